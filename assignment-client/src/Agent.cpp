@@ -151,7 +151,7 @@ void Agent::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNo
             // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
             int piggyBackedSizeWithHeader = message->getSize() - statsMessageLength;
 
-            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            auto buffer = udt::PacketBufferPool::allocate(piggyBackedSizeWithHeader);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
@@ -498,6 +498,11 @@ void Agent::executeScript() {
         // register ourselves to the script engine
         _scriptEngine->registerGlobalObject("Agent", new AgentScriptingInterface(this));
 
+        // the avatars the script plays besides its own
+        _avatarCrowd = new AvatarCrowd(this);
+        _scriptEngine->registerGlobalObject("AvatarCrowd", _avatarCrowd);
+        connect(_scriptEngine.data(), &ScriptEngine::update, _avatarCrowd, &AvatarCrowd::update);
+
         _scriptEngine->registerGlobalObject("AnimationCache", DependencyManager::get<AnimationCacheScriptingInterface>().data());
         _scriptEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
 
@@ -528,6 +533,10 @@ void Agent::executeScript() {
         Frame::clearFrameHandler(AUDIO_FRAME_TYPE);
         Frame::clearFrameHandler(AVATAR_FRAME_TYPE);
 
+        _avatarCrowd->removeAllAvatars();
+        _avatarCrowd->deleteLater();
+        _avatarCrowd = nullptr;
+
         if (recordingInterface->isPlaying()) {
             recordingInterface->stopPlaying();
         }
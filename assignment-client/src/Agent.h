@@ -31,6 +31,7 @@
 #include "AudioGate.h"
 #include "MixedAudioStream.h"
 #include "entities/EntityTreeHeadlessViewer.h"
+#include "avatars/AvatarCrowd.h"
 #include "avatars/ScriptableAvatar.h"
 
 class Agent : public ThreadedAssignment {
@@ -90,6 +91,7 @@ private:
     void computeLoudness(const QByteArray* decodedBuffer, QSharedPointer<ScriptableAvatar>);
 
     ScriptEnginePointer _scriptEngine;
+    AvatarCrowd* _avatarCrowd { nullptr };
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
@@ -13,6 +13,7 @@
 
 #include <assert.h>
 
+#include <QCoreApplication>
 #include <QProcess>
 #include <QSharedMemory>
 #include <QThread>
@@ -27,9 +28,11 @@
 #include <LogUtils.h>
 #include <LimitedNodeList.h>
 #include <NodeList.h>
+#include <plugins/PluginManager.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <ShutdownEventListener.h>
+#include <shared/GlobalAppProperties.h>
 
 #include <Trace.h>
 #include <StatTracker.h>
@@ -47,9 +50,13 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
                                    quint16 assignmentServerPort, quint16 assignmentMonitorPort) :
     _assignmentServerHostname(DEFAULT_ASSIGNMENT_SERVER_HOSTNAME)
 {
+    _startupTimer.start();
     LogUtils::init();
 
-    DependencyManager::set<tracing::Tracer>();
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    if (!qApp->property(hifi::properties::TRACING).toString().isEmpty()) {
+        tracer->startTracing();
+    }
     DependencyManager::set<StatTracker>();
     DependencyManager::set<AccountManager>();
     DependencyManager::set<ResourceRequestObserver>();
@@ -123,6 +130,34 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
         PacketReceiver::makeUnsourcedListenerReference<AssignmentClient>(this, &AssignmentClient::handleCreateAssignmentPacket));
     packetReceiver.registerListener(PacketType::StopNode,
         PacketReceiver::makeUnsourcedListenerReference<AssignmentClient>(this, &AssignmentClient::handleStopNodePacket));
+
+    // ask for an assignment right away rather than on the first tick of the timer, then warm up while waiting for it
+    QTimer::singleShot(0, this, &AssignmentClient::sendAssignmentRequest);
+    QTimer::singleShot(0, this, &AssignmentClient::warmUp);
+}
+
+void AssignmentClient::warmUp() {
+    if (_currentAssignment) {
+        // too late, the assignment loads what it needs itself
+        return;
+    }
+
+    // the codec plugins are the only ones the assignments use, and they stay loaded once they are, so that the
+    // assignment this spare gets doesn't have to wait for them
+    auto pluginManager = DependencyManager::set<PluginManager>();
+    pluginManager->setPluginFilter([](const QJsonObject& metaData) {
+        QJsonValue nameValue = metaData["MetaData"]["name"];
+        return nameValue.toString().contains("codec", Qt::CaseInsensitive);
+    });
+    auto numCodecs = pluginManager->getCodecPlugins().size();
+    DependencyManager::destroy<PluginManager>();
+
+    _readyMsecs = (qint32)_startupTimer.elapsed();
+    qCDebug(assignment_client) << "Ready for an assignment after" << _readyMsecs << "ms, with" << numCodecs << "codecs loaded.";
+
+    if (!_assignmentClientMonitorSocket.isNull()) {
+        sendStatusPacketToACM();
+    }
 }
 
 void AssignmentClient::stopAssignmentClient() {
@@ -153,6 +188,13 @@ AssignmentClient::~AssignmentClient() {
 void AssignmentClient::aboutToQuit() {
     crash::annotations::setShutdownState(true);
     stopAssignmentClient();
+
+    if (tracing::enabled()) {
+        auto tracer = DependencyManager::get<tracing::Tracer>();
+        tracer->stopTracing();
+        QString traceFile = qApp->property(hifi::properties::TRACING).toString();
+        tracer->serialize(traceFile.replace("{PID}", QString::number(QCoreApplication::applicationPid())));
+    }
 }
 
 void AssignmentClient::setUpStatusToMonitor() {
@@ -171,10 +213,15 @@ void AssignmentClient::sendStatusPacketToACM() {
         assignmentType = _currentAssignment->getType();
     }
 
-    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus, sizeof(assignmentType) + NUM_BYTES_RFC4122_UUID);
+    qint64 pid = QCoreApplication::applicationPid();
+
+    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus,
+                                         NUM_BYTES_RFC4122_UUID + sizeof(assignmentType) + sizeof(pid) + sizeof(_readyMsecs));
 
     statusPacket->write(_childAssignmentUUID.toRfc4122());
     statusPacket->writePrimitive(assignmentType);
+    statusPacket->writePrimitive(pid);
+    statusPacket->writePrimitive(_readyMsecs);
     
     nodeList->sendPacket(std::move(statusPacket), _assignmentClientMonitorSocket);
 }
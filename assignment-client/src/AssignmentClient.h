@@ -13,6 +13,7 @@
 #define hifi_AssignmentClient_h
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QPointer>
 
 #include "ThreadedAssignment.h"
@@ -34,6 +35,7 @@ private slots:
     void handleAuthenticationRequest();
     void sendStatusPacketToACM();
     void stopAssignmentClient();
+    void warmUp();
 
 public slots:
     void aboutToQuit();
@@ -53,6 +55,8 @@ private:
     QTimer _requestTimer; // timer for requesting and assignment
     QTimer _statsTimerACM; // timer for sending stats to assignment client monitor
     QUuid _childAssignmentUUID = QUuid::createUuid();
+    QElapsedTimer _startupTimer;
+    qint32 _readyMsecs { -1 }; // from the start until the warm up is done, -1 until then
 
  protected:
     HifiSockAddr _assignmentClientMonitorSocket;
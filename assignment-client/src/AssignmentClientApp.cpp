@@ -22,6 +22,7 @@
 #include <HifiConfigVariantMap.h>
 #include <SharedUtil.h>
 #include <ShutdownEventListener.h>
+#include <shared/GlobalAppProperties.h>
 #include <shared/ScriptInitializerMixin.h>
 
 #include "Assignment.h"
@@ -102,6 +103,10 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     const QCommandLineOption parentPIDOption(PARENT_PID_OPTION, "PID of the parent process", "parent-pid");
     parser.addOption(parentPIDOption);
 
+    const QCommandLineOption traceFileOption(ASSIGNMENT_TRACE_FILE,
+        "trace to write on exit, {PID} in the name is replaced by the process ID of each assignment client", "trace-file");
+    parser.addOption(traceFileOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         std::cout << parser.errorText().toStdString() << std::endl; // Avoid Qt log spam
         parser.showHelp();
@@ -228,6 +233,11 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
         }
     }
 
+    if (parser.isSet(traceFileOption)) {
+        // the assignment client traces to it, and a monitor passes it on to its children
+        setProperty(hifi::properties::TRACING, parser.value(traceFileOption));
+    }
+
     if (parser.isSet(parentPIDOption)) {
         bool ok = false;
         int parentPID = parser.value(parentPIDOption).toInt(&ok);
@@ -240,9 +250,6 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
 
     QThread::currentThread()->setObjectName("main thread");
 
-    LogHandler::getInstance().moveToThread(thread());
-    LogHandler::getInstance().setupRepeatedMessageFlusher();
-
     DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
     DependencyManager::set<ScriptInitializers>();
 
@@ -22,8 +22,17 @@ public:
     Assignment::Type getChildType() { return _childType; }
     void setChildType(Assignment::Type childType) { _childType = childType; }
 
+    qint64 getProcessID() const { return _processID; }
+    void setProcessID(qint64 processID) { _processID = processID; }
+
+    // the time the child took from its start to be ready for an assignment, -1 while it warms up
+    qint32 getReadyMsecs() const { return _readyMsecs; }
+    void setReadyMsecs(qint32 readyMsecs) { _readyMsecs = readyMsecs; }
+
 private:
     Assignment::Type _childType;
+    qint64 _processID { 0 };
+    qint32 _readyMsecs { -1 };
 };
 
 #endif // hifi_AssignmentClientChildData_h
@@ -20,6 +20,7 @@
 #include <AddressManager.h>
 #include <LogHandler.h>
 #include <udt/PacketHeaders.h>
+#include <shared/GlobalAppProperties.h>
 
 #include "AssignmentClientApp.h"
 #include "AssignmentClientChildData.h"
@@ -204,6 +205,12 @@ void AssignmentClientMonitor::spawnChildClient() {
         _childArguments.append(QString::number(listenPort));
     }
 
+    QString traceFile = qApp->property(hifi::properties::TRACING).toString();
+    if (!traceFile.isEmpty()) {
+        _childArguments.append("--" + ASSIGNMENT_TRACE_FILE);
+        _childArguments.append(traceFile);
+    }
+
     // tell children which assignment monitor port to use
     // for now they simply talk to us on localhost
     _childArguments.append("--" + ASSIGNMENT_CLIENT_MONITOR_PORT_OPTION);
@@ -371,6 +378,19 @@ void AssignmentClientMonitor::handleChildStatusPacket(QSharedPointer<ReceivedMes
 
         childData->setChildType(Assignment::Type(assignmentType));
 
+        qint64 processID;
+        qint32 readyMsecs;
+        if (message->getBytesLeftToRead() >= (qint64)(sizeof(processID) + sizeof(readyMsecs))) {
+            message->readPrimitive(&processID);
+            message->readPrimitive(&readyMsecs);
+
+            if (childData->getReadyMsecs() < 0 && readyMsecs >= 0) {
+                qDebug() << "Child" << processID << "is ready for an assignment after" << readyMsecs << "ms.";
+            }
+            childData->setProcessID(processID);
+            childData->setReadyMsecs(readyMsecs);
+        }
+
         // note when this child talked
         matchingNode->setLastHeardMicrostamp(usecTimestampNow());
     }
@@ -380,6 +400,15 @@ bool AssignmentClientMonitor::handleHTTPRequest(HTTPConnection* connection, cons
     if (url.path() == "/status") {
         QByteArray response;
 
+        // what the children last told about themselves
+        QHash<qint64, AssignmentClientChildData*> childrenData;
+        DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+            auto childData = static_cast<AssignmentClientChildData*>(node->getLinkedData());
+            if (childData && childData->getProcessID()) {
+                childrenData[childData->getProcessID()] = childData;
+            }
+        });
+
         QJsonObject status;
         QJsonObject servers;
         for (auto& ac : _childProcesses) {
@@ -389,6 +418,12 @@ bool AssignmentClientMonitor::handleHTTPRequest(HTTPConnection* connection, cons
             server["logStdout"] = ac.logStdoutPath;
             server["logStderr"] = ac.logStderrPath;
 
+            auto childData = childrenData.value(ac.process->processId());
+            if (childData) {
+                server["type"] = Assignment::typeToString(childData->getChildType());
+                server["readyMsecs"] = childData->getReadyMsecs();
+            }
+
             servers[QString::number(ac.process->processId())] = server;
         }
 
@@ -0,0 +1,172 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+AssetFileCache::AssetFileCache(qint64 capacity, qint64 maxFileSize) :
+    _capacity(capacity),
+    _maxFileSize(maxFileSize)
+{
+
+}
+
+void AssetFileCache::setLimits(qint64 capacity, qint64 maxFileSize) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = capacity;
+    _maxFileSize = maxFileSize;
+
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (canCache(it->content.size())) {
+            ++it;
+        } else {
+            _size -= it->content.size();
+            _entriesByHash.remove(it->hash);
+            it = _entries.erase(it);
+        }
+    }
+    evictLocked();
+}
+
+QByteArray AssetFileCache::get(const QString& hash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto content = findLocked(hash);
+    if (content.isNull()) {
+        ++_numMisses;
+    } else {
+        ++_numHits;
+    }
+    return content;
+}
+
+QByteArray AssetFileCache::getOrLoad(const QString& hash, const Loader& load) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_loading.contains(hash)) {
+        // another task is reading this file already, share its read
+        ++_numCoalescedLoads;
+        _loadFinished.wait(lock);
+    }
+    auto content = findLocked(hash);
+    if (!content.isNull()) {
+        return content;
+    }
+
+    _loading.insert(hash);
+    lock.unlock();
+    content = load();
+    lock.lock();
+    _loading.remove(hash);
+
+    if (!content.isNull()) {
+        insertLocked(hash, content);
+    }
+    _loadFinished.notify_all();
+    return content;
+}
+
+bool AssetFileCache::getFileSize(const QString& hash, qint64& fileSize) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _fileSizes.find(hash);
+    if (it == _fileSizes.end()) {
+        ++_numSizeMisses;
+        return false;
+    }
+    ++_numSizeHits;
+    fileSize = it.value();
+    return true;
+}
+
+void AssetFileCache::setFileSize(const QString& hash, qint64 fileSize) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _fileSizes.insert(hash, fileSize);
+}
+
+bool AssetFileCache::getChunkHashes(const QString& hash, qint64& chunkSize, QByteArray& chunkHashes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _chunkHashes.find(hash);
+    if (it == _chunkHashes.end()) {
+        return false;
+    }
+    chunkSize = it.value().first;
+    chunkHashes = it.value().second;
+    return true;
+}
+
+void AssetFileCache::setChunkHashes(const QString& hash, qint64 chunkSize, const QByteArray& chunkHashes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _chunkHashes.insert(hash, { chunkSize, chunkHashes });
+}
+
+void AssetFileCache::remove(const QString& hash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _fileSizes.remove(hash);
+    _chunkHashes.remove(hash);
+    auto it = _entriesByHash.find(hash);
+    if (it != _entriesByHash.end()) {
+        _size -= it.value()->content.size();
+        _entries.erase(it.value());
+        _entriesByHash.erase(it);
+    }
+}
+
+QJsonObject AssetFileCache::getStats() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto hitRate = [](int hits, int misses) {
+        int total = hits + misses;
+        return total > 0 ? (float)hits / (float)total : 0.0f;
+    };
+
+    QJsonObject stats;
+    stats["1. Cached Files"] = (int)_entries.size();
+    stats["2. Cached (MB)"] = (double)_size / (1024.0 * 1024.0);
+    stats["3. Hit Rate"] = hitRate(_numHits, _numMisses);
+    stats["4. Coalesced Reads"] = _numCoalescedLoads;
+    stats["5. Size Hit Rate"] = hitRate(_numSizeHits, _numSizeMisses);
+
+    _numHits = 0;
+    _numMisses = 0;
+    _numCoalescedLoads = 0;
+    _numSizeHits = 0;
+    _numSizeMisses = 0;
+
+    return stats;
+}
+
+QByteArray AssetFileCache::findLocked(const QString& hash) {
+    auto it = _entriesByHash.find(hash);
+    if (it == _entriesByHash.end()) {
+        return QByteArray();
+    }
+    _entries.splice(_entries.begin(), _entries, it.value());
+    return _entries.front().content;
+}
+
+void AssetFileCache::insertLocked(const QString& hash, const QByteArray& content) {
+    if (!canCache(content.size()) || _entriesByHash.contains(hash)) {
+        return;
+    }
+
+    _entries.push_front({ hash, content });
+    _entriesByHash.insert(hash, _entries.begin());
+    _size += content.size();
+    _fileSizes.insert(hash, content.size());
+
+    evictLocked();
+}
+
+void AssetFileCache::evictLocked() {
+    while (_size > _capacity && !_entries.empty()) {
+        const auto& leastRecent = _entries.back();
+        _size -= leastRecent.content.size();
+        _entriesByHash.remove(leastRecent.hash);
+        _entries.pop_back();
+    }
+}
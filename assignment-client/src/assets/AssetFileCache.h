@@ -0,0 +1,90 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QPair>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+// The content and size of recently requested asset files, shared by the send tasks and the asset server.
+//
+// Asset files are named after the hash of their content, so an entry only goes stale when its file is deleted.
+// The least recently used content is evicted once the cache holds more than its capacity.
+class AssetFileCache {
+public:
+    using Loader = std::function<QByteArray()>;
+
+    AssetFileCache(qint64 capacity, qint64 maxFileSize);
+
+    // evicts what doesn't fit anymore
+    void setLimits(qint64 capacity, qint64 maxFileSize);
+    bool canCache(qint64 fileSize) const { return fileSize <= _maxFileSize; }
+
+    // returns a null QByteArray if the content of the file isn't cached
+    QByteArray get(const QString& hash);
+    // returns the content of the file, loading it if it isn't cached yet
+    // concurrent requests for the same file wait for the one load, returns a null QByteArray if the load failed
+    QByteArray getOrLoad(const QString& hash, const Loader& load);
+
+    bool getFileSize(const QString& hash, qint64& fileSize);
+    void setFileSize(const QString& hash, qint64 fileSize);
+
+    // the hashes of the chunks of a large file, see SendAssetInfoTask
+    bool getChunkHashes(const QString& hash, qint64& chunkSize, QByteArray& chunkHashes);
+    void setChunkHashes(const QString& hash, qint64 chunkSize, const QByteArray& chunkHashes);
+
+    void remove(const QString& hash);
+
+    QJsonObject getStats();
+
+private:
+    struct Entry {
+        QString hash;
+        QByteArray content;
+    };
+    using Entries = std::list<Entry>;
+
+    QByteArray findLocked(const QString& hash);
+    void insertLocked(const QString& hash, const QByteArray& content);
+    void evictLocked();
+
+    std::atomic<qint64> _capacity;
+    std::atomic<qint64> _maxFileSize;
+
+    std::mutex _mutex;
+    std::condition_variable _loadFinished;
+    Entries _entries; // most recently used first
+    QHash<QString, Entries::iterator> _entriesByHash;
+    QSet<QString> _loading;
+    QHash<QString, qint64> _fileSizes;
+    QHash<QString, QPair<qint64, QByteArray>> _chunkHashes;
+    qint64 _size { 0 };
+
+    // since the last stats
+    int _numHits { 0 };
+    int _numMisses { 0 };
+    int _numCoalescedLoads { 0 };
+    int _numSizeHits { 0 };
+    int _numSizeMisses { 0 };
+};
+
+#endif // hifi_AssetFileCache_h
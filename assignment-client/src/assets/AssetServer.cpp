@@ -37,6 +37,7 @@
 
 #include "AssetServerLogging.h"
 #include "BakeAssetTask.h"
+#include "SendAssetInfoTask.h"
 #include "SendAssetTask.h"
 #include "UploadAssetTask.h"
 
@@ -45,6 +46,10 @@ static const uint8_t CPU_AFFINITY_COUNT_HIGH = 2;
 static const uint8_t CPU_AFFINITY_COUNT_LOW = 1;
 #ifdef Q_OS_WIN
 static const int INTERFACE_RUNNING_CHECK_FREQUENCY_MS = 1000;
+
+// the asset files kept in memory by default, large files are always sent straight from the disk
+static const qint64 ASSET_FILE_CACHE_CAPACITY = 256 * 1024 * 1024;
+static const qint64 MAX_CACHED_ASSET_FILE_SIZE = 16 * 1024 * 1024;
 #endif
 
 static const QStringList BAKEABLE_MODEL_EXTENSIONS = { "fbx" };
@@ -293,6 +298,7 @@ void updateConsumedCores() {
 
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
+    _fileCache(ASSET_FILE_CACHE_CAPACITY, MAX_CACHED_ASSET_FILE_SIZE),
     _transferTaskPool(this),
     _bakingTaskPool(this),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
@@ -459,6 +465,18 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the in-memory cache of asset files, in MB, 0 disables it
+    static const QString FILE_CACHE_SIZE_OPTION = "file_cache_size";
+    static const QString MAX_CACHED_FILE_SIZE_OPTION = "max_cached_file_size";
+    static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+    auto fileCacheSize = assetServerObject[FILE_CACHE_SIZE_OPTION].toInt(ASSET_FILE_CACHE_CAPACITY / BYTES_PER_MEGABYTE);
+    auto maxCachedFileSize = assetServerObject[MAX_CACHED_FILE_SIZE_OPTION].toInt(MAX_CACHED_ASSET_FILE_SIZE / BYTES_PER_MEGABYTE);
+    if (fileCacheSize <= 0) {
+        maxCachedFileSize = -1;
+    }
+    _fileCache.setLimits(std::max(fileCacheSize, 0) * BYTES_PER_MEGABYTE, (qint64)maxCachedFileSize * BYTES_PER_MEGABYTE);
+    qCDebug(asset_server) << "Caching asset files up to" << maxCachedFileSize << "MB, up to" << fileCacheSize << "MB total";
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -545,6 +563,8 @@ void AssetServer::cleanupUnmappedFiles() {
 
                 if (removeableFile.remove()) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
+                    _fileCache.remove(filename);
+                    _metaFileCache.remove(filename);
 
                     removeBakedPathsForDeletedAsset(filename);
                 } else {
@@ -838,24 +858,35 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
     message->readPrimitive(&messageID);
     assetHash = message->readWithoutCopy(AssetUtils::SHA256_HASH_LENGTH);
 
-    auto size = qint64(sizeof(MessageID) + AssetUtils::SHA256_HASH_LENGTH + sizeof(AssetUtils::AssetServerError) + sizeof(qint64));
-    auto replyPacket = NLPacket::create(PacketType::AssetGetInfoReply, size, true);
-
     QByteArray hexHash = assetHash.toHex();
 
-    replyPacket->writePrimitive(messageID);
-    replyPacket->write(assetHash);
-
     QString fileName = QString(hexHash);
-    QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
 
-    if (fileInfo.exists() && fileInfo.isReadable()) {
-        qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
-        replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-        replyPacket->writePrimitive(fileInfo.size());
+    qint64 fileSize;
+    bool found = _fileCache.getFileSize(fileName, fileSize);
+    if (!found) {
+        QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
+        found = fileInfo.exists() && fileInfo.isReadable();
+        if (found) {
+            fileSize = fileInfo.size();
+            _fileCache.setFileSize(fileName, fileSize);
+        }
+    }
+
+    std::unique_ptr<NLPacket> replyPacket;
+    if (found) {
+        qint64 chunkSize = 0;
+        QByteArray chunkHashes;
+        if (SendAssetInfoTask::hasChunks(fileSize) && !_fileCache.getChunkHashes(fileName, chunkSize, chunkHashes)) {
+            // the chunks have to be read and hashed first
+            auto task = new SendAssetInfoTask(messageID, assetHash, fileSize, senderNode, _filesDirectory, _fileCache);
+            _transferTaskPool.start(task);
+            return;
+        }
+        replyPacket = SendAssetInfoTask::createReply(messageID, assetHash, fileSize, chunkSize, chunkHashes);
     } else {
         qCDebug(asset_server) << "Asset not found: " << QString(hexHash);
-        replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+        replyPacket = SendAssetInfoTask::createNotFoundReply(messageID, assetHash);
     }
 
     auto nodeList = DependencyManager::get<NodeList>();
@@ -872,7 +903,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _fileCache);
     _transferTaskPool.start(task);
 }
 
@@ -965,6 +996,8 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    serverStats["file_cache"] = _fileCache.getStats();
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1182,6 +1215,8 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
             if (removeableFile.remove()) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
+                _fileCache.remove(hash);
+                _metaFileCache.remove(hash);
 
                 removeBakedPathsForDeletedAsset(hash);
             } else {
@@ -1491,6 +1526,12 @@ std::pair<bool, AssetMeta> AssetServer::readMetaFile(AssetUtils::AssetHash hash)
 
     auto metaFileHash = it->second;
 
+    // meta files are named after their content like any other, so what was read from one stays valid
+    auto cachedIt = _metaFileCache.find(metaFileHash);
+    if (cachedIt != _metaFileCache.end()) {
+        return { true, cachedIt.value() };
+    }
+
     QFile metaFile(_filesDirectory.absoluteFilePath(metaFileHash));
 
     if (metaFile.open(QIODevice::ReadOnly)) {
@@ -1518,6 +1559,7 @@ std::pair<bool, AssetMeta> AssetServer::readMetaFile(AssetUtils::AssetHash hash)
                 meta.lastBakeErrors = lastBakeErrors.toString();
                 meta.redirectTarget = redirectTarget.toString();
 
+                _metaFileCache.insert(metaFileHash, meta);
                 return { true, meta };
             } else {
                 qCWarning(asset_server) << "Metafile for" << hash << "has either missing or malformed data.";
@@ -18,6 +18,7 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetFileCache.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -153,6 +154,10 @@ private:
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// Content and size of the recently requested asset files, must outlive the transfer tasks
+    AssetFileCache _fileCache;
+    QHash<AssetUtils::AssetHash, AssetMeta> _metaFileCache; // by meta file hash
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
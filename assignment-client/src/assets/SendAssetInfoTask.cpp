@@ -0,0 +1,121 @@
+//
+//  SendAssetInfoTask.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendAssetInfoTask.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+
+#include <NodeList.h>
+
+#include "AssetFileCache.h"
+#include "AssetServerLogging.h"
+
+static const qint64 MIN_CHUNK_SIZE = 1024 * 1024;
+static const qint64 CHUNK_SIZE_ALIGNMENT = 64 * 1024;
+static const qint64 MAX_CHUNKS = 32;
+static const qint64 HASH_READ_SIZE = 1024 * 1024;
+
+SendAssetInfoTask::SendAssetInfoTask(MessageID messageID, const QByteArray& assetHash, qint64 fileSize,
+                                     const SharedNodePointer& sendToNode, const QDir& resourcesDir, AssetFileCache& fileCache) :
+    QRunnable(),
+    _messageID(messageID),
+    _assetHash(assetHash),
+    _fileSize(fileSize),
+    _senderNode(sendToNode),
+    _resourcesDir(resourcesDir),
+    _fileCache(fileCache)
+{
+
+}
+
+qint64 SendAssetInfoTask::getChunkSize(qint64 fileSize) {
+    qint64 chunkSize = (fileSize + MAX_CHUNKS - 1) / MAX_CHUNKS;
+    chunkSize = ((chunkSize + CHUNK_SIZE_ALIGNMENT - 1) / CHUNK_SIZE_ALIGNMENT) * CHUNK_SIZE_ALIGNMENT;
+    return std::max(chunkSize, MIN_CHUNK_SIZE);
+}
+
+std::unique_ptr<NLPacket> SendAssetInfoTask::createReply(MessageID messageID, const QByteArray& assetHash, qint64 fileSize,
+                                                         qint64 chunkSize, const QByteArray& chunkHashes) {
+    auto size = qint64(sizeof(MessageID) + AssetUtils::SHA256_HASH_LENGTH + sizeof(AssetUtils::AssetServerError) + sizeof(qint64));
+    if (!chunkHashes.isEmpty()) {
+        size += sizeof(qint64) + chunkHashes.size();
+    }
+    auto replyPacket = NLPacket::create(PacketType::AssetGetInfoReply, size, true);
+
+    replyPacket->writePrimitive(messageID);
+    replyPacket->write(assetHash);
+    replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+    replyPacket->writePrimitive(fileSize);
+    if (!chunkHashes.isEmpty()) {
+        replyPacket->writePrimitive(chunkSize);
+        replyPacket->write(chunkHashes);
+    }
+    return replyPacket;
+}
+
+std::unique_ptr<NLPacket> SendAssetInfoTask::createNotFoundReply(MessageID messageID, const QByteArray& assetHash) {
+    auto size = qint64(sizeof(MessageID) + AssetUtils::SHA256_HASH_LENGTH + sizeof(AssetUtils::AssetServerError));
+    auto replyPacket = NLPacket::create(PacketType::AssetGetInfoReply, size, true);
+
+    replyPacket->writePrimitive(messageID);
+    replyPacket->write(assetHash);
+    replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+    return replyPacket;
+}
+
+void SendAssetInfoTask::run() {
+    QString hexHash = _assetHash.toHex();
+    qint64 chunkSize = getChunkSize(_fileSize);
+
+    std::unique_ptr<NLPacket> replyPacket;
+
+    QFile file { _resourcesDir.filePath(hexHash) };
+    if (!file.open(QIODevice::ReadOnly) || file.size() != _fileSize) {
+        qCDebug(asset_server) << "Asset not found: " << hexHash;
+        replyPacket = createNotFoundReply(_messageID, _assetHash);
+    } else {
+        QByteArray chunkHashes;
+        QByteArray buffer;
+        buffer.resize((int)std::min(HASH_READ_SIZE, chunkSize));
+
+        bool failed = false;
+        for (qint64 offset = 0; offset < _fileSize && !failed; offset += chunkSize) {
+            QCryptographicHash chunkHash(QCryptographicHash::Sha256);
+            qint64 left = std::min(chunkSize, _fileSize - offset);
+            while (left > 0) {
+                qint64 bytesRead = file.read(buffer.data(), std::min(left, (qint64)buffer.size()));
+                if (bytesRead <= 0) {
+                    failed = true;
+                    break;
+                }
+                chunkHash.addData(buffer.constData(), (int)bytesRead);
+                left -= bytesRead;
+            }
+            chunkHashes.append(chunkHash.result());
+        }
+
+        if (failed) {
+            // still answer with the size, the clients fetch the asset whole
+            qCWarning(asset_server) << "Unable to read the chunks of" << hexHash;
+            replyPacket = createReply(_messageID, _assetHash, _fileSize, chunkSize, QByteArray());
+        } else {
+            // asset files never change, the manifest is good until the file is deleted
+            _fileCache.setChunkHashes(hexHash, chunkSize, chunkHashes);
+            replyPacket = createReply(_messageID, _assetHash, _fileSize, chunkSize, chunkHashes);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (_senderNode) {
+        nodeList->sendPacket(std::move(replyPacket), *_senderNode);
+    }
+}
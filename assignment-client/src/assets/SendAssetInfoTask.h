@@ -0,0 +1,57 @@
+//
+//  SendAssetInfoTask.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendAssetInfoTask_h
+#define hifi_SendAssetInfoTask_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QRunnable>
+#include <QtCore/QString>
+
+#include "AssetUtils.h"
+#include "ClientServerUtils.h"
+#include "NLPacket.h"
+#include "Node.h"
+
+class AssetFileCache;
+
+// Hashes the chunks of a large asset file that has no chunk manifest yet, and sends its info with the manifest.
+//
+// The info reply of an asset larger than a chunk ends with the size of its chunks and their SHA-256 hashes, which lets
+// the clients fetch the chunks in parallel and verify, cache and retry them one by one. The clients that don't know
+// about it read the size only.
+class SendAssetInfoTask : public QRunnable {
+public:
+    SendAssetInfoTask(MessageID messageID, const QByteArray& assetHash, qint64 fileSize, const SharedNodePointer& sendToNode,
+                      const QDir& resourcesDir, AssetFileCache& fileCache);
+
+    void run() override;
+
+    // the chunks are no smaller than MIN_CHUNK_SIZE, and no more than MAX_CHUNKS so that their hashes fit in the reply
+    static qint64 getChunkSize(qint64 fileSize);
+    static bool hasChunks(qint64 fileSize) { return fileSize > getChunkSize(fileSize); }
+
+    // chunkHashes is empty for the assets that fit in one chunk
+    static std::unique_ptr<NLPacket> createReply(MessageID messageID, const QByteArray& assetHash, qint64 fileSize,
+                                                 qint64 chunkSize, const QByteArray& chunkHashes);
+    static std::unique_ptr<NLPacket> createNotFoundReply(MessageID messageID, const QByteArray& assetHash);
+
+private:
+    MessageID _messageID;
+    QByteArray _assetHash;
+    qint64 _fileSize;
+    SharedNodePointer _senderNode;
+    QDir _resourcesDir;
+    AssetFileCache& _fileCache;
+};
+
+#endif // hifi_SendAssetInfoTask_h
@@ -11,6 +11,7 @@
 
 #include "SendAssetTask.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <QFile>
@@ -22,19 +23,46 @@
 #include <NodeList.h>
 #include <udt/Packet.h>
 
+#include "AssetFileCache.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             AssetFileCache& fileCache) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _fileCache(fileCache)
 {
     
 }
 
+// writes a range of a file to the packet list straight from the file, without reading it into memory first
+static void writeFileRange(QFile& file, qint64 offset, qint64 size, NLPacketList& packetList) {
+    uchar* mapped = file.map(offset, size);
+    if (mapped) {
+        packetList.write(reinterpret_cast<const char*>(mapped), size);
+        file.unmap(mapped);
+        return;
+    }
+
+    // the file can't be mapped, read it a chunk at a time
+    static const qint64 READ_CHUNK_SIZE = 1024 * 1024;
+    QByteArray chunk;
+    chunk.resize((int)std::min(size, READ_CHUNK_SIZE));
+    file.seek(offset);
+    while (size > 0) {
+        qint64 bytesRead = file.read(chunk.data(), std::min(size, (qint64)chunk.size()));
+        if (bytesRead <= 0) {
+            break;
+        }
+        packetList.write(chunk.constData(), bytesRead);
+        size -= bytesRead;
+    }
+}
+
 void SendAssetTask::run() {
     MessageID messageID;
     ByteRange byteRange;
@@ -64,17 +92,31 @@ void SendAssetTask::run() {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
     } else {
         QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
+
+        // popular assets are served from memory
+        QByteArray cachedContent = _fileCache.get(hexHash);
+
         QFile file { filePath };
 
-        if (file.open(QIODevice::ReadOnly)) {
+        if (cachedContent.isNull() && file.open(QIODevice::ReadOnly) && _fileCache.canCache(file.size())) {
+            // read it whole, so that the next requests for it don't have to go to the disk
+            // requests for the same file that come in meanwhile share this read
+            cachedContent = _fileCache.getOrLoad(hexHash, [&file] {
+                QByteArray content = file.readAll();
+                return content.size() == file.size() ? content : QByteArray();
+            });
+        }
+        bool isCached = !cachedContent.isNull();
+
+        if (isCached || file.isOpen()) {
+            qint64 fileSize = isCached ? cachedContent.size() : file.size();
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(fileSize);
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,29 +124,23 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
+                // a negative range is read back from the end of the file
+                qint64 offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : fileSize + byteRange.fromInclusive;
 
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+                replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList->writePrimitive(size);
 
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
+                if (isCached) {
+                    replyPacketList->write(cachedContent.constData() + offset, size);
+                } else {
+                    writeFileRange(file, offset, size, *replyPacketList);
                 }
 
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
+            if (file.isOpen()) {
+                file.close();
+            }
         } else {
             qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
             replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -21,11 +21,13 @@
 #include "AssetServer.h"
 #include "Node.h"
 
+class AssetFileCache;
 class NLPacket;
 
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                  AssetFileCache& fileCache);
 
     void run() override;
 
@@ -33,6 +35,7 @@ private:
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
     QDir _resourcesDir;
+    AssetFileCache& _fileCache;
 };
 
 #endif
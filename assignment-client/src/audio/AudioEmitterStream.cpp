@@ -0,0 +1,104 @@
+//
+//  AudioEmitterStream.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioEmitterStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <DependencyManager.h>
+#include <SoundCache.h>
+
+#include "AudioLogging.h"
+
+AudioEmitterStream::AudioEmitterStream(const AudioEmitterProperties& properties) :
+    InjectedAudioStream(properties.emitterID, false, 0)
+{
+    _shouldLoopbackForNode = false;
+    setProperties(properties);
+}
+
+void AudioEmitterStream::setProperties(const AudioEmitterProperties& properties) {
+    _position = properties.position;
+    _orientation = properties.orientation;
+    _attenuationRatio = properties.volume;
+    _ignorePenumbra = properties.ignorePenumbra;
+    _loop = properties.loop;
+
+    if (properties.soundURL != _soundURL) {
+        // a new sound starts over, from its offset
+        _soundURL = properties.soundURL;
+        _secondOffset = properties.secondOffset;
+        _sound = DependencyManager::get<SoundCache>()->getSound(_soundURL);
+        _nextFrame = -1;
+    }
+}
+
+bool AudioEmitterStream::writeNextFrame() {
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    auto audioData = _sound ? _sound->getAudioData() : AudioDataPointer();
+    if (!audioData) {
+        if (!_sound || _sound->isFailed()) {
+            return false;
+        }
+        // the stream stays alive while the sound loads
+        memset(_frameBuffer, 0, sizeof(_frameBuffer));
+        _ringBuffer.writeSamples(_frameBuffer, _ringBuffer.getNumFrameSamples());
+        _isStarved = false;
+        return true;
+    }
+
+    int numChannels = (int)audioData->getNumChannels();
+    if (numChannels > AudioConstants::STEREO) {
+        qCWarning(audio) << "Audio emitters can't play ambisonic sounds:" << _soundURL;
+        return false;
+    }
+    bool isStereo = numChannels == AudioConstants::STEREO;
+    if (isStereo != _isStereo) {
+        _ringBuffer.resizeForFrameSize(isStereo ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO : NUM_FRAMES);
+        _isStereo = isStereo;
+    }
+
+    int numSoundFrames = (int)audioData->getNumFrames();
+    if (numSoundFrames == 0) {
+        return false;
+    }
+    if (_nextFrame < 0) {
+        _nextFrame = std::min((int)(_secondOffset * AudioConstants::SAMPLE_RATE), numSoundFrames);
+    }
+
+    // copy a network frame, wrapping around when the sound loops
+    int numFramesWritten = 0;
+    while (numFramesWritten < NUM_FRAMES) {
+        if (_nextFrame >= numSoundFrames) {
+            if (!_loop) {
+                break;
+            }
+            _nextFrame = 0;
+        }
+        int numFrames = std::min(NUM_FRAMES - numFramesWritten, numSoundFrames - _nextFrame);
+        memcpy(_frameBuffer + numFramesWritten * numChannels, audioData->data() + _nextFrame * numChannels,
+               numFrames * numChannels * sizeof(AudioConstants::AudioSample));
+        numFramesWritten += numFrames;
+        _nextFrame += numFrames;
+    }
+    if (numFramesWritten == 0) {
+        return false;
+    }
+    memset(_frameBuffer + numFramesWritten * numChannels, 0,
+           (NUM_FRAMES - numFramesWritten) * numChannels * sizeof(AudioConstants::AudioSample));
+
+    _ringBuffer.writeSamples(_frameBuffer, NUM_FRAMES * numChannels);
+    _isStarved = false;
+    _hasStarted = true;
+    return true;
+}
@@ -0,0 +1,42 @@
+//
+//  AudioEmitterStream.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioEmitterStream_h
+#define hifi_AudioEmitterStream_h
+
+#include <AudioConstants.h>
+#include <AudioEmitterProperties.h>
+#include <InjectedAudioStream.h>
+#include <Sound.h>
+
+// The stream of a sound emitter hosted by the mixer. It is mixed as an injector, but its frames come from the sound
+// cache of the mixer, one per mixer frame, instead of a jitter buffer of packets.
+class AudioEmitterStream : public InjectedAudioStream {
+public:
+    AudioEmitterStream(const AudioEmitterProperties& properties);
+
+    // called from the AudioMixerSlave processing the packets of the node that owns the emitter
+    void setProperties(const AudioEmitterProperties& properties);
+
+    // writes the next frame of the sound, silence while it loads; returns false once the sound is over or failed
+    bool writeNextFrame();
+
+private:
+    SharedSoundPointer _sound;
+    QUrl _soundURL;
+    bool _loop { false };
+    float _secondOffset { 0.0f };
+    int _nextFrame { -1 }; // in the sound, -1 until it starts
+
+    AudioConstants::AudioSample _frameBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+};
+
+#endif // hifi_AudioEmitterStream_h
@@ -0,0 +1,85 @@
+//
+//  AudioEncodingController.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-26.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioEncodingController.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+static const std::array<int, 6> BITRATES {{ 128000, 96000, 64000, 48000, 32000, 24000 }};
+
+// above this loss rate, a lower bitrate is worth the quality
+static const float STEP_DOWN_LOSS_RATE = 0.05f;
+static const float CLEAN_LOSS_RATE = 0.01f;
+// the mixed audio shouldn't take more than this share of the connection
+static const int BANDWIDTH_SHARE = 4;
+// how long it has to be clean before stepping the bitrate back up, in updates
+static const int STEP_UP_UPDATES = 10;
+
+// Opus' in-band FEC doesn't do any better past this loss
+static const int MAX_EXPECTED_LOSS_PERCENTAGE = 30;
+
+// the complexity for the mix ratio, throttling starts at 0.9 by default
+static int complexityForMixRatio(float mixRatio) {
+    if (mixRatio < 0.5f) {
+        return 10;
+    } else if (mixRatio < 0.65f) {
+        return 7;
+    } else if (mixRatio < 0.8f) {
+        return 4;
+    } else {
+        return 1;
+    }
+}
+
+bool AudioEncodingController::update(const Inputs& inputs) {
+    const int LOWEST_LEVEL = (int)BITRATES.size() - 1;
+
+    bool isLossy = inputs.lossRate > STEP_DOWN_LOSS_RATE;
+    bool isTooNarrow = (inputs.estimatedBandwidth > 0 &&
+                        BITRATES[_bitrateLevel] * BANDWIDTH_SHARE > inputs.estimatedBandwidth) ||
+                       (inputs.downstreamShare > 0 && BITRATES[_bitrateLevel] > inputs.downstreamShare);
+
+    if (isLossy || isTooNarrow) {
+        _bitrateLevel = std::min(_bitrateLevel + 1, LOWEST_LEVEL);
+        _cleanUpdates = 0;
+    } else if (inputs.lossRate <= CLEAN_LOSS_RATE) {
+        if (++_cleanUpdates >= STEP_UP_UPDATES && _bitrateLevel > 0) {
+            int higherBitrate = BITRATES[_bitrateLevel - 1];
+            bool fitsConnection = inputs.estimatedBandwidth == 0 ||
+                                  higherBitrate * BANDWIDTH_SHARE <= inputs.estimatedBandwidth;
+            bool fitsShare = inputs.downstreamShare == 0 || higherBitrate <= inputs.downstreamShare;
+            if (fitsConnection && fitsShare) {
+                --_bitrateLevel;
+            }
+            _cleanUpdates = 0;
+        }
+    } else {
+        // some loss, hold where we are
+        _cleanUpdates = 0;
+    }
+
+    Settings settings;
+    settings.bitrate = BITRATES[_bitrateLevel];
+
+    // get cheaper right away when the mixer is loaded, but only get more expensive one step at a time
+    int complexity = complexityForMixRatio(inputs.mixRatio);
+    settings.complexity = complexity < _settings.complexity ? complexity : std::min(complexity, _settings.complexity + 1);
+
+    settings.expectedLossPercentage = std::min((int)std::round(inputs.lossRate * 100.0f), MAX_EXPECTED_LOSS_PERCENTAGE);
+
+    if (settings != _settings) {
+        _settings = settings;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,52 @@
+//
+//  AudioEncodingController.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-26.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioEncodingController_h
+#define hifi_AudioEncodingController_h
+
+// Picks the encoding of a listener's mixed stream from how well the listener receives it and how loaded the mixer is.
+//
+// The bitrate steps down as soon as the listener loses packets or the link looks too narrow for it, and back up
+// slowly once things are clean again. The complexity follows the mixer's headroom, so encoding gets cheaper before
+// AudioMixer::throttle has to start dropping streams.
+class AudioEncodingController {
+public:
+    struct Inputs {
+        float lossRate { 0.0f }; // of the mixed stream, as reported by the listener
+        int estimatedBandwidth { 0 }; // of the connection, in bits per second, 0 if unknown
+        int downstreamShare { 0 }; // of the listener's link for the audio, in bits per second, 0 for no limit
+        float mixRatio { 0.0f }; // trailing time spent mixing, over the frame time
+    };
+
+    struct Settings {
+        int bitrate; // bits per second
+        int complexity; // 0 to 10
+        int expectedLossPercentage;
+
+        bool operator==(const Settings& other) const {
+            return bitrate == other.bitrate && complexity == other.complexity &&
+                   expectedLossPercentage == other.expectedLossPercentage;
+        }
+        bool operator!=(const Settings& other) const { return !(*this == other); }
+    };
+
+    // expected about once a second, returns true if the settings changed
+    bool update(const Inputs& inputs);
+
+    const Settings& getSettings() const { return _settings; }
+
+private:
+    int _bitrateLevel { 0 };
+    int _cleanUpdates { 0 }; // since the last reason to step the bitrate down
+    Settings _settings { 128000, 10, 0 };
+};
+
+#endif // hifi_AudioEncodingController_h
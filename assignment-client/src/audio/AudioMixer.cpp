@@ -11,12 +11,15 @@
 
 #include "AudioMixer.h"
 
+#include <csignal>
 #include <thread>
 
+#include <QtCore/QDir>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonValue>
+#include <QtConcurrent/QtConcurrentRun>
 #include <shared/QtHelpers.h>
 
 #include <LogHandler.h>
@@ -26,7 +29,12 @@
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
+#include <ResourceCache.h>
+#include <ResourceManager.h>
+#include <SoundCache.h>
 #include <udt/PacketHeaders.h>
+#include <Profile.h>
+#include <SharedCounters.h>
 #include <SharedUtil.h>
 #include <StDev.h>
 #include <UUID.h>
@@ -44,6 +52,7 @@ using namespace std;
 static const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.5f;    // attenuation = -6dB * log2(distance)
 static const int DISABLE_STATIC_JITTER_FRAMES = -1;
 static const float DEFAULT_NOISE_MUTING_THRESHOLD = 1.0f;
+static const float DEFAULT_DOWNSTREAM_NEAR_FIELD_DISTANCE = 16.0f;
 static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
@@ -57,6 +66,14 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 vector<AudioMixer::ZoneDescription> AudioMixer::_audioZones;
 vector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 vector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+bool AudioMixer::_isZoneReverbShared { false };
+float AudioMixer::_ambisonicBedDistance { 0.0f };
+vector<AudioMixer::DownstreamZone> AudioMixer::_downstreamZones;
+float AudioMixer::_downstreamNearFieldDistance { DEFAULT_DOWNSTREAM_NEAR_FIELD_DISTANCE };
+std::atomic<bool> AudioMixer::_isTraceCaptureRequested { false };
+
+// how much a trace capture records once requested, about five seconds
+static const int TRACE_CAPTURE_FRAMES = 500;
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -66,6 +83,16 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     // This prevents previous assignment settings from sticking around
     clearDomainSettings();
 
+#ifndef Q_OS_WIN
+    // `kill -USR1 <pid>` writes a trace of the next few seconds of mixing
+    signal(SIGUSR1, requestTraceCapture);
+#endif
+
+    // the sounds of the emitters hosted by the mixer
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<SoundCache>();
+
     // hash the available codecs (on the mixer)
     _availableCodecs.clear(); // Make sure struct is clean
     auto pluginManager = DependencyManager::set<PluginManager>();
@@ -85,8 +112,9 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
 
-    // packets whose consequences are limited to their own node can be parallelized
-    packetReceiver.registerListenerForTypes({
+    // packets whose consequences are limited to their own node can be parallelized,
+    // they are only queued for the slaves as they arrive
+    packetReceiver.registerDirectListenerForTypes({
             PacketType::MicrophoneAudioNoEcho,
             PacketType::MicrophoneAudioWithEcho,
             PacketType::InjectAudio,
@@ -100,7 +128,9 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             PacketType::PerAvatarGainSet,
             PacketType::InjectorGainSet,
             PacketType::AudioSoloRequest,
-            PacketType::StopInjector },
+            PacketType::StopInjector,
+            PacketType::AudioParity,
+            PacketType::AudioEmitter },
             PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::queueAudioPacket)
     );
 
@@ -119,20 +149,43 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
         PacketType::ReplicatedSilentAudioFrame },
         PacketReceiver::makeUnsourcedListenerReference<AudioMixer>(this, &AudioMixer::queueReplicatedAudioPacket)
     );
+    packetReceiver.registerListener(PacketType::DownstreamAmbisonicBed,
+        PacketReceiver::makeUnsourcedListenerReference<AudioMixer>(this, &AudioMixer::handleDownstreamAmbisonicBedPacket));
 
     connect(nodeList.data(), &NodeList::nodeKilled, this, &AudioMixer::handleNodeKilled);
 }
 
 void AudioMixer::aboutToFinish() {
+    // don't leave a trace capture half written
+    _traceCaptureWrite.waitForFinished();
+
+    DependencyManager::get<ResourceManager>()->cleanup();
+
+    DependencyManager::destroy<SoundCache>();
+    DependencyManager::destroy<ResourceCacheSharedItems>();
+    DependencyManager::destroy<ResourceManager>();
+
     DependencyManager::destroy<PluginManager>();
 }
 
 void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
-    if (message->getType() == PacketType::SilentAudioFrame) {
-        _numSilentPackets++;
-    }
+    _incomingPackets.push(message, node);
+}
+
+void AudioMixer::queueIncomingPackets() {
+    _incomingPackets.take(_takenPackets);
+
+    for (auto& entry : _takenPackets) {
+        auto& message = entry.first;
+        auto& node = entry.second;
+
+        if (message->getType() == PacketType::SilentAudioFrame) {
+            _numSilentPackets++;
+        }
 
-    getOrCreateClientData(node.data())->queuePacket(message, node);
+        getOrCreateClientData(node.data())->queuePacket(message, node);
+    }
+    _takenPackets.clear();
 }
 
 void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> message) {
@@ -163,6 +216,114 @@ void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> mess
     getOrCreateClientData(replicatedNode.data())->queuePacket(replicatedMessage, replicatedNode);
 }
 
+void AudioMixer::handleDownstreamAmbisonicBedPacket(QSharedPointer<ReceivedMessage> message) {
+    // the bed is non-sourced, only take it from the upstream mixers of this mixer
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto upstreamMixer = nodeList->nodeMatchingPredicate([&](const SharedNodePointer& node) {
+        return node->getType() == NodeType::UpstreamAudioMixer &&
+            node->getPublicSocket() == message->getSenderSockAddr();
+    });
+    if (!upstreamMixer) {
+        return;
+    }
+
+    _workerSharedData.upstreamBed.queueFrame(message->getMessage());
+}
+
+bool AudioMixer::isNearDownstreamZone(const Node& downstreamNode, const glm::vec3& position) {
+    auto downstreamZone = downstreamZoneFor(downstreamNode);
+    if (!downstreamZone) {
+        return false;
+    }
+    const AABox& area = _audioZones[downstreamZone->zone].area;
+    glm::vec3 closest = glm::clamp(position, area.getMinimumPoint(), area.getMaximumPoint());
+    return glm::distance(position, closest) <= _downstreamNearFieldDistance;
+}
+
+const AudioMixer::DownstreamZone* AudioMixer::downstreamZoneFor(const Node& downstreamNode) {
+    for (const auto& downstreamZone : _downstreamZones) {
+        if (downstreamZone.sockAddr == downstreamNode.getPublicSocket()) {
+            return &downstreamZone;
+        }
+    }
+    return nullptr;
+}
+
+void AudioMixer::sendDownstreamBeds() {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    std::vector<std::pair<SharedNodePointer, const DownstreamZone*>> downstreamNodes;
+    nodeList->eachMatchingNode([&](const SharedNodePointer& node) {
+        return node->getType() == NodeType::DownstreamAudioMixer && node->getActiveSocket();
+    }, [&](const SharedNodePointer& node) {
+        auto downstreamZone = downstreamZoneFor(*node);
+        if (downstreamZone) {
+            downstreamNodes.emplace_back(node, downstreamZone);
+        }
+    });
+
+    for (auto& downstream : downstreamNodes) {
+        auto& downstreamNode = downstream.first;
+        auto downstreamZone = downstream.second;
+
+        // the far field is heard from the center of the zone
+        const AABox& area = _audioZones[downstreamZone->zone].area;
+        glm::vec3 center = area.getCorner() + 0.5f * area.getDimensions();
+
+        float bed[AudioAmbisonicBed::NUM_SAMPLES] = {};
+        int numSources = 0;
+        nodeList->eachNode([&](const SharedNodePointer& node) {
+            auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+
+            // the replicated agents are already sent raw to every downstream mixer, as are the agents near the zone
+            // (see AudioMixerClientData::optionallyReplicatePacket), and the upstream agents are not this mixer's
+            if (!data || node->isReplicated() || node->isUpstream() || !data->getAvatarAudioStream() ||
+                isNearDownstreamZone(*downstreamNode, data->getAvatarAudioStream()->getPosition())) {
+                return;
+            }
+
+            for (auto& stream : data->getAudioStreams()) {
+                if (!stream->lastPopSucceeded() || stream->getLastPopOutputLoudness() == 0.0f) {
+                    continue;
+                }
+
+                glm::vec3 relativePosition = stream->getPosition() - center;
+                float distance = glm::max(glm::length(relativePosition), EPSILON);
+                float gain = computeGain(1.0f, 1.0f, center, *stream, relativePosition, distance);
+                if (gain == 0.0f) {
+                    continue;
+                }
+
+                // stereo sources go into the bed folded down to mono
+                int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+                auto popOutput = stream->getLastPopOutput();
+                if (stream->isStereo()) {
+                    popOutput.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+                    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+                        samples[i] = (int16_t)(((int)samples[2 * i] + (int)samples[2 * i + 1]) / 2);
+                    }
+                } else {
+                    popOutput.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                }
+                AudioAmbisonicBed::encodeSource(samples, relativePosition, gain, bed);
+                ++numSources;
+            }
+        });
+
+        // the downstream mixer fills the gaps with silence
+        if (numSources == 0) {
+            continue;
+        }
+
+        QByteArray encodedBed;
+        AudioAmbisonicBed::encode(bed, encodedBed);
+        auto packet = NLPacket::create(PacketType::DownstreamAmbisonicBed, encodedBed.size());
+        packet->write(encodedBed);
+        nodeList->sendUnreliablePacket(*packet, *downstreamNode);
+        ++_numDownstreamBeds;
+    }
+}
+
 void AudioMixer::handleMuteEnvironmentPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     auto nodeList = DependencyManager::get<NodeList>();
 
@@ -273,12 +434,10 @@ void AudioMixer::sendStatsPacket() {
         return;
     }
 
-#ifdef DEBUG_EVENT_QUEUE
     QJsonObject qtStats;
 
     _slavePool.queueStats(qtStats);
     statsObject["audio_thread_event_queue"] = qtStats;
-#endif
 
     // general stats
     statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == DISABLE_STATIC_JITTER_FRAMES;
@@ -312,6 +471,26 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
 
+    // per-phase timing distributions, to catch the frames that go over budget
+    QJsonObject timingHistograms;
+    timingHistograms["frame"] = _frameTimeHistogram.toJson("usecs");
+    timingHistograms["packets"] = _stats.packetsTime.toJson("nsecs");
+    timingHistograms["prepare_mix"] = _stats.prepareMixTime.toJson("nsecs");
+    timingHistograms["add_streams"] = _stats.addStreamsTime.toJson("nsecs");
+    timingHistograms["encode"] = _stats.encodeTime.toJson("nsecs");
+    timingHistograms["send"] = _stats.sendTime.toJson("nsecs");
+    statsObject["timing_histograms"] = timingHistograms;
+
+    // the frames are 10ms apart, the buckets are around that
+    static const std::vector<quint64> FRAME_TIME_BUCKETS_USECS { 1000, 2500, 5000, 7500, 10000, 15000, 20000, 50000 };
+    _metrics.addHistogram("audio_mixer_frame_seconds", _frameTimeHistogram, FRAME_TIME_BUCKETS_USECS, 1.0e-6);
+    _metrics.setGauge("audio_mixer_trailing_mix_ratio", _trailingMixRatio);
+    _metrics.setGauge("audio_mixer_throttling_ratio", _throttlingRatio);
+    _metrics.setGauge("audio_mixer_streams", (float)_stats.sumStreams / (float)_numStatFrames);
+    _metrics.setGauge("audio_mixer_listeners", (float)_stats.sumListeners / (float)_numStatFrames);
+    _metrics.setGauge("audio_mixer_silent_listeners", (float)_stats.sumListenersSilent / (float)_numStatFrames);
+    _frameTimeHistogram.reset();
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -329,6 +508,18 @@ void AudioMixer::sendStatsPacket() {
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_spatialization_cache_hits"] = (int)(_stats.spatializationCacheHits / (float)_numStatFrames);
+    mixStats["1_spatialization_cache_renders"] = (int)(_stats.spatializationCacheRenders / (float)_numStatFrames);
+    mixStats["1_spatialization_cache_entries"] = (int)_workerSharedData.spatializationCache.size();
+    mixStats["1_ambisonic_bed_mixes"] = (int)(_stats.ambisonicBedMixes / (float)_numStatFrames);
+    mixStats["1_ambisonic_bed_sources"] = (int)(_stats.ambisonicBedSources / (float)_numStatFrames);
+    mixStats["1_culled_streams"] = (int)(_stats.culledStreams / (float)_numStatFrames);
+    mixStats["1_premixed_streams"] = (int)(_stats.premixedStreams / (float)_numStatFrames);
+    mixStats["1_cluster_premixes"] = (int)(_stats.clusterPremixes / (float)_numStatFrames);
+    mixStats["1_cluster_renders"] = (int)(_stats.clusterRenders / (float)_numStatFrames);
+    mixStats["1_source_clusters"] = _workerSharedData.sourceClusters.numClusters();
+    mixStats["1_upstream_bed_mixes"] = (int)(_stats.upstreamBedMixes / (float)_numStatFrames);
+    mixStats["1_downstream_beds"] = (float)_numDownstreamBeds / (float)_numStatFrames;
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
@@ -346,7 +537,7 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["mix_stats"] = mixStats;
 
-    _numStatFrames = _numSilentPackets = 0;
+    _numStatFrames = _numSilentPackets = _numDownstreamBeds = 0;
     _stats.reset();
 
     // add stats for each listerner
@@ -419,8 +610,11 @@ void AudioMixer::start() {
     // mix state
     unsigned int frame = 1;
 
+    static SharedCounter frames("audio.frames");
+
     while (!_isFinished) {
         auto ticTimer = _ticTiming.timer();
+        frames.increment();
 
         if (_startFrameTimestamp.time_since_epoch().count() == 0) {
             _startFrameTimestamp = _idealFrameTimestamp = p_high_resolution_clock::now();
@@ -428,7 +622,11 @@ void AudioMixer::start() {
             auto timer = _checkTimeTiming.timer();
             auto frameDuration = timeFrame();
             throttle(frameDuration, frame);
+            _frameTimeHistogram.record(frameDuration.count());
         }
+        _workerSharedData.mixRatio = _trailingMixRatio;
+
+        updateTraceCapture();
 
         auto frameTimer = _frameTiming.timer();
 
@@ -439,6 +637,8 @@ void AudioMixer::start() {
             // first clear the concurrent vector of added streams that the slaves will add to when they process packets
             _workerSharedData.addedStreams.clear();
 
+            queueIncomingPackets();
+
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 _slavePool.processPackets(cbegin, cend);
             });
@@ -456,6 +656,42 @@ void AudioMixer::start() {
             QCoreApplication::processEvents();
         }
 
+        // render the zone reverbs the listeners share, from the frames the slaves just popped
+        if (_isZoneReverbShared) {
+            auto& zoneReverb = _workerSharedData.zoneReverb;
+            zoneReverb.beginFrame();
+            nodeList->eachNode([&](const SharedNodePointer& node) {
+                auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+                if (data) {
+                    for (auto& stream : data->getAudioStreams()) {
+                        zoneReverb.addSource(*stream);
+                    }
+                }
+            });
+            zoneReverb.render();
+        }
+
+        // the far field of the upstream mixer, for the listeners of this one, and the far field of this mixer
+        // for the downstream mixers
+        _workerSharedData.upstreamBed.beginFrame();
+        if (hasDownstreamZones()) {
+            sendDownstreamBeds();
+        }
+
+        // group the sources that are heard this frame, for the slaves to cull and pre-mix
+        auto& sourceClusters = _workerSharedData.sourceClusters;
+        sourceClusters.beginFrame();
+        if (sourceClusters.isEnabled()) {
+            nodeList->eachNode([&](const SharedNodePointer& node) {
+                auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+                if (data) {
+                    for (auto& stream : data->getAudioStreams()) {
+                        sourceClusters.addSource(*stream);
+                    }
+                }
+            });
+        }
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
@@ -473,6 +709,12 @@ void AudioMixer::start() {
             slave.stats.reset();
         });
 
+        // drop cached renders for sources and cells nobody has heard in a while
+        const unsigned int SPATIALIZATION_CACHE_PURGE_INTERVAL = 100;
+        if (frame % SPATIALIZATION_CACHE_PURGE_INTERVAL == 0) {
+            _workerSharedData.spatializationCache.purge(frame);
+        }
+
         ++frame;
         ++_numStatFrames;
 
@@ -485,6 +727,41 @@ void AudioMixer::start() {
     }
 }
 
+void AudioMixer::requestTraceCapture(int) {
+    _isTraceCaptureRequested = true;
+}
+
+void AudioMixer::updateTraceCapture() {
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (!tracer) {
+        return;
+    }
+
+    if (_isTraceCaptureRequested.exchange(false) && _traceCaptureFramesLeft == 0) {
+        if (tracer->isEnabled()) {
+            qCDebug(audio) << "Ignoring trace capture request, tracing is already running";
+        } else {
+            qCDebug(audio) << "Starting trace capture of" << TRACE_CAPTURE_FRAMES << "frames";
+            tracer->startTracing();
+            _traceCaptureFramesLeft = TRACE_CAPTURE_FRAMES;
+        }
+        return;
+    }
+
+    if (_traceCaptureFramesLeft > 0 && --_traceCaptureFramesLeft == 0) {
+        tracer->stopTracing();
+
+        QString traceFile = QDir::tempPath() + QString("/audio-mixer-%1-{DATE}_{TIME}.json.gz")
+            .arg(QCoreApplication::applicationPid());
+        qCDebug(audio) << "Writing trace capture to" << traceFile;
+
+        // compressing the capture takes a while, keep it off the mix thread
+        _traceCaptureWrite = QtConcurrent::run([tracer, traceFile] {
+            tracer->serialize(traceFile);
+        });
+    }
+}
+
 chrono::microseconds AudioMixer::timeFrame() {
     // advance the next frame
     auto now = p_high_resolution_clock::now();
@@ -556,6 +833,23 @@ void AudioMixer::clearDomainSettings() {
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _isZoneReverbShared = false;
+    _ambisonicBedDistance = 0.0f;
+    _downstreamZones.clear();
+    _downstreamNearFieldDistance = DEFAULT_DOWNSTREAM_NEAR_FIELD_DISTANCE;
+    _workerSharedData.upstreamBed.clear();
+    _workerSharedData.zoneReverb.clear();
+
+    auto& spatializationCache = _workerSharedData.spatializationCache;
+    spatializationCache.setEnabled(false);
+    spatializationCache.setCellSize(AudioSpatializationCache::DEFAULT_CELL_SIZE);
+    spatializationCache.setNearFieldDistance(AudioSpatializationCache::DEFAULT_NEAR_FIELD_DISTANCE);
+    spatializationCache.clear();
+
+    auto& sourceClusters = _workerSharedData.sourceClusters;
+    sourceClusters.setEnabled(false);
+    sourceClusters.setCellSize(AudioSourceClusters::DEFAULT_CELL_SIZE);
+    sourceClusters.setPremixDistance(AudioSourceClusters::DEFAULT_PREMIX_DISTANCE);
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -687,6 +981,83 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString SHARED_ZONE_REVERB = "shared_zone_reverb";
+        if (audioEnvGroupObject[SHARED_ZONE_REVERB].isBool()) {
+            _isZoneReverbShared = audioEnvGroupObject[SHARED_ZONE_REVERB].toBool();
+            qCDebug(audio) << "Zone reverb rendered by the" << (_isZoneReverbShared ? "mixer" : "clients");
+        }
+
+        auto& spatializationCache = _workerSharedData.spatializationCache;
+
+        const QString SPATIALIZATION_CACHE_ENABLED = "spatialization_cache_enabled";
+        if (audioEnvGroupObject[SPATIALIZATION_CACHE_ENABLED].isBool()) {
+            bool enabled = audioEnvGroupObject[SPATIALIZATION_CACHE_ENABLED].toBool();
+            spatializationCache.setEnabled(enabled);
+            qCDebug(audio) << "Spatialization cache" << (enabled ? "enabled" : "disabled");
+        }
+
+        const QString SPATIALIZATION_CELL_SIZE = "spatialization_cell_size";
+        if (audioEnvGroupObject[SPATIALIZATION_CELL_SIZE].isString()) {
+            bool ok = false;
+            float cellSize = audioEnvGroupObject[SPATIALIZATION_CELL_SIZE].toString().toFloat(&ok);
+            if (ok && cellSize > 0.0f) {
+                spatializationCache.setCellSize(cellSize);
+                qCDebug(audio) << "Spatialization cell size changed to" << cellSize;
+            }
+        }
+
+        const QString SPATIALIZATION_NEAR_FIELD_DISTANCE = "spatialization_near_field_distance";
+        if (audioEnvGroupObject[SPATIALIZATION_NEAR_FIELD_DISTANCE].isString()) {
+            bool ok = false;
+            float nearFieldDistance = audioEnvGroupObject[SPATIALIZATION_NEAR_FIELD_DISTANCE].toString().toFloat(&ok);
+            if (ok && nearFieldDistance >= 0.0f) {
+                spatializationCache.setNearFieldDistance(nearFieldDistance);
+                qCDebug(audio) << "Spatialization near-field distance changed to" << nearFieldDistance;
+            }
+        }
+
+        auto& sourceClusters = _workerSharedData.sourceClusters;
+
+        const QString SOURCE_CLUSTERS_ENABLED = "source_clusters_enabled";
+        if (audioEnvGroupObject[SOURCE_CLUSTERS_ENABLED].isBool()) {
+            bool enabled = audioEnvGroupObject[SOURCE_CLUSTERS_ENABLED].toBool();
+            sourceClusters.setEnabled(enabled);
+            qCDebug(audio) << "Source clusters" << (enabled ? "enabled" : "disabled");
+        }
+
+        const QString SOURCE_CLUSTER_SIZE = "source_cluster_size";
+        if (audioEnvGroupObject[SOURCE_CLUSTER_SIZE].isString()) {
+            bool ok = false;
+            float clusterSize = audioEnvGroupObject[SOURCE_CLUSTER_SIZE].toString().toFloat(&ok);
+            if (ok && clusterSize > 0.0f) {
+                sourceClusters.setCellSize(clusterSize);
+                qCDebug(audio) << "Source cluster size changed to" << clusterSize;
+            }
+        }
+
+        const QString SOURCE_CLUSTER_PREMIX_DISTANCE = "source_cluster_premix_distance";
+        if (audioEnvGroupObject[SOURCE_CLUSTER_PREMIX_DISTANCE].isString()) {
+            bool ok = false;
+            float premixDistance = audioEnvGroupObject[SOURCE_CLUSTER_PREMIX_DISTANCE].toString().toFloat(&ok);
+            if (ok && premixDistance >= 0.0f) {
+                sourceClusters.setPremixDistance(premixDistance);
+                qCDebug(audio) << "Source cluster pre-mix distance changed to" << premixDistance;
+            }
+        }
+
+        // cached renders were made for the old cells and clusters
+        spatializationCache.clear();
+
+        const QString AMBISONIC_BED_DISTANCE = "ambisonic_bed_distance";
+        if (audioEnvGroupObject[AMBISONIC_BED_DISTANCE].isString()) {
+            bool ok = false;
+            float bedDistance = audioEnvGroupObject[AMBISONIC_BED_DISTANCE].toString().toFloat(&ok);
+            if (ok && bedDistance >= 0.0f) {
+                _ambisonicBedDistance = bedDistance;
+                qCDebug(audio) << "Ambisonic bed distance changed to" << _ambisonicBedDistance;
+            }
+        }
+
         const QString AUDIO_ZONES = "zones";
         if (audioEnvGroupObject[AUDIO_ZONES].isObject()) {
             const QJsonObject& zones = audioEnvGroupObject[AUDIO_ZONES].toObject();
@@ -801,12 +1172,56 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
                         settings.wetLevel = wetLevel;
 
                         _zoneReverbSettings.push_back(settings);
+                        _workerSharedData.zoneReverb.addZone(itZone->area, reverbTime, wetLevel);
 
                         qCDebug(audio) << "Added Reverb:" << itZone->name << reverbTime << wetLevel;
                     }
                 }
             }
         }
+
+        const QString DOWNSTREAM_ZONES = "downstream_zones";
+        if (audioEnvGroupObject[DOWNSTREAM_ZONES].isArray()) {
+            const QJsonArray& downstreamZones = audioEnvGroupObject[DOWNSTREAM_ZONES].toArray();
+
+            const QString ADDRESS = "address";
+            const QString PORT = "port";
+            const QString ZONE = "zone";
+            for (int i = 0; i < downstreamZones.count(); ++i) {
+                QJsonObject downstreamObject = downstreamZones[i].toObject();
+
+                if (downstreamObject.contains(ADDRESS) &&
+                    downstreamObject.contains(PORT) &&
+                    downstreamObject.contains(ZONE)) {
+
+                    bool ok;
+                    auto itZone = find_if(begin(_audioZones), end(_audioZones), [&](const ZoneDescription& description) {
+                        return description.name == downstreamObject.value(ZONE).toString();
+                    });
+                    quint16 port = (quint16)downstreamObject.value(PORT).toString().toInt(&ok);
+
+                    if (ok && itZone != end(_audioZones)) {
+                        // the same address as the downstream server in the broadcasting settings
+                        DownstreamZone downstreamZone;
+                        downstreamZone.sockAddr = HifiSockAddr(downstreamObject.value(ADDRESS).toString(), port, true);
+                        downstreamZone.zone = itZone - begin(_audioZones);
+
+                        _downstreamZones.push_back(downstreamZone);
+                        qCDebug(audio) << "Added downstream zone:" << itZone->name << downstreamZone.sockAddr;
+                    }
+                }
+            }
+        }
+
+        const QString DOWNSTREAM_NEAR_FIELD_DISTANCE = "downstream_near_field_distance";
+        if (audioEnvGroupObject[DOWNSTREAM_NEAR_FIELD_DISTANCE].isString()) {
+            bool ok = false;
+            float nearFieldDistance = audioEnvGroupObject[DOWNSTREAM_NEAR_FIELD_DISTANCE].toString().toFloat(&ok);
+            if (ok && nearFieldDistance >= 0.0f) {
+                _downstreamNearFieldDistance = nearFieldDistance;
+                qCDebug(audio) << "Downstream near-field distance changed to" << _downstreamNearFieldDistance;
+            }
+        }
     }
 }
 
@@ -12,9 +12,16 @@
 #ifndef hifi_AudioMixer_h
 #define hifi_AudioMixer_h
 
+#include <atomic>
+
+#include <QtCore/QFuture>
+
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
+#include <HifiSockAddr.h>
+#include <LatencyHistogram.h>
+#include <ReceivedMessageQueue.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 
@@ -49,6 +56,10 @@ public:
         float reverbTime;
         float wetLevel;
     };
+    struct DownstreamZone {
+        HifiSockAddr sockAddr;
+        int zone;
+    };
 
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
@@ -56,6 +67,9 @@ public:
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const std::vector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+    static bool isZoneReverbShared() { return _isZoneReverbShared; }
+    // the sources further than this from listeners asking for it go to their ambisonic bed, 0 if there is none
+    static float getAmbisonicBedDistance() { return _ambisonicBedDistance; }
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
     static bool shouldReplicateTo(const Node& from, const Node& to) {
@@ -64,6 +78,11 @@ public:
                to.getLocalSocket() != from.getLocalSocket();
     }
 
+    // a downstream mixer serving the listeners of a zone gets the streams near the zone replicated,
+    // and the other sources of this mixer in a far-field bed
+    static bool hasDownstreamZones() { return !_downstreamZones.empty(); }
+    static bool isNearDownstreamZone(const Node& downstreamNode, const glm::vec3& position);
+
     virtual void aboutToFinish() override;
     
 public slots:
@@ -76,7 +95,9 @@ private slots:
     void handleNodeMuteRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleNodeKilled(SharedNodePointer killedNode);
     void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void handleDownstreamAmbisonicBedPacket(QSharedPointer<ReceivedMessage> packet);
 
+    // called directly on the receiving thread
     void queueAudioPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> packet);
     void removeHRTFsForFinishedInjector(const QUuid& streamID);
@@ -87,10 +108,20 @@ private:
     std::chrono::microseconds timeFrame();
     void throttle(std::chrono::microseconds frameDuration, int frame);
 
+    // trace capture, requested with SIGUSR1 where signals are available
+    static void requestTraceCapture(int);
+    void updateTraceCapture();
+
     AudioMixerClientData* getOrCreateClientData(Node* node);
+    // hands the packets queued by queueAudioPacket to their nodes
+    void queueIncomingPackets();
 
     QString percentageForMixStats(int counter);
 
+    // mixes and sends the far-field beds of the downstream mixers that serve a zone
+    static const DownstreamZone* downstreamZoneFor(const Node& downstreamNode);
+    void sendDownstreamBeds();
+
     void parseSettingsObject(const QJsonObject& settingsObject);
     void clearDomainSettings();
 
@@ -101,9 +132,18 @@ private:
     float _throttlingRatio { 0.0f };
 
     int _numSilentPackets { 0 };
+    int _numDownstreamBeds { 0 };
+
+    ReceivedMessageQueue _incomingPackets;
+    std::vector<ReceivedMessageQueue::Entry> _takenPackets;
 
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
+    LatencyHistogram _frameTimeHistogram; // usecs
+
+    static std::atomic<bool> _isTraceCaptureRequested;
+    int _traceCaptureFramesLeft { 0 };
+    QFuture<void> _traceCaptureWrite;
 
     AudioMixerSlavePool _slavePool { _workerSharedData };
 
@@ -147,6 +187,10 @@ private:
     static std::vector<ZoneDescription> _audioZones;
     static std::vector<ZoneSettings> _zoneSettings;
     static std::vector<ReverbSettings> _zoneReverbSettings;
+    static bool _isZoneReverbShared;
+    static float _ambisonicBedDistance;
+    static std::vector<DownstreamZone> _downstreamZones;
+    static float _downstreamNearFieldDistance;
 
     float _throttleStartTarget = 0.9f;
     float _throttleBackoffTarget = 0.44f;
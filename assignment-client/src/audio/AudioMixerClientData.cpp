@@ -11,6 +11,7 @@
 
 #include "AudioMixerClientData.h"
 
+#include <limits>
 #include <random>
 
 #include <glm/common.hpp>
@@ -18,13 +19,17 @@
 #include <QtCore/QDebug>
 #include <QtCore/QJsonArray>
 
+#include <NumericalConstants.h>
+#include <udt/Constants.h>
 #include <udt/PacketHeaders.h>
 #include <UUID.h>
 
+#include "AudioEmitterProperties.h"
 #include "InjectedAudioStream.h"
 
 #include "AudioLogging.h"
 #include "AudioHelpers.h"
+#include "AudioEmitterStream.h"
 #include "AudioMixer.h"
 
 AudioMixerClientData::AudioMixerClientData(const QUuid& nodeID, Node::LocalID nodeLocalID) :
@@ -62,23 +67,36 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
     assert(_packetQueue.empty() || node);
     _packetQueue.node.clear();
 
+    auto processMicPacket = [&](const QSharedPointer<ReceivedMessage>& packet) {
+        processStreamPacket(*packet, addedStreams);
+
+        optionallyReplicatePacket(*packet, *node);
+    };
+
     while (!_packetQueue.empty()) {
         auto& packet = _packetQueue.front();
 
         switch (packet->getType()) {
             case PacketType::MicrophoneAudioNoEcho:
             case PacketType::MicrophoneAudioWithEcho:
-            case PacketType::InjectAudio:
-            case PacketType::SilentAudioFrame: {
+            case PacketType::SilentAudioFrame:
+                if (_fecEncoder.getGroupSize() > 0 && !node->isUpstream()) {
+                    // the mic stream is protected, packets go through the decoder in case one has to be rebuilt
+                    _fecDecoder.handleAudioPacket(packet, processMicPacket);
+                    break;
+                }
+                // FALLTHRU
+            case PacketType::InjectAudio: {
                 if (node->isUpstream()) {
                     setupCodecForReplicatedAgent(packet);
                 }
 
-                processStreamPacket(*packet, addedStreams);
-
-                optionallyReplicatePacket(*packet, *node);
+                processMicPacket(packet);
                 break;
             }
+            case PacketType::AudioParity:
+                _fecDecoder.handleParityPacket(*packet, processMicPacket);
+                break;
             case PacketType::AudioStreamStats: {
                 parseData(*packet);
                 break;
@@ -107,6 +125,9 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
             case PacketType::StopInjector:
                 parseStopInjectorPacket(packet);
                 break;
+            case PacketType::AudioEmitter:
+                parseAudioEmitterPacket(*packet, node, addedStreams);
+                break;
             default:
                 Q_UNREACHABLE();
         }
@@ -129,8 +150,14 @@ bool isReplicatedPacket(PacketType packetType) {
 
 void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, const Node& node) {
 
+    // the replicated nodes go to every downstream mixer, the others only to the mixers serving a zone they are near
+    // (the injectors of an agent go along with its avatar)
+    bool isReplicated = node.isReplicated();
+    bool mayBeNearDownstreamZone = !isReplicated && !node.isUpstream() && AudioMixer::hasDownstreamZones() &&
+        getAvatarAudioStream();
+
     // first, make sure that this is a packet from a node we are supposed to replicate
-    if (node.isReplicated()) {
+    if (isReplicated || mayBeNearDownstreamZone) {
 
         // now make sure it's a packet type that we want to replicate
 
@@ -148,11 +175,12 @@ void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, c
         }
 
         std::unique_ptr<NLPacket> packet;
-        auto nodeList = DependencyManager::get<NodeList>();
+        auto& nodeList = DependencyManager::getRef<NodeList>();
 
         // enumerate the downstream audio mixers and send them the replicated version of this packet
-        nodeList->unsafeEachNode([&](const SharedNodePointer& downstreamNode) {
-            if (AudioMixer::shouldReplicateTo(node, *downstreamNode)) {
+        nodeList.unsafeEachNode([&](const SharedNodePointer& downstreamNode) {
+            if (AudioMixer::shouldReplicateTo(node, *downstreamNode) && (isReplicated ||
+                AudioMixer::isNearDownstreamZone(*downstreamNode, getAvatarAudioStream()->getPosition()))) {
                 // construct the packet only once, if we have any downstream audio mixers to send to
                 if (!packet) {
                     // construct an NLPacket to send to the replicant that has the contents of the received packet
@@ -166,7 +194,7 @@ void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, c
                     packet->write(message.getMessage());
                 }
                 
-                nodeList->sendUnreliablePacket(*packet, *downstreamNode);
+                nodeList.sendUnreliablePacket(*packet, *downstreamNode);
             }
         });
     }
@@ -182,6 +210,22 @@ void AudioMixerClientData::negotiateAudioFormat(ReceivedMessage& message, const
     }
     const std::pair<QString, CodecPluginPointer> codec = AudioMixer::negotiateCodec(codecs);
 
+    // older clients don't ask for forward error correction
+    quint8 fecGroupSize = 0;
+    if (message.getBytesLeftToRead() >= (qint64)sizeof(fecGroupSize)) {
+        message.readPrimitive(&fecGroupSize);
+    }
+    _fecEncoder.setGroupSize(fecGroupSize);
+    // anything held was encoded for the previous codec
+    _fecDecoder.reset([](const QSharedPointer<ReceivedMessage>&) {});
+
+    // older clients don't ask for an ambisonic bed either
+    quint8 wantsAmbisonicBed = 0;
+    if (message.getBytesLeftToRead() >= (qint64)sizeof(wantsAmbisonicBed)) {
+        message.readPrimitive(&wantsAmbisonicBed);
+    }
+    _hasAmbisonicBed = wantsAmbisonicBed != 0 && AudioMixer::getAmbisonicBedDistance() > 0.0f;
+
     setupCodec(codec.second, codec.first);
     sendSelectAudioFormat(node, codec.first);
 }
@@ -515,6 +559,10 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
             // we don't have this injected stream yet, so add it
             auto injectorStream = new InjectedAudioStream(streamIdentifier, isStereo, AudioMixer::getStaticJitterFrames());
 
+            // nobody answers an injector, it can afford a deeper buffer than the voices to starve less
+            static const float INJECTOR_TARGET_LATENCY_MS = 60.0f;
+            injectorStream->setTargetLatencyMs(INJECTOR_TARGET_LATENCY_MS);
+
 #if INJECTORS_SUPPORT_CODECS
             injectorStream->setupCodec(_codec, _selectedCodecName, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
             qCDebug(audio) << "creating new injectorStream... codec:" << _selectedCodecName << "isStereo:" << isStereo;
@@ -547,7 +595,58 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
     }
 }
 
+void AudioMixerClientData::parseAudioEmitterPacket(ReceivedMessage& message, const SharedNodePointer& node,
+                                                   ConcurrentAddedStreams& addedStreams) {
+    // the emitters aren't replicated, and each node only gets a bounded share of the mixer's work
+    static const size_t MAX_EMITTERS_PER_NODE = 64;
+    if (node->isUpstream()) {
+        return;
+    }
+
+    AudioEmitterProperties properties;
+    properties.read(message);
+    if (properties.emitterID.isNull()) {
+        return;
+    }
+
+    auto it = _emitterStreams.find(properties.emitterID);
+    if (properties.isRemoved) {
+        if (it != _emitterStreams.end()) {
+            removeEmitterStream(properties.emitterID);
+        }
+    } else if (it != _emitterStreams.end()) {
+        it->second->setProperties(properties);
+    } else if (_emitterStreams.size() < MAX_EMITTERS_PER_NODE) {
+        auto stream = std::make_shared<AudioEmitterStream>(properties);
+        _emitterStreams[properties.emitterID] = stream;
+        _audioStreams.push_back(stream);
+        addedStreams.push_back(AddedStream(getNodeID(), getNodeLocalID(), stream->getStreamIdentifier(), stream.get()));
+    }
+}
+
+void AudioMixerClientData::removeEmitterStream(const QUuid& emitterID) {
+    _emitterStreams.erase(emitterID);
+
+    auto it = std::find_if(_audioStreams.begin(), _audioStreams.end(), [&](const SharedStreamPointer& stream) {
+        return stream->getStreamIdentifier() == emitterID;
+    });
+    if (it != _audioStreams.end()) {
+        _audioStreams.erase(it);
+        emit injectorStreamFinished(emitterID);
+    }
+}
+
 int AudioMixerClientData::checkBuffersBeforeFrameSend() {
+    // the emitters write their frame before it is popped with the others
+    for (auto emitterIt = _emitterStreams.begin(); emitterIt != _emitterStreams.end();) {
+        auto emitterID = emitterIt->first;
+        auto stream = emitterIt->second;
+        ++emitterIt;
+        if (!stream->writeNextFrame()) {
+            removeEmitterStream(emitterID);
+        }
+    }
+
     auto it = _audioStreams.begin();
     while (it != _audioStreams.end()) {
         SharedStreamPointer stream = *it;
@@ -760,10 +859,37 @@ void AudioMixerClientData::handleMismatchAudioFormat(SharedNodePointer node, con
 void AudioMixerClientData::sendSelectAudioFormat(SharedNodePointer node, const QString& selectedCodecName) {
     auto replyPacket = NLPacket::create(PacketType::SelectedAudioFormat);
     replyPacket->writeString(selectedCodecName);
+    replyPacket->writePrimitive((quint8)_fecEncoder.getGroupSize());
+    replyPacket->writePrimitive((quint8)_hasAmbisonicBed);
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->sendPacket(std::move(replyPacket), *node);
 }
 
+void AudioMixerClientData::updateEncoding(const Node& node, float mixRatio) {
+    if (!_encoder) {
+        return;
+    }
+
+    AudioEncodingController::Inputs inputs;
+    inputs.lossRate = _downstreamAudioStreamStats._packetStreamWindowStats.getLostRate();
+    // the estimate is in packets per second
+    int64_t estimatedBandwidth = (int64_t)node.getConnectionStats().estimatedBandwith * udt::MAX_PACKET_SIZE * BITS_IN_BYTE;
+    inputs.estimatedBandwidth = (int)std::min(estimatedBandwidth, (int64_t)std::numeric_limits<int>::max());
+    inputs.downstreamShare = (int)(getDownstreamShareKbps() * BYTES_PER_KILOBIT * BITS_IN_BYTE);
+    inputs.mixRatio = mixRatio;
+
+    if (_encodingController.update(inputs)) {
+        applyEncodingSettings();
+    }
+}
+
+void AudioMixerClientData::applyEncodingSettings() {
+    const auto& settings = _encodingController.getSettings();
+    _encoder->setBitrate(settings.bitrate);
+    _encoder->setComplexity(settings.complexity);
+    _encoder->setExpectedPacketLossPercentage(settings.expectedLossPercentage);
+}
+
 void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
     static QByteArray zeros(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
     if (_shouldFlushEncoder) {
@@ -776,6 +902,22 @@ void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
     _shouldFlushEncoder = false;
 }
 
+int AudioMixerClientData::nextSilentPacketFrames() {
+    // short pauses get a silent frame per frame, so that the client doesn't have silence queued up when audio resumes
+    const int SILENT_FRAMES_BEFORE_KEEPALIVES = 10;
+    const int FRAMES_PER_KEEPALIVE = 4;
+
+    ++_numSilentFrames;
+    if (_numSilentFramesAhead > 0) {
+        --_numSilentFramesAhead;
+        return 0;
+    }
+
+    int numFrames = _numSilentFrames > SILENT_FRAMES_BEFORE_KEEPALIVES ? FRAMES_PER_KEEPALIVE : 1;
+    _numSilentFramesAhead = numFrames - 1;
+    return numFrames;
+}
+
 void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& codecName) {
     cleanupCodec(); // cleanup any previously allocated coders first
     _codec = codec;
@@ -783,6 +925,7 @@ void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& c
     if (codec) {
         _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
+        applyEncodingSettings();
     }
 
     auto avatarAudioStream = getAvatarAudioStream();
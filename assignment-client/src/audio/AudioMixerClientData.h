@@ -22,6 +22,8 @@
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
+#include <AudioFEC.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -29,9 +31,12 @@
 #include <plugins/Forward.h>
 #include <plugins/CodecPlugin.h>
 
+#include "AudioEncodingController.h"
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
 
+class AudioEmitterStream;
+
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
 public:
@@ -71,6 +76,7 @@ public:
     void parseRadiusIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseSoloRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseStopInjectorPacket(QSharedPointer<ReceivedMessage> packet);
+    void parseAudioEmitterPacket(ReceivedMessage& message, const SharedNodePointer& node, ConcurrentAddedStreams& addedStreams);
 
     // attempt to pop a frame from each audio stream, and return the number of streams from this client
     int checkBuffersBeforeFrameSend();
@@ -104,10 +110,27 @@ public:
         _shouldFlushEncoder = true;
     }
     void encodeFrameOfZeros(QByteArray& encodedZeros);
+    // adapts the encoder to the stats of the mixed stream and the mix ratio of the mixer, about once a second
+    void updateEncoding(const Node& node, float mixRatio);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
+    // for a silent mix, returns the number of frames the SilentAudioFrame to send should cover,
+    // 0 if the client already has this frame from the last one
+    int nextSilentPacketFrames();
+    // the mix has audio again, the next silent frame goes out right away
+    void resetSilentFrames() { _numSilentFrames = 0; _numSilentFramesAhead = 0; }
+
     QString getCodecName() { return _selectedCodecName; }
 
+    // for the outbound mixed stream, the group size was negotiated with the codec
+    AudioFECEncoder& getFECEncoder() { return _fecEncoder; }
+
+    // the listener renders the distant sources from the ambisonic bed sent with its mix
+    bool hasAmbisonicBed() const { return _hasAmbisonicBed; }
+
+    // renders the far-field bed of the upstream mixer for a listener that doesn't take an ambisonic bed
+    AudioFOA& getUpstreamBedFOA() { return _upstreamBedFOA; }
+
     bool shouldMuteClient() { return _shouldMuteClient; }
     void setShouldMuteClient(bool shouldMuteClient) { _shouldMuteClient = shouldMuteClient; }
     glm::vec3 getPosition() { return getAvatarAudioStream() ? getAvatarAudioStream()->getPosition() : glm::vec3(0); }
@@ -123,6 +146,7 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        int cluster { -1 }; // of the source this frame, when the mixer clusters the sources
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -179,12 +203,18 @@ private:
 
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
+    // the emitters of this node hosted by the mixer, also in _audioStreams
+    std::unordered_map<QUuid, std::shared_ptr<AudioEmitterStream>> _emitterStreams;
+    void removeEmitterStream(const QUuid& emitterID);
+
     void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node);
 
     void setGainForAvatar(QUuid nodeID, float gain);
 
     bool containsValidPosition(ReceivedMessage& message) const;
 
+    void applyEncodingSettings();
+
     Streams _streams;
 
     quint16 _outgoingMixedAudioSequenceNumber;
@@ -201,8 +231,17 @@ private:
     Encoder* _encoder{ nullptr }; // for outbound mixed stream
     Decoder* _decoder{ nullptr }; // for mic stream
 
+    AudioEncodingController _encodingController; // for outbound mixed stream
+    AudioFECEncoder _fecEncoder; // for outbound mixed stream
+    AudioFECDecoder _fecDecoder; // for mic stream
+    AudioFOA _upstreamBedFOA;
+    bool _hasAmbisonicBed { false };
+
     bool _shouldFlushEncoder { false };
 
+    int _numSilentFrames { 0 }; // since the mix last had audio
+    int _numSilentFramesAhead { 0 }; // covered by the SilentAudioFrame last sent
+
     bool _shouldMuteClient { false };
     bool _requestsDomainListData { false };
 
@@ -25,6 +25,8 @@
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
 #include <udt/PacketHeaders.h>
+#include <Profile.h>
+#include <SharedCounters.h>
 #include <SharedUtil.h>
 #include <StDev.h>
 #include <UUID.h>
@@ -41,24 +43,51 @@ using AudioStreamVector = AudioMixerClientData::AudioStreamVector;
 using MixableStream = AudioMixerClientData::MixableStream;
 using MixableStreamsVector = AudioMixerClientData::MixableStreamsVector;
 
+// records the time spent in the enclosing scope into one of the per-phase timing histograms
+class PhaseTimer {
+public:
+    PhaseTimer(LatencyHistogram& histogram) : _histogram(histogram), _start(p_high_resolution_clock::now()) {}
+    ~PhaseTimer() {
+        auto elapsed = p_high_resolution_clock::now() - _start;
+        _histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+private:
+    LatencyHistogram& _histogram;
+    p_high_resolution_clock::time_point _start;
+};
+
 // packet helpers
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
+void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer,
+                   const QByteArray& encodedBed);
+void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data, int numFrames);
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
 void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 
 // mix helpers
+inline float missedFrameFadeFactor(const PositionalAudioStream& streamToAdd);
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
 inline float computeGain(float masterAvatarGain, float masterInjectorGain, const AvatarAudioStream& listeningNodeStream,
-        const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
+        const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance) {
+    return computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream.getPosition(), streamToAdd,
+                       relativePosition, distance);
+}
+inline float computeAzimuth(const glm::quat& listenerOrientation, const glm::vec3& relativePosition);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
-        const glm::vec3& relativePosition);
+        const glm::vec3& relativePosition) {
+    return computeAzimuth(listeningNodeStream.getOrientation(), relativePosition);
+}
 
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
+        PROFILE_RANGE(audio, QStringLiteral("processPackets"));
+        PhaseTimer timer(stats.packetsTime);
+
         // process packets and collect the number of streams available for this frame
+        static SharedCounter nodesProcessed("audio.nodesProcessed");
+        nodesProcessed.increment();
         stats.sumStreams += data->processPackets(_sharedData.addedStreams);
     }
 }
@@ -93,28 +122,58 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     }
 
     // send audio packets, if necessary
+    static SharedCounter listeners("audio.listeners");
+    static SharedCounter silentListeners("audio.silentListeners");
+
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
         ++stats.sumListeners;
+        listeners.increment();
 
         // mix the audio
-        bool mixHasAudio = prepareMix(node);
+        bool mixHasAudio;
+        {
+            PROFILE_RANGE(audio, QStringLiteral("prepareMix"));
+            PhaseTimer timer(stats.prepareMixTime);
+            mixHasAudio = prepareMix(node);
+        }
 
         // send audio packet
         if (mixHasAudio || data->shouldFlushEncoder()) {
             QByteArray encodedBuffer;
-            if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
-            } else {
-                // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
+            QByteArray encodedBed;
+            {
+                PROFILE_RANGE(audio, QStringLiteral("encode"));
+                PhaseTimer timer(stats.encodeTime);
+                if (mixHasAudio) {
+                    // encode the audio
+                    QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+                    data->encode(decodedBuffer, encodedBuffer);
+
+                    if (_numBedStreams > 0) {
+                        AudioAmbisonicBed::encode(_bedSamples, encodedBed);
+                        ++stats.ambisonicBedMixes;
+                    }
+                } else {
+                    // time to flush (resets shouldFlush until the next encode)
+                    data->encodeFrameOfZeros(encodedBuffer);
+                }
             }
 
-            sendMixPacket(node, *data, encodedBuffer);
+            PROFILE_RANGE(audio, QStringLiteral("send"));
+            PhaseTimer timer(stats.sendTime);
+            sendMixPacket(node, *data, encodedBuffer, encodedBed);
+            data->resetSilentFrames();
         } else {
             ++stats.sumListenersSilent;
-            sendSilentPacket(node, *data);
+            silentListeners.increment();
+
+            // once the mix has been silent for a while, a silent packet covers several frames
+            int numSilentFrames = data->nextSilentPacketFrames();
+            if (numSilentFrames > 0) {
+                PROFILE_RANGE(audio, QStringLiteral("send"));
+                PhaseTimer timer(stats.sendTime);
+                sendSilentPacket(node, *data, numSilentFrames);
+            }
         }
 
         // send environment packet
@@ -124,6 +183,9 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         const unsigned int NUM_FRAMES_PER_SEC = (int)ceil(AudioConstants::NETWORK_FRAMES_PER_SEC);
         if (data->shouldSendStats(_frame % NUM_FRAMES_PER_SEC)) {
             data->sendAudioStreamStatsPackets(node);
+
+            // and adapt the encoding of the mix to how it is received and to the load
+            data->updateEncoding(*node, _sharedData.mixRatio);
         }
     }
 }
@@ -306,19 +368,74 @@ float approximateVolume(const MixableStream& stream, const AvatarAudioStream* li
     return stream.positionalStream->getLastPopOutputTrailingLoudness() * gain;
 };
 
+void AudioMixerSlave::prepareClusters(const Node& listener, AudioMixerClientData& listenerData,
+                                      const AvatarAudioStream& listenerAudioStream) {
+    auto& sourceClusters = _sharedData.sourceClusters;
+
+    // the ambisonic bed takes the distant sources one at a time, a pre-mixed cluster could straddle its distance
+    sourceClusters.beginListener(listenerAudioStream.getPosition(), !_isMixingBed, _clusterListener);
+    _isClusterMixed.assign(sourceClusters.numClusters(), 0);
+
+    for (auto& stream : listenerData.getStreams().active) {
+        // the echo of the listener's own stream is neither culled nor pre-mixed, its cluster is mixed source by source
+        bool isEcho = stream.positionalStream == &listenerAudioStream;
+        stream.cluster = isEcho ? -1 : sourceClusters.clusterOf(stream.positionalStream);
+        if (stream.cluster == -1 ||
+            sourceClusters.getState(stream.cluster, _clusterListener) != AudioSourceClusters::Distant) {
+            continue;
+        }
+
+        // the pre-mix can only stand in for the sources this listener hears like any other listener would
+        bool isPremixable = stream.hrtf->getGainAdjustment() == HRTF_GAIN &&
+            !shouldBeRemoved(stream, _sharedData) &&
+            !shouldBeSkipped(stream, listener, listenerAudioStream, listenerData);
+        if (isPremixable) {
+            ++_clusterListener.numPremixable[stream.cluster];
+        }
+    }
+}
+
+AudioSourceClusters::State AudioMixerSlave::getClusterState(const MixableStream& mixableStream) {
+    if (!_isClustering || mixableStream.cluster == -1) {
+        return AudioSourceClusters::Near;
+    }
+
+    auto& sourceClusters = _sharedData.sourceClusters;
+    auto state = sourceClusters.getState(mixableStream.cluster, _clusterListener);
+
+    // a cluster is pre-mixed only if all of its sources can be pre-mixed for this listener
+    if (state == AudioSourceClusters::Distant &&
+        _clusterListener.numPremixable[mixableStream.cluster] <
+            (int)sourceClusters.getCluster(mixableStream.cluster).sources.size()) {
+        return AudioSourceClusters::Near;
+    }
+    return state;
+}
+
 bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
 
     // zero out the mix for this listener
     memset(_mixSamples, 0, sizeof(_mixSamples));
+    _numAddedStreams = 0;
+
+    _isMixingBed = listenerData->hasAmbisonicBed() && AudioMixer::getAmbisonicBedDistance() > 0.0f;
+    if (_isMixingBed) {
+        memset(_bedSamples, 0, sizeof(_bedSamples));
+    }
+    _numBedStreams = 0;
 
     bool isThrottling = _numToRetain != -1;
     bool isSoloing = !listenerData->getSoloedNodes().empty();
 
     auto& streams = listenerData->getStreams();
 
-    addStreams(*listener, *listenerData);
+    {
+        PROFILE_RANGE(audio, QStringLiteral("addStreams"));
+        PhaseTimer timer(stats.addStreamsTime);
+        addStreams(*listener, *listenerData);
+    }
 
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
@@ -331,16 +448,15 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 streams.inactive.push_back(move(stream));
                 ++stats.skippedToInactive;
             } else {
+                // skipped streams aren't followed, so the HRTF picks up from where the stream is now
+                updateHRTFParameters(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(),
+                                     listenerData->getMasterInjectorGain());
                 streams.active.push_back(move(stream));
                 ++stats.skippedToActive;
             }
             return true;
         }
 
-        if (!isThrottling) {
-            updateHRTFParameters(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(),
-                                 listenerData->getMasterInjectorGain());
-        }
         return false;
     });
 
@@ -357,18 +473,25 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         }
 
         if (!shouldBeInactive(stream)) {
+            // silent streams aren't followed either, the HRTF parameters are only brought up to date
+            // on the frame the stream becomes audible again
+            updateHRTFParameters(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(),
+                                 listenerData->getMasterInjectorGain());
             streams.active.push_back(move(stream));
             ++stats.inactiveToActive;
             return true;
         }
 
-        if (!isThrottling) {
-            updateHRTFParameters(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(),
-                                 listenerData->getMasterInjectorGain());
-        }
         return false;
     });
 
+    // cull and pre-mix the clusters of sources before going through the active streams one by one
+    // (a soloing listener hears its soloed sources without any attenuation)
+    _isClustering = _sharedData.sourceClusters.isEnabled() && !isSoloing;
+    if (_isClustering) {
+        prepareClusters(*listener, *listenerData, *listenerAudioStream);
+    }
+
     // Process active streams
     erase_if(streams.active, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
@@ -378,7 +501,9 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         if (isThrottling) {
             // we're throttling, so we need to update the approximate volume for any un-skipped streams
             // unless this is simply for an echo (in which case the approx volume is 1.0)
-            stream.approximateVolume = approximateVolume(stream, listenerAudioStream);
+            // culled streams go last, they are silent anyway
+            stream.approximateVolume = getClusterState(stream) == AudioSourceClusters::Culled ? 0.0f :
+                approximateVolume(stream, listenerAudioStream);
         } else {
             if (shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
                 addStream(stream, *listenerAudioStream, 0.0f, 0.0f, isSoloing);
@@ -460,6 +585,9 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         });
     }
 
+    // render whatever is left in the HRTF queue before the mix is used
+    flushHRTFRenders();
+
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
@@ -473,10 +601,33 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     stats.mixTime += mixTime.count();
 #endif
 
+    // the reverb tail of the zone goes on after its sources stopped
+    bool hasZoneReverb = AudioMixer::isZoneReverbShared() &&
+        _sharedData.zoneReverb.mixInto(listenerAudioStream->getPosition(), _mixSamples);
+
+    // the far field of the upstream mixer, the sources near this mixer's listeners come replicated
+    auto& upstreamBed = _sharedData.upstreamBed;
+    bool hasUpstreamBed = upstreamBed.hasFrame() && !isSoloing;
+    if (hasUpstreamBed) {
+        if (_isMixingBed) {
+            upstreamBed.addToBed(listenerData->getMasterAvatarGain(), _bedSamples);
+            ++_numBedStreams;
+        } else {
+            upstreamBed.render(listenerData->getUpstreamBedFOA(), listenerAudioStream->getOrientation(),
+                               listenerData->getMasterAvatarGain(), _mixSamples);
+        }
+        ++stats.upstreamBedMixes;
+    }
+
+    // nothing was added, the mix is silent and there is nothing to limit
+    if (_numAddedStreams == 0 && !hasZoneReverb && !hasUpstreamBed) {
+        return false;
+    }
+
     // check for silent audio before limiting
     // limiting uses a dither and can only guarantee abs(sample) <= 1
-    bool hasAudio = false;
-    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+    bool hasAudio = _numBedStreams > 0;
+    for (int i = 0; !hasAudio && i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
         if (_mixSamples[i] != 0.0f) {
             hasAudio = true;
             break;
@@ -494,50 +645,71 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
                                 float masterAvatarGain,
                                 float masterInjectorGain,
                                 bool isSoloing) {
+    static SharedCounter mixedStreams("audio.mixedStreams");
+    static SharedCounter culledStreams("audio.culledStreams");
+
+    auto clusterState = getClusterState(mixableStream);
+    if (clusterState == AudioSourceClusters::Culled) {
+        // the listener can't hear any source of the cluster, its HRTF starts clean if it comes back
+        mixableStream.hrtf->reset();
+        ++stats.culledStreams;
+        culledStreams.increment();
+        return;
+    }
+
     ++stats.totalMixes;
+    mixedStreams.increment();
+    ++_numAddedStreams;
 
     auto streamToAdd = mixableStream.positionalStream;
 
     // check if this is a server echo of a source back to itself
     bool isEcho = (streamToAdd == &listeningNodeStream);
 
+    // distant clusters are mixed together, and the mix is rendered once per listener cell
+    if (clusterState == AudioSourceClusters::Distant) {
+        addClusterStream(mixableStream, listeningNodeStream, masterAvatarGain, masterInjectorGain);
+        return;
+    }
+
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
+
+    // distant sources go to the ambisonic bed of listeners rendering it themselves
+    if (_isMixingBed && !isEcho && !isSoloing && !streamToAdd->isStereo() &&
+        distance > AudioMixer::getAmbisonicBedDistance()) {
+        addBedStream(mixableStream, listeningNodeStream, masterAvatarGain, masterInjectorGain, relativePosition, distance);
+        return;
+    }
+
+    // distant sources heard by listeners in the same cell share one rendering
+    auto& spatializationCache = _sharedData.spatializationCache;
+    if (spatializationCache.isEnabled() && !isEcho && !isSoloing && !streamToAdd->isStereo() &&
+        distance > spatializationCache.getNearFieldDistance()) {
+        addCachedStream(mixableStream, listeningNodeStream, masterAvatarGain, masterInjectorGain);
+        return;
+    }
+
     float gain = isEcho ? 1.0f
                         : (isSoloing ? masterAvatarGain
                                      : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd,
                                                    relativePosition, distance));
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
-    const int HRTF_DATASET_INDEX = 1;
-
     if (!streamToAdd->lastPopSucceeded()) {
-        bool forceSilentBlock = true;
-
-        if (!streamToAdd->getLastPopOutput().isNull()) {
-            bool isInjector = dynamic_cast<const InjectedAudioStream*>(streamToAdd);
-
-            // in an injector, just go silent - the injector has likely ended
-            // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
-            if (!isInjector) {
-                // calculate its fade factor, which depends on how many times it's already been repeated.
-                float fadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd->getConsecutiveNotMixedCount() - 1);
-                if (fadeFactor > 0.0f) {
-                    // apply the fadeFactor to the gain
-                    gain *= fadeFactor;
-                    forceSilentBlock = false;
-                }
-            }
-        }
+        float fadeFactor = missedFrameFadeFactor(*streamToAdd);
+        bool forceSilentBlock = fadeFactor <= 0.0f;
 
-        if (forceSilentBlock) {
+        if (!forceSilentBlock) {
+            // apply the fadeFactor to the gain
+            gain *= fadeFactor;
+        } else {
             // call renderSilent with a forced silent block to reduce artifacts
             // (this is not done for stereo streams since they do not go through the HRTF)
             if (!streamToAdd->isStereo() && !isEcho) {
                 static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                queueHRTFRender(*mixableStream.hrtf, silentMonoBlock, azimuth, distance, gain);
 
                 ++stats.hrtfRenders;
             }
@@ -567,11 +739,207 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         ++stats.manualEchoMixes;
     } else {
 
+        // read straight into the queue, the samples are rendered when the queue is flushed
+        int16_t* samples = _queuedHRTFSamples[_numQueuedHRTFRenders];
+        streamPopOutput.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        queueHRTFRender(*mixableStream.hrtf, samples, azimuth, distance, gain);
+        ++stats.hrtfRenders;
+    }
+}
+
+void AudioMixerSlave::addCachedStream(AudioMixerClientData::MixableStream& mixableStream,
+                                      AvatarAudioStream& listeningNodeStream,
+                                      float masterAvatarGain,
+                                      float masterInjectorGain) {
+    const int HRTF_DATASET_INDEX = 1;
+
+    auto streamToAdd = mixableStream.positionalStream;
+    auto& spatializationCache = _sharedData.spatializationCache;
+    auto cell = spatializationCache.cellForListener(listeningNodeStream.getPosition(), listeningNodeStream.getOrientation());
+
+    bool didRender = false;
+    const float* output = spatializationCache.getOutput(cell, mixableStream.nodeStreamID.nodeLocalID,
+                                                        mixableStream.nodeStreamID.streamID, _frame,
+                                                        [&](AudioHRTF& hrtf, float* output) {
+        // render from the center of the cell, with only the listener-independent part of the gain
+        glm::vec3 relativePosition = streamToAdd->getPosition() - cell.position;
+        float distance = glm::max(glm::length(relativePosition), EPSILON);
+        float gain = computeGain(1.0f, 1.0f, cell.position, *streamToAdd, relativePosition, distance);
+        float azimuth = computeAzimuth(cell.orientation, relativePosition);
+
+        if (!streamToAdd->lastPopSucceeded()) {
+            float fadeFactor = missedFrameFadeFactor(*streamToAdd);
+            if (fadeFactor <= 0.0f) {
+                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+                hrtf.render(silentMonoBlock, output, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                            AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                return;
+            }
+            gain *= fadeFactor;
+        }
+
+        AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        hrtf.render(_bufferSamples, output, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    }, didRender);
 
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    if (didRender) {
         ++stats.hrtfRenders;
+        ++stats.spatializationCacheRenders;
+    } else {
+        ++stats.spatializationCacheHits;
+    }
+
+    // the only per-listener parts of the gain: master gain and the listener's gain for this source
+    // (the shared HRTF has already applied the global HRTF_GAIN)
+    float gain = mixableStream.hrtf->getGainAdjustment() / HRTF_GAIN;
+    if (streamToAdd->getType() == PositionalAudioStream::Injector) {
+        gain *= masterInjectorGain;
+    } else if (streamToAdd->getType() == PositionalAudioStream::Microphone) {
+        gain *= masterAvatarGain;
+    }
+
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+        _mixSamples[i] += gain * output[i];
+    }
+
+    // this listener's own HRTF is not used while the cell renders the source, start it clean when it comes back
+    mixableStream.hrtf->reset();
+}
+
+void AudioMixerSlave::addClusterStream(AudioMixerClientData::MixableStream& mixableStream,
+                                       AvatarAudioStream& listeningNodeStream,
+                                       float masterAvatarGain,
+                                       float masterInjectorGain) {
+    const int HRTF_DATASET_INDEX = 1;
+
+    // this listener's own HRTF is not used while the cluster is pre-mixed, start it clean when it comes back
+    mixableStream.hrtf->reset();
+    ++stats.premixedStreams;
+
+    // the first source of the cluster brings in the whole cluster, the others are already in the mix
+    if (_isClusterMixed[mixableStream.cluster]) {
+        return;
+    }
+    _isClusterMixed[mixableStream.cluster] = 1;
+    ++stats.clusterPremixes;
+
+    const auto& cluster = _sharedData.sourceClusters.getCluster(mixableStream.cluster);
+    auto& spatializationCache = _sharedData.spatializationCache;
+    auto cell = spatializationCache.cellForListener(listeningNodeStream.getPosition(), listeningNodeStream.getOrientation());
+
+    bool didRender = false;
+    const float* output = spatializationCache.getOutput(cell, Node::NULL_LOCAL_ID, cluster.id, _frame,
+                                                        [&](AudioHRTF& hrtf, float* output) {
+        // each source with its listener-independent gain from the center of the cell
+        // (the sources of a cluster have all been popped this frame, none of them is fading out)
+        float mix[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+        float maxGain = 0.0f;
+        for (auto source : cluster.sources) {
+            glm::vec3 relativePosition = source->getPosition() - cell.position;
+            float distance = glm::max(glm::length(relativePosition), EPSILON);
+            float gain = computeGain(1.0f, 1.0f, cell.position, *source, relativePosition, distance);
+            if (gain == 0.0f) {
+                continue;
+            }
+            maxGain = std::max(maxGain, gain);
+
+            AudioRingBuffer::ConstIterator streamPopOutput = source->getLastPopOutput();
+            streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+                mix[i] += gain * _bufferSamples[i];
+            }
+        }
+        if (maxGain == 0.0f) {
+            return;
+        }
+
+        // the mix goes through the HRTF relative to the loudest source, to keep the resolution of the samples
+        float scale = 1.0f / maxGain;
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+            _bufferSamples[i] = (int16_t)glm::clamp(scale * mix[i], -32768.0f, 32767.0f);
+        }
+
+        glm::vec3 relativePosition = cluster.center - cell.position;
+        float distance = glm::max(glm::length(relativePosition), EPSILON);
+        float azimuth = computeAzimuth(cell.orientation, relativePosition);
+        hrtf.render(_bufferSamples, output, HRTF_DATASET_INDEX, azimuth, distance, maxGain,
+                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    }, didRender);
+
+    if (didRender) {
+        ++stats.hrtfRenders;
+        ++stats.clusterRenders;
+    }
+
+    // the sources of the cluster are all of one type, and heard by the listener without a gain of their own
+    float gain = 1.0f / HRTF_GAIN;
+    if (cluster.type == PositionalAudioStream::Injector) {
+        gain *= masterInjectorGain;
+    } else if (cluster.type == PositionalAudioStream::Microphone) {
+        gain *= masterAvatarGain;
+    }
+
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+        _mixSamples[i] += gain * output[i];
+    }
+}
+
+void AudioMixerSlave::addBedStream(AudioMixerClientData::MixableStream& mixableStream,
+                                   AvatarAudioStream& listeningNodeStream,
+                                   float masterAvatarGain,
+                                   float masterInjectorGain,
+                                   const glm::vec3& relativePosition,
+                                   float distance) {
+    auto streamToAdd = mixableStream.positionalStream;
+
+    // this listener's own HRTF is not used while the source is in the bed, start it clean when it comes back
+    mixableStream.hrtf->reset();
+
+    // along with the listener's gain for this source, which the HRTF would have applied
+    float gain = mixableStream.hrtf->getGainAdjustment() *
+        computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd, relativePosition, distance);
+
+    if (!streamToAdd->lastPopSucceeded()) {
+        float fadeFactor = missedFrameFadeFactor(*streamToAdd);
+        if (fadeFactor <= 0.0f) {
+            return;
+        }
+        gain *= fadeFactor;
+    }
+
+    // the bed is world oriented, the direction of the source is not rotated to the listener's
+    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
+    streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    AudioAmbisonicBed::encodeSource(_bufferSamples, relativePosition, gain, _bedSamples);
+
+    ++_numBedStreams;
+    ++stats.ambisonicBedSources;
+}
+
+void AudioMixerSlave::queueHRTFRender(AudioHRTF& hrtf, int16_t* input, float azimuth, float distance, float gain) {
+    int i = _numQueuedHRTFRenders++;
+    _queuedHRTFs[i] = &hrtf;
+    _queuedHRTFInputs[i] = input;
+    _queuedHRTFAzimuths[i] = azimuth;
+    _queuedHRTFDistances[i] = distance;
+    _queuedHRTFGains[i] = gain;
+
+    if (_numQueuedHRTFRenders == HRTF_RENDER_BATCH) {
+        flushHRTFRenders();
+    }
+}
+
+void AudioMixerSlave::flushHRTFRenders() {
+    const int HRTF_DATASET_INDEX = 1;
+
+    if (_numQueuedHRTFRenders > 0) {
+        AudioHRTF::renderMultiple(_queuedHRTFs, _queuedHRTFInputs, _queuedHRTFAzimuths, _queuedHRTFDistances,
+                                  _queuedHRTFGains, _numQueuedHRTFRenders, _mixSamples, HRTF_DATASET_INDEX,
+                                  AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        _numQueuedHRTFRenders = 0;
     }
 }
 
@@ -608,22 +976,37 @@ std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 s
     return audioPacket;
 }
 
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer) {
+void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer,
+                   const QByteArray& encodedBed) {
     const int MIX_PACKET_SIZE =
         sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
     quint16 sequence = data.getOutgoingSequenceNumber();
     QString codec = data.getCodecName();
-    auto mixPacket = createAudioPacket(PacketType::MixedAudio, MIX_PACKET_SIZE, sequence, codec);
+    bool hasBed = !encodedBed.isEmpty();
+    int bedSize = hasBed ? (int)sizeof(quint16) + encodedBed.size() : 0;
+    auto mixPacket = createAudioPacket(hasBed ? PacketType::MixedAudioWithAmbisonicBed : PacketType::MixedAudio,
+                                       MIX_PACKET_SIZE + bedSize, sequence, codec);
+
+    // pack the bed, ahead of the samples
+    if (hasBed) {
+        mixPacket->writePrimitive((quint16)encodedBed.size());
+        mixPacket->write(encodedBed);
+    }
 
     // pack samples
     mixPacket->write(buffer.constData(), buffer.size());
 
-    // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    // send packet, followed by its parity packet when it completes a group
+    auto& nodeList = DependencyManager::getRef<NodeList>();
+    auto parityPacket = data.getFECEncoder().addPacket(*mixPacket);
+    nodeList.sendPacket(std::move(mixPacket), *node);
+    if (parityPacket) {
+        nodeList.sendPacket(std::move(parityPacket), *node);
+    }
     data.incrementOutgoingMixedAudioSequenceNumber();
 }
 
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
+void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data, int numFrames) {
     const int SILENT_PACKET_SIZE =
         sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + sizeof(quint16);
     quint16 sequence = data.getOutgoingSequenceNumber();
@@ -631,16 +1014,21 @@ void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data)
     auto mixPacket = createAudioPacket(PacketType::SilentAudioFrame, SILENT_PACKET_SIZE, sequence, codec);
 
     // pack number of samples
-    mixPacket->writePrimitive(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
-
-    // send packet
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
+    mixPacket->writePrimitive((quint16)(numFrames * AudioConstants::NETWORK_FRAME_SAMPLES_STEREO));
+
+    // send packet, followed by its parity packet when it completes a group
+    auto& nodeList = DependencyManager::getRef<NodeList>();
+    auto parityPacket = data.getFECEncoder().addPacket(*mixPacket);
+    nodeList.sendPacket(std::move(mixPacket), *node);
+    if (parityPacket) {
+        nodeList.sendPacket(std::move(parityPacket), *node);
+    }
     data.incrementOutgoingMixedAudioSequenceNumber();
 }
 
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData& data) {
     auto mutePacket = NLPacket::create(PacketType::NoisyMute, 0);
-    DependencyManager::get<NodeList>()->sendPacket(std::move(mutePacket), *node);
+    DependencyManager::getRef<NodeList>().sendPacket(std::move(mutePacket), *node);
 
     // probably now we just reset the flag, once should do it (?)
     data.setShouldMuteClient(false);
@@ -656,8 +1044,11 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
     AvatarAudioStream* stream = data.getAvatarAudioStream();
     glm::vec3 streamPosition = stream->getPosition();
 
-    // find reverb properties
+    // find reverb properties, unless the mixer renders the zone reverb itself
     for (const auto& settings : reverbSettings) {
+        if (AudioMixer::isZoneReverbShared()) {
+            break;
+        }
         AABox box = audioZones[settings.zone].area;
         if (box.contains(streamPosition)) {
             hasReverb = true;
@@ -703,10 +1094,25 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
         }
 
         // send the packet
-        DependencyManager::get<NodeList>()->sendPacket(std::move(envPacket), *node);
+        DependencyManager::getRef<NodeList>().sendPacket(std::move(envPacket), *node);
     }
 }
 
+float missedFrameFadeFactor(const PositionalAudioStream& streamToAdd) {
+    if (!streamToAdd.getLastPopOutput().isNull()) {
+        bool isInjector = dynamic_cast<const InjectedAudioStream*>(&streamToAdd);
+
+        // in an injector, just go silent - the injector has likely ended
+        // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
+        if (!isInjector) {
+            // calculate its fade factor, which depends on how many times it's already been repeated.
+            return calculateRepeatedFrameFadeFactor(streamToAdd.getConsecutiveNotMixedCount() - 1);
+        }
+    }
+
+    return 0.0f;
+}
+
 float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
     float gain = 1.0f;
 
@@ -728,7 +1134,7 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
 
 float computeGain(float masterAvatarGain,
                   float masterInjectorGain,
-                  const AvatarAudioStream& listeningNodeStream,
+                  const glm::vec3& listenerPosition,
                   const PositionalAudioStream& streamToAdd,
                   const glm::vec3& relativePosition,
                   float distance) {
@@ -765,7 +1171,7 @@ float computeGain(float masterAvatarGain,
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (const auto& settings : zoneSettings) {
         if (audioZones[settings.source].area.contains(streamToAdd.getPosition()) &&
-            audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
+            audioZones[settings.listener].area.contains(listenerPosition)) {
             attenuationPerDoublingInDistance = settings.coefficient;
             break;
         }
@@ -801,10 +1207,8 @@ float computeGain(float masterAvatarGain,
     return gain;
 }
 
-float computeAzimuth(const AvatarAudioStream& listeningNodeStream,
-                     const PositionalAudioStream& streamToAdd,
-                     const glm::vec3& relativePosition) {
-    glm::quat inverseOrientation = glm::inverse(listeningNodeStream.getOrientation());
+float computeAzimuth(const glm::quat& listenerOrientation, const glm::vec3& relativePosition) {
+    glm::quat inverseOrientation = glm::inverse(listenerOrientation);
 
     glm::vec3 rotatedSourcePosition = inverseOrientation * relativePosition;
 
@@ -18,6 +18,7 @@
 #endif
 
 #include <AABox.h>
+#include <AudioAmbisonicBed.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
 #include <ThreadedAssignment.h>
@@ -27,10 +28,18 @@
 
 #include "AudioMixerClientData.h"
 #include "AudioMixerStats.h"
+#include "AudioSourceClusters.h"
+#include "AudioSpatializationCache.h"
+#include "AudioUpstreamBed.h"
+#include "AudioZoneReverb.h"
 
 class AvatarAudioStream;
 class AudioHRTF;
 
+// the gain of a source for a listener at listenerPosition, with the distance and zone attenuations of the domain
+float computeGain(float masterAvatarGain, float masterInjectorGain, const glm::vec3& listenerPosition,
+                  const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
+
 class AudioMixerSlave {
 public:
     using ConstIter = NodeList::const_iterator;
@@ -39,6 +48,11 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioSpatializationCache spatializationCache;
+        AudioZoneReverb zoneReverb;
+        AudioSourceClusters sourceClusters;
+        AudioUpstreamBed upstreamBed;
+        float mixRatio { 0.0f }; // trailing time spent mixing, over the frame time
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -63,6 +77,20 @@ private:
                    float masterAvatarGain,
                    float masterInjectorGain,
                    bool isSoloing);
+    void addCachedStream(AudioMixerClientData::MixableStream& mixableStream,
+                         AvatarAudioStream& listeningNodeStream,
+                         float masterAvatarGain,
+                         float masterInjectorGain);
+    void addBedStream(AudioMixerClientData::MixableStream& mixableStream,
+                      AvatarAudioStream& listeningNodeStream,
+                      float masterAvatarGain,
+                      float masterInjectorGain,
+                      const glm::vec3& relativePosition,
+                      float distance);
+    void addClusterStream(AudioMixerClientData::MixableStream& mixableStream,
+                          AvatarAudioStream& listeningNodeStream,
+                          float masterAvatarGain,
+                          float masterInjectorGain);
     void updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                               AvatarAudioStream& listeningNodeStream,
                               float masterAvatarGain,
@@ -71,9 +99,39 @@ private:
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
+    // works out which clusters of sources the listener can't hear, and which ones it can hear pre-mixed
+    void prepareClusters(const Node& listener, AudioMixerClientData& listenerData,
+                         const AvatarAudioStream& listenerAudioStream);
+    AudioSourceClusters::State getClusterState(const AudioMixerClientData::MixableStream& mixableStream);
+
+    // mono HRTF renders are queued up and flushed together, so that the HRTF can process several sources per pass
+    void queueHRTFRender(AudioHRTF& hrtf, int16_t* input, float azimuth, float distance, float gain);
+    void flushHRTFRenders();
+
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    int _numAddedStreams { 0 }; // to the mix of the current listener
+
+    // ambisonic bed of the distant sources, when the current listener has one
+    bool _isMixingBed { false };
+    float _bedSamples[AudioAmbisonicBed::NUM_SAMPLES];
+    int _numBedStreams { 0 };
+
+    // clusters of sources, as the current listener hears them
+    bool _isClustering { false };
+    AudioSourceClusters::Listener _clusterListener;
+    std::vector<uint8_t> _isClusterMixed;
+
+    // queued HRTF renders
+    static const int HRTF_RENDER_BATCH = 4;
+    int _numQueuedHRTFRenders { 0 };
+    AudioHRTF* _queuedHRTFs[HRTF_RENDER_BATCH];
+    int16_t* _queuedHRTFInputs[HRTF_RENDER_BATCH];
+    float _queuedHRTFAzimuths[HRTF_RENDER_BATCH];
+    float _queuedHRTFDistances[HRTF_RENDER_BATCH];
+    float _queuedHRTFGains[HRTF_RENDER_BATCH];
+    int16_t _queuedHRTFSamples[HRTF_RENDER_BATCH][AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
 
     // frame state
     ConstIter _begin;
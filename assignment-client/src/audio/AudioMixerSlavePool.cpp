@@ -11,66 +11,17 @@
 
 #include "AudioMixerSlavePool.h"
 
-#include <QObject>
-
 #include <assert.h>
 #include <algorithm>
 
-#include <ThreadHelpers.h>
-
-void AudioMixerSlaveThread::run() {
-    while (true) {
-        wait();
-
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
-        }
-
-        bool stopping = _stop;
-        notify(stopping);
-        if (stopping) {
-            return;
-        }
-    }
-}
-
-void AudioMixerSlaveThread::wait() {
-    {
-        Lock lock(_pool._mutex);
-        _pool._slaveCondition.wait(lock, [&] {
-            assert(_pool._numStarted <= _pool._numThreads);
-            return _pool._numStarted != _pool._numThreads;
-        });
-        ++_pool._numStarted;
-    }
-
-    if (_pool._configure) {
-        _pool._configure(*this);
-    }
-    _function = _pool._function;
-}
-
-void AudioMixerSlaveThread::notify(bool stopping) {
-    {
-        Lock lock(_pool._mutex);
-        assert(_pool._numFinished < _pool._numThreads);
-        ++_pool._numFinished;
-        if (stopping) {
-            ++_pool._numStopped;
-        }
-    }
-    _pool._poolCondition.notify_one();
-}
-
-bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
-}
+#include <NodeList.h>
+#include <udt/Socket.h>
 
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
-    _configure = [](AudioMixerSlave& slave) {};
+    _configure = [](AudioMixerSlave& slave) {
+        udt::Socket::setBatchSendsOnCurrentThread(false);
+    };
     run(begin, end);
 }
 
@@ -78,37 +29,32 @@ void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame
     _function = &AudioMixerSlave::mix;
     _configure = [=](AudioMixerSlave& slave) {
         slave.configureMix(_begin, _end, frame, numToRetain);
+
+        // queue this frame's mixes so they go out together once every slave is done
+        udt::Socket::setBatchSendsOnCurrentThread(true);
     };
 
     run(begin, end);
+
+    DependencyManager::get<NodeList>()->flushSendBatch();
 }
 
 void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
-
-    {
-        Lock lock(_mutex);
-
-        // run
-        _numStarted = _numFinished = 0;
-        _slaveCondition.notify_all();
-
-        // wait
-        _poolCondition.wait(lock, [&] {
-            assert(_numFinished <= _numThreads);
-            return _numFinished == _numThreads;
-        });
+    // the scheduler deals out indices into this frame's nodes
+    _nodes.assign(_begin, _end);
 
-        assert(_numStarted == _numThreads);
-    }
+    _scheduler->run((int)_nodes.size(), [&](int worker) {
+        if (_configure) {
+            _configure(*_slaves[worker]);
+        }
+    }, [&](int worker, int item) {
+        ((*_slaves[worker]).*_function)(_nodes[item]);
+    });
 
-    assert(_queue.empty());
+    _nodes.clear();
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -117,18 +63,23 @@ void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> funct
     }
 }
 
-#ifdef DEBUG_EVENT_QUEUE
 void AudioMixerSlavePool::queueStats(QJsonObject& stats) {
-    unsigned i = 0;
-    for (auto& slave : _slaves) {
-        int queueSize = ::hifi::qt::getEventQueueSize(slave.get());
-        QString queueName = QString("audio_thread_event_queue_%1").arg(i);
-        stats[queueName] = queueSize;
+    if (_scheduler) {
+        auto schedulerStats = _scheduler->takeStats();
+        stats["audio_thread_runs"] = schedulerStats.numRuns;
+        stats["audio_thread_steals"] = schedulerStats.numSteals;
+        stats["audio_thread_avg_imbalance"] = schedulerStats.averageImbalance;
+        stats["audio_thread_max_imbalance"] = schedulerStats.maxImbalance;
 
-        i++;
+#ifdef DEBUG_EVENT_QUEUE
+        for (int i = 0; i < _scheduler->numWorkers(); ++i) {
+            int queueSize = ::hifi::qt::getEventQueueSize(_scheduler->getWorkerThread(i));
+            QString queueName = QString("audio_thread_event_queue_%1").arg(i);
+            stats[queueName] = queueSize;
+        }
+#endif // DEBUG_EVENT_QUEUE
     }
 }
-#endif // DEBUG_EVENT_QUEUE
 
 void AudioMixerSlavePool::setNumThreads(int numThreads) {
     // clamp to allowed size
@@ -155,50 +106,21 @@ void AudioMixerSlavePool::resize(int numThreads) {
 
     qDebug("%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
 
-    Lock lock(_mutex);
-
-    if (numThreads > _numThreads) {
-        // start new slaves
-        for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData);
-            QObject::connect(slave, &QThread::started, [] { setThreadName("AudioMixerSlaveThread"); });
-            slave->start();
-            _slaves.emplace_back(slave);
-        }
-    } else if (numThreads < _numThreads) {
-        auto extraBegin = _slaves.begin() + numThreads;
-
-        // mark slaves to stop...
-        auto slave = extraBegin;
-        while (slave != _slaves.end()) {
-            (*slave)->_stop = true;
-            ++slave;
-        }
-
-        // ...cycle them until they do stop...
-        _numStopped = 0;
-        while (_numStopped != (_numThreads - numThreads)) {
-            _numStarted = _numFinished = _numStopped;
-            _slaveCondition.notify_all();
-            _poolCondition.wait(lock, [&] {
-                assert(_numFinished <= _numThreads);
-                return _numFinished == _numThreads;
-            });
-        }
+    if (numThreads == _numThreads) {
+        return;
+    }
 
-        // ...wait for threads to finish...
-        slave = extraBegin;
-        while (slave != _slaves.end()) {
-            QThread* thread = reinterpret_cast<QThread*>(slave->get());
-            static const int MAX_THREAD_WAIT_TIME = 10;
-            thread->wait(MAX_THREAD_WAIT_TIME);
-            ++slave;
-        }
+    // the workers are idle between runs, so they can simply be replaced
+    _scheduler.reset();
+    if (numThreads > 0) {
+        _scheduler.reset(new WorkStealingScheduler("AudioMixerSlaveThread", numThreads));
+    }
 
-        // ...and erase them
-        _slaves.erase(extraBegin, _slaves.end());
+    while ((int)_slaves.size() < numThreads) {
+        _slaves.emplace_back(new AudioMixerSlave(_workerSharedData));
     }
+    _slaves.resize(numThreads);
 
-    _numThreads = _numStarted = _numFinished = numThreads;
+    _numThreads = numThreads;
     assert(_numThreads == (int)_slaves.size());
 }
@@ -12,50 +12,19 @@
 #ifndef hifi_AudioMixerSlavePool_h
 #define hifi_AudioMixerSlavePool_h
 
-#include <condition_variable>
-#include <mutex>
+#include <memory>
 #include <vector>
 
 #include <QThread>
+#include <QJsonObject>
 #include <shared/QtHelpers.h>
-#include <TBBHelpers.h>
+#include <WorkStealingScheduler.h>
 
 #include "AudioMixerSlave.h"
 
-class AudioMixerSlavePool;
-
-class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
-    Q_OBJECT
-    using ConstIter = NodeList::const_iterator;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-
-public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData)
-        : AudioMixerSlave(sharedData), _pool(pool) {}
-
-    void run() override final;
-
-private:
-    friend class AudioMixerSlavePool;
-
-    void wait();
-    void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
-
-    AudioMixerSlavePool& _pool;
-    void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
-    bool _stop { false };
-};
-
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-    using ConditionVariable = std::condition_variable;
-
 public:
     using ConstIter = NodeList::const_iterator;
 
@@ -72,9 +41,8 @@ public:
     // iterate over all slaves
     void each(std::function<void(AudioMixerSlave& slave)> functor);
 
-#ifdef DEBUG_EVENT_QUEUE
+    // scheduler balance since the last call, and the slave event queues with DEBUG_EVENT_QUEUE
     void queueStats(QJsonObject& stats);
-#endif
 
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
@@ -83,25 +51,15 @@ private:
     void run(ConstIter begin, ConstIter end);
     void resize(int numThreads);
 
-    std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
-
-    friend void AudioMixerSlaveThread::wait();
-    friend void AudioMixerSlaveThread::notify(bool stopping);
-    friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
+    std::vector<std::unique_ptr<AudioMixerSlave>> _slaves;
+    std::unique_ptr<WorkStealingScheduler> _scheduler;
 
-    // synchronization state
-    Mutex _mutex;
-    ConditionVariable _slaveCondition;
-    ConditionVariable _poolCondition;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node);
     std::function<void(AudioMixerSlave&)> _configure;
     int _numThreads { 0 };
-    int _numStarted { 0 }; // guarded by _mutex
-    int _numFinished { 0 }; // guarded by _mutex
-    int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
+    std::vector<SharedNodePointer> _nodes;
     ConstIter _begin;
     ConstIter _end;
 
@@ -22,6 +22,19 @@ void AudioMixerStats::reset() {
     hrtfResets = 0;
     hrtfUpdates = 0;
 
+    spatializationCacheHits = 0;
+    spatializationCacheRenders = 0;
+
+    ambisonicBedMixes = 0;
+    ambisonicBedSources = 0;
+
+    culledStreams = 0;
+    premixedStreams = 0;
+    clusterPremixes = 0;
+    clusterRenders = 0;
+
+    upstreamBedMixes = 0;
+
     manualStereoMixes = 0;
     manualEchoMixes = 0;
 
@@ -36,6 +49,12 @@ void AudioMixerStats::reset() {
     inactive = 0;
     active = 0;
 
+    packetsTime.reset();
+    prepareMixTime.reset();
+    addStreamsTime.reset();
+    encodeTime.reset();
+    sendTime.reset();
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -52,6 +71,19 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
 
+    spatializationCacheHits += otherStats.spatializationCacheHits;
+    spatializationCacheRenders += otherStats.spatializationCacheRenders;
+
+    ambisonicBedMixes += otherStats.ambisonicBedMixes;
+    ambisonicBedSources += otherStats.ambisonicBedSources;
+
+    culledStreams += otherStats.culledStreams;
+    premixedStreams += otherStats.premixedStreams;
+    clusterPremixes += otherStats.clusterPremixes;
+    clusterRenders += otherStats.clusterRenders;
+
+    upstreamBedMixes += otherStats.upstreamBedMixes;
+
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
 
@@ -66,6 +98,12 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     inactive += otherStats.inactive;
     active += otherStats.active;
 
+    packetsTime.merge(otherStats.packetsTime);
+    prepareMixTime.merge(otherStats.prepareMixTime);
+    addStreamsTime.merge(otherStats.addStreamsTime);
+    encodeTime.merge(otherStats.encodeTime);
+    sendTime.merge(otherStats.sendTime);
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
@@ -16,6 +16,8 @@
 #include <cstdint>
 #endif
 
+#include <LatencyHistogram.h>
+
 struct AudioMixerStats {
     int sumStreams { 0 };
     int sumListeners { 0 };
@@ -27,6 +29,19 @@ struct AudioMixerStats {
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
 
+    int spatializationCacheHits { 0 };
+    int spatializationCacheRenders { 0 };
+
+    int ambisonicBedMixes { 0 };
+    int ambisonicBedSources { 0 };
+
+    int culledStreams { 0 };
+    int premixedStreams { 0 };
+    int clusterPremixes { 0 };
+    int clusterRenders { 0 };
+
+    int upstreamBedMixes { 0 };
+
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
@@ -41,6 +56,13 @@ struct AudioMixerStats {
     int inactive { 0 };
     int active { 0 };
 
+    // per-phase timings, in nsecs
+    LatencyHistogram packetsTime;
+    LatencyHistogram prepareMixTime;
+    LatencyHistogram addStreamsTime;
+    LatencyHistogram encodeTime;
+    LatencyHistogram sendTime;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
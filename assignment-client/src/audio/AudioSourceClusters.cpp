@@ -0,0 +1,156 @@
+//
+//  AudioSourceClusters.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSourceClusters.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <AudioHRTF.h>
+
+#include "AudioMixer.h"
+
+const float AudioSourceClusters::DEFAULT_CELL_SIZE = 16.0f;
+const float AudioSourceClusters::DEFAULT_PREMIX_DISTANCE = 32.0f;
+
+void AudioSourceClusters::beginFrame() {
+    _clusters.clear();
+    _clusterIndices.clear();
+    _sourceClusters.clear();
+    _zoneSettingIndices.clear();
+}
+
+void AudioSourceClusters::addSource(const PositionalAudioStream& stream) {
+    // only the sources that are heard this frame, the others are mixed (or faded out) one by one
+    if (!stream.lastPopSucceeded() || stream.getLastPopOutputLoudness() == 0.0f) {
+        return;
+    }
+
+    const glm::vec3& position = stream.getPosition();
+
+    // the zone settings that may apply to the source, in the order they are looked up (see computeGain)
+    auto& audioZones = AudioMixer::getAudioZones();
+    auto& zoneSettings = AudioMixer::getZoneSettings();
+    int firstZoneSetting = (int)_zoneSettingIndices.size();
+    uint16_t zoneHash = 0;
+    for (int i = 0; i < (int)zoneSettings.size(); ++i) {
+        if (audioZones[zoneSettings[i].source].area.contains(position)) {
+            _zoneSettingIndices.push_back(i);
+            zoneHash = (uint16_t)(zoneHash * 31 + i);
+        }
+    }
+    int numZoneSettings = (int)_zoneSettingIndices.size() - firstZoneSetting;
+
+    int x = (int)std::floor(position.x / _cellSize);
+    int y = (int)std::floor(position.y / _cellSize);
+    int z = (int)std::floor(position.z / _cellSize);
+    QUuid id((uint)x, (ushort)(y & 0xffff), (ushort)((uint)y >> 16),
+             (uchar)(z & 0xff), (uchar)((z >> 8) & 0xff), (uchar)((z >> 16) & 0xff), (uchar)((uint)z >> 24),
+             (uchar)(zoneHash & 0xff), (uchar)(zoneHash >> 8), (uchar)stream.getType(), (uchar)stream.isStereo());
+
+    auto it = _clusterIndices.find(id);
+    if (it == _clusterIndices.end()) {
+        Cluster cluster;
+        cluster.id = id;
+        cluster.type = stream.getType();
+        cluster.isStereo = stream.isStereo();
+        cluster.minimum = position;
+        cluster.maximum = position;
+        cluster.center = position;
+        cluster.firstZoneSetting = firstZoneSetting;
+        cluster.numZoneSettings = numZoneSettings;
+        cluster.sources.push_back(&stream);
+
+        int index = (int)_clusters.size();
+        _clusters.push_back(std::move(cluster));
+        _clusterIndices[id] = index;
+        _sourceClusters[&stream] = index;
+        return;
+    }
+
+    Cluster& cluster = _clusters[it->second];
+    bool hasSameZoneSettings = cluster.numZoneSettings == numZoneSettings &&
+        std::equal(_zoneSettingIndices.begin() + firstZoneSetting, _zoneSettingIndices.end(),
+                   _zoneSettingIndices.begin() + cluster.firstZoneSetting);
+
+    // the zone settings of the cluster are only kept once
+    _zoneSettingIndices.resize(firstZoneSetting);
+
+    if (!hasSameZoneSettings) {
+        // another set of zone settings with the same hash in this cell, this source isn't clustered
+        return;
+    }
+
+    cluster.minimum = glm::min(cluster.minimum, position);
+    cluster.maximum = glm::max(cluster.maximum, position);
+    cluster.center = 0.5f * (cluster.minimum + cluster.maximum);
+    cluster.sources.push_back(&stream);
+    _sourceClusters[&stream] = it->second;
+}
+
+int AudioSourceClusters::clusterOf(const PositionalAudioStream* stream) const {
+    auto it = _sourceClusters.find(stream);
+    return it != _sourceClusters.end() ? it->second : -1;
+}
+
+void AudioSourceClusters::beginListener(const glm::vec3& position, bool canPremix, Listener& listener) const {
+    listener.position = position;
+    listener.canPremix = canPremix && _premixDistance > 0.0f;
+
+    auto& audioZones = AudioMixer::getAudioZones();
+    auto& zoneSettings = AudioMixer::getZoneSettings();
+    listener.isInListenerZone.resize(zoneSettings.size());
+    for (size_t i = 0; i < zoneSettings.size(); ++i) {
+        listener.isInListenerZone[i] = audioZones[zoneSettings[i].listener].area.contains(position);
+    }
+
+    // the states are only worked out for the clusters the listener comes across
+    listener.states.assign(_clusters.size(), Unknown);
+    listener.numPremixable.assign(_clusters.size(), 0);
+}
+
+float AudioSourceClusters::coefficientFor(const Cluster& cluster, const Listener& listener) const {
+    auto& zoneSettings = AudioMixer::getZoneSettings();
+    for (int i = 0; i < cluster.numZoneSettings; ++i) {
+        int index = _zoneSettingIndices[cluster.firstZoneSetting + i];
+        if (listener.isInListenerZone[index]) {
+            return zoneSettings[index].coefficient;
+        }
+    }
+    return AudioMixer::getAttenuationPerDoublingInDistance();
+}
+
+AudioSourceClusters::State AudioSourceClusters::getState(int index, Listener& listener) const {
+    uint8_t& state = listener.states[index];
+    if (state != Unknown) {
+        return (State)state;
+    }
+
+    const Cluster& cluster = _clusters[index];
+    float coefficient = coefficientFor(cluster, listener);
+
+    // the closest any source of the cluster can be
+    glm::vec3 closest = glm::clamp(listener.position, cluster.minimum, cluster.maximum);
+    float distance = glm::length(listener.position - closest);
+
+    if (coefficient >= 1.0f) {
+        // silent at any distance
+        state = Culled;
+    } else if (coefficient < 0.0f && distance >= std::max(-coefficient, ATTN_DISTANCE_REF + 1.0f)) {
+        // past the distance limit of the zone, where the linear attenuation reaches 0
+        state = Culled;
+    } else if (listener.canPremix && !cluster.isStereo && cluster.sources.size() > 1 && distance > _premixDistance) {
+        state = Distant;
+    } else {
+        state = Near;
+    }
+    return (State)state;
+}
@@ -0,0 +1,101 @@
+//
+//  AudioSourceClusters.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSourceClusters_h
+#define hifi_AudioSourceClusters_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <QtCore/QUuid>
+
+#include <PositionalAudioStream.h>
+#include <UUIDHasher.h>
+
+// The audible sources of a frame, grouped by cell of space and by the zone settings that apply to them.
+//
+// The sources of a cluster are attenuated the same way for a given listener, so a listener can be tested against a
+// cluster once instead of against each of its sources: a cluster that is silenced by the zone settings, or beyond the
+// distance limit of its zone, is culled before any per-source work. The mono sources of a cluster that is far from
+// a listener can also be pre-mixed together, and rendered once per listener cell (AudioSpatializationCache) instead of
+// once per source.
+class AudioSourceClusters {
+public:
+    static const float DEFAULT_CELL_SIZE;       // meters
+    static const float DEFAULT_PREMIX_DISTANCE; // meters
+
+    enum State : uint8_t {
+        Unknown,
+        Culled,     // no source of the cluster can be heard by the listener
+        Near,       // the sources are mixed one by one
+        Distant     // the sources can be pre-mixed, if the listener hears all of them as they are
+    };
+
+    struct Cluster {
+        QUuid id;                       // stable from frame to frame, for the cached renders
+        PositionalAudioStream::Type type;
+        bool isStereo;
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        glm::vec3 center;               // between the sources
+        int firstZoneSetting;           // the zone settings that include the sources, in _zoneSettingIndices
+        int numZoneSettings;
+        std::vector<const PositionalAudioStream*> sources;
+    };
+
+    // the state of the clusters for one listener, filled on the slave mixing for it
+    struct Listener {
+        glm::vec3 position;
+        bool canPremix { false };
+        std::vector<uint8_t> isInListenerZone;  // per zone setting
+        std::vector<uint8_t> states;            // per cluster
+        std::vector<int> numPremixable;         // per cluster, the sources the listener hears unmodified
+    };
+
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    void setCellSize(float cellSize) { _cellSize = cellSize; }
+    float getCellSize() const { return _cellSize; }
+
+    // 0 disables the pre-mix, the clusters are then only culled
+    void setPremixDistance(float distance) { _premixDistance = distance; }
+    float getPremixDistance() const { return _premixDistance; }
+
+    // on the mixer thread, between the processing of the packets and the mix
+    void beginFrame();
+    void addSource(const PositionalAudioStream& stream);
+
+    // on the slave threads
+    int clusterOf(const PositionalAudioStream* stream) const;
+    const Cluster& getCluster(int cluster) const { return _clusters[cluster]; }
+    int numClusters() const { return (int)_clusters.size(); }
+
+    void beginListener(const glm::vec3& position, bool canPremix, Listener& listener) const;
+    State getState(int cluster, Listener& listener) const;
+
+private:
+    float coefficientFor(const Cluster& cluster, const Listener& listener) const;
+
+    std::vector<Cluster> _clusters;
+    std::unordered_map<QUuid, int, UUIDHasher> _clusterIndices;
+    std::unordered_map<const PositionalAudioStream*, int> _sourceClusters;
+    std::vector<int> _zoneSettingIndices;
+
+    bool _isEnabled { false };
+    float _cellSize { DEFAULT_CELL_SIZE };
+    float _premixDistance { DEFAULT_PREMIX_DISTANCE };
+};
+
+#endif // hifi_AudioSourceClusters_h
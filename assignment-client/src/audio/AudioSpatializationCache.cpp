@@ -0,0 +1,87 @@
+//
+//  AudioSpatializationCache.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-09.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSpatializationCache.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+const float AudioSpatializationCache::DEFAULT_CELL_SIZE = 1.0f;
+const float AudioSpatializationCache::DEFAULT_NEAR_FIELD_DISTANCE = 8.0f;
+
+// pairs that go unheard for this long are dropped, along with their HRTF state
+static const unsigned int PURGE_AFTER_FRAMES = 100;
+
+size_t AudioSpatializationCache::KeyHasher::operator()(const Key& key) const {
+    size_t hash = UUIDHasher()(key.streamID);
+    hash = hash * 31 + std::hash<int>()(key.x);
+    hash = hash * 31 + std::hash<int>()(key.y);
+    hash = hash * 31 + std::hash<int>()(key.z);
+    hash = hash * 31 + std::hash<int>()(key.yaw);
+    hash = hash * 31 + std::hash<Node::LocalID>()(key.sourceID);
+    return hash;
+}
+
+AudioSpatializationCache::Cell AudioSpatializationCache::cellForListener(const glm::vec3& position,
+                                                                         const glm::quat& orientation) const {
+    Cell cell;
+    cell.x = (int)std::floor(position.x / _cellSize);
+    cell.y = (int)std::floor(position.y / _cellSize);
+    cell.z = (int)std::floor(position.z / _cellSize);
+    cell.position = (glm::vec3(cell.x, cell.y, cell.z) + 0.5f) * _cellSize;
+
+    // only the yaw is quantized, the HRTF has no elevation
+    glm::vec3 front = orientation * Vectors::FRONT;
+    float yaw = std::atan2(-front.x, -front.z);
+    float binWidth = TWO_PI / _yawBins;
+    cell.yaw = ((int)std::floor((yaw + PI) / binWidth)) % _yawBins;
+    cell.orientation = glm::angleAxis(-PI + (cell.yaw + 0.5f) * binWidth, Vectors::UNIT_Y);
+
+    return cell;
+}
+
+const float* AudioSpatializationCache::getOutput(const Cell& cell, Node::LocalID sourceID, const QUuid& streamID,
+                                                 unsigned int frame, const RenderFunction& render, bool& didRender) {
+    Key key { cell.x, cell.y, cell.z, cell.yaw, sourceID, streamID };
+
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        // if another slave beat us to it we get theirs back and ours is thrown away
+        it = _entries.insert({ key, std::unique_ptr<Entry>(new Entry) }).first;
+    }
+
+    Entry& entry = *it->second;
+
+    std::lock_guard<std::mutex> lock(entry.mutex);
+    didRender = entry.frame != frame;
+    if (didRender) {
+        memset(entry.output, 0, sizeof(entry.output));
+        render(entry.hrtf, entry.output);
+        entry.frame = frame;
+    }
+
+    // the output is not written again until the next frame, when every slave is done with this one
+    return entry.output;
+}
+
+void AudioSpatializationCache::purge(unsigned int frame) {
+    auto it = _entries.begin();
+    while (it != _entries.end()) {
+        if (frame - it->second->frame > PURGE_AFTER_FRAMES) {
+            it = _entries.unsafe_erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
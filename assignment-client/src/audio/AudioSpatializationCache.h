@@ -0,0 +1,110 @@
+//
+//  AudioSpatializationCache.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-09.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSpatializationCache_h
+#define hifi_AudioSpatializationCache_h
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <Node.h>
+#include <TBBHelpers.h>
+#include <UUIDHasher.h>
+
+// Shares the spatialized contribution of distant sources between listeners that stand close together.
+//
+// Listener poses are quantized into cells (a cube of space and a range of yaw). For a source that is far enough away,
+// every listener in a cell hears the same HRTF rendering, made once per frame from the center of the cell with the
+// listener-independent part of the gain. Each listener then scales it by its own master and per-source gain.
+// Nearby sources still get a per-listener HRTF, where the error of the approximation would be audible.
+class AudioSpatializationCache {
+public:
+    static const float DEFAULT_CELL_SIZE;           // meters
+    static const float DEFAULT_NEAR_FIELD_DISTANCE; // meters
+    static const int DEFAULT_YAW_BINS = 16;
+
+    struct Cell {
+        int x { 0 };
+        int y { 0 };
+        int z { 0 };
+        int yaw { 0 };
+
+        glm::vec3 position { 0.0f };        // center of the cell
+        glm::quat orientation;              // center of the yaw range
+    };
+
+    // the output of a (cell, source) pair, valid until the next frame
+    using RenderFunction = std::function<void(AudioHRTF& hrtf, float* output)>;
+
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    void setCellSize(float cellSize) { _cellSize = cellSize; }
+    float getCellSize() const { return _cellSize; }
+
+    void setNearFieldDistance(float distance) { _nearFieldDistance = distance; }
+    float getNearFieldDistance() const { return _nearFieldDistance; }
+
+    Cell cellForListener(const glm::vec3& position, const glm::quat& orientation) const;
+
+    // thread-safe, returns the rendered output for this cell and source, calling render if it is not rendered yet this frame
+    const float* getOutput(const Cell& cell, Node::LocalID sourceID, const QUuid& streamID, unsigned int frame,
+                           const RenderFunction& render, bool& didRender);
+
+    // not thread-safe, called between frames to drop the pairs that have not been heard for a while
+    void purge(unsigned int frame);
+
+    // not thread-safe, drops everything (e.g. when the settings change)
+    void clear() { _entries.clear(); }
+
+    size_t size() const { return _entries.size(); }
+
+private:
+    struct Key {
+        int x;
+        int y;
+        int z;
+        int yaw;
+        Node::LocalID sourceID;
+        QUuid streamID;
+
+        bool operator==(const Key& other) const {
+            return x == other.x && y == other.y && z == other.z && yaw == other.yaw &&
+                sourceID == other.sourceID && streamID == other.streamID;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        std::mutex mutex;
+        unsigned int frame { 0 };   // frame the output was last rendered for
+        AudioHRTF hrtf;
+        float output[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    };
+
+    tbb::concurrent_unordered_map<Key, std::unique_ptr<Entry>, KeyHasher> _entries;
+
+    bool _isEnabled { false };
+    float _cellSize { DEFAULT_CELL_SIZE };
+    float _nearFieldDistance { DEFAULT_NEAR_FIELD_DISTANCE };
+    int _yawBins { DEFAULT_YAW_BINS };
+};
+
+#endif // hifi_AudioSpatializationCache_h
@@ -0,0 +1,72 @@
+//
+//  AudioUpstreamBed.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioUpstreamBed.h"
+
+#include <cstring>
+
+#include <AudioFOA.h>
+
+// frames beyond this are late, the oldest are dropped to keep the bed in step with the replicated streams
+static const size_t MAX_QUEUED_FRAMES = 4;
+
+void AudioUpstreamBed::queueFrame(const QByteArray& encodedBed) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _queuedFrames.push_back(encodedBed);
+    while (_queuedFrames.size() > MAX_QUEUED_FRAMES) {
+        _queuedFrames.pop_front();
+    }
+}
+
+void AudioUpstreamBed::beginFrame() {
+    QByteArray encodedBed;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_queuedFrames.empty()) {
+            encodedBed = _queuedFrames.front();
+            _queuedFrames.pop_front();
+        }
+    }
+
+    // a missing frame leaves a gap, the bed is made of distant sources
+    _hasFrame = !encodedBed.isEmpty() && AudioAmbisonicBed::decode(encodedBed, _samples);
+}
+
+void AudioUpstreamBed::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _queuedFrames.clear();
+    _hasFrame = false;
+}
+
+void AudioUpstreamBed::addToBed(float gain, float* bedSamples) const {
+    const float scale = gain * (1 / 32768.0f);
+    for (int i = 0; i < AudioAmbisonicBed::NUM_SAMPLES; ++i) {
+        bedSamples[i] += scale * _samples[i];
+    }
+}
+
+void AudioUpstreamBed::render(AudioFOA& foa, const glm::quat& listenerOrientation, float gain,
+                              float* mixSamples) const {
+    const int HRTF_DATASET_INDEX = 1;
+
+    // the bed is world oriented, rotate it to the listener (Y-up to Z-up, as the clients do)
+    glm::quat relativeOrientation = glm::inverse(listenerOrientation);
+    float qw = relativeOrientation.w;
+    float qx = -relativeOrientation.z;
+    float qy = -relativeOrientation.x;
+    float qz = relativeOrientation.y;
+
+    // the FOA renderer takes its input as writable
+    int16_t samples[AudioAmbisonicBed::NUM_SAMPLES];
+    memcpy(samples, _samples, sizeof(samples));
+    foa.render(samples, mixSamples, HRTF_DATASET_INDEX, qw, qx, qy, qz, gain,
+               AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+}
@@ -0,0 +1,54 @@
+//
+//  AudioUpstreamBed.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioUpstreamBed_h
+#define hifi_AudioUpstreamBed_h
+
+#include <deque>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioAmbisonicBed.h>
+
+class AudioFOA;
+
+// The far-field bed an upstream mixer sends a downstream mixer: the sources of the upstream mixer that aren't near the
+// listeners of this mixer, encoded as a first-order ambisonic bed (AudioAmbisonicBed) centered on their zone. The
+// sources near the zone are replicated to this mixer as they are, and mixed like its own.
+//
+// The bed goes into the ambisonic bed of the listeners that take one, and is rendered binaurally for the others.
+class AudioUpstreamBed {
+public:
+    // thread-safe, for the packet handler
+    void queueFrame(const QByteArray& encodedBed);
+
+    // on the mixer thread, before the mix: takes the next frame
+    void beginFrame();
+    void clear();
+
+    // on the slave threads
+    bool hasFrame() const { return _hasFrame; }
+    void addToBed(float gain, float* bedSamples) const;
+    void render(AudioFOA& foa, const glm::quat& listenerOrientation, float gain, float* mixSamples) const;
+
+private:
+    std::mutex _mutex;
+    std::deque<QByteArray> _queuedFrames;
+
+    bool _hasFrame { false };
+    int16_t _samples[AudioAmbisonicBed::NUM_SAMPLES];
+};
+
+#endif // hifi_AudioUpstreamBed_h
@@ -0,0 +1,123 @@
+//
+//  AudioZoneReverb.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioZoneReverb.h"
+
+#include <cstring>
+
+#include <AudioEffectOptions.h>
+#include <InjectedAudioStream.h>
+#include <PositionalAudioStream.h>
+
+static const float SAMPLE_SCALE = 1.0f / AudioConstants::MAX_SAMPLE_VALUE;
+
+void AudioZoneReverb::addZone(const AABox& area, float reverbTime, float wetLevel) {
+    auto bus = std::unique_ptr<Bus>(new Bus());
+    bus->area = area;
+    bus->wetLevel = wetLevel;
+    bus->reverb.reset(new AudioReverb(AudioConstants::SAMPLE_RATE));
+
+    // the same reverb as the zone reverb of the clients, but completely wet: the dry mix is each listener's
+    AudioEffectOptions options;
+    ReverbParameters p;
+    p.sampleRate = AudioConstants::SAMPLE_RATE;
+    p.bandwidth = options.getBandwidth();
+    p.preDelay = options.getPreDelay();
+    p.lateDelay = options.getLateDelay();
+    p.reverbTime = reverbTime;
+    p.earlyDiffusion = options.getEarlyDiffusion();
+    p.lateDiffusion = options.getLateDiffusion();
+    p.roomSize = options.getRoomSize();
+    p.density = options.getDensity();
+    p.bassMult = options.getBassMult();
+    p.bassFreq = options.getBassFreq();
+    p.highGain = options.getHighGain();
+    p.highFreq = options.getHighFreq();
+    p.modRate = options.getModRate();
+    p.modDepth = options.getModDepth();
+    p.earlyGain = options.getEarlyGain();
+    p.lateGain = options.getLateGain();
+    p.earlyMixLeft = options.getEarlyMixLeft();
+    p.earlyMixRight = options.getEarlyMixRight();
+    p.lateMixLeft = options.getLateMixLeft();
+    p.lateMixRight = options.getLateMixRight();
+    p.wetDryMix = 100.0f;
+    bus->reverb->setParameters(&p);
+
+    _buses.push_back(std::move(bus));
+}
+
+void AudioZoneReverb::beginFrame() {
+    for (auto& bus : _buses) {
+        memset(bus->send, 0, sizeof(bus->send));
+    }
+}
+
+void AudioZoneReverb::addSource(const PositionalAudioStream& stream) {
+    if (!stream.lastPopSucceeded() || stream.getLastPopOutput().isNull()) {
+        return;
+    }
+    auto bus = const_cast<Bus*>(busAt(stream.getPosition()));
+    if (!bus) {
+        return;
+    }
+
+    float gain = SAMPLE_SCALE;
+    if (stream.getType() == PositionalAudioStream::Injector) {
+        gain *= static_cast<const InjectedAudioStream&>(stream).getAttenuationRatio();
+    }
+
+    int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    auto popOutput = stream.getLastPopOutput();
+    if (stream.isStereo()) {
+        popOutput.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+            bus->send[i] += samples[i] * gain;
+        }
+    } else {
+        popOutput.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+            float sample = samples[i] * gain;
+            bus->send[2 * i] += sample;
+            bus->send[2 * i + 1] += sample;
+        }
+    }
+}
+
+void AudioZoneReverb::render() {
+    // a bus without input still renders, its tail keeps ringing
+    for (auto& bus : _buses) {
+        bus->reverb->render(bus->send, bus->output, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    }
+}
+
+bool AudioZoneReverb::mixInto(const glm::vec3& listenerPosition, float* mixSamples) const {
+    auto bus = busAt(listenerPosition);
+    if (!bus) {
+        return false;
+    }
+
+    float wetDryMix = bus->wetLevel / 100.0f;
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+        mixSamples[i] += (bus->output[i] - mixSamples[i]) * wetDryMix;
+    }
+    return true;
+}
+
+const AudioZoneReverb::Bus* AudioZoneReverb::busAt(const glm::vec3& position) const {
+    // the first zone containing the position wins, as for the reverb the clients are sent
+    for (auto& bus : _buses) {
+        if (bus->area.contains(position)) {
+            return bus.get();
+        }
+    }
+    return nullptr;
+}
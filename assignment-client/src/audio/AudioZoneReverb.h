@@ -0,0 +1,58 @@
+//
+//  AudioZoneReverb.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioZoneReverb_h
+#define hifi_AudioZoneReverb_h
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <AudioConstants.h>
+#include <AudioReverb.h>
+
+class PositionalAudioStream;
+
+// The reverb of the audio zones, rendered by the mixer on a send bus per zone instead of by each client.
+//
+// Every frame, the sources standing in a zone with reverb are summed, unspatialized, into the send of the zone, and
+// the send goes through a single reverb. Each listener in the zone then gets the wet output of the bus mixed into its
+// own mix, with the wet level of the zone, the way the client would have mixed it with its own reverb.
+class AudioZoneReverb {
+public:
+    void clear() { _buses.clear(); }
+    void addZone(const AABox& area, float reverbTime, float wetLevel);
+
+    // on the mixer thread, between the processing of the packets and the mix
+    void beginFrame();
+    void addSource(const PositionalAudioStream& stream);
+    void render();
+
+    // on the slave threads, returns false if the listener isn't in a zone with reverb
+    bool mixInto(const glm::vec3& listenerPosition, float* mixSamples) const;
+
+private:
+    struct Bus {
+        AABox area;
+        float wetLevel; // percent
+        std::unique_ptr<AudioReverb> reverb;
+        float send[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        float output[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    };
+
+    const Bus* busAt(const glm::vec3& position) const;
+
+    std::vector<std::unique_ptr<Bus>> _buses;
+};
+
+#endif // hifi_AudioZoneReverb_h
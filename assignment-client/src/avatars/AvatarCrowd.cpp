@@ -0,0 +1,364 @@
+//
+//  AvatarCrowd.cpp
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarCrowd.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QJsonDocument>
+
+#include <AvatarLogging.h>
+#include <NodeList.h>
+#include <RegisteredMetaTypes.h>
+#include <SharedUtil.h>
+#include <udt/PacketHeaders.h>
+
+// the avatar ID, and the type and size of the packet the avatar would have sent on its own
+static const int ENTRY_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + sizeof(quint8) + sizeof(quint16);
+
+namespace {
+
+// the world position goes along with the avatar data, as ScriptableAvatar does it
+class CrowdAvatar : public AvatarData {
+public:
+    QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking = false) override {
+        _globalPosition = getWorldPosition();
+        return AvatarData::toByteArrayStateful(dataDetail, dropFaceTracking);
+    }
+};
+
+}
+
+static void writeEntry(ExtendedIODevice& destination, const QUuid& avatarID, PacketType type, const QByteArray& payload) {
+    destination.write(avatarID.toRfc4122());
+    destination.writePrimitive((quint8)type);
+    destination.writePrimitive((quint16)payload.size());
+    destination.write(payload);
+}
+
+AvatarCrowd::AvatarCrowd(QObject* parent) : QObject(parent) {
+    // a new mixer knows nothing of the crowd yet
+    connect(DependencyManager::get<NodeList>().data(), &LimitedNodeList::nodeActivated, this,
+            [this](SharedNodePointer node) {
+        if (node->getType() == NodeType::AvatarMixer) {
+            for (auto& member : _members) {
+                member.sendIdentity = true;
+                member.sendSkeleton = true;
+            }
+        }
+    });
+}
+
+QUuid AvatarCrowd::addAvatar(const QVariantMap& properties) {
+    QUuid avatarID = QUuid::createUuid();
+
+    Member member;
+    auto avatar = std::make_shared<CrowdAvatar>();
+    avatar->setSessionUUID(avatarID);
+    // the head data is created lazily, the avatar data needs it
+    avatar->getHeadOrientation();
+    avatar->setSkeletonModelURL(QUrl());
+    member.avatar = avatar;
+    setProperties(member, properties);
+
+    _members.insert(avatarID, member);
+    return avatarID;
+}
+
+bool AvatarCrowd::editAvatar(const QUuid& avatarID, const QVariantMap& properties) {
+    auto member = _members.find(avatarID);
+    if (member == _members.end()) {
+        return false;
+    }
+    setProperties(*member, properties);
+    return true;
+}
+
+void AvatarCrowd::setProperties(Member& member, const QVariantMap& properties) {
+    auto& avatar = *member.avatar;
+
+    auto skeletonModelURL = properties.find("skeletonModelURL");
+    if (skeletonModelURL != properties.end()) {
+        QUrl url = skeletonModelURL->toString();
+        member.hasOwnSkeleton = !url.isEmpty();
+        if (url != avatar.getSkeletonModelURL()) {
+            avatar.setSkeletonModelURL(url);
+            member.sendSkeleton = true;
+        }
+    }
+
+    auto displayName = properties.find("displayName");
+    if (displayName != properties.end()) {
+        avatar.setDisplayName(displayName->toString());
+    }
+
+    bool isValid = false;
+    auto position = properties.find("position");
+    if (position != properties.end()) {
+        glm::vec3 value = vec3FromVariant(*position, isValid);
+        if (isValid) {
+            avatar.setWorldPosition(value);
+        }
+    }
+    auto orientation = properties.find("orientation");
+    if (orientation != properties.end()) {
+        glm::quat value = quatFromVariant(*orientation, isValid);
+        if (isValid) {
+            avatar.setWorldOrientation(value);
+        }
+    }
+    if (member.clip && member.playFromCurrentLocation && (position != properties.end() || orientation != properties.end())) {
+        // the recording moves along with the avatar
+        member.avatar->clearRecordingBasis();
+        member.avatar->setRecordingBasis();
+    }
+}
+
+void AvatarCrowd::removeAvatar(const QUuid& avatarID) {
+    if (_members.remove(avatarID) > 0) {
+        _removedMembers.push_back(avatarID);
+    }
+}
+
+void AvatarCrowd::removeAllAvatars() {
+    for (auto it = _members.constBegin(); it != _members.constEnd(); ++it) {
+        _removedMembers.push_back(it.key());
+    }
+    _members.clear();
+
+    // the script may be stopping, don't wait for the next update to say so
+    sendToMixer();
+}
+
+QVector<QUuid> AvatarCrowd::getAvatarIDs() const {
+    return _members.keys().toVector();
+}
+
+bool AvatarCrowd::playRecording(const QUuid& avatarID, const QString& url, const QVariantMap& options) {
+    auto member = _members.find(avatarID);
+    if (member == _members.end()) {
+        return false;
+    }
+
+    member->clipURL = QUrl(url);
+    member->clip.reset();
+    member->loop = options.value("loop", true).toBool();
+    member->time = options.value("offset", 0.0f).toFloat();
+    member->playFromCurrentLocation = options.value("playFromCurrentLocation", true).toBool();
+    member->frameIndex = -1;
+
+    auto clip = _clips.value(member->clipURL).lock();
+    if (clip) {
+        member->clip = clip;
+        startPlaying(*member);
+    } else {
+        loadClip(member->clipURL);
+    }
+    return true;
+}
+
+void AvatarCrowd::stopRecording(const QUuid& avatarID) {
+    auto member = _members.find(avatarID);
+    if (member == _members.end()) {
+        return;
+    }
+    member->clipURL.clear();
+    member->clip.reset();
+    member->avatar->clearRecordingBasis();
+}
+
+void AvatarCrowd::loadClip(const QUrl& url) {
+    if (_clipLoaders.contains(url)) {
+        return;
+    }
+
+    auto clipLoader = DependencyManager::get<recording::ClipCache>()->getClipLoader(url);
+    if (clipLoader->isLoaded()) {
+        _clipLoaders.insert(url, clipLoader);
+        clipLoaded(url);
+        return;
+    }
+
+    // hold on to the loader until the clip is in
+    _clipLoaders.insert(url, clipLoader);
+    connect(clipLoader.data(), &recording::NetworkClipLoader::clipLoaded, this, [this, url] {
+        clipLoaded(url);
+    });
+    connect(clipLoader.data(), &recording::NetworkClipLoader::failed, this, [this, url] {
+        qCWarning(avatars) << "AvatarCrowd failed to load recording from" << url;
+        _clipLoaders.remove(url);
+    });
+}
+
+void AvatarCrowd::clipLoaded(const QUrl& url) {
+    auto clipLoader = _clipLoaders.take(url);
+    if (!clipLoader) {
+        return;
+    }
+
+    // decode the avatar frames once, every avatar playing the clip applies the same ones
+    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    auto decoded = std::make_shared<DecodedClip>();
+    auto clip = clipLoader->getClip()->duplicate();
+    clip->seekFrameTime(0);
+    for (auto frame = clip->nextFrame(); frame; frame = clip->nextFrame()) {
+        if (frame->type == AVATAR_FRAME_TYPE) {
+            decoded->times.push_back(frame->timeOffset);
+            decoded->frames.push_back(QJsonDocument::fromBinaryData(frame->data).object());
+        }
+    }
+    decoded->duration = clip->duration();
+
+    DecodedClipPointer shared = decoded;
+    _clips[url] = shared;
+    for (auto& member : _members) {
+        if (member.clipURL == url && !member.clip) {
+            member.clip = shared;
+            startPlaying(member);
+        }
+    }
+}
+
+void AvatarCrowd::startPlaying(Member& member) {
+    member.avatar->clearRecordingBasis();
+    if (member.playFromCurrentLocation) {
+        member.avatar->setRecordingBasis();
+    }
+
+    // these procedural movements are included in the recordings
+    member.avatar->setHasScriptedBlendshapes(true);
+    member.avatar->setHasProceduralEyeFaceMovement(false);
+    member.avatar->setHasProceduralBlinkFaceMovement(false);
+    member.avatar->setHasAudioEnabledFaceMovement(false);
+
+    advance(member, 0.0f);
+}
+
+void AvatarCrowd::advance(Member& member, float deltaTime) {
+    const auto& clip = *member.clip;
+    if (clip.frames.empty()) {
+        return;
+    }
+
+    member.time += deltaTime;
+    if (member.time >= clip.duration) {
+        member.time = (member.loop && clip.duration > 0.0f) ? std::fmod(member.time, clip.duration) : clip.duration;
+    }
+
+    auto time = recording::Frame::secondsToFrameTime(member.time);
+    auto next = std::upper_bound(clip.times.begin(), clip.times.end(), time);
+    int frameIndex = std::max((int)std::distance(clip.times.begin(), next) - 1, 0);
+    if (frameIndex == member.frameIndex) {
+        return;
+    }
+    member.frameIndex = frameIndex;
+
+    auto skeletonModelURL = member.avatar->getSkeletonModelURL();
+    member.avatar->fromJson(clip.frames[frameIndex], !member.hasOwnSkeleton);
+    if (member.avatar->getSkeletonModelURL() != skeletonModelURL) {
+        member.sendSkeleton = true;
+    }
+}
+
+void AvatarCrowd::update(float deltaTime) {
+    for (auto& member : _members) {
+        if (member.clip) {
+            advance(member, deltaTime);
+        }
+    }
+    sendToMixer();
+}
+
+void AvatarCrowd::sendToMixer() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (!avatarMixer || !avatarMixer->getActiveSocket()) {
+        return;
+    }
+
+    // identities, traits and removals have to get there, the avatar data is sent again soon enough
+    std::unique_ptr<NLPacketList> reliablePackets;
+    auto reliableEntry = [&](const QUuid& avatarID, PacketType type, const QByteArray& payload) {
+        if (!reliablePackets) {
+            reliablePackets = NLPacketList::create(PacketType::HostedAvatarData, QByteArray(), true, true);
+        }
+        writeEntry(*reliablePackets, avatarID, type, payload);
+    };
+
+    for (auto& avatarID : _removedMembers) {
+        QByteArray reason;
+        reason.append((char)KillAvatarReason::AvatarDisconnected);
+        reliableEntry(avatarID, PacketType::KillAvatar, reason);
+    }
+    _removedMembers.clear();
+
+    const int MAX_AVATAR_DATA_SIZE = NLPacket::maxPayloadSize(PacketType::HostedAvatarData) - ENTRY_HEADER_BYTES
+        - (int)sizeof(AvatarDataSequenceNumber);
+    std::unique_ptr<NLPacket> dataPacket;
+
+    for (auto it = _members.begin(); it != _members.end(); ++it) {
+        const QUuid& avatarID = it.key();
+        Member& member = it.value();
+        auto& avatar = *member.avatar;
+
+        if (member.sendIdentity || avatar.getIdentityDataChanged()) {
+            reliableEntry(avatarID, PacketType::AvatarIdentity, avatar.identityByteArrayForSend());
+            member.sendIdentity = false;
+        }
+
+        if (member.sendSkeleton) {
+            QByteArray traitData = avatar.packTrait(AvatarTraits::SkeletonModelURL);
+            QByteArray payload;
+            payload.append(reinterpret_cast<const char*>(&(++member.traitVersion)), sizeof(AvatarTraits::TraitVersion));
+            AvatarTraits::TraitType traitType = AvatarTraits::SkeletonModelURL;
+            AvatarTraits::TraitWireSize traitSize = traitData.size();
+            payload.append(reinterpret_cast<const char*>(&traitType), sizeof(traitType));
+            payload.append(reinterpret_cast<const char*>(&traitSize), sizeof(traitSize));
+            payload.append(traitData);
+            reliableEntry(avatarID, PacketType::SetAvatarTraits, payload);
+            member.sendSkeleton = false;
+        }
+
+        // as in AvatarData::sendAvatarDataPacket, every so often all of it goes out
+        bool cullSmallData = randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO;
+        auto dataDetail = cullSmallData ? AvatarData::SendAllData : AvatarData::CullSmallData;
+        QByteArray avatarByteArray = avatar.toByteArrayStateful(dataDetail);
+        if (avatarByteArray.size() > MAX_AVATAR_DATA_SIZE) {
+            avatarByteArray = avatar.toByteArrayStateful(dataDetail, true);
+            if (avatarByteArray.size() > MAX_AVATAR_DATA_SIZE) {
+                avatarByteArray = avatar.toByteArrayStateful(AvatarData::MinimumData, true);
+                if (avatarByteArray.size() > MAX_AVATAR_DATA_SIZE) {
+                    continue;
+                }
+            }
+        }
+        avatar.doneEncoding(cullSmallData);
+
+        avatarByteArray.prepend(reinterpret_cast<const char*>(&member.sequenceNumber), sizeof(AvatarDataSequenceNumber));
+        ++member.sequenceNumber;
+
+        if (dataPacket && dataPacket->bytesAvailableForWrite() < ENTRY_HEADER_BYTES + avatarByteArray.size()) {
+            nodeList->sendPacket(std::move(dataPacket), *avatarMixer);
+        }
+        if (!dataPacket) {
+            dataPacket = NLPacket::create(PacketType::HostedAvatarData);
+        }
+        writeEntry(*dataPacket, avatarID, PacketType::AvatarData, avatarByteArray);
+    }
+
+    if (dataPacket) {
+        nodeList->sendPacket(std::move(dataPacket), *avatarMixer);
+    }
+    if (reliablePackets) {
+        nodeList->sendPacketList(std::move(reliablePackets), *avatarMixer);
+    }
+}
@@ -0,0 +1,175 @@
+//
+//  AvatarCrowd.h
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarCrowd_h
+#define hifi_AvatarCrowd_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+#include <QtCore/QUuid>
+#include <QtCore/QVariantMap>
+
+#include <AvatarData.h>
+#include <Node.h>
+#include <recording/ClipCache.h>
+
+/*@jsdoc
+ * The <code>AvatarCrowd</code> API lets an assignment client script play many avatars at once, a crowd of recordings say,
+ * without each of them needing an assignment client of its own.
+ *
+ * <p>The avatars are sent to the avatar mixer in batches, on behalf of the assignment client, and other users see them as
+ * any other avatar. The avatars playing the same recording share one decoded copy of it. The avatar mixer limits how many
+ * avatars an assignment client can play.</p>
+ *
+ * <p>The avatars don't have audio, avatar entities or scripted animations.</p>
+ *
+ * @namespace AvatarCrowd
+ *
+ * @hifi-assignment-client
+ *
+ * @example <caption>Play a recording on a crowd of avatars.</caption>
+ * for (var i = 0; i < 20; i++) {
+ *     var avatarID = AvatarCrowd.addAvatar({
+ *         displayName: "Extra " + i,
+ *         position: { x: i * 2, y: 0, z: 0 }
+ *     });
+ *     AvatarCrowd.playRecording(avatarID, "atp:/recordings/wave.hfr", { offset: i * 0.5 });
+ * }
+ */
+class AvatarCrowd : public QObject {
+    Q_OBJECT
+
+public:
+    AvatarCrowd(QObject* parent = nullptr);
+
+    /*@jsdoc
+     * The properties of a crowd avatar.
+     * @typedef {object} AvatarCrowd.AvatarProperties
+     * @property {string} [skeletonModelURL] - The URL of the avatar's model. If set, the models in the recordings the
+     *     avatar plays are ignored.
+     * @property {string} [displayName] - The avatar's display name.
+     * @property {Vec3} [position] - The avatar's position, which recordings are played from.
+     * @property {Quat} [orientation] - The avatar's orientation, which recordings are played from.
+     */
+    /*@jsdoc
+     * Adds an avatar to the crowd.
+     * @function AvatarCrowd.addAvatar
+     * @param {AvatarCrowd.AvatarProperties} [properties] - The avatar's properties.
+     * @returns {Uuid} The ID of the avatar.
+     */
+    Q_INVOKABLE QUuid addAvatar(const QVariantMap& properties = QVariantMap());
+
+    /*@jsdoc
+     * Edits an avatar of the crowd.
+     * @function AvatarCrowd.editAvatar
+     * @param {Uuid} avatarID - The ID of the avatar.
+     * @param {AvatarCrowd.AvatarProperties} properties - The properties to change.
+     * @returns {boolean} <code>true</code> if the avatar is in the crowd, <code>false</code> if it isn't.
+     */
+    Q_INVOKABLE bool editAvatar(const QUuid& avatarID, const QVariantMap& properties);
+
+    /*@jsdoc
+     * Removes an avatar from the crowd.
+     * @function AvatarCrowd.removeAvatar
+     * @param {Uuid} avatarID - The ID of the avatar.
+     */
+    Q_INVOKABLE void removeAvatar(const QUuid& avatarID);
+
+    /*@jsdoc
+     * Removes all the avatars from the crowd.
+     * @function AvatarCrowd.removeAllAvatars
+     */
+    Q_INVOKABLE void removeAllAvatars();
+
+    /*@jsdoc
+     * Gets the IDs of the avatars in the crowd.
+     * @function AvatarCrowd.getAvatarIDs
+     * @returns {Uuid[]} The IDs of the avatars.
+     */
+    Q_INVOKABLE QVector<QUuid> getAvatarIDs() const;
+
+    /*@jsdoc
+     * The options for playing a recording on a crowd avatar.
+     * @typedef {object} AvatarCrowd.PlaybackOptions
+     * @property {boolean} [loop=true] - <code>true</code> if the recording plays in a loop, <code>false</code> if the avatar
+     *     stops at its end.
+     * @property {number} [offset=0] - The time into the recording to start from, in seconds. Different offsets keep the
+     *     avatars playing the same recording from moving in step.
+     * @property {boolean} [playFromCurrentLocation=true] - <code>true</code> if the recording is played from the avatar's
+     *     position and orientation, <code>false</code> if it is played where it was recorded.
+     */
+    /*@jsdoc
+     * Plays a recording on a crowd avatar. The recording is loaded first if it isn't already.
+     * @function AvatarCrowd.playRecording
+     * @param {Uuid} avatarID - The ID of the avatar.
+     * @param {string} url - The URL of the recording, as for {@link Recording.loadRecording}.
+     * @param {AvatarCrowd.PlaybackOptions} [options] - How to play the recording.
+     * @returns {boolean} <code>true</code> if the avatar is in the crowd, <code>false</code> if it isn't.
+     */
+    Q_INVOKABLE bool playRecording(const QUuid& avatarID, const QString& url, const QVariantMap& options = QVariantMap());
+
+    /*@jsdoc
+     * Stops playing the recording on a crowd avatar. The avatar stays where the recording left it.
+     * @function AvatarCrowd.stopRecording
+     * @param {Uuid} avatarID - The ID of the avatar.
+     */
+    Q_INVOKABLE void stopRecording(const QUuid& avatarID);
+
+public slots:
+    // advances the recordings and sends the avatars to the mixer, on each update of the script engine
+    void update(float deltaTime);
+
+private:
+    // the avatar frames of a recording, decoded once for all the avatars playing it
+    struct DecodedClip {
+        std::vector<recording::Frame::Time> times;
+        std::vector<QJsonObject> frames;
+        float duration { 0.0f };
+    };
+    using DecodedClipPointer = std::shared_ptr<const DecodedClip>;
+
+    struct Member {
+        AvatarSharedPointer avatar;
+        bool hasOwnSkeleton { false };
+
+        QUrl clipURL;
+        DecodedClipPointer clip;
+        float time { 0.0f };
+        bool loop { true };
+        bool playFromCurrentLocation { true };
+        int frameIndex { -1 };
+
+        AvatarDataSequenceNumber sequenceNumber { 0 };
+        AvatarTraits::TraitVersion traitVersion { AvatarTraits::DEFAULT_TRAIT_VERSION };
+        bool sendIdentity { true };
+        bool sendSkeleton { true };
+    };
+
+    void setProperties(Member& member, const QVariantMap& properties);
+    void loadClip(const QUrl& url);
+    void clipLoaded(const QUrl& url);
+    void startPlaying(Member& member);
+    void advance(Member& member, float deltaTime);
+    void sendToMixer();
+
+    QHash<QUuid, Member> _members;
+    std::vector<QUuid> _removedMembers;
+
+    QHash<QUrl, std::weak_ptr<const DecodedClip>> _clips;
+    QHash<QUrl, recording::NetworkClipLoaderPointer> _clipLoaders;
+};
+
+#endif // hifi_AvatarCrowd_h
@@ -13,6 +13,7 @@
 
 #include <cfloat>
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <random>
 #include <thread>
@@ -31,6 +32,7 @@
 #include <LogHandler.h>
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
+#include <SharedCounters.h>
 #include <SharedUtil.h>
 #include <UUID.h>
 #include <TryLocker.h>
@@ -71,7 +73,7 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &AvatarMixer::handleAvatarKilled);
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::AvatarData,
+    packetReceiver.registerDirectListener(PacketType::AvatarData,
         PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::queueIncomingPacket));
     packetReceiver.registerListener(PacketType::AdjustAvatarSorting,
         PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleAdjustAvatarSorting));
@@ -87,13 +89,15 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
         PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleRadiusIgnoreRequestPacket));
     packetReceiver.registerListener(PacketType::RequestsDomainListData,
         PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleRequestsDomainListDataPacket));
-    packetReceiver.registerListener(PacketType::SetAvatarTraits,
+    packetReceiver.registerDirectListener(PacketType::SetAvatarTraits,
         PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::queueIncomingPacket));
-    packetReceiver.registerListener(PacketType::BulkAvatarTraitsAck,
+    packetReceiver.registerDirectListener(PacketType::BulkAvatarTraitsAck,
+        PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::queueIncomingPacket));
+    packetReceiver.registerDirectListener(PacketType::BulkAvatarTraitsMiss,
         PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::queueIncomingPacket));
     packetReceiver.registerListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
         PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleOctreePacket));
-    packetReceiver.registerListener(PacketType::ChallengeOwnership,
+    packetReceiver.registerDirectListener(PacketType::ChallengeOwnership,
         PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::queueIncomingPacket));
 
     packetReceiver.registerListenerForTypes({
@@ -104,6 +108,9 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     packetReceiver.registerListener(PacketType::ReplicatedBulkAvatarData,
         PacketReceiver::makeUnsourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleReplicatedBulkAvatarPacket));
 
+    packetReceiver.registerListener(PacketType::HostedAvatarData,
+        PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleHostedAvatarPacket));
+
     auto nodeList = DependencyManager::get<NodeList>();
     connect(nodeList.data(), &NodeList::packetVersionMismatch, this, &AvatarMixer::handlePacketVersionMismatch);
     connect(nodeList.data(), &NodeList::nodeAdded, this, [this](const SharedNodePointer& node) {
@@ -180,9 +187,182 @@ void AvatarMixer::handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessag
     }
 }
 
+SharedNodePointer AvatarMixer::addOrUpdateHostedNode(const QUuid& avatarID, const SharedNodePointer& hostNode) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    auto host = _hostedAvatarHosts.find(avatarID);
+    if (host != _hostedAvatarHosts.end()) {
+        if (host.value() != hostNode->getUUID()) {
+            // another agent's avatar
+            return SharedNodePointer();
+        }
+
+        auto hostedNode = nodeList->nodeWithUUID(avatarID);
+        if (hostedNode) {
+            hostedNode->setLastHeardMicrostamp(usecTimestampNow());
+        }
+        return hostedNode;
+    }
+
+    auto& hostedAvatars = _hostedAvatars[hostNode->getUUID()];
+    if (hostedAvatars.size() >= _maxHostedAvatarsPerNode || nodeList->nodeWithUUID(avatarID)) {
+        return SharedNodePointer();
+    }
+
+    // hosted avatars get local IDs of their own, from the range the domain server leaves to us
+    const int NUM_HOSTED_LOCAL_IDS = std::numeric_limits<Node::LocalID>::max() - Node::MIN_HOSTED_LOCAL_ID + 1;
+    Node::LocalID localID = Node::NULL_LOCAL_ID;
+    for (int i = 0; i < NUM_HOSTED_LOCAL_IDS && localID == Node::NULL_LOCAL_ID; ++i) {
+        Node::LocalID candidate = _nextHostedLocalID;
+        _nextHostedLocalID = candidate == std::numeric_limits<Node::LocalID>::max() ?
+            Node::MIN_HOSTED_LOCAL_ID : candidate + 1;
+        if (!nodeList->nodeWithLocalID(candidate)) {
+            localID = candidate;
+        }
+    }
+    if (localID == Node::NULL_LOCAL_ID) {
+        return SharedNodePointer();
+    }
+
+    // like the replicated avatars, they share the address of the node sending them, and are never sent anything
+    auto hostedNode = nodeList->addOrUpdateNode(avatarID, NodeType::Agent, hostNode->getPublicSocket(),
+                                                hostNode->getLocalSocket(), localID, false, true);
+    hostedNode->setLastHeardMicrostamp(usecTimestampNow());
+
+    hostedAvatars.insert(avatarID);
+    _hostedAvatarHosts[avatarID] = hostNode->getUUID();
+    return hostedNode;
+}
+
+void AvatarMixer::handleHostedAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (senderNode->getType() != NodeType::Agent || senderNode->isUpstream() || _maxHostedAvatarsPerNode <= 0) {
+        return;
+    }
+
+    const int ENTRY_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + sizeof(quint8) + sizeof(quint16);
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // each entry is the avatar's ID, the type and size of the packet the avatar would have sent, and its payload
+    while (message->getBytesLeftToRead() >= ENTRY_HEADER_BYTES) {
+        auto avatarID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        quint8 type;
+        quint16 size;
+        message->readPrimitive(&type);
+        message->readPrimitive(&size);
+        if (message->getBytesLeftToRead() < size) {
+            break;
+        }
+        auto payload = message->read(size);
+
+        PacketType packetType = (PacketType)type;
+        if (packetType == PacketType::KillAvatar) {
+            if (_hostedAvatarHosts.value(avatarID) == senderNode->getUUID()) {
+                nodeList->killNodeWithUUID(avatarID);
+            }
+            continue;
+        }
+        if (packetType != PacketType::AvatarData && packetType != PacketType::AvatarIdentity
+            && packetType != PacketType::SetAvatarTraits) {
+            continue;
+        }
+
+        auto hostedNode = addOrUpdateHostedNode(avatarID, senderNode);
+        if (!hostedNode) {
+            continue;
+        }
+
+        auto hostedMessage = QSharedPointer<ReceivedMessage>::create(payload, packetType, versionForPacketType(packetType),
+                                                                     message->getSenderSockAddr(), hostedNode->getLocalID());
+        if (packetType == PacketType::AvatarIdentity) {
+            handleAvatarIdentityPacket(hostedMessage, hostedNode);
+        } else {
+            getOrCreateClientData(hostedNode)->queuePacket(hostedMessage, hostedNode);
+        }
+    }
+}
+
+void AvatarMixer::forgetHostedAvatars(const SharedNodePointer& killedNode) {
+    auto host = _hostedAvatarHosts.find(killedNode->getUUID());
+    if (host != _hostedAvatarHosts.end()) {
+        auto hostedAvatars = _hostedAvatars.find(host.value());
+        if (hostedAvatars != _hostedAvatars.end()) {
+            hostedAvatars->remove(killedNode->getUUID());
+            if (hostedAvatars->isEmpty()) {
+                _hostedAvatars.erase(hostedAvatars);
+            }
+        }
+        _hostedAvatarHosts.erase(host);
+        return;
+    }
+
+    // the avatars of an agent that went away go with it
+    auto hostedAvatars = _hostedAvatars.take(killedNode->getUUID());
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (auto& avatarID : hostedAvatars) {
+        _hostedAvatarHosts.remove(avatarID);
+        nodeList->killNodeWithUUID(avatarID);
+    }
+}
+
+bool AvatarMixer::shouldReplicate(const Node& node) {
+    if (node.isReplicated()) {
+        return true;
+    }
+
+    auto nodeData = reinterpret_cast<const AvatarMixerClientData*>(node.getLinkedData());
+    return node.getType() == NodeType::Agent && !node.isUpstream() && nodeData && nodeData->isInShardBoundary();
+}
+
+void AvatarMixer::updateShardBoundary(NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+    std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+        // the avatars replicated to us belong to the other shards
+        if (node->getType() != NodeType::Agent || node->isUpstream() || !node->getLinkedData()) {
+            return;
+        }
+
+        auto nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+        bool isInBoundary = _shard.isInBoundary(nodeData->getAvatar().getClientGlobalPosition());
+        if (isInBoundary) {
+            ++_sumShardBoundaryAvatars;
+        } else if (nodeData->isInShardBoundary() && !node->isReplicated()) {
+            _avatarsLeavingShardBoundary.push_back({ node->getUUID(), node->getLocalID() });
+        }
+        nodeData->setIsInShardBoundary(isInBoundary);
+    });
+}
+
+void AvatarMixer::sendShardBoundaryKills() {
+    if (_avatarsLeavingShardBoundary.empty()) {
+        return;
+    }
+
+    // the neighbours drop the avatars that went back into our shard, rather than waiting for them to go silent
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->eachMatchingNode([&](const SharedNodePointer& node) {
+        return node->getType() == NodeType::DownstreamAvatarMixer && node->getActiveSocket();
+    }, [&](const SharedNodePointer& node) {
+        auto nodeData = reinterpret_cast<AvatarMixerClientData*>(node->getLinkedData());
+
+        for (auto& avatar : _avatarsLeavingShardBoundary) {
+            auto replicatedKillPacket = NLPacket::create(PacketType::ReplicatedKillAvatar,
+                                                         NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason));
+            replicatedKillPacket->write(avatar.first.toRfc4122());
+            replicatedKillPacket->writePrimitive(KillAvatarReason::AvatarDisconnected);
+            nodeList->sendUnreliablePacket(*replicatedKillPacket, *node);
+
+            // so the identity goes out again if the avatar comes back to the edge
+            if (nodeData) {
+                nodeData->setLastBroadcastTime(avatar.second, 0);
+            }
+        }
+    });
+
+    _avatarsLeavingShardBoundary.clear();
+}
+
 void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node& node) {
     // first, make sure that this is a packet from a node we are supposed to replicate
-    if (node.isReplicated()) {
+    if (shouldReplicate(node)) {
 
         // check if this is a packet type we replicate
         // which means it must be a packet type present in REPLICATED_PACKET_MAPPING or must be the
@@ -216,8 +396,17 @@ void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node
 }
 
 void AvatarMixer::queueIncomingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+    _incomingPackets.push(message, node);
+}
+
+void AvatarMixer::queueIncomingPackets() {
     auto start = usecTimestampNow();
-    getOrCreateClientData(node)->queuePacket(message, node);
+    _incomingPackets.take(_takenPackets);
+
+    for (auto& entry : _takenPackets) {
+        getOrCreateClientData(entry.second)->queuePacket(entry.first, entry.second);
+    }
+    _takenPackets.clear();
     auto end = usecTimestampNow();
     _queueIncomingPacketElapsedTime += (end - start);
 }
@@ -292,6 +481,8 @@ void AvatarMixer::start() {
 
         // Allow nodes to process any pending/queued packets across our worker threads
         {
+            queueIncomingPackets();
+
             auto start = usecTimestampNow();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
@@ -334,6 +525,15 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
+
+                // index everybody's position once, the slaves only read it
+                _slaveSharedData.avatarGrid.rebuild(cbegin, cend);
+                ++_slaveSharedData.broadcastFrame;
+
+                if (_shard.isEnabled()) {
+                    updateShardBoundary(cbegin, cend);
+                }
+
                 _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
@@ -341,11 +541,16 @@ void AvatarMixer::start() {
             auto end = usecTimestampNow();
             _broadcastAvatarDataElapsedTime += (end - start);
 
+            sendShardBoundaryKills();
+
             _broadcastAvatarDataLockWait += lockWait;
             _broadcastAvatarDataNodeTransform += nodeTransform;
             _broadcastAvatarDataNodeFunctor += functor;
         }
 
+        static SharedCounter frames("avatar.frames");
+        frames.increment();
+
         ++frame;
         ++_numTightLoopFrames;
         _loopRate.increment();
@@ -490,6 +695,8 @@ void AvatarMixer::throttle(std::chrono::microseconds duration, int frame) {
 
 
 void AvatarMixer::handleAvatarKilled(SharedNodePointer avatarNode) {
+    forgetHostedAvatars(avatarNode);
+
     if (avatarNode->getType() == NodeType::Agent
         && avatarNode->getLinkedData()) {
         auto nodeList = DependencyManager::get<NodeList>();
@@ -525,7 +732,7 @@ void AvatarMixer::handleAvatarKilled(SharedNodePointer avatarNode) {
             // and downstream avatar mixers, if the node that was just killed was being replicatedConnectedAgent
             return node->getActiveSocket() &&
                 (((node->getType() == NodeType::Agent || node->getType() == NodeType::EntityScriptServer) && !node->isUpstream()) ||
-                 (avatarNode->isReplicated() && shouldReplicateTo(*avatarNode, *node)));
+                 (shouldReplicate(*avatarNode) && shouldReplicateTo(*avatarNode, *node)));
         }, [&](const SharedNodePointer& node) {
             if (node->getType() == NodeType::Agent || node->getType() == NodeType::EntityScriptServer) {
                 if (!killPacket) {
@@ -768,12 +975,10 @@ void AvatarMixer::sendStatsPacket() {
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
-#ifdef DEBUG_EVENT_QUEUE
     QJsonObject qtStats;
 
     _slavePool.queueStats(qtStats);
     statsObject["avatar_thread_event_queue"] = qtStats;
-#endif
 
     // this things all occur on the frequency of the tight loop
     int tightLoopFrames = _numTightLoopFrames;
@@ -782,6 +987,10 @@ void AvatarMixer::sendStatsPacket() {
     #define TIGHT_LOOP_STAT_UINT64(x) (x > (quint64)tenTimesPerFrame) ? x / tightLoopFrames : ((float)x / (float)tightLoopFrames);
 
     statsObject["average_listeners_last_second"] = TIGHT_LOOP_STAT(_sumListeners);
+    statsObject["hosted_avatars"] = _hostedAvatarHosts.size();
+    if (_shard.isEnabled()) {
+        statsObject["average_shard_boundary_avatars"] = TIGHT_LOOP_STAT(_sumShardBoundaryAvatars);
+    }
 
     QJsonObject singleCoreTasks;
     singleCoreTasks["processEvents"] = TIGHT_LOOP_STAT_UINT64(_processEventsElapsedTime);
@@ -851,6 +1060,14 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
 
+    float averageOthersConsidered = averageNodes ? aggregateStats.numOthersConsidered / averageNodes : 0.0f;
+    slavesAggregatObject["sent_8_averageOthersConsidered"] = TIGHT_LOOP_STAT(averageOthersConsidered);
+    slavesAggregatObject["sent_9_averageSharedEncodings"] = TIGHT_LOOP_STAT(aggregateStats.numSharedEncodings);
+    slavesAggregatObject["sent_10_averageCompactJointAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numCompactJointsIncluded);
+    slavesAggregatObject["sent_11_averageTraitJournalChecks"] = TIGHT_LOOP_STAT(aggregateStats.numTraitJournalChecks);
+    slavesAggregatObject["sent_12_averageTraitFullChecks"] = TIGHT_LOOP_STAT(aggregateStats.numTraitFullChecks);
+    slavesAggregatObject["sent_13_averageTraitsDeferred"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsDeferred);
+
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
     slavesAggregatObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime);
@@ -910,10 +1127,19 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["z_avatars"] = avatarsObject;
 
+    _metrics.setGauge("avatar_mixer_broadcast_loop_rate", _loopRate.rate());
+    _metrics.setGauge("avatar_mixer_trailing_mix_ratio", _trailingMixRatio);
+    _metrics.setGauge("avatar_mixer_throttling_ratio", _throttlingRatio);
+    _metrics.setGauge("avatar_mixer_listeners", (float)_sumListeners / (float)tightLoopFrames);
+    _metrics.setGauge("avatar_mixer_hosted_avatars", _hostedAvatarHosts.size());
+    _metrics.setGauge("avatar_mixer_over_budget_avatars", averageOverBudgetAvatars);
+    _metrics.setGauge("avatar_mixer_data_bytes_per_frame", (float)aggregateStats.numDataBytesSent / (float)tightLoopFrames);
+
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 
     _sumListeners = 0;
     _sumIdentityPackets = 0;
+    _sumShardBoundaryAvatars = 0;
     _numTightLoopFrames = 0;
 
     _broadcastAvatarDataElapsedTime = 0;
@@ -1059,6 +1285,13 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
     qCDebug(avatars) << "This domain requires a minimum avatar height of" << _domainMinimumHeight
                      << "and a maximum avatar height of" << _domainMaximumHeight;
 
+    _shard.configure(avatarMixerGroupObject);
+
+    static const QString MAX_HOSTED_AVATARS_OPTION = "max_hosted_avatars_per_node";
+    const int DEFAULT_MAX_HOSTED_AVATARS_PER_NODE = 100;
+    _maxHostedAvatarsPerNode = avatarMixerGroupObject[MAX_HOSTED_AVATARS_OPTION].toInt(DEFAULT_MAX_HOSTED_AVATARS_PER_NODE);
+    qCDebug(avatars) << "Agents can host up to" << _maxHostedAvatarsPerNode << "avatars each.";
+
     static const QString AVATAR_WHITELIST_OPTION = "avatar_whitelist";
     _slaveSharedData.skeletonURLWhitelist = avatarMixerGroupObject[AVATAR_WHITELIST_OPTION]
         .toString().split(',', QString::KeepEmptyParts);
@@ -1113,7 +1346,7 @@ void AvatarMixer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, Sh
         const auto piggyBackedSizeWithHeader = message->getBytesLeftToRead();
         if (piggyBackedSizeWithHeader > 0) {
             // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
-            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            auto buffer = udt::PacketBufferPool::allocate(piggyBackedSizeWithHeader);
             memcpy(buffer.get(), message->getRawMessage() + message->getPosition(), piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
@@ -18,12 +18,14 @@
 #include <set>
 #include <shared/RateCounter.h>
 #include <PortableHighResolutionClock.h>
+#include <ReceivedMessageQueue.h>
 
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
 #include "AvatarMixerClientData.h"
 
 #include "AvatarMixerSlavePool.h"
+#include "AvatarShard.h"
 
 /// Handles assignments of type AvatarMixer - distribution of avatar data to various clients
 class AvatarMixer : public ThreadedAssignment {
@@ -38,6 +40,9 @@ public:
             to.getLocalSocket() != from.getLocalSocket();
     }
 
+    // replicated users, and the local avatars near the edge of a shard, are sent on to the downstream mixers
+    static bool shouldReplicate(const Node& node);
+
 public slots:
     /// runs the avatar mixer
     void run() override;
@@ -52,6 +57,7 @@ public slots:
     void entityChange();
 
 private slots:
+    // called directly on the receiving thread
     void queueIncomingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     void handleAdjustAvatarSorting(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAvatarQueryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
@@ -62,6 +68,7 @@ private slots:
     void handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleReplicatedPacket(QSharedPointer<ReceivedMessage> message);
     void handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessage> message);
+    void handleHostedAvatarPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void domainSettingsRequestComplete();
     void handlePacketVersionMismatch(PacketType type, const HifiSockAddr& senderSockAddr, const QUuid& senderUUID);
     void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
@@ -69,6 +76,8 @@ private slots:
 
 private:
     AvatarMixerClientData* getOrCreateClientData(SharedNodePointer node);
+    // hands the packets queued by queueIncomingPacket to their nodes
+    void queueIncomingPackets();
     std::chrono::microseconds timeFrame(p_high_resolution_clock::time_point& timestamp);
     void throttle(std::chrono::microseconds duration, int frame);
 
@@ -79,8 +88,14 @@ private:
 
     void optionallyReplicatePacket(ReceivedMessage& message, const Node& node);
 
+    void updateShardBoundary(NodeList::const_iterator cbegin, NodeList::const_iterator cend);
+    void sendShardBoundaryKills();
+
     void setupEntityQuery();
 
+    SharedNodePointer addOrUpdateHostedNode(const QUuid& avatarID, const SharedNodePointer& hostNode);
+    void forgetHostedAvatars(const SharedNodePointer& killedNode);
+
     p_high_resolution_clock::time_point _lastFrameTimestamp;
 
     // Attach to entity tree for avatar-priority zone info.
@@ -101,6 +116,10 @@ private:
     float _domainMinimumHeight { MIN_AVATAR_HEIGHT };
     float _domainMaximumHeight { MAX_AVATAR_HEIGHT };
 
+    AvatarShard _shard;
+    std::vector<std::pair<QUuid, Node::LocalID>> _avatarsLeavingShardBoundary;
+    int _sumShardBoundaryAvatars { 0 };
+
     RateCounter<> _broadcastRate;
     p_high_resolution_clock::time_point _lastDebugMessage;
 
@@ -122,6 +141,12 @@ private:
 
     std::set<SessionDisplayName> _sessionDisplayNames;
 
+    // the avatars agents play on behalf of no client of their own, a crowd of recordings say, by the agent hosting them
+    QHash<QUuid, QSet<QUuid>> _hostedAvatars;
+    QHash<QUuid, QUuid> _hostedAvatarHosts;
+    Node::LocalID _nextHostedLocalID { Node::MIN_HOSTED_LOCAL_ID };
+    int _maxHostedAvatarsPerNode { 0 };
+
     quint64 _displayNameManagementElapsedTime { 0 }; // total time spent in broadcastAvatarData/display name management... since last stats window
     quint64 _ignoreCalculationElapsedTime { 0 };
     quint64 _avatarDataPackingElapsedTime { 0 };
@@ -146,6 +171,9 @@ private:
     quint64 _processEventsElapsedTime { 0 };
     quint64 _sendStatsElapsedTime { 0 };
     quint64 _queueIncomingPacketElapsedTime { 0 };
+
+    ReceivedMessageQueue _incomingPackets;
+    std::vector<ReceivedMessageQueue::Entry> _takenPackets;
     quint64 _lastStatsTime { usecTimestampNow() };
 
     RateCounter<> _loopRate; // this is the rate that the main thread tight loop runs
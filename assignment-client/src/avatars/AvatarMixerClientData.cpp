@@ -17,6 +17,7 @@
 #include <DependencyManager.h>
 #include <NodeList.h>
 #include <EntityTree.h>
+#include <Profile.h>
 #include <ZoneEntityItem.h>
 
 #include "AvatarLogging.h"
@@ -58,6 +59,9 @@ int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData
     assert(_packetQueue.empty() || node);
     _packetQueue.node.clear();
 
+    // a trace is only carried on by the broadcast of the frame it was received in
+    _traceID = tracing::NULL_TRACE_ID;
+
     while (!_packetQueue.empty()) {
         auto& packet = _packetQueue.front();
 
@@ -73,6 +77,9 @@ int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData
             case PacketType::BulkAvatarTraitsAck:
                 processBulkAvatarTraitsAckMessage(*packet);
                 break;
+            case PacketType::BulkAvatarTraitsMiss:
+                processBulkAvatarTraitsMissMessage(*packet);
+                break;
             case PacketType::ChallengeOwnership:
                 _avatar->processChallengeResponse(*packet);
                 break;
@@ -144,6 +151,10 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message, const SlaveShared
         incrementNumOutOfOrderSends();
     }
     _lastReceivedSequenceNumber = sequenceNumber;
+    if (message.getTraceID() != tracing::NULL_TRACE_ID) {
+        _traceID = message.getTraceID();
+        tracing::traceFlow(trace_network(), "AvatarData received", tracing::FlowStep, _traceID);
+    }
     glm::vec3 oldPosition = _avatar->getClientGlobalPosition();
     bool oldHasPriority = _avatar->getHasPriority();
 
@@ -227,6 +238,7 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
             if (packetTraitVersion > _lastReceivedTraitVersions[traitType]) {
                 _avatar->processTrait(traitType, message.read(traitSize));
                 _lastReceivedTraitVersions[traitType] = packetTraitVersion;
+                journalTraitChange(traitType);
                 if (traitType == AvatarTraits::SkeletonModelURL) {
                     // special handling for skeleton model URL, since we need to make sure it is in the whitelist
                     checkSkeletonURLAgainstWhitelist(slaveSharedData, sendingNode, packetTraitVersion);
@@ -279,6 +291,7 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                         instanceVersionRef = packetTraitVersion;
                     }
 
+                    journalTraitChange(traitType, instanceID);
                     anyTraitsChanged = true;
                 } else {
                     message.seek(message.getPosition() + traitSize);
@@ -314,11 +327,39 @@ void AvatarMixerClientData::emulateDeleteEntitiesTraitsMessage(const QList<QUuid
         // If a user subsequently has canRezAvatarEntities permission granted, they will have to relog in order for their
         // avatar entities to be visible to others.
         instanceVersionRef = -instanceVersionRef - 1;
+        journalTraitChange(traitType, entityID);
     }
 
     _lastReceivedTraitsChange = std::chrono::steady_clock::now();
 }
 
+void AvatarMixerClientData::journalTraitChange(AvatarTraits::TraitType traitType,
+                                               const AvatarTraits::TraitInstanceID& instanceID) {
+    auto& change = _traitChangeJournal[_traitChangeSequence % TRAIT_CHANGE_JOURNAL_SIZE];
+    change.traitType = traitType;
+    change.instanceID = instanceID;
+    ++_traitChangeSequence;
+}
+
+bool AvatarMixerClientData::getTraitChangesSince(uint64_t sequence, std::vector<TraitChange>& changes) const {
+    if (sequence > _traitChangeSequence || _traitChangeSequence - sequence > (uint64_t)TRAIT_CHANGE_JOURNAL_SIZE) {
+        return false;
+    }
+
+    changes.clear();
+    for (; sequence < _traitChangeSequence; ++sequence) {
+        const auto& change = _traitChangeJournal[sequence % TRAIT_CHANGE_JOURNAL_SIZE];
+        // a trait that changed several times goes out once, with its latest version
+        bool isDuplicate = std::any_of(changes.cbegin(), changes.cend(), [&](const TraitChange& other) {
+            return other.traitType == change.traitType && other.instanceID == change.instanceID;
+        });
+        if (!isDuplicate) {
+            changes.push_back(change);
+        }
+    }
+    return true;
+}
+
 void AvatarMixerClientData::processBulkAvatarTraitsAckMessage(ReceivedMessage& message) {
     // Avatar Traits flow control marks each outgoing avatar traits packet with a
     // sequence number. The mixer caches the traits sent in the traits packet.
@@ -375,6 +416,22 @@ void AvatarMixerClientData::processBulkAvatarTraitsAckMessage(ReceivedMessage& m
     }
 }
 
+void AvatarMixerClientData::processBulkAvatarTraitsMissMessage(ReceivedMessage& message) {
+    // The node was sent traits by hash that it doesn't have the content of anymore. It is sent all the traits of
+    // those avatars again, the ones it missed in full.
+    auto nodeList = DependencyManager::get<NodeList>();
+    while (message.getBytesLeftToRead() >= NUM_BYTES_RFC4122_UUID + AvatarTraits::TRAIT_HASH_SIZE) {
+        auto avatarID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        auto traitHash = message.read(AvatarTraits::TRAIT_HASH_SIZE);
+        _sentTraitHashes.remove(traitHash);
+
+        auto avatarNode = nodeList->nodeWithUUID(avatarID);
+        if (avatarNode) {
+            resetSentTraitData(avatarNode->getLocalID());
+        }
+    }
+}
+
 void AvatarMixerClientData::checkSkeletonURLAgainstWhitelist(const SlaveSharedData& slaveSharedData,
                                                              Node& sendingNode,
                                                              AvatarTraits::TraitVersion traitVersion) {
@@ -478,6 +535,7 @@ void AvatarMixerClientData::removeFromRadiusIgnoringSet(const QUuid& other) {
 
 void AvatarMixerClientData::resetSentTraitData(Node::LocalID nodeLocalID) {
     _lastSentTraitsTimestamps[nodeLocalID] = TraitsCheckTimestamp();
+    _lastSentTraitChangeSequences.erase(nodeLocalID);
     _perNodeSentTraitVersions[nodeLocalID].reset();
     _perNodeAckedTraitVersions[nodeLocalID].reset();
     for (auto&& pendingTraitVersions : _perNodePendingTraitVersions) {
@@ -534,10 +592,22 @@ AvatarMixerClientData::TraitsCheckTimestamp AvatarMixerClientData::getLastOtherA
     }
 }
 
+bool AvatarMixerClientData::getLastOtherAvatarTraitChangeSequence(Node::LocalID otherAvatar, uint64_t& sequence) const {
+    auto it = _lastSentTraitChangeSequences.find(otherAvatar);
+
+    if (it != _lastSentTraitChangeSequences.end()) {
+        sequence = it->second;
+        return true;
+    } else {
+        return false;
+    }
+}
+
 void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLocalID) {
     removeLastBroadcastSequenceNumber(nodeLocalID);
     removeLastBroadcastTime(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
+    _lastSentTraitChangeSequences.erase(nodeLocalID);
     _perNodeSentTraitVersions.erase(nodeLocalID);
     _perNodeAckedTraitVersions.erase(nodeLocalID);
     for (auto&& pendingTraitVersions : _perNodePendingTraitVersions) {
@@ -13,6 +13,7 @@
 #define hifi_AvatarMixerClientData_h
 
 #include <algorithm>
+#include <array>
 #include <cfloat>
 #include <unordered_map>
 #include <vector>
@@ -59,6 +60,10 @@ public:
     bool isIgnoreRadiusEnabled() const { return _isIgnoreRadiusEnabled; }
     void setIsIgnoreRadiusEnabled(bool enabled) { _isIgnoreRadiusEnabled = enabled; }
 
+    // updated every frame by a sharded mixer, see AvatarShard
+    bool isInShardBoundary() const { return _isInShardBoundary; }
+    void setIsInShardBoundary(bool isInShardBoundary) { _isInShardBoundary = isInShardBoundary; }
+
     uint64_t getLastBroadcastTime(NLPacket::LocalID nodeUUID) const;
     void setLastBroadcastTime(NLPacket::LocalID nodeUUID, uint64_t broadcastTime) { _lastBroadcastTimes[nodeUUID] = broadcastTime; }
     Q_INVOKABLE void removeLastBroadcastTime(NLPacket::LocalID nodeUUID) { _lastBroadcastTimes.erase(nodeUUID); }
@@ -66,6 +71,8 @@ public:
     Q_INVOKABLE void cleanupKilledNode(const QUuid& nodeUUID, Node::LocalID nodeLocalID);
 
     uint16_t getLastReceivedSequenceNumber() const { return _lastReceivedSequenceNumber; }
+    // of the avatar data received this frame, to pass on to the listeners
+    tracing::TraceID getTraceID() const { return _traceID; }
 
     uint64_t getIdentityChangeTimestamp() const { return _identityChangeTimestamp; }
     void flagIdentityChange() { _identityChangeTimestamp = usecTimestampNow(); }
@@ -76,6 +83,10 @@ public:
     void incrementNumAvatarsSentLastFrame() { ++_numAvatarsSentLastFrame; }
     int getNumAvatarsSentLastFrame() const { return _numAvatarsSentLastFrame; }
 
+    // the other avatar that may send one avatar entity over this node's frame budget, see AvatarEntityBudget
+    Node::LocalID getAvatarEntityOverBudgetSender() const { return _avatarEntityOverBudgetSender; }
+    void setAvatarEntityOverBudgetSender(Node::LocalID sender) { _avatarEntityOverBudgetSender = sender; }
+
     void recordNumOtherAvatarStarves(int numAvatarsHeldBack) { _otherAvatarStarves.updateAverage((float) numAvatarsHeldBack); }
     float getAvgNumOtherAvatarStarvesPerSecond() const { return _otherAvatarStarves.getAverageSampleValuePerSecond(); }
 
@@ -134,6 +145,7 @@ public:
     void processSetTraitsMessage(ReceivedMessage& message, const SlaveSharedData& slaveSharedData, Node& sendingNode);
     void emulateDeleteEntitiesTraitsMessage(const QList<QUuid>& avatarEntityIDs);
     void processBulkAvatarTraitsAckMessage(ReceivedMessage& message);
+    void processBulkAvatarTraitsMissMessage(ReceivedMessage& message);
     void checkSkeletonURLAgainstWhitelist(const SlaveSharedData& slaveSharedData, Node& sendingNode,
                                           AvatarTraits::TraitVersion traitVersion);
 
@@ -148,6 +160,24 @@ public:
     void setLastOtherAvatarTraitsSendPoint(Node::LocalID otherAvatar, TraitsCheckTimestamp sendPoint)
         { _lastSentTraitsTimestamps[otherAvatar] = sendPoint; }
 
+    // Ring of the most recent trait changes of this avatar. A listener that is caught up with an earlier point of the
+    // journal only has to look at the traits changed since, instead of comparing the versions of every trait.
+    struct TraitChange {
+        AvatarTraits::TraitType traitType { AvatarTraits::NullTrait };
+        AvatarTraits::TraitInstanceID instanceID;
+    };
+    static const int TRAIT_CHANGE_JOURNAL_SIZE = 64;
+
+    // the number of trait changes journaled since this avatar connected
+    uint64_t getTraitChangeSequence() const { return _traitChangeSequence; }
+    // the distinct traits changed from sequence on, false if some of those changes already fell out of the ring
+    bool getTraitChangesSince(uint64_t sequence, std::vector<TraitChange>& changes) const;
+
+    // the point of another avatar's journal this node is caught up with, false if it has to compare every trait
+    bool getLastOtherAvatarTraitChangeSequence(Node::LocalID otherAvatar, uint64_t& sequence) const;
+    void setLastOtherAvatarTraitChangeSequence(Node::LocalID otherAvatar, uint64_t sequence)
+        { _lastSentTraitChangeSequences[otherAvatar] = sequence; }
+
     AvatarTraits::TraitMessageSequence getTraitsMessageSequence() const { return _currentTraitsMessageSequence; }
     AvatarTraits::TraitMessageSequence nextTraitsMessageSequence() { return ++_currentTraitsMessageSequence; }
     AvatarTraits::TraitVersions& getPendingTraitVersions(AvatarTraits::TraitMessageSequence seq, Node::LocalID otherId) {
@@ -159,6 +189,8 @@ public:
 
     void resetSentTraitData(Node::LocalID nodeID);
 
+    AvatarTraits::TraitHashes& getSentTraitHashes() { return _sentTraitHashes; }
+
 private:
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
@@ -168,6 +200,7 @@ private:
     MixerAvatarSharedPointer _avatar { new MixerAvatar() };
 
     uint16_t _lastReceivedSequenceNumber { 0 };
+    tracing::TraceID _traceID { tracing::NULL_TRACE_ID };
     std::unordered_map<NLPacket::LocalID, uint16_t> _lastBroadcastSequenceNumbers;
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastBroadcastTimes;
 
@@ -181,6 +214,7 @@ private:
     bool _avatarSkeletonModelUrlMustChange{ false };
 
     int _numAvatarsSentLastFrame = 0;
+    Node::LocalID _avatarEntityOverBudgetSender { Node::NULL_LOCAL_ID };
     int _numFramesSinceAdjustment = 0;
 
     SimpleMovingAverage _otherAvatarStarves;
@@ -198,9 +232,15 @@ private:
     bool _requestsDomainListData { false };
     bool _prevRequestsDomainListData{ false };
 
+    void journalTraitChange(AvatarTraits::TraitType traitType,
+                            const AvatarTraits::TraitInstanceID& instanceID = AvatarTraits::TraitInstanceID());
+
     AvatarTraits::TraitVersions _lastReceivedTraitVersions;
     TraitsCheckTimestamp _lastReceivedTraitsChange;
 
+    std::array<TraitChange, TRAIT_CHANGE_JOURNAL_SIZE> _traitChangeJournal;
+    uint64_t _traitChangeSequence { 0 };
+
     AvatarTraits::TraitMessageSequence _currentTraitsMessageSequence{ 0 };
 
     // Cache of trait versions sent in a given packet (indexed by sequence number)
@@ -218,12 +258,18 @@ private:
     PerNodeTraitVersions _perNodeAckedTraitVersions;
 
     std::unordered_map<Node::LocalID, TraitsCheckTimestamp> _lastSentTraitsTimestamps;
+    std::unordered_map<Node::LocalID, uint64_t> _lastSentTraitChangeSequences;
 
     // cache of traits sent to a node which are compared to incoming traits to 
     // prevent sending traits that have already been sent.
     PerNodeTraitVersions _perNodeSentTraitVersions;
 
+    // the hashes of the traits of any avatar sent to this node in full, it is sent the same content again by hash
+    AvatarTraits::TraitHashes _sentTraitHashes;
+
     std::atomic_bool _isIgnoreRadiusEnabled { false };
+    // written by the slaves once per frame, read by shouldReplicate on the packet threads
+    std::atomic_bool _isInShardBoundary { false };
 };
 
 #endif // hifi_AvatarMixerClientData_h
@@ -26,7 +26,9 @@
 #include <Node.h>
 #include <OctreeConstants.h>
 #include <PrioritySortUtil.h>
+#include <Profile.h>
 #include <udt/PacketHeaders.h>
+#include <SharedCounters.h>
 #include <SharedUtil.h>
 #include <StDev.h>
 #include <UUID.h>
@@ -63,8 +65,11 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
     auto start = usecTimestampNow();
     auto nodeData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
     if (nodeData) {
+        static SharedCounter packetsProcessed("avatar.packetsProcessed");
+        int numPackets = nodeData->processPackets(*_sharedData);
+        packetsProcessed.increment(numPackets);
         _stats.nodesProcessed++;
-        _stats.packetsProcessed += nodeData->processPackets(*_sharedData);
+        _stats.packetsProcessed += numPackets;
     }
     auto end = usecTimestampNow();
     _stats.processIncomingPacketsElapsedTime += (end - start);
@@ -100,7 +105,8 @@ qint64 AvatarMixerSlave::addTraitsNodeHeader(AvatarMixerClientData* listeningNod
 
 qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* listeningNodeData,
                                                       const AvatarMixerClientData* sendingNodeData,
-                                                      NLPacketList& traitsPacketList) {
+                                                      NLPacketList& traitsPacketList,
+                                                      AvatarEntityBudget& avatarEntityBudget) {
 
     // Avatar Traits flow control marks each outgoing avatar traits packet with a
     // sequence number. The mixer caches the traits sent in the traits packet.
@@ -128,11 +134,8 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
         auto& lastAckedVersions = listeningNodeData->getLastAckedTraitVersions(sendingNodeLocalID);
         const auto& lastReceivedVersions = sendingNodeData->getLastReceivedTraitVersions();
 
-        auto simpleReceivedIt = lastReceivedVersions.simpleCBegin();
-        while (simpleReceivedIt != lastReceivedVersions.simpleCEnd()) {
-            auto traitType = static_cast<AvatarTraits::TraitType>(std::distance(lastReceivedVersions.simpleCBegin(),
-                                                                                simpleReceivedIt));
-            auto lastReceivedVersion = *simpleReceivedIt;
+        auto addSimpleTrait = [&](AvatarTraits::TraitType traitType) {
+            auto lastReceivedVersion = lastReceivedVersions[traitType];
             auto& lastSentVersionRef = lastSentVersions[traitType];
             auto& lastAckedVersionRef = lastAckedVersions[traitType];
 
@@ -142,7 +145,8 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
                     bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
                     // there is an update to this trait, add it to the traits packet
                     bytesWritten += AvatarTraits::packVersionedTrait(traitType, traitsPacketList,
-                                                                     lastReceivedVersion, *sendingAvatar);
+                                                                     lastReceivedVersion, *sendingAvatar,
+                                                                     &listeningNodeData->getSentTraitHashes());
                     // update the last sent version
                     lastSentVersionRef = lastReceivedVersion;
                     // Remember which versions we sent in this particular packet
@@ -153,83 +157,139 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
             } else {
                 allTraitsUpdated = false;
             }
+        };
 
-            ++simpleReceivedIt;
-        }
-
-        // enumerate the received instanced trait versions
-        auto instancedReceivedIt = lastReceivedVersions.instancedCBegin();
-        while (instancedReceivedIt != lastReceivedVersions.instancedCEnd()) {
-            auto traitType = instancedReceivedIt->traitType;
-
+        auto addTraitInstance = [&](AvatarTraits::TraitType traitType, AvatarTraits::TraitInstanceID instanceID,
+                                    AvatarTraits::TraitVersion receivedVersion) {
             // get or create the sent trait versions for this trait type
             auto& sentIDValuePairs = lastSentVersions.getInstanceIDValuePairs(traitType);
             auto& ackIDValuePairs = lastAckedVersions.getInstanceIDValuePairs(traitType);
 
-            // enumerate each received instance
-            for (auto& receivedInstance : instancedReceivedIt->instances) {
-                auto instanceID = receivedInstance.id;
-                const auto receivedVersion = receivedInstance.value;
-
-                // to track deletes and maintain version information for traits
-                // the mixer stores the negative value of the received version when a trait instance is deleted
-                bool isDeleted = receivedVersion < 0;
-                const auto absoluteReceivedVersion = std::abs(receivedVersion);
-
-                // look for existing sent version for this instance
-                auto sentInstanceIt = std::find_if(sentIDValuePairs.begin(), sentIDValuePairs.end(),
-                                                   [instanceID](auto& sentInstance)
-                                                   {
-                                                       return sentInstance.id == instanceID;
-                                                   });
-                // look for existing acked version for this instance
-                auto ackedInstanceIt = std::find_if(ackIDValuePairs.begin(), ackIDValuePairs.end(),
-                                                    [instanceID](auto& ackInstance) { return ackInstance.id == instanceID; });
-                
-                // if we have a sent version, then we must have an acked instance of the same trait with the same
-                // version to go on, otherwise we drop the received trait
-                if (sentInstanceIt != sentIDValuePairs.end() &&
-                    (ackedInstanceIt == ackIDValuePairs.end() || sentInstanceIt->value != ackedInstanceIt->value)) {
-                    allTraitsUpdated = false;
-                    continue;
+            // to track deletes and maintain version information for traits
+            // the mixer stores the negative value of the received version when a trait instance is deleted
+            bool isDeleted = receivedVersion < 0;
+            const auto absoluteReceivedVersion = std::abs(receivedVersion);
+
+            // look for existing sent version for this instance
+            auto sentInstanceIt = std::find_if(sentIDValuePairs.begin(), sentIDValuePairs.end(),
+                                               [instanceID](auto& sentInstance)
+                                               {
+                                                   return sentInstance.id == instanceID;
+                                               });
+            // look for existing acked version for this instance
+            auto ackedInstanceIt = std::find_if(ackIDValuePairs.begin(), ackIDValuePairs.end(),
+                                                [instanceID](auto& ackInstance) { return ackInstance.id == instanceID; });
+
+            // if we have a sent version, then we must have an acked instance of the same trait with the same
+            // version to go on, otherwise we drop the received trait
+            if (sentInstanceIt != sentIDValuePairs.end() &&
+                (ackedInstanceIt == ackIDValuePairs.end() || sentInstanceIt->value != ackedInstanceIt->value)) {
+                allTraitsUpdated = false;
+                return;
+            }
+            if (!isDeleted && (sentInstanceIt == sentIDValuePairs.end() || receivedVersion > sentInstanceIt->value)) {
+                if (traitType == AvatarTraits::AvatarEntity) {
+                    if (!avatarEntityBudget.canSendAvatarEntity(bytesWritten)) {
+                        // left for a frame with room for it, the sent versions don't move so it is looked at again
+                        allTraitsUpdated = false;
+                        _stats.numTraitsDeferred++;
+                        return;
+                    }
                 }
-                if (!isDeleted && (sentInstanceIt == sentIDValuePairs.end() || receivedVersion > sentInstanceIt->value)) {
-                    bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
 
-                    // this instance version exists and has never been sent or is newer so we need to send it
-                    bytesWritten += AvatarTraits::packVersionedTraitInstance(traitType, instanceID, traitsPacketList,
-                                                                             receivedVersion, *sendingAvatar);
+                bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
 
-                    if (sentInstanceIt != sentIDValuePairs.end()) {
-                        sentInstanceIt->value = receivedVersion;
-                    } else {
-                        sentIDValuePairs.emplace_back(instanceID, receivedVersion);
-                    }
+                // this instance version exists and has never been sent or is newer so we need to send it
+                bytesWritten += AvatarTraits::packVersionedTraitInstance(traitType, instanceID, traitsPacketList,
+                                                                         receivedVersion, *sendingAvatar,
+                                                                         &listeningNodeData->getSentTraitHashes());
 
-                    auto& pendingTraitVersions =
-                        listeningNodeData->getPendingTraitVersions(listeningNodeData->getTraitsMessageSequence(),
-                                                                   sendingNodeLocalID);
-                    pendingTraitVersions.instanceInsert(traitType, instanceID, receivedVersion);
+                if (sentInstanceIt != sentIDValuePairs.end()) {
+                    sentInstanceIt->value = receivedVersion;
+                } else {
+                    sentIDValuePairs.emplace_back(instanceID, receivedVersion);
+                }
 
-                } else if (isDeleted && sentInstanceIt != sentIDValuePairs.end() && absoluteReceivedVersion > sentInstanceIt->value) {
-                    bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
+                auto& pendingTraitVersions =
+                    listeningNodeData->getPendingTraitVersions(listeningNodeData->getTraitsMessageSequence(),
+                                                               sendingNodeLocalID);
+                pendingTraitVersions.instanceInsert(traitType, instanceID, receivedVersion);
+
+            } else if (isDeleted && sentInstanceIt != sentIDValuePairs.end() && absoluteReceivedVersion > sentInstanceIt->value) {
+                bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
+
+                // this instance version was deleted and we haven't sent the delete to this client yet
+                bytesWritten += AvatarTraits::packInstancedTraitDelete(traitType, instanceID, traitsPacketList, absoluteReceivedVersion);
+
+                // update the last sent version for this trait instance to the absolute value of the deleted version
+                sentInstanceIt->value = absoluteReceivedVersion;
+
+                auto& pendingTraitVersions =
+                    listeningNodeData->getPendingTraitVersions(listeningNodeData->getTraitsMessageSequence(),
+                                                               sendingNodeLocalID);
+                pendingTraitVersions.instanceInsert(traitType, instanceID, absoluteReceivedVersion);
 
-                    // this instance version was deleted and we haven't sent the delete to this client yet
-                    bytesWritten += AvatarTraits::packInstancedTraitDelete(traitType, instanceID, traitsPacketList, absoluteReceivedVersion);
+            }
+        };
+
+        // when we were caught up with the sender's trait journal, only the traits changed since need a look
+        uint64_t lastTraitChangeSequence = 0;
+        std::vector<AvatarMixerClientData::TraitChange> traitChanges;
+        if (listeningNodeData->getLastOtherAvatarTraitChangeSequence(sendingNodeLocalID, lastTraitChangeSequence)
+            && sendingNodeData->getTraitChangesSince(lastTraitChangeSequence, traitChanges)) {
+            _stats.numTraitJournalChecks++;
+
+            for (const auto& traitChange : traitChanges) {
+                if (AvatarTraits::isSimpleTrait(traitChange.traitType)) {
+                    addSimpleTrait(traitChange.traitType);
+                    continue;
+                }
+
+                auto instancedReceivedIt = std::find_if(lastReceivedVersions.instancedCBegin(),
+                                                        lastReceivedVersions.instancedCEnd(),
+                                                        [&](auto& traitInstances) {
+                                                            return traitInstances.traitType == traitChange.traitType;
+                                                        });
+                if (instancedReceivedIt == lastReceivedVersions.instancedCEnd()) {
+                    continue;
+                }
 
-                    // update the last sent version for this trait instance to the absolute value of the deleted version
-                    sentInstanceIt->value = absoluteReceivedVersion;
+                auto receivedInstanceIt = std::find_if(instancedReceivedIt->instances.cbegin(),
+                                                       instancedReceivedIt->instances.cend(),
+                                                       [&](auto& receivedInstance) {
+                                                           return receivedInstance.id == traitChange.instanceID;
+                                                       });
+                if (receivedInstanceIt != instancedReceivedIt->instances.cend()) {
+                    addTraitInstance(traitChange.traitType, receivedInstanceIt->id, receivedInstanceIt->value);
+                }
+            }
+        } else {
+            _stats.numTraitFullChecks++;
 
-                    auto& pendingTraitVersions =
-                        listeningNodeData->getPendingTraitVersions(listeningNodeData->getTraitsMessageSequence(),
-                                                                   sendingNodeLocalID);
-                    pendingTraitVersions.instanceInsert(traitType, instanceID, absoluteReceivedVersion);
+            auto simpleReceivedIt = lastReceivedVersions.simpleCBegin();
+            while (simpleReceivedIt != lastReceivedVersions.simpleCEnd()) {
+                addSimpleTrait(static_cast<AvatarTraits::TraitType>(std::distance(lastReceivedVersions.simpleCBegin(),
+                                                                                  simpleReceivedIt)));
+                ++simpleReceivedIt;
+            }
 
+            // enumerate the received instanced trait versions
+            auto instancedReceivedIt = lastReceivedVersions.instancedCBegin();
+            while (instancedReceivedIt != lastReceivedVersions.instancedCEnd()) {
+                // enumerate each received instance
+                for (auto& receivedInstance : instancedReceivedIt->instances) {
+                    addTraitInstance(instancedReceivedIt->traitType, receivedInstance.id, receivedInstance.value);
                 }
+
+                ++instancedReceivedIt;
             }
+        }
 
-            ++instancedReceivedIt;
+        if (allTraitsUpdated) {
+            listeningNodeData->setLastOtherAvatarTraitChangeSequence(sendingNodeLocalID,
+                                                                     sendingNodeData->getTraitChangeSequence());
         }
+
         if (bytesWritten) {
             // write a null trait type to mark the end of trait data for this avatar
             bytesWritten += traitsPacketList.writePrimitive(AvatarTraits::NullTrait);
@@ -251,7 +311,7 @@ int AvatarMixerSlave::sendReplicatedIdentityPacket(const Node& agentNode, const
         individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122()); // FIXME, this looks suspicious
         auto identityPacket = NLPacketList::create(PacketType::ReplicatedAvatarIdentity, QByteArray(), true, true);
         identityPacket->write(individualData);
-        DependencyManager::get<NodeList>()->sendPacketList(std::move(identityPacket), destinationNode);
+        DependencyManager::getRef<NodeList>().sendPacketList(std::move(identityPacket), destinationNode);
         _stats.numIdentityPacketsSent++;
         _stats.numIdentityBytesSent += individualData.size();
         return individualData.size();
@@ -262,6 +322,13 @@ int AvatarMixerSlave::sendReplicatedIdentityPacket(const Node& agentNode, const
 
 static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 
+// beyond this distance from the receiver (in meters) joints are sent with the compact quantization
+static const float FAR_JOINTS_DISTANCE = 20.0f;
+
+// the part of a receiver's frame budget the avatar entities of the others can take, in the order of the avatars, so
+// that a crowd coming in doesn't send all its wearables at once
+static const float DEFERRABLE_TRAITS_FRAME_FRACTION = 0.25f;
+
 void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
     quint64 start = usecTimestampNow();
 
@@ -314,7 +381,7 @@ namespace {
 void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node) {
     const Node* destinationNode = node.data();
 
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto& nodeList = DependencyManager::getRef<NodeList>();
 
     // setup for distributed random floating point values
     std::random_device randomDevice;
@@ -344,9 +411,18 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     int identityBytesSent = 0;
     int traitBytesSent = 0;
 
+    // the client's link may have less room for the avatars than the mixer gives any node
+    float maxKbps = _maxKbpsPerNode;
+    float downstreamShareKbps = destinationNodeData->getDownstreamShareKbps();
+    if (downstreamShareKbps > 0.0f) {
+        maxKbps = std::min(maxKbps, downstreamShareKbps);
+    }
+
     // max number of avatarBytes per frame (13 900, typical)
-    const int maxAvatarBytesPerFrame = int(_maxKbpsPerNode * BYTES_PER_KILOBIT / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+    const int maxAvatarBytesPerFrame = int(maxKbps * BYTES_PER_KILOBIT / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
     const int maxHeroBytesPerFrame = int(maxAvatarBytesPerFrame * _avatarHeroFraction);  // 5555, typical
+    AvatarEntityBudget avatarEntityBudget(qint64(maxAvatarBytesPerFrame * DEFERRABLE_TRAITS_FRAME_FRACTION),
+                                          destinationNodeData->getAvatarEntityOverBudgetSender());
 
     // keep track of the number of other avatars held back in this frame
     int numAvatarsHeldBack = 0;
@@ -376,24 +452,32 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     using AvatarPriorityQueue = PrioritySortUtil::PriorityQueue<SortableAvatar>;
     // Keep two independent queues, one for heroes and one for the riff-raff.
     enum PriorityVariants { kHero, kNonhero };
-    AvatarPriorityQueue avatarPriorityQueues[2] =
+    // kept by the thread of the slave, from one agent to the next, so that their storage is reused
+    static thread_local AvatarPriorityQueue avatarPriorityQueues[2] =
     {
         {cameraViews, AvatarData::_avatarSortCoefficientSize, 
             AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge},
         {cameraViews, AvatarData::_avatarSortCoefficientSize,
             AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge}
     };
+    for (auto& avatarPriorityQueue : avatarPriorityQueues) {
+        avatarPriorityQueue.setViews(cameraViews);
+        avatarPriorityQueue.setWeights(AvatarData::_avatarSortCoefficientSize, AvatarData::_avatarSortCoefficientCenter,
+                                       AvatarData::_avatarSortCoefficientAge);
+        avatarPriorityQueue.clear();
+    }
 
     avatarPriorityQueues[kNonhero].reserve(_end - _begin);
 
-    for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
-        Node* otherNodeRaw = (*listedNode).data();
+    auto considerNode = [&](Node* otherNodeRaw) {
         if (otherNodeRaw->getType() != NodeType::Agent
             || !otherNodeRaw->getLinkedData()
             || otherNodeRaw == destinationNode) {
-            continue;
+            return;
         }
 
+        ++_stats.numOthersConsidered;
+
         auto sourceAvatarNode = otherNodeRaw;
 
         bool sendAvatar = true;  // We will consider this source avatar for sending.
@@ -497,11 +581,22 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
             packet->write(sourceAvatarNode->getUUID().toRfc4122());
             packet->writePrimitive(KillAvatarReason::AvatarIgnored);
-            nodeList->sendPacket(std::move(packet), *destinationNode);
+            nodeList.sendPacket(std::move(packet), *destinationNode);
             destinationNodeData->cleanupKilledNode(sourceAvatarNode->getUUID(), sourceAvatarNode->getLocalID());
         }
 
         destinationNodeData->setPrevRequestsDomainListData(PALIsOpen);
+    };
+
+    // in a crowd, only consider the avatars around this one plus a sample of the rest
+    // with the PAL open, or just closed, the destination needs to hear about everybody
+    const auto& avatarGrid = _sharedData->avatarGrid;
+    if (avatarGrid.isActive() && !PALIsOpen && !PALWasOpen) {
+        avatarGrid.eachCandidate(destinationPosition, destinationNode->getLocalID(), considerNode);
+    } else {
+        for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
+            considerNode((*listedNode).data());
+        }
     }
 
     // loop through our sorted avatars and allocate our bandwidth to them accordingly
@@ -516,6 +611,15 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     int numAvatarsSent = 0;
     auto identityPacketList = NLPacketList::create(PacketType::AvatarIdentity, QByteArray(), true, true);
 
+    // the first traced avatar written in a packet carries its trace on to the receiver
+    auto traceAvatarPacket = [&](const AvatarMixerClientData* sourceNodeData) {
+        auto traceID = sourceNodeData->getTraceID();
+        if (traceID != tracing::NULL_TRACE_ID && avatarPacket->getTraceID() == tracing::NULL_TRACE_ID) {
+            avatarPacket->writeTraceID(traceID);
+            tracing::traceFlow(trace_network(), "BulkAvatarData sent", tracing::FlowStep, traceID);
+        }
+    };
+
     // Loop over two priorities - hero avatars then everyone else:
     for (PriorityVariants currentVariant = kHero; currentVariant <= kNonhero; ++((int&)currentVariant)) {
         const auto& sortedAvatarVector = avatarPriorityQueues[currentVariant].getSortedVector(numToSendEst);
@@ -575,12 +679,59 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
             QVector<JointData>& lastSentJointsForOther = destinationNodeData->getLastOtherAvatarSentJoints(sourceNode->getLocalID());
 
-            const bool distanceAdjust = true;
             const bool dropFaceTracking = false;
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
 
-            do {
+            // heroes keep every joint change at full precision, far away avatars get the compact joint encoding
+            if (sourceAvatar->getHasPriority()) {
+                sendStatus.jointQuantization = AvatarDataPacket::HeroJoints;
+            } else if (glm::distance(destinationPosition, sourceAvatar->getClientGlobalPosition()) > FAR_JOINTS_DISTANCE) {
+                sendStatus.jointQuantization = AvatarDataPacket::FarJoints;
+                if (detail >= AvatarData::CullSmallData) {
+                    ++_stats.numCompactJointsIncluded;
+                }
+            }
+            const bool distanceAdjust = sendStatus.jointQuantization != AvatarDataPacket::HeroJoints;
+
+            // encodings that don't depend on the receiver are made once per frame, as long as they fit in a packet
+            bool sentSharedEncoding = false;
+            if (MixerAvatar::isSharedEncoding(detail)) {
+                auto startSerialize = chrono::high_resolution_clock::now();
+                bool wasCached = false;
+                QByteArray bytes = sourceAvatar->getSharedEncoding(detail, sendStatus.jointQuantization,
+                    _sharedData->broadcastFrame, wasCached, lastSentJointsForOther);
+                auto endSerialize = chrono::high_resolution_clock::now();
+                _stats.toByteArrayElapsedTime +=
+                    (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+                if (wasCached) {
+                    ++_stats.numSharedEncodings;
+                }
+
+                if (bytes.size() <= avatarPacketCapacity) {
+                    if (bytes.size() > avatarSpaceAvailable) {
+                        nodeList.sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+
+                    avatarPacket->write(bytes);
+                    traceAvatarPacket(sourceNodeData);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        nodeList.sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                    sentSharedEncoding = true;
+                }
+                // otherwise it's split below, which leaves the sent joints as they already are for SendAllData
+            }
+
+            while (!sentSharedEncoding) {
                 auto startSerialize = chrono::high_resolution_clock::now();
                 QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
                     sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
@@ -590,16 +741,21 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                     (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
 
                 avatarPacket->write(bytes);
+                traceAvatarPacket(sourceNodeData);
                 avatarSpaceAvailable -= bytes.size();
                 numAvatarDataBytes += bytes.size();
                 if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
                     // Weren't able to fit everything.
-                    nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                    nodeList.sendPacket(std::move(avatarPacket), *destinationNode);
                     ++numPacketsSent;
                     avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
                     avatarSpaceAvailable = avatarPacketCapacity;
                 }
-            } while (!sendStatus);
+
+                if (sendStatus) {
+                    break;
+                }
+            }
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
@@ -621,8 +777,15 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 (quint64)chrono::duration_cast<chrono::microseconds>(endAvatarDataPacking - startAvatarDataPacking).count();
 
             if (!overBudget) {
+                // the avatar entities of the avatars out of view wait until they come into view, the others are sent
+                // while this frame has room for them
+                avatarEntityBudget.beginAvatar(!isLowerPriority, sourceNode->getLocalID());
+
                 // use helper to add any changed traits to our packet list
-                traitBytesSent += addChangedTraitsToBulkPacket(destinationNodeData, sourceNodeData, *traitsPacketList);
+                qint64 traitBytes = addChangedTraitsToBulkPacket(destinationNodeData, sourceNodeData, *traitsPacketList,
+                                                                 avatarEntityBudget);
+                traitBytesSent += traitBytes;
+                avatarEntityBudget.endAvatar(traitBytes);
             }
             numAvatarsSent++;
             remainingAvatars--;
@@ -635,6 +798,8 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         }
     }
 
+    destinationNodeData->setAvatarEntityOverBudgetSender(avatarEntityBudget.getNextOverBudgetSender());
+
     if (destinationNodeData->getNumAvatarsSentLastFrame() > numToSendEst) {
         qCWarning(avatars) << "More avatars sent than upper estimate" << destinationNodeData->getNumAvatarsSentLastFrame()
             << " / " << numToSendEst;
@@ -643,10 +808,14 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     quint64 startPacketSending = usecTimestampNow();
 
     if (avatarPacket->getPayloadSize() != 0) {
-        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+        nodeList.sendPacket(std::move(avatarPacket), *destinationNode);
         ++numPacketsSent;
     }
 
+    static SharedCounter dataPacketsSent("avatar.dataPacketsSent");
+    static SharedCounter dataBytesSent("avatar.dataBytesSent");
+    dataPacketsSent.increment(numPacketsSent);
+    dataBytesSent.increment(numAvatarDataBytes);
     _stats.numDataPacketsSent += numPacketsSent;
     _stats.numDataBytesSent += numAvatarDataBytes;
 
@@ -657,13 +826,13 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         // send the traits packet list
         _stats.numTraitsBytesSent += traitBytesSent;
         _stats.numTraitsPacketsSent += (int) traitsPacketList->getNumPackets();
-        nodeList->sendPacketList(std::move(traitsPacketList), *destinationNode);
+        nodeList.sendPacketList(std::move(traitsPacketList), *destinationNode);
     }
 
     // Send any AvatarIdentity packets:
     identityPacketList->closeCurrentPacket();
     if (identityBytesSent > 0) {
-        nodeList->sendPacketList(std::move(identityPacketList), *destinationNode);
+        nodeList.sendPacketList(std::move(identityPacketList), *destinationNode);
     }
 
     // record the bytes sent for other avatar data in the AvatarMixerClientData
@@ -702,7 +871,8 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
         }
         
         // collect agents that we have avatar data for that we are supposed to replicate
-        if (agentNode->getType() == NodeType::Agent && agentNode->getLinkedData() && agentNode->isReplicated()) {
+        // and the ones near the edge of our shard
+        if (agentNode->getType() == NodeType::Agent && agentNode->getLinkedData() && AvatarMixer::shouldReplicate(*agentNode)) {
             const AvatarMixerClientData* agentNodeData = reinterpret_cast<const AvatarMixerClientData*>(agentNode->getLinkedData());
 
             AvatarSharedPointer otherAvatar = agentNodeData->getAvatarSharedPointer();
@@ -800,8 +970,7 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
         _stats.numDataBytesSent += numAvatarDataBytes;
 
         // send the replicated bulk avatar data
-        auto nodeList = DependencyManager::get<NodeList>();
-        nodeList->sendPacketList(std::move(avatarPacketList), node->getPublicSocket());
+        DependencyManager::getRef<NodeList>().sendPacketList(std::move(avatarPacketList), node->getPublicSocket());
 
         // record the bytes sent for other avatar data in the AvatarMixerClientData
         nodeData->recordSentAvatarData(numAvatarDataBytes);
@@ -12,8 +12,11 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <AvatarEntityBudget.h>
 #include <NodeList.h>
 
+#include "AvatarSpatialGrid.h"
+
 class AvatarMixerClientData;
 
 class AvatarMixerSlaveStats {
@@ -33,6 +36,12 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numOthersConsidered { 0 };
+    int numSharedEncodings { 0 };
+    int numCompactJointsIncluded { 0 };
+    int numTraitJournalChecks { 0 };
+    int numTraitFullChecks { 0 };
+    int numTraitsDeferred { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +68,12 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numOthersConsidered = 0;
+        numSharedEncodings = 0;
+        numCompactJointsIncluded = 0;
+        numTraitJournalChecks = 0;
+        numTraitFullChecks = 0;
+        numTraitsDeferred = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +98,12 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numOthersConsidered += rhs.numOthersConsidered;
+        numSharedEncodings += rhs.numSharedEncodings;
+        numCompactJointsIncluded += rhs.numCompactJointsIncluded;
+        numTraitJournalChecks += rhs.numTraitJournalChecks;
+        numTraitFullChecks += rhs.numTraitFullChecks;
+        numTraitsDeferred += rhs.numTraitsDeferred;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -100,6 +121,8 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+    AvatarSpatialGrid avatarGrid;
+    uint64_t broadcastFrame { 0 };  // keys the avatars' shared encodings
 };
 
 class AvatarMixerSlave {
@@ -127,9 +150,12 @@ private:
                                NLPacketList& traitsPacketList,
                                qint64 bytesWritten);
 
+    // the avatar entities, which can be large, are only added while the budget has room for them, the others wait for a
+    // later frame
     qint64 addChangedTraitsToBulkPacket(AvatarMixerClientData* listeningNodeData,
                                         const AvatarMixerClientData* sendingNodeData,
-                                        NLPacketList& traitsPacketList);
+                                        NLPacketList& traitsPacketList,
+                                        AvatarEntityBudget& avatarEntityBudget);
 
     void broadcastAvatarDataToAgent(const SharedNodePointer& node);
     void broadcastAvatarDataToDownstreamMixer(const SharedNodePointer& node);
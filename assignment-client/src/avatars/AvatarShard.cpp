@@ -0,0 +1,49 @@
+//
+//  AvatarShard.cpp
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2021-03-14.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarShard.h"
+
+#include <algorithm>
+
+#include "AvatarLogging.h"
+
+const float AvatarShard::DEFAULT_BOUNDARY_MARGIN = 32.0f;
+
+void AvatarShard::configure(const QJsonObject& avatarMixerSettings) {
+    static const QString SHARD_MIN_X_KEY = "shard_min_x";
+    static const QString SHARD_MIN_Z_KEY = "shard_min_z";
+    static const QString SHARD_MAX_X_KEY = "shard_max_x";
+    static const QString SHARD_MAX_Z_KEY = "shard_max_z";
+    static const QString SHARD_BOUNDARY_MARGIN_KEY = "shard_boundary_margin";
+
+    _min = glm::vec2(avatarMixerSettings[SHARD_MIN_X_KEY].toDouble(), avatarMixerSettings[SHARD_MIN_Z_KEY].toDouble());
+    _max = glm::vec2(avatarMixerSettings[SHARD_MAX_X_KEY].toDouble(), avatarMixerSettings[SHARD_MAX_Z_KEY].toDouble());
+    _boundaryMargin = std::max(0.0f,
+        (float)avatarMixerSettings[SHARD_BOUNDARY_MARGIN_KEY].toDouble(DEFAULT_BOUNDARY_MARGIN));
+    _isEnabled = _max.x > _min.x && _max.y > _min.y;
+
+    if (_isEnabled) {
+        qCDebug(avatars) << "Avatar mixer owns the shard from" << _min.x << _min.y << "to" << _max.x << _max.y
+            << "and replicates the avatars within" << _boundaryMargin << "m of its edge";
+    }
+}
+
+bool AvatarShard::isInBoundary(const glm::vec3& position) const {
+    if (!_isEnabled) {
+        return false;
+    }
+
+    // anything that isn't in the interior, including the avatars that walked out of the shard
+    glm::vec2 interiorMin = _min + _boundaryMargin;
+    glm::vec2 interiorMax = _max - _boundaryMargin;
+    return !(position.x >= interiorMin.x && position.x < interiorMax.x &&
+        position.z >= interiorMin.y && position.z < interiorMax.y);
+}
@@ -0,0 +1,45 @@
+//
+//  AvatarShard.h
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2021-03-14.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarShard_h
+#define hifi_AvatarShard_h
+
+#include <QtCore/QJsonObject>
+
+#include <glm/glm.hpp>
+
+// Horizontal region of the world owned by this avatar mixer, when one event is split between several domains.
+//
+// The mixers of the shards are linked with the usual broadcasting upstream and downstream servers. Instead of only the
+// replicated users, a sharded mixer also replicates every local avatar that is within the boundary margin of its shard's
+// edge, or that has left the shard, so the neighbouring mixers show it to their own agents. Avatars deep inside the shard
+// are not exchanged at all.
+class AvatarShard {
+public:
+    static const float DEFAULT_BOUNDARY_MARGIN;  // meters
+
+    // reads shard_min_x, shard_min_z, shard_max_x, shard_max_z and shard_boundary_margin from the avatar_mixer settings,
+    // the shard stays disabled unless it has a positive area
+    void configure(const QJsonObject& avatarMixerSettings);
+
+    bool isEnabled() const { return _isEnabled; }
+
+    // true if an avatar at position has to be replicated to the neighbouring shards
+    bool isInBoundary(const glm::vec3& position) const;
+
+private:
+    glm::vec2 _min;
+    glm::vec2 _max;
+    float _boundaryMargin { DEFAULT_BOUNDARY_MARGIN };
+    bool _isEnabled { false };
+};
+
+#endif // hifi_AvatarShard_h
@@ -0,0 +1,79 @@
+//
+//  AvatarSpatialGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2021-03-12.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarSpatialGrid.h"
+
+#include <cmath>
+
+#include "AvatarMixerClientData.h"
+
+const float AvatarSpatialGrid::CELL_SIZE = 16.0f;
+
+size_t AvatarSpatialGrid::CellHasher::operator()(const Cell& cell) const {
+    size_t hash = std::hash<int>()(cell.x);
+    hash = hash * 31 + std::hash<int>()(cell.y);
+    hash = hash * 31 + std::hash<int>()(cell.z);
+    return hash;
+}
+
+AvatarSpatialGrid::Cell AvatarSpatialGrid::cellFor(const glm::vec3& position) {
+    return {
+        (int)std::floor(position.x / CELL_SIZE),
+        (int)std::floor(position.y / CELL_SIZE),
+        (int)std::floor(position.z / CELL_SIZE)
+    };
+}
+
+bool AvatarSpatialGrid::isNear(const Cell& a, const Cell& b) {
+    return std::abs(a.x - b.x) <= NEAR_CELLS && std::abs(a.y - b.y) <= NEAR_VERTICAL_CELLS &&
+        std::abs(a.z - b.z) <= NEAR_CELLS;
+}
+
+void AvatarSpatialGrid::rebuild(ConstIter begin, ConstIter end) {
+    _entries.clear();
+    _heroes.clear();
+    for (auto& cell : _cells) {
+        cell.second.clear();
+    }
+    ++_frame;
+
+    for (auto it = begin; it != end; ++it) {
+        Node* node = it->data();
+        if (node->getType() != NodeType::Agent || !node->getLinkedData()) {
+            continue;
+        }
+
+        auto nodeData = reinterpret_cast<const AvatarMixerClientData*>(node->getLinkedData());
+        const MixerAvatar* avatar = nodeData->getConstAvatarData();
+
+        int index = (int)_entries.size();
+        Cell cell = cellFor(avatar->getClientGlobalPosition());
+        bool isHero = avatar->getHasPriority();
+        _entries.push_back({ node, cell, isHero });
+
+        if (isHero) {
+            _heroes.push_back(index);
+        } else {
+            _cells[cell].push_back(index);
+        }
+    }
+
+    // drop the cells that were left empty so the map doesn't keep growing as avatars move around
+    for (auto cell = _cells.begin(); cell != _cells.end();) {
+        if (cell->second.empty()) {
+            cell = _cells.erase(cell);
+        } else {
+            ++cell;
+        }
+    }
+
+    _isActive = (int)_entries.size() >= MIN_AVATARS;
+}
@@ -0,0 +1,118 @@
+//
+//  AvatarSpatialGrid.h
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2021-03-12.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarSpatialGrid_h
+#define hifi_AvatarSpatialGrid_h
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+
+// Uniform grid of the agents' avatar positions, rebuilt once per broadcast frame.
+//
+// Instead of considering everybody, a listener considers the avatars in the cells around it, every hero avatar, and a
+// strided sample of the rest. The stride start moves every frame, so each far avatar is still considered once every
+// few frames and the priority sort's age term lets it through eventually.
+//
+// With fewer than MIN_AVATARS agents the grid stays inactive and the slaves go back to checking every node.
+//
+//   AvatarSpatialGrid is not thread-safe while it is rebuilt. Queries from the slaves are read only.
+class AvatarSpatialGrid {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    static const float CELL_SIZE;            // meters
+    static const int NEAR_CELLS = 2;         // horizontal half-extent of the cell box around a listener
+    static const int NEAR_VERTICAL_CELLS = 1;
+    static const int MIN_AVATARS = 128;
+    static const int FAR_SAMPLES = 64;       // far avatars considered per listener per frame
+
+    // the nodes must outlive the frame, i.e. this is called within the same nestedEach as the broadcast
+    void rebuild(ConstIter begin, ConstIter end);
+
+    bool isActive() const { return _isActive; }
+
+    // calls visitor(Node*) once for every candidate for a listener at position
+    template <typename Visitor>
+    void eachCandidate(const glm::vec3& position, uint32_t seed, Visitor visitor) const;
+
+private:
+    struct Cell {
+        int x;
+        int y;
+        int z;
+
+        bool operator==(const Cell& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+
+    struct CellHasher {
+        size_t operator()(const Cell& cell) const;
+    };
+
+    struct Entry {
+        Node* node;
+        Cell cell;
+        bool isHero;
+    };
+
+    static Cell cellFor(const glm::vec3& position);
+    static bool isNear(const Cell& a, const Cell& b);
+
+    std::vector<Entry> _entries;
+    std::vector<int> _heroes;
+    std::unordered_map<Cell, std::vector<int>, CellHasher> _cells;
+
+    uint32_t _frame { 0 };
+    bool _isActive { false };
+};
+
+template <typename Visitor>
+void AvatarSpatialGrid::eachCandidate(const glm::vec3& position, uint32_t seed, Visitor visitor) const {
+    Cell center = cellFor(position);
+
+    // everything around the listener, heroes are kept out of the cells
+    for (int x = center.x - NEAR_CELLS; x <= center.x + NEAR_CELLS; ++x) {
+        for (int y = center.y - NEAR_VERTICAL_CELLS; y <= center.y + NEAR_VERTICAL_CELLS; ++y) {
+            for (int z = center.z - NEAR_CELLS; z <= center.z + NEAR_CELLS; ++z) {
+                auto cell = _cells.find({ x, y, z });
+                if (cell == _cells.end()) {
+                    continue;
+                }
+
+                for (int index : cell->second) {
+                    visitor(_entries[index].node);
+                }
+            }
+        }
+    }
+
+    // heroes are always candidates
+    for (int index : _heroes) {
+        visitor(_entries[index].node);
+    }
+
+    // and a sample of everybody further away
+    int numEntries = (int)_entries.size();
+    int stride = std::max(1, (numEntries + FAR_SAMPLES - 1) / FAR_SAMPLES);
+    for (int index = (int)((seed + _frame) % stride); index < numEntries; index += stride) {
+        const Entry& entry = _entries[index];
+        if (!entry.isHero && !isNear(entry.cell, center)) {
+            visitor(entry.node);
+        }
+    }
+}
+
+#endif // hifi_AvatarSpatialGrid_h
@@ -38,6 +38,55 @@ MixerAvatar::MixerAvatar() {
     connect(this, &MixerAvatar::startChallengeTimer, &_challengeTimer, static_cast<void(QTimer::*)()>(&QTimer::start));
 }
 
+QByteArray MixerAvatar::getSharedEncoding(AvatarDataDetail detail, AvatarDataPacket::JointQuantization jointQuantization,
+                                          uint64_t frame, bool& wasCached, QVector<JointData>& sentJointDataOut) const {
+    assert(isSharedEncoding(detail));
+    // heroes and near avatars share the full precision joints, only far ones differ
+    bool compactJoints = (detail == SendAllData && jointQuantization == AvatarDataPacket::FarJoints);
+    SharedEncoding& encoding = _sharedEncodings[detail == SendAllData ? (compactJoints ? 1 : 0) : 2];
+
+    std::unique_lock<std::mutex> lock(_sharedEncodingsMutex);
+    wasCached = encoding.frame == frame;
+    if (!wasCached) {
+        // encode without the lock, another slave getting here first only costs a second encode
+        lock.unlock();
+
+        SharedEncoding newEncoding;
+        newEncoding.frame = frame;
+
+        AvatarDataPacket::SendStatus sendStatus;
+        sendStatus.sendUUID = true;
+        sendStatus.jointQuantization = compactJoints ? AvatarDataPacket::FarJoints : AvatarDataPacket::NearJoints;
+        // the sent joints start out empty, which is also what SendAllData compares against
+        newEncoding.bytes = toByteArray(detail, 0, newEncoding.sentJoints, sendStatus, false, false, glm::vec3(0.0f),
+            &newEncoding.sentJoints, 0);
+
+        lock.lock();
+        encoding = std::move(newEncoding);
+    }
+
+    QByteArray bytes = encoding.bytes;
+    if (detail == SendAllData) {
+        // as toByteArray would have done, the joints in their default pose keep their last sent value
+        const QVector<JointData>& sentJoints = encoding.sentJoints;
+        int numJoints = sentJoints.size();
+        sentJointDataOut.resize(numJoints);
+        for (int i = 0; i < numJoints; ++i) {
+            const JointData& sent = sentJoints[i];
+            JointData& out = sentJointDataOut[i];
+            if (!sent.rotationIsDefaultPose) {
+                out.rotation = sent.rotation;
+            }
+            if (!sent.translationIsDefaultPose) {
+                out.translation = sent.translation;
+            }
+            out.rotationIsDefaultPose = sent.rotationIsDefaultPose;
+            out.translationIsDefaultPose = sent.translationIsDefaultPose;
+        }
+    }
+    return bytes;
+}
+
 const char* MixerAvatar::stateToName(VerifyState state) {
     return QMetaEnum::fromType<VerifyState>().valueToKey(state);
 }
@@ -14,6 +14,8 @@
 #ifndef hifi_MixerAvatar_h
 #define hifi_MixerAvatar_h
 
+#include <mutex>
+
 #include <AvatarData.h>
 
 class ResourceRequest;
@@ -48,7 +50,25 @@ public:
     const QUuid& getScreenshareZone() const { return _screenshareZone; }
     void setScreenshareZone(QUuid zone) { _screenshareZone = zone; }
 
+    // SendAllData and PALMinimum encodings don't depend on the receiver, so the slaves share one per broadcast frame.
+    static bool isSharedEncoding(AvatarDataDetail detail) { return detail == SendAllData || detail == PALMinimum; }
+
+    // Returns the complete encoding (session UUID included) of this avatar at detail for the given frame, encoding it
+    // on the first call of the frame. For SendAllData the caller's joint state is brought up to what was sent.
+    // Thread-safe, the avatar must not change while the frame is broadcast.
+    QByteArray getSharedEncoding(AvatarDataDetail detail, AvatarDataPacket::JointQuantization jointQuantization,
+                                 uint64_t frame, bool& wasCached, QVector<JointData>& sentJointDataOut) const;
+
 private:
+    struct SharedEncoding {
+        uint64_t frame { 0 };
+        QByteArray bytes;
+        QVector<JointData> sentJoints;
+    };
+
+    mutable SharedEncoding _sharedEncodings[3];  // SendAllData, SendAllData with compact joints, PALMinimum
+    mutable std::mutex _sharedEncodingsMutex;
+
     bool _needsHeroCheck { false };
     static const char* stateToName(VerifyState state);
     VerifyState _verifyState { nonCertified };
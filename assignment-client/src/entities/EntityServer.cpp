@@ -17,6 +17,21 @@
 #include <QJsonDocument>
 
 #include <EntityTree.h>
+#include <GizmoEntityItem.h>
+#include <GridEntityItem.h>
+#include <ImageEntityItem.h>
+#include <LightEntityItem.h>
+#include <LineEntityItem.h>
+#include <MaterialEntityItem.h>
+#include <ModelEntityItem.h>
+#include <ParticleEffectEntityItem.h>
+#include <PolyLineEntityItem.h>
+#include <PolyVoxEntityItem.h>
+#include <ShapeEntityItem.h>
+#include <StringPool.h>
+#include <TextEntityItem.h>
+#include <WebEntityItem.h>
+#include <ZoneEntityItem.h>
 #include <ResourceCache.h>
 #include <ScriptCache.h>
 #include <plugins/PluginManager.h>
@@ -56,6 +71,7 @@ EntityServer::EntityServer(ReceivedMessage& message) :
         PacketType::EntityEdit,
         PacketType::EntityErase,
         PacketType::EntityPhysics,
+        PacketType::BulkEntityPhysics,
         PacketType::ChallengeOwnership,
         PacketType::ChallengeOwnershipRequest,
         PacketType::ChallengeOwnershipReply },
@@ -336,6 +352,11 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
 
     startDynamicDomainVerification();
 
+    // the octree, or "grid" for a loose hashed grid, answers the sphere, cube, box and closest entity queries
+    QString spatialIndex;
+    readOptionString("spatialIndex", settingsSectionObject, spatialIndex);
+    tree->setSpatialIndex(spatialIndex == "grid" ? EntityTree::SpatialIndex::Grid : EntityTree::SpatialIndex::Octree);
+
     tree->setWantEditLogging(wantEditLogging);
     tree->setWantTerseEditLogging(wantTerseEditLogging);
 
@@ -406,6 +427,43 @@ void EntityServer::trackViewerGone(const QUuid& sessionID) {
     }
 }
 
+static size_t getEntityItemSize(EntityTypes::EntityType type) {
+    switch (type) {
+        case EntityTypes::Box:
+        case EntityTypes::Sphere:
+        case EntityTypes::Shape:
+            return sizeof(ShapeEntityItem);
+        case EntityTypes::Model:
+            return sizeof(ModelEntityItem);
+        case EntityTypes::Text:
+            return sizeof(TextEntityItem);
+        case EntityTypes::Image:
+            return sizeof(ImageEntityItem);
+        case EntityTypes::Web:
+            return sizeof(WebEntityItem);
+        case EntityTypes::ParticleEffect:
+            return sizeof(ParticleEffectEntityItem);
+        case EntityTypes::Line:
+            return sizeof(LineEntityItem);
+        case EntityTypes::PolyLine:
+            return sizeof(PolyLineEntityItem);
+        case EntityTypes::PolyVox:
+            return sizeof(PolyVoxEntityItem);
+        case EntityTypes::Grid:
+            return sizeof(GridEntityItem);
+        case EntityTypes::Gizmo:
+            return sizeof(GizmoEntityItem);
+        case EntityTypes::Light:
+            return sizeof(LightEntityItem);
+        case EntityTypes::Zone:
+            return sizeof(ZoneEntityItem);
+        case EntityTypes::Material:
+            return sizeof(MaterialEntityItem);
+        default:
+            return sizeof(EntityItem);
+    }
+}
+
 QString EntityServer::serverSubclassStats() {
     QLocale locale(QLocale::English);
     QString statsString;
@@ -414,6 +472,43 @@ QString EntityServer::serverSubclassStats() {
     statsString += "<b>Entity Server Memory Statistics</b>\r\n";
     statsString += QString().sprintf("EntityTreeElement size... %ld bytes\r\n", sizeof(EntityTreeElement));
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
+
+    // the footprint of the entity objects, without the heap allocations of their properties besides the pooled strings
+    if (auto tree = std::static_pointer_cast<EntityTree>(_tree)) {
+        int numEntities = 0;
+        size_t entitiesSize = 0;
+        for (int type = EntityTypes::Unknown + 1; type < EntityTypes::NUM_TYPES; type++) {
+            auto entityType = (EntityTypes::EntityType)type;
+            int numEntitiesOfType = tree->getNumEntitiesOfType(entityType);
+            if (numEntitiesOfType > 0) {
+                statsString += QString("%1 entities... %2 x %3 bytes\r\n")
+                    .arg(EntityTypes::getEntityTypeName(entityType), 14)
+                    .arg(locale.toString(numEntitiesOfType))
+                    .arg(getEntityItemSize(entityType));
+                numEntities += numEntitiesOfType;
+                entitiesSize += numEntitiesOfType * getEntityItemSize(entityType);
+            }
+        }
+        int numGrabPropertyGroups = EntityItem::getNumGrabPropertyGroups();
+        statsString += QString("  Grab properties... %1 x %2 bytes\r\n")
+            .arg(locale.toString(numGrabPropertyGroups)).arg(sizeof(GrabPropertyGroup));
+        entitiesSize += numGrabPropertyGroups * sizeof(GrabPropertyGroup);
+        size_t pooledStringsSize = StringPool::getMemorySize();
+        statsString += QString("   Pooled strings... %1, %2 bytes\r\n")
+            .arg(locale.toString(StringPool::getNumStrings())).arg(locale.toString((qulonglong)pooledStringsSize));
+        if (numEntities > 0) {
+            statsString += QString("Per entity footprint... %1 bytes\r\n")
+                .arg(locale.toString((qulonglong)((entitiesSize + pooledStringsSize) / numEntities)));
+        }
+    }
+    statsString += "\r\n\r\n";
+
+    // display how much of the traversing and encoding the send threads didn't have to redo
+    statsString += "<b>Entity Server Shared View Statistics</b>\r\n";
+    statsString += QString().sprintf("   Shared traversals... %llu used, %llu missed\r\n",
+        (unsigned long long)_viewCache.getScanHits(), (unsigned long long)_viewCache.getScanMisses());
+    statsString += QString().sprintf("    Reused encodings... %llu used, %llu missed\r\n",
+        (unsigned long long)EntityItem::getEncodedDataHits(), (unsigned long long)EntityItem::getEncodedDataMisses());
     statsString += "\r\n\r\n";
 
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
@@ -21,6 +21,7 @@
 #include <SimpleEntitySimulation.h>
 
 #include "EntityServerConsts.h"
+#include "EntityViewCache.h"
 
 /// Handles assignments of type EntityServer - sending entities to various clients.
 
@@ -59,6 +60,8 @@ public:
 
     virtual void aboutToFinish() override;
 
+    EntityViewCache& getViewCache() { return _viewCache; }
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -80,6 +83,8 @@ private:
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 
+    EntityViewCache _viewCache;
+
     static const int DEFAULT_MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = 45 * 60 * 1000;                    // 45m
     static const int DEFAULT_MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = 60 * 60 * 1000;                    // 1h
     int _MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 45m
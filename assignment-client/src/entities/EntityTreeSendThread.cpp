@@ -13,12 +13,14 @@
 
 #include <EntityNodeData.h>
 #include <EntityTypes.h>
+#include <Gzip.h>
 #include <OctreeUtils.h>
 
 #include "EntityServer.h"
 
 EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
-    OctreeSendThread(myServer, node)
+    OctreeSendThread(myServer, node),
+    _viewCache(static_cast<EntityServer*>(myServer)->getViewCache())
 {
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
@@ -33,6 +35,7 @@ void EntityTreeSendThread::resetState() {
 
     _knownState.clear();
     _traversal.reset();
+    _recordingScan.reset();
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -99,8 +102,29 @@ void EntityTreeSendThread::preDistributionProcessing() {
     }
 }
 
+void EntityTreeSendThread::updateCompressionDictionary(const SharedNodePointer& node, OctreeQueryNode* nodeData) {
+    QByteArray dictionary = nodeData->wantCompressionDictionary() ? _myServer->getCompressionDictionary() : QByteArray();
+    quint32 dictionaryID = zlibDictionaryID(dictionary);
+    if (dictionaryID != 0 && nodeData->getCompressionDictionaryID() == dictionaryID) {
+        _packetData.setCompressionDictionary(dictionary);
+        return;
+    }
+
+    // until the client says it has it, the sections are compressed without one
+    _packetData.setCompressionDictionary(QByteArray());
+    if (dictionaryID != 0 && nodeData->getSentCompressionDictionaryID() != dictionaryID) {
+        auto dictionaryPacketList = NLPacketList::create(PacketType::EntityCompressionDictionary, QByteArray(), true, true);
+        dictionaryPacketList->writePrimitive(dictionaryID);
+        dictionaryPacketList->write(dictionary);
+        DependencyManager::get<NodeList>()->sendPacketList(std::move(dictionaryPacketList), *node);
+        nodeData->setSentCompressionDictionaryID(dictionaryID);
+    }
+}
+
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
+    updateCompressionDictionary(node, nodeData);
+
     if (viewFrustumChanged || _traversal.finished()) {
         EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
@@ -153,6 +177,11 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
         #endif
         _traversal.traverse(TIME_BUDGET);
         OctreeServer::trackTreeTraverseTime((float)(usecTimestampNow() - startTime));
+
+        if (_recordingScan && _traversal.finished()) {
+            _viewCache.insertScan(_recordingScan);
+            _recordingScan.reset();
+        }
     }
 
     bool sendComplete = OctreeSendThread::traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
@@ -237,22 +266,43 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
     //
     // The "scanCallback" we provide to the traversal depends on the type:
 
+    _recordingScan.reset();
+
+    if (type == DiffTraversal::First) {
+        // When we get to a First traversal, clear the _knownState
+        _knownState.clear();
+    }
+
+    if (type != DiffTraversal::Repeat) {
+        // another send thread may have just walked the tree for a view very similar to ours
+        auto scan = _viewCache.findScan(_traversal.getCurrentView());
+        if (scan) {
+            _traversal.adoptCompletedTraversal(scan->view);
+            for (const auto& scanned : scan->entities) {
+                EntityItemPointer entity = scanned.entity.lock();
+                if (entity) {
+                    queueScannedEntity(entity, scanned.priority, type);
+                }
+            }
+            return;
+        }
+
+        _recordingScan = std::make_shared<EntityViewCache::Scan>();
+        _recordingScan->view = _traversal.getCurrentView();
+    }
+
     switch (type) {
         case DiffTraversal::First:
-            // When we get to a First traversal, clear the _knownState
-            _knownState.clear();
-            _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
+        case DiffTraversal::Differential:
+            assert(type == DiffTraversal::First || view.usesViewFrustums());
+            _traversal.setScanCallback([this, type](DiffTraversal::VisibleElement& next) {
                 next.element->forEachEntity([&](EntityItemPointer entity) {
-                    // Bail early if we've already checked this entity this frame
-                    if (_sendQueue.contains(entity.get())) {
-                        return;
-                    }
                     const auto& view = _traversal.getCurrentView();
                     float priority = view.computePriority(entity);
 
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority);
-                    }
+                    // keep the out of view entities too, a Differential still has to look at the known ones
+                    _recordingScan->entities.push_back({ entity, priority });
+                    queueScannedEntity(entity, priority, type);
                 });
             });
             break;
@@ -286,34 +336,31 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
                 }
             });
             break;
-        case DiffTraversal::Differential:
-            assert(view.usesViewFrustums());
-            _traversal.setScanCallback([this] (DiffTraversal::VisibleElement& next) {
-                next.element->forEachEntity([&](EntityItemPointer entity) {
-                    // Bail early if we've already checked this entity this frame
-                    if (_sendQueue.contains(entity.get())) {
-                        return;
-                    }
-                    float priority = PrioritizedEntity::DO_NOT_SEND;
+    }
+}
 
-                    auto knownTimestamp = _knownState.find(entity.get());
-                    if (knownTimestamp == _knownState.end()) {
-                        const auto& view = _traversal.getCurrentView();
-                        priority = view.computePriority(entity);
+void EntityTreeSendThread::queueScannedEntity(const EntityItemPointer& entity, float priority, DiffTraversal::Type type) {
+    // Bail early if we've already checked this entity this frame
+    if (_sendQueue.contains(entity.get())) {
+        return;
+    }
 
-                    } else if (entity->getLastEdited() > knownTimestamp->second ||
-                               entity->getLastChangedOnServer() > knownTimestamp->second) {
-                        // it is known and it changed --> put it on the queue with any priority
-                        // TODO: sort these correctly
-                        priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
-                    }
+    if (type == DiffTraversal::Differential) {
+        auto knownTimestamp = _knownState.find(entity.get());
+        if (knownTimestamp != _knownState.end()) {
+            if (entity->getLastEdited() > knownTimestamp->second ||
+                entity->getLastChangedOnServer() > knownTimestamp->second) {
+                // it is known and it changed --> put it on the queue with any priority
+                // TODO: sort these correctly
+                priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
+            } else {
+                priority = PrioritizedEntity::DO_NOT_SEND;
+            }
+        }
+    }
 
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority);
-                    }
-                });
-            });
-            break;
+    if (priority != PrioritizedEntity::DO_NOT_SEND) {
+        _sendQueue.emplace(entity, priority);
     }
 }
 
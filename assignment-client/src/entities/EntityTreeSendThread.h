@@ -20,6 +20,7 @@
 #include <EntityPriorityQueue.h>
 #include <shared/ConicalViewFrustum.h>
 
+#include "EntityViewCache.h"
 
 class EntityNodeData;
 class EntityItem;
@@ -42,7 +43,12 @@ private:
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
+    // compresses with the dictionary of the server once the client has it, and sends it to the client otherwise
+    void updateCompressionDictionary(const SharedNodePointer& node, OctreeQueryNode* nodeData);
+
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root, bool forceFirstPass = false);
+    // queues an entity found by a First or Differential traversal, priority is for the traversal's view
+    void queueScannedEntity(const EntityItemPointer& entity, float priority, DiffTraversal::Type type);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
     void preDistributionProcessing() override;
@@ -53,6 +59,9 @@ private:
     EntityPriorityQueue _sendQueue;
     std::unordered_map<EntityItem*, uint64_t> _knownState;
 
+    EntityViewCache& _viewCache;
+    std::shared_ptr<EntityViewCache::Scan> _recordingScan; // what the current traversal found, for the other threads
+
     // packet construction stuff
     EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
     int32_t _numEntitiesOffset { 0 };
@@ -0,0 +1,56 @@
+//
+//  EntityViewCache.cpp
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors on 2021-03-15.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityViewCache.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+// a thread taking a scan has to Repeat everything that changed since it started, so this is kept short
+const uint64_t EntityViewCache::MAX_SCAN_AGE = USECS_PER_SECOND;
+const int EntityViewCache::MAX_SCANS;
+
+EntityViewCache::ScanPointer EntityViewCache::findScan(const DiffTraversal::View& view) {
+    uint64_t now = usecTimestampNow();
+
+    std::lock_guard<std::mutex> lock(_scansMutex);
+    for (const auto& scan : _scans) {
+        if (now - scan->view.startTime < MAX_SCAN_AGE && scan->view.isVerySimilar(view)) {
+            ++_scanHits;
+            return scan;
+        }
+    }
+
+    ++_scanMisses;
+    return ScanPointer();
+}
+
+void EntityViewCache::insertScan(ScanPointer scan) {
+    uint64_t now = usecTimestampNow();
+
+    std::lock_guard<std::mutex> lock(_scansMutex);
+
+    // the new scan replaces the ones it could stand in for, and the ones nobody can use anymore
+    _scans.erase(std::remove_if(_scans.begin(), _scans.end(), [&](const ScanPointer& other) {
+        return now - other->view.startTime >= MAX_SCAN_AGE || other->view.isVerySimilar(scan->view);
+    }), _scans.end());
+
+    if ((int)_scans.size() >= MAX_SCANS) {
+        auto oldest = std::min_element(_scans.begin(), _scans.end(), [](const ScanPointer& a, const ScanPointer& b) {
+            return a->view.startTime < b->view.startTime;
+        });
+        _scans.erase(oldest);
+    }
+
+    _scans.push_back(scan);
+}
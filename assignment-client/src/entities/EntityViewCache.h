@@ -0,0 +1,61 @@
+//
+//  EntityViewCache.h
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors on 2021-03-15.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityViewCache_h
+#define hifi_EntityViewCache_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <DiffTraversal.h>
+#include <EntityItem.h>
+
+// Traversal work that the EntityTreeSendThreads can share with each other.
+//
+// A Scan is what a First or Differential traversal found in view: every entity in the traversed elements with its
+// priority. A send thread starting such a traversal with a view very similar to a recent scan takes the scan's results
+// instead of walking the tree, then carries on with Repeat traversals from the scan's start time like it had done the
+// walk itself. What gets queued from a scan is still decided by the thread's own known state.
+//
+//   EntityViewCache is thread-safe. The send threads only use it under the tree read lock.
+class EntityViewCache {
+public:
+    struct ScannedEntity {
+        EntityItemWeakPointer entity;
+        float priority;
+    };
+
+    struct Scan {
+        DiffTraversal::View view;
+        std::vector<ScannedEntity> entities;
+    };
+    using ScanPointer = std::shared_ptr<const Scan>;
+
+    static const uint64_t MAX_SCAN_AGE; // usecs
+    static const int MAX_SCANS = 32;
+
+    ScanPointer findScan(const DiffTraversal::View& view);
+    void insertScan(ScanPointer scan);
+
+    uint64_t getScanHits() const { return _scanHits; }
+    uint64_t getScanMisses() const { return _scanMisses; }
+
+private:
+    std::mutex _scansMutex;
+    std::vector<ScanPointer> _scans;
+
+    std::atomic<uint64_t> _scanHits { 0 };
+    std::atomic<uint64_t> _scanMisses { 0 };
+};
+
+#endif // hifi_EntityViewCache_h
@@ -13,6 +13,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
+#include <QtCore/QRunnable>
 #include <QBuffer>
 #include <LogHandler.h>
 #include <MessagesClient.h>
@@ -22,8 +23,31 @@
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 const int MESSAGES_MIXER_RATE_LIMITER_INTERVAL = 1000; // 1 second
 
+// Sends one already encoded message to each of the subscribers it was resolved for
+class MessagesFanOutTask : public QRunnable {
+public:
+    MessagesFanOutTask(QByteArray payload, std::vector<SharedNodePointer> subscribers) :
+        _payload(payload), _subscribers(std::move(subscribers)) {}
+
+    void run() override {
+        auto& nodeList = DependencyManager::getRef<NodeList>();
+        for (const auto& node : _subscribers) {
+            // each reliable packet list carries its own sequence numbers, only the packetization is per subscriber
+            nodeList.sendPacketList(MessagesClient::createMessagesPacketList(_payload), *node);
+        }
+    }
+
+private:
+    QByteArray _payload;
+    std::vector<SharedNodePointer> _subscribers;
+};
+
 MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
 {
+    for (auto& pool : _fanOutPools) {
+        pool.setMaxThreadCount(1);
+    }
+
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &MessagesMixer::nodeKilled);
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::MessagesData,
@@ -48,7 +72,7 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
     auto senderUUID = senderNode->getUUID();
     MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
 
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto& nodeList = DependencyManager::getRef<NodeList>();
 
     auto itr = _allSubscribers.find(senderUUID);
     if (itr == _allSubscribers.end()) {
@@ -59,15 +83,30 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
         *itr += 1;
     }
 
-    nodeList->eachMatchingNode(
+    auto channelSubscribers = _channelSubscribers.constFind(channel);
+    if (channelSubscribers == _channelSubscribers.cend() || channelSubscribers->isEmpty()) {
+        return;
+    }
+
+    std::vector<SharedNodePointer> subscribers;
+    subscribers.reserve(channelSubscribers->size());
+    nodeList.eachMatchingNode(
         [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
+        return node->getActiveSocket() && channelSubscribers->contains(node->getUUID());
     },
         [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
+        subscribers.push_back(node);
     });
+
+    if (subscribers.empty()) {
+        return;
+    }
+
+    // encode once, every subscriber gets the same payload
+    auto payload = MessagesClient::encodeMessagesPayload(channel, isText, isText ? message.toUtf8() : data, senderID);
+
+    auto& pool = _fanOutPools[qHash(channel) % FAN_OUT_POOL_COUNT];
+    pool.start(new MessagesFanOutTask(payload, std::move(subscribers)));
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -102,6 +141,16 @@ void MessagesMixer::sendStatsPacket() {
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
+void MessagesMixer::aboutToFinish() {
+    // drop fan-outs that haven't started and let the running ones finish before the NodeList goes away
+    for (auto& pool : _fanOutPools) {
+        pool.clear();
+    }
+    for (auto& pool : _fanOutPools) {
+        pool.waitForDone();
+    }
+}
+
 void MessagesMixer::run() {
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
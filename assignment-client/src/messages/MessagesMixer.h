@@ -15,6 +15,8 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <QtCore/QThreadPool>
+
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -23,6 +25,8 @@ class MessagesMixer : public ThreadedAssignment {
 public:
     MessagesMixer(ReceivedMessage& message);
 
+    void aboutToFinish() override;
+
 public slots:
     void run() override;
     void nodeKilled(SharedNodePointer killedNode);
@@ -47,6 +51,10 @@ private:
     int _maxMessagesPerSecond { 0 };
 
     QTimer* _maxMessagesTimer { nullptr };
+
+    // fan-out runs off the mixer thread, every channel maps to one single-threaded pool so its messages stay in order
+    static const int FAN_OUT_POOL_COUNT = 4;
+    QThreadPool _fanOutPools[FAN_OUT_POOL_COUNT];
 };
 
 #endif // hifi_MessagesMixer_h
@@ -23,6 +23,8 @@
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
 
+const int OctreeInboundPacketProcessor::MAX_EDIT_PACKETS_PER_BATCH;
+
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
     _receivedPacketCount(0),
@@ -31,6 +33,8 @@ OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServe
     _totalLockWaitTime(0),
     _totalElementsInPacket(0),
     _totalPackets(0),
+    _totalEditBatches(0),
+    _totalPacketsInEditBatches(0),
     _lastNackTime(usecTimestampNow()),
     _shuttingDown(false)
 {
@@ -44,6 +48,14 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalPackets = 0;
     _lastNackTime = usecTimestampNow();
 
+    _totalEditBatches = 0;
+    _totalPacketsInEditBatches = 0;
+    {
+        QMutexLocker locker(&_editBatchStatsMutex);
+        _editBatchLockWaitTimes.reset();
+        _editBatchApplyTimes.reset();
+    }
+
     QWriteLocker locker(&_senderStatsLock);
     _singleSenderStats.clear();
 }
@@ -68,6 +80,11 @@ void OctreeInboundPacketProcessor::preProcess() {
 }
 
 void OctreeInboundPacketProcessor::midProcess() {
+    // don't let a long queue hold the tree lock for too long in one go
+    if ((int)_pendingEditPackets.size() >= MAX_EDIT_PACKETS_PER_BATCH) {
+        processEditBatch();
+    }
+
     // check if it's time to send a nack. If yes, do so
     quint64 now = usecTimestampNow();
     if (now - _lastNackTime >= TOO_LONG_SINCE_LAST_NACK) {
@@ -76,6 +93,10 @@ void OctreeInboundPacketProcessor::midProcess() {
     }
 }
 
+void OctreeInboundPacketProcessor::postProcess() {
+    processEditBatch();
+}
+
 void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (_shuttingDown) {
         qDebug() << "OctreeInboundPacketProcessor::processPacket() while shutting down... ignoring incoming packet";
@@ -92,7 +113,12 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
     // Ask our tree subclass if it can handle the incoming packet...
     PacketType packetType = message->getType();
-    
+
+    if (!_myServer->getOctree()->handlesEditPacketType(packetType)) {
+        // keep the edits that came before this packet ahead of it
+        processEditBatch();
+    }
+
     if (packetType == PacketType::ChallengeOwnership) {
         _myServer->getOctree()->withWriteLock([&] {
             _myServer->getOctree()->processChallengeOwnershipPacket(*message, sendingNode);
@@ -125,7 +151,6 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
         }
 
         quint64 transitTime = arrivedAt - sentAt;
-        int editsInPacket = 0;
         quint64 processTime = 0;
         quint64 lockWaitTime = 0;
 
@@ -153,59 +178,12 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             }
         }
         
-        const unsigned char* editData = nullptr;
-        
-        while (message->getBytesLeftToRead() > 0) {
-
-            editData = reinterpret_cast<const unsigned char*>(message->getRawMessage() + message->getPosition());
-
-            int maxSize = message->getBytesLeftToRead();
-
-            if (debugProcessPacket) {
-                qDebug() << " --- inside while loop ---";
-                qDebug() << "    maxSize=" << maxSize;
-                qDebug("OctreeInboundPacketProcessor::processPacket() %hhu "
-                       "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld maxSize=%d",
-                       (unsigned char)packetType, message->getRawMessage(), message->getSize(), editData,
-                        message->getPosition(), maxSize);
-            }
-
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
-            quint64 endProcess = usecTimestampNow();
-
-            if (debugProcessPacket) {
-                qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
-                    << "editDataBytesRead=" << editDataBytesRead;
-            }
-
-            editsInPacket++;
-            quint64 thisProcessTime = endProcess - startProcess;
-            quint64 thisLockWaitTime = startProcess - startLock;
-            processTime += thisProcessTime;
-            lockWaitTime += thisLockWaitTime;
-
-            // skip to next edit record in the packet
-            message->seek(message->getPosition() + editDataBytesRead);
-
-            if (debugProcessPacket) {
-                qDebug() << "    editDataBytesRead=" << editDataBytesRead;
-                qDebug() << "    AFTER processEditPacketData payload position=" << message->getPosition();
-                qDebug() << "    AFTER processEditPacketData payload size=" << message->getSize();
-            }
-
+        if (_myServer->wantsBatchedEdits()) {
+            _pendingEditPackets.push_back({ message, sendingNode, sequence, transitTime });
+            return;
         }
 
-        if (debugProcessPacket) {
-            qDebug("OctreeInboundPacketProcessor::processPacket() DONE LOOPING FOR %hhu "
-                   "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld",
-                   (unsigned char)packetType, message->getRawMessage(), message->getSize(), editData, message->getPosition());
-        }
+        int editsInPacket = processEdits(*message, sendingNode, true, processTime, lockWaitTime);
 
         // Make sure our Node and NodeList knows we've heard from this node.
         QUuid& nodeUUID = DEFAULT_NODE_ID_REF;
@@ -225,6 +203,120 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
     }
 }
 
+int OctreeInboundPacketProcessor::processEdits(ReceivedMessage& message, const SharedNodePointer& sendingNode,
+        bool lockPerEdit, quint64& processTime, quint64& lockWaitTime) {
+    bool debugProcessPacket = _myServer->wantsVerboseDebug();
+    PacketType packetType = message.getType();
+    int editsInPacket = 0;
+
+    const unsigned char* editData = nullptr;
+
+    while (message.getBytesLeftToRead() > 0) {
+
+        editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+
+        int maxSize = message.getBytesLeftToRead();
+
+        if (debugProcessPacket) {
+            qDebug() << " --- inside while loop ---";
+            qDebug() << "    maxSize=" << maxSize;
+            qDebug("OctreeInboundPacketProcessor::processPacket() %hhu "
+                   "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld maxSize=%d",
+                   (unsigned char)packetType, message.getRawMessage(), message.getSize(), editData,
+                    message.getPosition(), maxSize);
+        }
+
+        quint64 startProcess, startLock = usecTimestampNow();
+        int editDataBytesRead;
+        if (lockPerEdit) {
+            _myServer->getOctree()->withWriteLock([&] {
+                startProcess = usecTimestampNow();
+                editDataBytesRead =
+                    _myServer->getOctree()->processEditPacketData(message, editData, maxSize, sendingNode);
+            });
+        } else {
+            // the caller already holds the tree lock
+            startProcess = startLock;
+            editDataBytesRead = _myServer->getOctree()->processEditPacketData(message, editData, maxSize, sendingNode);
+        }
+        quint64 endProcess = usecTimestampNow();
+
+        if (debugProcessPacket) {
+            qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
+                << "editDataBytesRead=" << editDataBytesRead;
+        }
+
+        editsInPacket++;
+        quint64 thisProcessTime = endProcess - startProcess;
+        quint64 thisLockWaitTime = startProcess - startLock;
+        processTime += thisProcessTime;
+        lockWaitTime += thisLockWaitTime;
+
+        // skip to next edit record in the packet
+        message.seek(message.getPosition() + editDataBytesRead);
+
+        if (debugProcessPacket) {
+            qDebug() << "    editDataBytesRead=" << editDataBytesRead;
+            qDebug() << "    AFTER processEditPacketData payload position=" << message.getPosition();
+            qDebug() << "    AFTER processEditPacketData payload size=" << message.getSize();
+        }
+
+    }
+
+    if (debugProcessPacket) {
+        qDebug("OctreeInboundPacketProcessor::processPacket() DONE LOOPING FOR %hhu "
+               "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld",
+               (unsigned char)packetType, message.getRawMessage(), message.getSize(), editData, message.getPosition());
+    }
+
+    return editsInPacket;
+}
+
+void OctreeInboundPacketProcessor::processEditBatch() {
+    if (_pendingEditPackets.empty()) {
+        return;
+    }
+
+    struct EditPacketResult {
+        int editsInPacket;
+        quint64 processTime;
+    };
+    std::vector<EditPacketResult> results;
+    results.reserve(_pendingEditPackets.size());
+
+    quint64 startLock = usecTimestampNow();
+    quint64 startApply = startLock;
+    _myServer->getOctree()->withWriteLock([&] {
+        startApply = usecTimestampNow();
+        for (auto& pending : _pendingEditPackets) {
+            quint64 processTime = 0;
+            quint64 unusedLockWaitTime = 0;
+            int editsInPacket = processEdits(*pending.message, pending.sendingNode, false, processTime, unusedLockWaitTime);
+            results.push_back({ editsInPacket, processTime });
+        }
+    });
+    quint64 endApply = usecTimestampNow();
+
+    // every packet in the batch waited for the lock as long as the batch did
+    quint64 lockWaitTime = startApply - startLock;
+    for (size_t i = 0; i < _pendingEditPackets.size(); ++i) {
+        const auto& pending = _pendingEditPackets[i];
+        QUuid nodeUUID = pending.sendingNode ? pending.sendingNode->getUUID() : DEFAULT_NODE_ID_REF;
+        trackInboundPacket(nodeUUID, pending.sequence, pending.transitTime, results[i].editsInPacket,
+                           results[i].processTime, lockWaitTime);
+    }
+
+    _totalEditBatches++;
+    _totalPacketsInEditBatches += _pendingEditPackets.size();
+    {
+        QMutexLocker locker(&_editBatchStatsMutex);
+        _editBatchLockWaitTimes.record(lockWaitTime);
+        _editBatchApplyTimes.record(endApply - startApply);
+    }
+
+    _pendingEditPackets.clear();
+}
+
 void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int editsInPacket, quint64 processTime, quint64 lockWaitTime) {
 
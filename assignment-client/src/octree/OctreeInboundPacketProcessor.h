@@ -14,6 +14,11 @@
 #ifndef hifi_OctreeInboundPacketProcessor_h
 #define hifi_OctreeInboundPacketProcessor_h
 
+#include <vector>
+
+#include <QtCore/QMutex>
+
+#include <LatencyHistogram.h>
 #include <ReceivedPacketProcessor.h>
 
 #include "SequenceNumberStats.h"
@@ -55,9 +60,15 @@ typedef QHash<QUuid, SingleSenderStats>::const_iterator NodeToSenderStatsMapCons
 
 /// Handles processing of incoming network packets for the octee servers. As with other ReceivedPacketProcessor classes
 /// the user is responsible for reading inbound packets and adding them to the processing queue by calling queueReceivedPacket()
+///
+/// When the server wants batched edits, the edit packets of one pass over the queue are held back and applied together
+/// under a single tree write lock at the end of the pass (or every MAX_EDIT_PACKETS_PER_BATCH packets), instead of
+/// taking the lock once per edit.
 class OctreeInboundPacketProcessor : public ReceivedPacketProcessor {
     Q_OBJECT
 public:
+    static const int MAX_EDIT_PACKETS_PER_BATCH = 64;
+
     OctreeInboundPacketProcessor(OctreeServer* myServer);
 
     quint64 getAverageTransitTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalTransitTime / _totalPackets; }
@@ -70,6 +81,14 @@ public:
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
 
+    quint64 getTotalEditBatches() const { return _totalEditBatches; }
+    float getAveragePacketsPerEditBatch() const
+                { return _totalEditBatches == 0 ? 0.0f : (float)_totalPacketsInEditBatches / _totalEditBatches; }
+
+    // in usecs, wait is the time to get the tree lock and apply is how long a batch then held it
+    LatencyHistogram getEditBatchLockWaitTimes() { QMutexLocker locker(&_editBatchStatsMutex); return _editBatchLockWaitTimes; }
+    LatencyHistogram getEditBatchApplyTimes() { QMutexLocker locker(&_editBatchStatsMutex); return _editBatchApplyTimes; }
+
     void resetStats();
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
@@ -83,11 +102,24 @@ protected:
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
     virtual void midProcess() override;
+    virtual void postProcess() override;
 
 private:
     int sendNackPackets();
 
 private:
+    struct PendingEditPacket {
+        QSharedPointer<ReceivedMessage> message;
+        SharedNodePointer sendingNode;
+        unsigned short int sequence;
+        quint64 transitTime;
+    };
+
+    // runs every edit in the message, taking the tree lock around each one when lockPerEdit is set. Returns the edit count.
+    int processEdits(ReceivedMessage& message, const SharedNodePointer& sendingNode, bool lockPerEdit,
+            quint64& processTime, quint64& lockWaitTime);
+    void processEditBatch();
+
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
 
@@ -103,6 +135,14 @@ private:
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
 
+    std::vector<PendingEditPacket> _pendingEditPackets;
+
+    std::atomic<uint64_t> _totalEditBatches;
+    std::atomic<uint64_t> _totalPacketsInEditBatches;
+    LatencyHistogram _editBatchLockWaitTimes;
+    LatencyHistogram _editBatchApplyTimes;
+    QMutex _editBatchStatsMutex;
+
     std::atomic<uint64_t> _lastNackTime;
     bool _shuttingDown;
 };
@@ -67,6 +67,21 @@ void OctreeSendThread::setIsShuttingDown() {
 
 
 bool OctreeSendThread::process() {
+    int usecToSleep = 0;
+    if (!sendToClient(usecToSleep)) {
+        return false; // exit early if we're shutting down
+    }
+
+    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
+    if (isStillRunning()) {
+        PerformanceWarning warn(false,"OctreeSendThread... usleep()",false,&_usleepTime,&_usleepCalls);
+        std::this_thread::sleep_for(std::chrono::microseconds(usecToSleep));
+    }
+
+    return isStillRunning();  // keep running till they terminate us
+}
+
+bool OctreeSendThread::sendToClient(int& usecToSleep) {
     if (_isShuttingDown) {
         return false; // exit early if we're shutting down
     }
@@ -101,25 +116,16 @@ bool OctreeSendThread::process() {
         return false; // exit early if we're shutting down
     }
 
-    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
-        // dynamically sleep until we need to fire off the next set of octree elements
-        int elapsed = (usecTimestampNow() - start);
-        int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
-
-        if (usecToSleep <= 0) {
-            const int MIN_USEC_TO_SLEEP = 1;
-            usecToSleep = MIN_USEC_TO_SLEEP;
-        }
-
-        {
-            PerformanceWarning warn(false,"OctreeSendThread... usleep()",false,&_usleepTime,&_usleepCalls);
-            std::this_thread::sleep_for(std::chrono::microseconds(usecToSleep));
-        }
+    // the next set of octree elements is due one interval after this one started
+    int elapsed = (usecTimestampNow() - start);
+    usecToSleep = OCTREE_SEND_INTERVAL_USECS - elapsed;
 
+    if (usecToSleep <= 0) {
+        const int MIN_USEC_TO_SLEEP = 1;
+        usecToSleep = MIN_USEC_TO_SLEEP;
     }
 
-    return isStillRunning();  // keep running till they terminate us
+    return true;
 }
 
 AtomicUIntStat OctreeSendThread::_usleepTime { 0 };
@@ -321,6 +327,18 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     _trueBytesSent = 0;
     _packetsSentThisInterval = 0;
 
+    nodeData->updateSendBudget(node->getConnectionStats());
+
+    // a budget of less than a packet per interval is sent a packet every few intervals, once its fractions add up
+    float budgetPerInterval = (float)nodeData->getSendBudgetPacketsPerSecond() / INTERVALS_PER_SECOND;
+    if (budgetPerInterval > 0.0f) {
+        _packetCredit = std::min(_packetCredit + budgetPerInterval, std::max(budgetPerInterval, 1.0f));
+        _clientMaxPacketsPerInterval = (int)_packetCredit;
+        _packetCredit -= _clientMaxPacketsPerInterval;
+    } else {
+        _clientMaxPacketsPerInterval = 1;
+    }
+
     bool isFullScene = nodeData->shouldForceFullScene();
     if (isFullScene) {
         // we're forcing a full scene, clear the force in OctreeQueryNode so we don't force it next time again
@@ -386,8 +404,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     }
 
     // calculate max number of packets that can be sent during this interval
-    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
-    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
+    int maxPacketsPerInterval = std::min(_clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
 
     // Re-send packets that were nacked by the client
     while (nodeData->hasNextNackedPacket() && _packetsSentThisInterval < maxPacketsPerInterval) {
@@ -427,8 +444,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
 
 bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged, bool isFullScene) {
     // calculate max number of packets that can be sent during this interval
-    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
-    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
+    int maxPacketsPerInterval = std::min(_clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
 
     int extraPackingAttempts = 0;
 
@@ -465,6 +481,11 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
             if (_packetData.hasContent()) {
                 // yes, more data to send
                 quint64 compressAndWriteStart = usecTimestampNow();
+                if (_packetData.isCompressed()) {
+                    _myServer->addCompressionDictionarySample(_packetData.getUncompressedData(),
+                                                              _packetData.getUncompressedSize());
+                    nodeData->stats.sectionCompressed(_packetData.getUncompressedSize(), _packetData.getFinalizedSize());
+                }
                 unsigned int additionalSize = _packetData.getFinalizedSize() + sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
                 if (additionalSize > nodeData->getAvailable()) {
                     // no room --> flush what we've got
@@ -506,7 +527,8 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
     if (somethingToSend && _myServer->wantsVerboseDebug()) {
         qCDebug(octree) << "Hit PPS Limit, packetsSentThisInterval =" << _packetsSentThisInterval
                         << "  maxPacketsPerInterval = " << maxPacketsPerInterval
-                        << "  clientMaxPacketsPerInterval = " << clientMaxPacketsPerInterval;
+                        << "  clientMaxPacketsPerInterval = " << _clientMaxPacketsPerInterval
+                        << "  sendBudgetScale = " << nodeData->getSendBudgetScale();
     }
 
     return params.stopReason == EncodeBitstreamParams::FINISHED;
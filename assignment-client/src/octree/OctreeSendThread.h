@@ -38,6 +38,10 @@ public:
 
     QUuid getNodeUuid() const { return _nodeUuid; }
 
+    /// Sends the next set of octree elements to the client, false once it is shutting down. The time until the next
+    /// set is due is in usecToSleep. Called by process(), or by an OctreeSendWorker when the sending is pooled.
+    bool sendToClient(int& usecToSleep);
+
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
     static AtomicUIntStat _totalPackets;
@@ -73,6 +77,8 @@ private:
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
+    int _clientMaxPacketsPerInterval { 1 }; // what the client's send budget allows in this interval
+    float _packetCredit { 0.0f }; // the fraction of a packet the budget carries over to the next intervals
     bool _isShuttingDown { false };
 };
 
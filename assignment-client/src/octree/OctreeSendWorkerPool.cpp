@@ -0,0 +1,195 @@
+//
+//  OctreeSendWorkerPool.cpp
+//  assignment-client/src/octree
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendWorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QtCore/QCoreApplication>
+
+#include <SharedUtil.h>
+#include <ThreadHelpers.h>
+
+#include "OctreeSendThread.h"
+
+static const quint64 MAX_IDLE_USECS = 2000;   // the queued slots of the clients wait at most this long
+
+OctreeSendWorker::OctreeSendWorker(int index) :
+    _utilizationStart(usecTimestampNow())
+{
+    setObjectName(QString("Octree Send Worker %1").arg(index));
+}
+
+void OctreeSendWorker::run() {
+    setThreadName(objectName().toStdString());
+
+    while (!_stop) {
+        // the slots of the clients, between two sends as GenericThread::threadRoutine does
+        QCoreApplication::processEvents();
+
+        Lock lock(_mutex);
+        processRemovals(lock);
+
+        quint64 now = usecTimestampNow();
+        auto next = std::min_element(_clients.begin(), _clients.end(), [](const Client& a, const Client& b) {
+            return a.deadline < b.deadline;
+        });
+        if (next == _clients.end() || next->deadline > now) {
+            quint64 wakeUp = now + MAX_IDLE_USECS;
+            if (next != _clients.end()) {
+                wakeUp = std::min(wakeUp, next->deadline);
+            }
+            _wakeUp.wait_for(lock, std::chrono::microseconds(wakeUp - now));
+            continue;
+        }
+
+        OctreeSendThread* sendThread = next->sendThread;
+        lock.unlock();
+
+        int usecToSleep = 0;
+        bool keepSending = sendThread->sendToClient(usecToSleep);
+        quint64 end = usecTimestampNow();
+        _busyUsecs += end - now;
+
+        lock.lock();
+        // only this thread takes the clients out, it is still there
+        auto client = std::find_if(_clients.begin(), _clients.end(), [&](const Client& client) {
+            return client.sendThread == sendThread;
+        });
+        if (keepSending) {
+            client->deadline = end + usecToSleep;
+        } else {
+            // done with the client, the server deletes it once it is back on its thread
+            sendThread->moveToThread(client->ownerThread);
+            _clients.erase(client);
+            emit sendThread->finished();
+        }
+    }
+}
+
+void OctreeSendWorker::stop() {
+    {
+        Lock lock(_mutex);
+        _stop = true;
+    }
+    _wakeUp.notify_all();
+}
+
+void OctreeSendWorker::processRemovals(Lock& lock) {
+    if (_removals.empty()) {
+        return;
+    }
+
+    for (auto sendThread : _removals) {
+        auto client = std::find_if(_clients.begin(), _clients.end(), [&](const Client& client) {
+            return client.sendThread == sendThread;
+        });
+        // it may have finished on its own since
+        if (client != _clients.end()) {
+            sendThread->moveToThread(client->ownerThread);
+            _clients.erase(client);
+        }
+    }
+    _removals.clear();
+    _removed.notify_all();
+}
+
+void OctreeSendWorker::addClient(OctreeSendThread* client) {
+    client->moveToThread(this);
+
+    Lock lock(_mutex);
+    _clients.push_back({ client, QThread::currentThread(), usecTimestampNow() });
+    _wakeUp.notify_all();
+}
+
+bool OctreeSendWorker::removeClient(OctreeSendThread* client) {
+    Lock lock(_mutex);
+    auto it = std::find_if(_clients.begin(), _clients.end(), [&](const Client& other) {
+        return other.sendThread == client;
+    });
+    if (it == _clients.end()) {
+        return false;
+    }
+
+    if (_stop) {
+        // the thread it lives on is done, it can be deleted there
+        _clients.erase(it);
+        return true;
+    }
+
+    // the worker moves it back between two sends, so that none of its slots runs meanwhile
+    _removals.push_back(client);
+    _wakeUp.notify_all();
+    _removed.wait(lock, [&] {
+        return std::find(_removals.begin(), _removals.end(), client) == _removals.end();
+    });
+    return true;
+}
+
+int OctreeSendWorker::getClientCount() const {
+    Lock lock(_mutex);
+    return (int)_clients.size();
+}
+
+float OctreeSendWorker::takeUtilization() {
+    quint64 now = usecTimestampNow();
+    quint64 busyUsecs = _busyUsecs.exchange(0);
+    quint64 elapsedUsecs = now - _utilizationStart;
+    _utilizationStart = now;
+    return elapsedUsecs > 0 ? std::min(1.0f, (float)busyUsecs / (float)elapsedUsecs) : 0.0f;
+}
+
+OctreeSendWorkerPool::OctreeSendWorkerPool(int numWorkers) {
+    numWorkers = std::max(1, numWorkers);
+    for (int i = 0; i < numWorkers; ++i) {
+        _workers.push_back(std::make_unique<OctreeSendWorker>(i));
+        _workers.back()->start();
+    }
+}
+
+OctreeSendWorkerPool::~OctreeSendWorkerPool() {
+    stop();
+}
+
+void OctreeSendWorkerPool::addClient(OctreeSendThread* client) {
+    auto worker = std::min_element(_workers.begin(), _workers.end(), [](const std::unique_ptr<OctreeSendWorker>& a,
+                                                                        const std::unique_ptr<OctreeSendWorker>& b) {
+        return a->getClientCount() < b->getClientCount();
+    });
+    (*worker)->addClient(client);
+}
+
+void OctreeSendWorkerPool::removeClient(OctreeSendThread* client) {
+    for (auto& worker : _workers) {
+        if (worker->removeClient(client)) {
+            return;
+        }
+    }
+}
+
+void OctreeSendWorkerPool::stop() {
+    for (auto& worker : _workers) {
+        worker->stop();
+    }
+    for (auto& worker : _workers) {
+        worker->wait();
+    }
+}
+
+QJsonArray OctreeSendWorkerPool::takeUtilization() {
+    QJsonArray utilization;
+    for (auto& worker : _workers) {
+        const float PERCENT = 100.0f;
+        utilization.append((double)(worker->takeUtilization() * PERCENT));
+    }
+    return utilization;
+}
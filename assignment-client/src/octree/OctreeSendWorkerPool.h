@@ -0,0 +1,93 @@
+//
+//  OctreeSendWorkerPool.h
+//  assignment-client/src/octree
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OctreeSendWorkerPool_h
+#define hifi_OctreeSendWorkerPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QThread>
+
+class OctreeSendThread;
+
+// Runs the sending to many clients on one thread, each client when its next set of octree elements is due, the earliest
+// first. The OctreeSendThreads of the worker live on its thread, so that their slots run between two sends as they
+// do on a thread of their own.
+class OctreeSendWorker : public QThread {
+    Q_OBJECT
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+public:
+    OctreeSendWorker(int index);
+
+    void run() override;
+    void stop();
+
+    // On the thread the send threads are made on:
+    // moves the client to this worker, which sends to it as soon as it runs
+    void addClient(OctreeSendThread* client);
+    // moves the client back to the calling thread, so that it can be deleted, false if it wasn't one of this worker
+    bool removeClient(OctreeSendThread* client);
+
+    int getClientCount() const;
+
+    // the share of the time spent sending since the last call
+    float takeUtilization();
+
+private:
+    struct Client {
+        OctreeSendThread* sendThread;
+        QThread* ownerThread;   // that it goes back to once removed
+        quint64 deadline;       // usecs
+    };
+
+    void processRemovals(Lock& lock);
+
+    std::atomic<bool> _stop { false };
+
+    mutable Mutex _mutex;
+    std::condition_variable _wakeUp;      // a client was added or is to be removed
+    std::condition_variable _removed;
+    std::vector<Client> _clients;
+    std::vector<OctreeSendThread*> _removals;
+
+    std::atomic<quint64> _busyUsecs { 0 };
+    quint64 _utilizationStart { 0 };
+};
+
+// A fixed number of OctreeSendWorkers, one per core, the clients are given to the one that has the fewest.
+class OctreeSendWorkerPool {
+public:
+    OctreeSendWorkerPool(int numWorkers = QThread::idealThreadCount());
+    ~OctreeSendWorkerPool();
+
+    void addClient(OctreeSendThread* client);
+    void removeClient(OctreeSendThread* client);
+
+    // stops and joins the workers, their clients are not sent to any more
+    void stop();
+
+    // the utilization of each worker since the last call, in percent
+    QJsonArray takeUtilization();
+
+private:
+    std::vector<std::unique_ptr<OctreeSendWorker>> _workers;
+};
+
+#endif // hifi_OctreeSendWorkerPool_h
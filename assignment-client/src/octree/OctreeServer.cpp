@@ -33,6 +33,7 @@
 #include <PathUtils.h>
 #include <QtCore/QDir>
 
+#include <OctreeCompressionDictionary.h>
 #include <OctreeDataUtils.h>
 #include <ThreadHelpers.h>
 
@@ -162,6 +163,43 @@ void OctreeServer::trackEncodeTime(float time) {
     }
 }
 
+QByteArray OctreeServer::getCompressionDictionary() const {
+    if (!_hasCompressionDictionary) {
+        return QByteArray();
+    }
+    std::lock_guard<std::mutex> lock(_compressionDictionaryMutex);
+    return _compressionDictionary;
+}
+
+void OctreeServer::addCompressionDictionarySample(const unsigned char* data, int size) {
+    if (_hasCompressionDictionary || size <= 0) {
+        return;
+    }
+
+    std::vector<QByteArray> samples;
+    {
+        std::lock_guard<std::mutex> lock(_compressionDictionaryMutex);
+        if (_compressionDictionarySamplesSize >= OctreeCompressionDictionary::TRAINING_SIZE) {
+            return; // another send thread is training it
+        }
+        _compressionDictionarySamples.emplace_back(reinterpret_cast<const char*>(data), size);
+        _compressionDictionarySamplesSize += size;
+        if (_compressionDictionarySamplesSize < OctreeCompressionDictionary::TRAINING_SIZE) {
+            return;
+        }
+        samples.swap(_compressionDictionarySamples);
+    }
+
+    // trained once, on the send thread that gave the last sample, out of the lock
+    QByteArray dictionary = OctreeCompressionDictionary::train(samples);
+    qDebug() << "Trained a compression dictionary of" << dictionary.size() << "bytes on" << samples.size() << "sections,"
+             << "id" << zlibDictionaryID(dictionary);
+
+    std::lock_guard<std::mutex> lock(_compressionDictionaryMutex);
+    _compressionDictionary = dictionary;
+    _hasCompressionDictionary = !dictionary.isEmpty();
+}
+
 void OctreeServer::trackTreeWaitTime(float time) {
     const float MAX_SHORT_TIME = 10.0f;
     const float MAX_LONG_TIME = 100.0f;
@@ -244,6 +282,7 @@ OctreeServer::OctreeServer(ReceivedMessage& message) :
     _debugSending(false),
     _debugReceiving(false),
     _verboseDebug(false),
+    _batchedEdits(true),
     _octreeInboundPacketProcessor(nullptr),
     _persistManager(nullptr),
     _started(time(0)),
@@ -657,6 +696,10 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 averageLockWaitTimePerElement = _octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
         quint64 totalElementsProcessed = _octreeInboundPacketProcessor->getTotalElementsProcessed();
         quint64 totalPacketsProcessed = _octreeInboundPacketProcessor->getTotalPacketsProcessed();
+        quint64 totalEditBatches = _octreeInboundPacketProcessor->getTotalEditBatches();
+        float averagePacketsPerEditBatch = _octreeInboundPacketProcessor->getAveragePacketsPerEditBatch();
+        LatencyHistogram editBatchLockWaitTimes = _octreeInboundPacketProcessor->getEditBatchLockWaitTimes();
+        LatencyHistogram editBatchApplyTimes = _octreeInboundPacketProcessor->getEditBatchApplyTimes();
 
         quint64 averageDecodeTime = _tree->getAverageDecodeTime();
         quint64 averageLookupTime = _tree->getAverageLookupTime();
@@ -693,6 +736,19 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("  Average Wait Lock Time/Element: %1 usecs\r\n")
             .arg(locale.toString((uint)averageLockWaitTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
 
+        statsString += QString("              Total Edit Batches: %1 batches\r\n")
+            .arg(locale.toString((uint)totalEditBatches).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("     Average Edit Packets/Batch: %1 packets\r\n")
+            .arg(locale.toString(averagePacketsPerEditBatch, 'f', FLOAT_PRECISION).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("Batch Wait Lock Time p50/p99/max: %1 / %2 / %3 usecs\r\n")
+            .arg(locale.toString((uint)editBatchLockWaitTimes.getPercentile(50.0)))
+            .arg(locale.toString((uint)editBatchLockWaitTimes.getPercentile(99.0)))
+            .arg(locale.toString((uint)editBatchLockWaitTimes.getMax()));
+        statsString += QString("    Batch Apply Time p50/p99/max: %1 / %2 / %3 usecs\r\n")
+            .arg(locale.toString((uint)editBatchApplyTimes.getPercentile(50.0)))
+            .arg(locale.toString((uint)editBatchApplyTimes.getPercentile(99.0)))
+            .arg(locale.toString((uint)editBatchApplyTimes.getMax()));
+
         statsString += QString("             Average Decode Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageDecodeTime).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("             Average Lookup Time: %1 usecs\r\n")
@@ -880,16 +936,32 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 
     // we want to be notified when the thread finishes
     connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+    if (_sendWorkerPool) {
+        sendThread->initialize(false);
+        _sendWorkerPool->addClient(sendThread.get());
+    } else {
+        sendThread->initialize(true);
+    }
 
     return sendThread;
 }
 
+OctreeServer::SendThreads::iterator OctreeServer::eraseSendThread(SendThreads::iterator it) {
+    if (_sendWorkerPool) {
+        // back from its worker before it is deleted
+        _sendWorkerPool->removeClient(it->second.get());
+    }
+    return _sendThreads.erase(it);
+}
+
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
-        // This deletes the unique_ptr, so sendThread is destructed after that line
-        _sendThreads.erase(sendThread->getNodeUuid());
+        auto it = _sendThreads.find(sendThread->getNodeUuid());
+        if (it != _sendThreads.end() && it->second.get() == sendThread) {
+            // This deletes the unique_ptr, so sendThread is destructed after that line
+            eraseSendThread(it);
+        }
     }
 }
 
@@ -904,7 +976,7 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
-            _sendThreads.erase(it); // Remove right away and wait on thread to be
+            eraseSendThread(it); // Remove right away and wait on thread to be
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         }
@@ -1025,6 +1097,12 @@ void OctreeServer::readConfiguration() {
     readOptionBool(QString("debugTimestampNow"), settingsSectionObject, _debugTimestampNow);
     qDebug() << "debugTimestampNow=" << _debugTimestampNow;
 
+    // edits are applied in batches under one tree lock unless asked not to
+    bool noBatchedEdits;
+    readOptionBool(QString("noBatchedEdits"), settingsSectionObject, noBatchedEdits);
+    _batchedEdits = !noBatchedEdits;
+    qDebug("batchedEdits=%s", debug::valueOf(_batchedEdits));
+
     bool noPersist;
     readOptionBool(QString("NoPersist"), settingsSectionObject, noPersist);
     _wantPersist = !noPersist;
@@ -1050,6 +1128,12 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
         _persistAsFileType = "json.gz";
+        bool persistAsBinary = false;
+        readOptionBool(QString("persistAsBinary"), settingsSectionObject, persistAsBinary);
+        if (persistAsBinary) {
+            _persistAsFileType = "bin";
+        }
+        qDebug() << "persistAsFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         int result { -1 };
@@ -1060,6 +1144,14 @@ void OctreeServer::readConfiguration() {
 
         qDebug() << "persistInterval=" << _persistInterval.count();
 
+        // with a journal interval the changes are saved that often, and the full persist becomes a compaction
+        result = -1;
+        readOptionInt(QString("journalInterval"), settingsSectionObject, result);
+        if (result > 0) {
+            _journalInterval = std::chrono::milliseconds(result);
+        }
+        qDebug() << "journalInterval=" << _journalInterval.count();
+
         readOptionBool(QString("persistFileDownload"), settingsSectionObject, _persistFileDownload);
         qDebug() << "persistFileDownload=" << _persistFileDownload;
 
@@ -1099,6 +1191,9 @@ void OctreeServer::readConfiguration() {
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
 
+    readOptionBool(QString("pooledSending"), settingsSectionObject, _wantPooledSending);
+    qDebug() << "pooledSending=" << _wantPooledSending;
+
     readAdditionalConfiguration(settingsSectionObject);
 }
 
@@ -1132,6 +1227,10 @@ void OctreeServer::domainSettingsRequestComplete() {
 
     readConfiguration();
 
+    if (_wantPooledSending) {
+        _sendWorkerPool = std::make_unique<OctreeSendWorkerPool>();
+    }
+
     // if we want Persistence, set up the local file and persist thread
     if (_wantPersist) {
         static const QString ENTITY_PERSIST_EXTENSION = ".json.gz";
@@ -1190,7 +1289,7 @@ void OctreeServer::domainSettingsRequestComplete() {
 
         // now set up PersistThread
         _persistManager = new OctreePersistThread(_tree, _persistAbsoluteFilePath, _persistInterval, _debugTimestampNow,
-                                                 _persistAsFileType);
+                                                 _persistAsFileType, _journalInterval);
         _persistManager->moveToThread(&_persistThread);
         connect(&_persistThread, &QThread::finished, _persistManager, &QObject::deleteLater);
         connect(&_persistThread, &QThread::started, _persistManager, [this] {
@@ -1301,6 +1400,9 @@ void OctreeServer::aboutToFinish() {
         sendThread.setIsShuttingDown();
         sendThread.terminate();
     }
+    if (_sendWorkerPool) {
+        _sendWorkerPool->stop();
+    }
 
     // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
     // which waits on the thread to be done before returning
@@ -1428,6 +1530,9 @@ void OctreeServer::sendStatsPacket() {
     threadsStats["2. packetDistributor"] = (double)howManyThreadsDidPacketDistributor(oneSecondAgo);
     threadsStats["3. handlePacektSend"] = (double)howManyThreadsDidHandlePacketSend(oneSecondAgo);
     threadsStats["4. writeDatagram"] = (double)howManyThreadsDidCallWriteDatagram(oneSecondAgo);
+    if (_sendWorkerPool) {
+        threadsStats["5. sendWorkerUtilization"] = _sendWorkerPool->takeUtilization();
+    }
 
     QJsonObject statsArray1;
     statsArray1["1. configuration"] = getConfiguration();
@@ -1481,6 +1586,11 @@ void OctreeServer::sendStatsPacket() {
         timingArray2["3. avgLockWaitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
         timingArray2["4. avgProcessTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         timingArray2["5. avgLockWaitTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
+
+        dataArray2["4. totalEditBatches"] = (double)_octreeInboundPacketProcessor->getTotalEditBatches();
+        dataArray2["5. avgPacketsPerEditBatch"] = (double)_octreeInboundPacketProcessor->getAveragePacketsPerEditBatch();
+        timingArray2["6. editBatchLockWaitTimes"] = _octreeInboundPacketProcessor->getEditBatchLockWaitTimes().toJson("usecs");
+        timingArray2["7. editBatchApplyTimes"] = _octreeInboundPacketProcessor->getEditBatchApplyTimes().toJson("usecs");
     }
 
     QJsonObject statsObject3;
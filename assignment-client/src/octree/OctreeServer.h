@@ -12,7 +12,10 @@
 #ifndef hifi_OctreeServer_h
 #define hifi_OctreeServer_h
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <QStringList>
 #include <QDateTime>
@@ -24,6 +27,7 @@
 
 #include "OctreePersistThread.h"
 #include "OctreeSendThread.h"
+#include "OctreeSendWorkerPool.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
 
@@ -46,6 +50,7 @@ public:
     bool wantsDebugSending() const { return _debugSending; }
     bool wantsDebugReceiving() const { return _debugReceiving; }
     bool wantsVerboseDebug() const { return _verboseDebug; }
+    bool wantsBatchedEdits() const { return _batchedEdits; }
 
     OctreePointer getOctree() { return _tree; }
 
@@ -85,6 +90,11 @@ public:
     virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& viewerNode) { }
     virtual void trackViewerGone(const QUuid& viewerNode) { }
 
+    // The dictionary the sections are compressed with for the clients that have it, empty until there was enough of the
+    // sections sent to train it on (see OctreeCompressionDictionary). The send threads give their sections as samples.
+    QByteArray getCompressionDictionary() const;
+    void addCompressionDictionarySample(const unsigned char* data, int size);
+
     static float SKIP_TIME; // use this for trackXXXTime() calls for non-times
 
     static void trackLoopTime(float time) { _averageLoopTime.updateAverage(time); }
@@ -167,6 +177,7 @@ protected:
     void beginRunning();
     
     UniqueSendThread createSendThread(const SharedNodePointer& node);
+    SendThreads::iterator eraseSendThread(SendThreads::iterator it);
     virtual UniqueSendThread newSendThread(const SharedNodePointer& node) = 0;
 
     int _argc;
@@ -191,11 +202,13 @@ protected:
     bool _debugReceiving;
     bool _debugTimestampNow;
     bool _verboseDebug;
+    bool _batchedEdits;
     OctreeInboundPacketProcessor* _octreeInboundPacketProcessor;
     OctreePersistThread* _persistManager;
     QThread _persistThread;
 
     std::chrono::milliseconds _persistInterval;
+    std::chrono::milliseconds _journalInterval { std::chrono::milliseconds::zero() };
     bool _persistFileDownload;
     int _maxBackupVersions;
 
@@ -204,6 +217,15 @@ protected:
     QString _safeServerName;
     
     SendThreads _sendThreads;
+    // when the sending is pooled, the send threads are run by a fixed number of workers rather than each on a thread
+    bool _wantPooledSending { false };
+    std::unique_ptr<OctreeSendWorkerPool> _sendWorkerPool;
+
+    mutable std::mutex _compressionDictionaryMutex;
+    std::vector<QByteArray> _compressionDictionarySamples;
+    int _compressionDictionarySamplesSize { 0 };
+    QByteArray _compressionDictionary;
+    std::atomic<bool> _hasCompressionDictionary { false };
 
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
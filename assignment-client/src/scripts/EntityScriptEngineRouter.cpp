@@ -0,0 +1,81 @@
+//
+//  EntityScriptEngineRouter.cpp
+//  assignment-client/src/scripts
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEngineRouter.h"
+
+#include <algorithm>
+
+void EntityScriptEngineRouter::setEngines(const std::vector<ScriptEnginePointer>& engines, Sharding sharding) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _engines = engines;
+    _sharding = sharding;
+    _entityEngines.clear();
+}
+
+void EntityScriptEngineRouter::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _engines.clear();
+    _entityEngines.clear();
+}
+
+ScriptEnginePointer EntityScriptEngineRouter::pickEngine(const EntityItemID& entityID, const QString& scriptURL) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_engines.empty()) {
+        return ScriptEnginePointer();
+    }
+    uint hash = _sharding == Sharding::ByScriptURL ? qHash(scriptURL) : qHash((const QUuid&)entityID);
+    return _engines[indexForHash(hash)];
+}
+
+ScriptEnginePointer EntityScriptEngineRouter::engineFor(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_engines.empty()) {
+        return ScriptEnginePointer();
+    }
+    auto it = _entityEngines.find(entityID);
+    int index = it != _entityEngines.end() ? it.value() : indexForHash(qHash((const QUuid&)entityID));
+    return _engines[index];
+}
+
+QList<QUuid> EntityScriptEngineRouter::getEntityIDs() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entityEngines.keys();
+}
+
+void EntityScriptEngineRouter::setEngineFor(const EntityItemID& entityID, const ScriptEnginePointer& engine) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = std::find(_engines.begin(), _engines.end(), engine);
+    if (it == _engines.end()) {
+        return;
+    }
+    _entityEngines.insert(entityID, (int)(it - _engines.begin()));
+}
+
+void EntityScriptEngineRouter::removeEngineFor(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entityEngines.remove(entityID);
+}
+
+void EntityScriptEngineRouter::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                      const QStringList& params, const QUuid& remoteCallerID) {
+    auto engine = engineFor(entityID);
+    if (engine) {
+        engine->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+}
+
+QFuture<QVariant> EntityScriptEngineRouter::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = engineFor(entityID);
+    if (!engine) {
+        return QFuture<QVariant>();
+    }
+    return engine->getLocalEntityScriptDetails(entityID);
+}
@@ -0,0 +1,62 @@
+//
+//  EntityScriptEngineRouter.h
+//  assignment-client/src/scripts
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEngineRouter_h
+#define hifi_EntityScriptEngineRouter_h
+
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// Spreads the entity server scripts over the entity script server's script engines, and routes the calls made for an
+// entity to the engine running its script, whichever thread they come from.
+class EntityScriptEngineRouter : public EntitiesScriptEngineProvider {
+public:
+    enum class Sharding {
+        ByEntityID, // spreads the scripts the most evenly
+        ByScriptURL // keeps the entities running the same script together
+    };
+
+    void setEngines(const std::vector<ScriptEnginePointer>& engines, Sharding sharding);
+    void clear();
+
+    // only for the server's thread, which is the only one to set them
+    const std::vector<ScriptEnginePointer>& getEngines() const { return _engines; }
+
+    // the engine that should run the given script for an entity
+    ScriptEnginePointer pickEngine(const EntityItemID& entityID, const QString& scriptURL) const;
+
+    // the engine running the script of an entity, or the one it would be picked by ID if none is
+    ScriptEnginePointer engineFor(const EntityItemID& entityID) const;
+    QList<QUuid> getEntityIDs() const;
+
+    void setEngineFor(const EntityItemID& entityID, const ScriptEnginePointer& engine);
+    void removeEngineFor(const EntityItemID& entityID);
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    int indexForHash(uint hash) const { return (int)(hash % (uint)_engines.size()); }
+
+    mutable std::mutex _mutex;
+    std::vector<ScriptEnginePointer> _engines;
+    Sharding _sharding { Sharding::ByEntityID };
+    QHash<QUuid, int> _entityEngines; // engine index by entity ID
+};
+
+#endif // hifi_EntityScriptEngineRouter_h
@@ -13,6 +13,8 @@
 
 #include <mutex>
 
+#include <QtCore/QJsonArray>
+
 #include <AudioConstants.h>
 #include <AudioInjectorManager.h>
 #include <ClientServerUtils.h>
@@ -130,7 +132,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto engine = _engineRouter->engineFor(entityID);
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -150,6 +153,15 @@ void EntityScriptServer::handleSettings() {
     auto& domainHandler = nodeList->getDomainHandler();
     const QJsonObject& settingsObject = domainHandler.getSettingsObject();
 
+    // the scripts query the entities with the index the entity server uses
+    static const QString ENTITY_SERVER_SETTINGS_KEY = "entity_server_settings";
+    static const QString SPATIAL_INDEX_OPTION = "spatialIndex";
+    static const QString SPATIAL_INDEX_GRID = "grid";
+    if (_entityViewer.getTree()) {
+        bool isGrid = settingsObject[ENTITY_SERVER_SETTINGS_KEY].toObject()[SPATIAL_INDEX_OPTION].toString() == SPATIAL_INDEX_GRID;
+        _entityViewer.getTree()->setSpatialIndex(isGrid ? EntityTree::SpatialIndex::Grid : EntityTree::SpatialIndex::Octree);
+    }
+
     static const QString ENTITY_SCRIPT_SERVER_SETTINGS_KEY = "entity_script_server";
 
     if (!settingsObject.contains(ENTITY_SCRIPT_SERVER_SETTINGS_KEY)) {
@@ -159,6 +171,38 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    static const QString SCRIPT_ENGINE_COUNT_OPTION = "script_engine_count";
+    static const QString SCRIPT_ENGINE_SHARDING_OPTION = "script_engine_sharding";
+    static const QString SHARDING_BY_SCRIPT_URL = "script_url";
+    static const int MAX_SCRIPT_ENGINE_COUNT = 32;
+
+    int numScriptEngines = std::min(std::max(entityScriptServerSettings[SCRIPT_ENGINE_COUNT_OPTION].toInt(1), 1),
+                                    MAX_SCRIPT_ENGINE_COUNT);
+    auto sharding = entityScriptServerSettings[SCRIPT_ENGINE_SHARDING_OPTION].toString() == SHARDING_BY_SCRIPT_URL ?
+        EntityScriptEngineRouter::Sharding::ByScriptURL : EntityScriptEngineRouter::Sharding::ByEntityID;
+
+    if (numScriptEngines != _numScriptEngines || sharding != _sharding) {
+        _numScriptEngines = numScriptEngines;
+        _sharding = sharding;
+
+        qDebug() << "Running entity scripts in" << _numScriptEngines << "script engines, sharded by"
+                 << (_sharding == EntityScriptEngineRouter::Sharding::ByScriptURL ? "script URL" : "entity ID");
+
+        if (!_entitiesScriptEngines.empty() && !_shuttingDown) {
+            restartEntitiesScriptEngines();
+        }
+    }
+
+    // the time each entity script may take per second before its calls are skipped, 0 for no budget
+    static const QString SCRIPT_BUDGET_OPTION = "script_budget_ms_per_second";
+    int scriptBudget = std::max(entityScriptServerSettings[SCRIPT_BUDGET_OPTION].toInt(0), 0);
+    if (scriptBudget != _scriptBudget) {
+        _scriptBudget = scriptBudget;
+        for (auto& engine : _entitiesScriptEngines) {
+            engine->setScriptBudget(_scriptBudget);
+        }
+    }
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -175,7 +219,10 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = 0;
+    for (const auto& engine : _entitiesScriptEngines) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -236,7 +283,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (!_entitiesScriptEngines.empty() && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -250,7 +297,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        _engineRouter->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -281,8 +328,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -444,7 +491,34 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    for (const auto& engine : _entitiesScriptEngines) {
+        disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+    }
+
+    // each engine releases its queued edits from its own thread, so the sender has to run on its own
+    if (_numScriptEngines > 1 && !_entityEditSender.isThreaded()) {
+        _entityEditSender.initialize(true);
+    }
+
+    std::vector<ScriptEnginePointer> newEngines;
+    for (int i = 0; i < _numScriptEngines; ++i) {
+        // a single engine drives the updates of the entity tree
+        newEngines.push_back(createEntitiesScriptEngine(i == 0));
+    }
+    _engineRouter->setEngines(newEngines, _sharding);
+
+    // On the entity script server, these are the same
+    DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(_engineRouter);
+    DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(_engineRouter);
+
+    _entitiesScriptEngines.swap(newEngines);
+    for (const auto& engine : _entitiesScriptEngines) {
+        connect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+    }
+}
+
+ScriptEnginePointer EntityScriptServer::createEntitiesScriptEngine(bool updatesEntityTree) {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
 
@@ -461,50 +535,60 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->preUpdate();
-        _entityViewer.getTree()->update();
-    });
+    if (updatesEntityTree) {
+        connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+            _entityViewer.queryOctree();
+            _entityViewer.getTree()->preUpdate();
+            _entityViewer.getTree()->update();
+        });
+    }
+
+    newEngine->setScriptBudget(_scriptBudget);
 
     scriptEngines->runScriptInitializers(newEngine);
     newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    // On the entity script server, these are the same
-    DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(newEngineSP);
-    DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(newEngineSP);
+    return newEngine;
+}
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
-    }
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    // unload and stop the engines, all at once so that they wind down in parallel
+    for (const auto& engine : _entitiesScriptEngines) {
+        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
+        engine->unloadAllEntityScripts();
+        engine->stop();
+    }
+    for (const auto& engine : _entitiesScriptEngines) {
+        engine->waitTillDoneRunning();
+    }
 }
 
+void EntityScriptServer::restartEntitiesScriptEngines() {
+    auto entityIDs = _engineRouter->getEntityIDs();
 
-void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
-        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+    stopEntitiesScriptEngines();
+    resetEntitiesScriptEngines();
+
+    // the entities are still there, load their scripts in the new engines
+    for (const auto& entityID : entityIDs) {
+        checkAndCallPreload(entityID);
     }
+}
+
+void EntityScriptServer::clear() {
+    stopEntitiesScriptEngines();
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (const auto& engine : _entitiesScriptEngines) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -513,7 +597,12 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    _entitiesScriptEngines.clear();
+    _engineRouter->clear();
+
+    if (_entityEditSender.isThreaded()) {
+        _entityEditSender.terminate();
+    }
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -531,8 +620,9 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown && !_entitiesScriptEngines.empty()) {
+        _engineRouter->engineFor(entityID)->unloadEntityScript(entityID, true);
+        _engineRouter->removeEngineFor(entityID);
     }
 }
 
@@ -543,20 +633,24 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && !_entitiesScriptEngines.empty()) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        auto runningEngine = _engineRouter->engineFor(entityID);
+        bool isRunning = runningEngine->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+                runningEngine->unloadEntityScript(entityID, true);
             }
+            _engineRouter->removeEngineFor(entityID);
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                auto engine = _engineRouter->pickEngine(entityID, scriptUrl);
+                _engineRouter->setEngineFor(entityID, engine);
+                engine->loadEntityScript(entityID, scriptUrl, forceRedownload);
             }
         }
     }
@@ -571,13 +665,22 @@ void EntityScriptServer::sendStatsPacket() {
     octreeStats["leafElementCount"] = (double)OctreeElement::getLeafNodeCount();
     statsObject["octree_stats"] = octreeStats;
 
+    static const int SLOWEST_SCRIPTS_IN_STATS = 5;
     QJsonObject scriptEngineStats;
     int numberRunningScripts = 0;
-    const auto scriptEngine = _entitiesScriptEngine;
-    if (scriptEngine) {
-        numberRunningScripts = scriptEngine->getNumRunningEntityScripts();
+    QJsonArray enginesStats;
+    for (const auto& engine : _entitiesScriptEngines) {
+        int engineRunningScripts = engine->getNumRunningEntityScripts();
+        numberRunningScripts += engineRunningScripts;
+
+        QJsonObject engineStats;
+        engineStats["number_running_scripts"] = engineRunningScripts;
+        engineStats["thread_load"] = engine->getAndResetThreadLoad();
+        engineStats["slowest_scripts"] = QJsonArray::fromVariantList(engine->getSlowestScripts(SLOWEST_SCRIPTS_IN_STATS));
+        enginesStats.append(engineStats);
     }
     scriptEngineStats["number_running_scripts"] = numberRunningScripts;
+    scriptEngineStats["engines"] = enginesStats;
     statsObject["script_engine_stats"] = scriptEngineStats;
     
 
@@ -620,7 +723,7 @@ void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> mess
             // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
             int piggyBackedSizeWithHeader = message->getSize() - statsMessageLength;
 
-            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            auto buffer = udt::PacketBufferPool::allocate(piggyBackedSizeWithHeader);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
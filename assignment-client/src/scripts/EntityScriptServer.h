@@ -24,6 +24,7 @@
 #include <SimpleEntitySimulation.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptEngineRouter.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -61,7 +62,10 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void resetEntitiesScriptEngines();
+    void stopEntitiesScriptEngines();
+    void restartEntitiesScriptEngines();
+    ScriptEnginePointer createEntitiesScriptEngine(bool updatesEntityTree);
     void clear();
     void shutdownScriptEngine();
 
@@ -75,7 +79,12 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    // the entity scripts are spread over several engines, each running on its own thread
+    std::vector<ScriptEnginePointer> _entitiesScriptEngines;
+    QSharedPointer<EntityScriptEngineRouter> _engineRouter { new EntityScriptEngineRouter() };
+    int _numScriptEngines { 1 };
+    EntityScriptEngineRouter::Sharding _sharding { EntityScriptEngineRouter::Sharding::ByEntityID };
+    int _scriptBudget { 0 }; // ms per second for each entity script, 0 for no budget
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
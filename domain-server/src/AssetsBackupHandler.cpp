@@ -11,6 +11,7 @@
 
 #include "AssetsBackupHandler.h"
 
+#include <QCryptographicHash>
 #include <QJsonDocument>
 #include <QDate>
 #include <QtCore/QLoggingCategory>
@@ -143,6 +144,22 @@ bool AssetsBackupHandler::isCorruptedBackup(const QString& backupName) {
     return it->corruptedBackup;
 }
 
+void AssetsBackupHandler::addContentToHash(QCryptographicHash& hash) {
+    if (_assetServerEnabled && _lastMappingsRefresh.time_since_epoch().count() == 0) {
+        // the mappings aren't known yet, so this can't be the same as any backup
+        hash.addData(QByteArray::number(p_high_resolution_clock::now().time_since_epoch().count()));
+        return;
+    }
+
+    // the asset files themselves are kept once for all backups, only the mappings go in each one
+    for (const auto& mapping : _currentMappings) {
+        hash.addData(mapping.first.toUtf8());
+        hash.addData("\n", 1);
+        hash.addData(mapping.second.toUtf8());
+        hash.addData("\n", 1);
+    }
+}
+
 std::pair<bool, float> AssetsBackupHandler::isAvailable(const QString& backupName) {
     const auto it = find_if(begin(_backups), end(_backups), [&](const AssetServerBackup& backup) {
         return backup.name == backupName;
@@ -394,8 +411,13 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
         return;
     }
 
+    // assets mapped to more than one path go in once
+    std::set<AssetUtils::AssetHash> consolidatedAssets;
     for (const auto& mapping : it->mappings) {
         const auto& hash = mapping.second;
+        if (!consolidatedAssets.insert(hash).second) {
+            continue;
+        }
 
         QDir assetsDir { _assetsDirectory };
         QFile file { assetsDir.filePath(hash) };
@@ -409,7 +431,9 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
             qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
             continue;
         }
-        zipFile.write(file.readAll());
+        if (!copyBackupData(file, zipFile)) {
+            qCCritical(asset_backup) << "Could not copy asset file" << file.fileName() << "to the backup";
+        }
         zipFile.close();
         if (zipFile.getZipError() != UNZ_OK) {
             qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
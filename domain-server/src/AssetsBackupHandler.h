@@ -42,6 +42,7 @@ public:
     void deleteBackup(const QString& backupName) override;
     void consolidateBackup(const QString& backupName, QuaZip& zip) override;
     bool isCorruptedBackup(const QString& backupName) override;
+    void addContentToHash(QCryptographicHash& hash) override;
 
     bool operationInProgress() { return getRecoveryStatus().first; }
 
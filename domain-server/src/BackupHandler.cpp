@@ -0,0 +1,38 @@
+//
+//  BackupHandler.cpp
+//  domain-server/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BackupHandler.h"
+
+#include <chrono>
+#include <thread>
+
+#include <QIODevice>
+
+#include <NumericalConstants.h>
+
+bool copyBackupData(QIODevice& source, QIODevice& destination) {
+    static const qint64 CHUNK_SIZE = 1024 * 1024;
+
+    auto start = std::chrono::steady_clock::now();
+    qint64 bytesCopied = 0;
+
+    while (!source.atEnd()) {
+        QByteArray chunk = source.read(CHUNK_SIZE);
+        if (chunk.isEmpty() || destination.write(chunk) != chunk.size()) {
+            return false;
+        }
+        bytesCopied += chunk.size();
+
+        // wait until the copy is back down to the rate
+        std::this_thread::sleep_until(start + std::chrono::microseconds(bytesCopied * USECS_PER_SECOND / MAX_BACKUP_BYTES_PER_SECOND));
+    }
+    return true;
+}
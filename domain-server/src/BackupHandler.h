@@ -16,6 +16,8 @@
 
 #include <QString>
 
+class QCryptographicHash;
+class QIODevice;
 class QuaZip;
 
 class BackupHandlerInterface {
@@ -34,7 +36,16 @@ public:
     virtual void deleteBackup(const QString& backupName) = 0;
     virtual void consolidateBackup(const QString& backupName, QuaZip& zip) = 0;
     virtual bool isCorruptedBackup(const QString& backupName) = 0;
+
+    // Adds what a backup created now would hold to the hash, a backup the same as the last one of its rule is skipped.
+    virtual void addContentToHash(QCryptographicHash& hash) = 0;
 };
 using BackupHandlerPointer = std::unique_ptr<BackupHandlerInterface>;
 
+// Backups are written at no more than this rate, so that they don't take the disk away from the servers.
+const qint64 MAX_BACKUP_BYTES_PER_SECOND = 32 * 1024 * 1024;
+
+// Copies what is left of one device to another, paced to MAX_BACKUP_BYTES_PER_SECOND. Returns false if either fails.
+bool copyBackupData(QIODevice& source, QIODevice& destination);
+
 #endif /* hifi_BackupHandler_h */
@@ -12,6 +12,8 @@
 #include "ContentSettingsBackupHandler.h"
 #include "DomainContentBackupManager.h"
 
+#include <QCryptographicHash>
+
 #if !defined(__clang__) && defined(__GNUC__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wsuggest-override"
@@ -34,15 +36,23 @@ ContentSettingsBackupHandler::ContentSettingsBackupHandler(DomainServerSettingsM
 
 static const QString CONTENT_SETTINGS_BACKUP_FILENAME = "content-settings.json";
 
-void ContentSettingsBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
-
+QJsonObject ContentSettingsBackupHandler::getContentSettings() {
     // grab the content settings as JSON, excluding default values and values hidden from backup
-    QJsonObject contentSettingsJSON = _settingsManager.settingsResponseObjectForType(
+    return _settingsManager.settingsResponseObjectForType(
         "", // include all settings types
         DomainServerSettingsManager::Authenticated, DomainServerSettingsManager::NoDomainSettings,
         DomainServerSettingsManager::IncludeContentSettings, DomainServerSettingsManager::NoDefaultSettings,
         DomainServerSettingsManager::ForBackup
     );
+}
+
+void ContentSettingsBackupHandler::addContentToHash(QCryptographicHash& hash) {
+    // the installed content info is left out, it changes with every backup
+    hash.addData(QJsonDocument(getContentSettings()).toJson(QJsonDocument::Compact));
+}
+
+void ContentSettingsBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
+    QJsonObject contentSettingsJSON = getContentSettings();
     QString prefixFormat = "(" + QRegExp::escape(AUTOMATIC_BACKUP_PREFIX) + "|" + QRegExp::escape(MANUAL_BACKUP_PREFIX) + ")";
     QString nameFormat = "(.+)";
     QString dateTimeFormat = "(" + DATETIME_FORMAT_RE + ")";
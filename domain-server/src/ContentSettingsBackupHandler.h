@@ -36,7 +36,11 @@ public:
 
     bool isCorruptedBackup(const QString& backupName) override { return false; }
 
+    void addContentToHash(QCryptographicHash& hash) override;
+
 private:
+    QJsonObject getContentSettings();
+
     DomainServerSettingsManager& _settingsManager;
 };
 
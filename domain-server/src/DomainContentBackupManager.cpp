@@ -20,6 +20,7 @@
 #include <time.h>
 
 #include <QBuffer>
+#include <QCryptographicHash>
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
@@ -31,6 +32,11 @@
 
 #include <quazip5/quazip.h>
 
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <PathUtils.h>
@@ -45,6 +51,9 @@ static const QString DATETIME_FORMAT { "yyyy-MM-dd_HH-mm-ss" };
 static const QString PRE_UPLOAD_SUFFIX{ "pre_upload" };
 static const QString MANUAL_BACKUP_NAME_RE { "[a-zA-Z0-9\\-_ ]+" };
 
+// the archive comment holds the hash of the content, so a rule can tell whether anything changed since its last backup
+static const QString CONTENT_HASH_COMMENT_PREFIX { "content-hash:" };
+
 void DomainContentBackupManager::addBackupHandler(BackupHandlerPointer handler) {
     _backupHandlers.push_back(std::move(handler));
 }
@@ -126,7 +135,22 @@ int64_t DomainContentBackupManager::getMostRecentBackupTimeInSecs(const QString&
     return mostRecentBackupInSecs;
 }
 
+static void lowerBackupIOPriority() {
+#ifdef Q_OS_LINUX
+    // the lowest level of the best effort class, for this thread only, so the servers' own disk access goes first
+    const int IOPRIO_WHO_PROCESS = 1;
+    const int IOPRIO_CLASS_BE = 2;
+    const int IOPRIO_CLASS_SHIFT = 13;
+    const int IOPRIO_LOWEST_LEVEL = 7;
+    if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, (IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | IOPRIO_LOWEST_LEVEL) != 0) {
+        qCDebug(domain_server) << "Could not lower the I/O priority of the backup thread";
+    }
+#endif
+}
+
 void DomainContentBackupManager::setup() {
+    lowerBackupIOPriority();
+
     for (auto& rule : _backupRules) {
         removeOldBackupVersions(rule);
     }
@@ -559,6 +583,18 @@ void DomainContentBackupManager::backup() {
 
         if (secondsSinceLastBackup > rule.intervalSeconds) {
 
+            // the rule's last backup still holds the content if nothing changed since
+            QString lastBackupPath;
+            QDateTime lastBackupTime;
+            if (getMostRecentBackup(rule.extensionFormat, lastBackupPath, lastBackupTime)) {
+                auto lastContentHash = getBackupContentHash(lastBackupPath);
+                if (!lastContentHash.isEmpty() && lastContentHash == getContentHash()) {
+                    qCDebug(domain_server) << "Content unchanged since the last" << rule.name << "backup, skipping it";
+                    rule.lastBackupSeconds = nowSeconds;
+                    continue;
+                }
+            }
+
             bool success;
             QString path;
             std::tie(success, path) =  createBackup(AUTOMATIC_BACKUP_PREFIX, rule.extensionFormat);
@@ -731,11 +767,39 @@ std::pair<bool, QString> DomainContentBackupManager::createBackup(const QString&
         return { false, path };
     }
 
+    // hashed first, content that changes while it is being backed up only makes the next backup go ahead
+    auto contentHash = getContentHash();
+
     for (auto& handler : _backupHandlers) {
         handler->createBackup(fileName, zip);
     }
 
+    zip.setComment(CONTENT_HASH_COMMENT_PREFIX + contentHash.toHex());
     zip.close();
 
     return { true, path };
 }
+
+QByteArray DomainContentBackupManager::getContentHash() {
+    QCryptographicHash hash { QCryptographicHash::Sha256 };
+    for (auto& handler : _backupHandlers) {
+        handler->addContentToHash(hash);
+    }
+    return hash.result();
+}
+
+QByteArray DomainContentBackupManager::getBackupContentHash(const QString& backupPath) {
+    QuaZip zip { backupPath };
+    if (!zip.open(QuaZip::mdUnzip)) {
+        return QByteArray();
+    }
+
+    auto comment = zip.getComment();
+    zip.close();
+
+    if (!comment.startsWith(CONTENT_HASH_COMMENT_PREFIX)) {
+        // backups from before content hashes are always replaced
+        return QByteArray();
+    }
+    return QByteArray::fromHex(comment.mid(CONTENT_HASH_COMMENT_PREFIX.length()).toLatin1());
+}
@@ -119,6 +119,10 @@ protected:
 
     std::pair<bool, QString> createBackup(const QString& prefix, const QString& name);
 
+    // a hash of what a backup created now would hold, from all the handlers
+    QByteArray getContentHash();
+    QByteArray getBackupContentHash(const QString& backupPath);
+
     bool recoverFromBackupZip(const QString& backupName, QuaZip& backupZip, const QString& username, const QString& sourceFilename, bool rollingBack = false);
 
 private slots:
@@ -12,26 +12,38 @@
 
 #include "DomainGatekeeper.h"
 
-#include <openssl/err.h>
-#include <openssl/rsa.h>
-#include <openssl/x509.h>
+#include <algorithm>
 #include <random>
 
 #include <QtCore/QDataStream>
 #include <QtCore/QMetaMethod>
+#include <QtCore/QThread>
 
 #include <AccountManager.h>
 #include <Assignment.h>
+#include <SharedUtil.h>
 
 #include "DomainServer.h"
 #include "DomainServerNodeData.h"
 
 using SharedAssignmentPointer = QSharedPointer<Assignment>;
 
+// a crowd connecting at once asks for many keys, only this many are asked of the metaverse at a time
+static const int MAX_IN_FLIGHT_PUBLIC_KEY_REQUESTS = 8;
+// a key fetched this recently isn't fetched again for a user that is about to sign with it
+static const quint64 PUBLIC_KEY_TTL_USECS = 5 * 60 * USECS_PER_SECOND;
+// the checks and connect attempts no one came back for
+static const quint64 SIGNATURE_VERIFICATION_TIMEOUT_USECS = 30 * USECS_PER_SECOND;
+static const quint64 CONNECT_ATTEMPT_TIMEOUT_USECS = 60 * USECS_PER_SECOND;
+static const size_t MAX_CONNECT_LATENCY_SAMPLES = 1000;
+
 DomainGatekeeper::DomainGatekeeper(DomainServer* server) :
     _server(server)
 {
     initLocalIDManagement();
+
+    // leave a core to the main thread, the signature checks are there to keep it free
+    _signatureVerifierPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
 }
 
 void DomainGatekeeper::addPendingAssignedNode(const QUuid& nodeUUID, const QUuid& assignmentUUID,
@@ -94,6 +106,15 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
     if (pendingAssignment != _pendingAssignedNodes.end()) {
         node = processAssignmentConnectRequest(nodeConnection, pendingAssignment->second);
     } else if (!STATICALLY_ASSIGNED_NODES.contains(nodeConnection.nodeType)) {
+        // time how long the agent takes to get in, from the first time it asks
+        if (!_connectStartTimes.contains(message->getSenderSockAddr())) {
+            quint64 now = usecTimestampNow();
+            for (auto it = _connectStartTimes.begin(); it != _connectStartTimes.end();) {
+                it = now - it.value() > CONNECT_ATTEMPT_TIMEOUT_USECS ? _connectStartTimes.erase(it) : std::next(it);
+            }
+            _connectStartTimes.insert(message->getSenderSockAddr(), now);
+        }
+
         QByteArray usernameSignature;
 
         QString domainUsername;
@@ -151,9 +172,15 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
             << "previous connection uptime" << nodeConnection.previousConnectionUpTime/USECS_PER_MSEC << "msec"
             << "sysinfo" << nodeConnection.SystemInfo;
 
+        recordConnectLatency(message->getSenderSockAddr());
+
         // signal that we just connected a node so the DomainServer can get it a list
         // and broadcast its presence right away
         emit connectedNode(node, message->getFirstPacketReceiveTime());
+    } else if (!username.isEmpty() && _signatureVerifications.contains(username.toLower())
+               && !_signatureVerifications[username.toLower()].isFinished) {
+        // hold on to the request while the signature is checked, it is processed again once it has been
+        _signatureVerifications[username.toLower()].connectRequest = message;
     } else {
         qDebug() << "Refusing connection from node at" << message->getSenderSockAddr()
             << "with hardware address" << nodeConnection.hardwareAddress
@@ -379,6 +406,7 @@ void DomainGatekeeper::updateNodePermissions() {
         }
 
         node->setPermissions(userPerms);
+        _server->markNodeListChanged(node);
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
             qDebug() << "node" << node->getUUID() << "no longer has permission to connect.";
@@ -496,18 +524,24 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
             if (!domainHasLogin() || domainUsername.isEmpty()) {
                 return SharedNodePointer();
             }
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
-            // they sent us a username and the signature verifies it
-            getGroupMemberships(username);
-            verifiedUsername = username.toLower();
         } else {
-            // they sent us a username, but it didn't check out
-            requestUserPublicKey(username);
+            auto signatureCheck = verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr);
+            if (signatureCheck == SignatureCheck::Verified) {
+                // they sent us a username and the signature verifies it
+                getGroupMemberships(username);
+                verifiedUsername = username.toLower();
+            } else if (signatureCheck == SignatureCheck::Pending) {
+                // the signature is being checked, hold off on the login until it has been
+                return SharedNodePointer();
+            } else {
+                // they sent us a username, but it didn't check out
+                requestUserPublicKey(username);
 #ifdef WANT_DEBUG
-            qDebug() << "stalling login because signature verification failed:" << username;
+                qDebug() << "stalling login because signature verification failed:" << username;
 #endif
-            if (!domainHasLogin() || domainUsername.isEmpty()) {
-                return SharedNodePointer();
+                if (!domainHasLogin() || domainUsername.isEmpty()) {
+                    return SharedNodePointer();
+                }
             }
         }
     }
@@ -688,62 +722,49 @@ void DomainGatekeeper::cleanupICEPeerForNode(const QUuid& nodeID) {
     }
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const HifiSockAddr& senderSockAddr) {
+DomainGatekeeper::SignatureCheck DomainGatekeeper::verifyUserSignature(const QString& username,
+                                                                       const QByteArray& usernameSignature,
+                                                                       const HifiSockAddr& senderSockAddr) {
     // it's possible this user can be allowed to connect, but we need to check their username signature
     auto lowerUsername = username.toLower();
-    KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
-
-    QByteArray publicKeyArray = publicKeyPair.first;
-    bool isOptimisticKey = publicKeyPair.second;
+    UserPublicKey publicKey = _userPublicKeys.value(lowerUsername);
 
     const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
-    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
+    if (!publicKey.key.isEmpty() && !connectionToken.isNull()) {
         // if we do have a public key for the user, check for a signature match
+        auto verification = _signatureVerifications.find(lowerUsername);
+        if (verification == _signatureVerifications.end() || verification->publicKey != publicKey.key
+            || verification->connectionToken != connectionToken || verification->usernameSignature != usernameSignature) {
+            // the check is done on a worker so that a crowd connecting doesn't hold up the main thread
+            startSignatureVerification(lowerUsername, publicKey.key, connectionToken, usernameSignature);
+            return SignatureCheck::Pending;
+        } else if (!verification->isFinished) {
+            return SignatureCheck::Pending;
+        }
 
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
-
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
-
-        QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
-        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
-                                                                QCryptographicHash::Sha256);
-
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
+        auto result = verification->result;
+        _signatureVerifications.erase(verification);
 
-            if (decryptResult == 1) {
-                qDebug() << "Username signature matches for" << username;
+        if (result == UsernameSignatureVerifier::Match) {
+            qDebug() << "Username signature matches for" << username;
 
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
-                _connectionTokenHash.remove(username);
+            // remove connection token before we return
+            _connectionTokenHash.remove(username);
 
-                return true;
+            return SignatureCheck::Verified;
 
-            } else {
-                // we only send back a LoginErrorMetaverse if this wasn't an "optimistic" key
-                // (a key that we hoped would work but is probably stale)
-
-                if (!senderSockAddr.isNull() && !isOptimisticKey) {
-                    qDebug() << "Error decrypting metaverse username signature for" << username << "- denying connection.";
-                    sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
-                        DomainHandler::ConnectionRefusedReason::LoginErrorMetaverse);
-                } else if (!senderSockAddr.isNull()) {
-                    qDebug() << "Error decrypting metaverse username signature for" << username << "with optimistic key -"
-                        << "re-requesting public key and delaying connection";
-                }
+        } else if (result == UsernameSignatureVerifier::Mismatch) {
+            // we only send back a LoginErrorMetaverse if this wasn't an "optimistic" key
+            // (a key that we hoped would work but is probably stale)
 
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
+            if (!senderSockAddr.isNull() && !publicKey.isOptimistic) {
+                qDebug() << "Error decrypting metaverse username signature for" << username << "- denying connection.";
+                sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
+                    DomainHandler::ConnectionRefusedReason::LoginErrorMetaverse);
+            } else if (!senderSockAddr.isNull()) {
+                qDebug() << "Error decrypting metaverse username signature for" << username << "with optimistic key -"
+                    << "re-requesting public key and delaying connection";
             }
 
         } else {
@@ -762,7 +783,47 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
     }
 
     requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
+    return SignatureCheck::Failed;
+}
+
+void DomainGatekeeper::startSignatureVerification(const QString& lowerUsername, const QByteArray& publicKey,
+                                                  const QUuid& connectionToken, const QByteArray& usernameSignature) {
+    quint64 now = usecTimestampNow();
+
+    // forget the checks of the users that gave up on connecting
+    for (auto it = _signatureVerifications.begin(); it != _signatureVerifications.end();) {
+        it = now - it->startTime > SIGNATURE_VERIFICATION_TIMEOUT_USECS ? _signatureVerifications.erase(it) : std::next(it);
+    }
+
+    SignatureVerification& verification = _signatureVerifications[lowerUsername];
+    verification = SignatureVerification();
+    verification.publicKey = publicKey;
+    verification.connectionToken = connectionToken;
+    verification.usernameSignature = usernameSignature;
+    verification.startTime = now;
+
+    auto verifier = new UsernameSignatureVerifier(lowerUsername, publicKey, connectionToken, usernameSignature);
+    connect(verifier, &UsernameSignatureVerifier::finished, this, &DomainGatekeeper::handleVerifiedSignature);
+    _signatureVerifierPool.start(verifier);
+}
+
+void DomainGatekeeper::handleVerifiedSignature(QString lowerUsername, QByteArray publicKey, QUuid connectionToken,
+                                               QByteArray usernameSignature, UsernameSignatureVerifier::Result result) {
+    auto verification = _signatureVerifications.find(lowerUsername);
+    if (verification == _signatureVerifications.end() || verification->isFinished || verification->publicKey != publicKey
+        || verification->connectionToken != connectionToken || verification->usernameSignature != usernameSignature) {
+        // this check was superseded by a newer one
+        return;
+    }
+
+    verification->isFinished = true;
+    verification->result = result;
+
+    auto connectRequest = verification->connectRequest;
+    verification->connectRequest.reset();
+    if (connectRequest) {
+        processConnectRequestPacket(connectRequest);
+    }
 }
 
 
@@ -815,7 +876,35 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOpti
         // public-key request for this username is already flight, not rerequesting
         return;
     }
-    _inFlightPublicKeyRequests.insert(lowerUsername, isOptimistic);
+
+    if (isOptimistic) {
+        auto publicKey = _userPublicKeys.find(lowerUsername);
+        if (publicKey != _userPublicKeys.end() && usecTimestampNow() - publicKey->fetchTime < PUBLIC_KEY_TTL_USECS) {
+            // the key is recent enough to try, but the user may have just uploaded a new one
+            // so a signature that doesn't match it isn't reason enough to deny them
+            publicKey->isOptimistic = true;
+            return;
+        }
+    }
+
+    if (_inFlightPublicKeyRequests.size() >= MAX_IN_FLIGHT_PUBLIC_KEY_REQUESTS) {
+        auto queued = std::find_if(_queuedPublicKeyRequests.begin(), _queuedPublicKeyRequests.end(),
+                                   [&](const QPair<QString, bool>& request) {
+            return request.first.toLower() == lowerUsername;
+        });
+        if (queued == _queuedPublicKeyRequests.end()) {
+            _queuedPublicKeyRequests.append({ username, isOptimistic });
+        } else {
+            queued->second = queued->second && isOptimistic;
+        }
+        return;
+    }
+
+    sendPublicKeyRequest(username, isOptimistic);
+}
+
+void DomainGatekeeper::sendPublicKeyRequest(const QString& username, bool isOptimistic) {
+    _inFlightPublicKeyRequests.insert(username.toLower(), isOptimistic);
 
     // even if we have a public key for them right now, request a new one in case it has just changed
     JSONCallbackParameters callbackParams;
@@ -833,6 +922,15 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOpti
                                               QNetworkAccessManager::GetOperation, callbackParams);
 }
 
+void DomainGatekeeper::sendQueuedPublicKeyRequests() {
+    while (!_queuedPublicKeyRequests.isEmpty() && _inFlightPublicKeyRequests.size() < MAX_IN_FLIGHT_PUBLIC_KEY_REQUESTS) {
+        auto request = _queuedPublicKeyRequests.takeFirst();
+        if (!_inFlightPublicKeyRequests.contains(request.first.toLower())) {
+            sendPublicKeyRequest(request.first, request.second);
+        }
+    }
+}
+
 QString extractUsernameFromPublicKeyRequest(QNetworkReply* requestReply) {
     // extract the username from the request url
     QString username;
@@ -860,15 +958,66 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply* requestReply) {
         _userPublicKeys[username.toLower()] =
             {
                 QByteArray::fromBase64(jsonObject[JSON_DATA_KEY].toObject()[JSON_PUBLIC_KEY_KEY].toString().toUtf8()),
-                isOptimisticKey
+                isOptimisticKey,
+                usecTimestampNow()
             };
     }
+
+    sendQueuedPublicKeyRequests();
 }
 
 void DomainGatekeeper::publicKeyJSONErrorCallback(QNetworkReply* requestReply) {
     qDebug() << "publicKey api call failed:" << requestReply->error();
     QString username = extractUsernameFromPublicKeyRequest(requestReply);
     _inFlightPublicKeyRequests.remove(username);
+
+    sendQueuedPublicKeyRequests();
+}
+
+void DomainGatekeeper::recordConnectLatency(const HifiSockAddr& senderSockAddr) {
+    auto startTime = _connectStartTimes.find(senderSockAddr);
+    if (startTime == _connectStartTimes.end()) {
+        return;
+    }
+
+    quint64 latency = usecTimestampNow() - startTime.value();
+    _connectStartTimes.erase(startTime);
+
+    if (_connectLatencies.size() < MAX_CONNECT_LATENCY_SAMPLES) {
+        _connectLatencies.push_back(latency);
+    } else {
+        _connectLatencies[_nextConnectLatency] = latency;
+    }
+    _nextConnectLatency = (_nextConnectLatency + 1) % MAX_CONNECT_LATENCY_SAMPLES;
+}
+
+QJsonObject DomainGatekeeper::getAdmissionStats() const {
+    QJsonObject stats;
+    stats["connecting"] = _connectStartTimes.size();
+    stats["public_key_requests_in_flight"] = _inFlightPublicKeyRequests.size();
+    stats["public_key_requests_queued"] = _queuedPublicKeyRequests.size();
+    stats["cached_public_keys"] = _userPublicKeys.size();
+    stats["signature_checks"] = (int)std::count_if(_signatureVerifications.cbegin(), _signatureVerifications.cend(),
+                                                   [](const SignatureVerification& verification) {
+        return !verification.isFinished;
+    });
+
+    QJsonObject latencyStats;
+    latencyStats["samples"] = (int)_connectLatencies.size();
+    if (!_connectLatencies.empty()) {
+        auto latencies = _connectLatencies;
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](size_t percent) {
+            return (double)latencies[std::min(latencies.size() * percent / 100, latencies.size() - 1)] / USECS_PER_MSEC;
+        };
+        latencyStats["p50"] = percentile(50);
+        latencyStats["p90"] = percentile(90);
+        latencyStats["p99"] = percentile(99);
+        latencyStats["max"] = (double)latencies.back() / USECS_PER_MSEC;
+    }
+    stats["connect_latency_msecs"] = latencyStats;
+
+    return stats;
 }
 
 void DomainGatekeeper::sendProtocolMismatchConnectionDenial(const HifiSockAddr& senderSockAddr) {
@@ -1199,13 +1348,14 @@ Node::LocalID DomainGatekeeper::findOrCreateLocalID(const QUuid& uuid) {
         return existingLocalIDIt->second;
     }
 
-    assert(_localIDs.size() < (size_t)(std::numeric_limits<LocalIDs::value_type>::max() - 2));
+    assert(_localIDs.size() < (size_t)(Node::MIN_HOSTED_LOCAL_ID - 2));
 
     Node::LocalID newLocalID;
     do {
         newLocalID = _currentLocalID;
         _currentLocalID += _idIncrement;
-    } while (newLocalID == Node::NULL_LOCAL_ID || _localIDs.find(newLocalID) != _localIDs.end());
+    } while (newLocalID == Node::NULL_LOCAL_ID || newLocalID >= Node::MIN_HOSTED_LOCAL_ID
+             || _localIDs.find(newLocalID) != _localIDs.end());
 
     _uuidToLocalID.emplace(uuid, newLocalID);
     _localIDs.insert(newLocalID);
@@ -17,8 +17,11 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
+#include <QtCore/QThreadPool>
 #include <QtNetwork/QNetworkReply>
 
 #include <DomainHandler.h>
@@ -29,6 +32,7 @@
 
 #include "NodeConnectionData.h"
 #include "PendingAssignedNodeData.h"
+#include "UsernameSignatureVerifier.h"
 
 const QString DOMAIN_GROUP_CHAR = "@";
 
@@ -48,6 +52,10 @@ public:
     Node::LocalID findOrCreateLocalID(const QUuid& uuid);
 
     static void sendProtocolMismatchConnectionDenial(const HifiSockAddr& senderSockAddr);
+
+    // the users waiting to connect, the public key requests and signature checks they wait on,
+    // and the time it took the users that did connect to do so
+    QJsonObject getAdmissionStats() const;
 public slots:
     void processConnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEPingPacket(QSharedPointer<ReceivedMessage> message);
@@ -75,6 +83,9 @@ public slots:
 private slots:
     void handlePeerPingTimeout();
 
+    void handleVerifiedSignature(QString lowerUsername, QByteArray publicKey, QUuid connectionToken,
+                                 QByteArray usernameSignature, UsernameSignatureVerifier::Result result);
+
     // Login and groups for domain, separate from metaverse.
     void requestDomainUserFinished();
 
@@ -89,8 +100,15 @@ private:
                                                  const QString& domainRefreshToken);
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection);
     
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const HifiSockAddr& senderSockAddr);
+    enum class SignatureCheck {
+        Verified,
+        Failed,
+        Pending // being checked on a worker, the connect request is processed again once it has been
+    };
+    SignatureCheck verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
+                                       const HifiSockAddr& senderSockAddr);
+    void startSignatureVerification(const QString& lowerUsername, const QByteArray& publicKey, const QUuid& connectionToken,
+                                    const QByteArray& usernameSignature);
     
     bool needToVerifyDomainUserIdentity(const QString& username, const QString& accessToken, const QString& refreshToken);
     bool verifyDomainUserIdentity(const QString& username, const QString& accessToken, const QString& refreshToken,
@@ -109,6 +127,10 @@ private:
     void pingPunchForConnectingPeer(const SharedNetworkPeer& peer);
     
     void requestUserPublicKey(const QString& username, bool isOptimistic = false);
+    void sendPublicKeyRequest(const QString& username, bool isOptimistic);
+    void sendQueuedPublicKeyRequests();
+
+    void recordConnectLatency(const HifiSockAddr& senderSockAddr);
     
     DomainServer* _server;
     
@@ -128,10 +150,31 @@ private:
     // we don't send back user signature decryption errors for those keys so that there isn't a thrasing of key re-generation
     // and connection refusal
 
-    using KeyFlagPair = QPair<QByteArray, bool>;
+    struct UserPublicKey {
+        QByteArray key;
+        bool isOptimistic { false };
+        quint64 fetchTime { 0 };
+    };
 
-    QHash<QString, KeyFlagPair> _userPublicKeys; // keep track of keys and flag them as optimistic or not
+    QHash<QString, UserPublicKey> _userPublicKeys; // keep track of keys and flag them as optimistic or not
     QHash<QString, bool> _inFlightPublicKeyRequests; // keep track of keys we've asked for (and if it was optimistic)
+    // the key requests waiting for others to return, so that a crowd connecting doesn't flood the metaverse
+    QList<QPair<QString, bool>> _queuedPublicKeyRequests;
+
+    struct SignatureVerification {
+        QByteArray publicKey;
+        QUuid connectionToken;
+        QByteArray usernameSignature;
+        quint64 startTime { 0 };
+        bool isFinished { false };
+        UsernameSignatureVerifier::Result result { UsernameSignatureVerifier::Mismatch };
+        QSharedPointer<ReceivedMessage> connectRequest; // the latest connect request waiting on the check
+    };
+    QHash<QString, SignatureVerification> _signatureVerifications;
+
+    QHash<HifiSockAddr, quint64> _connectStartTimes; // when the agents still connecting first asked to
+    std::vector<quint64> _connectLatencies; // the most recent, in usecs
+    size_t _nextConnectLatency { 0 };
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
 
@@ -161,6 +204,9 @@ private:
     DomainUserIdentities _verifiedDomainUserIdentities;  // Verified domain users.
 
     QHash<QString, QStringList> _domainGroupMemberships;  // <domainUserName, [domainGroupName]>
+
+    // last, so that it is done with its verifiers before the rest goes away
+    QThreadPool _signatureVerifierPool;
 };
 
 
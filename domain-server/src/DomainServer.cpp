@@ -178,9 +178,6 @@ DomainServer::DomainServer(int argc, char* argv[]) :
 
     LogUtils::init();
 
-    LogHandler::getInstance().moveToThread(thread());
-    LogHandler::getInstance().setupRepeatedMessageFlusher();
-
     qDebug() << "Setting up domain-server";
     qDebug() << "[VERSION] Build sequence:" << qPrintable(applicationVersion());
     qDebug() << "[VERSION] MODIFIED_ORGANIZATION:" << BuildInfo::MODIFIED_ORGANIZATION;
@@ -330,7 +327,7 @@ DomainServer::DomainServer(int argc, char* argv[]) :
         _contentManager->addBackupHandler(BackupHandlerPointer(new ContentSettingsBackupHandler(_settingsManager)));
     });
 
-    _contentManager->initialize(true);
+    _contentManager->initialize(true, QThread::LowPriority);
 
     connect(_contentManager.get(), &DomainContentBackupManager::recoveryCompleted, this, &DomainServer::restart);
 
@@ -791,6 +788,8 @@ void DomainServer::setupNodeListAndAssignments() {
         PacketReceiver::makeUnsourcedListenerReference<DomainServer>(this, &DomainServer::processPathQueryPacket));
     packetReceiver.registerListener(PacketType::NodeJsonStats,
         PacketReceiver::makeSourcedListenerReference<DomainServer>(this, &DomainServer::processNodeJSONStatsPacket));
+    packetReceiver.registerListener(PacketType::NodeMetrics,
+        PacketReceiver::makeSourcedListenerReference<DomainServer>(this, &DomainServer::processNodeMetricsPacket));
     packetReceiver.registerListener(PacketType::DomainDisconnectRequest,
         PacketReceiver::makeUnsourcedListenerReference<DomainServer>(this, &DomainServer::processNodeDisconnectRequestPacket));
     packetReceiver.registerListener(PacketType::AvatarZonePresence,
@@ -1115,9 +1114,17 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
+    // the version of the domain list the node last heard all of
+    quint64 lastListVersion = 0;
+    packetStream >> lastListVersion;
+
     // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+        || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        markNodeListChanged(sendingNode);
+    }
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
@@ -1134,8 +1141,12 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
-    // update the NodeInterestSet in case there have been any changes
-    nodeData->setNodeInterestSet(safeInterestSet);
+    // update the NodeInterestSet in case there have been any changes,
+    // the nodes it didn't have before aren't in the changes since the last list so they need the full list
+    if (safeInterestSet != nodeData->getNodeInterestSet()) {
+        nodeData->setNodeInterestSet(safeInterestSet);
+        lastListVersion = 0;
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
@@ -1143,7 +1154,7 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false, lastListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1221,14 +1232,32 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
+    // the nodes that have already heard about this node heard about it before it had its permissions
+    markNodeListChanged(newNode);
+
     // send out this node to our other connected nodes
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr, bool newConnection) {
+// the most removed nodes a domain list carries, in the header of each of its packets
+static const size_t MAX_DOMAIN_LIST_REMOVED_NODES = 32;
+
+void DomainServer::markNodeListChanged(const SharedNodePointer& node) {
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (nodeData) {
+        nodeData->setListVersion(++_domainListVersion);
+    }
+}
+
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr,
+                                        bool newConnection, quint64 lastListVersion) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
+    // send only what changed since the last version the node heard all of, unless we no longer know what that is
+    bool isDelta = !newConnection && lastListVersion > 0
+        && lastListVersion >= _oldestListDeltaVersion && lastListVersion <= _domainListVersion;
+
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
@@ -1236,6 +1265,36 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
+    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
+    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+
+    std::vector<SharedNodePointer> listedNodes;
+    if (nodeInterestSet.size() > 0) {
+
+        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+        if (nodeData->isAuthenticated()) {
+            // if this authenticated node has any interest types, send back those nodes as well
+            limitedNodeList->eachNode([this, node, isDelta, lastListVersion, &listedNodes](const SharedNodePointer& otherNode) {
+                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                    auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+                    if (!isDelta || (otherNodeData && otherNodeData->getListVersion() > lastListVersion)) {
+                        listedNodes.push_back(otherNode);
+                    }
+                }
+            });
+        }
+    }
+
+    // the full list doesn't remove nodes, they're removed by DomainServerRemovedNode or by going silent
+    QList<QUuid> removedNodes;
+    if (isDelta) {
+        for (const auto& removedNode : _removedListNodes) {
+            if (removedNode.first > lastListVersion) {
+                removedNodes.append(removedNode.second);
+            }
+        }
+    }
+
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
     extendedHeaderStream << node->getUUID();
@@ -1246,35 +1305,28 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+    // the packets of the list can arrive in any order, each of them says which version it is and how many nodes
+    // the whole list has so the node knows once it has heard all of it
+    extendedHeaderStream << _domainListVersion;
+    extendedHeaderStream << (quint32)listedNodes.size();
+    extendedHeaderStream << removedNodes;
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
-
-    if (nodeInterestSet.size() > 0) {
-
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+    for (const auto& otherNode : listedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -1928,6 +1980,19 @@ void DomainServer::processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> pa
     }
 }
 
+void DomainServer::processNodeMetricsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
+    auto nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
+    if (nodeData) {
+        QDataStream metricsStream(packetList->getMessage());
+        NodeMetrics metrics;
+        metricsStream >> metrics;
+
+        if (metricsStream.status() == QDataStream::Ok) {
+            nodeData->setMetrics(metrics);
+        }
+    }
+}
+
 QJsonObject DomainServer::jsonForSocket(const HifiSockAddr& socket) {
     QJsonObject socketJSON;
 
@@ -2192,6 +2257,12 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             connection->respond(HTTPConnection::StatusCode200, assignmentDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
             // we've processed this request
+            return true;
+        } else if (url.path() == "/admission.json") {
+            // the users waiting to get in and how long it has been taking them
+            QJsonDocument admissionDocument(_gatekeeper.getAdmissionStats());
+            connection->respond(HTTPConnection::StatusCode200, admissionDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+
             return true;
         } else if (url.path() == "/transactions.json") {
             // enumerate our pending transactions and display them in an array
@@ -3213,7 +3284,10 @@ void DomainServer::updateReplicatedNodes() {
                 qDebug() << "Setting node to replicated:"
                     << otherNode->getPermissions().getVerifiedUserName() << otherNode->getUUID();
             }
-            otherNode->setIsReplicated(shouldReplicate);
+            if (isReplicated != shouldReplicate) {
+                otherNode->setIsReplicated(shouldReplicate);
+                markNodeListChanged(otherNode);
+            }
         }
     );
 }
@@ -3240,12 +3314,20 @@ bool DomainServer::isAssetServerEnabled() {
 void DomainServer::nodeAdded(SharedNodePointer node) {
     // we don't use updateNodeWithData, so add the DomainServerNodeData to the node here
     node->setLinkedData(std::unique_ptr<DomainServerNodeData> { new DomainServerNodeData() });
+    markNodeListChanged(node);
 }
 
 void DomainServer::nodeKilled(SharedNodePointer node) {
     // if this peer connected via ICE then remove them from our ICE peers hash
     _gatekeeper.cleanupICEPeerForNode(node->getUUID());
 
+    // the nodes that check in next hear about the removal in their list, in case they missed DomainServerRemovedNode
+    _removedListNodes.emplace_back(++_domainListVersion, node->getUUID());
+    if (_removedListNodes.size() > MAX_DOMAIN_LIST_REMOVED_NODES) {
+        _oldestListDeltaVersion = _removedListNodes.front().first;
+        _removedListNodes.pop_front();
+    }
+
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
 
     if (nodeData) {
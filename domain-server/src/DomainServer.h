@@ -13,6 +13,8 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
@@ -97,6 +99,7 @@ private slots:
     void processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> packet);
     void processListRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
+    void processNodeMetricsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
     void processPathQueryPacket(QSharedPointer<ReceivedMessage> packet);
     void processNodeDisconnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEServerHeartbeatDenialPacket(QSharedPointer<ReceivedMessage> message);
@@ -186,7 +189,10 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr,
+                              bool newConnection, quint64 lastListVersion = 0);
+    // ends the current version of the domain list, the nodes that check in next will hear about the node's change
+    void markNodeListChanged(const SharedNodePointer& node);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -241,6 +247,12 @@ private:
     std::vector<QString> _replicatedUsernames;
 
     DomainGatekeeper _gatekeeper;
+
+    quint64 _domainListVersion { 0 };
+    // the nodes removed from the domain list along with the version they were removed in,
+    // nodes that last saw a version older than the oldest delta can only be sent the full list
+    std::deque<std::pair<quint64, QUuid>> _removedListNodes;
+    quint64 _oldestListDeltaVersion { 0 };
     DomainServerExporter _exporter;
 
     HTTPManager _httpManager;
@@ -25,6 +25,9 @@
 #include <QJsonDocument>
 #include <QRegularExpression>
 #include <QSet>
+#include <QUrlQuery>
+
+#include <vector>
 
 #include "DomainServerExporter.h"
 #include "DependencyManager.h"
@@ -299,7 +302,12 @@ bool DomainServerExporter::handleHTTPRequest(HTTPConnection* connection, const Q
         QString output = "";
         QTextStream outStream(&output);
 
-        nodeList->eachNode([this, &outStream](const SharedNodePointer& node) { generateMetricsForNode(outStream, node); });
+        generateNodeMetrics(outStream);
+
+        // the metrics converted from the JSON stats cost a lot more to generate, scrapers can go without them with ?json=0
+        if (QUrlQuery(url).queryItemValue("json") != "0") {
+            nodeList->eachNode([this, &outStream](const SharedNodePointer& node) { generateMetricsForNode(outStream, node); });
+        }
 
         connection->respond(HTTPConnection::StatusCode200, output.toUtf8(), qPrintable(EXPORTER_MIME_TYPE));
         return true;
@@ -309,39 +317,116 @@ bool DomainServerExporter::handleHTTPRequest(HTTPConnection* connection, const Q
 }
 
 QString DomainServerExporter::escapeName(const QString& name) {
-    QRegularExpression invalidCharacters("[^A-Za-z0-9_]");
+    // compiled once, this runs for every key of every node's stats on every scrape
+    static const QRegularExpression NUMBERED_PREFIX("^\\d+\\. ");
+    static const QRegularExpression NUMBERED_UNDERSCORE_PREFIX("^\\d+_");
+    static const QRegularExpression Z_PREFIX("^z_");
+    static const QRegularExpression PERCENT("%");
+    static const QRegularExpression MIXED_CASE("([a-z])([A-Z])");
+    static const QRegularExpression INVALID_CHARACTERS("[^A-Za-z0-9_]");
+    static const QRegularExpression LEADING_UNDERSCORES("^_+");
+    static const QRegularExpression TRAILING_UNDERSCORES("_+$");
+    static const QRegularExpression UNDERSCORES("_+");
 
     QString result = name;
 
     // If a key is named something like: "6. threads", turn it into just "threads"
-    result.replace(QRegularExpression("^\\d+\\. "), "");
-    result.replace(QRegularExpression("^\\d+_"), "");
+    result.replace(NUMBERED_PREFIX, "");
+    result.replace(NUMBERED_UNDERSCORE_PREFIX, "");
 
     // If a key is named something like "z_listeners", turn it into just "listeners"
-    result.replace(QRegularExpression("^z_"), "");
+    result.replace(Z_PREFIX, "");
 
     // If a key is named something like "lost%", change it to "lost_percent_".
     // redundant underscores will be removed below.
-    result.replace(QRegularExpression("%"), "_percent_");
+    result.replace(PERCENT, "_percent_");
 
     // change mixedCaseNames to mixed_case_names
-    result.replace(QRegularExpression("([a-z])([A-Z])"), "\\1_\\2");
+    result.replace(MIXED_CASE, "\\1_\\2");
 
     // Replace all invalid characters with a _
-    result.replace(invalidCharacters, "_");
+    result.replace(INVALID_CHARACTERS, "_");
 
     // Remove any "_" characters at the beginning or end
-    result.replace(QRegularExpression("^_+"), "");
-    result.replace(QRegularExpression("_+$"), "");
+    result.replace(LEADING_UNDERSCORES, "");
+    result.replace(TRAILING_UNDERSCORES, "");
 
     // Replace any duplicated _ characters with a single one
-    result.replace(QRegularExpression("_+"), "_");
+    result.replace(UNDERSCORES, "_");
 
     result = result.toLower();
 
     return result;
 }
 
+void DomainServerExporter::generateNodeMetrics(QTextStream& stream) {
+    static const QString METRIC_PREFIX = "vircadia_";
+    static const QRegularExpression VALID_NAME("^[a-zA-Z_][a-zA-Z0-9_]*$");
+
+    // Prometheus wants the samples of a metric together, so gather each metric from all the nodes first
+    std::vector<std::pair<QString, NodeMetrics>> nodeMetrics;
+    DependencyManager::get<LimitedNodeList>()->eachNode([&nodeMetrics](const SharedNodePointer& node) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        if (nodeData && !nodeData->getMetrics().isEmpty()) {
+            QString labels = QString("node_type=\"%1\",uuid=\"%2\"")
+                .arg(NodeType::getNodeTypeName(static_cast<NodeType_t>(node->getType())))
+                .arg(node->getUUID().toString(QUuid::WithoutBraces));
+            nodeMetrics.emplace_back(labels, nodeData->getMetrics());
+        }
+    });
+
+    using Sample = std::pair<const QString*, const NodeMetrics::Metric*>;
+    QMap<QString, std::vector<Sample>> families;
+    for (const auto& node : nodeMetrics) {
+        const auto& metrics = node.second.getMetrics();
+        for (auto it = metrics.constBegin(); it != metrics.constEnd(); ++it) {
+            if (VALID_NAME.match(it.key()).hasMatch()) {
+                families[it.key()].emplace_back(&node.first, &it.value());
+            }
+        }
+    }
+
+    for (auto family = families.constBegin(); family != families.constEnd(); ++family) {
+        QString name = METRIC_PREFIX + family.key();
+        NodeMetrics::Type type = family.value().front().second->type;
+
+        stream << "# TYPE " << name << " ";
+        switch (type) {
+            case NodeMetrics::Type::Counter:
+                stream << "counter";
+                break;
+            case NodeMetrics::Type::Gauge:
+                stream << "gauge";
+                break;
+            case NodeMetrics::Type::Histogram:
+                stream << "histogram";
+                break;
+        }
+        stream << "\n";
+
+        for (const auto& sample : family.value()) {
+            const QString& labels = *sample.first;
+            const NodeMetrics::Metric& metric = *sample.second;
+            if (metric.type != type) {
+                // a node disagreeing on the type, Prometheus would reject the whole scrape
+                continue;
+            }
+
+            if (type == NodeMetrics::Type::Histogram) {
+                for (size_t i = 0; i < metric.bucketBounds.size(); ++i) {
+                    stream << name << "_bucket{" << labels << ",le=\"" << metric.bucketBounds[i] << "\"} "
+                        << metric.bucketCounts[i] << "\n";
+                }
+                stream << name << "_bucket{" << labels << ",le=\"+Inf\"} " << metric.count << "\n";
+                stream << name << "_sum{" << labels << "} " << metric.value << "\n";
+                stream << name << "_count{" << labels << "} " << metric.count << "\n";
+            } else {
+                stream << name << "{" << labels << "} " << metric.value << "\n";
+            }
+        }
+    }
+}
+
 void DomainServerExporter::generateMetricsForNode(QTextStream& stream, const SharedNodePointer& node) {
     QJsonObject statsObject = static_cast<DomainServerNodeData*>(node->getLinkedData())->getStatsJSONObject();
     QString nodeType = NodeType::getNodeTypeName(static_cast<NodeType_t>(node->getType()));
@@ -48,6 +48,7 @@ public:
 
 private:
     QString escapeName(const QString &name);
+    void generateNodeMetrics(QTextStream& stream);
     void generateMetricsForNode(QTextStream& stream, const SharedNodePointer& node);
     void generateMetricsFromJson(QTextStream& stream, QString originalPath, QString path, QHash<QString, QString> labels, const QJsonObject& obj);
 };
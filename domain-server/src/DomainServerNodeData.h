@@ -20,6 +20,7 @@
 #include <HifiSockAddr.h>
 #include <NLPacket.h>
 #include <NodeData.h>
+#include <NodeMetrics.h>
 #include <NodeType.h>
 
 class DomainServerNodeData : public NodeData {
@@ -30,6 +31,9 @@ public:
 
     void updateJSONStats(QByteArray statsByteArray);
 
+    const NodeMetrics& getMetrics() const { return _metrics; }
+    void setMetrics(const NodeMetrics& metrics) { _metrics = metrics; }
+
     void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
     const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
 
@@ -75,6 +79,10 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // the version of the domain list this node last changed in
+    quint64 getListVersion() const { return _listVersion; }
+    void setListVersion(quint64 listVersion) { _listVersion = listVersion; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -88,6 +96,7 @@ private:
     
     using StringPairHash = QHash<QPair<QString, QString>, QString>;
     QJsonObject _statsJSONObject;
+    NodeMetrics _metrics;
     static StringPairHash _overrideHash;
     
     HifiSockAddr _sendingSockAddr;
@@ -102,6 +111,8 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    quint64 _listVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
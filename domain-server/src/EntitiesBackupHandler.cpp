@@ -11,6 +11,7 @@
 
 #include "EntitiesBackupHandler.h"
 
+#include <QCryptographicHash>
 #include <QDebug>
 
 #if !defined(__clang__) && defined(__GNUC__)
@@ -44,8 +45,7 @@ void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip)
             qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
             return;
         }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
+        if (!copyBackupData(entitiesFile, zipFile)) {
             qCritical() << "Failed to write entities file to backup";
             zipFile.close();
             return;
@@ -57,6 +57,13 @@ void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip)
     }
 }
 
+void EntitiesBackupHandler::addContentToHash(QCryptographicHash& hash) {
+    QFile entitiesFile { _entitiesFilePath };
+    if (entitiesFile.open(QIODevice::ReadOnly)) {
+        hash.addData(&entitiesFile);
+    }
+}
+
 std::pair<bool, QString> EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) {
     if (!zip.setCurrentFile(ENTITIES_BACKUP_FILENAME)) {
         QString errorStr("Failed to find " + ENTITIES_BACKUP_FILENAME + " while recovering backup");
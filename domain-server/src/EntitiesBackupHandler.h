@@ -39,6 +39,8 @@ public:
 
     bool isCorruptedBackup(const QString& backupName) override { return false; }
 
+    void addContentToHash(QCryptographicHash& hash) override;
+
 private:
     QString _entitiesFilePath;
     QString _entitiesReplacementFilePath;
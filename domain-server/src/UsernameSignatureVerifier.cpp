@@ -0,0 +1,52 @@
+//
+//  UsernameSignatureVerifier.cpp
+//  domain-server/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UsernameSignatureVerifier.h"
+
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+#include <QtCore/QCryptographicHash>
+
+UsernameSignatureVerifier::UsernameSignatureVerifier(const QString& lowerUsername, const QByteArray& publicKey,
+                                                     const QUuid& connectionToken, const QByteArray& usernameSignature) :
+    _lowerUsername(lowerUsername),
+    _publicKey(publicKey),
+    _connectionToken(connectionToken),
+    _usernameSignature(usernameSignature)
+{
+}
+
+void UsernameSignatureVerifier::run() {
+    const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(_publicKey.constData());
+
+    // first load up the public key into an RSA struct
+    RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, _publicKey.size());
+
+    Result result = InvalidKey;
+    if (rsaPublicKey) {
+        QByteArray lowercaseUsernameUTF8 = _lowerUsername.toUtf8();
+        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(_connectionToken.toRfc4122()),
+                                                                QCryptographicHash::Sha256);
+
+        int decryptResult = RSA_verify(NID_sha256,
+                                       reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
+                                       usernameWithToken.size(),
+                                       reinterpret_cast<const unsigned char*>(_usernameSignature.constData()),
+                                       _usernameSignature.size(),
+                                       rsaPublicKey);
+        result = decryptResult == 1 ? Match : Mismatch;
+
+        RSA_free(rsaPublicKey);
+    }
+
+    emit finished(_lowerUsername, _publicKey, _connectionToken, _usernameSignature, result);
+}
@@ -0,0 +1,47 @@
+//
+//  UsernameSignatureVerifier.h
+//  domain-server/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UsernameSignatureVerifier_h
+#define hifi_UsernameSignatureVerifier_h
+
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QUuid>
+
+// Checks the signature a user connecting to the domain made of their username and connection token against their public
+// key, off the domain-server's main thread.
+class UsernameSignatureVerifier : public QObject, public QRunnable {
+    Q_OBJECT
+public:
+    enum Result {
+        Match,
+        Mismatch,
+        InvalidKey
+    };
+    Q_ENUM(Result)
+
+    UsernameSignatureVerifier(const QString& lowerUsername, const QByteArray& publicKey, const QUuid& connectionToken,
+                              const QByteArray& usernameSignature);
+
+    virtual void run() override;
+
+signals:
+    void finished(QString lowerUsername, QByteArray publicKey, QUuid connectionToken, QByteArray usernameSignature,
+                  UsernameSignatureVerifier::Result result);
+
+private:
+    QString _lowerUsername;
+    QByteArray _publicKey;
+    QUuid _connectionToken;
+    QByteArray _usernameSignature;
+};
+
+#endif // hifi_UsernameSignatureVerifier_h
@@ -0,0 +1,39 @@
+//
+//  HeartbeatVerifier.cpp
+//  ice-server/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HeartbeatVerifier.h"
+
+#include <openssl/x509.h>
+
+#include <QtCore/QCryptographicHash>
+
+HeartbeatVerifier::HeartbeatVerifier(const Heartbeat& heartbeat, std::shared_ptr<RSA> publicKey) :
+    _heartbeat(heartbeat),
+    _publicKey(std::move(publicKey))
+{
+    // deleted by the ice-server once it has the result
+    setAutoDelete(false);
+}
+
+bool HeartbeatVerifier::isVerified(RSA* publicKey, const QByteArray& plaintext, const QByteArray& signature) {
+    auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
+    int verificationResult = RSA_verify(NID_sha256,
+                                        reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                        hashedPlaintext.size(),
+                                        reinterpret_cast<const unsigned char*>(signature.constData()),
+                                        signature.size(),
+                                        publicKey);
+    return verificationResult == 1;
+}
+
+void HeartbeatVerifier::run() {
+    emit finished(isVerified(_publicKey.get(), _heartbeat.plaintext, _heartbeat.signature));
+}
@@ -0,0 +1,55 @@
+//
+//  HeartbeatVerifier.h
+//  ice-server/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HeartbeatVerifier_h
+#define hifi_HeartbeatVerifier_h
+
+#include <memory>
+
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QUuid>
+
+#include <openssl/rsa.h>
+
+#include <HifiSockAddr.h>
+
+// Checks the signature of a domain's heartbeat against the domain's public key, off the ice-server's main thread.
+class HeartbeatVerifier : public QObject, public QRunnable {
+    Q_OBJECT
+public:
+    struct Heartbeat {
+        QUuid domainID;
+        HifiSockAddr publicSocket;
+        HifiSockAddr localSocket;
+        HifiSockAddr senderSockAddr;
+        QByteArray plaintext;
+        QByteArray signature;
+        quint64 receivedAt { 0 };
+    };
+
+    HeartbeatVerifier(const Heartbeat& heartbeat, std::shared_ptr<RSA> publicKey);
+
+    static bool isVerified(RSA* publicKey, const QByteArray& plaintext, const QByteArray& signature);
+
+    const Heartbeat& getHeartbeat() const { return _heartbeat; }
+
+    virtual void run() override;
+
+signals:
+    void finished(bool isVerified);
+
+private:
+    Heartbeat _heartbeat;
+    std::shared_ptr<RSA> _publicKey;
+};
+
+#endif // hifi_HeartbeatVerifier_h
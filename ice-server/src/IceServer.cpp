@@ -11,10 +11,15 @@
 
 #include "IceServer.h"
 
+#include <algorithm>
+
 #include <openssl/x509.h>
 
+#include <QtCore/QCommandLineParser>
 #include <QtCore/QDataStream>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
@@ -23,18 +28,53 @@
 #include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
 #include <MetaverseAPI.h>
+#include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 
+// a peer is removed once its slot of the expiry wheel comes back around without it being heard, 5 to 6 seconds
 const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
-const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
+
+const quint16 ICE_SERVER_MONITORING_PORT = 40110;
+
+// a heartbeat the same as the last one verified for its domain within this time is taken as verified
+const quint64 VERIFIED_HEARTBEAT_CACHE_USECS = 60 * USECS_PER_SECOND;
+// past this many heartbeats waiting for the verifier threads, they are checked as they come in
+const int MAX_QUEUED_VERIFICATIONS = 1000;
 
 IceServer::IceServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
     _id(QUuid::createUuid()),
     _serverSocket(0, false),
-    _activePeers()
+    _activePeers(),
+    _httpManager(QHostAddress::AnyIPv4, ICE_SERVER_MONITORING_PORT, QString(), this)
 {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Vircadia ICE Server");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+    const QCommandLineOption verifierThreadsOption("verifier-threads",
+        "number of threads checking heartbeat signatures, 0 to check them on the main thread", "threads");
+    parser.addOption(verifierThreadsOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _verifierThreads = std::max(QThread::idealThreadCount() - 1, 0);
+    if (parser.isSet(verifierThreadsOption)) {
+        _verifierThreads = std::max(parser.value(verifierThreadsOption).toInt(), 0);
+    }
+    if (_verifierThreads > 0) {
+        _verifierPool.setMaxThreadCount(_verifierThreads);
+    }
+    qDebug() << "ice-server is checking heartbeats on" << _verifierThreads << "verifier threads";
+
     // start the ice-server socket
     qDebug() << "ice-server socket is listening on" << ICE_SERVER_DEFAULT_PORT;
     _serverSocket.bind(QHostAddress::AnyIPv4, ICE_SERVER_DEFAULT_PORT);
@@ -56,6 +96,11 @@ IceServer::IceServer(int argc, char* argv[]) :
     connect(&networkAccessManager, &QNetworkAccessManager::finished, this, &IceServer::publicKeyReplyFinished);
 }
 
+IceServer::~IceServer() {
+    // the verifiers are children of the ice-server, let them finish before they go
+    _verifierPool.waitForDone();
+}
+
 bool IceServer::packetVersionMatch(const udt::Packet& packet) {
     PacketType headerType = NLPacket::typeInHeader(packet);
     PacketVersion headerVersion = NLPacket::versionInHeader(packet);
@@ -75,21 +120,10 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     if (nlPacket->getPayloadSize() >= NLPacket::localHeaderSize(PacketType::ICEServerHeartbeat)) {
         
         if (nlPacket->getType() == PacketType::ICEServerHeartbeat) {
-            SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(*nlPacket);
-            if (peer) {
-                // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
-                peer->activateMatchingOrNewSymmetricSocket(nlPacket->getSenderSockAddr());
-
-                // we have an active and verified heartbeating peer
-                // send them an ACK packet so they know that they are being heard and ready for ICE
-                static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
-                _serverSocket.writePacket(*ackPacket, nlPacket->getSenderSockAddr());
-            } else {
-                // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
-                static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
-                _serverSocket.writePacket(*deniedPacket, nlPacket->getSenderSockAddr());
-            }
+            processHeartbeat(*nlPacket);
         } else if (nlPacket->getType() == PacketType::ICEServerQuery) {
+            ++_stats.queries;
+
             QDataStream heartbeatStream(nlPacket.get());
             
             // this is a node hoping to connect to a heartbeating peer - do we have the heartbeating peer?
@@ -104,9 +138,10 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
             QUuid connectRequestID;
             heartbeatStream >> connectRequestID;
             
-            SharedNetworkPeer matchingPeer = _activePeers.value(connectRequestID);
+            SharedNetworkPeer matchingPeer = _activePeers.value(connectRequestID).peer;
             
             if (matchingPeer) {
+                ++_stats.answeredQueries;
                 
                 qDebug() << "Sending information for peer" << connectRequestID << "to peer" << senderUUID;
                 
@@ -125,85 +160,132 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     }
 }
 
-SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
+void IceServer::processHeartbeat(NLPacket& packet) {
+    ++_stats.heartbeats;
 
     // pull the UUID, public and private sock addrs for this peer
-    QUuid senderUUID;
-    HifiSockAddr publicSocket, localSocket;
-    QByteArray signature;
+    Heartbeat heartbeat;
+    heartbeat.senderSockAddr = packet.getSenderSockAddr();
+    heartbeat.receivedAt = usecTimestampNow();
 
     QDataStream heartbeatStream(&packet);
-    heartbeatStream >> senderUUID >> publicSocket >> localSocket;
-
-    auto signedPlaintext = QByteArray::fromRawData(packet.getPayload(), heartbeatStream.device()->pos());
-    heartbeatStream >> signature;
+    heartbeatStream >> heartbeat.domainID >> heartbeat.publicSocket >> heartbeat.localSocket;
 
-    // make sure this is a verified heartbeat before performing any more processing
-    if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
-        // make sure we have this sender in our peer hash
-        SharedNetworkPeer matchingPeer = _activePeers.value(senderUUID);
+    // copied, the packet is gone by the time a verifier thread gets to it
+    heartbeat.plaintext = QByteArray(packet.getPayload(), heartbeatStream.device()->pos());
+    heartbeatStream >> heartbeat.signature;
 
-        if (!matchingPeer) {
-            // if we don't have this sender we need to create them now
-            matchingPeer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
-            _activePeers.insert(senderUUID, matchingPeer);
+    // make sure we're not already waiting for a public key for this domain-server
+    if (_pendingPublicKeyRequests.contains(heartbeat.domainID)) {
+        finishHeartbeat(heartbeat, false);
+        return;
+    }
 
-            qDebug() << "Added a new network peer" << *matchingPeer;
-        } else {
-            // we already had the peer so just potentially update their sockets
-            matchingPeer->setPublicSocket(publicSocket);
-            matchingPeer->setLocalSocket(localSocket);
+    // check if we have a public key for this domain ID - if we do not then fire off the request for it
+    auto it = _domainPublicKeys.find(heartbeat.domainID);
+    if (it == _domainPublicKeys.end() || !it->second) {
+        if (it != _domainPublicKeys.end()) {
+            // we can't let this user in since we couldn't convert their public key to an RSA key we could use
+            qWarning() << "Public key for" << heartbeat.domainID << "is not a usable RSA* public key.";
+            qWarning() << "Re-requesting public key from API";
         }
+        finishHeartbeat(heartbeat, false);
+        return;
+    }
 
-        // update our last heard microstamp for this network peer to now
-        matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
-        
-        return matchingPeer;
-    } else {
-        // not verified, return the empty peer object
-        return SharedNetworkPeer();
+    // a domain sends the same signed heartbeat until its sockets change, so most don't need checking again
+    auto verified = _verifiedHeartbeats.find(heartbeat.domainID);
+    if (verified != _verifiedHeartbeats.end() && heartbeat.receivedAt - verified->second.verifiedAt < VERIFIED_HEARTBEAT_CACHE_USECS
+        && verified->second.signature == heartbeat.signature && verified->second.plaintext == heartbeat.plaintext) {
+        ++_stats.cachedVerifications;
+        finishHeartbeat(heartbeat, true);
+        return;
     }
+
+    if (_verifierThreads == 0 || _queuedVerifications >= MAX_QUEUED_VERIFICATIONS) {
+        finishHeartbeat(heartbeat, HeartbeatVerifier::isVerified(it->second.get(), heartbeat.plaintext, heartbeat.signature));
+        return;
+    }
+
+    auto verifier = new HeartbeatVerifier(heartbeat, it->second);
+    verifier->setParent(this);
+    connect(verifier, &HeartbeatVerifier::finished, this, [this, verifier](bool isVerified) {
+        --_queuedVerifications;
+        finishHeartbeat(verifier->getHeartbeat(), isVerified);
+        verifier->deleteLater();
+    }, Qt::QueuedConnection);
+
+    ++_queuedVerifications;
+    _verifierPool.start(verifier);
 }
 
-bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
-    // make sure we're not already waiting for a public key for this domain-server
-    if (!_pendingPublicKeyRequests.contains(domainID)) {
-        // check if we have a public key for this domain ID - if we do not then fire off the request for it
-        auto it = _domainPublicKeys.find(domainID);
-        if (it != _domainPublicKeys.end()) {
+void IceServer::finishHeartbeat(const Heartbeat& heartbeat, bool isVerified) {
+    if (isVerified) {
+        ++_stats.verifiedHeartbeats;
 
-            // attempt to verify the signature for this heartbeat
-            const auto rsaPublicKey = it->second.get();
-
-            if (rsaPublicKey) {
-                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
-                int verificationResult = RSA_verify(NID_sha256,
-                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
-                                                    hashedPlaintext.size(),
-                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
-                                                    signature.size(),
-                                                    rsaPublicKey);
-
-                if (verificationResult == 1) {
-                    // this is the only success case - we return true here to indicate that the heartbeat is verified
-                    return true;
-                } else {
-                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
-                }
+        auto& verified = _verifiedHeartbeats[heartbeat.domainID];
+        if (verified.signature != heartbeat.signature || verified.plaintext != heartbeat.plaintext) {
+            verified.plaintext = heartbeat.plaintext;
+            verified.signature = heartbeat.signature;
+            verified.verifiedAt = heartbeat.receivedAt;
+        }
 
-            } else {
-                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
-                qWarning() << "Re-requesting public key from API";
+        SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(heartbeat);
+
+        // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
+        peer->activateMatchingOrNewSymmetricSocket(heartbeat.senderSockAddr);
+
+        // we have an active and verified heartbeating peer
+        // send them an ACK packet so they know that they are being heard and ready for ICE
+        static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
+        _serverSocket.writePacket(*ackPacket, heartbeat.senderSockAddr);
+    } else {
+        ++_stats.deniedHeartbeats;
+
+        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
+        // ask the metaverse API for the right public key
+        if (!_pendingPublicKeyRequests.contains(heartbeat.domainID)) {
+            if (_domainPublicKeys.find(heartbeat.domainID) != _domainPublicKeys.end()) {
+                qDebug() << "Failed to verify heartbeat for" << heartbeat.domainID << "- re-requesting public key from API.";
             }
+            requestDomainPublicKey(heartbeat.domainID);
         }
 
-        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
-        // ask the metaverse API for the right public key and return false to indicate that this is not verified
-        requestDomainPublicKey(domainID);
+        // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
+        static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
+        _serverSocket.writePacket(*deniedPacket, heartbeat.senderSockAddr);
     }
 
-    return false;
+    _stats.heartbeatLatencies.record(usecTimestampNow() - heartbeat.receivedAt);
+}
+
+SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(const Heartbeat& heartbeat) {
+    // make sure we have this sender in our peer hash
+    ActivePeer& activePeer = _activePeers[heartbeat.domainID];
+    SharedNetworkPeer& matchingPeer = activePeer.peer;
+    bool isNewPeer = !matchingPeer;
+
+    if (isNewPeer) {
+        // if we don't have this sender we need to create them now
+        matchingPeer = QSharedPointer<NetworkPeer>::create(heartbeat.domainID, heartbeat.publicSocket, heartbeat.localSocket);
+
+        qDebug() << "Added a new network peer" << *matchingPeer;
+    } else {
+        // we already had the peer so just potentially update their sockets
+        matchingPeer->setPublicSocket(heartbeat.publicSocket);
+        matchingPeer->setLocalSocket(heartbeat.localSocket);
+    }
+
+    // update our last heard microstamp for this network peer to now
+    matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
+
+    // the peer moves to the current slot of the expiry wheel, it's left in its old one until that comes around
+    if (isNewPeer || activePeer.lastHeardTick != _currentTick) {
+        activePeer.lastHeardTick = _currentTick;
+        _expiryWheel[_currentTick % EXPIRY_WHEEL_SLOTS].push_back(heartbeat.domainID);
+    }
+
+    return matchingPeer;
 }
 
 void IceServer::requestDomainPublicKey(const QUuid& domainID) {
@@ -262,7 +344,10 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
                 RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
 
                 if (rsaPublicKey) {
-                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                    _domainPublicKeys[domainID] = RSASharedPtr(rsaPublicKey, RSA_free);
+
+                    // heartbeats verified with the previous key have to be checked again
+                    _verifiedHeartbeats.erase(domainID);
                 } else {
                     qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
                     qWarning() << "Public key will be re-requested on next heartbeat.";
@@ -299,22 +384,55 @@ void IceServer::sendPeerInformationPacket(const NetworkPeer& peer, const HifiSoc
 }
 
 void IceServer::clearInactivePeers() {
-    NetworkPeerHash::iterator peerItem = _activePeers.begin();
+    ++_currentTick;
+
+    // the slot coming back around holds the peers heard a whole turn of the wheel ago, those still on that tick have
+    // been silent since
+    auto& expiringSlot = _expiryWheel[_currentTick % EXPIRY_WHEEL_SLOTS];
+    for (const auto& peerID : expiringSlot) {
+        auto peerItem = _activePeers.find(peerID);
+        if (peerItem == _activePeers.end() || peerItem->lastHeardTick + EXPIRY_WHEEL_SLOTS != _currentTick) {
+            continue;
+        }
 
-    while (peerItem != _activePeers.end()) {
-        SharedNetworkPeer peer = peerItem.value();
+        qDebug() << "Removing peer from memory for inactivity -" << *peerItem->peer;
+        ++_stats.expiredPeers;
 
-        if ((usecTimestampNow() - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
-            qDebug() << "Removing peer from memory for inactivity -" << *peer;
+        // if we had a public key for this domain, remove it now
+        _domainPublicKeys.erase(peerID);
+        _verifiedHeartbeats.erase(peerID);
 
-            // if we had a public key for this domain, remove it now
-            _domainPublicKeys.erase(peer->getUUID());
+        // remove the peer object
+        _activePeers.erase(peerItem);
+    }
+    expiringSlot.clear();
+}
 
-            // remove the peer object
-            peerItem = _activePeers.erase(peerItem);
-        } else {
-            // we didn't kill this peer, push the iterator forwards
-            ++peerItem;
+QJsonObject IceServer::getStats() const {
+    QJsonObject stats;
+    stats["active_peers"] = _activePeers.size();
+    stats["verifier_threads"] = _verifierThreads;
+    stats["queued_verifications"] = _queuedVerifications;
+    stats["heartbeats"] = (qint64)_stats.heartbeats;
+    stats["verified_heartbeats"] = (qint64)_stats.verifiedHeartbeats;
+    stats["denied_heartbeats"] = (qint64)_stats.deniedHeartbeats;
+    stats["cached_verifications"] = (qint64)_stats.cachedVerifications;
+    stats["queries"] = (qint64)_stats.queries;
+    stats["answered_queries"] = (qint64)_stats.answeredQueries;
+    stats["expired_peers"] = (qint64)_stats.expiredPeers;
+    stats["heartbeat_latency"] = _stats.heartbeatLatencies.toJson("usecs");
+    return stats;
+}
+
+bool IceServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
+    if (connection->requestOperation() == QNetworkAccessManager::GetOperation) {
+        if (url.path() == "/status") {
+            connection->respond(HTTPConnection::StatusCode200, QByteArray::number(_activePeers.size()));
+            return true;
+        } else if (url.path() == "/stats.json") {
+            connection->respond(HTTPConnection::StatusCode200, QJsonDocument(getStats()).toJson(), "application/json");
+            return true;
         }
     }
+    return false;
 }
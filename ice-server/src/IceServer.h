@@ -12,50 +12,104 @@
 #ifndef hifi_IceServer_h
 #define hifi_IceServer_h
 
+#include <array>
+#include <memory>
+#include <vector>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 #include <QUdpSocket>
 
 #include <openssl/rsa.h>
 
 #include <UUIDHasher.h>
 
+#include <LatencyHistogram.h>
 #include <NetworkPeer.h>
 #include <HTTPConnection.h>
 #include <HTTPManager.h>
 #include <NLPacket.h>
 #include <udt/Socket.h>
 
+#include "HeartbeatVerifier.h"
+
 class QNetworkReply;
 
-class IceServer : public QCoreApplication {
+class IceServer : public QCoreApplication, public HTTPRequestHandler {
     Q_OBJECT
 public:
     IceServer(int argc, char* argv[]);
+    ~IceServer();
+
+    bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
 private slots:
     void clearInactivePeers();
     void publicKeyReplyFinished(QNetworkReply* reply);
 private:
+    using Heartbeat = HeartbeatVerifier::Heartbeat;
+
     bool packetVersionMatch(const udt::Packet& packet);
     void processPacket(std::unique_ptr<udt::Packet> packet);
-    
-    SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
+
+    void processHeartbeat(NLPacket& packet);
+    void finishHeartbeat(const Heartbeat& heartbeat, bool isVerified);
+    SharedNetworkPeer addOrUpdateHeartbeatingPeer(const Heartbeat& heartbeat);
     void sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr* destinationSockAddr);
 
-    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
     void requestDomainPublicKey(const QUuid& domainID);
 
+    QJsonObject getStats() const;
+
     QUuid _id;
     udt::Socket _serverSocket;
 
-    using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
+    struct ActivePeer {
+        SharedNetworkPeer peer;
+        // the tick of the expiry wheel the peer was last heard in
+        quint64 lastHeardTick { 0 };
+    };
+    using NetworkPeerHash = QHash<QUuid, ActivePeer>;
     NetworkPeerHash _activePeers;
 
-    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
+    // an expiry wheel of the peers heard in each of its ticks, a peer is only looked at again once its slot comes back
+    // around, rather than every peer on every tick
+    static const int EXPIRY_WHEEL_SLOTS = 6;
+    std::array<std::vector<QUuid>, EXPIRY_WHEEL_SLOTS> _expiryWheel;
+    quint64 _currentTick { 0 };
+
+    using RSASharedPtr = std::shared_ptr<RSA>;
+    using DomainPublicKeyHash = std::unordered_map<QUuid, RSASharedPtr>;
     DomainPublicKeyHash _domainPublicKeys;
 
     QSet<QUuid> _pendingPublicKeyRequests;
+
+    // the last heartbeat verified for each domain, a heartbeat that is the same as it doesn't need checking again
+    struct VerifiedHeartbeat {
+        QByteArray plaintext;
+        QByteArray signature;
+        quint64 verifiedAt { 0 };
+    };
+    std::unordered_map<QUuid, VerifiedHeartbeat> _verifiedHeartbeats;
+
+    struct Stats {
+        quint64 heartbeats { 0 };
+        quint64 verifiedHeartbeats { 0 };
+        quint64 deniedHeartbeats { 0 };
+        quint64 cachedVerifications { 0 };
+        quint64 queries { 0 };
+        quint64 answeredQueries { 0 };
+        quint64 expiredPeers { 0 };
+        LatencyHistogram heartbeatLatencies;
+    };
+    Stats _stats;
+
+    HTTPManager _httpManager;
+
+    // heartbeats that aren't in the cache are checked here, unless there are no verifier threads
+    int _verifierThreads { 0 };
+    int _queuedVerifications { 0 };
+    QThreadPool _verifierPool;
 };
 
 #endif // hifi_IceServer_h
@@ -105,6 +105,7 @@
 #include <LocationScriptingInterface.h>
 #include <MainWindow.h>
 #include <MappingRequest.h>
+#include <MemoryAccounting.h>
 #include <MessagesClient.h>
 #include <hfm/ModelFormatRegistry.h>
 #include <model-networking/ModelCacheScriptingInterface.h>
@@ -581,10 +582,10 @@ public:
 };
 
 void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+#ifdef Q_OS_ANDROID
     QString logMessage = LogHandler::getInstance().printMessage((LogMsgType) type, context, message);
 
     if (!logMessage.isEmpty()) {
-#ifdef Q_OS_ANDROID
         const char * local=logMessage.toStdString().c_str();
         switch (type) {
             case QtDebugMsg:
@@ -604,10 +605,11 @@ void messageHandler(QtMsgType type, const QMessageLogContext& context, const QSt
                 __android_log_write(ANDROID_LOG_FATAL,"Interface",local);
                 abort();
         }
+    }
 #else
-        qApp->getLogger()->addMessage(qPrintable(logMessage));
+    // the FileLogger is a sink of the LogHandler
+    LogHandler::getInstance().queueMessage((LogMsgType) type, context, message);
 #endif
-    }
 }
 
 
@@ -1057,13 +1059,20 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     _snapshotSound(nullptr),
     _sampleSound(nullptr)
 {
+    // the time of each phase of the startup goes to the log, with the time since the launch
+    QElapsedTimer startupPhaseTimer;
+    startupPhaseTimer.start();
+    auto logStartupPhase = [&](const char* phase) {
+        qCDebug(interfaceapp, "Startup: %s took %lld ms, %4.2f seconds since the launch.", phase,
+                (long long)startupPhaseTimer.restart(), (double)startupTimer.elapsed() / 1000.0);
+    };
 
     auto steamClient = PluginManager::getInstance()->getSteamClientPlugin();
     setProperty(hifi::properties::STEAM, (steamClient && steamClient->isRunning()));
     setProperty(hifi::properties::CRASHED, _previousSessionCrashed);
 
-    LogHandler::getInstance().moveToThread(thread());
-    LogHandler::getInstance().setupRepeatedMessageFlusher();
+    // the log lines are written to the file by the writer thread of the LogHandler
+    LogHandler::getInstance().addSink(_logger);
 
     {
         const QStringList args = arguments();
@@ -1528,13 +1537,19 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     // Make sure the window is set to the correct size by processing the pending events
     QCoreApplication::processEvents();
 
+    // The avatar model downloads and parses on the resource threads while the GL, the shaders and the UI initialize
+    if (myAvatar) {
+        myAvatar->prefetchFullAvatarModel();
+    }
+    logStartupPhase("setup");
+
     // Create the main thread context, the GPU backend
     initializeGL();
-    qCDebug(interfaceapp, "Initialized GL");
+    logStartupPhase("GL");
 
     // Initialize the display plugin architecture
     initializeDisplayPlugins();
-    qCDebug(interfaceapp, "Initialized Display");
+    logStartupPhase("display plugins");
 
     if (_displayPlugin && !_displayPlugin->isHmd()) {
         _preferredCursor.set(Cursor::Manager::getIconName(Cursor::Icon::SYSTEM));
@@ -1569,7 +1584,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     // Create the rendering engine.  This can be slow on some machines due to lots of
     // GPU pipeline creation.
     initializeRenderEngine();
-    qCDebug(interfaceapp, "Initialized Render Engine.");
+    logStartupPhase("render engine");
 
     // Overlays need to exist before we set the ContextOverlayInterface dependency
     _overlays.init(); // do this before scripts load
@@ -1606,9 +1621,10 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     // Initialize the user interface and menu system
     // Needs to happen AFTER the render engine initialization to access its configuration
     initializeUi();
+    logStartupPhase("UI");
 
     init();
-    qCDebug(interfaceapp, "init() complete.");
+    logStartupPhase("init");
 
     // create thread for parsing of octree data independent of the main network and rendering threads
     _octreeProcessor.initialize(_enableProcessOctreeThread);
@@ -1970,6 +1986,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     updateHeartbeat();
 
     loadSettings();
+    logStartupPhase("settings");
 
     updateVerboseLogging();
     
@@ -5314,6 +5331,8 @@ void Application::idle() {
 
     checkChangeCursor();
 
+    MemoryAccounting::getInstance().logSnapshotIfDue();
+
 #if !defined(DISABLE_QML)
     auto stats = Stats::getInstance();
     if (stats) {
@@ -5693,7 +5712,25 @@ void Application::init() {
         }
 
         auto distance = glm::distance(getMyAvatar()->getWorldPosition(), item.getWorldPosition());
-        return atan2(maxSize, distance);
+        float priority = atan2(maxSize, distance);
+
+        // what can't be seen yet waits for what can
+        bool success;
+        AABox bound = item.getAABox(success);
+        if (success) {
+            bool isInView = false;
+            for (const auto& view : _conicalViews) {
+                if (view.intersects(bound)) {
+                    isInView = true;
+                    break;
+                }
+            }
+            if (!isInView) {
+                const float OUT_OF_VIEW_PRIORITY_FACTOR = 0.5f;
+                priority *= OUT_OF_VIEW_PRIORITY_FACTOR;
+            }
+        }
+        return priority;
     });
 
     ObjectMotionState::setShapeManager(&_shapeManager);
@@ -6333,6 +6370,9 @@ void Application::update(float deltaTime) {
         return;
     }
 
+    // the start of the simulation of the next rendered frame, from which its latency to the display is measured
+    _lastUpdateStartTime = usecTimestampNow();
+
     if (!_physicsEnabled) {
         if (!domainLoadingInProgress) {
             PROFILE_ASYNC_BEGIN(app, "Scene Loading", "");
@@ -6691,6 +6731,7 @@ void Application::update(float deltaTime) {
         {
             PROFILE_RANGE(simulation, "OtherAvatars");
             PerformanceTimer perfTimer("otherAvatars");
+            _avatarTraceIDs = avatarManager->takeReceivedTraceIDs();
             avatarManager->updateOtherAvatars(deltaTime);
         }
 
@@ -6706,6 +6747,10 @@ void Application::update(float deltaTime) {
     PerformanceWarning warn(showWarnings, "Application::update()");
 
     updateLOD(deltaTime);
+    if (!isThrottleRendering()) {
+        _performanceManager.updateDynamicResolution(deltaTime, getGPUContext()->getFrameTimerGPUAverage(),
+                                                    DependencyManager::get<LODManager>()->getLODTargetFPS());
+    }
 
     if (!_loginDialogID.isNull()) {
         _loginStateManager.update(getMyAvatar()->getDominantHand(), _loginDialogID);
@@ -6832,10 +6877,18 @@ void Application::update(float deltaTime) {
     }
 }
 
+// radii of the full resolution regions of the foveated rendering, over the height of the eyes
+static const float FOVEATION_RADIUS = 0.4f;
+static const float TRACKED_FOVEATION_RADIUS = 0.25f;
+
 void Application::updateRenderArgs(float deltaTime) {
     _graphicsEngine.editRenderArgs([this, deltaTime](AppRenderArgs& appRenderArgs) {
         PerformanceTimer perfTimer("editRenderArgs");
+        appRenderArgs._simulationTime = _lastUpdateStartTime;
         appRenderArgs._headPose = getHMDSensorPose();
+        // kept until a frame is rendered, the updates can run faster than the frames
+        appRenderArgs._traceIDs.insert(appRenderArgs._traceIDs.end(), _avatarTraceIDs.begin(), _avatarTraceIDs.end());
+        _avatarTraceIDs.clear();
 
         auto myAvatar = getMyAvatar();
 
@@ -6934,6 +6987,31 @@ void Application::updateRenderArgs(float deltaTime) {
 
                 // Configure the type of display / stereo
                 appRenderArgs._renderArgs._displayMode = (isHMDMode() ? RenderArgs::STEREO_HMD : RenderArgs::STEREO_MONITOR);
+
+                auto& renderArgs = appRenderArgs._renderArgs;
+                renderArgs._foveated = isHMDMode() && RenderScriptingInterface::getInstance()->getFoveatedRenderingEnabled();
+                if (renderArgs._foveated) {
+                    // the full resolution region follows the gaze if the eyes are tracked, it is centered on the lenses otherwise
+                    controller::Pose eyePoses[2] = {
+                        myAvatar->getControllerPoseInAvatarFrame(controller::Action::LEFT_EYE),
+                        myAvatar->getControllerPoseInAvatarFrame(controller::Action::RIGHT_EYE)
+                    };
+                    bool eyesTracked = eyePoses[0].isValid() && eyePoses[1].isValid();
+                    renderArgs._foveationRadius = eyesTracked ? TRACKED_FOVEATION_RADIUS : FOVEATION_RADIUS;
+                    glm::quat worldToEye = glm::inverse(_myCamera.getOrientation());
+                    for_each_eye([&](Eye eye) {
+                        glm::vec3 direction = Vectors::FRONT;
+                        if (eyesTracked) {
+                            glm::vec3 gaze = worldToEye * myAvatar->getWorldOrientation() * eyePoses[eye].rotation * Vectors::UNIT_Z;
+                            if (gaze.z < 0.0f) {
+                                direction = gaze;
+                            }
+                        }
+                        glm::vec4 clipDirection = eyeProjections[eye] * glm::vec4(direction, 0.0f);
+                        glm::vec2 ndc = glm::vec2(clipDirection) / clipDirection.w;
+                        renderArgs._foveationCenters[eye] = glm::clamp(0.5f * ndc + 0.5f, glm::vec2(0.0f), glm::vec2(1.0f));
+                    });
+                }
             }
         }
 
@@ -7073,6 +7151,10 @@ void Application::queryOctree(NodeType_t serverType, PacketType packetType) {
     }
     _octreeQuery.setReportInitialCompletion(isModifiedQuery);
 
+    // the server compresses with its dictionary once it sees we have it
+    _octreeQuery.setWantCompressionDictionary(true);
+    _octreeQuery.setCompressionDictionaryID(getEntities()->getCompressionDictionaryID());
+
 
     auto nodeList = DependencyManager::get<NodeList>();
 
@@ -8719,7 +8801,8 @@ void Application::shareSnapshot(const QString& path, const QUrl& href) {
 }
 
 float Application::getRenderResolutionScale() const {
-    return RenderScriptingInterface::getInstance()->getViewportResolutionScale();
+    auto renderInterface = RenderScriptingInterface::getInstance();
+    return renderInterface->getViewportResolutionScale() * renderInterface->getDynamicResolutionFactor();
 }
 
 void Application::notifyPacketVersionMismatch() {
@@ -9095,6 +9178,11 @@ void Application::setDisplayPlugin(DisplayPluginPointer newDisplayPlugin) {
 
         RefreshRateManager& refreshRateManager = getRefreshRateManager();
         refreshRateManager.setRefreshRateOperator(OpenGLDisplayPlugin::getRefreshRateOperator());
+        std::weak_ptr<DisplayPlugin> weakDisplayPlugin = newDisplayPlugin;
+        refreshRateManager.setFramePacingOperator([weakDisplayPlugin](LatencyHistogram& latencies, LatencyHistogram& intervals) {
+            auto displayPlugin = weakDisplayPlugin.lock();
+            return displayPlugin && displayPlugin->getFramePacing(latencies, intervals);
+        });
         bool isHmd = newDisplayPlugin->isHmd();
         RefreshRateManager::UXMode uxMode = isHmd ? RefreshRateManager::UXMode::VR :
             RefreshRateManager::UXMode::DESKTOP;
@@ -9177,6 +9265,10 @@ void Application::setShowBulletConstraintLimits(bool value) {
     _physicsEngine->setShowBulletConstraintLimits(value);
 }
 
+void Application::setParallelSimulation(bool value) {
+    _physicsEngine->setParallelSimulation(value);
+}
+
 void Application::confirmConnectWithoutAvatarEntities() {
 
     if (_confirmConnectWithoutAvatarEntitiesDialog) {
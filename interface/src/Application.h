@@ -544,6 +544,7 @@ private slots:
     void setShowBulletContactPoints(bool value);
     void setShowBulletConstraints(bool value);
     void setShowBulletConstraintLimits(bool value);
+    void setParallelSimulation(bool value);
 
     void onDismissedLoginDialog();
 
@@ -638,6 +639,8 @@ private:
     QTimer _minimizedWindowTimer;
     QElapsedTimer _timerStart;
     QElapsedTimer _lastTimeUpdated;
+    quint64 _lastUpdateStartTime { 0 };
+    std::vector<tracing::TraceID> _avatarTraceIDs; // of the avatar data this update applied, for the frame to render
 
     int _minimumGPUTextureMemSizeStabilityCount { 30 };
 
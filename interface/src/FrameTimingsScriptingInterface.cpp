@@ -10,10 +10,15 @@
 
 #include <TextureCache.h>
 
+#include "Application.h"
+
 void FrameTimingsScriptingInterface::start() {
     _values.clear();
     DependencyManager::get<TextureCache>()->setUnusedResourceCacheSize(0);
     _values.reserve(8192);
+    if (auto displayPlugin = qApp->getActiveDisplayPlugin()) {
+        displayPlugin->resetFramePacing();
+    }
     _active = true;
 }
 
@@ -51,3 +56,7 @@ QVariantList FrameTimingsScriptingInterface::getValues() const {
     }
     return result;
 }
+
+QVariantMap FrameTimingsScriptingInterface::getFramePacing() const {
+    return qApp->getRefreshRateManager().getFramePacing().toVariantMap();
+}
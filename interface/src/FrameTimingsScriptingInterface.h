@@ -21,6 +21,8 @@ public:
     Q_INVOKABLE void addValue(uint64_t value);
     Q_INVOKABLE void finish();
     Q_INVOKABLE QVariantList getValues() const;
+    // the pacing of the frames presented to the display since start, see Performance.getFramePacing
+    Q_INVOKABLE QVariantMap getFramePacing() const;
 
 
     uint64_t getMax() const { return _max; }
@@ -512,6 +512,11 @@ Menu::Menu() {
         ModelMeshPartPayload::enableMaterialProceduralShaders = action->isChecked();
     });
 
+    action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::PreSkinMeshes, 0, false);
+    connect(action, &QAction::triggered, [action] {
+        Model::enablePreSkinning = action->isChecked();
+    });
+
     {
         auto drawStatusConfig = qApp->getRenderEngine()->getConfiguration()->getConfig<render::DrawStatus>("RenderMainView.DrawStatus");
         addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::HighlightTransitions, 0, false,
@@ -715,6 +720,7 @@ Menu::Menu() {
     addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsShowBulletContactPoints, 0, false, qApp, SLOT(setShowBulletContactPoints(bool)));
     addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsShowBulletConstraints, 0, false, qApp, SLOT(setShowBulletConstraints(bool)));
     addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsShowBulletConstraintLimits, 0, false, qApp, SLOT(setShowBulletConstraintLimits(bool)));
+    addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsParallelSimulation, 0, false, qApp, SLOT(setParallelSimulation(bool)));
 
     // Developer > Picking >>>
     MenuWrapper* pickingOptionsMenu = developerMenu->addMenu("Picking");
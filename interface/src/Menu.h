@@ -157,6 +157,7 @@ namespace MenuOption {
     const QString PhysicsShowBulletContactPoints = "Show Bullet Contact Points";
     const QString PhysicsShowBulletConstraints = "Show Bullet Constraints";
     const QString PhysicsShowBulletConstraintLimits = "Show Bullet Constraint Limits";
+    const QString PhysicsParallelSimulation = "Parallel Simulation";
     const QString PipelineWarnings = "Log Render Pipeline Warnings";
     const QString Preferences = "General...";
     const QString Quit =  "Quit";
@@ -233,6 +234,7 @@ namespace MenuOption {
     const QString ComputeBlendshapes = "Compute Blendshapes";
     const QString HighlightTransitions = "Highlight Transitions";
     const QString MaterialProceduralShaders = "Enable Procedural Materials";
+    const QString PreSkinMeshes = "Skin Meshes Once per Frame";
 }
 
 #endif // hifi_Menu_h
@@ -10,6 +10,7 @@
 //
 #include "PerformanceManager.h"
 
+#include <NumericalConstants.h>
 #include <platform/Platform.h>
 #include <platform/PlatformKeys.h>
 #include <platform/Profiler.h>
@@ -17,6 +18,14 @@
 #include "scripting/RenderScriptingInterface.h"
 #include "LODManager.h"
 
+// the render resolution doesn't go below half the viewport resolution scale, a quarter of its pixels
+static const float MIN_DYNAMIC_RESOLUTION_FACTOR = 0.5f;
+// aim under the frame time so that the spikes still fit
+static const float DYNAMIC_RESOLUTION_HEADROOM = 0.9f;
+static const float DYNAMIC_RESOLUTION_TIMESCALE = 0.5f; // seconds
+// the framebuffers are made again each time their size changes, so the factor moves by steps
+static const float DYNAMIC_RESOLUTION_STEP = 0.05f;
+
 PerformanceManager::PerformanceManager()
 {
     setPerformancePreset((PerformancePreset) _performancePresetSetting.get());
@@ -63,6 +72,64 @@ PerformanceManager::PerformancePreset PerformanceManager::getPerformancePreset()
     return preset;
 }
 
+void PerformanceManager::setDynamicResolutionEnabled(bool enabled) {
+    std::unique_lock<std::mutex> lock(_dynamicResolutionMutex);
+    if (_dynamicResolutionSetting.get() == enabled) {
+        return;
+    }
+    _dynamicResolutionSetting.set(enabled);
+    _dynamicResolutionFactor = 1.0f;
+    _appliedDynamicResolutionFactor = 1.0f;
+    lock.unlock();
+
+    RenderScriptingInterface::getInstance()->setDynamicResolutionFactor(1.0f);
+}
+
+bool PerformanceManager::isDynamicResolutionEnabled() const {
+    std::lock_guard<std::mutex> lock(_dynamicResolutionMutex);
+    return _dynamicResolutionSetting.get();
+}
+
+void PerformanceManager::updateDynamicResolution(float deltaTime, float gpuTime, float targetFPS) {
+    std::unique_lock<std::mutex> lock(_dynamicResolutionMutex);
+    if (!_dynamicResolutionSetting.get() || gpuTime <= 0.0f || targetFPS <= 0.0f) {
+        return;
+    }
+
+    _dynamicResolutionGPUTime = gpuTime;
+    _dynamicResolutionTargetTime = DYNAMIC_RESOLUTION_HEADROOM * (float)MSECS_PER_SECOND / targetFPS;
+
+    // the GPU time goes roughly with the number of pixels, the square of the factor it was measured at
+    float wantedFactor = _appliedDynamicResolutionFactor * sqrtf(_dynamicResolutionTargetTime / gpuTime);
+    wantedFactor = glm::clamp(wantedFactor, MIN_DYNAMIC_RESOLUTION_FACTOR, 1.0f);
+    float blend = std::min(deltaTime / DYNAMIC_RESOLUTION_TIMESCALE, 1.0f);
+    _dynamicResolutionFactor += (wantedFactor - _dynamicResolutionFactor) * blend;
+
+    // a whole step away before moving, so that it doesn't go back and forth across the edge of one
+    if (fabsf(_dynamicResolutionFactor - _appliedDynamicResolutionFactor) < DYNAMIC_RESOLUTION_STEP) {
+        return;
+    }
+    float factor = roundf(_dynamicResolutionFactor / DYNAMIC_RESOLUTION_STEP) * DYNAMIC_RESOLUTION_STEP;
+    _appliedDynamicResolutionFactor = glm::clamp(factor, MIN_DYNAMIC_RESOLUTION_FACTOR, 1.0f);
+    factor = _appliedDynamicResolutionFactor;
+    lock.unlock();
+
+    RenderScriptingInterface::getInstance()->setDynamicResolutionFactor(factor);
+}
+
+QVariantMap PerformanceManager::getDynamicResolution() const {
+    std::lock_guard<std::mutex> lock(_dynamicResolutionMutex);
+    QVariantMap result;
+    result["enabled"] = _dynamicResolutionSetting.get();
+    result["factor"] = _appliedDynamicResolutionFactor;
+    result["wantedFactor"] = _dynamicResolutionFactor;
+    result["minFactor"] = MIN_DYNAMIC_RESOLUTION_FACTOR;
+    result["resolutionScale"] = RenderScriptingInterface::getInstance()->getViewportResolutionScale() * _appliedDynamicResolutionFactor;
+    result["gpuTime"] = _dynamicResolutionGPUTime;
+    result["targetTime"] = _dynamicResolutionTargetTime;
+    return result;
+}
+
 void PerformanceManager::applyPerformancePreset(PerformanceManager::PerformancePreset preset) {
 
     // Ugly case that prevent us to run deferred everywhere...
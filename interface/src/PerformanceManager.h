@@ -12,8 +12,11 @@
 #ifndef hifi_PerformanceManager_h
 #define hifi_PerformanceManager_h
 
+#include <mutex>
 #include <string>
 
+#include <QtCore/QVariantMap>
+
 #include <SettingHandle.h>
 #include <shared/ReadWriteLockable.h>
 
@@ -38,10 +41,25 @@ public:
     void setPerformancePreset(PerformancePreset performancePreset);
     PerformancePreset getPerformancePreset() const;
 
+    // Dynamic resolution lowers the render resolution below the viewport resolution scale while the GPU takes longer
+    // than the frame time of the target frame rate, and brings it back up once there's room again
+    void setDynamicResolutionEnabled(bool enabled);
+    bool isDynamicResolutionEnabled() const;
+    // gpuTime is the average GPU time of the last frames in ms
+    void updateDynamicResolution(float deltaTime, float gpuTime, float targetFPS);
+    QVariantMap getDynamicResolution() const;
+
 private:
     mutable ReadWriteLockable _performancePresetSettingLock;
     Setting::Handle<int> _performancePresetSetting { "performancePreset", PerformanceManager::PerformancePreset::UNKNOWN };
 
+    mutable std::mutex _dynamicResolutionMutex;
+    Setting::Handle<bool> _dynamicResolutionSetting { "dynamicResolution", false };
+    float _dynamicResolutionFactor { 1.0f };         // smoothed, what the controller aims at
+    float _appliedDynamicResolutionFactor { 1.0f };  // in steps, what is rendered
+    float _dynamicResolutionGPUTime { 0.0f };
+    float _dynamicResolutionTargetTime { 0.0f };
+
     // The concrete performance preset changes
     void applyPerformancePreset(PerformanceManager::PerformancePreset performancePreset);
 };
@@ -12,11 +12,17 @@
 
 #include "RefreshRateManager.h"
 
+#include <algorithm>
 #include <array>
 
+#include <NumericalConstants.h>
+
 
 static const int VR_TARGET_RATE = 90;
 
+// a new frame presented this many refresh periods after the previous one missed at least one refresh
+static const float LATE_FRAME_PERIODS = 1.5f;
+
 /*@jsdoc
  * <p>Refresh rate profile.</p>
  * <table>
@@ -190,6 +196,22 @@ int RefreshRateManager::queryRefreshRateTarget(RefreshRateProfile profile, Refre
     return targetRefreshRate;
 }
 
+QJsonObject RefreshRateManager::getFramePacing() const {
+    QJsonObject framePacing;
+    LatencyHistogram latencies;
+    LatencyHistogram intervals;
+    if (!_framePacingOperator || !_framePacingOperator(latencies, intervals)) {
+        return framePacing;
+    }
+
+    uint64_t latePresentInterval = (uint64_t)(LATE_FRAME_PERIODS * USECS_PER_SECOND / std::max(_activeRefreshRate, 1));
+    framePacing["refreshRate"] = _activeRefreshRate;
+    framePacing["latency"] = latencies.toJson("usecs");
+    framePacing["presentInterval"] = intervals.toJson("usecs");
+    framePacing["lateFrames"] = (qint64)(intervals.getCount() - intervals.getCountAtOrBelow(latePresentInterval));
+    return framePacing;
+}
+
 void RefreshRateManager::updateRefreshRateController() const {
     if (_refreshRateOperator) {
         int targetRefreshRate = queryRefreshRateTarget(_refreshRateProfile, _refreshRateRegime, _uxMode);
@@ -16,8 +16,10 @@
 #include <string>
 #include <functional>
 
+#include <QtCore/QJsonObject>
 #include <QTimer>
 
+#include <LatencyHistogram.h>
 #include <SettingHandle.h>
 #include <shared/ReadWriteLockable.h>
 
@@ -95,6 +97,11 @@ public:
     int getActiveRefreshRate() const { return _activeRefreshRate; }
     void updateRefreshRateController() const;
 
+    using FramePacingOperator = std::function<bool(LatencyHistogram& latencies, LatencyHistogram& intervals)>;
+    void setFramePacingOperator(FramePacingOperator framePacingOperator) { _framePacingOperator = framePacingOperator; }
+    // the frame pacing of the display, with the number of new frames presented late for the active refresh rate
+    QJsonObject getFramePacing() const;
+
     // query the refresh rate target at the specified combination
     int queryRefreshRateTarget(RefreshRateProfile profile, RefreshRateRegime regime, UXMode uxMode) const;
 
@@ -116,6 +123,7 @@ private:
     Setting::Handle<int> _refreshRateProfileSetting { "refreshRateProfile", RefreshRateProfile::INTERACTIVE };
 
     std::function<void(int)> _refreshRateOperator { nullptr };
+    FramePacingOperator _framePacingOperator { nullptr };
 
     std::shared_ptr<QTimer> _inactiveTimer { std::make_shared<QTimer>() };
 };
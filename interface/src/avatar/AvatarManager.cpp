@@ -35,6 +35,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -251,7 +252,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         kNonHero,
         NumVariants
     };
-    AvatarPriorityQueue avatarPriorityQueues[NumVariants] = {
+    // kept from one frame to the next, so that their storage is reused
+    static AvatarPriorityQueue avatarPriorityQueues[NumVariants] = {
              { views,
                AvatarData::_avatarSortCoefficientSize,
                AvatarData::_avatarSortCoefficientCenter,
@@ -260,6 +262,12 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                AvatarData::_avatarSortCoefficientSize,
                AvatarData::_avatarSortCoefficientCenter,
                AvatarData::_avatarSortCoefficientAge } };
+    for (auto& avatarPriorityQueue : avatarPriorityQueues) {
+        avatarPriorityQueue.setViews(views);
+        avatarPriorityQueue.setWeights(AvatarData::_avatarSortCoefficientSize, AvatarData::_avatarSortCoefficientCenter,
+                                       AvatarData::_avatarSortCoefficientAge);
+        avatarPriorityQueue.clear();
+    }
     // Reserve space
     //avatarPriorityQueues[kHero].reserve(10);  // just few
     avatarPriorityQueues[kNonHero].reserve(avatarMap.size() - 1);  // don't include MyAvatar
@@ -296,6 +304,15 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
 
+    // the avatars within budget, whose joints are simulated all at once after the passes
+    struct SimulatedAvatar {
+        std::shared_ptr<OtherAvatar> avatar;
+        bool inView;
+        bool isConcurrent;
+    };
+    std::vector<SimulatedAvatar> simulatedAvatars;
+    simulatedAvatars.reserve(avatarMap.size());
+
     for (int p = kHero; p < NumVariants; p++) {
         auto& priorityQueue = avatarPriorityQueues[p];
         // Sorting the current queue HERE as part of the measured timing.
@@ -340,17 +357,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->_transit.reset();
                     avatar->setIsNewAvatar(false);
                 }
-                avatar->simulate(deltaTime, inView);
-                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
-                    _myAvatar->addAvatarHandsToFlow(avatar);
-                }
-                if (_drawOtherAvatarSkeletons) {
-                    avatar->debugJointData();
-                }
-                avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
-                avatar->updateRenderItem(renderTransaction);
-                avatar->updateSpaceProxy(workloadTransaction);
-                avatar->setLastRenderUpdateTime(startTime);
+                avatar->beginSimulation(deltaTime, inView);
+                simulatedAvatars.push_back({ avatar, inView, avatar->canSimulateJointsConcurrently() });
 
             } else {
                 // we've spent our time budget for this priority bucket
@@ -385,6 +393,42 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             numHerosUpdated = numAvatarsUpdated;
         }
     }
+    // don't keep the avatars alive until the next frame
+    for (auto& avatarPriorityQueue : avatarPriorityQueues) {
+        avatarPriorityQueue.clear();
+    }
+
+    {
+        // the joint unpacking, rig and skeleton model updates of each avatar only touch that avatar, so they run across the
+        // worker threads, with the main thread waiting for them
+        PerformanceTimer perfTimer("simulateJoints");
+        tbb::parallel_for((size_t)0, simulatedAvatars.size(), [&](size_t i) {
+            const auto& simulatedAvatar = simulatedAvatars[i];
+            if (simulatedAvatar.isConcurrent) {
+                simulatedAvatar.avatar->simulateJoints(deltaTime, simulatedAvatar.inView);
+            }
+        });
+        for (const auto& simulatedAvatar : simulatedAvatars) {
+            if (!simulatedAvatar.isConcurrent) {
+                simulatedAvatar.avatar->simulateJoints(deltaTime, simulatedAvatar.inView);
+            }
+        }
+    }
+
+    for (const auto& simulatedAvatar : simulatedAvatars) {
+        const auto& avatar = simulatedAvatar.avatar;
+        avatar->endSimulation(deltaTime, simulatedAvatar.inView);
+        if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
+            _myAvatar->addAvatarHandsToFlow(avatar);
+        }
+        if (_drawOtherAvatarSkeletons) {
+            avatar->debugJointData();
+        }
+        avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
+        avatar->updateRenderItem(renderTransaction);
+        avatar->updateSpaceProxy(workloadTransaction);
+        avatar->setLastRenderUpdateTime(startTime);
+    }
 
     if (_shouldRender) {
         qApp->getMain3DScene()->enqueueTransaction(renderTransaction);
@@ -2073,6 +2073,8 @@ void MyAvatar::loadData() {
     _fullAvatarModelName = _fullAvatarModelNameSetting.get(DEFAULT_FULL_AVATAR_MODEL_NAME).toString();
 
     useFullAvatarURL(_fullAvatarURLFromPreferences, _fullAvatarModelName);
+    // the skeleton model holds it now
+    _prefetchedFullAvatarModel.reset();
 
     loadAvatarEntityDataFromSettings();
 
@@ -2687,6 +2689,13 @@ void MyAvatar::resetFullAvatarURL() {
     useFullAvatarURL(lastAvatarURL, lastAvatarName);
 }
 
+void MyAvatar::prefetchFullAvatarModel() {
+    QUrl fullAvatarURL = _fullAvatarURLSetting.get(QUrl(AvatarData::defaultFullAvatarModelUrl()));
+    if (!fullAvatarURL.isEmpty()) {
+        _prefetchedFullAvatarModel = DependencyManager::get<ModelCache>()->getGeometryResource(fullAvatarURL);
+    }
+}
+
 void MyAvatar::useFullAvatarURL(const QUrl& fullAvatarURL, const QString& modelName) {
 
     if (QThread::currentThread() != thread()) {
@@ -6398,6 +6407,10 @@ float MyAvatar::getIKErrorOnLastSolve() const {
     return _skeletonModel->getRig().getIKErrorOnLastSolve();
 }
 
+int MyAvatar::getIKIterationsOnLastSolve() const {
+    return _skeletonModel->getRig().getIKIterationsOnLastSolve();
+}
+
 // thread-safe
 void MyAvatar::addHoldAction(AvatarActionHold* holdAction) {
     std::lock_guard<std::mutex> guard(_holdActionsMutex);
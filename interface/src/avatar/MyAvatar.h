@@ -24,6 +24,7 @@
 #include <controllers/Pose.h>
 #include <controllers/Actions.h>
 #include <EntityItem.h>
+#include <model-networking/ModelCache.h>
 #include <ThreadSafeValueCache.h>
 #include <Rig.h>
 #include <ScriptEngine.h>
@@ -1062,6 +1063,8 @@ public:
     void saveAvatarEntityDataToSettings();
     void loadData();
     void loadAvatarEntityDataFromSettings();
+    // starts loading the avatar model of the settings before loadData, while the rest of the startup runs
+    void prefetchFullAvatarModel();
 
     void saveAttachmentData(const AttachmentData& attachment) const;
     AttachmentData loadAttachmentData(const QUrl& modelURL, const QString& jointName = QString()) const;
@@ -1357,6 +1360,14 @@ public:
      */
     Q_INVOKABLE float getIKErrorOnLastSolve() const;
 
+    /*@jsdoc
+     * Gets the number of iterations the most recent inverse kinematics (IK) solution took.
+     * @function MyAvatar.getIKIterationsOnLastSolve
+     * @returns {number} The number of IK iterations, <code>0</code> if the previous solution was reused because the IK
+     *     targets and the underlying animation didn't change.
+     */
+    Q_INVOKABLE int getIKIterationsOnLastSolve() const;
+
     /*@jsdoc
      * Changes the user's avatar and associated descriptive name.
      * @function MyAvatar.useFullAvatarURL
@@ -3042,6 +3053,7 @@ private:
     Setting::Handle<float> _yawSpeedSetting;
     Setting::Handle<float> _pitchSpeedSetting;
     Setting::Handle<QUrl> _fullAvatarURLSetting;
+    GeometryResource::Pointer _prefetchedFullAvatarModel;
     Setting::Handle<QUrl> _fullAvatarModelNameSetting;
     Setting::Handle<QUrl> _animGraphURLSetting;
     Setting::Handle<QString> _displayNameSetting;
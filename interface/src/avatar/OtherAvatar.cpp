@@ -246,7 +246,57 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
 
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
+    beginSimulation(deltaTime, inView);
+    {
+        PerformanceTimer perfTimer("simulate");
+        simulateJoints(deltaTime, inView);
+    }
+    endSimulation(deltaTime, inView);
+}
+
+bool OtherAvatar::canSimulateJointsConcurrently() const {
+    return !_skeletonModel->isLoaded() || !_skeletonModel->getRig().jointStatesEmpty();
+}
+
+// the angular radius on screen under which an avatar's animation is reduced, and the margin above it to restore it, so
+// that an avatar at the limit doesn't pop between the two
+static const float REDUCED_ANIMATION_ANGULAR_RADIUS = 0.02f; // radians, a 1m avatar 50m away
+static const float MINIMAL_ANIMATION_ANGULAR_RADIUS = 0.005f; // radians, a 1m avatar 200m away
+static const float ANIMATION_LOD_HYSTERESIS = 1.25f;
+static const float REDUCED_ANIMATION_RATE = 30.0f; // Hz
+static const float MINIMAL_ANIMATION_RATE = 10.0f; // Hz
+
+void OtherAvatar::computeAnimationLOD(const glm::vec3& cameraPosition) {
+    float distance = glm::distance(cameraPosition, _globalPosition);
+    float angularRadius = distance > EPSILON ? getBoundingRadius() / distance : PI;
+
+    AnimationLOD newLOD = _animationLOD;
+    // lowered as soon as the avatar is smaller than a threshold, raised once it is clearly above it
+    if (angularRadius < MINIMAL_ANIMATION_ANGULAR_RADIUS) {
+        newLOD = AnimationLOD::MinimalAnimation;
+    } else if (angularRadius < REDUCED_ANIMATION_ANGULAR_RADIUS) {
+        if (newLOD == AnimationLOD::FullAnimation ||
+            angularRadius > ANIMATION_LOD_HYSTERESIS * MINIMAL_ANIMATION_ANGULAR_RADIUS) {
+            newLOD = AnimationLOD::ReducedAnimation;
+        }
+    } else if (angularRadius > ANIMATION_LOD_HYSTERESIS * REDUCED_ANIMATION_ANGULAR_RADIUS) {
+        newLOD = AnimationLOD::FullAnimation;
+    } else if (newLOD == AnimationLOD::MinimalAnimation) {
+        newLOD = AnimationLOD::ReducedAnimation;
+    }
 
+    // the avatars in the farthest workload regions are never fully animated
+    if ((_workloadRegion == workload::Region::R3 || _workloadRegion == workload::Region::R4) &&
+        newLOD == AnimationLOD::FullAnimation) {
+        newLOD = AnimationLOD::ReducedAnimation;
+    }
+    _animationLOD = newLOD;
+
+    // the avatars too small on screen to see their attachments or their shadows don't draw them
+    setDistantRendering(_animationLOD == AnimationLOD::MinimalAnimation);
+}
+
+void OtherAvatar::beginSimulation(float deltaTime, bool inView) {
     _globalPosition = _transit.isActive() ? _transit.getCurrentPosition() : _serverPosition;
     if (!hasParent()) {
         setLocalPosition(_globalPosition);
@@ -257,39 +307,70 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
         _simulationInViewRate.increment();
     }
 
-    PerformanceTimer perfTimer("simulate");
-    {
-        PROFILE_RANGE(simulation, "updateJoints");
-        if (inView) {
-            Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
-                _jointDataSimulationRate.increment();
+    if (!_skeletonModel->isLoaded()) {
+        // the nearer avatars are downloaded first, all of them still ahead of the entities, whose priority is <= PI / 2
+        float distance = glm::distance(qApp->getCamera().getPosition(), _globalPosition);
+        const float AVATAR_PRIORITY_RANGE = OTHERAVATAR_LOADING_PRIORITY - PI_OVER_TWO - EPSILON;
+        _skeletonModel->setLoadingPriority(OTHERAVATAR_LOADING_PRIORITY - AVATAR_PRIORITY_RANGE * atanf(distance) / PI_OVER_TWO);
+    }
 
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, true);
+    computeAnimationLOD(qApp->getCamera().getPosition());
+}
 
-                locationChanged(); // joints changed, so if there are any children, update them.
-                _hasNewJointData = false;
+void OtherAvatar::simulateJoints(float deltaTime, bool inView) {
+    PROFILE_RANGE(simulation, "updateJoints");
+    _jointsChanged = false;
 
-                glm::vec3 headPosition = getWorldPosition();
-                if (!_skeletonModel->getHeadPosition(headPosition)) {
-                    headPosition = getWorldPosition();
-                }
-                head->setPosition(headPosition);
-            } else {
+    // the joints of small avatars are applied less often, the latest ones received being kept until then
+    bool jointsUpdateDue = true;
+    uint64_t now = usecTimestampNow();
+    if (_animationLOD != AnimationLOD::FullAnimation) {
+        float rate = _animationLOD == AnimationLOD::ReducedAnimation ? REDUCED_ANIMATION_RATE : MINIMAL_ANIMATION_RATE;
+        jointsUpdateDue = now - _lastJointsUpdateTime >= (uint64_t)(USECS_PER_SECOND / rate);
+    }
+
+    if (inView) {
+        Head* head = getHead();
+        if ((_hasNewJointData || _transit.isActive()) && jointsUpdateDue) {
+            _lastJointsUpdateTime = now;
+            _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+            glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+            _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            _jointDataSimulationRate.increment();
+
+            if (_animationLOD != AnimationLOD::MinimalAnimation) {
                 head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, false);
             }
-            head->setScale(getModelScale());
-            relayJointDataToChildren();
+            _skeletonModel->simulate(deltaTime, true);
+
+            _jointsChanged = true;
+            _hasNewJointData = false;
+
+            glm::vec3 headPosition = getWorldPosition();
+            if (!_skeletonModel->getHeadPosition(headPosition)) {
+                headPosition = getWorldPosition();
+            }
+            head->setPosition(headPosition);
         } else {
-            // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+            if (_animationLOD != AnimationLOD::MinimalAnimation) {
+                head->simulate(deltaTime);
+            }
             _skeletonModel->simulate(deltaTime, false);
         }
-        _skeletonModelSimulationRate.increment();
+        head->setScale(getModelScale());
+    } else {
+        // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+        _skeletonModel->simulate(deltaTime, false);
+    }
+    _skeletonModelSimulationRate.increment();
+}
+
+void OtherAvatar::endSimulation(float deltaTime, bool inView) {
+    if (_jointsChanged) {
+        locationChanged(); // joints changed, so if there are any children, update them.
+    }
+    if (inView) {
+        relayJointDataToChildren();
     }
 
     // update animation for display name fade in/out
@@ -32,6 +32,13 @@ public:
         MultiSphereHigh // All joints
     };
 
+    // How often the joints received for the avatar are applied to its skeleton, from its size on screen
+    enum AnimationLOD {
+        FullAnimation = 0, // every update received
+        ReducedAnimation, // at most REDUCED_ANIMATION_RATE, with the latest joints received
+        MinimalAnimation // at most MINIMAL_ANIMATION_RATE, without the procedural head animations, and rendered distant
+    };
+
     virtual void instantiableAvatar() override { };
     virtual void createOrb() override;
     virtual void indicateLoadingStatus(LoadingStatus loadingStatus) override;
@@ -57,6 +64,8 @@ public:
     void forgetDetailedMotionStates();
     BodyLOD getBodyLOD() { return _bodyLOD; }
     void computeShapeLOD();
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+    void computeAnimationLOD(const glm::vec3& cameraPosition);
 
     void updateCollisionGroup(bool myAvatarCollide);
     bool getCollideWithOtherAvatars() const { return _collideWithOtherAvatars; } 
@@ -64,6 +73,15 @@ public:
     void setCollisionWithOtherAvatarsFlags() override;
 
     void simulate(float deltaTime, bool inView) override;
+
+    // simulate() in three steps: the joints step only touches this avatar and its skeleton model, so that AvatarManager can
+    // run it for several avatars at once on worker threads, between the other two steps on the main thread
+    void beginSimulation(float deltaTime, bool inView);
+    void simulateJoints(float deltaTime, bool inView);
+    void endSimulation(float deltaTime, bool inView);
+    // the joints of a skeleton model whose rig isn't set up yet are simulated on the main thread, which is that of the rig's signals
+    bool canSimulateJointsConcurrently() const;
+
     void debugJointData() const;
     friend AvatarManager;
 
@@ -91,6 +109,9 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+    bool _jointsChanged { false };
+    AnimationLOD _animationLOD { AnimationLOD::FullAnimation };
+    uint64_t _lastJointsUpdateTime { 0 };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
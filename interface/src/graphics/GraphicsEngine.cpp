@@ -202,6 +202,8 @@ void GraphicsEngine::render_performFrame() {
     ViewFrustum viewFrustum;
 
     bool isStereo;
+    uint64_t simulationTime;
+    std::vector<tracing::TraceID> traceIDs;
     glm::mat4  stereoEyeOffsets[2];
     glm::mat4  stereoEyeProjections[2];
 
@@ -218,6 +220,8 @@ void GraphicsEngine::render_performFrame() {
         eyeToWorld = _appRenderArgs._eyeToWorld;
         sensorToWorld = _appRenderArgs._sensorToWorld;
         isStereo = _appRenderArgs._isStereo;
+        simulationTime = _appRenderArgs._simulationTime;
+        traceIDs.swap(_appRenderArgs._traceIDs);
         for_each_eye([&](Eye eye) {
             stereoEyeOffsets[eye] = _appRenderArgs._eyeOffsets[eye];
             stereoEyeProjections[eye] = _appRenderArgs._eyeProjections[eye];
@@ -289,6 +293,7 @@ void GraphicsEngine::render_performFrame() {
 
     auto frame = getGPUContext()->endFrame();
     frame->frameIndex = _renderFrameCount;
+    frame->simulationTime = simulationTime;
     frame->framebuffer = finalFramebuffer;
     frame->framebufferRecycler = [](const gpu::FramebufferPointer& framebuffer) {
         auto frameBufferCache = DependencyManager::get<FramebufferCache>();
@@ -302,9 +307,14 @@ void GraphicsEngine::render_performFrame() {
         PROFILE_RANGE(render, "/pluginOutput");
         PerformanceTimer perfTimer("pluginOutput");
         _renderLoopCounter.increment();
+        frame->submitTime = usecTimestampNow();
         displayPlugin->submitFrame(frame);
     }
 
+    for (auto traceID : traceIDs) {
+        tracing::traceFlow(trace_render(), "Frame submitted", tracing::FlowEnd, traceID);
+    }
+
     // Reset the framebuffer and stereo state
     renderArgs._blitFramebuffer.reset();
     renderArgs._context->enableStereo(false);
@@ -18,6 +18,7 @@
 #include <procedural/ProceduralSkybox.h>
 
 #include <OctreeConstants.h>
+#include <Trace.h>
 #include <shared/RateCounter.h>
 
 #include "FrameTimingsScriptingInterface.h"
@@ -33,6 +34,8 @@ struct AppRenderArgs {
     glm::mat4 _sensorToWorld;
     float _sensorToWorldScale{ 1.0f };
     bool _isStereo{ false };
+    uint64_t _simulationTime{ 0 };
+    std::vector<tracing::TraceID> _traceIDs; // of the data that the frame shows
 };
 
 using RenderArgsEditor = std::function <void(AppRenderArgs&)>;
@@ -172,10 +172,11 @@ int main(int argc, const char* argv[]) {
         }
     }
 
-    // Early check for --traceFile argument 
+    // Early check for --traceFile and --traceSampleRate arguments
     auto tracer = DependencyManager::set<tracing::Tracer>();
     const char * traceFile = nullptr;
     const QString traceFileFlag("--traceFile");
+    const QString traceSampleRateFlag("--traceSampleRate");
     float traceDuration = 0.0f;
     for (int a = 1; a < argc; ++a) {
         if (traceFileFlag == argv[a] && argc > a + 1) {
@@ -183,7 +184,9 @@ int main(int argc, const char* argv[]) {
             if (argc > a + 2) {
                 traceDuration = atof(argv[a + 2]);
             }
-            break;
+        } else if (traceSampleRateFlag == argv[a] && argc > a + 1) {
+            // the fraction of the avatar updates that are followed through the avatar mixer to the other clients
+            tracer->setSampleRate(atof(argv[a + 1]));
         }
     }
     if (traceFile != nullptr) {
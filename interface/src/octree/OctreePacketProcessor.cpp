@@ -24,7 +24,8 @@ OctreePacketProcessor::OctreePacketProcessor():
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     const PacketReceiver::PacketTypeList octreePackets =
-        { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase, PacketType::EntityQueryInitialResultsComplete };
+        { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase, PacketType::EntityQueryInitialResultsComplete,
+          PacketType::EntityCompressionDictionary };
     packetReceiver.registerDirectListenerForTypes(octreePackets,
         PacketReceiver::makeSourcedListenerReference<OctreePacketProcessor>(this, &OctreePacketProcessor::handleOctreePacket));
 }
@@ -62,7 +63,7 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
         
         if (piggybackBytes) {
             // construct a new packet from the piggybacked one
-            auto buffer = std::unique_ptr<char[]>(new char[piggybackBytes]);
+            auto buffer = udt::PacketBufferPool::allocate(piggybackBytes);
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggybackBytes);
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggybackBytes, message->getSenderSockAddr());
             message = QSharedPointer<ReceivedMessage>::create(*newPacket);
@@ -92,7 +93,7 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
         return; // bail since piggyback version doesn't match
     }
 
-    if (packetType != PacketType::EntityQueryInitialResultsComplete) {
+    if (packetType != PacketType::EntityQueryInitialResultsComplete && packetType != PacketType::EntityCompressionDictionary) {
         qApp->trackIncomingOctreePacket(*message, sendingNode, wasStatsPacket);
     }
     
@@ -134,6 +135,13 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
             }
         } break;
 
+        case PacketType::EntityCompressionDictionary: {
+            auto renderer = qApp->getEntities();
+            if (renderer) {
+                renderer->processCompressionDictionaryMessage(*message);
+            }
+        } break;
+
         default: {
             // nothing to do
         } break;
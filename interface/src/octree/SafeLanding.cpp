@@ -11,6 +11,7 @@
 
 #include "SafeLanding.h"
 #include <SharedUtil.h>
+#include <ResourceCache.h>
 
 #include "EntityTreeRenderer.h"
 #include "RenderableModelEntityItem.h"
@@ -146,6 +147,10 @@ void SafeLanding::updateTracking() {
                      ((distance(startIter, endIter) == sequenceSize - 1) || !missingSequenceNumbers)));
             }
             if (shouldStop) {
+                // the time from arriving to the first frame with everything nearby usable
+                qCDebug(interfaceapp) << "Safe landing took" << (usecTimestampNow() - _startTime) / USECS_PER_MSEC << "ms for"
+                    << _maxTrackedEntityCount << "entities," << ResourceCache::getLoadingRequestCount() << "downloads still loading and"
+                    << ResourceCache::getPendingRequestCount() << "pending";
                 stopTracking();
             }
         }
@@ -15,6 +15,11 @@
 #include "DependencyManager.h"
 #include "PickManager.h"
 
+#include <TBBHelpers.h>
+
+// fewer parabolas than this are intersected on the main thread
+const size_t MIN_PARALLEL_ENTITY_PARABOLAS = 4;
+
 ParabolaPick::ParabolaPick(const glm::vec3& position, const glm::vec3& direction, float speed, const glm::vec3& accelerationAxis, bool rotateAccelerationWithAvatar, bool rotateAccelerationWithParent, bool scaleWithParent, const PickFilter& filter, float maxDistance, bool enabled) :
     Pick(PickParabola(position, speed * direction, accelerationAxis), filter, maxDistance, enabled),
     _rotateAccelerationWithAvatar(rotateAccelerationWithAvatar),
@@ -81,6 +86,21 @@ PickResultPointer ParabolaPick::getEntityIntersection(const PickParabola& pick)
     return std::make_shared<ParabolaPickResult>(pick.toVariantMap());
 }
 
+// Unlike the rays, the parabolas can't share a walk of the tree, so they are each intersected on a TBB worker instead.
+// The entity tree is only read there, under its read lock.
+void ParabolaPick::getEntityIntersections(const std::vector<Pick<PickParabola>*>& picks, const std::vector<PickParabola>& mathPicks,
+                                          std::vector<PickResultPointer>& results) {
+    if (picks.size() < MIN_PARALLEL_ENTITY_PARABOLAS) {
+        Pick<PickParabola>::getEntityIntersections(picks, mathPicks, results);
+        return;
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, picks.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            results[i] = picks[i]->getEntityIntersection(mathPicks[i]);
+        }
+    });
+}
+
 PickResultPointer ParabolaPick::getAvatarIntersection(const PickParabola& pick) {
     if (glm::length2(pick.acceleration) > EPSILON && glm::length2(pick.velocity) > EPSILON) {
         ParabolaToAvatarIntersectionResult avatarRes = DependencyManager::get<AvatarManager>()->findParabolaIntersectionVector(pick, getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>());
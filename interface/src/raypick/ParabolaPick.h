@@ -98,6 +98,8 @@ public:
 
     PickResultPointer getDefaultResult(const QVariantMap& pickVariant) const override { return std::make_shared<ParabolaPickResult>(pickVariant); }
     PickResultPointer getEntityIntersection(const PickParabola& pick) override;
+    void getEntityIntersections(const std::vector<Pick<PickParabola>*>& picks, const std::vector<PickParabola>& mathPicks,
+                                std::vector<PickResultPointer>& results) override;
     PickResultPointer getAvatarIntersection(const PickParabola& pick) override;
     PickResultPointer getHUDIntersection(const PickParabola& pick) override;
     Transform getResultTransform() const override;
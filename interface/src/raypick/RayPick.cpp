@@ -25,16 +25,43 @@ PickRay RayPick::getMathematicalPick() const {
     return PickRay(origin, direction);
 }
 
-PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
+PickFilter RayPick::getEntitySearchFilter() const {
     PickFilter searchFilter = getFilter();
     if (DependencyManager::get<PickManager>()->getForceCoarsePicking()) {
         searchFilter.setFlag(PickFilter::COARSE, true);
         searchFilter.setFlag(PickFilter::PRECISE, false);
     }
+    return searchFilter;
+}
 
+PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
     RayToEntityIntersectionResult entityRes =
-        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVector(pick, searchFilter,
+        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVector(pick, getEntitySearchFilter(),
             getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>());
+    return getEntityResult(pick, entityRes);
+}
+
+// The rays of the pointers mostly start from the hands and the head, they are tested together in one walk of the tree.
+void RayPick::getEntityIntersections(const std::vector<Pick<PickRay>*>& picks, const std::vector<PickRay>& mathPicks,
+                                     std::vector<PickResultPointer>& results) {
+    std::vector<EntityTree::RayPick> entityPicks(picks.size());
+    for (size_t i = 0; i < picks.size(); i++) {
+        auto rayPick = static_cast<RayPick*>(picks[i]);
+        EntityTree::RayPick& entityPick = entityPicks[i];
+        entityPick.origin = mathPicks[i].origin;
+        entityPick.direction = mathPicks[i].direction;
+        entityPick.entityIdsToInclude = rayPick->getIncludeItemsAs<EntityItemID>();
+        entityPick.entityIdsToDiscard = rayPick->getIgnoreItemsAs<EntityItemID>();
+        entityPick.searchFilter = rayPick->getEntitySearchFilter();
+    }
+
+    auto entityResults = DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVectors(entityPicks);
+    for (size_t i = 0; i < picks.size(); i++) {
+        results[i] = static_cast<RayPick*>(picks[i])->getEntityResult(mathPicks[i], entityResults[i]);
+    }
+}
+
+PickResultPointer RayPick::getEntityResult(const PickRay& pick, const RayToEntityIntersectionResult& entityRes) const {
     if (entityRes.intersects) {
         IntersectionType type = IntersectionType::ENTITY;
         if (getFilter().doesPickLocalEntities()) {
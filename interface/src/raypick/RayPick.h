@@ -12,6 +12,7 @@
 #include <Pick.h>
 
 class EntityItemID;
+class RayToEntityIntersectionResult;
 
 class RayPickResult : public PickResult {
 public:
@@ -94,6 +95,8 @@ public:
 
     PickResultPointer getDefaultResult(const QVariantMap& pickVariant) const override { return std::make_shared<RayPickResult>(pickVariant); }
     PickResultPointer getEntityIntersection(const PickRay& pick) override;
+    void getEntityIntersections(const std::vector<Pick<PickRay>*>& picks, const std::vector<PickRay>& mathPicks,
+                                std::vector<PickResultPointer>& results) override;
     PickResultPointer getAvatarIntersection(const PickRay& pick) override;
     PickResultPointer getHUDIntersection(const PickRay& pick) override;
     Transform getResultTransform() const override;
@@ -106,6 +109,9 @@ public:
     static glm::vec2 projectOntoXZPlane(const glm::vec3& worldPos, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& dimensions, const glm::vec3& registrationPoint, bool unNoemalized);
 
 private:
+    PickFilter getEntitySearchFilter() const;
+    PickResultPointer getEntityResult(const PickRay& pick, const RayToEntityIntersectionResult& entityRes) const;
+
     static glm::vec3 intersectRayWithXYPlane(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& point, const glm::quat& rotation, const glm::vec3& registration);
 };
 
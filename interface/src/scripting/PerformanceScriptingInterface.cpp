@@ -51,6 +51,25 @@ int PerformanceScriptingInterface::getActiveRefreshRate() const {
     return qApp->getRefreshRateManager().getActiveRefreshRate();
 }
 
+QVariantMap PerformanceScriptingInterface::getFramePacing() const {
+    return qApp->getRefreshRateManager().getFramePacing().toVariantMap();
+}
+
+void PerformanceScriptingInterface::setDynamicResolutionEnabled(bool enabled) {
+    if (getDynamicResolutionEnabled() != enabled) {
+        qApp->getPerformanceManager().setDynamicResolutionEnabled(enabled);
+        emit settingsChanged();
+    }
+}
+
+bool PerformanceScriptingInterface::getDynamicResolutionEnabled() const {
+    return qApp->getPerformanceManager().isDynamicResolutionEnabled();
+}
+
+QVariantMap PerformanceScriptingInterface::getDynamicResolution() const {
+    return qApp->getPerformanceManager().getDynamicResolution();
+}
+
 RefreshRateManager::UXMode PerformanceScriptingInterface::getUXMode() const {
     return qApp->getRefreshRateManager().getUXMode();
 }
@@ -29,11 +29,15 @@
  *
  * @property {Performance.PerformancePreset} performancePreset - The current graphics performance preset.
  * @property {Performance.RefreshRateProfile} refreshRateProfile - The current refresh rate profile.
+ * @property {boolean} dynamicResolutionEnabled - <code>true</code> if the render resolution is lowered below 
+ *     {@link Render|Render.viewportResolutionScale} while the GPU can't keep up with the target frame rate, 
+ *     <code>false</code> if it isn't.
  */
 class PerformanceScriptingInterface : public QObject {
     Q_OBJECT
     Q_PROPERTY(PerformancePreset performancePreset READ getPerformancePreset WRITE setPerformancePreset NOTIFY settingsChanged)
     Q_PROPERTY(RefreshRateProfile refreshRateProfile READ getRefreshRateProfile WRITE setRefreshRateProfile NOTIFY settingsChanged)
+    Q_PROPERTY(bool dynamicResolutionEnabled READ getDynamicResolutionEnabled WRITE setDynamicResolutionEnabled NOTIFY settingsChanged)
 
 public:
 
@@ -161,6 +165,58 @@ public slots:
      */
     RefreshRateManager::RefreshRateRegime getRefreshRateRegime() const;
 
+    /*@jsdoc
+     * Gets the pacing of the frames presented to the display since Interface started or since the last 
+     * {@link FrameTimings.start}.
+     * @function Performance.getFramePacing
+     * @returns {Performance.FramePacing} The frame pacing, or an empty object if the display doesn't track it.
+     */
+    /*@jsdoc
+     * <p>The pacing of the frames presented to the display. The times are in microseconds.</p>
+     * @typedef {object} Performance.FramePacing
+     * @property {number} refreshRate - The current target refresh rate, in Hz.
+     * @property {object} latency - The count, mean, max and the 50th, 90th, 99th and 99.9th percentiles of the times from 
+     *     the start of the simulation of each new frame to its present.
+     * @property {object} presentInterval - The same statistics of the times between the presents of new frames.
+     * @property {number} lateFrames - The number of new frames presented more than one and a half refresh periods after 
+     *     the previous one.
+     */
+    QVariantMap getFramePacing() const;
+
+    /*@jsdoc
+     * Sets whether the render resolution is lowered while the GPU can't keep up with the target frame rate.
+     * @function Performance.setDynamicResolutionEnabled
+     * @param {boolean} enabled - <code>true</code> to scale the render resolution with the GPU time, <code>false</code> 
+     *     to render at the viewport resolution scale.
+     */
+    void setDynamicResolutionEnabled(bool enabled);
+
+    /*@jsdoc
+     * Gets whether the render resolution is lowered while the GPU can't keep up with the target frame rate.
+     * @function Performance.getDynamicResolutionEnabled
+     * @returns {boolean} <code>true</code> if the render resolution scales with the GPU time, <code>false</code> if it 
+     *     doesn't.
+     */
+    bool getDynamicResolutionEnabled() const;
+
+    /*@jsdoc
+     * Gets the state of the dynamic resolution.
+     * @function Performance.getDynamicResolution
+     * @returns {Performance.DynamicResolution} The state of the dynamic resolution.
+     */
+    /*@jsdoc
+     * <p>The state of the dynamic resolution. The times are in milliseconds.</p>
+     * @typedef {object} Performance.DynamicResolution
+     * @property {boolean} enabled - <code>true</code> if the dynamic resolution is enabled.
+     * @property {number} factor - The factor of the viewport resolution scale rendered at, in steps of 0.05.
+     * @property {number} wantedFactor - The smoothed factor the GPU time asks for.
+     * @property {number} minFactor - The lowest factor.
+     * @property {number} resolutionScale - The resolution scale rendered at.
+     * @property {number} gpuTime - The average GPU time of the last frames.
+     * @property {number} targetTime - The GPU time aimed at, under the frame time of the target frame rate.
+     */
+    QVariantMap getDynamicResolution() const;
+
 signals:
 
     /*@jsdoc
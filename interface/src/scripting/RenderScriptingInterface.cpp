@@ -31,6 +31,7 @@ void RenderScriptingInterface::loadSettings() {
         _ambientOcclusionEnabled = (_ambientOcclusionEnabledSetting.get());
         _antialiasingEnabled = (_antialiasingEnabledSetting.get());
         _viewportResolutionScale = (_viewportResolutionScaleSetting.get());
+        _foveatedRenderingEnabled = (_foveatedRenderingEnabledSetting.get());
     });
     forceRenderMethod((RenderMethod)_renderMethod);
     forceShadowsEnabled(_shadowsEnabled);
@@ -173,18 +174,56 @@ void RenderScriptingInterface::forceViewportResolutionScale(float scale) {
     _renderSettingLock.withWriteLock([&] {
         _viewportResolutionScale = (scale);
         _viewportResolutionScaleSetting.set(scale);
+        applyResolutionScale();
+    });
+}
 
-        auto renderConfig = qApp->getRenderEngine()->getConfiguration();
-        assert(renderConfig);
-        auto deferredView = renderConfig->getConfig("RenderMainView.RenderDeferredTask");
-        // mainView can be null if we're rendering in forward mode
-        if (deferredView) {
-            deferredView->setProperty("resolutionScale", _viewportResolutionScale);
-        }
-        auto forwardView = renderConfig->getConfig("RenderMainView.RenderForwardTask");
-        // mainView can be null if we're rendering in forward mode
-        if (forwardView) {
-            forwardView->setProperty("resolutionScale", _viewportResolutionScale);
+void RenderScriptingInterface::setDynamicResolutionFactor(float factor) {
+    if (factor <= 0.f) {
+        return;
+    }
+    _renderSettingLock.withWriteLock([&] {
+        if (_dynamicResolutionFactor != factor) {
+            _dynamicResolutionFactor = factor;
+            applyResolutionScale();
         }
     });
 }
+
+float RenderScriptingInterface::getDynamicResolutionFactor() const {
+    return _renderSettingLock.resultWithReadLock<float>([&] {
+        return _dynamicResolutionFactor;
+    });
+}
+
+void RenderScriptingInterface::applyResolutionScale() {
+    float resolutionScale = _viewportResolutionScale * _dynamicResolutionFactor;
+
+    auto renderConfig = qApp->getRenderEngine()->getConfiguration();
+    assert(renderConfig);
+    auto deferredView = renderConfig->getConfig("RenderMainView.RenderDeferredTask");
+    // mainView can be null if we're rendering in forward mode
+    if (deferredView) {
+        deferredView->setProperty("resolutionScale", resolutionScale);
+    }
+    auto forwardView = renderConfig->getConfig("RenderMainView.RenderForwardTask");
+    // mainView can be null if we're rendering in forward mode
+    if (forwardView) {
+        forwardView->setProperty("resolutionScale", resolutionScale);
+    }
+}
+
+bool RenderScriptingInterface::getFoveatedRenderingEnabled() const {
+    return _foveatedRenderingEnabled;
+}
+
+void RenderScriptingInterface::setFoveatedRenderingEnabled(bool enabled) {
+    if (_foveatedRenderingEnabled != enabled) {
+        // read by Application when it sets up the render args of each frame
+        _renderSettingLock.withWriteLock([&] {
+            _foveatedRenderingEnabled = (enabled);
+            _foveatedRenderingEnabledSetting.set(enabled);
+        });
+        emit settingsChanged();
+    }
+}
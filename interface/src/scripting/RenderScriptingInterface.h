@@ -29,6 +29,9 @@
  *     disabled.
  * @property {boolean} antialiasingEnabled - <code>true</code> if anti-aliasing is enabled, <code>false</code> if it's disabled.
  * @property {number} viewportResolutionScale - The view port resolution scale, <code>&gt; 0.0</code>.
+ * @property {boolean} foveatedRenderingEnabled - <code>true</code> if the periphery of the view is rendered at a lower 
+ *     resolution in HMD mode, around where the HMD reports the user is looking if it tracks the eyes, <code>false</code> 
+ *     if the whole view is rendered at full resolution.
  */
 class RenderScriptingInterface : public QObject {
     Q_OBJECT
@@ -37,6 +40,7 @@ class RenderScriptingInterface : public QObject {
     Q_PROPERTY(bool ambientOcclusionEnabled READ getAmbientOcclusionEnabled WRITE setAmbientOcclusionEnabled NOTIFY settingsChanged)
     Q_PROPERTY(bool antialiasingEnabled READ getAntialiasingEnabled WRITE setAntialiasingEnabled NOTIFY settingsChanged)
     Q_PROPERTY(float viewportResolutionScale READ getViewportResolutionScale WRITE setViewportResolutionScale NOTIFY settingsChanged)
+    Q_PROPERTY(bool foveatedRenderingEnabled READ getFoveatedRenderingEnabled WRITE setFoveatedRenderingEnabled NOTIFY settingsChanged)
 
 public:
     RenderScriptingInterface();
@@ -66,6 +70,11 @@ public:
     Q_ENUM(RenderMethod)
     static bool isValidRenderMethod(RenderMethod value) { return (value >= RenderMethod::DEFERRED && value <= RenderMethod::FORWARD); }
 
+    // The dynamic resolution of the PerformanceManager renders at this factor of the viewport resolution scale,
+    // without changing the setting
+    void setDynamicResolutionFactor(float factor);
+    float getDynamicResolutionFactor() const;
+
 
     // Load Settings
     // Synchronize the runtime value to the actual setting
@@ -170,6 +179,20 @@ public slots:
      */
     void setViewportResolutionScale(float resolutionScale);
 
+    /*@jsdoc
+     * Gets whether or not foveated rendering is enabled.
+     * @function Render.getFoveatedRenderingEnabled
+     * @returns {boolean} <code>true</code> if foveated rendering is enabled, <code>false</code> if it's disabled.
+     */
+    bool getFoveatedRenderingEnabled() const;
+
+    /*@jsdoc
+     * Sets whether or not the periphery of the view is rendered at a lower resolution in HMD mode.
+     * @function Render.setFoveatedRenderingEnabled
+     * @param {boolean} enabled - <code>true</code> to enable foveated rendering, <code>false</code> to disable.
+     */
+    void setFoveatedRenderingEnabled(bool enabled);
+
 signals:
     
     /*@jsdoc
@@ -194,6 +217,8 @@ private:
     bool _ambientOcclusionEnabled{ false };
     bool _antialiasingEnabled{ true };
     float _viewportResolutionScale{ 1.0f };
+    float _dynamicResolutionFactor{ 1.0f };
+    bool _foveatedRenderingEnabled{ false };
 
     // Actual settings saved on disk
     Setting::Handle<int> _renderMethodSetting { "renderMethod", RENDER_FORWARD ? render::Args::RenderMethod::FORWARD : render::Args::RenderMethod::DEFERRED };
@@ -201,6 +226,7 @@ private:
     Setting::Handle<bool> _ambientOcclusionEnabledSetting { "ambientOcclusionEnabled", false };
     Setting::Handle<bool> _antialiasingEnabledSetting { "antialiasingEnabled", true };
     Setting::Handle<float> _viewportResolutionScaleSetting { "viewportResolutionScale", 1.0f };
+    Setting::Handle<bool> _foveatedRenderingEnabledSetting { "foveatedRenderingEnabled", false };
 
     // Force assign both setting AND runtime value to the parameter value
     void forceRenderMethod(RenderMethod renderMethod);
@@ -209,6 +235,9 @@ private:
     void forceAntialiasingEnabled(bool enabled);
     void forceViewportResolutionScale(float scale);
 
+    // Sets the resolution scale of the render tasks, under the lock
+    void applyResolutionScale();
+
     static std::once_flag registry_flag;
 };
 
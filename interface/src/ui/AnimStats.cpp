@@ -109,6 +109,13 @@ void AnimStats::updateStats(bool force) {
     _networkGraphText = QString("Network Graph: %1").arg(networkGraphActive ? "enabled" : "disabled");
     emit networkGraphTextChanged();
 
+    // print current ikText
+    const Rig& rig = myAvatar->getSkeletonModel()->getRig();
+    _ikText = QString("IK: %1 iterations, error %2").
+        arg(rig.getIKIterationsOnLastSolve()).
+        arg(QString::number(rig.getIKErrorOnLastSolve(), 'f', 4));
+    emit ikTextChanged();
+
     // update animation debug alpha values
     QStringList newAnimAlphaValues;
     qint64 now = usecTimestampNow();
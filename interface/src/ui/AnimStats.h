@@ -28,6 +28,7 @@ class AnimStats : public QQuickItem {
     Q_PROPERTY(QString overrideJointText READ overrideJointText NOTIFY overrideJointTextChanged)
     Q_PROPERTY(QString flowText READ flowText NOTIFY flowTextChanged)
     Q_PROPERTY(QString networkGraphText READ networkGraphText NOTIFY networkGraphTextChanged)
+    Q_PROPERTY(QString ikText READ ikText NOTIFY ikTextChanged)
 
 public:
     static AnimStats* getInstance();
@@ -49,6 +50,7 @@ public:
     QString overrideJointText() const { return _overrideJointText; }
     QString flowText() const { return _flowText; }
     QString networkGraphText() const { return _networkGraphText; }
+    QString ikText() const { return _ikText; }
 
 public slots:
     void forceUpdateStats() { updateStats(true); }
@@ -67,6 +69,7 @@ signals:
     void overrideJointTextChanged();
     void flowTextChanged();
     void networkGraphTextChanged();
+    void ikTextChanged();
 
 private:
     QStringList _animAlphaValues;
@@ -88,6 +91,7 @@ private:
     QString _overrideJointText;
     QString _flowText;
     QString _networkGraphText;
+    QString _ikText;
 };
 
 #endif // hifi_AnimStats_h
@@ -8,6 +8,7 @@
 
 #include "Stats.h"
 
+#include <algorithm>
 #include <queue>
 #include <sstream>
 #include <QFontDatabase>
@@ -22,7 +23,11 @@
 #include <Application.h>
 #include <AudioClient.h>
 #include <GeometryCache.h>
+#include <HTTPResourceRequest.h>
 #include <LODManager.h>
+#include <MemoryAccounting.h>
+#include <Model.h>
+#include <NumericalConstants.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
@@ -173,6 +178,11 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(rayPicksUpdated, updatedPicks[PickQuery::Ray]);
         STAT_UPDATE(parabolaPicksUpdated, updatedPicks[PickQuery::Parabola]);
         STAT_UPDATE(collisionPicksUpdated, updatedPicks[PickQuery::Collision]);
+        std::vector<uint64_t> pickTimes = pickManager->getPickUpdateTimes();
+        STAT_UPDATE_FLOAT(stylusPicksTime, (float)pickTimes[PickQuery::Stylus] / (float)USECS_PER_MSEC, 0.01f);
+        STAT_UPDATE_FLOAT(rayPicksTime, (float)pickTimes[PickQuery::Ray] / (float)USECS_PER_MSEC, 0.01f);
+        STAT_UPDATE_FLOAT(parabolaPicksTime, (float)pickTimes[PickQuery::Parabola] / (float)USECS_PER_MSEC, 0.01f);
+        STAT_UPDATE_FLOAT(collisionPicksTime, (float)pickTimes[PickQuery::Collision] / (float)USECS_PER_MSEC, 0.01f);
     }
 
     STAT_UPDATE(packetInCount, nodeList->getInboundPPS());
@@ -314,6 +324,25 @@ void Stats::updateStats(bool force) {
             }
             emit downloadUrlsChanged();
         }
+
+        // The origins downloaded from the most
+        static const int MAX_DOWNLOAD_ORIGINS = 8;
+        auto originStats = HTTPResourceRequest::getOriginStats();
+        auto origins = originStats.keys();
+        std::sort(origins.begin(), origins.end(), [&](const QString& a, const QString& b) {
+            return originStats[a].requests > originStats[b].requests;
+        });
+        QStringList downloadOrigins;
+        for (int i = 0; i < std::min(origins.size(), MAX_DOWNLOAD_ORIGINS); i++) {
+            const auto& stats = originStats[origins[i]];
+            downloadOrigins << QString("%1: %2 requests (%3 shared, %4 failed), %5 MB%6").arg(origins[i])
+                .arg(stats.requests).arg(stats.sharedRequests).arg(stats.failedRequests)
+                .arg((double)stats.bytesReceived / (BYTES_PER_KILOBYTE * BYTES_PER_KILOBYTE), 0, 'f', 1).arg(stats.usedHTTP2 ? ", HTTP/2" : "");
+        }
+        if (downloadOrigins != _downloadOrigins) {
+            _downloadOrigins = downloadOrigins;
+            emit downloadOriginsChanged();
+        }
         // TODO fix to match original behavior
         //stringstream downloads;
         //downloads << "Downloads: ";
@@ -410,8 +439,30 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(gpuTextureMemoryPressureState, getTextureMemoryPressureModeString());
 #endif
         STAT_UPDATE(gpuFreeMemory, (int)BYTES_TO_MB(gpu::Context::getFreeGPUMemSize()));
+
+        {
+            static const size_t MAX_MEMORY_USAGE_LINES = 6;
+            auto usages = MemoryAccounting::getInstance().sample();
+            int64_t accountedBytes = 0;
+            for (const auto& usage : usages) {
+                accountedBytes += usage.bytes;
+            }
+            std::sort(usages.begin(), usages.end(), [](const MemoryAccounting::Usage& a, const MemoryAccounting::Usage& b) {
+                return a.bytes > b.bytes;
+            });
+            QStringList lines;
+            for (size_t i = 0; i < usages.size() && i < MAX_MEMORY_USAGE_LINES && usages[i].bytes > 0; ++i) {
+                lines << QString("%1: %2 MB").arg(usages[i].name).arg((int)BYTES_TO_MB(usages[i].bytes));
+            }
+            STAT_UPDATE(accountedMemory, (int)BYTES_TO_MB(accountedBytes));
+            STAT_UPDATE(memoryUsage, lines.join("\n"));
+        }
+
         STAT_UPDATE(rectifiedTextureCount, (int)RECTIFIED_TEXTURE_COUNT.load());
         STAT_UPDATE(decimatedTextureCount, (int)DECIMATED_TEXTURE_COUNT.load());
+        STAT_UPDATE(proceduralShadersCompiling, (int)gpu::Context::getAsyncProgramPendingCount());
+        STAT_UPDATE(proceduralShadersCompiled, (int)gpu::Context::getAsyncProgramCompiledCount());
+        STAT_UPDATE_FLOAT(proceduralShaderCompileTime, (float)gpu::Context::getAsyncProgramCompileTime() / (float)USECS_PER_MSEC, 0.01f);
     }
 
     gpu::ContextStats gpuFrameStats;
@@ -460,6 +511,8 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(lodStatus, "You can see " + DependencyManager::get<LODManager>()->getLODFeedbackText());
         STAT_UPDATE(numEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevNumEntityUpdates());
         STAT_UPDATE(numNeededEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevTotalNeededEntityUpdates());
+        STAT_UPDATE(modelsWaitingToFinalize, Model::getPrevNumModelsWaitingToFinalize());
+        STAT_UPDATE_FLOAT(modelFinalizationTime, (float)Model::getPrevModelFinalizationTime() / (float)USECS_PER_MSEC, 0.01f);
     }
 
 
@@ -212,6 +212,10 @@ private: \
  * @property {string[]} downloadUrls - The download URLs.
  *     <em>Read-only.</em>
  *     <p><strong>Note:</strong> Property not available in the API.</p>
+ * @property {string[]} downloadOrigins - The HTTP requests, shared requests, failures and bytes received of each of the
+ *     origins downloaded from the most, and whether HTTP/2 was used with them.
+ *     <em>Read-only.</em>
+ *     <p><strong>Note:</strong> Property not available in the API.</p>
  * @property {number} processing - The number of completed downloads being processed.
  *     <em>Read-only.</em>
  * @property {number} processingPending - The number of completed downloads waiting to be processed.
@@ -252,6 +256,11 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} numNeededEntityUpdates - The total number of entity updates scheduled for last frame.
  *     <em>Read-only.</em>
+ * @property {number} modelsWaitingToFinalize - The number of loaded models that waited for a later frame to be added to the
+ *     scene last frame, because the time budget for adding models was used up.
+ *     <em>Read-only.</em>
+ * @property {number} modelFinalizationTime - The time spent adding loaded models to the scene last frame, in ms.
+ *     <em>Read-only.</em>
  * @property {string} timingStats - Details of the average time (ms) spent in and number of calls made to different parts of 
  *     the code. Provided only if <code>timingExpanded</code> is <code>true</code>. Only the top 10 items are provided if 
  *     Developer &gt; Timing &gt; Performance Timer &gt; Only Display Top 10 is enabled.
@@ -276,6 +285,14 @@ private: \
  * @property {number} decimatedTextureCount - The number of textures that have been reduced in size because they were over the 
  *     maximum allowed dimensions of 8192 pixels on desktop or 2048 pixels on mobile.
  *     <em>Read-only.</em>
+ * @property {number} proceduralShadersCompiling - The number of procedural shader programs waiting to be compiled, during
+ *     which their entities are drawn with their fallback material.
+ *     <em>Read-only.</em>
+ * @property {number} proceduralShadersCompiled - The number of procedural shader programs compiled so far. Entities with the
+ *     same shaders share a program.
+ *     <em>Read-only.</em>
+ * @property {number} proceduralShaderCompileTime - The time spent compiling the procedural shader programs so far, in ms.
+ *     <em>Read-only.</em>
  * @property {number} gpuBuffers - The number of OpenGL buffer objects managed by the GPU back-end.
  *     <em>Read-only.</em>
  * @property {number} gpuBufferMemory - The total memory size of the <code>gpuBuffers</code>, in MB. 
@@ -324,6 +341,11 @@ private: \
  * @property {number} gpuTextureExternalMemory - The estimated amount of memory consumed by textures being used but that are
  *     not managed by the GPU library, in MB.
  *     <em>Read-only.</em>
+ * @property {number} accountedMemory - The memory the resource caches, sound data, packet buffers and other subsystems
+ *     account for, in MB. See {@link Memory.getUsage}.
+ *     <em>Read-only.</em>
+ * @property {string} memoryUsage - The subsystems that account for the most memory, one per line with their size in MB.
+ *     <em>Read-only.</em>
  * @property {Vec2} gpuFrameSize - The dimensions of the frames being rendered, in pixels.
  *     <em>Read-only.</em>
  *     <p><strong>Note:</strong> Property not available in the API.</p>
@@ -380,6 +402,14 @@ private: \
  *     </ul>
  *     <em>Read-only.</em>
  *     <p><strong>Note:</strong> Property not available in the API.</p>
+ * @property {number} stylusPicksTime - The time spent updating the stylus picks in the most recent game loop, in ms.
+ *     <em>Read-only.</em>
+ * @property {number} rayPicksTime - The time spent updating the ray picks in the most recent game loop, in ms.
+ *     <em>Read-only.</em>
+ * @property {number} parabolaPicksTime - The time spent updating the parabola picks in the most recent game loop, in ms.
+ *     <em>Read-only.</em>
+ * @property {number} collisionPicksTime - The time spent updating the collision picks in the most recent game loop, in ms.
+ *     <em>Read-only.</em>
  *
  * @property {boolean} eventQueueDebuggingOn - <code>true</code> if event queue statistics are provided, <code>false</code> if
  *     they're not.
@@ -529,6 +559,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, downloadLimit, 0)
     STATS_PROPERTY(int, downloadsPending, 0)
     Q_PROPERTY(QStringList downloadUrls READ downloadUrls NOTIFY downloadUrlsChanged)
+    Q_PROPERTY(QStringList downloadOrigins READ downloadOrigins NOTIFY downloadOriginsChanged)
     STATS_PROPERTY(int, processing, 0)
     STATS_PROPERTY(int, processingPending, 0)
     STATS_PROPERTY(int, triangles, 0)
@@ -549,6 +580,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, lodStatus, QString())
     STATS_PROPERTY(quint64, numEntityUpdates, 0)
     STATS_PROPERTY(quint64, numNeededEntityUpdates, 0)
+    STATS_PROPERTY(int, modelsWaitingToFinalize, 0)
+    STATS_PROPERTY(float, modelFinalizationTime, 0)
     STATS_PROPERTY(QString, timingStats, QString())
     STATS_PROPERTY(QString, gameUpdateStats, QString())
     STATS_PROPERTY(int, serverElements, 0)
@@ -559,6 +592,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, localLeaves, 0)
     STATS_PROPERTY(int, rectifiedTextureCount, 0)
     STATS_PROPERTY(int, decimatedTextureCount, 0)
+    STATS_PROPERTY(int, proceduralShadersCompiling, 0)
+    STATS_PROPERTY(int, proceduralShadersCompiled, 0)
+    STATS_PROPERTY(float, proceduralShaderCompileTime, 0)
 
     STATS_PROPERTY(int, gpuBuffers, 0)
     STATS_PROPERTY(int, gpuBufferMemory, 0)
@@ -575,6 +611,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, gpuTextureExternalMemory, 0)
     STATS_PROPERTY(QString, gpuTextureMemoryPressureState, QString())
     STATS_PROPERTY(int, gpuFreeMemory, 0)
+    STATS_PROPERTY(int, accountedMemory, 0)
+    STATS_PROPERTY(QString, memoryUsage, QString())
     STATS_PROPERTY(QVector2D, gpuFrameSize, QVector2D(0,0))
     STATS_PROPERTY(float, gpuFrameTime, 0)
     STATS_PROPERTY(float, gpuFrameTimePerPixel, 0)
@@ -590,6 +628,10 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QVector3D, rayPicksUpdated, QVector3D(0, 0, 0))
     STATS_PROPERTY(QVector3D, parabolaPicksUpdated, QVector3D(0, 0, 0))
     STATS_PROPERTY(QVector3D, collisionPicksUpdated, QVector3D(0, 0, 0))
+    STATS_PROPERTY(float, stylusPicksTime, 0)
+    STATS_PROPERTY(float, rayPicksTime, 0)
+    STATS_PROPERTY(float, parabolaPicksTime, 0)
+    STATS_PROPERTY(float, collisionPicksTime, 0)
 
     STATS_PROPERTY(int, mainThreadQueueDepth, -1);
     STATS_PROPERTY(int, nodeListThreadQueueDepth, -1);
@@ -623,6 +665,7 @@ public:
     }
 
     QStringList downloadUrls () { return _downloadUrls; }
+    QStringList downloadOrigins () { return _downloadOrigins; }
 
 public slots:
 
@@ -1091,6 +1134,13 @@ signals:
      */
     void downloadUrlsChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>downloadOrigins</code> property changes.
+     * @function Stats.downloadOriginsChanged
+     * @returns {Signal}
+     */
+    void downloadOriginsChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>processing</code> property changes.
      * @function Stats.processingChanged
@@ -1231,6 +1281,20 @@ signals:
      */
     void numNeededEntityUpdatesChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>modelsWaitingToFinalize</code> property changes.
+     * @function Stats.modelsWaitingToFinalizeChanged
+     * @returns {Signal}
+     */
+    void modelsWaitingToFinalizeChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>modelFinalizationTime</code> property changes.
+     * @function Stats.modelFinalizationTimeChanged
+     * @returns {Signal}
+     */
+    void modelFinalizationTimeChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>timingStats</code> property changes.
      * @function Stats.timingStatsChanged
@@ -1301,6 +1365,27 @@ signals:
      */
     void decimatedTextureCountChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>proceduralShadersCompiling</code> property changes.
+     * @function Stats.proceduralShadersCompilingChanged
+     * @returns {Signal}
+     */
+    void proceduralShadersCompilingChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>proceduralShadersCompiled</code> property changes.
+     * @function Stats.proceduralShadersCompiledChanged
+     * @returns {Signal}
+     */
+    void proceduralShadersCompiledChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>proceduralShaderCompileTime</code> property changes.
+     * @function Stats.proceduralShaderCompileTimeChanged
+     * @returns {Signal}
+     */
+    void proceduralShaderCompileTimeChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>gpuBuffers</code> property changes.
      * @function Stats.gpuBuffersChanged
@@ -1399,6 +1484,20 @@ signals:
      */
     void gpuTextureMemoryPressureStateChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>accountedMemory</code> property changes.
+     * @function Stats.accountedMemoryChanged
+     * @returns {Signal}
+     */
+    void accountedMemoryChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>memoryUsage</code> property changes.
+     * @function Stats.memoryUsageChanged
+     * @returns {Signal}
+     */
+    void memoryUsageChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>gpuFreeMemory</code> property changes.
      * @function Stats.gpuFreeMemoryChanged
@@ -1504,6 +1603,34 @@ signals:
      */
     void collisionPicksUpdatedChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>stylusPicksTime</code> property changes.
+     * @function Stats.stylusPicksTimeChanged
+     * @returns {Signal}
+     */
+    void stylusPicksTimeChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>rayPicksTime</code> property changes.
+     * @function Stats.rayPicksTimeChanged
+     * @returns {Signal}
+     */
+    void rayPicksTimeChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>parabolaPicksTime</code> property changes.
+     * @function Stats.parabolaPicksTimeChanged
+     * @returns {Signal}
+     */
+    void parabolaPicksTimeChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>collisionPicksTime</code> property changes.
+     * @function Stats.collisionPicksTimeChanged
+     * @returns {Signal}
+     */
+    void collisionPicksTimeChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>mainThreadQueueDepth</code> property changes.
      * @function Stats.mainThreadQueueDepthChanged
@@ -1817,6 +1944,7 @@ private:
     QString _monospaceFont;
     const AudioIOStats* _audioStats;
     QStringList _downloadUrls = QStringList();
+    QStringList _downloadOrigins = QStringList();
 };
 
 #endif // hifi_Stats_h
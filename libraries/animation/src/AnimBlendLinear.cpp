@@ -87,8 +87,9 @@ void AnimBlendLinear::evaluateAndBlendChildren(const AnimVariantMap& animVars, c
         _poses = _children[prevPoseIndex]->evaluate(animVars, context, dt, triggersOut);
     } else {
         // need to eval and blend between two children.
-        auto prevPoses = _children[prevPoseIndex]->evaluate(animVars, context, dt, triggersOut);
-        auto nextPoses = _children[nextPoseIndex]->evaluate(animVars, context, dt, triggersOut);
+        // the poses of the children are blended in place, they are not copied
+        const auto& prevPoses = _children[prevPoseIndex]->evaluate(animVars, context, dt, triggersOut);
+        const auto& nextPoses = _children[nextPoseIndex]->evaluate(animVars, context, dt, triggersOut);
 
         if (prevPoses.size() > 0 && prevPoses.size() == nextPoses.size()) {
             _poses.resize(prevPoses.size());
@@ -98,13 +99,17 @@ void AnimBlendLinear::evaluateAndBlendChildren(const AnimVariantMap& animVars, c
             } else if (_blendType == AnimBlendType_AddRelative) {
                 ::blendAdd(_poses.size(), &prevPoses[0], &nextPoses[0], alpha, &_poses[0]);
             } else if (_blendType == AnimBlendType_AddAbsolute) {
+                // scratch poses, kept from one evaluation to the next so that they aren't reallocated every frame
+                // rigs are evaluated on several threads
+                static thread_local AnimPoseVec absPrev;
+                static thread_local AnimPoseVec relOffsetPoses;
+
                 // convert prev from relative to absolute
-                AnimPoseVec absPrev = prevPoses;
+                absPrev.assign(prevPoses.begin(), prevPoses.end());
                 _skeleton->convertRelativePosesToAbsolute(absPrev);
 
                 // rotate the offset rotations from next into the parent relative frame of each joint.
-                AnimPoseVec relOffsetPoses;
-                relOffsetPoses.reserve(nextPoses.size());
+                relOffsetPoses.clear();
                 for (size_t i = 0; i < nextPoses.size(); ++i) {
 
                     // copy translation and scale from nextPoses
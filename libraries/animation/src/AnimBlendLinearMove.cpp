@@ -14,6 +14,10 @@
 #include "AnimUtil.h"
 #include "AnimClip.h"
 
+static const AnimVariantKey MOVE_LATERAL_SPEED_VAR("moveLateralSpeed");
+static const AnimVariantKey MOVE_BACKWARD_SPEED_VAR("moveBackwardSpeed");
+static const AnimVariantKey MOVE_FORWARD_SPEED_VAR("moveForwardSpeed");
+
 AnimBlendLinearMove::AnimBlendLinearMove(const QString& id, float alpha, float desiredSpeed, const std::vector<float>& characteristicSpeeds) :
     AnimNode(AnimNode::Type::BlendLinearMove, id),
     _alpha(alpha),
@@ -53,13 +57,13 @@ const AnimPoseVec& AnimBlendLinearMove::evaluate(const AnimVariantMap& animVars,
     _desiredSpeed = animVars.lookup(_desiredSpeedVar, _desiredSpeed);
 
     float speed = 0.0f;
-    if (_alphaVar.contains("Lateral")) {
-        speed = animVars.lookup("moveLateralSpeed", speed);
-    } else if (_alphaVar.contains("Backward")) {
-        speed = animVars.lookup("moveBackwardSpeed", speed);
+    if (_alphaVar.getName().contains("Lateral")) {
+        speed = animVars.lookup(MOVE_LATERAL_SPEED_VAR, speed);
+    } else if (_alphaVar.getName().contains("Backward")) {
+        speed = animVars.lookup(MOVE_BACKWARD_SPEED_VAR, speed);
     } else {
         //this is forward movement
-        speed = animVars.lookup("moveForwardSpeed", speed);
+        speed = animVars.lookup(MOVE_FORWARD_SPEED_VAR, speed);
     }
     _alpha = calculateAlpha(speed, _characteristicSpeeds);
     float parentDebugAlpha = context.getDebugAlpha(_id);
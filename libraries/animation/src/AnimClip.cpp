@@ -12,6 +12,8 @@
 
 #include <assert.h>
 
+#include <QtCore/QByteArray>
+
 #include "GLMHelpers.h"
 #include "AnimationLogging.h"
 #include "AnimUtil.h"
@@ -261,16 +263,23 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame, dt, _loopFlag, _id, triggersOut);
 
     // poll network anim to see if it's finished loading yet.
+    // the retargeted frames are shared by the clips playing the same animation on the same skeleton.
     if (_blendType == AnimBlendType_Normal) {
         if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
             // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+            auto networkAnim = _networkAnim;
+            auto skeleton = _skeleton;
+            _animKey = getAnimKey();
+            _anim = AnimClipData::getOrBuild(_animKey, [&] {
+                return copyAndRetargetFromNetworkAnim(networkAnim, skeleton);
+            });
 
             // we no longer need the actual animation resource anymore.
             _networkAnim.reset();
 
             // mirrorAnim will be re-built on demand, if needed.
-            _mirrorAnim.clear();
+            _mirrorAnim.reset();
+            clearDecodedFrames();
 
             _poses.resize(_skeleton->getNumJoints());
         }
@@ -278,33 +287,43 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
         // an additive blend type
         if (_networkAnim && _networkAnim->isLoaded() && _baseNetworkAnim && _baseNetworkAnim->isLoaded() && _skeleton) {
             // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+            auto networkAnim = _networkAnim;
+            auto baseNetworkAnim = _baseNetworkAnim;
+            auto skeleton = _skeleton;
+            auto blendType = _blendType;
+            auto baseFrame = _baseFrame;
+            _animKey = getAnimKey();
+            _anim = AnimClipData::getOrBuild(_animKey, [&] {
+                auto anim = copyAndRetargetFromNetworkAnim(networkAnim, skeleton);
+
+                // copy & retarget baseAnim!
+                auto baseAnim = copyAndRetargetFromNetworkAnim(baseNetworkAnim, skeleton);
+
+                if (blendType == AnimBlendType_AddAbsolute) {
+                    bakeAbsoluteDeltaAnim(anim, baseAnim[(int)baseFrame], skeleton);
+                } else {
+                    // AnimBlendType_AddRelative
+                    bakeRelativeDeltaAnim(anim, baseAnim[(int)baseFrame]);
+                }
+                return anim;
+            });
 
             // we no longer need the actual animation resource anymore.
             _networkAnim.reset();
 
             // mirrorAnim will be re-built on demand, if needed.
             // TODO: handle mirrored relative animations.
-            _mirrorAnim.clear();
+            _mirrorAnim.reset();
+            clearDecodedFrames();
 
             _poses.resize(_skeleton->getNumJoints());
-
-            // copy & retarget baseAnim!
-            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
-
-            if (_blendType == AnimBlendType_AddAbsolute) {
-                bakeAbsoluteDeltaAnim(_anim, baseAnim[(int)_baseFrame], _skeleton);
-            } else {
-                // AnimBlendType_AddRelative
-                bakeRelativeDeltaAnim(_anim, baseAnim[(int)_baseFrame]);
-            }
         }
     }
 
-    if (_anim.size()) {
+    if (_anim && _anim->getNumFrames() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
+        if (_mirrorFlag && !_mirrorAnim) {
             buildMirrorAnim();
         }
 
@@ -318,12 +337,13 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _anim->getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        const AnimClipData& anim = _mirrorFlag ? *_mirrorAnim : *_anim;
+        const AnimPoseVec& prevFrame = decodeFrame(anim, prevIndex);
+        const AnimPoseVec& nextFrame = decodeFrame(anim, nextIndex);
         float alpha = glm::fract(_frame);
 
         ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
@@ -342,14 +362,50 @@ void AnimClip::setCurrentFrameInternal(float frame) {
 }
 
 void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
+    assert(_skeleton && _anim);
+
+    auto anim = _anim;
+    auto skeleton = _skeleton;
+    _mirrorAnim = AnimClipData::getOrBuild(_animKey + "/mirror", [&] {
+        auto mirrorAnim = anim->decodeFrames();
+        for (auto& relPoses : mirrorAnim) {
+            skeleton->mirrorRelativePoses(relPoses);
+        }
+        return mirrorAnim;
+    });
+}
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+QByteArray AnimClip::getAnimKey() const {
+    assert(_networkAnim && _skeleton);
+    QByteArray key = _networkAnim->getURL().toEncoded();
+    if (_blendType != AnimBlendType_Normal) {
+        key += "/" + QByteArray::number((int)_blendType) + "/" + _baseURL.toUtf8() + "/" + QByteArray::number(_baseFrame);
+    }
+    return key + "/" + AnimClipData::getSkeletonKey(*_skeleton).toHex();
+}
+
+void AnimClip::clearDecodedFrames() {
+    for (auto& decodedFrame : _decodedFrames) {
+        decodedFrame.anim = nullptr;
+        decodedFrame.frame = -1;
+    }
+}
+
+const AnimPoseVec& AnimClip::decodeFrame(const AnimClipData& anim, int frame) {
+    // the two most recently decoded frames are kept, playback mostly blends between the same two frames
+    // for a few updates before moving on to the next one.
+    for (int i = 0; i < NUM_DECODED_FRAMES; i++) {
+        if (_decodedFrames[i].anim == &anim && _decodedFrames[i].frame == frame) {
+            _nextDecodedFrame = (i + 1) % NUM_DECODED_FRAMES;
+            return _decodedFrames[i].poses;
+        }
     }
+    auto& decodedFrame = _decodedFrames[_nextDecodedFrame];
+    _nextDecodedFrame = (_nextDecodedFrame + 1) % NUM_DECODED_FRAMES;
+    anim.decodeFrame(frame, decodedFrame.poses);
+    decodedFrame.anim = &anim;
+    decodedFrame.frame = frame;
+    return decodedFrame.poses;
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
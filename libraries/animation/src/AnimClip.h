@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimClipData.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -62,6 +63,9 @@ protected:
     virtual void setCurrentFrameInternal(float frame) override;
 
     void buildMirrorAnim();
+    QByteArray getAnimKey() const;
+    const AnimPoseVec& decodeFrame(const AnimClipData& anim, int frame);
+    void clearDecodedFrames();
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
@@ -71,9 +75,19 @@ protected:
 
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // shared by the clips playing the same animation on the same skeleton
+    QByteArray _animKey;
+    AnimClipData::Pointer _anim;
+    AnimClipData::Pointer _mirrorAnim;
+
+    struct DecodedFrame {
+        const AnimClipData* anim { nullptr };
+        int frame { -1 };
+        AnimPoseVec poses;
+    };
+    static const int NUM_DECODED_FRAMES = 2;
+    DecodedFrame _decodedFrames[NUM_DECODED_FRAMES];
+    int _nextDecodedFrame { 0 };
 
     QString _url;
     float _startFrame;
@@ -86,12 +100,12 @@ protected:
     QString _baseURL;
     float _baseFrame;
 
-    QString _startFrameVar;
-    QString _endFrameVar;
-    QString _timeScaleVar;
-    QString _loopFlagVar;
-    QString _mirrorFlagVar;
-    QString _frameVar;
+    AnimVariantKey _startFrameVar;
+    AnimVariantKey _endFrameVar;
+    AnimVariantKey _timeScaleVar;
+    AnimVariantKey _loopFlagVar;
+    AnimVariantKey _mirrorFlagVar;
+    AnimVariantKey _frameVar;
 
     // no copies
     AnimClip(const AnimClip&) = delete;
@@ -0,0 +1,137 @@
+//
+//  AnimClipData.cpp
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipData.h"
+
+#include <assert.h>
+#include <float.h>
+#include <mutex>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QHash>
+
+#include <GLMHelpers.h>
+
+#include "AnimSkeleton.h"
+
+static const float MAX_TRANSLATION_STEPS = (float)UINT16_MAX;
+
+AnimClipData::AnimClipData(const Frames& frames) :
+    _numFrames((int)frames.size()),
+    _numJoints(frames.empty() ? 0 : (int)frames[0].size()) {
+
+    _scales.resize(_numJoints, glm::vec3(1.0f));
+    _translationMins.resize(_numJoints, glm::vec3(FLT_MAX));
+    _translationSteps.resize(_numJoints, glm::vec3(0.0f));
+    if (_numFrames == 0) {
+        return;
+    }
+
+    // the range of the translations of each joint over the animation
+    std::vector<glm::vec3> translationMaxs(_numJoints, glm::vec3(-FLT_MAX));
+    for (auto& frame : frames) {
+        for (int i = 0; i < _numJoints; i++) {
+            _translationMins[i] = glm::min(_translationMins[i], frame[i].trans());
+            translationMaxs[i] = glm::max(translationMaxs[i], frame[i].trans());
+        }
+    }
+    for (int i = 0; i < _numJoints; i++) {
+        _scales[i] = frames[0][i].scale();
+        _translationSteps[i] = (translationMaxs[i] - _translationMins[i]) / MAX_TRANSLATION_STEPS;
+    }
+
+    _poses.resize(_numFrames * _numJoints);
+    for (int frame = 0; frame < _numFrames; frame++) {
+        for (int i = 0; i < _numJoints; i++) {
+            const AnimPose& pose = frames[frame][i];
+            QuantizedPose& quantizedPose = _poses[frame * _numJoints + i];
+            packOrientationQuatToSixBytes(quantizedPose.rotation, pose.rot());
+            for (int j = 0; j < 3; j++) {
+                float step = _translationSteps[i][j];
+                float steps = step > 0.0f ? (pose.trans()[j] - _translationMins[i][j]) / step : 0.0f;
+                quantizedPose.translation[j] = (uint16_t)glm::clamp(roundf(steps), 0.0f, MAX_TRANSLATION_STEPS);
+            }
+        }
+    }
+}
+
+size_t AnimClipData::getSize() const {
+    return sizeof(AnimClipData) + _poses.size() * sizeof(QuantizedPose) + 3 * _numJoints * sizeof(glm::vec3);
+}
+
+void AnimClipData::decodeFrame(int frame, AnimPoseVec& posesOut) const {
+    assert(frame >= 0 && frame < _numFrames);
+    posesOut.resize(_numJoints);
+    const QuantizedPose* quantizedPoses = &_poses[frame * _numJoints];
+    for (int i = 0; i < _numJoints; i++) {
+        AnimPose& pose = posesOut[i];
+        unpackOrientationQuatFromSixBytes(quantizedPoses[i].rotation, pose.rot());
+        pose.trans() = _translationMins[i] + _translationSteps[i] *
+            glm::vec3(quantizedPoses[i].translation[0], quantizedPoses[i].translation[1], quantizedPoses[i].translation[2]);
+        pose.scale() = _scales[i];
+    }
+}
+
+AnimClipData::Frames AnimClipData::decodeFrames() const {
+    Frames frames(_numFrames);
+    for (int frame = 0; frame < _numFrames; frame++) {
+        decodeFrame(frame, frames[frame]);
+    }
+    return frames;
+}
+
+QByteArray AnimClipData::getSkeletonKey(const AnimSkeleton& skeleton) {
+    // the retargeting depends on the names, the hierarchy and the default poses of the joints, and on the units
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const glm::mat4& geometryOffset = skeleton.getGeometryOffset();
+    hash.addData((const char*)&geometryOffset, sizeof(geometryOffset));
+    for (int i = 0; i < skeleton.getNumJoints(); i++) {
+        hash.addData(skeleton.getJointName(i).toUtf8());
+        int parentIndex = skeleton.getParentIndex(i);
+        hash.addData((const char*)&parentIndex, sizeof(parentIndex));
+        const AnimPose& pose = skeleton.getRelativeDefaultPose(i);
+        hash.addData((const char*)&pose.scale(), sizeof(glm::vec3));
+        hash.addData((const char*)&pose.rot(), sizeof(glm::quat));
+        hash.addData((const char*)&pose.trans(), sizeof(glm::vec3));
+    }
+    return hash.result();
+}
+
+AnimClipData::Pointer AnimClipData::getOrBuild(const QByteArray& key, const std::function<Frames()>& buildFrames) {
+    // the clips of the avatars are evaluated on several threads
+    static std::mutex cacheMutex;
+    static QHash<QByteArray, std::weak_ptr<const AnimClipData>> cache;
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto data = cache.value(key).lock();
+        if (data) {
+            return data;
+        }
+    }
+
+    // built outside of the lock, if another clip builds the same frames meanwhile the first ones are kept
+    auto newData = std::make_shared<const AnimClipData>(buildFrames());
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (auto it = cache.begin(); it != cache.end();) {
+        if (it.value().expired()) {
+            it = cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    auto data = cache.value(key).lock();
+    if (data) {
+        return data;
+    }
+    cache.insert(key, newData);
+    return newData;
+}
@@ -0,0 +1,63 @@
+//
+//  AnimClipData.h
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipData_h
+#define hifi_AnimClipData_h
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "AnimPose.h"
+
+class AnimSkeleton;
+
+// The frames of an animation retargeted to a skeleton, quantized: each rotation is packed in six bytes and each
+// translation in three 16 bit steps over the range of its joint. The scales aren't animated by the retargeting, they
+// are kept once per joint. The frames are shared by all the clips playing the same animation on the same skeleton,
+// and decoded one frame at a time as they are played.
+class AnimClipData {
+public:
+    using Pointer = std::shared_ptr<const AnimClipData>;
+    using Frames = std::vector<AnimPoseVec>;
+
+    AnimClipData(const Frames& frames);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return _numJoints; }
+    size_t getSize() const;
+
+    void decodeFrame(int frame, AnimPoseVec& posesOut) const;
+    Frames decodeFrames() const;
+
+    // skeletons with the same key retarget an animation to the same frames
+    static QByteArray getSkeletonKey(const AnimSkeleton& skeleton);
+
+    // the frames shared under key, built by buildFrames if no clip uses them yet
+    static Pointer getOrBuild(const QByteArray& key, const std::function<Frames()>& buildFrames);
+
+private:
+    struct QuantizedPose {
+        uint8_t rotation[6];
+        uint16_t translation[3];
+    };
+
+    int _numFrames { 0 };
+    int _numJoints { 0 };
+    std::vector<glm::vec3> _scales;
+    std::vector<glm::vec3> _translationMins;
+    std::vector<glm::vec3> _translationSteps;
+    std::vector<QuantizedPose> _poses; // _poses[frame * _numJoints + joint]
+};
+
+#endif // hifi_AnimClipData_h
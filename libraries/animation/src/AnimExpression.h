@@ -100,7 +100,7 @@ protected:
         }
 
         Type type {Int};
-        QString strVal;
+        AnimVariantKey strVal;  // interned as the expression is parsed
         int intVal {0};
         float floatVal {0.0f};
     };
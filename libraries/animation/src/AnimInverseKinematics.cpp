@@ -9,6 +9,8 @@
 
 #include "AnimInverseKinematics.h"
 
+#include <algorithm>
+
 #include <GeometryUtil.h>
 #include <GLMHelpers.h>
 #include <NumericalConstants.h>
@@ -54,6 +56,39 @@ static float easeOutExpo(float t) {
     return 1.0f - powf(2, -10.0f * t);
 }
 
+static bool isPoseUnchanged(const AnimPose& a, const AnimPose& b) {
+    const float TRANSLATION_EPSILON = 0.0001f;
+    const float ROTATION_DOT_EPSILON = 1.0e-7f;
+    return glm::distance(a.trans(), b.trans()) < TRANSLATION_EPSILON &&
+        1.0f - fabsf(glm::dot(a.rot(), b.rot())) < ROTATION_DOT_EPSILON;
+}
+
+static bool arePosesUnchanged(const AnimPoseVec& a, const AnimPoseVec& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!isPoseUnchanged(a[i], b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool areTargetsUnchanged(const std::vector<IKTarget>& a, const std::vector<IKTarget>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].getType() != b[i].getType() || a[i].getIndex() != b[i].getIndex() || a[i].getWeight() != b[i].getWeight() ||
+            a[i].getPoleVectorEnabled() != b[i].getPoleVectorEnabled() || a[i].getPoleVector() != b[i].getPoleVector() ||
+            !isPoseUnchanged(a[i].getPose(), b[i].getPose())) {
+            return false;
+        }
+    }
+    return true;
+}
+
 AnimInverseKinematics::IKTargetVar::IKTargetVar(const QString& jointNameIn, const QString& positionVarIn, const QString& rotationVarIn,
                                                 const QString& typeVarIn, const QString& weightVarIn, float weightIn, const std::vector<float>& flexCoefficientsIn,
                                                 const QString& poleVectorEnabledVarIn, const QString& poleReferenceVectorVarIn, const QString& poleVectorVarIn) :
@@ -248,13 +283,23 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
 
     std::map<int, int> targetToChainMap;
 
+    // the solver stops early once the error is small enough or no longer decreases, the starting poses are
+    // the previous solution (or close to it) so when the targets move smoothly only a few loops are needed.
+    // the chain interpolation and debug draw are done on the last loop, so one more loop is run once converged.
+    const int MIN_IK_LOOPS = 4;
+    const int MAX_IK_LOOPS = 16;
+    const float CONVERGED_IK_ERROR = 0.001f;
+    const float STALLED_IK_ERROR_RATIO = 0.01f;
     float maxError = 0.0f;
+    float prevMaxError = FLT_MAX;
+    bool converged = false;
     int numLoops = 0;
-    const int MAX_IK_LOOPS = 16;
-    while (numLoops < MAX_IK_LOOPS) {
+    bool lastLoop = false;
+    while (!lastLoop) {
         ++numLoops;
+        lastLoop = converged || numLoops == MAX_IK_LOOPS;
 
-        bool debug = context.getEnableDebugDrawIKChains() && numLoops == MAX_IK_LOOPS;
+        bool debug = context.getEnableDebugDrawIKChains() && lastLoop;
 
         // solve all targets
         for (size_t i = 0; i < targets.size(); i++) {
@@ -271,7 +316,7 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         }
         
         // on last iteration, interpolate jointChains, if necessary
-        if (numLoops == MAX_IK_LOOPS) {
+        if (lastLoop) {
             for (size_t i = 0; i < _prevJointChainInfoVec.size(); i++) {
                 targetToChainMap.insert(std::pair<int, int>(_prevJointChainInfoVec[i].target.getIndex(), (int)i));
                 if (_prevJointChainInfoVec[i].timer > 0.0f) {
@@ -346,8 +391,14 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
                 }
             }
         }
+
+        if (numLoops >= MIN_IK_LOOPS && !converged) {
+            converged = maxError < CONVERGED_IK_ERROR || prevMaxError - maxError < STALLED_IK_ERROR_RATIO * prevMaxError;
+        }
+        prevMaxError = maxError;
     }
     _maxErrorOnLastSolve = maxError;
+    _numIterationsOnLastSolve = numLoops;
 
     // finally set the relative rotation of each tip to agree with absolute target rotation
     for (auto& target: targets) {
@@ -941,9 +992,37 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
             computeTargets(animVars, targets, underPoses);
         }
 
+        // when nothing that drives the solution has changed since the last frame and the last solve didn't move the
+        // poses either, solving again would give the same poses, so the last solution is reused.
+        bool canReuseSolution = _isLastSolutionSteady && !targets.empty() &&
+            (int)solutionSource == _lastSolutionSource &&
+            !context.getEnableDebugDrawIKTargets() && !context.getEnableDebugDrawIKChains() &&
+            areTargetsUnchanged(targets, _lastTargets) && arePosesUnchanged(underPoses, _lastUnderPoses) &&
+            _secondaryTargetsInRigFrame.size() == _lastSecondaryTargetsInRigFrame.size() &&
+            std::equal(_secondaryTargetsInRigFrame.begin(), _secondaryTargetsInRigFrame.end(), _lastSecondaryTargetsInRigFrame.begin(),
+                [](const std::pair<const int, AnimPose>& a, const std::pair<const int, AnimPose>& b) {
+                    return a.first == b.first && isPoseUnchanged(a.second, b.second);
+                });
+        if (canReuseSolution) {
+            for (auto& chainInfo : _prevJointChainInfoVec) {
+                if (chainInfo.timer > 0.0f) {
+                    canReuseSolution = false;
+                    break;
+                }
+            }
+        }
+
         if (targets.empty()) {
             _relativePoses = underPoses;
+            _isLastSolutionSteady = false;
+        } else if (canReuseSolution) {
+            _relativePoses = _lastSolvedPoses;
+            _numIterationsOnLastSolve = 0;
         } else {
+            _lastTargets = targets;
+            _lastUnderPoses = underPoses;
+            _lastSolutionSource = (int)solutionSource;
+            _lastSecondaryTargetsInRigFrame = _secondaryTargetsInRigFrame;
 
             JointChainInfoVec jointChainInfoVec(targets.size());
             {
@@ -1072,6 +1151,9 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
 
                 solve(context, targets, dt, jointChainInfoVec);
             }
+
+            _isLastSolutionSteady = arePosesUnchanged(_relativePoses, _lastSolvedPoses);
+            _lastSolvedPoses = _relativePoses;
         }
 
         if (context.getEnableDebugDrawIKConstraints()) {
@@ -1463,6 +1545,7 @@ void AnimInverseKinematics::setSkeletonInternal(AnimSkeleton::ConstPointer skele
     for (auto& targetVar: _targetVarVec) {
         targetVar.jointIndex = AnimSkeleton::INVALID_JOINT_INDEX;
     }
+    _isLastSolutionSteady = false;
 
     for (auto& accumulator: _rotationAccumulators) {
         accumulator.clearAndClean();
@@ -58,6 +58,8 @@ public:
     void clearIKJointLimitHistory();
 
     float getMaxErrorOnLastSolve() { return _maxErrorOnLastSolve; }
+    // 0 when the last solution was reused because nothing changed
+    int getNumIterationsOnLastSolve() const { return _numIterationsOnLastSolve; }
 
     /*@jsdoc
      * <p>Specifies the initial conditions of the IK solver.</p>
@@ -165,13 +167,13 @@ protected:
         AnimInverseKinematics::IKTargetVar& operator=(const AnimInverseKinematics::IKTargetVar&) = default;
 
         QString jointName;
-        QString positionVar;
-        QString rotationVar;
-        QString typeVar;
-        QString weightVar;
-        QString poleVectorEnabledVar;
-        QString poleReferenceVectorVar;
-        QString poleVectorVar;
+        AnimVariantKey positionVar;
+        AnimVariantKey rotationVar;
+        AnimVariantKey typeVar;
+        AnimVariantKey weightVar;
+        AnimVariantKey poleVectorEnabledVar;
+        AnimVariantKey poleReferenceVectorVar;
+        AnimVariantKey poleVectorVar;
         float weight;
         float flexCoefficients[MAX_FLEX_COEFFICIENTS];
         size_t numFlexCoefficients;
@@ -199,9 +201,18 @@ protected:
     int _rightHandIndex { -1 };
 
     float _maxErrorOnLastSolve { FLT_MAX };
+    int _numIterationsOnLastSolve { 0 };
+
+    // what the last solve was done from, to reuse its solution when nothing changed
+    std::vector<IKTarget> _lastTargets;
+    AnimPoseVec _lastUnderPoses;
+    AnimPoseVec _lastSolvedPoses;
+    std::map<int, AnimPose> _lastSecondaryTargetsInRigFrame;
+    int _lastSolutionSource { -1 };
+    bool _isLastSolutionSteady { false };
     bool _previousEnableDebugIKTargets { false };
     SolutionSource _solutionSource { SolutionSource::RelaxToUnderPoses };
-    QString _solutionSourceVar;
+    AnimVariantKey _solutionSourceVar;
 
     JointChainInfoVec _prevJointChainInfoVec;
 };
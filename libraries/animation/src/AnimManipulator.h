@@ -42,8 +42,8 @@ public:
         QString jointName = "";
         Type rotationType = Type::Absolute;
         Type translationType = Type::Absolute;
-        QString rotationVar = "";
-        QString translationVar = "";
+        AnimVariantKey rotationVar;
+        AnimVariantKey translationVar;
 
         int jointIndex = -1;
         bool hasPerformedJointLookup = false;
@@ -62,7 +62,7 @@ protected:
 
     AnimPoseVec _poses;
     float _alpha;
-    QString _alphaVar;
+    AnimVariantKey _alphaVar;
 
     std::vector<JointVar> _jointVars;
 
@@ -109,9 +109,8 @@ const AnimPoseVec& AnimRandomSwitch::evaluate(const AnimVariantMap& animVars, co
     if (_duringInterp) {
         _alpha += _alphaVel * dt;
         if (_alpha < 1.0f) {
-            AnimPoseVec* nextPoses = nullptr;
-            AnimPoseVec* prevPoses = nullptr;
-            AnimPoseVec localNextPoses;
+            const AnimPoseVec* nextPoses = nullptr;
+            const AnimPoseVec* prevPoses = nullptr;
             AnimPoseVec localPrevPoses;
             if (_interpType == InterpType::SnapshotBoth) {
                 // interp between both snapshots
@@ -120,14 +119,16 @@ const AnimPoseVec& AnimRandomSwitch::evaluate(const AnimVariantMap& animVars, co
             } else if (_interpType == InterpType::SnapshotPrev) {
                 // interp between the prev snapshot and evaluated next target.
                 // this is useful for interping into a blend
-                localNextPoses = currentStateNode->evaluate(animVars, context, dt, triggersOut);
                 prevPoses = &_prevPoses;
-                nextPoses = &localNextPoses;
+                nextPoses = &currentStateNode->evaluate(animVars, context, dt, triggersOut);
             } else if (_interpType == InterpType::EvaluateBoth) {
-                localPrevPoses = previousStateNode->evaluate(animVars, context, dt, triggersOut);
-                localNextPoses = currentStateNode->evaluate(animVars, context, dt, triggersOut);
-                prevPoses = &localPrevPoses;
-                nextPoses = &localNextPoses;
+                // the evaluated poses are only copied when both states are the same node, which evaluates them twice
+                prevPoses = &previousStateNode->evaluate(animVars, context, dt, triggersOut);
+                if (previousStateNode == currentStateNode) {
+                    localPrevPoses = *prevPoses;
+                    prevPoses = &localPrevPoses;
+                }
+                nextPoses = &currentStateNode->evaluate(animVars, context, dt, triggersOut);
             } else {
                 assert(false);
             }
@@ -197,7 +197,9 @@ void AnimSkeleton::mirrorRelativePoses(AnimPoseVec& poses) const {
 }
 
 void AnimSkeleton::mirrorAbsolutePoses(AnimPoseVec& poses) const {
-    AnimPoseVec temp = poses;
+    // kept from one call to the next so that it isn't reallocated every frame, rigs are evaluated on several threads
+    static thread_local AnimPoseVec temp;
+    temp.assign(poses.begin(), poses.end());
     for (int i = 0; i < (int)poses.size(); i++) {
         poses[_mirrorMap[i]] = temp[i].mirror();
     }
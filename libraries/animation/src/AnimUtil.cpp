@@ -13,19 +13,88 @@
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
-void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
-    for (size_t i = 0; i < numPoses; i++) {
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include <emmintrin.h>
+
+// safeLerp() of the rotations of four poses at once: the rotations are transposed into one register per component, so that
+// the dot products, sign flips and normalizations of the four joints are done together.
+static inline void safeLerp4(const AnimPose* a, const AnimPose* b, __m128 alpha, AnimPose* result) {
+    __m128 a0 = _mm_loadu_ps((const float*)&a[0].rot());
+    __m128 a1 = _mm_loadu_ps((const float*)&a[1].rot());
+    __m128 a2 = _mm_loadu_ps((const float*)&a[2].rot());
+    __m128 a3 = _mm_loadu_ps((const float*)&a[3].rot());
+    _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+
+    __m128 b0 = _mm_loadu_ps((const float*)&b[0].rot());
+    __m128 b1 = _mm_loadu_ps((const float*)&b[1].rot());
+    __m128 b2 = _mm_loadu_ps((const float*)&b[2].rot());
+    __m128 b3 = _mm_loadu_ps((const float*)&b[3].rot());
+    _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+
+    // adjust signs if necessary
+    __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1)), _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3)));
+    __m128 sign = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+    b0 = _mm_xor_ps(b0, sign);
+    b1 = _mm_xor_ps(b1, sign);
+    b2 = _mm_xor_ps(b2, sign);
+    b3 = _mm_xor_ps(b3, sign);
+
+    __m128 r0 = _mm_add_ps(a0, _mm_mul_ps(_mm_sub_ps(b0, a0), alpha));
+    __m128 r1 = _mm_add_ps(a1, _mm_mul_ps(_mm_sub_ps(b1, a1), alpha));
+    __m128 r2 = _mm_add_ps(a2, _mm_mul_ps(_mm_sub_ps(b2, a2), alpha));
+    __m128 r3 = _mm_add_ps(a3, _mm_mul_ps(_mm_sub_ps(b3, a3), alpha));
+
+    // a full precision normalize, like the scalar one
+    __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)),
+                                           _mm_add_ps(_mm_mul_ps(r2, r2), _mm_mul_ps(r3, r3))));
+    r0 = _mm_div_ps(r0, length);
+    r1 = _mm_div_ps(r1, length);
+    r2 = _mm_div_ps(r2, length);
+    r3 = _mm_div_ps(r3, length);
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps((float*)&result[0].rot(), r0);
+    _mm_storeu_ps((float*)&result[1].rot(), r1);
+    _mm_storeu_ps((float*)&result[2].rot(), r2);
+    _mm_storeu_ps((float*)&result[3].rot(), r3);
+}
+#endif
+
+// result can be a or b
+template <bool WEIGHTED>
+static inline void blendPoses(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* weights, float alpha,
+                              AnimPose* result) {
+    size_t i = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    for (; i + 4 <= numPoses; i += 4) {
+        __m128 alpha4 = WEIGHTED ? _mm_mul_ps(_mm_loadu_ps(&weights[i]), _mm_set1_ps(alpha)) : _mm_set1_ps(alpha);
+        safeLerp4(&a[i], &b[i], alpha4, &result[i]);
+        for (size_t j = i; j < i + 4; j++) {
+            float poseAlpha = WEIGHTED ? weights[j] * alpha : alpha;
+            result[j].scale() = lerp(a[j].scale(), b[j].scale(), poseAlpha);
+            result[j].trans() = lerp(a[j].trans(), b[j].trans(), poseAlpha);
+        }
+    }
+#endif
+    for (; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
+        float poseAlpha = WEIGHTED ? weights[i] * alpha : alpha;
 
-        result[i].scale() = lerp(aPose.scale(), bPose.scale(), alpha);
-        result[i].rot() = safeLerp(aPose.rot(), bPose.rot(), alpha);
-        result[i].trans() = lerp(aPose.trans(), bPose.trans(), alpha);
+        result[i].scale() = lerp(aPose.scale(), bPose.scale(), poseAlpha);
+        result[i].rot() = safeLerp(aPose.rot(), bPose.rot(), poseAlpha);
+        result[i].trans() = lerp(aPose.trans(), bPose.trans(), poseAlpha);
     }
 }
 
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    blendPoses<false>(numPoses, a, b, nullptr, alpha, result);
+}
+
+void blendWeighted(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* weights, float alpha, AnimPose* result) {
+    blendPoses<true>(numPoses, a, b, weights, alpha, result);
+}
+
 void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
@@ -16,6 +16,9 @@
 // this is where the magic happens
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
 
+// blend between two sets of poses with a weight per pose, the alpha of pose i being weights[i] * alpha
+void blendWeighted(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* weights, float alpha, AnimPose* result);
+
 // blend between three sets of poses
 void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result);
 
@@ -11,6 +11,8 @@
 
 #include "AnimVariant.h" // which has AnimVariant/AnimVariantMap
 
+#include <QHash>
+#include <QReadWriteLock>
 #include <QScriptEngine>
 #include <QScriptValueIterator>
 #include <QThread>
@@ -18,6 +20,68 @@
 
 const AnimVariant AnimVariant::False = AnimVariant();
 
+namespace {
+    // the interned names, constructed on first use as keys may be static
+    struct AnimVariantKeys {
+        QReadWriteLock lock;
+        QHash<QString, int> slots;
+        std::vector<QString> names;
+    };
+
+    AnimVariantKeys& animVariantKeys() {
+        static AnimVariantKeys keys;
+        return keys;
+    }
+}
+
+int AnimVariantKey::intern(const QString& name) {
+    if (name.isEmpty()) {
+        return -1;
+    }
+    auto& keys = animVariantKeys();
+    {
+        QReadLocker locker(&keys.lock);
+        auto iter = keys.slots.constFind(name);
+        if (iter != keys.slots.constEnd()) {
+            return iter.value();
+        }
+    }
+    QWriteLocker locker(&keys.lock);
+    auto iter = keys.slots.constFind(name);
+    if (iter != keys.slots.constEnd()) {
+        return iter.value();
+    }
+    int slot = (int)keys.names.size();
+    keys.names.push_back(name);
+    keys.slots.insert(name, slot);
+    return slot;
+}
+
+int AnimVariantKey::find(const QString& name) {
+    if (name.isEmpty()) {
+        return -1;
+    }
+    auto& keys = animVariantKeys();
+    QReadLocker locker(&keys.lock);
+    return keys.slots.value(name, -1);
+}
+
+QString AnimVariantKey::nameOf(int slot) {
+    auto& keys = animVariantKeys();
+    QReadLocker locker(&keys.lock);
+    return slot >= 0 && slot < (int)keys.names.size() ? keys.names[slot] : QString();
+}
+
+std::map<QString, AnimVariant> AnimVariantMap::toNamedVariants() const {
+    std::map<QString, AnimVariant> result;
+    for (int slot = 0; slot < (int)_isSet.size(); ++slot) {
+        if (_isSet[slot]) {
+            result[AnimVariantKey::nameOf(slot)] = _slots[slot];
+        }
+    }
+    return result;
+}
+
 QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine, const QStringList& names, bool useNames) const {
     if (QThread::currentThread() != engine->thread()) {
         qCWarning(animation) << "Cannot create Javacript object from non-script thread" << QThread::currentThread();
@@ -52,16 +116,14 @@ QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine,
     };
     if (useNames) { // copy only the requested names
         for (const QString& name : names) {
-            auto search = _map.find(name);
-            if (search != _map.end()) {
-                setOne(name, search->second);
-            } else if (_triggers.count(name) == 1) {
-                target.setProperty(name, true);
+            const AnimVariant* var = find(name);
+            if (var) {
+                setOne(name, *var);
             } // scripts are allowed to request names that do not exist
         }
 
     } else {  // copy all of them
-        for (auto& pair : _map) {
+        for (auto& pair : toNamedVariants()) {
             setOne(pair.first, pair.second);
         }
     }
@@ -69,8 +131,10 @@ QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine,
 }
 
 void AnimVariantMap::copyVariantsFrom(const AnimVariantMap& other) {
-    for (auto& pair : other._map) {
-        _map[pair.first] = pair.second;
+    for (int slot = 0; slot < (int)other._isSet.size(); ++slot) {
+        if (other._isSet[slot]) {
+            setSlot(slot, other._slots[slot]);
+        }
     }
 }
 
@@ -128,7 +192,7 @@ void AnimVariantMap::animVariantMapFromScriptValue(const QScriptValue& source) {
 
 std::map<QString, QString> AnimVariantMap::toDebugMap() const {
     std::map<QString, QString> result;
-    for (auto& pair : _map) {
+    for (auto& pair : toNamedVariants()) {
         switch (pair.second.getType()) {
         case AnimVariant::Type::Bool:
             result[pair.first] = QString("%1").arg(pair.second.getBool());
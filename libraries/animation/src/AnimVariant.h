@@ -17,6 +17,7 @@
 #include <glm/gtx/quaternion.hpp>
 #include <map>
 #include <set>
+#include <vector>
 #include <QScriptValue>
 #include <StreamUtils.h>
 #include <GLMHelpers.h>
@@ -114,118 +115,117 @@ protected:
     } _val;
 };
 
+// The name of an anim var, interned to a slot of AnimVariantMap. The nodes of the anim graph resolve their var names
+// to keys once, as they are loaded, and then look their vars up by slot instead of by name on every frame.
+// The slots are interned for the process and shared by all the maps, names are never released.
+class AnimVariantKey {
+public:
+    AnimVariantKey() {}
+    AnimVariantKey(const QString& name) : _name(name), _slot(intern(name)) {}
+
+    const QString& getName() const { return _name; }
+    int getSlot() const { return _slot; }
+    bool isEmpty() const { return _slot < 0; }
+    operator const QString&() const { return _name; }
+
+    // the slot of name, interned if it isn't yet, -1 for an empty name
+    static int intern(const QString& name);
+
+    // the slot of name, -1 if it was never interned
+    static int find(const QString& name);
+
+    static QString nameOf(int slot);
+
+private:
+    QString _name;
+    int _slot { -1 };
+};
+
 class AnimVariantMap {
 public:
 
-    bool lookup(const QString& key, bool defaultValue) const {
-        // check triggers first, then map
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else if (_triggers.find(key) != _triggers.end()) {
-            return true;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getBool() : defaultValue;
-        }
+    // The lookups take an AnimVariantKey from the anim graph, or a name (scripts, Rig).
+
+    template <typename Key>
+    bool lookup(const Key& key, bool defaultValue) const {
+        const AnimVariant* var = find(key);
+        return var ? var->getBool() : defaultValue;
     }
 
-    int lookup(const QString& key, int defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getInt() : defaultValue;
-        }
+    template <typename Key>
+    int lookup(const Key& key, int defaultValue) const {
+        const AnimVariant* var = find(key);
+        return var ? var->getInt() : defaultValue;
     }
 
-    float lookup(const QString& key, float defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getFloat() : defaultValue;
-        }
+    template <typename Key>
+    float lookup(const Key& key, float defaultValue) const {
+        const AnimVariant* var = find(key);
+        return var ? var->getFloat() : defaultValue;
     }
 
-    const glm::vec3& lookupRaw(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getVec3() : defaultValue;
-        }
+    template <typename Key>
+    const glm::vec3& lookupRaw(const Key& key, const glm::vec3& defaultValue) const {
+        const AnimVariant* var = find(key);
+        return var ? var->getVec3() : defaultValue;
     }
 
-    glm::vec3 lookupRigToGeometry(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformPoint(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
-        }
+    template <typename Key>
+    glm::vec3 lookupRigToGeometry(const Key& key, const glm::vec3& defaultValue) const {
+        const AnimVariant* var = find(key);
+        return var ? transformPoint(_rigToGeometryMat, var->getVec3()) : defaultValue;
     }
 
-    glm::vec3 lookupRigToGeometryVector(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformVectorFast(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
-        }
+    template <typename Key>
+    glm::vec3 lookupRigToGeometryVector(const Key& key, const glm::vec3& defaultValue) const {
+        const AnimVariant* var = find(key);
+        return var ? transformVectorFast(_rigToGeometryMat, var->getVec3()) : defaultValue;
     }
 
-    const glm::quat& lookupRaw(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getQuat() : defaultValue;
-        }
+    template <typename Key>
+    const glm::quat& lookupRaw(const Key& key, const glm::quat& defaultValue) const {
+        const AnimVariant* var = find(key);
+        return var ? var->getQuat() : defaultValue;
     }
 
-    glm::quat lookupRigToGeometry(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? _rigToGeometryRot * iter->second.getQuat() : defaultValue;
-        }
+    template <typename Key>
+    glm::quat lookupRigToGeometry(const Key& key, const glm::quat& defaultValue) const {
+        const AnimVariant* var = find(key);
+        return var ? _rigToGeometryRot * var->getQuat() : defaultValue;
     }
 
-    const QString& lookup(const QString& key, const QString& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getString() : defaultValue;
-        }
+    template <typename Key>
+    const QString& lookup(const Key& key, const QString& defaultValue) const {
+        const AnimVariant* var = find(key);
+        return var ? var->getString() : defaultValue;
     }
 
-    void set(const QString& key, bool value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, int value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, float value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::vec3& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::quat& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const QString& value) { _map[key] = AnimVariant(value); }
-    void unset(const QString& key) { _map.erase(key); }
+    void set(const QString& key, bool value) { setSlot(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, int value) { setSlot(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, float value) { setSlot(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, const glm::vec3& value) { setSlot(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, const glm::quat& value) { setSlot(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void set(const QString& key, const QString& value) { setSlot(AnimVariantKey::intern(key), AnimVariant(value)); }
+    void unset(const QString& key) { unsetSlot(AnimVariantKey::find(key)); }
 
-    void setTrigger(const QString& key) { _map[key] = AnimVariant(true); }
+    void setTrigger(const QString& key) { setSlot(AnimVariantKey::intern(key), AnimVariant(true)); }
+    void setTrigger(const AnimVariantKey& key) { setSlot(key.getSlot(), AnimVariant(true)); }
 
     void setRigToGeometryTransform(const glm::mat4& rigToGeometry) {
         _rigToGeometryMat = rigToGeometry;
         _rigToGeometryRot = glmExtractRotation(rigToGeometry);
     }
 
-    void clearMap() { _map.clear(); _triggers.clear(); }
-    bool hasKey(const QString& key) const { return _map.find(key) != _map.end(); }
+    // keeps the storage, the trigger maps are cleared every frame
+    void clearMap() { _slots.clear(); _isSet.clear(); }
 
-    const AnimVariant& get(const QString& key) const {
-        auto iter = _map.find(key);
-        if (iter != _map.end()) {
-            return iter->second;
-        } else {
-            return AnimVariant::False;
-        }
+    template <typename Key>
+    bool hasKey(const Key& key) const { return find(key) != nullptr; }
+
+    template <typename Key>
+    const AnimVariant& get(const Key& key) const {
+        const AnimVariant* var = find(key);
+        return var ? *var : AnimVariant::False;
     }
 
     // Answer a Plain Old Javascript Object (for the given engine) all of our values set as properties.
@@ -240,7 +240,7 @@ public:
 #ifndef NDEBUG
     void dump() const {
         qCDebug(animation) << "AnimVariantMap =";
-        for (auto& pair : _map) {
+        for (auto& pair : toNamedVariants()) {
             switch (pair.second.getType()) {
             case AnimVariant::Type::Bool:
                 qCDebug(animation) << "    " << pair.first << "=" << pair.second.getBool();
@@ -268,8 +268,35 @@ public:
 #endif
 
 protected:
-    std::map<QString, AnimVariant> _map;
-    std::set<QString> _triggers;
+    const AnimVariant* find(int slot) const {
+        return slot >= 0 && slot < (int)_isSet.size() && _isSet[slot] ? &_slots[slot] : nullptr;
+    }
+    const AnimVariant* find(const AnimVariantKey& key) const { return find(key.getSlot()); }
+    const AnimVariant* find(const QString& key) const { return find(AnimVariantKey::find(key)); }
+
+    void setSlot(int slot, const AnimVariant& value) {
+        if (slot < 0) {
+            return;
+        }
+        if (slot >= (int)_slots.size()) {
+            _slots.resize(slot + 1);
+            _isSet.resize(slot + 1, 0);
+        }
+        _slots[slot] = value;
+        _isSet[slot] = 1;
+    }
+    void unsetSlot(int slot) {
+        if (slot >= 0 && slot < (int)_isSet.size()) {
+            _slots[slot] = AnimVariant();
+            _isSet[slot] = 0;
+        }
+    }
+
+    // the vars that are set, by name
+    std::map<QString, AnimVariant> toNamedVariants() const;
+
+    std::vector<AnimVariant> _slots;    // by AnimVariantKey slot
+    std::vector<uint8_t> _isSet;
     glm::mat4 _rigToGeometryMat;
     glm::quat _rigToGeometryRot;
 };
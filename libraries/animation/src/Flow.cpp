@@ -9,6 +9,9 @@
 //
 
 #include "Flow.h"
+
+#include <float.h>
+
 #include "Rig.h"
 #include "AnimSkeleton.h"
 
@@ -84,7 +87,7 @@ void FlowCollisionSystem::resetCollisions() {
     _selfCollisions.clear();
 }
 
-FlowCollisionResult FlowCollisionSystem::computeCollision(const std::vector<FlowCollisionResult> collisions) {
+FlowCollisionResult FlowCollisionSystem::computeCollision(const std::vector<FlowCollisionResult>& collisions) {
     FlowCollisionResult result;
     if (collisions.size() > 1) {
         for (size_t i = 0; i < collisions.size(); i++) {
@@ -118,11 +121,30 @@ void FlowCollisionSystem::setScale(float scale) {
     }
 };
 
-std::vector<FlowCollisionResult> FlowCollisionSystem::checkFlowThreadCollisions(FlowThread* flowThread) {
-    std::vector<std::vector<FlowCollisionResult>> FlowThreadResults;
+const std::vector<FlowCollisionResult>& FlowCollisionSystem::checkFlowThreadCollisions(FlowThread* flowThread) {
+    auto& FlowThreadResults = _jointCollisions;
     FlowThreadResults.resize(flowThread->_joints.size());
+    for (auto& jointCollisions : FlowThreadResults) {
+        jointCollisions.clear();
+    }
+
+    // the box around the thread, a sphere that doesn't reach it can't collide with any of its joints or segments.
+    // this makes the spheres of the other avatars' hands and the ones on the other side of the body cheap.
+    glm::vec3 boundsMin(FLT_MAX);
+    glm::vec3 boundsMax(-FLT_MAX);
+    for (auto& position : flowThread->_positions) {
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
+    boundsMin -= glm::vec3(flowThread->_radius);
+    boundsMax += glm::vec3(flowThread->_radius);
+
     for (size_t j = 0; j < _allCollisions.size(); j++) {
         FlowCollisionSphere &sphere = _allCollisions[j];
+        glm::vec3 closestPoint = glm::clamp(sphere._position, boundsMin, boundsMax);
+        if (glm::length2(sphere._position - closestPoint) > sphere._radius * sphere._radius) {
+            continue;
+        }
         FlowCollisionResult rootCollision = sphere.computeSphereCollision(flowThread->_positions[0], flowThread->_radius);
         std::vector<FlowCollisionResult> collisionData = { rootCollision };
         bool tooFar = rootCollision._distance >(flowThread->_length + rootCollision._radius);
@@ -161,11 +183,11 @@ std::vector<FlowCollisionResult> FlowCollisionSystem::checkFlowThreadCollisions(
         }
     }
 
-    std::vector<FlowCollisionResult> results;
+    _jointResults.resize(flowThread->_joints.size());
     for (size_t i = 0; i < flowThread->_joints.size(); i++) {
-        results.push_back(computeCollision(FlowThreadResults[i]));
+        _jointResults[i] = computeCollision(FlowThreadResults[i]);
     }
-    return results;
+    return _jointResults;
 };
 
 FlowCollisionSettings FlowCollisionSystem::getCollisionSettingsByJoint(int jointIndex) {
@@ -359,13 +381,12 @@ void FlowThread::computeFlowThread(int rootIndex) {
 };
 
 void FlowThread::computeRecovery() {
-    int parentIndex = _joints[0];
-    auto parentJoint = _jointsPointer->at(parentIndex);
-    _jointsPointer->at(parentIndex)._recoveryPosition = parentJoint._recoveryPosition = parentJoint._currentPosition;
-    glm::quat parentRotation = parentJoint._parentWorldRotation * parentJoint._initialRotation;
+    FlowJoint* parentJoint = &_jointsPointer->at(_joints[0]);
+    parentJoint->_recoveryPosition = parentJoint->_currentPosition;
+    glm::quat parentRotation = parentJoint->_parentWorldRotation * parentJoint->_initialRotation;
     for (size_t i = 1; i < _joints.size(); i++) {
-        auto joint = _jointsPointer->at(_joints[i]);
-        _jointsPointer->at(_joints[i])._recoveryPosition = joint._recoveryPosition = parentJoint._recoveryPosition + (parentRotation * (joint._initialTranslation * 0.01f));
+        FlowJoint* joint = &_jointsPointer->at(_joints[i]);
+        joint->_recoveryPosition = parentJoint->_recoveryPosition + (parentRotation * (joint->_initialTranslation * 0.01f));
         parentJoint = joint;
     }
 };
@@ -384,7 +405,7 @@ void FlowThread::update(float deltaTime) {
 
 void FlowThread::solve(FlowCollisionSystem& collisionSystem) {
     if (collisionSystem.getActive()) {
-        auto bodyCollisions = collisionSystem.checkFlowThreadCollisions(this);
+        const auto& bodyCollisions = collisionSystem.checkFlowThreadCollisions(this);
         for (size_t i = 0; i < _joints.size(); i++) {
             int index = _joints[i];
             _jointsPointer->at(index).solve(bodyCollisions[i]);
@@ -402,33 +423,35 @@ void FlowThread::computeJointRotations() {
     auto pos0 = _rootFramePositions[0];
     auto pos1 = _rootFramePositions[1];
 
-    auto joint0 = _jointsPointer->at(_joints[0]);
-    auto joint1 = _jointsPointer->at(_joints[1]);
+    FlowJoint* joint0 = &_jointsPointer->at(_joints[0]);
+    FlowJoint* joint1 = &_jointsPointer->at(_joints[1]);
 
-    auto initial_pos1 = pos0 + (joint0._initialRotation * (joint1._initialTranslation * 0.01f));
+    auto initial_pos1 = pos0 + (joint0->_initialRotation * (joint1->_initialTranslation * 0.01f));
 
     auto vec0 = initial_pos1 - pos0;
     auto vec1 = pos1 - pos0;
 
     auto delta = rotationBetween(vec0, vec1);
 
-    joint0._currentRotation = _jointsPointer->at(_joints[0])._currentRotation = delta * joint0._initialRotation;
+    joint0->_currentRotation = delta * joint0->_initialRotation;
     
     for (size_t i = 1; i < _joints.size() - 1; i++) {
-        auto nextJoint = _jointsPointer->at(_joints[i + 1]);
+        FlowJoint* nextJoint = &_jointsPointer->at(_joints[i + 1]);
+        glm::quat inverseRotation = glm::inverse(joint0->_currentRotation);
+        glm::vec3 translation = joint0->_initialTranslation * 0.01f;
         for (size_t j = i; j < _joints.size(); j++) {
-            _rootFramePositions[j] = glm::inverse(joint0._currentRotation) * _rootFramePositions[j] - (joint0._initialTranslation * 0.01f);
+            _rootFramePositions[j] = inverseRotation * _rootFramePositions[j] - translation;
         }
         pos0 = _rootFramePositions[i];
         pos1 = _rootFramePositions[i + 1];
-        initial_pos1 = pos0 + joint1._initialRotation * (nextJoint._initialTranslation * 0.01f);
+        initial_pos1 = pos0 + joint1->_initialRotation * (nextJoint->_initialTranslation * 0.01f);
 
         vec0 = initial_pos1 - pos0;
         vec1 = pos1 - pos0;
 
         delta = rotationBetween(vec0, vec1);
 
-        joint1._currentRotation = _jointsPointer->at(joint1._index)._currentRotation = delta * joint1._initialRotation;
+        joint1->_currentRotation = delta * joint1->_initialRotation;
         joint0 = joint1;
         joint1 = nextJoint;
     }
@@ -135,9 +135,10 @@ class FlowCollisionSystem {
 public:
     FlowCollisionSystem() {};
     void addCollisionSphere(int jointIndex, const FlowCollisionSettings& settings, const glm::vec3& position = { 0.0f, 0.0f, 0.0f }, bool isSelfCollision = true, bool isTouch = false);
-    FlowCollisionResult computeCollision(const std::vector<FlowCollisionResult> collisions);
+    FlowCollisionResult computeCollision(const std::vector<FlowCollisionResult>& collisions);
 
-    std::vector<FlowCollisionResult> checkFlowThreadCollisions(FlowThread* flowThread);
+    // the results are valid until the next thread is checked
+    const std::vector<FlowCollisionResult>& checkFlowThreadCollisions(FlowThread* flowThread);
 
     std::vector<FlowCollisionSphere>& getSelfCollisions() { return _selfCollisions; };
     std::vector<FlowCollisionSphere>& getSelfTouchCollisions() { return _selfTouchCollisions; };
@@ -157,6 +158,9 @@ protected:
     std::vector<FlowCollisionSphere> _othersCollisions;
     std::vector<FlowCollisionSphere> _selfTouchCollisions;
     std::vector<FlowCollisionSphere> _allCollisions;
+    // per thread joint, reused from one thread to the next
+    std::vector<std::vector<FlowCollisionResult>> _jointCollisions;
+    std::vector<FlowCollisionResult> _jointResults;
     float _scale { 1.0f };
     bool _active { false };
 };
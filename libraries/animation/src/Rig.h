@@ -155,6 +155,7 @@ public:
     float getMaxHipsOffsetLength() const;
 
     float getIKErrorOnLastSolve() const;
+    int getIKIterationsOnLastSolve() const;
 
     int getJointParentIndex(int childIndex) const;
 
@@ -11,6 +11,8 @@
 
 #include "AudioClient.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <cstring>
 #include <math.h>
 #include <sys/stat.h>
@@ -66,6 +68,11 @@ static const int CHECK_INPUT_READS_MSECS = 2000;
 static const int MIN_READS_TO_CONSIDER_INPUT_ALIVE = 10;
 #endif
 
+// the local injectors rendered at most each frame, the quietest others are stolen
+static const int MAX_LOCAL_INJECTOR_VOICES = 64;
+// -60 dB, these are skipped whatever the number of voices
+static const float MIN_AUDIBLE_LOCAL_INJECTOR_GAIN = 0.001f;
+
 const AudioClient::AudioPositionGetter  AudioClient::DEFAULT_POSITION_GETTER = []{ return Vectors::ZERO; };
 const AudioClient::AudioOrientationGetter AudioClient::DEFAULT_ORIENTATION_GETTER = [] { return Quaternions::IDENTITY; };
 
@@ -310,11 +317,49 @@ static inline float convertToFloat(int16_t sample) {
     return (float)sample * (1 / 32768.0f);
 }
 
+AudioClient::LocalInjectorsThread::LocalInjectorsThread(AudioClient* audioClient) : _audioClient(audioClient) {
+    setObjectName("Audio: Local Injectors");
+}
+
+void AudioClient::LocalInjectorsThread::run() {
+    setThreadName(objectName().toStdString());
+
+    // a wake can be missed between the check and the wait, the timeout bounds the delay to a network frame
+    const auto MAX_WAIT = std::chrono::microseconds(AudioConstants::NETWORK_FRAME_USECS);
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stop) {
+        if (!_wakeRequested.exchange(false, std::memory_order_acq_rel)) {
+            _condition.wait_for(lock, MAX_WAIT);
+            continue;
+        }
+        lock.unlock();
+        _audioClient->prepareLocalAudioInjectors();
+        lock.lock();
+    }
+}
+
+void AudioClient::LocalInjectorsThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _condition.notify_one();
+    wait();
+}
+
+void AudioClient::LocalInjectorsThread::wake() {
+    _wakeRequested.store(true, std::memory_order_release);
+    _condition.notify_one();
+}
+
 AudioClient::AudioClient() {
 
     // avoid putting a lock in the device callback
     assert(_localSamplesAvailable.is_lock_free());
 
+    _localInjectorsThread.start(QThread::HighPriority);
+    _localInjectorVoices.reserve(MAX_LOCAL_INJECTOR_VOICES);
+
     // deprecate legacy settings
     {
         Setting::Handle<int>::Deprecated("maxFramesOverDesired", InboundAudioStream::MAX_FRAMES_OVER_DESIRED);
@@ -377,6 +422,10 @@ AudioClient::AudioClient() {
         PacketReceiver::makeUnsourcedListenerReference<AudioClient>(this, &AudioClient::handleAudioDataPacket));
     packetReceiver.registerListener(PacketType::MixedAudio,
         PacketReceiver::makeUnsourcedListenerReference<AudioClient>(this, &AudioClient::handleAudioDataPacket));
+    packetReceiver.registerListener(PacketType::MixedAudioWithAmbisonicBed,
+        PacketReceiver::makeUnsourcedListenerReference<AudioClient>(this, &AudioClient::handleAudioDataPacket));
+    packetReceiver.registerListener(PacketType::AudioParity,
+        PacketReceiver::makeUnsourcedListenerReference<AudioClient>(this, &AudioClient::handleAudioParityPacket));
     packetReceiver.registerListener(PacketType::NoisyMute,
         PacketReceiver::makeUnsourcedListenerReference<AudioClient>(this, &AudioClient::handleNoisyMutePacket));
     packetReceiver.registerListener(PacketType::MuteEnvironment,
@@ -419,6 +468,7 @@ void AudioClient::handleMismatchAudioFormat(SharedNodePointer node, const QStrin
 
 
 void AudioClient::reset() {
+    _fecDecoder.reset([](const QSharedPointer<ReceivedMessage>&) {});
     _receivedAudioStream.reset();
     _stats.reset();
     _sourceReverb.reset();
@@ -820,6 +870,8 @@ void AudioClient::stop() {
     qCDebug(audioclient) << "AudioClient::stop(), requesting switchOutputToAudioDevice() to shut down";
     switchOutputToAudioDevice(HifiAudioDeviceInfo(), true);
 
+    _localInjectorsThread.stop();
+
     // Stop triggering the checks
     QObject::disconnect(_checkPeakValuesTimer, &QTimer::timeout, nullptr, nullptr);
     QObject::disconnect(_checkDevicesTimer, &QTimer::timeout, nullptr, nullptr);
@@ -876,13 +928,31 @@ void AudioClient::handleAudioDataPacket(QSharedPointer<ReceivedMessage> message)
             emit receivedFirstPacket();
         }
 
+        if (_fecEncoder.getGroupSize() > 0) {
+            _fecDecoder.handleAudioPacket(message, [this](const QSharedPointer<ReceivedMessage>& message) {
+                parseAudioDataPacket(message);
+            });
+        } else {
+            parseAudioDataPacket(message);
+        }
+    }
+}
+
+void AudioClient::handleAudioParityPacket(QSharedPointer<ReceivedMessage> message) {
+    if (_audioOutput && _fecEncoder.getGroupSize() > 0) {
+        _fecDecoder.handleParityPacket(*message, [this](const QSharedPointer<ReceivedMessage>& message) {
+            parseAudioDataPacket(message);
+        });
+    }
+}
+
+void AudioClient::parseAudioDataPacket(const QSharedPointer<ReceivedMessage>& message) {
 #if DEV_BUILD || PR_BUILD
-        _gate.insert(message);
+    _gate.insert(message);
 #else
-        // Audio output must exist and be correctly set up if we're going to process received audio
-        _receivedAudioStream.parseData(*message);
+    // Audio output must exist and be correctly set up if we're going to process received audio
+    _receivedAudioStream.parseData(*message);
 #endif
-    }
 }
 
 AudioClient::Gate::Gate(AudioClient* audioClient) :
@@ -969,6 +1039,10 @@ void AudioClient::negotiateAudioFormat() {
         auto codecName = plugin->getName();
         negotiateFormatPacket->writeString(codecName);
     }
+    // ask for forward error correction, the mixer replies with the group size both ends use
+    negotiateFormatPacket->writePrimitive((quint8)AudioFEC::clampGroupSize(_fecGroupSizeSetting.get()));
+    // and offer to render the distant sources from an ambisonic bed, if the mixer makes one
+    negotiateFormatPacket->writePrimitive((quint8)_ambisonicBedSetting.get());
 
     // grab our audio mixer from the NodeList, if it exists
     SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
@@ -981,6 +1055,28 @@ void AudioClient::negotiateAudioFormat() {
 
 void AudioClient::handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message) {
     QString selectedCodecName = message->readString();
+
+    // older mixers don't reply with a group size, they don't do forward error correction
+    quint8 fecGroupSize = 0;
+    if (message->getBytesLeftToRead() >= (qint64)sizeof(fecGroupSize)) {
+        message->readPrimitive(&fecGroupSize);
+    }
+    if (fecGroupSize != _fecEncoder.getGroupSize()) {
+        qCDebug(audioclient) << "Audio FEC group size:" << fecGroupSize;
+        _fecEncoder.setGroupSize(fecGroupSize);
+        _fecDecoder.reset([this](const QSharedPointer<ReceivedMessage>& message) {
+            parseAudioDataPacket(message);
+        });
+    }
+
+    quint8 hasAmbisonicBed = 0;
+    if (message->getBytesLeftToRead() >= (qint64)sizeof(hasAmbisonicBed)) {
+        message->readPrimitive(&hasAmbisonicBed);
+    }
+    if ((hasAmbisonicBed != 0) != _hasAmbisonicBed) {
+        _hasAmbisonicBed = hasAmbisonicBed != 0;
+        qCDebug(audioclient) << "Audio mixer ambisonic bed:" << (_hasAmbisonicBed ? "enabled" : "disabled");
+    }
     selectAudioFormat(selectedCodecName);
 }
 
@@ -1411,7 +1507,7 @@ void AudioClient::handleAudioInput(QByteArray& audioBuffer) {
 
         emitAudioPacket(encodedBuffer.data(), encodedBuffer.size(), _outgoingAvatarAudioSequenceNumber, _isStereoInput,
                         audioTransform, avatarBoundingBoxCorner, avatarBoundingBoxScale,
-                        packetType, _selectedCodecName);
+                        packetType, _selectedCodecName, &_fecEncoder);
         _stats.sentPacket();
     }
 }
@@ -1542,7 +1638,7 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
         }
 
         // get a network frame of local injectors' audio
-        if (!mixLocalAudioInjectors(_localMixBuffer)) {
+        if (!mixLocalAudioInjectors(_localMixBuffer, doSynchronously)) {
             break;
         }
 
@@ -1573,113 +1669,129 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
     }
 }
 
-bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
+bool AudioClient::mixLocalAudioInjectors(float* mixBuffer, bool tryLock) {
     // check the flag for injectors before attempting to lock
     if (!_localInjectorsAvailable.load(std::memory_order_acquire)) {
         return false;
     }
 
     // lock the injectors
-    Lock lock(_injectorsMutex);
+    Lock lock(_injectorsMutex, std::defer_lock);
+    if (!tryLock) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return false;
+    }
 
     QVector<AudioInjectorPointer> injectorsToRemove;
 
     memset(mixBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
 
+    // first pick the voices to render, the loudest ones: the gains and the distances are computed once per frame
+    _localInjectorVoices.clear();
     for (const AudioInjectorPointer& injector : _activeLocalAudioInjectors) {
         // the lock guarantees that injectorBuffer, if found, is invariant
-        auto injectorBuffer = injector->getLocalBuffer();
-        if (injectorBuffer) {
-
-            auto options = injector->getOptions();
+        if (!injector->getLocalBuffer()) {
+            //qCDebug(audioclient) << "injector has no local buffer, marking as finished for removal";
+            injector->finishLocalInjection();
+            injectorsToRemove.append(injector);
+            continue;
+        }
 
-            static const int HRTF_DATASET_INDEX = 1;
+        LocalInjectorVoice voice;
+        voice.injector = injector;
+        voice.options = injector->getOptions();
 
-            int numChannels = options.ambisonic ? AudioConstants::AMBISONIC : (options.stereo ? AudioConstants::STEREO : AudioConstants::MONO);
-            size_t bytesToRead = numChannels * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
+        bool isSystemSound = !voice.options.positionSet && !voice.options.ambisonic;
+        voice.gain = voice.options.volume * (isSystemSound ? _systemInjectorGain : _localInjectorGain);
+        if (voice.options.positionSet) {
+            // distance attenuation
+            voice.relativePosition = voice.options.position - _positionGetter();
+            voice.distance = glm::max(glm::length(voice.relativePosition), EPSILON);
+            voice.gain = gainForSource(voice.distance, voice.gain);
+        }
 
-            // get one frame from the injector
-            memset(_localScratchBuffer, 0, bytesToRead);
-            if (0 < injectorBuffer->readData((char*)_localScratchBuffer, bytesToRead)) {
+        // the system sounds are the interface's own, they are never stolen
+        voice.priority = isSystemSound ? FLT_MAX : voice.gain;
+        voice.isAudible = voice.gain > MIN_AUDIBLE_LOCAL_INJECTOR_GAIN;
+        _localInjectorVoices.push_back(voice);
+    }
 
-                bool isSystemSound = !options.positionSet && !options.ambisonic;
+    // beyond the voice limit, the quietest injectors are stolen for this frame
+    auto audibleEnd = std::partition(_localInjectorVoices.begin(), _localInjectorVoices.end(),
+        [](const LocalInjectorVoice& voice) { return voice.isAudible; });
+    int numAudible = (int)(audibleEnd - _localInjectorVoices.begin());
+    if (numAudible > MAX_LOCAL_INJECTOR_VOICES) {
+        std::nth_element(_localInjectorVoices.begin(), _localInjectorVoices.begin() + MAX_LOCAL_INJECTOR_VOICES, audibleEnd,
+            [](const LocalInjectorVoice& a, const LocalInjectorVoice& b) { return a.priority > b.priority; });
+        for (auto it = _localInjectorVoices.begin() + MAX_LOCAL_INJECTOR_VOICES; it != audibleEnd; ++it) {
+            it->isAudible = false;
+        }
+    }
 
-                float gain = options.volume * (isSystemSound ? _systemInjectorGain : _localInjectorGain);
+    for (const LocalInjectorVoice& voice : _localInjectorVoices) {
+        const AudioInjectorPointer& injector = voice.injector;
+        const AudioInjectorOptions& options = voice.options;
+        auto injectorBuffer = injector->getLocalBuffer();
 
-                if (options.ambisonic) {
+        static const int HRTF_DATASET_INDEX = 1;
 
-                    if (options.positionSet) {
+        int numChannels = options.ambisonic ? AudioConstants::AMBISONIC : (options.stereo ? AudioConstants::STEREO : AudioConstants::MONO);
+        size_t bytesToRead = numChannels * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
 
-                        // distance attenuation
-                        glm::vec3 relativePosition = options.position - _positionGetter();
-                        float distance = glm::max(glm::length(relativePosition), EPSILON);
-                        gain = gainForSource(distance, gain);
-                    }
+        // get one frame from the injector, the culled and stolen voices are only advanced, to stay in time
+        memset(_localScratchBuffer, 0, bytesToRead);
+        if (0 >= injectorBuffer->readData((char*)_localScratchBuffer, bytesToRead)) {
+            //qCDebug(audioclient) << "injector has no more data, marking finished for removal";
+            injector->finishLocalInjection();
+            injectorsToRemove.append(injector);
+            continue;
+        }
+        if (!voice.isAudible) {
+            continue;
+        }
 
-                    //
-                    // Calculate the soundfield orientation relative to the listener.
-                    // Injector orientation can be used to align a recording to our world coordinates.
-                    //
-                    glm::quat relativeOrientation = options.orientation * glm::inverse(_orientationGetter());
-
-                    // convert from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
-                    float qw = relativeOrientation.w;
-                    float qx = -relativeOrientation.z;
-                    float qy = -relativeOrientation.x;
-                    float qz = relativeOrientation.y;
-
-                    // spatialize into mixBuffer
-                    injector->getLocalFOA().render(_localScratchBuffer, mixBuffer, HRTF_DATASET_INDEX,
-                                                   qw, qx, qy, qz, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-                } else if (options.stereo) {
-
-                    if (options.positionSet) {
-
-                        // distance attenuation
-                        glm::vec3 relativePosition = options.position - _positionGetter();
-                        float distance = glm::max(glm::length(relativePosition), EPSILON);
-                        gain = gainForSource(distance, gain);
-                    }
+        float gain = voice.gain;
+        if (options.ambisonic) {
 
-                    // direct mix into mixBuffer
-                    injector->getLocalHRTF().mixStereo(_localScratchBuffer, mixBuffer, gain,
-                                                       AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-                } else {  // injector is mono
+            //
+            // Calculate the soundfield orientation relative to the listener.
+            // Injector orientation can be used to align a recording to our world coordinates.
+            //
+            glm::quat relativeOrientation = options.orientation * glm::inverse(_orientationGetter());
 
-                    if (options.positionSet) {
+            // convert from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
+            float qw = relativeOrientation.w;
+            float qx = -relativeOrientation.z;
+            float qy = -relativeOrientation.x;
+            float qz = relativeOrientation.y;
 
-                        // distance attenuation
-                        glm::vec3 relativePosition = options.position - _positionGetter();
-                        float distance = glm::max(glm::length(relativePosition), EPSILON);
-                        gain = gainForSource(distance, gain);
+            // spatialize into mixBuffer
+            injector->getLocalFOA().render(_localScratchBuffer, mixBuffer, HRTF_DATASET_INDEX,
+                                           qw, qx, qy, qz, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        } else if (options.stereo) {
 
-                        float azimuth = azimuthForSource(relativePosition);
+            // direct mix into mixBuffer
+            injector->getLocalHRTF().mixStereo(_localScratchBuffer, mixBuffer, gain,
+                                               AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        } else {  // injector is mono
 
-                        // spatialize into mixBuffer
-                        injector->getLocalHRTF().render(_localScratchBuffer, mixBuffer, HRTF_DATASET_INDEX,
-                                                        azimuth, distance, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-                    } else {
+            if (options.positionSet) {
 
-                        // direct mix into mixBuffer
-                        injector->getLocalHRTF().mixMono(_localScratchBuffer, mixBuffer, gain,
-                                                         AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-                    }
-                }
+                float azimuth = azimuthForSource(voice.relativePosition);
 
+                // spatialize into mixBuffer
+                injector->getLocalHRTF().render(_localScratchBuffer, mixBuffer, HRTF_DATASET_INDEX,
+                                                azimuth, voice.distance, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
             } else {
 
-                //qCDebug(audioclient) << "injector has no more data, marking finished for removal";
-                injector->finishLocalInjection();
-                injectorsToRemove.append(injector);
+                // direct mix into mixBuffer
+                injector->getLocalHRTF().mixMono(_localScratchBuffer, mixBuffer, gain,
+                                                 AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
             }
-
-        } else {
-
-            //qCDebug(audioclient) << "injector has no local buffer, marking as finished for removal";
-            injector->finishLocalInjection();
-            injectorsToRemove.append(injector);
         }
     }
+    _localInjectorVoices.clear();
 
     for (const AudioInjectorPointer& injector : injectorsToRemove) {
         //qCDebug(audioclient) << "removing injector";
@@ -2109,14 +2221,9 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
     // NOTE: device start() uses the Qt internal device list
     Lock lock(_deviceMutex);
 
-    _localSamplesAvailable.exchange(0, std::memory_order_release);
-
-    //wait on local injectors prep to finish running
-    if ( !_localPrepInjectorFuture.isFinished()) {
-        _localPrepInjectorFuture.waitForFinished();
-    }
-
+    // the local injectors thread writes to the local injectors' buffer with this lock held
     Lock localAudioLock(_localAudioMutex);
+    _localSamplesAvailable.exchange(0, std::memory_order_release);
 
     // cleanup any previously initialized device
     if (_audioOutput) {
@@ -2398,9 +2505,7 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
     }
     
     // prepare injectors for the next callback
-     _audio->_localPrepInjectorFuture = QtConcurrent::run(QThreadPool::globalInstance(), [this] {
-        _audio->prepareLocalAudioInjectors();
-    });
+    _audio->_localInjectorsThread.wake();
 
     int samplesPopped = std::max(networkSamplesPopped, injectorSamplesPopped);
     if (samplesPopped == 0) {
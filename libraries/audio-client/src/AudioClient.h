@@ -12,6 +12,8 @@
 #ifndef hifi_AudioClient_h
 #define hifi_AudioClient_h
 
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <memory>
 #include <vector>
@@ -23,12 +25,14 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
+#include <QtCore/QThread>
 #include <QtCore/QVector>
 #include <QtMultimedia/QAudio>
 #include <QtMultimedia/QAudioFormat>
 #include <QtMultimedia/QAudioInput>
 #include <AbstractAudioInterface.h>
 #include <AudioEffectOptions.h>
+#include <AudioFEC.h>
 #include <AudioStreamStats.h>
 #include <shared/WebRTC.h>
 
@@ -152,7 +156,10 @@ public:
     void setGateThreshold(int threshold) { _gate.setThreshold(threshold); }
 
     void setPositionGetter(AudioPositionGetter positionGetter) { _positionGetter = positionGetter; }
-    void setOrientationGetter(AudioOrientationGetter orientationGetter) { _orientationGetter = orientationGetter; }
+    void setOrientationGetter(AudioOrientationGetter orientationGetter) {
+        _orientationGetter = orientationGetter;
+        _receivedAudioStream.setOrientationGetter(orientationGetter);
+    }
 
     void setIsPlayingBackRecording(bool isPlayingBackRecording) { _isPlayingBackRecording = isPlayingBackRecording; }
 
@@ -195,6 +202,7 @@ public slots:
 
     void handleAudioEnvironmentDataPacket(QSharedPointer<ReceivedMessage> message);
     void handleAudioDataPacket(QSharedPointer<ReceivedMessage> message);
+    void handleAudioParityPacket(QSharedPointer<ReceivedMessage> message);
     void handleNoisyMutePacket(QSharedPointer<ReceivedMessage> message);
     void handleMuteEnvironmentPacket(QSharedPointer<ReceivedMessage> message);
     void handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message);
@@ -325,9 +333,12 @@ private:
     void checkPeakValues();
 
     void outputFormatChanged();
+    // hands a mixed audio packet to the received audio stream, once it's been through the FEC decoder if need be
+    void parseAudioDataPacket(const QSharedPointer<ReceivedMessage>& message);
     void handleAudioInput(QByteArray& audioBuffer);
     void prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLock = nullptr);
-    bool mixLocalAudioInjectors(float* mixBuffer);
+    // the device callback only tries to lock the injectors, it mixes nothing if they are being changed
+    bool mixLocalAudioInjectors(float* mixBuffer, bool tryLock = false);
     float azimuthForSource(const glm::vec3& relativePosition);
     float gainForSource(float distance, float volume);
 
@@ -363,6 +374,28 @@ private:
 
     Gate _gate{ this };
 
+    // Prepares the audio of the local injectors ahead of the output device callback, which only wakes it:
+    // the callback doesn't queue work on the global thread pool, which allocates and locks.
+    class LocalInjectorsThread : public QThread {
+    public:
+        LocalInjectorsThread(AudioClient* audioClient);
+
+        void run() override;
+        void stop();
+
+        // realtime-safe, called from the output device callback
+        void wake();
+
+    private:
+        AudioClient* _audioClient;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::atomic<bool> _wakeRequested { false };
+        bool _stop { false };
+    };
+
+    LocalInjectorsThread _localInjectorsThread { this };
+
     Mutex _injectorsMutex;
     QAudioInput* _audioInput{ nullptr };
     QTimer* _dummyAudioInput{ nullptr };
@@ -386,6 +419,13 @@ private:
     std::atomic<bool> _localInjectorsAvailable { false };
     MixedProcessedAudioStream _receivedAudioStream{ RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES };
     bool _isStereoInput{ false };
+
+    // forward error correction, requested when negotiating the codec, off by default
+    Setting::Handle<int> _fecGroupSizeSetting { "audioFECGroupSize", 0 };
+    Setting::Handle<bool> _ambisonicBedSetting { "audioAmbisonicBed", true };
+    bool _hasAmbisonicBed { false }; // the mixer sends the distant sources as an ambisonic bed
+    AudioFECEncoder _fecEncoder; // for the mic stream
+    AudioFECDecoder _fecDecoder; // for the mixed stream
     std::atomic<bool> _enablePeakValues { false };
 
     quint64 _outputStarveDetectionStartTimeMsec{ 0 };
@@ -502,6 +542,18 @@ private:
 
     QVector<AudioInjectorPointer> _activeLocalAudioInjectors;
 
+    // the local injectors of a frame, sorted out before any is rendered
+    struct LocalInjectorVoice {
+        AudioInjectorPointer injector;
+        AudioInjectorOptions options;
+        float gain { 0.0f }; // with the distance attenuation
+        float priority { 0.0f };
+        glm::vec3 relativePosition;
+        float distance { 0.0f };
+        bool isAudible { false };
+    };
+    std::vector<LocalInjectorVoice> _localInjectorVoices;
+
     bool _isPlayingBackRecording { false };
     bool _audioPaused { false };
 
@@ -520,7 +572,6 @@ private:
 
     AudioSolo _solo;
     
-    QFuture<void> _localPrepInjectorFuture;
     QReadWriteLock _hmdNameLock;
     Mutex _checkDevicesMutex;
     QTimer* _checkDevicesTimer { nullptr };
@@ -112,6 +112,12 @@ void AudioIOStats::publish() {
     _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
     _interface->updateClientStream(stats);
 
+    // each way, the audio waits in the buffer of the device and in a jitter buffer, and travels half the round trip
+    float oneWayMs = audioMixer->getPingMs() / 2.0f;
+    _interface->inputLatencyMs((float)_inputMsUnplayed.getWindowAverage() + oneWayMs +
+        _interface->getMixerStream()->unplayedMsMax());
+    _interface->outputLatencyMs(oneWayMs + stats._unplayedMs + (float)_outputMsUnplayed.getWindowAverage());
+
     // prepare a packet to the mixer
     int statsPacketSize = sizeof(appendFlag) + sizeof(numStreamStatsToPack) + sizeof(stats);
     auto statsPacket = NLPacket::create(PacketType::AudioStreamStats, statsPacketSize);
@@ -249,11 +249,15 @@ class AudioStatsInterface : public QObject {
      * @property {number} inputUnplayedMsMax - The maximum duration of microphone audio recently in the input buffer waiting to 
      *     be played, in ms.
      *     <em>Read-only.</em>
+     * @property {number} inputLatencyMs - The estimated time from the microphone to the audio mixer's mix, in ms.
+     *     <em>Read-only.</em>
      * @property {AudioStats.AudioStreamStats} mixerStream - Statistics of the audio mixer's stream.
      *     <em>Read-only.</em>
      * @property {number} outputUnplayedMsMax - The maximum duration of output audio recently in the output buffer waiting to 
      *     be played, in ms.
      *     <em>Read-only.</em>
+     * @property {number} outputLatencyMs - The estimated time from the audio mixer's mix to the speakers, in ms.
+     *     <em>Read-only.</em>
      * @property {number} pingMs - The current ping time to the audio mixer, in ms.
      *     <em>Read-only.</em>
      * @property {number} sentTimegapMsAvg - The overall average time between sending data packets to the audio mixer, in ms.
@@ -303,6 +307,22 @@ class AudioStatsInterface : public QObject {
      */
     AUDIO_PROPERTY(float, outputUnplayedMsMax);
 
+    /*@jsdoc
+     * Triggered when the estimated time from the microphone to the audio mixer's mix changes.
+     * @function AudioStats.inputLatencyMsChanged
+     * @param {number} inputLatencyMs - The estimated time from the microphone to the audio mixer's mix, in ms.
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(float, inputLatencyMs);
+
+    /*@jsdoc
+     * Triggered when the estimated time from the audio mixer's mix to the speakers changes.
+     * @function AudioStats.outputLatencyMsChanged
+     * @param {number} outputLatencyMs - The estimated time from the audio mixer's mix to the speakers, in ms.
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(float, outputLatencyMs);
+
 
     /*@jsdoc
      * Triggered when the overall maximum time between sending data packets to the audio mixer changes.
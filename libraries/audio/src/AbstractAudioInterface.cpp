@@ -18,14 +18,22 @@
 #include <Transform.h>
 
 #include "AudioConstants.h"
+#include "AudioFEC.h"
 
 void AbstractAudioInterface::emitAudioPacket(const void* audioData, size_t bytes, quint16& sequenceNumber, bool isStereo,
                                              const Transform& transform, glm::vec3 avatarBoundingBoxCorner, glm::vec3 avatarBoundingBoxScale,
-                                             PacketType packetType, QString codecName) {
+                                             PacketType packetType, QString codecName, AudioFECEncoder* fecEncoder) {
+    emitAudioPacket(*DependencyManager::get<NodeList>(), audioData, bytes, sequenceNumber, isStereo, transform,
+                    avatarBoundingBoxCorner, avatarBoundingBoxScale, packetType, codecName, fecEncoder);
+}
+
+void AbstractAudioInterface::emitAudioPacket(NodeList& nodeList, const void* audioData, size_t bytes,
+                                             quint16& sequenceNumber, bool isStereo, const Transform& transform,
+                                             glm::vec3 avatarBoundingBoxCorner, glm::vec3 avatarBoundingBoxScale,
+                                             PacketType packetType, QString codecName, AudioFECEncoder* fecEncoder) {
     static std::mutex _mutex;
     using Locker = std::unique_lock<std::mutex>;
-    auto nodeList = DependencyManager::get<NodeList>();
-    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    SharedNodePointer audioMixer = nodeList.soloNodeOfType(NodeType::AudioMixer);
     if (audioMixer && audioMixer->getActiveSocket()) {
         Locker lock(_mutex);
         auto audioPacket = NLPacket::create(packetType);
@@ -67,7 +75,15 @@ void AbstractAudioInterface::emitAudioPacket(const void* audioData, size_t bytes
             audioPacket->setPayloadSize(leadingBytes + bytes);
             memcpy(audioPacket->getPayload() + leadingBytes, audioData, bytes);
         }
-        nodeList->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SendAudioPacket);
-        nodeList->sendUnreliablePacket(*audioPacket, *audioMixer);
+        nodeList.flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SendAudioPacket);
+        nodeList.sendUnreliablePacket(*audioPacket, *audioMixer);
+
+        if (fecEncoder) {
+            // send the parity packet of the group this packet completes
+            auto parityPacket = fecEncoder->addPacket(*audioPacket);
+            if (parityPacket) {
+                nodeList.sendUnreliablePacket(*parityPacket, *audioMixer);
+            }
+        }
     }
 }
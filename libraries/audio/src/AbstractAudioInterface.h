@@ -21,8 +21,10 @@
 #include "AudioInjector.h"
 #include "AudioSolo.h"
 
+class AudioFECEncoder;
 class AudioInjector;
 class AudioInjectorLocalBuffer;
+class NodeList;
 class Transform;
 
 class AbstractAudioInterface : public QObject {
@@ -32,7 +34,13 @@ public:
 
     static void emitAudioPacket(const void* audioData, size_t bytes, quint16& sequenceNumber, bool isStereo,
                                 const Transform& transform, glm::vec3 avatarBoundingBoxCorner, glm::vec3 avatarBoundingBoxScale,
-                                PacketType packetType, QString codecName = QString(""));
+                                PacketType packetType, QString codecName = QString(""),
+                                AudioFECEncoder* fecEncoder = nullptr);
+    // sends to the audio mixer of a node list other than the DependencyManager's one, for the tools that connect many clients
+    static void emitAudioPacket(NodeList& nodeList, const void* audioData, size_t bytes, quint16& sequenceNumber,
+                                bool isStereo, const Transform& transform, glm::vec3 avatarBoundingBoxCorner,
+                                glm::vec3 avatarBoundingBoxScale, PacketType packetType, QString codecName = QString(""),
+                                AudioFECEncoder* fecEncoder = nullptr);
 
     // threadsafe
     // moves injector->getLocalBuffer() to another thread (so removes its parent)
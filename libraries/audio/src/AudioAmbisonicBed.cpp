@@ -0,0 +1,162 @@
+//
+//  AudioAmbisonicBed.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioAmbisonicBed.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static const int STEP_TABLE[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+    107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+    5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+    27086, 29794, 32767
+};
+static const int MAX_STEP_INDEX = 88;
+
+static const int INDEX_TABLE[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static inline int16_t clampSample(int sample) {
+    return (int16_t)std::min(std::max(sample, -32768), 32767);
+}
+
+// updates the predictor and step index for a code, as the decoder does
+static inline void decodeStep(int code, int& predictor, int& index) {
+    int step = STEP_TABLE[index];
+    int delta = step >> 3;
+    if (code & 4) {
+        delta += step;
+    }
+    if (code & 2) {
+        delta += step >> 1;
+    }
+    if (code & 1) {
+        delta += step >> 2;
+    }
+    predictor = clampSample((code & 8) ? predictor - delta : predictor + delta);
+    index = std::min(std::max(index + INDEX_TABLE[code & 7], 0), MAX_STEP_INDEX);
+}
+
+static inline int encodeStep(int sample, int& predictor, int& index) {
+    int diff = sample - predictor;
+    int code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    int step = STEP_TABLE[index];
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+    }
+    if (diff >= (step >> 1)) {
+        code |= 2;
+        diff -= step >> 1;
+    }
+    if (diff >= (step >> 2)) {
+        code |= 1;
+    }
+    decodeStep(code, predictor, index);
+    return code;
+}
+
+void AudioAmbisonicBed::encodeSource(const int16_t* input, const glm::vec3& direction, float gain, float* bed) {
+    float length = glm::length(direction);
+    glm::vec3 d = length > 0.0f ? direction / length : glm::vec3(0.0f);
+
+    // world (-z forward, x right, y up) to ambisonic (x forward, y left, z up), SN3D gains
+    const float scale = gain * (1 / 32768.0f);
+    const float gains[NUM_CHANNELS] = { scale, -d.x * scale, d.y * scale, -d.z * scale };
+
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        float sample = (float)input[i];
+        bed[NUM_CHANNELS * i + 0] += gains[0] * sample;
+        bed[NUM_CHANNELS * i + 1] += gains[1] * sample;
+        bed[NUM_CHANNELS * i + 2] += gains[2] * sample;
+        bed[NUM_CHANNELS * i + 3] += gains[3] * sample;
+    }
+}
+
+void AudioAmbisonicBed::encode(const float* bed, QByteArray& encoded) {
+    encoded.resize(ENCODED_BYTES);
+    uint8_t* output = reinterpret_cast<uint8_t*>(encoded.data());
+
+    for (int channel = 0; channel < NUM_CHANNELS; channel++) {
+
+        // decimate with a [1/4 1/2 1/4] lowpass, the edges of the frame are held
+        int16_t samples[NUM_CODED_FRAMES];
+        for (int i = 0; i < NUM_CODED_FRAMES; i++) {
+            int j = DECIMATION * i;
+            float previous = bed[NUM_CHANNELS * std::max(j - 1, 0) + channel];
+            float current = bed[NUM_CHANNELS * j + channel];
+            float next = bed[NUM_CHANNELS * std::min(j + 1, NUM_FRAMES - 1) + channel];
+            float sample = (0.25f * previous + 0.5f * current + 0.25f * next) * 32768.0f;
+            samples[i] = clampSample((int)lrintf(std::min(std::max(sample, -32768.0f), 32767.0f)));
+        }
+
+        // start from the first sample, with a step that fits the first difference
+        int predictor = samples[0];
+        int firstDelta = std::abs(samples[1] - samples[0]);
+        int index = 0;
+        while (index < MAX_STEP_INDEX && STEP_TABLE[index] < firstDelta) {
+            index++;
+        }
+
+        int16_t header = (int16_t)predictor;
+        memcpy(output, &header, sizeof(header));
+        output[sizeof(header)] = (uint8_t)index;
+        uint8_t* codes = output + sizeof(header) + sizeof(uint8_t);
+
+        for (int i = 0; i < NUM_CODED_FRAMES; i += 2) {
+            int low = encodeStep(samples[i], predictor, index);
+            int high = encodeStep(samples[i + 1], predictor, index);
+            codes[i / 2] = (uint8_t)(low | (high << 4));
+        }
+        output += CHANNEL_BYTES;
+    }
+}
+
+bool AudioAmbisonicBed::decode(const QByteArray& encoded, int16_t* output) {
+    if (encoded.size() != ENCODED_BYTES) {
+        return false;
+    }
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(encoded.constData());
+
+    for (int channel = 0; channel < NUM_CHANNELS; channel++) {
+        int16_t header;
+        memcpy(&header, input, sizeof(header));
+        int predictor = header;
+        int index = input[sizeof(header)];
+        if (index > MAX_STEP_INDEX) {
+            return false;
+        }
+        const uint8_t* codes = input + sizeof(header) + sizeof(uint8_t);
+
+        int16_t samples[NUM_CODED_FRAMES];
+        for (int i = 0; i < NUM_CODED_FRAMES; i += 2) {
+            decodeStep(codes[i / 2] & 0xf, predictor, index);
+            samples[i] = (int16_t)predictor;
+            decodeStep(codes[i / 2] >> 4, predictor, index);
+            samples[i + 1] = (int16_t)predictor;
+        }
+
+        // back to full rate, interpolating linearly and holding the last sample
+        for (int i = 0; i < NUM_CODED_FRAMES; i++) {
+            int next = samples[std::min(i + 1, NUM_CODED_FRAMES - 1)];
+            output[NUM_CHANNELS * (DECIMATION * i) + channel] = samples[i];
+            output[NUM_CHANNELS * (DECIMATION * i + 1) + channel] = (int16_t)((samples[i] + next) / 2);
+        }
+        input += CHANNEL_BYTES;
+    }
+    return true;
+}
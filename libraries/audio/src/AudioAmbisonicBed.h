@@ -0,0 +1,50 @@
+//
+//  AudioAmbisonicBed.h
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioAmbisonicBed_h
+#define hifi_AudioAmbisonicBed_h
+
+#include <stdint.h>
+
+#include <QtCore/QByteArray>
+
+#include <glm/glm.hpp>
+
+#include "AudioConstants.h"
+
+// The first-order ambisonic bed of the distant sources of a mix, sent along with the binaural mix of the near sources
+// in MixedAudioWithAmbisonicBed packets. The bed is world oriented, the listener renders it with its own head
+// orientation (AudioFOA).
+//
+// The channels are in ambiX order (W, Y, Z, X). The codec is stateless so that a lost packet doesn't affect the
+// next ones: each channel is decimated to half rate and coded as 4 bit IMA ADPCM, behind a header with the initial
+// predictor and step index.
+namespace AudioAmbisonicBed {
+    const int NUM_CHANNELS = 4;
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    const int NUM_SAMPLES = NUM_CHANNELS * NUM_FRAMES;
+
+    const int DECIMATION = 2;
+    const int NUM_CODED_FRAMES = NUM_FRAMES / DECIMATION;
+    const int CHANNEL_BYTES = sizeof(int16_t) + sizeof(uint8_t) + NUM_CODED_FRAMES / 2;
+    const int ENCODED_BYTES = NUM_CHANNELS * CHANNEL_BYTES;
+
+    // accumulates a mono frame of samples coming from direction (world frame, need not be normalized) into bed
+    void encodeSource(const int16_t* input, const glm::vec3& direction, float gain, float* bed);
+
+    // bed: a frame of interleaved samples, full scale 1.0
+    void encode(const float* bed, QByteArray& encoded);
+
+    // output: a frame of interleaved samples, returns false if encoded isn't a bed
+    bool decode(const QByteArray& encoded, int16_t* output);
+}
+
+#endif // hifi_AudioAmbisonicBed_h
@@ -0,0 +1,61 @@
+//
+//  AudioEmitterProperties.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioEmitterProperties.h"
+
+#include <udt/PacketHeaders.h>
+#include <UUID.h>
+
+AudioEmitterProperties::AudioEmitterProperties(const QUuid& emitterID, const QUrl& soundURL,
+                                               const AudioInjectorOptions& options) :
+    emitterID(emitterID),
+    soundURL(soundURL),
+    position(options.position),
+    orientation(options.orientation),
+    volume(options.volume),
+    secondOffset(options.secondOffset),
+    loop(options.loop),
+    ignorePenumbra(options.ignorePenumbra) {
+}
+
+std::unique_ptr<NLPacket> AudioEmitterProperties::createPacket() const {
+    // the emitters only change when scripts change them, they are sent reliably
+    auto packet = NLPacket::create(PacketType::AudioEmitter, -1, true);
+
+    uint8_t flags = (loop ? LOOP : 0) | (ignorePenumbra ? IGNORE_PENUMBRA : 0) | (isRemoved ? REMOVED : 0);
+    packet->write(emitterID.toRfc4122());
+    packet->writePrimitive(flags);
+    if (!isRemoved) {
+        packet->writeString(soundURL.toString());
+        packet->writePrimitive(position);
+        packet->writePrimitive(orientation);
+        packet->writePrimitive(volume);
+        packet->writePrimitive(secondOffset);
+    }
+    return packet;
+}
+
+void AudioEmitterProperties::read(ReceivedMessage& message) {
+    emitterID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+    uint8_t flags { 0 };
+    message.readPrimitive(&flags);
+    loop = (flags & LOOP) != 0;
+    ignorePenumbra = (flags & IGNORE_PENUMBRA) != 0;
+    isRemoved = (flags & REMOVED) != 0;
+    if (!isRemoved) {
+        soundURL = QUrl(message.readString());
+        message.readPrimitive(&position);
+        message.readPrimitive(&orientation);
+        message.readPrimitive(&volume);
+        message.readPrimitive(&secondOffset);
+    }
+}
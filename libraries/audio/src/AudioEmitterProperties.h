@@ -0,0 +1,57 @@
+//
+//  AudioEmitterProperties.h
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioEmitterProperties_h
+#define hifi_AudioEmitterProperties_h
+
+#include <memory>
+
+#include <QtCore/QUrl>
+#include <QtCore/QUuid>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+#include "AudioInjectorOptions.h"
+
+// A sound emitter hosted by the audio mixer. The agents and the entity script server send its properties in an
+// AudioEmitter packet, each time they change, and the mixer plays the sound from its own sound cache instead of
+// receiving an injected stream of it: there is no stream over the network, and no jitter buffer.
+class AudioEmitterProperties {
+public:
+    AudioEmitterProperties() = default;
+    AudioEmitterProperties(const QUuid& emitterID, const QUrl& soundURL, const AudioInjectorOptions& options);
+
+    QUuid emitterID;
+    QUrl soundURL;
+    glm::vec3 position { 0.0f };
+    glm::quat orientation;
+    float volume { 1.0f };
+    float secondOffset { 0.0f }; // where the sound starts, when it is (re)started
+    bool loop { false };
+    bool ignorePenumbra { false };
+    bool isRemoved { false };
+
+    std::unique_ptr<NLPacket> createPacket() const;
+    void read(ReceivedMessage& message);
+
+private:
+    enum Flag : uint8_t {
+        LOOP = 1,
+        IGNORE_PENUMBRA = 2,
+        REMOVED = 4
+    };
+};
+
+#endif // hifi_AudioEmitterProperties_h
@@ -0,0 +1,241 @@
+//
+//  AudioFEC.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-25.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioFEC.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <udt/PacketHeaders.h>
+
+using SequenceNumber = quint16;
+
+// first sequence number, group size, type parity and length parity
+static const int PARITY_HEADER_BYTES = sizeof(SequenceNumber) + sizeof(quint8) + sizeof(quint8) + sizeof(quint16);
+
+int AudioFEC::clampGroupSize(int requestedGroupSize) {
+    if (requestedGroupSize < MIN_GROUP_SIZE) {
+        return 0;
+    }
+    return std::min(requestedGroupSize, MAX_GROUP_SIZE);
+}
+
+static void xorInto(char* destination, const char* source, int size) {
+    for (int i = 0; i < size; ++i) {
+        destination[i] ^= source[i];
+    }
+}
+
+std::unique_ptr<NLPacket> AudioFECEncoder::addPacket(const NLPacket& audioPacket) {
+    int groupSize = _groupSize;
+    if (groupSize != _currentGroupSize) {
+        _currentGroupSize = groupSize;
+        _count = 0;
+    }
+    if (groupSize == 0 || audioPacket.getPayloadSize() < (qint64)sizeof(SequenceNumber)) {
+        return nullptr;
+    }
+
+    SequenceNumber sequence;
+    memcpy(&sequence, audioPacket.getPayload(), sizeof(SequenceNumber));
+    const char* payload = audioPacket.getPayload() + sizeof(SequenceNumber);
+    int length = (int)audioPacket.getPayloadSize() - (int)sizeof(SequenceNumber);
+
+    if (_count > 0 && sequence != (SequenceNumber)(_firstSequence + _count)) {
+        // the sequence numbers were reset, start a new group
+        _count = 0;
+    }
+    if (_count == 0) {
+        _firstSequence = sequence;
+        _typeParity = 0;
+        _lengthParity = 0;
+        _parity.clear();
+    }
+
+    if (_parity.size() < length) {
+        _parity.append(length - _parity.size(), 0);
+    }
+    xorInto(_parity.data(), payload, length);
+    _typeParity ^= (quint8)audioPacket.getType();
+    _lengthParity ^= (quint16)length;
+
+    if (++_count < groupSize) {
+        return nullptr;
+    }
+
+    auto parityPacket = NLPacket::create(PacketType::AudioParity, PARITY_HEADER_BYTES + _parity.size());
+    parityPacket->writePrimitive(_firstSequence);
+    parityPacket->writePrimitive((quint8)_count);
+    parityPacket->writePrimitive(_typeParity);
+    parityPacket->writePrimitive(_lengthParity);
+    parityPacket->write(_parity);
+
+    _count = 0;
+    return parityPacket;
+}
+
+static SequenceNumber readSequence(ReceivedMessage& message) {
+    auto position = message.getPosition();
+    message.seek(0);
+    SequenceNumber sequence { 0 };
+    message.readPrimitive(&sequence);
+    message.seek(position);
+    return sequence;
+}
+
+// the signed distance from b to a, across wrap arounds
+static int sequenceDiff(SequenceNumber a, SequenceNumber b) {
+    return (qint16)(SequenceNumber)(a - b);
+}
+
+void AudioFECDecoder::handleAudioPacket(const QSharedPointer<ReceivedMessage>& message, const Output& output) {
+    SequenceNumber sequence = readSequence(*message);
+    if (!_hasReceived) {
+        _hasReceived = true;
+        _nextSequence = sequence;
+    }
+    remember(sequence, message);
+
+    int ahead = sequenceDiff(sequence, _nextSequence);
+    if (ahead < 0) {
+        // late or duplicated, the stream knows what to do with it
+        output(message);
+        return;
+    }
+    if (ahead == 0 && _held.empty()) {
+        ++_nextSequence;
+        output(message);
+        return;
+    }
+
+    hold(sequence, message);
+    releaseHeld(output);
+
+    // a whole group past the loss, its parity packet has been lost as well
+    if (!_held.empty() && sequenceDiff(_held.back().sequence, _nextSequence) > _groupSize) {
+        flushHeld(output);
+    }
+}
+
+void AudioFECDecoder::handleParityPacket(ReceivedMessage& message, const Output& output) {
+    SequenceNumber firstSequence;
+    quint8 count;
+    quint8 typeParity;
+    quint16 lengthParity;
+    message.readPrimitive(&firstSequence);
+    message.readPrimitive(&count);
+    message.readPrimitive(&typeParity);
+    message.readPrimitive(&lengthParity);
+    if (count < AudioFEC::MIN_GROUP_SIZE || count > AudioFEC::MAX_GROUP_SIZE || !_hasReceived) {
+        return;
+    }
+    _groupSize = count;
+    QByteArray payload = message.readAll();
+
+    int numMissing = 0;
+    SequenceNumber lostSequence = 0;
+    for (int i = 0; i < count; ++i) {
+        SequenceNumber sequence = firstSequence + i;
+        if (!findReceived(sequence)) {
+            lostSequence = sequence;
+            ++numMissing;
+        }
+    }
+
+    if (numMissing == 1 && sequenceDiff(lostSequence, _nextSequence) >= 0) {
+        bool isValid = true;
+        for (int i = 0; i < count && isValid; ++i) {
+            SequenceNumber sequence = firstSequence + i;
+            if (sequence == lostSequence) {
+                continue;
+            }
+            auto received = findReceived(sequence);
+            QByteArray data = received->getMessage();
+            int length = data.size() - (int)sizeof(SequenceNumber);
+            if (length < 0 || length > payload.size()) {
+                isValid = false;
+                break;
+            }
+            xorInto(payload.data(), data.constData() + sizeof(SequenceNumber), length);
+            typeParity ^= (quint8)received->getType();
+            lengthParity ^= (quint16)length;
+        }
+
+        if (isValid && lengthParity <= payload.size() && typeParity < (quint8)PacketType::NUM_PACKET_TYPE) {
+            payload.truncate(lengthParity);
+            payload.prepend(reinterpret_cast<const char*>(&lostSequence), sizeof(SequenceNumber));
+
+            PacketType lostType = (PacketType)typeParity;
+            auto rebuilt = QSharedPointer<ReceivedMessage>::create(payload, lostType, versionForPacketType(lostType),
+                                                                   message.getSenderSockAddr(), message.getSourceID());
+            ++_numRecoveredPackets;
+            handleAudioPacket(rebuilt, output);
+        }
+    }
+
+    // whatever is still missing up to the end of this group isn't coming back
+    SequenceNumber endSequence = firstSequence + count;
+    if (!_held.empty() && sequenceDiff(endSequence, _nextSequence) > 0) {
+        flushHeld(output);
+    }
+}
+
+void AudioFECDecoder::reset(const Output& output) {
+    flushHeld(output);
+    _history.fill(Received());
+    _hasReceived = false;
+    _groupSize = AudioFEC::MAX_GROUP_SIZE;
+}
+
+void AudioFECDecoder::remember(SequenceNumber sequence, const QSharedPointer<ReceivedMessage>& message) {
+    _history[sequence % HISTORY_SIZE] = { sequence, message };
+}
+
+QSharedPointer<ReceivedMessage> AudioFECDecoder::findReceived(SequenceNumber sequence) const {
+    const auto& received = _history[sequence % HISTORY_SIZE];
+    if (received.message && received.sequence == sequence) {
+        return received.message;
+    }
+    return QSharedPointer<ReceivedMessage>();
+}
+
+void AudioFECDecoder::hold(SequenceNumber sequence, const QSharedPointer<ReceivedMessage>& message) {
+    auto it = std::find_if(_held.begin(), _held.end(), [&](const Received& held) {
+        return sequenceDiff(held.sequence, sequence) >= 0;
+    });
+    if (it != _held.end() && it->sequence == sequence) {
+        // duplicated
+        return;
+    }
+    _held.insert(it, { sequence, message });
+}
+
+void AudioFECDecoder::releaseHeld(const Output& output) {
+    auto it = _held.begin();
+    for (; it != _held.end() && it->sequence == _nextSequence; ++it) {
+        ++_nextSequence;
+        output(it->message);
+    }
+    _held.erase(_held.begin(), it);
+}
+
+void AudioFECDecoder::flushHeld(const Output& output) {
+    if (_held.empty()) {
+        return;
+    }
+    // let the stream conceal the packets that are still missing
+    _nextSequence = _held.back().sequence + 1;
+    auto held = std::move(_held);
+    _held.clear();
+    for (auto& received : held) {
+        output(received.message);
+    }
+}
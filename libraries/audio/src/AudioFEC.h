@@ -0,0 +1,100 @@
+//
+//  AudioFEC.h
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-25.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioFEC_h
+#define hifi_AudioFEC_h
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QSharedPointer>
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+// Forward error correction for the unreliable audio streams.
+//
+// After each group of consecutive audio packets, the sender sends an AudioParity packet holding the XOR of their
+// payloads (padded to the longest), types and lengths. The receiver can rebuild any single packet lost in a group
+// from the others and the parity packet.
+//
+// The group size is negotiated along with the codec (NegotiateAudioFormat / SelectedAudioFormat), 0 disables it.
+namespace AudioFEC {
+    const int MIN_GROUP_SIZE = 2;
+    const int MAX_GROUP_SIZE = 8;
+
+    // the group size to use for a requested one, 0 if FEC should be disabled
+    int clampGroupSize(int requestedGroupSize);
+}
+
+class AudioFECEncoder {
+public:
+    // thread-safe, the group in progress is dropped
+    void setGroupSize(int groupSize) { _groupSize = AudioFEC::clampGroupSize(groupSize); }
+    int getGroupSize() const { return _groupSize; }
+
+    // adds an audio packet about to be sent, returns the parity packet to send after it when it completes a group
+    std::unique_ptr<NLPacket> addPacket(const NLPacket& audioPacket);
+
+private:
+    std::atomic<int> _groupSize { 0 };
+
+    int _currentGroupSize { 0 };
+    int _count { 0 };
+    quint16 _firstSequence { 0 };
+    quint8 _typeParity { 0 };
+    quint16 _lengthParity { 0 };
+    QByteArray _parity;
+};
+
+class AudioFECDecoder {
+public:
+    using Output = std::function<void(const QSharedPointer<ReceivedMessage>&)>;
+
+    // Handles a received audio packet. Packets are passed to output in order: after a loss, the packets that follow
+    // are held until the lost one is rebuilt, or until it can't be and they are let through for the stream to conceal.
+    void handleAudioPacket(const QSharedPointer<ReceivedMessage>& message, const Output& output);
+    void handleParityPacket(ReceivedMessage& message, const Output& output);
+
+    // lets the held packets through and forgets the packets seen so far
+    void reset(const Output& output);
+
+    int getNumRecoveredPackets() const { return _numRecoveredPackets; }
+
+private:
+    struct Received {
+        quint16 sequence { 0 };
+        QSharedPointer<ReceivedMessage> message;
+    };
+
+    static const int HISTORY_SIZE = 4 * AudioFEC::MAX_GROUP_SIZE;
+
+    void remember(quint16 sequence, const QSharedPointer<ReceivedMessage>& message);
+    QSharedPointer<ReceivedMessage> findReceived(quint16 sequence) const;
+    void hold(quint16 sequence, const QSharedPointer<ReceivedMessage>& message);
+    void releaseHeld(const Output& output);
+    void flushHeld(const Output& output);
+
+    std::array<Received, HISTORY_SIZE> _history;
+    std::vector<Received> _held; // ordered by sequence number
+
+    bool _hasReceived { false };
+    quint16 _nextSequence { 0 }; // of the next packet to output
+    int _groupSize { AudioFEC::MAX_GROUP_SIZE }; // of the last parity packet
+
+    int _numRecoveredPackets { 0 };
+};
+
+#endif // hifi_AudioFEC_h
@@ -308,6 +308,14 @@ static void biquad2_4x4_SSE(float* src, float* dst, float coef[5][8], float stat
     _MM_SET_FLUSH_ZERO_MODE(ftz);
 }
 
+// process 2 cascaded biquads on 4 channels (interleaved), for 2 independent sources
+// SSE has no registers to spare for a second source, so they are simply processed in turn
+static void biquad2_4x4x2_SSE(float* src0, float* dst0, float* src1, float* dst1, float coef0[5][8], float state0[3][8],
+                              float coef1[5][8], float state1[3][8], int numFrames) {
+    biquad2_4x4_SSE(src0, dst0, coef0, state0, numFrames);
+    biquad2_4x4_SSE(src1, dst1, coef1, state1, numFrames);
+}
+
 // crossfade 4 inputs into 2 outputs with accumulation (interleaved)
 static void crossfade_4x2_SSE(float* src, float* dst, const float* win, int numFrames) {
 
@@ -384,6 +392,10 @@ void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3
 void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
 void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
 void biquad2_4x4_AVX2(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
+void biquad2_4x4x2_AVX2(float* src0, float* dst0, float* src1, float* dst1, float coef0[5][8], float state0[3][8],
+                        float coef1[5][8], float state1[3][8], int numFrames);
+void biquad2_4x4x2_AVX512(float* src0, float* dst0, float* src1, float* dst1, float coef0[5][8], float state0[3][8],
+                          float coef1[5][8], float state1[3][8], int numFrames);
 void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames);
 void interpolate_AVX2(const float* src0, const float* src1, float* dst, float frac, float gain);
 
@@ -407,6 +419,16 @@ static void biquad2_4x4(float* src, float* dst, float coef[5][8], float state[3]
     (*f)(src, dst, coef, state, numFrames); // dispatch
 }
 
+static void biquad2_4x4x2(float* src0, float* dst0, float* src1, float* dst1, float coef0[5][8], float state0[3][8],
+                          float coef1[5][8], float state1[3][8], int numFrames) {
+#ifndef STACK_PROTECTOR
+    static auto f = cpuSupportsAVX512() ? biquad2_4x4x2_AVX512 : (cpuSupportsAVX2() ? biquad2_4x4x2_AVX2 : biquad2_4x4x2_SSE);
+#else
+    static auto f = cpuSupportsAVX2() ? biquad2_4x4x2_AVX2 : biquad2_4x4x2_SSE;
+#endif
+    (*f)(src0, dst0, src1, dst1, coef0, state0, coef1, state1, numFrames); // dispatch
+}
+
 static void crossfade_4x2(float* src, float* dst, const float* win, int numFrames) {
     static auto f = cpuSupportsAVX2() ? crossfade_4x2_AVX2 : crossfade_4x2_SSE;
     (*f)(src, dst, win, numFrames); // dispatch
@@ -666,6 +688,13 @@ static void biquad2_4x4(float* src, float* dst, float coef[5][8], float state[3]
     state[2][7] = w27;
 }
 
+// process 2 cascaded biquads on 4 channels (interleaved), for 2 independent sources
+static void biquad2_4x4x2(float* src0, float* dst0, float* src1, float* dst1, float coef0[5][8], float state0[3][8],
+                          float coef1[5][8], float state1[3][8], int numFrames) {
+    biquad2_4x4(src0, dst0, coef0, state0, numFrames);
+    biquad2_4x4(src1, dst1, coef1, state1, numFrames);
+}
+
 // crossfade 4 inputs into 2 outputs with accumulation (interleaved)
 static void crossfade_4x2(float* src, float* dst, const float* win, int numFrames) {
 
@@ -1067,11 +1096,57 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     assert(index < HRTF_TABLES);
     assert(numFrames == HRTF_BLOCK);
 
+    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
+    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
+
+    renderFilters(input, index, azimuth, distance, gain, lpfDistance, bqCoef, bqBuffer);
+
+    // process old/new biquads
+    biquad2_4x4(bqBuffer, bqBuffer, bqCoef, _bqState, HRTF_BLOCK);
+
+    renderOutput(bqBuffer, output);
+}
+
+void AudioHRTF::renderMultiple(AudioHRTF* const* hrtfs, int16_t* const* inputs, const float* azimuths,
+                               const float* distances, const float* gains, int numSources, float* output,
+                               int index, int numFrames, float lpfDistance) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float bqCoef[2][5][8];                          // 4-channel (interleaved), per source
+    ALIGN32 float bqBuffer[2][4 * HRTF_BLOCK];              // 4-channel (interleaved), per source
+
+    int i = 0;
+    for (; i + 1 < numSources; i += 2) {
+        AudioHRTF& hrtf0 = *hrtfs[i];
+        AudioHRTF& hrtf1 = *hrtfs[i + 1];
+
+        hrtf0.renderFilters(inputs[i], index, azimuths[i], distances[i], gains[i], lpfDistance, bqCoef[0], bqBuffer[0]);
+        hrtf1.renderFilters(inputs[i + 1], index, azimuths[i + 1], distances[i + 1], gains[i + 1], lpfDistance,
+                            bqCoef[1], bqBuffer[1]);
+
+        // process old/new biquads of both sources in one pass
+        biquad2_4x4x2(bqBuffer[0], bqBuffer[0], bqBuffer[1], bqBuffer[1],
+                      bqCoef[0], hrtf0._bqState, bqCoef[1], hrtf1._bqState, HRTF_BLOCK);
+
+        hrtf0.renderOutput(bqBuffer[0], output);
+        hrtf1.renderOutput(bqBuffer[1], output);
+    }
+
+    // odd source out
+    if (i < numSources) {
+        hrtfs[i]->render(inputs[i], output, index, azimuths[i], distances[i], gains[i], numFrames, lpfDistance);
+    }
+}
+
+void AudioHRTF::renderFilters(int16_t* input, int index, float azimuth, float distance, float gain, float lpfDistance,
+                              float bqCoef[5][8], float* bqBuffer) {
+
     ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
     ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
     ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
-    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
-    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
     int delay[4];                                           // 4-channel (interleaved)
 
     // apply global and local gain adjustment
@@ -1135,9 +1210,9 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
                    &firBuffer[L1][HRTF_DELAY] - delay[L1],
                    &firBuffer[R1][HRTF_DELAY] - delay[R1],
                    bqBuffer, HRTF_BLOCK);
+}
 
-    // process old/new biquads
-    biquad2_4x4(bqBuffer, bqBuffer, bqCoef, _bqState, HRTF_BLOCK);
+void AudioHRTF::renderOutput(float* bqBuffer, float* output) {
 
     // new state becomes old
     _bqState[0][L0] = _bqState[0][L1];
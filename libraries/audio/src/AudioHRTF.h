@@ -58,6 +58,15 @@ public:
     void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
                 float lpfDistance = LPF_DISTANCE_REF);
 
+    //
+    // Render several mono sources into the same output, equivalent to calling render() on each of them.
+    // Sources are processed in pairs, so the filters of two sources share a single SIMD pass.
+    // hrtfs, inputs, azimuths, distances, gains: numSources entries, one per source
+    //
+    static void renderMultiple(AudioHRTF* const* hrtfs, int16_t* const* inputs, const float* azimuths,
+                               const float* distances, const float* gains, int numSources, float* output,
+                               int index, int numFrames, float lpfDistance = LPF_DISTANCE_REF);
+
     //
     // Non-spatialized direct mix (accumulates into existing output)
     //
@@ -111,6 +120,11 @@ private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
 
+    // render() in stages: everything up to the biquads, and everything after them
+    void renderFilters(int16_t* input, int index, float azimuth, float distance, float gain, float lpfDistance,
+                       float bqCoef[5][8], float* bqBuffer);
+    void renderOutput(float* bqBuffer, float* output);
+
     // SIMD channel assignmentS
     enum Channel {
         L0, R0,
@@ -26,6 +26,8 @@
 #define MIN(a,b)    (((a) < (b)) ? (a) : (b))
 #endif
 
+static const int REVERB_BLOCK = 256;
+
 static const float PHI = 0.6180339887f; // maximum allpass diffusion
 static const float TWOPI = 6.283185307f;
 
@@ -1205,6 +1207,11 @@ class ReverbImpl {
     float _earlyGain = 0.0f;
     float _wetDryMix = 0.0f;
 
+    // the wet output of a block, mixed with the dry input once the block is done
+    float _wet[2][REVERB_BLOCK];
+
+    void processBlock(float** inputs, float** outputs, int offset, int numFrames);
+
 public:
     void setParameters(ReverbParameters *p);
     void process(float** inputs, float** outputs, int numFrames);
@@ -1577,14 +1584,53 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
     _wetDryMix = MIN(MAX(_wetDryMix, 0.0f), 1.0f);
 }
 
+//
+// The delay network feeds back sample by sample, only the wet/dry mix of a block is vectorized.
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void mixWetDry(const float* dry, const float* wet, float* output, float wetDryMix, int numFrames) {
+    __m128 mix = _mm_set1_ps(wetDryMix);
+
+    int i = 0;
+    for (; i < (numFrames & ~3); i += 4) {
+        __m128 x = _mm_loadu_ps(&dry[i]);
+        __m128 y = _mm_loadu_ps(&wet[i]);
+        _mm_storeu_ps(&output[i], _mm_add_ps(x, _mm_mul_ps(_mm_sub_ps(y, x), mix)));
+    }
+    for (; i < numFrames; i++) {
+        output[i] = dry[i] + (wet[i] - dry[i]) * wetDryMix;
+    }
+}
+
+#else
+
+static void mixWetDry(const float* dry, const float* wet, float* output, float wetDryMix, int numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        output[i] = dry[i] + (wet[i] - dry[i]) * wetDryMix;
+    }
+}
+
+#endif
+
 void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
+    for (int offset = 0; offset < numFrames; offset += REVERB_BLOCK) {
+        processBlock(inputs, outputs, offset, MIN(numFrames - offset, REVERB_BLOCK));
+    }
+}
+
+void ReverbImpl::processBlock(float** inputs, float** outputs, int offset, int numFrames) {
+    const float* input0 = inputs[0] + offset;
+    const float* input1 = inputs[1] + offset;
 
     for (int i = 0; i < numFrames; i++) {
         float x0, x1, y0, y1, y2, y3;
 
         // Preprocess
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
+        x0 = input0[i];
+        x1 = input1[i];
         _bw.process(x0, x1, x0, x1);
 
         float preL, preR;
@@ -1660,11 +1706,13 @@ void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
         _ap20.process(-earlyOutR + lateOut1 + lateOut2, x1);
         _ap21.process(x1, y1);
 
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        outputs[0][i] = x0 + (y0 - x0) * _wetDryMix;
-        outputs[1][i] = x1 + (y1 - x1) * _wetDryMix;
+        _wet[0][i] = y0;
+        _wet[1][i] = y1;
     }
+
+    // the outputs may be the inputs, the dry samples are only overwritten here
+    mixWetDry(input0, _wet[0], outputs[0] + offset, _wetDryMix, numFrames);
+    mixWetDry(input1, _wet[1], outputs[1] + offset, _wetDryMix, numFrames);
 }
 
 // clear internal state, but retain settings
@@ -1720,7 +1768,6 @@ void ReverbImpl::reset() {
 // Public API
 //
 
-static const int REVERB_BLOCK = 256;
 
 AudioReverb::AudioReverb(float sampleRate) {
 
@@ -435,18 +435,21 @@ int AudioSRC::multirateFilter4_ref(const float* input0, const float* input1, con
 #include "CPUDetect.h"
 
 int AudioSRC::multirateFilter1(const float* input0, float* output0, int inputFrames) {
-    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter1_AVX2 : &AudioSRC::multirateFilter1_ref;
+    static auto f = cpuSupportsAVX512() ? &AudioSRC::multirateFilter1_AVX512 :
+                    (cpuSupportsAVX2() ? &AudioSRC::multirateFilter1_AVX2 : &AudioSRC::multirateFilter1_ref);
     return (this->*f)(input0, output0, inputFrames);    // dispatch
 }
 
 int AudioSRC::multirateFilter2(const float* input0, const float* input1, float* output0, float* output1, int inputFrames) {
-    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter2_AVX2 : &AudioSRC::multirateFilter2_ref;
+    static auto f = cpuSupportsAVX512() ? &AudioSRC::multirateFilter2_AVX512 :
+                    (cpuSupportsAVX2() ? &AudioSRC::multirateFilter2_AVX2 : &AudioSRC::multirateFilter2_ref);
     return (this->*f)(input0, input1, output0, output1, inputFrames);   // dispatch
 }
 
 int AudioSRC::multirateFilter4(const float* input0, const float* input1, const float* input2, const float* input3, 
                                float* output0, float* output1, float* output2, float* output3, int inputFrames) {
-    static auto f = cpuSupportsAVX2() ? &AudioSRC::multirateFilter4_AVX2 : &AudioSRC::multirateFilter4_ref;
+    static auto f = cpuSupportsAVX512() ? &AudioSRC::multirateFilter4_AVX512 :
+                    (cpuSupportsAVX2() ? &AudioSRC::multirateFilter4_AVX2 : &AudioSRC::multirateFilter4_ref);
     return (this->*f)(input0, input1, input2, input3, output0, output1, output2, output3, inputFrames); // dispatch
 }
 
@@ -94,6 +94,11 @@ private:
     int multirateFilter4_AVX2(const float* input0, const float* input1, const float* input2, const float* input3, 
                               float* output0, float* output1, float* output2, float* output3, int inputFrames);
 
+    int multirateFilter1_AVX512(const float* input0, float* output0, int inputFrames);
+    int multirateFilter2_AVX512(const float* input0, const float* input1, float* output0, float* output1, int inputFrames);
+    int multirateFilter4_AVX512(const float* input0, const float* input1, const float* input2, const float* input3,
+                                float* output0, float* output1, float* output2, float* output3, int inputFrames);
+
     void convertInput(const int16_t* input, float** outputs, int numFrames);
     void convertOutput(float** inputs, int16_t* output, int numFrames);
 
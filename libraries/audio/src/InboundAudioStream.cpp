@@ -12,6 +12,8 @@
 #include "InboundAudioStream.h"
 #include "TryLocker.h"
 
+#include <algorithm>
+
 #include <glm/glm.hpp>
 
 #include <NLPacket.h>
@@ -29,8 +31,6 @@ const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
 const bool InboundAudioStream::USE_STDEV_FOR_JITTER = false;
 const bool InboundAudioStream::REPETITION_WITH_FADE = true;
 
-static const int STARVE_HISTORY_CAPACITY = 50;
-
 // This is called 1x/s, and we want it to log the last 5s
 static const int UNPLAYED_MS_WINDOW_SECS = 5;
 
@@ -48,6 +48,17 @@ static const int STATS_FOR_STATS_PACKET_WINDOW_SECONDS = 30;
 // _currentJitterBufferFrames is updated with the time-weighted avg and the running time-weighted avg is reset.
 static const quint64 FRAMES_AVAILABLE_STAT_WINDOW_USECS = 10 * USECS_PER_SECOND;
 
+// The jitter estimate follows a late packet at once, and forgets it over a few seconds of packets on time.
+static const float JITTER_ESTIMATE_ATTACK = 0.5f;
+static const float JITTER_ESTIMATE_DECAY = 0.002f;
+static const quint32 NUM_INITIAL_PACKETS_DISCARD_FOR_ESTIMATE = 10;
+
+// The depth of the buffer is averaged over the pops, around its oscillation between packets, before it is stretched.
+static const float AVERAGE_FRAMES_AVAILABLE_FACTOR = 0.02f;
+static const float TIME_STRETCH_HYSTERESIS_FRAMES = 0.5f;
+// at most one frame is stretched every so many, for the stretching to stay inaudible
+static const int MIN_FRAMES_BETWEEN_TIME_STRETCHES = 8;
+
 // When the audio codec is switched, temporary codec mismatch is expected due to packets in-flight.
 // A SelectedAudioFormat packet is not sent until this threshold is exceeded.
 static const int MAX_MISMATCHED_AUDIO_CODEC_COUNT = 10;
@@ -59,7 +70,6 @@ InboundAudioStream::InboundAudioStream(int numChannels, int numFrames, int numBl
     _staticJitterBufferFrames(std::max(numStaticJitterBlocks, DEFAULT_STATIC_JITTER_FRAMES)),
     _desiredJitterBufferFrames(_dynamicJitterBufferEnabled ? 1 : _staticJitterBufferFrames),
     _incomingSequenceNumberStats(STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
-    _starveHistory(STARVE_HISTORY_CAPACITY),
     _unplayedMs(0, UNPLAYED_MS_WINDOW_SECS),
     _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS) {}
 
@@ -89,13 +99,16 @@ void InboundAudioStream::resetStats() {
     _oldFramesDropped = 0;
     _incomingSequenceNumberStats.reset();
     _lastPacketReceivedTime = 0;
+    _lastPacketExtraFrames = 0;
     _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
-    _timeGapStatsForDesiredReduction.reset();
-    _starveHistory.clear();
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
     _timeGapStatsForStatsPacket.reset();
     _unplayedMs.reset();
+    _jitterEstimateUsecs = 0.0f;
+    _averageFramesAvailable = 0.0f;
+    _framesSinceTimeStretch = 0;
+    _timeStretchCount = 0;
 }
 
 void InboundAudioStream::clearBuffer() {
@@ -113,7 +126,6 @@ void InboundAudioStream::setReverb(float reverbTime, float wetLevel) {
 void InboundAudioStream::perSecondCallbackForUpdatingStats() {
     _incomingSequenceNumberStats.pushStatsToHistory();
     _timeGapStatsForDesiredCalcOnTooManyStarves.currentIntervalComplete();
-    _timeGapStatsForDesiredReduction.currentIntervalComplete();
     _timeGapStatsForStatsPacket.currentIntervalComplete();
     _unplayedMs.currentIntervalComplete();
 }
@@ -126,8 +138,6 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
         _incomingSequenceNumberStats.sequenceNumberReceived(sequence, message.getSourceID());
     QString codecInPacket = message.readString();
 
-    packetReceivedUpdateTimingStats();
-
     int networkFrames;
 
     // parse the info after the seq number and before the audio data (the stream properties)
@@ -136,6 +146,12 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
 
     message.seek(prePropertyPosition + propertyBytes);
 
+    // the mixer sends a single silent frame for several frames of silence, the next packet isn't due before they are over
+    bool isSilent = message.getType() == PacketType::SilentAudioFrame ||
+                    message.getType() == PacketType::ReplicatedSilentAudioFrame;
+    int framesInPacket = isSilent ? std::max(1, networkFrames / AudioConstants::NETWORK_FRAME_SAMPLES_STEREO) : 1;
+    packetReceivedUpdateTimingStats(framesInPacket);
+
     // handle this packet based on its arrival status.
     switch (arrivalInfo._status) {
         case SequenceNumberStats::Unreasonable: {
@@ -350,6 +366,11 @@ int InboundAudioStream::popSamples(int maxSamples, bool allOrNothing) {
         _consecutiveNotMixedCount++;
         _lastPopSucceeded = false;
     } else {
+        if (_dynamicJitterBufferEnabled) {
+            timeStretchBeforePop();
+            samplesAvailable = _ringBuffer.samplesAvailable();
+        }
+
         if (samplesAvailable >= maxSamples) {
             // we have enough samples to pop, so we're good to pop
             popSamplesNoCheck(maxSamples);
@@ -423,46 +444,20 @@ void InboundAudioStream::framesAvailableChanged() {
 void InboundAudioStream::setToStarved() {
     _consecutiveNotMixedCount = 0;
     _starveCount++;
-    // if we have more than the desired frames when setToStarved() is called, then we'll immediately
-    // be considered refilled. in that case, there's no need to set _isStarved to true.
-    _isStarved = (_ringBuffer.framesAvailable() < _desiredJitterBufferFrames);
-
-    // record the time of this starve in the starve history
-    quint64 now = usecTimestampNow();
-    _starveHistory.insert(now);
 
     if (_dynamicJitterBufferEnabled) {
-        // dynamic jitter buffers are enabled. check if this starve put us over the window
-        // starve threshold
-        quint64 windowEnd = now - WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES * USECS_PER_SECOND;
-        RingBufferHistory<quint64>::Iterator starvesIterator = _starveHistory.begin();
-        RingBufferHistory<quint64>::Iterator end = _starveHistory.end();
-        int starvesInWindow = 1;
-        do {
-            ++starvesIterator;
-            if (*starvesIterator < windowEnd) {
-                break;
-            }
-            starvesInWindow++;
-        } while (starvesIterator != end);
-
-        // this starve put us over the starve threshold. update _desiredJitterBufferFrames to
-        // value determined by window A.
-        if (starvesInWindow >= WINDOW_STARVE_THRESHOLD) {
-            int calculatedJitterBufferFrames;
-            // we don't know when the next packet will arrive, so it's possible the gap between the last packet and the
-            // next packet will exceed the max time gap in the window.  If the time since the last packet has already exceeded
-            // the window max gap, then we should use that value to calculate desired frames.
-            int framesSinceLastPacket = ceilf((float)(now - _lastPacketReceivedTime)
-                                              / (float)AudioConstants::NETWORK_FRAME_USECS);
-            calculatedJitterBufferFrames = std::max(_calculatedJitterBufferFrames, framesSinceLastPacket);
-            // make sure _desiredJitterBufferFrames does not become lower here
-            if (calculatedJitterBufferFrames >= _desiredJitterBufferFrames) {
-                _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                qCInfo(audiostream, "Set desired jitter frames to %d (starved)", _desiredJitterBufferFrames);
-            }
+        // the packet we are waiting for is late by at least the time since the last one
+        quint64 now = usecTimestampNow();
+        float excessGapUsecs = (float)(now - _lastPacketReceivedTime) - (float)AudioConstants::NETWORK_FRAME_USECS;
+        if (_lastPacketReceivedTime != 0 && excessGapUsecs > _jitterEstimateUsecs) {
+            updateJitterEstimate(excessGapUsecs);
+            qCInfo(audiostream, "Set desired jitter frames to %d (starved)", _desiredJitterBufferFrames);
         }
     }
+
+    // if we have more than the desired frames when setToStarved() is called, then we'll immediately
+    // be considered refilled. in that case, there's no need to set _isStarved to true.
+    _isStarved = (_ringBuffer.framesAvailable() < _desiredJitterBufferFrames);
 }
 
 void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
@@ -484,42 +479,156 @@ void InboundAudioStream::setStaticJitterBufferFrames(int staticJitterBufferFrame
     }
 }
 
-void InboundAudioStream::packetReceivedUpdateTimingStats() {
+void InboundAudioStream::setTargetLatencyMs(float targetLatencyMs) {
+    _targetLatencyMs = std::max(targetLatencyMs, 0.0f);
+    if (_dynamicJitterBufferEnabled) {
+        updateDesiredJitterBufferFrames();
+    }
+}
+
+void InboundAudioStream::updateJitterEstimate(float excessGapUsecs) {
+    excessGapUsecs = std::max(excessGapUsecs, 0.0f);
+    float factor = excessGapUsecs > _jitterEstimateUsecs ? JITTER_ESTIMATE_ATTACK : JITTER_ESTIMATE_DECAY;
+    _jitterEstimateUsecs += (excessGapUsecs - _jitterEstimateUsecs) * factor;
+    updateDesiredJitterBufferFrames();
+}
+
+void InboundAudioStream::updateDesiredJitterBufferFrames() {
+    int jitterFrames = (int)ceilf(_jitterEstimateUsecs / (float)AudioConstants::NETWORK_FRAME_USECS);
+    int targetFrames = (int)ceilf(_targetLatencyMs / AudioConstants::NETWORK_FRAME_MSECS);
+    _desiredJitterBufferFrames = std::max({ 1, jitterFrames, targetFrames });
+}
+
+void InboundAudioStream::timeStretchBeforePop() {
+    int numFrameSamples = _ringBuffer.getNumFrameSamples();
+    int samplesAvailable = _ringBuffer.samplesAvailable();
+    float framesAvailable = (float)samplesAvailable / (float)numFrameSamples;
+    _averageFramesAvailable += (framesAvailable - _averageFramesAvailable) * AVERAGE_FRAMES_AVAILABLE_FACTOR;
+
+    ++_framesSinceTimeStretch;
+    if (_framesSinceTimeStretch < MIN_FRAMES_BETWEEN_TIME_STRETCHES || _numChannels <= 0) {
+        return;
+    }
+
+    bool shouldShrink = _averageFramesAvailable >
+        _desiredJitterBufferFrames + DESIRED_JITTER_BUFFER_FRAMES_PADDING + TIME_STRETCH_HYSTERESIS_FRAMES;
+    bool shouldExpand = _averageFramesAvailable < _desiredJitterBufferFrames - TIME_STRETCH_HYSTERESIS_FRAMES;
+    // two frames are stretched into one or three halves, the samples behind the read position are written when expanding
+    if ((!shouldShrink && !shouldExpand) || samplesAvailable < 2 * numFrameSamples ||
+        (shouldExpand && samplesAvailable + 2 * numFrameSamples > _ringBuffer.getSampleCapacity())) {
+        return;
+    }
+
+    // WSOLA: the frame is overlapped with the most similar segment, from half a frame to a frame further, and the two
+    // are cross-faded, which removes or repeats a whole number of periods of the signal
+    int numFrames = numFrameSamples / _numChannels;
+    int offset = findStretchOffset(numFrames);
+    int offsetSamples = offset * _numChannels;
+
+    if (shouldShrink) {
+        // [0, numFrames + offset) becomes numFrames frames, fading from the frame to the segment at offset
+        _timeStretchBuffer.resize(numFrameSamples);
+        for (int i = 0; i < numFrames; i++) {
+            float fade = (float)i / (float)numFrames;
+            for (int c = 0; c < _numChannels; c++) {
+                int index = i * _numChannels + c;
+                float sample = _ringBuffer[index] * (1.0f - fade) + _ringBuffer[index + offsetSamples] * fade;
+                _timeStretchBuffer[index] = (int16_t)sample;
+            }
+        }
+        _ringBuffer.shiftReadPosition(offsetSamples);
+        for (int i = 0; i < numFrameSamples; i++) {
+            _ringBuffer[i] = _timeStretchBuffer[i];
+        }
+        _averageFramesAvailable -= (float)offset / (float)numFrames;
+    } else {
+        // [0, numFrames) becomes numFrames + offset frames, fading from the frame to the frame delayed by offset
+        int numStretchedSamples = numFrameSamples + offsetSamples;
+        _timeStretchBuffer.resize(numStretchedSamples);
+        for (int i = 0; i < numFrames + offset; i++) {
+            float fade = i < offset ? 0.0f : (float)(i - offset) / (float)numFrames;
+            for (int c = 0; c < _numChannels; c++) {
+                int index = i * _numChannels + c;
+                float delayed = i < offset ? 0.0f : _ringBuffer[index - offsetSamples];
+                float sample = _ringBuffer[index] * (1.0f - fade) + delayed * fade;
+                _timeStretchBuffer[index] = (int16_t)sample;
+            }
+        }
+        // unsigned shift: moves the read position back, over samples already played
+        _ringBuffer.shiftReadPosition(_ringBuffer.getSampleCapacity() - offsetSamples);
+        for (int i = 0; i < numStretchedSamples; i++) {
+            _ringBuffer[i] = _timeStretchBuffer[i];
+        }
+        _averageFramesAvailable += (float)offset / (float)numFrames;
+    }
+
+    _framesSinceTimeStretch = 0;
+    ++_timeStretchCount;
+}
+
+int InboundAudioStream::findStretchOffset(int numFrames) const {
+    // the normalized correlation of the frame with the segment starting at each offset, on every other frame of the
+    // first channel, is enough to find the period of the signal
+    static const int FRAME_STEP = 2;
+    static const int OFFSET_STEP = 2;
+
+    int bestOffset = numFrames;
+    float bestCorrelation = -1.0f;
+    for (int offset = numFrames / 2; offset <= numFrames; offset += OFFSET_STEP) {
+        float correlation = 0.0f;
+        float energy = 0.0f;
+        for (int i = 0; i < numFrames; i += FRAME_STEP) {
+            float sample = _ringBuffer[i * _numChannels];
+            float shifted = _ringBuffer[(i + offset) * _numChannels];
+            correlation += sample * shifted;
+            energy += shifted * shifted;
+        }
+        float normalized = energy > 0.0f ? correlation / sqrtf(energy) : 0.0f;
+        if (normalized > bestCorrelation) {
+            bestCorrelation = normalized;
+            bestOffset = offset;
+        }
+    }
+    return bestOffset;
+}
+
+void InboundAudioStream::packetReceivedUpdateTimingStats(int framesInPacket) {
     
     // update our timegap stats and desired jitter buffer frames if necessary
     // discard the first few packets we receive since they usually have gaps that aren't represensative of normal jitter
     const quint32 NUM_INITIAL_PACKETS_DISCARD = 1000; // 10s
     quint64 now = usecTimestampNow();
+
+    quint64 gap = now - _lastPacketReceivedTime;
+    // don't count the frames the last packet covered past its first as jitter
+    quint64 coveredGap = (quint64)_lastPacketExtraFrames * AudioConstants::NETWORK_FRAME_USECS;
+    gap = gap > coveredGap ? gap - coveredGap : 0;
+
+    // the playout controller only skips the very first packets, it has to settle quickly
+    if (_dynamicJitterBufferEnabled && _incomingSequenceNumberStats.getReceived() > NUM_INITIAL_PACKETS_DISCARD_FOR_ESTIMATE) {
+        int desiredFramesBefore = _desiredJitterBufferFrames;
+        updateJitterEstimate((float)gap - (float)AudioConstants::NETWORK_FRAME_USECS);
+        if (_desiredJitterBufferFrames != desiredFramesBefore) {
+            qCInfo(audiostream, "Set desired jitter frames to %d (estimated)", _desiredJitterBufferFrames);
+        }
+    }
+
     if (_incomingSequenceNumberStats.getReceived() > NUM_INITIAL_PACKETS_DISCARD) {
-        quint64 gap = now - _lastPacketReceivedTime;
         _timeGapStatsForStatsPacket.update(gap);
 
         // update all stats used for desired frames calculations under dynamic jitter buffer mode
         _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
-        _timeGapStatsForDesiredReduction.update(gap);
 
+        // the window maximum is still reported in the stats
         if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
             _calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
                                                              / (float) AudioConstants::NETWORK_FRAME_USECS);
             _timeGapStatsForDesiredCalcOnTooManyStarves.clearNewStatsAvailableFlag();
         }
-
-        if (_dynamicJitterBufferEnabled) {
-            // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
-            // then reduce _desiredJitterBufferFrames to that number of frames.
-            if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
-                int calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredReduction.getWindowMax()
-                                                         / (float)AudioConstants::NETWORK_FRAME_USECS);
-                if (calculatedJitterBufferFrames < _desiredJitterBufferFrames) {
-                    _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                    qCInfo(audiostream, "Set desired jitter frames to %d (reduced)", _desiredJitterBufferFrames);
-                }
-                _timeGapStatsForDesiredReduction.clearNewStatsAvailableFlag();
-            }
-        }
     }
 
     _lastPacketReceivedTime = now;
+    _lastPacketExtraFrames = framesInPacket - 1;
 }
 
 AudioStreamStats InboundAudioStream::getAudioStreamStats() const {
@@ -71,6 +71,10 @@ public:
     void setDynamicJitterBufferEnabled(bool enable);
     void setStaticJitterBufferFrames(int staticJitterBufferFrames);
 
+    /// the latency the dynamic jitter buffer keeps at least, when the network would allow less (0 for as low as it allows)
+    void setTargetLatencyMs(float targetLatencyMs);
+    float getTargetLatencyMs() const { return _targetLatencyMs; }
+
     virtual AudioStreamStats getAudioStreamStats() const;
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
@@ -115,11 +119,16 @@ public slots:
     void perSecondCallbackForUpdatingStats();
 
 private:
-    void packetReceivedUpdateTimingStats();
+    void packetReceivedUpdateTimingStats(int framesInPacket);
 
     void popSamplesNoCheck(int samples);
     void framesAvailableChanged();
 
+    void updateJitterEstimate(float excessGapUsecs);
+    void updateDesiredJitterBufferFrames();
+    void timeStretchBeforePop();
+    int findStretchOffset(int numFrames) const;
+
 protected:
     // disallow copying of InboundAudioStream objects
     InboundAudioStream(const InboundAudioStream&);
@@ -165,11 +174,9 @@ protected:
     SequenceNumberStats _incomingSequenceNumberStats;
 
     quint64 _lastPacketReceivedTime { 0 };
+    int _lastPacketExtraFrames { 0 }; // covered by the last packet past its first
     MovingMinMaxAvg<quint64> _timeGapStatsForDesiredCalcOnTooManyStarves { 0, WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES };
     int _calculatedJitterBufferFrames { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredReduction { 0, WINDOW_SECONDS_FOR_DESIRED_REDUCTION };
-
-    RingBufferHistory<quint64> _starveHistory;
 
     TimeWeightedAvg<int> _framesAvailableStat;
     MovingMinMaxAvg<float> _unplayedMs;
@@ -180,6 +187,15 @@ protected:
 
     MovingMinMaxAvg<quint64> _timeGapStatsForStatsPacket;
 
+    // adaptive playout under the dynamic jitter buffer: the jitter estimate rises as soon as a packet is late and decays
+    // slowly, and the depth follows it by time-stretching a frame at a time instead of by starving or dropping frames
+    float _jitterEstimateUsecs { 0.0f };
+    float _targetLatencyMs { 0.0f };
+    float _averageFramesAvailable { 0.0f };
+    int _framesSinceTimeStretch { 0 };
+    int _timeStretchCount { 0 };
+    std::vector<int16_t> _timeStretchBuffer;
+
     // Reverb properties
     bool _hasReverb { false };
     float _reverbTime { 0.0f };
@@ -10,6 +10,12 @@
 //
 
 #include "MixedProcessedAudioStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "AudioAmbisonicBed.h"
 #include "AudioLogging.h"
 #include "TryLocker.h"
 
@@ -25,6 +31,24 @@ void MixedProcessedAudioStream::outputFormatChanged(int sampleRate, int channelC
     _ringBuffer.resizeForFrameSize(deviceOutputFrameSamples);
 }
 
+int MixedProcessedAudioStream::parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum,
+                                                     int& numAudioSamples) {
+    if (type != PacketType::MixedAudioWithAmbisonicBed) {
+        _encodedBed.clear();
+        return InboundAudioStream::parseStreamProperties(type, packetAfterSeqNum, numAudioSamples);
+    }
+
+    numAudioSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    quint16 bedSize = 0;
+    if (packetAfterSeqNum.size() < (int)sizeof(bedSize)) {
+        _encodedBed.clear();
+        return packetAfterSeqNum.size();
+    }
+    memcpy(&bedSize, packetAfterSeqNum.constData(), sizeof(bedSize));
+    _encodedBed = packetAfterSeqNum.mid(sizeof(bedSize), bedSize);
+    return std::min((int)sizeof(bedSize) + (int)bedSize, packetAfterSeqNum.size());
+}
+
 int MixedProcessedAudioStream::writeDroppableSilentFrames(int silentFrames) {
     int deviceSilentFrames = networkToDeviceFrames(silentFrames);
     int deviceSilentFramesWritten = InboundAudioStream::writeDroppableSilentFrames(deviceSilentFrames);
@@ -33,8 +57,8 @@ int MixedProcessedAudioStream::writeDroppableSilentFrames(int silentFrames) {
 }
 
 int MixedProcessedAudioStream::lostAudioData(int numPackets) {
-    QByteArray decodedBuffer;
-    QByteArray outputBuffer;
+    QByteArray& decodedBuffer = _lostDecodedBuffer;
+    QByteArray& outputBuffer = _lostOutputBuffer;
 
     while (numPackets--) {
         MutexTryLocker lock(_decoderMutex);
@@ -75,6 +99,10 @@ int MixedProcessedAudioStream::parseAudioData(PacketType type, const QByteArray&
         decodedBuffer = packetAfterStreamProperties;
     }
 
+    if (!_encodedBed.isEmpty() && decodedBuffer.size() == AudioConstants::NETWORK_FRAME_BYTES_STEREO) {
+        renderAmbisonicBed(decodedBuffer);
+    }
+
     emit addedStereoSamples(decodedBuffer);
 
     QByteArray outputBuffer;
@@ -86,6 +114,32 @@ int MixedProcessedAudioStream::parseAudioData(PacketType type, const QByteArray&
     return packetAfterStreamProperties.size();
 }
 
+void MixedProcessedAudioStream::renderAmbisonicBed(QByteArray& decodedBuffer) {
+    static const int HRTF_DATASET_INDEX = 1;
+
+    int16_t bedSamples[AudioAmbisonicBed::NUM_SAMPLES];
+    if (!AudioAmbisonicBed::decode(_encodedBed, bedSamples)) {
+        return;
+    }
+
+    // the bed is world oriented, rotate it to the listener's head (Y-up to Z-up, as the local ambisonic injectors)
+    glm::quat relativeOrientation = _orientationGetter ? glm::inverse(_orientationGetter()) : glm::quat();
+    float qw = relativeOrientation.w;
+    float qx = -relativeOrientation.z;
+    float qy = -relativeOrientation.x;
+    float qz = relativeOrientation.y;
+
+    float bedMix[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] = {};
+    _bedFOA.render(bedSamples, bedMix, HRTF_DATASET_INDEX, qw, qx, qy, qz, FOA_GAIN,
+                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    int16_t* samples = reinterpret_cast<int16_t*>(decodedBuffer.data());
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+        float sample = (float)samples[i] + bedMix[i] * 32768.0f;
+        samples[i] = (int16_t)lrintf(std::max(std::min(sample, 32767.0f), -32768.0f));
+    }
+}
+
 int MixedProcessedAudioStream::networkToDeviceFrames(int networkFrames) {
     return ((quint64)networkFrames * _outputChannelCount * _outputSampleRate) /
         (quint64)(AudioConstants::STEREO * AudioConstants::SAMPLE_RATE);
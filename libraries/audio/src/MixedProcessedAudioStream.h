@@ -12,6 +12,11 @@
 #ifndef hifi_MixedProcessedAudioStream_h
 #define hifi_MixedProcessedAudioStream_h
 
+#include <functional>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "AudioFOA.h"
 #include "InboundAudioStream.h"
 
 class AudioClient;
@@ -30,9 +35,15 @@ signals:
     void processSamples(const QByteArray& inputBuffer, QByteArray& outputBuffer);
 
 public:
+    using OrientationGetter = std::function<glm::quat()>;
+
     void outputFormatChanged(int sampleRate, int channelCount);
 
+    // the head orientation the ambisonic bed of the mix is rendered with
+    void setOrientationGetter(OrientationGetter orientationGetter) { _orientationGetter = orientationGetter; }
+
 protected:
+    int parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& numAudioSamples) override;
     int writeDroppableSilentFrames(int silentFrames) override;
     int parseAudioData(PacketType type, const QByteArray& packetAfterStreamProperties) override;
     int lostAudioData(int numPackets) override;
@@ -41,9 +52,21 @@ private:
     int networkToDeviceFrames(int networkFrames);
     int deviceToNetworkFrames(int deviceFrames);
 
+    void renderAmbisonicBed(QByteArray& decodedBuffer);
+
 private:
     quint64 _outputSampleRate;
     quint64 _outputChannelCount;
+
+    // the lost frames are generated on the audio device thread, these keep their allocations from one to the next;
+    // guarded by the decoder mutex
+    QByteArray _lostDecodedBuffer;
+    QByteArray _lostOutputBuffer;
+
+    // the bed of the packet being parsed, rendered to binaural over the decoded mix
+    QByteArray _encodedBed;
+    AudioFOA _bedFOA;
+    OrientationGetter _orientationGetter;
 };
 
 #endif // hifi_MixedProcessedAudioStream_h
@@ -24,6 +24,7 @@
 #include <qendian.h>
 
 #include <LimitedNodeList.h>
+#include <MemoryAccounting.h>
 #include <NetworkAccessManager.h>
 #include <SharedUtil.h>
 
@@ -37,6 +38,11 @@ int audioDataPointerMetaTypeID = qRegisterMetaType<AudioDataPointer>("AudioDataP
 
 using AudioConstants::AudioSample;
 
+static MemoryTag& audioDataTag() {
+    static MemoryTag tag("audio.soundData");
+    return tag;
+}
+
 AudioDataPointer AudioData::make(uint32_t numSamples, uint32_t numChannels,
                                  const AudioSample* samples) {
     // Compute the amount of memory required for the audio data object
@@ -51,14 +57,16 @@ AudioDataPointer AudioData::make(uint32_t numSamples, uint32_t numChannels,
 
     // Use placement new to construct the audio data object at the memory allocated
     ::new(audioData) AudioData(numSamples, numChannels, buffer);
+    audioDataTag().allocated(memorySize);
 
     // Copy the samples to the buffer
     memcpy(buffer, samples, bufferSize);
 
     // Return shared_ptr that properly destruct the object and release the memory
-    return AudioDataPointer(audioData, [](AudioData* ptr) {
+    return AudioDataPointer(audioData, [memorySize](AudioData* ptr) {
         ptr->~AudioData();
         ::free(ptr);
+        audioDataTag().freed(memorySize);
     });
 }
 
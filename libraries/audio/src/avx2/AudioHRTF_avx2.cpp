@@ -169,6 +169,78 @@ void biquad2_4x4_AVX2(float* src, float* dst, float coef[5][8], float state[3][8
     _mm256_zeroupper();
 }
 
+// process 2 cascaded biquads on 4 channels (interleaved), for 2 independent sources
+// the biquads are latency bound, so interleaving two sources fills the otherwise idle FMA slots
+void biquad2_4x4x2_AVX2(float* src0, float* dst0, float* src1, float* dst1, float coef0[5][8], float state0[3][8],
+                        float coef1[5][8], float state1[3][8], int numFrames) {
+
+    // enable flush-to-zero mode to prevent denormals
+    unsigned int ftz = _MM_GET_FLUSH_ZERO_MODE();
+    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+
+    // restore state
+    __m256 x00 = _mm256_setzero_ps();
+    __m256 y00 = _mm256_loadu_ps(state0[0]);
+    __m256 w10 = _mm256_loadu_ps(state0[1]);
+    __m256 w20 = _mm256_loadu_ps(state0[2]);
+
+    __m256 x01 = _mm256_setzero_ps();
+    __m256 y01 = _mm256_loadu_ps(state1[0]);
+    __m256 w11 = _mm256_loadu_ps(state1[1]);
+    __m256 w21 = _mm256_loadu_ps(state1[2]);
+
+    //  biquad coefs
+    __m256 b00 = _mm256_loadu_ps(coef0[0]);
+    __m256 b10 = _mm256_loadu_ps(coef0[1]);
+    __m256 b20 = _mm256_loadu_ps(coef0[2]);
+    __m256 a10 = _mm256_loadu_ps(coef0[3]);
+    __m256 a20 = _mm256_loadu_ps(coef0[4]);
+
+    __m256 b01 = _mm256_loadu_ps(coef1[0]);
+    __m256 b11 = _mm256_loadu_ps(coef1[1]);
+    __m256 b21 = _mm256_loadu_ps(coef1[2]);
+    __m256 a11 = _mm256_loadu_ps(coef1[3]);
+    __m256 a21 = _mm256_loadu_ps(coef1[4]);
+
+    for (int i = 0; i < numFrames; i++) {
+
+        // x0 = (first biquad output << 128) | input
+        x00 = _mm256_insertf128_ps(_mm256_permute2f128_ps(y00, y00, 0x01), _mm_loadu_ps(&src0[4*i]), 0);
+        x01 = _mm256_insertf128_ps(_mm256_permute2f128_ps(y01, y01, 0x01), _mm_loadu_ps(&src1[4*i]), 0);
+
+        // transposed Direct Form II
+        y00 = _mm256_fmadd_ps(x00, b00, w10);
+        y01 = _mm256_fmadd_ps(x01, b01, w11);
+
+        w10 = _mm256_fmadd_ps(x00, b10, w20);
+        w11 = _mm256_fmadd_ps(x01, b11, w21);
+
+        w20 = _mm256_mul_ps(x00, b20);
+        w21 = _mm256_mul_ps(x01, b21);
+
+        w10 = _mm256_fnmadd_ps(y00, a10, w10);
+        w11 = _mm256_fnmadd_ps(y01, a11, w11);
+
+        w20 = _mm256_fnmadd_ps(y00, a20, w20);
+        w21 = _mm256_fnmadd_ps(y01, a21, w21);
+
+        _mm_storeu_ps(&dst0[4*i], _mm256_extractf128_ps(y00, 1)); // second biquad output
+        _mm_storeu_ps(&dst1[4*i], _mm256_extractf128_ps(y01, 1));
+    }
+
+    // save state
+    _mm256_storeu_ps(state0[0], y00);
+    _mm256_storeu_ps(state0[1], w10);
+    _mm256_storeu_ps(state0[2], w20);
+
+    _mm256_storeu_ps(state1[0], y01);
+    _mm256_storeu_ps(state1[1], w11);
+    _mm256_storeu_ps(state1[2], w21);
+
+    _MM_SET_FLUSH_ZERO_MODE(ftz);
+    _mm256_zeroupper();
+}
+
 // crossfade 4 inputs into 2 outputs with accumulation (interleaved)
 void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames) {
 
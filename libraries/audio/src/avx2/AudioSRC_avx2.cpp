@@ -29,6 +29,46 @@ int AudioSRC::multirateFilter1_AVX2(const float* input0, float* output0, int inp
 
         int32_t i = HI32(_offset);
 
+        if (_upFactor == 1) {
+
+            // integer decimation (48khz to 24khz): every output uses the same phase,
+            // so four consecutive outputs share each load of the coefficients
+            const float* c0 = _polyphaseFilter;
+            const int step = _downFactor;
+
+            for (; i + 3 * step < inputFrames; i += 4 * step) {
+
+                __m256 acc0 = _mm256_setzero_ps();
+                __m256 acc1 = _mm256_setzero_ps();
+                __m256 acc2 = _mm256_setzero_ps();
+                __m256 acc3 = _mm256_setzero_ps();
+
+                const float* x0 = &input0[i];
+                const float* x1 = &input0[i + 1 * step];
+                const float* x2 = &input0[i + 2 * step];
+                const float* x3 = &input0[i + 3 * step];
+
+                for (int j = 0; j < _numTaps; j += 8) {
+
+                    __m256 coef0 = _mm256_loadu_ps(&c0[j]);
+
+                    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x0[j]), coef0, acc0);
+                    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x1[j]), coef0, acc1);
+                    acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(&x2[j]), coef0, acc2);
+                    acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(&x3[j]), coef0, acc3);
+                }
+
+                // horizontal sum, the four outputs are consecutive
+                acc0 = _mm256_hadd_ps(acc0, acc1);
+                acc2 = _mm256_hadd_ps(acc2, acc3);
+                acc0 = _mm256_hadd_ps(acc0, acc2);
+                __m128 t0 = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+
+                _mm_storeu_ps(&output0[outputFrames], t0);
+                outputFrames += 4;
+            }
+        }
+
         while (i < inputFrames) {
 
             const float* c0 = &_polyphaseFilter[_numTaps * _phase];
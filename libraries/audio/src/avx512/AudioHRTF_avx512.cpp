@@ -87,4 +87,64 @@ void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* ds
     _mm256_zeroupper();
 }
 
+// two 8-channel rows (one per source) packed into a single 16-channel register
+static inline __m512 load_2x8(const float* src0, const float* src1) {
+    __m512d lo = _mm512_castpd256_pd512(_mm256_castps_pd(_mm256_loadu_ps(src0)));
+    return _mm512_castpd_ps(_mm512_insertf64x4(lo, _mm256_castps_pd(_mm256_loadu_ps(src1)), 1));
+}
+
+static inline void store_2x8(float* dst0, float* dst1, __m512 x) {
+    _mm256_storeu_ps(dst0, _mm512_castps512_ps256(x));
+    _mm256_storeu_ps(dst1, _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x), 1)));
+}
+
+// process 2 cascaded biquads on 4 channels (interleaved), for 2 independent sources
+// source 0 runs in the low 256 bits and source 1 in the high 256 bits
+void biquad2_4x4x2_AVX512(float* src0, float* dst0, float* src1, float* dst1, float coef0[5][8], float state0[3][8],
+                          float coef1[5][8], float state1[3][8], int numFrames) {
+
+    // enable flush-to-zero mode to prevent denormals
+    unsigned int ftz = _MM_GET_FLUSH_ZERO_MODE();
+    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+
+    // restore state
+    __m512 x0 = _mm512_setzero_ps();
+    __m512 y0 = load_2x8(state0[0], state1[0]);
+    __m512 w1 = load_2x8(state0[1], state1[1]);
+    __m512 w2 = load_2x8(state0[2], state1[2]);
+
+    //  biquad coefs
+    __m512 b0 = load_2x8(coef0[0], coef1[0]);
+    __m512 b1 = load_2x8(coef0[1], coef1[1]);
+    __m512 b2 = load_2x8(coef0[2], coef1[2]);
+    __m512 a1 = load_2x8(coef0[3], coef1[3]);
+    __m512 a2 = load_2x8(coef0[4], coef1[4]);
+
+    for (int i = 0; i < numFrames; i++) {
+
+        // x0 = { input0, first biquad output0, input1, first biquad output1 }
+        x0 = _mm512_shuffle_f32x4(y0, y0, _MM_SHUFFLE(2,2,0,0));
+        x0 = _mm512_insertf32x4(x0, _mm_loadu_ps(&src0[4*i]), 0);
+        x0 = _mm512_insertf32x4(x0, _mm_loadu_ps(&src1[4*i]), 2);
+
+        // transposed Direct Form II
+        y0 = _mm512_fmadd_ps(x0, b0, w1);
+        w1 = _mm512_fmadd_ps(x0, b1, w2);
+        w2 = _mm512_mul_ps(x0, b2);
+        w1 = _mm512_fnmadd_ps(y0, a1, w1);
+        w2 = _mm512_fnmadd_ps(y0, a2, w2);
+
+        _mm_storeu_ps(&dst0[4*i], _mm512_extractf32x4_ps(y0, 1));  // second biquad outputs
+        _mm_storeu_ps(&dst1[4*i], _mm512_extractf32x4_ps(y0, 3));
+    }
+
+    // save state
+    store_2x8(state0[0], state1[0], y0);
+    store_2x8(state0[1], state1[1], w1);
+    store_2x8(state0[2], state1[2], w2);
+
+    _MM_SET_FLUSH_ZERO_MODE(ftz);
+    _mm256_zeroupper();
+}
+
 #endif
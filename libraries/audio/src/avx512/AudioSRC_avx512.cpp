@@ -0,0 +1,396 @@
+//
+//  AudioSRC_avx512.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX512F__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../AudioSRC.h"
+
+// high/low part of int64_t
+#define LO32(a)   ((uint32_t)(a))
+#define HI32(a)   ((int32_t)((a) >> 32))
+
+//
+// The taps are a multiple of 8, so the last 8 taps are processed with the upper half masked off.
+// The masked loads don't read past the end of the input.
+//
+
+int AudioSRC::multirateFilter1_AVX512(const float* input0, float* output0, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 8 == 0);  // SIMD8
+    const int numTaps16 = _numTaps & ~15;
+    const __mmask16 tail = 0x00ff;
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        if (_upFactor == 1) {
+
+            // integer decimation (48khz to 24khz): every output uses the same phase,
+            // so four consecutive outputs share each load of the coefficients
+            const float* c0 = _polyphaseFilter;
+            const int step = _downFactor;
+
+            for (; i + 3 * step < inputFrames; i += 4 * step) {
+
+                __m512 acc0 = _mm512_setzero_ps();
+                __m512 acc1 = _mm512_setzero_ps();
+                __m512 acc2 = _mm512_setzero_ps();
+                __m512 acc3 = _mm512_setzero_ps();
+
+                const float* x0 = &input0[i];
+                const float* x1 = &input0[i + 1 * step];
+                const float* x2 = &input0[i + 2 * step];
+                const float* x3 = &input0[i + 3 * step];
+
+                int j = 0;
+                for (; j < numTaps16; j += 16) {
+
+                    __m512 coef0 = _mm512_loadu_ps(&c0[j]);
+
+                    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(&x0[j]), coef0, acc0);
+                    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(&x1[j]), coef0, acc1);
+                    acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(&x2[j]), coef0, acc2);
+                    acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(&x3[j]), coef0, acc3);
+                }
+                if (j < _numTaps) {
+
+                    __m512 coef0 = _mm512_maskz_loadu_ps(tail, &c0[j]);
+
+                    acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &x0[j]), coef0, acc0);
+                    acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &x1[j]), coef0, acc1);
+                    acc2 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &x2[j]), coef0, acc2);
+                    acc3 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &x3[j]), coef0, acc3);
+                }
+
+                output0[outputFrames + 0] = _mm512_reduce_add_ps(acc0);
+                output0[outputFrames + 1] = _mm512_reduce_add_ps(acc1);
+                output0[outputFrames + 2] = _mm512_reduce_add_ps(acc2);
+                output0[outputFrames + 3] = _mm512_reduce_add_ps(acc3);
+                outputFrames += 4;
+            }
+        }
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            __m512 acc0 = _mm512_setzero_ps();
+            __m512 acc1 = _mm512_setzero_ps();
+
+            int j = 0;
+            for (; j < numTaps16 - 16; j += 32) {   // unrolled x 2
+
+                //float coef = c0[j];
+                __m512 coef0 = _mm512_loadu_ps(&c0[j + 0]);
+                __m512 coef1 = _mm512_loadu_ps(&c0[j + 16]);
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(&input0[i + j + 0]), coef0, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(&input0[i + j + 16]), coef1, acc1);
+            }
+            for (; j < numTaps16; j += 16) {
+
+                __m512 coef0 = _mm512_loadu_ps(&c0[j]);
+
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(&input0[i + j]), coef0, acc0);
+            }
+            if (j < _numTaps) {
+
+                __m512 coef0 = _mm512_maskz_loadu_ps(tail, &c0[j]);
+
+                acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input0[i + j]), coef0, acc1);
+            }
+
+            output0[outputFrames] = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            float ftmp = (f & SRC_FRACMASK) * QFRAC_TO_FLOAT;
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            __m512 acc0 = _mm512_setzero_ps();
+            __m512 frac = _mm512_set1_ps(ftmp);
+
+            int j = 0;
+            for (; j < numTaps16; j += 16) {
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                __m512 coef0 = _mm512_loadu_ps(&c0[j]);
+                __m512 coef1 = _mm512_loadu_ps(&c1[j]);
+                coef1 = _mm512_sub_ps(coef1, coef0);
+                coef0 = _mm512_fmadd_ps(coef1, frac, coef0);
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(&input0[i + j]), coef0, acc0);
+            }
+            if (j < _numTaps) {
+
+                __m512 coef0 = _mm512_maskz_loadu_ps(tail, &c0[j]);
+                __m512 coef1 = _mm512_maskz_loadu_ps(tail, &c1[j]);
+                coef1 = _mm512_sub_ps(coef1, coef0);
+                coef0 = _mm512_fmadd_ps(coef1, frac, coef0);
+
+                acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input0[i + j]), coef0, acc0);
+            }
+
+            output0[outputFrames] = _mm512_reduce_add_ps(acc0);
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+    _mm256_zeroupper();
+
+    return outputFrames;
+}
+
+int AudioSRC::multirateFilter2_AVX512(const float* input0, const float* input1, float* output0, float* output1, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 8 == 0);  // SIMD8
+    const int numTaps16 = _numTaps & ~15;
+    const __mmask16 tail = 0x00ff;
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            __m512 acc0 = _mm512_setzero_ps();
+            __m512 acc1 = _mm512_setzero_ps();
+
+            int j = 0;
+            for (; j < numTaps16; j += 16) {
+
+                //float coef = c0[j];
+                __m512 coef0 = _mm512_loadu_ps(&c0[j]);
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(&input0[i + j]), coef0, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(&input1[i + j]), coef0, acc1);
+            }
+            if (j < _numTaps) {
+
+                __m512 coef0 = _mm512_maskz_loadu_ps(tail, &c0[j]);
+
+                acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input0[i + j]), coef0, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input1[i + j]), coef0, acc1);
+            }
+
+            output0[outputFrames] = _mm512_reduce_add_ps(acc0);
+            output1[outputFrames] = _mm512_reduce_add_ps(acc1);
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            float ftmp = (f & SRC_FRACMASK) * QFRAC_TO_FLOAT;
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            __m512 acc0 = _mm512_setzero_ps();
+            __m512 acc1 = _mm512_setzero_ps();
+            __m512 frac = _mm512_set1_ps(ftmp);
+
+            int j = 0;
+            for (; j < numTaps16; j += 16) {
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                __m512 coef0 = _mm512_loadu_ps(&c0[j]);
+                __m512 coef1 = _mm512_loadu_ps(&c1[j]);
+                coef1 = _mm512_sub_ps(coef1, coef0);
+                coef0 = _mm512_fmadd_ps(coef1, frac, coef0);
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(&input0[i + j]), coef0, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(&input1[i + j]), coef0, acc1);
+            }
+            if (j < _numTaps) {
+
+                __m512 coef0 = _mm512_maskz_loadu_ps(tail, &c0[j]);
+                __m512 coef1 = _mm512_maskz_loadu_ps(tail, &c1[j]);
+                coef1 = _mm512_sub_ps(coef1, coef0);
+                coef0 = _mm512_fmadd_ps(coef1, frac, coef0);
+
+                acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input0[i + j]), coef0, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input1[i + j]), coef0, acc1);
+            }
+
+            output0[outputFrames] = _mm512_reduce_add_ps(acc0);
+            output1[outputFrames] = _mm512_reduce_add_ps(acc1);
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+    _mm256_zeroupper();
+
+    return outputFrames;
+}
+
+int AudioSRC::multirateFilter4_AVX512(const float* input0, const float* input1, const float* input2, const float* input3,
+                                      float* output0, float* output1, float* output2, float* output3, int inputFrames) {
+    int outputFrames = 0;
+
+    assert(_numTaps % 8 == 0);  // SIMD8
+    const int numTaps16 = _numTaps & ~15;
+    const __mmask16 tail = 0x00ff;
+
+    if (_step == 0) {   // rational
+
+        int32_t i = HI32(_offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &_polyphaseFilter[_numTaps * _phase];
+
+            __m512 acc0 = _mm512_setzero_ps();
+            __m512 acc1 = _mm512_setzero_ps();
+            __m512 acc2 = _mm512_setzero_ps();
+            __m512 acc3 = _mm512_setzero_ps();
+
+            int j = 0;
+            for (; j < numTaps16; j += 16) {
+
+                //float coef = c0[j];
+                __m512 coef0 = _mm512_loadu_ps(&c0[j]);
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(&input0[i + j]), coef0, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(&input1[i + j]), coef0, acc1);
+                acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(&input2[i + j]), coef0, acc2);
+                acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(&input3[i + j]), coef0, acc3);
+            }
+            if (j < _numTaps) {
+
+                __m512 coef0 = _mm512_maskz_loadu_ps(tail, &c0[j]);
+
+                acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input0[i + j]), coef0, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input1[i + j]), coef0, acc1);
+                acc2 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input2[i + j]), coef0, acc2);
+                acc3 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input3[i + j]), coef0, acc3);
+            }
+
+            output0[outputFrames] = _mm512_reduce_add_ps(acc0);
+            output1[outputFrames] = _mm512_reduce_add_ps(acc1);
+            output2[outputFrames] = _mm512_reduce_add_ps(acc2);
+            output3[outputFrames] = _mm512_reduce_add_ps(acc3);
+            outputFrames += 1;
+
+            i += _stepTable[_phase];
+            if (++_phase == _upFactor) {
+                _phase = 0;
+            }
+        }
+        _offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_offset) < inputFrames) {
+
+            int32_t i = HI32(_offset);
+            uint32_t f = LO32(_offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            float ftmp = (f & SRC_FRACMASK) * QFRAC_TO_FLOAT;
+
+            const float* c0 = &_polyphaseFilter[_numTaps * (phase + 0)];
+            const float* c1 = &_polyphaseFilter[_numTaps * (phase + 1)];
+
+            __m512 acc0 = _mm512_setzero_ps();
+            __m512 acc1 = _mm512_setzero_ps();
+            __m512 acc2 = _mm512_setzero_ps();
+            __m512 acc3 = _mm512_setzero_ps();
+            __m512 frac = _mm512_set1_ps(ftmp);
+
+            int j = 0;
+            for (; j < numTaps16; j += 16) {
+
+                //float coef = c0[j] + frac * (c1[j] - c0[j]);
+                __m512 coef0 = _mm512_loadu_ps(&c0[j]);
+                __m512 coef1 = _mm512_loadu_ps(&c1[j]);
+                coef1 = _mm512_sub_ps(coef1, coef0);
+                coef0 = _mm512_fmadd_ps(coef1, frac, coef0);
+
+                //acc += input[i + j] * coef;
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(&input0[i + j]), coef0, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(&input1[i + j]), coef0, acc1);
+                acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(&input2[i + j]), coef0, acc2);
+                acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(&input3[i + j]), coef0, acc3);
+            }
+            if (j < _numTaps) {
+
+                __m512 coef0 = _mm512_maskz_loadu_ps(tail, &c0[j]);
+                __m512 coef1 = _mm512_maskz_loadu_ps(tail, &c1[j]);
+                coef1 = _mm512_sub_ps(coef1, coef0);
+                coef0 = _mm512_fmadd_ps(coef1, frac, coef0);
+
+                acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input0[i + j]), coef0, acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input1[i + j]), coef0, acc1);
+                acc2 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input2[i + j]), coef0, acc2);
+                acc3 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, &input3[i + j]), coef0, acc3);
+            }
+
+            output0[outputFrames] = _mm512_reduce_add_ps(acc0);
+            output1[outputFrames] = _mm512_reduce_add_ps(acc1);
+            output2[outputFrames] = _mm512_reduce_add_ps(acc2);
+            output3[outputFrames] = _mm512_reduce_add_ps(acc3);
+            outputFrames += 1;
+
+            _offset += _step;
+        }
+        _offset -= (int64_t)inputFrames << 32;
+    }
+    _mm256_zeroupper();
+
+    return outputFrames;
+}
+
+#endif
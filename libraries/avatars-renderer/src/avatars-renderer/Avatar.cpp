@@ -647,7 +647,7 @@ void Avatar::addToScene(AvatarSharedPointer self, const render::ScenePointer& sc
     _skeletonModel->addToScene(scene, transaction, std::bind(&Avatar::metaBlendshapeOperator, _renderItemID, _1, _2, _3, _4));
     _skeletonModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
     _skeletonModel->setGroupCulled(true);
-    _skeletonModel->setCanCastShadow(true);
+    _skeletonModel->setCanCastShadow(!_isDistantRendering);
     _skeletonModel->setVisibleInScene(_isMeshVisible, scene);
 
     processMaterials();
@@ -657,7 +657,7 @@ void Avatar::addToScene(AvatarSharedPointer self, const render::ScenePointer& sc
         attachmentModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
         attachmentModel->setGroupCulled(true);
         attachmentModel->setCanCastShadow(true);
-        attachmentModel->setVisibleInScene(_isMeshVisible, scene);
+        attachmentModel->setVisibleInScene(_isMeshVisible && !_isDistantRendering, scene);
         attachmentRenderingNeedsUpdate = true;
     }
 
@@ -863,6 +863,13 @@ bool Avatar::getEnableMeshVisible() const {
     return _isMeshVisible;
 }
 
+void Avatar::setDistantRendering(bool isDistant) {
+    if (_isDistantRendering != isDistant) {
+        _isDistantRendering = isDistant;
+        _needDistantRenderingSwitch = true;
+    }
+}
+
 void Avatar::fixupModelsInScene(const render::ScenePointer& scene) {
     bool canTryFade{ false };
 
@@ -878,7 +885,7 @@ void Avatar::fixupModelsInScene(const render::ScenePointer& scene) {
 
         _skeletonModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
         _skeletonModel->setGroupCulled(true);
-        _skeletonModel->setCanCastShadow(true);
+        _skeletonModel->setCanCastShadow(!_isDistantRendering);
         _skeletonModel->setVisibleInScene(_isMeshVisible, scene);
 
         processMaterials();
@@ -894,7 +901,7 @@ void Avatar::fixupModelsInScene(const render::ScenePointer& scene) {
             attachmentModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
             attachmentModel->setGroupCulled(true);
             attachmentModel->setCanCastShadow(true);
-            attachmentModel->setVisibleInScene(_isMeshVisible, scene);
+            attachmentModel->setVisibleInScene(_isMeshVisible && !_isDistantRendering, scene);
             attachmentRenderingNeedsUpdate = true;
         }
     }
@@ -903,13 +910,29 @@ void Avatar::fixupModelsInScene(const render::ScenePointer& scene) {
         _skeletonModel->setVisibleInScene(_isMeshVisible, scene);
         for (auto attachmentModel : _attachmentModels) {
             if (attachmentModel->isRenderable()) {
-                attachmentModel->setVisibleInScene(_isMeshVisible, scene);
+                attachmentModel->setVisibleInScene(_isMeshVisible && !_isDistantRendering, scene);
             }
         }
         updateRenderItem(transaction);
         _needMeshVisibleSwitch = false;
     }
 
+    if (_needDistantRenderingSwitch) {
+        _skeletonModel->setCanCastShadow(!_isDistantRendering, scene);
+        bool attachmentsVisible = _isMeshVisible && !_isDistantRendering;
+        for (auto attachmentModel : _attachmentModels) {
+            if (attachmentModel->isRenderable()) {
+                attachmentModel->setVisibleInScene(attachmentsVisible, scene);
+                if (attachmentsVisible) {
+                    for (auto itemID : attachmentModel->fetchRenderItemIDs()) {
+                        transaction.resetTransitionOnItem(itemID, render::Transition::AVATAR_CHANGE, _renderItemID);
+                    }
+                }
+            }
+        }
+        _needDistantRenderingSwitch = false;
+    }
+
     if (_mustFadeIn && canTryFade) {
         // Do it now to be sure all the sub items are ready and the fade is sent to them too
         fade(transaction, render::Transition::USER_ENTER_DOMAIN);
@@ -1076,7 +1099,10 @@ void Avatar::renderDisplayName(gpu::Batch& batch, const ViewFrustum& view, const
     }
 
     // Compute display name extent/position offset
-    static TextRenderer3D* displayNameRenderer = TextRenderer3D::getInstance(ROBOTO_FONT_FAMILY);
+    if (!_displayNameRenderer) {
+        _displayNameRenderer.reset(TextRenderer3D::getInstance(ROBOTO_FONT_FAMILY));
+    }
+    const auto& displayNameRenderer = _displayNameRenderer;
     const glm::vec2 extent = displayNameRenderer->computeExtent(renderedDisplayName);
     if (!glm::any(glm::isCompNull(extent, EPSILON))) {
         const QRect nameDynamicRect = QRect(0, 0, (int)extent.x, (int)extent.y);
@@ -58,6 +58,7 @@ enum ScreenTintLayer {
 };
 
 class Texture;
+class TextRenderer3D;
 
 class AvatarTransit {
 public:
@@ -540,6 +541,11 @@ public:
     virtual void setEnableMeshVisible(bool isEnabled);
     virtual bool getEnableMeshVisible() const;
 
+    // The distant avatars are drawn without their attachments and don't cast shadows, the attachments fade back in
+    // once the avatar is near again
+    void setDistantRendering(bool isDistant);
+    bool isRenderedDistant() const { return _isDistantRendering; }
+
     void addMaterial(graphics::MaterialLayer material, const std::string& parentMaterialName);
     void removeMaterial(graphics::MaterialPointer material, const std::string& parentMaterialName);
 
@@ -723,6 +729,8 @@ protected:
     int _leftPointerGeometryID { 0 };
     int _rightPointerGeometryID { 0 };
     int _nameRectGeometryID { 0 };
+    // of this avatar, so that the layout of its name is kept from frame to frame
+    mutable std::shared_ptr<TextRenderer3D> _displayNameRenderer;
     bool _initialized { false };
     bool _isAnimatingScale { false };
     bool _mustFadeIn { false };
@@ -749,6 +757,8 @@ protected:
     AABox _renderBound;
     bool _isMeshVisible{ true };
     bool _needMeshVisibleSwitch{ true };
+    bool _isDistantRendering { false };
+    bool _needDistantRenderingSwitch { false };
 
     static const float MYAVATAR_LOADING_PRIORITY;
     static const float OTHERAVATAR_LOADING_PRIORITY;
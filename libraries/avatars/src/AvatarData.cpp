@@ -55,6 +55,7 @@ using namespace std;
 const QString AvatarData::FRAME_NAME = "com.highfidelity.recording.AvatarData";
 
 static const int TRANSLATION_COMPRESSION_RADIX = 14;
+static const int COMPACT_TRANSLATION_COMPRESSION_RADIX = 6;
 static const int HAND_CONTROLLER_COMPRESSION_RADIX = 12;
 static const int SENSOR_TO_WORLD_SCALE_RADIX = 10;
 static const float AUDIO_LOUDNESS_SCALE = 1024.0f;
@@ -689,9 +690,15 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     // include jointData if there is room for the most minimal section. i.e. no translations or rotations.
     IF_AVATAR_SPACE(PACKET_HAS_JOINT_DATA, AvatarDataPacket::minJointDataSize(numJoints)) {
+        const bool compactJoints = (sendStatus.jointQuantization == AvatarDataPacket::FarJoints);
+        if (compactJoints) {
+            includedFlags |= AvatarDataPacket::PACKET_HAS_COMPACT_JOINTS;
+        }
+        const ptrdiff_t rotationSize = compactJoints ? sizeof(AvatarDataPacket::FourByteQuat) : sizeof(AvatarDataPacket::SixByteQuat);
+
         // Minimum space required for another rotation joint -
         // size of joint + following translation bit-vector + translation scale:
-        const ptrdiff_t minSizeForJoint = sizeof(AvatarDataPacket::SixByteQuat) + jointBitVectorSize + sizeof(float);
+        const ptrdiff_t minSizeForJoint = rotationSize + jointBitVectorSize + sizeof(float);
 
         auto startSection = destinationBuffer;
 
@@ -743,7 +750,11 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         rotationSentCount++;
 #endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        if (compactJoints) {
+                            destinationBuffer += packOrientationQuatToFourBytes(destinationBuffer, data.rotation);
+                        } else {
+                            destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        }
 
                         if (sentJoints) {
                             sentJoints[i].rotation = data.rotation;
@@ -791,8 +802,13 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         translationSentCount++;
 #endif
-                        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
-                                                                               TRANSLATION_COMPRESSION_RADIX);
+                        if (compactJoints) {
+                            destinationBuffer += packFloatVec3ToSignedOneByteFixed(destinationBuffer,
+                                data.translation / maxTranslationDimension, COMPACT_TRANSLATION_COMPRESSION_RADIX);
+                        } else {
+                            destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer,
+                                data.translation / maxTranslationDimension, TRANSLATION_COMPRESSION_RADIX);
+                        }
 
                         if (sentJoints) {
                             sentJoints[i].translation = data.translation;
@@ -997,6 +1013,7 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     bool hasJointData             = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DATA);
     bool hasJointDefaultPoseFlags = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS);
     bool hasGrabJoints            = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_GRAB_JOINTS);
+    bool hasCompactJoints         = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_COMPACT_JOINTS);
 
     quint64 now = usecTimestampNow();
 
@@ -1347,16 +1364,20 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
             }
         }
 
-        // each joint rotation is stored in 6 bytes.
+        // each joint rotation is stored in 6 bytes, or 4 when compact.
         QWriteLocker writeLock(&_jointDataLock);
         _jointData.resize(numJoints);
 
-        const int COMPRESSED_QUATERNION_SIZE = 6;
+        const int COMPRESSED_QUATERNION_SIZE = hasCompactJoints ? 4 : 6;
         PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
         for (int i = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                if (hasCompactJoints) {
+                    sourceBuffer += unpackOrientationQuatFromFourBytes(sourceBuffer, data.rotation);
+                } else {
+                    sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                }
                 _hasNewJointData = true;
                 data.rotationIsDefaultPose = false;
             }
@@ -1390,14 +1411,20 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
         sourceBuffer += sizeof(float);
 
-        // each joint translation component is stored in 6 bytes.
-        const int COMPRESSED_TRANSLATION_SIZE = 6;
+        // each joint translation is stored in 6 bytes, or 3 when compact.
+        const int COMPRESSED_TRANSLATION_SIZE = hasCompactJoints ? 3 : 6;
         PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
 
         for (int i = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+                if (hasCompactJoints) {
+                    sourceBuffer += unpackFloatVec3FromSignedOneByteFixed(sourceBuffer, data.translation,
+                        COMPACT_TRANSLATION_COMPRESSION_RADIX);
+                } else {
+                    sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation,
+                        TRANSLATION_COMPRESSION_RADIX);
+                }
                 data.translation *= maxTranslationDimension;
                 _hasNewJointData = true;
                 data.translationIsDefaultPose = false;
@@ -2404,8 +2431,10 @@ void AvatarData::detachAll(const QString& modelURL, const QString& jointName) {
 }
 
 int AvatarData::sendAvatarDataPacket(bool sendAll) {
-    auto nodeList = DependencyManager::get<NodeList>();
+    return sendAvatarDataPacketTo(*DependencyManager::get<NodeList>(), sendAll);
+}
 
+int AvatarData::sendAvatarDataPacketTo(NodeList& nodeList, bool sendAll) {
     // about 2% of the time, we send a full update (meaning, we transmit all the joint data), even if nothing has changed.
     // this is to guard against a joint moving once, the packet getting lost, and the joint never moving again.
 
@@ -2430,38 +2459,50 @@ int AvatarData::sendAvatarDataPacket(bool sendAll) {
 
     doneEncoding(cullSmallData);
 
-    static AvatarDataSequenceNumber sequenceNumber = 0;
-
-    auto avatarPacket = NLPacket::create(PacketType::AvatarData, avatarByteArray.size() + sizeof(sequenceNumber));
-    avatarPacket->writePrimitive(sequenceNumber++);
+    auto avatarPacket = NLPacket::create(PacketType::AvatarData,
+                                         avatarByteArray.size() + sizeof(_avatarDataSequenceNumber));
+    avatarPacket->writePrimitive(_avatarDataSequenceNumber++);
     avatarPacket->write(avatarByteArray);
     auto packetSize = avatarPacket->getWireSize();
 
-    nodeList->broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
+    // a sample of the updates is followed through the avatar mixer to the other clients
+    auto traceID = tracing::sampleTraceID();
+    if (traceID != tracing::NULL_TRACE_ID) {
+        avatarPacket->writeTraceID(traceID);
+        tracing::traceFlow(trace_network(), "AvatarData sent", tracing::FlowStart, traceID);
+    }
+
+    nodeList.broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
 
     return packetSize;
 }
 
-int AvatarData::sendIdentityPacket() {
-    auto nodeList = DependencyManager::get<NodeList>();
-
+QByteArray AvatarData::identityByteArrayForSend() {
     if (_identityDataChanged) {
         // if the identity data has changed, push the sequence number forwards
         ++_identitySequenceNumber;
     }
-    QByteArray identityData = identityByteArray();
+    _identityDataChanged = false;
+    return identityByteArray();
+}
+
+int AvatarData::sendIdentityPacket() {
+    return sendIdentityPacketTo(*DependencyManager::get<NodeList>());
+}
+
+int AvatarData::sendIdentityPacketTo(NodeList& nodeList) {
+    QByteArray identityData = identityByteArrayForSend();
 
     auto packetList = NLPacketList::create(PacketType::AvatarIdentity, QByteArray(), true, true);
     packetList->write(identityData);
-    nodeList->eachMatchingNode(
+    nodeList.eachMatchingNode(
         [](const SharedNodePointer& node)->bool {
             return node->getType() == NodeType::AvatarMixer && node->getActiveSocket();
         },
         [&](const SharedNodePointer& node) {
-            nodeList->sendPacketList(std::move(packetList), *node);
+            nodeList.sendPacketList(std::move(packetList), *node);
     });
 
-    _identityDataChanged = false;
     return identityData.size();
 }
 
@@ -205,10 +205,22 @@ namespace AvatarDataPacket {
     const HasFlags PACKET_HAS_JOINT_DATA               = 1U << 12;
     const HasFlags PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS = 1U << 13;
     const HasFlags PACKET_HAS_GRAB_JOINTS              = 1U << 14;
+    const HasFlags PACKET_HAS_COMPACT_JOINTS           = 1U << 15; // the joint data uses the compact quantization below
     const size_t AVATAR_HAS_FLAGS_SIZE = 2;
 
     using SixByteQuat = uint8_t[6];
     using SixByteTrans = uint8_t[6];
+    using FourByteQuat = uint8_t[4];
+    using ThreeByteTrans = uint8_t[3];
+
+    // How precisely the mixer quantizes a source's joints for one receiver. Near and hero joints use the full
+    // SixByteQuat / SixByteTrans encoding, heroes are also never culled by distance. Far joints are compacted to
+    // FourByteQuat / ThreeByteTrans and flagged with PACKET_HAS_COMPACT_JOINTS.
+    enum JointQuantization : uint8_t {
+        NearJoints = 0,
+        FarJoints,
+        HeroJoints
+    };
 
     // NOTE: AvatarDataPackets start with a uint16_t sequence number that is not reflected in the Header structure.
 
@@ -341,9 +353,11 @@ namespace AvatarDataPacket {
         uint8_t numJoints;
         uint8_t rotationValidityBits[ceil(numJoints / 8)];     // one bit per joint, if true then a compressed rotation follows.
         SixByteQuat rotation[numValidRotations];               // encodeded and compressed by packOrientationQuatToSixBytes()
+                                                               // or FourByteQuat, packOrientationQuatToFourBytes(), if compact
         uint8_t translationValidityBits[ceil(numJoints / 8)];  // one bit per joint, if true then a compressed translation follows.
         float maxTranslationDimension;                         // used to normalize fixed point translation values.
         SixByteTrans translation[numValidTranslations];        // normalized and compressed by packFloatVec3ToSignedTwoByteFixed()
+                                                               // or ThreeByteTrans, packFloatVec3ToSignedOneByteFixed(), if compact
         SixByteQuat leftHandControllerRotation;
         SixByteTrans leftHandControllerTranslation;
         SixByteQuat rightHandControllerRotation;
@@ -384,6 +398,7 @@ namespace AvatarDataPacket {
         bool sendUUID { false };
         int rotationsSent { 0 };  // ie: index of next unsent joint
         int translationsSent { 0 };
+        JointQuantization jointQuantization { NearJoints };
         operator bool() { return itemFlags == 0; }
     };
 }
@@ -479,6 +494,7 @@ public:
 };
 
 class ClientTraitsHandler;
+class NodeList;
 
 class AvatarData : public QObject, public SpatiallyNestable {
     Q_OBJECT
@@ -1235,6 +1251,12 @@ public:
     void prepareResetTraitInstances();
 
     QByteArray identityByteArray(bool setIsReplicated = false) const;
+    // the identity as it is sent to the mixer, with its sequence number pushed forwards if it changed since it last was
+    QByteArray identityByteArrayForSend();
+
+    // send through a node list other than the DependencyManager's one, for the tools that connect many avatars
+    int sendAvatarDataPacketTo(NodeList& nodeList, bool sendAll = false);
+    int sendIdentityPacketTo(NodeList& nodeList);
 
     QUrl getWireSafeSkeletonModelURL() const;
     virtual const QUrl& getSkeletonModelURL() const;
@@ -1843,6 +1865,7 @@ protected:
 
     bool _identityDataChanged { false };
     udt::SequenceNumber _identitySequenceNumber { 0 };
+    AvatarDataSequenceNumber _avatarDataSequenceNumber { 0 };
     bool _hasProcessedFirstIdentity { false };
     float _density;
     int _replicaIndex { 0 };
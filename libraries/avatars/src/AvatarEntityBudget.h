@@ -0,0 +1,92 @@
+//
+//  AvatarEntityBudget.h
+//  libraries/avatars/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AvatarEntityBudget_h
+#define hifi_AvatarEntityBudget_h
+
+#include <algorithm>
+
+#include <QtCore/QtGlobal>
+
+#include <UUID.h>
+
+// The room a frame of the avatar mixer has for the avatar entities of the others, for one receiver. The avatars are
+// taken in the receiver's priority order: those in view are sent their avatar entities while the frame has room, and
+// those out of view keep theirs until they come into view.
+//
+// Once the frame is full, one avatar in view still gets a single avatar entity out, so that the avatars at the end of
+// the order, and an entity larger than the budget, make progress. That pass goes round the avatars held back by local
+// ID, one frame after the other, and the receiver keeps the one it goes to next between its frames.
+class AvatarEntityBudget {
+public:
+    static const NetworkLocalID NULL_SENDER = 0;
+
+    // overBudgetSender is what getNextOverBudgetSender returned in the receiver's previous frame
+    AvatarEntityBudget(qint64 bytesPerFrame, NetworkLocalID overBudgetSender) :
+        _remainingBytes(std::max(bytesPerFrame, (qint64)0)), _overBudgetSender(overBudgetSender) {}
+
+    void beginAvatar(bool isInView, NetworkLocalID sender) {
+        _isInView = isInView;
+        _sender = sender;
+    }
+
+    // bytesWritten is what the traits of the avatar took so far in this frame. An avatar entity that is refused is
+    // counted as held back, the caller has to leave it for a later frame.
+    bool canSendAvatarEntity(qint64 bytesWritten) {
+        if (!_isInView) {
+            return false;
+        }
+        if (bytesWritten < _remainingBytes) {
+            return true;
+        }
+        if (!_hasUsedOverBudgetPass && _sender != NULL_SENDER && _sender == _overBudgetSender) {
+            _hasUsedOverBudgetPass = true;
+            return true;
+        }
+
+        if (_firstHeldBackSender == NULL_SENDER || _sender < _firstHeldBackSender) {
+            _firstHeldBackSender = _sender;
+        }
+        if (_sender > _overBudgetSender && (_nextHeldBackSender == NULL_SENDER || _sender < _nextHeldBackSender)) {
+            _nextHeldBackSender = _sender;
+        }
+        return false;
+    }
+
+    // the traits of the avatars in view, all of them, count against the budget
+    void endAvatar(qint64 bytesWritten) {
+        if (_isInView) {
+            _remainingBytes = std::max(_remainingBytes - bytesWritten, (qint64)0);
+        }
+    }
+
+    qint64 getRemainingBytes() const { return _remainingBytes; }
+
+    // the avatar held back in this frame that gets the pass in the next one, after this frame's in the local ID order
+    NetworkLocalID getNextOverBudgetSender() const {
+        return _nextHeldBackSender != NULL_SENDER ? _nextHeldBackSender : _firstHeldBackSender;
+    }
+
+private:
+    qint64 _remainingBytes;
+    const NetworkLocalID _overBudgetSender;
+    bool _hasUsedOverBudgetPass { false };
+
+    NetworkLocalID _firstHeldBackSender { NULL_SENDER };
+    NetworkLocalID _nextHeldBackSender { NULL_SENDER };
+
+    bool _isInView { false };
+    NetworkLocalID _sender { NULL_SENDER };
+};
+
+#endif // hifi_AvatarEntityBudget_h
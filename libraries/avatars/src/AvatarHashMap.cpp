@@ -119,7 +119,10 @@ void AvatarReplicas::processTraitInstance(const QUuid& parentID, AvatarTraits::T
     }
 }
 
-AvatarHashMap::AvatarHashMap() {
+// in bytes, the mixer sends the traits that fell out of it again when it is told
+static const int TRAIT_DATA_CACHE_SIZE = 8 * 1024 * 1024;
+
+AvatarHashMap::AvatarHashMap() : _traitDataCache(TRAIT_DATA_CACHE_SIZE) {
     auto nodeList = DependencyManager::get<NodeList>();
 
     auto& packetReceiver = nodeList->getPacketReceiver();
@@ -245,6 +248,12 @@ AvatarSharedPointer AvatarHashMap::findAvatar(const QUuid& sessionUUID) const {
 void AvatarHashMap::processAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     DETAILED_PROFILE_RANGE(network, __FUNCTION__);
     PerformanceTimer perfTimer("receiveAvatar");
+    if (message->getTraceID() != tracing::NULL_TRACE_ID) {
+        tracing::traceFlow(trace_network(), "BulkAvatarData received", tracing::FlowStep, message->getTraceID());
+        std::lock_guard<std::mutex> lock(_receivedTraceIDsMutex);
+        _receivedTraceIDs.push_back(message->getTraceID());
+    }
+
     // enumerate over all of the avatars in this packet
     // only add them if mixerWeakPointer points to something (meaning that mixer is still around)
     while (message->getBytesLeftToRead()) {
@@ -252,6 +261,13 @@ void AvatarHashMap::processAvatarDataPacket(QSharedPointer<ReceivedMessage> mess
     }
 }
 
+std::vector<tracing::TraceID> AvatarHashMap::takeReceivedTraceIDs() {
+    std::vector<tracing::TraceID> traceIDs;
+    std::lock_guard<std::mutex> lock(_receivedTraceIDsMutex);
+    traceIDs.swap(_receivedTraceIDs);
+    return traceIDs;
+}
+
 AvatarSharedPointer AvatarHashMap::parseAvatarData(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     QUuid sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
 
@@ -360,6 +376,32 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
         nodeList->sendPacket(std::move(traitsAckPacket), *avatarMixer);
     }
 
+    // the traits sent by hash that we don't have the content of anymore, the mixer sends them again
+    std::vector<std::pair<QUuid, AvatarTraits::TraitHash>> missedTraits;
+
+    auto cacheTraitData = [&](const QByteArray& traitData) {
+        if (traitData.size() >= AvatarTraits::MIN_HASHED_TRAIT_SIZE) {
+            _traitDataCache.insert(AvatarTraits::hashTraitData(traitData), new QByteArray(traitData), traitData.size());
+        }
+    };
+
+    auto readTraitData = [&](const QUuid& avatarID, AvatarTraits::TraitWireSize traitBinarySize, QByteArray& traitData) {
+        if (traitBinarySize != AvatarTraits::HASHED_TRAIT_SIZE) {
+            traitData = message->read(traitBinarySize);
+            cacheTraitData(traitData);
+            return true;
+        }
+
+        auto traitHash = message->read(AvatarTraits::TRAIT_HASH_SIZE);
+        auto cachedTraitData = _traitDataCache.object(traitHash);
+        if (!cachedTraitData) {
+            missedTraits.emplace_back(avatarID, traitHash);
+            return false;
+        }
+        traitData = *cachedTraitData;
+        return true;
+    };
+
     while (message->getBytesLeftToRead() > 0) {
         // Trying to read more bytes than available, bail
         if (message->getBytesLeftToRead() < qint64(NUM_BYTES_RFC4122_UUID +
@@ -393,6 +435,7 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
             message->readPrimitive(&packetTraitVersion);
 
             AvatarTraits::TraitWireSize traitBinarySize;
+            qint64 traitWireBytes = 0;
             bool skipBinaryTrait = false;
 
             if (AvatarTraits::isSimpleTrait(traitType)) {
@@ -403,19 +446,23 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
                 }
 
                 message->readPrimitive(&traitBinarySize);
+                traitWireBytes = traitBinarySize == AvatarTraits::HASHED_TRAIT_SIZE ?
+                    AvatarTraits::TRAIT_HASH_SIZE : traitBinarySize;
 
                 // Trying to read more bytes than available, bail
-                if (message->getBytesLeftToRead() < traitBinarySize) {
+                if (traitWireBytes < 0 || message->getBytesLeftToRead() < traitWireBytes) {
                     qWarning() << "Malformed bulk trait packet, bailling";
                     return;
                 }
 
                 // check if this trait version is newer than what we already have for this avatar
                 if (packetTraitVersion > lastProcessedVersions[traitType]) {
-                    auto traitData = message->read(traitBinarySize);
-                    avatar->processTrait(traitType, traitData);
-                    _replicas.processTrait(avatarID, traitType, traitData);
-                    lastProcessedVersions[traitType] = packetTraitVersion;
+                    QByteArray traitData;
+                    if (readTraitData(avatarID, traitBinarySize, traitData)) {
+                        avatar->processTrait(traitType, traitData);
+                        _replicas.processTrait(avatarID, traitType, traitData);
+                        lastProcessedVersions[traitType] = packetTraitVersion;
+                    }
                 } else {
                     skipBinaryTrait = true;
                 }
@@ -431,9 +478,11 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
                     QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
 
                 message->readPrimitive(&traitBinarySize);
+                traitWireBytes = traitBinarySize == AvatarTraits::HASHED_TRAIT_SIZE ?
+                    AvatarTraits::TRAIT_HASH_SIZE : std::max((qint64)traitBinarySize, (qint64)0);
 
                 // Trying to read more bytes than available, bail
-                if (traitBinarySize < -1 || message->getBytesLeftToRead() < traitBinarySize) {
+                if (traitBinarySize < AvatarTraits::HASHED_TRAIT_SIZE || message->getBytesLeftToRead() < traitWireBytes) {
                     qWarning() << "Malformed bulk trait packet, bailling";
                     return;
                 }
@@ -443,26 +492,43 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
                     if (traitBinarySize == AvatarTraits::DELETED_TRAIT_SIZE) {
                         avatar->processDeletedTraitInstance(traitType, traitInstanceID);
                         _replicas.processDeletedTraitInstance(avatarID, traitType, traitInstanceID);
+                        processedInstanceVersion = packetTraitVersion;
                     } else {
-                        auto traitData = message->read(traitBinarySize);
-                        avatar->processTraitInstance(traitType, traitInstanceID, traitData);
-                        _replicas.processTraitInstance(avatarID, traitType, traitInstanceID, traitData);
+                        QByteArray traitData;
+                        if (readTraitData(avatarID, traitBinarySize, traitData)) {
+                            avatar->processTraitInstance(traitType, traitInstanceID, traitData);
+                            _replicas.processTraitInstance(avatarID, traitType, traitInstanceID, traitData);
+                            processedInstanceVersion = packetTraitVersion;
+                        }
                     }
-                    processedInstanceVersion = packetTraitVersion;
                 } else {
                     skipBinaryTrait = true;
                 }
             }
 
-            if (skipBinaryTrait && traitBinarySize > 0) {
-                // we didn't read this trait because it was older or because we didn't have an avatar to process it for
-                message->seek(message->getPosition() + traitBinarySize);
+            if (skipBinaryTrait && traitWireBytes > 0) {
+                // we didn't read this trait because it was older or because we didn't have an avatar to process it for,
+                // its content is kept all the same since the mixer refers to it by hash from now on
+                if (traitBinarySize >= AvatarTraits::MIN_HASHED_TRAIT_SIZE) {
+                    cacheTraitData(message->read(traitBinarySize));
+                } else {
+                    message->seek(message->getPosition() + traitWireBytes);
+                }
             }
 
             // read the next trait type, which is null if there are no more traits for this avatar
             message->readPrimitive(&traitType);
         }
     }
+
+    if (!missedTraits.empty() && !avatarMixer.isNull()) {
+        auto missPacketList = NLPacketList::create(PacketType::BulkAvatarTraitsMiss, QByteArray(), true, true);
+        for (const auto& missedTrait : missedTraits) {
+            missPacketList->write(missedTrait.first.toRfc4122());
+            missPacketList->write(missedTrait.second);
+        }
+        nodeList->sendPacketList(std::move(missPacketList), *avatarMixer);
+    }
 }
 
 void AvatarHashMap::processKillAvatar(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -13,13 +13,16 @@
 #ifndef hifi_AvatarHashMap_h
 #define hifi_AvatarHashMap_h
 
+#include <QtCore/QCache>
 #include <QtCore/QHash>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QUuid>
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <chrono>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -78,6 +81,9 @@ public:
     const AvatarHash getHashCopy() const { QReadLocker lock(&_hashLock); return _avatarHash; }
     int size() { QReadLocker lock(&_hashLock); return _avatarHash.size(); }
 
+    // the traces of the avatar data received since the last call, for the frame that shows the data to end them
+    std::vector<tracing::TraceID> takeReceivedTraceIDs();
+
     // Currently, your own avatar will be included as the null avatar id.
     
     /*@jsdoc
@@ -242,6 +248,12 @@ protected:
     std::unordered_map<QUuid, AvatarTraits::TraitVersions> _processedTraitVersions;
     AvatarReplicas _replicas;
 
+    // the content of the traits the mixer sent us in full, by hash, for it to refer to when any avatar has it again
+    QCache<AvatarTraits::TraitHash, QByteArray> _traitDataCache;
+
+    std::mutex _receivedTraceIDsMutex;
+    std::vector<tracing::TraceID> _receivedTraceIDs;
+
 private:
     QUuid _lastOwnerSessionUUID;
 };
@@ -11,12 +11,36 @@
 
 #include "AvatarTraits.h"
 
+#include <QtCore/QCryptographicHash>
+
 #include <ExtendedIODevice.h>
 
 #include "AvatarData.h"
 
 namespace AvatarTraits {
 
+    TraitHash hashTraitData(const QByteArray& traitData) {
+        return QCryptographicHash::hash(traitData, QCryptographicHash::Md5);
+    }
+
+    static qint64 writeTraitData(ExtendedIODevice& destination, const QByteArray& traitBinaryData,
+                                 TraitHashes* sentHashes) {
+        qint64 bytesWritten = 0;
+        if (sentHashes && traitBinaryData.size() >= MIN_HASHED_TRAIT_SIZE) {
+            auto hash = hashTraitData(traitBinaryData);
+            if (sentHashes->contains(hash)) {
+                bytesWritten += destination.writePrimitive(HASHED_TRAIT_SIZE);
+                bytesWritten += destination.write(hash);
+                return bytesWritten;
+            }
+            sentHashes->insert(hash);
+        }
+
+        bytesWritten += destination.writePrimitive((TraitWireSize)traitBinaryData.size());
+        bytesWritten += destination.write(traitBinaryData);
+        return bytesWritten;
+    }
+
     qint64 packTrait(TraitType traitType, ExtendedIODevice& destination, const AvatarData& avatar) {
         // Call packer function
         auto traitBinaryData = avatar.packTrait(traitType);
@@ -38,7 +62,8 @@ namespace AvatarTraits {
     }
 
     qint64 packVersionedTrait(TraitType traitType, ExtendedIODevice& destination,
-                              TraitVersion traitVersion, const AvatarData& avatar) {
+                              TraitVersion traitVersion, const AvatarData& avatar,
+                              TraitHashes* sentHashes) {
         // Call packer function
         auto traitBinaryData = avatar.packTrait(traitType);
         auto traitBinaryDataSize = traitBinaryData.size();
@@ -54,8 +79,7 @@ namespace AvatarTraits {
         qint64 bytesWritten = 0;
         bytesWritten += destination.writePrimitive((TraitType)traitType);
         bytesWritten += destination.writePrimitive((TraitVersion)traitVersion);
-        bytesWritten += destination.writePrimitive((TraitWireSize)traitBinaryDataSize);
-        bytesWritten += destination.write(traitBinaryData);
+        bytesWritten += writeTraitData(destination, traitBinaryData, sentHashes);
         return bytesWritten;
     }
 
@@ -91,7 +115,7 @@ namespace AvatarTraits {
 
     qint64 packVersionedTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
                                       ExtendedIODevice& destination, TraitVersion traitVersion,
-                                      AvatarData& avatar) {
+                                      AvatarData& avatar, TraitHashes* sentHashes) {
         // Call packer function
         auto traitBinaryData = avatar.packTraitInstance(traitType, traitInstanceID);
         auto traitBinaryDataSize = traitBinaryData.size();
@@ -111,8 +135,7 @@ namespace AvatarTraits {
         bytesWritten += destination.write(traitInstanceID.toRfc4122());
 
         if (!traitBinaryData.isNull()) {
-            bytesWritten += destination.writePrimitive((TraitWireSize)traitBinaryDataSize);
-            bytesWritten += destination.write(traitBinaryData);
+            bytesWritten += writeTraitData(destination, traitBinaryData, sentHashes);
         } else {
             bytesWritten += destination.writePrimitive(AvatarTraits::DELETED_TRAIT_SIZE);
         }
@@ -17,6 +17,8 @@
 #include <array>
 #include <vector>
 
+#include <QtCore/QByteArray>
+#include <QtCore/QSet>
 #include <QtCore/QUuid>
 
 class ExtendedIODevice;
@@ -57,19 +59,35 @@ namespace AvatarTraits {
     const TraitWireSize DELETED_TRAIT_SIZE = -1;
     const TraitWireSize MAXIMUM_TRAIT_SIZE = INT16_MAX;
 
+    // The mixer sends a trait that its listener was already sent the same content of, by this or another avatar, as
+    // the hash of that content. The listener keeps the content of the traits it was sent by hash, and tells the mixer
+    // when it doesn't have one anymore, with a BulkAvatarTraitsMiss.
+    const TraitWireSize HASHED_TRAIT_SIZE = -2;
+    // the traits smaller than this are always sent in full, a hash wouldn't save much
+    const int MIN_HASHED_TRAIT_SIZE = 128;
+
+    using TraitHash = QByteArray;
+    const int TRAIT_HASH_SIZE = 16;
+    TraitHash hashTraitData(const QByteArray& traitData);
+
+    // the hashes of the traits sent in full to a listener
+    using TraitHashes = QSet<TraitHash>;
+
     using TraitMessageSequence = int64_t;
     const TraitMessageSequence FIRST_TRAIT_SEQUENCE = 0;
     const TraitMessageSequence MAX_TRAIT_SEQUENCE = INT64_MAX;
 
     qint64 packTrait(TraitType traitType, ExtendedIODevice& destination, const AvatarData& avatar);
+    // the versioned traits are sent by hash when their content is in sentHashes, and added to it when sent in full
     qint64 packVersionedTrait(TraitType traitType, ExtendedIODevice& destination,
-                              TraitVersion traitVersion, const AvatarData& avatar);
+                              TraitVersion traitVersion, const AvatarData& avatar,
+                              TraitHashes* sentHashes = nullptr);
 
     qint64 packTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
                              ExtendedIODevice& destination, AvatarData& avatar);
     qint64 packVersionedTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
                                       ExtendedIODevice& destination, TraitVersion traitVersion,
-                                      AvatarData& avatar);
+                                      AvatarData& avatar, TraitHashes* sentHashes = nullptr);
 
     qint64 packInstancedTraitDelete(TraitType traitType, TraitInstanceID instanceID, ExtendedIODevice& destination,
                                            TraitVersion traitVersion = NULL_TRAIT_VERSION);
@@ -181,30 +181,30 @@ void TextureBaker::processTexture() {
                 return;
             }
 
-            auto memKTX = gpu::Texture::serialize(*processedTextureAndSize.first, processedTextureAndSize.second);
-            if (!memKTX) {
+            ktx::Header header;
+            ktx::Images images;
+            ktx::KeyValues keyValues;
+            if (!gpu::Texture::serialize(*processedTextureAndSize.first, processedTextureAndSize.second, header, images, keyValues)) {
                 handleError("Could not serialize " + _textureURL.toString() + " to KTX");
                 return;
             }
 
-            const char* name = khronos::gl::texture::toString(memKTX->_header.getGLInternaFormat());
+            const char* name = khronos::gl::texture::toString(header.getGLInternaFormat());
             if (name == nullptr) {
                 handleError("Could not determine internal format for compressed KTX: " + _textureURL.toString());
                 return;
             }
 
-            const char* data = reinterpret_cast<const char*>(memKTX->_storage->data());
-            const size_t length = memKTX->_storage->size();
-
+            // written straight from the mips, without a copy of the whole KTX
             auto fileName = _baseFilename + "_" + name + ".ktx";
             auto filePath = _outputDirectory.absoluteFilePath(fileName);
             QFile bakedTextureFile { filePath };
-            if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data, length) == -1) {
+            if (!bakedTextureFile.open(QIODevice::WriteOnly) || !ktx::KTX::write(bakedTextureFile, header, images, keyValues)) {
                 handleError("Could not write baked texture for " + _textureURL.toString());
                 return;
             }
             _outputFiles.push_back(filePath);
-            meta.availableTextureTypes[memKTX->_header.getGLInternaFormat()] = fileName;
+            meta.availableTextureTypes[header.getGLInternaFormat()] = fileName;
         }
     }
 
@@ -223,19 +223,18 @@ void TextureBaker::processTexture() {
             return;
         }
 
-        auto memKTX = gpu::Texture::serialize(*processedTextureAndSize.first, processedTextureAndSize.second);
-        if (!memKTX) {
+        ktx::Header header;
+        ktx::Images images;
+        ktx::KeyValues keyValues;
+        if (!gpu::Texture::serialize(*processedTextureAndSize.first, processedTextureAndSize.second, header, images, keyValues)) {
             handleError("Could not serialize " + _textureURL.toString() + " to KTX");
             return;
         }
 
-        const char* data = reinterpret_cast<const char*>(memKTX->_storage->data());
-        const size_t length = memKTX->_storage->size();
-
         auto fileName = _baseFilename + ".ktx";
         auto filePath = _outputDirectory.absoluteFilePath(fileName);
         QFile bakedTextureFile { filePath };
-        if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data, length) == -1) {
+        if (!bakedTextureFile.open(QIODevice::WriteOnly) || !ktx::KTX::write(bakedTextureFile, header, images, keyValues)) {
             handleError("Could not write baked texture for " + _textureURL.toString());
             return;
         }
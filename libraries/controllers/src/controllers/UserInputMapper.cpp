@@ -520,17 +520,33 @@ void UserInputMapper::runMappings() {
 void UserInputMapper::applyRoutes(const Route::List& routes) {
     Route::List deferredRoutes;
 
+    // only the routes to the standard inputs wait for a write, and only a route that writes to something else than
+    // an action can make one of them ready, so there's no need to try them all again after each route
+    auto mayWrite = [](const Route::Pointer& route) {
+        return route->destination && route->destination->getInput().device != ACTIONS_DEVICE;
+    };
+    bool mayHaveWritten = false;
     for (const auto& route : routes) {
         if (!route) {
             continue;
         }
 
         // Try all the deferred routes
-        deferredRoutes.remove_if([](Route::Pointer route) {
-            return UserInputMapper::applyRoute(route);
-        });
+        bool mayHaveWrittenAgain = false;
+        if (mayHaveWritten && !deferredRoutes.empty()) {
+            deferredRoutes.remove_if([&](Route::Pointer route) {
+                if (!UserInputMapper::applyRoute(route)) {
+                    return false;
+                }
+                mayHaveWrittenAgain = mayHaveWrittenAgain || mayWrite(route);
+                return true;
+            });
+        }
+        mayHaveWritten = mayHaveWrittenAgain;
 
-        if (!applyRoute(route)) {
+        if (applyRoute(route)) {
+            mayHaveWritten = mayHaveWritten || mayWrite(route);
+        } else {
             deferredRoutes.push_back(route);
         }
     }
@@ -1112,6 +1128,7 @@ Route::Pointer UserInputMapper::parseRoute(const QJsonValue& value) {
     if (obj.contains(JSON_CHANNEL_FILTERS)) {
         auto filtersValue = obj[JSON_CHANNEL_FILTERS];
         result->filters = parseFilters(filtersValue);
+        Filter::combine(result->filters);
         if (result->filters.empty()) {
             qWarning() << "Invalid route filters " << filtersValue;
             return Route::Pointer();
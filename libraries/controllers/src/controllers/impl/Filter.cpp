@@ -35,6 +35,23 @@
 
 using namespace controller;
 
+void Filter::combine(List& filters) {
+    auto it = filters.begin();
+    while (it != filters.end()) {
+        auto next = std::next(it);
+        if (next == filters.end()) {
+            break;
+        }
+        auto combined = (*it)->combine(*next);
+        if (combined) {
+            *it = combined;
+            filters.erase(next);
+        } else {
+            it = next;
+        }
+    }
+}
+
 Filter::Factory Filter::_factory;
 
 REGISTER_FILTER_CLASS_INSTANCE(ClampFilter, "clamp")
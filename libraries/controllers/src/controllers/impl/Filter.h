@@ -41,6 +41,11 @@ namespace controller {
         virtual AxisValue apply(AxisValue value) const = 0;
         virtual Pose apply(Pose value) const = 0;
 
+        // returns one filter that does what this one then next do, or null if they can't be combined
+        virtual Pointer combine(const Pointer& next) const { return Pointer(); }
+        // combines the consecutive filters of a route that can be, once, when the route is made
+        static void combine(List& filters);
+
         // Factory features
         virtual bool parseParameters(const QJsonValue& parameters) { return true; }
 
@@ -51,6 +51,7 @@ void RouteBuilderProxy::to(const QScriptValue& destination) {
 
 void RouteBuilderProxy::to(const Endpoint::Pointer& destination) {
     _route->destination = destination;
+    Filter::combine(_route->filters);
     _mapping->routes.push_back(_route);
     deleteLater();
 }
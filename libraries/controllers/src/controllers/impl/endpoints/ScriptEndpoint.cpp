@@ -41,9 +41,12 @@ AxisValue ScriptEndpoint::peek() const {
 
 void ScriptEndpoint::updateValue() {
     if (QThread::currentThread() != thread()) {
-        QMetaObject::invokeMethod(this, "updateValue", Qt::QueuedConnection);
+        if (!_isUpdateQueued.exchange(true)) {
+            QMetaObject::invokeMethod(this, "updateValue", Qt::QueuedConnection);
+        }
         return;
     }
+    _isUpdateQueued = false;
 
     QScriptValue result = _callable.call();
     if (result.isError()) {
@@ -51,7 +54,7 @@ void ScriptEndpoint::updateValue() {
         qCDebug(controllers).noquote() << formatException(result);
         _lastValueRead = 0.0f;
     } else if (result.isNumber()) {
-        _lastValueRead = (float)_callable.call().toNumber();
+        _lastValueRead = (float)result.toNumber();
     } else {
         Pose::fromScriptValue(result, _lastPoseRead);
         _returnPose = true;
@@ -68,9 +71,9 @@ void ScriptEndpoint::apply(AxisValue value, const Pointer& source) {
 
 void ScriptEndpoint::internalApply(float value, int sourceID) {
     if (QThread::currentThread() != thread()) {
-        QMetaObject::invokeMethod(this, "internalApply", Qt::QueuedConnection,
-            Q_ARG(float, value),
-            Q_ARG(int, sourceID));
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _pendingValues.emplace_back(value, sourceID);
+        queueApply();
         return;
     }
     QScriptValue result = _callable.call(QScriptValue(),
@@ -88,9 +91,13 @@ Pose ScriptEndpoint::peekPose() const {
 
 void ScriptEndpoint::updatePose() {
     if (QThread::currentThread() != thread()) {
-        QMetaObject::invokeMethod(this, "updatePose", Qt::QueuedConnection);
+        if (!_isPoseUpdateQueued.exchange(true)) {
+            QMetaObject::invokeMethod(this, "updatePose", Qt::QueuedConnection);
+        }
         return;
     }
+    _isPoseUpdateQueued = false;
+
     QScriptValue result = _callable.call();
     if (result.isError()) {
         // print JavaScript exception
@@ -109,9 +116,9 @@ void ScriptEndpoint::apply(const Pose& newPose, const Pointer& source) {
 void ScriptEndpoint::internalApply(const Pose& newPose, int sourceID) {
     _lastPoseWritten = newPose;
     if (QThread::currentThread() != thread()) {
-        QMetaObject::invokeMethod(this, "internalApply", Qt::QueuedConnection,
-            Q_ARG(const Pose&, newPose),
-            Q_ARG(int, sourceID));
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _pendingPoses.emplace_back(newPose, sourceID);
+        queueApply();
         return;
     }
     QScriptValue result = _callable.call(QScriptValue(),
@@ -121,3 +128,30 @@ void ScriptEndpoint::internalApply(const Pose& newPose, int sourceID) {
         qCDebug(controllers).noquote() << formatException(result);
     }
 }
+
+void ScriptEndpoint::queueApply() {
+    // under _pendingMutex
+    if (!_isApplyQueued) {
+        _isApplyQueued = true;
+        QMetaObject::invokeMethod(this, "applyPending", Qt::QueuedConnection);
+    }
+}
+
+void ScriptEndpoint::applyPending() {
+    std::vector<std::pair<float, int>> values;
+    std::vector<std::pair<Pose, int>> poses;
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _isApplyQueued = false;
+        values.swap(_pendingValues);
+        poses.swap(_pendingPoses);
+    }
+
+    // in the order they were written, none of them is dropped so that a press and its release both get through
+    for (const auto& value : values) {
+        internalApply(value.first, value.second);
+    }
+    for (const auto& pose : poses) {
+        internalApply(pose.first, pose.second);
+    }
+}
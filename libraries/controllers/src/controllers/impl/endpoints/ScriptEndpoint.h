@@ -10,6 +10,10 @@
 #ifndef hifi_Controllers_ScriptEndpoint_h
 #define hifi_Controllers_ScriptEndpoint_h
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include <QtScript/QScriptValue>
 
 #include "../Endpoint.h"
@@ -38,7 +42,22 @@ protected:
 
     Q_INVOKABLE void updatePose();
     Q_INVOKABLE virtual void internalApply(const Pose& newValue, int sourceID);
+
+    // passes the values written from the other threads to the script, all at once
+    Q_INVOKABLE void applyPending();
 private:
+    void queueApply();
+
+    // the values written by the routes wait for the script thread here, a single call of applyPending takes them all
+    std::mutex _pendingMutex;
+    std::vector<std::pair<float, int>> _pendingValues;
+    std::vector<std::pair<Pose, int>> _pendingPoses;
+    bool _isApplyQueued { false };
+
+    // a read is queued once until the script thread gets to it
+    std::atomic<bool> _isUpdateQueued { false };
+    std::atomic<bool> _isPoseUpdateQueued { false };
+
     QScriptValue _callable;
     float _lastValueRead { 0.0f };
     AxisValue _lastValueWritten { 0.0f, 0, false };
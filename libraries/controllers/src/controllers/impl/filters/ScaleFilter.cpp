@@ -13,6 +13,14 @@
 
 using namespace controller;
 
+Filter::Pointer ScaleFilter::combine(const Filter::Pointer& next) const {
+    auto nextScale = std::dynamic_pointer_cast<ScaleFilter>(next);
+    if (!nextScale) {
+        return Filter::Pointer();
+    }
+    return std::make_shared<ScaleFilter>(_scale * nextScale->_scale);
+}
+
 bool ScaleFilter::parseParameters(const QJsonValue& parameters) {
     static const QString JSON_SCALE = QStringLiteral("scale");
     return parseSingleFloatParameter(parameters, JSON_SCALE, _scale);
@@ -30,6 +30,8 @@ public:
         return value.transform(glm::scale(glm::mat4(), glm::vec3(_scale)));
     }
 
+    virtual Filter::Pointer combine(const Filter::Pointer& next) const override;
+
     virtual bool parseParameters(const QJsonValue& parameters) override;
 
 private:
@@ -424,6 +424,7 @@ void OpenGLDisplayPlugin::uncustomizeContext() {
     withPresentThreadLock([&] {
         _currentFrame.reset();
         _lastFrame = nullptr;
+        _lastNewFramePresentTime = 0;
         while (!_newFrameQueue.empty()) {
             _gpuContext->consumeFrameUpdates(_newFrameQueue.front());
             _newFrameQueue.pop();
@@ -586,22 +587,34 @@ void OpenGLDisplayPlugin::updateFrameData() {
     if (_lockCurrentTexture) {
         return;
     }
+
+    // Only the handoff is done under the lock, so that the render thread never waits on the GL work below to submit
+    // its next frame
+    std::queue<gpu::FramePointer> newFrames;
     withPresentThreadLock([&] {
-        if (!_newFrameQueue.empty()) {
-            // We're changing frames, so we can cleanup any GL resources that might have been used by the old frame
-            _gpuContext->recycle();
-        }
-        if (_newFrameQueue.size() > 1) {
-            _droppedFrameRate.increment(_newFrameQueue.size() - 1);
-        }
+        std::swap(newFrames, _newFrameQueue);
+    });
+
+    if (!newFrames.empty()) {
+        // We're changing frames, so we can cleanup any GL resources that might have been used by the old frame
+        _gpuContext->recycle();
+    }
+    if (newFrames.size() > 1) {
+        _droppedFrameRate.increment(newFrames.size() - 1);
+    }
 
-        _gpuContext->processProgramsToSync();
+    _gpuContext->processProgramsToSync();
 
-        while (!_newFrameQueue.empty()) {
-            _currentFrame = _newFrameQueue.front();
-            _newFrameQueue.pop();
-            _gpuContext->consumeFrameUpdates(_currentFrame);
-        }
+    if (newFrames.empty()) {
+        return;
+    }
+    auto newFrame = newFrames.back();
+    while (!newFrames.empty()) {
+        _gpuContext->consumeFrameUpdates(newFrames.front());
+        newFrames.pop();
+    }
+    withPresentThreadLock([&] {
+        _currentFrame = newFrame;
     });
 }
 
@@ -646,12 +659,16 @@ void OpenGLDisplayPlugin::compositeScene() {
         batch.setStateScissorRect(ivec4(uvec2(), _compositeFramebuffer->getSize()));
         batch.resetViewTransform();
         batch.setProjectionTransform(mat4());
-        batch.setResourceTexture(0, _currentFrame->framebuffer->getRenderBuffer(0));
+        batch.setResourceTexture(0, getCompositeSceneTexture());
         setupCompositeScenePipeline(batch);
         batch.draw(gpu::TRIANGLE_STRIP, 4);
     });
 }
 
+gpu::TexturePointer OpenGLDisplayPlugin::getCompositeSceneTexture() {
+    return _currentFrame->framebuffer->getRenderBuffer(0);
+}
+
 void OpenGLDisplayPlugin::compositeLayers() {
     updateCompositeFramebuffer();
 
@@ -699,17 +716,24 @@ void OpenGLDisplayPlugin::present(const std::shared_ptr<RefreshRateController>&
     incrementPresentCount();
 
     if (_currentFrame) {
-        auto correction = getViewCorrection();
-        getGLBackend()->setCameraCorrection(correction, _prevRenderView);
-        _prevRenderView = correction * _currentFrame->view;
-        {
-            withPresentThreadLock([&] {
-                _renderRate.increment();
-                if (_currentFrame.get() != _lastFrame) {
-                    _newFrameRate.increment();
-                }
-                _lastFrame = _currentFrame.get();
-            });
+        bool isNewFrame = false;
+        withPresentThreadLock([&] {
+            _renderRate.increment();
+            isNewFrame = _currentFrame.get() != _lastFrame;
+            if (isNewFrame) {
+                _newFrameRate.increment();
+            }
+            _lastFrame = _currentFrame.get();
+        });
+
+        // A frame the render thread didn't replace in time is warped during the composite rather than executed
+        // again, the framebuffer still holds its output
+        _reprojectFrame = !isNewFrame && reprojectsRepeatedFrames();
+        if (!_reprojectFrame) {
+            auto correction = getViewCorrection();
+            getGLBackend()->setCameraCorrection(correction, _prevRenderView);
+            _prevRenderView = correction * _currentFrame->view;
+
             // Execute the frame rendering commands
             PROFILE_RANGE_EX(render, "execute", 0xff00ff00, frameId)
             _gpuContext->executeFrame(_currentFrame);
@@ -741,6 +765,19 @@ void OpenGLDisplayPlugin::present(const std::shared_ptr<RefreshRateController>&
             internalPresent();
         }
 
+        if (isNewFrame) {
+            uint64_t presentTime = usecTimestampNow();
+            withPresentThreadLock([&] {
+                if (_currentFrame->simulationTime != 0) {
+                    _frameLatencies.record(presentTime - _currentFrame->simulationTime);
+                }
+                if (_lastNewFramePresentTime != 0) {
+                    _framePresentIntervals.record(presentTime - _lastNewFramePresentTime);
+                }
+                _lastNewFramePresentTime = presentTime;
+            });
+        }
+
         gpu::Backend::freeGPUMemSize.set(gpu::gl::getFreeDedicatedMemory());
     } else if (alwaysPresent()) {
         refreshRateController->clockEndTime();
@@ -779,6 +816,21 @@ float OpenGLDisplayPlugin::renderRate() const {
     return _renderRate.rate();
 }
 
+bool OpenGLDisplayPlugin::getFramePacing(LatencyHistogram& latencies, LatencyHistogram& intervals) const {
+    withNonPresentThreadLock([&] {
+        latencies = _frameLatencies;
+        intervals = _framePresentIntervals;
+    });
+    return true;
+}
+
+void OpenGLDisplayPlugin::resetFramePacing() {
+    withNonPresentThreadLock([&] {
+        _frameLatencies.reset();
+        _framePresentIntervals.reset();
+    });
+}
+
 void OpenGLDisplayPlugin::swapBuffers() {
     static auto context = _container->getPrimaryWidget()->context();
     context->swapBuffers();
@@ -72,6 +72,9 @@ public:
 
     float renderRate() const override;
 
+    bool getFramePacing(LatencyHistogram& latencies, LatencyHistogram& intervals) const override;
+    void resetFramePacing() override;
+
     bool beginFrameRender(uint32_t frameIndex) override;
 
     virtual bool wantVsync() const { return true; }
@@ -96,6 +99,9 @@ protected:
     // Such plugins must be prepared to do the right thing if the `_currentFrame`
     // is not populated
     virtual bool alwaysPresent() const { return false; }
+    // The plugins that warp the last rendered frame to the latest pose when the render thread misses a frame,
+    // rather than executing the frame again
+    virtual bool reprojectsRepeatedFrames() const { return false; }
 
     void updateCompositeFramebuffer();
 
@@ -103,6 +109,7 @@ protected:
     virtual void compositeLayers();
     virtual void setupCompositeScenePipeline(gpu::Batch& batch);
     virtual void compositeScene();
+    virtual gpu::TexturePointer getCompositeSceneTexture();
     virtual void compositePointer();
     virtual void compositeExtra(){};
 
@@ -150,6 +157,12 @@ protected:
 
     gpu::FramePointer _currentFrame;
     gpu::Frame* _lastFrame{ nullptr };
+    // the current frame wasn't executed again for this present, its output is reprojected
+    bool _reprojectFrame { false };
+    // Guarded by _presentMutex
+    LatencyHistogram _frameLatencies;
+    LatencyHistogram _framePresentIntervals;
+    uint64_t _lastNewFramePresentTime{ 0 };
     mat4 _prevRenderView;
     gpu::FramebufferPointer _compositeFramebuffer;
     gpu::PipelinePointer _hudPipeline;
@@ -128,6 +128,15 @@ void HmdDisplayPlugin::customizeContext() {
     _visionSqueezeParametersBuffer =
         gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(VisionSqueezeParameters), (const gpu::Byte*) &parameters));
 
+    ReprojectionParameters reprojectionParameters;
+    _reprojectionParametersBuffer =
+        gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(ReprojectionParameters), (const gpu::Byte*) &reprojectionParameters));
+    {
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+        state->setDepthTest(gpu::State::DepthTest(false));
+        _reprojectionPipeline = gpu::Pipeline::create(gpu::Shader::createProgram(shader::display_plugins::program::DrawReprojectedTexture), state);
+    }
+
     Parent::customizeContext();
     _hudRenderer.build();
 }
@@ -144,6 +153,8 @@ void HmdDisplayPlugin::uncustomizeContext() {
     });
     _hudRenderer = HUDRenderer();
     _previewTexture.reset();
+    _reprojectionPipeline.reset();
+    _reprojectionFramebuffer.reset();
     Parent::uncustomizeContext();
 }
 
@@ -533,6 +544,51 @@ void HmdDisplayPlugin::updateVisionSqueezeParameters(float visionSqueezeX, float
     }
 }
 
+void HmdDisplayPlugin::compositeScene() {
+    if (!_reprojectFrame) {
+        _executedPresentPose = _currentPresentFrameInfo.presentPose;
+        Parent::compositeScene();
+        return;
+    }
+
+    auto sceneTexture = _currentFrame->framebuffer->getRenderBuffer(0);
+    if (!_reprojectionFramebuffer || _reprojectionFramebuffer->getSize() != _currentFrame->framebuffer->getSize()) {
+        _reprojectionFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("HmdDisplayPlugin::reprojection",
+            sceneTexture->getTexelFormat(), sceneTexture->getWidth(), sceneTexture->getHeight()));
+    }
+
+    // A rotation only warp: the translations of the head and the eyes are dropped, along with the parallax they'd bring
+    mat4 executedOrientation = mat4(mat3(_executedPresentPose));
+    mat4 presentOrientation = mat4(mat3(_currentPresentFrameInfo.presentPose));
+    auto& parameters = _reprojectionParametersBuffer.edit<ReprojectionParameters>();
+    for_each_eye([&](Eye eye) {
+        mat4 eyeToHead = mat4(mat3(getEyeToHeadTransform(eye)));
+        parameters._reprojections[eye] = _eyeProjections[eye] * glm::inverse(executedOrientation * eyeToHead) *
+            presentOrientation * eyeToHead * _eyeInverseProjections[eye];
+    });
+
+    render([&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+        batch.setFramebuffer(_reprojectionFramebuffer);
+        batch.setViewportTransform(ivec4(uvec2(), _reprojectionFramebuffer->getSize()));
+        batch.resetViewTransform();
+        batch.setProjectionTransform(mat4());
+        batch.setPipeline(_reprojectionPipeline);
+        batch.setUniformBuffer(drawReprojectedTextureParamsSlot, _reprojectionParametersBuffer);
+        batch.setResourceTexture(0, sceneTexture);
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+    });
+
+    Parent::compositeScene();
+}
+
+gpu::TexturePointer HmdDisplayPlugin::getCompositeSceneTexture() {
+    if (_reprojectFrame && _reprojectionFramebuffer) {
+        return _reprojectionFramebuffer->getRenderBuffer(0);
+    }
+    return Parent::getCompositeSceneTexture();
+}
+
 void HmdDisplayPlugin::setupCompositeScenePipeline(gpu::Batch& batch) {
     batch.setPipeline(_drawTextureSqueezePipeline);
     _visionSqueezeParametersBuffer.edit<VisionSqueezeParameters>()._hmdSensorMatrix = _currentPresentFrameInfo.presentPose;
@@ -72,6 +72,9 @@ protected:
     void internalDeactivate() override;
     void compositePointer() override;
     void internalPresent() override;
+    bool reprojectsRepeatedFrames() const override { return !hasAsyncReprojection(); }
+    void compositeScene() override;
+    gpu::TexturePointer getCompositeSceneTexture() override;
     void customizeContext() override;
     void uncustomizeContext() override;
     void updateFrameData() override;
@@ -118,6 +121,15 @@ protected:
     typedef gpu::BufferView UniformBufferView;
     gpu::BufferView _visionSqueezeParametersBuffer;
 
+    struct ReprojectionParameters {
+        mat4 _reprojections[2];
+    };
+    gpu::BufferView _reprojectionParametersBuffer;
+    gpu::PipelinePointer _reprojectionPipeline;
+    gpu::FramebufferPointer _reprojectionFramebuffer;
+    // the head pose the frame framebuffer was last rendered for
+    mat4 _executedPresentPose;
+
     virtual void setupCompositeScenePipeline(gpu::Batch& batch) override;
 
     float _visionSqueezeDeviceLowX { 0.0f };
@@ -162,3 +174,4 @@ private:
 };
 
 const int drawTextureWithVisionSqueezeParamsSlot = 1; // must match binding in DrawTextureWithVisionSqueeze.slf
+const int drawReprojectedTextureParamsSlot = 1; // must match binding in DrawReprojectedTexture.slf
@@ -16,6 +16,7 @@
 #include <QBuffer>
 #include <QCryptographicHash>
 #include <QTcpSocket>
+#include <QThread>
 #include <QUrlQuery>
 
 #include "EmbeddedWebserverLogging.h"
@@ -32,6 +33,15 @@ const char* HTTPConnection::StatusCode404 = "404 Not Found";
 const char* HTTPConnection::StatusCode500 = "500 Internal server error";
 const char* HTTPConnection::DefaultContentType = "text/plain; charset=ISO-8859-1";
 
+// Storing big requests in memory gets expensive, especially on servers
+// with limited memory. So we store big requests in a temporary file on disk
+// and map it to faster read/write access.
+static const qint64 MAX_CONTENT_SIZE_IN_MEMORY = 10 * 1000 * 1000;
+
+// the response is read in chunks of this size, as long as the socket has less than the high water mark left to write
+static const qint64 HTTP_RESPONSE_CHUNK_SIZE = 256 * 1024;
+static const qint64 HTTP_RESPONSE_HIGH_WATER_MARK = 1024 * 1024;
+
 
 class MemoryStorage : public HTTPConnection::Storage {
 public:
@@ -63,6 +73,8 @@ void MemoryStorage::write(const QByteArray& data) {
 class FileStorage : public HTTPConnection::Storage {
 public:
     static std::unique_ptr<FileStorage> make(qint64 size);
+    // maps content that has already been written to the file
+    static std::unique_ptr<FileStorage> make(std::unique_ptr<QTemporaryFile> file);
     virtual ~FileStorage();
 
     const QByteArray& content() const override { return _wrapperArray; };
@@ -91,6 +103,16 @@ std::unique_ptr<FileStorage> FileStorage::make(qint64 size) {
     return std::unique_ptr<FileStorage>(new FileStorage(std::move(file), mapped, size));
 }
 
+std::unique_ptr<FileStorage> FileStorage::make(std::unique_ptr<QTemporaryFile> file) {
+    auto size = file->size();
+    auto mapped = file->map(0, size);
+
+    // the content is all there, nothing is left to write
+    auto storage = std::unique_ptr<FileStorage>(new FileStorage(std::move(file), mapped, size));
+    storage->_bytesWritten = size;
+    return storage;
+}
+
 // Use QByteArray::fromRawData to avoid a new allocation and access the already existing
 // memory directly as long as all operations on the array are const.
 FileStorage::FileStorage(std::unique_ptr<QTemporaryFile> file, uchar* mapped, qint64 size) :
@@ -115,7 +137,6 @@ void FileStorage::write(const QByteArray& data) {
 
 
 HTTPConnection::HTTPConnection(QTcpSocket* socket, HTTPManager* parentManager) :
-    QObject(parentManager),
     _parentManager(parentManager),
     _socket(socket),
     _address(socket->peerAddress())
@@ -125,8 +146,8 @@ HTTPConnection::HTTPConnection(QTcpSocket* socket, HTTPManager* parentManager) :
 
     // connect initial slots
     connect(socket, SIGNAL(readyRead()), SLOT(readRequest()));
-    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(deleteLater()));
-    connect(socket, SIGNAL(disconnected()), SLOT(deleteLater()));
+    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(socketClosed()));
+    connect(socket, SIGNAL(disconnected()), SLOT(socketClosed()));
 }
 
 HTTPConnection::~HTTPConnection() {
@@ -217,7 +238,46 @@ QList<FormData> HTTPConnection::parseFormData() const {
     return data;
 }
 
+void HTTPConnection::socketClosed() {
+    // the handler still has the connection, it's deleted once it has been responded to
+    if (!_isHandlingRequest) {
+        deleteLater();
+    }
+}
+
+void HTTPConnection::dispatchRequest(const QUrl& url) {
+    _isHandlingRequest = true;
+
+    QMetaObject::invokeMethod(_parentManager, [this, url] {
+        _parentManager->handleHTTPRequest(this, url);
+    });
+}
+
+bool HTTPConnection::finishRespondingIfClosed() {
+    _isHandlingRequest = false;
+
+    if (_socket->state() == QAbstractSocket::UnconnectedState) {
+        deleteLater();
+        return true;
+    }
+    return false;
+}
+
 void HTTPConnection::respond(const char* code, const QByteArray& content, const char* contentType, const Headers& headers) {
+    if (QThread::currentThread() != thread()) {
+        // the code and content type can be temporaries, so take copies for the connection's thread
+        QByteArray codeCopy { code };
+        QByteArray contentTypeCopy { contentType };
+        QMetaObject::invokeMethod(this, [this, codeCopy, content, contentTypeCopy, headers] {
+            respond(codeCopy.constData(), content, contentTypeCopy.constData(), headers);
+        });
+        return;
+    }
+
+    if (finishRespondingIfClosed()) {
+        return;
+    }
+
     respondWithStatusAndHeaders(code, contentType, headers, content.size());
 
     _socket->write(content);
@@ -229,6 +289,24 @@ void HTTPConnection::respond(const char* code, const QByteArray& content, const
 }
 
 void HTTPConnection::respond(const char* code, std::unique_ptr<QIODevice> device, const char* contentType, const Headers& headers) {
+    if (QThread::currentThread() != thread()) {
+        QByteArray codeCopy { code };
+        QByteArray contentTypeCopy { contentType };
+        // the device is read on the connection's thread from now on
+        if (!device->parent()) {
+            device->moveToThread(thread());
+        }
+        QIODevice* rawDevice = device.release();
+        QMetaObject::invokeMethod(this, [this, codeCopy, rawDevice, contentTypeCopy, headers] {
+            respond(codeCopy.constData(), std::unique_ptr<QIODevice>(rawDevice), contentTypeCopy.constData(), headers);
+        });
+        return;
+    }
+
+    if (finishRespondingIfClosed()) {
+        return;
+    }
+
     _responseDevice = std::move(device);
 
     if (_responseDevice->isSequential()) {
@@ -239,29 +317,38 @@ void HTTPConnection::respond(const char* code, std::unique_ptr<QIODevice> device
         return;
     }
 
-    int totalToBeWritten = _responseDevice->size();
-    respondWithStatusAndHeaders(code, contentType, headers, totalToBeWritten);
+    respondWithStatusAndHeaders(code, contentType, headers, _responseDevice->size());
 
     if (_responseDevice->atEnd()) {
         _socket->disconnectFromHost();
     } else {
-        connect(_socket, &QTcpSocket::bytesWritten, this, [this, totalToBeWritten](size_t bytes) mutable {
-            constexpr size_t HTTP_RESPONSE_CHUNK_SIZE = 1024 * 10;
-            if (!_responseDevice->atEnd()) {
-                totalToBeWritten -= _socket->write(_responseDevice->read(HTTP_RESPONSE_CHUNK_SIZE));
-                if (_responseDevice->atEnd()) {
-                    _socket->disconnectFromHost();
-                    disconnect(_socket, &QTcpSocket::bytesWritten, this, nullptr);
-                }
-            }
-        });
-
+        connect(_socket, &QTcpSocket::bytesWritten, this, &HTTPConnection::writeResponseContent);
+        writeResponseContent();
     }
 
     // make sure we receive no further read notifications
     disconnect(_socket, &QTcpSocket::readyRead, this, nullptr);
 }
 
+void HTTPConnection::writeResponseContent() {
+    // keep enough queued that the socket never runs dry between notifications, without reading the whole device in
+    while (!_responseDevice->atEnd() && _socket->bytesToWrite() < HTTP_RESPONSE_HIGH_WATER_MARK) {
+        QByteArray chunk = _responseDevice->read(HTTP_RESPONSE_CHUNK_SIZE);
+        if (chunk.isEmpty()) {
+            qCWarning(embeddedwebserver) << "Error reading HTTP response content:" << _responseDevice->errorString();
+            disconnect(_socket, &QTcpSocket::bytesWritten, this, nullptr);
+            _socket->abort();
+            return;
+        }
+        _socket->write(chunk);
+    }
+
+    if (_responseDevice->atEnd()) {
+        disconnect(_socket, &QTcpSocket::bytesWritten, this, nullptr);
+        _socket->disconnectFromHost();
+    }
+}
+
 void HTTPConnection::respondWithStatusAndHeaders(const char* code, const char* contentType, const Headers& headers, qint64 contentLength) {
     _socket->write("HTTP/1.1 ");
 
@@ -337,22 +424,33 @@ void HTTPConnection::readHeaders() {
             _socket->disconnect(this, SLOT(readHeaders()));
 
             QByteArray clength = requestHeader("Content-Length");
-            if (clength.isEmpty()) {
-                _parentManager->handleHTTPRequest(this, _requestUrl);
+            if (requestHeader("Transfer-Encoding").toLower().contains("chunked")) {
+                // the size isn't known up front, so the content goes to disk until we have it all
+                _chunkedContent.reset(new QTemporaryFile());
+                if (!_chunkedContent->open()) {
+                    qCWarning(embeddedwebserver) << "Could not open a file for chunked content:"
+                        << _chunkedContent->errorString();
+                    respond(StatusCode500);
+                    return;
+                }
+
+                connect(_socket, SIGNAL(readyRead()), SLOT(readChunkedContent()));
+
+                // read any content immediately available
+                readChunkedContent();
+
+            } else if (clength.isEmpty()) {
+                dispatchRequest(_requestUrl);
 
             } else {
                 bool success = false;
-                auto length = clength.toInt(&success);
-                if (!success) {
+                auto length = clength.toLongLong(&success);
+                if (!success || length < 0) {
                     qWarning() << "Invalid header." << _address << trimmed;
                     respond("400 Bad Request", "The header was malformed.");
                     return;
                 }
 
-                // Storing big requests in memory gets expensive, especially on servers
-                // with limited memory. So we store big requests in a temporary file on disk
-                // and map it to faster read/write access.
-                static const int MAX_CONTENT_SIZE_IN_MEMORY = 10 * 1000 * 1000;
                 if (length < MAX_CONTENT_SIZE_IN_MEMORY) {
                     _requestContent = MemoryStorage::make(length);
                 } else {
@@ -394,6 +492,70 @@ void HTTPConnection::readContent() {
     if (_requestContent->bytesLeftToWrite() == 0) {
         _socket->disconnect(this, SLOT(readContent()));
 
-        _parentManager->handleHTTPRequest(this, _requestUrl.path());
+        dispatchRequest(_requestUrl.path());
+    }
+}
+
+void HTTPConnection::readChunkedContent() {
+    while (_chunkedContent) {
+        if (_chunkState == ChunkState::Data) {
+            auto size = std::min(_socket->bytesAvailable(), _chunkBytesLeft);
+            if (size == 0) {
+                return;
+            }
+            if (_chunkedContent->write(_socket->read(size)) != size) {
+                qCWarning(embeddedwebserver) << "Could not write chunked content:" << _chunkedContent->errorString();
+                _chunkedContent.reset();
+                respond(StatusCode500);
+                return;
+            }
+            _chunkBytesLeft -= size;
+            if (_chunkBytesLeft == 0) {
+                _chunkState = ChunkState::DataEnd;
+            }
+            continue;
+        }
+
+        if (!_socket->canReadLine()) {
+            return;
+        }
+        QByteArray line = _socket->readLine().trimmed();
+
+        if (_chunkState == ChunkState::Size) {
+            // chunk extensions follow the size, we have no use for them
+            int extensionStart = line.indexOf(';');
+            bool success = false;
+            _chunkBytesLeft = line.left(extensionStart).trimmed().toLongLong(&success, 16);
+            if (!success || _chunkBytesLeft < 0) {
+                qWarning() << "Invalid chunk size." << _address << line;
+                _chunkedContent.reset();
+                respond("400 Bad Request", "The chunk size was malformed.");
+                return;
+            }
+            _chunkState = _chunkBytesLeft > 0 ? ChunkState::Data : ChunkState::Trailer;
+
+        } else if (_chunkState == ChunkState::DataEnd) {
+            _chunkState = ChunkState::Size;
+
+        } else if (line.isEmpty()) {
+            // that was the end of the trailer, and of the content
+            _socket->disconnect(this, SLOT(readChunkedContent()));
+
+            auto file = std::move(_chunkedContent);
+            auto length = file->size();
+            if (length < MAX_CONTENT_SIZE_IN_MEMORY) {
+                file->seek(0);
+                auto storage = MemoryStorage::make(length);
+                storage->write(file->readAll());
+                _requestContent = std::move(storage);
+            } else {
+                file->flush();
+                _requestContent = FileStorage::make(std::move(file));
+            }
+
+            dispatchRequest(_requestUrl.path());
+            return;
+        }
+        // trailer fields are dropped
     }
 }
@@ -40,6 +40,11 @@ typedef QHash<QByteArray, QByteArray> Headers;
 typedef QPair<Headers, QByteArray> FormData;
 
 /// Handles a single HTTP connection.
+///
+/// The connection lives on its manager's connection thread, where its socket is read and written. The request is handed
+/// to the manager's thread once it has been read in full, and can be responded to from there: the accessors only read what
+/// was parsed before the request was handed over, and the response is written on the connection's own thread. The
+/// connection isn't deleted between the request being handed over and its response, even if the peer goes away.
 class HTTPConnection : public QObject {
    Q_OBJECT
 
@@ -100,7 +105,7 @@ public:
     /// Duplicate keys are not supported.
     QHash<QString, QString> parseUrlEncodedForm();
 
-    /// Sends a response and closes the connection.
+    /// Sends a response and closes the connection. Can be called from any thread.
     void respond(const char* code, const QByteArray& content = QByteArray(),
         const char* contentType = DefaultContentType,
         const Headers& headers = Headers());
@@ -119,9 +124,24 @@ protected slots:
     /// Reads the content.
     void readContent();
 
+    /// Reads chunked content, which is spooled to disk as it comes in.
+    void readChunkedContent();
+
+    /// Deletes the connection unless its request is still being handled.
+    void socketClosed();
+
 protected:
     void respondWithStatusAndHeaders(const char* code, const char* contentType, const Headers& headers, qint64 size);
 
+    /// Hands the request over to the manager's thread.
+    void dispatchRequest(const QUrl& url);
+
+    /// Writes the response device out while the socket's buffer is below its high water mark.
+    void writeResponseContent();
+
+    /// Returns true if the response can't be written, and deletes the connection if that's because the socket is gone.
+    bool finishRespondingIfClosed();
+
     /// The parent HTTP manager
     HTTPManager* _parentManager;
 
@@ -146,6 +166,16 @@ protected:
     /// The content of the request.
     std::unique_ptr<Storage> _requestContent;
 
+    /// Where chunked content goes until the last chunk has been read.
+    std::unique_ptr<QTemporaryFile> _chunkedContent;
+
+    enum class ChunkState { Size, Data, DataEnd, Trailer };
+    ChunkState _chunkState { ChunkState::Size };
+    qint64 _chunkBytesLeft { 0 };
+
+    /// Whether the request has been handed over and is waiting for a response.
+    bool _isHandlingRequest { false };
+
     /// Response content
     std::unique_ptr<QIODevice> _responseDevice;
 };
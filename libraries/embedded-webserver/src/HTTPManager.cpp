@@ -16,6 +16,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QMimeDatabase>
+#include <QtCore/QThread>
 #include <QtNetwork/QTcpSocket>
 
 #include "HTTPConnection.h"
@@ -30,6 +31,14 @@ HTTPManager::HTTPManager(const QHostAddress& listenAddress, quint16 port, const
     _requestHandler(requestHandler),
     _port(port)
 {
+    _connectionThread = new QThread(this);
+    _connectionThread->setObjectName("HTTP Connections");
+    _connectionContext = new QObject();
+    _connectionContext->moveToThread(_connectionThread);
+    // the remaining connections go with the context once the thread is done
+    connect(_connectionThread, &QThread::finished, _connectionContext, &QObject::deleteLater);
+    _connectionThread->start();
+
     bindSocket();
     
     _isListeningTimer = new QTimer(this);
@@ -37,14 +46,28 @@ HTTPManager::HTTPManager(const QHostAddress& listenAddress, quint16 port, const
     _isListeningTimer->start(SOCKET_CHECK_INTERVAL_IN_MS);
 }
 
+HTTPManager::~HTTPManager() {
+    close();
+    _connectionThread->quit();
+    _connectionThread->wait();
+}
+
 void HTTPManager::incomingConnection(qintptr socketDescriptor) {
-    QTcpSocket* socket = new QTcpSocket(this);
-    
-    if (socket->setSocketDescriptor(socketDescriptor)) {
-        new HTTPConnection(socket, this);
-    } else {
-        delete socket;
-    }
+    // the socket is created on the connection thread so its notifications are delivered there
+    QMetaObject::invokeMethod(_connectionContext, [this, socketDescriptor] {
+        QTcpSocket* socket = new QTcpSocket();
+
+        if (socket->setSocketDescriptor(socketDescriptor)) {
+            addConnection(new HTTPConnection(socket, this));
+        } else {
+            delete socket;
+        }
+    });
+}
+
+void HTTPManager::addConnection(HTTPConnection* connection) {
+    Q_ASSERT(QThread::currentThread() == _connectionThread);
+    connection->setParent(_connectionContext);
 }
 
 bool HTTPManager::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
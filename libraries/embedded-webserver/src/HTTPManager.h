@@ -19,6 +19,7 @@
 #include <QtNetwork/QTcpServer>
 #include <QtCore/QTimer>
 
+class QThread;
 class HTTPConnection;
 class HTTPSConnection;
 
@@ -29,11 +30,16 @@ public:
 };
 
 /// Handles HTTP connections
+///
+/// The connections' sockets are read and written on a thread of the manager's own, so that a large upload or download
+/// doesn't hold up the thread the manager lives on. Requests are handled on the manager's thread once they have been
+/// read in full.
 class HTTPManager : public QTcpServer, public HTTPRequestHandler {
    Q_OBJECT
 public:
     /// Initializes the manager.
     HTTPManager(const QHostAddress& listenAddress, quint16 port, const QString& documentRoot, HTTPRequestHandler* requestHandler = nullptr);
+    virtual ~HTTPManager();
 
     bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
 
@@ -48,7 +54,14 @@ protected:
     /// Accepts all pending connections
     virtual void incomingConnection(qintptr socketDescriptor) override;
     virtual bool requestHandledByRequestHandler(HTTPConnection* connection, const QUrl& url);
-    
+
+    /// Takes ownership of a connection created on the connection thread
+    void addConnection(HTTPConnection* connection);
+
+    QThread* _connectionThread;
+    /// Lives on the connection thread, the connections are its children
+    QObject* _connectionContext;
+
     QHostAddress _listenAddress;
     QString _documentRoot;
     HTTPRequestHandler* _requestHandler;
@@ -26,17 +26,20 @@ HTTPSManager::HTTPSManager(QHostAddress listenAddress, quint16 port, const QSslC
 }
 
 void HTTPSManager::incomingConnection(qintptr socketDescriptor) {
-    QSslSocket* sslSocket = new QSslSocket(this);
-    
-    sslSocket->setLocalCertificate(_certificate);
-    sslSocket->setPrivateKey(_privateKey);
-    sslSocket->setPeerVerifyMode(QSslSocket::VerifyNone);
-    
-    if (sslSocket->setSocketDescriptor(socketDescriptor)) {
-        new HTTPSConnection(sslSocket, this);
-    } else {
-        delete sslSocket;
-    }
+    // copy the certificate and key here, they can be changed on this thread while the socket is set up on the other
+    QMetaObject::invokeMethod(_connectionContext, [this, socketDescriptor, certificate = _certificate, privateKey = _privateKey] {
+        QSslSocket* sslSocket = new QSslSocket();
+
+        sslSocket->setLocalCertificate(certificate);
+        sslSocket->setPrivateKey(privateKey);
+        sslSocket->setPeerVerifyMode(QSslSocket::VerifyNone);
+
+        if (sslSocket->setSocketDescriptor(socketDescriptor)) {
+            addConnection(new HTTPSConnection(sslSocket, this));
+        } else {
+            delete sslSocket;
+        }
+    });
 }
 
 bool HTTPSManager::handleHTTPRequest(HTTPConnection* connection, const QUrl &url, bool skipSubHandler) {
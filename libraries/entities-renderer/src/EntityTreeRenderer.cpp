@@ -12,6 +12,7 @@
 #include "EntityTreeRenderer.h"
 
 #include <glm/gtx/quaternion.hpp>
+#include <algorithm>
 #include <queue>
 
 #include <QEventLoop>
@@ -30,6 +31,7 @@
 #include <Rig.h>
 #include <SceneScriptingInterface.h>
 #include <ScriptEngines.h>
+#include <TBBHelpers.h>
 #include <EntitySimulation.h>
 #include <ZoneRenderer.h>
 #include <PhysicalEntitySimulation.h>
@@ -264,7 +266,7 @@ void EntityTreeRenderer::clearDomainAndNonOwnedEntities() {
     }
 
     std::unordered_map<EntityItemID, EntityRendererPointer> savedEntities;
-    std::unordered_set<EntityRendererPointer> savedRenderables;
+    std::vector<EntityRendererPointer> savedRenderables;
     // remove all entities from the scene
     auto scene = _viewState->getMain3DScene();
     if (scene) {
@@ -275,12 +277,18 @@ void EntityTreeRenderer::clearDomainAndNonOwnedEntities() {
                 fadeOutRenderable(renderer);
             } else {
                 savedEntities[entry.first] = entry.second;
-                savedRenderables.insert(entry.second);
+                savedRenderables.push_back(entry.second);
             }
         }
     }
 
-    _renderablesToUpdate = savedRenderables;
+    for (const auto& renderable : _renderablesToUpdate) {
+        renderable->setQueuedForUpdate(false);
+    }
+    _renderablesToUpdate.clear();
+    for (const auto& renderable : savedRenderables) {
+        queueRenderableUpdate(renderable);
+    }
     _entitiesInScene = savedEntities;
 
     if (_layeredZones.clearDomainAndNonOwnedZones()) {
@@ -331,10 +339,15 @@ void EntityTreeRenderer::clear() {
         }
     }
     _entitiesInScene.clear();
+    for (const auto& renderable : _renderablesToUpdate) {
+        renderable->setQueuedForUpdate(false);
+    }
     _renderablesToUpdate.clear();
 
     // reset the zone to the default (while we load the next scene)
     _layeredZones.clear();
+    _zoneCandidates.clear();
+    _zoneCandidatesInvalid = true;
     if (!_shuttingDown) {
         applyLayeredZones();
     }
@@ -443,6 +456,37 @@ void EntityTreeRenderer::addPendingEntities(const render::ScenePointer& scene, r
     }
 }
 
+// fewer renderables than this are prepared on the main thread
+const size_t MIN_PARALLEL_PREPARE_RENDERABLES = 32;
+const size_t PARALLEL_PREPARE_RENDERABLES_GRAIN = 16;
+// the renderables are prepared in batches when they are updated within the time budget,
+// so that few are prepared for nothing when it runs out
+const size_t PREPARE_RENDERABLES_BATCH = 128;
+
+void EntityTreeRenderer::queueRenderableUpdate(const EntityRendererPointer& renderable) {
+    if (!renderable->isQueuedForUpdate()) {
+        renderable->setQueuedForUpdate(true);
+        _renderablesToUpdate.push_back(renderable);
+    }
+}
+
+// The preparation only touches each renderer and reads its entity, unlike updateInScene which fills the transaction
+// and can use the resource caches and the Qt objects of the renderers, so only the preparation runs on the TBB workers.
+void EntityTreeRenderer::prepareRenderableUpdates(size_t begin, size_t end) {
+    PROFILE_RANGE_EX(simulation_physics, "PrepareRenderables", 0xffff00ff, (uint64_t)(end - begin));
+    if (end - begin < MIN_PARALLEL_PREPARE_RENDERABLES) {
+        for (size_t i = begin; i < end; ++i) {
+            _renderablesToUpdate[i]->prepareUpdateInScene();
+        }
+        return;
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(begin, end, PARALLEL_PREPARE_RENDERABLES_GRAIN), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            _renderablesToUpdate[i]->prepareUpdateInScene();
+        }
+    });
+}
+
 void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene, render::Transaction& transaction) {
     PROFILE_RANGE_EX(simulation_physics, "ChangeInScene", 0xffff00ff, (uint64_t)_changedEntities.size());
     PerformanceTimer pt("change");
@@ -453,11 +497,14 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
 
     {
         PROFILE_RANGE_EX(simulation_physics, "CopyRenderables", 0xffff00ff, (uint64_t)changedEntities.size());
+        // drop the renderables of the entities deleted since they were queued
+        _renderablesToUpdate.erase(std::remove_if(_renderablesToUpdate.begin(), _renderablesToUpdate.end(),
+            [](const EntityRendererPointer& renderable) { return !renderable->isQueuedForUpdate(); }), _renderablesToUpdate.end());
         for (const auto& entityId : changedEntities) {
             auto renderable = renderableForEntityId(entityId);
             if (renderable) {
                 // only add valid renderables _renderablesToUpdate
-                _renderablesToUpdate.insert(renderable);
+                queueRenderableUpdate(renderable);
             }
         }
     }
@@ -468,9 +515,11 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         // we expect to update all renderables within available time budget
         PROFILE_RANGE_EX(simulation_physics, "UpdateRenderables", 0xffff00ff, (uint64_t)_renderablesToUpdate.size());
         uint64_t updateStart = usecTimestampNow();
+        prepareRenderableUpdates(0, _renderablesToUpdate.size());
         for (const auto& renderable : _renderablesToUpdate) {
             assert(renderable); // only valid renderables are added to _renderablesToUpdate
             renderable->updateInScene(scene, transaction);
+            renderable->setQueuedForUpdate(false);
         }
         _prevNumEntityUpdates = _renderablesToUpdate.size();
         size_t numRenderables = _prevNumEntityUpdates + 1; // add one to avoid divide by zero
@@ -501,7 +550,10 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         uint64_t sortStart = usecTimestampNow();
 
         const auto& views = _viewState->getConicalViews();
-        PrioritySortUtil::PriorityQueue<SortableRenderer> sortedRenderables(views);
+        // kept from one frame to the next, so that its storage is reused
+        static PrioritySortUtil::PriorityQueue<SortableRenderer> sortedRenderables(views);
+        sortedRenderables.setViews(views);
+        sortedRenderables.clear();
         sortedRenderables.reserve(_renderablesToUpdate.size());
         {
             PROFILE_RANGE_EX(simulation_physics, "BuildSortedRenderables", 0xffff00ff, (uint64_t)_renderablesToUpdate.size());
@@ -513,8 +565,16 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         {
             PROFILE_RANGE_EX(simulation_physics, "SortAndUpdateRenderables", 0xffff00ff, sortedRenderables.size());
 
-            // compute remaining time budget
+            // keep the renderables in priority order, the ones left over are the first ones updated next time
             const auto& sortedRenderablesVector = sortedRenderables.getSortedVector();
+            size_t numRenderables = sortedRenderablesVector.size();
+            for (size_t i = 0; i < numRenderables; ++i) {
+                _renderablesToUpdate[i] = sortedRenderablesVector[i].getRenderer();
+            }
+            // don't keep the renderers alive until the next frame
+            sortedRenderables.clear();
+
+            // compute remaining time budget
             uint64_t updateStart = usecTimestampNow();
             uint64_t sortCost = updateStart - sortStart;
             uint64_t timeBudget = MIN_SORTED_UPDATE_RENDERABLES_TIME_BUDGET;
@@ -523,20 +583,28 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
             }
             uint64_t expiry = updateStart + timeBudget;
 
-            // process the sorted renderables
-            for (const auto& sortedRenderable : sortedRenderablesVector) {
-                if (usecTimestampNow() > expiry) {
-                    break;
+            // process the sorted renderables, a batch at a time
+            size_t numUpdated = 0;
+            bool outOfTime = false;
+            while (numUpdated < numRenderables && !outOfTime) {
+                size_t batchEnd = std::min(numUpdated + PREPARE_RENDERABLES_BATCH, numRenderables);
+                prepareRenderableUpdates(numUpdated, batchEnd);
+                while (numUpdated < batchEnd) {
+                    if (usecTimestampNow() > expiry) {
+                        outOfTime = true;
+                        break;
+                    }
+                    const auto& renderable = _renderablesToUpdate[numUpdated];
+                    renderable->updateInScene(scene, transaction);
+                    renderable->setQueuedForUpdate(false);
+                    ++numUpdated;
                 }
-                const auto& renderable = sortedRenderable.getRenderer();
-                renderable->updateInScene(scene, transaction);
-                _renderablesToUpdate.erase(renderable);
             }
+            _renderablesToUpdate.erase(_renderablesToUpdate.begin(), _renderablesToUpdate.begin() + numUpdated);
 
             // compute average per-renderable update cost
-            _prevNumEntityUpdates = sortedRenderables.size() - _renderablesToUpdate.size();
-            size_t numUpdated = _prevNumEntityUpdates + 1; // add one to avoid divide by zero
-            float cost = (float)(usecTimestampNow() - updateStart) / (float)(numUpdated);
+            _prevNumEntityUpdates = numUpdated;
+            float cost = (float)(usecTimestampNow() - updateStart) / (float)(numUpdated + 1); // add one to avoid divide by zero
             const float BLEND = 0.1f;
             _avgRenderableUpdateCost = (1.0f - BLEND) * _avgRenderableUpdateCost + BLEND * cost;
         }
@@ -569,6 +637,7 @@ void EntityTreeRenderer::update(bool simulate) {
                 render::Transaction transaction;
                 addPendingEntities(scene, transaction);
 
+                Model::startFinalizingModels();
                 updateChangedEntities(scene, transaction);
                 scene->enqueueTransaction(transaction);
             }
@@ -613,24 +682,28 @@ void EntityTreeRenderer::handleSpaceUpdate(std::pair<int32_t, glm::vec4> proxyUp
 }
 
 void EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QSet<EntityItemID>& entitiesContainingAvatar) {
-    float radius = 0.01f; // for now, assume 0.01 meter radius, because we actually check the point inside later
-    QVector<QUuid> entityIDs;
-
-    // find the entities near us
     // don't let someone else change our tree while we search
     _tree->withReadLock([&] {
         auto entityTree = std::static_pointer_cast<EntityTree>(_tree);
 
-        // FIXME - if EntityTree had a findEntitiesContainingPoint() this could theoretically be a little faster
-        entityTree->evalEntitiesInSphere(_avatarPosition, radius, PickFilter(), entityIDs);
+        // an entity containing the avatar's position touches the candidates' sphere as long as the avatar is within
+        // half of its radius
+        auto now = usecTimestampNow();
+        if (_zoneCandidatesInvalid || (now - _lastZoneCandidatesSearch) > ZONE_CANDIDATES_INTERVAL ||
+            glm::distance(_avatarPosition, _zoneCandidatesCenter) > 0.5f * ZONE_CANDIDATES_RADIUS) {
+            entityTree->evalZonesAndScriptedEntitiesInSphere(_avatarPosition, ZONE_CANDIDATES_RADIUS, _zoneCandidates);
+            _zoneCandidatesCenter = _avatarPosition;
+            _lastZoneCandidatesSearch = now;
+            _zoneCandidatesInvalid = false;
+        }
 
         LayeredZones oldLayeredZones(_layeredZones);
         _layeredZones.clear();
 
         // create a list of entities that actually contain the avatar's position
-        for (auto& entityID : entityIDs) {
-            auto entity = entityTree->findEntityByID(entityID);
-            if (!entity) {
+        for (auto& entity : _zoneCandidates) {
+            if (!entity->getElement()) {
+                // deleted since the search
                 continue;
             }
 
@@ -767,6 +840,7 @@ void EntityTreeRenderer::leaveAllEntities() {
 
 void EntityTreeRenderer::forceRecheckEntities() {
     _forceRecheckEntities = true;
+    _zoneCandidatesInvalid = true;
 }
 
 bool EntityTreeRenderer::applyLayeredZones() {
@@ -1068,7 +1142,10 @@ void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
     }
 
     auto renderable = itr->second;
-    _renderablesToUpdate.erase(renderable);
+    if (renderable) {
+        // dropped from _renderablesToUpdate on its next update
+        renderable->setQueuedForUpdate(false);
+    }
     _entitiesInScene.erase(itr);
 
     if (!renderable) {
@@ -170,6 +170,8 @@ protected:
 private:
     void addPendingEntities(const render::ScenePointer& scene, render::Transaction& transaction);
     void updateChangedEntities(const render::ScenePointer& scene, render::Transaction& transaction);
+    void queueRenderableUpdate(const EntityRendererPointer& renderable);
+    void prepareRenderableUpdates(size_t begin, size_t end);
     EntityRendererPointer renderableForEntity(const EntityItemPointer& entity) const { return renderableForEntityId(entity->getID()); }
     render::ItemID renderableIdForEntity(const EntityItemPointer& entity) const { return renderableIdForEntityId(entity->getID()); }
 
@@ -249,6 +251,16 @@ private:
     const uint64_t ZONE_CHECK_INTERVAL = USECS_PER_MSEC * 100; // ~10hz
     const float ZONE_CHECK_DISTANCE = 0.001f;
 
+    // The zones and scripted entities within ZONE_CANDIDATES_RADIUS are kept as the candidates of the enter/leave checks,
+    // and only searched for again when the avatar has moved half of that radius, after ZONE_CANDIDATES_INTERVAL for the
+    // entities moving towards it, or when the entities or their scripts change.
+    QVector<EntityItemPointer> _zoneCandidates;
+    glm::vec3 _zoneCandidatesCenter { 0.0f };
+    uint64_t _lastZoneCandidatesSearch { 0 };
+    bool _zoneCandidatesInvalid { true };
+    const float ZONE_CANDIDATES_RADIUS = 10.0f;
+    const uint64_t ZONE_CANDIDATES_INTERVAL = USECS_PER_MSEC * 500;
+
     float _avgRenderableUpdateCost { 0.0f };
 
     ReadWriteLockable _changedEntitiesGuard;
@@ -256,7 +268,7 @@ private:
     size_t _prevNumEntityUpdates { 0 };
     size_t _prevTotalNeededEntityUpdates { 0 };
 
-    std::unordered_set<EntityRendererPointer> _renderablesToUpdate;
+    std::vector<EntityRendererPointer> _renderablesToUpdate; // each renderable once, see EntityRenderer::isQueuedForUpdate
     std::unordered_map<EntityItemID, EntityRendererPointer> _entitiesInScene;
     std::unordered_map<EntityItemID, EntityItemWeakPointer> _entitiesToAdd;
 
@@ -325,6 +325,7 @@ bool EntityRenderer::addToScene(const ScenePointer& scene, Transaction& transact
     renderPayload->addStatusGetters(statusGetters);
     transaction.resetItem(_renderItemID, renderPayload);
     onAddToScene(_entity);
+    prepareUpdateInScene();
     updateInScene(scene, transaction);
     _entity->bumpAncestorChainRenderableVersion();
     return true;
@@ -337,6 +338,14 @@ void EntityRenderer::removeFromScene(const ScenePointer& scene, Transaction& tra
     _entity->bumpAncestorChainRenderableVersion();
 }
 
+void EntityRenderer::prepareUpdateInScene() {
+    DETAILED_PROFILE_RANGE(simulation_physics, __FUNCTION__);
+    if (!isValidRenderItem()) {
+        return;
+    }
+    doRenderUpdatePrepare(_entity);
+}
+
 void EntityRenderer::updateInScene(const ScenePointer& scene, Transaction& transaction) {
     DETAILED_PROFILE_RANGE(simulation_physics, __FUNCTION__);
     if (!isValidRenderItem()) {
@@ -424,6 +433,13 @@ void EntityRenderer::updateModelTransformAndBound(const EntityItemPointer& entit
     }
 }
 
+void EntityRenderer::doRenderUpdatePrepare(const EntityItemPointer& entity) {
+    // walking up the parents for the transform is most of the cost of an update in a large scene
+    withWriteLock([&] {
+        updateModelTransformAndBound(entity);
+    });
+}
+
 void EntityRenderer::doRenderUpdateSynchronous(const ScenePointer& scene, Transaction& transaction, const EntityItemPointer& entity) {
     DETAILED_PROFILE_RANGE(simulation_physics, __FUNCTION__);
     withWriteLock([&] {
@@ -438,8 +454,6 @@ void EntityRenderer::doRenderUpdateSynchronous(const ScenePointer& scene, Transa
 
         _prevIsTransparent = transparent;
 
-        updateModelTransformAndBound(entity);
-
         _moving = entity->isMovingRelativeToParent();
         _visible = entity->getVisible();
         entity->setNeedsRenderUpdate(false);
@@ -50,11 +50,17 @@ public:
     // Handlers for rendering events... executed on the main thread, only called by EntityTreeRenderer, 
     // cannot be overridden or accessed by subclasses
     virtual void updateInScene(const ScenePointer& scene, Transaction& transaction) final;
+    // Called before updateInScene, possibly on a worker thread and concurrently with other renderers
+    virtual void prepareUpdateInScene() final;
     virtual bool addToScene(const ScenePointer& scene, Transaction& transaction) final;
     virtual void removeFromScene(const ScenePointer& scene, Transaction& transaction);
 
     const uint64_t& getUpdateTime() const { return _updateTime; }
 
+    // Only used by EntityTreeRenderer on the main thread, to keep each renderable once in its updates
+    bool isQueuedForUpdate() const { return _isQueuedForUpdate; }
+    void setQueuedForUpdate(bool queued) { _isQueuedForUpdate = queued; }
+
     enum class Pipeline {
         SIMPLE,
         MATERIAL,
@@ -94,6 +100,11 @@ protected:
     // Returns true if the item in question needs to have updateInScene called because of changes in the entity
     virtual bool needsRenderUpdateFromEntity(const EntityItemPointer& entity) const;
 
+    // Will be called from prepareUpdateInScene, before updateInScene.  This can run on a worker thread at the same time
+    // as the other renderers, so it may only read the entity and update the renderer's own state: the scene, the 
+    // resource caches and the Qt objects can't be used here
+    virtual void doRenderUpdatePrepare(const EntityItemPointer& entity);
+
     // Will be called on the main thread from updateInScene.  This can be used to fetch things like 
     // network textures or model geometry from resource caches
     virtual void doRenderUpdateSynchronous(const ScenePointer& scene, Transaction& transaction, const EntityItemPointer& entity);
@@ -137,6 +148,7 @@ protected:
     ItemID _renderItemID{ Item::INVALID_ITEM_ID };
     uint64_t _fadeStartTime{ usecTimestampNow() };
     uint64_t _updateTime{ usecTimestampNow() }; // used when sorting/throttling render updates
+    bool _isQueuedForUpdate { false };
     bool _isFading { EntityTreeRenderer::getEntitiesShouldFadeFunction()() };
     bool _prevIsTransparent { false };
     bool _visible { false };
@@ -197,6 +209,11 @@ protected:
         return Parent::needsRenderUpdateFromEntity(entity) || needsRenderUpdateFromTypedEntity(_typedEntity);
     }
 
+    virtual void doRenderUpdatePrepare(const EntityItemPointer& entity) override final {
+        Parent::doRenderUpdatePrepare(entity);
+        doRenderUpdatePrepareTyped(_typedEntity);
+    }
+
     virtual void doRenderUpdateSynchronous(const ScenePointer& scene, Transaction& transaction, const EntityItemPointer& entity) override final {
         Parent::doRenderUpdateSynchronous(scene, transaction, entity);
         doRenderUpdateSynchronousTyped(scene, transaction, _typedEntity);
@@ -208,6 +225,7 @@ protected:
     }
 
     virtual bool needsRenderUpdateFromTypedEntity(const TypedEntityPointer& entity) const { return false; }
+    virtual void doRenderUpdatePrepareTyped(const TypedEntityPointer& entity) { }
     virtual void doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) { }
     virtual void doRenderUpdateAsynchronousTyped(const TypedEntityPointer& entity) { }
     virtual void onAddToSceneTyped(const TypedEntityPointer& entity) { }
@@ -271,7 +271,9 @@ void GizmoEntityRenderer::doRender(RenderArgs* args) {
         if (pipelineType == Pipeline::PROCEDURAL) {
             auto procedural = std::static_pointer_cast<graphics::ProceduralMaterial>(materials.top().material);
             transparent |= procedural->isFading();
-            procedural->prepare(batch, transform.getTranslation(), transform.getScale(), transform.getRotation(), _created, ProceduralProgramKey(transparent));
+            if (!procedural->prepare(batch, transform.getTranslation(), transform.getScale(), transform.getRotation(), _created, ProceduralProgramKey(transparent))) {
+                return;
+            }
         } else if (pipelineType == Pipeline::MATERIAL) {
             if (RenderPipelines::bindMaterials(materials, batch, args->_renderMode, args->_enableTexturing)) {
                 args->_details._materialSwitches++;
@@ -293,8 +293,10 @@ void MaterialEntityRenderer::doRender(RenderArgs* args) {
         auto proceduralDrawMaterial = std::static_pointer_cast<graphics::ProceduralMaterial>(drawMaterial);
         glm::vec4 outColor = glm::vec4(drawMaterial->getAlbedo(), drawMaterial->getOpacity());
         outColor = proceduralDrawMaterial->getColor(outColor);
-        proceduralDrawMaterial->prepare(batch, transform.getTranslation(), transform.getScale(),
-                                        transform.getRotation(), _created, ProceduralProgramKey(outColor.a < 1.0f));
+        if (!proceduralDrawMaterial->prepare(batch, transform.getTranslation(), transform.getScale(),
+                                             transform.getRotation(), _created, ProceduralProgramKey(outColor.a < 1.0f))) {
+            return;
+        }
         if (render::ShapeKey(args->_globalShapeKey).isWireframe() || _primitiveMode == PrimitiveMode::LINES) {
             DependencyManager::get<GeometryCache>()->renderWireSphere(batch, outColor);
         } else {
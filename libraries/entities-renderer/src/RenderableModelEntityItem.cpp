@@ -1301,6 +1301,8 @@ void ModelEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPoint
 
     // Nothing else to do unless the model is loaded
     if (!model->isLoaded()) {
+        // the priority follows the entity coming into view or getting closer while it is queued
+        model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
         return;
     }
 
@@ -1361,13 +1363,20 @@ void ModelEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPoint
     {
         DETAILED_PROFILE_RANGE(simulation_physics, "Fixup");
         if (model->needsFixupInScene()) {
-            model->removeFromScene(scene, transaction);
-            render::Item::Status::Getters statusGetters;
-            makeStatusGetters(entity, statusGetters);
-            using namespace std::placeholders;
-            model->addToScene(scene, transaction, statusGetters, std::bind(&ModelEntityRenderer::metaBlendshapeOperator, _renderItemID, _1, _2, _3, _4));
-            entity->bumpAncestorChainRenderableVersion();
-            processMaterials();
+            if (Model::canFinalizeModel()) {
+                uint64_t fixupStart = usecTimestampNow();
+                model->removeFromScene(scene, transaction);
+                render::Item::Status::Getters statusGetters;
+                makeStatusGetters(entity, statusGetters);
+                using namespace std::placeholders;
+                model->addToScene(scene, transaction, statusGetters, std::bind(&ModelEntityRenderer::metaBlendshapeOperator, _renderItemID, _1, _2, _3, _4));
+                entity->bumpAncestorChainRenderableVersion();
+                processMaterials();
+                Model::modelFinalized(usecTimestampNow() - fixupStart);
+            } else {
+                // out of time this frame, try again in the next one
+                emit requestRenderUpdate();
+            }
         }
     }
 
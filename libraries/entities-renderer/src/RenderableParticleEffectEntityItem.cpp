@@ -41,12 +41,15 @@ static ShapePipelinePointer shapePipelineFactory(const ShapePlumber& plumber, co
 }
 
 struct GpuParticle {
-    GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
-    glm::vec3 xyz; // Position
-    glm::vec2 uv; // Lifetime + seed
+    glm::vec3 position; // Emission position, relative to the emitter for non trailing particles
+    float spawnTime;
+    glm::vec3 velocity;
+    float seed;
+    glm::vec3 acceleration;
 };
 
-using GpuParticles = std::vector<GpuParticle>;
+// The times in the particle buffer are floats, rebase them before they lose too much precision
+static const uint64_t MAX_PARTICLE_TIME_USECS = 3600 * USECS_PER_SECOND;
 
 ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     ParticleUniforms uniforms;
@@ -57,10 +60,12 @@ ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPoint
         // As we create the first ParticuleSystem entity, let s register its special shapePIpeline factory:
         CUSTOM_PIPELINE_NUMBER = render::ShapePipeline::registerCustomShapePipelineFactory(shapePipelineFactory);
         _vertexFormat = std::make_shared<Format>();
-        _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC3F_XYZ,
-            offsetof(GpuParticle, xyz), gpu::Stream::PER_INSTANCE);
-        _vertexFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element::VEC2F_UV,
-            offsetof(GpuParticle, uv), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC4F_XYZW,
+            offsetof(GpuParticle, position), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element::VEC4F_XYZW,
+            offsetof(GpuParticle, velocity), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element::VEC3F_XYZ,
+            offsetof(GpuParticle, acceleration), gpu::Stream::PER_INSTANCE);
     });
 }
 
@@ -206,7 +211,6 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     const auto& polarFinish = particleProperties.polar.finish;
 
     particle.seed = randFloatInRange(-1.0f, 1.0f);
-    particle.expiration = (uint64_t)(particleProperties.lifespan * USECS_PER_SECOND);
 
     particle.relativePosition = glm::vec3(0.0f);
     particle.basePosition = baseTransform.getTranslation();
@@ -362,6 +366,42 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     return particle;
 }
 
+void ParticleEffectEntityRenderer::resizeParticles(size_t maxParticles) {
+    // Keep the newest particles, in order from the start of the ring
+    size_t numParticles = std::min(_numParticles, maxParticles);
+    CpuParticles particles;
+    particles.reserve(maxParticles);
+    for (size_t i = _numParticles - numParticles; i < _numParticles; i++) {
+        particles.push_back(_cpuParticles[(_nextParticle + _cpuParticles.size() - _numParticles + i) % _cpuParticles.size()]);
+    }
+    particles.resize(maxParticles);
+
+    _cpuParticles.swap(particles);
+    _numParticles = numParticles;
+    _nextParticle = numParticles % maxParticles;
+}
+
+void ParticleEffectEntityRenderer::updateGpuParticle(size_t index) {
+    const auto& particle = _cpuParticles[index];
+    GpuParticle gpuParticle;
+    gpuParticle.position = particle.relativePosition;
+    if (_particleProperties.emission.shouldTrail) {
+        gpuParticle.position += particle.basePosition;
+    }
+    gpuParticle.spawnTime = (float)(int64_t)(particle.spawnTime - _timeBase) / (float)USECS_PER_SECOND;
+    gpuParticle.velocity = particle.velocity;
+    gpuParticle.seed = particle.seed;
+    gpuParticle.acceleration = particle.acceleration;
+    _particleBuffer->setSubData(index, gpuParticle);
+}
+
+void ParticleEffectEntityRenderer::updateGpuParticles() {
+    _particleBuffer->resize(sizeof(GpuParticle) * _cpuParticles.size());
+    for (size_t i = 0; i < _numParticles; i++) {
+        updateGpuParticle((_nextParticle + _cpuParticles.size() - _numParticles + i) % _cpuParticles.size());
+    }
+}
+
 void ParticleEffectEntityRenderer::stepSimulation() {
     if (_lastSimulated == 0) {
         _lastSimulated = usecTimestampNow();
@@ -373,6 +413,33 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     _lastSimulated = now;
 
     const auto& modelTransform = getModelTransform();
+    bool needsUpdate = false;
+    size_t maxParticles = std::max<size_t>(_particleProperties.maxParticles, 1);
+    if (_cpuParticles.size() != maxParticles) {
+        resizeParticles(maxParticles);
+        needsUpdate = true;
+    }
+
+    if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
+        for (auto& particle : _cpuParticles) {
+            if (_prevEmitterShouldTrail) {
+                particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
+            }
+            particle.basePosition = modelTransform.getTranslation();
+        }
+        _prevEmitterShouldTrail = _particleProperties.emission.shouldTrail;
+        needsUpdate = true;
+    }
+
+    if (_simulationTime - _timeBase > MAX_PARTICLE_TIME_USECS) {
+        _timeBase = _simulationTime;
+        needsUpdate = true;
+    }
+
+    if (needsUpdate) {
+        updateGpuParticles();
+    }
+
     if (_emitting && _particleProperties.emitting() &&
         (_shapeType != SHAPE_TYPE_COMPOUND || (_geometryResource && _geometryResource->isLoaded()))) {
         uint64_t emitInterval = _particleProperties.emitIntervalUsecs();
@@ -382,8 +449,14 @@ void ParticleEffectEntityRenderer::stepSimulation() {
                 if (_shapeType == SHAPE_TYPE_COMPOUND && !_hasComputedTriangles) {
                     computeTriangles(_geometryResource->getHFMModel());
                 }
-                // emit particle
-                _cpuParticles.push_back(createParticle(modelTransform, _particleProperties, _shapeType, _geometryResource, _triangleInfo));
+                // emit particle, replacing the oldest one if there are already maxParticles
+                auto& particle = _cpuParticles[_nextParticle];
+                particle = createParticle(modelTransform, _particleProperties, _shapeType, _geometryResource, _triangleInfo);
+                particle.spawnTime = _simulationTime;
+                updateGpuParticle(_nextParticle);
+                _nextParticle = (_nextParticle + 1) % maxParticles;
+                _numParticles = std::min(_numParticles + 1, maxParticles);
+
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
@@ -394,41 +467,18 @@ void ParticleEffectEntityRenderer::stepSimulation() {
         }
     }
 
-    // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > _particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration == 0)) {
-        _cpuParticles.pop_front();
+    // Kill any particles that have expired, the oldest ones expire first
+    const uint64_t lifespan = (uint64_t)(_particleProperties.lifespan * USECS_PER_SECOND);
+    while (_numParticles > 0 &&
+           _simulationTime - _cpuParticles[(_nextParticle + maxParticles - _numParticles) % maxParticles].spawnTime >= lifespan) {
+        _numParticles--;
     }
 
-    const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
-    // update the particles
-    for (auto& particle : _cpuParticles) {
-        if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
-            if (_prevEmitterShouldTrail) {
-                particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
-            }
-            particle.basePosition = modelTransform.getTranslation();
-        }
-        particle.expiration = particle.expiration >= interval ? particle.expiration - interval : 0;
-        particle.integrate(deltaTime);
-    }
-    _prevEmitterShouldTrail = _particleProperties.emission.shouldTrail;
-
-    // Build particle primitives
-    static GpuParticles gpuParticles;
-    gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [this, &modelTransform] (const CpuParticle& particle) {
-        glm::vec3 position = particle.relativePosition + (_particleProperties.emission.shouldTrail ? particle.basePosition : modelTransform.getTranslation());
-        return GpuParticle(position, glm::vec2(particle.lifetime, particle.seed));
-    });
+    _simulationTime += interval;
 
-    // Update particle buffer
-    auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
-    if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
-    }
+    auto& uniforms = _uniformBuffer.edit<ParticleUniforms>();
+    uniforms.time = (float)(_simulationTime - _timeBase) / (float)USECS_PER_SECOND;
+    uniforms.emitterPosition = glm::vec4(_particleProperties.emission.shouldTrail ? glm::vec3(0.0f) : modelTransform.getTranslation(), 1.0f);
 }
 
 void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
@@ -436,7 +486,6 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
         return;
     }
 
-    // FIXME migrate simulation to a compute stage
     stepSimulation();
 
     gpu::Batch& batch = *args->_batch;
@@ -459,11 +508,19 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
 
     batch.setUniformBuffer(0, _uniformBuffer);
     batch.setInputFormat(_vertexFormat);
-    batch.setInputBuffer(0, _particleBuffer, 0, sizeof(GpuParticle));
 
-    auto numParticles = _particleBuffer->getSize() / sizeof(GpuParticle);
+    // The live particles may wrap around the end of the ring, in which case they take two draws
     static const size_t VERTEX_PER_PARTICLE = 4;
-    batch.drawInstanced((gpu::uint32)numParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    size_t oldestParticle = (_nextParticle + _cpuParticles.size() - _numParticles) % std::max<size_t>(_cpuParticles.size(), 1);
+    size_t numParticles = std::min(_numParticles, _cpuParticles.size() - oldestParticle);
+    if (numParticles > 0) {
+        batch.setInputBuffer(0, _particleBuffer, oldestParticle * sizeof(GpuParticle), sizeof(GpuParticle));
+        batch.drawInstanced((gpu::uint32)numParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    }
+    if (_numParticles > numParticles) {
+        batch.setInputBuffer(0, _particleBuffer, 0, sizeof(GpuParticle));
+        batch.drawInstanced((gpu::uint32)(_numParticles - numParticles), gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    }
 }
 
 void ParticleEffectEntityRenderer::fetchGeometryResource() {
@@ -42,24 +42,17 @@ private:
     using BufferView = gpu::BufferView;
 
     // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
+    // Only the emission state of the particles is kept, their trajectory is evaluated in the vertex shader from it
     struct CpuParticle {
         float seed { 0.0f };
-        uint64_t expiration { 0 };
-        float lifetime { 0.0f };
+        uint64_t spawnTime { 0 };  // Simulation time, in usecs
         glm::vec3 basePosition;
-        glm::vec3 relativePosition;
+        glm::vec3 relativePosition;  // At spawn time
         glm::vec3 velocity;
         glm::vec3 acceleration;
-
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            relativePosition += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
     };
-    using CpuParticles = std::deque<CpuParticle>;
+    // Ring of maxParticles particles, the newest particle replaces the oldest
+    using CpuParticles = std::vector<CpuParticle>;
 
 
     template<typename T>
@@ -76,7 +69,9 @@ private:
         InterpolationData<float> spin;
         float lifespan;
         int rotateWithEntity;
-        glm::vec2 spare;
+        float time;
+        float spare;
+        glm::vec4 emitterPosition;  // Where the non trailing particles are relative to
     };
 
     void computeTriangles(const hfm::Model& hfmModel);
@@ -92,16 +87,23 @@ private:
                                       const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
                                       const TriangleInfo& triangleInfo);
     void stepSimulation();
+    void resizeParticles(size_t maxParticles);
+    void updateGpuParticle(size_t index);
+    void updateGpuParticles();
 
     particle::Properties _particleProperties;
     bool _prevEmitterShouldTrail;
     bool _prevEmitterShouldTrailInitialized { false };
     CpuParticles _cpuParticles;
+    size_t _nextParticle { 0 };
+    size_t _numParticles { 0 };
     bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
     BufferPointer _particleBuffer { std::make_shared<Buffer>() };
     BufferView _uniformBuffer;
     quint64 _lastSimulated { 0 };
+    uint64_t _simulationTime { 0 };
+    uint64_t _timeBase { 0 };  // Simulation time that the times in the particle buffer are relative to
 
     PulsePropertyGroup _pulseProperties;
     ShapeType _shapeType;
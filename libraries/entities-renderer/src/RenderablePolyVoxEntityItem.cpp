@@ -13,11 +13,13 @@
 #include "RenderablePolyVoxEntityItem.h"
 
 #include <math.h>
+#include <numeric>
 
 #include <glm/gtx/transform.hpp>
 
 #include <QObject>
 #include <QByteArray>
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtConcurrent/QtConcurrentRun>
 
 #include <model-networking/SimpleMeshProxy.h>
@@ -135,6 +137,9 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   _voxelDataDirty to be set true while worker threads are attempting to bake meshes or shapes.  If this happens,
   we jump back to a higher point in the diagram to avoid wasting effort.
 
+  The mesh and the collision hulls are kept for each chunk of MESH_CHUNK_SIZE voxels along each axis.  Changing a voxel
+  marks the chunks that use it in _dirtyMeshChunks, and only those chunks are extracted again, on the worker threads.
+
   PolyVoxes are designed to seemlessly fit up against neighbors.  If voxels go right up to the edge of polyvox,
   the resulting mesh wont be closed -- the library assumes you'll have another polyvox next to it to continue the
   mesh.
@@ -197,8 +202,10 @@ bool isEdged(PolyVoxEntityItem::PolyVoxSurfaceStyle surfaceStyle) {
 void RenderablePolyVoxEntityItem::setVoxelData(const QByteArray& voxelData) {
     // accept compressed voxel information from the entity-server
     withWriteLock([&] {
-        if (_voxelData != voxelData) {
-            _voxelData = voxelData;
+        // an edit may only carry the chunks it changed
+        QByteArray mergedVoxelData = PolyVoxChunks::merge(_voxelData, voxelData);
+        if (_voxelData != mergedVoxelData) {
+            _voxelData = mergedVoxelData;
             _voxelDataDirty = true;
             startUpdates();
         }
@@ -225,6 +232,7 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
             volSizeChanged = true;
         }
         _voxelSurfaceStyle = voxelSurfaceStyle;
+        _allMeshChunksDirty = true;
         startUpdates();
     });
 
@@ -261,24 +269,30 @@ void RenderablePolyVoxEntityItem::forEachVoxelValue(const ivec3& voxelSize, std:
     });
 }
 
-QByteArray RenderablePolyVoxEntityItem::volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const {
-    int totalSize = voxelXSize * voxelYSize * voxelZSize;
-    ivec3 voxelSize{ voxelXSize, voxelYSize, voxelZSize };
-    ivec3 low{ 0 };
-    int index = 0;
+PolyVoxChunks::Chunks RenderablePolyVoxEntityItem::volDataToChunks(const ivec3& voxelSize) const {
+    ivec3 grid = PolyVoxChunks::getChunkGrid(voxelSize);
+    int numChunks = grid.x * grid.y * grid.z;
 
-    QByteArray result = QByteArray(totalSize, '\0');
+    // copy the voxels out under the lock, and compress them after
+    std::vector<QByteArray> chunkVoxels(numChunks, QByteArray(PolyVoxChunks::CHUNK_VOXELS, '\0'));
     withReadLock([&] {
-        if (isEdged()) {
-            low += 1;
-            voxelSize += 2;
+        for (int index = 0; index < numChunks; index++) {
+            ivec3 chunkCorner = PolyVoxChunks::getChunk(grid, index) * PolyVoxChunks::CHUNK_SIZE;
+            ivec3 chunkEnd = glm::min(chunkCorner + ivec3(PolyVoxChunks::CHUNK_SIZE), voxelSize);
+            QByteArray& voxels = chunkVoxels[index];
+            loop3(chunkCorner, chunkEnd, [&](const ivec3& v) {
+                voxels[PolyVoxChunks::getVoxelIndex(v - chunkCorner)] = getVoxelInternal(v);
+            });
         }
-
-        loop3(low, voxelSize, [&](const ivec3& v){
-            result[index++] = _volData->getVoxelAt(v.x, v.y, v.z);
-        });
     });
 
+    PolyVoxChunks::Chunks result;
+    for (int index = 0; index < numChunks; index++) {
+        QByteArray encoded = PolyVoxChunks::encodeChunk(chunkVoxels[index]);
+        if (!encoded.isEmpty()) {
+            result.insert(index, encoded);
+        }
+    }
     return result;
 }
 
@@ -869,6 +883,9 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _voxelDataDirty = true;
         _voxelVolumeSize = voxelVolumeSize;
         _volData.reset();
+        _volDataGeneration++;
+        _volDataChunks = PolyVoxChunks::Data();
+        _allMeshChunksDirty = true;
         _onCount = 0;
         _updateFromNeighborXEdge = _updateFromNeighborYEdge = _updateFromNeighborZEdge = true;
         startUpdates();
@@ -947,6 +964,7 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    markMeshChunksDirty(x, y, z);
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -1003,55 +1021,62 @@ bool RenderablePolyVoxEntityItem::updateOnCount(const ivec3& v, uint8_t toValue)
 void RenderablePolyVoxEntityItem::uncompressVolumeData() {
     // take compressed data and expand it into _volData.
     QByteArray voxelData;
+    PolyVoxChunks::Data oldChunks;
+    int volDataGeneration;
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
     withReadLock([&] {
         voxelData = _voxelData;
+        oldChunks = _volDataChunks;
+        volDataGeneration = _volDataGeneration;
     });
 
     QtConcurrent::run([=] {
-        QDataStream reader(voxelData);
-        quint16 voxelXSize, voxelYSize, voxelZSize;
-        reader >> voxelXSize;
-        reader >> voxelYSize;
-        reader >> voxelZSize;
-
-        if (voxelXSize == 0 || voxelXSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION ||
-            voxelYSize == 0 || voxelYSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION ||
-            voxelZSize == 0 || voxelZSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION) {
-            qCDebug(entitiesrenderer) << "voxelSize is not reasonable, skipping uncompressions."
-                                      << voxelXSize << voxelYSize << voxelZSize << getName() << getID();
-            entity->setVoxelsFromData(QByteArray(1, 0), 1, 1, 1);
-            return;
+        PolyVoxChunks::Data data;
+        if (!PolyVoxChunks::read(voxelData, data)) {
+            qCDebug(entitiesrenderer) << "voxel data is not valid, skipping uncompressions." << getName() << getID();
+            data = PolyVoxChunks::Data();
+            data.size = ivec3(1);
         }
-        int rawSize = voxelXSize * voxelYSize * voxelZSize;
 
-        QByteArray compressedData;
-        reader >> compressedData;
-
-        QByteArray uncompressedData = qUncompress(compressedData);
-
-        if (uncompressedData.size() != rawSize) {
-            qCDebug(entitiesrenderer) << "PolyVox uncompress -- size is (" << voxelXSize << voxelYSize << voxelZSize << ")"
-                     << "so expected uncompressed length of" << rawSize << "but length is" << uncompressedData.size()
-                                      << getName() << getID();
-            entity->setVoxelsFromData(QByteArray(1, 0), 1, 1, 1);
-            return;
+        // only the chunks that changed are expanded again, unless _volData was made from voxel data of another size
+        PolyVoxChunks::Chunks changedChunks;
+        if (data.size == oldChunks.size) {
+            changedChunks = PolyVoxChunks::diff(oldChunks.chunks, data.chunks);
+        } else {
+            ivec3 grid = PolyVoxChunks::getChunkGrid(data.size);
+            for (int index = 0; index < grid.x * grid.y * grid.z; index++) {
+                changedChunks.insert(index, data.chunks.value(index));
+            }
         }
 
-        entity->setVoxelsFromData(uncompressedData, voxelXSize, voxelYSize, voxelZSize);
+        entity->setVoxelsFromChunks(data.size, data.chunks, changedChunks, volDataGeneration);
     });
 }
 
-void RenderablePolyVoxEntityItem::setVoxelsFromData(QByteArray uncompressedData,
-                                                    quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) {
+void RenderablePolyVoxEntityItem::setVoxelsFromChunks(const ivec3& voxelSize, const PolyVoxChunks::Chunks& chunks,
+                                                      const PolyVoxChunks::Chunks& changedChunks, int volDataGeneration) {
     // this accepts the payload from uncompressVolumeData
+    ivec3 grid = PolyVoxChunks::getChunkGrid(voxelSize);
+    std::vector<std::pair<ivec3, QByteArray>> decodedChunks;
+    decodedChunks.reserve(changedChunks.size());
+    for (auto chunk = changedChunks.cbegin(); chunk != changedChunks.cend(); ++chunk) {
+        decodedChunks.emplace_back(PolyVoxChunks::getChunk(grid, chunk.key()) * PolyVoxChunks::CHUNK_SIZE,
+                                   PolyVoxChunks::decodeChunk(chunk.value()));
+    }
+
     withWriteLock([&] {
-        loop3(ivec3(0), ivec3(voxelXSize, voxelYSize, voxelZSize), [&](const ivec3& v) {
-            int uncompressedIndex = (v.z * voxelYSize * voxelXSize) + (v.y * voxelZSize) + v.x;
-            setVoxelInternal(v, uncompressedData[uncompressedIndex]);
-        });
+        for (const auto& chunk : decodedChunks) {
+            ivec3 chunkEnd = glm::min(chunk.first + ivec3(PolyVoxChunks::CHUNK_SIZE), voxelSize);
+            loop3(chunk.first, chunkEnd, [&](const ivec3& v) {
+                setVoxelInternal(v, chunk.second[PolyVoxChunks::getVoxelIndex(v - chunk.first)]);
+            });
+        }
 
+        if (volDataGeneration == _volDataGeneration) {
+            _volDataChunks.size = voxelSize;
+            _volDataChunks.chunks = chunks;
+        }
         _state = PolyVoxState::UncompressingFinished;
     });
 }
@@ -1062,26 +1087,22 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
 
     EntityItemPointer entity = getThisPointer();
 
-    quint16 voxelXSize;
-    quint16 voxelYSize;
-    quint16 voxelZSize;
+    ivec3 voxelSize;
+    PolyVoxChunks::Data oldChunks;
+    int volDataGeneration;
     withReadLock([&] {
-        voxelXSize = _voxelVolumeSize.x;
-        voxelYSize = _voxelVolumeSize.y;
-        voxelZSize = _voxelVolumeSize.z;
+        voxelSize = _voxelVolumeSize;
+        oldChunks = _volDataChunks;
+        volDataGeneration = _volDataGeneration;
     });
 
-    QtConcurrent::run([voxelXSize, voxelYSize, voxelZSize, entity] {
+    QtConcurrent::run([voxelSize, oldChunks, volDataGeneration, entity] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-        QByteArray uncompressedData = polyVoxEntity->volDataToArray(voxelXSize, voxelYSize, voxelZSize);
-
-        QByteArray newVoxelData;
-        QDataStream writer(&newVoxelData, QIODevice::WriteOnly | QIODevice::Truncate);
 
-        writer << voxelXSize << voxelYSize << voxelZSize;
-
-        QByteArray compressedData = qCompress(uncompressedData, 9);
-        writer << compressedData;
+        PolyVoxChunks::Data data;
+        data.size = voxelSize;
+        data.chunks = polyVoxEntity->volDataToChunks(voxelSize);
+        QByteArray newVoxelData = PolyVoxChunks::write(data);
 
         // make sure the compressed data can be sent over the wire-protocol
         if (newVoxelData.size() > 1150) {
@@ -1089,21 +1110,34 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
             // revert the active voxel-space to the last version that fit.
             qCDebug(entitiesrenderer) << "compressed voxel data is too large" << entity->getName() << entity->getID();
 
-            const auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-            polyVoxEntity->compressVolumeDataFinished(QByteArray());
+            polyVoxEntity->compressVolumeDataFinished(QByteArray(), QByteArray(), PolyVoxChunks::Data(), volDataGeneration);
             return;
         }
 
-        std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->compressVolumeDataFinished(newVoxelData);
+        // the edit only carries the chunks that changed since the voxel data was last received or sent
+        QByteArray delta = newVoxelData;
+        if (oldChunks.size == voxelSize) {
+            PolyVoxChunks::Data deltaData;
+            deltaData.size = voxelSize;
+            deltaData.isDelta = true;
+            deltaData.chunks = PolyVoxChunks::diff(oldChunks.chunks, data.chunks);
+            delta = PolyVoxChunks::write(deltaData);
+        }
+
+        polyVoxEntity->compressVolumeDataFinished(newVoxelData, delta, data, volDataGeneration);
     });
 }
 
-void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const QByteArray& voxelData) {
+void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const QByteArray& voxelData, const QByteArray& delta,
+                                                             const PolyVoxChunks::Data& chunks, int volDataGeneration) {
     // compressed voxel information from the entity-server
     withWriteLock([&] {
         if (voxelData.size() > 0 && _voxelData != voxelData) {
             _voxelData = voxelData;
         }
+        if (voxelData.size() > 0 && volDataGeneration == _volDataGeneration) {
+            _volDataChunks = chunks;
+        }
         _state = PolyVoxState::CompressingFinished;
     });
 
@@ -1119,7 +1153,11 @@ void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const QByteArray& v
             EntityPropertyFlags desiredProperties;
             desiredProperties.setHasProperty(PROP_VOXEL_DATA);
             EntityItemProperties properties = getProperties(desiredProperties, false);
-            properties.setVoxelDataDirty();
+            if (delta.size() > 0) {
+                properties.setVoxelData(delta);
+            } else {
+                properties.setVoxelDataDirty();
+            }
             properties.setLastEdited(now);
 
             EntitySimulationPointer simulation = tree ? tree->getSimulation() : nullptr;
@@ -1199,6 +1237,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1219,6 +1258,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1239,6 +1279,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1278,50 +1319,126 @@ void RenderablePolyVoxEntityItem::tellNeighborsToRecopyEdges(bool force) {
 }
 
 
+ivec3 RenderablePolyVoxEntityItem::getMeshChunkGrid(const PolyVox::SimpleVolume<uint8_t>* volData) {
+    // the extractors work on the pairs of neighboring voxels, so a chunk shares its upper layers with the next one
+    ivec3 volumeSize { volData->getWidth(), volData->getHeight(), volData->getDepth() };
+    return glm::max((volumeSize - 1 + MESH_CHUNK_SIZE - 1) / MESH_CHUNK_SIZE, ivec3(1));
+}
+
+void RenderablePolyVoxEntityItem::markMeshChunksDirty(int x, int y, int z) {
+    // a voxel is used by the chunks that extract it or one of its neighbors, including for the normals
+    ivec3 grid = getMeshChunkGrid(_volData.get());
+    ivec3 v { x, y, z };
+    ivec3 low = glm::max(v - 2, ivec3(0)) / MESH_CHUNK_SIZE;
+    ivec3 high = glm::min((v + 1) / MESH_CHUNK_SIZE, grid - 1);
+    loop3(low, high + 1, [&](const ivec3& chunk) {
+        _dirtyMeshChunks.insert(chunk.x + grid.x * (chunk.y + grid.y * chunk.z));
+    });
+}
+
+void RenderablePolyVoxEntityItem::extractMeshChunk(PolyVox::SimpleVolume<uint8_t>* volData,
+                                                   PolyVoxSurfaceStyle voxelSurfaceStyle,
+                                                   const ivec3& chunk, MeshChunk& meshChunk) {
+    PolyVox::Vector3DInt32 volumeUpper = volData->getEnclosingRegion().getUpperCorner();
+    ivec3 low = chunk * MESH_CHUNK_SIZE;
+    ivec3 high = glm::min(low + MESH_CHUNK_SIZE, ivec3(volumeUpper.getX(), volumeUpper.getY(), volumeUpper.getZ()));
+    PolyVox::Region region(PolyVox::Vector3DInt32(low.x, low.y, low.z), PolyVox::Vector3DInt32(high.x, high.y, high.z));
+
+    // A mesh object to hold the result of surface extraction
+    PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+    switch (voxelSurfaceStyle) {
+        case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
+        case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+            PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (volData, region, &polyVoxMesh);
+            surfaceExtractor.execute();
+            break;
+        }
+        case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
+        case PolyVoxEntityItem::SURFACE_CUBIC: {
+            PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (volData, region, &polyVoxMesh);
+            surfaceExtractor.execute();
+            break;
+        }
+    }
+
+    // the extractors make the vertices relative to the lower corner of the region
+    PolyVox::Vector3DFloat offset((float)low.x, (float)low.y, (float)low.z);
+    meshChunk.vertices = polyVoxMesh.getRawVertexData();
+    for (auto& vertex : meshChunk.vertices) {
+        vertex.setPosition(vertex.getPosition() + offset);
+    }
+    meshChunk.indices = polyVoxMesh.getIndices();
+    meshChunk.pointsDirty = true;
+}
+
 void RenderablePolyVoxEntityItem::recomputeMesh() {
     // use _volData to make a renderable mesh
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    std::vector<int> dirtyChunks;
+    bool allChunksDirty;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        dirtyChunks.assign(_dirtyMeshChunks.begin(), _dirtyMeshChunks.end());
+        allChunksDirty = _allMeshChunksDirty;
+        _dirtyMeshChunks.clear();
+        _allMeshChunksDirty = false;
     });
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
+    QtConcurrent::run([entity, voxelSurfaceStyle, dirtyChunks, allChunksDirty] {
         graphics::MeshPointer mesh(new graphics::Mesh());
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+        std::vector<uint32_t> vecIndices;
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
 
         entity->withReadLock([&] {
             PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+            auto& meshChunks = entity->_meshChunks;
+            ivec3 grid = getMeshChunkGrid(volData);
+
+            std::vector<int> chunksToExtract;
+            if (allChunksDirty || grid != entity->_meshChunkGrid) {
+                entity->_meshChunkGrid = grid;
+                meshChunks.clear();
+                meshChunks.resize(grid.x * grid.y * grid.z);
+                chunksToExtract.resize(meshChunks.size());
+                std::iota(chunksToExtract.begin(), chunksToExtract.end(), 0);
+            } else {
+                chunksToExtract = dirtyChunks;
+            }
+
+            QtConcurrent::blockingMap(chunksToExtract, [&](int index) {
+                ivec3 chunk { index % grid.x, (index / grid.x) % grid.y, index / (grid.x * grid.y) };
+                extractMeshChunk(volData, voxelSurfaceStyle, chunk, meshChunks[index]);
+            });
+
+            size_t numVertices = 0;
+            size_t numIndices = 0;
+            for (const auto& meshChunk : meshChunks) {
+                numVertices += meshChunk.vertices.size();
+                numIndices += meshChunk.indices.size();
+            }
+            vecVertices.reserve(numVertices);
+            vecIndices.reserve(numIndices);
+            for (const auto& meshChunk : meshChunks) {
+                uint32_t baseVertex = (uint32_t)vecVertices.size();
+                vecVertices.insert(vecVertices.end(), meshChunk.vertices.begin(), meshChunk.vertices.end());
+                for (auto index : meshChunk.indices) {
+                    vecIndices.push_back(baseVertex + index);
                 }
             }
         });
 
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -1366,135 +1483,142 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
     somethingChangedNotification();
 }
 
+void RenderablePolyVoxEntityItem::computeMeshChunkPoints(PolyVoxSurfaceStyle voxelSurfaceStyle, const ivec3& voxelVolumeSize,
+                                                         const ivec3& chunk, MeshChunk& meshChunk) const {
+    // the collision hulls of a chunk come from its mesh for marching-cube extractors and from its voxels for
+    // cubic extractors.  This assumes that the caller has read-locked the entity.
+    meshChunk.points.clear();
+    meshChunk.pointsDirty = false;
+
+    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
+        voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
+        auto getPosition = [&](uint32_t index) {
+            const auto& position = meshChunk.vertices[index].getPosition();
+            return glm::vec3(position.getX(), position.getY(), position.getZ());
+        };
+
+        // pull each triangle in the mesh into a polyhedron which can be collided with
+        for (size_t i = 0; i + 2 < meshChunk.indices.size(); i += 3) {
+            glm::vec3 p0 = getPosition(meshChunk.indices[i]);
+            glm::vec3 p1 = getPosition(meshChunk.indices[i + 1]);
+            glm::vec3 p2 = getPosition(meshChunk.indices[i + 2]);
+
+            glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
+            glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+            glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
+
+            QVector<glm::vec3> pointsInPart;
+            pointsInPart << p0;
+            pointsInPart << p1;
+            pointsInPart << p2;
+            pointsInPart << p3;
+            // add next convex hull
+            meshChunk.points << pointsInPart;
+        }
+        return;
+    }
+
+    // the voxels of a chunk are those from its lower corner up to the next chunk, in user voxel-coords
+    ivec3 edge { isEdged(voxelSurfaceStyle) ? 1 : 0 };
+    ivec3 volumeSize { _volData->getWidth(), _volData->getHeight(), _volData->getDepth() };
+    ivec3 low = chunk * MESH_CHUNK_SIZE;
+    ivec3 high = glm::mix(low + MESH_CHUNK_SIZE, volumeSize, glm::equal(chunk, _meshChunkGrid - 1));
+    low = glm::clamp(low - edge, ivec3(0), voxelVolumeSize);
+    high = glm::clamp(high - edge, ivec3(0), voxelVolumeSize);
+
+    float offL = -0.5f;
+    float offH = 0.5f;
+    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
+        offL += 1.0f;
+        offH += 1.0f;
+    }
+
+    loop3(low, high, [&](const ivec3& v) {
+        if (getVoxelInternal(v) == 0) {
+            return;
+        }
+
+        const auto& x = v.x;
+        const auto& y = v.y;
+        const auto& z = v.z;
+        if (glm::all(glm::greaterThan(v, ivec3(0))) &&
+            glm::all(glm::lessThan(v, voxelVolumeSize - 1)) &&
+            (getVoxelInternal({ x - 1, y, z }) > 0) &&
+            (getVoxelInternal({ x, y - 1, z }) > 0) &&
+            (getVoxelInternal({ x, y, z - 1 }) > 0) &&
+            (getVoxelInternal({ x + 1, y, z }) > 0) &&
+            (getVoxelInternal({ x, y + 1, z }) > 0) &&
+            (getVoxelInternal({ x, y, z + 1 }) > 0)) {
+            // this voxel has neighbors in every cardinal direction, so there's no need
+            // to include it in the collision hull.
+            return;
+        }
+
+        QVector<glm::vec3> pointsInPart;
+        pointsInPart << glm::vec3(x + offL, y + offL, z + offL);
+        pointsInPart << glm::vec3(x + offL, y + offL, z + offH);
+        pointsInPart << glm::vec3(x + offL, y + offH, z + offL);
+        pointsInPart << glm::vec3(x + offL, y + offH, z + offH);
+        pointsInPart << glm::vec3(x + offH, y + offL, z + offL);
+        pointsInPart << glm::vec3(x + offH, y + offL, z + offH);
+        pointsInPart << glm::vec3(x + offH, y + offH, z + offL);
+        pointsInPart << glm::vec3(x + offH, y + offH, z + offH);
+        // add next convex hull
+        meshChunk.points << pointsInPart;
+    });
+}
+
 void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
-    // this creates a collision-shape for the physics engine.  The shape comes from
-    // _volData for cubic extractors and from _mesh for marching-cube extractors
+    // this creates a collision-shape for the physics engine from the collision hulls of the chunks, after
+    // computing them again for the chunks that have been extracted since the last shape
 
     EntityItemPointer entity = getThisPointer();
 
     PolyVoxSurfaceStyle voxelSurfaceStyle;
     glm::vec3 voxelVolumeSize;
-    graphics::MeshPointer mesh;
 
     withReadLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
         voxelVolumeSize = _voxelVolumeSize;
-        mesh = _mesh;
     });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
+    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
         QVector<QVector<glm::vec3>> pointCollection;
         AABox box;
-        glm::mat4 vtoM = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->voxelToLocalMatrix();
-
-        if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
-            voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
-            // pull each triangle in the mesh into a polyhedron which can be collided with
-            unsigned int i = 0;
-
-            const gpu::BufferView& vertexBufferView = mesh->getVertexBuffer();
-            const gpu::BufferView& indexBufferView = mesh->getIndexBuffer();
-
-            gpu::BufferView::Iterator<const uint32_t> it = indexBufferView.cbegin<uint32_t>();
-            while (it != indexBufferView.cend<uint32_t>()) {
-                uint32_t p0Index = *(it++);
-                uint32_t p1Index = *(it++);
-                uint32_t p2Index = *(it++);
-
-                const glm::vec3& p0 = vertexBufferView.get<const glm::vec3>(p0Index);
-                const glm::vec3& p1 = vertexBufferView.get<const glm::vec3>(p1Index);
-                const glm::vec3& p2 = vertexBufferView.get<const glm::vec3>(p2Index);
-
-                glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
-                glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-                glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
-
-                glm::vec3 p0Model = glm::vec3(vtoM * glm::vec4(p0, 1.0f));
-                glm::vec3 p1Model = glm::vec3(vtoM * glm::vec4(p1, 1.0f));
-                glm::vec3 p2Model = glm::vec3(vtoM * glm::vec4(p2, 1.0f));
-                glm::vec3 p3Model = glm::vec3(vtoM * glm::vec4(p3, 1.0f));
-
-                box += p0Model;
-                box += p1Model;
-                box += p2Model;
-                box += p3Model;
-
-                QVector<glm::vec3> pointsInPart;
-                pointsInPart << p0Model;
-                pointsInPart << p1Model;
-                pointsInPart << p2Model;
-                pointsInPart << p3Model;
-                // add next convex hull
-                QVector<glm::vec3> newMeshPoints;
-                pointCollection << newMeshPoints;
-                // add points to the new convex hull
-                pointCollection[i++] << pointsInPart;
-            }
-        } else {
-            unsigned int i = 0;
-            polyVoxEntity->forEachVoxelValue(voxelVolumeSize, [&](const ivec3& v, uint8_t value) {
-                if (value > 0) {
-                    const auto& x = v.x;
-                    const auto& y = v.y;
-                    const auto& z = v.z;
-                    if (glm::all(glm::greaterThan(v, ivec3(0))) &&
-                        glm::all(glm::lessThan(v, ivec3(voxelVolumeSize) - 1)) &&
-                        (polyVoxEntity->getVoxelInternal({ x - 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y - 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z - 1 }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x + 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y + 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z + 1 }) > 0)) {
-                        // this voxel has neighbors in every cardinal direction, so there's no need
-                        // to include it in the collision hull.
-                        return;
-                    }
+        glm::mat4 vtoM = polyVoxEntity->voxelToLocalMatrix();
 
-                    QVector<glm::vec3> pointsInPart;
+        polyVoxEntity->withReadLock([&] {
+            auto& meshChunks = polyVoxEntity->_meshChunks;
+            ivec3 grid = polyVoxEntity->_meshChunkGrid;
 
-                    float offL = -0.5f;
-                    float offH = 0.5f;
-                    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
-                        offL += 1.0f;
-                        offH += 1.0f;
-                    }
+            std::vector<int> dirtyChunks;
+            for (int i = 0; i < (int)meshChunks.size(); i++) {
+                if (meshChunks[i].pointsDirty) {
+                    dirtyChunks.push_back(i);
+                }
+            }
 
-                    glm::vec3 p000 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offL, 1.0f));
-                    glm::vec3 p001 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offH, 1.0f));
-                    glm::vec3 p010 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offL, 1.0f));
-                    glm::vec3 p011 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offH, 1.0f));
-                    glm::vec3 p100 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offL, 1.0f));
-                    glm::vec3 p101 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offH, 1.0f));
-                    glm::vec3 p110 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offL, 1.0f));
-                    glm::vec3 p111 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offH, 1.0f));
-
-                    box += p000;
-                    box += p001;
-                    box += p010;
-                    box += p011;
-                    box += p100;
-                    box += p101;
-                    box += p110;
-                    box += p111;
-
-                    pointsInPart << p000;
-                    pointsInPart << p001;
-                    pointsInPart << p010;
-                    pointsInPart << p011;
-                    pointsInPart << p100;
-                    pointsInPart << p101;
-                    pointsInPart << p110;
-                    pointsInPart << p111;
+            QtConcurrent::blockingMap(dirtyChunks, [&](int index) {
+                ivec3 chunk { index % grid.x, (index / grid.x) % grid.y, index / (grid.x * grid.y) };
+                polyVoxEntity->computeMeshChunkPoints(voxelSurfaceStyle, ivec3(voxelVolumeSize), chunk, meshChunks[index]);
+            });
 
+            for (const auto& meshChunk : meshChunks) {
+                for (const auto& points : meshChunk.points) {
+                    QVector<glm::vec3> pointsInPart;
+                    pointsInPart.reserve(points.size());
+                    for (const auto& point : points) {
+                        glm::vec3 pointModel = glm::vec3(vtoM * glm::vec4(point, 1.0f));
+                        box += pointModel;
+                        pointsInPart << pointModel;
+                    }
                     // add next convex hull
-                    QVector<glm::vec3> newMeshPoints;
-                    pointCollection << newMeshPoints;
-                    // add points to the new convex hull
-                    pointCollection[i++] << pointsInPart;
+                    pointCollection << pointsInPart;
                 }
-            });
-        }
+            }
+        });
+
         polyVoxEntity->setCollisionPoints(pointCollection, box);
     });
 }
@@ -13,11 +13,13 @@
 #define hifi_RenderablePolyVoxEntityItem_h
 
 #include <atomic>
+#include <unordered_set>
 
 #include <QSemaphore>
 
 #include <PolyVoxCore/SimpleVolume.h>
 #include <PolyVoxCore/Raycast.h>
+#include <PolyVoxCore/VertexTypes.h>
 
 #include <gpu/Forward.h>
 #include <gpu/Context.h>
@@ -25,6 +27,7 @@
 #include <graphics/Geometry.h>
 #include <TextureCache.h>
 #include <PolyVoxEntityItem.h>
+#include <PolyVoxChunks.h>
 
 #include "RenderableEntityItem.h"
 
@@ -115,9 +118,10 @@ public:
 
     virtual void setRegistrationPoint(const glm::vec3& value) override;
 
-    void setVoxelsFromData(QByteArray uncompressedData, quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize);
+    void setVoxelsFromChunks(const ivec3& voxelSize, const PolyVoxChunks::Chunks& chunks,
+                             const PolyVoxChunks::Chunks& changedChunks, int volDataGeneration);
     void forEachVoxelValue(const ivec3& voxelSize, std::function<void(const ivec3&, uint8_t)> thunk);
-    QByteArray volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const;
+    PolyVoxChunks::Chunks volDataToChunks(const ivec3& voxelSize) const;
 
     void setMesh(graphics::MeshPointer mesh);
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
@@ -127,7 +131,8 @@ public:
     bool setVoxelInternal(const ivec3& v, uint8_t toValue);
     void setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue);
 
-    void compressVolumeDataFinished(const QByteArray& voxelData);
+    void compressVolumeDataFinished(const QByteArray& voxelData, const QByteArray& delta, const PolyVoxChunks::Data& chunks,
+                                    int volDataGeneration);
     void neighborXEdgeChanged() { withWriteLock([&] { _updateFromNeighborXEdge = true; }); startUpdates(); }
     void neighborYEdgeChanged() { withWriteLock([&] { _updateFromNeighborYEdge = true; }); startUpdates(); }
     void neighborZEdgeChanged() { withWriteLock([&] { _updateFromNeighborZEdge = true; }); startUpdates(); }
@@ -146,6 +151,23 @@ private:
     void startUpdates();
     void stopUpdates();
 
+    // The mesh and the collision hulls are made of chunks of MESH_CHUNK_SIZE voxels along each axis.  Only the chunks
+    // with changed voxels are extracted again, in parallel, the others keep their previous results.
+    static const int MESH_CHUNK_SIZE { 16 };
+    struct MeshChunk {
+        // in voxel-volume space
+        std::vector<PolyVox::PositionMaterialNormal> vertices;
+        std::vector<uint32_t> indices;
+        QVector<QVector<glm::vec3>> points;
+        bool pointsDirty { true };
+    };
+    static ivec3 getMeshChunkGrid(const PolyVox::SimpleVolume<uint8_t>* volData);
+    static void extractMeshChunk(PolyVox::SimpleVolume<uint8_t>* volData, PolyVoxSurfaceStyle voxelSurfaceStyle,
+                                 const ivec3& chunk, MeshChunk& meshChunk);
+    void computeMeshChunkPoints(PolyVoxSurfaceStyle voxelSurfaceStyle, const ivec3& voxelVolumeSize,
+                                const ivec3& chunk, MeshChunk& meshChunk) const;
+    void markMeshChunksDirty(int x, int y, int z);
+
     void recomputeMesh();
     void cacheNeighbors();
     void copyUpperEdgesFromNeighbors();
@@ -168,9 +190,20 @@ private:
 
     graphics::MeshPointer _mesh;
 
+    // only touched by the worker threads, which the state machine runs one at a time
+    std::vector<MeshChunk> _meshChunks;
+    ivec3 _meshChunkGrid { 0 };
+    // chunks with changed voxels since the last mesh, or all of them
+    std::unordered_set<int> _dirtyMeshChunks;
+    bool _allMeshChunksDirty { true };
+
     ShapeInfo _shapeInfo;
 
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
+    int _volDataGeneration { 0 }; // counts the reallocations of _volData
+    // the chunks of the voxel data that _volData was last made from or sent as, so that only the chunks that change are
+    // uncompressed and only the edited ones are sent.  Their size is 0 until _volData holds a whole voxel data.
+    PolyVoxChunks::Data _volDataChunks;
     int _onCount; // how many non-zero voxels are in _volData
 
     bool _neighborXNeedsUpdate { false };
@@ -48,11 +48,22 @@ static int MAX_WINDOW_SIZE = 4096;
 const float METERS_TO_INCHES = 39.3701f;
 static float OPAQUE_ALPHA_THRESHOLD = 0.99f;
 
-// If a web-view hasn't been rendered for 30 seconds, de-allocate the framebuffer
-static uint64_t MAX_NO_RENDER_INTERVAL = 30 * USECS_PER_SECOND;
+// If a web-view hasn't been rendered for a second, it is off screen and stops rendering until it's drawn again
+static uint64_t MAX_NO_RENDER_INTERVAL = USECS_PER_SECOND;
+
+// How often the frame rates of the web-views are set from how they were drawn
+static int FPS_UPDATE_INTERVAL_MSECS = MSECS_PER_SECOND / 4;
 
 static uint8_t YOUTUBE_MAX_FPS = 30;
 
+// Web-views at least this wide on screen, in radians, render at their full frame rate, the smaller ones slower
+static float FULL_FPS_ANGULAR_SIZE = 0.5f;
+static uint8_t MIN_WEB_FPS = 1;
+
+// The frames per second the html web-views on screen share, past it they all slow down in proportion
+static std::atomic<uint32_t> _totalRequestedFps(0);
+static const uint32_t MAX_TOTAL_WEB_FPS = 120;
+
 // Don't allow more than 20 concurrent web views
 static std::atomic<uint32_t> _currentWebCount(0);
 static const uint32_t MAX_CONCURRENT_WEB_VIEWS = 20;
@@ -90,8 +101,9 @@ WebEntityRenderer::WebEntityRenderer(const EntityItemPointer& entity) : Parent(e
     _contentType = ContentType::HtmlContent;
     buildWebSurface(entity, "");
 
-    _timer.setInterval(MSECS_PER_SECOND);
+    _timer.setInterval(FPS_UPDATE_INTERVAL_MSECS);
     connect(&_timer, &QTimer::timeout, this, &WebEntityRenderer::onTimeout);
+    _timer.start();
 }
 
 WebEntityRenderer::~WebEntityRenderer() {
@@ -127,17 +139,52 @@ bool WebEntityRenderer::needsRenderUpdateFromTypedEntity(const TypedEntityPointe
 }
 
 void WebEntityRenderer::onTimeout() {
+    // only the html surfaces are throttled, the qml ones are the tablet and other UI that must stay responsive
+    QSharedPointer<OffscreenQmlSurface> webSurface;
     uint64_t lastRenderTime;
-    if (!resultWithReadLock<bool>([&] {
+    float angularSize;
+    uint8_t maxFPS;
+    withReadLock([&] {
+        if (_contentType == ContentType::HtmlContent) {
+            webSurface = _webSurface;
+        }
         lastRenderTime = _lastRenderTime;
-        return (_lastRenderTime != 0 && (bool)_webSurface);
-    })) {
+        angularSize = _angularSize;
+        maxFPS = QUrl(_sourceURL).host().endsWith("youtube.com", Qt::CaseInsensitive) ? YOUTUBE_MAX_FPS : _maxFPS;
+    });
+
+    if (!webSurface || lastRenderTime == 0) {
+        setRequestedFps(0);
         return;
     }
 
     if (usecTimestampNow() - lastRenderTime > MAX_NO_RENDER_INTERVAL) {
-        destroyWebSurface();
+        // doRender resumes it
+        if (!webSurface->isPaused()) {
+            webSurface->pause();
+        }
+        setRequestedFps(0);
+        return;
+    }
+
+    uint8_t requestedFps = 0;
+    if (maxFPS > 0) {
+        float fpsScale = glm::min(angularSize / FULL_FPS_ANGULAR_SIZE, 1.0f);
+        requestedFps = std::max(MIN_WEB_FPS, (uint8_t)(maxFPS * fpsScale));
     }
+    uint32_t totalRequestedFps = setRequestedFps(requestedFps);
+
+    uint8_t fps = requestedFps;
+    if (requestedFps > 0 && totalRequestedFps > MAX_TOTAL_WEB_FPS) {
+        fps = std::max(MIN_WEB_FPS, (uint8_t)((uint32_t)requestedFps * MAX_TOTAL_WEB_FPS / totalRequestedFps));
+    }
+    webSurface->setMaxFps(fps);
+}
+
+uint32_t WebEntityRenderer::setRequestedFps(uint8_t requestedFps) {
+    int32_t delta = (int32_t)requestedFps - (int32_t)_requestedFps;
+    _requestedFps = requestedFps;
+    return _totalRequestedFps += delta;
 }
 
 void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) {
@@ -268,24 +315,44 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
 
 void WebEntityRenderer::doRender(RenderArgs* args) {
     PerformanceTimer perfTimer("WebEntityRenderer::render");
-    withWriteLock([&] {
-        _lastRenderTime = usecTimestampNow();
-    });
+    // the shadows don't tell whether the surface is on screen
+    bool isShadow = args->_renderMode == RenderArgs::RenderMode::SHADOW_RENDER_MODE;
+    if (!isShadow) {
+        withWriteLock([&] {
+            _lastRenderTime = usecTimestampNow();
+            glm::vec3 dimensions = _renderTransform.getScale();
+            float distance = glm::distance(_renderTransform.getTranslation(), args->getViewFrustum().getPosition());
+            _angularSize = glm::max(dimensions.x, dimensions.y) / glm::max(distance, EPSILON);
+        });
+    }
 
     // Try to update the texture
     OffscreenQmlSurface::TextureAndFence newTextureAndFence;
     bool newTextureAvailable = false;
+    bool isPaused = false;
     if (!resultWithReadLock<bool>([&] {
         if (!_webSurface) {
             return false;
         }
 
         newTextureAvailable = _webSurface->fetchTexture(newTextureAndFence);
+        isPaused = _webSurface->isPaused();
         return true;
     })) {
         return;
     }
 
+    // it was paused while off screen, it keeps showing its last texture until it renders again
+    if (isPaused && !isShadow) {
+        QMetaObject::invokeMethod(this, [this] {
+            withReadLock([&] {
+                if (_webSurface && _webSurface->isPaused()) {
+                    _webSurface->resume();
+                }
+            });
+        }, Qt::QueuedConnection);
+    }
+
     if (newTextureAvailable) {
         _texture->setExternalTexture(newTextureAndFence.first, newTextureAndFence.second);
     }
@@ -349,6 +416,8 @@ void WebEntityRenderer::buildWebSurface(const EntityItemPointer& entity, const Q
 }
 
 void WebEntityRenderer::destroyWebSurface() {
+    setRequestedFps(0);
+
     QSharedPointer<OffscreenQmlSurface> webSurface;
     withWriteLock([&] {
         webSurface.swap(_webSurface);
@@ -69,6 +69,8 @@ protected:
 
 private:
     void onTimeout();
+    // returns the frames per second requested by all the web-views
+    uint32_t setRequestedFps(uint8_t requestedFps);
     void buildWebSurface(const EntityItemPointer& entity, const QString& newSourceURL);
     void destroyWebSurface();
     glm::vec2 getWindowSize(const TypedEntityPointer& entity) const;
@@ -103,6 +105,8 @@ private:
 
     QTimer _timer;
     uint64_t _lastRenderTime { 0 };
+    float _angularSize { 0.0f };
+    uint8_t _requestedFps { 0 };
 
     std::vector<QMetaObject::Connection> _connections;
 
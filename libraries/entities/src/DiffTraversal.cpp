@@ -11,10 +11,15 @@
 
 #include "DiffTraversal.h"
 
+#include <CullingBatch.h>
 #include <OctreeUtils.h>
 
 #include "EntityPriorityQueue.h"
 
+// the invisible entities and the zones draw nothing of their own, they yield to the visible content of the same size,
+// but aren't culled any sooner
+static const float NON_VISUAL_PRIORITY_WEIGHT = 0.25f;
+
 DiffTraversal::Waypoint::Waypoint(EntityTreeElementPointer& element) : _nextIndex(0) {
     assert(element);
     _weakElement = element;
@@ -37,7 +42,7 @@ void DiffTraversal::Waypoint::getNextVisibleElementFirstTime(DiffTraversal::Visi
             while (_nextIndex < NUMBER_OF_CHILDREN) {
                 EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
                 ++_nextIndex;
-                if (nextElement && view.shouldTraverseElement(*nextElement)) {
+                if (nextElement && isChildTraversable(_nextIndex - 1, *element, view)) {
                     next.element = nextElement;
                     return;
                 }
@@ -66,7 +71,7 @@ void DiffTraversal::Waypoint::getNextVisibleElementRepeat(
                 ++_nextIndex;
                 if (nextElement &&
                     nextElement->getLastChanged() > lastTime &&
-                    view.shouldTraverseElement(*nextElement)) {
+                    isChildTraversable(_nextIndex - 1, *element, view)) {
 
                     next.element = nextElement;
                     return;
@@ -91,7 +96,7 @@ void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::V
             while (_nextIndex < NUMBER_OF_CHILDREN) {
                 EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
                 ++_nextIndex;
-                if (nextElement && view.shouldTraverseElement(*nextElement)) {
+                if (nextElement && isChildTraversable(_nextIndex - 1, *element, view)) {
                     next.element = nextElement;
                     return;
                 }
@@ -101,6 +106,15 @@ void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::V
     next.element.reset();
 }
 
+bool DiffTraversal::Waypoint::isChildTraversable(int childIndex, const EntityTreeElement& element, const View& view) {
+    // the view doesn't change during a traversal, the children are tested all at once the first time one is needed
+    if (!_hasTestedChildren) {
+        _traversableChildren = view.getTraversableChildren(element);
+        _hasTestedChildren = true;
+    }
+    return (_traversableChildren & (1 << childIndex)) != 0;
+}
+
 bool DiffTraversal::View::usesViewFrustums() const {
     return !viewFrustums.empty();
 }
@@ -140,10 +154,12 @@ float DiffTraversal::View::computePriority(const EntityItemPointer& entity) cons
     auto radius = 0.5f * SQRT_THREE * cube.getScale(); // radius of bounding sphere
 
     auto priority = PrioritizedEntity::DO_NOT_SEND;
+    bool containsView = false;
 
     for (const auto& frustum : viewFrustums) {
         auto position = center - frustum.getPosition(); // position of bounding sphere in view-frame
         float distance = glm::length(position); // distance to center of bounding sphere
+        containsView = containsView || distance < radius;
 
         // Check the size of the entity, it's possible that a "too small to see" entity is included in a
         // larger octree cell because of its position (for example if it crosses the boundary of a cell it
@@ -159,6 +175,12 @@ float DiffTraversal::View::computePriority(const EntityItemPointer& entity) cons
         }
     }
 
+    // the zone the viewer is in sets its lighting, skybox and haze, it isn't put behind anything
+    bool isNonVisual = !entity->getVisible() || entity->getType() == EntityTypes::Zone;
+    if (priority != PrioritizedEntity::DO_NOT_SEND && isNonVisual && !containsView) {
+        priority *= NON_VISUAL_PRIORITY_WEIGHT;
+    }
+
     return priority;
 }
 
@@ -188,6 +210,34 @@ bool DiffTraversal::View::shouldTraverseElement(const EntityTreeElement& element
     });
 }
 
+uint8_t DiffTraversal::View::getTraversableChildren(const EntityTreeElement& element) const {
+    static_assert(NUMBER_OF_CHILDREN <= CULLING_BATCH_SIZE, "The children are tested in one batch");
+    uint8_t children = 0;
+    CullingSphereBatch spheres;
+    for (int i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+        EntityTreeElementPointer child = element.getChildAtIndex(i);
+        if (child) {
+            const auto& cube = child->getAACube();
+            spheres.add(cube.calcCenter(), 0.5f * SQRT_THREE * cube.getScale()); // bounding sphere
+            children |= 1 << i;
+        } else {
+            spheres.add(glm::vec3(0.0f), 0.0f);
+        }
+    }
+
+    if (!usesViewFrustums()) {
+        return children;
+    }
+
+    // see shouldTraverseElement
+    float minAngularSize = lodScaleFactor * MIN_ELEMENT_ANGULAR_DIAMETER;
+    uint8_t traversable = 0;
+    for (const auto& frustum : viewFrustums) {
+        traversable |= frustum.intersects(spheres, minAngularSize);
+    }
+    return traversable & children;
+}
+
 DiffTraversal::DiffTraversal() {
     const int32_t MIN_PATH_DEPTH = 16;
     _path.reserve(MIN_PATH_DEPTH);
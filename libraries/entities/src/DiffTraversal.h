@@ -33,6 +33,8 @@ public:
         bool isVerySimilar(const View& view) const;
 
         bool shouldTraverseElement(const EntityTreeElement& element) const;
+        // the children of the element that should be traversed, tested at once, a bit per child
+        uint8_t getTraversableChildren(const EntityTreeElement& element) const;
         float computePriority(const EntityItemPointer& entity) const;
 
         ConicalViewFrustums viewFrustums;
@@ -53,8 +55,12 @@ public:
         void initRootNextIndex() { _nextIndex = -1; }
 
     protected:
+        bool isChildTraversable(int childIndex, const EntityTreeElement& element, const View& view);
+
         EntityTreeElementWeakPointer _weakElement;
         int8_t _nextIndex;
+        uint8_t _traversableChildren { 0 };
+        bool _hasTestedChildren { false };
     };
 
     typedef enum { First, Repeat, Differential } Type;
@@ -73,6 +79,10 @@ public:
 
     void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
 
+    // finishes the prepared traversal as if it had walked the tree with view, for when the results of a very similar
+    // traversal elsewhere were used instead. The next Repeat picks up what changed since view.startTime.
+    void adoptCompletedTraversal(const View& view) { _path.clear(); _currentView = view; _completedView = view; }
+
 private:
     void getNextVisibleElement(VisibleElement& next);
 
@@ -24,6 +24,9 @@
 #include "EntityItem.h"
 #include "EntityItemProperties.h"
 
+// the edits merged for an entity are sent after at most this long, even if the queued messages aren't released
+static const quint64 MAX_PENDING_EDIT_USECS = USECS_PER_SECOND / 60;
+
 EntityEditPacketSender::EntityEditPacketSender() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerDirectListener(PacketType::EntityEditNack,
@@ -35,7 +38,8 @@ void EntityEditPacketSender::processEntityEditNackPacket(QSharedPointer<Received
 }
 
 void EntityEditPacketSender::adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) {
-    if (type == PacketType::EntityAdd || type == PacketType::EntityEdit || type == PacketType::EntityPhysics) {
+    if (type == PacketType::EntityAdd || type == PacketType::EntityEdit || type == PacketType::EntityPhysics ||
+            type == PacketType::BulkEntityPhysics) {
         EntityItem::adjustEditPacketForClockSkew(buffer, clockSkew);
     }
 }
@@ -95,6 +99,74 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
         return;
     }
 
+    if (type == PacketType::EntityEdit || type == PacketType::EntityPhysics) {
+        std::lock_guard<std::mutex> lock(_pendingEditsMutex);
+        auto pendingEdit = _pendingEdits.find(entityItemID);
+        if (pendingEdit != _pendingEdits.end()) {
+            if (pendingEdit->type == type) {
+                pendingEdit->properties.merge(properties);
+                pendingEdit->properties.setLastEdited(properties.getLastEdited());
+                return;
+            }
+            // the edits of an entity go out in order when its type of edit changes
+            encodeEntityEditMessage(pendingEdit->type, entityItemID, pendingEdit->properties);
+            _pendingEdits.erase(pendingEdit);
+        }
+        if (_pendingEdits.empty()) {
+            _oldestPendingEditTime = usecTimestampNow();
+        }
+        _pendingEdits.insert(entityItemID, { type, properties });
+        _pendingEditOrder.push_back(entityItemID);
+        return;
+    }
+
+    // the adds go out after the edits queued before them
+    flushPendingEdits();
+    encodeEntityEditMessage(type, entityItemID, properties);
+}
+
+void EntityEditPacketSender::flushPendingEdits() {
+    std::lock_guard<std::mutex> lock(_pendingEditsMutex);
+    for (const auto& entityItemID : _pendingEditOrder) {
+        auto pendingEdit = _pendingEdits.find(entityItemID);
+        if (pendingEdit != _pendingEdits.end()) {
+            encodeEntityEditMessage(pendingEdit->type, entityItemID, pendingEdit->properties);
+            _pendingEdits.erase(pendingEdit);
+        }
+    }
+    _pendingEdits.clear();
+    _pendingEditOrder.clear();
+}
+
+void EntityEditPacketSender::releaseQueuedMessages() {
+    flushPendingEdits();
+    OctreeEditPacketSender::releaseQueuedMessages();
+}
+
+bool EntityEditPacketSender::process() {
+    bool hasPendingEdits;
+    {
+        std::lock_guard<std::mutex> lock(_pendingEditsMutex);
+        hasPendingEdits = !_pendingEdits.empty() && usecTimestampNow() - _oldestPendingEditTime > MAX_PENDING_EDIT_USECS;
+    }
+    if (hasPendingEdits) {
+        flushPendingEdits();
+    }
+    return OctreeEditPacketSender::process();
+}
+
+void EntityEditPacketSender::encodeEntityEditMessage(PacketType type, const EntityItemID& entityItemID,
+                                                     const EntityItemProperties& properties) {
+    if (type == PacketType::EntityPhysics) {
+        // the motion and ownership updates of many entities go in one packet
+        QByteArray bulkMessage;
+        auto sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
+        if (EntityItemProperties::encodeBulkEntityPhysicsMessage(entityItemID, properties, sessionID, bulkMessage)) {
+            queueOctreeEditMessage(PacketType::BulkEntityPhysics, bulkMessage);
+            return;
+        }
+    }
+
     QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
 
     if (type == PacketType::EntityAdd) {
@@ -152,6 +224,7 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
 }
 
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
+    flushPendingEdits();
 
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
 
@@ -161,6 +234,7 @@ void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityI
 }
 
 void EntityEditPacketSender::queueCloneEntityMessage(const EntityItemID& entityIDToClone, const EntityItemID& newEntityID) {
+    flushPendingEdits();
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityClone), 0);
 
     if (EntityItemProperties::encodeCloneEntityMessage(entityIDToClone, newEntityID, bufferOut)) {
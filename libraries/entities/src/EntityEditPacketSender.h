@@ -16,7 +16,11 @@
 
 #include <mutex>
 
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
 #include "EntityItem.h"
+#include "EntityItemProperties.h"
 #include "AvatarData.h"
 
 /// Utility for processing, packing, queueing and sending of outbound edit voxel messages.
@@ -32,6 +36,7 @@ public:
     /// which voxel-server node or nodes the packet should be sent to. Can be called even before voxel servers are known, in
     /// which case up to MaxPendingMessages will be buffered and processed when voxel servers are known.
     /// NOTE: EntityItemProperties assumes that all distances are in meter units
+    /// The edit and physics messages of an entity are merged until they are released, the later values of a property win.
     void queueEditEntityMessage(PacketType type, EntityTreePointer entityTree,
                                 EntityItemID entityItemID, const EntityItemProperties& properties);
 
@@ -43,6 +48,9 @@ public:
     virtual char getMyNodeType() const override { return NodeType::EntityServer; }
     virtual void adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) override;
 
+    virtual void releaseQueuedMessages() override;
+    virtual bool process() override;
+
 signals:
     void addingEntityWithCertificate(const QString& certificateID, const QString& placeName);
 
@@ -53,8 +61,21 @@ private:
     friend class MyAvatar;
     void queueEditAvatarEntityMessage(EntityTreePointer entityTree, EntityItemID entityItemID);
 
+    void encodeEntityEditMessage(PacketType type, const EntityItemID& entityItemID, const EntityItemProperties& properties);
+    void flushPendingEdits();
+
 private:
+    struct PendingEdit {
+        PacketType type;
+        EntityItemProperties properties;
+    };
+
     std::mutex _mutex;
     AvatarData* _myAvatar { nullptr };
+
+    std::mutex _pendingEditsMutex;
+    QHash<EntityItemID, PendingEdit> _pendingEdits;
+    QVector<EntityItemID> _pendingEditOrder; // by first edit, an entity can be listed again after its type of edit changed
+    quint64 _oldestPendingEditTime { 0 };
 };
 #endif // hifi_EntityEditPacketSender_h
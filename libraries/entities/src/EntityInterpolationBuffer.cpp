@@ -0,0 +1,137 @@
+//
+//  EntityInterpolationBuffer.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityInterpolationBuffer.h"
+
+#include <cmath>
+
+#include <SharedUtil.h>
+
+const quint64 EntityInterpolationBuffer::MIN_DELAY = USECS_PER_SECOND / 30;
+const quint64 EntityInterpolationBuffer::MAX_DELAY = USECS_PER_SECOND / 2;
+const int EntityInterpolationBuffer::MAX_SNAPSHOTS = 8;
+
+// how fast the averages follow the changes in the updates
+static const float AVERAGE_TIMESCALE = 0.1f;
+// the delay is the interval plus this many times the jitter of the arrivals
+static const float JITTER_MARGIN = 2.0f;
+
+static glm::quat slerpShortest(const glm::quat& a, const glm::quat& b, float alpha) {
+    return glm::normalize(glm::slerp(a, glm::dot(a, b) < 0.0f ? -b : b, alpha));
+}
+
+static quint64 computeDelay(float averageInterval, float latencyJitter) {
+    float delay = averageInterval + JITTER_MARGIN * latencyJitter;
+    return glm::clamp((quint64)delay, EntityInterpolationBuffer::MIN_DELAY, EntityInterpolationBuffer::MAX_DELAY);
+}
+
+void EntityInterpolationBuffer::addSnapshot(const Snapshot& snapshot, quint64 arrival, const QUuid& parentID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // the states are only comparable in the same frame
+    if (parentID != _parentID) {
+        _snapshots.clear();
+        _parentID = parentID;
+    }
+
+    float latency = (float)((qint64)arrival - (qint64)snapshot.timestamp);
+    if (_snapshots.empty()) {
+        _averageLatency = latency;
+        _snapshots.push_back(snapshot);
+        return;
+    }
+    if (snapshot.timestamp <= _snapshots.back().timestamp) {
+        // late or repeated
+        return;
+    }
+
+    float interval = (float)(snapshot.timestamp - _snapshots.back().timestamp);
+    if (_averageInterval == 0.0f) {
+        _averageInterval = interval;
+    } else {
+        _averageInterval += AVERAGE_TIMESCALE * (interval - _averageInterval);
+    }
+    _averageLatency += AVERAGE_TIMESCALE * (latency - _averageLatency);
+    _latencyJitter += AVERAGE_TIMESCALE * (fabsf(latency - _averageLatency) - _latencyJitter);
+
+    _snapshots.push_back(snapshot);
+
+    // drop the ones that no sample can fall after any more
+    quint64 oldestSampleTime = arrival > MAX_DELAY ? arrival - MAX_DELAY : 0;
+    while ((int)_snapshots.size() > MAX_SNAPSHOTS ||
+           (_snapshots.size() > 2 && _snapshots[1].timestamp <= oldestSampleTime)) {
+        _snapshots.pop_front();
+    }
+}
+
+bool EntityInterpolationBuffer::sample(quint64 now, Snapshot& result, float& extrapolationTime) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    extrapolationTime = 0.0f;
+    if (_snapshots.empty()) {
+        return false;
+    }
+
+    quint64 delay = computeDelay(_averageInterval, _latencyJitter);
+    quint64 sampleTime = now > delay ? now - delay : 0;
+
+    if (sampleTime <= _snapshots.front().timestamp) {
+        result = _snapshots.front();
+        return true;
+    }
+    if (sampleTime >= _snapshots.back().timestamp) {
+        result = _snapshots.back();
+        extrapolationTime = (float)(sampleTime - result.timestamp) / (float)USECS_PER_SECOND;
+        return true;
+    }
+
+    size_t next = 1;
+    while (_snapshots[next].timestamp < sampleTime) {
+        next++;
+    }
+    const Snapshot& a = _snapshots[next - 1];
+    const Snapshot& b = _snapshots[next];
+
+    // a cubic Hermite curve through both positions with their velocities, so that it doesn't bend at the snapshots
+    float dt = (float)(b.timestamp - a.timestamp) / (float)USECS_PER_SECOND;
+    float s = (float)(sampleTime - a.timestamp) / (float)(b.timestamp - a.timestamp);
+    float s2 = s * s;
+    float s3 = s2 * s;
+    float h00 = 2.0f * s3 - 3.0f * s2 + 1.0f;
+    float h10 = s3 - 2.0f * s2 + s;
+    float h01 = -2.0f * s3 + 3.0f * s2;
+    float h11 = s3 - s2;
+
+    result.timestamp = sampleTime;
+    result.position = h00 * a.position + h10 * dt * a.velocity + h01 * b.position + h11 * dt * b.velocity;
+    result.rotation = slerpShortest(a.rotation, b.rotation, s);
+    result.velocity = glm::mix(a.velocity, b.velocity, s);
+    result.angularVelocity = glm::mix(a.angularVelocity, b.angularVelocity, s);
+    return true;
+}
+
+quint64 EntityInterpolationBuffer::getDelay() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return computeDelay(_averageInterval, _latencyJitter);
+}
+
+bool EntityInterpolationBuffer::isEmpty() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _snapshots.empty();
+}
+
+void EntityInterpolationBuffer::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _snapshots.clear();
+    _parentID = QUuid();
+    _averageInterval = 0.0f;
+    _averageLatency = 0.0f;
+    _latencyJitter = 0.0f;
+}
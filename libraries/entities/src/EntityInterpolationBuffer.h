@@ -0,0 +1,67 @@
+//
+//  EntityInterpolationBuffer.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityInterpolationBuffer_h
+#define hifi_EntityInterpolationBuffer_h
+
+#include <deque>
+#include <mutex>
+
+#include <QtCore/QUuid>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// The recent states of an entity that someone else simulates, as they were sent, so that its motion can be played back a
+// little in the past between two of them instead of extrapolated from the last one, which jitters whenever an update
+// corrects the extrapolation.
+//
+// The delay behind the newest state adapts to the interval at which the simulation owner sends them and to how much
+// their arrival varies, so that a state is usually there before it is needed.
+//
+//   EntityInterpolationBuffer is thread-safe.
+class EntityInterpolationBuffer {
+public:
+    struct Snapshot {
+        quint64 timestamp { 0 }; // when it was simulated, in local time
+        glm::vec3 position; // in the frame of the parent, as the velocities
+        glm::quat rotation;
+        glm::vec3 velocity;
+        glm::vec3 angularVelocity;
+    };
+
+    static const quint64 MIN_DELAY; // usecs
+    static const quint64 MAX_DELAY; // usecs
+    static const int MAX_SNAPSHOTS;
+
+    // arrival is when it was received, in local time, parentID is the one the snapshot is relative to
+    void addSnapshot(const Snapshot& snapshot, quint64 arrival, const QUuid& parentID);
+
+    // The state at now minus the delay, between the two snapshots around it. After the newest one extrapolationTime is
+    // how far past it that is, in seconds, otherwise it is 0. False if there is no snapshot.
+    bool sample(quint64 now, Snapshot& result, float& extrapolationTime) const;
+
+    quint64 getDelay() const;
+    bool isEmpty() const;
+    void clear();
+
+private:
+    mutable std::mutex _mutex;
+    std::deque<Snapshot> _snapshots;
+    QUuid _parentID;
+
+    // smoothed, in usecs
+    float _averageInterval { 0.0f };
+    float _averageLatency { 0.0f };
+    float _latencyJitter { 0.0f };
+};
+
+#endif // hifi_EntityInterpolationBuffer_h
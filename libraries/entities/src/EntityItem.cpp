@@ -31,6 +31,7 @@
 #include <Profile.h>
 #include <RegisteredMetaTypes.h>
 #include <SharedUtil.h> // usecTimestampNow()
+#include <StringPool.h>
 #include <LogHandler.h>
 #include <Extents.h>
 #include <QVariantGLM.h>
@@ -49,6 +50,8 @@ int entityItemPointernMetaTypeId = qRegisterMetaType<EntityItemPointer>();
 
 int EntityItem::_maxActionsDataSize = 800;
 quint64 EntityItem::_rememberDeletedActionTime = 20 * USECS_PER_SECOND;
+AtomicUIntStat EntityItem::_encodedDataHits { 0 };
+AtomicUIntStat EntityItem::_encodedDataMisses { 0 };
 QString EntityItem::_marketplacePublicKey;
 
 EntityItem::EntityItem(const EntityItemID& entityItemID) :
@@ -71,6 +74,16 @@ EntityItem::~EntityItem() {
     assert(!_simulated || (!_element && !_physicsInfo));
     assert(!_element);
     assert(!_physicsInfo);
+    if (_grabProperties) {
+        _numGrabPropertyGroups--;
+    }
+}
+
+std::atomic<int> EntityItem::_numGrabPropertyGroups { 0 };
+
+const GrabPropertyGroup& EntityItem::getGrabProperties() const {
+    static const GrabPropertyGroup DEFAULT_GRAB_PROPERTIES;
+    return _grabProperties ? *_grabProperties : DEFAULT_GRAB_PROPERTIES;
 }
 
 EntityPropertyFlags EntityItem::getEntityProperties(EncodeBitstreamParams& params) const {
@@ -105,7 +118,7 @@ EntityPropertyFlags EntityItem::getEntityProperties(EncodeBitstreamParams& param
     requestedProperties += PROP_IGNORE_PICK_INTERSECTION;
     requestedProperties += PROP_RENDER_WITH_ZONES;
     requestedProperties += PROP_BILLBOARD_MODE;
-    requestedProperties += _grabProperties.getEntityProperties(params);
+    requestedProperties += getGrabProperties().getEntityProperties(params);
 
     // Physics
     requestedProperties += PROP_DENSITY;
@@ -168,6 +181,19 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     OctreeElement::AppendState appendState = OctreeElement::COMPLETED; // assume the best
 
+    // Nothing has changed since we last encoded all of this entity, copy that unless it doesn't fit. Subsequent passes
+    // for a partially encoded entity always go property by property.
+    bool isSubsequentPass = entityTreeElementExtraEncodeData &&
+        entityTreeElementExtraEncodeData->entities.contains(getEntityItemID());
+    if (!isSubsequentPass) {
+        QByteArray encodedData = getEncodedData(destinationNodeCanGetAndSetPrivateUserData);
+        if (!encodedData.isEmpty() && packetData->appendRawData(encodedData)) {
+            params.trackSend(getID(), getLastEdited());
+            return appendState;
+        }
+    }
+    int startOfEncodedData = packetData->getUncompressedByteOffset();
+
     // encode our ID as a byte count coded byte stream
     QByteArray encodedID = getID().toRfc4122();
 
@@ -303,7 +329,7 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         APPEND_ENTITY_PROPERTY(PROP_RENDER_WITH_ZONES, getRenderWithZones());
         APPEND_ENTITY_PROPERTY(PROP_BILLBOARD_MODE, (uint32_t)getBillboardMode());
         withReadLock([&] {
-            _grabProperties.appendSubclassData(packetData, params, entityTreeElementExtraEncodeData, requestedProperties,
+            getGrabProperties().appendSubclassData(packetData, params, entityTreeElementExtraEncodeData, requestedProperties,
                 propertyFlags, propertiesDidntFit, propertyCount, appendState);
         });
 
@@ -397,9 +423,38 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         params.trackSend(getID(), getLastEdited());
     }
 
+    if (appendState == OctreeElement::COMPLETED && !isSubsequentPass) {
+        int encodedSize = packetData->getUncompressedByteOffset() - startOfEncodedData;
+        setEncodedData(destinationNodeCanGetAndSetPrivateUserData,
+            QByteArray((const char*)packetData->getUncompressedData(startOfEncodedData), encodedSize));
+    }
+
     return appendState;
 }
 
+QByteArray EntityItem::getEncodedData(bool includesPrivateUserData) const {
+    std::lock_guard<std::mutex> lock(_encodedDataMutex);
+    const EncodedData& encodedData = _encodedData[includesPrivateUserData ? 1 : 0];
+    if (!encodedData.bytes.isEmpty() && encodedData.lastEdited == getLastEdited() &&
+        encodedData.lastUpdated == getLastUpdated() && encodedData.lastSimulated == getLastSimulated() &&
+        encodedData.lastChangedOnServer == getLastChangedOnServer()) {
+        ++_encodedDataHits;
+        return encodedData.bytes;
+    }
+    ++_encodedDataMisses;
+    return QByteArray();
+}
+
+void EntityItem::setEncodedData(bool includesPrivateUserData, const QByteArray& bytes) const {
+    std::lock_guard<std::mutex> lock(_encodedDataMutex);
+    EncodedData& encodedData = _encodedData[includesPrivateUserData ? 1 : 0];
+    encodedData.lastEdited = getLastEdited();
+    encodedData.lastUpdated = getLastUpdated();
+    encodedData.lastSimulated = getLastSimulated();
+    encodedData.lastChangedOnServer = getLastChangedOnServer();
+    encodedData.bytes = bytes;
+}
+
 // TODO: My goal is to get rid of this concept completely. The old code (and some of the current code) used this
 // result to calculate if a packet being sent to it was potentially bad or corrupt. I've adjusted this to now
 // only consider the minimum header bytes as being required. But it would be preferable to completely eliminate
@@ -876,9 +931,21 @@ int EntityItem::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
     READ_ENTITY_PROPERTY(PROP_RENDER_WITH_ZONES, QVector<QUuid>, setRenderWithZones);
     READ_ENTITY_PROPERTY(PROP_BILLBOARD_MODE, BillboardMode, setBillboardMode);
     withWriteLock([&] {
-        int bytesFromGrab = _grabProperties.readEntitySubclassDataFromBuffer(dataAt, (bytesLeftToRead - bytesRead), args,
-            propertyFlags, overwriteLocalData,
-            somethingChanged);
+        int bytesFromGrab;
+        if (_grabProperties) {
+            bytesFromGrab = _grabProperties->readEntitySubclassDataFromBuffer(dataAt, (bytesLeftToRead - bytesRead), args,
+                propertyFlags, overwriteLocalData,
+                somethingChanged);
+        } else {
+            GrabPropertyGroup grabProperties;
+            bytesFromGrab = grabProperties.readEntitySubclassDataFromBuffer(dataAt, (bytesLeftToRead - bytesRead), args,
+                propertyFlags, overwriteLocalData,
+                somethingChanged);
+            if (!grabProperties.isDefault()) {
+                _grabProperties = std::make_unique<GrabPropertyGroup>(grabProperties);
+                _numGrabPropertyGroups++;
+            }
+        }
         bytesRead += bytesFromGrab;
         dataAt += bytesFromGrab;
     });
@@ -980,11 +1047,30 @@ int EntityItem::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
         // NOTE: We don't want to do this in the hasGrab case because grabs "know best"
         // (e.g. grabs will prevent drift between distributed physics simulations).
         //
-        float skipTimeForward = (float)(now - lastSimulatedFromBufferAdjusted) / (float)(USECS_PER_SECOND);
+        // The kinematic motion of an entity that someone else simulates is played back a little in the past, between
+        // the states they send, so that it doesn't jitter when a state corrects the extrapolation of the previous one.
+        // The dynamic ones are simulated here by Bullet, and the avatar entities follow their avatar. A state that
+        // stops it is shown right away, as nothing would step it there.
+        bool interpolate = !weOwnSimulation && !_simulationOwner.isNull() && (!getDynamic() || !getParentID().isNull()) &&
+            getEntityHostType() != entity::HostType::AVATAR && isMovingRelativeToParent();
+        if (interpolate) {
+            EntityInterpolationBuffer::Snapshot snapshot;
+            Transform transform;
+            getLocalTransformAndVelocities(transform, snapshot.velocity, snapshot.angularVelocity);
+            snapshot.timestamp = lastSimulatedFromBufferAdjusted;
+            snapshot.position = transform.getTranslation();
+            snapshot.rotation = transform.getRotation();
+            _interpolationBuffer.addSnapshot(snapshot, now, getParentID());
+            stepInterpolatedMotion();
+        } else {
+            _interpolationBuffer.clear();
+
+            float skipTimeForward = (float)(now - lastSimulatedFromBufferAdjusted) / (float)(USECS_PER_SECOND);
 
-        // we want to extrapolate the motion forward to compensate for packet travel time, but
-        // we don't want the side effect of flag setting.
-        stepKinematicMotion(skipTimeForward);
+            // we want to extrapolate the motion forward to compensate for packet travel time, but
+            // we don't want the side effect of flag setting.
+            stepKinematicMotion(skipTimeForward);
+        }
     }
 
     if (overwriteLocalData) {
@@ -1094,7 +1180,7 @@ void EntityItem::setCollisionSoundURL(const QString& value) {
     bool modified = false;
     withWriteLock([&] {
         if (_collisionSoundURL != value) {
-            _collisionSoundURL = value;
+            _collisionSoundURL = StringPool::intern(value);
             modified = true;
         }
     });
@@ -1163,6 +1249,45 @@ void EntityItem::simulate(const quint64& now) {
 
 bool EntityItem::stepKinematicMotion(float timeElapsed) {
     DETAILED_PROFILE_RANGE(simulation_physics, "StepKinematicMotion");
+    if (!_interpolationBuffer.isEmpty()) {
+        if (isSimulatedRemotely()) {
+            return stepInterpolatedMotion();
+        }
+        // the simulation has stopped, or we have taken it over
+        _interpolationBuffer.clear();
+    }
+    return integrateKinematicMotion(timeElapsed);
+}
+
+bool EntityItem::isSimulatedRemotely() const {
+    QUuid simulatorID = getSimulatorID();
+    return !simulatorID.isNull() && simulatorID != Physics::getSessionUUID();
+}
+
+bool EntityItem::stepInterpolatedMotion() {
+    EntityInterpolationBuffer::Snapshot snapshot;
+    float extrapolationTime;
+    if (!_interpolationBuffer.sample(usecTimestampNow(), snapshot, extrapolationTime)) {
+        return isMovingRelativeToParent();
+    }
+
+    Transform transform;
+    glm::vec3 linearVelocity;
+    glm::vec3 angularVelocity;
+    getLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
+    transform.setTranslation(snapshot.position);
+    transform.setRotation(snapshot.rotation);
+    setLocalTransformAndVelocities(transform, snapshot.velocity, snapshot.angularVelocity);
+
+    if (extrapolationTime > 0.0f) {
+        // past the newest state it carries on from it, until the next one arrives
+        const float MAX_EXTRAPOLATION_TIME = 1.0f; // seconds
+        return integrateKinematicMotion(glm::min(extrapolationTime, MAX_EXTRAPOLATION_TIME));
+    }
+    return true;
+}
+
+bool EntityItem::integrateKinematicMotion(float timeElapsed) {
     // get all the data
     Transform transform;
     glm::vec3 linearVelocity;
@@ -1360,7 +1485,7 @@ EntityItemProperties EntityItem::getProperties(const EntityPropertyFlags& desire
     COPY_ENTITY_PROPERTY_TO_PROPERTIES(renderWithZones, getRenderWithZones);
     COPY_ENTITY_PROPERTY_TO_PROPERTIES(billboardMode, getBillboardMode);
     withReadLock([&] {
-        _grabProperties.getProperties(properties);
+        getGrabProperties().getProperties(properties);
     });
 
     // Physics
@@ -1511,7 +1636,17 @@ bool EntityItem::setProperties(const EntityItemProperties& properties) {
     SET_ENTITY_PROPERTY_FROM_PROPERTIES(renderWithZones, setRenderWithZones);
     SET_ENTITY_PROPERTY_FROM_PROPERTIES(billboardMode, setBillboardMode);
     withWriteLock([&] {
-        bool grabPropertiesChanged = _grabProperties.setProperties(properties);
+        bool grabPropertiesChanged;
+        if (_grabProperties) {
+            grabPropertiesChanged = _grabProperties->setProperties(properties);
+        } else {
+            GrabPropertyGroup grabProperties;
+            grabPropertiesChanged = grabProperties.setProperties(properties);
+            if (!grabProperties.isDefault()) {
+                _grabProperties = std::make_unique<GrabPropertyGroup>(grabProperties);
+                _numGrabPropertyGroups++;
+            }
+        }
         somethingChanged |= grabPropertiesChanged;
     });
 
@@ -2644,9 +2779,12 @@ QList<EntityDynamicPointer> EntityItem::getActionsOfType(EntityDynamicType typeT
 
 void EntityItem::locationChanged(bool tellPhysics, bool tellChildren) {
     requiresRecalcBoxes();
+    EntityTreePointer tree = getTree();
+    if (tree) {
+        tree->updateEntityPickBounds(getEntityItemID());
+    }
     if (tellPhysics) {
         _flags |= Simulation::DIRTY_TRANSFORM;
-        EntityTreePointer tree = getTree();
         if (tree) {
             tree->entityChanged(getThisPointer());
         }
@@ -2661,6 +2799,10 @@ void EntityItem::dimensionsChanged() {
     requiresRecalcBoxes();
     SpatiallyNestable::dimensionsChanged(); // Do what you have to do
     _boundingRadius = 0.5f * glm::length(getScaledDimensions());
+    EntityTreePointer tree = getTree();
+    if (tree) {
+        tree->updateEntityPickBounds(getEntityItemID());
+    }
     std::pair<int32_t, glm::vec4> data(_spaceIndex, glm::vec4(getWorldPosition(), _boundingRadius));
     emit spaceUpdate(data);
     somethingChangedNotification();
@@ -2890,9 +3032,18 @@ QString EntityItem::getScript() const {
 }
 
 void EntityItem::setScript(const QString& value) {
+    bool hadScript = false;
     withWriteLock([&] {
-        _script = value;
+        hadScript = !_script.isEmpty();
+        _script = StringPool::intern(value);
     });
+
+    if (hadScript != !value.isEmpty()) {
+        EntityTreePointer tree = getTree();
+        if (tree) {
+            tree->updateEntityScriptIndex(getEntityItemID(), !value.isEmpty());
+        }
+    }
 }
 
 quint64 EntityItem::getScriptTimestamp() const {
@@ -2919,7 +3070,7 @@ QString EntityItem::getServerScripts() const {
 
 void EntityItem::setServerScripts(const QString& serverScripts) {
     withWriteLock([&] {
-        _serverScripts = serverScripts;
+        _serverScripts = StringPool::intern(serverScripts);
         _serverScriptsChangedTimestamp = usecTimestampNow();
     });
 }
@@ -2955,9 +3106,18 @@ QString EntityItem::getName() const {
 }
 
 void EntityItem::setName(const QString& value) {
+    bool changed = false;
     withWriteLock([&] {
+        changed = _name != value;
         _name = value;
     });
+
+    if (changed) {
+        EntityTreePointer tree = getTree();
+        if (tree) {
+            tree->updateEntityNameIndex(getEntityItemID(), value);
+        }
+    }
 }
 
 QString EntityItem::getDebugName() {
@@ -3150,7 +3310,7 @@ QString EntityItem::getUserData() const {
 
 void EntityItem::setUserData(const QString& value) {
     withWriteLock([&] {
-        _userData = value;
+        _userData = StringPool::intern(value);
     });
 }
 
@@ -3563,9 +3723,9 @@ void EntityItem::addGrab(GrabPointer grab) {
             arguments["timeScale"] = 0.05;
             arguments["relativePosition"] = vec3ToQMap(grab->getPositionalOffset());
             arguments["relativeRotation"] = quatToQMap(grab->getRotationalOffset());
-            arguments["kinematic"] = _grabProperties.getGrabKinematic();
+            arguments["kinematic"] = getGrabProperties().getGrabKinematic();
             arguments["kinematicSetVelocity"] = true;
-            arguments["ignoreIK"] = _grabProperties.getGrabFollowsController();
+            arguments["ignoreIK"] = getGrabProperties().getGrabFollowsController();
         }
         EntityDynamicPointer action = actionFactory->factory(dynamicType, actionID, getThisPointer(), arguments);
         grab->setActionID(actionID);
@@ -12,7 +12,9 @@
 #ifndef hifi_EntityItem_h
 #define hifi_EntityItem_h
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 
 #include <glm/glm.hpp>
@@ -36,6 +38,7 @@
 #include "EntityTypes.h"
 #include "SimulationOwner.h"
 #include "EntityDynamicInterface.h"
+#include "EntityInterpolationBuffer.h"
 #include "GrabPropertyGroup.h"
 
 class EntitySimulation;
@@ -159,6 +162,10 @@ public:
                                                 { somethingChanged = false; return 0; }
     static int expectedBytes();
 
+    // how often appendEntityData() could copy a previous encode instead of encoding every property again
+    static uintmax_t getEncodedDataHits() { return _encodedDataHits; }
+    static uintmax_t getEncodedDataMisses() { return _encodedDataMisses; }
+
     static void adjustEditPacketForClockSkew(QByteArray& buffer, qint64 clockSkew);
 
     // perform update
@@ -566,7 +573,8 @@ public:
     void setCloneIDs(const QVector<QUuid>& cloneIDs);
     void setVisuallyReady(bool visuallyReady) { _visuallyReady = visuallyReady; }
 
-    const GrabPropertyGroup& getGrabProperties() const { return _grabProperties; }
+    const GrabPropertyGroup& getGrabProperties() const;
+    static int getNumGrabPropertyGroups() { return _numGrabPropertyGroups; }
 
     void prepareForSimulationOwnershipBid(EntityItemProperties& properties, uint64_t now, uint8_t priority);
 
@@ -602,6 +610,10 @@ protected:
     bool stillHasGrab() const;
     void setDynamicDataInternal(QByteArray dynamicData);
 
+    bool integrateKinematicMotion(float timeElapsed);
+    bool isSimulatedRemotely() const;
+    bool stepInterpolatedMotion();
+
     virtual void dimensionsChanged() override;
 
     glm::vec3 _unscaledDimensions { ENTITY_ITEM_DEFAULT_DIMENSIONS };
@@ -728,6 +740,22 @@ protected:
     static quint64 _rememberDeletedActionTime;
     mutable QHash<QUuid, quint64> _previouslyDeletedActions;
 
+    // the last complete appendEntityData() output, with and without the private user data. It is good for as long as
+    // none of the timestamps it was encoded with have moved.
+    struct EncodedData {
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 lastChangedOnServer { 0 };
+        QByteArray bytes;
+    };
+    QByteArray getEncodedData(bool includesPrivateUserData) const;
+    void setEncodedData(bool includesPrivateUserData, const QByteArray& bytes) const;
+    mutable EncodedData _encodedData[2];
+    mutable std::mutex _encodedDataMutex;
+    static AtomicUIntStat _encodedDataHits;
+    static AtomicUIntStat _encodedDataMisses;
+
     QUuid _sourceUUID; /// the server node UUID we came from
 
     entity::HostType _hostType { entity::HostType::DOMAIN };
@@ -751,6 +779,9 @@ protected:
     quint64 _lastUpdatedQueryAACubeTimestamp { 0 };
     uint64_t _simulationOwnershipExpiry { 0 };
 
+    // the states sent by someone else who simulates this entity, which its kinematic motion plays back
+    EntityInterpolationBuffer _interpolationBuffer;
+
     float _boundingRadius { 0.0f };
     int32_t _spaceIndex { -1 }; // index to proxy in workload::Space
 
@@ -772,7 +803,9 @@ protected:
     QUuid _cloneOriginID;
     QVector<QUuid> _cloneIDs;
 
-    GrabPropertyGroup _grabProperties;
+    // most entities keep the default grab properties, they are only allocated once they differ
+    std::unique_ptr<GrabPropertyGroup> _grabProperties;
+    static std::atomic<int> _numGrabPropertyGroups;
 
     QHash<QUuid, EntityDynamicPointer> _grabActions;
 
@@ -4041,6 +4041,235 @@ bool EntityItemProperties::decodeCloneEntityMessage(const QByteArray& buffer, in
     return true;
 }
 
+enum BulkEntityPhysicsFlags : uint8_t {
+    BULK_PHYSICS_POSITION = 0x01,
+    BULK_PHYSICS_ROTATION = 0x02,
+    BULK_PHYSICS_VELOCITY = 0x04,
+    BULK_PHYSICS_ANGULAR_VELOCITY = 0x08,
+    BULK_PHYSICS_ACCELERATION = 0x10,
+    BULK_PHYSICS_QUERY_AA_CUBE = 0x20,
+    BULK_PHYSICS_SIMULATION_OWNER = 0x40
+};
+
+// the velocities are sent as fixed point numbers of two bytes, the ones out of range make a whole EntityPhysics edit
+static const int BULK_PHYSICS_VELOCITY_RADIX = 8; // 4 mm/s up to 128 m/s
+static const int BULK_PHYSICS_ANGULAR_VELOCITY_RADIX = 10; // 1 mrad/s up to 32 rad/s
+static const int BULK_PHYSICS_ACCELERATION_RADIX = 8; // up to 128 m/s^2, more than the 10 g gravity allows
+
+static bool fitsTwoByteFixed(const glm::vec3& value, int radix) {
+    const float MAX_VALUE = (float)INT16_MAX / (float)(1 << radix);
+    return glm::all(glm::lessThanEqual(glm::abs(value), glm::vec3(MAX_VALUE)));
+}
+
+bool EntityItemProperties::encodeBulkEntityPhysicsMessage(const EntityItemID& id, const EntityItemProperties& properties,
+                                                          const QUuid& sessionID, QByteArray& buffer) {
+    EntityPropertyFlags bulkProperties;
+    bulkProperties += PROP_POSITION;
+    bulkProperties += PROP_ROTATION;
+    bulkProperties += PROP_VELOCITY;
+    bulkProperties += PROP_ANGULAR_VELOCITY;
+    bulkProperties += PROP_ACCELERATION;
+    bulkProperties += PROP_QUERY_AA_CUBE;
+    bulkProperties += PROP_SIMULATION_OWNER;
+    // not sent over the wire
+    bulkProperties += PROP_ENTITY_HOST_TYPE;
+    bulkProperties += PROP_OWNING_AVATAR_ID;
+
+    EntityPropertyFlags changedProperties = properties.getChangedProperties();
+    for (int flag = (int)changedProperties.firstFlag(); flag <= (int)changedProperties.lastFlag(); flag++) {
+        if (changedProperties.getHasProperty((EntityPropertyList)flag) && !bulkProperties.getHasProperty((EntityPropertyList)flag)) {
+            return false;
+        }
+    }
+
+    uint8_t flags = 0;
+    if (properties.positionChanged()) {
+        flags |= BULK_PHYSICS_POSITION;
+    }
+    if (properties.rotationChanged()) {
+        flags |= BULK_PHYSICS_ROTATION;
+    }
+    if (properties.velocityChanged()) {
+        if (!fitsTwoByteFixed(properties.getVelocity(), BULK_PHYSICS_VELOCITY_RADIX)) {
+            return false;
+        }
+        flags |= BULK_PHYSICS_VELOCITY;
+    }
+    if (properties.angularVelocityChanged()) {
+        if (!fitsTwoByteFixed(properties.getAngularVelocity(), BULK_PHYSICS_ANGULAR_VELOCITY_RADIX)) {
+            return false;
+        }
+        flags |= BULK_PHYSICS_ANGULAR_VELOCITY;
+    }
+    if (properties.accelerationChanged()) {
+        if (!fitsTwoByteFixed(properties.getAcceleration(), BULK_PHYSICS_ACCELERATION_RADIX)) {
+            return false;
+        }
+        flags |= BULK_PHYSICS_ACCELERATION;
+    }
+    if (properties.queryAACubeChanged()) {
+        flags |= BULK_PHYSICS_QUERY_AA_CUBE;
+    }
+    uint8_t priority = 0;
+    if (properties.simulationOwnerChanged()) {
+        // only our own simulation ownership can be bid or released
+        const SimulationOwner& owner = properties.getSimulationOwner();
+        if (!owner.getID().isNull()) {
+            if (owner.getID() != sessionID || owner.getPriority() == 0) {
+                return false;
+            }
+            priority = owner.getPriority();
+        }
+        flags |= BULK_PHYSICS_SIMULATION_OWNER;
+    }
+
+    // same header as the other edit messages, so that the clock skew is adjusted the same way
+    vec3 rootPosition(0);
+    float rootScale = 0.5f;
+    unsigned char* octcode = pointToOctalCode(rootPosition.x, rootPosition.y, rootPosition.z, rootScale);
+    int octcodeLength = (int)bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(octcode));
+
+    const int MAX_BULK_PHYSICS_MESSAGE_SIZE = octcodeLength + sizeof(quint64) + NUM_BYTES_RFC4122_UUID + sizeof(flags) +
+        sizeof(glm::vec3) + 6 + 3 * 6 + sizeof(glm::vec3) + sizeof(float) + sizeof(priority);
+    buffer.resize(MAX_BULK_PHYSICS_MESSAGE_SIZE);
+    unsigned char* copyAt = reinterpret_cast<unsigned char*>(buffer.data());
+
+    memcpy(copyAt, octcode, octcodeLength);
+    copyAt += octcodeLength;
+    delete[] octcode;
+
+    quint64 lastEdited = properties.getLastEdited();
+    memcpy(copyAt, &lastEdited, sizeof(lastEdited));
+    copyAt += sizeof(lastEdited);
+
+    memcpy(copyAt, id.toRfc4122().constData(), NUM_BYTES_RFC4122_UUID);
+    copyAt += NUM_BYTES_RFC4122_UUID;
+
+    *copyAt++ = flags;
+
+    if (flags & BULK_PHYSICS_POSITION) {
+        glm::vec3 position = properties.getPosition();
+        memcpy(copyAt, &position, sizeof(position));
+        copyAt += sizeof(position);
+    }
+    if (flags & BULK_PHYSICS_ROTATION) {
+        copyAt += packOrientationQuatToSixBytes(copyAt, properties.getRotation());
+    }
+    if (flags & BULK_PHYSICS_VELOCITY) {
+        copyAt += packFloatVec3ToSignedTwoByteFixed(copyAt, properties.getVelocity(), BULK_PHYSICS_VELOCITY_RADIX);
+    }
+    if (flags & BULK_PHYSICS_ANGULAR_VELOCITY) {
+        copyAt += packFloatVec3ToSignedTwoByteFixed(copyAt, properties.getAngularVelocity(),
+                                                     BULK_PHYSICS_ANGULAR_VELOCITY_RADIX);
+    }
+    if (flags & BULK_PHYSICS_ACCELERATION) {
+        copyAt += packFloatVec3ToSignedTwoByteFixed(copyAt, properties.getAcceleration(), BULK_PHYSICS_ACCELERATION_RADIX);
+    }
+    if (flags & BULK_PHYSICS_QUERY_AA_CUBE) {
+        AACube queryAACube = properties.getQueryAACube();
+        glm::vec3 corner = queryAACube.getCorner();
+        float scale = queryAACube.getScale();
+        memcpy(copyAt, &corner, sizeof(corner));
+        copyAt += sizeof(corner);
+        memcpy(copyAt, &scale, sizeof(scale));
+        copyAt += sizeof(scale);
+    }
+    if (flags & BULK_PHYSICS_SIMULATION_OWNER) {
+        *copyAt++ = priority;
+    }
+
+    buffer.resize((int)(copyAt - reinterpret_cast<unsigned char*>(buffer.data())));
+    return true;
+}
+
+bool EntityItemProperties::decodeBulkEntityPhysicsMessage(const unsigned char* data, int bytesToRead, int& processedBytes,
+                                                          const QUuid& senderID, EntityItemID& entityID,
+                                                          EntityItemProperties& properties) {
+    const unsigned char* dataAt = data;
+    processedBytes = 0;
+
+    int octets = numberOfThreeBitSectionsInCode(data, bytesToRead);
+    if (octets < 0) {
+        return false;
+    }
+    int octcodeLength = (int)bytesRequiredForCodeLength(octets);
+    const int MIN_BULK_PHYSICS_MESSAGE_SIZE = octcodeLength + sizeof(quint64) + NUM_BYTES_RFC4122_UUID + sizeof(uint8_t);
+    if (bytesToRead < MIN_BULK_PHYSICS_MESSAGE_SIZE) {
+        qCDebug(entities) << "EntityItemProperties::decodeBulkEntityPhysicsMessage().... bailing because not enough bytes in buffer";
+        return false;
+    }
+    dataAt += octcodeLength;
+
+    quint64 lastEdited;
+    memcpy(&lastEdited, dataAt, sizeof(lastEdited));
+    dataAt += sizeof(lastEdited);
+    properties.setLastEdited(lastEdited);
+
+    entityID = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(dataAt), NUM_BYTES_RFC4122_UUID));
+    dataAt += NUM_BYTES_RFC4122_UUID;
+
+    uint8_t flags = *dataAt++;
+
+    int size = 0;
+    size += (flags & BULK_PHYSICS_POSITION) ? (int)sizeof(glm::vec3) : 0;
+    size += (flags & BULK_PHYSICS_ROTATION) ? 6 : 0;
+    size += (flags & BULK_PHYSICS_VELOCITY) ? 6 : 0;
+    size += (flags & BULK_PHYSICS_ANGULAR_VELOCITY) ? 6 : 0;
+    size += (flags & BULK_PHYSICS_ACCELERATION) ? 6 : 0;
+    size += (flags & BULK_PHYSICS_QUERY_AA_CUBE) ? (int)(sizeof(glm::vec3) + sizeof(float)) : 0;
+    size += (flags & BULK_PHYSICS_SIMULATION_OWNER) ? 1 : 0;
+    if (bytesToRead < MIN_BULK_PHYSICS_MESSAGE_SIZE + size) {
+        qCDebug(entities) << "EntityItemProperties::decodeBulkEntityPhysicsMessage().... bailing because not enough bytes in buffer";
+        return false;
+    }
+
+    if (flags & BULK_PHYSICS_POSITION) {
+        glm::vec3 position;
+        memcpy(&position, dataAt, sizeof(position));
+        dataAt += sizeof(position);
+        properties.setPosition(position);
+    }
+    if (flags & BULK_PHYSICS_ROTATION) {
+        glm::quat rotation;
+        dataAt += unpackOrientationQuatFromSixBytes(dataAt, rotation);
+        properties.setRotation(rotation);
+    }
+    if (flags & BULK_PHYSICS_VELOCITY) {
+        glm::vec3 velocity;
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, velocity, BULK_PHYSICS_VELOCITY_RADIX);
+        properties.setVelocity(velocity);
+    }
+    if (flags & BULK_PHYSICS_ANGULAR_VELOCITY) {
+        glm::vec3 angularVelocity;
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, angularVelocity, BULK_PHYSICS_ANGULAR_VELOCITY_RADIX);
+        properties.setAngularVelocity(angularVelocity);
+    }
+    if (flags & BULK_PHYSICS_ACCELERATION) {
+        glm::vec3 acceleration;
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, acceleration, BULK_PHYSICS_ACCELERATION_RADIX);
+        properties.setAcceleration(acceleration);
+    }
+    if (flags & BULK_PHYSICS_QUERY_AA_CUBE) {
+        glm::vec3 corner;
+        float scale;
+        memcpy(&corner, dataAt, sizeof(corner));
+        dataAt += sizeof(corner);
+        memcpy(&scale, dataAt, sizeof(scale));
+        dataAt += sizeof(scale);
+        properties.setQueryAACube(AACube(corner, scale));
+    }
+    if (flags & BULK_PHYSICS_SIMULATION_OWNER) {
+        uint8_t priority = *dataAt++;
+        // decoded as the whole edit messages are, a null owner for a release
+        QByteArray ownerData = priority == 0 ? QUuid().toRfc4122() : senderID.toRfc4122();
+        ownerData.append(priority);
+        properties.setSimulationOwner(ownerData);
+    }
+
+    processedBytes = (int)(dataAt - data);
+    return true;
+}
+
 void EntityItemProperties::markAllChanged() {
     // Core
     _simulationOwnerChanged = true;
@@ -432,6 +432,15 @@ public:
     static bool decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
                                        EntityItemID& entityID, EntityItemProperties& properties);
 
+    // The physics edits that only carry the motion and the simulation ownership of an entity are sent in a compact form,
+    // with the velocities quantized, and many of them go in one BulkEntityPhysics packet. Returns false if the properties
+    // don't fit that form, and the edit has to be sent as a whole EntityPhysics message.
+    static bool encodeBulkEntityPhysicsMessage(const EntityItemID& id, const EntityItemProperties& properties,
+                                               const QUuid& sessionID, QByteArray& buffer);
+    // the simulation owner of the message is the sender
+    static bool decodeBulkEntityPhysicsMessage(const unsigned char* data, int bytesToRead, int& processedBytes,
+                                               const QUuid& senderID, EntityItemID& entityID, EntityItemProperties& properties);
+
     void clearID() { _id = UNKNOWN_ENTITY_ID; _idSet = false; }
     void markAllChanged();
 
@@ -15,6 +15,7 @@
 
 #include "EntityItemID.h"
 #include <RegisteredMetaTypes.h>
+#include <StringPool.h>
 
 #define APPEND_ENTITY_PROPERTY(P,V) \
         if (requestedProperties.getHasProperty(P)) {                \
@@ -230,7 +231,11 @@ inline uint32_t uint32_t_convertFromScriptValue(const QScriptValue& v, bool& isV
 inline int int_convertFromScriptValue(const QScriptValue& v, bool& isValid) { return v.toVariant().toInt(&isValid); }
 inline bool bool_convertFromScriptValue(const QScriptValue& v, bool& isValid) { isValid = true; return v.toVariant().toBool(); }
 inline uint8_t uint8_t_convertFromScriptValue(const QScriptValue& v, bool& isValid) { isValid = true; return (uint8_t)(0xff & v.toVariant().toInt(&isValid)); }
-inline QString QString_convertFromScriptValue(const QScriptValue& v, bool& isValid) { isValid = true; return v.toVariant().toString().trimmed(); }
+inline QString QString_convertFromScriptValue(const QScriptValue& v, bool& isValid) {
+    isValid = true;
+    // the URLs of the entities loaded from the models file or made by the scripts share their strings, as the decoded ones
+    return StringPool::getInstance().intern(v.toVariant().toString().trimmed());
+}
 inline QUuid QUuid_convertFromScriptValue(const QScriptValue& v, bool& isValid) { isValid = true; return v.toVariant().toUuid(); }
 inline EntityItemID EntityItemID_convertFromScriptValue(const QScriptValue& v, bool& isValid) { isValid = true; return v.toVariant().toUuid(); }
 
@@ -334,6 +339,7 @@ inline QRect QRect_convertFromScriptValue(const QScriptValue& v, bool& isValid)
 {                                   \
     if (other._##P##Changed) {      \
         _##P = other._##P;          \
+        _##P##Changed = true;       \
     }                               \
 }
 
@@ -791,104 +791,179 @@ QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScri
     return finalResult;
 }
 
+QScriptValue EntityScriptingInterface::editEntities(QScriptContext* context, QScriptEngine* engine) {
+    const int ARGUMENT_ENTITY_IDS = 0;
+    const int ARGUMENT_PROPERTIES = 1;
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    const auto entityIDs = qscriptvalue_cast<QVector<QUuid>>(context->argument(ARGUMENT_ENTITY_IDS));
+    const QScriptValue propertiesValue = context->argument(ARGUMENT_PROPERTIES);
+
+    // either the same properties for all the entities or the properties for each of them
+    QVector<EntityItemProperties> properties;
+    if (propertiesValue.isArray()) {
+        const int length = propertiesValue.property("length").toInt32();
+        if (length != entityIDs.size()) {
+            context->throwError(QScriptContext::RangeError, "Entities.editEntities: there must be properties for each entity");
+            return QScriptValue();
+        }
+        properties.resize(length);
+        for (int i = 0; i < length; ++i) {
+            EntityItemPropertiesFromScriptValueHonorReadOnly(propertiesValue.property(i), properties[i]);
+        }
+    } else {
+        EntityItemProperties sharedProperties;
+        EntityItemPropertiesFromScriptValueHonorReadOnly(propertiesValue, sharedProperties);
+        properties.fill(sharedProperties, entityIDs.size());
+    }
+
+    return qScriptValueFromSequence(engine, entityScriptingInterface->editEntitiesInternal(entityIDs, properties));
+}
+
 QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProperties& scriptSideProperties) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
-    _activityTracking.editedEntityCount++;
+    return editEntitiesInternal({ id }, { scriptSideProperties }).first();
+}
+
+QVector<QUuid> EntityScriptingInterface::editEntitiesInternal(const QVector<QUuid>& ids,
+                                                              const QVector<EntityItemProperties>& scriptSideProperties) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    // the tree is locked for each batch of edits rather than each edit, but not so long that other threads stall
+    const int EDITS_PER_LOCK = 500;
+
+    QVector<QUuid> results;
+    results.reserve(ids.size());
+    for (int i = 0; i < ids.size(); i += EDITS_PER_LOCK) {
+        results.append(editEntityBatch(ids.mid(i, EDITS_PER_LOCK), scriptSideProperties.mid(i, EDITS_PER_LOCK)));
+    }
+    return results;
+}
+
+QVector<QUuid> EntityScriptingInterface::editEntityBatch(const QVector<QUuid>& ids,
+                                                         const QVector<EntityItemProperties>& scriptSideProperties) {
+    _activityTracking.editedEntityCount += ids.size();
 
     const auto sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
 
-    EntityItemProperties properties = scriptSideProperties;
+    struct Edit {
+        EntityItemID entityID;
+        EntityItemProperties properties;
+        EntityItemPointer entity;
+        SimulationOwner simulationOwner;
+        bool hasQueryAACubeRelatedChanges { false };
+    };
+    std::vector<Edit> edits(ids.size());
+    for (int i = 0; i < ids.size(); ++i) {
+        edits[i].entityID = EntityItemID(ids[i]);
+        edits[i].properties = scriptSideProperties[i];
+    }
+    QVector<QUuid> results = ids;
 
-    EntityItemID entityID(id);
     if (!_entityTree) {
-        properties.setLastEditedBy(sessionID);
-        queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-        return id;
+        for (auto& edit : edits) {
+            edit.properties.setLastEditedBy(sessionID);
+            queueEntityMessage(PacketType::EntityEdit, edit.entityID, edit.properties);
+        }
+        return results;
     }
 
-    EntityItemPointer entity(nullptr);
-    SimulationOwner simulationOwner;
     _entityTree->withReadLock([&] {
-        // make a copy of entity for local logic outside of tree lock
-        entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (!entity) {
-            return;
-        }
+        for (auto& edit : edits) {
+            // make a copy of entity for local logic outside of tree lock
+            edit.entity = _entityTree->findEntityByEntityItemID(edit.entityID);
+            if (!edit.entity) {
+                continue;
+            }
 
-        if (entity->isAvatarEntity() && !entity->isMyAvatarEntity()) {
-            // don't edit other avatar's avatarEntities
-            properties = EntityItemProperties();
-            return;
+            if (edit.entity->isAvatarEntity() && !edit.entity->isMyAvatarEntity()) {
+                // don't edit other avatar's avatarEntities
+                edit.properties = EntityItemProperties();
+                continue;
+            }
+            // make a copy of simulationOwner for local logic outside of tree lock
+            edit.simulationOwner = edit.entity->getSimulationOwner();
         }
-        // make a copy of simulationOwner for local logic outside of tree lock
-        simulationOwner = entity->getSimulationOwner();
     });
 
-    QString previousUserdata;
-    if (entity) {
-        if (properties.hasTransformOrVelocityChanges() && entity->hasGrabs()) {
-            // if an entity is grabbed, the grab will override any position changes
-            properties.clearTransformOrVelocityChanges();
-        }
-        if (properties.hasSimulationRestrictedChanges()) {
-            if (_bidOnSimulationOwnership) {
-                // flag for simulation ownership, or upgrade existing ownership priority
-                // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
-                entity->upgradeScriptSimulationPriority(properties.computeSimulationBidPriority());
-                if (entity->isLocalEntity() || entity->isMyAvatarEntity() || simulationOwner.getID() == sessionID) {
-                    // we own the simulation --> copy ALL restricted properties
-                    properties.copySimulationRestrictedProperties(entity);
-                } else {
-                    // we don't own the simulation but think we would like to
-
-                    uint8_t desiredPriority = entity->getScriptSimulationPriority();
-                    if (desiredPriority < simulationOwner.getPriority()) {
-                        // the priority at which we'd like to own it is not high enough
-                        // --> assume failure and clear all restricted property changes
-                        properties.clearSimulationRestrictedProperties();
-                    } else {
-                        // the priority at which we'd like to own it is high enough to win.
-                        // --> assume success and copy ALL restricted properties
+    std::vector<bool> isSkipped(edits.size(), false);
+    for (size_t i = 0; i < edits.size(); ++i) {
+        EntityItemProperties& properties = edits[i].properties;
+        const EntityItemPointer& entity = edits[i].entity;
+        const SimulationOwner& simulationOwner = edits[i].simulationOwner;
+
+        QString previousUserdata;
+        if (entity) {
+            if (properties.hasTransformOrVelocityChanges() && entity->hasGrabs()) {
+                // if an entity is grabbed, the grab will override any position changes
+                properties.clearTransformOrVelocityChanges();
+            }
+            if (properties.hasSimulationRestrictedChanges()) {
+                if (_bidOnSimulationOwnership) {
+                    // flag for simulation ownership, or upgrade existing ownership priority
+                    // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
+                    entity->upgradeScriptSimulationPriority(properties.computeSimulationBidPriority());
+                    if (entity->isLocalEntity() || entity->isMyAvatarEntity() || simulationOwner.getID() == sessionID) {
+                        // we own the simulation --> copy ALL restricted properties
                         properties.copySimulationRestrictedProperties(entity);
+                    } else {
+                        // we don't own the simulation but think we would like to
+
+                        uint8_t desiredPriority = entity->getScriptSimulationPriority();
+                        if (desiredPriority < simulationOwner.getPriority()) {
+                            // the priority at which we'd like to own it is not high enough
+                            // --> assume failure and clear all restricted property changes
+                            properties.clearSimulationRestrictedProperties();
+                        } else {
+                            // the priority at which we'd like to own it is high enough to win.
+                            // --> assume success and copy ALL restricted properties
+                            properties.copySimulationRestrictedProperties(entity);
+                        }
                     }
+                } else if (!simulationOwner.getID().isNull()) {
+                    // someone owns this but not us
+                    // clear restricted properties
+                    properties.clearSimulationRestrictedProperties();
                 }
-            } else if (!simulationOwner.getID().isNull()) {
-                // someone owns this but not us
-                // clear restricted properties
-                properties.clearSimulationRestrictedProperties();
+                // clear the cached simulationPriority level
+                entity->upgradeScriptSimulationPriority(0);
             }
-            // clear the cached simulationPriority level
-            entity->upgradeScriptSimulationPriority(0);
-        }
 
-        // set these to make EntityItemProperties::getScalesWithParent() work correctly
-        entity::HostType entityHostType = entity->getEntityHostType();
-        properties.setEntityHostType(entityHostType);
-        if (entityHostType == entity::HostType::LOCAL) {
-            properties.setCollisionless(true);
-        }
-        properties.setOwningAvatarID(entity->getOwningAvatarID());
+            // set these to make EntityItemProperties::getScalesWithParent() work correctly
+            entity::HostType entityHostType = entity->getEntityHostType();
+            properties.setEntityHostType(entityHostType);
+            if (entityHostType == entity::HostType::LOCAL) {
+                properties.setCollisionless(true);
+            }
+            properties.setOwningAvatarID(entity->getOwningAvatarID());
 
-        // make sure the properties has a type, so that the encode can know which properties to include
-        properties.setType(entity->getType());
+            // make sure the properties has a type, so that the encode can know which properties to include
+            properties.setType(entity->getType());
 
-        previousUserdata = entity->getUserData();
-    } else if (_bidOnSimulationOwnership) {
-        // bail when simulation participants don't know about entity
-        return QUuid();
-    }
-    // TODO: it is possible there is no remaining useful changes in properties and we should bail early.
-    // How to check for this cheaply?
+            previousUserdata = entity->getUserData();
+        } else if (_bidOnSimulationOwnership) {
+            // bail when simulation participants don't know about entity
+            results[(int)i] = QUuid();
+            isSkipped[i] = true;
+            continue;
+        }
+        // TODO: it is possible there is no remaining useful changes in properties and we should bail early.
+        // How to check for this cheaply?
 
-    properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
-    synchronizeEditedGrabProperties(properties, previousUserdata);
-    properties.setLastEditedBy(sessionID);
+        properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
+        synchronizeEditedGrabProperties(properties, previousUserdata);
+        properties.setLastEditedBy(sessionID);
+        edits[i].hasQueryAACubeRelatedChanges = properties.queryAACubeRelatedPropertyChanged();
+    }
 
     // done reading and modifying properties --> start write
-    bool updatedEntity = false;
     _entityTree->withWriteLock([&] {
-        updatedEntity = _entityTree->updateEntity(entityID, properties);
+        for (size_t i = 0; i < edits.size(); ++i) {
+            if (!isSkipped[i]) {
+                _entityTree->updateEntity(edits[i].entityID, edits[i].properties);
+            }
+        }
     });
 
     // FIXME: We need to figure out a better way to handle this. Allowing these edits to go through potentially
@@ -900,80 +975,96 @@ QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProp
     //     return QUuid();
     // }
 
-    bool hasQueryAACubeRelatedChanges = properties.queryAACubeRelatedPropertyChanged();
     // done writing, send update
     _entityTree->withReadLock([&] {
-        // find the entity again: maybe it was removed since we last found it
-        entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (entity) {
-            uint64_t now = usecTimestampNow();
-            entity->setLastBroadcast(now);
-
-            if (hasQueryAACubeRelatedChanges) {
-                properties.setQueryAACube(entity->getQueryAACube());
-
-                // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
-                // if they've changed.
-                entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
-                    if (descendant->getNestableType() == NestableType::Entity) {
-                        if (descendant->updateQueryAACube()) {
-                            EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
-                            EntityItemProperties newQueryCubeProperties;
-                            newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
-                            newQueryCubeProperties.setLastEdited(properties.getLastEdited());
-                            queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
-                            entityDescendant->setLastBroadcast(now);
+        uint64_t now = usecTimestampNow();
+        for (size_t i = 0; i < edits.size(); ++i) {
+            if (isSkipped[i]) {
+                continue;
+            }
+            const EntityItemProperties& properties = edits[i].properties;
+
+            // find the entity again: maybe it was removed since we last found it
+            EntityItemPointer entity = _entityTree->findEntityByEntityItemID(edits[i].entityID);
+            edits[i].entity = entity;
+            if (entity) {
+                entity->setLastBroadcast(now);
+
+                if (edits[i].hasQueryAACubeRelatedChanges) {
+                    edits[i].properties.setQueryAACube(entity->getQueryAACube());
+
+                    // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
+                    // if they've changed.
+                    entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+                        if (descendant->getNestableType() == NestableType::Entity) {
+                            if (descendant->updateQueryAACube()) {
+                                EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
+                                EntityItemProperties newQueryCubeProperties;
+                                newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
+                                newQueryCubeProperties.setLastEdited(properties.getLastEdited());
+                                queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
+                                entityDescendant->setLastBroadcast(now);
+                            }
                         }
-                    }
-                });
+                    });
+                }
             }
         }
     });
-    if (!entity) {
-        if (hasQueryAACubeRelatedChanges) {
-            // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
-            // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
-            // This is because, on the script side, "position" is in world frame, but in the network
-            // protocol and in the internal data-structures, "position" is "relative to parent".
-            // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
-            if (properties.localPositionChanged()) {
-                properties.setPosition(properties.getLocalPosition());
-            }
-            if (properties.localRotationChanged()) {
-                properties.setRotation(properties.getLocalRotation());
-            }
-            if (properties.localVelocityChanged()) {
-                properties.setVelocity(properties.getLocalVelocity());
-            }
-            if (properties.localAngularVelocityChanged()) {
-                properties.setAngularVelocity(properties.getLocalAngularVelocity());
-            }
-            if (properties.localDimensionsChanged()) {
-                properties.setDimensions(properties.getLocalDimensions());
+
+    for (size_t i = 0; i < edits.size(); ++i) {
+        if (isSkipped[i]) {
+            continue;
+        }
+        EntityItemProperties& properties = edits[i].properties;
+
+        if (!edits[i].entity) {
+            if (edits[i].hasQueryAACubeRelatedChanges) {
+                // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
+                // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
+                // This is because, on the script side, "position" is in world frame, but in the network
+                // protocol and in the internal data-structures, "position" is "relative to parent".
+                // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
+                if (properties.localPositionChanged()) {
+                    properties.setPosition(properties.getLocalPosition());
+                }
+                if (properties.localRotationChanged()) {
+                    properties.setRotation(properties.getLocalRotation());
+                }
+                if (properties.localVelocityChanged()) {
+                    properties.setVelocity(properties.getLocalVelocity());
+                }
+                if (properties.localAngularVelocityChanged()) {
+                    properties.setAngularVelocity(properties.getLocalAngularVelocity());
+                }
+                if (properties.localDimensionsChanged()) {
+                    properties.setDimensions(properties.getLocalDimensions());
+                }
             }
-        }
-        // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
-        // print a warning and don't send an edit packet to the entity-server.
-        QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
-        if (parentFinder) {
-            bool success;
-            auto nestableWP = parentFinder->find(id, success, static_cast<SpatialParentTree*>(_entityTree.get()));
-            if (success) {
-                auto nestable = nestableWP.lock();
-                if (nestable) {
-                    NestableType nestableType = nestable->getNestableType();
-                    if (nestableType == NestableType::Avatar) {
-                        qCWarning(entities) << "attempted edit on non-entity: " << id << nestable->getName();
-                        return QUuid(); // null script value to indicate failure
+            // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
+            // print a warning and don't send an edit packet to the entity-server.
+            QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
+            if (parentFinder) {
+                bool success;
+                auto nestableWP = parentFinder->find(ids[(int)i], success, static_cast<SpatialParentTree*>(_entityTree.get()));
+                if (success) {
+                    auto nestable = nestableWP.lock();
+                    if (nestable) {
+                        NestableType nestableType = nestable->getNestableType();
+                        if (nestableType == NestableType::Avatar) {
+                            qCWarning(entities) << "attempted edit on non-entity: " << ids[(int)i] << nestable->getName();
+                            results[(int)i] = QUuid(); // null script value to indicate failure
+                            continue;
+                        }
                     }
                 }
             }
         }
+        // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
+        // to edit entities they know only by ID.  The edits are packed together into as few packets as fit them.
+        queueEntityMessage(PacketType::EntityEdit, edits[i].entityID, properties);
     }
-    // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
-    // to edit entities they know only by ID.
-    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-    return id;
+    return results;
 }
 
 void EntityScriptingInterface::deleteEntity(const QUuid& id) {
@@ -1287,6 +1378,31 @@ RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionVecto
     return evalRayIntersectionWorker(ray, Octree::Lock, searchFilter, entityIdsToInclude, entityIdsToDiscard);
 }
 
+std::vector<RayToEntityIntersectionResult> EntityScriptingInterface::evalRayIntersectionVectors(std::vector<EntityTree::RayPick>& picks) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    std::vector<RayToEntityIntersectionResult> results(picks.size());
+    if (_entityTree) {
+        bool accurate = false;
+        _entityTree->evalRayIntersections(picks, Octree::Lock, &accurate);
+        for (size_t i = 0; i < picks.size(); i++) {
+            const EntityTree::RayPick& pick = picks[i];
+            RayToEntityIntersectionResult& result = results[i];
+            result.entityID = pick.entityID;
+            result.intersects = !result.entityID.isNull();
+            result.accurate = accurate;
+            result.distance = pick.distance;
+            result.face = pick.face;
+            result.surfaceNormal = pick.surfaceNormal;
+            result.extraInfo = pick.extraInfo;
+            if (result.intersects) {
+                result.intersection = pick.origin + (pick.direction * result.distance);
+            }
+        }
+    }
+    return results;
+}
+
 RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionWorker(const PickRay& ray,
         Octree::lockType lockType, PickFilter searchFilter, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard) const {
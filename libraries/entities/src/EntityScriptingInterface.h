@@ -189,6 +189,8 @@ public:
 
     RayToEntityIntersectionResult evalRayIntersectionVector(const PickRay& ray, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
+    // the intersections of all the rays, found in a single walk of the tree
+    std::vector<RayToEntityIntersectionResult> evalRayIntersectionVectors(std::vector<EntityTree::RayPick>& picks);
     ParabolaToEntityIntersectionResult evalParabolaIntersectionVector(const PickParabola& parabola, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
 
@@ -211,6 +213,26 @@ public:
     static QScriptValue getMultipleEntityProperties(QScriptContext* context, QScriptEngine* engine);
     QScriptValue getMultipleEntityPropertiesInternal(QScriptEngine* engine, QVector<QUuid> entityIDs, const QScriptValue& extendedDesiredProperties);
 
+    /*@jsdoc
+     * Edits multiple entities, changing one or more of their property values. This is much faster than calling 
+     * {@link Entities.editEntity|editEntity} for each entity when editing many entities at once.
+     * @function Entities.editEntities
+     * @param {Uuid[]} entityIDs - The IDs of the entities to edit.
+     * @param {Entities.EntityProperties[]|Entities.EntityProperties} properties - The new property values for each entity, in 
+     *     the same order as <code>entityIDs</code>, or the new property values for all the entities.
+     * @returns {Uuid[]} For each entity, its ID if the edit was successful, otherwise <code>null</code> or 
+     *     {@link Uuid|Uuid.NULL}.
+     * @example <caption>Raise the nearby entities by 1m.</caption>
+     * var SEARCH_RADIUS = 50; // meters
+     * var entityIDs = Entities.findEntities(MyAvatar.position, SEARCH_RADIUS);
+     * var propertySets = Entities.getMultipleEntityProperties(entityIDs, "position");
+     * Entities.editEntities(entityIDs, propertySets.map(function (properties) {
+     *     return { position: Vec3.sum(properties.position, { x: 0, y: 1, z: 0 }) };
+     * }));
+     */
+    static QScriptValue editEntities(QScriptContext* context, QScriptEngine* engine);
+    QVector<QUuid> editEntitiesInternal(const QVector<QUuid>& entityIDs, const QVector<EntityItemProperties>& properties);
+
     QUuid addEntityInternal(const EntityItemProperties& properties, entity::HostType entityHostType);
 
 public slots:
@@ -2546,6 +2568,8 @@ private:
     bool polyVoxWorker(QUuid entityID, std::function<bool(PolyVoxEntityItem&)> actor);
     bool setPoints(QUuid entityID, std::function<bool(LineEntityItem&)> actor);
     void queueEntityMessage(PacketType packetType, EntityItemID entityID, const EntityItemProperties& properties);
+    // edits the entities with each lock of the tree taken once for all of them
+    QVector<QUuid> editEntityBatch(const QVector<QUuid>& entityIDs, const QVector<EntityItemProperties>& properties);
     bool addLocalEntityCopy(EntityItemProperties& propertiesWithSimID, EntityItemID& id, bool isClone = false);
 
     EntityItemPointer checkForTreeEntityAndTypeMatch(const QUuid& entityID,
@@ -11,8 +11,11 @@
 
 #include "EntitySimulation.h"
 
+#include <algorithm>
+
 #include <AACube.h>
 #include <Profile.h>
+#include <TBBHelpers.h>
 
 #include "EntitiesLogging.h"
 #include "MovingEntitiesOperator.h"
@@ -24,7 +27,7 @@ void EntitySimulation::setEntityTree(EntityTreePointer tree) {
         _changedEntities.clear();
         _entitiesToUpdate.clear();
         _mortalEntities.clear();
-        _nextExpiry = std::numeric_limits<uint64_t>::max();
+        _expiryQueue.clear();
     }
     _entityTree = tree;
 }
@@ -66,31 +69,52 @@ void EntitySimulation::prepareEntityForDelete(EntityItemPointer entity) {
     }
 }
 
+// the earliest expiry is on top of the heap
+static bool isLaterExpiry(const std::pair<uint64_t, EntityItemWeakPointer>& a, const std::pair<uint64_t, EntityItemWeakPointer>& b) {
+    return a.first > b.first;
+}
+
+// past this many stale entries the expiry queue is rebuilt from the mortal entities
+static const size_t MIN_STALE_EXPIRIES_TO_REBUILD = 64;
+
+// protected: _mutex lock is guaranteed
+void EntitySimulation::queueExpiry(const EntityItemPointer& entity) {
+    if (_expiryQueue.size() > 2 * (size_t)_mortalEntities.size() + MIN_STALE_EXPIRIES_TO_REBUILD) {
+        _expiryQueue.clear();
+        for (auto& mortalEntity : _mortalEntities) {
+            if (mortalEntity != entity) {
+                _expiryQueue.emplace_back(mortalEntity->getExpiry(), mortalEntity);
+            }
+        }
+        std::make_heap(_expiryQueue.begin(), _expiryQueue.end(), isLaterExpiry);
+    }
+    _expiryQueue.emplace_back(entity->getExpiry(), entity);
+    std::push_heap(_expiryQueue.begin(), _expiryQueue.end(), isLaterExpiry);
+}
+
 // protected
 void EntitySimulation::expireMortalEntities(uint64_t now) {
-    if (now > _nextExpiry) {
-        PROFILE_RANGE_EX(simulation_physics, "ExpireMortals", 0xffff00ff, (uint64_t)_mortalEntities.size());
-        // only search for expired entities if we expect to find one
-        _nextExpiry = std::numeric_limits<uint64_t>::max();
-        QMutexLocker lock(&_mutex);
-        SetOfEntities::iterator itemItr = _mortalEntities.begin();
-        while (itemItr != _mortalEntities.end()) {
-            EntityItemPointer entity = *itemItr;
-            uint64_t expiry = entity->getExpiry();
-            if (expiry < now) {
-                itemItr = _mortalEntities.erase(itemItr);
-                entity->die();
-                prepareEntityForDelete(entity);
-            } else {
-                if (expiry < _nextExpiry) {
-                    // remember the smallest _nextExpiry so we know when to start the next search
-                    _nextExpiry = expiry;
-                }
-                ++itemItr;
-            }
+    QMutexLocker lock(&_mutex);
+    if (_expiryQueue.empty() || _expiryQueue.front().first >= now) {
+        return;
+    }
+    PROFILE_RANGE_EX(simulation_physics, "ExpireMortals", 0xffff00ff, (uint64_t)_mortalEntities.size());
+    while (!_expiryQueue.empty() && _expiryQueue.front().first < now) {
+        std::pop_heap(_expiryQueue.begin(), _expiryQueue.end(), isLaterExpiry);
+        EntityItemPointer entity = _expiryQueue.back().second.lock();
+        _expiryQueue.pop_back();
+        if (!entity || !_mortalEntities.contains(entity)) {
+            continue;
         }
-        if (_mortalEntities.size() < 1) {
-            _nextExpiry = -1;
+        uint64_t expiry = entity->getExpiry();
+        if (expiry < now) {
+            _mortalEntities.remove(entity);
+            entity->die();
+            prepareEntityForDelete(entity);
+        } else {
+            // its lifetime was extended since it was queued
+            _expiryQueue.emplace_back(expiry, entity);
+            std::push_heap(_expiryQueue.begin(), _expiryQueue.end(), isLaterExpiry);
         }
     }
 }
@@ -119,6 +143,7 @@ void EntitySimulation::sortEntitiesThatMoved() {
     // NOTE: this is only for entities that have been moved by THIS EntitySimulation.
     // External changes to entity position/shape are expected to be sorted outside of the EntitySimulation.
     MovingEntitiesOperator moveOperator;
+    std::vector<EntityItemPointer> movedEntities;
     AACube domainBounds(glm::vec3((float)-HALF_TREE_SCALE), (float)TREE_SCALE);
     SetOfEntities::iterator itemItr = _entitiesToSort.begin();
     while (itemItr != _entitiesToSort.end()) {
@@ -133,6 +158,7 @@ void EntitySimulation::sortEntitiesThatMoved() {
             prepareEntityForDelete(entity);
         } else {
             moveOperator.addEntityToMoveList(entity, newCube);
+            movedEntities.push_back(entity);
             ++itemItr;
         }
     }
@@ -140,6 +166,7 @@ void EntitySimulation::sortEntitiesThatMoved() {
         PerformanceTimer perfTimer("recurseTreeWithOperator");
         _entityTree->recurseTreeWithOperator(&moveOperator);
     }
+    _entityTree->entitiesMovedBySimulation(movedEntities);
 
     _entitiesToSort.clear();
 }
@@ -148,10 +175,7 @@ void EntitySimulation::addEntityToInternalLists(EntityItemPointer entity) {
     // protected: _mutex lock is guaranteed
     if (entity->isMortal()) {
         _mortalEntities.insert(entity);
-        uint64_t expiry = entity->getExpiry();
-        if (expiry < _nextExpiry) {
-            _nextExpiry = expiry;
-        }
+        queueExpiry(entity);
     }
     if (entity->needsToCallUpdate()) {
         _entitiesToUpdate.insert(entity);
@@ -194,10 +218,7 @@ void EntitySimulation::processChangedEntity(const EntityItemPointer& entity) {
         if (dirtyFlags & Simulation::DIRTY_LIFETIME) {
             if (entity->isMortal()) {
                 _mortalEntities.insert(entity);
-                uint64_t expiry = entity->getExpiry();
-                if (expiry < _nextExpiry) {
-                    _nextExpiry = expiry;
-                }
+                queueExpiry(entity);
             } else {
                 _mortalEntities.remove(entity);
             }
@@ -222,11 +243,17 @@ void EntitySimulation::clearEntities() {
     _deadEntitiesToRemoveFromTree.clear();
     _entitiesToUpdate.clear();
     _mortalEntities.clear();
-    _nextExpiry = std::numeric_limits<uint64_t>::max();
+    _expiryQueue.clear();
 }
 
+// fewer independent kinematic entities than this are moved on the simulation thread
+const size_t MIN_PARALLEL_SIMPLE_KINEMATICS = 64;
+const size_t PARALLEL_SIMPLE_KINEMATICS_GRAIN = 32;
+
 void EntitySimulation::moveSimpleKinematics(uint64_t now) {
     PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
+    // the entities without parent nor children don't read each other's transforms as they move, they are stepped in parallel
+    std::vector<EntityItemPointer> independentEntities;
     SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
     while (itemItr != _simpleKinematicEntities.end()) {
         EntityItemPointer entity = *itemItr;
@@ -239,8 +266,10 @@ void EntitySimulation::moveSimpleKinematics(uint64_t now) {
 
         bool isMoving = entity->isMovingRelativeToParent();
         if (isMoving && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
-            entity->simulate(now);
-            if (ancestryIsKnown && !hasAvatarAncestor) {
+            if (entity->getParentID().isNull() && !entity->hasChildren()) {
+                independentEntities.push_back(entity);
+            } else {
+                entity->simulate(now);
                 entity->updateQueryAACube();
             }
             _entitiesToSort.insert(entity);
@@ -256,6 +285,21 @@ void EntitySimulation::moveSimpleKinematics(uint64_t now) {
             itemItr = _simpleKinematicEntities.erase(itemItr);
         }
     }
+
+    auto moveEntity = [now](const EntityItemPointer& entity) {
+        entity->simulate(now);
+        entity->updateQueryAACube();
+    };
+    if (independentEntities.size() < MIN_PARALLEL_SIMPLE_KINEMATICS) {
+        std::for_each(independentEntities.begin(), independentEntities.end(), moveEntity);
+    } else {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, independentEntities.size(), PARALLEL_SIMPLE_KINEMATICS_GRAIN),
+                          [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                moveEntity(independentEntities[i]);
+            }
+        });
+    }
 }
 
 void EntitySimulation::processDeadEntities() {
@@ -12,8 +12,9 @@
 #ifndef hifi_EntitySimulation_h
 #define hifi_EntitySimulation_h
 
-#include <limits>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <QtCore/QObject>
 #include <QVector>
@@ -44,7 +45,7 @@ const int DIRTY_SIMULATION_FLAGS =
 
 class EntitySimulation : public QObject, public std::enable_shared_from_this<EntitySimulation> {
 public:
-    EntitySimulation() : _mutex(QMutex::Recursive), _nextExpiry(std::numeric_limits<uint64_t>::max()), _entityTree(nullptr) { }
+    EntitySimulation() : _mutex(QMutex::Recursive), _entityTree(nullptr) { }
     virtual ~EntitySimulation() { setEntityTree(nullptr); }
 
     inline EntitySimulationPointer getThisPointer() const {
@@ -87,6 +88,7 @@ protected:
     virtual void processDeadEntities();
 
     void expireMortalEntities(uint64_t now);
+    void queueExpiry(const EntityItemPointer& entity);
     void callUpdateOnEntitiesThatNeedIt(uint64_t now);
     virtual void sortEntitiesThatMoved();
 
@@ -105,7 +107,11 @@ private:
     SetOfEntities _allEntities; // tracks all entities added the simulation
     SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
     SetOfEntities _mortalEntities; // entities that have an expiry
-    uint64_t _nextExpiry;
+
+    // A min-heap of the expiries of _mortalEntities. An entry goes stale when its entity is removed or its lifetime
+    // changes, it is dropped or queued again when it comes up rather than searched for.
+    using ExpiryEntry = std::pair<uint64_t, EntityItemWeakPointer>;
+    std::vector<ExpiryEntry> _expiryQueue;
 
     // back pointer to EntityTree structure
     EntityTreePointer _entityTree;
@@ -11,6 +11,8 @@
 //
 
 #include "EntityTree.h"
+
+
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
 #include <openssl/err.h>
@@ -26,8 +28,12 @@
 #include <QtScript/QScriptEngine>
 
 #include <Extents.h>
+#include <Gzip.h>
+#include <MemoryAccounting.h>
+#include <OctreeBinaryPersist.h>
 #include <PerfStat.h>
 #include <Profile.h>
+#include <TBBHelpers.h>
 #include <AddressManager.h>
 
 #include "EntitySimulation.h"
@@ -47,6 +53,12 @@ static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC *
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
 static const QString DOMAIN_UNLIMITED = "domainUnlimited";
 
+// the entities in the maps of the trees, their properties aren't sized
+static MemoryTag& entitiesTag() {
+    static MemoryTag tag("entities.items");
+    return tag;
+}
+
 EntityTree::EntityTree(bool shouldReaverage) :
     Octree(shouldReaverage)
 {
@@ -65,6 +77,8 @@ EntityTree::~EntityTree() {
     // TODO: EntityTreeElement::_tree should be raw back pointer.
     // AND: EntityItem::_element should be a raw back pointer.
     //eraseAllOctreeElements(false); // KEEP THIS
+
+    entitiesTag().freed(0, _entityMap.size());
 }
 
 void EntityTree::setEntityScriptSourceWhitelist(const QString& entityScriptSourceWhitelist) { 
@@ -112,7 +126,9 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
                 }
             }
         }
+        entitiesTag().freed(0, _entityMap.size() - savedEntities.size());
         _entityMap.swap(savedEntities);
+        rebuildEntityIndexes();
     });
 
     resetClientEditStats();
@@ -141,6 +157,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     }
     QHash<EntityItemID, EntityItemPointer> localMap;
     localMap.swap(_entityMap);
+    entitiesTag().freed(0, localMap.size());
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -156,6 +173,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
             }
         }
     });
+    rebuildEntityIndexes();
     localMap.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
 
@@ -281,6 +299,7 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
         case PacketType::EntityEdit:
         case PacketType::EntityErase:
         case PacketType::EntityPhysics:
+        case PacketType::BulkEntityPhysics:
             return true;
         default:
             return false;
@@ -305,6 +324,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    journalEntityChange(entity->getEntityItemID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
     fixupNeedsParentFixups();
@@ -371,6 +391,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                journalEntityChange(entity->getID());
             }
         }
     } else {
@@ -468,7 +489,8 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
             emit editingEntityPointer(entity);
         }
 
-        // if the entity has children, run UpdateEntityOperator on them.  If the children have children, recurse
+        // if the entity has descendants, move them all in one pass over the tree
+        MovingEntitiesOperator descendantsMoveOperator;
         QQueue<SpatiallyNestablePointer> toProcess;
         foreach (SpatiallyNestablePointer child, entity->getChildren()) {
             if (child && child->getNestableType() == NestableType::Entity) {
@@ -496,16 +518,20 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                 addToNeedsParentFixupList(childEntity);
             }
 
-            UpdateEntityOperator theChildOperator(getThisPointer(), childContainingElement, childEntity, queryCube);
-            recurseTreeWithOperator(&theChildOperator);
+            descendantsMoveOperator.addEntityToMoveList(childEntity, queryCube, true);
+            journalEntityChange(childEntity->getID());
             foreach (SpatiallyNestablePointer childChild, childEntity->getChildren()) {
                 if (childChild && childChild->getNestableType() == NestableType::Entity) {
                     toProcess.enqueue(childChild);
                 }
             }
         }
+        if (descendantsMoveOperator.hasMovingEntities()) {
+            recurseTreeWithOperator(&descendantsMoveOperator);
+        }
 
         _isDirty = true;
+        journalEntityChange(entity->getID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -745,6 +771,7 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
     for (auto entity : entities) {
         if (entity->getElement()) {
             theOperator.addEntityToDeleteList(entity);
+            journalEntityDelete(entity->getID());
             emit deletingEntity(entity->getID());
             emit deletingEntityPointer(entity.get());
         }
@@ -792,144 +819,69 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
     }
 }
 
-class RayArgs {
-public:
-    // Inputs
-    glm::vec3 origin;
-    glm::vec3 direction;
-    glm::vec3 invDirection;
-    glm::vec3 viewFrustumPos;
-    const QVector<EntityItemID>& entityIdsToInclude;
-    const QVector<EntityItemID>& entityIdsToDiscard;
-    PickFilter searchFilter;
-
-    // Outputs
-    OctreeElementPointer& element;
-    float& distance;
-    BoxFace& face;
-    glm::vec3& surfaceNormal;
-    QVariantMap& extraInfo;
-    EntityItemID entityID;
-};
-
-bool evalRayIntersectionOp(const OctreeElementPointer& element, void* extraData) {
-    RayArgs* args = static_cast<RayArgs*>(extraData);
-    bool keepSearching = true;
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    EntityItemID entityID = entityTreeElementPointer->evalRayIntersection(args->origin, args->direction, args->viewFrustumPos,
-        args->element, args->distance, args->face, args->surfaceNormal, args->entityIdsToInclude,
-        args->entityIdsToDiscard, args->searchFilter, args->extraInfo);
-    if (!entityID.isNull()) {
-        args->entityID = entityID;
-        // We recurse OctreeElements in order, so if we hit something, we can stop immediately
-        keepSearching = false;
-    }
-    return keepSearching;
-}
-
-float evalRayIntersectionSortingOp(const OctreeElementPointer& element, void* extraData) {
-    RayArgs* args = static_cast<RayArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    float distance = FLT_MAX;
-    // If origin is inside the cube, always check this element first
-    if (entityTreeElementPointer->getAACube().contains(args->origin)) {
-        distance = 0.0f;
-    } else {
-        float boundDistance = FLT_MAX;
-        BoxFace face;
-        glm::vec3 surfaceNormal;
-        if (entityTreeElementPointer->getAACube().findRayIntersection(args->origin, args->direction, args->invDirection,
-            boundDistance, face, surfaceNormal)) {
-            // Don't add this cell if it's already farther than our best distance so far
-            if (boundDistance < args->distance) {
-                distance = boundDistance;
-            }
-        }
-    }
-    return distance;
-}
-
 EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
                                     QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
                                     PickFilter searchFilter, OctreeElementPointer& element, float& distance,
                                     BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
                                     Octree::lockType lockType, bool* accurateResult) {
+    std::vector<RayPick> picks(1);
+    RayPick& pick = picks[0];
+    pick.origin = origin;
+    pick.direction = direction;
+    pick.entityIdsToInclude = entityIdsToInclude;
+    pick.entityIdsToDiscard = entityIdsToDiscard;
+    pick.searchFilter = searchFilter;
+
+    evalRayIntersections(picks, lockType, accurateResult);
 
+    element = pick.element;
+    distance = pick.distance;
+    face = pick.face;
+    surfaceNormal = pick.surfaceNormal;
+    extraInfo = pick.extraInfo;
+    return pick.entityID;
+}
+
+void EntityTree::evalRayIntersections(std::vector<RayPick>& picks, Octree::lockType lockType, bool* accurateResult) {
     // calculate dirReciprocal like this rather than with glm's scalar / vec3 template to avoid NaNs.
-    vec3 dirReciprocal = glm::vec3(direction.x == 0.0f ? 0.0f : 1.0f / direction.x,
-                                   direction.y == 0.0f ? 0.0f : 1.0f / direction.y,
-                                   direction.z == 0.0f ? 0.0f : 1.0f / direction.z);
-    RayArgs args = { origin, direction, dirReciprocal, BillboardModeHelpers::getPrimaryViewFrustumPosition(), entityIdsToInclude, entityIdsToDiscard,
-            searchFilter, element, distance, face, surfaceNormal, extraInfo, EntityItemID() };
-    distance = FLT_MAX;
+    std::vector<glm::vec3> dirReciprocals;
+    dirReciprocals.reserve(picks.size());
+    for (auto& pick : picks) {
+        const glm::vec3& direction = pick.direction;
+        dirReciprocals.emplace_back(direction.x == 0.0f ? 0.0f : 1.0f / direction.x,
+                                    direction.y == 0.0f ? 0.0f : 1.0f / direction.y,
+                                    direction.z == 0.0f ? 0.0f : 1.0f / direction.z);
+        pick.entityID = EntityItemID();
+        pick.element = OctreeElementPointer();
+        pick.distance = FLT_MAX;
+    }
+    glm::vec3 viewFrustumPos = BillboardModeHelpers::getPrimaryViewFrustumPosition();
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&]{
-        recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        updatePickBVH();
+        glm::vec3 nearPoint = picks.empty() ? glm::vec3(0.0f) : picks[0].origin;
+        _pickBVH.traverse((int)picks.size(), nearPoint,
+            [&](int i, const glm::vec3& minCorner, const glm::vec3& maxCorner) {
+                const RayPick& pick = picks[i];
+                return EntityTreeBVH::rayHitsBounds(pick.origin, pick.direction, dirReciprocals[i], minCorner, maxCorner,
+                                                    pick.distance);
+            },
+            [&](int i, const EntityItemPointer& entity) {
+                RayPick& pick = picks[i];
+                OctreeElementPointer element = entity->getElement();
+                if (EntityTreeElement::evalEntityRayIntersection(entity, pick.origin, pick.direction, viewFrustumPos, element,
+                        pick.distance, pick.face, pick.surfaceNormal, pick.entityIdsToInclude, pick.entityIdsToDiscard,
+                        pick.searchFilter, pick.extraInfo)) {
+                    pick.entityID = entity->getEntityItemID();
+                    pick.element = element;
+                }
+            });
     }, requireLock);
 
     if (accurateResult) {
         *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
     }
-
-    return args.entityID;
-}
-
-class ParabolaArgs {
-public:
-    // Inputs
-    glm::vec3 origin;
-    glm::vec3 velocity;
-    glm::vec3 acceleration;
-    glm::vec3 viewFrustumPos;
-    const QVector<EntityItemID>& entityIdsToInclude;
-    const QVector<EntityItemID>& entityIdsToDiscard;
-    PickFilter searchFilter;
-
-    // Outputs
-    OctreeElementPointer& element;
-    float& parabolicDistance;
-    BoxFace& face;
-    glm::vec3& surfaceNormal;
-    QVariantMap& extraInfo;
-    EntityItemID entityID;
-};
-
-bool evalParabolaIntersectionOp(const OctreeElementPointer& element, void* extraData) {
-    ParabolaArgs* args = static_cast<ParabolaArgs*>(extraData);
-    bool keepSearching = true;
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    EntityItemID entityID = entityTreeElementPointer->evalParabolaIntersection(args->origin, args->velocity, args->acceleration, args->viewFrustumPos,
-        args->element, args->parabolicDistance, args->face, args->surfaceNormal, args->entityIdsToInclude,
-        args->entityIdsToDiscard, args->searchFilter, args->extraInfo);
-    if (!entityID.isNull()) {
-        args->entityID = entityID;
-        // We recurse OctreeElements in order, so if we hit something, we can stop immediately
-        keepSearching = false;
-    }
-    return keepSearching;
-}
-
-float evalParabolaIntersectionSortingOp(const OctreeElementPointer& element, void* extraData) {
-    ParabolaArgs* args = static_cast<ParabolaArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    float distance = FLT_MAX;
-    // If origin is inside the cube, always check this element first
-    if (entityTreeElementPointer->getAACube().contains(args->origin)) {
-        distance = 0.0f;
-    } else {
-        float boundDistance = FLT_MAX;
-        BoxFace face;
-        glm::vec3 surfaceNormal;
-        if (entityTreeElementPointer->getAACube().findParabolaIntersection(args->origin, args->velocity, args->acceleration,
-            boundDistance, face, surfaceNormal)) {
-            // Don't add this cell if it's already farther than our best distance so far
-            if (boundDistance < args->parabolicDistance) {
-                distance = boundDistance;
-            }
-        }
-    }
-    return distance;
 }
 
 EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
@@ -938,26 +890,99 @@ EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
                                     OctreeElementPointer& element, glm::vec3& intersection, float& distance, float& parabolicDistance,
                                     BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
                                     Octree::lockType lockType, bool* accurateResult) {
-    ParabolaArgs args = { parabola.origin, parabola.velocity, parabola.acceleration, BillboardModeHelpers::getPrimaryViewFrustumPosition(),
-        entityIdsToInclude, entityIdsToDiscard, searchFilter, element, parabolicDistance, face, surfaceNormal, extraInfo, EntityItemID() };
     parabolicDistance = FLT_MAX;
     distance = FLT_MAX;
+    glm::vec3 viewFrustumPos = BillboardModeHelpers::getPrimaryViewFrustumPosition();
 
+    // We can precompute the world-space parabola normal and reuse it for the parabola plane intersects AABox sphere check
+    glm::vec3 vectorOnPlane = parabola.velocity;
+    if (glm::dot(glm::normalize(parabola.velocity), glm::normalize(parabola.acceleration)) > 1.0f - EPSILON) {
+        // Handle the degenerate case where velocity is parallel to acceleration
+        // We pick t = 1 and calculate a second point on the plane
+        vectorOnPlane = parabola.velocity + 0.5f * parabola.acceleration;
+    }
+    // Get the normal of the plane, the cross product of two vectors on the plane
+    glm::vec3 normal = glm::normalize(glm::cross(vectorOnPlane, parabola.acceleration));
+
+    EntityItemID entityID;
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&] {
-        recurseTreeWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
+        updatePickBVH();
+        _pickBVH.traverse(1, parabola.origin,
+            [&](int, const glm::vec3& minCorner, const glm::vec3& maxCorner) {
+                AABox bounds(minCorner, maxCorner - minCorner);
+                if (bounds.contains(parabola.origin)) {
+                    return true;
+                }
+                float boundDistance;
+                BoxFace boundFace;
+                glm::vec3 boundNormal;
+                return bounds.findParabolaIntersection(parabola.origin, parabola.velocity, parabola.acceleration,
+                                                       boundDistance, boundFace, boundNormal) &&
+                       boundDistance < parabolicDistance;
+            },
+            [&](int, const EntityItemPointer& entity) {
+                OctreeElementPointer entityElement = entity->getElement();
+                if (EntityTreeElement::evalEntityParabolaIntersection(entity, parabola.origin, parabola.velocity,
+                        parabola.acceleration, viewFrustumPos, normal, entityElement, parabolicDistance, face, surfaceNormal,
+                        entityIdsToInclude, entityIdsToDiscard, searchFilter, extraInfo)) {
+                    entityID = entity->getEntityItemID();
+                    element = entityElement;
+                }
+            });
     }, requireLock);
 
     if (accurateResult) {
         *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
     }
 
-    if (!args.entityID.isNull()) {
+    if (!entityID.isNull()) {
         intersection = parabola.origin + parabola.velocity * parabolicDistance + 0.5f * parabola.acceleration * parabolicDistance * parabolicDistance;
         distance = glm::distance(intersection, parabola.origin);
     }
 
-    return args.entityID;
+    return entityID;
+}
+
+std::vector<EntityItemPointer> EntityTree::getAllEntities() const {
+    std::vector<EntityItemPointer> entities;
+    QReadLocker locker(&_entityMapLock);
+    entities.reserve(_entityMap.size());
+    foreach(EntityItemPointer entity, _entityMap) {
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+void EntityTree::updatePickBVH() const {
+    _pickBVH.update([this] {
+        return getAllEntities();
+    });
+}
+
+void EntityTree::setSpatialIndex(SpatialIndex spatialIndex) {
+    if (spatialIndex == _spatialIndex.exchange(spatialIndex)) {
+        return;
+    }
+    // the grid isn't told of the changes while it isn't used
+    _spatialGrid.markNeedsRebuild();
+    qCDebug(entities) << "EntityTree: the spatial queries use the" << (spatialIndex == SpatialIndex::Grid ? "grid" : "octree");
+}
+
+void EntityTree::updateEntityPickBounds(const EntityItemID& id) {
+    _pickBVH.markMoved(id);
+    if (isUsingSpatialGrid()) {
+        _spatialGrid.markChanged(id);
+    }
+}
+
+void EntityTree::updateSpatialGrid() const {
+    _spatialGrid.update([this](const EntityItemID& id) {
+        QReadLocker locker(&_entityMapLock);
+        return _entityMap.value(id);
+    }, [this] {
+        return getAllEntities();
+    });
 }
 
 class FindClosestEntityArgs {
@@ -1009,6 +1034,25 @@ bool evalClosestEntityOperation(const OctreeElementPointer& element, void* extra
 
 // NOTE: assumes caller has handled locking
 QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadius, PickFilter searchFilter) {
+    if (isUsingSpatialGrid()) {
+        updateSpatialGrid();
+        QUuid closestEntity;
+        float closestDistanceSquared = targetRadius * targetRadius;
+        _spatialGrid.query(position - glm::vec3(targetRadius), position + glm::vec3(targetRadius),
+            [&](const EntityItemPointer& entity) {
+                if (!entity->getElement() || !EntityTreeElement::checkFilterSettings(entity, searchFilter)) {
+                    return;
+                }
+                glm::vec3 offset = entity->getWorldPosition() - position;
+                float distanceSquared = glm::dot(offset, offset);
+                if (distanceSquared <= closestDistanceSquared) {
+                    closestEntity = entity->getID();
+                    closestDistanceSquared = distanceSquared;
+                }
+            });
+        return closestEntity;
+    }
+
     FindClosestEntityArgs args = { position, targetRadius, searchFilter, QUuid(), FLT_MAX };
     recurseTreeWithOperation(evalClosestEntityOperation, &args);
     return args.closestEntity;
@@ -1043,6 +1087,13 @@ bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData)
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (isUsingSpatialGrid()) {
+        evalGridEntitiesInSphere(center, radius, foundEntities, [&](const EntityItemPointer& entity) {
+            return EntityTreeElement::checkFilterSettings(entity, searchFilter);
+        });
+        return;
+    }
+
     FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
     recurseTreeWithOperation(evalInSphereOperation, &args);
     foundEntities.swap(args.entities);
@@ -1078,11 +1129,66 @@ bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* ex
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    QVector<EntityItemPointer> candidates;
+    if (getIndexedEntities(_entitiesByType, type, candidates)) {
+        foundEntities.clear();
+        for (const auto& entity : candidates) {
+            if (entity->getElement() && EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+                EntityTreeElement::isEntityInSphere(entity, center, radius)) {
+                foundEntities.push_back(entity->getID());
+            }
+        }
+        return;
+    }
+
+    if (isUsingSpatialGrid()) {
+        evalGridEntitiesInSphere(center, radius, foundEntities, [&](const EntityItemPointer& entity) {
+            return entity->getType() == type && EntityTreeElement::checkFilterSettings(entity, searchFilter);
+        });
+        return;
+    }
+
     FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
     recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
     foundEntities.swap(args.entities);
 }
 
+int EntityTree::getNumEntitiesOfType(EntityTypes::EntityType type) const {
+    QReadLocker locker(&_entityIndexLock);
+    return _entitiesByType.value(type).size();
+}
+
+// NOTE: assumes caller has handled locking
+void EntityTree::evalZonesAndScriptedEntitiesInSphere(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities) {
+    foundEntities.clear();
+    QSet<EntityItemID> ids;
+    {
+        QReadLocker locker(&_entityIndexLock);
+        ids = _entitiesByType.value(EntityTypes::Zone) + _entitiesWithScripts;
+    }
+
+    if (ids.size() > MAX_INDEXED_CANDIDATES) {
+        QVector<QUuid> entityIDs;
+        evalEntitiesInSphere(center, radius, PickFilter(), entityIDs);
+        for (const auto& entityID : entityIDs) {
+            EntityItemPointer entity = findEntityByID(entityID);
+            if (entity && (entity->getType() == EntityTypes::Zone || !entity->getScript().isEmpty())) {
+                foundEntities.push_back(entity);
+            }
+        }
+        return;
+    }
+
+    QReadLocker locker(&_entityMapLock);
+    for (const auto& id : ids) {
+        EntityItemPointer entity = _entityMap.value(id);
+        if (entity && entity->getElement() && EntityTreeElement::checkFilterSettings(entity, PickFilter()) &&
+            EntityTreeElement::isEntityInSphere(entity, center, radius)) {
+            foundEntities.push_back(entity);
+        }
+    }
+}
+
 class FindEntitiesInSphereWithNameArgs {
 public:
     // Inputs
@@ -1114,6 +1220,29 @@ bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* ex
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    QVector<EntityItemPointer> candidates;
+    bool isIndexed = caseSensitive ? getIndexedEntities(_entitiesByName, name, candidates) :
+        getIndexedEntities(_entitiesByFoldedName, name.toLower(), candidates);
+    if (isIndexed) {
+        foundEntities.clear();
+        for (const auto& entity : candidates) {
+            if (entity->getElement() && EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+                EntityTreeElement::isEntityNamed(entity, name, caseSensitive) &&
+                EntityTreeElement::isEntityInSphere(entity, center, radius)) {
+                foundEntities.push_back(entity->getID());
+            }
+        }
+        return;
+    }
+
+    if (isUsingSpatialGrid()) {
+        evalGridEntitiesInSphere(center, radius, foundEntities, [&](const EntityItemPointer& entity) {
+            return EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+                EntityTreeElement::isEntityNamed(entity, name, caseSensitive);
+        });
+        return;
+    }
+
     FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
     recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
     foundEntities.swap(args.entities);
@@ -1141,6 +1270,11 @@ bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (isUsingSpatialGrid()) {
+        evalGridEntitiesInBox(AABox(cube), searchFilter, foundEntities);
+        return;
+    }
+
     FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
     recurseTreeWithOperation(findInCubeOperation, &args);
     foundEntities.swap(args.entities);
@@ -1168,6 +1302,11 @@ bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (isUsingSpatialGrid()) {
+        evalGridEntitiesInBox(box, searchFilter, foundEntities);
+        return;
+    }
+
     FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInBoxOperation, &args);
@@ -1175,6 +1314,34 @@ void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QV
     foundEntities.swap(args.entities);
 }
 
+template <typename Accept>
+void EntityTree::evalGridEntitiesInSphere(const glm::vec3& center, float radius, QVector<QUuid>& foundEntities,
+                                          Accept accept) const {
+    updateSpatialGrid();
+    foundEntities.clear();
+    _spatialGrid.query(center - glm::vec3(radius), center + glm::vec3(radius), [&](const EntityItemPointer& entity) {
+        if (entity->getElement() && accept(entity) && EntityTreeElement::isEntityInSphere(entity, center, radius)) {
+            foundEntities.push_back(entity->getID());
+        }
+    });
+}
+
+void EntityTree::evalGridEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
+    updateSpatialGrid();
+    foundEntities.clear();
+    _spatialGrid.query(box.getMinimumPoint(), box.getMaximumPoint(), [&](const EntityItemPointer& entity) {
+        if (!entity->getElement() || !EntityTreeElement::checkFilterSettings(entity, searchFilter)) {
+            return;
+        }
+        // as the octree does it, in case the grid's bounds round differently
+        bool success;
+        AABox entityBox = entity->getAABox(success);
+        if (success && entityBox.touches(box)) {
+            foundEntities.push_back(entity->getID());
+        }
+    });
+}
+
 class FindEntitiesInFrustumArgs {
 public:
     // Inputs
@@ -1825,6 +1992,7 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             isAdd = true;  // fall through to next case
             // FALLTHRU
         case PacketType::EntityPhysics:
+        case PacketType::BulkEntityPhysics:
         case PacketType::EntityEdit: {
             quint64 startDecode = 0, endDecode = 0;
             quint64 startLookup = 0, endLookup = 0;
@@ -1836,7 +2004,8 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             bool suppressDisallowedClientScript = false;
             bool suppressDisallowedServerScript = false;
             bool suppressDisallowedPrivateUserData = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
+            bool isBulkPhysics = message.getType() == PacketType::BulkEntityPhysics;
+            bool isPhysics = isBulkPhysics || message.getType() == PacketType::EntityPhysics;
 
             _totalEditMessages++;
 
@@ -1856,6 +2025,9 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                         properties = entityToClone->getProperties();
                     }
                 }
+            } else if (isBulkPhysics) {
+                validEditPacket = EntityItemProperties::decodeBulkEntityPhysicsMessage(editData, maxLength, processedBytes,
+                                                                                       senderNode->getUUID(), entityItemID, properties);
             } else {
                 validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
             }
@@ -2559,11 +2731,147 @@ void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
         return;
     }
     _entityMap.insert(id, entity);
+    entitiesTag().allocated(0);
+    indexEntity(entity);
+    _pickBVH.markNeedsRebuild();
+    if (isUsingSpatialGrid()) {
+        _spatialGrid.markChanged(id);
+    }
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
     QWriteLocker locker(&_entityMapLock);
-    _entityMap.remove(id);
+    if (_entityMap.remove(id) > 0) {
+        entitiesTag().freed(0);
+    }
+    unindexEntity(id);
+    _pickBVH.markNeedsRebuild();
+    if (isUsingSpatialGrid()) {
+        _spatialGrid.markChanged(id);
+    }
+}
+
+namespace {
+void removeFromIndex(QHash<QString, QSet<EntityItemID>>& index, const QString& key, const EntityItemID& id) {
+    auto posting = index.find(key);
+    if (posting != index.end()) {
+        posting->remove(id);
+        if (posting->empty()) {
+            index.erase(posting);
+        }
+    }
+}
+}
+
+void EntityTree::indexEntity(const EntityItemPointer& entity) {
+    EntityItemID id = entity->getEntityItemID();
+    QString name = entity->getName();
+    bool hasScript = !entity->getScript().isEmpty();
+
+    QWriteLocker locker(&_entityIndexLock);
+    _entitiesByType[entity->getType()].insert(id);
+    _indexedTypes[id] = entity->getType();
+    _entitiesByName[name].insert(id);
+    _entitiesByFoldedName[name.toLower()].insert(id);
+    _indexedNames[id] = name;
+    if (hasScript) {
+        _entitiesWithScripts.insert(id);
+    }
+}
+
+void EntityTree::unindexEntity(const EntityItemID& id) {
+    QWriteLocker locker(&_entityIndexLock);
+    auto type = _indexedTypes.find(id);
+    if (type != _indexedTypes.end()) {
+        auto posting = _entitiesByType.find(type.value());
+        if (posting != _entitiesByType.end()) {
+            posting->remove(id);
+            if (posting->empty()) {
+                _entitiesByType.erase(posting);
+            }
+        }
+        _indexedTypes.erase(type);
+    }
+
+    auto name = _indexedNames.find(id);
+    if (name != _indexedNames.end()) {
+        removeFromIndex(_entitiesByName, name.value(), id);
+        removeFromIndex(_entitiesByFoldedName, name.value().toLower(), id);
+        _indexedNames.erase(name);
+    }
+    _entitiesWithScripts.remove(id);
+}
+
+void EntityTree::updateEntityNameIndex(const EntityItemID& id, const QString& name) {
+    QWriteLocker locker(&_entityIndexLock);
+    auto indexedName = _indexedNames.find(id);
+    if (indexedName == _indexedNames.end() || indexedName.value() == name) {
+        return;
+    }
+
+    removeFromIndex(_entitiesByName, indexedName.value(), id);
+    removeFromIndex(_entitiesByFoldedName, indexedName.value().toLower(), id);
+    _entitiesByName[name].insert(id);
+    _entitiesByFoldedName[name.toLower()].insert(id);
+    indexedName.value() = name;
+}
+
+void EntityTree::updateEntityScriptIndex(const EntityItemID& id, bool hasScript) {
+    QWriteLocker locker(&_entityIndexLock);
+    if (!_indexedTypes.contains(id)) {
+        return;
+    }
+
+    if (hasScript) {
+        _entitiesWithScripts.insert(id);
+    } else {
+        _entitiesWithScripts.remove(id);
+    }
+}
+
+// NOTE: assumes caller has handled locking of the _entityMap
+void EntityTree::rebuildEntityIndexes() {
+    {
+        QWriteLocker locker(&_entityIndexLock);
+        _entitiesByType.clear();
+        _entitiesByName.clear();
+        _entitiesByFoldedName.clear();
+        _indexedTypes.clear();
+        _indexedNames.clear();
+        _entitiesWithScripts.clear();
+    }
+    foreach(EntityItemPointer entity, _entityMap) {
+        indexEntity(entity);
+    }
+    _pickBVH.markNeedsRebuild();
+    _spatialGrid.markNeedsRebuild();
+}
+
+// Returns false if there are too many indexed entities for key to be worth checking one by one.
+template <typename Key>
+bool EntityTree::getIndexedEntities(const QHash<Key, QSet<EntityItemID>>& index, const Key& key,
+                                    QVector<EntityItemPointer>& entities) const {
+    QSet<EntityItemID> ids;
+    {
+        QReadLocker locker(&_entityIndexLock);
+        auto posting = index.find(key);
+        if (posting == index.end()) {
+            return true;
+        }
+        if (posting->size() > MAX_INDEXED_CANDIDATES) {
+            return false;
+        }
+        ids = posting.value();
+    }
+
+    QReadLocker locker(&_entityMapLock);
+    for (const auto& id : ids) {
+        EntityItemPointer entity = _entityMap.value(id);
+        if (entity) {
+            entities.push_back(entity);
+        }
+    }
+    return true;
 }
 
 void EntityTree::debugDumpMap() {
@@ -2852,8 +3160,10 @@ bool EntityTree::writeToMap(QVariantMap& entityDescription, OctreeElementPointer
     RecurseOctreeToMapOperator theOperator(entityDescription, element, &scriptEngine, skipDefaultValues,
                                             skipThoseWithBadParents, _myAvatar);
     withReadLock([&] {
-        recurseTreeWithOperator(&theOperator);
+        recurseTreeInParallel(theOperator);
     });
+    // the engine isn't thread safe, the script values are made here
+    theOperator.writeEntities();
     return true;
 }
 
@@ -2971,215 +3281,614 @@ void convertGrabUserDataToProperties(EntityItemProperties& properties) {
 }
 
 
+// QVariantMap --> QScriptValue --> EntityItemProperties, with the conversions for older content.
+// Doesn't touch the tree, so persist files can have their entities converted on several threads.
+void EntityTree::loadedEntityFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                                     LoadedEntity& loaded) const {
+    // handle parentJointName for wearables
+    if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+        QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+
+        entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+
+        qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+            " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    }
+
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, loaded.properties);
+
+    if (entityMap.contains("id")) {
+        loaded.id = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        loaded.id = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            loaded.properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        }
+    }
+
+    if (loaded.properties.getEntityHostType() == entity::HostType::AVATAR) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        const QUuid myNodeID = nodeList->getSessionUUID();
+        loaded.properties.setOwningAvatarID(myNodeID);
+    }
+
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (loaded.properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        loaded.properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            loaded.properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+        }
+
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        loaded.properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (loaded.properties.getAmbientLight().getAmbientURL() == "") {
+            if (loaded.properties.getSkybox().getURL() != "") {
+                loaded.properties.getAmbientLight().setAmbientURL(loaded.properties.getSkybox().getURL());
+            } else {
+                loaded.properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+            }
+        }
+
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            loaded.properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            loaded.properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && loaded.properties.getType() == EntityTypes::EntityType::Material) {
+        if (loaded.properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = loaded.properties.getMaterialURL();
+            loaded.properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+
+            QJsonObject userData = QJsonDocument::fromJson(loaded.properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
+            }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
+            }
+
+            loaded.properties.setMaterialData(QJsonDocument(materialData).toJson());
+            loaded.properties.setUserData(QJsonDocument(userData).toJson());
+        }
+    }
+
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(loaded.properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            loaded.properties.setCloneable(true);
+            loaded.properties.setCloneLifetime(cloneLifetime.toInt());
+            loaded.properties.setCloneLimit(cloneLimit.toInt());
+            loaded.properties.setCloneDynamic(cloneDynamic.toBool());
+            loaded.properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        }
+    }
+
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(loaded.properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        loaded.properties.setRadiusSpread(0.0f);
+        loaded.properties.setAlphaSpread(0.0f);
+        loaded.properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            loaded.properties.setCreated(created);
+        }
+    }
+
+    // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
+    if (contentVersion < (int)EntityVersion::AllBillboardMode) {
+        if (loaded.properties.getBillboardMode() != BillboardMode::NONE) {
+            loaded.properties.setRotation(glm::quat());
+        }
+    }
+}
+
+bool EntityTree::addLoadedEntity(const LoadedEntity& loaded, bool isImport, QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    EntityItemPointer entity = addEntity(loaded.id, loaded.properties, isImport);
+    if (!entity) {
+        qCDebug(entities) << "adding Entity failed:" << loaded.id << loaded.properties.getType();
+        return false;
+    }
+
+    const QUuid& cloneOriginID = entity->getCloneOriginID();
+    if (!cloneOriginID.isNull()) {
+        cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+    }
+    return true;
+}
+
+void EntityTree::setLoadedCloneIDs(const QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
+}
+
 bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
+    // map will have a top-level list keyed as "Entities", read as a single batch
+    beginReadingEntities(map, isImport);
+    readEntitiesBatch(map["Entities"].toList());
+    return endReadingEntities();
+}
+
+void EntityTree::beginReadingEntities(const QVariantMap& header, const bool isImport) {
     // These are needed to deal with older content (before adding inheritance modes)
-    int contentVersion = map["Version"].toInt();
+    _readingContentVersion = header["Version"].toInt();
+    _isReadingImport = isImport;
+    _hasReadingFailed = false;
+    _numEntitiesRead = 0;
+    _readingCloneIDs.clear();
 
-    if (map.contains("Id")) {
-        _persistID = map["Id"].toUuid();
+    if (header.contains("Id")) {
+        _persistID = header["Id"].toUuid();
     }
 
-    if (map.contains("DataVersion")) {
-        _persistDataVersion = map["DataVersion"].toInt();
+    if (header.contains("DataVersion")) {
+        _persistDataVersion = header["DataVersion"].toInt();
     }
 
     _namedPaths.clear();
-    if (map.contains("Paths")) {
-        QVariantMap namedPathsMap = map["Paths"].toMap();
+    if (header.contains("Paths")) {
+        QVariantMap namedPathsMap = header["Paths"].toMap();
         for(QVariantMap::const_iterator iter = namedPathsMap.begin(); iter != namedPathsMap.end(); ++iter) {
             QString namedPathName = iter.key();
             QString namedPathViewPoint = iter.value().toString();
             _namedPaths[namedPathName] = namedPathViewPoint;
         }
     }
+}
 
-    // map will have a top-level list keyed as "Entities".  This will be extracted
-    // and iterated over.  Each member of this list is converted to a QVariantMap, then
-    // to a QScriptValue, and then to EntityItemProperties.  These properties are used
-    // to add the new entity to the EntityTree.
-    QVariantList entitiesQList = map["Entities"].toList();
+void EntityTree::readEntitiesBatch(const QVariantList& entities) {
+    // Each member of the list is converted to a QVariantMap, then to a QScriptValue, and then to EntityItemProperties.
+    // These properties are used to add the new entity to the EntityTree.
     QScriptEngine scriptEngine;
-
-    if (entitiesQList.length() == 0) {
-        // Empty map or invalidly formed file.
-        return false;
-    }
-
-    QMap<QUuid, QVector<QUuid>> cloneIDs;
-
-    bool success = true;
-    foreach (QVariant entityVariant, entitiesQList) {
-        // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
+    for (const auto& entityVariant : entities) {
         QVariantMap entityMap = entityVariant.toMap();
+        LoadedEntity loaded;
+        loadedEntityFromMap(entityMap, _readingContentVersion, scriptEngine, loaded);
+        if (!addLoadedEntity(loaded, _isReadingImport, _readingCloneIDs)) {
+            _hasReadingFailed = true;
+        }
+    }
+    _numEntitiesRead += entities.size();
+}
 
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+bool EntityTree::endReadingEntities() {
+    setLoadedCloneIDs(_readingCloneIDs);
+    _readingCloneIDs.clear();
 
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+    // no entities means an empty map or an invalidly formed file
+    return _numEntitiesRead > 0 && !_hasReadingFailed;
+}
 
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
+    QScriptEngine scriptEngine;
+    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
+    if (!element || element == _rootElement) {
+        // the persist and the backups, the tree is only locked while the snapshot gets the changes
+        EntityTreeSnapshot snapshot = takeSnapshot();
+        for (const auto& properties : snapshot) {
+            theOperator.writeEntity(*properties);
         }
+    } else {
+        withReadLock([&] {
+            recurseTreeInParallel(theOperator);
+        });
+        // the engine isn't thread safe, the script values are made here
+        theOperator.writeEntities();
+    }
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+    jsonString = theOperator.getJson();
+    return true;
+}
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
+// A binary persist block holds the entities of a single type, stored by property: the block's property names once,
+// then for every property a column with each entity's value, invalid where the entity had the default.
+bool EntityTree::writeToBinary(QDataStream& out) {
+    // the tree isn't locked while the blocks are made, only while the snapshot gets the changes
+    EntityTreeSnapshot snapshot = takeSnapshot();
+    std::map<EntityTypes::EntityType, std::vector<const EntityItemProperties*>> entitiesByType;
+    for (const auto& properties : snapshot) {
+        // same as the JSON, nothing that lost its parent. The parents are looked for in the snapshot, where the
+        // entities parented to avatars are never found, as on the entity server.
+        const QUuid& parentID = properties->getParentID();
+        if (parentID.isNull() || snapshot.contains(parentID)) {
+            entitiesByType[properties->getType()].push_back(properties.get());
         }
+    }
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+    QScriptEngine scriptEngine;
+    for (const auto& typeEntities : entitiesByType) {
+        const auto& entities = typeEntities.second;
+        for (size_t blockStart = 0; blockStart < entities.size(); blockStart += BINARY_PERSIST_BLOCK_SIZE) {
+            size_t blockEnd = std::min(entities.size(), blockStart + BINARY_PERSIST_BLOCK_SIZE);
+
+            std::vector<QVariantMap> entityMaps;
+            QStringList names;
+            QHash<QString, int> nameIndices;
+            for (size_t i = blockStart; i < blockEnd; ++i) {
+                QVariantMap entityMap = EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, *entities[i]).toVariant().toMap();
+                for (auto property = entityMap.cbegin(); property != entityMap.cend(); ++property) {
+                    if (!nameIndices.contains(property.key())) {
+                        nameIndices[property.key()] = names.size();
+                        names << property.key();
+                    }
+                }
+                entityMaps.push_back(entityMap);
             }
-        }
-
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
-        }
-
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+            if (entityMaps.empty()) {
+                continue;
             }
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+            QByteArray block;
+            QDataStream blockStream(&block, QIODevice::WriteOnly);
+            blockStream.setVersion(OctreeBinaryPersist::STREAM_VERSION);
+            blockStream << (quint32)entityMaps.size() << names;
+            for (const auto& name : names) {
+                for (const auto& entityMap : entityMaps) {
+                    blockStream << entityMap.value(name);
                 }
             }
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+            QByteArray compressedBlock;
+            if (!gzip(block, compressedBlock, -1)) {
+                qCritical("Unable to gzip entities block while saving to binary.");
+                return false;
+            }
+            OctreeBinaryPersist::writeBlock(out, compressedBlock);
+            if (out.status() != QDataStream::Ok) {
+                return false;
             }
         }
+    }
+
+    return true;
+}
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+bool EntityTree::decodeBinaryBlock(const QByteArray& compressedBlock, int contentVersion,
+                                   std::vector<LoadedEntity>& loadedEntities) const {
+    QByteArray block;
+    if (!gunzip(compressedBlock, block)) {
+        qCritical() << "Binary entities block not in gzip format";
+        return false;
+    }
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
+    QDataStream blockStream(block);
+    blockStream.setVersion(OctreeBinaryPersist::STREAM_VERSION);
+    quint32 numEntities;
+    QStringList names;
+    blockStream >> numEntities >> names;
+    if (blockStream.status() != QDataStream::Ok || numEntities > (quint32)BINARY_PERSIST_BLOCK_SIZE) {
+        qCritical() << "Couldn't read binary entities block";
+        return false;
+    }
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
+    std::vector<QVariantMap> entityMaps(numEntities);
+    for (const auto& name : names) {
+        for (auto& entityMap : entityMaps) {
+            QVariant value;
+            blockStream >> value;
+            if (value.isValid()) {
+                entityMap[name] = value;
             }
         }
+    }
+    if (blockStream.status() != QDataStream::Ok) {
+        qCritical() << "Couldn't read binary entities block";
+        return false;
+    }
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+    QScriptEngine scriptEngine;
+    loadedEntities.resize(numEntities);
+    for (quint32 i = 0; i < numEntities; ++i) {
+        loadedEntityFromMap(entityMaps[i], contentVersion, scriptEngine, loadedEntities[i]);
+    }
+    return true;
+}
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+bool EntityTree::readFromBinary(QDataStream& in, const OctreeBinaryPersist::Header& header) {
+    std::vector<QByteArray> compressedBlocks;
+    while (true) {
+        QByteArray compressedBlock;
+        bool isEnd;
+        if (!OctreeBinaryPersist::readBlock(in, compressedBlock, isEnd)) {
+            qCritical() << "Binary entities data is damaged or incomplete";
+            return false;
+        }
+        if (isEnd) {
+            break;
+        }
+        compressedBlocks.push_back(compressedBlock);
+    }
+
+    if (!header.id.isNull()) {
+        _persistID = header.id;
+    }
+    _persistDataVersion = header.dataVersion;
+    _namedPaths.clear();
+
+    if (compressedBlocks.empty()) {
+        // same as an empty JSON file
+        return false;
+    }
+
+    // The blocks are decoded and turned into properties on the tbb workers, a batch of blocks at a time so there's never
+    // more than a few blocks worth of properties around. Adding the entities to the tree stays on this thread.
+    static const size_t BINARY_DECODE_BATCH_BLOCKS = 16;
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    bool success = true;
+    for (size_t batchStart = 0; batchStart < compressedBlocks.size(); batchStart += BINARY_DECODE_BATCH_BLOCKS) {
+        size_t batchEnd = std::min(compressedBlocks.size(), batchStart + BINARY_DECODE_BATCH_BLOCKS);
+
+        std::vector<std::vector<LoadedEntity>> loadedBlocks(batchEnd - batchStart);
+        std::atomic<bool> decodeFailed { false };
+        tbb::parallel_for(tbb::blocked_range<size_t>(batchStart, batchEnd, 1), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                if (!decodeBinaryBlock(compressedBlocks[i], (int)header.version, loadedBlocks[i - batchStart])) {
+                    decodeFailed = true;
+                }
             }
+        });
+        if (decodeFailed) {
+            return false;
         }
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
+        for (const auto& loadedBlock : loadedBlocks) {
+            for (const auto& loaded : loadedBlock) {
+                if (!addLoadedEntity(loaded, false, cloneIDs)) {
+                    success = false;
+                }
+            }
         }
+    }
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
+    setLoadedCloneIDs(cloneIDs);
+    return success;
+}
+
+void EntityTree::journalEntityChange(const EntityItemID& entityID) {
+    if (_wantJournal || _wantSnapshotChanges) {
+        std::lock_guard<std::mutex> lock(_journalLock);
+        if (_wantJournal) {
+            _journalDeletedIDs.remove(entityID);
+            _journalChangedIDs.insert(entityID);
+        }
+        if (_wantSnapshotChanges) {
+            _snapshotDeletedIDs.remove(entityID);
+            _snapshotChangedIDs.insert(entityID);
         }
+    }
+}
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
-            }
+void EntityTree::journalEntityDelete(const EntityItemID& entityID) {
+    if (_wantJournal || _wantSnapshotChanges) {
+        std::lock_guard<std::mutex> lock(_journalLock);
+        if (_wantJournal) {
+            _journalChangedIDs.remove(entityID);
+            _journalDeletedIDs.insert(entityID);
+        }
+        if (_wantSnapshotChanges) {
+            _snapshotChangedIDs.remove(entityID);
+            _snapshotDeletedIDs.insert(entityID);
         }
+    }
+}
 
-        // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
-        if (contentVersion < (int)EntityVersion::AllBillboardMode) {
-            if (properties.getBillboardMode() != BillboardMode::NONE) {
-                properties.setRotation(glm::quat());
+void EntityTree::entitiesMovedBySimulation(const std::vector<EntityItemPointer>& entities) {
+    if (_wantJournal || _wantSnapshotChanges) {
+        std::lock_guard<std::mutex> lock(_journalLock);
+        for (const auto& entity : entities) {
+            const EntityItemID& entityID = entity->getEntityItemID();
+            if (_wantJournal) {
+                _journalDeletedIDs.remove(entityID);
+                _journalChangedIDs.insert(entityID);
+            }
+            if (_wantSnapshotChanges) {
+                _snapshotDeletedIDs.remove(entityID);
+                _snapshotChangedIDs.insert(entityID);
             }
         }
+    }
+}
 
-        EntityItemPointer entity = addEntity(entityItemID, properties, isImport);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
-            success = false;
+EntityTreeSnapshot EntityTree::takeSnapshot() {
+    std::lock_guard<std::mutex> snapshotLock(_snapshotLock);
+
+    // the changes made from here on are in the next snapshot, they may be in this one too
+    bool isFirstSnapshot = !_wantSnapshotChanges.exchange(true);
+    QSet<EntityItemID> changedIDs;
+    QSet<EntityItemID> deletedIDs;
+    {
+        std::lock_guard<std::mutex> lock(_journalLock);
+        changedIDs.swap(_snapshotChangedIDs);
+        deletedIDs.swap(_snapshotDeletedIDs);
+    }
+
+    // when the previous snapshot is still held, the first change copies the hash, though not the properties
+    withReadLock([&] {
+        if (isFirstSnapshot) {
+            QReadLocker locker(&_entityMapLock);
+            _snapshot.reserve(_entityMap.size());
+            for (const auto& entity : _entityMap) {
+                if (entity->getElement()) {
+                    _snapshot.insert(entity->getEntityItemID(), std::make_shared<const EntityItemProperties>(entity->getProperties()));
+                }
+            }
+            return;
         }
 
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        for (const auto& entityID : changedIDs) {
+            EntityItemPointer entity = findEntityByEntityItemID(entityID);
+            if (entity && entity->getElement()) {
+                _snapshot.insert(entityID, std::make_shared<const EntityItemProperties>(entity->getProperties()));
+            } else {
+                _snapshot.remove(entityID);
             }
         }
+    });
+    for (const auto& entityID : deletedIDs) {
+        _snapshot.remove(entityID);
     }
 
-    for (const auto& entityID : cloneIDs.keys()) {
-        auto entity = findEntityByID(entityID);
-        if (entity) {
-            entity->setCloneIDs(cloneIDs.value(entityID));
+    return _snapshot;
+}
+
+namespace {
+const quint8 JOURNAL_EDIT = 0;
+const quint8 JOURNAL_DELETE = 1;
+}
+
+// A journal block is a list of records, each either an entity's complete properties or its deletion. Complete
+// properties make the records idempotent, so an entity that also made it into the snapshot is simply written again.
+bool EntityTree::takeJournalChanges(QByteArray& compressedBlock) {
+    QSet<EntityItemID> changedIDs;
+    QSet<EntityItemID> deletedIDs;
+    {
+        std::lock_guard<std::mutex> lock(_journalLock);
+        changedIDs.swap(_journalChangedIDs);
+        deletedIDs.swap(_journalDeletedIDs);
+    }
+    if (changedIDs.empty() && deletedIDs.empty()) {
+        return false;
+    }
+
+    QByteArray block;
+    QDataStream blockStream(&block, QIODevice::WriteOnly);
+    blockStream.setVersion(OctreeBinaryPersist::STREAM_VERSION);
+    blockStream << (quint32)(changedIDs.size() + deletedIDs.size());
+
+    QScriptEngine scriptEngine;
+    withReadLock([&] {
+        for (const auto& entityID : changedIDs) {
+            EntityItemPointer entity = findEntityByEntityItemID(entityID);
+            if (entity && entity->getElement()) {
+                QVariantMap entityMap = EntityItemPropertiesToScriptValue(&scriptEngine, entity->getProperties()).toVariant().toMap();
+                blockStream << JOURNAL_EDIT << (QUuid)entityID << entityMap;
+            } else {
+                blockStream << JOURNAL_DELETE << (QUuid)entityID;
+            }
         }
+    });
+    for (const auto& entityID : deletedIDs) {
+        blockStream << JOURNAL_DELETE << (QUuid)entityID;
     }
 
-    return success;
+    if (!gzip(block, compressedBlock, -1)) {
+        qCritical("Unable to gzip journal block.");
+        return false;
+    }
+    return true;
 }
 
-bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
+bool EntityTree::readJournalBlock(const QByteArray& compressedBlock, int64_t contentVersion) {
+    QByteArray block;
+    if (!gunzip(compressedBlock, block)) {
+        qCritical() << "Journal block not in gzip format";
+        return false;
+    }
+
+    QDataStream blockStream(block);
+    blockStream.setVersion(OctreeBinaryPersist::STREAM_VERSION);
+    quint32 numRecords;
+    blockStream >> numRecords;
+
+    // only the last record of each entity matters
+    QHash<QUuid, QVariantMap> editedEntities;
+    QSet<QUuid> deletedEntities;
+    for (quint32 i = 0; i < numRecords && blockStream.status() == QDataStream::Ok; ++i) {
+        quint8 recordType;
+        QUuid entityID;
+        blockStream >> recordType >> entityID;
+        if (recordType == JOURNAL_EDIT) {
+            QVariantMap entityMap;
+            blockStream >> entityMap;
+            editedEntities[entityID] = entityMap;
+            deletedEntities.remove(entityID);
+        } else {
+            editedEntities.remove(entityID);
+            deletedEntities.insert(entityID);
+        }
+    }
+    if (blockStream.status() != QDataStream::Ok) {
+        qCritical() << "Couldn't read journal block";
+        return false;
+    }
+
+    for (const auto& entityID : deletedEntities) {
+        deleteEntity(entityID, true, true);
+    }
+
+    // entities that are still around take their new properties in place, deleting them would take their children too
     QScriptEngine scriptEngine;
-    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
-    withReadLock([&] {
+    QVariantList addedEntities;
+    for (auto edited = editedEntities.cbegin(); edited != editedEntities.cend(); ++edited) {
+        EntityItemPointer entity = findEntityByEntityItemID(edited.key());
+        if (!entity || !entity->getElement()) {
+            addedEntities << edited.value();
+            continue;
+        }
+
+        QVariantMap entityMap = edited.value();
+        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+        EntityItemProperties properties;
+        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+        QUuid parentIDBefore = entity->getParentID();
+        UpdateEntityOperator theOperator(getThisPointer(), entity->getElement(), entity, properties.getQueryAACube());
         recurseTreeWithOperator(&theOperator);
-    });
+        entity->setProperties(properties);
+        if (entity->getParentID() != parentIDBefore) {
+            addToNeedsParentFixupList(entity);
+        }
+    }
+    fixupNeedsParentFixups();
 
-    jsonString = theOperator.getJson();
+    if (!addedEntities.empty()) {
+        QVariantMap map;
+        map["Version"] = (int)contentVersion;
+        map["Entities"] = addedEntities;
+        return readFromMap(map);
+    }
     return true;
 }
 
@@ -12,6 +12,11 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+#include <cfloat>
+#include <mutex>
+#include <vector>
+
 #include <QSet>
 #include <QVector>
 
@@ -21,12 +26,20 @@
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
+#include "EntityTreeBVH.h"
+#include "EntityTreeGrid.h"
 #include "MovingEntitiesOperator.h"
 
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
 class EntitySimulation;
+class QScriptEngine;
+
+// The properties of the entities as of an EntityTree::takeSnapshot, unchanged entities share theirs between snapshots.
+// Implicitly shared, a copy costs nothing.
+using EntityPropertiesPointer = std::shared_ptr<const EntityItemProperties>;
+using EntityTreeSnapshot = QHash<EntityItemID, EntityPropertiesPointer>;
 
 namespace EntityQueryFilterSymbol {
     static const QString NonDefault = "+";
@@ -64,6 +77,15 @@ public:
     void setEntityMaxTmpLifetime(float maxTmpEntityLifetime) { _maxTmpEntityLifetime = maxTmpEntityLifetime; }
     void setEntityScriptSourceWhitelist(const QString& entityScriptSourceWhitelist);
 
+    // What answers the sphere, cube, box and closest entity queries. The octree is kept either way, to send and persist
+    // the entities: the grid is an index next to it, for domains of many small entities that move a lot.
+    enum class SpatialIndex {
+        Octree,
+        Grid
+    };
+    void setSpatialIndex(SpatialIndex spatialIndex);
+    SpatialIndex getSpatialIndex() const { return _spatialIndex; }
+
     /// Implements our type specific root element factory
     virtual OctreeElementPointer createNewElement(unsigned char* octalCode = NULL) override;
 
@@ -106,6 +128,27 @@ public:
         float& distance, float& parabolicDistance, BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
         Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
 
+    struct RayPick {
+        // Inputs
+        glm::vec3 origin;
+        glm::vec3 direction;
+        QVector<EntityItemID> entityIdsToInclude;
+        QVector<EntityItemID> entityIdsToDiscard;
+        PickFilter searchFilter;
+
+        // Outputs
+        EntityItemID entityID;
+        OctreeElementPointer element;
+        float distance { FLT_MAX };
+        BoxFace face { UNKNOWN_FACE };
+        glm::vec3 surfaceNormal;
+        QVariantMap extraInfo;
+    };
+
+    // Finds the closest hit of every pick in a single walk of the picking BVH, for callers with many rays at once.
+    void evalRayIntersections(std::vector<RayPick>& picks, Octree::lockType lockType = Octree::TryLock,
+                              bool* accurateResult = NULL);
+
     virtual bool rootElementHasData() const override { return true; }
 
     virtual void releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncodeData) const override;
@@ -141,6 +184,10 @@ public:
     void evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities);
+    // the zones and the entities with a script, the only ones that can be entered and left, touching the sphere
+    void evalZonesAndScriptedEntitiesInSphere(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities);
+
+    int getNumEntitiesOfType(EntityTypes::EntityType type) const;
     void evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities);
@@ -171,6 +218,9 @@ public:
     EntityTreeElementPointer getContainingElement(const EntityItemID& entityItemID)  /*const*/;
     void addEntityMapEntry(EntityItemPointer entity);
     void clearEntityMapEntry(const EntityItemID& id);
+    void updateEntityNameIndex(const EntityItemID& id, const QString& name); // called by EntityItem::setName
+    void updateEntityScriptIndex(const EntityItemID& id, bool hasScript); // called by EntityItem::setScript
+    void updateEntityPickBounds(const EntityItemID& id); // called when an entity moves
     void debugDumpMap();
     virtual void dumpTree() override;
     virtual void pruneTree() override;
@@ -197,7 +247,25 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
+    virtual void beginReadingEntities(const QVariantMap& header, const bool isImport) override;
+    virtual void readEntitiesBatch(const QVariantList& entities) override;
+    virtual bool endReadingEntities() override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToBinary(QDataStream& out) override;
+    virtual bool readFromBinary(QDataStream& in, const OctreeBinaryPersist::Header& header) override;
+
+    static const int BINARY_PERSIST_BLOCK_SIZE = 1024; // entities per block
+
+    virtual void setWantJournal(bool wantJournal) override { _wantJournal = wantJournal; }
+    virtual bool takeJournalChanges(QByteArray& compressedBlock) override;
+    virtual bool readJournalBlock(const QByteArray& compressedBlock, int64_t contentVersion) override;
+
+    // The properties of all the entities in the tree, for writing them without holding the lock of the tree. Only the
+    // entities changed since the previous snapshot get their properties under the read lock, so the edits wait on the
+    // persist for as long as it takes to copy the changes. The first snapshot copies all the entities.
+    EntityTreeSnapshot takeSnapshot();
+    // the changes of the simulation don't go through updateEntity
+    void entitiesMovedBySimulation(const std::vector<EntityItemPointer>& entities);
 
 
     glm::vec3 getContentsDimensions();
@@ -330,6 +398,37 @@ protected:
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
 
+    // Secondary indexes of _entityMap for the type and name queries. When the index has few enough entities for a
+    // query those are checked directly, otherwise the query goes through the octree as before.
+    static const int MAX_INDEXED_CANDIDATES = 512;
+    void indexEntity(const EntityItemPointer& entity);
+    void unindexEntity(const EntityItemID& id);
+    void rebuildEntityIndexes();
+    template <typename Key>
+    bool getIndexedEntities(const QHash<Key, QSet<EntityItemID>>& index, const Key& key,
+                            QVector<EntityItemPointer>& entities) const;
+
+    mutable QReadWriteLock _entityIndexLock;
+    QHash<EntityTypes::EntityType, QSet<EntityItemID>> _entitiesByType;
+    QHash<QString, QSet<EntityItemID>> _entitiesByName;
+    QHash<QString, QSet<EntityItemID>> _entitiesByFoldedName; // lower case names
+    QHash<EntityItemID, EntityTypes::EntityType> _indexedTypes;
+    QHash<EntityItemID, QString> _indexedNames;
+    QSet<EntityItemID> _entitiesWithScripts;
+
+    std::vector<EntityItemPointer> getAllEntities() const;
+
+    void updatePickBVH() const;
+    mutable EntityTreeBVH _pickBVH;
+
+    bool isUsingSpatialGrid() const { return _spatialIndex == SpatialIndex::Grid; }
+    void updateSpatialGrid() const;
+    template <typename Accept>
+    void evalGridEntitiesInSphere(const glm::vec3& center, float radius, QVector<QUuid>& foundEntities, Accept accept) const;
+    void evalGridEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
+    std::atomic<SpatialIndex> _spatialIndex { SpatialIndex::Octree };
+    mutable EntityTreeGrid _spatialGrid;
+
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, QList<EntityItemID>> _entityCertificateIDMap;
 
@@ -403,6 +502,39 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    struct LoadedEntity {
+        EntityItemID id;
+        EntityItemProperties properties;
+    };
+    void loadedEntityFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                             LoadedEntity& loaded) const;
+    bool addLoadedEntity(const LoadedEntity& loaded, bool isImport, QMap<QUuid, QVector<QUuid>>& cloneIDs);
+    void setLoadedCloneIDs(const QMap<QUuid, QVector<QUuid>>& cloneIDs);
+
+    // while the entities are read in batches, the clones are only told about once they're all there
+    int _readingContentVersion { 0 };
+    bool _isReadingImport { false };
+    bool _hasReadingFailed { false };
+    int _numEntitiesRead { 0 };
+    QMap<QUuid, QVector<QUuid>> _readingCloneIDs;
+    bool decodeBinaryBlock(const QByteArray& compressedBlock, int contentVersion,
+                           std::vector<LoadedEntity>& loadedEntities) const;
+
+    void journalEntityChange(const EntityItemID& entityID);
+    void journalEntityDelete(const EntityItemID& entityID);
+
+    std::atomic<bool> _wantJournal { false };
+    std::mutex _journalLock;
+    QSet<EntityItemID> _journalChangedIDs;
+    QSet<EntityItemID> _journalDeletedIDs;
+
+    // the changes since the last snapshot are tracked once there was one, under the lock of the journal
+    std::atomic<bool> _wantSnapshotChanges { false };
+    QSet<EntityItemID> _snapshotChangedIDs;
+    QSet<EntityItemID> _snapshotDeletedIDs;
+    std::mutex _snapshotLock;
+    EntityTreeSnapshot _snapshot;
+
     // Return an AACube containing object and all its entity descendants
     AACube updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                          MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
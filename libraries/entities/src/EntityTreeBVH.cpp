@@ -0,0 +1,205 @@
+//
+//  EntityTreeBVH.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-17.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBVH.h"
+
+#include <algorithm>
+#include <cfloat>
+
+void EntityTreeBVH::markMoved(const EntityItemID& id) {
+    if (!_isBuilt) {
+        return; // the first build picks up everything
+    }
+
+    std::lock_guard<std::mutex> lock(_movedMutex);
+    _moved.insert(id);
+    _hasMoved = true;
+}
+
+void EntityTreeBVH::update(const std::function<std::vector<EntityItemPointer>()>& getEntities) {
+    if (!_needsRebuild && !_hasMoved) {
+        return;
+    }
+
+    withWriteLock([&] {
+        // clear the flags before looking at the entities so that changes made meanwhile are caught by the next update
+        bool needsRebuild = _needsRebuild.exchange(false);
+        QSet<EntityItemID> moved;
+        {
+            std::lock_guard<std::mutex> lock(_movedMutex);
+            moved.swap(_moved);
+            _hasMoved = false;
+        }
+
+        if (!needsRebuild && _refitsSinceRebuild + moved.size() > (int)_items.size()) {
+            needsRebuild = true;
+        }
+
+        if (needsRebuild) {
+            rebuild(getEntities());
+            return;
+        }
+
+        for (const auto& id : moved) {
+            auto itemIndex = _itemIndexes.find(id);
+            if (itemIndex != _itemIndexes.end()) {
+                refit(itemIndex.value());
+            }
+        }
+        _refitsSinceRebuild += moved.size();
+    });
+}
+
+bool EntityTreeBVH::rayHitsBounds(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
+                                  const glm::vec3& minCorner, const glm::vec3& maxCorner, float maxDistance) {
+    float nearDistance = 0.0f;
+    float farDistance = maxDistance;
+    for (int i = 0; i < 3; i++) {
+        if (direction[i] == 0.0f) {
+            if (origin[i] < minCorner[i] || origin[i] > maxCorner[i]) {
+                return false;
+            }
+            continue;
+        }
+
+        float distance1 = (minCorner[i] - origin[i]) * invDirection[i];
+        float distance2 = (maxCorner[i] - origin[i]) * invDirection[i];
+        if (distance1 > distance2) {
+            std::swap(distance1, distance2);
+        }
+        nearDistance = std::max(nearDistance, distance1);
+        farDistance = std::min(farDistance, distance2);
+        if (nearDistance > farDistance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void EntityTreeBVH::computeBounds(Item& item) {
+    bool success;
+    AABox box = item.entity->getAABox(success);
+    if (!success) {
+        item.minCorner = glm::vec3(FLT_MAX);
+        item.maxCorner = glm::vec3(-FLT_MAX);
+        item.center = glm::vec3(0.0f);
+        return;
+    }
+
+    // the per entity broadphase tests the box's bounding sphere, which doesn't depend on billboarding
+    item.center = box.calcCenter();
+    glm::vec3 radius = glm::vec3(0.5f * glm::length(box.getScale()));
+    item.minCorner = item.center - radius;
+    item.maxCorner = item.center + radius;
+}
+
+void EntityTreeBVH::rebuild(std::vector<EntityItemPointer> entities) {
+    _items.clear();
+    _items.reserve(entities.size());
+    for (auto& entity : entities) {
+        Item item;
+        item.entity = std::move(entity);
+        item.leaf = -1;
+        computeBounds(item);
+        _items.push_back(std::move(item));
+    }
+
+    _nodes.clear();
+    _parents.clear();
+    if (!_items.empty()) {
+        _nodes.reserve(2 * _items.size() / MAX_LEAF_ENTITIES + 1);
+        _parents.reserve(_nodes.capacity());
+        build(0, (int)_items.size(), -1);
+    }
+
+    _itemIndexes.clear();
+    _itemIndexes.reserve((int)_items.size());
+    for (int i = 0; i < (int)_items.size(); i++) {
+        _itemIndexes.insert(_items[i].entity->getEntityItemID(), i);
+    }
+
+    _refitsSinceRebuild = 0;
+    _isBuilt = true;
+}
+
+int EntityTreeBVH::build(int begin, int end, int parent) {
+    int index = (int)_nodes.size();
+    _nodes.push_back(Node());
+    _parents.push_back(parent);
+
+    glm::vec3 minCorner(FLT_MAX);
+    glm::vec3 maxCorner(-FLT_MAX);
+    glm::vec3 minCenter(FLT_MAX);
+    glm::vec3 maxCenter(-FLT_MAX);
+    for (int i = begin; i < end; i++) {
+        const Item& item = _items[i];
+        minCorner = glm::min(minCorner, item.minCorner);
+        maxCorner = glm::max(maxCorner, item.maxCorner);
+        minCenter = glm::min(minCenter, item.center);
+        maxCenter = glm::max(maxCenter, item.center);
+    }
+
+    if (end - begin <= MAX_LEAF_ENTITIES) {
+        for (int i = begin; i < end; i++) {
+            _items[i].leaf = index;
+        }
+        _nodes[index] = { minCorner, begin, maxCorner, end - begin };
+        return index;
+    }
+
+    // split at the median along the axis the centers are most spread over
+    glm::vec3 spread = maxCenter - minCenter;
+    int axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+    int middle = begin + (end - begin) / 2;
+    std::nth_element(_items.begin() + begin, _items.begin() + middle, _items.begin() + end,
+        [axis](const Item& a, const Item& b) {
+            return a.center[axis] < b.center[axis];
+        });
+
+    build(begin, middle, index);
+    int right = build(middle, end, index);
+    _nodes[index] = { minCorner, right, maxCorner, 0 };
+    return index;
+}
+
+void EntityTreeBVH::refit(int itemIndex) {
+    computeBounds(_items[itemIndex]);
+
+    // ancestors only need refitting up to the first one whose bounds stay the same
+    int nodeIndex = _items[itemIndex].leaf;
+    while (nodeIndex != -1 && fitNode(nodeIndex)) {
+        nodeIndex = _parents[nodeIndex];
+    }
+}
+
+bool EntityTreeBVH::fitNode(int nodeIndex) {
+    Node& node = _nodes[nodeIndex];
+    glm::vec3 minCorner(FLT_MAX);
+    glm::vec3 maxCorner(-FLT_MAX);
+    if (node.count > 0) {
+        for (int i = node.offset; i < node.offset + node.count; i++) {
+            minCorner = glm::min(minCorner, _items[i].minCorner);
+            maxCorner = glm::max(maxCorner, _items[i].maxCorner);
+        }
+    } else {
+        const Node& left = _nodes[nodeIndex + 1];
+        const Node& right = _nodes[node.offset];
+        minCorner = glm::min(left.minCorner, right.minCorner);
+        maxCorner = glm::max(left.maxCorner, right.maxCorner);
+    }
+
+    if (minCorner == node.minCorner && maxCorner == node.maxCorner) {
+        return false;
+    }
+    node.minCorner = minCorner;
+    node.maxCorner = maxCorner;
+    return true;
+}
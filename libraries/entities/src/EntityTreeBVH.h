@@ -0,0 +1,162 @@
+//
+//  EntityTreeBVH.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-17.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBVH_h
+#define hifi_EntityTreeBVH_h
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+
+#include <glm/glm.hpp>
+
+#include <shared/ReadWriteLockable.h>
+
+#include "EntityItem.h"
+
+// Bounding volume hierarchy over the entities of a tree, used for picking.
+//
+// The octree only bounds where an entity may be, so a pick tests every entity of every cell along the ray. The BVH is
+// built over the bounding sphere of each entity's AABox instead, which is what the per entity broadphase tests, and is
+// flattened into an array of 32 byte nodes in depth first order.
+//
+// Adding or removing entities flags the BVH to be rebuilt before the next pick. Entities that move only have their
+// leaf and its ancestors refit, until there have been more refits than entities and a rebuild is cheaper than the
+// slower traversals.
+//
+//   EntityTreeBVH is thread-safe. EntityTree updates it from the picks that need it.
+class EntityTreeBVH : public ReadWriteLockable {
+public:
+    static const int MAX_LEAF_ENTITIES = 4;
+
+    void markNeedsRebuild() { _needsRebuild = true; }
+    void markMoved(const EntityItemID& id);
+
+    // getEntities is only called if the hierarchy has to be rebuilt
+    void update(const std::function<std::vector<EntityItemPointer>()>& getEntities);
+
+    // Walks the hierarchy for numQueries queries at once, visiting the nodes nearer to nearPoint first.
+    // hitsBounds(query, minCorner, maxCorner) decides if a query reaches a node, visit(query, entity) is called for every
+    // entity of the leaves a query reaches.
+    template <typename HitsBounds, typename Visit>
+    void traverse(int numQueries, const glm::vec3& nearPoint, HitsBounds hitsBounds, Visit visit) const;
+
+    static bool rayHitsBounds(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
+                              const glm::vec3& minCorner, const glm::vec3& maxCorner, float maxDistance);
+
+private:
+    // a leaf has count entities from offset, otherwise the left child follows the node and offset is the right child
+    struct Node {
+        glm::vec3 minCorner;
+        int32_t offset;
+        glm::vec3 maxCorner;
+        int32_t count;
+    };
+
+    struct Item {
+        EntityItemPointer entity;
+        glm::vec3 minCorner;
+        glm::vec3 maxCorner;
+        glm::vec3 center;
+        int leaf;
+    };
+
+    struct StackEntry {
+        int node;
+        int begin; // the range of activeQueries that reached the parent
+        int end;
+    };
+
+    static void computeBounds(Item& item);
+
+    void rebuild(std::vector<EntityItemPointer> entities);
+    int build(int begin, int end, int parent);
+    void refit(int itemIndex);
+    bool fitNode(int nodeIndex);
+
+    std::vector<Node> _nodes;
+    std::vector<int> _parents;
+    std::vector<Item> _items;
+    QHash<EntityItemID, int> _itemIndexes;
+    int _refitsSinceRebuild { 0 };
+
+    std::mutex _movedMutex;
+    QSet<EntityItemID> _moved;
+    std::atomic<bool> _hasMoved { false };
+    std::atomic<bool> _needsRebuild { true };
+    std::atomic<bool> _isBuilt { false };
+};
+
+template <typename HitsBounds, typename Visit>
+void EntityTreeBVH::traverse(int numQueries, const glm::vec3& nearPoint, HitsBounds hitsBounds, Visit visit) const {
+    withReadLock([&] {
+        if (_nodes.empty() || numQueries <= 0) {
+            return;
+        }
+
+        std::vector<int> activeQueries(numQueries);
+        std::iota(activeQueries.begin(), activeQueries.end(), 0);
+        std::vector<StackEntry> stack;
+        stack.push_back({ 0, 0, numQueries });
+
+        while (!stack.empty()) {
+            StackEntry entry = stack.back();
+            stack.pop_back();
+            const Node& node = _nodes[entry.node];
+            if (node.minCorner.x > node.maxCorner.x) {
+                continue; // nothing in it has bounds yet
+            }
+
+            int begin = (int)activeQueries.size();
+            for (int i = entry.begin; i < entry.end; i++) {
+                int query = activeQueries[i];
+                if (hitsBounds(query, node.minCorner, node.maxCorner)) {
+                    activeQueries.push_back(query);
+                }
+            }
+            int end = (int)activeQueries.size();
+            if (begin == end) {
+                continue;
+            }
+
+            if (node.count > 0) {
+                for (int item = node.offset; item < node.offset + node.count; item++) {
+                    for (int i = begin; i < end; i++) {
+                        visit(activeQueries[i], _items[item].entity);
+                    }
+                }
+                continue;
+            }
+
+            // push the farther child first so that the nearer one is walked first, and tightens the queries' distances
+            int left = entry.node + 1;
+            int right = node.offset;
+            const Node& leftNode = _nodes[left];
+            const Node& rightNode = _nodes[right];
+            glm::vec3 leftOffset = 0.5f * (leftNode.minCorner + leftNode.maxCorner) - nearPoint;
+            glm::vec3 rightOffset = 0.5f * (rightNode.minCorner + rightNode.maxCorner) - nearPoint;
+            if (glm::dot(leftOffset, leftOffset) < glm::dot(rightOffset, rightOffset)) {
+                stack.push_back({ right, begin, end });
+                stack.push_back({ left, begin, end });
+            } else {
+                stack.push_back({ left, begin, end });
+                stack.push_back({ right, begin, end });
+            }
+        }
+    });
+}
+
+#endif // hifi_EntityTreeBVH_h
@@ -197,79 +197,92 @@ EntityItemID EntityTreeElement::evalDetailedRayIntersection(const glm::vec3& ori
     // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
     EntityItemID entityID;
     forEachEntity([&](EntityItemPointer entity) {
-        if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
-            return;
+        if (evalEntityRayIntersection(entity, origin, direction, viewFrustumPos, element, distance, face, surfaceNormal,
+                                      entityIdsToInclude, entityIDsToDiscard, searchFilter, extraInfo)) {
+            entityID = entity->getEntityItemID();
         }
+    });
+    return entityID;
+}
 
-        // use simple line-sphere for broadphase check
-        // (this is faster and more likely to cull results than the filter check below so we do it first)
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        if (!success || !entityBox.rayHitsBoundingSphere(origin, direction)) {
-            return;
-        }
+bool EntityTreeElement::evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                                    const glm::vec3& direction, const glm::vec3& viewFrustumPos, OctreeElementPointer& element,
+                                    float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+                                    const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIDsToDiscard,
+                                    PickFilter searchFilter, QVariantMap& extraInfo) {
+    bool hit = false;
+    if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
+        return false;
+    }
 
-        if (!checkFilterSettings(entity, searchFilter) ||
-            (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
-            (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
-            return;
-        }
+    // use simple line-sphere for broadphase check
+    // (this is faster and more likely to cull results than the filter check below so we do it first)
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    if (!success || !entityBox.rayHitsBoundingSphere(origin, direction)) {
+        return false;
+    }
 
-        // extents is the entity relative, scaled, centered extents of the entity
-        glm::vec3 position = entity->getWorldPosition();
-        glm::mat4 translation = glm::translate(position);
-        BillboardMode billboardMode = entity->getBillboardMode();
-        glm::quat orientation = billboardMode == BillboardMode::NONE ? entity->getWorldOrientation() : entity->getLocalOrientation();
-        glm::mat4 rotation = glm::mat4_cast(BillboardModeHelpers::getBillboardRotation(position, orientation, billboardMode,
-            viewFrustumPos, entity->getRotateForPicking()));
-        glm::mat4 entityToWorldMatrix = translation * rotation;
-        glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-        glm::vec3 dimensions = entity->getScaledDimensions();
-        glm::vec3 registrationPoint = entity->getRegistrationPoint();
-        glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
-
-        AABox entityFrameBox(corner, dimensions);
-
-        glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
-        glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
-
-        // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
-        // and testing intersection there.
-        float localDistance;
-        BoxFace localFace { UNKNOWN_FACE };
-        glm::vec3 localSurfaceNormal;
-        if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, 1.0f / entityFrameDirection, localDistance,
-                                                localFace, localSurfaceNormal)) {
-            if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
-                // now ask the entity if we actually intersect
-                if (entity->supportsDetailedIntersection()) {
-                    QVariantMap localExtraInfo;
-                    if (entity->findDetailedRayIntersection(origin, direction, viewFrustumPos, element, localDistance,
-                            localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
-                        if (localDistance < distance) {
-                            distance = localDistance;
-                            face = localFace;
-                            surfaceNormal = localSurfaceNormal;
-                            extraInfo = localExtraInfo;
-                            entityID = entity->getEntityItemID();
-                        }
-                    }
-                } else {
-                    // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
-                    // Never intersect with particle entities
-                    if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+    if (!checkFilterSettings(entity, searchFilter) ||
+        (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
+        (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
+        return false;
+    }
+
+    // extents is the entity relative, scaled, centered extents of the entity
+    glm::vec3 position = entity->getWorldPosition();
+    glm::mat4 translation = glm::translate(position);
+    BillboardMode billboardMode = entity->getBillboardMode();
+    glm::quat orientation = billboardMode == BillboardMode::NONE ? entity->getWorldOrientation() : entity->getLocalOrientation();
+    glm::mat4 rotation = glm::mat4_cast(BillboardModeHelpers::getBillboardRotation(position, orientation, billboardMode,
+        viewFrustumPos, entity->getRotateForPicking()));
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 dimensions = entity->getScaledDimensions();
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
+    glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
+
+    // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
+    // and testing intersection there.
+    float localDistance;
+    BoxFace localFace { UNKNOWN_FACE };
+    glm::vec3 localSurfaceNormal;
+    if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, 1.0f / entityFrameDirection, localDistance,
+                                            localFace, localSurfaceNormal)) {
+        if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
+            // now ask the entity if we actually intersect
+            if (entity->supportsDetailedIntersection()) {
+                QVariantMap localExtraInfo;
+                if (entity->findDetailedRayIntersection(origin, direction, viewFrustumPos, element, localDistance,
+                        localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
+                    if (localDistance < distance) {
                         distance = localDistance;
                         face = localFace;
-                        surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
-                        extraInfo = QVariantMap();
-                        entityID = entity->getEntityItemID();
+                        surfaceNormal = localSurfaceNormal;
+                        extraInfo = localExtraInfo;
+                        hit = true;
                     }
                 }
+            } else {
+                // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
+                // Never intersect with particle entities
+                if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+                    distance = localDistance;
+                    face = localFace;
+                    surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
+                    extraInfo = QVariantMap();
+                    hit = true;
+                }
             }
         }
-    });
-    return entityID;
+    }
+    return hit;
 }
 
 // TODO: change this to use better bounding shape for entity than sphere
@@ -343,85 +356,99 @@ EntityItemID EntityTreeElement::evalDetailedParabolaIntersection(const glm::vec3
     // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
     EntityItemID entityID;
     forEachEntity([&](EntityItemPointer entity) {
-        if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
-            return;
+        if (evalEntityParabolaIntersection(entity, origin, velocity, acceleration, viewFrustumPos, normal, element,
+                                           parabolicDistance, face, surfaceNormal, entityIdsToInclude, entityIDsToDiscard,
+                                           searchFilter, extraInfo)) {
+            entityID = entity->getEntityItemID();
         }
+    });
+    return entityID;
+}
 
-        // use simple line-sphere for broadphase check
-        // (this is faster and more likely to cull results than the filter check below so we do it first)
-        bool success;
-        AABox entityBox = entity->getAABox(success);
+bool EntityTreeElement::evalEntityParabolaIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                                    const glm::vec3& velocity, const glm::vec3& acceleration, const glm::vec3& viewFrustumPos,
+                                    const glm::vec3& normal, OctreeElementPointer& element, float& parabolicDistance,
+                                    BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+                                    const QVector<EntityItemID>& entityIDsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo) {
+    bool hit = false;
+    if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
+        return false;
+    }
 
-        // Instead of checking parabolaInstersectsBoundingSphere here, we are just going to check if the plane
-        // defined by the parabola slices the sphere.  The solution to parabolaIntersectsBoundingSphere is cubic,
-        // the solution to which is more computationally expensive than the quadratic AABox::findParabolaIntersection
-        // below
-        if (!success || !entityBox.parabolaPlaneIntersectsBoundingSphere(origin, velocity, acceleration, normal)) {
-            return;
-        }
+    // use simple line-sphere for broadphase check
+    // (this is faster and more likely to cull results than the filter check below so we do it first)
+    bool success;
+    AABox entityBox = entity->getAABox(success);
 
-        if (!checkFilterSettings(entity, searchFilter) ||
-            (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
-            (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID()))) {
-            return;
-        }
+    // Instead of checking parabolaInstersectsBoundingSphere here, we are just going to check if the plane
+    // defined by the parabola slices the sphere.  The solution to parabolaIntersectsBoundingSphere is cubic,
+    // the solution to which is more computationally expensive than the quadratic AABox::findParabolaIntersection
+    // below
+    if (!success || !entityBox.parabolaPlaneIntersectsBoundingSphere(origin, velocity, acceleration, normal)) {
+        return false;
+    }
 
-        // extents is the entity relative, scaled, centered extents of the entity
-        glm::vec3 position = entity->getWorldPosition();
-        glm::mat4 translation = glm::translate(position);
-        BillboardMode billboardMode = entity->getBillboardMode();
-        glm::quat orientation = billboardMode == BillboardMode::NONE ? entity->getWorldOrientation() : entity->getLocalOrientation();
-        glm::mat4 rotation = glm::mat4_cast(BillboardModeHelpers::getBillboardRotation(position, orientation, billboardMode,
-            viewFrustumPos, entity->getRotateForPicking()));
-        glm::mat4 entityToWorldMatrix = translation * rotation;
-        glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-        glm::vec3 dimensions = entity->getScaledDimensions();
-        glm::vec3 registrationPoint = entity->getRegistrationPoint();
-        glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
-
-        AABox entityFrameBox(corner, dimensions);
-
-        glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
-        glm::vec3 entityFrameVelocity = glm::vec3(worldToEntityMatrix * glm::vec4(velocity, 0.0f));
-        glm::vec3 entityFrameAcceleration = glm::vec3(worldToEntityMatrix * glm::vec4(acceleration, 0.0f));
-
-        // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
-        // and testing intersection there.
-        float localDistance;
-        BoxFace localFace;
-        glm::vec3 localSurfaceNormal;
-        if (entityFrameBox.findParabolaIntersection(entityFrameOrigin, entityFrameVelocity, entityFrameAcceleration, localDistance,
-                                                localFace, localSurfaceNormal)) {
-            if (entityFrameBox.contains(entityFrameOrigin) || localDistance < parabolicDistance) {
-                // now ask the entity if we actually intersect
-                if (entity->supportsDetailedIntersection()) {
-                    QVariantMap localExtraInfo;
-                    if (entity->findDetailedParabolaIntersection(origin, velocity, acceleration, viewFrustumPos, element, localDistance,
-                            localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
-                        if (localDistance < parabolicDistance) {
-                            parabolicDistance = localDistance;
-                            face = localFace;
-                            surfaceNormal = localSurfaceNormal;
-                            extraInfo = localExtraInfo;
-                            entityID = entity->getEntityItemID();
-                        }
-                    }
-                } else {
-                    // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
-                    // Never intersect with particle entities
-                    if (localDistance < parabolicDistance && entity->getType() != EntityTypes::ParticleEffect) {
+    if (!checkFilterSettings(entity, searchFilter) ||
+        (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
+        (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID()))) {
+        return false;
+    }
+
+    // extents is the entity relative, scaled, centered extents of the entity
+    glm::vec3 position = entity->getWorldPosition();
+    glm::mat4 translation = glm::translate(position);
+    BillboardMode billboardMode = entity->getBillboardMode();
+    glm::quat orientation = billboardMode == BillboardMode::NONE ? entity->getWorldOrientation() : entity->getLocalOrientation();
+    glm::mat4 rotation = glm::mat4_cast(BillboardModeHelpers::getBillboardRotation(position, orientation, billboardMode,
+        viewFrustumPos, entity->getRotateForPicking()));
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 dimensions = entity->getScaledDimensions();
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
+    glm::vec3 entityFrameVelocity = glm::vec3(worldToEntityMatrix * glm::vec4(velocity, 0.0f));
+    glm::vec3 entityFrameAcceleration = glm::vec3(worldToEntityMatrix * glm::vec4(acceleration, 0.0f));
+
+    // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
+    // and testing intersection there.
+    float localDistance;
+    BoxFace localFace;
+    glm::vec3 localSurfaceNormal;
+    if (entityFrameBox.findParabolaIntersection(entityFrameOrigin, entityFrameVelocity, entityFrameAcceleration, localDistance,
+                                            localFace, localSurfaceNormal)) {
+        if (entityFrameBox.contains(entityFrameOrigin) || localDistance < parabolicDistance) {
+            // now ask the entity if we actually intersect
+            if (entity->supportsDetailedIntersection()) {
+                QVariantMap localExtraInfo;
+                if (entity->findDetailedParabolaIntersection(origin, velocity, acceleration, viewFrustumPos, element, localDistance,
+                        localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
+                    if (localDistance < parabolicDistance) {
                         parabolicDistance = localDistance;
                         face = localFace;
-                        surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
-                        extraInfo = QVariantMap();
-                        entityID = entity->getEntityItemID();
+                        surfaceNormal = localSurfaceNormal;
+                        extraInfo = localExtraInfo;
+                        hit = true;
                     }
                 }
+            } else {
+                // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
+                // Never intersect with particle entities
+                if (localDistance < parabolicDistance && entity->getType() != EntityTypes::ParticleEffect) {
+                    parabolicDistance = localDistance;
+                    face = localFace;
+                    surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
+                    extraInfo = QVariantMap();
+                    hit = true;
+                }
             }
         }
-    });
-    return entityID;
+    }
+    return hit;
 }
 
 QUuid EntityTreeElement::evalClosetEntity(const glm::vec3& position, PickFilter searchFilter, float& closestDistanceSquared) const {
@@ -440,164 +467,74 @@ QUuid EntityTreeElement::evalClosetEntity(const glm::vec3& position, PickFilter
     return closestEntity;
 }
 
-void EntityTreeElement::evalEntitiesInSphere(const glm::vec3& position, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter)) {
-            return;
-        }
+bool EntityTreeElement::isEntityInSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
+    glm::vec3 penetration;
+    if (!success || !entityBox.findSpherePenetration(position, radius, penetration)) {
+        return false;
+    }
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(position, radius, penetration)) {
-
-            glm::vec3 dimensions = entity->getScaledDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably do actual hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                glm::vec3 center = entity->getCenterPosition(success);
-                if (success && findSphereSpherePenetration(position, radius, center, entityTrueRadius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+    glm::vec3 dimensions = entity->getScaledDimensions();
 
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
+    // FIXME - consider allowing the entity to determine penetration so that
+    //         entities could presumably do actual hull testing if they wanted to
+    // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
+    //         can we handle the ellipsoid case better? We only currently handle perfect spheres
+    //         with centered registration points
+    if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
 
-                AABox entityFrameBox(corner, dimensions);
+        // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
+        //       maximum bounding sphere, which is actually larger than our actual radius
+        float entityTrueRadius = dimensions.x / 2.0f;
 
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            }
-        }
-    });
-}
+        glm::vec3 center = entity->getCenterPosition(success);
+        return success && findSphereSpherePenetration(position, radius, center, entityTrueRadius, penetration);
+    }
 
-void EntityTreeElement::evalEntitiesInSphereWithType(const glm::vec3& position, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter) || type != entity->getType()) {
-            return;
-        }
+    // determine the worldToEntityMatrix that doesn't include scale because
+    // we're going to use the registration aware aa box in the entity frame
+    glm::mat4 translation = glm::translate(entity->getWorldPosition());
+    glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(position, radius, penetration)) {
-
-            glm::vec3 dimensions = entity->getScaledDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably do actual hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                glm::vec3 center = entity->getCenterPosition(success);
-                if (success && findSphereSpherePenetration(position, radius, center, entityTrueRadius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
 
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
+    AABox entityFrameBox(corner, dimensions);
 
-                AABox entityFrameBox(corner, dimensions);
+    glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
+    return entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration);
+}
 
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            }
-        }
-    });
+bool EntityTreeElement::isEntityNamed(const EntityItemPointer& entity, const QString& name, bool caseSensitive) {
+    QString entityName = entity->getName();
+    return caseSensitive ? name == entityName : name.toLower() == entityName.toLower();
 }
 
-void EntityTreeElement::evalEntitiesInSphereWithName(const glm::vec3& position, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
+void EntityTreeElement::evalEntitiesInSphere(const glm::vec3& position, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
     forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter)) {
-            return;
+        if (checkFilterSettings(entity, searchFilter) && isEntityInSphere(entity, position, radius)) {
+            foundEntities.push_back(entity->getID());
         }
+    });
+}
 
-        QString entityName = entity->getName();
-        if ((caseSensitive && name != entityName) || (!caseSensitive && name.toLower() != entityName.toLower())) {
-            return;
+void EntityTreeElement::evalEntitiesInSphereWithType(const glm::vec3& position, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
+    forEachEntity([&](EntityItemPointer entity) {
+        if (type == entity->getType() && checkFilterSettings(entity, searchFilter) && isEntityInSphere(entity, position, radius)) {
+            foundEntities.push_back(entity->getID());
         }
+    });
+}
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(position, radius, penetration)) {
-
-            glm::vec3 dimensions = entity->getScaledDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably do actual hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-                bool success;
-                glm::vec3 center = entity->getCenterPosition(success);
-
-                if (success && findSphereSpherePenetration(position, radius, center, entityTrueRadius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
-
-                AABox entityFrameBox(corner, dimensions);
-
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            }
+void EntityTreeElement::evalEntitiesInSphereWithName(const glm::vec3& position, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
+    forEachEntity([&](EntityItemPointer entity) {
+        if (checkFilterSettings(entity, searchFilter) && isEntityNamed(entity, name, caseSensitive) &&
+            isEntityInSphere(entity, position, radius)) {
+            foundEntities.push_back(entity->getID());
         }
     });
 }
@@ -135,6 +135,20 @@ public:
     virtual bool deleteApproved() const override { return !hasEntities(); }
 
     static bool checkFilterSettings(const EntityItemPointer& entity, PickFilter searchFilter);
+    static bool isEntityInSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
+    static bool isEntityNamed(const EntityItemPointer& entity, const QString& name, bool caseSensitive);
+
+    // the intersection tests of a single entity, true if it is hit closer than distance
+    static bool evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+        const glm::vec3& direction, const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& distance,
+        BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+        const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
+    static bool evalEntityParabolaIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+        const glm::vec3& velocity, const glm::vec3& acceleration, const glm::vec3& viewFrustumPos, const glm::vec3& normal,
+        OctreeElementPointer& element, float& parabolicDistance, BoxFace& face, glm::vec3& surfaceNormal,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        PickFilter searchFilter, QVariantMap& extraInfo);
+
     virtual bool canPickIntersect() const override { return hasEntities(); }
     virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& viewFrustumPos,
         OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
@@ -0,0 +1,147 @@
+//
+//  EntityTreeGrid.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeGrid.h"
+
+#include <cfloat>
+
+const float EntityTreeGrid::CELL_SIZE = 8.0f;
+
+// the cell coordinates are packed in 21 bits each, far more than the 16 km of a domain needs
+static const int CELL_COORDINATE_BITS = 21;
+static const int MAX_CELL_COORDINATE = (1 << (CELL_COORDINATE_BITS - 1)) - 1;
+static const uint64_t CELL_COORDINATE_MASK = (1ULL << CELL_COORDINATE_BITS) - 1;
+
+void EntityTreeGrid::markChanged(const EntityItemID& id) {
+    if (!_isBuilt) {
+        return; // the first build picks up everything
+    }
+
+    std::lock_guard<std::mutex> lock(_changedMutex);
+    _changed.insert(id);
+    _hasChanged = true;
+}
+
+void EntityTreeGrid::update(const std::function<EntityItemPointer(const EntityItemID&)>& findEntity,
+                            const std::function<std::vector<EntityItemPointer>()>& getEntities) {
+    if (!_needsRebuild && !_hasChanged) {
+        return;
+    }
+
+    withWriteLock([&] {
+        // clear the flags before looking at the entities so that changes made meanwhile are caught by the next update
+        bool needsRebuild = _needsRebuild.exchange(false);
+        QSet<EntityItemID> changed;
+        {
+            std::lock_guard<std::mutex> lock(_changedMutex);
+            changed.swap(_changed);
+            _hasChanged = false;
+        }
+
+        if (needsRebuild) {
+            rebuild(getEntities());
+            return;
+        }
+
+        for (const auto& id : changed) {
+            Item item { findEntity(id) };
+            if (item.entity) {
+                computeBounds(item);
+            }
+
+            auto location = _locations.find(id);
+            if (location != _locations.end()) {
+                Location oldLocation = location.value();
+                if (item.entity && getCellKey(item) == oldLocation.cell) {
+                    // it moved within its cell
+                    Cell& cell = oldLocation.cell == LARGE_ITEMS_CELL ? _largeItems : _cells[oldLocation.cell];
+                    cell[oldLocation.index] = std::move(item);
+                    continue;
+                }
+                _locations.erase(location);
+                remove(oldLocation);
+            }
+
+            if (item.entity) {
+                insert(std::move(item));
+            }
+        }
+    });
+}
+
+void EntityTreeGrid::computeBounds(Item& item) {
+    bool success;
+    AABox box = item.entity->getAABox(success);
+    if (!success) {
+        // kept with the large items, where it touches nothing until it has bounds
+        item.minCorner = glm::vec3(FLT_MAX);
+        item.maxCorner = glm::vec3(-FLT_MAX);
+        return;
+    }
+    item.minCorner = box.getMinimumPoint();
+    item.maxCorner = box.getMaximumPoint();
+}
+
+glm::ivec3 EntityTreeGrid::getCellCoordinates(const glm::vec3& position) {
+    glm::vec3 coordinates = glm::clamp(glm::floor(position / CELL_SIZE), glm::vec3((float)-MAX_CELL_COORDINATE),
+                                       glm::vec3((float)MAX_CELL_COORDINATE));
+    return glm::ivec3(coordinates);
+}
+
+uint64_t EntityTreeGrid::getCellKey(const glm::ivec3& coordinates) {
+    glm::ivec3 offsetCoordinates = coordinates + glm::ivec3(MAX_CELL_COORDINATE);
+    return (((uint64_t)offsetCoordinates.x & CELL_COORDINATE_MASK) << (2 * CELL_COORDINATE_BITS)) |
+        (((uint64_t)offsetCoordinates.y & CELL_COORDINATE_MASK) << CELL_COORDINATE_BITS) |
+        ((uint64_t)offsetCoordinates.z & CELL_COORDINATE_MASK);
+}
+
+uint64_t EntityTreeGrid::getCellKey(const Item& item) {
+    glm::vec3 size = item.maxCorner - item.minCorner;
+    if (glm::any(glm::lessThan(size, glm::vec3(0.0f))) || glm::any(glm::greaterThan(size, glm::vec3(CELL_SIZE)))) {
+        return LARGE_ITEMS_CELL;
+    }
+    return getCellKey(getCellCoordinates(0.5f * (item.minCorner + item.maxCorner)));
+}
+
+void EntityTreeGrid::rebuild(std::vector<EntityItemPointer> entities) {
+    _cells.clear();
+    _largeItems.clear();
+    _locations.clear();
+    _locations.reserve((int)entities.size());
+    for (auto& entity : entities) {
+        Item item { std::move(entity) };
+        computeBounds(item);
+        insert(std::move(item));
+    }
+    _isBuilt = true;
+}
+
+void EntityTreeGrid::insert(Item item) {
+    uint64_t key = getCellKey(item);
+    Cell& cell = key == LARGE_ITEMS_CELL ? _largeItems : _cells[key];
+    _locations.insert(item.entity->getEntityItemID(), { key, (int)cell.size() });
+    cell.push_back(std::move(item));
+}
+
+void EntityTreeGrid::remove(const Location& location) {
+    Cell& cell = location.cell == LARGE_ITEMS_CELL ? _largeItems : _cells[location.cell];
+
+    // the last item of the cell takes the place of the removed one
+    if (location.index + 1 < (int)cell.size()) {
+        cell[location.index] = std::move(cell.back());
+        _locations[cell[location.index].entity->getEntityItemID()].index = location.index;
+    }
+    cell.pop_back();
+
+    if (cell.empty() && location.cell != LARGE_ITEMS_CELL) {
+        _cells.erase(location.cell);
+    }
+}
@@ -0,0 +1,138 @@
+//
+//  EntityTreeGrid.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeGrid_h
+#define hifi_EntityTreeGrid_h
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+
+#include <glm/glm.hpp>
+
+#include <shared/ReadWriteLockable.h>
+
+#include "EntityItem.h"
+
+// Loose hashed grid over the entities of a tree, which can answer the sphere, cube, box and closest entity queries
+// instead of the octree in domains of many small entities that move a lot.
+//
+// Each entity is kept in the cell that holds the center of its AABox, in an array per cell, so that it can reach out of
+// that cell by half a cell at most. A query looks at the cells its bounds touch, grown by half a cell. Moving an entity
+// only moves it to another cell when its center crosses into it, and the grid has no depth to walk down. The entities
+// larger than a cell are kept apart, and every query tests them.
+//
+// Adding, removing or moving entities marks them as changed, and they are put back in their cells before the next query.
+//
+//   EntityTreeGrid is thread-safe. EntityTree updates it from the queries that need it.
+class EntityTreeGrid : public ReadWriteLockable {
+public:
+    static const float CELL_SIZE; // meters
+
+    void markNeedsRebuild() { _needsRebuild = true; }
+    void markChanged(const EntityItemID& id);
+
+    // findEntity is called for the changed entities, and returns null for the ones that were removed, getEntities is only
+    // called if the grid has to be rebuilt
+    void update(const std::function<EntityItemPointer(const EntityItemID&)>& findEntity,
+                const std::function<std::vector<EntityItemPointer>()>& getEntities);
+
+    // visit(entity) is called for every entity whose AABox touches the bounds
+    template <typename Visit>
+    void query(const glm::vec3& minCorner, const glm::vec3& maxCorner, Visit visit) const;
+
+private:
+    struct Item {
+        EntityItemPointer entity;
+        glm::vec3 minCorner;
+        glm::vec3 maxCorner;
+    };
+
+    using Cell = std::vector<Item>;
+
+    struct Location {
+        uint64_t cell;
+        int index;
+    };
+
+    static const uint64_t LARGE_ITEMS_CELL = UINT64_MAX;
+
+    static void computeBounds(Item& item);
+    static glm::ivec3 getCellCoordinates(const glm::vec3& position);
+    static uint64_t getCellKey(const glm::ivec3& coordinates);
+    static uint64_t getCellKey(const Item& item);
+
+    void rebuild(std::vector<EntityItemPointer> entities);
+    void insert(Item item);
+    void remove(const Location& location);
+
+    std::unordered_map<uint64_t, Cell> _cells;
+    Cell _largeItems;
+    QHash<EntityItemID, Location> _locations;
+
+    std::mutex _changedMutex;
+    QSet<EntityItemID> _changed;
+    std::atomic<bool> _hasChanged { false };
+    std::atomic<bool> _needsRebuild { true };
+    std::atomic<bool> _isBuilt { false };
+};
+
+template <typename Visit>
+void EntityTreeGrid::query(const glm::vec3& minCorner, const glm::vec3& maxCorner, Visit visit) const {
+    withReadLock([&] {
+        auto visitCell = [&](const Cell& cell) {
+            for (const auto& item : cell) {
+                if (item.minCorner.x <= maxCorner.x && item.maxCorner.x >= minCorner.x &&
+                    item.minCorner.y <= maxCorner.y && item.maxCorner.y >= minCorner.y &&
+                    item.minCorner.z <= maxCorner.z && item.maxCorner.z >= minCorner.z) {
+                    visit(item.entity);
+                }
+            }
+        };
+
+        visitCell(_largeItems);
+
+        glm::vec3 halfCell(0.5f * CELL_SIZE);
+        glm::ivec3 minCell = getCellCoordinates(minCorner - halfCell);
+        glm::ivec3 maxCell = getCellCoordinates(maxCorner + halfCell);
+        if (glm::any(glm::lessThan(maxCell, minCell))) {
+            return;
+        }
+
+        // a query larger than the grid is cheaper as a walk of the cells that have entities
+        glm::ivec3 span = maxCell - minCell;
+        uint64_t numCells = (uint64_t)(span.x + 1) * (uint64_t)(span.y + 1) * (uint64_t)(span.z + 1);
+        if (numCells > _cells.size()) {
+            for (const auto& cell : _cells) {
+                visitCell(cell.second);
+            }
+            return;
+        }
+
+        for (int x = minCell.x; x <= maxCell.x; x++) {
+            for (int y = minCell.y; y <= maxCell.y; y++) {
+                for (int z = minCell.z; z <= maxCell.z; z++) {
+                    auto cell = _cells.find(getCellKey(glm::ivec3(x, y, z)));
+                    if (cell != _cells.end()) {
+                        visitCell(cell->second);
+                    }
+                }
+            }
+        }
+    });
+}
+
+#endif // hifi_EntityTreeGrid_h
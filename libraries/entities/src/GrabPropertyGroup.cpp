@@ -75,6 +75,22 @@ void GrabPropertyGroup::merge(const GrabPropertyGroup& other) {
     COPY_PROPERTY_IF_CHANGED(equippableIndicatorOffset);
 }
 
+bool GrabPropertyGroup::isDefault() const {
+    return _grabbable == INITIAL_GRABBABLE &&
+        _grabKinematic == INITIAL_KINEMATIC &&
+        _grabFollowsController == INITIAL_FOLLOWS_CONTROLLER &&
+        _triggerable == INITIAL_TRIGGERABLE &&
+        _equippable == INITIAL_EQUIPPABLE &&
+        _grabDelegateToParent == INITIAL_GRAB_DELEGATE_TO_PARENT &&
+        _equippableLeftPosition == INITIAL_LEFT_EQUIPPABLE_POSITION &&
+        _equippableLeftRotation == INITIAL_LEFT_EQUIPPABLE_ROTATION &&
+        _equippableRightPosition == INITIAL_RIGHT_EQUIPPABLE_POSITION &&
+        _equippableRightRotation == INITIAL_RIGHT_EQUIPPABLE_ROTATION &&
+        _equippableIndicatorURL.isEmpty() &&
+        _equippableIndicatorScale == INITIAL_EQUIPPABLE_INDICATOR_SCALE &&
+        _equippableIndicatorOffset == INITIAL_EQUIPPABLE_INDICATOR_OFFSET;
+}
+
 void GrabPropertyGroup::debugDump() const {
     qCDebug(entities) << "   GrabPropertyGroup: ---------------------------------------------";
 
@@ -79,6 +79,9 @@ public:
 
     void merge(const GrabPropertyGroup& other);
 
+    // true while all the properties have their initial values
+    bool isDefault() const;
+
     virtual void debugDump() const override;
     virtual void listChangedProperties(QList<QString>& out) override;
 
@@ -17,6 +17,7 @@
 
 #include <ByteCountCoding.h>
 #include <GLMHelpers.h>
+#include <StringPool.h>
 
 #include "EntitiesLogging.h"
 #include "EntityItemProperties.h"
@@ -299,7 +300,7 @@ ShapeType ModelEntityItem::getShapeType() const {
 void ModelEntityItem::setModelURL(const QString& url) {
     withWriteLock([&] {
         if (_modelURL != url) {
-            _modelURL = url;
+            _modelURL = StringPool::intern(url);
             _needsRenderUpdate = true;
         }
     });
@@ -346,7 +347,7 @@ const Transform ModelEntityItem::getTransformWithOnlyLocalRotation(bool& success
 void ModelEntityItem::setCompoundShapeURL(const QString& url) {
     withWriteLock([&] {
         if (_compoundShapeURL.get() != url) {
-            _compoundShapeURL.set(url);
+            _compoundShapeURL.set(StringPool::intern(url));
         }
     });
 }
@@ -688,9 +689,15 @@ glm::vec3 ModelEntityItem::getModelScale() const {
 }
 
 void ModelEntityItem::setModelScale(const glm::vec3& modelScale) {
+    bool changed = false;
     withWriteLock([&] {
+        changed = _modelScale != modelScale;
         _modelScale = modelScale;
     });
+    if (changed && hasChildren()) {
+        // the children are relative to the scaled model, their cached world transforms are stale
+        invalidateWorldTransforms();
+    }
 }
 
 QString ModelEntityItem::getBlendshapeCoefficients() const {
@@ -42,7 +42,7 @@ MovingEntitiesOperator::~MovingEntitiesOperator() {
 }
 
 
-void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const AACube& newCube) {
+void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const AACube& newCube, bool markUnmoved) {
     EntityTreeElementPointer oldContainingElement = entity->getElement();
     AABox newCubeClamped = newCube.clamp((float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE);
 
@@ -65,17 +65,20 @@ void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const
 
     // If the original containing element is the best fit for the requested newCube locations then
     // we don't actually need to add the entity for moving and we can short circuit all this work
-    if (!oldContainingElement->bestFitBounds(newCubeClamped)) {
-        // check our tree, to determine if this entity is known
+    if (markUnmoved || !oldContainingElement->bestFitBounds(newCubeClamped)) {
+        // the first move queued for an entity is the one made
+        if (_entityIDsToMove.contains(entity->getEntityItemID())) {
+            return;
+        }
+        _entityIDsToMove.insert(entity->getEntityItemID());
+
         EntityToMoveDetails details;
         details.oldContainingElement = oldContainingElement;
         details.oldContainingElementCube = oldContainingElement->getAACube();
         details.entity = entity;
-        details.oldFound = false;
-        details.newFound = false;
         details.newCube = newCube;
         details.newCubeClamped = newCubeClamped;
-        _entitiesToMove << details;
+        _entitiesToMove.push_back(details);
         _lookingCount++;
 
         if (_wantDebug) {
@@ -98,42 +101,10 @@ void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const
     }
 }
 
-// does this entity tree element contain the old entity
-bool MovingEntitiesOperator::shouldRecurseSubTree(const OctreeElementPointer& element) {
-    bool containsEntity = false;
-
-    // If we don't have an old entity, then we don't contain the entity, otherwise
-    // check the bounds
-    if (_entitiesToMove.size() > 0) {
-        const AACube& elementCube = element->getAACube();
-        int detailIndex = 0;
-        foreach(const EntityToMoveDetails& details, _entitiesToMove) {
-
-            if (_wantDebug) {
-                qCDebug(entities) << "MovingEntitiesOperator::shouldRecurseSubTree() details["<< detailIndex <<"]-----------------------------";
-                qCDebug(entities) << "    element:" << element->getAACube();
-                qCDebug(entities) << "    details.entity:" << details.entity->getEntityItemID();
-                qCDebug(entities) << "    details.oldContainingElementCube:" << details.oldContainingElementCube;
-                qCDebug(entities) << "    details.newCube:" << details.newCube;
-                qCDebug(entities) << "    details.newCubeClamped:" << details.newCubeClamped;
-                qCDebug(entities) << "    elementCube.contains(details.newCube)" << elementCube.contains(details.newCube);
-                qCDebug(entities) << "    elementCube.contains(details.newCubeClamped)" << elementCube.contains(details.newCubeClamped);
-                qCDebug(entities) << "--------------------------------------------------------------------------";
-            }
-
-            if (elementCube.contains(details.oldContainingElementCube) || elementCube.contains(details.newCubeClamped)) {
-                containsEntity = true;
-                break; // if it contains at least one, we're good to go
-            }
-            detailIndex++;
-        }
-    }
-    return containsEntity;
-}
-
 bool MovingEntitiesOperator::preRecursion(const OctreeElementPointer& element) {
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-    
+    const AACube& elementCube = element->getAACube();
+
     // In Pre-recursion, we're generally deciding whether or not we want to recurse this
     // path of the tree. For this operation, we want to recurse the branch of the tree if
     // any of the following are true:
@@ -142,73 +113,62 @@ bool MovingEntitiesOperator::preRecursion(const OctreeElementPointer& element) {
     //
     // Note: it's often the case that the branch in question contains both the old entity
     // and the new entity.
-    
+    //
+    // Only the entities within the parent can be within this element, and those already moved are done with.
+    bool isRoot = _pathLevelStarts.empty();
+    size_t parentStart = isRoot ? 0 : _pathLevelStarts.back();
+    size_t levelStart = _pathDetailIndices.size();
+    size_t numCandidates = isRoot ? _entitiesToMove.size() : levelStart - parentStart;
+    _pathLevelStarts.push_back(levelStart);
+    for (size_t i = 0; i < numCandidates; i++) {
+        int detailIndex = isRoot ? (int)i : _pathDetailIndices[parentStart + i];
+        const EntityToMoveDetails& details = _entitiesToMove[detailIndex];
+        if ((!details.oldFound || !details.newFound) &&
+                (elementCube.contains(details.oldContainingElementCube) || elementCube.contains(details.newCubeClamped))) {
+            _pathDetailIndices.push_back(detailIndex);
+        }
+    }
+
     bool keepSearching = (_foundOldCount < _lookingCount) || (_foundNewCount < _lookingCount);
+    if (!keepSearching || levelStart == _pathDetailIndices.size()) {
+        return false;
+    }
 
-    // If we haven't yet found all the entities, and this sub tree contains at least one of our
-    // entities, then we need to keep searching.
-    if (keepSearching && shouldRecurseSubTree(element)) {
+    for (size_t i = levelStart; i < _pathDetailIndices.size(); i++) {
+        EntityToMoveDetails& details = _entitiesToMove[_pathDetailIndices[i]];
 
-        // check against each of our search entities
-        int detailIndex = 0;
-        foreach(const EntityToMoveDetails& details, _entitiesToMove) {
-        
-            if (_wantDebug) {
-                qCDebug(entities) << "MovingEntitiesOperator::preRecursion() details["<< detailIndex <<"]-----------------------------";
-                qCDebug(entities) << "    entityTreeElement:" << entityTreeElement->getAACube();
-                qCDebug(entities) << "    entityTreeElement->bestFitBounds(details.newCube):" << entityTreeElement->bestFitBounds(details.newCube);
-                qCDebug(entities) << "    details.entity:" << details.entity->getEntityItemID();
-                qCDebug(entities) << "    details.oldContainingElementCube:" << details.oldContainingElementCube;
-                qCDebug(entities) << "    entityTreeElement:" << entityTreeElement.get();
-                qCDebug(entities) << "    details.newCube:" << details.newCube;
-                qCDebug(entities) << "    details.newCubeClamped:" << details.newCubeClamped;
-                qCDebug(entities) << "    _lookingCount:" << _lookingCount;
-                qCDebug(entities) << "    _foundOldCount:" << _foundOldCount;
-                qCDebug(entities) << "--------------------------------------------------------------------------";
-            }
-        
+        // If this is one of the old elements we're looking for, then ask it to remove the old entity
+        if (!details.oldFound && entityTreeElement == details.oldContainingElement) {
+            // DO NOT remove the entity here.  It will be removed when added to the destination element.
+            _foundOldCount++;
+            details.oldFound = true;
+        }
 
-            // If this is one of the old elements we're looking for, then ask it to remove the old entity
-            if (!details.oldFound && entityTreeElement == details.oldContainingElement) {
-                // DO NOT remove the entity here.  It will be removed when added to the destination element.
-                _foundOldCount++;
-                //details.oldFound = true; // TODO: would be nice to add this optimization
-                if (_wantDebug) {
-                    qCDebug(entities) << "MovingEntitiesOperator::preRecursion() -----------------------------";
-                    qCDebug(entities) << "    FOUND OLD - REMOVING";
-                    qCDebug(entities) << "    entityTreeElement == details.oldContainingElement";
-                    qCDebug(entities) << "--------------------------------------------------------------------------";
+        // If this element is the best fit for the new bounds of this entity then add the entity to the element
+        if (!details.newFound && entityTreeElement->bestFitBounds(details.newCube)) {
+            // remove from the old before adding
+            EntityTreeElementPointer oldElement = details.entity->getElement();
+            if (oldElement != entityTreeElement) {
+                if (oldElement) {
+                    oldElement->removeEntityItem(details.entity);
                 }
+                entityTreeElement->addEntityItem(details.entity);
+            } else {
+                entityTreeElement->bumpChangedContent();
             }
-
-            // If this element is the best fit for the new bounds of this entity then add the entity to the element
-            if (!details.newFound && entityTreeElement->bestFitBounds(details.newCube)) {
-                // remove from the old before adding
-                EntityTreeElementPointer oldElement = details.entity->getElement();
-                if (oldElement != entityTreeElement) {
-                    if (oldElement) {
-                        oldElement->removeEntityItem(details.entity);
-                    }
-                    entityTreeElement->addEntityItem(details.entity);
-                } else {
-                    entityTreeElement->bumpChangedContent();
-                }
-                _foundNewCount++;
-                //details.newFound = true; // TODO: would be nice to add this optimization
-                if (_wantDebug) {
-                    qCDebug(entities) << "MovingEntitiesOperator::preRecursion() -----------------------------";
-                    qCDebug(entities) << "    FOUND NEW - ADDING";
-                    qCDebug(entities) << "    entityTreeElement->bestFitBounds(details.newCube)";
-                    qCDebug(entities) << "--------------------------------------------------------------------------";
-                }
+            _foundNewCount++;
+            details.newFound = true;
+            if (_wantDebug) {
+                qCDebug(entities) << "MovingEntitiesOperator::preRecursion() -----------------------------";
+                qCDebug(entities) << "    FOUND NEW - ADDING" << details.entity->getEntityItemID();
+                qCDebug(entities) << "    entityTreeElement:" << entityTreeElement->getAACube();
+                qCDebug(entities) << "--------------------------------------------------------------------------";
             }
-            detailIndex++;
         }
-        // if we haven't found all of our search for entities, then keep looking
-        keepSearching = (_foundOldCount < _lookingCount) || (_foundNewCount < _lookingCount);
     }
 
-    return keepSearching; // if we haven't yet found it, keep looking
+    // if we haven't found all of our search for entities, then keep looking
+    return (_foundOldCount < _lookingCount) || (_foundNewCount < _lookingCount);
 }
 
 bool MovingEntitiesOperator::postRecursion(const OctreeElementPointer& element) {
@@ -216,54 +176,52 @@ bool MovingEntitiesOperator::postRecursion(const OctreeElementPointer& element)
     // unwind we want to mark the path as being dirty if we changed it below.
     // We might have two paths, one for the old entity and one for the new entity.
     bool keepSearching = (_foundOldCount < _lookingCount) || (_foundNewCount < _lookingCount);
+    size_t levelStart = _pathLevelStarts.back();
 
     // As we unwind, if we're in either of these two paths, we mark our element
     // as dirty.
-    if ((shouldRecurseSubTree(element))) {
+    if (levelStart < _pathDetailIndices.size()) {
         element->markWithChangedTime();
     }
 
     // It's not OK to prune if we have the potential of deleting the original containing element
     // because if we prune the containing element then new might end up reallocating the same memory later 
-    // and that will confuse our logic.
-    // 
-    // it's ok to prune if:
-    // 2) this subtree doesn't contain any old elements
-    // 3) this subtree contains an old element, but this element isn't a direct parent of any old containing element
-
-    bool elementSubTreeContainsOldElements = false;
-    bool elementIsDirectParentOfOldElment = false;
-    foreach(const EntityToMoveDetails& details, _entitiesToMove) {
-        if (element->getAACube().contains(details.oldContainingElementCube)) {
-            elementSubTreeContainsOldElements = true;
-        }
-        if (element->isParentOf(details.oldContainingElement)) {
-            elementIsDirectParentOfOldElment = true;
+    // and that will confuse our logic, so the direct parents of the old containing elements are pruned
+    // by the elements above them.
+    bool elementIsDirectParentOfOldElement = false;
+    for (size_t i = levelStart; i < _pathDetailIndices.size(); i++) {
+        if (element->isParentOf(_entitiesToMove[_pathDetailIndices[i]].oldContainingElement)) {
+            elementIsDirectParentOfOldElement = true;
+            break;
         }
     }
-    if (!elementSubTreeContainsOldElements || !elementIsDirectParentOfOldElment) {
+    if (!elementIsDirectParentOfOldElement) {
         EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
         entityTreeElement->pruneChildren(); // take this opportunity to prune any empty leaves
     }
 
+    _pathDetailIndices.resize(levelStart);
+    _pathLevelStarts.pop_back();
+
     return keepSearching; // if we haven't yet found it, keep looking
 }
 
 OctreeElementPointer MovingEntitiesOperator::possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) {
     // If we're getting called, it's because there was no child element at this index while recursing.
     // We only care if this happens while still searching for the new entity locations.
-    if (_foundNewCount < _lookingCount) {
+    if (_foundNewCount < _lookingCount && !_pathLevelStarts.empty()) {
 
         float childElementScale = element->getAACube().getScale() / 2.0f; // all of our children will be half our scale
-    
-        // check against each of our entities
-        foreach(const EntityToMoveDetails& details, _entitiesToMove) {
+
+        // check against each of the entities within this element
+        for (size_t i = _pathLevelStarts.back(); i < _pathDetailIndices.size(); i++) {
+            const EntityToMoveDetails& details = _entitiesToMove[_pathDetailIndices[i]];
 
             // if the scale of our desired cube is smaller than our children, then consider making a child
-            if (details.newCubeClamped.getLargestDimension() <= childElementScale) {
+            if (!details.newFound && details.newCubeClamped.getLargestDimension() <= childElementScale) {
 
                 int indexOfChildContainingNewEntity = element->getMyChildContaining(details.newCubeClamped);
-            
+
                 // If the childIndex we were asked if we wanted to create contains this newCube,
                 // then we will create this branch and continue. We can exit this loop immediately
                 // because if we need this branch for any one entity then it doesn't matter if it's
@@ -279,6 +237,9 @@ OctreeElementPointer MovingEntitiesOperator::possiblyCreateChildAt(const OctreeE
 
 void MovingEntitiesOperator::reset() {
     _entitiesToMove.clear();
+    _entityIDsToMove.clear();
+    _pathDetailIndices.clear();
+    _pathLevelStarts.clear();
     _foundOldCount = 0;
     _foundNewCount = 0;
     _lookingCount = 0;
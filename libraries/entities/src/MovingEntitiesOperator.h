@@ -12,6 +12,8 @@
 #ifndef hifi_MovingEntitiesOperator_h
 #define hifi_MovingEntitiesOperator_h
 
+#include <vector>
+
 #include <QSet>
 
 #include "EntityItem.h"
@@ -24,8 +26,8 @@ public:
     AABox newCubeClamped; // meters
     EntityTreeElementPointer oldContainingElement;
     AACube oldContainingElementCube; // meters
-    bool oldFound;
-    bool newFound;
+    bool oldFound { false };
+    bool newFound { false };
 };
 
 inline uint qHash(const EntityToMoveDetails& a, uint seed) {
@@ -36,21 +38,28 @@ inline bool operator==(const EntityToMoveDetails& a, const EntityToMoveDetails&
     return a.entity->getEntityItemID() == b.entity->getEntityItemID();
 }
 
+// Moves a batch of entities to the elements that best fit their new cubes in one traversal of the tree. Each element
+// only checks the entities whose old element or new cube are within it, narrowed down from those of its parent.
 class MovingEntitiesOperator : public RecurseOctreeOperator {
 public:
     MovingEntitiesOperator();
     ~MovingEntitiesOperator();
 
-    void addEntityToMoveList(EntityItemPointer entity, const AACube& newCube);
+    // with markUnmoved an entity that remains in its element is still marked as changed there, as UpdateEntityOperator does
+    void addEntityToMoveList(EntityItemPointer entity, const AACube& newCube, bool markUnmoved = false);
     virtual bool preRecursion(const OctreeElementPointer& element) override;
     virtual bool postRecursion(const OctreeElementPointer& element) override;
     virtual OctreeElementPointer possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) override;
     bool hasMovingEntities() const { return _entitiesToMove.size() > 0; }
     void reset();
 private:
-    bool shouldRecurseSubTree(const OctreeElementPointer& element);
+    std::vector<EntityToMoveDetails> _entitiesToMove;
+    QSet<EntityItemID> _entityIDsToMove;
+
+    // the indices in _entitiesToMove of the entities within each element of the current path, one range per level
+    std::vector<int> _pathDetailIndices;
+    std::vector<size_t> _pathLevelStarts;
 
-    QSet<EntityToMoveDetails> _entitiesToMove;
     int _foundOldCount { 0 };
     int _foundNewCount { 0 };
     int _lookingCount { 0 };
@@ -0,0 +1,226 @@
+//
+//  PolyVoxChunks.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunks.h"
+
+#include <QtCore/QDataStream>
+
+#include "EntitiesLogging.h"
+#include "PolyVoxEntityItem.h"
+
+static const quint16 CHUNKED_FORMAT_MARKER = 0;
+
+static bool isReasonableSize(const glm::ivec3& size) {
+    return size.x > 0 && size.x <= PolyVoxEntityItem::MAX_VOXEL_DIMENSION &&
+        size.y > 0 && size.y <= PolyVoxEntityItem::MAX_VOXEL_DIMENSION &&
+        size.z > 0 && size.z <= PolyVoxEntityItem::MAX_VOXEL_DIMENSION;
+}
+
+bool PolyVoxChunks::isChunked(const QByteArray& voxelData) {
+    QDataStream reader(voxelData);
+    quint16 marker;
+    reader >> marker;
+    return reader.status() == QDataStream::Ok && marker == CHUNKED_FORMAT_MARKER;
+}
+
+bool PolyVoxChunks::read(const QByteArray& voxelData, Data& data) {
+    QDataStream reader(voxelData);
+    quint16 voxelXSize, voxelYSize, voxelZSize;
+    reader >> voxelXSize;
+
+    if (voxelXSize != CHUNKED_FORMAT_MARKER) {
+        // the whole volume compressed at once
+        reader >> voxelYSize >> voxelZSize;
+        glm::ivec3 size(voxelXSize, voxelYSize, voxelZSize);
+        if (!isReasonableSize(size)) {
+            qCDebug(entities) << "PolyVox voxel size is not reasonable" << voxelXSize << voxelYSize << voxelZSize;
+            return false;
+        }
+
+        QByteArray compressedData;
+        reader >> compressedData;
+        QByteArray uncompressedData = qUncompress(compressedData);
+        int rawSize = voxelXSize * voxelYSize * voxelZSize;
+        if (uncompressedData.size() != rawSize) {
+            qCDebug(entities) << "PolyVox uncompress -- size is (" << voxelXSize << voxelYSize << voxelZSize << ")"
+                << "so expected uncompressed length of" << rawSize << "but length is" << uncompressedData.size();
+            return false;
+        }
+
+        data.size = size;
+        data.isDelta = false;
+        data.chunks.clear();
+
+        glm::ivec3 grid = getChunkGrid(size);
+        QByteArray voxels(CHUNK_VOXELS, '\0');
+        for (int index = 0; index < grid.x * grid.y * grid.z; index++) {
+            glm::ivec3 chunkCorner = getChunk(grid, index) * CHUNK_SIZE;
+            voxels.fill('\0');
+            bool isEmpty = true;
+            glm::ivec3 v;
+            for (v.z = 0; v.z < CHUNK_SIZE && chunkCorner.z + v.z < size.z; v.z++) {
+                for (v.y = 0; v.y < CHUNK_SIZE && chunkCorner.y + v.y < size.y; v.y++) {
+                    for (v.x = 0; v.x < CHUNK_SIZE && chunkCorner.x + v.x < size.x; v.x++) {
+                        glm::ivec3 voxel = chunkCorner + v;
+                        // the layout the older readers expect
+                        int uncompressedIndex = (voxel.z * size.y * size.x) + (voxel.y * size.z) + voxel.x;
+                        char value = uncompressedIndex < rawSize ? uncompressedData[uncompressedIndex] : '\0';
+                        voxels[getVoxelIndex(v)] = value;
+                        isEmpty &= value == '\0';
+                    }
+                }
+            }
+            if (!isEmpty) {
+                data.chunks.insert(index, encodeChunk(voxels));
+            }
+        }
+        return true;
+    }
+
+    quint8 isDelta;
+    qint32 numChunks;
+    reader >> isDelta >> voxelXSize >> voxelYSize >> voxelZSize >> numChunks;
+    glm::ivec3 size(voxelXSize, voxelYSize, voxelZSize);
+    if (reader.status() != QDataStream::Ok || !isReasonableSize(size)) {
+        qCDebug(entities) << "PolyVox voxel size is not reasonable" << voxelXSize << voxelYSize << voxelZSize;
+        return false;
+    }
+
+    glm::ivec3 grid = getChunkGrid(size);
+    int gridSize = grid.x * grid.y * grid.z;
+    if (numChunks < 0 || numChunks > gridSize) {
+        qCDebug(entities) << "PolyVox voxel data has" << numChunks << "chunks but the volume holds" << gridSize;
+        return false;
+    }
+
+    data.size = size;
+    data.isDelta = isDelta != 0;
+    data.chunks.clear();
+    for (qint32 i = 0; i < numChunks; i++) {
+        qint32 index;
+        QByteArray encoded;
+        reader >> index >> encoded;
+        if (reader.status() != QDataStream::Ok || index < 0 || index >= gridSize) {
+            qCDebug(entities) << "PolyVox voxel data is truncated or has a chunk out of the volume";
+            return false;
+        }
+        data.chunks.insert(index, encoded);
+    }
+    return true;
+}
+
+QByteArray PolyVoxChunks::write(const Data& data) {
+    QByteArray voxelData;
+    QDataStream writer(&voxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+
+    // a whole volume doesn't keep its empty chunks, a delta has to so that they are emptied
+    Chunks chunks;
+    for (auto chunk = data.chunks.cbegin(); chunk != data.chunks.cend(); ++chunk) {
+        if (data.isDelta || !chunk.value().isEmpty()) {
+            chunks.insert(chunk.key(), chunk.value());
+        }
+    }
+
+    writer << CHUNKED_FORMAT_MARKER << (quint8)(data.isDelta ? 1 : 0);
+    writer << (quint16)data.size.x << (quint16)data.size.y << (quint16)data.size.z;
+    writer << (qint32)chunks.size();
+    for (auto chunk = chunks.cbegin(); chunk != chunks.cend(); ++chunk) {
+        writer << (qint32)chunk.key() << chunk.value();
+    }
+    return voxelData;
+}
+
+QByteArray PolyVoxChunks::merge(const QByteArray& voxelData, const QByteArray& delta) {
+    Data deltaData;
+    if (!isChunked(delta) || !read(delta, deltaData) || !deltaData.isDelta) {
+        return delta;
+    }
+
+    Data data;
+    if (!read(voxelData, data) || data.size != deltaData.size) {
+        // start from an empty volume
+        data.size = deltaData.size;
+        data.chunks.clear();
+    }
+    data.isDelta = false;
+
+    for (auto chunk = deltaData.chunks.cbegin(); chunk != deltaData.chunks.cend(); ++chunk) {
+        if (chunk.value().isEmpty()) {
+            data.chunks.remove(chunk.key());
+        } else {
+            data.chunks.insert(chunk.key(), chunk.value());
+        }
+    }
+    return write(data);
+}
+
+PolyVoxChunks::Chunks PolyVoxChunks::diff(const Chunks& oldChunks, const Chunks& newChunks) {
+    Chunks changed;
+    for (auto chunk = newChunks.cbegin(); chunk != newChunks.cend(); ++chunk) {
+        if (oldChunks.value(chunk.key()) != chunk.value()) {
+            changed.insert(chunk.key(), chunk.value());
+        }
+    }
+    for (auto chunk = oldChunks.cbegin(); chunk != oldChunks.cend(); ++chunk) {
+        if (!chunk.value().isEmpty() && newChunks.value(chunk.key()).isEmpty()) {
+            changed.insert(chunk.key(), QByteArray());
+        }
+    }
+    return changed;
+}
+
+QByteArray PolyVoxChunks::encodeChunk(const QByteArray& voxels) {
+    if (voxels.isEmpty()) {
+        return QByteArray();
+    }
+
+    char first = voxels[0];
+    bool isUniform = true;
+    for (int i = 1; i < voxels.size() && isUniform; i++) {
+        isUniform = voxels[i] == first;
+    }
+    if (isUniform) {
+        return first == '\0' ? QByteArray() : QByteArray(1, first);
+    }
+    return qCompress(voxels, 9);
+}
+
+QByteArray PolyVoxChunks::decodeChunk(const QByteArray& encoded) {
+    if (encoded.isEmpty()) {
+        return QByteArray(CHUNK_VOXELS, '\0');
+    }
+    if (encoded.size() == 1) {
+        return QByteArray(CHUNK_VOXELS, encoded[0]);
+    }
+
+    QByteArray voxels = qUncompress(encoded);
+    if (voxels.size() != CHUNK_VOXELS) {
+        qCDebug(entities) << "PolyVox chunk uncompressed to" << voxels.size() << "voxels instead of" << CHUNK_VOXELS;
+        return QByteArray(CHUNK_VOXELS, '\0');
+    }
+    return voxels;
+}
+
+glm::ivec3 PolyVoxChunks::getChunkGrid(const glm::ivec3& size) {
+    return (size + glm::ivec3(CHUNK_SIZE - 1)) / CHUNK_SIZE;
+}
+
+int PolyVoxChunks::getChunkIndex(const glm::ivec3& grid, const glm::ivec3& chunk) {
+    return (chunk.z * grid.y + chunk.y) * grid.x + chunk.x;
+}
+
+glm::ivec3 PolyVoxChunks::getChunk(const glm::ivec3& grid, int index) {
+    return glm::ivec3(index % grid.x, (index / grid.x) % grid.y, index / (grid.x * grid.y));
+}
+
+int PolyVoxChunks::getVoxelIndex(const glm::ivec3& voxelInChunk) {
+    return (voxelInChunk.z * CHUNK_SIZE + voxelInChunk.y) * CHUNK_SIZE + voxelInChunk.x;
+}
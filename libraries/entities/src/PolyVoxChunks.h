@@ -0,0 +1,62 @@
+//
+//  PolyVoxChunks.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunks_h
+#define hifi_PolyVoxChunks_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QMap>
+
+#include <glm/glm.hpp>
+
+// The voxel data of a PolyVox entity, cut into chunks of CHUNK_SIZE voxels along each axis that are compressed one by
+// one. The chunks that are all zero aren't kept, and a chunk of a single value takes one byte, so that a sparse volume
+// stays small. An edit only has to carry the chunks it changed, as a delta that is merged into the whole voxel data.
+//
+// The voxel data starts with a size of 0, which the readers of the older format (three sizes and then the whole volume
+// compressed at once) reject, and that format is still read.
+class PolyVoxChunks {
+public:
+    static const int CHUNK_SIZE { 16 };
+    static const int CHUNK_VOXELS { CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE };
+
+    // the encoded chunks by index, an empty one is all zero
+    using Chunks = QMap<int, QByteArray>;
+
+    struct Data {
+        glm::ivec3 size { 0 };
+        bool isDelta { false };
+        Chunks chunks;
+    };
+
+    static bool isChunked(const QByteArray& voxelData);
+
+    // reads both formats, false if the voxel data isn't valid
+    static bool read(const QByteArray& voxelData, Data& data);
+    static QByteArray write(const Data& data);
+
+    // the voxel data with the chunks of delta replaced, or delta itself if it is whole or of another size
+    static QByteArray merge(const QByteArray& voxelData, const QByteArray& delta);
+
+    // the chunks of newChunks that differ from oldChunks, with the ones that became empty
+    static Chunks diff(const Chunks& oldChunks, const Chunks& newChunks);
+
+    // voxels holds CHUNK_VOXELS values, x first, then y, then z
+    static QByteArray encodeChunk(const QByteArray& voxels);
+    static QByteArray decodeChunk(const QByteArray& encoded);
+
+    static glm::ivec3 getChunkGrid(const glm::ivec3& size);
+    static int getChunkIndex(const glm::ivec3& grid, const glm::ivec3& chunk);
+    static glm::ivec3 getChunk(const glm::ivec3& grid, int index);
+    static int getVoxelIndex(const glm::ivec3& voxelInChunk);
+};
+
+#endif // hifi_PolyVoxChunks_h
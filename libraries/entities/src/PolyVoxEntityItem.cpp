@@ -24,6 +24,7 @@
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
 #include "EntityTreeElement.h"
+#include "PolyVoxChunks.h"
 
 bool PolyVoxEntityItem::isEdged(PolyVoxSurfaceStyle surfaceStyle) {
     switch (surfaceStyle) {
@@ -199,7 +200,8 @@ void PolyVoxEntityItem::debugDump() const {
 
 void PolyVoxEntityItem::setVoxelData(const QByteArray& voxelData) {
     withWriteLock([&] {
-        _voxelData = voxelData;
+        // an edit may only carry the chunks it changed
+        _voxelData = PolyVoxChunks::merge(_voxelData, voxelData);
         _voxelDataDirty = true;
     });
 }
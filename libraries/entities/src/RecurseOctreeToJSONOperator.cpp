@@ -14,29 +14,25 @@
 
 RecurseOctreeToJSONOperator::RecurseOctreeToJSONOperator(const OctreeElementPointer&, QScriptEngine* engine,
     QString jsonPrefix, bool skipDefaults, bool skipThoseWithBadParents):
+    RecurseOctreeToPropertiesOperator(skipThoseWithBadParents),
     _engine(engine),
     _json(jsonPrefix),
-    _skipDefaults(skipDefaults),
-    _skipThoseWithBadParents(skipThoseWithBadParents)
+    _skipDefaults(skipDefaults)
 {
     _toStringMethod = _engine->evaluate("(function() { return JSON.stringify(this, null, '    ') })");
 }
 
-bool RecurseOctreeToJSONOperator::postRecursion(const OctreeElementPointer& element) {
-    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-
-    entityTreeElement->forEachEntity([&](const EntityItemPointer& entity) { processEntity(entity); } );
-    return true;
-}
-
-void RecurseOctreeToJSONOperator::processEntity(const EntityItemPointer& entity) {
-    if (_skipThoseWithBadParents && !entity->isParentIDValid()) {
-        return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
+void RecurseOctreeToJSONOperator::writeEntities() {
+    for (const auto& properties : _properties) {
+        writeEntity(properties);
     }
+    _properties.clear();
+}
 
+void RecurseOctreeToJSONOperator::writeEntity(const EntityItemProperties& properties) {
     QScriptValue qScriptValues = _skipDefaults
-        ? EntityItemNonDefaultPropertiesToScriptValue(_engine, entity->getProperties())
-        : EntityItemPropertiesToScriptValue(_engine, entity->getProperties());
+        ? EntityItemNonDefaultPropertiesToScriptValue(_engine, properties)
+        : EntityItemPropertiesToScriptValue(_engine, properties);
 
     if (_comma) {
         _json += ',';
@@ -9,25 +9,26 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
-#include "EntityTree.h"
+#include "RecurseOctreeToPropertiesOperator.h"
 
-class RecurseOctreeToJSONOperator : public RecurseOctreeOperator {
+class RecurseOctreeToJSONOperator : public RecurseOctreeToPropertiesOperator {
 public:
     RecurseOctreeToJSONOperator(const OctreeElementPointer&, QScriptEngine* engine, QString jsonPrefix = QString(), bool skipDefaults = true,
         bool skipThoseWithBadParents = false);
-    virtual bool preRecursion(const OctreeElementPointer& element) override { return true; };
-    virtual bool postRecursion(const OctreeElementPointer& element) override;
+
+    // once the tree was recursed, on the thread of the engine
+    void writeEntities();
+    // an entity of a snapshot, in place of the recursion
+    void writeEntity(const EntityItemProperties& properties);
 
     QString getJson() const { return _json; }
 
 private:
-    void processEntity(const EntityItemPointer& entity);
 
     QScriptEngine* _engine;
     QScriptValue _toStringMethod;
 
     QString _json;
     const bool _skipDefaults;
-    bool _skipThoseWithBadParents;
     bool _comma { false };
 };
@@ -14,48 +14,29 @@
 #include "EntityItemProperties.h"
 
 RecurseOctreeToMapOperator::RecurseOctreeToMapOperator(QVariantMap& map,
-                                                       const OctreeElementPointer& top,
+                                                       const OctreeElementPointer&,
                                                        QScriptEngine* engine,
                                                        bool skipDefaultValues,
                                                        bool skipThoseWithBadParents,
                                                        std::shared_ptr<AvatarData> myAvatar) :
-        RecurseOctreeOperator(),
+        RecurseOctreeToPropertiesOperator(skipThoseWithBadParents),
         _map(map),
-        _top(top),
         _engine(engine),
         _skipDefaultValues(skipDefaultValues),
-        _skipThoseWithBadParents(skipThoseWithBadParents),
         _myAvatar(myAvatar)
 {
-    // if some element "top" was given, only save information for that element and its children.
-    if (_top) {
-        _withinTop = false;
-    } else {
-        // top was NULL, export entire tree.
-        _withinTop = true;
-    }
-};
-
-bool RecurseOctreeToMapOperator::preRecursion(const OctreeElementPointer& element) {
-    if (element == _top) {
-        _withinTop = true;
-    }
-    return true;
 }
 
-bool RecurseOctreeToMapOperator::postRecursion(const OctreeElementPointer& element) {
-
-    EntityItemProperties defaultProperties;
-
-    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+void RecurseOctreeToMapOperator::writeEntities() {
     QVariantList entitiesQList = qvariant_cast<QVariantList>(_map["Entities"]);
+    entitiesQList.reserve(entitiesQList.size() + (int)_properties.size());
 
-    entityTreeElement->forEachEntity([&](EntityItemPointer entityItem) {
-        if (_skipThoseWithBadParents && !entityItem->isParentIDValid()) {
-            return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
-        }
+    QStringList jointNames;
+    if (_myAvatar) {
+        jointNames = _myAvatar->getJointNames();
+    }
 
-        EntityItemProperties properties = entityItem->getProperties();
+    for (const auto& properties : _properties) {
         QScriptValue qScriptValues;
         if (_skipDefaultValues) {
             qScriptValues = EntityItemNonDefaultPropertiesToScriptValue(_engine, properties);
@@ -64,22 +45,18 @@ bool RecurseOctreeToMapOperator::postRecursion(const OctreeElementPointer& eleme
         }
 
         // handle parentJointName for wearables
-        if (_myAvatar && entityItem->getParentID() == AVATAR_SELF_ID &&
-            entityItem->getParentJointIndex() != INVALID_JOINT_INDEX) {
+        if (_myAvatar && properties.getParentID() == AVATAR_SELF_ID &&
+            properties.getParentJointIndex() != INVALID_JOINT_INDEX) {
 
-            auto jointNames = _myAvatar->getJointNames();
-            auto parentJointIndex = entityItem->getParentJointIndex();
-        	if (parentJointIndex < jointNames.count()) {
+            auto parentJointIndex = properties.getParentJointIndex();
+            if (parentJointIndex < jointNames.count()) {
                 qScriptValues.setProperty("parentJointName", jointNames.at(parentJointIndex));
-        	}
+            }
         }
 
         entitiesQList << qScriptValues.toVariant();
-    });
+    }
+    _properties.clear();
 
     _map["Entities"] = entitiesQList;
-    if (element == _top) {
-        _withinTop = false;
-    }
-    return true;
 }
@@ -9,20 +9,19 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
-#include "EntityTree.h"
+#include "RecurseOctreeToPropertiesOperator.h"
 
-class RecurseOctreeToMapOperator : public RecurseOctreeOperator {
+class RecurseOctreeToMapOperator : public RecurseOctreeToPropertiesOperator {
 public:
     RecurseOctreeToMapOperator(QVariantMap& map, const OctreeElementPointer& top, QScriptEngine* engine, bool skipDefaultValues,
                                bool skipThoseWithBadParents, std::shared_ptr<AvatarData> myAvatar);
-    bool preRecursion(const OctreeElementPointer& element) override;
-    bool postRecursion(const OctreeElementPointer& element) override;
+
+    // once the tree was recursed, on the thread of the engine
+    void writeEntities();
+
  private:
     QVariantMap& _map;
-    OctreeElementPointer _top;
     QScriptEngine* _engine;
-    bool _withinTop;
     bool _skipDefaultValues;
-    bool _skipThoseWithBadParents;
     std::shared_ptr<AvatarData> _myAvatar;
 };
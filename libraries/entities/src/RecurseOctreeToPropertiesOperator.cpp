@@ -0,0 +1,36 @@
+//
+//  RecurseOctreeToPropertiesOperator.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RecurseOctreeToPropertiesOperator.h"
+
+#include <iterator>
+
+bool RecurseOctreeToPropertiesOperator::visit(const OctreeElementPointer& element) {
+    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+    entityTreeElement->forEachEntity([&](const EntityItemPointer& entity) {
+        if (_skipThoseWithBadParents && !entity->isParentIDValid()) {
+            return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
+        }
+        _properties.push_back(entity->getProperties());
+    });
+    return true;
+}
+
+std::unique_ptr<ParallelRecurseOctreeOperator> RecurseOctreeToPropertiesOperator::clone() const {
+    return std::make_unique<RecurseOctreeToPropertiesOperator>(_skipThoseWithBadParents);
+}
+
+void RecurseOctreeToPropertiesOperator::merge(ParallelRecurseOctreeOperator& other) {
+    auto& properties = static_cast<RecurseOctreeToPropertiesOperator&>(other)._properties;
+    _properties.insert(_properties.end(), std::make_move_iterator(properties.begin()),
+                       std::make_move_iterator(properties.end()));
+    properties.clear();
+}
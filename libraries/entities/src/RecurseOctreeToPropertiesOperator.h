@@ -0,0 +1,35 @@
+//
+//  RecurseOctreeToPropertiesOperator.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RecurseOctreeToPropertiesOperator_h
+#define hifi_RecurseOctreeToPropertiesOperator_h
+
+#include <vector>
+
+#include "EntityItemProperties.h"
+#include "EntityTree.h"
+
+// Gets the properties of all the entities of the tree, in parallel, for the persist and the export. The script values
+// are made afterwards by the operators that derive from this one, on the thread of their engine.
+class RecurseOctreeToPropertiesOperator : public ParallelRecurseOctreeOperator {
+public:
+    RecurseOctreeToPropertiesOperator(bool skipThoseWithBadParents) : _skipThoseWithBadParents(skipThoseWithBadParents) {}
+
+    bool visit(const OctreeElementPointer& element) override;
+    std::unique_ptr<ParallelRecurseOctreeOperator> clone() const override;
+    void merge(ParallelRecurseOctreeOperator& other) override;
+
+protected:
+    const bool _skipThoseWithBadParents;
+    std::vector<EntityItemProperties> _properties;
+};
+
+#endif // hifi_RecurseOctreeToPropertiesOperator_h
@@ -5,8 +5,10 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonValue>
 #include <QtCore/QJsonObject>
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QCryptographicHash>
+#include <QtCore/QSaveFile>
 
 #include <shared/FileUtils.h>
 
@@ -427,6 +429,14 @@ bool gl::linkProgram(GLuint glprogram, std::string& message) {
 }
 
 const QString& getShaderCacheFile() {
+    static const QString SHADER_CACHE_FOLDER{ "shaders" };
+    static const QString SHADER_CACHE_FILE_NAME{ "cache.bin" };
+    static const QString SHADER_CACHE_FILE = FileUtils::standardPath(SHADER_CACHE_FOLDER) + SHADER_CACHE_FILE_NAME;
+    return SHADER_CACHE_FILE;
+}
+
+// the cache of the previous versions, read once if there is no binary cache yet
+const QString& getLegacyShaderCacheFile() {
     static const QString SHADER_CACHE_FOLDER{ "shaders" };
     static const QString SHADER_CACHE_FILE_NAME{ "cache.json" };
     static const QString SHADER_CACHE_FILE = FileUtils::standardPath(SHADER_CACHE_FOLDER) + SHADER_CACHE_FILE_NAME;
@@ -437,9 +447,136 @@ static const char* SHADER_JSON_TYPE_KEY = "type";
 static const char* SHADER_JSON_SOURCE_KEY = "source";
 static const char* SHADER_JSON_DATA_KEY = "data";
 
+// Binary cache layout, native endianness as the file never leaves the machine:
+//   uint32 magic, uint32 version, string driver, uint32 count,
+//   count * { string hash, uint32 format, uint8 used, string binary }
+// where a string is a uint32 length followed by its bytes.
+static const uint32_t SHADER_CACHE_MAGIC = 0x43535348;  // "HSSC"
+static const uint32_t SHADER_CACHE_VERSION = 1;
+
+static std::string getDriverVersion() {
+    std::string result;
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        auto value = reinterpret_cast<const char*>(glGetString(name));
+        if (value) {
+            result += value;
+        }
+        result += '\n';
+    }
+    return result;
+}
+
+namespace {
+    class CacheReader {
+    public:
+        CacheReader(const uchar* data, qint64 size) : _data(data), _end(data + size) {}
+
+        bool read(uint32_t& value) { return read(&value, sizeof(value)); }
+        bool read(uint8_t& value) { return read(&value, sizeof(value)); }
+        bool read(std::string& value) {
+            const uchar* bytes;
+            uint32_t length;
+            if (!readBytes(bytes, length)) {
+                return false;
+            }
+            value.assign(reinterpret_cast<const char*>(bytes), length);
+            return true;
+        }
+        bool read(std::vector<char>& value) {
+            const uchar* bytes;
+            uint32_t length;
+            if (!readBytes(bytes, length)) {
+                return false;
+            }
+            value.assign(bytes, bytes + length);
+            return true;
+        }
+
+    private:
+        bool read(void* value, size_t size) {
+            if ((size_t)(_end - _data) < size) {
+                return false;
+            }
+            memcpy(value, _data, size);
+            _data += size;
+            return true;
+        }
+        bool readBytes(const uchar*& bytes, uint32_t& length) {
+            if (!read(length) || (size_t)(_end - _data) < length) {
+                return false;
+            }
+            bytes = _data;
+            _data += length;
+            return true;
+        }
+
+        const uchar* _data;
+        const uchar* _end;
+    };
+
+    void append(QByteArray& output, uint32_t value) {
+        output.append(reinterpret_cast<const char*>(&value), (int)sizeof(value));
+    }
+    void append(QByteArray& output, uint8_t value) {
+        output.append(reinterpret_cast<const char*>(&value), (int)sizeof(value));
+    }
+    void append(QByteArray& output, const char* data, size_t size) {
+        append(output, (uint32_t)size);
+        output.append(data, (int)size);
+    }
+}
+
+static bool loadBinaryShaderCache(const QString& shaderCacheFile, ShaderCache& cache) {
+    QFile file(shaderCacheFile);
+    if (!file.open(QFile::ReadOnly) || file.size() == 0) {
+        return false;
+    }
+    const uchar* data = file.map(0, file.size());
+    if (!data) {
+        return false;
+    }
+
+    CacheReader reader(data, file.size());
+    uint32_t magic, version, count;
+    std::string driver;
+    if (!reader.read(magic) || magic != SHADER_CACHE_MAGIC || !reader.read(version) || version != SHADER_CACHE_VERSION) {
+        qCDebug(glLogging) << "Ignoring shader cache of an unknown format";
+        return true;
+    }
+    if (!reader.read(driver) || driver != getDriverVersion()) {
+        qCDebug(glLogging) << "Ignoring shader cache saved by another driver";
+        return true;
+    }
+    if (!reader.read(count)) {
+        return true;
+    }
+
+    ShaderCache loaded;
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string hash;
+        uint32_t format;
+        uint8_t used;
+        CachedShader cachedShader;
+        if (!reader.read(hash) || !reader.read(format) || !reader.read(used) || !reader.read(cachedShader.binary)) {
+            qCWarning(glLogging) << "Ignoring truncated shader cache";
+            return true;
+        }
+        cachedShader.format = (GLenum)format;
+        cachedShader.used = used != 0;
+        loaded[hash] = std::move(cachedShader);
+    }
+
+    cache.swap(loaded);
+    return true;
+}
+
 void gl::loadShaderCache(ShaderCache& cache) {
 #if !defined(DISABLE_QML)
-    QString shaderCacheFile = getShaderCacheFile();
+    if (loadBinaryShaderCache(getShaderCacheFile(), cache)) {
+        return;
+    }
+
+    QString shaderCacheFile = getLegacyShaderCacheFile();
     if (QFileInfo(shaderCacheFile).exists()) {
         QString json = FileUtils::readFile(shaderCacheFile);
         auto root = QJsonDocument::fromJson(json.toUtf8()).object();
@@ -452,34 +589,46 @@ void gl::loadShaderCache(ShaderCache& cache) {
             memcpy(cachedShader.binary.data(), qbinary.data(), qbinary.size());
             cachedShader.format = (GLenum)programObject[SHADER_JSON_TYPE_KEY].toInt();
             cachedShader.source = programObject[SHADER_JSON_SOURCE_KEY].toString().toStdString();
+            // the programs the previous versions used are unknown, all of them are prewarmed
+            cachedShader.used = true;
         }
     }
 #endif
 }
 
 void gl::saveShaderCache(const ShaderCache& cache) {
-    QByteArray json;
-    {
-        QVariantMap variantMap;
-        for (const auto& entry : cache) {
-            const auto& key = entry.first;
-            const auto& type = entry.second.format;
-            const auto& binary = entry.second.binary;
-            QVariantMap qentry;
-            qentry[SHADER_JSON_TYPE_KEY] = QVariant(type);
-            qentry[SHADER_JSON_SOURCE_KEY] = QString(entry.second.source.c_str());
-            qentry[SHADER_JSON_DATA_KEY] = QByteArray{ binary.data(), (int)binary.size() }.toBase64();
-            variantMap[key.c_str()] = qentry;
+    QByteArray output;
+    append(output, SHADER_CACHE_MAGIC);
+    append(output, SHADER_CACHE_VERSION);
+    std::string driver = getDriverVersion();
+    append(output, driver.data(), driver.size());
+
+    uint32_t count = 0;
+    for (const auto& entry : cache) {
+        if (entry.second) {
+            ++count;
+        }
+    }
+    append(output, count);
+
+    for (const auto& entry : cache) {
+        // the sources are only kept in memory, the hashes identify them
+        const auto& cachedShader = entry.second;
+        if (cachedShader) {
+            append(output, entry.first.data(), entry.first.size());
+            append(output, (uint32_t)cachedShader.format);
+            append(output, (uint8_t)(cachedShader.used ? 1 : 0));
+            append(output, cachedShader.binary.data(), cachedShader.binary.size());
         }
-        json = QJsonDocument::fromVariant(variantMap).toJson(QJsonDocument::Indented);
     }
 
-    if (!json.isEmpty()) {
-        QString shaderCacheFile = getShaderCacheFile();
-        QFile saveFile(shaderCacheFile);
-        saveFile.open(QFile::WriteOnly | QFile::Text | QFile::Truncate);
-        saveFile.write(json);
-        saveFile.close();
+    // written aside and renamed, so that a crash can't leave a truncated cache
+    QSaveFile saveFile(getShaderCacheFile());
+    if (saveFile.open(QFile::WriteOnly)) {
+        saveFile.write(output);
+        if (saveFile.commit()) {
+            QFile::remove(getLegacyShaderCacheFile());
+        }
     }
 }
 
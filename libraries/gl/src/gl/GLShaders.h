@@ -86,12 +86,18 @@ struct CachedShader {
     GLenum format{ 0 };
     std::string source;
     std::vector<char> binary;
+    // the program was built in the session, it is prewarmed at the start of the next one
+    bool used{ false };
     inline operator bool() const { return format != 0 && !binary.empty(); }
 };
 
 using ShaderCache = std::unordered_map<std::string, CachedShader>;
 
 std::string getShaderHash(const std::string& shaderSource);
+
+// The cache is a binary file, memory mapped on load. The binaries only work with the driver that produced them,
+// so the cache is keyed by the driver of the current context as well as by the source hashes: a cache saved by
+// another driver (or driver version) is dropped on load.
 void loadShaderCache(ShaderCache& cache);
 void saveShaderCache(const ShaderCache& cache);
 
@@ -269,7 +269,9 @@ GLBackend::GLBackend() {
     initShaderBinaryCache();
 }
 
-GLBackend::~GLBackend() {}
+GLBackend::~GLBackend() {
+    stopShaderThread();
+}
 
 void GLBackend::shutdown() {
     if (_mipGenerationFramebufferId) {
@@ -367,7 +369,24 @@ void GLBackend::renderPassDraw(const Batch& batch) {
     const size_t numCommands = batch.getCommands().size();
     const Batch::Commands::value_type* command = batch.getCommands().data();
     const Batch::CommandOffsets::value_type* offset = batch.getCommandOffsets().data();
+    bool filterCommands = isCommandFilterEnabled();
+    const std::vector<bool>* filteredCommands = nullptr;
+    if (filterCommands) {
+        // found off the render thread once the batch is recorded, see Batch::finishFrame
+        const auto& filtered = batch.getFilteredCommands();
+        filteredCommands = &filtered.commands;
+        _stats._ISNumFormatChangesFiltered += filtered.numFormatChanges;
+        _stats._RSNumUniformBuffersFiltered += filtered.numUniformBuffers;
+        _stats._RSNumTexturesFiltered += filtered.numTextures;
+        _stats._RSNumTextureTablesFiltered += filtered.numTextureTables;
+        _stats._PSNumSetPipelinesFiltered += filtered.numPipelines;
+    }
     for (_commandIndex = 0; _commandIndex < numCommands; ++_commandIndex) {
+        if (filterCommands && (*filteredCommands)[_commandIndex]) {
+            command++;
+            offset++;
+            continue;
+        }
         switch (*command) {
             // Ignore these commands on this pass, taken care of in the transfer pass
             // Note we allow COMMAND_setViewportTransform to occur in both passes
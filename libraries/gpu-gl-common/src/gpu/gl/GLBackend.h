@@ -19,8 +19,10 @@
 #include <utility>
 #include <list>
 #include <array>
+#include <atomic>
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QThread>
 
 #include <gl/Config.h>
 #include <gl/GLShaders.h>
@@ -588,14 +590,26 @@ protected:
     // Note that shaders in the cache can still fail to load due to hardware or driver
     // changes that invalidate the cached binary, in which case we fall back on compiling
     // the source again
+    //
+    // The programs used in the previous session are built from their binaries ahead of their first use, on a
+    // shader thread with a context sharing the objects of the backend one. The thread then compiles the programs
+    // queued by Context::compileProgramAsync, until the backend goes away.
     struct ShaderBinaryCache {
         std::mutex _mutex;
         std::vector<GLint> _formats;
         std::unordered_map<std::string, ::gl::CachedShader> _binaries;
+        std::unordered_map<std::string, GLuint> _prewarmed;  // built by the warmup thread and not used yet
+        std::unordered_set<std::string> _requested;          // the shader thread skips them
+        std::atomic<bool> _stopShaderThread{ false };
+        QThread* _shaderThread{ nullptr };
     } _shaderBinaryCache;
 
     virtual void initShaderBinaryCache();
     virtual void killShaderBinaryCache();
+    void startShaderThread();
+    void stopShaderThread();
+    void warmupShaders(const std::vector<std::string>& hashes);
+    void compileAsyncPrograms();
 
     struct TextureManagementStageState {
         bool _sparseCapable{ false };
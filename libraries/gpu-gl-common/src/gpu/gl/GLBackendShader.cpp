@@ -7,7 +7,11 @@
 //
 #include "GLBackend.h"
 #include "GLShader.h"
+#include <QtGui/QOpenGLContext>
 #include <gl/GLShaders.h>
+#include <gl/OffscreenGLCanvas.h>
+#include <SharedUtil.h>
+#include <ThreadHelpers.h>
 
 using namespace gpu;
 using namespace gpu::gl;
@@ -105,16 +109,29 @@ GLShader* GLBackend::compileBackendProgram(const Shader& program, const Shader::
         auto hash = ::gl::getShaderHash(programSource);
 
         CachedShader cachedBinary;
+        GLuint glprogram = 0;
         {
             Lock shaderCacheLock{ _shaderBinaryCache._mutex };
-            if (_shaderBinaryCache._binaries.count(hash) != 0) {
-                cachedBinary = _shaderBinaryCache._binaries[hash];
+            _shaderBinaryCache._requested.insert(hash);
+            auto prewarmed = _shaderBinaryCache._prewarmed.find(hash);
+            if (prewarmed != _shaderBinaryCache._prewarmed.end()) {
+                glprogram = prewarmed->second;
+                _shaderBinaryCache._prewarmed.erase(prewarmed);
+            }
+            auto binary = _shaderBinaryCache._binaries.find(hash);
+            if (binary != _shaderBinaryCache._binaries.end()) {
+                binary->second.used = true;
+                if (0 == glprogram) {
+                    cachedBinary = binary->second;
+                }
             }
         }
 
-        GLuint glprogram = 0;
-        // If we have a cached binary program, try to load it instead of compiling the individual shaders
-        if (cachedBinary) {
+        // The shader thread may have built the program already
+        if (0 != glprogram) {
+            ++gpuBinaryShadersLoaded;
+        } else if (cachedBinary) {
+            // If we have a cached binary program, try to load it instead of compiling the individual shaders
             glprogram = ::gl::buildProgram(cachedBinary);
             if (0 != glprogram) {
                 ++gpuBinaryShadersLoaded;
@@ -157,6 +174,7 @@ GLShader* GLBackend::compileBackendProgram(const Shader& program, const Shader::
             if (!cachedBinary) {
                 ::gl::getProgramBinary(glprogram, cachedBinary);
                 cachedBinary.source = programSource;
+                cachedBinary.used = true;
                 std::unique_lock<std::mutex> shaderCacheLock{ _shaderBinaryCache._mutex };
                 _shaderBinaryCache._binaries[hash] = cachedBinary;
             }
@@ -398,9 +416,138 @@ void GLBackend::initShaderBinaryCache() {
         glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, _shaderBinaryCache._formats.data());
     }
     ::gl::loadShaderCache(_shaderBinaryCache._binaries);
+#if !defined(USE_GLES)
+    startShaderThread();
+#endif
 }
 
 void GLBackend::killShaderBinaryCache() {
+    stopShaderThread();
+    {
+        Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+        for (const auto& entry : _shaderBinaryCache._prewarmed) {
+            glDeleteProgram(entry.second);
+        }
+        _shaderBinaryCache._prewarmed.clear();
+    }
     ::gl::saveShaderCache(_shaderBinaryCache._binaries);
 }
 
+class ShaderCompileThread : public QThread {
+public:
+    ShaderCompileThread(std::function<void()> work) : _work(work) {}
+
+protected:
+    void run() override { _work(); }
+
+private:
+    std::function<void()> _work;
+};
+
+void GLBackend::startShaderThread() {
+    std::vector<std::string> hashes;
+    {
+        Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+        for (auto& entry : _shaderBinaryCache._binaries) {
+            if (entry.second.used) {
+                hashes.push_back(entry.first);
+            }
+            // the programs used in this session are the ones prewarmed in the next
+            entry.second.used = false;
+        }
+    }
+
+    QOpenGLContext* currentContext = QOpenGLContext::currentContext();
+    if (!currentContext) {
+        return;
+    }
+
+    // Creating the shared context releases the backend one
+    QSurface* currentSurface = currentContext->surface();
+    auto canvas = new OffscreenGLCanvas();
+    canvas->create(currentContext);
+    currentContext->makeCurrent(currentSurface);
+
+    auto thread = new ShaderCompileThread([this, canvas, hashes] {
+        if (canvas->makeCurrent()) {
+            if (!hashes.empty()) {
+                warmupShaders(hashes);
+            }
+            compileAsyncPrograms();
+            canvas->doneCurrent();
+        } else {
+            Backend::setAsyncProgramCompileEnabled(false);
+        }
+        delete canvas;
+    });
+    QString name = "ShaderCompileThread";
+    thread->setObjectName(name);
+    QObject::connect(thread, &QThread::started, [name] { setThreadName(name.toStdString()); });
+    canvas->moveToThreadWithContext(thread);
+
+    _shaderBinaryCache._stopShaderThread = false;
+    _shaderBinaryCache._shaderThread = thread;
+    Backend::setAsyncProgramCompileEnabled(true);
+    thread->start(QThread::LowPriority);
+}
+
+void GLBackend::stopShaderThread() {
+    auto thread = _shaderBinaryCache._shaderThread;
+    if (thread) {
+        _shaderBinaryCache._stopShaderThread = true;
+        // Wakes the thread up if it waits for programs to compile
+        Backend::setAsyncProgramCompileEnabled(false);
+        thread->wait();
+        delete thread;
+        _shaderBinaryCache._shaderThread = nullptr;
+    }
+}
+
+void GLBackend::warmupShaders(const std::vector<std::string>& hashes) {
+    size_t numPrewarmed = 0;
+    for (const auto& hash : hashes) {
+        if (_shaderBinaryCache._stopShaderThread) {
+            break;
+        }
+
+        CachedShader cachedBinary;
+        {
+            Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+            auto binary = _shaderBinaryCache._binaries.find(hash);
+            if (_shaderBinaryCache._requested.count(hash) != 0 || binary == _shaderBinaryCache._binaries.end()) {
+                continue;
+            }
+            cachedBinary = binary->second;
+        }
+
+        // A binary that fails to load here fails on the backend thread too, which compiles the sources then
+        GLuint glprogram = ::gl::buildProgram(cachedBinary);
+        if (0 == glprogram) {
+            continue;
+        }
+        // The program must be complete before the backend context uses it
+        glFinish();
+
+        Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+        if (_shaderBinaryCache._requested.count(hash) != 0) {
+            glDeleteProgram(glprogram);
+        } else {
+            _shaderBinaryCache._prewarmed[hash] = glprogram;
+            ++numPrewarmed;
+        }
+    }
+    qCDebug(gpugllogging) << "GLBackend::warmupShaders - prewarmed" << numPrewarmed << "of" << hashes.size() << "programs";
+}
+
+void GLBackend::compileAsyncPrograms() {
+    ShaderPointer program;
+    ProgramCompiledCallback callback;
+    while (!_shaderBinaryCache._stopShaderThread && popAsyncProgram(program, callback)) {
+        auto start = usecTimestampNow();
+        // The sync ends with a glFinish, the program is complete before the backend context uses it
+        bool compiled = (nullptr != GLShader::sync(*this, *program));
+        asyncProgramCompiled(compiled, usecTimestampNow() - start, callback);
+        program.reset();
+        callback = nullptr;
+    }
+}
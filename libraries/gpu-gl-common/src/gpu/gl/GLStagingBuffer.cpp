@@ -0,0 +1,112 @@
+//
+//  GLStagingBuffer.cpp
+//  libraries/gpu-gl-common/src/gpu/gl
+//
+//  Created by Vircadia contributors on 2021-03-19.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "GLStagingBuffer.h"
+
+#include <algorithm>
+
+using namespace gpu;
+using namespace gpu::gl;
+
+const size_t GLStagingBuffer::ALIGNMENT;
+
+bool GLStagingBuffer::isSupported() {
+#if defined(USE_GLES)
+    return false;
+#else
+    return GLAD_GL_VERSION_4_4 != 0;
+#endif
+}
+
+GLStagingBuffer::GLStagingBuffer(size_t size) : _size(size) {
+#if !defined(USE_GLES)
+    static const GLbitfield FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &_buffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _buffer);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, _size, nullptr, FLAGS);
+    _data = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, _size, FLAGS));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (!_data) {
+        qCWarning(gpugllogging) << "Unable to map the texture staging buffer";
+    }
+    (void)CHECK_GL_ERROR();
+#endif
+}
+
+GLStagingBuffer::~GLStagingBuffer() {
+    for (const auto& fence : _fences) {
+        glDeleteSync(fence.first);
+    }
+    _fences.clear();
+
+    if (_buffer) {
+        if (_data) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _buffer);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &_buffer);
+    }
+}
+
+bool GLStagingBuffer::allocate(size_t size, Allocation& allocation) {
+    if (!_data || size == 0 || size > _size) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    // An allocation never wraps around the end of the ring, the space left at the end is skipped instead
+    uint64_t start = _head;
+    size_t offset = (size_t)(start % _size);
+    if (offset + size > _size) {
+        start += _size - offset;
+        offset = 0;
+    }
+    uint64_t end = start + ((size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+    if (end - _tail > _size) {
+        return false;
+    }
+    _head = end;
+
+    allocation.buffer = _buffer;
+    allocation.data = _data + offset;
+    allocation.offset = offset;
+    allocation.size = size;
+    allocation.end = end;
+    return true;
+}
+
+void GLStagingBuffer::consume(uint64_t end) {
+    _consumed = std::max(_consumed, end);
+}
+
+void GLStagingBuffer::fence() {
+    if (_consumed == _fenced) {
+        return;
+    }
+    _fences.emplace_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), _consumed);
+    _fenced = _consumed;
+}
+
+void GLStagingBuffer::reclaim() {
+    while (!_fences.empty()) {
+        const auto& fence = _fences.front();
+        auto result = glClientWaitSync(fence.first, 0, 0);
+        if (GL_ALREADY_SIGNALED != result && GL_CONDITION_SATISFIED != result) {
+            break;
+        }
+        glDeleteSync(fence.first);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tail = fence.second;
+        }
+        _fences.pop_front();
+    }
+}
@@ -0,0 +1,73 @@
+//
+//  GLStagingBuffer.h
+//  libraries/gpu-gl-common/src/gpu/gl
+//
+//  Created by Vircadia contributors on 2021-03-19.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_gl_GLStagingBuffer_h
+#define hifi_gpu_gl_GLStagingBuffer_h
+
+#include <deque>
+#include <mutex>
+
+#include "GLShared.h"
+
+namespace gpu { namespace gl {
+
+/**
+  A ring of pixel unpack buffer memory that stays mapped for the lifetime of the buffer, so that texture data can be
+  written into it from any thread and uploaded on the GL thread with a buffer to texture copy.
+
+  Space is handed out in order and has to be consumed in the same order.  The GL thread fences the consumed space once
+  per frame and the space is only reused once the GPU has passed the fence.
+ */
+class GLStagingBuffer {
+public:
+    struct Allocation {
+        GLuint buffer { 0 };
+        uint8_t* data { nullptr };
+        size_t offset { 0 };
+        size_t size { 0 };
+        // Position of the end of the allocation in the ring, to be passed to consume()
+        uint64_t end { 0 };
+    };
+
+    // Persistent mapping needs glBufferStorage, from OpenGL 4.4
+    static bool isSupported();
+
+    // Must be called on the GL thread
+    GLStagingBuffer(size_t size);
+    ~GLStagingBuffer();
+
+    // Thread-safe.  Returns false if there isn't enough free space, in which case the caller should use client memory
+    bool allocate(size_t size, Allocation& allocation);
+
+    // These must be called on the GL thread
+    void consume(uint64_t end);
+    void fence();
+    void reclaim();
+
+private:
+    static const size_t ALIGNMENT { 16 };
+
+    GLuint _buffer { 0 };
+    uint8_t* _data { nullptr };
+    const size_t _size;
+
+    std::mutex _mutex;
+    // Running totals of the bytes handed out and of the bytes the GPU is done with
+    uint64_t _head { 0 };
+    uint64_t _tail { 0 };
+
+    uint64_t _consumed { 0 };
+    uint64_t _fenced { 0 };
+    std::deque<std::pair<GLsync, uint64_t>> _fences;
+};
+
+}}  // namespace gpu::gl
+
+#endif
@@ -8,6 +8,8 @@
 
 #include "GLTexture.h"
 
+#include <cstring>
+
 #include <QtCore/QThread>
 #include <NumericalConstants.h>
 
@@ -262,7 +264,13 @@ TransferJob::TransferJob(const Texture& texture,
     };
 
     _transferLambda = [=](const TexturePointer& texture) {
-        if (_mipData) {
+        if (_staging.size) {
+            auto gltexture = Backend::getGPUObject<GLTexture>(*texture);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _staging.buffer);
+            gltexture->copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, internalFormat, format,
+                type, _staging.size, BUFFER_OFFSET(_staging.offset));
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        } else if (_mipData) {
             auto gltexture = Backend::getGPUObject<GLTexture>(*texture);
             gltexture->copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, internalFormat, format,
                 type, _mipData->size(), _mipData->readData());
@@ -274,6 +282,15 @@ TransferJob::TransferJob(const Texture& texture,
     };
 }
 
+bool TransferJob::stage(GLStagingBuffer& stagingBuffer) {
+    if (!_mipData || !stagingBuffer.allocate(_mipData->size(), _staging)) {
+        return false;
+    }
+    memcpy(_staging.data, _mipData->readData(), _staging.size);
+    _mipData.reset();
+    return true;
+}
+
 TransferJob::TransferJob(uint16_t sourceMip, const std::function<void()>& transferLambda) :
     _sourceMip(sourceMip), _bufferingRequired(false), _transferLambda([=](const TexturePointer&) { transferLambda(); }) {}
 
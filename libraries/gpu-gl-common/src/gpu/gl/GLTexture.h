@@ -14,6 +14,7 @@
 #include "GLShared.h"
 #include "GLBackend.h"
 #include "GLTexelFormat.h"
+#include "GLStagingBuffer.h"
 #include <thread>
 
 namespace gpu { namespace gl {
@@ -71,6 +72,7 @@ public:
     using Lambda = std::function<void(const TexturePointer&)>;
 private:
     Texture::PixelsPointer _mipData;
+    GLStagingBuffer::Allocation _staging;
     size_t _transferOffset{ 0 };
     size_t _transferSize{ 0 };
     uint16_t _sourceMip{ 0 };
@@ -86,6 +88,10 @@ public:
     const size_t& size() const { return _transferSize; }
     bool bufferingRequired() const { return _bufferingRequired; }
     void buffer(const TexturePointer& texture) { _bufferingLambda(texture); }
+    // Moves the buffered data into the staging buffer, so that the transfer is a copy from a pixel unpack buffer
+    bool stage(GLStagingBuffer& stagingBuffer);
+    // The staging buffer position to consume once the job has been transferred or dropped, 0 if it isn't staged
+    uint64_t stagingEnd() const { return _staging.end; }
     void transfer(const TexturePointer& texture) { _transferLambda(texture); }
 };
 
@@ -23,6 +23,10 @@
 #define THREADED_TEXTURE_BUFFERING 1
 #define MAX_AUTO_FRACTION_OF_TOTAL_MEMORY 0.8f
 #define AUTO_RESERVE_TEXTURE_MEMORY MB_TO_BYTES(64)
+// Enough for the GPU to be a few frames behind on the transfers before buffering falls back to client memory
+// A texture covering about a hundredth of the view has to be twice as large as an off screen one to be demoted first
+#define PRIORITY_DEMOTE_WEIGHT 100.0f
+#define STAGING_BUFFER_SIZE (4 * GLVariableAllocationSupport::MAX_BUFFER_SIZE)
 
 static const size_t DEFAULT_ALLOWED_TEXTURE_MEMORY = MB_TO_BYTES(DEFAULT_ALLOWED_TEXTURE_MEMORY_MB);
 
@@ -111,6 +115,9 @@ private:
     Mutex _bufferMutex;
     // The buffering thread which drains the _activeBufferQueue and populates the _activeTransferQueue
     TextureBufferThread* _transferThread{ nullptr };
+    // Persistently mapped memory the buffering thread copies the mips into, created on the GL thread when supported.
+    // Without it the transfers read from the texture backing store directly
+    std::unique_ptr<GLStagingBuffer> _stagingBuffer;
     // The amount of buffering work currently represented by the _activeBufferQueue
     std::atomic<size_t> _queuedBufferSize{ 0 };
     // This contains a map of all textures to queues of pending transfer jobs.  While in the transfer state, this map is used to
@@ -164,6 +171,7 @@ void GLTextureTransferEngineDefault::shutdown() {
         _transferThread = nullptr;
     }
 #endif
+    _stagingBuffer.reset();
 }
 
 void GLTextureTransferEngineDefault::manageMemory() {
@@ -290,8 +298,8 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
             GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
             GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
             if (MemoryPressureState::Undersubscribed == _memoryPressureState && vargltexture->canPromote()) {
-                // Promote smallest first
-                _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
+                // Promote the ones that are largest on screen first, then the smallest first
+                _promoteQueue.push({ texture, texture->getPriority() + 1.0f / (float)gltexture->size() });
             } else if (MemoryPressureState::Transfer == _memoryPressureState && vargltexture->hasPendingTransfers()) {
                 populateTransferQueue(texture);
             }
@@ -301,6 +309,13 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
 
 // Manage the _activeBufferQueue and _activeTransferQueue queues
 void GLTextureTransferEngineDefault::processTransferQueues() {
+    if (!_stagingBuffer && GLStagingBuffer::isSupported()) {
+        _stagingBuffer = std::make_unique<GLStagingBuffer>(STAGING_BUFFER_SIZE);
+    }
+    if (_stagingBuffer) {
+        _stagingBuffer->reclaim();
+    }
+
 #if THREADED_TEXTURE_BUFFERING
     if (!_transferThread) {
         _transferThread = new TextureBufferThread(*this);
@@ -340,12 +355,19 @@ void GLTextureTransferEngineDefault::processTransferQueues() {
             if (tranferJob->sourceMip() < vargltexture->populatedMip()) {
                 tranferJob->transfer(texturePointer);
             }
+            if (tranferJob->stagingEnd()) {
+                _stagingBuffer->consume(tranferJob->stagingEnd());
+            }
             // The pop_front MUST be the last call since all of these varaibles in scope are
             // references that will be invalid after the pop
             activeTransferQueue.pop_front();
         }
     }
 
+    if (_stagingBuffer) {
+        _stagingBuffer->fence();
+    }
+
     // If we have no more work in any of the structures, reset the memory state to idle to
     // force reconstruction of the _pendingTransfersMap if necessary
     {
@@ -435,6 +457,9 @@ bool GLTextureTransferEngineDefault::processActiveBufferQueue() {
         }
         const auto& transferSize = transferJob->size();
         transferJob->buffer(texture);
+        if (_stagingBuffer) {
+            transferJob->stage(*_stagingBuffer);
+        }
         Q_ASSERT(_queuedBufferSize >= transferSize);
         _queuedBufferSize -= transferSize;
     }
@@ -504,13 +529,13 @@ void GLTextureTransferEngineDefault::processPromotes() {
 }
 
 void GLTextureTransferEngineDefault::processDemotes(size_t reliefRequired, const std::vector<TexturePointer>& strongTextures) {
-    // Demote largest first
+    // Demote largest first, favoring the ones that aren't on screen
     ImmediateWorkQueue demoteQueue;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
         if (!gltexture->_gpuObject.getImportant() && vargltexture->canDemote()) {
-            demoteQueue.push({ texture, (float)gltexture->size() });
+            demoteQueue.push({ texture, (float)gltexture->size() / (1.0f + PRIORITY_DEMOTE_WEIGHT * texture->getPriority()) });
         }
     }
 
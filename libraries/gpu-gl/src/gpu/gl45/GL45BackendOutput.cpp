@@ -152,10 +152,17 @@ void GL45Backend::do_blit(const Batch& batch, size_t paramOffset) {
     // Assign dest framebuffer if not bound already
     auto destFbo = getFramebufferID(dstframebuffer);
     auto srcFbo = getFramebufferID(srcframebuffer);
+    // Framebuffers without color, like the shadow maps, have their depth blitted instead
+    GLbitfield mask = GL_COLOR_BUFFER_BIT;
+    GLenum filter = GL_LINEAR;
+    if (srcframebuffer && dstframebuffer && !srcframebuffer->hasColor() && !dstframebuffer->hasColor() && srcframebuffer->hasDepth()) {
+        mask = GL_DEPTH_BUFFER_BIT;
+        filter = GL_NEAREST;
+    }
     glBlitNamedFramebuffer(srcFbo, destFbo,
         srcvp.x, srcvp.y, srcvp.z, srcvp.w,
         dstvp.x, dstvp.y, dstvp.z, dstvp.w,
-        GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        mask, filter);
     (void) CHECK_GL_ERROR();
 }
 
@@ -204,10 +204,18 @@ void GLESBackend::do_blit(const Batch& batch, size_t paramOffset) {
     // always bind the read fbo
     glBindFramebuffer(GL_READ_FRAMEBUFFER, getFramebufferID(srcframebuffer));
 
+    // Framebuffers without color, like the shadow maps, have their depth blitted instead
+    GLbitfield mask = GL_COLOR_BUFFER_BIT;
+    GLenum filter = GL_LINEAR;
+    if (srcframebuffer && dstframebuffer && !srcframebuffer->hasColor() && !dstframebuffer->hasColor() && srcframebuffer->hasDepth()) {
+        mask = GL_DEPTH_BUFFER_BIT;
+        filter = GL_NEAREST;
+    }
+
     // Blit!
     glBlitFramebuffer(srcvp.x, srcvp.y, srcvp.z, srcvp.w, 
         dstvp.x, dstvp.y, dstvp.z, dstvp.w,
-        GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        mask, filter);
 
     // Always clean the read fbo to 0
     glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
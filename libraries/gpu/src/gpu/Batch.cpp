@@ -12,8 +12,12 @@
 
 #include <string.h>
 
+#include <array>
+#include <bitset>
+
 #include <QDebug>
 #include "ShaderConstants.h"
+#include "TextureTable.h"
 
 #include "GPULogging.h"
 
@@ -95,6 +99,7 @@ void Batch::clear() {
     _textures.clear();
     _textureTables.clear();
     _transforms.clear();
+    _filteredCommands = FilteredCommands();
 
     _name.clear();
     _invalidModel = true;
@@ -724,6 +729,173 @@ void Batch::finishFrame(BufferUpdates& updates) {
         }
         updates.emplace_back(buffer->getUpdate());
     }
+
+    // While on the thread that recorded the frame, rather than when replaying it on the render thread
+    filterRedundantCommands();
+}
+
+// A set command is redundant when it binds what the previous one of the batch for the same slot bound, and no command in
+// between may have changed the binding behind the backend's back. These are skipped by the draw pass rather than
+// replayed: their handlers would find the binding in the state caches, but only after fetching the objects.
+void Batch::filterRedundantCommands() const {
+    PROFILE_RANGE(render_gpu, __FUNCTION__);
+    const size_t numCommands = _commands.size();
+    const Commands::value_type* command = _commands.data();
+    const CommandOffsets::value_type* offset = _commandOffsets.data();
+    _filteredCommands = FilteredCommands();
+    _filteredCommands.commands.assign(numCommands, false);
+
+    // What the commands of the batch left bound so far, null when unknown
+    struct UniformBufferBinding {
+        const Buffer* buffer{ nullptr };
+        Offset offset{ 0 };
+        Offset size{ 0 };
+    };
+    std::array<UniformBufferBinding, MAX_NUM_UNIFORM_BUFFERS> uniformBuffers;
+    std::array<const Texture*, MAX_NUM_RESOURCE_TEXTURES> textures;
+    textures.fill(nullptr);
+    const Pipeline* pipeline = nullptr;
+    const Stream::Format* format = nullptr;
+    // the texture table covers the first TextureTable::COUNT texture slots
+    const TextureTable* textureTable = nullptr;
+    uint32 textureTableSlot = 0;
+    // a null object is a valid binding as well, these tell the unknown bindings apart
+    std::bitset<MAX_NUM_UNIFORM_BUFFERS> knownUniformBuffers;
+    std::bitset<MAX_NUM_RESOURCE_TEXTURES> knownTextures;
+    bool knownTextureTable = false;
+    bool knownPipeline = false;
+    bool knownFormat = false;
+
+    for (size_t i = 0; i < numCommands; ++i, ++command, ++offset) {
+        const Param* params = _params.data() + *offset;
+        switch (*command) {
+            case COMMAND_setUniformBuffer: {
+                uint32 slot = params[3]._uint;
+                if (slot >= (uint32)MAX_NUM_UNIFORM_BUFFERS) {
+                    break;
+                }
+                UniformBufferBinding binding;
+                binding.buffer = _buffers.get(params[2]._uint).get();
+                binding.offset = params[1]._uint;
+                binding.size = params[0]._uint;
+                auto& current = uniformBuffers[slot];
+                if (knownUniformBuffers[slot] && current.buffer == binding.buffer && current.offset == binding.offset &&
+                    current.size == binding.size) {
+                    _filteredCommands.commands[i] = true;
+                    _filteredCommands.numUniformBuffers++;
+                } else {
+                    current = binding;
+                    knownUniformBuffers.set(slot);
+                }
+                break;
+            }
+
+            case COMMAND_setResourceTexture: {
+                uint32 slot = params[1]._uint;
+                if (slot >= (uint32)MAX_NUM_RESOURCE_TEXTURES) {
+                    break;
+                }
+                const Texture* texture = _textures.get(params[0]._uint).get();
+                if (knownTextures[slot] && textures[slot] == texture) {
+                    _filteredCommands.commands[i] = true;
+                    _filteredCommands.numTextures++;
+                } else {
+                    textures[slot] = texture;
+                    knownTextures.set(slot);
+                    if (slot < (uint32)TextureTable::COUNT) {
+                        knownTextureTable = false;
+                    }
+                }
+                break;
+            }
+
+            case COMMAND_setResourceTextureTable: {
+                // The materials that share their textures (the defaults, the shadow pass) share their table
+                const TextureTable* newTextureTable = _textureTables.get(params[0]._uint).get();
+                uint32 slot = params[1]._uint;
+                if (knownTextureTable && textureTable == newTextureTable && textureTableSlot == slot) {
+                    _filteredCommands.commands[i] = true;
+                    _filteredCommands.numTextureTables++;
+                } else {
+                    textureTable = newTextureTable;
+                    textureTableSlot = slot;
+                    knownTextureTable = true;
+                    // the table binds its textures to the slots, the tracking of these is lost
+                    knownTextures.reset();
+                }
+                break;
+            }
+
+            case COMMAND_setPipeline: {
+                const Pipeline* newPipeline = _pipelines.get(params[0]._uint).get();
+                if (knownPipeline && pipeline == newPipeline) {
+                    _filteredCommands.commands[i] = true;
+                    _filteredCommands.numPipelines++;
+                } else {
+                    pipeline = newPipeline;
+                    knownPipeline = true;
+                }
+                break;
+            }
+
+            case COMMAND_setInputFormat: {
+                const Stream::Format* newFormat = _streamFormats.get(params[0]._uint).get();
+                if (knownFormat && format == newFormat) {
+                    _filteredCommands.commands[i] = true;
+                    _filteredCommands.numFormatChanges++;
+                } else {
+                    format = newFormat;
+                    knownFormat = true;
+                }
+                break;
+            }
+
+            case COMMAND_setResourceFramebufferSwapChainTexture: {
+                uint32 slot = params[1]._uint;
+                if (slot < (uint32)MAX_NUM_RESOURCE_TEXTURES) {
+                    knownTextures.reset(slot);
+                }
+                if (slot < (uint32)TextureTable::COUNT) {
+                    knownTextureTable = false;
+                }
+                break;
+            }
+
+            // These bind textures of their own
+            case COMMAND_generateTextureMips:
+            case COMMAND_blit:
+                knownTextures.reset();
+                knownTextureTable = false;
+                break;
+
+            case COMMAND_generateTextureMipsWithPipeline:
+                knownTextures.reset();
+                knownTextureTable = false;
+                knownPipeline = false;
+                break;
+
+            // Anything can happen there
+            case COMMAND_resetStages:
+            case COMMAND_runLambda:
+                knownUniformBuffers.reset();
+                knownTextures.reset();
+                knownTextureTable = false;
+                knownPipeline = false;
+                knownFormat = false;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+const Batch::FilteredCommands& Batch::getFilteredCommands() const {
+    // The batches executed outside of a frame are filtered on the render thread
+    if (_filteredCommands.commands.size() != _commands.size()) {
+        filterRedundantCommands();
+    }
+    return _filteredCommands;
 }
 
 void Batch::flush() {
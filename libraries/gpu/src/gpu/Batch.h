@@ -222,6 +222,7 @@ public:
     // Blit src framebuffer to destination
     // the srcRect and dstRect are the rect region in source and destination framebuffers expressed in pixel space
     // with xy and zw the bounding corners of the rect region.
+    // Framebuffers without color attachments have their depth blitted instead.
     void blit(const FramebufferPointer& src, const Vec4i& srcRect, const FramebufferPointer& dst, const Vec4i& dstRect);
 
     // Generate the mips for a texture
@@ -530,6 +531,18 @@ public:
     bool _enableStereo{ true };
     bool _enableSkybox { false };
 
+    // The set commands that rebind what the previous command for the same slot left bound, for the backends to skip
+    struct FilteredCommands {
+        std::vector<bool> commands;
+        uint32 numFormatChanges { 0 };
+        uint32 numUniformBuffers { 0 };
+        uint32 numTextures { 0 };
+        uint32 numTextureTables { 0 };
+        uint32 numPipelines { 0 };
+    };
+    // Filters the batch first if it hasn't been since it was last recorded to
+    const FilteredCommands& getFilteredCommands() const;
+
 protected:
     std::string _name;
 
@@ -540,6 +553,9 @@ protected:
     // and prepare updates for the render shadow copies of the buffers
     void finishFrame(BufferUpdates& updates);
 
+    void filterRedundantCommands() const;
+    mutable FilteredCommands _filteredCommands;
+
     // Directly copy from the main data to the render thread shadow copy
     // MUST only be called on the render thread
     // MUST only be called on batches created on the render thread
@@ -8,6 +8,7 @@
 //  Distributed under the Apache License, Version 2.0.
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
+#include <condition_variable>
 #include <limits>
 #include "Context.h"
 
@@ -41,6 +42,12 @@ void ContextStats::evalDelta(const ContextStats& begin, const ContextStats& end)
     _DSNumTriangles= subWrap<uint32_t>(end._DSNumTriangles, begin._DSNumTriangles);
 
     _PSNumSetPipelines = subWrap<uint32_t>(end._PSNumSetPipelines, begin._PSNumSetPipelines);
+
+    _ISNumFormatChangesFiltered = subWrap<uint32_t>(end._ISNumFormatChangesFiltered, begin._ISNumFormatChangesFiltered);
+    _RSNumUniformBuffersFiltered = subWrap<uint32_t>(end._RSNumUniformBuffersFiltered, begin._RSNumUniformBuffersFiltered);
+    _RSNumTexturesFiltered = subWrap<uint32_t>(end._RSNumTexturesFiltered, begin._RSNumTexturesFiltered);
+    _RSNumTextureTablesFiltered = subWrap<uint32_t>(end._RSNumTextureTablesFiltered, begin._RSNumTextureTablesFiltered);
+    _PSNumSetPipelinesFiltered = subWrap<uint32_t>(end._PSNumSetPipelinesFiltered, begin._PSNumSetPipelinesFiltered);
 }
 
 
@@ -84,7 +91,22 @@ void Context::beginFrame(const glm::mat4& renderView, const glm::mat4& renderPos
     }
 }
 
+static thread_local Context::Batches* t_capturedBatches { nullptr };
+
+void Context::beginBatchCapture(Batches& batches) {
+    assert(!t_capturedBatches);
+    t_capturedBatches = &batches;
+}
+
+void Context::endBatchCapture() {
+    t_capturedBatches = nullptr;
+}
+
 void Context::appendFrameBatch(const BatchPointer& batch) {
+    if (t_capturedBatches) {
+        t_capturedBatches->push_back(batch);
+        return;
+    }
     if (!_frameActive) {
         qWarning() << "Batch executed outside of frame boundaries";
         return;
@@ -285,6 +307,10 @@ ContextMetricSize  Backend::texturePendingGPUTransferMemSize;
 ContextMetricSize  Backend::textureResourcePopulatedGPUMemSize;
 ContextMetricSize  Backend::textureResourceIdealGPUMemSize;
 
+ContextMetricCount Backend::asyncProgramPendingCount;
+ContextMetricCount Backend::asyncProgramCompiledCount;
+ContextMetricSize  Backend::asyncProgramCompileTime;
+
 Size Context::getFreeGPUMemSize() {
     return Backend::freeGPUMemSize.getValue();
 }
@@ -359,6 +385,81 @@ Size Context::getTextureResourceIdealGPUMemSize() {
     return Backend::textureResourceIdealGPUMemSize.getValue();
 }
 
+// The programs waiting for the backend compile thread
+static std::mutex asyncProgramsMutex;
+static std::condition_variable asyncProgramsCondition;
+static std::queue<std::pair<ShaderPointer, Backend::ProgramCompiledCallback>> asyncPrograms;
+static bool asyncProgramCompileEnabled { false };
+
+void Backend::setAsyncProgramCompileEnabled(bool enabled) {
+    std::queue<std::pair<ShaderPointer, ProgramCompiledCallback>> leftPrograms;
+    {
+        Lock lock(asyncProgramsMutex);
+        asyncProgramCompileEnabled = enabled;
+        if (!enabled) {
+            std::swap(leftPrograms, asyncPrograms);
+        }
+    }
+    asyncProgramsCondition.notify_all();
+
+    // Those are compiled on their first use
+    asyncProgramPendingCount.update((uint32_t)leftPrograms.size(), 0);
+    while (!leftPrograms.empty()) {
+        if (leftPrograms.front().second) {
+            leftPrograms.front().second(true, 0);
+        }
+        leftPrograms.pop();
+    }
+}
+
+bool Backend::popAsyncProgram(ShaderPointer& program, ProgramCompiledCallback& callback) {
+    Lock lock(asyncProgramsMutex);
+    asyncProgramsCondition.wait(lock, [] { return !asyncProgramCompileEnabled || !asyncPrograms.empty(); });
+    if (!asyncProgramCompileEnabled) {
+        return false;
+    }
+    program = asyncPrograms.front().first;
+    callback = asyncPrograms.front().second;
+    asyncPrograms.pop();
+    return true;
+}
+
+void Backend::asyncProgramCompiled(bool compiled, uint64_t usecs, const ProgramCompiledCallback& callback) {
+    asyncProgramPendingCount.decrement();
+    if (compiled) {
+        asyncProgramCompiledCount.increment();
+    }
+    asyncProgramCompileTime.update(0, (Size)usecs);
+    if (callback) {
+        callback(compiled, usecs);
+    }
+}
+
+bool Context::compileProgramAsync(const ShaderPointer& program, const Backend::ProgramCompiledCallback& callback) {
+    {
+        Lock lock(asyncProgramsMutex);
+        if (!asyncProgramCompileEnabled) {
+            return false;
+        }
+        asyncPrograms.emplace(program, callback);
+        Backend::asyncProgramPendingCount.increment();
+    }
+    asyncProgramsCondition.notify_one();
+    return true;
+}
+
+uint32_t Context::getAsyncProgramPendingCount() {
+    return Backend::asyncProgramPendingCount.getValue();
+}
+
+uint32_t Context::getAsyncProgramCompiledCount() {
+    return Backend::asyncProgramCompiledCount.getValue();
+}
+
+uint64_t Context::getAsyncProgramCompileTime() {
+    return Backend::asyncProgramCompileTime.getValue();
+}
+
 void Context::pushProgramsToSync(const std::vector<uint32_t>& programIDs, std::function<void()> callback, size_t rate) {
     std::vector<gpu::ShaderPointer> programs;
     for (auto programID : programIDs) {
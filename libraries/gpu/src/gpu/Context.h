@@ -46,6 +46,13 @@ public:
 
     uint32_t _PSNumSetPipelines { 0 };
 
+    // The redundant commands the backend skipped before replaying them
+    uint32_t _ISNumFormatChangesFiltered { 0 };
+    uint32_t _RSNumUniformBuffersFiltered { 0 };
+    uint32_t _RSNumTexturesFiltered { 0 };
+    uint32_t _RSNumTextureTablesFiltered { 0 };
+    uint32_t _PSNumSetPipelinesFiltered { 0 };
+
     ContextStats() {}
     ContextStats(const ContextStats& stats) = default;
 
@@ -94,8 +101,19 @@ public:
     void resetStats() const { _stats = ContextStats(); }
     void getStats(ContextStats& stats) const { stats = _stats; }
 
+    // Whether the backends that can skip the set commands of a batch that rebind what the previous ones left bound do
+    void enableCommandFilter(bool enable) { _commandFilterEnabled = enable; }
+    bool isCommandFilterEnabled() const { return _commandFilterEnabled; }
+
     virtual bool isTextureManagementSparseEnabled() const = 0;
 
+    // For the backends that compile the programs queued by Context::compileProgramAsync on a thread of their own:
+    // popAsyncProgram blocks until a program is queued, and returns false once the async compile is disabled
+    using ProgramCompiledCallback = std::function<void(bool ready, uint64_t usecs)>;
+    static void setAsyncProgramCompileEnabled(bool enabled);
+    static bool popAsyncProgram(ShaderPointer& program, ProgramCompiledCallback& callback);
+    static void asyncProgramCompiled(bool compiled, uint64_t usecs, const ProgramCompiledCallback& callback);
+
     // These should only be accessed by Backend implementation to report the buffer and texture allocations,
     // they are NOT public objects
     static ContextMetricSize freeGPUMemSize;
@@ -118,6 +136,10 @@ public:
     static ContextMetricSize textureResourcePopulatedGPUMemSize;
     static ContextMetricSize textureResourceIdealGPUMemSize;
 
+    static ContextMetricCount asyncProgramPendingCount;
+    static ContextMetricCount asyncProgramCompiledCount;
+    static ContextMetricSize asyncProgramCompileTime;
+
     virtual bool isStereo() const {
         return _stereo.isStereo();
     }
@@ -138,6 +160,7 @@ protected:
     friend class Context;
     mutable ContextStats _stats;
     StereoState _stereo;
+    bool _commandFilterEnabled { true };
 };
 
 class Context {
@@ -164,6 +187,12 @@ public:
     void appendFrameBatch(const BatchPointer& batch);
     FramePointer endFrame();
 
+    // While a thread captures batches, the ones it appends to the frame are kept in the capture instead. This lets jobs
+    // record their batches on worker threads and have them appended to the frame in a deterministic order afterwards.
+    using Batches = std::vector<BatchPointer>;
+    static void beginBatchCapture(Batches& batches);
+    static void endBatchCapture();
+
     static BatchPointer acquireBatch(const char* name = nullptr);
     static void releaseBatch(Batch* batch);
 
@@ -256,6 +285,17 @@ public:
     static Size getTextureResourcePopulatedGPUMemSize();
     static Size getTextureResourceIdealGPUMemSize();
 
+    // Compiles a program on a thread of the backend rather than on the render thread when a batch first uses it, for
+    // the shaders only known at run time (procedurals). The callback is called on that thread once the program is
+    // ready to use, or has failed to compile, with the compile time in usecs. If the backend stops compiling before
+    // getting to the program, the callback is called with no time: the program is then compiled on its first use.
+    // Returns false, and doesn't call the callback, if the backend can't compile programs on its own thread.
+    static bool compileProgramAsync(const ShaderPointer& program, const Backend::ProgramCompiledCallback& callback);
+
+    static uint32_t getAsyncProgramPendingCount();
+    static uint32_t getAsyncProgramCompiledCount();
+    static uint64_t getAsyncProgramCompileTime();  // usecs, in total
+
     struct ProgramsToSync {
         ProgramsToSync(const std::vector<gpu::ShaderPointer>& programs, std::function<void()> callback, size_t rate) :
             programs(programs), callback(callback), rate(rate) {}
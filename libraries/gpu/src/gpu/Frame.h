@@ -29,6 +29,9 @@ namespace gpu {
 
         StereoState stereoState;
         uint32_t frameIndex{ 0 };
+        /// When the simulation of the frame started and when the frame was submitted to the display, in usecs
+        uint64_t simulationTime{ 0 };
+        uint64_t submitTime{ 0 };
         /// The view matrix used for rendering the frame, only applicable for HMDs
         Mat4 view;
         /// The sensor pose used for rendering the frame, only applicable for HMDs
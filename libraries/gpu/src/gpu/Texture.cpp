@@ -22,6 +22,7 @@
 
 #include <ktx/KTX.h>
 #include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 #include "GPULogging.h"
 #include "Context.h"
@@ -508,6 +509,26 @@ void Texture::setSampler(const Sampler& sampler) {
     _samplerStamp++;
 }
 
+// Updates within an interval keep the highest priority, the first update of the next interval starts over so that the
+// priority drops once the items that drew the texture get smaller
+static const uint64_t PRIORITY_INTERVAL = USECS_PER_SECOND / 10;
+static const uint64_t PRIORITY_LIFETIME = USECS_PER_SECOND;
+
+float Texture::getPriority() const {
+    if (usecTimestampNow() - _priorityTimestamp > PRIORITY_LIFETIME) {
+        return 0.0f;
+    }
+    return _priority;
+}
+
+void Texture::updatePriority(float priority) {
+    uint64_t now = usecTimestampNow();
+    if (priority > _priority || now - _priorityTimestamp > PRIORITY_INTERVAL) {
+        _priority = priority;
+        _priorityTimestamp = now;
+    }
+}
+
 
 bool Texture::generateIrradiance(gpu::BackendTarget target) {
     if (getType() != TEX_CUBE) {
@@ -35,6 +35,8 @@ namespace ktx {
     struct Header;
     struct KeyValue;
     using KeyValues = std::list<KeyValue>;
+    struct Image;
+    using Images = std::vector<Image>;
 }
 
 namespace khronos { namespace gl { namespace texture {
@@ -574,12 +576,22 @@ public:
     bool getImportant() const { return _important; }
     void setImportant(bool important) { _important = important; }
 
+    // How much the texture matters to what is being rendered, the screen space size of the largest item that drew it
+    // recently.  Renderers update it as they draw, and the backend uses it to pick the textures to promote and demote.
+    // Thread-safe, and 0 once nothing has drawn the texture for a while
+    float getPriority() const;
+    void updatePriority(float priority);
+
     const GPUObjectPointer gpuObject {};
 
     ExternalUpdates getUpdates() const;
 
     // Serialize a texture into a KTX file
     static ktx::KTXUniquePointer serialize(const Texture& texture, const glm::ivec2& originalSize);
+    // The parts of the KTX file of a texture, without copying them, to be written with ktx::KTX::write.
+    // The images point into the stored mips of the texture.
+    static bool serialize(const Texture& texture, const glm::ivec2& originalSize,
+                          ktx::Header& header, ktx::Images& images, ktx::KeyValues& keyValues);
 
     static std::pair<TexturePointer, glm::ivec2> build(const ktx::KTXDescriptor& descriptor);
     static std::pair<TexturePointer, glm::ivec2> unserialize(const std::string& ktxFile);
@@ -636,6 +648,9 @@ protected:
     bool _isIrradianceValid = false;
     bool _defined = false;
     bool _important = false;
+
+    std::atomic<float> _priority { 0.0f };
+    std::atomic<uint64_t> _priorityTimestamp { 0 };
    
     static TexturePointer create(TextureUsageType usageType, Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices, uint16 numMips, const Sampler& sampler);
 
@@ -275,7 +275,10 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
     }
-    return storageView->toMemoryStorage();
+    // The view points straight into the mapped file and keeps it mapped for as long as it's held, so the mip can be
+    // uploaded without a copy.  The callers only hold on to mips while they use them, so the file still gets closed
+    // soon after releaseOpenKtxFiles
+    return storageView;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -389,13 +392,50 @@ void Texture::setKtxBacking(const cache::FilePointer& cacheEntry) {
 
 ktx::KTXUniquePointer Texture::serialize(const Texture& texture, const glm::ivec2& originalSize) {
     ktx::Header header;
+    ktx::Images images;
+    ktx::KeyValues keyValues;
+    if (!serialize(texture, originalSize, header, images, keyValues)) {
+        return nullptr;
+    }
+
+    auto ktxBuffer = ktx::KTX::create(header, images, keyValues);
+#if 0
+    auto expectedMipCount = texture.evalNumMips();
+    assert(expectedMipCount == ktxBuffer->_images.size());
+    assert(expectedMipCount == header.numberOfMipmapLevels);
+
+    assert(0 == memcmp(&header, ktxBuffer->getHeader(), sizeof(ktx::Header)));
+    assert(ktxBuffer->_images.size() == images.size());
+    auto start = ktxBuffer->_storage->data();
+    for (size_t i = 0; i < images.size(); ++i) {
+        auto expected = images[i];
+        auto actual = ktxBuffer->_images[i];
+        assert(expected._padding == actual._padding);
+        assert(expected._numFaces == actual._numFaces);
+        assert(expected._imageSize == actual._imageSize);
+        assert(expected._faceSize == actual._faceSize);
+        assert(actual._faceBytes.size() == actual._numFaces);
+        for (uint32_t face = 0; face < expected._numFaces; ++face) {
+            auto expectedFace = expected._faceBytes[face];
+            auto actualFace = actual._faceBytes[face];
+            auto offset = actualFace - start;
+            assert(offset % 4 == 0);
+            assert(expectedFace != actualFace);
+            assert(0 == memcmp(expectedFace, actualFace, expected._faceSize));
+        }
+    }
+#endif
+    return ktxBuffer;
+}
 
+bool Texture::serialize(const Texture& texture, const glm::ivec2& originalSize,
+                        ktx::Header& header, ktx::Images& images, ktx::KeyValues& keyValues) {
     // From texture format to ktx format description
     auto texelFormat = texture.getTexelFormat();
     auto mipFormat = texture.getStoredMipFormat();
 
     if (!Texture::evalKTXFormat(mipFormat, texelFormat, header)) {
-        return nullptr;
+        return false;
     }
 
     // Set Dimensions
@@ -435,13 +475,13 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture, const glm::ivec
             break;
         }
         default:
-            return nullptr;
+            return false;
     }
 
     // Number level of mips coming
     header.numberOfMipmapLevels = texture.getNumMips();
 
-    ktx::Images images;
+    images.clear();
     uint32_t imageOffset = 0;
     for (uint32_t level = 0; level < header.numberOfMipmapLevels; level++) {
         auto mip = texture.accessStoredMipFace(level);
@@ -469,7 +509,7 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture, const glm::ivec
     Byte keyvalPayload[GPUKTXPayload::SIZE];
     gpuKeyval.serialize(keyvalPayload);
 
-    ktx::KeyValues keyValues;
+    keyValues.clear();
     keyValues.emplace_back(GPUKTXPayload::KEY, (uint32)GPUKTXPayload::SIZE, (ktx::Byte*) &keyvalPayload);
 
     if (texture.getIrradiance()) {
@@ -490,34 +530,7 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture, const glm::ivec
         keyValues.emplace_back(SOURCE_HASH_KEY, static_cast<uint32>(binaryHash.size()), (ktx::Byte*) binaryHash.data());
     }
 
-    auto ktxBuffer = ktx::KTX::create(header, images, keyValues);
-#if 0
-    auto expectedMipCount = texture.evalNumMips();
-    assert(expectedMipCount == ktxBuffer->_images.size());
-    assert(expectedMipCount == header.numberOfMipmapLevels);
-
-    assert(0 == memcmp(&header, ktxBuffer->getHeader(), sizeof(ktx::Header)));
-    assert(ktxBuffer->_images.size() == images.size());
-    auto start = ktxBuffer->_storage->data();
-    for (size_t i = 0; i < images.size(); ++i) {
-        auto expected = images[i];
-        auto actual = ktxBuffer->_images[i];
-        assert(expected._padding == actual._padding);
-        assert(expected._numFaces == actual._numFaces);
-        assert(expected._imageSize == actual._imageSize);
-        assert(expected._faceSize == actual._faceSize);
-        assert(actual._faceBytes.size() == actual._numFaces);
-        for (uint32_t face = 0; face < expected._numFaces; ++face) {
-            auto expectedFace = expected._faceBytes[face];
-            auto actualFace = actual._faceBytes[face];
-            auto offset = actualFace - start;
-            assert(offset % 4 == 0);
-            assert(expectedFace != actualFace);
-            assert(0 == memcmp(expectedFace, actualFace, expected._faceSize));
-        }
-    }
-#endif
-    return ktxBuffer;
+    return true;
 }
 
 std::pair<TexturePointer, glm::ivec2> Texture::build(const ktx::KTXDescriptor& descriptor) {
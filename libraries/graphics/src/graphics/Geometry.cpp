@@ -26,7 +26,9 @@ Mesh::Mesh(const Mesh& mesh) :
     _vertexBuffer(mesh._vertexBuffer),
     _attributeBuffers(mesh._attributeBuffers),
     _indexBuffer(mesh._indexBuffer),
-    _partBuffer(mesh._partBuffer) {
+    _partBuffer(mesh._partBuffer),
+    _lodIndexBuffer(mesh._lodIndexBuffer),
+    _lods(mesh._lods) {
 }
 
 Mesh::~Mesh() {
@@ -108,6 +110,11 @@ void Mesh::setPartBuffer(const BufferView& buffer) {
     _partBuffer = buffer;
 }
 
+void Mesh::setLODs(const BufferView& indexBuffer, const LODs& lods) {
+    _lodIndexBuffer = indexBuffer;
+    _lods = lods;
+}
+
 Box Mesh::evalPartBound(int partNum) const {
     Box box;
     if (partNum < _partBuffer.getNum<Part>()) {
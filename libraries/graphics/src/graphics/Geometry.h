@@ -117,6 +117,20 @@ public:
     const BufferView& getPartBuffer() const { return _partBuffer; }
     size_t getNumParts() const { return _partBuffer.getNumElements(); }
 
+    // Simplified level of detail of the mesh, one part per part of the mesh indexing the same vertices in the LOD index
+    // buffer, with the largest distance in meters between the simplified surface and the full one
+    class LOD {
+    public:
+        float _error { 0.0f };
+        std::vector<Part> _parts;
+    };
+    using LODs = std::vector<LOD>;
+
+    // The LODs from the finest to the coarsest, their indices are kept apart from the index buffer of the full mesh
+    void setLODs(const BufferView& indexBuffer, const LODs& lods);
+    const BufferView& getLODIndexBuffer() const { return _lodIndexBuffer; }
+    const LODs& getLODs() const { return _lods; }
+
     // evaluate the bounding box of A part
     Box evalPartBound(int partNum) const;
     // evaluate the bounding boxes of the parts in the range [start, end]
@@ -154,6 +168,9 @@ protected:
 
     BufferView _partBuffer;
 
+    BufferView _lodIndexBuffer;
+    LODs _lods;
+
     void evalVertexFormat();
     void evalVertexStream();
 
@@ -11,6 +11,8 @@
 
 #include "TextureProcessing.h"
 
+#include <mutex>
+
 #include <glm/gtc/packing.hpp>
 
 #include <QtCore/QtGlobal>
@@ -23,6 +25,8 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
+#include <tbb/parallel_invoke.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -253,7 +257,23 @@ std::function<glm::vec3(gpu::uint32)> getHDRUnpackingFunction() {
     return getHDRUnpackingFunction(GPU_CUBEMAP_HDR_FORMAT);
 }
 
-Image processRawImageData(QIODevice& content, const std::string& filename) {
+// Decodes the image at a size of at most maxNumPixels when the reader can scale while decoding, as the JPEG one does at
+// a fraction of the size, so that the image isn't allocated and decoded at its full size to be downscaled after
+static Image readImage(QImageReader& imageReader, int maxNumPixels) {
+    QSize size = imageReader.size();
+    if (size.isValid() && (float)size.width() * (float)size.height() > (float)maxNumPixels &&
+        imageReader.supportsOption(QImageIOHandler::ScaledSize)) {
+        float scaleFactor = sqrtf(maxNumPixels / ((float)size.width() * (float)size.height()));
+        // rounded down so that processImage doesn't scale it again
+        QSize scaledSize(std::max((int)(scaleFactor * (float)size.width()), 1),
+                         std::max((int)(scaleFactor * (float)size.height()), 1));
+        imageReader.setScaledSize(scaledSize);
+        qCDebug(imagelogging).nospace() << "Downscaling while decoding (" << size << " to " << scaledSize << ")";
+    }
+    return Image(imageReader.read());
+}
+
+Image processRawImageData(QIODevice& content, const std::string& filename, int maxNumPixels) {
     // Help the Image loader by extracting the image file format from the url filename ext.
     // Some tga are not created properly without it.
     auto filenameExtension = filename.substr(filename.find_last_of('.') + 1);
@@ -284,7 +304,7 @@ Image processRawImageData(QIODevice& content, const std::string& filename) {
     QImageReader imageReader(&content, filenameExtension.c_str());
 
     if (imageReader.canRead()) {
-        return Image(imageReader.read());
+        return readImage(imageReader, maxNumPixels);
     } else {
         // Extension could be incorrect, try to detect the format from the content
         QImageReader newImageReader;
@@ -293,7 +313,7 @@ Image processRawImageData(QIODevice& content, const std::string& filename) {
         newImageReader.setDevice(&content);
 
         if (newImageReader.canRead()) {
-            return Image(newImageReader.read());
+            return readImage(newImageReader, maxNumPixels);
         }
     }
 
@@ -342,7 +362,7 @@ std::pair<gpu::TexturePointer, glm::ivec2> processImage(std::shared_ptr<QIODevic
                                                         int maxNumPixels, TextureUsage::Type textureType,
                                                         bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
 
-    Image image = processRawImageData(*content.get(), filename);
+    Image image = processRawImageData(*content.get(), filename, maxNumPixels);
     // Texture content can take up a lot of memory. Here we release our ownership of that content
     // in case it can be released.
     content.reset();
@@ -421,6 +441,18 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
 }
 
 #if defined(NVTT_API)
+// The mips and faces of a texture are compressed concurrently, but assigning them to the texture isn't thread-safe
+std::mutex assignCompressedMipMutex;
+
+void assignCompressedMip(gpu::Texture* texture, int face, int mipLevel, int size, const gpu::Byte* data) {
+    std::lock_guard<std::mutex> lock(assignCompressedMipMutex);
+    if (face >= 0) {
+        texture->assignStoredMipFace(mipLevel, face, size, data);
+    } else {
+        texture->assignStoredMip(mipLevel, size, data);
+    }
+}
+
 struct OutputHandler : public nvtt::OutputHandler {
     OutputHandler(gpu::Texture* texture, int face) : _texture(texture), _face(face) {}
 
@@ -440,11 +472,7 @@ struct OutputHandler : public nvtt::OutputHandler {
     }
 
     virtual void endImage() override {
-        if (_face >= 0) {
-            _texture->assignStoredMipFace(_miplevel, _face, _size, static_cast<const gpu::Byte*>(_data));
-        } else {
-            _texture->assignStoredMip(_miplevel, _size, static_cast<const gpu::Byte*>(_data));
-        }
+        assignCompressedMip(_texture, _face, _miplevel, _size, static_cast<const gpu::Byte*>(_data));
         free(_data);
         _data = nullptr;
     }
@@ -501,23 +529,52 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
 };
 
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
+        tbb::parallel_for(0, count, [&](int i) {
             if (!_abortProcessing.load()) {
                 task(context, i);
-            } else {
-                break;
             }
-        }
+        });
     }
 };
+
+// Builds the mips down from surface, then compresses them concurrently, each with its own compressor and output handler
+void compressMips(nvtt::Surface surface, bool buildMips, int face, int baseMipLevel, const nvtt::CompressionOptions& compressionOptions,
+                  const std::function<nvtt::OutputHandler*()>& createOutputHandler, const std::atomic<bool>& abortProcessing) {
+    std::vector<nvtt::Surface> mips;
+    mips.push_back(surface);
+    if (buildMips) {
+        while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
+            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
+            mips.push_back(surface);
+        }
+    }
+
+    ParallelTaskDispatcher dispatcher(abortProcessing);
+    tbb::parallel_for(0, (int)mips.size(), [&](int mip) {
+        if (abortProcessing.load()) {
+            return;
+        }
+
+        std::unique_ptr<nvtt::OutputHandler> outputHandler{ createOutputHandler() };
+        MyErrorHandler errorHandler;
+        nvtt::OutputOptions outputOptions;
+        outputOptions.setOutputHeader(false);
+        outputOptions.setOutputHandler(outputHandler.get());
+        outputOptions.setErrorHandler(&errorHandler);
+
+        nvtt::Context context;
+        context.setTaskDispatcher(&dispatcher);
+        context.compress(mips[mip], face, baseMipLevel + mip, compressionOptions, outputOptions);
+    });
+}
 #endif
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
@@ -604,35 +661,22 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     const int width = localCopy.getWidth();
     const int height = localCopy.getHeight();
 
-    nvtt::OutputOptions outputOptions;
-    outputOptions.setOutputHeader(false);
-
     nvtt::CompressionOptions compressionOptions;
     std::unique_ptr<nvtt::OutputHandler> outputHandler{ getNVTTCompressionOutputHandler(texture, face, compressionOptions) };
-
-    MyErrorHandler errorHandler;
-    outputOptions.setErrorHandler(&errorHandler);
-    nvtt::Context context;
-    int mipLevel = baseMipLevel;
-
-    outputOptions.setOutputHandler(outputHandler.get());
+    if (!outputHandler) {
+        return;
+    }
 
     nvtt::Surface surface;
     surface.setImage(nvtt::InputFormat_RGBA_32F, width, height, 1, localCopy.getBits());
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
-    context.setTaskDispatcher(&dispatcher);
-
-    context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-    if (buildMips) {
-        while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-            context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        }
-    }
+    compressMips(surface, buildMips, face, baseMipLevel, compressionOptions, [&] {
+        // the options were set up above, only the handler is needed per mip
+        nvtt::CompressionOptions handlerOptions;
+        return getNVTTCompressionOutputHandler(texture, face, handlerOptions);
+    }, abortProcessing);
 }
 
 void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
@@ -642,7 +686,6 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
     const int width = localCopy.getWidth(), height = localCopy.getHeight();
     auto mipFormat = texture->getStoredMipFormat();
-    int mipLevel = baseMipLevel;
 
     if (target != BackendTarget::GLES32) {
         if (localCopy.getFormat() != Image::Format_ARGB32) {
@@ -752,23 +795,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             return;
         }
 
-        nvtt::OutputOptions outputOptions;
-        outputOptions.setOutputHeader(false);
-        OutputHandler outputHandler(texture, face);
-        outputOptions.setOutputHandler(&outputHandler);
-        MyErrorHandler errorHandler;
-        outputOptions.setErrorHandler(&errorHandler);
-
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
-
-        context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        if (buildMips) {
-            while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-                surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-                context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-            }
-        }
+        compressMips(surface, buildMips, face, baseMipLevel, compressionOptions, [&] {
+            return new OutputHandler(texture, face);
+        }, abortProcessing);
     } else {
         int numMips = 1;
     
@@ -824,11 +853,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
         for (int i = 0; i < numMips; i++) {
             if (mipMaps[i].paucEncodingBits.get()) {
-                if (face >= 0) {
-                    texture->assignStoredMipFace(i+baseMipLevel, face, mipMaps[i].uiEncodingBitsBytes, static_cast<const gpu::Byte*>(mipMaps[i].paucEncodingBits.get()));
-                } else {
-                    texture->assignStoredMip(i + baseMipLevel, mipMaps[i].uiEncodingBitsBytes, static_cast<const gpu::Byte*>(mipMaps[i].paucEncodingBits.get()));
-                }
+                assignCompressedMip(texture, face, i + baseMipLevel, mipMaps[i].uiEncodingBitsBytes, static_cast<const gpu::Byte*>(mipMaps[i].paucEncodingBits.get()));
             }
         }
 
@@ -1491,11 +1516,14 @@ void convolveForGGX(const std::vector<Image>& faces, gpu::Texture* texture, Back
         output.applyGamma(1.0f/2.2f);
     }
 
-    for (int face = 0; face < 6; face++) {
-        for (gpu::uint16 mipLevel = 0; mipLevel < output.getMipCount(); mipLevel++) {
-            convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
-        }
-    }
+    // the faces and mips are independent, so they are compressed concurrently
+    const int NUM_FACES = 6;
+    const int mipCount = (int)output.getMipCount();
+    tbb::parallel_for(0, NUM_FACES * mipCount, [&](int index) {
+        int face = index / mipCount;
+        gpu::uint16 mipLevel = (gpu::uint16)(index % mipCount);
+        convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
+    });
 }
 
 gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcImage, const std::string& srcImageName,
@@ -1572,8 +1600,25 @@ gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcIm
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
 
-        // Generate irradiance while we are at it
+        // Generate irradiance while we are at it, from faces of the size the spherical harmonics are sampled at
+        // rather than a copy of the whole ones, concurrently with the mips
+        std::vector<Image> irradianceFaces;
         if (options & CUBE_GENERATE_IRRADIANCE) {
+            PROFILE_RANGE(resource_parse, "scaleIrradianceFaces");
+            static const glm::uint32 IRRADIANCE_FACE_SIZE = 32;
+            for (const auto& face : faces) {
+                if (face.getWidth() > IRRADIANCE_FACE_SIZE) {
+                    irradianceFaces.push_back(face.getScaled(glm::uvec2(IRRADIANCE_FACE_SIZE), Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+                } else {
+                    irradianceFaces.push_back(face);
+                }
+            }
+        }
+
+        auto generateIrradiance = [&] {
+            if (irradianceFaces.empty()) {
+                return;
+            }
             PROFILE_RANGE(resource_parse, "generateIrradiance");
             gpu::Element irradianceFormat;
             // TODO: we could locally compress the irradiance texture on Android, but we don't need to
@@ -1583,29 +1628,32 @@ gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcIm
                 irradianceFormat = GPU_CUBEMAP_HDR_FORMAT;
             }
 
-            auto irradianceTexture = gpu::Texture::createCube(irradianceFormat, faces[0].getWidth(), gpu::Texture::MAX_NUM_MIPS, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR, gpu::Sampler::WRAP_CLAMP));
+            auto irradianceTexture = gpu::Texture::createCube(irradianceFormat, irradianceFaces[0].getWidth(), gpu::Texture::MAX_NUM_MIPS, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR, gpu::Sampler::WRAP_CLAMP));
             irradianceTexture->setSource(srcImageName);
             irradianceTexture->setStoredMipFormat(irradianceFormat);
-            for (uint8 face = 0; face < faces.size(); ++face) {
-                irradianceTexture->assignStoredMipFace(0, face, faces[face].getByteCount(), faces[face].getBits());
+            for (uint8 face = 0; face < irradianceFaces.size(); ++face) {
+                irradianceTexture->assignStoredMipFace(0, face, irradianceFaces[face].getByteCount(), irradianceFaces[face].getBits());
             }
 
             irradianceTexture->generateIrradiance(target);
 
             auto irradiance = irradianceTexture->getIrradiance();
             theTexture->overrideIrradiance(irradiance);
-        }
-        
-        if (options & CUBE_GGX_CONVOLVE) {
-            // Performs and convolution AND mip map generation
-            convolveForGGX(faces, theTexture.get(), target, abortProcessing);
-        } else {
-            // Create mip maps and compress to final format in one go
-            for (uint8 face = 0; face < faces.size(); ++face) {
-                // Force building the mip maps right now on CPU if we are convolving for GGX later on
-                convertToTextureWithMips(theTexture.get(), std::move(faces[face]), target, abortProcessing, face);
+        };
+
+        auto generateMips = [&] {
+            if (options & CUBE_GGX_CONVOLVE) {
+                // Performs and convolution AND mip map generation
+                convolveForGGX(faces, theTexture.get(), target, abortProcessing);
+            } else {
+                // Create mip maps and compress to final format in one go, the faces concurrently
+                tbb::parallel_for(0, (int)faces.size(), [&](int face) {
+                    convertToTextureWithMips(theTexture.get(), std::move(faces[face]), target, abortProcessing, face);
+                });
             }
-        }
+        };
+
+        tbb::parallel_invoke(generateIrradiance, generateMips);
     }
 
     return theTexture;
@@ -19,11 +19,14 @@
 #include <cstring>
 #include <string>
 #include <memory>
+#include <mutex>
 
 #include <shared/Storage.h>
 
 #include "../khronos/KHR.h"
 
+class QIODevice;
+
 /* 
 
 KTX Specification: https://www.khronos.org/opengles/sdk/tools/KTX/file_format_spec/
@@ -356,6 +359,9 @@ namespace ktx {
         static size_t writeKeyValues(Byte* destBytes, size_t destByteSize, const KeyValues& keyValues);
         static Images writeImages(Byte* destBytes, size_t destByteSize, const Images& images);
 
+        // The same serialization written to a device as it goes, without a copy of the whole KTX in memory
+        static bool write(QIODevice& device, const Header& header, const Images& images, const KeyValues& keyValues = KeyValues());
+
         void writeMipData(uint16_t level, const Byte* sourceBytes, size_t source_size);
 
         // Parse a block of memory and create a KTX object from it
@@ -386,6 +392,47 @@ namespace ktx {
         friend struct KTXDescriptor;
     };
 
+    // Writes a KTX to a seekable device without assembling it in memory: the header and the key values when it is created,
+    // then each mip at its place whenever it is ready, in any order and from any thread, so that the mips can be written
+    // as they finish compressing. Each mip is checked against its descriptor as it is written.
+    //
+    //   StreamWriter writer(file, header, keyValues);
+    //   writer.writeMip(level, faceBytes, faceSize); // for every level
+    //   bool success = writer.finish();
+    class StreamWriter {
+    public:
+        // the descriptors of the header, for mips that are still to be made
+        StreamWriter(QIODevice& device, const Header& header, const KeyValues& keyValues = KeyValues());
+        StreamWriter(QIODevice& device, const Header& header, const ImageDescriptors& descriptors,
+                     const KeyValues& keyValues = KeyValues());
+
+        StreamWriter(const StreamWriter&) = delete;
+        StreamWriter& operator=(const StreamWriter&) = delete;
+
+        // the descriptors of images that are laid out as KTX::write lays them out
+        static ImageDescriptors generateImageDescriptors(const Images& images);
+
+        // the size of the whole KTX once all the mips are written
+        size_t getStorageSize() const;
+
+        bool writeMip(uint16_t level, const Image::FaceBytes& faceBytes, uint32_t faceSize);
+        bool writeImage(uint16_t level, const Image& image) { return writeMip(level, image._faceBytes, image._faceSize); }
+
+        // true if every mip was written and nothing failed
+        bool finish();
+
+    private:
+        bool writeAt(size_t offset, const void* data, size_t size);
+
+        std::mutex _mutex;
+        QIODevice& _device;
+        Header _header;
+        const ImageDescriptors _descriptors;
+        std::vector<bool> _isMipWritten;
+        size_t _imagesOffset { 0 };
+        bool _isValid { false };
+    };
+
 }
 
 Q_DECLARE_METATYPE(ktx::KTXDescriptor*);
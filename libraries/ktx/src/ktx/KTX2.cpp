@@ -0,0 +1,284 @@
+//
+//  KTX2.cpp
+//  ktx/src/ktx
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "KTX2.h"
+
+#include <QtCore/QDebug>
+
+#ifndef _MSC_VER
+#define NOEXCEPT noexcept
+#else
+#define NOEXCEPT
+#endif
+
+namespace ktx {
+    class KTX2ReaderException: public std::exception {
+    public:
+        KTX2ReaderException(const std::string& explanation) : _explanation("KTX2 deserialization error: " + explanation) {}
+        const char* what() const NOEXCEPT override { return _explanation.c_str(); }
+    private:
+        const std::string _explanation;
+    };
+
+    // The Vulkan formats that have a KTX 1.1 equivalent the GPU layer can load
+    enum VulkanFormat : uint32_t {
+        VK_FORMAT_R8G8B8A8_UNORM = 37,
+        VK_FORMAT_R8G8B8A8_SRGB = 43,
+        VK_FORMAT_BC1_RGB_SRGB_BLOCK = 132,
+        VK_FORMAT_BC1_RGBA_SRGB_BLOCK = 134,
+        VK_FORMAT_BC3_SRGB_BLOCK = 138,
+        VK_FORMAT_BC4_UNORM_BLOCK = 139,
+        VK_FORMAT_BC5_UNORM_BLOCK = 141,
+        VK_FORMAT_BC6H_UFLOAT_BLOCK = 143,
+        VK_FORMAT_BC7_SRGB_BLOCK = 146,
+        VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK = 147,
+        VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK = 148,
+        VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK = 149,
+        VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK = 150,
+        VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK = 151,
+        VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK = 152,
+        VK_FORMAT_EAC_R11_UNORM_BLOCK = 153,
+        VK_FORMAT_EAC_R11_SNORM_BLOCK = 154,
+        VK_FORMAT_EAC_R11G11_UNORM_BLOCK = 155,
+        VK_FORMAT_EAC_R11G11_SNORM_BLOCK = 156,
+    };
+
+    const KTX2::Identifier KTX2::IDENTIFIER {{
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    }};
+
+    std::mutex KTX2::_transcoderMutex;
+    KTX2TranscoderPointer KTX2::_transcoder;
+
+    static bool isInStorage(size_t storageSize, uint64_t byteOffset, uint64_t byteLength) {
+        return byteOffset <= storageSize && byteLength <= (storageSize - byteOffset);
+    }
+
+    bool KTX2::checkIdentifier(const Byte* identifier) {
+        return (0 == memcmp(identifier, IDENTIFIER.data(), IDENTIFIER_LENGTH));
+    }
+
+    std::unique_ptr<KTX2> KTX2::create(const StoragePointer& src) {
+        if (!src || !(*src)) {
+            return nullptr;
+        }
+
+        try {
+            auto srcSize = src->size();
+            auto srcBytes = src->data();
+            if (srcSize < KTX2_HEADER_SIZE) {
+                throw KTX2ReaderException("length is too short for header");
+            }
+            if (!checkIdentifier(srcBytes)) {
+                throw KTX2ReaderException("identifier field invalid");
+            }
+
+            std::unique_ptr<KTX2> result(new KTX2());
+            memcpy(&result->_header, srcBytes, KTX2_HEADER_SIZE);
+            const auto& header = result->_header;
+
+            if (header.pixelWidth == 0) {
+                throw KTX2ReaderException("pixelWidth field is 0");
+            }
+            if (header.faceCount != 1 && header.faceCount != NUM_CUBEMAPFACES) {
+                throw KTX2ReaderException("faceCount field has invalid value");
+            }
+
+            auto numLevels = header.getNumberOfLevels();
+            if (srcSize < (KTX2_HEADER_SIZE + (size_t)numLevels * KTX2_LEVEL_INDEX_SIZE)) {
+                throw KTX2ReaderException("length is too short for level index");
+            }
+            result->_levels.resize(numLevels);
+            memcpy(result->_levels.data(), srcBytes + KTX2_HEADER_SIZE, numLevels * KTX2_LEVEL_INDEX_SIZE);
+            for (uint32_t level = 0; level < numLevels; ++level) {
+                const auto& levelIndex = result->_levels[level];
+                if (!isInStorage(srcSize, levelIndex.byteOffset, levelIndex.byteLength)) {
+                    throw KTX2ReaderException("length is too short for level " + std::to_string(level));
+                }
+            }
+
+            if (!isInStorage(srcSize, header.dfdByteOffset, header.dfdByteLength)) {
+                throw KTX2ReaderException("length is too short for data format descriptor");
+            }
+            if (!isInStorage(srcSize, header.kvdByteOffset, header.kvdByteLength)) {
+                throw KTX2ReaderException("length is too short for metadata");
+            }
+            if (!isInStorage(srcSize, header.sgdByteOffset, header.sgdByteLength)) {
+                throw KTX2ReaderException("length is too short for supercompression global data");
+            }
+
+            // the key values are serialized as in KTX 1.1
+            result->_keyValues = KTX::parseKeyValues(header.kvdByteLength, srcBytes + header.kvdByteOffset);
+            result->_storage = src;
+            return result;
+        }
+        catch (const KTX2ReaderException& e) {
+            qWarning() << e.what();
+            return nullptr;
+        }
+    }
+
+    void KTX2::setTranscoder(const KTX2TranscoderPointer& transcoder) {
+        std::lock_guard<std::mutex> lock(_transcoderMutex);
+        _transcoder = transcoder;
+    }
+
+    KTX2TranscoderPointer KTX2::getTranscoder() {
+        std::lock_guard<std::mutex> lock(_transcoderMutex);
+        return _transcoder;
+    }
+
+    StoragePointer KTX2::getLevelData(uint32_t level) const {
+        if (level >= _levels.size() || _levels[level].byteLength == 0) {
+            return StoragePointer();
+        }
+        return _storage->createView((size_t)_levels[level].byteLength, (size_t)_levels[level].byteOffset);
+    }
+
+    StoragePointer KTX2::getDataFormatDescriptor() const {
+        if (_header.dfdByteLength == 0) {
+            return StoragePointer();
+        }
+        return _storage->createView(_header.dfdByteLength, _header.dfdByteOffset);
+    }
+
+    StoragePointer KTX2::getSupercompressionGlobalData() const {
+        if (_header.sgdByteLength == 0) {
+            return StoragePointer();
+        }
+        return _storage->createView((size_t)_header.sgdByteLength, (size_t)_header.sgdByteOffset);
+    }
+
+    ktx::Header KTX2::evalKTXHeader() const {
+        ktx::Header header;
+        header.pixelWidth = _header.pixelWidth;
+        header.pixelHeight = _header.pixelHeight;
+        header.pixelDepth = _header.pixelDepth;
+        header.numberOfArrayElements = _header.layerCount;
+        header.numberOfFaces = _header.faceCount;
+        header.numberOfMipmapLevels = _header.levelCount;
+        return header;
+    }
+
+    bool KTX2::evalKTXFormat(uint32_t vkFormat, ktx::Header& header) {
+        switch (vkFormat) {
+            case VK_FORMAT_R8G8B8A8_UNORM:
+                header.setUncompressed(GLType::UNSIGNED_BYTE, 1, GLFormat::RGBA, GLInternalFormat::RGBA8, GLBaseInternalFormat::RGBA);
+                break;
+            case VK_FORMAT_R8G8B8A8_SRGB:
+                header.setUncompressed(GLType::UNSIGNED_BYTE, 1, GLFormat::RGBA, GLInternalFormat::SRGB8_ALPHA8, GLBaseInternalFormat::RGBA);
+                break;
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_SRGB_S3TC_DXT1_EXT, GLBaseInternalFormat::RGB);
+                break;
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, GLBaseInternalFormat::RGBA);
+                break;
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, GLBaseInternalFormat::RGBA);
+                break;
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RED_RGTC1, GLBaseInternalFormat::RED);
+                break;
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RG_RGTC2, GLBaseInternalFormat::RG);
+                break;
+            case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT, GLBaseInternalFormat::RGB);
+                break;
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_SRGB_ALPHA_BPTC_UNORM, GLBaseInternalFormat::RGBA);
+                break;
+            case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RGB8_ETC2, GLBaseInternalFormat::RGB);
+                break;
+            case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_SRGB8_ETC2, GLBaseInternalFormat::RGB);
+                break;
+            case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2, GLBaseInternalFormat::RGBA);
+                break;
+            case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2, GLBaseInternalFormat::RGBA);
+                break;
+            case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RGBA8_ETC2_EAC, GLBaseInternalFormat::RGBA);
+                break;
+            case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_SRGB8_ALPHA8_ETC2_EAC, GLBaseInternalFormat::RGBA);
+                break;
+            case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_R11_EAC, GLBaseInternalFormat::RED);
+                break;
+            case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_SIGNED_R11_EAC, GLBaseInternalFormat::RED);
+                break;
+            case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RG11_EAC, GLBaseInternalFormat::RG);
+                break;
+            case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+                header.setCompressed(GLInternalFormat::COMPRESSED_SIGNED_RG11_EAC, GLBaseInternalFormat::RG);
+                break;
+            default:
+                return false;
+        }
+        return true;
+    }
+
+    std::unique_ptr<KTX> KTX2::toKTX() const {
+        if (needsTranscoding()) {
+            auto transcoder = getTranscoder();
+            if (!transcoder) {
+                qWarning() << "KTX2 texels need to be transcoded and there is no transcoder, supercompression scheme:"
+                           << _header.supercompressionScheme;
+                return nullptr;
+            }
+            return transcoder->transcode(*this);
+        }
+
+        if (_header.layerCount > 0) {
+            qWarning() << "KTX2 texture arrays are not supported";
+            return nullptr;
+        }
+
+        auto header = evalKTXHeader();
+        if (!evalKTXFormat(_header.vkFormat, header)) {
+            qWarning() << "KTX2 vkFormat has no KTX equivalent:" << _header.vkFormat;
+            return nullptr;
+        }
+
+        // A KTX2 level holds all its faces one after the other, where KTX stores each face on its own
+        Images images;
+        size_t imageOffset = 0;
+        auto numFaces = header.numberOfFaces;
+        auto srcBytes = _storage->data();
+        for (uint32_t level = 0; level < (uint32_t)_levels.size(); ++level) {
+            auto faceSize = header.evalFaceSize(level);
+            if (faceSize == 0 || _levels[level].byteLength != faceSize * numFaces) {
+                qWarning() << "KTX2 level" << level << "has a size that doesn't match its format";
+                return nullptr;
+            }
+
+            auto levelBytes = srcBytes + _levels[level].byteOffset;
+            if (numFaces == NUM_CUBEMAPFACES) {
+                Image::FaceBytes faces(NUM_CUBEMAPFACES);
+                for (uint32_t face = 0; face < NUM_CUBEMAPFACES; ++face) {
+                    faces[face] = levelBytes + face * faceSize;
+                }
+                images.emplace_back(Image(imageOffset, (uint32_t)faceSize, 0, faces));
+            } else {
+                images.emplace_back(Image(imageOffset, (uint32_t)faceSize, 0, levelBytes));
+            }
+            imageOffset += numFaces * faceSize + IMAGE_SIZE_WIDTH;
+        }
+
+        return KTX::create(header, images, _keyValues);
+    }
+}
@@ -0,0 +1,167 @@
+//
+//  KTX2.h
+//  ktx/src/ktx
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#pragma once
+#ifndef hifi_ktx_KTX2_h
+#define hifi_ktx_KTX2_h
+
+#include "KTX.h"
+
+/*
+
+KTX 2.0 Specification: https://github.khronos.org/KTX-Specification/
+
+A KTX2 file is laid out in a different way than a KTX 1.1 one:
+
+Byte[12] identifier
+UInt32 vkFormat
+UInt32 typeSize
+UInt32 pixelWidth
+UInt32 pixelHeight
+UInt32 pixelDepth
+UInt32 layerCount
+UInt32 faceCount
+UInt32 levelCount
+UInt32 supercompressionScheme
+
+// Index
+UInt32 dfdByteOffset
+UInt32 dfdByteLength
+UInt32 kvdByteOffset
+UInt32 kvdByteLength
+UInt64 sgdByteOffset
+UInt64 sgdByteLength
+
+// Level Index
+for each level in max(1, levelCount)
+    UInt64 byteOffset
+    UInt64 byteLength
+    UInt64 uncompressedByteLength
+end
+
+Data Format Descriptor, Key/Value Data, Supercompression Global Data and the Mip Level Array follow at the offsets
+given by the index. The key values are serialized the same way as in KTX 1.1.
+
+The texels of a level are either in a Vulkan format that is used as is, or supercompressed (Basis Universal ETC1S
+comes with BASIS_LZ and a vkFormat of 0, UASTC with a vkFormat of 0 and no or zstd supercompression), in which case
+they need to be transcoded to a format the GPU can sample first.
+
+*/
+
+namespace ktx {
+
+    class KTX2;
+
+    // Turns the texels of a KTX2 that is supercompressed, or in a universal format, into a KTX in a format the GPU can
+    // sample. The transcoder is the one that knows which block formats the GPU supports.
+    class KTX2Transcoder {
+    public:
+        virtual ~KTX2Transcoder() {}
+        virtual std::unique_ptr<KTX> transcode(const KTX2& source) const = 0;
+    };
+    using KTX2TranscoderPointer = std::shared_ptr<KTX2Transcoder>;
+
+    class KTX2 {
+    public:
+        static const size_t IDENTIFIER_LENGTH { ktx::Header::IDENTIFIER_LENGTH };
+        using Identifier = ktx::Header::Identifier;
+        static const Identifier IDENTIFIER;
+
+        enum SupercompressionScheme : uint32_t {
+            NONE = 0,
+            BASIS_LZ = 1,
+            ZSTANDARD = 2,
+            ZLIB = 3,
+        };
+
+        // the Vulkan format of a level that is in a universal format, that needs a transcoder whatever the supercompression
+        static const uint32_t VK_FORMAT_UNDEFINED { 0 };
+
+        struct Header {
+            Byte identifier[IDENTIFIER_LENGTH];
+
+            uint32_t vkFormat { VK_FORMAT_UNDEFINED };
+            uint32_t typeSize { 1 };
+            uint32_t pixelWidth { 1 };
+            uint32_t pixelHeight { 0 };
+            uint32_t pixelDepth { 0 };
+            uint32_t layerCount { 0 };
+            uint32_t faceCount { 1 };
+            uint32_t levelCount { 0 };
+            uint32_t supercompressionScheme { NONE };
+
+            uint32_t dfdByteOffset { 0 };
+            uint32_t dfdByteLength { 0 };
+            uint32_t kvdByteOffset { 0 };
+            uint32_t kvdByteLength { 0 };
+            uint64_t sgdByteOffset { 0 };
+            uint64_t sgdByteLength { 0 };
+
+            uint32_t getNumberOfLevels() const { return (levelCount ? levelCount : 1); }
+        };
+
+        struct LevelIndex {
+            uint64_t byteOffset { 0 };
+            uint64_t byteLength { 0 };
+            uint64_t uncompressedByteLength { 0 };
+        };
+        using LevelIndices = std::vector<LevelIndex>;
+
+        static bool checkIdentifier(const Byte* identifier);
+
+        // Parse a block of memory and create a KTX2 object from it, the levels still point in the storage
+        static std::unique_ptr<KTX2> create(const StoragePointer& src);
+
+        // The transcoder used for the KTX2 that can't be turned into a KTX as they are, shared by all the threads
+        static void setTranscoder(const KTX2TranscoderPointer& transcoder);
+        static KTX2TranscoderPointer getTranscoder();
+
+        const Header& getHeader() const { return _header; }
+        const LevelIndices& getLevelIndices() const { return _levels; }
+        const KeyValues& getKeyValues() const { return _keyValues; }
+        const StoragePointer& getStorage() const { return _storage; }
+
+        bool isSupercompressed() const { return _header.supercompressionScheme != NONE; }
+        bool needsTranscoding() const { return isSupercompressed() || _header.vkFormat == VK_FORMAT_UNDEFINED; }
+
+        // the texels of a level, for all the faces and layers of it, as they are stored
+        StoragePointer getLevelData(uint32_t level) const;
+        StoragePointer getDataFormatDescriptor() const;
+        StoragePointer getSupercompressionGlobalData() const;
+
+        // A KTX header with the dimensions, faces and levels of this KTX2, for the transcoder to set its format on
+        ktx::Header evalKTXHeader() const;
+
+        // Copy the levels into a KTX: as they are for the Vulkan formats the GPU layer knows, or through the transcoder.
+        // Null if the format has no KTX 1.1 equivalent, or it needs transcoding and there is no transcoder.
+        std::unique_ptr<KTX> toKTX() const;
+
+    private:
+        KTX2() {}
+
+        static bool evalKTXFormat(uint32_t vkFormat, ktx::Header& header);
+
+        Header _header;
+        LevelIndices _levels;
+        KeyValues _keyValues;
+        StoragePointer _storage;
+
+        static std::mutex _transcoderMutex;
+        static KTX2TranscoderPointer _transcoder;
+    };
+
+    static const size_t KTX2_HEADER_SIZE { 80 };
+    static_assert(sizeof(KTX2::Header) == KTX2_HEADER_SIZE, "KTX2 Header size is static and should not change from the spec");
+    static const size_t KTX2_LEVEL_INDEX_SIZE { 24 };
+    static_assert(sizeof(KTX2::LevelIndex) == KTX2_LEVEL_INDEX_SIZE, "KTX2 level index size should not change from the spec");
+
+}
+
+#endif // hifi_ktx_KTX2_h
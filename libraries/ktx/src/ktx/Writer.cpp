@@ -13,6 +13,7 @@
 
 #include <QtGlobal>
 #include <QtCore/QDebug>
+#include <QtCore/QIODevice>
 #ifndef _MSC_VER
 #define NOEXCEPT noexcept
 #else
@@ -246,6 +247,134 @@ namespace ktx {
         return destImages;
     }
 
+    bool KTX::write(QIODevice& device, const Header& header, const Images& images, const KeyValues& keyValues) {
+        StreamWriter writer(device, header, StreamWriter::generateImageDescriptors(images), keyValues);
+        for (uint16_t level = 0; level < images.size(); level++) {
+            if (!writer.writeImage(level, images[level])) {
+                return false;
+            }
+        }
+        return writer.finish();
+    }
+
+    StreamWriter::StreamWriter(QIODevice& device, const Header& header, const KeyValues& keyValues) :
+        StreamWriter(device, header, header.generateImageDescriptors(), keyValues) {
+    }
+
+    StreamWriter::StreamWriter(QIODevice& device, const Header& header, const ImageDescriptors& descriptors,
+                               const KeyValues& keyValues) :
+        _device(device),
+        _header(header),
+        _descriptors(descriptors),
+        _isMipWritten(descriptors.size(), false) {
+        if (_descriptors.empty() || _descriptors.size() > _header.getNumberOfLevels()) {
+            qWarning() << "KTX stream has" << _descriptors.size() << "images for" << _header.getNumberOfLevels() << "levels";
+            return;
+        }
+
+        std::vector<Byte> keyValueData(KeyValue::serializedKeyValuesByteSize(keyValues));
+        _header.bytesOfKeyValueData = (uint32_t)KTX::writeKeyValues(keyValueData.data(), keyValueData.size(), keyValues);
+        _imagesOffset = sizeof(Header) + _header.bytesOfKeyValueData;
+
+        _isValid = writeAt(0, &_header, sizeof(Header)) && writeAt(sizeof(Header), keyValueData.data(), _header.bytesOfKeyValueData);
+        if (!_isValid) {
+            qWarning() << "Failed to write the KTX header:" << _device.errorString();
+        }
+    }
+
+    ImageDescriptors StreamWriter::generateImageDescriptors(const Images& images) {
+        ImageDescriptors descriptors;
+        size_t imageOffset = 0;
+        for (const auto& image : images) {
+            ImageHeader header {
+                image._numFaces == NUM_CUBEMAPFACES,
+                imageOffset,
+                image._faceSize,
+                evalPadding(image._imageSize)
+            };
+            imageOffset += IMAGE_SIZE_WIDTH + header._imageSize + header._padding;
+            descriptors.push_back(ImageDescriptor(header, ImageHeader::FaceOffsets(header._numFaces, 0)));
+        }
+        return descriptors;
+    }
+
+    size_t StreamWriter::getStorageSize() const {
+        size_t storageSize = _imagesOffset;
+        for (const auto& descriptor : _descriptors) {
+            storageSize += IMAGE_SIZE_WIDTH + descriptor._imageSize + descriptor._padding;
+        }
+        return storageSize;
+    }
+
+    bool StreamWriter::writeMip(uint16_t level, const Image::FaceBytes& faceBytes, uint32_t faceSize) {
+        if (level >= _descriptors.size()) {
+            qWarning() << "KTX mip" << level << "is past the" << _descriptors.size() << "images of the stream";
+            return false;
+        }
+
+        // validate the mip before any of it is written
+        const auto& descriptor = _descriptors[level];
+        if (faceBytes.size() != descriptor._numFaces || faceSize != descriptor._faceSize) {
+            qWarning() << "KTX mip" << level << "has" << faceBytes.size() << "faces of" << faceSize << "bytes instead of"
+                << descriptor._numFaces << "of" << descriptor._faceSize;
+            return false;
+        }
+        for (const auto& face : faceBytes) {
+            if (!face) {
+                qWarning() << "KTX mip" << level << "is missing a face";
+                return false;
+            }
+        }
+        size_t offset = _imagesOffset + descriptor._imageOffset;
+        if (!checkAlignment(offset) || (descriptor._numFaces > 1 && !checkAlignment(faceSize))) {
+            qWarning() << "KTX mip" << level << "is not 4 byte aligned";
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_isValid || _isMipWritten[level]) {
+            return false;
+        }
+
+        // the imageSize written in the ktx is the FACE size
+        static const Byte PADDING[ALIGNMENT] { 0 };
+        bool success = writeAt(offset, &faceSize, IMAGE_SIZE_WIDTH);
+        offset += IMAGE_SIZE_WIDTH;
+        for (const auto& face : faceBytes) {
+            success = success && writeAt(offset, face, faceSize);
+            offset += faceSize;
+        }
+        success = success && writeAt(offset, PADDING, descriptor._padding);
+
+        if (!success) {
+            qWarning() << "Failed to write KTX mip" << level << ":" << _device.errorString();
+            _isValid = false;
+        }
+        _isMipWritten[level] = success;
+        return success;
+    }
+
+    bool StreamWriter::finish() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t level = 0; level < _isMipWritten.size(); level++) {
+            if (!_isMipWritten[level]) {
+                qWarning() << "KTX mip" << level << "was not written";
+                return false;
+            }
+        }
+        return _isValid;
+    }
+
+    bool StreamWriter::writeAt(size_t offset, const void* data, size_t size) {
+        if (size == 0) {
+            return true;
+        }
+        if (_device.pos() != (qint64)offset && !_device.seek((qint64)offset)) {
+            return false;
+        }
+        return _device.write(reinterpret_cast<const char*>(data), (qint64)size) == (qint64)size;
+    }
+
     void KTX::writeMipData(uint16_t level, const Byte* sourceBytes, size_t sourceSize) {
         Q_ASSERT(level > 0);
         Q_ASSERT(level < _images.size());
@@ -33,6 +33,7 @@
 
 #include <gl/GLHelpers.h>
 #include <gpu/Batch.h>
+#include <ktx/KTX2.h>
 
 #include <image/TextureProcessing.h>
 
@@ -496,6 +497,9 @@ public:
 private:
     static void listSupportedImageFormats();
 
+    // KTX2 files are uploaded as they are, or once the KTX2 transcoder turned them into a format the GPU can sample
+    std::pair<gpu::TexturePointer, glm::ivec2> readKTX2() const;
+
     QWeakPointer<Resource> _resource;
     QUrl _url;
     QByteArray _content;
@@ -1261,16 +1265,19 @@ void ImageReader::read() {
     {
         PROFILE_RANGE_EX(resource_parse_image_raw, __FUNCTION__, 0xffff0000, 0);
 
-        // IMPORTANT: _content is empty past this point
-        auto buffer = std::shared_ptr<QIODevice>((QIODevice*)new OwningBuffer(std::move(_content)));
-
 #ifdef USE_GLES
         constexpr bool shouldCompress = true;
 #else
         constexpr bool shouldCompress = false;
 #endif
         auto target = getBackendTarget();
-        textureAndSize = image::processImage(std::move(buffer), _url.toString().toStdString(), _sourceChannel, _maxNumPixels, networkTexture->getTextureType(), shouldCompress, target);
+        if (_content.size() >= (int)ktx::KTX2_HEADER_SIZE && ktx::KTX2::checkIdentifier(reinterpret_cast<const ktx::Byte*>(_content.constData()))) {
+            textureAndSize = readKTX2();
+        } else {
+            // IMPORTANT: _content is empty past this point
+            auto buffer = std::shared_ptr<QIODevice>((QIODevice*)new OwningBuffer(std::move(_content)));
+            textureAndSize = image::processImage(std::move(buffer), _url.toString().toStdString(), _sourceChannel, _maxNumPixels, networkTexture->getTextureType(), shouldCompress, target);
+        }
 
         if (!textureAndSize.first) {
             QMetaObject::invokeMethod(resource.data(), "setImage",
@@ -1286,14 +1293,17 @@ void ImageReader::read() {
 
     // Save the image into a KTXFile
     if (textureAndSize.first && textureCache) {
-        auto memKtx = gpu::Texture::serialize(*textureAndSize.first, textureAndSize.second);
+        ktx::Header header;
+        ktx::Images images;
+        ktx::KeyValues keyValues;
 
-        // Move the texture into a memory mapped file
-        if (memKtx) {
-            const char* data = reinterpret_cast<const char*>(memKtx->_storage->data());
-            size_t length = memKtx->_storage->size();
+        // Write the texture into a memory mapped file, straight from its mips
+        if (gpu::Texture::serialize(*textureAndSize.first, textureAndSize.second, header, images, keyValues)) {
+            size_t length = ktx::KTX::evalStorageSize(header, images, keyValues);
             auto& ktxCache = textureCache->_ktxCache;
-            auto file = ktxCache->writeFile(data, KTXCache::Metadata(hash, length));
+            auto file = ktxCache->writeFile([&](QIODevice& device) {
+                return ktx::KTX::write(device, header, images, keyValues);
+            }, KTXCache::Metadata(hash, length));
             if (file) {
                 textureAndSize.first->setKtxBacking(file);
             }
@@ -1311,6 +1321,30 @@ void ImageReader::read() {
                                 Q_ARG(int, textureAndSize.second.y));
 }
 
+std::pair<gpu::TexturePointer, glm::ivec2> ImageReader::readKTX2() const {
+    auto storage = std::make_shared<storage::MemoryStorage>(_content.size(), reinterpret_cast<const uint8_t*>(_content.constData()));
+    auto ktx2File = ktx::KTX2::create(storage);
+    std::unique_ptr<ktx::KTX> ktxFile;
+    if (ktx2File) {
+        ktxFile = ktx2File->toKTX();
+    }
+    if (!ktxFile) {
+        qCWarning(materialnetworking) << "Could not read KTX2" << _url;
+        return { nullptr, { 0, 0 } };
+    }
+
+    auto textureAndSize = gpu::Texture::build(ktxFile->toDescriptor());
+    auto& texture = textureAndSize.first;
+    if (texture) {
+        texture->setKtxBacking(ktxFile->getStorage());
+        texture->setSource(_url.toString().toStdString());
+        if (textureAndSize.second == glm::ivec2(0)) {
+            textureAndSize.second = glm::ivec2(texture->getWidth(), texture->getHeight());
+        }
+    }
+    return textureAndSize;
+}
+
 NetworkTexturePointer TextureCache::getResourceTexture(const QUrl& resourceTextureUrl) {
     gpu::TexturePointer texture;
     if (resourceTextureUrl == SPECTATOR_CAMERA_FRAME_URL) {
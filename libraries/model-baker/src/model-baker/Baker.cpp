@@ -13,6 +13,7 @@
 
 #include "BakerTypes.h"
 #include "ModelMath.h"
+#include "OptimizeMeshesTask.h"
 #include "BuildGraphicsMeshTask.h"
 #include "CalculateMeshNormalsTask.h"
 #include "CalculateMeshTangentsTask.h"
@@ -99,6 +100,98 @@ namespace baker {
         }
     };
 
+    // Calculates the normals and then the tangents of the meshes
+    class CalculateMeshAttributesTask {
+    public:
+        using Input = std::vector<hfm::Mesh>;
+        using Output = VaryingSet2<NormalsPerMesh, TangentsPerMesh>;
+        using JobModel = Task::ModelIO<CalculateMeshAttributesTask, Input, Output>;
+
+        void build(JobModel& model, const Varying& input, Varying& output) {
+            const auto normalsPerMesh = model.addJob<CalculateMeshNormalsTask>("CalculateMeshNormals", input);
+            const auto calculateMeshTangentsInputs = CalculateMeshTangentsTask::Input(normalsPerMesh, input).asVarying();
+            const auto tangentsPerMesh = model.addJob<CalculateMeshTangentsTask>("CalculateMeshTangents", calculateMeshTangentsInputs);
+            output = Output(normalsPerMesh, tangentsPerMesh);
+        }
+    };
+
+    // Calculates the normals and then the tangents of the blendshapes
+    class CalculateBlendshapeAttributesTask {
+    public:
+        using Input = VaryingSet2<BlendshapesPerMesh, std::vector<hfm::Mesh>>;
+        using Output = VaryingSet2<std::vector<NormalsPerBlendshape>, std::vector<TangentsPerBlendshape>>;
+        using JobModel = Task::ModelIO<CalculateBlendshapeAttributesTask, Input, Output>;
+
+        void build(JobModel& model, const Varying& input, Varying& output) {
+            const auto& blendshapesPerMeshIn = input.getN<Input>(0);
+            const auto& meshesIn = input.getN<Input>(1);
+
+            const auto normalsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeNormalsTask>("CalculateBlendshapeNormals", input);
+            const auto calculateBlendshapeTangentsInputs = CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMeshIn, meshesIn).asVarying();
+            const auto tangentsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeTangentsTask>("CalculateBlendshapeTangents", calculateBlendshapeTangentsInputs);
+            output = Output(normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh);
+        }
+    };
+
+    // The mesh and blendshape attributes don't depend on each other, so they are calculated in parallel
+    class CalculateAttributesTask {
+    public:
+        using Input = VaryingSet2<std::vector<hfm::Mesh>, BlendshapesPerMesh>;
+        using Output = VaryingSet4<NormalsPerMesh, TangentsPerMesh, std::vector<NormalsPerBlendshape>, std::vector<TangentsPerBlendshape>>;
+        using JobModel = Task::ParallelModelIO<CalculateAttributesTask, Input, Output>;
+
+        void build(JobModel& model, const Varying& input, Varying& output) {
+            const auto& meshesIn = input.getN<Input>(0);
+            const auto& blendshapesPerMeshIn = input.getN<Input>(1);
+
+            const auto meshAttributes = model.addJob<CalculateMeshAttributesTask>("CalculateMeshAttributes", meshesIn);
+            const auto calculateBlendshapeAttributesInputs = CalculateBlendshapeAttributesTask::Input(blendshapesPerMeshIn, meshesIn).asVarying();
+            const auto blendshapeAttributes = model.addJob<CalculateBlendshapeAttributesTask>("CalculateBlendshapeAttributes", calculateBlendshapeAttributesInputs);
+
+            output = Output(meshAttributes.getN<CalculateMeshAttributesTask::Output>(0), meshAttributes.getN<CalculateMeshAttributesTask::Output>(1),
+                blendshapeAttributes.getN<CalculateBlendshapeAttributesTask::Output>(0), blendshapeAttributes.getN<CalculateBlendshapeAttributesTask::Output>(1));
+        }
+    };
+
+    // The graphics meshes, draco meshes and blendshapes are built from the same attributes independently, so in parallel
+    class BuildMeshDataTask {
+    public:
+        using Input = VaryingSet8<std::vector<hfm::Mesh>, hifi::URL, MeshIndicesToModelNames, NormalsPerMesh, TangentsPerMesh, BlendshapesPerMesh, std::vector<NormalsPerBlendshape>, std::vector<TangentsPerBlendshape>>;
+        using Output = VaryingSet5<std::vector<graphics::MeshPointer>, std::vector<hifi::ByteArray>, std::vector<bool>, std::vector<std::vector<hifi::ByteArray>>, BlendshapesPerMesh>;
+        using JobModel = Task::ParallelModelIO<BuildMeshDataTask, Input, Output>;
+
+        void build(JobModel& model, const Varying& input, Varying& output) {
+            const auto& meshesIn = input.getN<Input>(0);
+            const auto& url = input.getN<Input>(1);
+            const auto& meshIndicesToModelNames = input.getN<Input>(2);
+            const auto& normalsPerMesh = input.getN<Input>(3);
+            const auto& tangentsPerMesh = input.getN<Input>(4);
+            const auto& blendshapesPerMeshIn = input.getN<Input>(5);
+            const auto& normalsPerBlendshapePerMesh = input.getN<Input>(6);
+            const auto& tangentsPerBlendshapePerMesh = input.getN<Input>(7);
+
+            // Build the graphics::MeshPointer for each hfm::Mesh
+            const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh).asVarying();
+            const auto graphicsMeshes = model.addJob<BuildGraphicsMeshTask>("BuildGraphicsMesh", buildGraphicsMeshInputs);
+
+            // Build Draco meshes
+            // NOTE: This task is disabled by default and must be enabled through configuration
+            // TODO: Tangent support (Needs changes to FBXSerializer_Mesh as well)
+            // NOTE: Due to an unresolved linker error, BuildDracoMeshTask is not functional on Android
+            // TODO: Figure out why BuildDracoMeshTask.cpp won't link with draco on Android
+            const auto buildDracoMeshInputs = BuildDracoMeshTask::Input(meshesIn, normalsPerMesh, tangentsPerMesh).asVarying();
+            const auto buildDracoMeshOutputs = model.addJob<BuildDracoMeshTask>("BuildDracoMesh", buildDracoMeshInputs);
+            const auto dracoMeshes = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(0);
+            const auto dracoErrors = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(1);
+            const auto materialList = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(2);
+
+            const auto buildBlendshapesInputs = BuildBlendshapesTask::Input(blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh).asVarying();
+            const auto blendshapesPerMeshOut = model.addJob<BuildBlendshapesTask>("BuildBlendshapes", buildBlendshapesInputs);
+
+            output = Output(graphicsMeshes, dracoMeshes, dracoErrors, materialList, blendshapesPerMeshOut);
+        }
+    };
+
     class BuildModelTask {
     public:
         using Input = VaryingSet6<hfm::Model::Pointer, std::vector<hfm::Mesh>, std::vector<hfm::Joint>, QMap<int, glm::quat>, QHash<QString, int>, FlowData>;
@@ -129,25 +222,36 @@ namespace baker {
 
             // Split up the inputs from hfm::Model
             const auto modelPartsIn = model.addJob<GetModelPartsTask>("GetModelParts", hfmModelIn);
-            const auto meshesIn = modelPartsIn.getN<GetModelPartsTask::Output>(0);
+            const auto parsedMeshes = modelPartsIn.getN<GetModelPartsTask::Output>(0);
             const auto url = modelPartsIn.getN<GetModelPartsTask::Output>(1);
             const auto meshIndicesToModelNames = modelPartsIn.getN<GetModelPartsTask::Output>(2);
-            const auto blendshapesPerMeshIn = modelPartsIn.getN<GetModelPartsTask::Output>(3);
+            const auto parsedBlendshapesPerMesh = modelPartsIn.getN<GetModelPartsTask::Output>(3);
             const auto jointsIn = modelPartsIn.getN<GetModelPartsTask::Output>(4);
 
+            // Reorder the triangles and vertices of the meshes for the GPU, everything after is built from that order
+            const auto optimizeMeshesInputs = OptimizeMeshesTask::Input(parsedMeshes, parsedBlendshapesPerMesh).asVarying();
+            const auto optimizedMeshes = model.addJob<OptimizeMeshesTask>("OptimizeMeshes", optimizeMeshesInputs);
+            const auto meshesIn = optimizedMeshes.getN<OptimizeMeshesTask::Output>(0);
+            const auto blendshapesPerMeshIn = optimizedMeshes.getN<OptimizeMeshesTask::Output>(1);
+
             // Calculate normals and tangents for meshes and blendshapes if they do not exist
             // Note: Normals are never calculated here for OBJ models. OBJ files optionally define normals on a per-face basis, so for consistency normals are calculated beforehand in OBJSerializer.
-            const auto normalsPerMesh = model.addJob<CalculateMeshNormalsTask>("CalculateMeshNormals", meshesIn);
-            const auto calculateMeshTangentsInputs = CalculateMeshTangentsTask::Input(normalsPerMesh, meshesIn).asVarying();
-            const auto tangentsPerMesh = model.addJob<CalculateMeshTangentsTask>("CalculateMeshTangents", calculateMeshTangentsInputs);
-            const auto calculateBlendshapeNormalsInputs = CalculateBlendshapeNormalsTask::Input(blendshapesPerMeshIn, meshesIn).asVarying();
-            const auto normalsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeNormalsTask>("CalculateBlendshapeNormals", calculateBlendshapeNormalsInputs);
-            const auto calculateBlendshapeTangentsInputs = CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMeshIn, meshesIn).asVarying();
-            const auto tangentsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeTangentsTask>("CalculateBlendshapeTangents", calculateBlendshapeTangentsInputs);
+            const auto calculateAttributesInputs = CalculateAttributesTask::Input(meshesIn, blendshapesPerMeshIn).asVarying();
+            const auto attributes = model.addJob<CalculateAttributesTask>("CalculateAttributes", calculateAttributesInputs);
+            const auto normalsPerMesh = attributes.getN<CalculateAttributesTask::Output>(0);
+            const auto tangentsPerMesh = attributes.getN<CalculateAttributesTask::Output>(1);
+            const auto normalsPerBlendshapePerMesh = attributes.getN<CalculateAttributesTask::Output>(2);
+            const auto tangentsPerBlendshapePerMesh = attributes.getN<CalculateAttributesTask::Output>(3);
 
-            // Build the graphics::MeshPointer for each hfm::Mesh
-            const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh).asVarying();
-            const auto graphicsMeshes = model.addJob<BuildGraphicsMeshTask>("BuildGraphicsMesh", buildGraphicsMeshInputs);
+            // Build the graphics meshes, draco meshes and blendshapes
+            const auto buildMeshDataInputs = BuildMeshDataTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh,
+                blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh).asVarying();
+            const auto meshData = model.addJob<BuildMeshDataTask>("BuildMeshData", buildMeshDataInputs);
+            const auto graphicsMeshes = meshData.getN<BuildMeshDataTask::Output>(0);
+            const auto dracoMeshes = meshData.getN<BuildMeshDataTask::Output>(1);
+            const auto dracoErrors = meshData.getN<BuildMeshDataTask::Output>(2);
+            const auto materialList = meshData.getN<BuildMeshDataTask::Output>(3);
+            const auto blendshapesPerMeshOut = meshData.getN<BuildMeshDataTask::Output>(4);
 
             // Prepare joint information
             const auto prepareJointsInputs = PrepareJointsTask::Input(jointsIn, mapping).asVarying();
@@ -160,23 +264,10 @@ namespace baker {
             const auto parseMaterialMappingInputs = ParseMaterialMappingTask::Input(mapping, materialMappingBaseURL).asVarying();
             const auto materialMapping = model.addJob<ParseMaterialMappingTask>("ParseMaterialMapping", parseMaterialMappingInputs);
 
-            // Build Draco meshes
-            // NOTE: This task is disabled by default and must be enabled through configuration
-            // TODO: Tangent support (Needs changes to FBXSerializer_Mesh as well)
-            // NOTE: Due to an unresolved linker error, BuildDracoMeshTask is not functional on Android
-            // TODO: Figure out why BuildDracoMeshTask.cpp won't link with draco on Android
-            const auto buildDracoMeshInputs = BuildDracoMeshTask::Input(meshesIn, normalsPerMesh, tangentsPerMesh).asVarying();
-            const auto buildDracoMeshOutputs = model.addJob<BuildDracoMeshTask>("BuildDracoMesh", buildDracoMeshInputs);
-            const auto dracoMeshes = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(0);
-            const auto dracoErrors = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(1);
-            const auto materialList = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(2);
-
             // Parse flow data
             const auto flowData = model.addJob<ParseFlowDataTask>("ParseFlowData", mapping);
 
             // Combine the outputs into a new hfm::Model
-            const auto buildBlendshapesInputs = BuildBlendshapesTask::Input(blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh).asVarying();
-            const auto blendshapesPerMeshOut = model.addJob<BuildBlendshapesTask>("BuildBlendshapes", buildBlendshapesInputs);
             const auto buildMeshesInputs = BuildMeshesTask::Input(meshesIn, graphicsMeshes, normalsPerMesh, tangentsPerMesh, blendshapesPerMeshOut).asVarying();
             const auto meshesOut = model.addJob<BuildMeshesTask>("BuildMeshes", buildMeshesInputs);
             const auto buildModelInputs = BuildModelTask::Input(hfmModelIn, meshesOut, jointsOut, jointRotationOffsets, jointIndices, flowData).asVarying();
@@ -191,6 +282,15 @@ namespace baker {
         _engine->feedInput<BakerEngineBuilder::Input>(0, hfmModel);
         _engine->feedInput<BakerEngineBuilder::Input>(1, mapping);
         _engine->feedInput<BakerEngineBuilder::Input>(2, materialMappingBaseURL);
+
+        // The independent branches of the graph run concurrently
+        auto config = _engine->getConfiguration();
+        for (const auto& parallelTask : { "CalculateAttributes", "BuildMeshData" }) {
+            auto parallelConfig = dynamic_cast<ParallelConfig*>(config->getJobConfig(parallelTask));
+            if (parallelConfig) {
+                parallelConfig->parallel = true;
+            }
+        }
     }
 
     std::shared_ptr<TaskConfig> Baker::getConfiguration() {
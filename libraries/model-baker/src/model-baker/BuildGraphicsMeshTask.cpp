@@ -14,6 +14,10 @@
 #include <glm/gtc/packing.hpp>
 
 #include <LogHandler.h>
+#include <TBBHelpers.h>
+
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -27,6 +31,63 @@ glm::vec3 normalizeDirForPacking(const glm::vec3& dir) {
     return dir;
 }
 
+// the meshes below this are cheap enough to draw in full at any distance
+static const size_t MIN_LOD_TRIANGLES = 4096;
+static const int MAX_LODS = 3;
+// each LOD has about half the triangles of the previous one, it isn't kept when the simplification gets stuck well above that
+static const float LOD_REDUCTION = 0.5f;
+static const float MIN_LOD_REDUCTION = 0.75f;
+
+static void buildGraphicsMeshLODs(const hfm::Mesh& hfmMesh, graphics::Mesh& graphicsMesh) {
+    std::vector<glm::vec3> positions(hfmMesh.vertices.cbegin(), hfmMesh.vertices.cend());
+
+    size_t numTriangles = 0;
+    std::vector<baker::MeshSimplifier> simplifiers;
+    simplifiers.reserve(hfmMesh.parts.size());
+    for (const auto& part : hfmMesh.parts) {
+        std::vector<uint32_t> indices;
+        indices.reserve(part.quadTrianglesIndices.size() + part.triangleIndices.size());
+        indices.insert(indices.end(), part.quadTrianglesIndices.cbegin(), part.quadTrianglesIndices.cend());
+        indices.insert(indices.end(), part.triangleIndices.cbegin(), part.triangleIndices.cend());
+        numTriangles += indices.size() / 3;
+        simplifiers.emplace_back(positions, indices);
+    }
+    if (numTriangles < MIN_LOD_TRIANGLES) {
+        return;
+    }
+
+    std::vector<uint32_t> lodIndices;
+    graphics::Mesh::LODs lods;
+    size_t previousNumIndices = numTriangles * 3;
+    for (int level = 0; level < MAX_LODS; ++level) {
+        graphics::Mesh::LOD lod;
+        size_t levelStart = lodIndices.size();
+        size_t numIndices = 0;
+        for (auto& simplifier : simplifiers) {
+            // the collapses leave the triangles in the order of the full mesh, with holes in its vertex cache runs
+            auto indices = simplifier.simplify((size_t)(simplifier.getIndices().size() * LOD_REDUCTION));
+            baker::optimizeVertexCache(indices, positions.size());
+            lod._parts.emplace_back((graphics::Index)lodIndices.size(), (graphics::Index)indices.size(), 0, graphics::Mesh::TRIANGLES);
+            lodIndices.insert(lodIndices.end(), indices.cbegin(), indices.cend());
+            lod._error = std::max(lod._error, simplifier.getError());
+            numIndices += indices.size();
+        }
+        if (numIndices > previousNumIndices * MIN_LOD_REDUCTION) {
+            lodIndices.resize(levelStart);
+            break;
+        }
+        lods.push_back(lod);
+        previousNumIndices = numIndices;
+    }
+    if (lods.empty()) {
+        return;
+    }
+
+    auto lodIndexBuffer = std::make_shared<gpu::Buffer>();
+    lodIndexBuffer->setData(lodIndices.size() * sizeof(uint32_t), (const gpu::Byte*) lodIndices.data());
+    graphicsMesh.setLODs(gpu::BufferView(lodIndexBuffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ)), lods);
+}
+
 void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphicsMeshPointer, const baker::MeshNormals& meshNormals, const baker::MeshTangents& meshTangentsIn) {
     auto graphicsMesh = std::make_shared<graphics::Mesh>();
 
@@ -368,6 +429,8 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
 
     graphicsMesh->evalPartBound(0);
 
+    buildGraphicsMeshLODs(hfmMesh, *graphicsMesh);
+
     graphicsMeshPointer = graphicsMesh;
 }
 
@@ -380,9 +443,10 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
 
     auto& graphicsMeshes = output;
 
+    // the meshes are independent of each other
     int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
+    graphicsMeshes.resize(n);
+    tbb::parallel_for(0, n, [&](int i) {
         auto& graphicsMesh = graphicsMeshes[i];
         
         // Try to create the graphics::Mesh
@@ -395,5 +459,5 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
                 graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
             }
         }
-    }
+    });
 }
@@ -11,6 +11,8 @@
 
 #include "CalculateBlendshapeNormalsTask.h"
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -18,20 +20,22 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
     const auto& meshes = input.get1();
     auto& normalsPerBlendshapePerMeshOut = output;
 
-    normalsPerBlendshapePerMeshOut.reserve(blendshapesPerMesh.size());
+    // each blendshape of each mesh is independent of the others
+    normalsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
     for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+        normalsPerBlendshapePerMeshOut[i].resize(blendshapesPerMesh[i].size());
+    }
+    tbb::parallel_for((size_t)0, blendshapesPerMesh.size(), [&](size_t i) {
         const auto& mesh = meshes[i];
         const auto& blendshapes = blendshapesPerMesh[i];
-        normalsPerBlendshapePerMeshOut.emplace_back();
-        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[normalsPerBlendshapePerMeshOut.size()-1];
+        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[i];
 
-        normalsPerBlendshapeOut.reserve(blendshapes.size());
-        for (size_t j = 0; j < blendshapes.size(); j++) {
+        tbb::parallel_for((size_t)0, blendshapes.size(), [&](size_t j) {
             const auto& blendshape = blendshapes[j];
             const auto& normalsIn = blendshape.normals;
             // Check if normals are already defined. Otherwise, calculate them from existing blendshape vertices.
             if (!normalsIn.empty()) {
-                normalsPerBlendshapeOut.push_back(normalsIn.toStdVector());
+                normalsPerBlendshapeOut[j] = normalsIn.toStdVector();
             } else {
                 // Create lookup to get index in blendshape from vertex index in mesh
                 std::vector<int> reverseIndices;
@@ -42,8 +46,7 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                     reverseIndices[indexInMesh] = indexInBlendShape;
                 }
 
-                normalsPerBlendshapeOut.emplace_back();
-                auto& normals = normalsPerBlendshapeOut[normalsPerBlendshapeOut.size()-1];
+                auto& normals = normalsPerBlendshapeOut[j];
                 normals.resize(mesh.vertices.size());
                 baker::calculateNormals(mesh,
                     [&reverseIndices, &blendshape, &normals](int normalIndex) /* NormalAccessor */ {
@@ -65,6 +68,6 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                         }
                     });
             }
-        }
-    }
+        });
+    });
 }
@@ -18,7 +18,8 @@ namespace baker {
 
     class BakeContext : public task::JobContext {
     public:
-        // No context settings yet for model prep
+        // No context settings yet for model prep, so a fork is just another context
+        task::JobContextPointer fork() override { return std::make_shared<BakeContext>(); }
     };
     using BakeContextPointer = std::shared_ptr<BakeContext>;
 
@@ -0,0 +1,333 @@
+//
+//  MeshOptimizer.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static const int VERTICES_PER_TRIANGLE = 3;
+
+// the scoring of Forsyth's paper, for a cache of 32 vertices which is about what the post-transform caches hold
+static const int VERTEX_CACHE_SIZE = 32;
+static const float CACHE_DECAY_POWER = 1.5f;
+static const float LAST_TRIANGLE_SCORE = 0.75f;
+static const float VALENCE_BOOST_SCALE = 2.0f;
+static const float VALENCE_BOOST_POWER = 0.5f;
+
+// the clusters of optimizeOverdraw are cut on the misses of a smaller FIFO cache, as the paper does
+static const int CLUSTER_CACHE_SIZE = 16;
+
+static float vertexScore(int cachePosition, uint32_t remainingTriangles) {
+    if (remainingTriangles == 0) {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < VERTICES_PER_TRIANGLE) {
+            // the vertices of the last triangle get a fixed score, so that the next one doesn't just reuse its edge
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            float scale = 1.0f / (VERTEX_CACHE_SIZE - VERTICES_PER_TRIANGLE);
+            score = powf(1.0f - (cachePosition - VERTICES_PER_TRIANGLE) * scale, CACHE_DECAY_POWER);
+        }
+    }
+    // the vertices with few triangles left go first, so that they don't strand them
+    score += VALENCE_BOOST_SCALE * powf((float)remainingTriangles, -VALENCE_BOOST_POWER);
+    return score;
+}
+
+static bool hasValidIndices(const std::vector<uint32_t>& indices, size_t numVertices) {
+    return std::all_of(indices.cbegin(), indices.cend(), [numVertices](uint32_t index) {
+        return index < numVertices;
+    });
+}
+
+void baker::optimizeVertexCache(std::vector<uint32_t>& indices, size_t numVertices) {
+    size_t numTriangles = indices.size() / VERTICES_PER_TRIANGLE;
+    if (numTriangles < 2 || !hasValidIndices(indices, numVertices)) {
+        return;
+    }
+
+    // the triangles around each vertex, those not emitted yet first
+    std::vector<uint32_t> triangleOffsets(numVertices + 1, 0);
+    for (size_t i = 0; i < numTriangles * VERTICES_PER_TRIANGLE; ++i) {
+        ++triangleOffsets[indices[i] + 1];
+    }
+    for (size_t i = 1; i < triangleOffsets.size(); ++i) {
+        triangleOffsets[i] += triangleOffsets[i - 1];
+    }
+    std::vector<uint32_t> vertexTriangles(numTriangles * VERTICES_PER_TRIANGLE);
+    std::vector<uint32_t> remainingTriangles(numVertices);
+    {
+        std::vector<uint32_t> written(triangleOffsets.begin(), triangleOffsets.end() - 1);
+        for (size_t i = 0; i < numTriangles * VERTICES_PER_TRIANGLE; ++i) {
+            vertexTriangles[written[indices[i]]++] = (uint32_t)(i / VERTICES_PER_TRIANGLE);
+        }
+    }
+    for (size_t i = 0; i < numVertices; ++i) {
+        remainingTriangles[i] = triangleOffsets[i + 1] - triangleOffsets[i];
+    }
+
+    std::vector<int> cachePositions(numVertices, -1);
+    std::vector<float> vertexScores(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        vertexScores[i] = vertexScore(-1, remainingTriangles[i]);
+    }
+    std::vector<float> triangleScores(numTriangles);
+    for (size_t i = 0; i < numTriangles; ++i) {
+        const uint32_t* triangle = &indices[i * VERTICES_PER_TRIANGLE];
+        triangleScores[i] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(numTriangles * VERTICES_PER_TRIANGLE);
+    std::vector<bool> isEmitted(numTriangles, false);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(VERTEX_CACHE_SIZE + VERTICES_PER_TRIANGLE);
+    newCache.reserve(VERTEX_CACHE_SIZE + VERTICES_PER_TRIANGLE);
+
+    size_t nextTriangle = 0;
+    int64_t bestTriangle = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+    while (bestTriangle >= 0) {
+        isEmitted[bestTriangle] = true;
+        const uint32_t* triangle = &indices[bestTriangle * VERTICES_PER_TRIANGLE];
+
+        newCache.clear();
+        for (int i = 0; i < VERTICES_PER_TRIANGLE; ++i) {
+            uint32_t vertex = triangle[i];
+            result.push_back(vertex);
+            newCache.push_back(vertex);
+
+            // move the triangle past the ones left
+            uint32_t* begin = &vertexTriangles[triangleOffsets[vertex]];
+            uint32_t* end = begin + remainingTriangles[vertex];
+            uint32_t* found = std::find(begin, end, (uint32_t)bestTriangle);
+            if (found != end) {
+                std::swap(*found, *(end - 1));
+                --remainingTriangles[vertex];
+            }
+        }
+        for (auto vertex : cache) {
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2]) {
+                newCache.push_back(vertex);
+            }
+        }
+
+        // the vertices that fell out of the cache lose their cache score, those in it get their new position
+        for (auto vertex : cache) {
+            cachePositions[vertex] = -1;
+        }
+        int cacheSize = std::min((int)newCache.size(), VERTEX_CACHE_SIZE);
+        for (int i = 0; i < cacheSize; ++i) {
+            cachePositions[newCache[i]] = i;
+        }
+        for (auto list : { &cache, &newCache }) {
+            for (auto vertex : *list) {
+                vertexScores[vertex] = vertexScore(cachePositions[vertex], remainingTriangles[vertex]);
+            }
+        }
+        newCache.resize(cacheSize);
+        std::swap(cache, newCache);
+
+        // the next triangle is the best one around the cache
+        bestTriangle = -1;
+        float bestScore = -std::numeric_limits<float>::max();
+        for (auto list : { &newCache, &cache }) {
+            for (auto vertex : *list) {
+                for (uint32_t i = 0; i < remainingTriangles[vertex]; ++i) {
+                    uint32_t candidate = vertexTriangles[triangleOffsets[vertex] + i];
+                    const uint32_t* candidateTriangle = &indices[candidate * VERTICES_PER_TRIANGLE];
+                    float score = vertexScores[candidateTriangle[0]] + vertexScores[candidateTriangle[1]] +
+                        vertexScores[candidateTriangle[2]];
+                    triangleScores[candidate] = score;
+                    if (list == &cache && score > bestScore) {
+                        bestScore = score;
+                        bestTriangle = candidate;
+                    }
+                }
+            }
+        }
+
+        // or none are left there, and it goes on with the first one left
+        if (bestTriangle < 0) {
+            while (nextTriangle < numTriangles && isEmitted[nextTriangle]) {
+                ++nextTriangle;
+            }
+            if (nextTriangle < numTriangles) {
+                bestTriangle = nextTriangle;
+            }
+        }
+    }
+
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+float baker::computeACMR(const std::vector<uint32_t>& indices, size_t numVertices, int cacheSize) {
+    size_t numTriangles = indices.size() / VERTICES_PER_TRIANGLE;
+    if (numTriangles == 0 || !hasValidIndices(indices, numVertices)) {
+        return 0.0f;
+    }
+
+    // a vertex is in the FIFO cache while fewer than cacheSize misses happened since its own
+    std::vector<uint32_t> missTimes(numVertices, 0);
+    uint32_t time = cacheSize + 1;
+    size_t misses = 0;
+    for (size_t i = 0; i < numTriangles * VERTICES_PER_TRIANGLE; ++i) {
+        if (time - missTimes[indices[i]] > (uint32_t)cacheSize) {
+            missTimes[indices[i]] = time++;
+            ++misses;
+        }
+    }
+    return (float)misses / numTriangles;
+}
+
+void baker::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold) {
+    size_t numTriangles = indices.size() / VERTICES_PER_TRIANGLE;
+    size_t numVertices = positions.size();
+    if (numTriangles < 2 || !hasValidIndices(indices, numVertices)) {
+        return;
+    }
+
+    std::vector<uint32_t> missTimes(numVertices, 0);
+    uint32_t time = CLUSTER_CACHE_SIZE + 1;
+    auto countMisses = [&](size_t triangle) {
+        int misses = 0;
+        for (int i = 0; i < VERTICES_PER_TRIANGLE; ++i) {
+            uint32_t vertex = indices[triangle * VERTICES_PER_TRIANGLE + i];
+            if (time - missTimes[vertex] > (uint32_t)CLUSTER_CACHE_SIZE) {
+                missTimes[vertex] = time++;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+    auto flushCache = [&]() {
+        time += CLUSTER_CACHE_SIZE + 1;
+    };
+
+    // the hard boundaries are where the cache is cold anyway, all the vertices of the triangle miss
+    std::vector<size_t> hardClusters;
+    for (size_t i = 0; i < numTriangles; ++i) {
+        if (countMisses(i) == VERTICES_PER_TRIANGLE) {
+            hardClusters.push_back(i);
+        }
+    }
+    if (hardClusters.empty() || hardClusters.front() != 0) {
+        hardClusters.insert(hardClusters.begin(), 0);
+    }
+    hardClusters.push_back(numTriangles);
+
+    // the soft ones cut a hard cluster where its misses so far are about as good as those of the whole cluster
+    std::vector<size_t> clusters;
+    for (size_t i = 0; i + 1 < hardClusters.size(); ++i) {
+        size_t start = hardClusters[i];
+        size_t end = hardClusters[i + 1];
+
+        flushCache();
+        size_t clusterMisses = 0;
+        for (size_t j = start; j < end; ++j) {
+            clusterMisses += countMisses(j);
+        }
+        float clusterACMR = (float)clusterMisses / (end - start);
+
+        flushCache();
+        clusters.push_back(start);
+        size_t misses = 0;
+        size_t softStart = start;
+        for (size_t j = start; j < end; ++j) {
+            misses += countMisses(j);
+            if (j + 1 < end && (float)misses / (j + 1 - softStart) <= clusterACMR * threshold) {
+                clusters.push_back(j + 1);
+                softStart = j + 1;
+                misses = 0;
+                flushCache();
+            }
+        }
+    }
+    clusters.push_back(numTriangles);
+
+    // the clusters facing away from the center of the mesh are drawn first, they are the likeliest to hide the others
+    struct Cluster {
+        size_t start;
+        size_t end;
+        float sortKey;
+    };
+    std::vector<Cluster> sortedClusters;
+    sortedClusters.reserve(clusters.size() - 1);
+
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    std::vector<glm::vec3> clusterCentroids(clusters.size() - 1, glm::vec3(0.0f));
+    std::vector<glm::vec3> clusterNormals(clusters.size() - 1, glm::vec3(0.0f));
+    for (size_t i = 0; i + 1 < clusters.size(); ++i) {
+        float clusterArea = 0.0f;
+        for (size_t j = clusters[i]; j < clusters[i + 1]; ++j) {
+            const glm::vec3& p0 = positions[indices[j * VERTICES_PER_TRIANGLE]];
+            const glm::vec3& p1 = positions[indices[j * VERTICES_PER_TRIANGLE + 1]];
+            const glm::vec3& p2 = positions[indices[j * VERTICES_PER_TRIANGLE + 2]];
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(normal);
+            glm::vec3 centroid = (p0 + p1 + p2) / 3.0f;
+            clusterCentroids[i] += centroid * area;
+            clusterNormals[i] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += clusterCentroids[i];
+        meshArea += clusterArea;
+        if (clusterArea > 0.0f) {
+            clusterCentroids[i] /= clusterArea;
+        }
+        float normalLength = glm::length(clusterNormals[i]);
+        if (normalLength > 0.0f) {
+            clusterNormals[i] /= normalLength;
+        }
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+    for (size_t i = 0; i + 1 < clusters.size(); ++i) {
+        sortedClusters.push_back({ clusters[i], clusters[i + 1], glm::dot(clusterCentroids[i] - meshCentroid, clusterNormals[i]) });
+    }
+    std::stable_sort(sortedClusters.begin(), sortedClusters.end(), [](const Cluster& a, const Cluster& b) {
+        return a.sortKey > b.sortKey;
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(numTriangles * VERTICES_PER_TRIANGLE);
+    for (const auto& cluster : sortedClusters) {
+        result.insert(result.end(), indices.begin() + cluster.start * VERTICES_PER_TRIANGLE,
+                      indices.begin() + cluster.end * VERTICES_PER_TRIANGLE);
+    }
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+std::vector<uint32_t> baker::buildVertexFetchRemap(const std::vector<const std::vector<uint32_t>*>& indexLists, size_t numVertices) {
+    const uint32_t UNUSED = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(numVertices, UNUSED);
+    uint32_t nextVertex = 0;
+    for (auto indices : indexLists) {
+        for (auto index : *indices) {
+            if (index < numVertices && remap[index] == UNUSED) {
+                remap[index] = nextVertex++;
+            }
+        }
+    }
+    for (auto& vertex : remap) {
+        if (vertex == UNUSED) {
+            vertex = nextVertex++;
+        }
+    }
+    return remap;
+}
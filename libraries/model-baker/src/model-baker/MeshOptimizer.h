@@ -0,0 +1,44 @@
+//
+//  MeshOptimizer.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_MeshOptimizer_h
+#define hifi_MeshOptimizer_h
+
+#include <vector>
+#include <stdint.h>
+
+#include <glm/glm.hpp>
+
+namespace baker {
+
+    // The orderings of a triangle list that make it cheaper to draw, without changing what is drawn.
+
+    // Reorders the triangles so that they reuse the vertices recently transformed by the GPU, after Forsyth's linear-speed
+    // vertex cache optimisation. numVertices is one past the largest index.
+    void optimizeVertexCache(std::vector<uint32_t>& indices, size_t numVertices);
+
+    // Reorders clusters of the triangles ordered by optimizeVertexCache so that the ones facing outwards come first and
+    // hide the others, after Sander et al.'s "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw". The
+    // clusters are cut where they would make the vertex cache misses more than threshold times worse.
+    void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold);
+
+    // The new index of each vertex, in the order the triangles first use them, so that fetching them reads the vertex
+    // buffer forwards. The vertices that aren't used go last, in their order.
+    std::vector<uint32_t> buildVertexFetchRemap(const std::vector<const std::vector<uint32_t>*>& indexLists, size_t numVertices);
+
+    // the number of vertex cache misses per triangle with a FIFO cache of cacheSize, between 0.5 and 3
+    float computeACMR(const std::vector<uint32_t>& indices, size_t numVertices, int cacheSize);
+
+};
+
+#endif // hifi_MeshOptimizer_h
@@ -0,0 +1,297 @@
+//
+//  MeshSimplifier.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+using namespace baker;
+
+static const int VERTICES_PER_TRIANGLE = 3;
+
+// a collapse can't turn the normal of a triangle by more than about 80 degrees
+static const double MIN_NORMAL_COSINE = 0.2;
+
+static uint64_t edgeKey(uint32_t a, uint32_t b) {
+    return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+}
+
+void MeshSimplifier::Quadric::addPlane(const glm::dvec3& normal, double distance) {
+    a2 += normal.x * normal.x;
+    ab += normal.x * normal.y;
+    ac += normal.x * normal.z;
+    ad += normal.x * distance;
+    b2 += normal.y * normal.y;
+    bc += normal.y * normal.z;
+    bd += normal.y * distance;
+    c2 += normal.z * normal.z;
+    cd += normal.z * distance;
+    d2 += distance * distance;
+}
+
+void MeshSimplifier::Quadric::add(const Quadric& other) {
+    a2 += other.a2;
+    ab += other.ab;
+    ac += other.ac;
+    ad += other.ad;
+    b2 += other.b2;
+    bc += other.bc;
+    bd += other.bd;
+    c2 += other.c2;
+    cd += other.cd;
+    d2 += other.d2;
+}
+
+double MeshSimplifier::Quadric::evaluate(const glm::dvec3& point) const {
+    const double x = point.x;
+    const double y = point.y;
+    const double z = point.z;
+    double result = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+        b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+        c2 * z * z + 2.0 * cd * z + d2;
+    // rounding can take it slightly below zero
+    return std::max(result, 0.0);
+}
+
+MeshSimplifier::MeshSimplifier(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+    // number the vertices of the part from 0, the vertices out of range stay where they are
+    std::unordered_map<uint32_t, uint32_t> localVertices;
+    std::vector<bool> isOutOfRange;
+    size_t numIndices = indices.size() - indices.size() % VERTICES_PER_TRIANGLE;
+    _localIndices.reserve(numIndices);
+    for (size_t i = 0; i < numIndices; i += VERTICES_PER_TRIANGLE) {
+        if (indices[i] == indices[i + 1] || indices[i + 1] == indices[i + 2] || indices[i] == indices[i + 2]) {
+            continue;
+        }
+        for (int j = 0; j < VERTICES_PER_TRIANGLE; ++j) {
+            uint32_t index = indices[i + j];
+            auto inserted = localVertices.emplace(index, (uint32_t)_vertices.size());
+            if (inserted.second) {
+                bool isInRange = index < positions.size();
+                _vertices.push_back(index);
+                _positions.push_back(isInRange ? glm::dvec3(positions[index]) : glm::dvec3(0.0));
+                isOutOfRange.push_back(!isInRange);
+            }
+            _localIndices.push_back(inserted.first->second);
+        }
+    }
+
+    // the planes of the triangles around each vertex
+    _quadrics.resize(_vertices.size());
+    for (size_t i = 0; i < _localIndices.size(); i += VERTICES_PER_TRIANGLE) {
+        const glm::dvec3& p0 = _positions[_localIndices[i]];
+        const glm::dvec3& p1 = _positions[_localIndices[i + 1]];
+        const glm::dvec3& p2 = _positions[_localIndices[i + 2]];
+        glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+        double length = glm::length(normal);
+        if (length > 0.0) {
+            normal /= length;
+            double distance = -glm::dot(normal, p0);
+            for (int j = 0; j < VERTICES_PER_TRIANGLE; ++j) {
+                _quadrics[_localIndices[i + j]].addPlane(normal, distance);
+            }
+        }
+    }
+
+    // the edges of only one triangle are open, those of more than two are not manifold, their vertices are locked
+    std::vector<uint64_t> edges;
+    edges.reserve(_localIndices.size());
+    for (size_t i = 0; i < _localIndices.size(); i += VERTICES_PER_TRIANGLE) {
+        for (int j = 0; j < VERTICES_PER_TRIANGLE; ++j) {
+            edges.push_back(edgeKey(_localIndices[i + j], _localIndices[i + (j + 1) % VERTICES_PER_TRIANGLE]));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    _isLocked = isOutOfRange;
+    for (size_t i = 0; i < edges.size();) {
+        size_t end = i + 1;
+        while (end < edges.size() && edges[end] == edges[i]) {
+            ++end;
+        }
+        if (end - i != 2) {
+            _isLocked[(uint32_t)(edges[i] >> 32)] = true;
+            _isLocked[(uint32_t)edges[i]] = true;
+        }
+        i = end;
+    }
+
+    _indices.reserve(_localIndices.size());
+    for (auto index : _localIndices) {
+        _indices.push_back(_vertices[index]);
+    }
+}
+
+const std::vector<uint32_t>& MeshSimplifier::simplify(size_t targetIndexCount) {
+    size_t targetTriangles = targetIndexCount / VERTICES_PER_TRIANGLE;
+    size_t numTriangles = _localIndices.size() / VERTICES_PER_TRIANGLE;
+    if (numTriangles <= targetTriangles) {
+        return _indices;
+    }
+
+    while (numTriangles > targetTriangles) {
+        size_t removed = collapsePass(numTriangles - targetTriangles);
+        if (removed == 0) {
+            break;
+        }
+        numTriangles = _localIndices.size() / VERTICES_PER_TRIANGLE;
+    }
+
+    _indices.clear();
+    for (auto index : _localIndices) {
+        _indices.push_back(_vertices[index]);
+    }
+    _error = (float)sqrt(_maxCost);
+    return _indices;
+}
+
+void MeshSimplifier::buildAdjacency() {
+    _triangleOffsets.assign(_vertices.size() + 1, 0);
+    for (auto index : _localIndices) {
+        ++_triangleOffsets[index + 1];
+    }
+    for (size_t i = 1; i < _triangleOffsets.size(); ++i) {
+        _triangleOffsets[i] += _triangleOffsets[i - 1];
+    }
+
+    _vertexTriangles.resize(_localIndices.size());
+    std::vector<uint32_t> written(_triangleOffsets.begin(), _triangleOffsets.end() - 1);
+    for (size_t i = 0; i < _localIndices.size(); ++i) {
+        _vertexTriangles[written[_localIndices[i]]++] = (uint32_t)(i / VERTICES_PER_TRIANGLE);
+    }
+}
+
+bool MeshSimplifier::flipsTriangle(uint32_t from, uint32_t to) const {
+    const glm::dvec3& target = _positions[to];
+    for (uint32_t i = _triangleOffsets[from]; i < _triangleOffsets[from + 1]; ++i) {
+        const uint32_t* triangle = &_localIndices[_vertexTriangles[i] * VERTICES_PER_TRIANGLE];
+        if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+            continue; // collapsed
+        }
+
+        glm::dvec3 before[VERTICES_PER_TRIANGLE];
+        glm::dvec3 after[VERTICES_PER_TRIANGLE];
+        for (int j = 0; j < VERTICES_PER_TRIANGLE; ++j) {
+            before[j] = _positions[triangle[j]];
+            after[j] = triangle[j] == from ? target : before[j];
+        }
+        glm::dvec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+        glm::dvec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+        double lengths = glm::length(normalBefore) * glm::length(normalAfter);
+        if (lengths <= 0.0 || glm::dot(normalBefore, normalAfter) < MIN_NORMAL_COSINE * lengths) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t MeshSimplifier::collapsePass(size_t trianglesToRemove) {
+    buildAdjacency();
+
+    std::vector<uint64_t> edges;
+    edges.reserve(_localIndices.size());
+    for (size_t i = 0; i < _localIndices.size(); i += VERTICES_PER_TRIANGLE) {
+        for (int j = 0; j < VERTICES_PER_TRIANGLE; ++j) {
+            edges.push_back(edgeKey(_localIndices[i + j], _localIndices[i + (j + 1) % VERTICES_PER_TRIANGLE]));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // each edge collapses towards the end where the error is the lowest, the locked vertices don't move
+    std::vector<Collapse> collapses;
+    collapses.reserve(edges.size());
+    for (auto edge : edges) {
+        uint32_t a = (uint32_t)(edge >> 32);
+        uint32_t b = (uint32_t)edge;
+        if (_isLocked[a] && _isLocked[b]) {
+            continue;
+        }
+        Quadric quadric = _quadrics[a];
+        quadric.add(_quadrics[b]);
+        if (_isLocked[a]) {
+            collapses.push_back({ b, a, quadric.evaluate(_positions[a]) });
+        } else if (_isLocked[b]) {
+            collapses.push_back({ a, b, quadric.evaluate(_positions[b]) });
+        } else {
+            double costA = quadric.evaluate(_positions[a]);
+            double costB = quadric.evaluate(_positions[b]);
+            if (costA <= costB) {
+                collapses.push_back({ b, a, costA });
+            } else {
+                collapses.push_back({ a, b, costB });
+            }
+        }
+    }
+    std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+        return a.cost < b.cost;
+    });
+
+    // the collapses of a pass don't touch the same triangles, so that checking them one by one is enough
+    std::vector<uint32_t> remap(_vertices.size());
+    for (uint32_t i = 0; i < (uint32_t)remap.size(); ++i) {
+        remap[i] = i;
+    }
+    std::vector<bool> isTouched(_vertices.size(), false);
+    size_t removed = 0;
+    for (const auto& collapse : collapses) {
+        if (removed >= trianglesToRemove) {
+            break;
+        }
+        if (isTouched[collapse.from] || isTouched[collapse.to]) {
+            continue;
+        }
+
+        // an edge between two triangles only, or the surface would tear
+        size_t sharedTriangles = 0;
+        for (uint32_t i = _triangleOffsets[collapse.from]; i < _triangleOffsets[collapse.from + 1]; ++i) {
+            const uint32_t* triangle = &_localIndices[_vertexTriangles[i] * VERTICES_PER_TRIANGLE];
+            if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to) {
+                ++sharedTriangles;
+            }
+        }
+        if (sharedTriangles != 2 || flipsTriangle(collapse.from, collapse.to)) {
+            continue;
+        }
+
+        remap[collapse.from] = collapse.to;
+        for (uint32_t i = _triangleOffsets[collapse.from]; i < _triangleOffsets[collapse.from + 1]; ++i) {
+            const uint32_t* triangle = &_localIndices[_vertexTriangles[i] * VERTICES_PER_TRIANGLE];
+            for (int j = 0; j < VERTICES_PER_TRIANGLE; ++j) {
+                isTouched[triangle[j]] = true;
+            }
+        }
+        _quadrics[collapse.to].add(_quadrics[collapse.from]);
+        _maxCost = std::max(_maxCost, collapse.cost);
+        removed += sharedTriangles;
+    }
+
+    if (removed == 0) {
+        return 0;
+    }
+
+    size_t numIndices = 0;
+    for (size_t i = 0; i < _localIndices.size(); i += VERTICES_PER_TRIANGLE) {
+        uint32_t a = remap[_localIndices[i]];
+        uint32_t b = remap[_localIndices[i + 1]];
+        uint32_t c = remap[_localIndices[i + 2]];
+        if (a == b || b == c || a == c) {
+            continue;
+        }
+        _localIndices[numIndices++] = a;
+        _localIndices[numIndices++] = b;
+        _localIndices[numIndices++] = c;
+    }
+    _localIndices.resize(numIndices);
+    return removed;
+}
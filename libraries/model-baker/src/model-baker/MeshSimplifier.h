@@ -0,0 +1,87 @@
+//
+//  MeshSimplifier.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_MeshSimplifier_h
+#define hifi_MeshSimplifier_h
+
+#include <vector>
+#include <stdint.h>
+
+#include <glm/glm.hpp>
+
+namespace baker {
+
+    // Simplifies the triangles of a mesh part by collapsing its edges, cheapest first, with the cost of a collapse measured
+    // by the quadric error of the planes of the triangles around the vertices (Garland and Heckbert).
+    //
+    // The collapses move a vertex onto one of its neighbours, so the simplified triangles index the vertices of the mesh
+    // and share its vertex buffer. The vertices on the open edges never move: that keeps the silhouette of the open
+    // surfaces, and also the seams of the texture coordinates and normals, whose vertices are split in the mesh.
+    //
+    // simplify can be called again with a lower target to go on from the previous level.
+    class MeshSimplifier {
+    public:
+        MeshSimplifier(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+
+        // collapses edges until there are no more than targetIndexCount indices, or no collapse is left that doesn't
+        // flip a triangle, returns the indices
+        const std::vector<uint32_t>& simplify(size_t targetIndexCount);
+
+        const std::vector<uint32_t>& getIndices() const { return _indices; }
+
+        // the largest distance in meters the surface has moved by, roughly, over all the collapses so far
+        float getError() const { return _error; }
+
+    private:
+        // the squared distance to a set of planes, as a symmetric 4x4 matrix
+        struct Quadric {
+            double a2 { 0.0 }, ab { 0.0 }, ac { 0.0 }, ad { 0.0 };
+            double b2 { 0.0 }, bc { 0.0 }, bd { 0.0 };
+            double c2 { 0.0 }, cd { 0.0 };
+            double d2 { 0.0 };
+
+            void addPlane(const glm::dvec3& normal, double distance);
+            void add(const Quadric& other);
+            double evaluate(const glm::dvec3& point) const;
+        };
+
+        struct Collapse {
+            uint32_t from;
+            uint32_t to;
+            double cost;
+        };
+
+        // one pass of collapses that don't share triangles, returns the number of triangles removed
+        size_t collapsePass(size_t trianglesToRemove);
+        void buildAdjacency();
+        bool flipsTriangle(uint32_t from, uint32_t to) const;
+
+        // the positions and the indices are over the vertices used by the part only
+        std::vector<glm::dvec3> _positions;
+        std::vector<uint32_t> _vertices;        // the index in the mesh of each of them
+        std::vector<uint32_t> _localIndices;
+        std::vector<uint32_t> _indices;         // in the mesh
+        std::vector<Quadric> _quadrics;
+        std::vector<bool> _isLocked;
+
+        // the triangles around each vertex, rebuilt before each pass
+        std::vector<uint32_t> _triangleOffsets;
+        std::vector<uint32_t> _vertexTriangles;
+
+        double _maxCost { 0.0 };
+        float _error { 0.0f };
+    };
+
+};
+
+#endif // hifi_MeshSimplifier_h
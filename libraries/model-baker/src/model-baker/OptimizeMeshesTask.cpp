@@ -0,0 +1,160 @@
+//
+//  OptimizeMeshesTask.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OptimizeMeshesTask.h"
+
+#include <algorithm>
+
+#include <LogHandler.h>
+#include <TBBHelpers.h>
+
+#include "MeshOptimizer.h"
+#include "ModelBakerLogging.h"
+
+// how much worse the vertex cache may get for the clusters sorted against overdraw
+static const float OVERDRAW_CACHE_THRESHOLD = 1.05f;
+
+static bool toIndices(const QVector<int>& in, int numVertices, std::vector<uint32_t>& out) {
+    out.clear();
+    out.reserve(in.size());
+    for (auto index : in) {
+        if (index < 0 || index >= numVertices) {
+            return false;
+        }
+        out.push_back((uint32_t)index);
+    }
+    return true;
+}
+
+template <typename T>
+static void remapVertices(QVector<T>& data, const std::vector<uint32_t>& remap) {
+    // the data of a vertex can take more than one element, as the 4 skinning clusters do
+    int elementsPerVertex = data.size() / (int)remap.size();
+    if (elementsPerVertex == 0) {
+        return;
+    }
+    QVector<T> remapped(data.size());
+    for (size_t i = 0; i < remap.size(); ++i) {
+        std::copy_n(data.constData() + i * elementsPerVertex, elementsPerVertex, remapped.data() + remap[i] * elementsPerVertex);
+    }
+    data.swap(remapped);
+}
+
+static void remapIndices(QVector<int>& indices, const std::vector<uint32_t>& remap) {
+    for (auto& index : indices) {
+        index = (int)remap[index];
+    }
+}
+
+static void optimizeMesh(hfm::Mesh& mesh, baker::Blendshapes& blendshapes) {
+    static int repeatMessageID = LogHandler::getInstance().newRepeatedMessageID();
+
+    int numVertices = mesh.vertices.size();
+    if (numVertices == 0) {
+        return;
+    }
+
+    std::vector<glm::vec3> positions(mesh.vertices.cbegin(), mesh.vertices.cend());
+    std::vector<std::vector<uint32_t>> indexLists;
+    indexLists.reserve(mesh.parts.size() * 2);
+    for (const auto& part : mesh.parts) {
+        std::vector<uint32_t> quadIndices;
+        if (!toIndices(part.quadIndices, numVertices, quadIndices)) {
+            HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "OptimizeMeshesTask -- indices out of range, the mesh is left as is");
+            return;
+        }
+        for (const auto indices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+            indexLists.emplace_back();
+            if (!toIndices(*indices, numVertices, indexLists.back())) {
+                HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "OptimizeMeshesTask -- indices out of range, the mesh is left as is");
+                return;
+            }
+            baker::optimizeVertexCache(indexLists.back(), numVertices);
+            baker::optimizeOverdraw(indexLists.back(), positions, OVERDRAW_CACHE_THRESHOLD);
+        }
+    }
+
+    // the vertex data must all be per vertex for the vertices to move
+    bool canRemapVertices = true;
+    auto checkPerVertex = [&](int size, int elementsPerVertex) {
+        if (size != 0 && size != numVertices * elementsPerVertex) {
+            canRemapVertices = false;
+        }
+    };
+    checkPerVertex(mesh.normals.size(), 1);
+    checkPerVertex(mesh.tangents.size(), 1);
+    checkPerVertex(mesh.colors.size(), 1);
+    checkPerVertex(mesh.texCoords.size(), 1);
+    checkPerVertex(mesh.texCoords1.size(), 1);
+    checkPerVertex(mesh.originalIndices.size(), 1);
+    if (mesh.clusterIndices.size() != mesh.clusterWeights.size() || mesh.clusterIndices.size() % numVertices != 0) {
+        canRemapVertices = false;
+    }
+    for (const auto& blendshape : blendshapes) {
+        if (!std::all_of(blendshape.indices.cbegin(), blendshape.indices.cend(), [numVertices](int index) {
+                return index >= 0 && index < numVertices;
+            })) {
+            canRemapVertices = false;
+        }
+    }
+
+    std::vector<uint32_t> remap;
+    if (canRemapVertices) {
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (const auto& indices : indexLists) {
+            lists.push_back(&indices);
+        }
+        remap = baker::buildVertexFetchRemap(lists, numVertices);
+
+        remapVertices(mesh.vertices, remap);
+        remapVertices(mesh.normals, remap);
+        remapVertices(mesh.tangents, remap);
+        remapVertices(mesh.colors, remap);
+        remapVertices(mesh.texCoords, remap);
+        remapVertices(mesh.texCoords1, remap);
+        remapVertices(mesh.clusterIndices, remap);
+        remapVertices(mesh.clusterWeights, remap);
+        remapVertices(mesh.originalIndices, remap);
+        for (auto& blendshape : blendshapes) {
+            remapIndices(blendshape.indices, remap);
+        }
+        mesh.blendshapes = QVector<hfm::Blendshape>::fromStdVector(blendshapes);
+    } else {
+        HIFI_FCDEBUG_ID(model_baker(), repeatMessageID, "OptimizeMeshesTask -- the vertex data isn't per vertex, the vertices are left in their order");
+    }
+
+    auto indices = indexLists.cbegin();
+    for (auto& part : mesh.parts) {
+        for (auto partIndices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+            partIndices->resize((int)indices->size());
+            for (size_t i = 0; i < indices->size(); ++i) {
+                (*partIndices)[(int)i] = remap.empty() ? (int)(*indices)[i] : (int)remap[(*indices)[i]];
+            }
+            ++indices;
+        }
+        if (!remap.empty()) {
+            remapIndices(part.quadIndices, remap);
+        }
+    }
+}
+
+void OptimizeMeshesTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    auto& meshesOut = output.edit0();
+    auto& blendshapesPerMeshOut = output.edit1();
+    meshesOut = input.get0();
+    blendshapesPerMeshOut = input.get1();
+    blendshapesPerMeshOut.resize(meshesOut.size());
+
+    // the meshes are independent of each other
+    tbb::parallel_for(0, (int)meshesOut.size(), [&](int i) {
+        optimizeMesh(meshesOut[i], blendshapesPerMeshOut[i]);
+    });
+}
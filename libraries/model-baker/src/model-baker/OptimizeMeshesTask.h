@@ -0,0 +1,33 @@
+//
+//  OptimizeMeshesTask.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OptimizeMeshesTask_h
+#define hifi_OptimizeMeshesTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+
+// Reorders the triangles of the mesh parts for the vertex cache and then against overdraw, and the vertices in the order
+// the triangles use them, before anything else is built from the meshes. The blendshapes follow the vertices.
+class OptimizeMeshesTask {
+public:
+    using Input = baker::VaryingSet2<std::vector<hfm::Mesh>, baker::BlendshapesPerMesh>;
+    using Output = baker::VaryingSet2<std::vector<hfm::Mesh>, baker::BlendshapesPerMesh>;
+    using JobModel = baker::Job::ModelIO<OptimizeMeshesTask, Input, Output>;
+
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+};
+
+#endif // hifi_OptimizeMeshesTask_h
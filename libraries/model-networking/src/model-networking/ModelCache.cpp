@@ -271,6 +271,8 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
             _geometryResource = modelCache->getResource(url, QUrl(), &extra, std::hash<GeometryExtra>()(extra)).staticCast<GeometryResource>();
             // Avoid caching nested resources - their references will be held by the parent
             _geometryResource->_isCacheable = false;
+            // The model is downloaded as soon as its mapping would have been
+            _geometryResource->setLoadPriorities(_loadPriorities);
 
             if (_geometryResource->isLoaded()) {
                 onGeometryMappingLoaded(!_geometryResource->getURL().isEmpty());
@@ -523,6 +525,12 @@ void GeometryResourceWatcher::stopWatching() {
     disconnect(_resource.data(), &Resource::onRefresh, this, &GeometryResourceWatcher::resourceRefreshed);
 }
 
+void GeometryResourceWatcher::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    if (_resource && !_resource->isLoaded()) {
+        _resource->setLoadPriority(owner, priority);
+    }
+}
+
 void GeometryResourceWatcher::setResource(GeometryResource::Pointer resource) {
     if (_resource) {
         stopWatching();
@@ -135,6 +135,8 @@ public:
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
 
+    void setLoadPriority(const QPointer<QObject>& owner, float priority);
+
 private:
     void startWatching();
     void stopWatching();
@@ -18,6 +18,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include <BlendshapeConstants.h>
+#include <TBBHelpers.h>
 
 #include <hfm/ModelFormatLogging.h>
 
@@ -397,6 +398,14 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
     bool deduplicateIndices = mapping["deduplicateIndices"].toBool();
 
     QMap<QString, ExtractedMesh> meshes;
+    // the geometry nodes of the meshes, extracted together once all the objects have been read
+    struct PendingMesh {
+        QString id;
+        const FBXNode* object;
+        unsigned int meshIndex;
+        ExtractedMesh extracted;
+    };
+    std::vector<PendingMesh> pendingMeshes;
     QHash<QString, QString> modelIDsToNames;
     QHash<QString, int> meshIDsToMeshIndices;
     QHash<QString, QString> ooChildToParent;
@@ -513,7 +522,8 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices));
+                        // the node stays put, it's in the root node that isn't changed while the model is extracted
+                        pendingMeshes.push_back({ getID(object.properties), &object, meshIndex++, ExtractedMesh() });
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
@@ -1100,6 +1110,17 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                 }
 #endif
             }
+
+            // each mesh only reads its own node
+            tbb::parallel_for(0, (int)pendingMeshes.size(), [&](int i) {
+                PendingMesh& pending = pendingMeshes[i];
+                unsigned int index = pending.meshIndex;
+                pending.extracted = extractMesh(*pending.object, index, deduplicateIndices);
+            });
+            for (auto& pending : pendingMeshes) {
+                meshes.insert(pending.id, std::move(pending.extracted));
+            }
+            pendingMeshes.clear();
         } else if (child.name == "Connections") {
             static const QVariant OO = hifi::ByteArray("OO");
             static const QVariant OP = hifi::ByteArray("OP");
@@ -116,6 +116,8 @@ public:
 
     FBXNode _rootNode;
     static FBXNode parseFBX(QIODevice* device);
+    // inflates the big compressed arrays put off while reading the node tree
+    static void inflateDeferredArrays(FBXNode& top);
 
     HFMModel* extractHFMModel(const hifi::VariantHash& mapping, const QString& url);
 
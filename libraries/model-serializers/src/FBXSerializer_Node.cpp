@@ -11,7 +11,11 @@
 
 #include "FBXSerializer.h"
 
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <vector>
+
 #include <QtCore/QBuffer>
 #include <QtCore/QDataStream>
 #include <QtCore/QIODevice>
@@ -23,6 +27,16 @@
 
 #include <shared/NsightHelpers.h>
 #include <hfm/ModelFormatLogging.h>
+#include <TBBHelpers.h>
+
+// compressed arrays this big or bigger are inflated once the whole node tree has been read, several at a time
+static const quint32 MIN_DEFERRED_COMPRESSED_LENGTH = 64 * 1024;
+
+// stands in for an array property until it is inflated
+struct DeferredBinaryArray {
+    std::function<QVariant()> inflate;
+};
+Q_DECLARE_METATYPE(DeferredBinaryArray)
 
 template<class T>
 int streamSize() {
@@ -34,6 +48,20 @@ int streamSize() {
     return 1;
 }
 
+// answers an invalid variant if the data is corrupt
+template<class T>
+QVariant inflateBinaryArray(const hifi::ByteArray& compressed, quint32 arrayLength) {
+    hifi::ByteArray arrayData = qUncompress(compressed);
+    if (arrayData.isEmpty() || (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) {
+        return QVariant();
+    }
+
+    QVector<T> values;
+    values.resize(arrayLength);
+    memcpy(&values[0], arrayData.constData(), arrayData.size());
+    return QVariant::fromValue(values);
+}
+
 template<class T>
 QVariant readBinaryArray(QDataStream& in, int& position) {
     quint32 arrayLength;
@@ -53,25 +81,32 @@ QVariant readBinaryArray(QDataStream& in, int& position) {
 
     QVector<T> values;
     if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        hifi::ByteArray arrayData;
         if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
             // preface encoded data with uncompressed length
             hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
             *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
             in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
             position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
+
+            if (compressedLength >= MIN_DEFERRED_COMPRESSED_LENGTH) {
+                return QVariant::fromValue(DeferredBinaryArray { [compressed, arrayLength] {
+                    return inflateBinaryArray<T>(compressed, arrayLength);
+                } });
+            }
+
+            QVariant inflated = inflateBinaryArray<T>(compressed, arrayLength);
+            if (!inflated.isValid()) {
                 throw QString("corrupt fbx file");
             }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
+            return inflated;
         }
 
+        values.resize(arrayLength);
+        hifi::ByteArray arrayData;
+        arrayData.resize(sizeof(T) * arrayLength);
+        position += sizeof(T) * arrayLength;
+        in.readRawData(arrayData.data(), arrayData.size());
+
         if (arrayData.size() > 0) {
             memcpy(&values[0], arrayData.constData(), arrayData.size());
         }
@@ -392,16 +427,50 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
     while (device->bytesAvailable()) {
         FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
         if (next.name.isNull()) {
-            return top;
+            break;
 
         } else {
             top.children.append(next);
         }
     }
 
+    inflateDeferredArrays(top);
     return top;
 }
 
+static void collectDeferredArrays(FBXNode& node, std::vector<QVariant*>& deferredArrays) {
+    static const int DEFERRED_ARRAY_TYPE = qMetaTypeId<DeferredBinaryArray>();
+    for (auto& property : node.properties) {
+        if (property.userType() == DEFERRED_ARRAY_TYPE) {
+            deferredArrays.push_back(&property);
+        }
+    }
+    for (auto& child : node.children) {
+        collectDeferredArrays(child, deferredArrays);
+    }
+}
+
+void FBXSerializer::inflateDeferredArrays(FBXNode& top) {
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, 0);
+
+    // the tree isn't changed from here on, so the properties stay where they are while they are inflated
+    std::vector<QVariant*> deferredArrays;
+    collectDeferredArrays(top, deferredArrays);
+
+    std::atomic<bool> isCorrupt { false };
+    tbb::parallel_for(0, (int)deferredArrays.size(), [&](int i) {
+        QVariant& property = *deferredArrays[i];
+        property = property.value<DeferredBinaryArray>().inflate();
+        if (!property.isValid()) {
+            isCorrupt = true;
+        }
+    });
+
+    if (isCorrupt) {
+        throw QString("corrupt fbx file");
+    }
+}
+
 
 glm::vec3 FBXSerializer::getVec3(const QVariantList& properties, int index) {
     return glm::vec3(properties.at(index).value<double>(), properties.at(index + 1).value<double>(),
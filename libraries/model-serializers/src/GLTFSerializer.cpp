@@ -13,6 +13,7 @@
 
 #include <QtCore/QBuffer>
 #include <QtCore/QIODevice>
+#include <QtCore/QtEndian>
 #include <QtCore/QEventLoop>
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
@@ -33,6 +34,7 @@
 #include <PathUtils.h>
 #include <image/ColorChannel.h>
 #include <BlendshapeConstants.h>
+#include <TBBHelpers.h>
 
 #include "FBXSerializer.h"
 
@@ -148,26 +150,35 @@ bool GLTFSerializer::getObjectArrayVal(const QJsonObject& object, const QString&
 }
 
 hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
-    int byte = 4;
-    int jsonStart = data.indexOf("JSON", Qt::CaseSensitive);
-    int binStart = data.indexOf("BIN", Qt::CaseSensitive);
-    int jsonLength, binLength;
-    hifi::ByteArray jsonLengthChunk, binLengthChunk;
-
-    jsonLengthChunk = data.mid(jsonStart - byte, byte);
-    QDataStream tempJsonLen(jsonLengthChunk);
-    tempJsonLen.setByteOrder(QDataStream::LittleEndian);
-    tempJsonLen >> jsonLength;
-    hifi::ByteArray jsonChunk = data.mid(jsonStart + byte, jsonLength);
-
-    if (binStart != -1) {
-        binLengthChunk = data.mid(binStart - byte, byte);
-
-        QDataStream tempBinLen(binLengthChunk);
-        tempBinLen.setByteOrder(QDataStream::LittleEndian);
-        tempBinLen >> binLength;
+    // 12 byte header: magic, version and length, then chunks of length, type and data padded to 4 bytes
+    static const int GLB_HEADER_SIZE = 12;
+    static const int GLB_CHUNK_HEADER_SIZE = 8;
+    static const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+    static const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+
+    hifi::ByteArray jsonChunk;
+    if (data.size() < GLB_HEADER_SIZE) {
+        return jsonChunk;
+    }
+    const char* bytes = data.constData();
+    qint64 fileLength = std::min<qint64>(data.size(), qFromLittleEndian<quint32>(bytes + 8));
+    qint64 offset = GLB_HEADER_SIZE;
+    while (offset + GLB_CHUNK_HEADER_SIZE <= fileLength) {
+        qint64 chunkLength = qFromLittleEndian<quint32>(bytes + offset);
+        quint32 chunkType = qFromLittleEndian<quint32>(bytes + offset + 4);
+        offset += GLB_CHUNK_HEADER_SIZE;
+        if (offset + chunkLength > fileLength) {
+            qWarning(modelformat) << "Truncated GLB chunk in model " << _url;
+            break;
+        }
 
-        _glbBinary = data.mid(binStart + byte, binLength);
+        // the chunks are views of the data rather than copies, the data outlives the parsing
+        if (chunkType == GLB_CHUNK_TYPE_JSON && jsonChunk.isEmpty()) {
+            jsonChunk = hifi::ByteArray::fromRawData(bytes + offset, (int)chunkLength);
+        } else if (chunkType == GLB_CHUNK_TYPE_BIN && _glbBinary.isEmpty()) {
+            _glbBinary = hifi::ByteArray::fromRawData(bytes + offset, (int)chunkLength);
+        }
+        offset += (chunkLength + 3) & ~3;
     }
     return jsonChunk;
 }
@@ -386,6 +397,7 @@ bool GLTFSerializer::addBufferView(const QJsonObject& object) {
     getIntVal(object, "buffer", bufferview.buffer, bufferview.defined);
     getIntVal(object, "byteLength", bufferview.byteLength, bufferview.defined);
     getIntVal(object, "byteOffset", bufferview.byteOffset, bufferview.defined);
+    getIntVal(object, "byteStride", bufferview.byteStride, bufferview.defined);
     getIntVal(object, "target", bufferview.target, bufferview.defined);
 
     _file.bufferviews.push_back(bufferview);
@@ -1706,14 +1718,24 @@ HFMModel::Pointer GLTFSerializer::read(const hifi::ByteArray& data, const hifi::
         //hfmModel.debugDump();
         //glTFDebugDump();
 
+        releaseBuffers();
         return hfmModelPtr;
     } else {
         qCDebug(modelformat) << "Error parsing GLTF file.";
     }
 
+    releaseBuffers();
     return nullptr;
 }
 
+void GLTFSerializer::releaseBuffers() {
+    // the GLB chunk and the buffers made from it refer to the data passed to read()
+    _glbBinary.clear();
+    for (auto& buffer : _file.buffers) {
+        buffer.blob.clear();
+    }
+}
+
 bool GLTFSerializer::readBinary(const QString& url, hifi::ByteArray& outdata) {
     bool success;
 
@@ -1805,7 +1827,10 @@ HFMTexture GLTFSerializer::getHFMTexture(const GLTFTexture& texture) {
             int offset = imagesBufferview.byteOffset;
             int length = imagesBufferview.byteLength;
 
-            fbxtex.content = _glbBinary.mid(offset, length);
+            // a deep copy, the texture outlives the GLB chunk
+            if (offset >= 0 && length >= 0 && offset + length <= _glbBinary.size()) {
+                fbxtex.content = hifi::ByteArray(_glbBinary.constData() + offset, length);
+            }
             fbxtex.filename = textureUrl.toEncoded().append(texture.source);
         }
 
@@ -1887,15 +1912,8 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& hfmMat, const GLTFMaterial& mat
 }
 
 template<typename T, typename L>
-bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count,
+bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
                            QVector<L>& outarray, int accessorType, bool normalized) {
-
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
-
     int bufferCount = 0;
     switch (accessorType) {
     case GLTFAccessorType::SCALAR:
@@ -1921,7 +1939,17 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
         break;
     default:
         qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-        blobstream.setDevice(nullptr);
+        return false;
+    }
+
+    if (count <= 0) {
+        return true;
+    }
+
+    // the elements are read in place from the buffer, byteStride apart when the buffer view interleaves them
+    const qint64 elementSize = bufferCount * (qint64)sizeof(T);
+    const qint64 stride = byteStride > 0 ? byteStride : elementSize;
+    if (byteOffset < 0 || byteOffset + (count - 1) * stride + elementSize > bin.size()) {
         return false;
     }
 
@@ -1930,46 +1958,57 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
         scale = (float)(std::numeric_limits<T>::max)();
     }
 
-    for (int i = 0; i < count; ++i) {
-        for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
-                T value;
-                blobstream >> value;
+    const int outStart = outarray.size();
+    outarray.resize(outStart + count * bufferCount);
+    const char* source = bin.constData() + byteOffset;
+    L* destination = outarray.data() + outStart;
+
+    auto readElements = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const char* element = source + i * stride;
+            L* out = destination + i * bufferCount;
+            for (int j = 0; j < bufferCount; ++j) {
+                T value = qFromLittleEndian<T>(element + j * sizeof(T));
                 if (normalized) {
-                    outarray.push_back(std::max((float)value / scale, -1.0f));
+                    out[j] = (L)std::max((float)value / scale, -1.0f);
                 } else {
-                    outarray.push_back(value);
+                    out[j] = (L)value;
                 }
-            } else {
-                blobstream.setDevice(nullptr);
-                return false;
             }
         }
+    };
+
+    // large accessors, the vertices of a dense mesh say, are worth splitting across threads
+    static const int PARALLEL_READ_GRAIN_SIZE = 16384;
+    if (count > PARALLEL_READ_GRAIN_SIZE) {
+        tbb::parallel_for(tbb::blocked_range<int>(0, count, PARALLEL_READ_GRAIN_SIZE), [&](const tbb::blocked_range<int>& range) {
+            readElements(range.begin(), range.end());
+        });
+    } else {
+        readElements(0, count);
     }
-
-    blobstream.setDevice(nullptr);
     return true;
 }
 template<typename T>
-bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
+bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
                                 QVector<T>& outarray, int accessorType, int componentType, bool normalized) {
 
     switch (componentType) {
     case GLTFAccessorComponentType::BYTE: {}
     case GLTFAccessorComponentType::UNSIGNED_BYTE: {
-        return readArray<uchar>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<uchar>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::SHORT: {
-        return readArray<short>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<short>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_INT: {
-        return readArray<uint>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<uint>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_SHORT: {
-        return readArray<ushort>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<ushort>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::FLOAT: {
-        return readArray<float>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<float>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     }
     return false;
@@ -1985,8 +2024,8 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
         int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
 
-        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, accessor.count, outarray, accessor.type,
-                                 accessor.componentType, accessor.normalized);
+        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, bufferview.byteStride, accessor.count,
+                                 outarray, accessor.type, accessor.componentType, accessor.normalized);
     } else {
         for (int i = 0; i < accessor.count; ++i) {
             T value;
@@ -2004,7 +2043,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
             int accSIBoffset = accessor.sparse.indices.defined["byteOffset"] ? accessor.sparse.indices.byteOffset : 0;
 
-            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset,
+            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset, 0,
                                      accessor.sparse.count, out_sparse_indices_array, GLTFAccessorType::SCALAR,
                                      accessor.sparse.indices.componentType, false);
             if (success) {
@@ -2015,7 +2054,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
                 int accSVBoffset = accessor.sparse.values.defined["byteOffset"] ? accessor.sparse.values.byteOffset : 0;
 
-                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset,
+                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset, 0,
                                          accessor.sparse.count, out_sparse_values_array, accessor.type, accessor.componentType,
                                          accessor.normalized);
 
@@ -14,10 +14,11 @@
 #include <cstdint>
 
 #include <QtCore/QBuffer>
+#include <QtCore/QDir>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtScript/QScriptEngine>
-#include <QtNetwork/QNetworkDiskCache>
 
 #include <shared/GlobalAppProperties.h>
 #include <shared/MiniPromises.h>
@@ -31,9 +32,12 @@
 #include "NodeList.h"
 #include "PacketReceiver.h"
 #include "ResourceCache.h"
+#include "ResourceDiskCache.h"
 
 MessageID AssetClient::_currentID = 0;
 
+static const QString RESOURCE_CACHE_DIRNAME = "resources";
+
 AssetClient::AssetClient() {
     _cacheDir = qApp->property(hifi::properties::APP_LOCAL_DATA_PATH).toString();
     setCustomDeleter([](Dependency* dependency){
@@ -71,14 +75,19 @@ void AssetClient::initCaching() {
 #endif
             _cacheDir = !cachePath.isEmpty() ? cachePath : "interfaceCache";
         }
-        QNetworkDiskCache* cache = new QNetworkDiskCache();
-        cache->setMaximumCacheSize(MAXIMUM_CACHE_SIZE);
-        cache->setCacheDirectory(_cacheDir);
+        auto cache = new ResourceDiskCache(QDir(_cacheDir).filePath(RESOURCE_CACHE_DIRNAME), MAXIMUM_CACHE_SIZE);
         networkAccessManager.setCache(cache);
-        qInfo() << "ResourceManager disk cache setup at" << _cacheDir
+        qInfo() << "ResourceManager disk cache setup at" << cache->cacheDirectory()
                  << "(size:" << MAXIMUM_CACHE_SIZE / BYTES_PER_GIGABYTES << "GB)";
-    } else {
-        auto cache = qobject_cast<QNetworkDiskCache*>(networkAccessManager.cache());
+
+        // the folders of the QNetworkDiskCache used before are of no use anymore
+        QString cacheDir = _cacheDir;
+        QThreadPool::globalInstance()->start([cacheDir] {
+            for (const auto& oldFolder : { "data8", "prepared" }) {
+                QDir(QDir(cacheDir).filePath(oldFolder)).removeRecursively();
+            }
+        });
+    } else if (auto cache = qobject_cast<ResourceDiskCache*>(networkAccessManager.cache())) {
         qInfo() << "ResourceManager disk cache already setup at" << cache->cacheDirectory()
                 << "(size:" << cache->maximumCacheSize() / BYTES_PER_GIGABYTES << "GB)";
     }
@@ -103,7 +112,7 @@ MiniPromise::Promise AssetClient::cacheInfoRequestAsync(MiniPromise::Promise def
     if (QThread::currentThread() != thread()) {
         QMetaObject::invokeMethod(this, "cacheInfoRequestAsync", Q_ARG(MiniPromise::Promise, deferred));
     } else {
-        auto cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache());
+        auto cache = qobject_cast<ResourceDiskCache*>(NetworkAccessManager::getInstance().cache());
         if (cache) {
             deferred->resolve({
                 { "cacheDirectory", cache->cacheDirectory() },
@@ -296,7 +305,7 @@ void AssetClient::cacheInfoRequest(QObject* reciever, QString slot) {
     }
 
 
-    if (auto* cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache())) {
+    if (auto* cache = qobject_cast<ResourceDiskCache*>(NetworkAccessManager::getInstance().cache())) {
         QMetaObject::invokeMethod(reciever, slot.toStdString().data(), Qt::QueuedConnection,
                                   Q_ARG(QString, cache->cacheDirectory()),
                                   Q_ARG(qint64, cache->cacheSize()),
@@ -496,7 +505,7 @@ MessageID AssetClient::getAssetInfo(const QString& hash, GetInfoCallback callbac
         }
     }
 
-    callback(false, AssetUtils::AssetServerError::NoError, { "", 0 });
+    callback(false, AssetUtils::AssetServerError::NoError, { "", 0, 0, QByteArray() });
     return INVALID_MESSAGE_ID;
 }
 
@@ -510,10 +519,23 @@ void AssetClient::handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> messag
     AssetUtils::AssetServerError error;
     message->readPrimitive(&error);
 
-    AssetInfo info { assetHash.toHex(), 0 };
+    AssetInfo info { assetHash.toHex(), 0, 0, QByteArray() };
 
     if (error == AssetUtils::AssetServerError::NoError) {
         message->readPrimitive(&info.size);
+
+        // the asset servers that hash the chunks of the large assets add them after the size
+        if (message->getBytesLeftToRead() > (qint64)sizeof(info.chunkSize)) {
+            message->readPrimitive(&info.chunkSize);
+            auto chunkHashes = message->readAll();
+            auto numChunks = info.chunkSize > 0 ? (info.size + info.chunkSize - 1) / info.chunkSize : 0;
+            if (numChunks > 1 && chunkHashes.size() == numChunks * (qint64)AssetUtils::SHA256_HASH_LENGTH) {
+                info.chunkHashes = chunkHashes;
+            } else {
+                qCWarning(asset_client) << "Ignoring the invalid chunk hashes of" << info.hash;
+                info.chunkSize = 0;
+            }
+        }
     }
 
     // Check if we have any pending requests for this node
@@ -16,6 +16,7 @@
 #include <QtQml/QJSEngine>
 #include <QString>
 
+#include <atomic>
 #include <map>
 
 #include <DependencyManager.h>
@@ -40,6 +41,9 @@ class AssetUpload;
 struct AssetInfo {
     QString hash;
     int64_t size;
+    // the SHA-256 hashes of the chunks of chunkSize bytes of a large asset, empty if the asset server doesn't send them
+    int64_t chunkSize;
+    QByteArray chunkHashes;
 };
 
 using MappingOperationCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, QSharedPointer<ReceivedMessage> message)>;
@@ -63,6 +67,10 @@ public:
     Q_INVOKABLE AssetUpload* createUpload(const QString& filename);
     Q_INVOKABLE AssetUpload* createUpload(const QByteArray& data);
 
+    // the number of chunks of a large asset that are requested at once
+    void setChunkRequestWindow(int window) { _chunkRequestWindow = std::max(window, 1); }
+    int getChunkRequestWindow() const { return _chunkRequestWindow; }
+
 public slots:
     void initCaching();
 
@@ -119,6 +127,9 @@ private:
 
     QString _cacheDir;
 
+    static const int DEFAULT_CHUNK_REQUEST_WINDOW { 4 };
+    std::atomic<int> _chunkRequestWindow { DEFAULT_CHUNK_REQUEST_WINDOW };
+
     friend class AssetRequest;
     friend class AssetUpload;
     friend class MappingRequest;
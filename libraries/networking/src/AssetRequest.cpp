@@ -12,8 +12,10 @@
 #include "AssetRequest.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include <StatTracker.h>
 #include <Trace.h>
@@ -25,6 +27,21 @@
 
 static int requestID = 0;
 
+// a chunk is requested again after a lost connection, waiting longer each time for the node to reconnect
+static const int MAX_CHUNK_ATTEMPTS = 5;
+static const int CHUNK_RETRY_DELAY_MSECS = 1000;
+
+static AssetRequest::Error getRequestError(AssetUtils::AssetServerError serverError) {
+    switch (serverError) {
+        case AssetUtils::AssetServerError::AssetNotFound:
+            return AssetRequest::NotFound;
+        case AssetUtils::AssetServerError::InvalidByteRange:
+            return AssetRequest::InvalidByteRange;
+        default:
+            return AssetRequest::UnknownError;
+    }
+}
+
 AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     _requestID(++requestID),
     _hash(hash),
@@ -38,6 +55,14 @@ AssetRequest::~AssetRequest() {
     if (_assetRequestID) {
         assetClient->cancelGetAssetRequest(_assetRequestID);
     }
+    if (_assetInfoRequestID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+    }
+    for (const auto& chunk : _chunks) {
+        if (chunk.requestID) {
+            assetClient->cancelGetAssetRequest(chunk.requestID);
+        }
+    }
 }
 
 void AssetRequest::start() {
@@ -75,6 +100,32 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        requestAsset();
+        return;
+    }
+
+    // the info of a large asset has the hashes of its chunks, if the asset server sends them
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    _assetInfoRequestID = assetClient->getAssetInfo(_hash,
+        [this, that](bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info) {
+
+        if (!that) {
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+
+        if (responseReceived && serverError == AssetUtils::AssetServerError::NoError && !info.chunkHashes.isEmpty()) {
+            requestChunks(info);
+        } else {
+            // the errors are reported by the request of the whole asset
+            requestAsset();
+        }
+    });
+}
+
+void AssetRequest::requestAsset() {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
@@ -92,17 +143,7 @@ void AssetRequest::start() {
         if (!responseReceived) {
             _error = NetworkError;
         } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
+            _error = getRequestError(serverError);
         } else {
             if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
                 // the hash of the received data does not match what we expect, so we return an error
@@ -135,6 +176,162 @@ void AssetRequest::start() {
     });
 }
 
+void AssetRequest::requestChunks(const AssetInfo& info) {
+    _chunkSize = info.chunkSize;
+    int numChunks = (int)((info.size + _chunkSize - 1) / _chunkSize);
+    _chunks.resize(numChunks);
+    _data.resize((int)info.size);
+
+    // the chunks received by an earlier request that didn't finish are in the cache under their own hash
+    for (int i = 0; i < numChunks; ++i) {
+        auto& chunk = _chunks[i];
+        chunk.hash = info.chunkHashes.mid(i * (int)AssetUtils::SHA256_HASH_LENGTH, (int)AssetUtils::SHA256_HASH_LENGTH);
+
+        auto start = i * _chunkSize;
+        auto size = std::min(_chunkSize, (AssetUtils::DataOffset)info.size - start);
+        QByteArray cached = AssetUtils::loadFromCache(getChunkUrl(i));
+        if (cached.size() == size && AssetUtils::hashData(cached) == chunk.hash) {
+            memcpy(_data.data() + start, cached.constData(), size);
+            chunk.bytesReceived = size;
+            chunk.isReceived = true;
+            _totalReceived += size;
+            ++_numChunksReceived;
+        }
+    }
+
+    if (_numChunksReceived > 0) {
+        qCDebug(asset_client) << "Resuming" << _hash << "with" << _numChunksReceived << "of" << numChunks << "chunks cached";
+        emit progress(_totalReceived, _data.size());
+    }
+    requestNextChunks();
+}
+
+void AssetRequest::requestNextChunks() {
+    int window = DependencyManager::get<AssetClient>()->getChunkRequestWindow();
+    while (_numChunksInFlight < window && _nextChunk < (int)_chunks.size()) {
+        int chunk = _nextChunk++;
+        if (!_chunks[chunk].isReceived) {
+            ++_numChunksInFlight;
+            requestChunk(chunk);
+        }
+    }
+
+    if (_numChunksReceived == (int)_chunks.size() && _state != Finished) {
+        finishChunks();
+    }
+}
+
+void AssetRequest::requestChunk(int chunk) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    AssetUtils::DataOffset start = chunk * _chunkSize;
+    AssetUtils::DataOffset end = std::min(start + _chunkSize, (AssetUtils::DataOffset)_data.size());
+    ++_chunks[chunk].attempts;
+
+    // invalid if there's no asset server to send the request to, the reply is handled already then
+    _chunks[chunk].requestID = assetClient->getAsset(_hash, start, end,
+        [this, that, chunk](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+
+        if (!that) {
+            return;
+        }
+        handleChunkReply(chunk, responseReceived, serverError, data);
+    }, [this, that, chunk](qint64 totalReceived, qint64 total) {
+        if (!that || _state == Finished) {
+            return;
+        }
+        auto& chunkReceived = _chunks[chunk].bytesReceived;
+        _totalReceived += totalReceived - chunkReceived;
+        chunkReceived = totalReceived;
+        emit progress(_totalReceived, _data.size());
+    });
+}
+
+void AssetRequest::handleChunkReply(int chunk, bool responseReceived, AssetUtils::AssetServerError serverError,
+                                    const QByteArray& data) {
+    auto& state = _chunks[chunk];
+    state.requestID = INVALID_MESSAGE_ID;
+    if (_state == Finished) {
+        return;
+    }
+
+    if (responseReceived && serverError != AssetUtils::AssetServerError::NoError) {
+        finish(getRequestError(serverError));
+        return;
+    }
+
+    AssetUtils::DataOffset start = chunk * _chunkSize;
+    AssetUtils::DataOffset size = std::min(_chunkSize, (AssetUtils::DataOffset)_data.size() - start);
+    if (responseReceived && data.size() == size && AssetUtils::hashData(data) == state.hash) {
+        memcpy(_data.data() + start, data.constData(), size);
+        _totalReceived += size - state.bytesReceived;
+        state.bytesReceived = size;
+        state.isReceived = true;
+        ++_numChunksReceived;
+        --_numChunksInFlight;
+
+        AssetUtils::saveToCache(getChunkUrl(chunk), data);
+        emit progress(_totalReceived, _data.size());
+
+        requestNextChunks();
+        return;
+    }
+
+    // the connection was lost, or the chunk doesn't match its hash
+    _totalReceived -= state.bytesReceived;
+    state.bytesReceived = 0;
+    if (state.attempts >= MAX_CHUNK_ATTEMPTS) {
+        finish(responseReceived ? HashVerificationFailed : NetworkError);
+        return;
+    }
+
+    qCDebug(asset_client) << "Requesting chunk" << chunk << "of" << _hash << "again," << (responseReceived ?
+        "it doesn't match its hash" : "the connection was lost");
+    QTimer::singleShot(CHUNK_RETRY_DELAY_MSECS * state.attempts, this, [this, chunk] {
+        if (_state != Finished) {
+            requestChunk(chunk);
+        }
+    });
+}
+
+void AssetRequest::finishChunks() {
+    // the chunk hashes come from the asset server, the asset hash is what was asked for
+    bool isValid = AssetUtils::hashData(_data).toHex() == _hash;
+
+    // the whole asset replaces its chunks in the cache, or they're dropped since one of them is wrong
+    for (int i = 0; i < (int)_chunks.size(); ++i) {
+        AssetUtils::removeFromCache(getChunkUrl(i));
+    }
+
+    if (!isValid) {
+        finish(HashVerificationFailed);
+        return;
+    }
+
+    AssetUtils::saveToCache(getUrl(), _data);
+    finish(NoError);
+}
+
+void AssetRequest::finish(Error error) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    for (auto& chunk : _chunks) {
+        if (chunk.requestID) {
+            assetClient->cancelGetAssetRequest(chunk.requestID);
+            chunk.requestID = INVALID_MESSAGE_ID;
+        }
+    }
+
+    _error = error;
+    if (_error != NoError) {
+        _data.clear();
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+    }
+
+    _state = Finished;
+    emit finished(this);
+}
+
 
 const QString AssetRequest::getErrorString() const {
     QString result;
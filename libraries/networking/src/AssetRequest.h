@@ -12,6 +12,8 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <vector>
+
 #include <QByteArray>
 #include <QObject>
 #include <QString>
@@ -62,6 +64,24 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    // the chunks of a large asset are requested a window at a time, and verified, cached and retried one by one
+    struct Chunk {
+        QByteArray hash;
+        MessageID requestID { INVALID_MESSAGE_ID };
+        int attempts { 0 };
+        qint64 bytesReceived { 0 };
+        bool isReceived { false };
+    };
+
+    void requestAsset();
+    void requestChunks(const AssetInfo& info);
+    void requestNextChunks();
+    void requestChunk(int chunk);
+    void handleChunkReply(int chunk, bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data);
+    void finishChunks();
+    void finish(Error error);
+    QUrl getChunkUrl(int chunk) const { return AssetUtils::getATPUrl(_chunks[chunk].hash.toHex()); }
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -70,6 +90,12 @@ private:
     QByteArray _data;
     int _numPendingRequests { 0 };
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
+    std::vector<Chunk> _chunks;
+    AssetUtils::DataOffset _chunkSize { 0 };
+    int _nextChunk { 0 };
+    int _numChunksInFlight { 0 };
+    int _numChunksReceived { 0 };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
 };
@@ -83,6 +83,7 @@ QByteArray hashData(const QByteArray& data);
 
 QByteArray loadFromCache(const QUrl& url);
 bool saveToCache(const QUrl& url, const QByteArray& file);
+void removeFromCache(const QUrl& url);
 
 bool isValidFilePath(const AssetPath& path);
 bool isValidPath(const AssetPath& path);
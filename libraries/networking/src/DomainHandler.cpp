@@ -92,14 +92,20 @@ void DomainHandler::sendDisconnectPacket() {
     // The DomainDisconnect packet is not verified - we're relying on the eventual addition of DTLS to the
     // domain-server connection to stop greifing here
 
-    // construct the disconnect packet once (an empty packet but sourced with our current session UUID)
-    static auto disconnectPacket = NLPacket::create(PacketType::DomainDisconnectRequest, 0);
+    // an empty packet but sourced with our current session UUID, not shared since the node lists of a crowd client
+    // send theirs on different threads
+    auto disconnectPacket = NLPacket::create(PacketType::DomainDisconnectRequest, 0);
 
     // send the disconnect packet to the current domain server
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto nodeList = getNodeList();
     nodeList->sendUnreliablePacket(*disconnectPacket, _sockAddr);
 }
 
+NodeList* DomainHandler::getNodeList() const {
+    auto nodeList = qobject_cast<NodeList*>(parent());
+    return nodeList ? nodeList : DependencyManager::get<NodeList>().data();
+}
+
 void DomainHandler::clearSettings() {
     _settingsObject = QJsonObject();
 }
@@ -179,7 +185,7 @@ void DomainHandler::setSockAddr(const HifiSockAddr& sockAddr, const QString& hos
     }
 
     if (!_sockAddr.isNull()) {
-        DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+        getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
     }
 
     // some callers may pass a hostname, this is not to be used for lookup but for DTLS certificate verification
@@ -236,7 +242,7 @@ void DomainHandler::setURLAndID(QUrl domainURL, QUuid domainID) {
                     QHostInfo::lookupHost(domainURL.host(), this, SLOT(completedHostnameLookup(const QHostInfo&)));
                 }
 
-                DependencyManager::get<NodeList>()->flagTimeForConnectionStep(
+                getNodeList()->flagTimeForConnectionStep(
                     LimitedNodeList::ConnectionStep::SetDomainHostname);
 
                 UserActivityLogger::getInstance().changedDomain(domainURL.host());
@@ -285,7 +291,7 @@ void DomainHandler::setIceServerHostnameAndID(const QString& iceServerHostname,
         replaceableSockAddr = new (replaceableSockAddr) HifiSockAddr(iceServerHostname, ICE_SERVER_DEFAULT_PORT);
         _iceServerSockAddr.setObjectName("IceServer");
 
-        auto nodeList = DependencyManager::get<NodeList>();
+        auto nodeList = getNodeList();
 
         nodeList->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetICEServerHostname);
 
@@ -301,7 +307,7 @@ void DomainHandler::setIceServerHostnameAndID(const QString& iceServerHostname,
 }
 
 void DomainHandler::activateICELocalSocket() {
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
     _sockAddr = _icePeer.getLocalSocket();
     _domainURL.setScheme(URL_SCHEME_HIFI);
     _domainURL.setHost(_sockAddr.getAddress().toString());
@@ -310,7 +316,7 @@ void DomainHandler::activateICELocalSocket() {
 }
 
 void DomainHandler::activateICEPublicSocket() {
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
     _sockAddr = _icePeer.getPublicSocket();
     _domainURL.setScheme(URL_SCHEME_HIFI);
     _domainURL.setHost(_sockAddr.getAddress().toString());
@@ -334,7 +340,7 @@ void DomainHandler::completedHostnameLookup(const QHostInfo& hostInfo) {
         if (hostInfo.addresses()[i].protocol() == QAbstractSocket::IPv4Protocol) {
             _sockAddr.setAddress(hostInfo.addresses()[i]);
 
-            DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
+            getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
 
             qCDebug(networking, "DS at %s is at %s", _domainURL.host().toLocal8Bit().constData(),
                    _sockAddr.getAddress().toString().toLocal8Bit().constData());
@@ -352,7 +358,7 @@ void DomainHandler::completedHostnameLookup(const QHostInfo& hostInfo) {
 void DomainHandler::completedIceServerHostnameLookup() {
     qCDebug(networking_ice) << "ICE server socket is at" << _iceServerSockAddr;
 
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetICEServerSocket);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetICEServerSocket);
 
     // emit our signal so we can send a heartbeat to ice-server immediately
     emit iceSocketAndIDReceived();
@@ -431,12 +437,12 @@ void DomainHandler::setRedirectErrorState(QUrl errorUrl, QString reasonMessage,
 void DomainHandler::requestDomainSettings() {
     qCDebug(networking) << "Requesting settings from domain server";
 
-    Assignment::Type assignmentType = Assignment::typeForNodeType(DependencyManager::get<NodeList>()->getOwnerType());
+    Assignment::Type assignmentType = Assignment::typeForNodeType(getNodeList()->getOwnerType());
 
     auto packet = NLPacket::create(PacketType::DomainSettingsRequest, sizeof(assignmentType), true, false);
     packet->writePrimitive(assignmentType);
 
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    auto nodeList = getNodeList();
     nodeList->sendPacket(std::move(packet), _sockAddr);
 
     _settingsTimer.start();
@@ -504,7 +510,7 @@ void DomainHandler::processICEResponsePacket(QSharedPointer<ReceivedMessage> mes
 
     iceResponseStream >> _icePeer;
 
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSPeerInformation);
+    getNodeList()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSPeerInformation);
 
     if (_icePeer.getUUID() != _pendingDomainID) {
         qCDebug(networking_ice) << "Received a network peer with ID that does not match current domain. Will not attempt connection.";
@@ -655,7 +661,7 @@ bool DomainHandler::checkInPacketTimeout() {
         qCDebug(networking_ice) << "Silent domain checkins:" << _checkInPacketsSinceLastReply;
     }
 
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto nodeList = getNodeList();
 
     if (_checkInPacketsSinceLastReply > SILENT_DOMAIN_TRAFFIC_DROP_MIN) {
         qCDebug(networking_ice) << _checkInPacketsSinceLastReply << "seconds since last domain list request, squelching traffic";
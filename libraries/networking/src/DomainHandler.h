@@ -84,6 +84,8 @@ const quint16 DOMAIN_SERVER_METADATA_EXPORTER_PORT =
 
 const int MAX_SILENT_DOMAIN_SERVER_CHECK_INS = 5;
 
+class NodeList;
+
 class DomainHandler : public QObject {
     Q_OBJECT
 public:
@@ -282,6 +284,10 @@ private:
     void sendDisconnectPacket();
     void hardReset(QString reason);
 
+    // the node list this is the domain handler of, which isn't the DependencyManager's one for every client of a tool
+    // that connects a crowd of them
+    NodeList* getNodeList() const;
+
     bool isHardRefusal(int reasonCode);
 
     QUuid _uuid;
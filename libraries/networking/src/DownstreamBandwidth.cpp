@@ -0,0 +1,123 @@
+//
+//  DownstreamBandwidth.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DownstreamBandwidth.h"
+
+#include <algorithm>
+
+// the part of the capacity each stream keeps from the streams before it, if it needs it
+static const std::array<float, DownstreamBandwidth::NumStreams> MIN_SHARES {{ 0.0f, 0.15f, 0.10f, 0.05f }};
+// the room a stream gets to grow into over what it uses
+static const float USAGE_HEADROOM = 1.25f;
+static const float USAGE_GROWTH_KBPS = 32.0f;
+
+// the smoothed loss over which the link is taken to be full, and under which it is clean enough to grow the capacity
+static const float CONGESTED_LOSS_RATIO = 0.02f;
+static const float CLEAN_LOSS_RATIO = 0.005f;
+static const float LOSS_RATIO_SMOOTHING = 0.5f;
+// fewer packets in a sample are too few to tell the loss from
+static const int MIN_PACKETS_FOR_LOSS = 50;
+static const float CONGESTED_CAPACITY_RATIO = 0.9f;
+static const float CAPACITY_GROWTH = 1.05f;
+// the capacity only grows while the streams are held back by it
+static const float USED_CAPACITY_RATIO = 0.8f;
+static const float MIN_CAPACITY_KBPS = 128.0f;
+
+bool DownstreamBandwidth::streamForNodeType(NodeType_t nodeType, Stream& stream) {
+    switch (nodeType) {
+        case NodeType::AudioMixer:
+            stream = Audio;
+            return true;
+        case NodeType::AvatarMixer:
+            stream = Avatars;
+            return true;
+        case NodeType::EntityServer:
+            stream = Entities;
+            return true;
+        case NodeType::AssetServer:
+            stream = Assets;
+            return true;
+        default:
+            return false;
+    }
+}
+
+float DownstreamBandwidth::getShareKbps(Stream stream) const {
+    if (capacityKbps <= 0.0f || stream >= NumStreams) {
+        return 0.0f;
+    }
+
+    auto demandKbps = [this](int i) {
+        return usageKbps[i] * USAGE_HEADROOM + USAGE_GROWTH_KBPS;
+    };
+
+    float remainingKbps = capacityKbps;
+    for (int i = 0; i < NumStreams; ++i) {
+        float reservedKbps = 0.0f;
+        for (int later = i + 1; later < NumStreams; ++later) {
+            reservedKbps += std::min(MIN_SHARES[later] * capacityKbps, demandKbps(later));
+        }
+
+        float availableKbps = std::max(remainingKbps - reservedKbps, 0.0f);
+        float shareKbps = i == NumStreams - 1 ? availableKbps : std::min(demandKbps(i), availableKbps);
+        if (i == stream) {
+            return shareKbps;
+        }
+        remainingKbps -= shareKbps;
+    }
+    return 0.0f;
+}
+
+QDataStream& operator<<(QDataStream& out, const DownstreamBandwidth& bandwidth) {
+    out << bandwidth.capacityKbps;
+    for (float usage : bandwidth.usageKbps) {
+        out << usage;
+    }
+    return out;
+}
+
+QDataStream& operator>>(QDataStream& in, DownstreamBandwidth& bandwidth) {
+    // the rates come from the client, anything but a positive rate counts as none
+    auto readRate = [&in]() {
+        float rate = 0.0f;
+        in >> rate;
+        return rate > 0.0f ? rate : 0.0f;
+    };
+
+    bandwidth.capacityKbps = readRate();
+    for (float& usage : bandwidth.usageKbps) {
+        usage = readRate();
+    }
+    if (in.status() != QDataStream::Ok) {
+        bandwidth = DownstreamBandwidth();
+    }
+    return in;
+}
+
+float DownstreamBandwidthEstimator::update(float receivedKbps, int receivedPackets, int lostPackets) {
+    int numPackets = receivedPackets + lostPackets;
+    if (numPackets < MIN_PACKETS_FOR_LOSS) {
+        return _capacityKbps;
+    }
+
+    float lossRatio = (float)lostPackets / (float)numPackets;
+    _lossRatio = LOSS_RATIO_SMOOTHING * _lossRatio + (1.0f - LOSS_RATIO_SMOOTHING) * lossRatio;
+
+    if (_lossRatio > CONGESTED_LOSS_RATIO) {
+        _capacityKbps = std::max(receivedKbps * CONGESTED_CAPACITY_RATIO, MIN_CAPACITY_KBPS);
+        // the next sample tells on its own whether the streams have backed off far enough
+        _lossRatio = 0.0f;
+    } else if (_capacityKbps > 0.0f && _lossRatio < CLEAN_LOSS_RATIO &&
+               receivedKbps > USED_CAPACITY_RATIO * _capacityKbps) {
+        _capacityKbps *= CAPACITY_GROWTH;
+    }
+    return _capacityKbps;
+}
@@ -0,0 +1,65 @@
+//
+//  DownstreamBandwidth.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DownstreamBandwidth_h
+#define hifi_DownstreamBandwidth_h
+
+#include <array>
+
+#include <QtCore/QDataStream>
+
+#include "NodeType.h"
+
+// What a client's link has room for from the assignments it is connected to, and how much of it each of their streams
+// takes. Each assignment rate limits its stream on its own, so a client on a weak link gets overrun by their sum and the
+// loss hurts the audio most. The client, the only one to see all the streams, reports this to each of them every second
+// and each keeps to the share of its stream: audio first, then avatars, then entities and assets.
+class DownstreamBandwidth {
+public:
+    enum Stream : quint8 {
+        Audio,
+        Avatars,
+        Entities,
+        Assets,
+        NumStreams
+    };
+
+    // the stream an assignment of the node type sends, false for the types that don't send clients one
+    static bool streamForNodeType(NodeType_t nodeType, Stream& stream);
+
+    float capacityKbps { 0.0f }; // 0 while the client hasn't seen its link congested
+    std::array<float, NumStreams> usageKbps {{ 0.0f, 0.0f, 0.0f, 0.0f }};
+
+    // The rate the stream should keep to, 0 for no limit. Each stream gets what it uses and some room to grow, in the
+    // order of the streams, and the last what is left. The streams after it keep a minimum part of the capacity, if they
+    // need it, so that none starves.
+    float getShareKbps(Stream stream) const;
+
+    friend QDataStream& operator<<(QDataStream& out, const DownstreamBandwidth& bandwidth);
+    friend QDataStream& operator>>(QDataStream& in, DownstreamBandwidth& bandwidth);
+};
+
+// Estimates the capacity of a client's link from what it receives from all the nodes. The link is taken to be full when
+// some of it is lost - right away the capacity is set under what still got through, then it grows slowly back while
+// the streams use most of it without loss, so that they find out when the link gets better.
+class DownstreamBandwidthEstimator {
+public:
+    // fed about once a second with what was received since the previous sample, returns the capacity
+    float update(float receivedKbps, int receivedPackets, int lostPackets);
+
+    float getCapacityKbps() const { return _capacityKbps; }
+
+private:
+    float _capacityKbps { 0.0f };
+    float _lossRatio { 0.0f }; // smoothed across the samples
+};
+
+#endif // hifi_DownstreamBandwidth_h
@@ -11,10 +11,13 @@
 
 #include "HTTPResourceRequest.h"
 
+#include <mutex>
+
 #include <QFile>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QMetaEnum>
+#include <QPointer>
 
 #include <SharedUtil.h>
 #include <StatTracker.h>
@@ -23,12 +26,69 @@
 #include "NetworkLogging.h"
 #include "NetworkingConstants.h"
 
+static const char* SHARED_DATA_PROPERTY = "sharedData";
+static const char* SHARED_REQUESTS_PROPERTY = "sharedRequests";
+
+// the requests for the same thing while it is in flight, several models using the same texture say, share its reply
+// replies belong to the network access manager of their thread, which is per thread
+static thread_local QHash<QString, QPointer<QNetworkReply>> inFlightReplies;
+
+static std::mutex originStatsMutex;
+static QHash<QString, HTTPResourceRequest::OriginStats> originStats;
+
 HTTPResourceRequest::~HTTPResourceRequest() {
     if (_reply) {
-        _reply->disconnect(this);
+        releaseReply(false);
+    }
+}
+
+QHash<QString, HTTPResourceRequest::OriginStats> HTTPResourceRequest::getOriginStats() {
+    std::lock_guard<std::mutex> lock(originStatsMutex);
+    return originStats;
+}
+
+void HTTPResourceRequest::recordOriginStats(bool isShared, bool isFailed, qint64 bytesReceived) {
+    bool usedHTTP2 = _reply && _reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+
+    std::lock_guard<std::mutex> lock(originStatsMutex);
+    auto& stats = originStats[_url.host()];
+    if (isShared) {
+        stats.requests++;
+        stats.sharedRequests++;
+    } else if (isFailed) {
+        stats.failedRequests++;
+    } else {
+        stats.bytesReceived += bytesReceived;
+        stats.usedHTTP2 |= usedHTTP2;
+    }
+}
+
+QString HTTPResourceRequest::getSharedReplyKey() const {
+    return _url.toString(QUrl::FullyEncoded) + "|" + QString::number(_byteRange.fromInclusive) + "-" +
+        QString::number(_byteRange.toExclusive) + (_cacheEnabled ? "|cache" : "|network");
+}
+
+QByteArray HTTPResourceRequest::readSharedData() {
+    // the reply is read once, for all the requests sharing it
+    auto data = _reply->property(SHARED_DATA_PROPERTY);
+    if (!data.isValid()) {
+        data = _reply->readAll();
+        _reply->setProperty(SHARED_DATA_PROPERTY, data);
+    }
+    return data.toByteArray();
+}
+
+void HTTPResourceRequest::releaseReply(bool abort) {
+    _reply->disconnect(this);
+    int sharedRequests = _reply->property(SHARED_REQUESTS_PROPERTY).toInt() - 1;
+    _reply->setProperty(SHARED_REQUESTS_PROPERTY, sharedRequests);
+    if (sharedRequests <= 0) {
+        if (abort) {
+            _reply->abort();
+        }
         _reply->deleteLater();
-        _reply = nullptr;
     }
+    _reply = nullptr;
 }
 
 void HTTPResourceRequest::setupTimer() {
@@ -75,8 +135,34 @@ void HTTPResourceRequest::doSend() {
     }
     networkRequest.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, false);
 
-    _reply = NetworkAccessManager::getInstance().get(networkRequest);
-    
+    // servers that support HTTP/2 get all the requests to them over a single connection, with no head-of-line blocking
+    networkRequest.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+
+    auto key = getSharedReplyKey();
+    auto sharedReply = inFlightReplies.value(key);
+    if (sharedReply && !sharedReply->isFinished()) {
+        _reply = sharedReply.data();
+        _reply->setProperty(SHARED_REQUESTS_PROPERTY, _reply->property(SHARED_REQUESTS_PROPERTY).toInt() + 1);
+        DependencyManager::get<StatTracker>()->incrementStat(STAT_HTTP_REQUEST_SHARED);
+        recordOriginStats(true, false, 0);
+    } else {
+        _reply = NetworkAccessManager::getInstance().get(networkRequest);
+        _reply->setProperty(SHARED_REQUESTS_PROPERTY, 1);
+        inFlightReplies.insert(key, _reply);
+        {
+            std::lock_guard<std::mutex> lock(originStatsMutex);
+            originStats[_url.host()].requests++;
+        }
+
+        // connected first so that no request joins the reply once it is finished
+        QPointer<QNetworkReply> reply = _reply;
+        connect(_reply, &QNetworkReply::finished, _reply, [key, reply] {
+            if (inFlightReplies.value(key) == reply) {
+                inFlightReplies.remove(key);
+            }
+        });
+    }
+
     connect(_reply, &QNetworkReply::finished, this, &HTTPResourceRequest::onRequestFinished);
     connect(_reply, &QNetworkReply::downloadProgress, this, &HTTPResourceRequest::onDownloadProgress);
 
@@ -127,7 +213,7 @@ void HTTPResourceRequest::onRequestFinished() {
 
     switch(_reply->error()) {
         case QNetworkReply::NoError:
-            _data = _reply->readAll();
+            _data = readSharedData();
             _loadedFromCache = _reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
             _result = Success;
 
@@ -197,9 +283,12 @@ void HTTPResourceRequest::onRequestFinished() {
             _result = Error;
             break;
     }
-    _reply->disconnect(this);
-    _reply->deleteLater();
-    _reply = nullptr;
+
+    // the stats of a shared reply are recorded once, by the last request to finish with it
+    if (_reply->property(SHARED_REQUESTS_PROPERTY).toInt() <= 1) {
+        recordOriginStats(false, _result != Success, _data.size());
+    }
+    releaseReply(false);
     
     _state = Finished;
     emit finished();
@@ -230,10 +319,8 @@ void HTTPResourceRequest::onDownloadProgress(qint64 bytesReceived, qint64 bytesT
 void HTTPResourceRequest::onTimeout() {
     qDebug() << "Timeout: " << _reply->isFinished();
     Q_ASSERT(_state == InProgress);
-    _reply->disconnect(this);
-    _reply->abort();
-    _reply->deleteLater();
-    _reply = nullptr;
+    recordOriginStats(false, true, 0);
+    releaseReply(true);
 
     cleanupTimer();
     
@@ -12,6 +12,7 @@
 #ifndef hifi_HTTPResourceRequest_h
 #define hifi_HTTPResourceRequest_h
 
+#include <QHash>
 #include <QNetworkReply>
 #include <QUrl>
 #include <QTimer>
@@ -29,6 +30,15 @@ public:
     ) : ResourceRequest(url, isObservable, callerId) { }
     ~HTTPResourceRequest();
 
+    struct OriginStats {
+        int requests { 0 };
+        int sharedRequests { 0 }; // that joined a reply already in flight for the same URL
+        int failedRequests { 0 };
+        qint64 bytesReceived { 0 };
+        bool usedHTTP2 { false };
+    };
+    static QHash<QString, OriginStats> getOriginStats();
+
 protected:
     virtual void doSend() override;
 
@@ -40,6 +50,10 @@ private slots:
 private:
     void setupTimer();
     void cleanupTimer();
+    QString getSharedReplyKey() const;
+    QByteArray readSharedData();
+    void releaseReply(bool abort);
+    void recordOriginStats(bool isShared, bool isFailed, qint64 bytesReceived);
 
     QTimer* _sendTimer { nullptr };
     QNetworkReply* _reply { nullptr };
@@ -18,6 +18,8 @@
 #include <QtCore/QDataStream>
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMutex>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 #include <QtCore/QUrl>
 #include <QtNetwork/QTcpSocket>
@@ -36,7 +38,7 @@
 #include "HifiSockAddr.h"
 #include "NetworkLogging.h"
 #include "udt/Packet.h"
-#include "HMACAuth.h"
+#include "PacketAuth.h"
 
 #if defined(Q_OS_WIN)
 #include <winsock.h>
@@ -46,6 +48,9 @@
 
 static Setting::Handle<quint16> LIMITED_NODELIST_LOCAL_PORT("LimitedNodeList.LocalPort", 0);
 
+static const QString RECEIVE_SHARDS_ENV = "HIFI_UDT_RECEIVE_SHARDS";
+static const QString CONGESTION_CONTROL_ENV = "HIFI_UDT_CONGESTION_CONTROL";
+
 using namespace std::chrono_literals;
 static const std::chrono::milliseconds CONNECTION_RATE_INTERVAL_MS = 1s;
 
@@ -54,6 +59,42 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     _packetReceiver(new PacketReceiver(this))
 {
     qRegisterMetaType<ConnectionStep>("ConnectionStep");
+
+    // the socket handlers are set before binding since receive shards start reading as soon as the port is bound
+
+    // set &PacketReceiver::handleVerifiedPacket as the verified packet callback for the udt::Socket
+    _nodeSocket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+            _packetReceiver->handleVerifiedPacket(std::move(packet));
+    });
+    _nodeSocket.setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
+            _packetReceiver->handleVerifiedMessagePacket(std::move(packet));
+    });
+    _nodeSocket.setMessageFailureHandler([this](HifiSockAddr from,
+                                                udt::Packet::MessageNumber messageNumber) {
+            _packetReceiver->handleMessageFailure(from, messageNumber);
+    });
+
+    // set our isPacketVerified method as the verify operator for the udt::Socket
+    using std::placeholders::_1;
+    _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
+
+    // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
+    _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
+
+    // optionally spread receives over several SO_REUSEPORT sockets, each read on its own thread
+    static const int numReceiveShards = QProcessEnvironment::systemEnvironment().value(RECEIVE_SHARDS_ENV, "1").toInt();
+    if (numReceiveShards > 1) {
+        _nodeSocket.setNumReceiveShards(numReceiveShards);
+    }
+
+    // TCP Vegas unless BBR is asked for, so that the two can be compared on real links
+    static const QString congestionControl = QProcessEnvironment::systemEnvironment().value(CONGESTION_CONTROL_ENV, "vegas");
+    if (congestionControl == "bbr") {
+        qCDebug(networking) << "NodeList socket is using BBR congestion control";
+        _nodeSocket.setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::BBRCC>()));
+    }
+
     auto port = (socketListenPort != INVALID_PORT) ? socketListenPort : LIMITED_NODELIST_LOCAL_PORT.get();
     _nodeSocket.bind(QHostAddress::AnyIPv4, port);
     quint16 assignedPort = _nodeSocket.localPort();
@@ -96,25 +137,6 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     // check the local socket right now
     updateLocalSocket();
 
-    // set &PacketReceiver::handleVerifiedPacket as the verified packet callback for the udt::Socket
-    _nodeSocket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
-            _packetReceiver->handleVerifiedPacket(std::move(packet));
-    });
-    _nodeSocket.setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
-            _packetReceiver->handleVerifiedMessagePacket(std::move(packet));
-    });
-    _nodeSocket.setMessageFailureHandler([this](HifiSockAddr from,
-                                                udt::Packet::MessageNumber messageNumber) {
-            _packetReceiver->handleMessageFailure(from, messageNumber);
-    });
-
-    // set our isPacketVerified method as the verify operator for the udt::Socket
-    using std::placeholders::_1;
-    _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
-
-    // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
-    _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
-
     // handle when a socket connection has its receiver side reset - might need to emit clientConnectionToNodeReset
     connect(&_nodeSocket, &udt::Socket::clientHandshakeRequestComplete, this, &LimitedNodeList::clientConnectionToSockAddrReset);
 
@@ -250,6 +272,10 @@ bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
         static QMultiHash<QUuid, PacketType> sourcedVersionDebugSuppressMap;
         static QMultiHash<HifiSockAddr, PacketType> versionDebugSuppressMap;
 
+        // packets can be verified on the receive shard threads
+        static QMutex versionDebugSuppressMutex;
+        QMutexLocker versionDebugSuppressLocker(&versionDebugSuppressMutex);
+
         bool hasBeenOutput = false;
         QString senderString;
         const HifiSockAddr& senderSockAddr = packet.getSenderSockAddr();
@@ -351,21 +377,24 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
 
             if (verifiedPacket && verificationEnabled) {
 
-                QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
-                QByteArray expectedHash;
-                auto sourceNodeHMACAuth = sourceNode->getAuthenticateHash();
-                if (sourceNode->getAuthenticateHash()) {
-                    expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
+                PacketAuth::Hash packetHeaderHash = NLPacket::verificationHashInHeader(packet);
+                PacketAuth::Hash expectedHash {};
+                auto sourceNodeAuth = sourceNode->getAuthenticateHash();
+                if (sourceNodeAuth) {
+                    expectedHash = NLPacket::hashForPacket(packet, *sourceNodeAuth);
                 }
 
-                // check if the HMAC-md5 hash in the header matches the hash we would expect
-                if (!sourceNodeHMACAuth || packetHeaderHash != expectedHash) {
+                // check if the hash in the header matches the hash we would expect
+                if (!sourceNodeAuth || packetHeaderHash != expectedHash) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
+                    static QMutex hashDebugSuppressMutex;
+                    QMutexLocker hashDebugSuppressLocker(&hashDebugSuppressMutex);
 
                     if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
                         qCDebug(networking) << "Packet hash mismatch on" << headerType << "- Sender" << sourceID;
                         qCDebug(networking) << "Packet len:" << packet.getDataSize() << "Expected hash:" <<
-                            expectedHash.toHex() << "Actual:" << packetHeaderHash.toHex();
+                            QByteArray((const char*)expectedHash.data(), (int)expectedHash.size()).toHex() << "Actual:" <<
+                            QByteArray((const char*)packetHeaderHash.data(), (int)packetHeaderHash.size()).toHex();
 
                         hashDebugSuppressMap.insert(sourceID, headerType);
                     }
@@ -389,15 +418,15 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
     return false;
 }
 
-void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth) {
+void LimitedNodeList::fillPacketHeader(const NLPacket& packet, PacketAuth* packetAuth) {
     if (!PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())) {
         packet.writeSourceID(getSessionLocalID());
     }
 
-    if (_useAuthentication && hmacAuth
+    if (_useAuthentication && packetAuth
         && !PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())
         && !PacketTypeEnum::getNonVerifiedPackets().contains(packet.getType())) {
-        packet.writeVerificationHash(*hmacAuth);
+        packet.writeVerificationHash(*packetAuth);
     }
 }
 
@@ -414,7 +443,7 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const Node&
 }
 
 qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr,
-        HMACAuth* hmacAuth) {
+        PacketAuth* packetAuth) {
     Q_ASSERT(!packet.isPartOfMessage());
     Q_ASSERT_X(!packet.isReliable(), "LimitedNodeList::sendUnreliablePacket",
                "Trying to send a reliable packet unreliably.");
@@ -429,7 +458,7 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const HifiS
         }
     }
 
-    fillPacketHeader(packet, hmacAuth);
+    fillPacketHeader(packet, packetAuth);
 
     return _nodeSocket.writePacket(packet, sockAddr);
 }
@@ -447,17 +476,17 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node&
 }
 
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr,
-                                   HMACAuth* hmacAuth) {
+                                   PacketAuth* packetAuth) {
     Q_ASSERT(!packet->isPartOfMessage());
     if (packet->isReliable()) {
-        fillPacketHeader(*packet, hmacAuth);
+        fillPacketHeader(*packet, packetAuth);
 
         auto size = packet->getDataSize();
         _nodeSocket.writePacket(std::move(packet), sockAddr);
 
         return size;
     } else {
-        auto size = sendUnreliablePacket(*packet, sockAddr, hmacAuth);
+        auto size = sendUnreliablePacket(*packet, sockAddr, packetAuth);
         if (size < 0) {
             auto now = usecTimestampNow();
             if (now - _sendErrorStatsTime > ERROR_STATS_PERIOD_US) {
@@ -498,14 +527,14 @@ qint64 LimitedNodeList::sendUnreliableUnorderedPacketList(NLPacketList& packetLi
 }
 
 qint64 LimitedNodeList::sendUnreliableUnorderedPacketList(NLPacketList& packetList, const HifiSockAddr& sockAddr,
-                                                          HMACAuth* hmacAuth) {
+                                                          PacketAuth* packetAuth) {
     qint64 bytesSent = 0;
 
     // close the last packet in the list
     packetList.closeCurrentPacket();
 
     while (!packetList._packets.empty()) {
-        bytesSent += sendPacket(packetList.takeFront<NLPacket>(), sockAddr, hmacAuth);
+        bytesSent += sendPacket(packetList.takeFront<NLPacket>(), sockAddr, packetAuth);
     }
 
     return bytesSent;
@@ -580,6 +609,38 @@ NodeData* LimitedNodeList::getOrCreateLinkedData(SharedNodePointer node) {
     return node->getLinkedData();
 }
 
+void LimitedNodeList::rebuildNodeSnapshot() {
+    auto snapshot = std::make_shared<NodeSnapshot>();
+
+    QReadLocker readLocker(&_nodeMutex);
+    std::lock_guard<std::mutex> snapshotLock(_nodeSnapshotMutex);
+
+    // inserts only hold a read lock, so the hash can grow while we copy it
+    snapshot->nodes.reserve(_nodeHash.size());
+    snapshot->linkedData.reserve(_nodeHash.size());
+    for (const auto& pair : _nodeHash) {
+        snapshot->nodes.push_back(pair.second);
+        snapshot->linkedData.push_back(pair.second->getLinkedData());
+    }
+
+    std::atomic_store(&_nodeSnapshot, NodeSnapshotPointer(std::move(snapshot)));
+}
+
+void LimitedNodeList::refreshNodeSnapshotLinkedData() {
+    // called with the node mutex of the changed node held, so this must not take _nodeMutex
+    std::lock_guard<std::mutex> snapshotLock(_nodeSnapshotMutex);
+    auto current = std::atomic_load(&_nodeSnapshot);
+
+    auto snapshot = std::make_shared<NodeSnapshot>();
+    snapshot->nodes = current->nodes;
+    snapshot->linkedData.reserve(snapshot->nodes.size());
+    for (const auto& node : snapshot->nodes) {
+        snapshot->linkedData.push_back(node->getLinkedData());
+    }
+
+    std::atomic_store(&_nodeSnapshot, NodeSnapshotPointer(std::move(snapshot)));
+}
+
 SharedNodePointer LimitedNodeList::nodeWithUUID(const QUuid& nodeUUID) {
     QReadLocker readLocker(&_nodeMutex);
 
@@ -614,6 +675,8 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
         _nodeHash.clear();
     }
 
+    rebuildNodeSnapshot();
+
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         handleNodeKill(killedNode);
     }
@@ -639,6 +702,7 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID, ConnectionID newCo
             _nodeHash.unsafe_erase(matchingNode->getUUID());
         }
 
+        rebuildNodeSnapshot();
         handleNodeKill(matchingNode, newConnectionID);
         return true;
     }
@@ -698,20 +762,38 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
                 _localIDMap.unsafe_erase(node->getLocalID());
                 _nodeHash.unsafe_erase(node->getUUID());
             }
+            rebuildNodeSnapshot();
             handleNodeKill(node);
         }
     };
 
+    // the avatars relayed by an upstream mixer, or hosted by an agent, share the address of the node that sends them,
+    // they neither replace the node at that address nor get replaced by it
+    auto isRelayedAvatar = [](const Node& node) {
+        return node.getType() == NodeType::Agent && node.isUpstream();
+    };
+    auto findConnectedNodeWithAddr = [&](const HifiSockAddr& addr) {
+        QReadLocker locker(&_nodeMutex);
+        auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&](const UUIDNodePair& pair) {
+            return !isRelayedAvatar(*pair.second) && (pair.second->getPublicSocket() == addr
+                || pair.second->getLocalSocket() == addr
+                || pair.second->getSymmetricSocket() == addr);
+        });
+        return (it != std::end(_nodeHash)) ? it->second : SharedNodePointer();
+    };
+
     // if this is a solo node type, we assume that the DS has replaced its assignment and we should kill the previous node
     if (SOLO_NODE_TYPES.count(nodeType)) {
         removeOldNode(soloNodeOfType(nodeType));
     }
-    // If there is a new node with the same socket, this is a reconnection, kill the old node
-    removeOldNode(findNodeWithAddr(publicSocket));
-    removeOldNode(findNodeWithAddr(localSocket));
-    // If there is an old Connection to the new node's address kill it
-    _nodeSocket.cleanupConnection(publicSocket);
-    _nodeSocket.cleanupConnection(localSocket);
+    if (!(nodeType == NodeType::Agent && isUpstream)) {
+        // If there is a new node with the same socket, this is a reconnection, kill the old node
+        removeOldNode(findConnectedNodeWithAddr(publicSocket));
+        removeOldNode(findConnectedNodeWithAddr(localSocket));
+        // If there is an old Connection to the new node's address kill it
+        _nodeSocket.cleanupConnection(publicSocket);
+        _nodeSocket.cleanupConnection(localSocket);
+    }
 
     auto it = _connectionIDs.find(uuid);
     if (it == _connectionIDs.end()) {
@@ -729,6 +811,9 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
     // move the newly constructed node to the LNL thread
     newNode->moveToThread(thread());
 
+    // linked data is usually created later, by the first packet from the node, so republish when it changes
+    connect(newNode, &Node::linkedDataChanged, this, &LimitedNodeList::refreshNodeSnapshotLinkedData, Qt::DirectConnection);
+
     if (nodeType == NodeType::AudioMixer) {
         LimitedNodeList::flagTimeForConnectionStep(LimitedNodeList::AddedAudioMixer);
     }
@@ -743,6 +828,8 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         _localIDMap.insert({ localID, newNodePointer });
     }
 
+    rebuildNodeSnapshot();
+
     qCDebug(networking) << "Added" << *newNode;
 
     auto weakPtr = newNodePointer.toWeakRef(); // We don't want the lambdas to hold a strong ref
@@ -917,6 +1004,10 @@ void LimitedNodeList::removeSilentNodes() {
         node->getMutex().unlock();
     });
 
+    if (!killedNodes.isEmpty()) {
+        rebuildNodeSnapshot();
+    }
+
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         auto now = usecTimestampNow();
         qCDebug(networking_ice) << "Removing silent node" << *killedNode << "\n"
@@ -976,6 +1067,23 @@ void LimitedNodeList::sampleConnectionStats() {
         _inboundKbps = 0.0f;
         _outboundKbps = 0.0f;
     }
+
+    auto socketStats = _nodeSocket.sampleSocketStats();
+    if (socketStats.receiveBatches > 0) {
+        _averageReceiveBatchSize = (float)socketStats.receiveBatchedPackets / socketStats.receiveBatches;
+    } else {
+        _averageReceiveBatchSize = 0.0f;
+    }
+    _maxReceiveBatchSize = socketStats.maxReceiveBatchSize;
+
+    if (socketStats.sendBatches > 0) {
+        _averageSendBatchSize = (float)socketStats.sendBatchedPackets / socketStats.sendBatches;
+    } else {
+        _averageSendBatchSize = 0.0f;
+    }
+    _maxSendBatchSize = socketStats.maxSendBatchSize;
+
+    emit connectionStatsSampled();
 }
 
 const uint32_t RFC_5389_MAGIC_COOKIE = 0x2112A442;
@@ -17,8 +17,10 @@
 #include <stdint.h>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <unistd.h> // not on windows, not needed for mac or windows
@@ -75,6 +77,15 @@ const ConnectionID INITIAL_CONNECTION_ID { 0 };
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef tbb::concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
 
+// Immutable copy of the node list that can be iterated from any thread without taking the node mutex.
+// A new snapshot is published whenever a node is added or removed or a node's linked data is replaced; a reader keeps
+// the snapshot it loaded, and every node in it, alive for as long as it holds on to it.
+struct NodeSnapshot {
+    std::vector<SharedNodePointer> nodes;
+    std::vector<NodeData*> linkedData; // linked data of nodes[i] when the snapshot was published
+};
+using NodeSnapshotPointer = std::shared_ptr<const NodeSnapshot>;
+
 typedef quint8 PingType_t;
 namespace PingType {
     const PingType_t Agnostic = 0;
@@ -150,17 +161,17 @@ public:
     // use sendUnreliablePacket to send an unreliable packet (that you do not need to move)
     // either to a node (via its active socket) or to a manual sockaddr
     qint64 sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode);
-    qint64 sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr, HMACAuth* hmacAuth = nullptr);
+    qint64 sendUnreliablePacket(const NLPacket& packet, const HifiSockAddr& sockAddr, PacketAuth* packetAuth = nullptr);
 
     // use sendPacket to send a moved unreliable or reliable NL packet to a node's active socket or manual sockaddr
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode);
-    qint64 sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr, HMACAuth* hmacAuth = nullptr);
+    qint64 sendPacket(std::unique_ptr<NLPacket> packet, const HifiSockAddr& sockAddr, PacketAuth* packetAuth = nullptr);
 
     // use sendUnreliableUnorderedPacketList to unreliably send separate packets from the packet list
     // either to a node's active socket or to a manual sockaddr
     qint64 sendUnreliableUnorderedPacketList(NLPacketList& packetList, const Node& destinationNode);
     qint64 sendUnreliableUnorderedPacketList(NLPacketList& packetList, const HifiSockAddr& sockAddr,
-        HMACAuth* hmacAuth = nullptr);
+        PacketAuth* packetAuth = nullptr);
 
     // use sendPacketList to send reliable packet lists (ordered or unordered) to a node's active socket
     // or to a manual sock addr
@@ -208,73 +219,63 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    // the most recently published node snapshot, safe to iterate with no lock held
+    NodeSnapshotPointer getNodeSnapshot() const { return std::atomic_load(&_nodeSnapshot); }
+
+    // Cede control of iteration over a single node snapshot (e.g. for use by thread pools)
+    //   The iterators stay valid for the duration of the functor, and since no lock is held
+    //   a dying node never has to wait for the pool to finish before it can be removed
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor,
                     int* lockWaitOut = nullptr,
                     int* nodeTransformOut = nullptr,
                     int* functorOut = nullptr) {
-        quint64 start, endTransform, endFunctor;
+        quint64 start, endSnapshot, endFunctor;
 
         start = usecTimestampNow();
-        std::vector<SharedNodePointer> nodes;
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
-
-            // Size of _nodeHash could change at any time,
-            // so reserve enough memory for the current size
-            // and then back insert all the nodes found
-            nodes.reserve(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes), [&](const NodeHash::value_type& it) {
-                return it.second;
-            });
-
-            endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        auto snapshot = getNodeSnapshot();
+        endSnapshot = usecTimestampNow();
+        if (lockWaitOut) {
+            *lockWaitOut = (endSnapshot - start);
+        }
+        if (nodeTransformOut) {
+            // the snapshot is already a contiguous array, there is nothing left to transform
+            *nodeTransformOut = 0;
         }
 
-        functor(nodes.cbegin(), nodes.cend());
+        functor(snapshot->nodes.cbegin(), snapshot->nodes.cend());
         endFunctor = usecTimestampNow();
         if (functorOut) {
-            *functorOut = (endFunctor - endTransform);
+            *functorOut = (endFunctor - endSnapshot);
         }
     }
 
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const auto& node : snapshot->nodes) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const auto& node : snapshot->nodes) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const auto& node : snapshot->nodes) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -282,25 +283,22 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        auto snapshot = getNodeSnapshot();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const auto& node : snapshot->nodes) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
         return SharedNodePointer();
     }
 
-    // This is unsafe because it does not take a lock
-    // Must only be called when you know that a read lock on the node mutex is held
-    // and will be held for the duration of your iteration
+    // Kept for callers that used to run nested inside a nestedEach read lock,
+    // iterating a snapshot is safe from anywhere so this is now the same as eachNode
     template<typename NodeLambda>
     void unsafeEachNode(NodeLambda functor) {
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
-        }
+        eachNode(functor);
     }
 
     void putLocalPortIntoSharedMemory(const QString key, QObject* parent, quint16 localPort);
@@ -312,7 +310,14 @@ public:
 
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
 
+    bool isUsingBatchedReceive() const { return _nodeSocket.isUsingBatchedReceive(); }
+    void setUseBatchedReceive(bool useBatchedReceive) { _nodeSocket.setUseBatchedReceive(useBatchedReceive); }
+    bool isUsingBatchedSend() const { return _nodeSocket.isUsingBatchedSend(); }
+    void setUseBatchedSend(bool useBatchedSend) { _nodeSocket.setUseBatchedSend(useBatchedSend); }
+    void flushSendBatch() { _nodeSocket.flushSendBatch(); }
+
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
+    void setPacingEngine(std::shared_ptr<udt::PacingEngine> pacingEngine) { _nodeSocket.setPacingEngine(std::move(pacingEngine)); }
 
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
@@ -338,6 +343,10 @@ public:
     int getOutboundPPS() const { return _outboundPPS; }
     float getInboundKbps() const { return _inboundKbps; }
     float getOutboundKbps() const { return _outboundKbps; }
+    float getAverageReceiveBatchSize() const { return _averageReceiveBatchSize; }
+    int getMaxReceiveBatchSize() const { return _maxReceiveBatchSize; }
+    float getAverageSendBatchSize() const { return _averageSendBatchSize; }
+    int getMaxSendBatchSize() const { return _maxSendBatchSize; }
 
     void setDropOutgoingNodeTraffic(bool squelchOutgoingNodeTraffic) { _dropOutgoingNodeTraffic = squelchOutgoingNodeTraffic; }
 
@@ -374,6 +383,8 @@ signals:
     void uuidChanged(const QUuid& ownerUUID, const QUuid& oldUUID);
     void nodeAdded(SharedNodePointer);
     void nodeSocketUpdated(SharedNodePointer);
+    // about once a second, once the connection stats of the nodes are updated
+    void connectionStatsSampled();
     void nodeKilled(SharedNodePointer);
     void nodeActivated(SharedNodePointer);
 
@@ -419,7 +430,7 @@ protected:
 
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode,
                       const HifiSockAddr& overridenSockAddr);
-    void fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth = nullptr);
+    void fillPacketHeader(const NLPacket& packet, PacketAuth* packetAuth = nullptr);
 
     void setLocalSocket(const HifiSockAddr& sockAddr);
 
@@ -440,8 +451,15 @@ protected:
     void removeDelayedAdd(QUuid nodeUUID);
     bool isDelayedNode(QUuid nodeUUID);
 
+    // publish a new node snapshot, must be called after every change to _nodeHash with no write lock held
+    void rebuildNodeSnapshot();
+    // publish a copy of the current snapshot with the linked data of its nodes re-read
+    void refreshNodeSnapshotLinkedData();
+
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex { QReadWriteLock::Recursive };
+    std::mutex _nodeSnapshotMutex; // serializes publishing, readers never take it
+    NodeSnapshotPointer _nodeSnapshot { std::make_shared<NodeSnapshot>() };
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket { nullptr };
     HifiSockAddr _localSockAddr;
@@ -501,6 +519,10 @@ private:
     int _outboundPPS { 0 };
     float _inboundKbps { 0.0f };
     float _outboundKbps { 0.0f };
+    float _averageReceiveBatchSize { 0.0f };
+    int _maxReceiveBatchSize { 0 };
+    float _averageSendBatchSize { 0.0f };
+    int _maxSendBatchSize { 0 };
 
     bool _dropOutgoingNodeTraffic { false };
 
@@ -167,6 +167,10 @@ public:
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
+    // encode a message once and wrap the same payload in a packet list per destination (e.g. when fanning out)
+    static QByteArray encodeMessagesPayload(QString channel, bool isText, QByteArray messageData, QUuid senderID);
+    static std::unique_ptr<NLPacketList> createMessagesPacketList(const QByteArray& payload);
+
 signals:
     /*@jsdoc
      * Triggered when a text message is received.
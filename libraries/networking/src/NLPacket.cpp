@@ -11,12 +11,14 @@
 
 #include "NLPacket.h"
 
-#include "HMACAuth.h"
+static_assert(PacketAuth::HASH_SIZE == NUM_BYTES_VERIFICATION_HASH, "the verification hash fills its header field");
 
 int NLPacket::localHeaderSize(PacketType type) {
     bool nonSourced = PacketTypeEnum::getNonSourcedPackets().contains(type);
     bool nonVerified = PacketTypeEnum::getNonVerifiedPackets().contains(type);
-    qint64 optionalSize = (nonSourced ? 0 : NUM_BYTES_LOCALID) + ((nonSourced || nonVerified) ? 0 : NUM_BYTES_MD5_HASH);
+    bool traced = PacketTypeEnum::getTracedPackets().contains(type);
+    qint64 optionalSize = (nonSourced ? 0 : NUM_BYTES_LOCALID) + ((nonSourced || nonVerified) ? 0 : NUM_BYTES_VERIFICATION_HASH) +
+        (traced ? NUM_BYTES_TRACE_ID : 0);
     return sizeof(PacketType) + sizeof(PacketVersion) + optionalSize;
 }
 int NLPacket::totalHeaderSize(PacketType type, bool isPartOfMessage) {
@@ -34,7 +36,7 @@ std::unique_ptr<NLPacket> NLPacket::create(PacketType type, qint64 size, bool is
     return packet;
 }
 
-std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                        const HifiSockAddr& senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
@@ -71,6 +73,10 @@ NLPacket::NLPacket(PacketType type, qint64 size, bool isReliable, bool isPartOfM
     adjustPayloadStartAndCapacity(NLPacket::localHeaderSize(_type));
 
     writeTypeAndVersion();
+
+    if (PacketTypeEnum::getTracedPackets().contains(_type)) {
+        writeTraceID(tracing::NULL_TRACE_ID);
+    }
 }
 
 NLPacket::NLPacket(Packet&& packet) :
@@ -79,6 +85,7 @@ NLPacket::NLPacket(Packet&& packet) :
     readType();
     readVersion();
     readSourceID();
+    readTraceID();
     
     adjustPayloadStartAndCapacity(NLPacket::localHeaderSize(_type), _payloadSize > 0);
 }
@@ -87,9 +94,10 @@ NLPacket::NLPacket(const NLPacket& other) : Packet(other) {
     _type = other._type;
     _version = other._version;
     _sourceID = other._sourceID;
+    _traceID = other._traceID;
 }
 
-NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr) :
+NLPacket::NLPacket(udt::PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr) :
     Packet(std::move(data), size, senderSockAddr)
 {    
     // sanity check before we decrease the payloadSize with the payloadCapacity
@@ -98,6 +106,7 @@ NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr
     readType();
     readVersion();
     readSourceID();
+    readTraceID();
     
     adjustPayloadStartAndCapacity(NLPacket::localHeaderSize(_type), _payloadSize > 0);
 }
@@ -108,6 +117,7 @@ NLPacket::NLPacket(NLPacket&& other) :
     _type = other._type;
     _version = other._version;
     _sourceID = std::move(other._sourceID);
+    _traceID = other._traceID;
 }
 
 NLPacket& NLPacket::operator=(const NLPacket& other) {
@@ -116,6 +126,7 @@ NLPacket& NLPacket::operator=(const NLPacket& other) {
     _type = other._type;
     _version = other._version;
     _sourceID = other._sourceID;
+    _traceID = other._traceID;
     
     return *this;
 }
@@ -127,6 +138,7 @@ NLPacket& NLPacket::operator=(NLPacket&& other) {
     _type = other._type;
     _version = other._version;
     _sourceID = std::move(other._sourceID);
+    _traceID = other._traceID;
     
     return *this;
 }
@@ -146,22 +158,27 @@ NLPacket::LocalID NLPacket::sourceIDInHeader(const udt::Packet& packet) {
     return *reinterpret_cast<const LocalID*>(packet.getData() + offset);
 }
 
-QByteArray NLPacket::verificationHashInHeader(const udt::Packet& packet) {
+tracing::TraceID NLPacket::traceIDInHeader(const udt::Packet& packet) {
+    // the last field of the header, after those that are optional too
+    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + localHeaderSize(typeInHeader(packet)) -
+        NUM_BYTES_TRACE_ID;
+    return *reinterpret_cast<const tracing::TraceID*>(packet.getData() + offset);
+}
+
+PacketAuth::Hash NLPacket::verificationHashInHeader(const udt::Packet& packet) {
     int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) +
         sizeof(PacketVersion) + NUM_BYTES_LOCALID;
-    return QByteArray(packet.getData() + offset, NUM_BYTES_MD5_HASH);
+    PacketAuth::Hash hash;
+    memcpy(hash.data(), packet.getData() + offset, NUM_BYTES_VERIFICATION_HASH);
+    return hash;
 }
 
-QByteArray NLPacket::hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash) {
+PacketAuth::Hash NLPacket::hashForPacket(const udt::Packet& packet, const PacketAuth& packetAuth) {
     int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
-        + NUM_BYTES_LOCALID + NUM_BYTES_MD5_HASH;
+        + NUM_BYTES_LOCALID + NUM_BYTES_VERIFICATION_HASH;
     
-    // add the packet payload and the connection UUID
-    HMACAuth::HMACHash hashResult;
-    if (!hash.calculateHash(hashResult, packet.getData() + offset, packet.getDataSize() - offset)) {
-        return QByteArray();
-    }
-    return QByteArray((const char*) hashResult.data(), (int) hashResult.size());
+    // the packet payload, keyed by the connection secret
+    return packetAuth.calculateHash(packet.getData() + offset, packet.getDataSize() - offset);
 }
 
 void NLPacket::writeTypeAndVersion() {
@@ -206,6 +223,25 @@ void NLPacket::readSourceID() {
     }
 }
 
+void NLPacket::readTraceID() {
+    if (PacketTypeEnum::getTracedPackets().contains(_type)) {
+        _traceID = traceIDInHeader(*this);
+    } else {
+        _traceID = tracing::NULL_TRACE_ID;
+    }
+}
+
+void NLPacket::writeTraceID(tracing::TraceID traceID) {
+    Q_ASSERT(PacketTypeEnum::getTracedPackets().contains(_type));
+
+    // before the verification hash is written at send time, that includes it
+    auto offset = Packet::totalHeaderSize(isPartOfMessage()) + localHeaderSize(_type) - NUM_BYTES_TRACE_ID;
+
+    memcpy(_packet.get() + offset, &traceID, sizeof(traceID));
+
+    _traceID = traceID;
+}
+
 void NLPacket::writeSourceID(LocalID sourceID) const {
     Q_ASSERT(!PacketTypeEnum::getNonSourcedPackets().contains(_type));
     
@@ -216,14 +252,14 @@ void NLPacket::writeSourceID(LocalID sourceID) const {
     _sourceID = sourceID;
 }
 
-void NLPacket::writeVerificationHash(HMACAuth& hmacAuth) const {
+void NLPacket::writeVerificationHash(const PacketAuth& packetAuth) const {
     Q_ASSERT(!PacketTypeEnum::getNonSourcedPackets().contains(_type) &&
              !PacketTypeEnum::getNonVerifiedPackets().contains(_type));
     
     auto offset = Packet::totalHeaderSize(isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
                 + NUM_BYTES_LOCALID;
 
-    QByteArray verificationHash = hashForPacketAndHMAC(*this, hmacAuth);
+    PacketAuth::Hash verificationHash = hashForPacket(*this, packetAuth);
     
     memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
 }
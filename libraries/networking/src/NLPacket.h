@@ -14,12 +14,12 @@
 
 #include <QtCore/QSharedPointer>
 
+#include <Trace.h>
 #include <UUID.h>
 
+#include "PacketAuth.h"
 #include "udt/Packet.h"
 
-class HMACAuth;
-
 class NLPacket : public udt::Packet {
     Q_OBJECT
 public:
@@ -37,21 +37,24 @@ public:
     //    |                 (ONLY FOR VERIFIED PACKETS)                   |
     //    |                                                               |
     //    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    //    |             Trace ID - traced packet types only               |
+    //    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
     //
 
     using LocalID = NetworkLocalID;
     static const LocalID NULL_LOCAL_ID = 0;
     
     static const int NUM_BYTES_LOCALID = sizeof(LocalID);
+    static const int NUM_BYTES_TRACE_ID = sizeof(tracing::TraceID);
     // this is used by the Octree classes - must be known at compile time
     static const int MAX_PACKET_HEADER_SIZE =
         sizeof(udt::Packet::SequenceNumberAndBitField) + sizeof(udt::Packet::MessageNumberAndBitField) +
-        sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_LOCALID + NUM_BYTES_MD5_HASH;
+        sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_LOCALID + NUM_BYTES_VERIFICATION_HASH + NUM_BYTES_TRACE_ID;
     
     static std::unique_ptr<NLPacket> create(PacketType type, qint64 size = -1,
                     bool isReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
     
-    static std::unique_ptr<NLPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<NLPacket> fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                         const HifiSockAddr& senderSockAddr);
 
     static std::unique_ptr<NLPacket> fromBase(std::unique_ptr<Packet> packet);
@@ -70,8 +73,9 @@ public:
     static PacketVersion versionInHeader(const udt::Packet& packet);
     
     static LocalID sourceIDInHeader(const udt::Packet& packet);
-    static QByteArray verificationHashInHeader(const udt::Packet& packet);
-    static QByteArray hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash);
+    static tracing::TraceID traceIDInHeader(const udt::Packet& packet);
+    static PacketAuth::Hash verificationHashInHeader(const udt::Packet& packet);
+    static PacketAuth::Hash hashForPacket(const udt::Packet& packet, const PacketAuth& packetAuth);
     
     PacketType getType() const { return _type; }
     void setType(PacketType type);
@@ -82,12 +86,16 @@ public:
     LocalID getSourceID() const { return _sourceID; }
     
     void writeSourceID(LocalID sourceID) const;
-    void writeVerificationHash(HMACAuth& hmacAuth) const;
+    void writeVerificationHash(const PacketAuth& packetAuth) const;
+
+    // the trace that this packet carries on to the receiver, only for the traced packet types
+    tracing::TraceID getTraceID() const { return _traceID; }
+    void writeTraceID(tracing::TraceID traceID);
 
 protected:
     
     NLPacket(PacketType type, qint64 size = -1, bool forceReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
-    NLPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr);
+    NLPacket(udt::PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr);
     
     NLPacket(const NLPacket& other);
     NLPacket(NLPacket&& other);
@@ -103,10 +111,12 @@ protected:
     void readType();
     void readVersion();
     void readSourceID();
+    void readTraceID();
     
     PacketType _type;
     PacketVersion _version;
     mutable LocalID _sourceID;
+    tracing::TraceID _traceID { tracing::NULL_TRACE_ID };
 };
 
 #endif // hifi_NLPacket_h
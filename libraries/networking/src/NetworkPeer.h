@@ -42,6 +42,8 @@ public:
 
     using LocalID = NetworkLocalID;
     static const LocalID NULL_LOCAL_ID = 0;
+    // the domain server doesn't hand out the local IDs from here up, the avatar mixer gives them to hosted avatars
+    static const LocalID MIN_HOSTED_LOCAL_ID = 0xF000;
 
     LocalID getLocalID() const { return _localID; }
     void setLocalID(LocalID localID) { _localID = localID; }
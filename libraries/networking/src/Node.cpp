@@ -207,13 +207,18 @@ QDebug operator<<(QDebug debug, const Node& node) {
     return debug.nospace();
 }
 
+void Node::setLinkedData(std::unique_ptr<NodeData> linkedData) {
+    _linkedData = std::move(linkedData);
+    emit linkedDataChanged();
+}
+
 void Node::setConnectionSecret(const QUuid& connectionSecret) {
     if (_connectionSecret == connectionSecret) {
         return;
     }
 
     if (!_authenticateHash) {
-        _authenticateHash.reset(new HMACAuth());
+        _authenticateHash.reset(new PacketAuth());
     }
 
     _connectionSecret = connectionSecret;
@@ -34,7 +34,7 @@
 #include "SimpleMovingAverage.h"
 #include "MovingPercentile.h"
 #include "NodePermissions.h"
-#include "HMACAuth.h"
+#include "PacketAuth.h"
 #include "udt/ConnectionStats.h"
 #include "NumericalConstants.h"
 
@@ -61,10 +61,10 @@ public:
 
     const QUuid& getConnectionSecret() const { return _connectionSecret; }
     void setConnectionSecret(const QUuid& connectionSecret);
-    HMACAuth* getAuthenticateHash() const { return _authenticateHash.get(); }
+    PacketAuth* getAuthenticateHash() const { return _authenticateHash.get(); }
 
     NodeData* getLinkedData() const { return _linkedData.get(); }
-    void setLinkedData(std::unique_ptr<NodeData> linkedData) { _linkedData = std::move(linkedData); }
+    void setLinkedData(std::unique_ptr<NodeData> linkedData);
 
     int getPingMs() const { return _pingMs; }
     void setPingMs(int pingMs) { _pingMs = pingMs; }
@@ -107,6 +107,10 @@ public:
     float getInboundKbps() const;
     float getOutboundKbps() const;
 
+signals:
+    // emitted on the thread that replaced the linked data, after the previous data has been released
+    void linkedDataChanged();
+
 private:
     // privatize copy and assignment operator to disallow Node copying
     Node(const Node &otherNode);
@@ -115,7 +119,7 @@ private:
     NodeType_t _type;
 
     QUuid _connectionSecret;
-    std::unique_ptr<HMACAuth> _authenticateHash { nullptr };
+    std::unique_ptr<PacketAuth> _authenticateHash { nullptr };
     std::unique_ptr<NodeData> _linkedData;
     bool _isReplicated { false };
     int _pingMs;
@@ -12,6 +12,8 @@
 #ifndef hifi_NodeData_h
 #define hifi_NodeData_h
 
+#include <atomic>
+
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
@@ -34,10 +36,15 @@ public:
     
     QMutex& getMutex() { return _mutex; }
 
+    // the rate the node's link has room for from this assignment, as the node last reported it, 0 for no limit
+    float getDownstreamShareKbps() const { return _downstreamShareKbps.load(); }
+    void setDownstreamShareKbps(float shareKbps) { _downstreamShareKbps.store(shareKbps); }
+
 private:
     QMutex _mutex;
     QUuid _nodeID;
     NetworkPeer::LocalID _nodeLocalID;
+    std::atomic<float> _downstreamShareKbps { 0.0f };
 };
 
 #endif // hifi_NodeData_h
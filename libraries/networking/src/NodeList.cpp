@@ -12,6 +12,7 @@
 
 #include "NodeList.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <QtCore/QDataStream>
@@ -49,6 +50,10 @@ using namespace std::chrono;
 const int KEEPALIVE_PING_INTERVAL_MS = 1000;
 const int MAX_SYSTEM_INFO_SIZE = 1000;
 
+QSharedPointer<NodeList> NodeList::create(char ownerType, int socketListenPort) {
+    return QSharedPointer<NodeList>(new NodeList(ownerType, socketListenPort), &QObject::deleteLater);
+}
+
 NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort) :
     LimitedNodeList(socketListenPort, dtlsListenPort),
     _ownerType(newOwnerType),
@@ -98,7 +103,6 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // FIXME: Can remove this temporary work-around in version 2021.2.0. (New protocol version implies a domain server upgrade.)
     // Adjust our canRezAvatarEntities permissions on older domains that do not have this setting.
     // DomainServerList and DomainSettings packets can come in either order so need to adjust with both occurrences.
-    auto nodeList = DependencyManager::get<NodeList>();
     connect(&_domainHandler, &DomainHandler::settingsReceived, this, &NodeList::adjustCanRezAvatarEntitiesPerSettings);
 
     auto accountManager = DependencyManager::get<AccountManager>();
@@ -132,6 +136,8 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     connect(&_domainHandler, SIGNAL(connectedToDomain(QUrl)), &_keepAlivePingTimer, SLOT(start()));
     connect(&_domainHandler, &DomainHandler::disconnectedFromDomain, &_keepAlivePingTimer, &QTimer::stop);
 
+    connect(this, &LimitedNodeList::connectionStatsSampled, this, &NodeList::sendDownstreamBandwidth);
+
     connect(&_domainHandler, &DomainHandler::limitOfSilentDomainCheckInsReached, this, [this]() {
         if (_connectReason != Awake) {
             _connectReason = SilentDomainDisconnect;
@@ -203,6 +209,18 @@ qint64 NodeList::sendStatsToDomainServer(QJsonObject statsObject) {
     return sendStats(statsObject, _domainHandler.getSockAddr());
 }
 
+void NodeList::sendMetricsToDomainServer(QByteArray metrics) {
+    if (thread() != QThread::currentThread()) {
+        QMetaObject::invokeMethod(this, "sendMetricsToDomainServer", Qt::QueuedConnection, Q_ARG(QByteArray, metrics));
+        return;
+    }
+
+    auto metricsPacketList = NLPacketList::create(PacketType::NodeMetrics, QByteArray(), true, true);
+    metricsPacketList->write(metrics);
+
+    sendPacketList(std::move(metricsPacketList), _domainHandler.getSockAddr());
+}
+
 void NodeList::timePingReply(ReceivedMessage& message, const SharedNodePointer& sendingNode) {
     PingType_t pingType;
 
@@ -318,6 +336,12 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
 
+    // the next domain list is the full list
+    _domainListVersion = 0;
+    _pendingDomainListVersion = 0;
+    _pendingDomainListSendTime = 0;
+    _pendingDomainListNodes = 0;
+
     // if we setup the DTLS socket, also disconnect from the DTLS socket readyRead() so it can handle handshaking
     if (_dtlsSocket) {
         disconnect(_dtlsSocket, 0, this, 0);
@@ -519,6 +543,9 @@ void NodeList::sendDomainServerCheckIn() {
                 }
             }
 
+        } else {
+            // the domain-server only sends the changes since the last version of the list we heard all of
+            packetStream << _domainListVersion;
         }
 
         flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SendDSCheckIn);
@@ -756,6 +783,14 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     bool newConnection;
     packetStream >> newConnection;
 
+    // the version of the list, how many nodes it has over all its packets and the nodes it removes
+    quint64 listVersion;
+    packetStream >> listVersion;
+    quint32 numListedNodes;
+    packetStream >> numListedNodes;
+    QList<QUuid> removedNodes;
+    packetStream >> removedNodes;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -790,7 +825,7 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     // emit our signal so listeners know we just heard from the DS
     emit receivedDomainServerList();
 
-    DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSList);
+    flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveDSList);
 
     if (_domainHandler.isConnected() && _domainHandler.getUUID() != domainUUID) {
         // Received packet from different domain.
@@ -852,9 +887,28 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
 
+    foreach (const QUuid& nodeUUID, removedNodes) {
+        killNodeWithUUID(nodeUUID);
+        removeDelayedAdd(nodeUUID);
+    }
+
     // pull each node in the packet
+    quint32 numParsedNodes = 0;
     while (packetStream.device()->pos() < message->getSize()) {
         parseNodeFromPacketStream(packetStream);
+        ++numParsedNodes;
+    }
+
+    // the list's packets are unreliable, we've only heard all of this version once all of its nodes arrived,
+    // until then the domain-server keeps sending what changed since the last version we did hear all of
+    if (listVersion != _pendingDomainListVersion || domainServerPingSendTime != _pendingDomainListSendTime) {
+        _pendingDomainListVersion = listVersion;
+        _pendingDomainListSendTime = domainServerPingSendTime;
+        _pendingDomainListNodes = numListedNodes;
+    }
+    _pendingDomainListNodes -= std::min(numParsedNodes, _pendingDomainListNodes);
+    if (_pendingDomainListNodes == 0) {
+        _domainListVersion = listVersion;
     }
 }
 
@@ -1012,6 +1066,53 @@ void NodeList::sendKeepAlivePings() {
     });
 }
 
+void NodeList::sendDownstreamBandwidth() {
+    // only a client hears from all the assignments over its one link
+    if (_ownerType.load() != NodeType::Agent) {
+        return;
+    }
+
+    DownstreamBandwidth bandwidth;
+    float receivedKbps = 0.0f;
+    int receivedPackets = 0;
+    int lostPackets = 0;
+    eachNode([&](const SharedNodePointer& node) {
+        const auto& stats = node->getConnectionStats();
+        if (stats.endTime <= stats.startTime) {
+            return;
+        }
+
+        float inboundKbps = node->getInboundKbps();
+        receivedKbps += inboundKbps;
+        receivedPackets += stats.receivedPackets + stats.receivedUnreliablePackets;
+        lostPackets += stats.lostPackets;
+
+        DownstreamBandwidth::Stream stream;
+        if (DownstreamBandwidth::streamForNodeType(node->getType(), stream)) {
+            bandwidth.usageKbps[stream] += inboundKbps;
+        }
+    });
+
+    bandwidth.capacityKbps = _downstreamBandwidthEstimator.update(receivedKbps, receivedPackets, lostPackets);
+    if (bandwidth.capacityKbps <= 0.0f) {
+        // the link has kept up so far, the assignments keep to their own limits
+        return;
+    }
+
+    QByteArray payload;
+    QDataStream payloadStream(&payload, QIODevice::WriteOnly);
+    payloadStream << bandwidth;
+
+    eachMatchingNode([](const SharedNodePointer& node)->bool {
+        DownstreamBandwidth::Stream stream;
+        return node->getActiveSocket() && DownstreamBandwidth::streamForNodeType(node->getType(), stream);
+    }, [&](const SharedNodePointer& node) {
+        auto bandwidthPacket = NLPacket::create(PacketType::DownstreamBandwidth, payload.size());
+        bandwidthPacket->write(payload);
+        sendPacket(std::move(bandwidthPacket), *node);
+    });
+}
+
 bool NodeList::sockAddrBelongsToDomainOrNode(const HifiSockAddr& sockAddr) {
     return _domainHandler.getSockAddr() == sockAddr || LimitedNodeList::sockAddrBelongsToNode(sockAddr);
 }
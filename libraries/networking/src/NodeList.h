@@ -33,6 +33,7 @@
 #include <SettingHandle.h>
 
 #include "DomainHandler.h"
+#include "DownstreamBandwidth.h"
 #include "LimitedNodeList.h"
 #include "Node.h"
 
@@ -53,12 +54,17 @@ class NodeList : public LimitedNodeList {
     SINGLETON_DEPENDENCY
 
 public:
+    // a node list of its own rather than the DependencyManager's one, for the tools that connect many clients from a process
+    static QSharedPointer<NodeList> create(char ownerType, int socketListenPort = INVALID_PORT);
+
     void startThread();
     NodeType_t getOwnerType() const { return _ownerType.load(); }
     void setOwnerType(NodeType_t ownerType) { _ownerType.store(ownerType); }
 
     Q_INVOKABLE qint64 sendStats(QJsonObject statsObject, HifiSockAddr destination);
     Q_INVOKABLE qint64 sendStatsToDomainServer(QJsonObject statsObject);
+    // the serialized NodeMetrics of this node
+    Q_INVOKABLE void sendMetricsToDomainServer(QByteArray metrics);
 
     DomainHandler& getDomainHandler() { return _domainHandler; }
 
@@ -149,6 +155,7 @@ private slots:
     void pingPunchForDomainServer();
 
     void sendKeepAlivePings();
+    void sendDownstreamBandwidth();
 
     void maybeSendIgnoreSetToNode(SharedNodePointer node);
 
@@ -178,9 +185,16 @@ private:
     bool _isShuttingDown { false };
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData { false };
+    DownstreamBandwidthEstimator _downstreamBandwidthEstimator;
 
     bool _sendDomainServerCheckInEnabled { true };
 
+    // the last version of the domain list we heard all of, and how much of the one we're hearing is still to come
+    quint64 _domainListVersion { 0 };
+    quint64 _pendingDomainListVersion { 0 };
+    quint64 _pendingDomainListSendTime { 0 };
+    quint32 _pendingDomainListNodes { 0 };
+
     mutable QReadWriteLock _ignoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _ignoredNodeIDs;
     mutable QReadWriteLock _personalMutedSetLock;
@@ -0,0 +1,105 @@
+//
+//  NodeMetrics.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeMetrics.h"
+
+#include <algorithm>
+
+// keeps a malformed packet from having us allocate a lot of buckets
+static const quint8 MAX_HISTOGRAM_BUCKETS = 64;
+
+void NodeMetrics::setCounter(const QString& name, double value) {
+    Metric& metric = _metrics[name];
+    metric.type = Type::Counter;
+    metric.value = value;
+}
+
+void NodeMetrics::setGauge(const QString& name, double value) {
+    Metric& metric = _metrics[name];
+    metric.type = Type::Gauge;
+    metric.value = value;
+}
+
+void NodeMetrics::addHistogram(const QString& name, const LatencyHistogram& histogram,
+                               const std::vector<quint64>& bucketBounds, double scale) {
+    Metric& metric = _metrics[name];
+    size_t numBuckets = std::min(bucketBounds.size(), (size_t)MAX_HISTOGRAM_BUCKETS);
+    if (metric.type != Type::Histogram || metric.bucketBounds.size() != numBuckets) {
+        metric = Metric();
+        metric.type = Type::Histogram;
+        metric.bucketCounts.resize(numBuckets, 0);
+        for (size_t i = 0; i < numBuckets; ++i) {
+            metric.bucketBounds.push_back(bucketBounds[i] * scale);
+        }
+    }
+
+    for (size_t i = 0; i < numBuckets; ++i) {
+        metric.bucketCounts[i] += histogram.getCountAtOrBelow(bucketBounds[i]);
+    }
+    metric.value += histogram.getSum() * scale;
+    metric.count += histogram.getCount();
+}
+
+QDataStream& operator<<(QDataStream& out, const NodeMetrics& metrics) {
+    out << (quint16)metrics._metrics.size();
+    for (auto it = metrics._metrics.constBegin(); it != metrics._metrics.constEnd(); ++it) {
+        const NodeMetrics::Metric& metric = it.value();
+        out << it.key().toLatin1() << (quint8)metric.type << metric.value;
+
+        if (metric.type == NodeMetrics::Type::Histogram) {
+            out << (quint8)metric.bucketBounds.size();
+            for (size_t i = 0; i < metric.bucketBounds.size(); ++i) {
+                out << metric.bucketBounds[i] << metric.bucketCounts[i];
+            }
+            out << metric.count;
+        }
+    }
+    return out;
+}
+
+QDataStream& operator>>(QDataStream& in, NodeMetrics& metrics) {
+    metrics._metrics.clear();
+
+    quint16 numMetrics = 0;
+    in >> numMetrics;
+    for (quint16 i = 0; i < numMetrics && in.status() == QDataStream::Ok; ++i) {
+        QByteArray name;
+        quint8 type;
+        NodeMetrics::Metric metric;
+        in >> name >> type >> metric.value;
+
+        if (type > (quint8)NodeMetrics::Type::Histogram) {
+            in.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+        metric.type = (NodeMetrics::Type)type;
+
+        if (metric.type == NodeMetrics::Type::Histogram) {
+            quint8 numBuckets = 0;
+            in >> numBuckets;
+            if (numBuckets > MAX_HISTOGRAM_BUCKETS) {
+                in.setStatus(QDataStream::ReadCorruptData);
+                break;
+            }
+            metric.bucketBounds.resize(numBuckets);
+            metric.bucketCounts.resize(numBuckets);
+            for (quint8 bucket = 0; bucket < numBuckets; ++bucket) {
+                in >> metric.bucketBounds[bucket] >> metric.bucketCounts[bucket];
+            }
+            in >> metric.count;
+        }
+
+        if (in.status() == QDataStream::Ok) {
+            metrics._metrics.insert(QString::fromLatin1(name), metric);
+        }
+    }
+    return in;
+}
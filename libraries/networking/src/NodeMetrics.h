@@ -0,0 +1,61 @@
+//
+//  NodeMetrics.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeMetrics_h
+#define hifi_NodeMetrics_h
+
+#include <vector>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+
+#include <LatencyHistogram.h>
+
+// The counters, gauges and histograms an assignment client reports to the domain-server, for it to serve to Prometheus.
+// They are sent next to the JSON stats in a compact binary packet, so that scraping them doesn't need the JSON parsed.
+//
+// Names are Prometheus metric names without the common prefix and labels, the domain-server adds those.
+class NodeMetrics {
+public:
+    enum class Type : quint8 {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    struct Metric {
+        Type type { Type::Gauge };
+        double value { 0.0 }; // the sum of the observations, for a histogram
+        std::vector<double> bucketBounds; // the upper bounds of a histogram's buckets
+        std::vector<quint64> bucketCounts; // the observations at or below each bound, since the metric was added
+        quint64 count { 0 };
+    };
+
+    void setCounter(const QString& name, double value);
+    void setGauge(const QString& name, double value);
+
+    // adds the values recorded in the histogram to the metric's totals, the bounds are in the units of the histogram
+    // and scale converts them to the units of the metric (1.0e-6 for a histogram of usecs reported in seconds)
+    void addHistogram(const QString& name, const LatencyHistogram& histogram, const std::vector<quint64>& bucketBounds,
+                      double scale);
+
+    bool isEmpty() const { return _metrics.isEmpty(); }
+    const QMap<QString, Metric>& getMetrics() const { return _metrics; }
+
+    friend QDataStream& operator<<(QDataStream& out, const NodeMetrics& metrics);
+    friend QDataStream& operator>>(QDataStream& in, NodeMetrics& metrics);
+
+private:
+    QMap<QString, Metric> _metrics;
+};
+
+#endif // hifi_NodeMetrics_h
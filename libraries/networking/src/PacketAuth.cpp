@@ -0,0 +1,102 @@
+//
+//  PacketAuth.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketAuth.h"
+
+#include <QtCore/QtEndian>
+#include <QtCore/QUuid>
+
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+namespace {
+
+struct SipHashState {
+    uint64_t v0, v1, v2, v3;
+
+    inline void round() {
+        v0 += v1;
+        v1 = rotateLeft(v1, 13);
+        v1 ^= v0;
+        v0 = rotateLeft(v0, 32);
+        v2 += v3;
+        v3 = rotateLeft(v3, 16);
+        v3 ^= v2;
+        v0 += v3;
+        v3 = rotateLeft(v3, 21);
+        v3 ^= v0;
+        v2 += v1;
+        v1 = rotateLeft(v1, 17);
+        v1 ^= v2;
+        v2 = rotateLeft(v2, 32);
+    }
+
+    inline void compress(uint64_t word) {
+        v3 ^= word;
+        round();
+        round();
+        v0 ^= word;
+    }
+
+    inline uint64_t finalize() {
+        round();
+        round();
+        round();
+        round();
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
+};
+
+}
+
+void PacketAuth::setKey(const QUuid& key) {
+    const QByteArray rfcBytes(key.toRfc4122());
+    setKey(qFromLittleEndian<quint64>(rfcBytes.constData()),
+           qFromLittleEndian<quint64>(rfcBytes.constData() + sizeof(quint64)));
+}
+
+void PacketAuth::setKey(uint64_t key0, uint64_t key1) {
+    _key0.store(key0, std::memory_order_relaxed);
+    _key1.store(key1, std::memory_order_relaxed);
+}
+
+PacketAuth::Hash PacketAuth::calculateHash(const char* data, int dataLen) const {
+    uint64_t key0 = _key0.load(std::memory_order_relaxed);
+    uint64_t key1 = _key1.load(std::memory_order_relaxed);
+
+    SipHashState state {
+        key0 ^ 0x736f6d6570736575ULL,
+        key1 ^ 0x646f72616e646f6dULL ^ 0xeeULL, // the 128 bit output
+        key0 ^ 0x6c7967656e657261ULL,
+        key1 ^ 0x7465646279746573ULL
+    };
+
+    const int numWords = dataLen / (int)sizeof(uint64_t);
+    for (int i = 0; i < numWords; i++) {
+        state.compress(qFromLittleEndian<quint64>(data + i * sizeof(uint64_t)));
+    }
+
+    // the remaining bytes with the length in the top one
+    uint64_t last = (uint64_t)(dataLen & 0xff) << 56;
+    const uint8_t* tail = reinterpret_cast<const uint8_t*>(data) + numWords * sizeof(uint64_t);
+    for (int i = 0; i < dataLen % (int)sizeof(uint64_t); i++) {
+        last |= (uint64_t)tail[i] << (8 * i);
+    }
+    state.compress(last);
+
+    Hash hash;
+    state.v2 ^= 0xee;
+    qToLittleEndian<quint64>(state.finalize(), hash.data());
+    state.v1 ^= 0xdd;
+    qToLittleEndian<quint64>(state.finalize(), hash.data() + sizeof(uint64_t));
+    return hash;
+}
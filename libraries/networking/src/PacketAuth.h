@@ -0,0 +1,42 @@
+//
+//  PacketAuth.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketAuth_h
+#define hifi_PacketAuth_h
+
+#include <array>
+#include <atomic>
+#include <stdint.h>
+
+class QUuid;
+
+// The verification hash of the sourced packets: SipHash-2-4 with its 128 bit output, keyed by the secret of the
+// connection. The state of a hash lives on the stack of the caller, so the packets of a node are hashed on as many
+// threads as they are sent and received on without a lock.
+//
+// The key is changed when the connection secret is; a packet hashed meanwhile may mix both halves and fail verification
+// as one hashed with the previous secret would.
+class PacketAuth {
+public:
+    static const int HASH_SIZE { 16 };
+    using Hash = std::array<uint8_t, HASH_SIZE>;
+
+    void setKey(const QUuid& key);
+    void setKey(uint64_t key0, uint64_t key1);
+
+    Hash calculateHash(const char* data, int dataLen) const;
+
+private:
+    std::atomic<uint64_t> _key0 { 0 };
+    std::atomic<uint64_t> _key1 { 0 };
+};
+
+#endif // hifi_PacketAuth_h
@@ -44,42 +44,43 @@ bool PacketReceiver::registerListenerForTypes(PacketTypeList types, const Listen
     return true;
 }
 
-void PacketReceiver::registerDirectListener(PacketType type, const ListenerReferencePointer& listener) {
-    Q_ASSERT_X(listener, "PacketReceiver::registerDirectListener", "No listener to register");
-    
-    bool success = registerListener(type, listener);
-    if (success) {
-        QMutexLocker locker(&_directConnectSetMutex);
-        
-        // if we successfully registered, add this object to the set of objects that are directly connected
-        _directlyConnectedObjects.insert(listener->getObject());
+bool PacketReceiver::registerListener(PacketType type, const ListenerReferencePointer& listener,  bool deliverPending) {
+    Q_ASSERT_X(listener, "PacketReceiver::registerListener", "No listener to register");
+
+    bool matchingMethod = matchingMethodForListener(type, listener);
+
+    if (matchingMethod) {
+        qCDebug(networking) << "Registering a packet listener for packet list type" << type;
+        registerVerifiedListener(type, listener, deliverPending);
+        return true;
+    } else {
+        qCWarning(networking) << "FAILED to Register a packet listener for packet list type" << type;
+        return false;
     }
 }
 
-void PacketReceiver::registerDirectListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener) {
+bool PacketReceiver::registerDirectListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener) {
+    Q_ASSERT_X(!types.empty(), "PacketReceiver::registerDirectListenerForTypes", "No types to register");
     Q_ASSERT_X(listener, "PacketReceiver::registerDirectListenerForTypes", "No listener to register");
-    
-    // just call register listener for types to start
-    bool success = registerListenerForTypes(std::move(types), listener);
-    if (success) {
-        QMutexLocker locker(&_directConnectSetMutex);
-        
-        // if we successfully registered, add this object to the set of objects that are directly connected
-        _directlyConnectedObjects.insert(listener->getObject());
-    }
+
+    std::for_each(std::begin(types), std::end(types), [this, &listener](PacketType type) {
+        registerVerifiedListener(type, listener, false, true);
+    });
+
+    return true;
 }
 
-bool PacketReceiver::registerListener(PacketType type, const ListenerReferencePointer& listener,  bool deliverPending) {
-    Q_ASSERT_X(listener, "PacketReceiver::registerListener", "No listener to register");
+bool PacketReceiver::registerDirectListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending) {
+    Q_ASSERT_X(listener, "PacketReceiver::registerDirectListener", "No listener to register");
 
     bool matchingMethod = matchingMethodForListener(type, listener);
 
     if (matchingMethod) {
-        qCDebug(networking) << "Registering a packet listener for packet list type" << type;
-        registerVerifiedListener(type, listener, deliverPending);
+        qCDebug(networking) << "Registering a direct packet listener for packet list type" << type;
+        registerVerifiedListener(type, listener, deliverPending, true);
         return true;
     } else {
-        qCWarning(networking) << "FAILED to Register a packet listener for packet list type" << type;
+        qCWarning(networking) << "FAILED to Register a direct packet listener for packet list type" << type;
         return false;
     }
 }
@@ -99,7 +100,8 @@ bool PacketReceiver::matchingMethodForListener(PacketType type, const ListenerRe
     return true;
 }
 
-void PacketReceiver::registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending) {
+void PacketReceiver::registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending,
+                                              bool isDirect) {
     Q_ASSERT_X(listener, "PacketReceiver::registerVerifiedListener", "No listener to register");
     QMutexLocker locker(&_packetListenerLock);
 
@@ -109,29 +111,24 @@ void PacketReceiver::registerVerifiedListener(PacketType type, const ListenerRef
     }
     
     // add the mapping
-    _messageListenerMap[type] = { listener, deliverPending };
+    _messageListenerMap[type] = { listener, deliverPending, isDirect };
 }
 
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
     
-    {
-        QMutexLocker packetListenerLocker(&_packetListenerLock);
-        
-        // clear any registrations for this listener in _messageListenerMap
-        auto it = _messageListenerMap.begin();
-        
-        while (it != _messageListenerMap.end()) {
-            if (it.value().listener->getObject() == listener) {
-                it = _messageListenerMap.erase(it);
-            } else {
-                ++it;
-            }
+    QMutexLocker packetListenerLocker(&_packetListenerLock);
+
+    // clear any registrations for this listener in _messageListenerMap
+    auto it = _messageListenerMap.begin();
+
+    while (it != _messageListenerMap.end()) {
+        if (it.value().listener->getObject() == listener) {
+            it = _messageListenerMap.erase(it);
+        } else {
+            ++it;
         }
     }
-    
-    QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
-    _directlyConnectedObjects.remove(listener);
 }
 
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
@@ -140,11 +137,9 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
         return;
     }
     
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
-    
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
-    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
 
     handleVerifiedMessage(receivedMessage, true);
 }
@@ -158,14 +153,14 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
 
     if (it == _pendingMessages.end()) {
         // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+        message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
         if (!message->isComplete()) {
             _pendingMessages[key] = message;
         }
         handleVerifiedMessage(message, true);
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
@@ -184,8 +179,13 @@ void PacketReceiver::handleMessageFailure(HifiSockAddr from, udt::Packet::Messag
     }
 }
 
+LimitedNodeList* PacketReceiver::getNodeList() const {
+    auto nodeList = qobject_cast<LimitedNodeList*>(parent());
+    return nodeList ? nodeList : DependencyManager::get<LimitedNodeList>().data();
+}
+
 void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> receivedMessage, bool justReceived) {
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    auto nodeList = getNodeList();
     
     SharedNodePointer matchingNode;
     
@@ -205,16 +205,9 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
             
         bool success = false;
 
-        bool isDirectConnect = false;
-        // check if this is a directly connected listener
-        {
-            QMutexLocker directConnectLocker(&_directConnectSetMutex);
-            isDirectConnect = _directlyConnectedObjects.contains(listener.listener->getObject());
-        }
-
         // one final check on the QPointer before we go to invoke
         if (listener.listener->getObject()) {
-            if (isDirectConnect) {
+            if (listener.isDirect) {
                 success = listener.listener->invokeDirectly(receivedMessage, matchingNode);
             } else {
                 success = listener.listener->invokeWithQt(receivedMessage, matchingNode);
@@ -223,12 +216,6 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
             qCDebug(networking).nospace() << "Listener for packet " << receivedMessage->getType()
                 << " has been destroyed. Removing from listener map.";
             it = _messageListenerMap.erase(it);
-
-            // if it exists, remove the listener from _directlyConnectedObjects
-            {
-                QMutexLocker directConnectLocker(&_directConnectSetMutex);
-                _directlyConnectedObjects.remove(listener.listener->getObject());
-            }
         }
 
         if (!success) {
@@ -240,6 +227,6 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
         qCWarning(networking) << "No listener found for packet type" << receivedMessage->getType();
         
         // insert a dummy listener so we don't print this again
-        _messageListenerMap.insert(receivedMessage->getType(), { ListenerReferencePointer(), false });
+        _messageListenerMap.insert(receivedMessage->getType(), { ListenerReferencePointer(), false, false });
     }
 }
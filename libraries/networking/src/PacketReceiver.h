@@ -19,7 +19,6 @@
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
-#include <QtCore/QSet>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QEnableSharedFromThis>
 
@@ -28,9 +27,8 @@
 #include "ReceivedMessage.h"
 #include "udt/PacketHeaders.h"
 
-class EntityEditPacketSender;
+class LimitedNodeList;
 class Node;
-class OctreePacketProcessor;
 
 namespace std {
     template <>
@@ -74,6 +72,12 @@ public:
     // for the message is received.
     bool registerListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener);
+
+    // Direct listeners are invoked on the thread that received the packet, instead of being queued to the thread
+    // of the listener's object. They must be thread-safe and return quickly, typically by queueing the message for
+    // their own thread (see ReceivedMessageQueue).
+    bool registerDirectListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
+    bool registerDirectListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener);
     void unregisterListener(QObject* listener);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
@@ -110,29 +114,24 @@ private:
     struct Listener {
         ListenerReferencePointer listener;
         bool deliverPending;
+        bool isDirect;
     };
 
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
 
-    // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
-    // should be changed to have a true event loop and be able to handle our QMetaMethod::invoke
-    void registerDirectListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener);
-    void registerDirectListener(PacketType type, const ListenerReferencePointer& listener);
+    // the node list that owns this receiver, for the tools that have more than the DependencyManager's one
+    LimitedNodeList* getNodeList() const;
 
     bool matchingMethodForListener(PacketType type, const ListenerReferencePointer& listener) const;
-    void registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
+    void registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false,
+                                  bool isDirect = false);
 
     QMutex _packetListenerLock;
     QHash<PacketType, Listener> _messageListenerMap;
 
     bool _shouldDropPackets = false;
-    QMutex _directConnectSetMutex;
-    QSet<QObject*> _directlyConnectedObjects;
 
     std::unordered_map<std::pair<HifiSockAddr, udt::Packet::MessageNumber>, QSharedPointer<ReceivedMessage>> _pendingMessages;
-    
-    friend class EntityEditPacketSender;
-    friend class OctreePacketProcessor;
 };
 
 template <class T>
@@ -24,34 +24,48 @@ static const int HEAD_DATA_SIZE = 512;
 using namespace std::chrono;
 
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
-    : _data(packetList.getMessage()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
-      _numPackets(packetList.getNumPackets()),
+    : _numPackets(packetList.getNumPackets()),
       _sourceID(packetList.getSourceID()),
       _packetType(packetList.getType()),
       _packetVersion(packetList.getVersion()),
       _senderSockAddr(packetList.getSenderSockAddr())
 {
+    addSegment(packetList.getMessage());
     _firstPacketReceiveTime = duration_cast<microseconds>(packetList.getFirstPacketReceiveTime().time_since_epoch()).count();
 }
 
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
-    : _data(packet.readAll()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
-      _numPackets(1),
+    : _numPackets(1),
       _sourceID(packet.getSourceID()),
       _packetType(packet.getType()),
       _packetVersion(packet.getVersion()),
       _senderSockAddr(packet.getSenderSockAddr()),
+      _traceID(packet.getTraceID()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
+    addSegment(packet.readAll());
     _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
 }
 
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet)
+    : _numPackets(1),
+      _sourceID(packet->getSourceID()),
+      _packetType(packet->getType()),
+      _packetVersion(packet->getVersion()),
+      _senderSockAddr(packet->getSenderSockAddr()),
+      _traceID(packet->getTraceID()),
+      _isComplete(packet->getPacketPosition() == NLPacket::ONLY)
+{
+    _firstPacketReceiveTime = duration_cast<microseconds>(packet->getReceiveTime().time_since_epoch()).count();
+
+    // what is left to read of the packet, as readAll would return
+    addSegment(QByteArray::fromRawData(packet->getPayload() + packet->pos(), packet->bytesLeftToRead()));
+    _packets.push_back(std::move(packet));
+    _hasPacketSegments = true;
+}
+
 ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                 const HifiSockAddr& senderSockAddr, NLPacket::LocalID sourceID) :
-    _data(byteArray),
-    _headData(_data.mid(0, HEAD_DATA_SIZE)),
     _numPackets(1),
     _firstPacketReceiveTime(0),
     _sourceID(sourceID),
@@ -60,6 +74,61 @@ ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, Pa
     _senderSockAddr(senderSockAddr),
     _isComplete(true)
 {
+    addSegment(byteArray);
+}
+
+void ReceivedMessage::addSegment(QByteArray segment) {
+    if (_segments.empty()) {
+        // a deep copy, the segment may point into a packet that won't be kept
+        _headData = QByteArray(segment.constData(), std::min(segment.size(), HEAD_DATA_SIZE));
+    }
+    if (segment.isEmpty()) {
+        return;
+    }
+    _segmentOffsets.push_back(_size);
+    _size += segment.size();
+    _segments.push_back(segment);
+}
+
+int ReceivedMessage::findSegment(qint64 position) const {
+    // the last segment starting at or before position
+    auto it = std::upper_bound(_segmentOffsets.begin(), _segmentOffsets.end(), position);
+    return (int)(it - _segmentOffsets.begin()) - 1;
+}
+
+const QByteArray& ReceivedMessage::getContiguousData(bool isCopyNeeded) const {
+    static const QByteArray EMPTY;
+    if (_segments.empty()) {
+        return EMPTY;
+    }
+
+    if (_segments.size() > 1 || (isCopyNeeded && _hasPacketSegments)) {
+        QByteArray data;
+        data.reserve(_size);
+        for (const auto& segment : _segments) {
+            data.append(segment.constData(), segment.size());
+        }
+        _segments.clear();
+        _segments.push_back(data);
+        _segmentOffsets.clear();
+        _segmentOffsets.push_back(0);
+
+        // nothing points into the packets anymore
+        _packets.clear();
+        _hasPacketSegments = false;
+    }
+    return _segments.front();
+}
+
+QByteArray ReceivedMessage::getMessage() const {
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    // the returned copy shares the data, which can't be in the packets since it could outlive them
+    return getContiguousData(true);
+}
+
+const char* ReceivedMessage::getRawMessage() const {
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    return getContiguousData(false).constData();
 }
 
 void ReceivedMessage::setFailed() {
@@ -68,7 +137,7 @@ void ReceivedMessage::setFailed() {
     emit completed();
 }
 
-void ReceivedMessage::appendPacket(NLPacket& packet) {
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
@@ -77,16 +146,24 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
+    auto packetPosition = packet->getPacketPosition();
+    auto receiveTime = packet->getReceiveTime();
+
+    {
+        // keep the packet, its payload is part of the message
+        std::lock_guard<std::mutex> lock(_segmentsMutex);
+        addSegment(QByteArray::fromRawData(packet->getPayload(), packet->getPayloadSize()));
+        _packets.push_back(std::move(packet));
+        _hasPacketSegments = true;
+    }
 
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
     }
 
-    auto packetPosition = packet.getPacketPosition();
     if ((packetPosition == NLPacket::PacketPosition::FIRST) ||
         (packetPosition == NLPacket::PacketPosition::ONLY)) {
-        _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
+        _firstPacketReceiveTime = duration_cast<microseconds>(receiveTime.time_since_epoch()).count();
     }
 
     if (packetPosition == NLPacket::PacketPosition::LAST) {
@@ -95,17 +172,43 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     }
 }
 
-qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
+qint64 ReceivedMessage::copyData(char* data, qint64 position, qint64 size) const {
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    qint64 sizeRead = std::max(std::min(size, _size - position), (qint64)0);
+    qint64 copied = 0;
+    for (int i = findSegment(position); copied < sizeRead; ++i) {
+        const auto& segment = _segments[i];
+        qint64 offset = position + copied - _segmentOffsets[i];
+        qint64 length = std::min(segment.size() - offset, sizeRead - copied);
+        memcpy(data + copied, segment.constData() + offset, length);
+        copied += length;
+    }
+    return sizeRead;
+}
+
+qint64 ReceivedMessage::readSegments(qint64 size, const std::function<void(const char* data, qint64 size)>& callback) {
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    qint64 position = _position;
+    qint64 bytesLeft = _size - position;
+    qint64 sizeRead = (size < 0) ? bytesLeft : std::max(std::min(size, bytesLeft), (qint64)0);
+    qint64 done = 0;
+    for (int i = findSegment(position); done < sizeRead; ++i) {
+        const auto& segment = _segments[i];
+        qint64 offset = position + done - _segmentOffsets[i];
+        qint64 length = std::min(segment.size() - offset, sizeRead - done);
+        callback(segment.constData() + offset, length);
+        done += length;
+    }
+    _position += sizeRead;
     return sizeRead;
 }
 
+qint64 ReceivedMessage::peek(char* data, qint64 size) {
+    return copyData(data, _position, size);
+}
+
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
+    auto sizeRead = copyData(data, _position, size);
     _position += sizeRead;
     return sizeRead;
 }
@@ -119,11 +222,14 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    qint64 position = _position;
+    QByteArray data(std::max(std::min(size, _size - position), (qint64)0), Qt::Uninitialized);
+    copyData(data.data(), position, data.size());
+    return data;
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
+    auto data = peek(size);
     _position += size;
     return data;
 }
@@ -142,15 +248,24 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
-    auto string = QString::fromUtf8(_data.constData() + _position, size);
-    _position += size;
-    return string;
+    return QString::fromUtf8(read(size));
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
-    QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
+    std::lock_guard<std::mutex> lock(_segmentsMutex);
+    qint64 position = _position;
     _position += size;
-    return data;
+
+    int index = findSegment(position);
+    if (index < 0) {
+        return QByteArray();
+    }
+    if (position + size > _segmentOffsets[index] + _segments[index].size()) {
+        // the data spans segments
+        getContiguousData(false);
+        index = 0;
+    }
+    return QByteArray::fromRawData(_segments[index].constData() + position - _segmentOffsets[index], size);
 }
 
 void ReceivedMessage::onComplete() {
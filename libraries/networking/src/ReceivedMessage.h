@@ -16,31 +16,44 @@
 #include <QObject>
 
 #include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "NLPacketList.h"
 
+// The data of a message is kept as the segments it was received in. The packets moved into the message are kept
+// and their payloads used in place, so assembling a large message doesn't copy or reallocate anything.
+//
+// The reads copy straight out of the segments and readSegments streams them without a copy. Only getMessage,
+// getRawMessage and readWithoutCopy (across segments) need the data to be contiguous, which costs a single copy
+// the first time.
 class ReceivedMessage : public QObject {
     Q_OBJECT
 public:
     ReceivedMessage(const NLPacketList& packetList);
     ReceivedMessage(NLPacket& packet);
+    // the message keeps the packet, its payload isn't copied
+    ReceivedMessage(std::unique_ptr<NLPacket> packet);
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const HifiSockAddr& senderSockAddr, NLPacket::LocalID sourceID = NLPacket::NULL_LOCAL_ID);
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    QByteArray getMessage() const;
+    const char* getRawMessage() const;
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
 
     void setFailed();
 
-    void appendPacket(NLPacket& packet);
+    void appendPacket(std::unique_ptr<NLPacket> packet);
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
 
     NLPacket::LocalID getSourceID() const { return _sourceID; }
+    tracing::TraceID getTraceID() const { return _traceID; }
     const HifiSockAddr& getSenderSockAddr() { return _senderSockAddr; }
 
     qint64 getPosition() const { return _position; }
@@ -50,9 +63,9 @@ public:
 
     qint64 getFirstPacketReceiveTime() const { return _firstPacketReceiveTime; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size -  _position; }
 
     void seek(qint64 position) { _position = position; }
 
@@ -76,6 +89,10 @@ public:
     // exceed that of the ReceivedMessage.
     QByteArray readWithoutCopy(qint64 size);
 
+    // Streams the next size bytes (the rest of the message if size is negative) to callback, one contiguous segment at
+    // a time, and returns the number of bytes read. The data passed to the callback is only valid during the call.
+    qint64 readSegments(qint64 size, const std::function<void(const char* data, qint64 size)>& callback);
+
     template<typename T> qint64 peekPrimitive(T* data);
     template<typename T> qint64 readPrimitive(T* data);
 
@@ -89,7 +106,22 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
+    // these must be called with the segments mutex locked
+    void addSegment(QByteArray segment);
+    int findSegment(qint64 position) const;
+    // merges the segments into one, which is also copied out of the packets if isCopyNeeded is true
+    const QByteArray& getContiguousData(bool isCopyNeeded) const;
+
+    qint64 copyData(char* data, qint64 position, qint64 size) const;
+
+    mutable std::mutex _segmentsMutex;
+    mutable std::vector<QByteArray> _segments;
+    mutable std::vector<qint64> _segmentOffsets;
+    // packets that segments point into, _hasPacketSegments is set while there are any
+    mutable std::vector<std::unique_ptr<NLPacket>> _packets;
+    mutable bool _hasPacketSegments { false };
+    std::atomic<qint64> _size { 0 };
+
     QByteArray _headData;
 
     std::atomic<qint64> _position { 0 };
@@ -100,6 +132,7 @@ private:
     PacketType _packetType;
     PacketVersion _packetVersion;
     HifiSockAddr _senderSockAddr;
+    tracing::TraceID _traceID { tracing::NULL_TRACE_ID };
 
     std::atomic<bool> _isComplete { true };  
     std::atomic<bool> _failed { false };
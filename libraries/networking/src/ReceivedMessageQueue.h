@@ -0,0 +1,47 @@
+//
+//  ReceivedMessageQueue.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-25.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedMessageQueue_h
+#define hifi_ReceivedMessageQueue_h
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QSharedPointer>
+
+#include "Node.h"
+#include "ReceivedMessage.h"
+
+// Messages handed over by a direct PacketReceiver listener on the receiving thread, for the listener's own thread to
+// take in batches, instead of being posted to its event loop one at a time.
+class ReceivedMessageQueue {
+public:
+    using Entry = std::pair<QSharedPointer<ReceivedMessage>, SharedNodePointer>;
+
+    void push(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.emplace_back(std::move(message), std::move(node));
+    }
+
+    // replaces the content of entries with the messages pushed since the last call, in order
+    void take(std::vector<Entry>& entries) {
+        entries.clear();
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.swap(entries);
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<Entry> _entries;
+};
+
+#endif // hifi_ReceivedMessageQueue_h
@@ -12,6 +12,7 @@
 #include "ResourceCache.h"
 #include "ResourceRequestObserver.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <assert.h>
@@ -20,18 +21,46 @@
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
+#include <MemoryAccounting.h>
 #include <SharedUtil.h>
 #include <shared/QtHelpers.h>
 #include <Trace.h>
 #include <Profile.h>
 
 #include "NetworkAccessManager.h"
+#include "NetworkingConstants.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 
+// servers limit the connections of a client, as browsers do, so the requests to one host don't use up all the slots
+static const uint32_t MAX_REQUESTS_PER_HOST = 6;
+
+// a loading request is only dropped for one that is clearly more important, the range of entity priorities is 0 to PI / 2
+static const float PREEMPTION_PRIORITY_MARGIN = 0.25f;
+
+// and only when little of it has been received, as it starts over when it is loaded again
+static const qint64 MAX_PREEMPTED_BYTES_RECEIVED = 256 * 1024;
+
+static QString getHostKey(const QUrl& url) {
+    // the other schemes are either local or share a single connection
+    auto scheme = url.scheme();
+    if (scheme == HIFI_URL_SCHEME_HTTP || scheme == HIFI_URL_SCHEME_HTTPS) {
+        return url.host() + ":" + QString::number(url.port(scheme == HIFI_URL_SCHEME_HTTPS ? 443 : 80));
+    }
+    return QString();
+}
+
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
+
+    bool hasHostBudget = true;
+    auto locked = resource.lock();
+    if (locked) {
+        auto host = getHostKey(locked->getURL());
+        hasHostBudget = host.isEmpty() || getLoadingRequestsPerHost().value(host) < MAX_REQUESTS_PER_HOST;
+    }
+
+    if ((uint32_t)_loadingRequests.size() < _requestLimit && hasHostBudget) {
         _loadingRequests.append(resource);
         return true;
     } else {
@@ -88,6 +117,46 @@ uint32_t ResourceCacheSharedItems::getLoadingRequestsCount() const {
     return _loadingRequests.size();
 }
 
+QHash<QString, uint32_t> ResourceCacheSharedItems::getLoadingRequestsPerHost() const {
+    QHash<QString, uint32_t> result;
+    Lock lock(_mutex);
+
+    foreach(QWeakPointer<Resource> resource, _loadingRequests) {
+        auto locked = resource.lock();
+        if (locked) {
+            auto host = getHostKey(locked->getURL());
+            if (!host.isEmpty()) {
+                result[host]++;
+            }
+        }
+    }
+
+    return result;
+}
+
+float ResourceCacheSharedItems::getPriority(const QSharedPointer<Resource>& resource) const {
+    float priority = resource->getLoadPriority();
+
+    Lock lock(_mutex);
+    if (!_priorityHints.isEmpty()) {
+        // some resources mark the part they are loading in the fragment
+        auto hint = _priorityHints.find(resource->getURL().adjusted(QUrl::RemoveFragment));
+        if (hint != _priorityHints.end()) {
+            priority = std::max(priority, hint.value());
+        }
+    }
+    return priority;
+}
+
+void ResourceCacheSharedItems::setPriorityHint(const QUrl& url, float priority) {
+    Lock lock(_mutex);
+    if (priority != 0.0f) {
+        _priorityHints[url.adjusted(QUrl::RemoveFragment)] = priority;
+    } else {
+        _priorityHints.remove(url.adjusted(QUrl::RemoveFragment));
+    }
+}
+
 void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
 
@@ -113,6 +182,7 @@ QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
     Lock lock(_mutex);
 
     bool currentHighestIsFile = false;
+    auto loadingRequestsPerHost = getLoadingRequestsPerHost();
 
     for (int i = 0; i < _pendingRequests.size();) {
         // Clear any freed resources
@@ -122,8 +192,15 @@ QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
             continue;
         }
 
+        // Skip the requests to hosts that are already at their budget
+        auto host = getHostKey(resource->getURL());
+        if (!host.isEmpty() && loadingRequestsPerHost.value(host) >= MAX_REQUESTS_PER_HOST) {
+            i++;
+            continue;
+        }
+
         // Check load priority
-        float priority = resource->getLoadPriority();
+        float priority = getPriority(resource);
         bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
         if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
             highestPriority = priority;
@@ -141,6 +218,50 @@ QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
     return highestResource;
 }
 
+QSharedPointer<Resource> ResourceCacheSharedItems::preemptRequest(QSharedPointer<Resource> resource) {
+    Lock lock(_mutex);
+
+    int pendingIndex = -1;
+    for (int i = 0; i < _pendingRequests.size(); i++) {
+        if (_pendingRequests.at(i).data() == resource.data()) {
+            pendingIndex = i;
+            break;
+        }
+    }
+    if (pendingIndex < 0) {
+        return QSharedPointer<Resource>();
+    }
+
+    // when the host of the resource is at its budget, only one of its own requests can make room for it
+    auto host = getHostKey(resource->getURL());
+    bool isHostFull = !host.isEmpty() && getLoadingRequestsPerHost().value(host) >= MAX_REQUESTS_PER_HOST;
+
+    int lowestIndex = -1;
+    float lowestPriority = getPriority(resource) - PREEMPTION_PRIORITY_MARGIN;
+    QSharedPointer<Resource> lowestResource;
+    for (int i = 0; i < _loadingRequests.size(); i++) {
+        auto loading = _loadingRequests.at(i).lock();
+        if (!loading || !loading->canBePreempted() || (isHostFull && getHostKey(loading->getURL()) != host)) {
+            continue;
+        }
+
+        float priority = getPriority(loading);
+        if (priority < lowestPriority) {
+            lowestPriority = priority;
+            lowestIndex = i;
+            lowestResource = loading;
+        }
+    }
+
+    if (lowestIndex >= 0) {
+        _loadingRequests.removeAt(lowestIndex);
+        _pendingRequests.removeAt(pendingIndex);
+        _loadingRequests.append(resource);
+    }
+
+    return lowestResource;
+}
+
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
     _pendingRequests.clear();
@@ -161,6 +282,10 @@ void ScriptableResourceCache::updateTotalSize(const qint64& deltaSize) {
     _resourceCache->updateTotalSize(deltaSize);
 }
 
+void ScriptableResourceCache::setLoadPriorityHint(const QUrl& url, float priority) {
+    DependencyManager::get<ResourceCacheSharedItems>()->setPriorityHint(url, priority);
+}
+
 ScriptableResource* ScriptableResourceCache::prefetch(const QUrl& url, void* extra, size_t extraHash) {
     return _resourceCache->prefetch(url, extra, extraHash);
 }
@@ -259,9 +384,21 @@ ResourceCache::ResourceCache(QObject* parent) : QObject(parent) {
         connect(&domainHandler, &DomainHandler::disconnectedFromDomain,
             this, &ResourceCache::clearATPAssets, Qt::DirectConnection);
     }
+
+    // named once the subclass is constructed, the source only reads the counters of the base class
+    QTimer::singleShot(0, this, [this] {
+        _memorySource = MemoryAccounting::getInstance().addSource(QString("resources.") + metaObject()->className(),
+            [this](int64_t& bytes, int64_t& count) {
+                bytes = _totalResourcesSize;
+                count = _numTotalResources;
+            });
+    });
 }
 
 ResourceCache::~ResourceCache() {
+    if (_memorySource != -1) {
+        MemoryAccounting::getInstance().removeSource(_memorySource);
+    }
     clearUnusedResources();
 }
 
@@ -538,6 +675,17 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
         resource->makeRequest();
         return true;
     }
+    return attemptPreemption(resource);
+}
+
+bool ResourceCache::attemptPreemption(QSharedPointer<Resource> resource) {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto preempted = sharedItems->preemptRequest(resource);
+    if (preempted) {
+        preempted->preempt();
+        resource->makeRequest();
+        return true;
+    }
     return false;
 }
 
@@ -546,9 +694,11 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
 
     sharedItems->removeRequest(resource);
 
-    // Now go fill any new request spots
+    // Now go fill any new request spots, the pending requests can all be to hosts that are at their budget
     while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -606,7 +756,16 @@ void Resource::ensureLoading() {
 
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
+        bool isRaised = priority > _loadPriorities.value(owner, 0.0f);
         _loadPriorities.insert(owner, priority);
+
+        // a queued resource that became important can take the place of a download that just started
+        if (isRaised && _startedLoading && !_request && !_loaded) {
+            auto self = _self.lock();
+            if (self) {
+                ResourceCache::attemptPreemption(self);
+            }
+        }
     }
 }
 
@@ -686,6 +845,35 @@ void Resource::allReferencesCleared() {
     }
 }
 
+bool Resource::canBePreempted() const {
+    // only plain downloads can be started over, not ranged requests or those the resource makes itself
+    return _request && !_loaded && !_requestByteRange.isSet() && _bytesReceived < MAX_PREEMPTED_BYTES_RECEIVED &&
+        _activeUrl.scheme() != HIFI_URL_SCHEME_FILE;
+}
+
+void Resource::preempt() {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "preempt");
+        return;
+    }
+
+    // the request may have finished in the meantime, it no longer has a loading spot either way
+    if (!_request || _loaded || _failedToLoad) {
+        return;
+    }
+
+    PROFILE_ASYNC_END(resource, "Resource:" + getType(), QString::number(_requestID));
+    _request->disconnect(this);
+    _request->deleteLater();
+    _request = nullptr;
+    _bytesReceived = _bytesTotal = 0;
+
+    auto self = _self.lock();
+    if (self) {
+        ResourceCache::attemptRequest(self);
+    }
+}
+
 void Resource::init(bool resetLoaded) {
     _startedLoading = false;
     _failedToLoad = false;
@@ -77,12 +77,23 @@ public:
     uint32_t getLoadingRequestsCount() const;
     void clear();
 
+    /// Moves a pending request into the loading requests in place of a much lower priority one that has only just started,
+    /// which is taken out of the loading requests and returned so that it can be preempted.
+    QSharedPointer<Resource> preemptRequest(QSharedPointer<Resource> resource);
+
+    /// Sets a priority for the resources with this URL, used when it is higher than their own, or clears it if zero.
+    void setPriorityHint(const QUrl& url, float priority);
+
 private:
     ResourceCacheSharedItems() = default;
 
+    float getPriority(const QSharedPointer<Resource>& resource) const;
+    QHash<QString, uint32_t> getLoadingRequestsPerHost() const;
+
     mutable Mutex _mutex;
     QList<QWeakPointer<Resource>> _pendingRequests;
     QList<QWeakPointer<Resource>> _loadingRequests;
+    QHash<QUrl, float> _priorityHints;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
 };
@@ -271,6 +282,9 @@ protected:
     static bool attemptRequest(QSharedPointer<Resource> resource);
     static void requestCompleted(QWeakPointer<Resource> resource);
     static bool attemptHighestPriorityRequest();
+    /// Starts loading a pending resource in place of a much lower priority one, which is queued again
+    /// \return true if the resource began loading
+    static bool attemptPreemption(QSharedPointer<Resource> resource);
 
 private:
     friend class Resource;
@@ -298,6 +312,8 @@ private:
 
     std::atomic<size_t> _numUnusedResources { 0 };
     std::atomic<qint64> _unusedResourcesSize { 0 };
+
+    int _memorySource { -1 }; // the source of the cache in the MemoryAccounting
 };
 
 /// Wrapper to expose resource caches to JS/QML
@@ -384,6 +400,20 @@ public:
     // FIXME: This function variation shouldn't be in the API.
     Q_INVOKABLE ScriptableResource* prefetch(const QUrl& url, void* extra, size_t extraHash);
 
+    /*@jsdoc
+     * Sets a priority for downloading a resource, used instead of the priority given to it by what uses it when that is
+     * lower. Resources with higher priorities are downloaded first, and can take the place of lower priority downloads that
+     * have only just started. The priority applies to the resource in all the resource caches.
+     * @function ResourceCache.setLoadPriorityHint
+     * @param {string} url - The URL of the resource.
+     * @param {number} priority - The priority of the resource, <code>0</code> to clear it. The priority of entities is
+     *     between <code>0</code> and <code>1.57</code>, depending on their size and distance, and the priority of avatar
+     *     models is about <code>3</code>.
+     * @example <caption>Download a model ahead of the entities around it.</caption>
+     * ModelCache.setLoadPriorityHint("https://example.com/models/stage.fbx", 2.0);
+     */
+    Q_INVOKABLE void setLoadPriorityHint(const QUrl& url, float priority);
+
 signals:
 
     /*@jsdoc
@@ -521,6 +551,12 @@ protected:
 
     Q_INVOKABLE void allReferencesCleared();
 
+    /// Checks whether the request can be dropped to make room for a higher priority one, and started over later.
+    bool canBePreempted() const;
+
+    /// Drops the request, queueing the resource to be loaded again without this counting as an attempt.
+    Q_INVOKABLE void preempt();
+
     /// Return true if the resource will be retried
     virtual bool handleFailedRequest(ResourceRequest::Result result);
 
@@ -556,6 +592,7 @@ public slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
     
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
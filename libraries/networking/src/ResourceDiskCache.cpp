@@ -0,0 +1,176 @@
+//
+//  ResourceDiskCache.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceDiskCache.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+
+#include "AssetUtils.h"
+#include "NetworkingConstants.h"
+#include "NetworkLogging.h"
+
+static const char* RESOURCE_FILE_EXT = "cache";
+static const quint32 RESOURCE_FILE_MAGIC = 0x65637372; // "rsce"
+static const quint32 RESOURCE_FILE_VERSION = 1;
+
+ResourceDiskCache::ResourceDiskCache(const QString& cacheDirectory, qint64 maximumCacheSize, QObject* parent) :
+    QAbstractNetworkCache(parent),
+    _fileCache(std::make_shared<cache::FileCache>(cacheDirectory.toStdString(), RESOURCE_FILE_EXT)) {
+    _fileCache->initialize();
+    _fileCache->setMaxSize((size_t)maximumCacheSize);
+}
+
+cache::FileCache::Key ResourceDiskCache::getKey(const QUrl& url) {
+    if (url.scheme() == URL_SCHEME_ATP) {
+        auto hash = url.path();
+        if (AssetUtils::isValidHash(hash)) {
+            return hash.toStdString();
+        }
+    }
+    return QCryptographicHash::hash(url.adjusted(QUrl::RemoveFragment).toEncoded(), QCryptographicHash::Sha256).toHex().toStdString();
+}
+
+bool ResourceDiskCache::read(const QUrl& url, QNetworkCacheMetaData& metaData, QByteArray* data) {
+    auto key = getKey(url);
+    auto file = _fileCache->getFile(key);
+    if (!file) {
+        return false;
+    }
+
+    QFile cacheFile(QString::fromStdString(file->getFilepath()));
+    if (!cacheFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&cacheFile);
+    quint32 magic { 0 };
+    quint32 version { 0 };
+    stream >> magic >> version;
+    if (magic != RESOURCE_FILE_MAGIC || version != RESOURCE_FILE_VERSION) {
+        return false;
+    }
+    stream >> metaData;
+    if (stream.status() != QDataStream::Ok || getKey(metaData.url()) != key) {
+        metaData = QNetworkCacheMetaData();
+        return false;
+    }
+
+    if (data) {
+        *data = cacheFile.readAll();
+    }
+    return true;
+}
+
+bool ResourceDiskCache::write(const QNetworkCacheMetaData& metaData, const QByteArray& data) {
+    QByteArray contents;
+    {
+        QDataStream stream(&contents, QIODevice::WriteOnly);
+        stream << RESOURCE_FILE_MAGIC << RESOURCE_FILE_VERSION << metaData;
+    }
+    contents.append(data);
+
+    // the file being replaced is removed first, the file cache doesn't replace files in use
+    auto key = getKey(metaData.url());
+    _fileCache->removeFile(key);
+    return (bool)_fileCache->writeFile(contents.constData(), cache::FileCache::Metadata(key, contents.size()));
+}
+
+QNetworkCacheMetaData ResourceDiskCache::metaData(const QUrl& url) {
+    QNetworkCacheMetaData metaData;
+    read(url, metaData, nullptr);
+    return metaData;
+}
+
+void ResourceDiskCache::updateMetaData(const QNetworkCacheMetaData& metaData) {
+    QNetworkCacheMetaData oldMetaData;
+    QByteArray data;
+    if (read(metaData.url(), oldMetaData, &data)) {
+        write(metaData, data);
+    }
+}
+
+QIODevice* ResourceDiskCache::data(const QUrl& url) {
+    QNetworkCacheMetaData metaData;
+    QByteArray data;
+    if (!read(url, metaData, &data)) {
+        return nullptr;
+    }
+
+    // the caller owns the device, which has a copy so that the file can be ejected meanwhile
+    auto buffer = new QBuffer();
+    buffer->setData(data);
+    buffer->open(QIODevice::ReadOnly);
+    return buffer;
+}
+
+bool ResourceDiskCache::remove(const QUrl& url) {
+    {
+        QMutexLocker locker(&_preparedLock);
+        for (auto it = _prepared.begin(); it != _prepared.end();) {
+            if (it.value().url() == url) {
+                delete it.key();
+                it = _prepared.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    return _fileCache->removeFile(getKey(url));
+}
+
+qint64 ResourceDiskCache::cacheSize() const {
+    return (qint64)_fileCache->getSizeTotalFiles();
+}
+
+QIODevice* ResourceDiskCache::prepare(const QNetworkCacheMetaData& metaData) {
+    if (!metaData.isValid() || !metaData.url().isValid() || !metaData.saveToDisk()) {
+        return nullptr;
+    }
+
+    auto buffer = new QBuffer();
+    buffer->open(QIODevice::ReadWrite);
+
+    QMutexLocker locker(&_preparedLock);
+    _prepared.insert(buffer, metaData);
+    return buffer;
+}
+
+void ResourceDiskCache::insert(QIODevice* device) {
+    QNetworkCacheMetaData metaData;
+    {
+        QMutexLocker locker(&_preparedLock);
+        auto it = _prepared.find(device);
+        if (it == _prepared.end()) {
+            qCWarning(networking) << "ResourceDiskCache::insert() called with a device that wasn't prepared";
+            return;
+        }
+        metaData = it.value();
+        _prepared.erase(it);
+    }
+
+    auto buffer = static_cast<QBuffer*>(device);
+    if (!write(metaData, buffer->data())) {
+        qCWarning(networking) << "Could not write" << metaData.url() << "to the disk cache";
+    }
+    delete device;
+}
+
+void ResourceDiskCache::clear() {
+    {
+        QMutexLocker locker(&_preparedLock);
+        qDeleteAll(_prepared.keys());
+        _prepared.clear();
+    }
+    _fileCache->wipe();
+}
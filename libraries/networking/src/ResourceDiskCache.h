@@ -0,0 +1,58 @@
+//
+//  ResourceDiskCache.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceDiskCache_h
+#define hifi_ResourceDiskCache_h
+
+#include <memory>
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtNetwork/QAbstractNetworkCache>
+
+#include <shared/FileCache.h>
+
+// The disk cache of the network access manager, for the HTTP and ATP downloads, on the same file cache as the KTX textures:
+// its index is loaded without scanning the folder, and it ejects the files used once before those used again.
+class ResourceDiskCache : public QAbstractNetworkCache {
+    Q_OBJECT
+
+public:
+    ResourceDiskCache(const QString& cacheDirectory, qint64 maximumCacheSize, QObject* parent = nullptr);
+
+    // the hash of an ATP asset is the key of its content, whatever path it was mapped from
+    static cache::FileCache::Key getKey(const QUrl& url);
+
+    QString cacheDirectory() const { return QString::fromStdString(_fileCache->getDirpath()); }
+    qint64 maximumCacheSize() const { return (qint64)_fileCache->getMaxSize(); }
+
+    QNetworkCacheMetaData metaData(const QUrl& url) override;
+    void updateMetaData(const QNetworkCacheMetaData& metaData) override;
+    QIODevice* data(const QUrl& url) override;
+    bool remove(const QUrl& url) override;
+    qint64 cacheSize() const override;
+    QIODevice* prepare(const QNetworkCacheMetaData& metaData) override;
+    void insert(QIODevice* device) override;
+
+public slots:
+    void clear() override;
+
+private:
+    bool read(const QUrl& url, QNetworkCacheMetaData& metaData, QByteArray* data);
+    bool write(const QNetworkCacheMetaData& metaData, const QByteArray& data);
+
+    std::shared_ptr<cache::FileCache> _fileCache;
+
+    QMutex _preparedLock;
+    QHash<QIODevice*, QNetworkCacheMetaData> _prepared;
+};
+
+#endif // hifi_ResourceDiskCache_h
@@ -30,6 +30,7 @@ const QString STAT_HTTP_REQUEST_FAILED = "FailedHTTPRequest";
 const QString STAT_FILE_REQUEST_FAILED = "FailedFileRequest";
 const QString STAT_ATP_REQUEST_CACHE = "CacheATPRequest";
 const QString STAT_HTTP_REQUEST_CACHE = "CacheHTTPRequest";
+const QString STAT_HTTP_REQUEST_SHARED = "SharedHTTPRequest";
 const QString STAT_ATP_MAPPING_REQUEST_STARTED = "StartedATPMappingRequest";
 const QString STAT_ATP_MAPPING_REQUEST_FAILED = "FailedATPMappingRequest";
 const QString STAT_ATP_MAPPING_REQUEST_SUCCESS = "SuccessfulATPMappingRequest";
@@ -14,14 +14,18 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
 #include <LogHandler.h>
+#include <MemoryAccounting.h>
 #include <shared/QtHelpers.h>
 
 #include <platform/Platform.h>
+#include "DownstreamBandwidth.h"
 #include "NetworkLogging.h"
+#include "udt/PacketBufferPool.h"
 
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
@@ -104,6 +108,28 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
 
     // stop sending stats if we disconnect
     connect(&nodeList->getDomainHandler(), &DomainHandler::disconnectedFromDomain, &_statsTimer, &QTimer::stop);
+
+    // the clients on a weak link tell each assignment how much of it its stream can have
+    DownstreamBandwidth::Stream stream;
+    if (DownstreamBandwidth::streamForNodeType(nodeType, stream)) {
+        nodeList->getPacketReceiver().registerListener(PacketType::DownstreamBandwidth,
+            PacketReceiver::makeSourcedListenerReference<ThreadedAssignment>(this,
+                &ThreadedAssignment::handleDownstreamBandwidthPacket));
+    }
+}
+
+void ThreadedAssignment::handleDownstreamBandwidthPacket(QSharedPointer<ReceivedMessage> message,
+                                                         SharedNodePointer sendingNode) {
+    DownstreamBandwidth::Stream stream;
+    auto nodeData = sendingNode->getLinkedData();
+    if (!nodeData || !DownstreamBandwidth::streamForNodeType(DependencyManager::get<NodeList>()->getOwnerType(), stream)) {
+        return;
+    }
+
+    DownstreamBandwidth bandwidth;
+    QDataStream packetStream(message->getMessage());
+    packetStream >> bandwidth;
+    nodeData->setDownstreamShareKbps(bandwidth.getShareKbps(stream));
 }
 
 void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObject) {
@@ -118,15 +144,58 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["inbound_pps"] = nodeList->getInboundPPS();
     ioStats["outbound_kbps"] = nodeList->getOutboundKbps();
     ioStats["outbound_pps"] = nodeList->getOutboundPPS();
+    if (nodeList->isUsingBatchedReceive()) {
+        ioStats["receive_batch_size_avg"] = nodeList->getAverageReceiveBatchSize();
+        ioStats["receive_batch_size_max"] = nodeList->getMaxReceiveBatchSize();
+    }
+    if (nodeList->isUsingBatchedSend()) {
+        ioStats["send_batch_size_avg"] = nodeList->getAverageSendBatchSize();
+        ioStats["send_batch_size_max"] = nodeList->getMaxSendBatchSize();
+    }
 
     statsObject["io_stats"] = ioStats;
 
+    auto bufferPoolStats = udt::PacketBufferPool::getStats();
+    QJsonObject bufferPool;
+    bufferPool["hits"] = (qint64)bufferPoolStats.hits;
+    bufferPool["misses"] = (qint64)bufferPoolStats.misses;
+    bufferPool["oversized"] = (qint64)bufferPoolStats.oversized;
+    bufferPool["freed"] = (qint64)bufferPoolStats.freed;
+    bufferPool["depot_size"] = bufferPoolStats.depotSize;
+
+    statsObject["packet_buffer_pool"] = bufferPool;
+
+    auto& memoryAccounting = MemoryAccounting::getInstance();
+    auto memoryUsage = memoryAccounting.sample();
+    statsObject["memory"] = MemoryAccounting::toJson(memoryUsage);
+    memoryAccounting.logSnapshotIfDue();
+
     QJsonObject assignmentStats;
     assignmentStats["numQueuedCheckIns"] = _numQueuedCheckIns;
 
     statsObject["assignmentStats"] = assignmentStats;
 
     nodeList->sendStatsToDomainServer(statsObject);
+
+    _metrics.setGauge("inbound_kbps", nodeList->getInboundKbps());
+    _metrics.setGauge("inbound_pps", nodeList->getInboundPPS());
+    _metrics.setGauge("outbound_kbps", nodeList->getOutboundKbps());
+    _metrics.setGauge("outbound_pps", nodeList->getOutboundPPS());
+    _metrics.setGauge("queued_check_ins", _numQueuedCheckIns);
+    _metrics.setCounter("packet_buffer_pool_hits_total", (double)bufferPoolStats.hits);
+    _metrics.setCounter("packet_buffer_pool_misses_total", (double)bufferPoolStats.misses);
+    for (const auto& usage : memoryUsage) {
+        // "resources.TextureCache" is reported as memory_resources_texturecache_bytes
+        static const QRegularExpression INVALID_METRIC_CHARACTERS("[^a-z0-9_]+");
+        QString metricName = "memory_" + usage.name.toLower().replace(INVALID_METRIC_CHARACTERS, "_");
+        _metrics.setGauge(metricName + "_bytes", (double)usage.bytes);
+        _metrics.setGauge(metricName + "_count", (double)usage.count);
+    }
+
+    QByteArray metrics;
+    QDataStream metricsStream(&metrics, QIODevice::WriteOnly);
+    metricsStream << _metrics;
+    nodeList->sendMetricsToDomainServer(metrics);
 }
 
 void ThreadedAssignment::sendStatsPacket() {
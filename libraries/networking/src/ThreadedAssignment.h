@@ -14,6 +14,7 @@
 
 #include <QtCore/QSharedPointer>
 
+#include "NodeMetrics.h"
 #include "ReceivedMessage.h"
 
 #include "Assignment.h"
@@ -47,6 +48,8 @@ protected:
     bool _isFinished;
     QTimer _domainServerTimer;
     QTimer _statsTimer;
+    // filled in by the sendStatsPacket implementations, sent along with the JSON stats
+    NodeMetrics _metrics;
     int _numQueuedCheckIns { 0 };
 
 protected slots:
@@ -54,6 +57,7 @@ protected slots:
 
 private slots:
     void checkInWithDomainServerOrExit();
+    void handleDownstreamBandwidthPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
 };
 
 typedef QSharedPointer<ThreadedAssignment> SharedAssignmentPointer;
@@ -0,0 +1,312 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-23.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+using namespace udt;
+using namespace std::chrono;
+
+// 2 / ln(2), the smallest gain that doubles the sending rate every round trip
+static const double STARTUP_GAIN = 2.885;
+static const double DRAIN_GAIN = 1.0 / STARTUP_GAIN;
+static const double PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN = 2.0;
+
+// probe for more bandwidth for one min RTT, drain the queue that may have built up for one, then cruise for six
+static const int PACING_GAIN_CYCLE_LENGTH = 8;
+static const double PACING_GAIN_CYCLE[PACING_GAIN_CYCLE_LENGTH] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+// the bandwidth has stopped growing if it didn't grow by 25% for three round trips
+static const double FULL_BANDWIDTH_THRESHOLD = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const auto MIN_RTT_WINDOW = seconds(10);
+static const auto PROBE_RTT_DURATION = milliseconds(200);
+
+static const int INITIAL_CONGESTION_WINDOW = 10;
+static const int MIN_CONGESTION_WINDOW = 4;
+
+static const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+BBRCC::BBRCC() {
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = INITIAL_CONGESTION_WINDOW;
+
+    _pacingGain = STARTUP_GAIN;
+    _congestionWindowGain = STARTUP_GAIN;
+
+    _bandwidthSamples.fill(0.0);
+
+    // we can't do this as a member initializer until our VS has support for constexpr
+    _minRTT = std::numeric_limits<int>::max();
+}
+
+int BBRCC::getPacketsInFlight() const {
+    return seqlen(_lastACK, _sendCurrSeqNum) - 1;
+}
+
+double BBRCC::getBDP() const {
+    if (_minRTT == std::numeric_limits<int>::max()) {
+        return 0.0;
+    }
+    return _bottleneckBandwidth * _minRTT / USECS_PER_SECOND;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPacketDatas.empty()) {
+        // nothing is in flight, so the delivery rate of this packet is measured from now
+        _deliveredTime = timePoint;
+        _firstSentTime = timePoint;
+    }
+
+    SentPacketData sentPacketData;
+    sentPacketData.sequenceNumber = seqNum;
+    sentPacketData.timePoint = timePoint;
+    sentPacketData.delivered = _delivered;
+    sentPacketData.deliveredTime = _deliveredTime;
+    sentPacketData.firstSentTime = _firstSentTime;
+    _sentPacketDatas.push_back(sentPacketData);
+}
+
+void BBRCC::onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [seqNum](SentPacketData& sentPacketData) {
+        return sentPacketData.sequenceNumber == seqNum;
+    });
+
+    // a re-sent packet can't be used for RTT calculations, its ACK could be for either send
+    if (it != _sentPacketDatas.end()) {
+        it->wasResent = true;
+    }
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    auto previousAck = _lastACK;
+    _lastACK = ack;
+
+    if (ack == previousAck) {
+        // duplicate ACKs don't tell us anything about the path, but may signal a loss
+        return needsFastRetransmit();
+    }
+    _duplicateACKCount = 0;
+
+    int newlyDelivered = seqlen(previousAck, ack) - 1;
+    _delivered += newlyDelivered;
+    _deliveredTime = receiveTime;
+
+    _minRTTExpired = _minRTT != std::numeric_limits<int>::max() && receiveTime - _minRTTTimestamp > MIN_RTT_WINDOW;
+
+    bool isRoundStart = false;
+    double deliveryRate = 0.0;
+
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [ack](SentPacketData& sentPacketData) {
+        return sentPacketData.sequenceNumber == ack;
+    });
+
+    if (it != _sentPacketDatas.end()) {
+        bool canBeUsedForRTT = std::none_of(_sentPacketDatas.begin(), it + 1, [](SentPacketData& sentPacketData) {
+            return sentPacketData.wasResent;
+        });
+
+        SentPacketData packet = *it;
+        _sentPacketDatas.erase(_sentPacketDatas.begin(), it + 1);
+        _firstSentTime = packet.timePoint;
+
+        if (canBeUsedForRTT) {
+            updateRTT((int)duration_cast<microseconds>(receiveTime - packet.timePoint).count(), receiveTime);
+        }
+
+        // a round trip ends when a packet sent after the start of the round is ACKed
+        if (packet.delivered >= _nextRoundDelivered) {
+            _nextRoundDelivered = _delivered;
+            ++_roundCount;
+            isRoundStart = true;
+        }
+
+        // the delivery rate is measured over the longest of the send and ACK intervals, which can't be shorter than the
+        // min RTT unless ACKs were compressed
+        auto sendElapsed = packet.timePoint - packet.firstSentTime;
+        auto ackElapsed = receiveTime - packet.deliveredTime;
+        auto interval = duration_cast<microseconds>(std::max(sendElapsed, ackElapsed)).count();
+        if (interval > 0 && interval >= minRTT()) {
+            deliveryRate = (double)(_delivered - packet.delivered) * USECS_PER_SECOND / interval;
+        }
+    }
+
+    updateBandwidth(deliveryRate, isRoundStart);
+    updateMode(isRoundStart, receiveTime);
+    updateControlParameters(newlyDelivered);
+
+    return false;
+}
+
+bool BBRCC::needsFastRetransmit() {
+    // fallback to Reno's fast re-transmit on the 3rd duplicate ACK, without touching the model
+    static const int RENO_FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+
+    if (++_duplicateACKCount == RENO_FAST_RETRANSMIT_DUPLICATE_COUNT) {
+        _duplicateACKCount = 0;
+        return true;
+    }
+    return false;
+}
+
+void BBRCC::updateRTT(int rtt, p_high_resolution_clock::time_point now) {
+    if (rtt < 0) {
+        Q_ASSERT_X(false, __FUNCTION__, "calculated an RTT that is not > 0");
+        return;
+    }
+    rtt = std::min(std::max(rtt, 1), MAX_RTT_SAMPLE_MICROSECONDS);
+
+    // Jacobson's estimation, as in TCPVegasCC, only used for the timeout
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        static const int RTT_ESTIMATION_ALPHA = 8;
+        static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1)
+                        + abs(rtt - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    if (rtt <= _minRTT || _minRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTimestamp = now;
+    }
+}
+
+void BBRCC::updateBandwidth(double deliveryRate, bool isRoundStart) {
+    // each new round replaces the max of the round that is now out of the window
+    auto& sample = _bandwidthSamples[_roundCount % BANDWIDTH_FILTER_ROUNDS];
+    if (isRoundStart) {
+        sample = 0.0;
+    }
+    sample = std::max(sample, deliveryRate);
+
+    _bottleneckBandwidth = *std::max_element(_bandwidthSamples.begin(), _bandwidthSamples.end());
+}
+
+void BBRCC::enterProbeBandwidth(p_high_resolution_clock::time_point now) {
+    _mode = Mode::ProbeBandwidth;
+    _congestionWindowGain = PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN;
+
+    // start anywhere in the cycle but on the drain phase, so that connections sharing a link don't probe in sync
+    _cycleIndex = randIntInRange(1, PACING_GAIN_CYCLE_LENGTH - 1);
+    if (_cycleIndex == 1) {
+        _cycleIndex = 0;
+    }
+    _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+    _cycleTimestamp = now;
+}
+
+void BBRCC::updateMode(bool isRoundStart, p_high_resolution_clock::time_point now) {
+    int packetsInFlight = getPacketsInFlight();
+
+    if (isRoundStart && !_isPipeFilled) {
+        if (_bottleneckBandwidth >= _fullBandwidth * FULL_BANDWIDTH_THRESHOLD) {
+            _fullBandwidth = _bottleneckBandwidth;
+            _fullBandwidthCount = 0;
+        } else if (++_fullBandwidthCount >= FULL_BANDWIDTH_ROUNDS) {
+            _isPipeFilled = true;
+        }
+    }
+
+    if (_mode == Mode::Startup && _isPipeFilled) {
+        _mode = Mode::Drain;
+        _pacingGain = DRAIN_GAIN;
+    }
+    if (_mode == Mode::Drain && packetsInFlight <= getBDP()) {
+        enterProbeBandwidth(now);
+    }
+
+    if (_mode == Mode::ProbeBandwidth) {
+        auto pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+        bool isPhaseOver = now - _cycleTimestamp > microseconds(_minRTT);
+        if (pacingGain < 1.0) {
+            // the drain phase can end early, once the queue it is draining is gone
+            isPhaseOver = isPhaseOver || packetsInFlight <= getBDP();
+        }
+
+        if (isPhaseOver) {
+            _cycleIndex = (_cycleIndex + 1) % PACING_GAIN_CYCLE_LENGTH;
+            _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+            _cycleTimestamp = now;
+        }
+    }
+
+    if (_mode != Mode::ProbeRTT && _minRTTExpired) {
+        // the min RTT hasn't been seen for a while, drop what is in flight to see if it is still valid
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _congestionWindowGain = 1.0;
+        _priorCongestionWindowSize = _congestionWindowSize;
+        _probeRTTDoneTimestamp = p_high_resolution_clock::time_point();
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        if (_probeRTTDoneTimestamp == p_high_resolution_clock::time_point()) {
+            if (packetsInFlight <= MIN_CONGESTION_WINDOW) {
+                // hold the small window for at least a round trip and PROBE_RTT_DURATION
+                _probeRTTDoneTimestamp = now + PROBE_RTT_DURATION;
+                _isProbeRTTRoundDone = false;
+                _nextRoundDelivered = _delivered;
+            }
+        } else {
+            if (isRoundStart) {
+                _isProbeRTTRoundDone = true;
+            }
+            if (_isProbeRTTRoundDone && now > _probeRTTDoneTimestamp) {
+                _minRTTTimestamp = now;
+                _congestionWindowSize = std::max(_congestionWindowSize, _priorCongestionWindowSize);
+
+                if (_isPipeFilled) {
+                    enterProbeBandwidth(now);
+                } else {
+                    _mode = Mode::Startup;
+                    _pacingGain = STARTUP_GAIN;
+                    _congestionWindowGain = STARTUP_GAIN;
+                }
+            }
+        }
+    }
+}
+
+void BBRCC::updateControlParameters(int newlyDelivered) {
+    if (_bottleneckBandwidth > 0.0) {
+        setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * _bottleneckBandwidth));
+    } else if (_ewmaRTT > 0) {
+        // no delivery rate sample yet, pace the congestion window over a round trip
+        setPacketSendPeriod(_ewmaRTT / (_pacingGain * _congestionWindowSize));
+    }
+
+    int targetWindowSize = std::max(MIN_CONGESTION_WINDOW, (int)std::ceil(_congestionWindowGain * getBDP()));
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = std::min(_congestionWindowSize, MIN_CONGESTION_WINDOW);
+    } else if (_isPipeFilled) {
+        _congestionWindowSize = std::min(_congestionWindowSize + newlyDelivered, targetWindowSize);
+    } else if (_congestionWindowSize < targetWindowSize || _delivered < INITIAL_CONGESTION_WINDOW) {
+        // while searching for the bandwidth, grow the window by what is delivered, like slow start
+        _congestionWindowSize += newlyDelivered;
+    }
+
+    _congestionWindowSize = std::min(std::max(_congestionWindowSize, MIN_CONGESTION_WINDOW), udt::MAX_PACKETS_IN_FLIGHT);
+}
+
+int BBRCC::estimatedTimeout() const {
+    return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
+}
@@ -0,0 +1,125 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-23.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <limits>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Model based congestion control, after BBR (https://queue.acm.org/detail.cfm?id=3022184).
+//
+// Instead of reacting to loss or to RTT increases like TCPVegasCC, it keeps estimates of the bottleneck bandwidth
+// (the max delivery rate over the last few round trips) and of the min RTT (over the last ten seconds), paces
+// packets at that bandwidth and keeps about two bandwidth-delay products in flight.
+// Random loss and long RTTs on their own don't slow it down.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onTimeout() override {};
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+    virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual int estimatedTimeout() const override;
+
+    virtual int estimatedBandwidth() const override { return (int)_bottleneckBandwidth; }
+    virtual int estimatedRTT() const override { return std::max(_ewmaRTT, 0); }
+    virtual int minRTT() const override { return _minRTT == std::numeric_limits<int>::max() ? 0 : _minRTT; }
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    enum class Mode {
+        Startup, // exponential search for the bottleneck bandwidth
+        Drain, // drain the queue built up during startup
+        ProbeBandwidth, // cruise at the bottleneck bandwidth, with periodic probes up and down
+        ProbeRTT // briefly drop the packets in flight to refresh the min RTT
+    };
+
+    struct SentPacketData {
+        SequenceNumber sequenceNumber;
+        p_high_resolution_clock::time_point timePoint;
+        // delivery state when the packet was sent, for the delivery rate sample of its ACK
+        int64_t delivered;
+        p_high_resolution_clock::time_point deliveredTime;
+        p_high_resolution_clock::time_point firstSentTime;
+        bool wasResent { false };
+    };
+
+    void updateRTT(int rtt, p_high_resolution_clock::time_point now);
+    void updateBandwidth(double deliveryRate, bool isRoundStart);
+    void updateMode(bool isRoundStart, p_high_resolution_clock::time_point now);
+    void enterProbeBandwidth(p_high_resolution_clock::time_point now);
+    void updateControlParameters(int newlyDelivered);
+    bool needsFastRetransmit();
+
+    int getPacketsInFlight() const;
+    // bandwidth-delay product, in packets
+    double getBDP() const;
+
+    std::deque<SentPacketData> _sentPacketDatas;
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+    int _duplicateACKCount { 0 };
+
+    // delivery rate sampling
+    int64_t _delivered { 0 }; // packets ACKed during the connection
+    p_high_resolution_clock::time_point _deliveredTime;
+    p_high_resolution_clock::time_point _firstSentTime; // send time of the last ACKed packet
+
+    // round trips, counted in delivered packets
+    int64_t _nextRoundDelivered { 0 };
+    uint64_t _roundCount { 0 };
+
+    // windowed max of the delivery rate, one entry per round trip, in packets per second
+    static const int BANDWIDTH_FILTER_ROUNDS = 10;
+    std::array<double, BANDWIDTH_FILTER_ROUNDS> _bandwidthSamples;
+    double _bottleneckBandwidth { 0.0 };
+
+    int _minRTT; // in microseconds
+    p_high_resolution_clock::time_point _minRTTTimestamp;
+    bool _minRTTExpired { false };
+    int _ewmaRTT { -1 };
+    int _rttVariance { 0 };
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    // startup ends once the bandwidth stops growing
+    bool _isPipeFilled { false };
+    double _fullBandwidth { 0.0 };
+    int _fullBandwidthCount { 0 };
+
+    int _cycleIndex { 0 };
+    p_high_resolution_clock::time_point _cycleTimestamp;
+
+    p_high_resolution_clock::time_point _probeRTTDoneTimestamp;
+    bool _isProbeRTTRoundDone { false };
+    int _priorCongestionWindowSize { 0 }; // restored after probing the RTT
+};
+
+}
+
+#endif // hifi_BBRCC_h
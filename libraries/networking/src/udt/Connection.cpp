@@ -11,10 +11,9 @@
 
 #include "Connection.h"
 
+#include <algorithm>
 #include <random>
 
-#include <QtCore/QThread>
-
 #include <NumericalConstants.h>
 
 #include "../HifiSockAddr.h"
@@ -68,20 +67,14 @@ Connection::~Connection() {
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
         // tell the send queue to stop and be deleted
-        
         sendQueue->stop();
 
         _lastMessageNumber = sendQueue->getCurrentMessageNumber();
 
-        sendQueue->deleteLater();
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
+        // the send queue removes itself from its pacing thread, waiting for any step in progress,
+        // so it is safe to delete it from here
+        delete sendQueue;
     }
 }
 
@@ -204,8 +197,21 @@ void Connection::recordSentUnreliablePackets(int wireSize, int payloadSize) {
     _stats.recordUnreliableSentPackets(payloadSize, wireSize);
 }
 
-void Connection::recordReceivedUnreliablePackets(int wireSize, int payloadSize) {
-    _stats.recordUnreliableReceivedPackets(payloadSize, wireSize);
+void Connection::recordReceivedUnreliablePackets(int wireSize, int payloadSize, SequenceNumber lastSequenceNumber,
+                                                 int numPackets) {
+    _stats.recordUnreliableReceivedPackets(payloadSize, wireSize, numPackets);
+
+    // packets that come in late have been counted as lost, as they are by the jitter buffers they are for, and a jump
+    // further than a sender would lose means it started numbering over
+    static const int MAX_UNRELIABLE_SEQUENCE_GAP = 1000;
+    int gap = seqoff(_lastReceivedUnreliableSequenceNumber, lastSequenceNumber);
+    if (!_hasReceivedUnreliablePacket || gap > MAX_UNRELIABLE_SEQUENCE_GAP || gap < -MAX_UNRELIABLE_SEQUENCE_GAP) {
+        _hasReceivedUnreliablePacket = true;
+        _lastReceivedUnreliableSequenceNumber = lastSequenceNumber;
+    } else if (gap > 0) {
+        _stats.recordLostPackets(std::max(gap - numPackets, 0));
+        _lastReceivedUnreliableSequenceNumber = lastSequenceNumber;
+    }
 }
 
 void Connection::sendACK() {
@@ -259,6 +265,7 @@ bool Connection::processReceivedSequenceNumber(SequenceNumber sequenceNumber, in
     
     // If this is not the next sequence number, report loss
     if (sequenceNumber > _lastReceivedSequenceNumber + 1) {
+        _stats.recordLostPackets(seqoff(_lastReceivedSequenceNumber, sequenceNumber) - 1);
         if (_lastReceivedSequenceNumber + 1 == sequenceNumber - 1) {
             _lossList.append(_lastReceivedSequenceNumber + 1);
         } else {
@@ -443,6 +450,9 @@ void Connection::updateCongestionControlAndSendQueue(std::function<void ()> cong
     // record connection stats
     _stats.recordPacketSendPeriod(_congestionControl->_packetSendPeriod);
     _stats.recordCongestionWindowSize(_congestionControl->_congestionWindowSize);
+    _stats.recordEstimatedBandwidth(_congestionControl->estimatedBandwidth());
+    _stats.recordRTT(_congestionControl->estimatedRTT());
+    _stats.recordMinRTT(_congestionControl->minRTT());
 }
 
 void PendingReceivedMessage::enqueuePacket(std::unique_ptr<Packet> packet) {
@@ -76,7 +76,9 @@ public:
     bool hasReceivedHandshake() const { return _hasReceivedHandshake; }
     
     void recordSentUnreliablePackets(int wireSize, int payloadSize);
-    void recordReceivedUnreliablePackets(int wireSize, int payloadSize);
+    // lastSequenceNumber is the highest of the packets, the ones it skips over are counted as lost
+    void recordReceivedUnreliablePackets(int wireSize, int payloadSize, SequenceNumber lastSequenceNumber,
+                                         int numPackets = 1);
     void setDestinationAddress(const HifiSockAddr& destination);
 
 signals:
@@ -122,6 +124,8 @@ private:
     LossList _lossList; // List of all missing packets
     SequenceNumber _lastReceivedSequenceNumber; // The largest sequence number received from the peer
     SequenceNumber _lastReceivedACK; // The last ACK received
+    SequenceNumber _lastReceivedUnreliableSequenceNumber; // The largest unreliable sequence number received from the peer
+    bool _hasReceivedUnreliablePacket { false };
     
     Socket* _parentSocket { nullptr };
     HifiSockAddr _destination;
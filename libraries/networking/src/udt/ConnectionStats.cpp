@@ -11,6 +11,8 @@
 
 #include "ConnectionStats.h"
 
+#include <algorithm>
+
 #include <QtCore/QDebug>
 
 using namespace udt;
@@ -76,12 +78,29 @@ void ConnectionStats::recordUnreliableSentPackets(int payload, int total) {
     _currentSample.sentUnreliableBytes += total;
 }
 
-void ConnectionStats::recordUnreliableReceivedPackets(int payload, int total) {
-    ++_currentSample.receivedUnreliablePackets;
+void ConnectionStats::recordUnreliableReceivedPackets(int payload, int total, int numPackets) {
+    _currentSample.receivedUnreliablePackets += numPackets;
     _currentSample.receivedUnreliableUtilBytes += payload;
     _currentSample.receivedUnreliableBytes += total;
 }
 
+void ConnectionStats::recordLostPackets(int numPackets) {
+    _currentSample.lostPackets += numPackets;
+}
+
+void ConnectionStats::recordReceiveBatch(int numPackets) {
+    ++_currentSample.receiveBatches;
+    _currentSample.receiveBatchedPackets += numPackets;
+    _currentSample.maxReceiveBatchSize = std::max(_currentSample.maxReceiveBatchSize, (uint32_t)numPackets);
+}
+
+void ConnectionStats::recordSendBatch(int numPackets, int numSegmentedSends) {
+    ++_currentSample.sendBatches;
+    _currentSample.sendBatchedPackets += numPackets;
+    _currentSample.maxSendBatchSize = std::max(_currentSample.maxSendBatchSize, (uint32_t)numPackets);
+    _currentSample.segmentedSends += numSegmentedSends;
+}
+
 void ConnectionStats::recordCongestionWindowSize(int sample) {
     _currentSample.congestionWindowSize = sample;
 }
@@ -90,6 +109,18 @@ void ConnectionStats::recordPacketSendPeriod(int sample) {
     _currentSample.packetSendPeriod = sample;
 }
 
+void ConnectionStats::recordEstimatedBandwidth(int sample) {
+    _currentSample.estimatedBandwith = sample;
+}
+
+void ConnectionStats::recordRTT(int sample) {
+    _currentSample.rtt = sample;
+}
+
+void ConnectionStats::recordMinRTT(int sample) {
+    _currentSample.minRTT = sample;
+}
+
 QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "Connection stats:\n";
 #define HIFI_LOG_EVENT(x) << "    " #x " events: " << stats.events[ConnectionStats::Stats::Event::x] << "\n"
@@ -104,8 +135,24 @@ QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "\n    Retransmitted packets: " << stats.retransmittedPackets;
     debug << "\n     Received packets: " << stats.receivedPackets;
     debug << "\n     Duplicate packets: " << stats.duplicatePackets;
+    debug << "\n     Lost packets: " << stats.lostPackets;
     debug << "\n     Sent util bytes: " << stats.sentUtilBytes;
     debug << "\n     Sent bytes: " << stats.sentBytes;
-    debug << "\n     Received bytes: " << stats.receivedBytes << "\n";
+    debug << "\n     Received bytes: " << stats.receivedBytes;
+    if (stats.rtt > 0) {
+        debug << "\n     Est. bandwidth (P/s): " << stats.estimatedBandwith;
+        debug << "\n     RTT (us): " << stats.rtt << "(min" << stats.minRTT << ")";
+    }
+    if (stats.receiveBatches > 0) {
+        debug << "\n     Receive batches: " << stats.receiveBatches
+            << "(avg" << (float)stats.receiveBatchedPackets / stats.receiveBatches
+            << "max" << stats.maxReceiveBatchSize << "packets)";
+    }
+    if (stats.sendBatches > 0) {
+        debug << "\n     Send batches: " << stats.sendBatches
+            << "(avg" << (float)stats.sendBatchedPackets / stats.sendBatches
+            << "max" << stats.maxSendBatchSize << "packets," << stats.segmentedSends << "segmented)";
+    }
+    debug << "\n";
     return debug;
 }
@@ -60,12 +60,25 @@ public:
         uint64_t receivedUnreliableUtilBytes { 0 };
         uint64_t sentUnreliableBytes { 0 };
         uint64_t receivedUnreliableBytes { 0 };
+
+        // the sequence numbers skipped over by what was received, reliable and unreliable
+        uint32_t lostPackets { 0 };
+
+        // send and receive batching (socket-wide sample only)
+        uint32_t receiveBatches { 0 };
+        uint32_t receiveBatchedPackets { 0 };
+        uint32_t maxReceiveBatchSize { 0 };
+        uint32_t sendBatches { 0 };
+        uint32_t sendBatchedPackets { 0 };
+        uint32_t maxSendBatchSize { 0 };
+        uint32_t segmentedSends { 0 };
        
         // the following stats are trailing averages in the result, not totals
         int sendRate { 0 };
         int receiveRate { 0 };
         int estimatedBandwith { 0 };
         int rtt { 0 };
+        int minRTT { 0 };
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
         
@@ -89,10 +102,19 @@ public:
     void recordDuplicatePackets(int payload, int total);
     
     void recordUnreliableSentPackets(int payload, int total);
-    void recordUnreliableReceivedPackets(int payload, int total);
+    void recordUnreliableReceivedPackets(int payload, int total, int numPackets = 1);
+    void recordLostPackets(int numPackets);
+
+    void recordReceiveBatch(int numPackets);
+    void recordSendBatch(int numPackets, int numSegmentedSends);
 
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
+
+    // path estimates of the congestion control, in packets per second and microseconds
+    void recordEstimatedBandwidth(int sample);
+    void recordRTT(int sample);
+    void recordMinRTT(int sample);
     
 private:
     Stats _currentSample;
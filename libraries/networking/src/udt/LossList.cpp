@@ -11,11 +11,37 @@
 
 #include "LossList.h"
 
+#include <algorithm>
+
 #include "ControlPacket.h"
 
 using namespace udt;
 using namespace std;
 
+LossList::Iterator LossList::findRange(SequenceNumber seq) {
+    return std::partition_point(begin(), _lossList.end(), [&seq](const Range& range) {
+        return range.second < seq;
+    });
+}
+
+LossList::Iterator LossList::eraseRanges(Iterator first, Iterator last) {
+    if (first != begin()) {
+        return _lossList.erase(first, last);
+    }
+
+    // removing from the front, only move the start of the list and compact it once in a while
+    static const size_t MIN_COMPACTED_RANGES = 64;
+    _first += last - first;
+    if (isRangesEmpty()) {
+        _lossList.clear();
+        _first = 0;
+    } else if (_first >= MIN_COMPACTED_RANGES && _first * 2 >= _lossList.size()) {
+        _lossList.erase(_lossList.begin(), begin());
+        _first = 0;
+    }
+    return begin();
+}
+
 void LossList::append(SequenceNumber seq) {
     Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
@@ -47,14 +73,18 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
+    auto it = findRange(start);
     
     if (it == _lossList.end() || end < it->first) {
         // No overlap, simply insert
         _length += seqlen(start, end);
-        _lossList.insert(it, make_pair(start, end));
+        if (it == begin() && _first > 0) {
+            // re-use the space left by a range removed from the front
+            --_first;
+            *begin() = make_pair(start, end);
+        } else {
+            _lossList.insert(it, make_pair(start, end));
+        }
     } else {
         // If it starts before segment, extend segment
         if (start < it->first) {
@@ -68,31 +98,29 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
             it->second = end;
         }
         
-        auto it2 = it;
-        ++it2;
+        auto last = it + 1;
         // For all ranges touching the current range
-        while (it2 != _lossList.end() && it->second >= it2->first - 1) {
+        while (last != _lossList.end() && it->second >= last->first - 1) {
             // extend current range if necessary
-            if (it->second < it2->second) {
-                _length += seqlen(it->second + 1, it2->second);
-                it->second = it2->second;
+            if (it->second < last->second) {
+                _length += seqlen(it->second + 1, last->second);
+                it->second = last->second;
             }
             
-            // Remove overlapping range
-            _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
+            // Overlapping range is removed below
+            _length -= seqlen(last->first, last->second);
+            ++last;
         }
+        eraseRanges(it + 1, last);
     }
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
+    auto it = findRange(seq);
     
-    if (it != end(_lossList)) {
+    if (it != _lossList.end() && it->first <= seq) {
         if (it->first == it->second) {
-            _lossList.erase(it);
+            eraseRanges(it, it + 1);
         } else if (seq == it->first) {
             ++it->first;
         } else if (seq == it->second) {
@@ -100,7 +128,7 @@ bool LossList::remove(SequenceNumber seq) {
         } else {
             auto temp = it->second;
             it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
+            _lossList.insert(it + 1, make_pair(seq + 1, temp));
         }
         _length -= 1;
         
@@ -116,63 +144,67 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
+    auto it = findRange(start);
+    if (it == _lossList.end()) {
+        return;
+    }
     
-    // If we found one
-    if (it != _lossList.end()) {
-        
-        // While the end of the current segment is contained, either shorten it (first one only - sometimes)
-        // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
-                // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
-            } else {
-                // Beginning of segment not contained, modify end of segment.
-                // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
-            }
+    if (it->first < start) {
+        if (end < it->second) {
+            // Cut it in half if the range we are removing is contained within one segment
+            _length -= seqlen(start, end);
+            auto temp = it->second;
+            it->second = start - 1;
+            _lossList.insert(it + 1, make_pair(end + 1, temp));
+            return;
         }
         
-        // There might be more to remove
-        if (it != _lossList.end() && it->first <= end) {
-            if (start <= it->first) {
-                // Truncate beginning of segment
-                _length -= seqlen(it->first, end);
-                it->first = end + 1;
-            } else {
-                // Cut it in half if the range we are removing is contained within one segment
-                _length -= seqlen(start, end);
-                auto temp = it->second;
-                it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
-            }
-        }
+        // Beginning of segment not contained, modify end of segment.
+        _length -= seqlen(start, it->second);
+        it->second = start - 1;
+        ++it;
     }
+    
+    // Segments fully contained in the range are removed altogether
+    auto last = it;
+    while (last != _lossList.end() && last->second <= end) {
+        _length -= seqlen(last->first, last->second);
+        ++last;
+    }
+    
+    // There might be more to remove, truncate beginning of segment
+    if (last != _lossList.end() && last->first <= end) {
+        _length -= seqlen(last->first, end);
+        last->first = end + 1;
+    }
+    
+    eraseRanges(it, last);
 }
 
 SequenceNumber LossList::getFirstSequenceNumber() const {
     Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
-    return _lossList.front().first;
+    return _lossList[_first].first;
 }
 
 SequenceNumber LossList::popFirstSequenceNumber() {
-    auto front = getFirstSequenceNumber();
-    remove(front);
-    return front;
+    Q_ASSERT_X(getLength() > 0, "LossList::popFirstSequenceNumber()", "Trying to pop first element of an empty list");
+    auto& front = *begin();
+    auto seq = front.first;
+    if (front.first == front.second) {
+        eraseRanges(begin(), begin() + 1);
+    } else {
+        ++front.first;
+    }
+    _length -= 1;
+    return seq;
 }
 
 void LossList::write(ControlPacket& packet, int maxPairs) {
     int writtenPairs = 0;
     
-    for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
+    for (auto it = _lossList.cbegin() + _first; it != _lossList.cend(); ++it) {
+        packet.writePrimitive(it->first);
+        packet.writePrimitive(it->second);
         
         ++writtenPairs;
         
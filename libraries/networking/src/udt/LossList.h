@@ -12,7 +12,8 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <utility>
+#include <vector>
 
 #include "SequenceNumber.h"
 
@@ -20,17 +21,20 @@ namespace udt {
 
 class ControlPacket;
     
+// Sorted ranges of lost sequence numbers, in a vector.
+// Lookups are binary searches, and ranges removed from the front (the common case, as losses are re-sent and ACKed
+// in order) only move the start of the list, the space is reclaimed once it is half of the vector.
 class LossList {
 public:
     LossList() {}
     
-    void clear() { _length = 0; _lossList.clear(); }
+    void clear() { _length = 0; _first = 0; _lossList.clear(); }
     
     // must always add at the end - faster than insert
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere - slower, as the ranges after it are moved
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -44,7 +48,18 @@ public:
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    using Range = std::pair<SequenceNumber, SequenceNumber>;
+    using Iterator = std::vector<Range>::iterator;
+
+    Iterator begin() { return _lossList.begin() + _first; }
+    bool isRangesEmpty() const { return _first == _lossList.size(); }
+    // the first range that ends at or after seq
+    Iterator findRange(SequenceNumber seq);
+    // returns the range after the erased ones
+    Iterator eraseRanges(Iterator first, Iterator last);
+
+    std::vector<Range> _lossList;
+    size_t _first { 0 }; // ranges before this one have been removed
     int _length { 0 };
 };
     
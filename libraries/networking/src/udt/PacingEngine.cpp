@@ -0,0 +1,167 @@
+//
+//  PacingEngine.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-22.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacingEngine.h"
+
+#include <algorithm>
+
+#include <ThreadHelpers.h>
+
+#include "SendQueue.h"
+
+using namespace udt;
+
+// the send loop used to sleep_for the packet send period, which isn't any more precise than this
+static const std::chrono::microseconds TIMER_RESOLUTION { 100 };
+static const int MAX_PACING_THREADS = 4;
+
+PacingThread::PacingThread(int index) :
+    _wheel(TIMER_RESOLUTION, p_high_resolution_clock::now())
+{
+    setObjectName(QString("Networking: Pacing %1").arg(index));
+}
+
+PacingThread::~PacingThread() {
+    stop();
+    wait();
+}
+
+void PacingThread::stop() {
+    {
+        Lock lock(_mutex);
+        _stop = true;
+    }
+    _condition.notify_one();
+}
+
+int PacingThread::getNumQueues() const {
+    Lock lock(_mutex);
+    return (int)_queues.size();
+}
+
+void PacingThread::add(SendQueue* queue) {
+    {
+        Lock lock(_mutex);
+        scheduleLocked(queue, _queues[queue], p_high_resolution_clock::now());
+    }
+    _condition.notify_one();
+}
+
+void PacingThread::remove(SendQueue* queue) {
+    Lock lock(_mutex);
+    _steppedCondition.wait(lock, [&] { return _stepping != queue; });
+    _queues.erase(queue);
+}
+
+void PacingThread::wake(SendQueue* queue) {
+    {
+        Lock lock(_mutex);
+        auto it = _queues.find(queue);
+        if (it == _queues.end()) {
+            return;
+        }
+        if (_stepping == queue) {
+            it->second.wakeRequested = true;
+            return;
+        }
+        scheduleLocked(queue, it->second, p_high_resolution_clock::now());
+    }
+    _condition.notify_one();
+}
+
+void PacingThread::scheduleLocked(SendQueue* queue, QueueState& state, p_high_resolution_clock::time_point when) {
+    state.generation = ++_nextGeneration;
+    _wheel.schedule({ queue, state.generation }, when);
+}
+
+void PacingThread::run() {
+    setThreadName(objectName().toStdString());
+
+    std::vector<Timer> expired;
+    Lock lock(_mutex);
+    while (!_stop) {
+        _wheel.advance(p_high_resolution_clock::now(), expired);
+        if (expired.empty()) {
+            auto nextCheck = _wheel.getNextCheck();
+            if (nextCheck == p_high_resolution_clock::time_point::max()) {
+                _condition.wait(lock);
+            } else {
+                _condition.wait_until(lock, nextCheck);
+            }
+            continue;
+        }
+
+        for (const auto& timer : expired) {
+            auto it = _queues.find(timer.queue);
+            if (it == _queues.end() || it->second.generation != timer.generation) {
+                // the queue has been removed or rescheduled since
+                continue;
+            }
+
+            _stepping = timer.queue;
+            lock.unlock();
+            auto nextStep = timer.queue->step();
+            lock.lock();
+            _stepping = nullptr;
+
+            // the queue can't be removed while it's being stepped, but others may have been added
+            auto& state = _queues[timer.queue];
+            if (state.wakeRequested) {
+                state.wakeRequested = false;
+                nextStep = p_high_resolution_clock::now();
+            }
+            if (nextStep != p_high_resolution_clock::time_point::max()) {
+                scheduleLocked(timer.queue, state, nextStep);
+            }
+            _steppedCondition.notify_all();
+
+            if (_stop) {
+                break;
+            }
+        }
+        expired.clear();
+    }
+}
+
+PacingEngine::PacingEngine() {
+}
+
+PacingEngine::~PacingEngine() {
+    // the SendQueues are gone by now, their Connections remove them from their threads
+    for (auto& thread : _threads) {
+        thread->stop();
+    }
+    _threads.clear();
+}
+
+PacingThread* PacingEngine::add(SendQueue* queue) {
+    PacingThread* thread { nullptr };
+    {
+        std::lock_guard<std::mutex> lock(_threadsMutex);
+
+        // start threads as they are needed, up to the maximum, then spread the queues over them
+        int maxThreads = std::max(1, std::min(QThread::idealThreadCount(), MAX_PACING_THREADS));
+        auto leastLoaded = std::min_element(_threads.begin(), _threads.end(), [](const auto& a, const auto& b) {
+            return a->getNumQueues() < b->getNumQueues();
+        });
+        if (leastLoaded != _threads.end() && ((*leastLoaded)->getNumQueues() == 0 || (int)_threads.size() >= maxThreads)) {
+            thread = leastLoaded->get();
+        } else {
+            _threads.emplace_back(new PacingThread((int)_threads.size()));
+            thread = _threads.back().get();
+            thread->start();
+        }
+    }
+
+    queue->moveToThread(thread);
+    thread->add(queue);
+    return thread;
+}
@@ -0,0 +1,98 @@
+//
+//  PacingEngine.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-22.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacingEngine_h
+#define hifi_PacingEngine_h
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QThread>
+
+#include "TimerWheel.h"
+
+namespace udt {
+
+class SendQueue;
+
+// One of the threads of a PacingEngine. The SendQueues it runs live on it, and are stepped as their timers expire.
+class PacingThread : public QThread {
+    Q_OBJECT
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+public:
+    PacingThread(int index);
+    ~PacingThread();
+
+    void run() override;
+    void stop();
+
+    int getNumQueues() const;
+
+    void add(SendQueue* queue);
+    // blocks until the queue isn't being stepped, it is never stepped again after this returns
+    void remove(SendQueue* queue);
+    // steps the queue as soon as possible
+    void wake(SendQueue* queue);
+
+private:
+    struct Timer {
+        SendQueue* queue;
+        uint64_t generation;
+    };
+
+    struct QueueState {
+        uint64_t generation { 0 }; // of the last timer scheduled, the others are stale
+        bool wakeRequested { false }; // while being stepped
+    };
+
+    void scheduleLocked(SendQueue* queue, QueueState& state, p_high_resolution_clock::time_point when);
+
+    mutable Mutex _mutex;
+    std::condition_variable _condition;
+    std::condition_variable _steppedCondition;
+    bool _stop { false };
+
+    TimerWheel<Timer> _wheel;
+    std::vector<Timer> _expired;
+    std::unordered_map<SendQueue*, QueueState> _queues;
+    SendQueue* _stepping { nullptr };
+    uint64_t _nextGeneration { 0 };
+};
+
+// Runs the SendQueues of a Socket on a small fixed pool of threads, instead of a thread each.
+//
+// A SendQueue is stepped each time it has something to do: its next packet is due according to its packet send period,
+// it has been notified of new packets, ACKs or losses, or one of its timeouts has expired. Each step returns when the
+// queue needs to be stepped again, which is kept in the timer wheel of the queue's thread.
+class PacingEngine {
+public:
+    PacingEngine();
+    ~PacingEngine();
+
+    // moves the queue to one of the pacing threads and starts stepping it, must be called on the queue's thread
+    PacingThread* add(SendQueue* queue);
+
+private:
+    std::mutex _threadsMutex;
+    std::vector<std::unique_ptr<PacingThread>> _threads;
+};
+
+}
+
+#endif // hifi_PacingEngine_h
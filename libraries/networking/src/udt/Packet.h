@@ -69,7 +69,7 @@ public:
     };
 
     static std::unique_ptr<Packet> create(qint64 size = -1, bool isReliable = false, bool isPartOfMessage = false);
-    static std::unique_ptr<Packet> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr);
+    static std::unique_ptr<Packet> fromReceivedPacket(PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr);
     
     // Provided for convenience, try to limit use
     static std::unique_ptr<Packet> createCopy(const Packet& other);
@@ -97,7 +97,7 @@ public:
 
 protected:
     Packet(qint64 size, bool isReliable = false, bool isPartOfMessage = false);
-    Packet(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr);
+    Packet(PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr);
     
     Packet(const Packet& other);
     Packet(Packet&& other);
@@ -106,6 +106,8 @@ protected:
     Packet& operator=(Packet&& other);
 
 private:
+    friend class PacketQueue;
+
     void copyMembers(const Packet& other);
 
     // Header readers - these read data to member variables after pulling packet off wire
@@ -120,6 +122,8 @@ private:
     mutable MessageNumber _messageNumber { 0 };
     mutable PacketPosition _packetPosition { PacketPosition::ONLY };
     mutable MessagePartNumber _messagePartNumber { 0 };
+
+    Packet* _nextInQueue { nullptr }; // the next one in the PacketQueue that owns it
 };
 
 } // namespace udt
@@ -0,0 +1,220 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-02.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <MemoryAccounting.h>
+
+using namespace udt;
+
+static const size_t MAX_THREAD_CACHE_BUFFERS = 256;
+static const size_t DEPOT_TRANSFER_BUFFERS = 64;
+static const size_t MAX_DEPOT_BUFFERS = 8192; // roughly 12MB of idle buffers
+
+namespace {
+
+MemoryTag& packetBuffersTag() {
+    static MemoryTag tag("network.packetBuffers");
+    return tag;
+}
+
+char* newBuffer(qint64 size) {
+    packetBuffersTag().allocated(size);
+    return new char[size];
+}
+
+void deleteBuffer(char* buffer, qint64 size) {
+    packetBuffersTag().freed(size);
+    delete[] buffer;
+}
+
+// set once the depot is destroyed with the statics, the buffers released after that go straight to the heap
+std::atomic<bool> isDepotDestroyed { false };
+
+struct Depot {
+    std::mutex mutex;
+    std::vector<char*> buffers;
+
+    ~Depot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        isDepotDestroyed = true;
+        for (auto buffer : buffers) {
+            deleteBuffer(buffer, PacketBufferPool::BUFFER_SIZE);
+        }
+        buffers.clear();
+    }
+};
+
+Depot& depot() {
+    static Depot depot;
+    return depot;
+}
+
+std::atomic<bool> isPoolEnabled { true };
+
+std::atomic<uint64_t> hits { 0 };
+std::atomic<uint64_t> misses { 0 };
+std::atomic<uint64_t> oversized { 0 };
+std::atomic<uint64_t> freed { 0 };
+
+// moves up to count buffers from the back of source to destination, freeing whatever destination can't hold
+void transferBuffers(std::vector<char*>& source, std::vector<char*>& destination, size_t count, size_t maxDestination) {
+    count = std::min(count, source.size());
+    for (size_t i = 0; i < count; ++i) {
+        auto buffer = source.back();
+        source.pop_back();
+
+        if (destination.size() < maxDestination) {
+            destination.push_back(buffer);
+        } else {
+            deleteBuffer(buffer, PacketBufferPool::BUFFER_SIZE);
+            freed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Releases a buffer without the cache of the thread, to the depot while it is alive.
+void releaseToDepot(char* buffer) {
+    if (!isDepotDestroyed) {
+        auto& sharedDepot = depot();
+        std::lock_guard<std::mutex> lock(sharedDepot.mutex);
+        if (!isDepotDestroyed && sharedDepot.buffers.size() < MAX_DEPOT_BUFFERS) {
+            sharedDepot.buffers.push_back(buffer);
+            return;
+        }
+    }
+    deleteBuffer(buffer, PacketBufferPool::BUFFER_SIZE);
+    freed.fetch_add(1, std::memory_order_relaxed);
+}
+
+enum class ThreadCacheState : uint8_t {
+    NotConstructed,
+    Alive,
+    Destroyed
+};
+
+// Plain data, so it is still readable while the thread locals of an exiting thread are destroyed: a buffer released
+// from the destructor of another thread local, after the cache of the thread is gone, must not touch the cache.
+thread_local ThreadCacheState threadCacheState { ThreadCacheState::NotConstructed };
+
+struct ThreadCache {
+    std::vector<char*> buffers;
+
+    ThreadCache() {
+        buffers.reserve(MAX_THREAD_CACHE_BUFFERS);
+        threadCacheState = ThreadCacheState::Alive;
+    }
+
+    ~ThreadCache() {
+        threadCacheState = ThreadCacheState::Destroyed;
+
+        // the thread is going away, hand everything we hold back to the depot
+        for (auto buffer : buffers) {
+            releaseToDepot(buffer);
+        }
+        buffers.clear();
+    }
+};
+
+thread_local ThreadCache threadCache;
+
+bool isThreadCacheDestroyed() {
+    return threadCacheState == ThreadCacheState::Destroyed;
+}
+
+}
+
+void PacketBufferDeleter::operator()(char* buffer) const {
+    if (isPooled) {
+        PacketBufferPool::recycle(buffer);
+    } else {
+        deleteBuffer(buffer, size);
+    }
+}
+
+PacketBuffer PacketBufferPool::allocate(qint64 size) {
+    if (size > BUFFER_SIZE) {
+        oversized.fetch_add(1, std::memory_order_relaxed);
+        return PacketBuffer(newBuffer(size), PacketBufferDeleter(false, size));
+    }
+
+    if (!isPoolEnabled.load(std::memory_order_relaxed) || isThreadCacheDestroyed()) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return PacketBuffer(newBuffer(BUFFER_SIZE), PacketBufferDeleter(false, BUFFER_SIZE));
+    }
+
+    auto& cache = threadCache.buffers;
+    if (cache.empty() && !isDepotDestroyed) {
+        auto& sharedDepot = depot();
+        std::lock_guard<std::mutex> lock(sharedDepot.mutex);
+        transferBuffers(sharedDepot.buffers, cache, DEPOT_TRANSFER_BUFFERS, MAX_THREAD_CACHE_BUFFERS);
+    }
+
+    if (!cache.empty()) {
+        auto buffer = cache.back();
+        cache.pop_back();
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return PacketBuffer(buffer, PacketBufferDeleter(true, BUFFER_SIZE));
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return PacketBuffer(newBuffer(BUFFER_SIZE), PacketBufferDeleter(true, BUFFER_SIZE));
+}
+
+void PacketBufferPool::recycle(char* buffer) {
+    if (isThreadCacheDestroyed()) {
+        releaseToDepot(buffer);
+        return;
+    }
+
+    auto& cache = threadCache.buffers;
+    if (cache.size() >= MAX_THREAD_CACHE_BUFFERS) {
+        if (isDepotDestroyed) {
+            deleteBuffer(buffer, BUFFER_SIZE);
+            freed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // this thread frees more than it allocates, push a block back to the depot for the allocating threads
+        auto& sharedDepot = depot();
+        std::lock_guard<std::mutex> lock(sharedDepot.mutex);
+        transferBuffers(cache, sharedDepot.buffers, DEPOT_TRANSFER_BUFFERS, MAX_DEPOT_BUFFERS);
+    }
+
+    cache.push_back(buffer);
+}
+
+void PacketBufferPool::setEnabled(bool isEnabled) {
+    isPoolEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+bool PacketBufferPool::isEnabled() {
+    return isPoolEnabled.load(std::memory_order_relaxed);
+}
+
+PacketBufferPool::Stats PacketBufferPool::getStats() {
+    Stats stats;
+    stats.hits = hits.load(std::memory_order_relaxed);
+    stats.misses = misses.load(std::memory_order_relaxed);
+    stats.oversized = oversized.load(std::memory_order_relaxed);
+    stats.freed = freed.load(std::memory_order_relaxed);
+
+    auto& sharedDepot = depot();
+    std::lock_guard<std::mutex> lock(sharedDepot.mutex);
+    stats.depotSize = (int)sharedDepot.buffers.size();
+
+    return stats;
+}
@@ -0,0 +1,76 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-02.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <memory>
+#include <stdint.h>
+
+#include <QtCore/QtGlobal>
+
+#include "Constants.h"
+
+namespace udt {
+
+// returns pooled buffers to the PacketBufferPool, frees everything else
+struct PacketBufferDeleter {
+    PacketBufferDeleter() {}
+    PacketBufferDeleter(bool isPooled, qint64 size) : isPooled(isPooled), size(size) {}
+
+    void operator()(char* buffer) const;
+
+    bool isPooled { false };
+    qint64 size { 0 }; // for the memory accounting of the buffers that are freed
+};
+
+using PacketBuffer = std::unique_ptr<char[], PacketBufferDeleter>;
+
+// Recycles MTU-sized packet buffers so that creating and destroying packets stays off the malloc path.
+//
+// Every thread keeps a small cache of free buffers. Packets are usually allocated on one thread (the NodeList thread
+// for received packets, a mixer thread for sent ones) and destroyed on another, so a thread whose cache fills up hands
+// a block of buffers back to a shared depot, which a thread with an empty cache refills from.
+//
+// The buffers taken from the heap, in use or free in the pool, are accounted for as "network.packetBuffers", which also
+// covers every packet waiting in the send and receive queues.
+class PacketBufferPool {
+public:
+    // large enough for anything we can receive in one datagram
+    static const int BUFFER_SIZE = MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+    struct Stats {
+        uint64_t hits { 0 };        // served from a free buffer
+        uint64_t misses { 0 };      // pool was empty, buffer was allocated
+        uint64_t oversized { 0 };   // request was larger than BUFFER_SIZE, bypassed the pool
+        uint64_t freed { 0 };       // depot was full, buffer was released to the heap
+        int depotSize { 0 };        // free buffers currently sitting in the shared depot
+    };
+
+    // returns a buffer of at least size bytes, pooled when size <= BUFFER_SIZE
+    static PacketBuffer allocate(qint64 size);
+
+    static Stats getStats();
+
+    // with the pool disabled every buffer comes from and goes back to the heap, so that what it saves can be measured
+    static void setEnabled(bool isEnabled);
+    static bool isEnabled();
+
+private:
+    friend struct PacketBufferDeleter;
+    static void recycle(char* buffer);
+};
+
+}
+
+#endif // hifi_PacketBufferPool_h
@@ -137,6 +137,16 @@ public:
         BulkAvatarTraitsAck,
         StopInjector,
         AvatarZonePresence,
+        AudioParity,
+        HostedAvatarData,
+        NodeMetrics,
+        AudioEmitter,
+        MixedAudioWithAmbisonicBed,
+        DownstreamAmbisonicBed,
+        EntityCompressionDictionary,
+        BulkAvatarTraitsMiss,
+        BulkEntityPhysics,
+        DownstreamBandwidth,
         NUM_PACKET_TYPE
     };
 
@@ -156,6 +166,7 @@ public:
     const static QSet<PacketTypeEnum::Value> getNonVerifiedPackets() {
         const static QSet<PacketTypeEnum::Value> NON_VERIFIED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::NodeJsonStats
+            << PacketTypeEnum::Value::NodeMetrics
             << PacketTypeEnum::Value::EntityQuery
             << PacketTypeEnum::Value::OctreeDataNack
             << PacketTypeEnum::Value::EntityEditNack
@@ -188,10 +199,17 @@ public:
             << PacketTypeEnum::Value::ReplicatedMicrophoneAudioWithEcho << PacketTypeEnum::Value::ReplicatedInjectAudio
             << PacketTypeEnum::Value::ReplicatedSilentAudioFrame << PacketTypeEnum::Value::ReplicatedAvatarIdentity
             << PacketTypeEnum::Value::ReplicatedKillAvatar << PacketTypeEnum::Value::ReplicatedBulkAvatarData
-            << PacketTypeEnum::Value::AvatarZonePresence;
+            << PacketTypeEnum::Value::AvatarZonePresence << PacketTypeEnum::Value::DownstreamAmbisonicBed;
         return NON_SOURCED_PACKETS;
     }
 
+    // the packets that carry a trace ID at the end of their header, see NLPacket
+    const static QSet<PacketTypeEnum::Value> getTracedPackets() {
+        const static QSet<PacketTypeEnum::Value> TRACED_PACKETS = QSet<PacketTypeEnum::Value>()
+            << PacketTypeEnum::Value::AvatarData << PacketTypeEnum::Value::BulkAvatarData;
+        return TRACED_PACKETS;
+    }
+
     const static QSet<PacketTypeEnum::Value> getDomainSourcedPackets() {
         const static QSet<PacketTypeEnum::Value> DOMAIN_SOURCED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperation
@@ -211,7 +229,8 @@ public:
 
 using PacketType = PacketTypeEnum::Value;
 
-const int NUM_BYTES_MD5_HASH = 16;
+// the SipHash-2-4-128 of the sourced packets, see PacketAuth
+const int NUM_BYTES_VERIFICATION_HASH = 16;
 
 // NOTE: There is a max limit of 255, hopefully we have a better way to manage this by then.
 typedef uint8_t PacketVersion;
@@ -287,6 +306,8 @@ enum class EntityVersion : PacketVersion {
     UserAgent,
     AllBillboardMode,
     TextAlignment,
+    ChunkedVoxelData,
+    BulkEntityPhysics,
 
     // Add new versions above here
     NUM_PACKET_TYPE,
@@ -304,7 +325,8 @@ enum class EntityQueryPacketVersion: PacketVersion {
     ConnectionIdentifier = 20,
     RemovedJurisdictions = 21,
     MultiFrustumQuery = 22,
-    ConicalFrustums = 23
+    ConicalFrustums = 23,
+    CompressionDictionary = 24
 };
 
 enum class AssetServerPacketVersion: PacketVersion {
@@ -352,7 +374,10 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     FBXJointOrderChange,
     HandControllerSection,
     SendVerificationFailed,
-    ARKitBlendshapes
+    ARKitBlendshapes,
+    CompactJointData,
+    TraceID,
+    HashedAvatarTraits
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -386,7 +411,14 @@ enum class DomainListVersion : PacketVersion {
     GetMachineFingerprintFromUUIDSupport,
     AuthenticationOptional,
     HasTimestamp,
-    HasConnectReason
+    HasConnectReason,
+    HasListDeltas,
+    SipHashVerification
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreListVersion = 22,
+    HasListVersion
 };
 
 enum class AudioVersion : PacketVersion {
@@ -412,6 +444,10 @@ enum class PingVersion : PacketVersion {
     IncludeConnectionID = 18
 };
 
+enum class OctreeStatsVersion : PacketVersion {
+    CompressionBytes = 23
+};
+
 enum class AvatarQueryVersion : PacketVersion {
     SendMultipleFrustums = 21,
     ConicalFrustums = 22
@@ -102,6 +102,8 @@ private:
     int _segmentStartIndex = -1;
     
     QByteArray _extendedHeader;
+
+    PacketList* _nextInQueue { nullptr }; // the next one in the PacketQueue that owns it
 };
 
 template<typename T> std::unique_ptr<T> PacketList::takeFront() {
@@ -11,57 +11,134 @@
 
 #include "PacketQueue.h"
 
+#include <limits>
+
 #include "PacketList.h"
 
 using namespace udt;
 
+static const MessageNumber MAX_MESSAGE_NUMBER = MessageNumber(1) << MESSAGE_NUMBER_SIZE;
+
+// the count of the message numbers wraps around at a multiple of MAX_MESSAGE_NUMBER
+static_assert(((uint64_t)std::numeric_limits<MessageNumber>::max() + 1) % MAX_MESSAGE_NUMBER == 0,
+              "Message number wraps around unevenly");
+
+template <typename T>
+void PacketQueue::push(std::atomic<T*>& stack, T* item) {
+    item->_nextInQueue = stack.load(std::memory_order_relaxed);
+    while (!stack.compare_exchange_weak(item->_nextInQueue, item, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+// the whole stack, reversed to the order it was pushed in
+template <typename T>
+T* PacketQueue::takeAll(std::atomic<T*>& stack) {
+    T* item = stack.exchange(nullptr, std::memory_order_acquire);
+    T* reversed = nullptr;
+    while (item) {
+        T* next = item->_nextInQueue;
+        item->_nextInQueue = reversed;
+        reversed = item;
+        item = next;
+    }
+    return reversed;
+}
+
 PacketQueue::PacketQueue(MessageNumber messageNumber) : _currentMessageNumber(messageNumber) {
-    _channels.emplace_front(new std::list<PacketPointer>());
-    _currentChannel = _channels.begin();
+}
+
+PacketQueue::~PacketQueue() {
+    takeQueued();
+    while (_mainChannelFront) {
+        Packet* packet = _mainChannelFront;
+        _mainChannelFront = packet->_nextInQueue;
+        delete packet;
+    }
 }
 
 MessageNumber PacketQueue::getNextMessageNumber() {
-    static const MessageNumber MAX_MESSAGE_NUMBER = MessageNumber(1) << MESSAGE_NUMBER_SIZE;
-    _currentMessageNumber = (_currentMessageNumber + 1) % MAX_MESSAGE_NUMBER;
-    return _currentMessageNumber;
+    return (_currentMessageNumber.fetch_add(1, std::memory_order_relaxed) + 1) % MAX_MESSAGE_NUMBER;
 }
 
-bool PacketQueue::isEmpty() const {
-    LockGuard locker(_packetsLock);
+MessageNumber PacketQueue::getCurrentMessageNumber() const {
+    return _currentMessageNumber.load(std::memory_order_relaxed) % MAX_MESSAGE_NUMBER;
+}
+
+void PacketQueue::takeQueued() {
+    if (_queuedPackets.load(std::memory_order_relaxed)) {
+        Packet* packets = takeAll(_queuedPackets);
+        if (_mainChannelBack) {
+            _mainChannelBack->_nextInQueue = packets;
+        } else {
+            _mainChannelFront = packets;
+        }
+        _mainChannelBack = packets;
+        while (_mainChannelBack->_nextInQueue) {
+            _mainChannelBack = _mainChannelBack->_nextInQueue;
+        }
+    }
+
+    if (_queuedPacketLists.load(std::memory_order_relaxed)) {
+        PacketList* packetList = takeAll(_queuedPacketLists);
+        while (packetList) {
+            PacketList* next = packetList->_nextInQueue;
+            packetList->_nextInQueue = nullptr;
+            if (packetList->_packets.empty()) {
+                delete packetList;
+            } else {
+                _channels.emplace_back(packetList);
+            }
+            packetList = next;
+        }
+    }
+}
 
+bool PacketQueue::isEmpty() const {
     // Only the main channel and it is empty
-    return _channels.size() == 1 && _channels.front()->empty();
+    return !_mainChannelFront && _channels.empty() &&
+        !_queuedPackets.load(std::memory_order_relaxed) && !_queuedPacketLists.load(std::memory_order_relaxed);
 }
 
 PacketQueue::PacketPointer PacketQueue::takePacket() {
-    LockGuard locker(_packetsLock);
+    takeQueued();
 
-    if (isEmpty()) {
+    if (!_mainChannelFront && _channels.empty()) {
         return PacketPointer();
     }
 
     // handle the case where we are looking at the first channel and it is empty
-    if (_currentChannel == _channels.begin() && (*_currentChannel)->empty()) {
+    if (_currentChannel == 0 && !_mainChannelFront) {
         ++_currentChannel;
     }
 
     // at this point the current channel should always not be at the end and should also not be empty
-    Q_ASSERT(_currentChannel != _channels.end());
-
-    auto& channel = *_currentChannel;
+    Q_ASSERT(_currentChannel <= _channels.size());
+
+    PacketPointer packet;
+    if (_currentChannel == 0) {
+        // Take front packet of the main channel
+        packet.reset(_mainChannelFront);
+        _mainChannelFront = packet->_nextInQueue;
+        packet->_nextInQueue = nullptr;
+        if (!_mainChannelFront) {
+            _mainChannelBack = nullptr;
+        }
+        ++_currentChannel;
+    } else {
+        auto& channel = _channels[_currentChannel - 1]->_packets;
 
-    Q_ASSERT(!channel->empty());
+        Q_ASSERT(!channel.empty());
 
-    // Take front packet
-    auto packet = std::move(channel->front());
-    channel->pop_front();
+        // Take front packet
+        packet = std::move(channel.front());
+        channel.pop_front();
 
-    // Remove now empty channel (Don't remove the main channel)
-    if (channel->empty() && _currentChannel != _channels.begin()) {
-        // erase the current channel and slide the iterator to the next channel
-        _currentChannel = _channels.erase(_currentChannel);
-    } else {
-        ++_currentChannel;
+        // Remove now empty channel, the next one slides into its place
+        if (channel.empty()) {
+            _channels.erase(_channels.begin() + (_currentChannel - 1));
+        } else {
+            ++_currentChannel;
+        }
     }
 
     // push forward our number of channels taken from
@@ -69,19 +146,18 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
 
     // check if we need to restart back at the front channel (main)
     // to respect our capped number of channels considered concurrently
-    static const int MAX_CHANNELS_SENT_CONCURRENTLY = 16;
+    static const unsigned int MAX_CHANNELS_SENT_CONCURRENTLY = 16;
 
-    if (_currentChannel == _channels.end() || _channelsVisitedCount >= MAX_CHANNELS_SENT_CONCURRENTLY) {
+    if (_currentChannel > _channels.size() || _channelsVisitedCount >= MAX_CHANNELS_SENT_CONCURRENTLY) {
         _channelsVisitedCount = 0;
-        _currentChannel = _channels.begin();
+        _currentChannel = 0;
     }
 
     return packet;
 }
 
 void PacketQueue::queuePacket(PacketPointer packet) {
-    LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    push(_queuedPackets, packet.release());
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
@@ -89,7 +165,5 @@ void PacketQueue::queuePacketList(PacketListPointer packetList) {
         packetList->preparePackets(getNextMessageNumber());
     }
 
-    LockGuard locker(_packetsLock);
-    _channels.emplace_back(new std::list<PacketPointer>());
-    _channels.back()->swap(packetList->_packets);
+    push(_queuedPacketLists, packetList.release());
 }
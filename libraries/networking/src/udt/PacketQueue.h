@@ -12,10 +12,9 @@
 #ifndef hifi_PacketQueue_h
 #define hifi_PacketQueue_h
 
-#include <list>
+#include <atomic>
 #include <vector>
 #include <memory>
-#include <mutex>
 
 #include "Packet.h"
 
@@ -25,36 +24,52 @@ class PacketList;
     
 using MessageNumber = uint32_t;
     
+// The packets waiting for the SendQueue: a main channel for the single packets and one channel per packet list, which
+// are sent from in turn.
+//
+// Any thread queues without a lock: the packets and the packet lists are pushed on a lock-free stack through a link they
+// carry, so that queuing doesn't allocate. Only the thread of the SendQueue takes them, and moves the stacks into its
+// channels in the order they were queued in.
 class PacketQueue {
-    using Mutex = std::recursive_mutex;
-    using LockGuard = std::lock_guard<Mutex>;
     using PacketPointer = std::unique_ptr<Packet>;
     using PacketListPointer = std::unique_ptr<PacketList>;
-    using RawChannel = std::list<PacketPointer>;
-    using Channel = std::unique_ptr<RawChannel>;
-    using Channels = std::list<Channel>;
+    using Channels = std::vector<PacketListPointer>;
     
 public:
     PacketQueue(MessageNumber messageNumber = 0);
+    ~PacketQueue();
+
+    PacketQueue(const PacketQueue&) = delete;
+    PacketQueue& operator=(const PacketQueue&) = delete;
+
     void queuePacket(PacketPointer packet);
     void queuePacketList(PacketListPointer packetList);
     
+    // only from the thread that takes the packets
     bool isEmpty() const;
     PacketPointer takePacket();
     
-    Mutex& getLock() { return _packetsLock; }
-
-    MessageNumber getCurrentMessageNumber() const { return _currentMessageNumber; }
+    MessageNumber getCurrentMessageNumber() const;
     
 private:
+    template <typename T> static void push(std::atomic<T*>& stack, T* item);
+    template <typename T> static T* takeAll(std::atomic<T*>& stack);
+
     MessageNumber getNextMessageNumber();
+    void takeQueued();
 
-    MessageNumber _currentMessageNumber { 0 };
+    std::atomic<MessageNumber> _currentMessageNumber { 0 };
     
-    mutable Mutex _packetsLock; // Protects the packets to be sent.
-    Channels _channels; // One channel per packet list + Main channel
+    // pushed by any thread, the last one queued first
+    std::atomic<Packet*> _queuedPackets { nullptr };
+    std::atomic<PacketList*> _queuedPacketLists { nullptr };
+
+    // the main channel, from the oldest to the newest through Packet::_nextInQueue
+    Packet* _mainChannelFront { nullptr };
+    Packet* _mainChannelBack { nullptr };
+    Channels _channels; // One channel per packet list
 
-    Channels::iterator _currentChannel;
+    size_t _currentChannel { 0 }; // 0 is the main channel, then the packet lists
     unsigned int _channelsVisitedCount { 0 };
 };
 
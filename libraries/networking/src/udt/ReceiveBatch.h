@@ -0,0 +1,85 @@
+//
+//  ReceiveBatch.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-04.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ReceiveBatch_h
+#define hifi_ReceiveBatch_h
+
+#include <QtCore/QtGlobal>
+
+#include "PacketBufferPool.h"
+
+#if defined(Q_OS_LINUX)
+#include <cstring>
+#include <sys/socket.h>
+#endif
+
+namespace udt {
+
+#if defined(Q_OS_LINUX)
+
+// Slot storage for draining many datagrams from a socket with one recvmmsg call
+struct ReceiveBatch {
+    static const int MAX_DATAGRAMS = 64;
+
+    // datagrams larger than this are truncated by the kernel and dropped - nothing we send comes close
+    static const int MAX_DATAGRAM_SIZE = PacketBufferPool::BUFFER_SIZE;
+
+    mmsghdr headers[MAX_DATAGRAMS];
+    iovec iovecs[MAX_DATAGRAMS];
+    sockaddr_storage addresses[MAX_DATAGRAMS];
+
+    // buffers are handed off to the packets we create, the empty slots are re-allocated before the next read
+    PacketBuffer buffers[MAX_DATAGRAMS];
+
+    void prepare() {
+        memset(headers, 0, sizeof(headers));
+        for (int i = 0; i < MAX_DATAGRAMS; ++i) {
+            if (!buffers[i]) {
+                buffers[i] = PacketBufferPool::allocate(MAX_DATAGRAM_SIZE);
+            }
+            iovecs[i].iov_base = buffers[i].get();
+            iovecs[i].iov_len = MAX_DATAGRAM_SIZE;
+
+            headers[i].msg_hdr.msg_name = &addresses[i];
+            headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+
+    // non-blocking, returns the number of datagrams read or -1 with errno set
+    int receive(int socketDescriptor) {
+        prepare();
+        return ::recvmmsg(socketDescriptor, headers, MAX_DATAGRAMS, MSG_DONTWAIT, nullptr);
+    }
+
+    // size of the datagram in slot i, or -1 if it should be skipped
+    int sizeAt(int i) const {
+        if (headers[i].msg_len == 0 || (headers[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+            return -1;
+        }
+        return (int)headers[i].msg_len;
+    }
+
+    const sockaddr* addressAt(int i) const { return reinterpret_cast<const sockaddr*>(&addresses[i]); }
+};
+
+#else
+
+struct ReceiveBatch {};
+
+#endif
+
+}
+
+#endif // hifi_ReceiveBatch_h
@@ -0,0 +1,140 @@
+//
+//  ReceiveShard.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-04.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceiveShard.h"
+
+#if defined(Q_OS_LINUX)
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+#include <LogHandler.h>
+
+#include "../NetworkLogging.h"
+#include "Packet.h"
+#include "Socket.h"
+
+using namespace udt;
+
+// how long a shard blocks in poll before re-checking whether it has been asked to stop
+static const int SHARD_POLL_TIMEOUT_MSECS = 100;
+
+ReceiveShard::ReceiveShard(Socket& socket, int socketDescriptor, int index) :
+    _socket(socket),
+    _socketDescriptor(socketDescriptor)
+{
+    setObjectName(QString("ReceiveShard %1").arg(index));
+}
+
+ReceiveShard::~ReceiveShard() {
+    stop();
+    wait();
+
+#if defined(Q_OS_LINUX)
+    if (_socketDescriptor != -1) {
+        ::close(_socketDescriptor);
+    }
+#endif
+}
+
+void ReceiveShard::stop() {
+    _stop = true;
+}
+
+void ReceiveShard::run() {
+#if defined(Q_OS_LINUX)
+    pollfd pollDescriptor;
+    pollDescriptor.fd = _socketDescriptor;
+    pollDescriptor.events = POLLIN;
+
+    while (!_stop) {
+        pollDescriptor.revents = 0;
+        if (::poll(&pollDescriptor, 1, SHARD_POLL_TIMEOUT_MSECS) <= 0) {
+            continue;
+        }
+
+        bool didReceive = false;
+        int numReceived = 0;
+        do {
+            numReceived = _batch.receive(_socketDescriptor);
+            if (numReceived <= 0) {
+                if (numReceived < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    HIFI_FCDEBUG(networking(), "ReceiveShard recvmmsg error -" << errno);
+                }
+                break;
+            }
+
+            auto receiveTime = p_high_resolution_clock::now();
+            _socket.recordReceiveBatch(numReceived);
+
+            for (int i = 0; i < numReceived; ++i) {
+                int size = _batch.sizeAt(i);
+                if (size <= 0) {
+                    continue;
+                }
+
+                processDatagram(std::move(_batch.buffers[i]), size, HifiSockAddr(_batch.addressAt(i)), receiveTime);
+            }
+
+            didReceive = true;
+        } while (numReceived == ReceiveBatch::MAX_DATAGRAMS && !_stop);
+
+        if (didReceive) {
+            _socket.notifyShardPending();
+        }
+    }
+#endif
+}
+
+void ReceiveShard::processDatagram(PacketBuffer buffer, int size, const HifiSockAddr& senderSockAddr,
+                                   p_high_resolution_clock::time_point receiveTime) {
+    bool mustForward = _socket.isUnfilteredSender(senderSockAddr);
+
+    if (!mustForward) {
+        // peek at the UDT header bits, anything that carries Connection state is processed on the Socket thread
+        uint32_t bitField = *reinterpret_cast<uint32_t*>(buffer.get());
+        mustForward = bitField & (CONTROL_BIT_MASK | RELIABILITY_BIT_MASK | MESSAGE_BIT_MASK);
+    }
+
+    if (mustForward) {
+        Lock lock(_pendingMutex);
+        _pendingDatagrams.push_back({ std::move(buffer), size, senderSockAddr, receiveTime });
+        return;
+    }
+
+    auto packet = Packet::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+    packet->setReceiveTime(receiveTime);
+
+    if (!_socket._packetFilterOperator || _socket._packetFilterOperator(*packet)) {
+        {
+            // the Connection stats for this sender are updated by the Socket thread when it picks these up
+            Lock lock(_pendingMutex);
+            auto& stats = _pendingStats[senderSockAddr];
+            if (stats.numPackets == 0 || packet->getSequenceNumber() > stats.lastSequenceNumber) {
+                stats.lastSequenceNumber = packet->getSequenceNumber();
+            }
+            ++stats.numPackets;
+            stats.wireSize += packet->getWireSize();
+            stats.payloadSize += packet->getPayloadSize();
+        }
+
+        if (_socket._packetHandler) {
+            _socket._packetHandler(std::move(packet));
+        }
+    }
+}
+
+void ReceiveShard::takePending(std::vector<ForwardedDatagram>& datagrams, UnreliableReceiveStatsMap& stats) {
+    Lock lock(_pendingMutex);
+    datagrams.swap(_pendingDatagrams);
+    stats.swap(_pendingStats);
+}
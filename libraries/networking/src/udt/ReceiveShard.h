@@ -0,0 +1,89 @@
+//
+//  ReceiveShard.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-04.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ReceiveShard_h
+#define hifi_ReceiveShard_h
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QThread>
+
+#include <PortableHighResolutionClock.h>
+
+#include "../HifiSockAddr.h"
+#include "PacketBufferPool.h"
+#include "ReceiveBatch.h"
+#include "SequenceNumber.h"
+
+namespace udt {
+
+class Socket;
+
+// Reads one of the SO_REUSEPORT sockets bound to the Socket's port on its own thread.
+//
+// The kernel picks the socket for each datagram by hashing the sender address, so every datagram from a given sender
+// arrives on the same shard. Unreliable, single-packet data is verified and handed to the packet handler right here.
+// Anything that touches Connection state (control, reliable and message packets) and anything for an unfiltered
+// handler is forwarded in arrival order to the Socket thread, which keeps per-sender ordering intact.
+class ReceiveShard : public QThread {
+    Q_OBJECT
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+public:
+    struct ForwardedDatagram {
+        PacketBuffer buffer;
+        int size;
+        HifiSockAddr senderSockAddr;
+        p_high_resolution_clock::time_point receiveTime;
+    };
+
+    struct UnreliableReceiveStats {
+        int numPackets { 0 };
+        int wireSize { 0 };
+        int payloadSize { 0 };
+        SequenceNumber lastSequenceNumber; // the highest of the packets
+    };
+    using UnreliableReceiveStatsMap = std::unordered_map<HifiSockAddr, UnreliableReceiveStats>;
+
+    // takes ownership of the (already bound) socket descriptor
+    ReceiveShard(Socket& socket, int socketDescriptor, int index);
+    ~ReceiveShard();
+
+    void run() override;
+    void stop();
+
+    // called on the Socket thread to pick up what this shard could not process itself
+    void takePending(std::vector<ForwardedDatagram>& datagrams, UnreliableReceiveStatsMap& stats);
+
+private:
+    void processDatagram(PacketBuffer buffer, int size, const HifiSockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
+
+    Socket& _socket;
+    int _socketDescriptor { -1 };
+    std::atomic<bool> _stop { false };
+
+    ReceiveBatch _batch;
+
+    Mutex _pendingMutex;
+    std::vector<ForwardedDatagram> _pendingDatagrams;
+    UnreliableReceiveStatsMap _pendingStats;
+};
+
+}
+
+#endif // hifi_ReceiveShard_h
@@ -12,12 +12,10 @@
 #include "SendQueue.h"
 
 #include <algorithm>
-#include <thread>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -25,46 +23,25 @@
 
 #include "../NetworkLogging.h"
 #include "ControlPacket.h"
+#include "PacingEngine.h"
 #include "Packet.h"
 #include "PacketList.h"
 #include "../UserActivityLogger.h"
 #include "Socket.h"
 #include <Trace.h>
 #include <Profile.h>
-#include <ThreadHelpers.h>
 
 #include "../NetworkLogging.h"
 
 using namespace udt;
 using namespace std::chrono;
 
-template <typename Mutex1, typename Mutex2>
-class DoubleLock {
-public:
-    using Lock = std::unique_lock<DoubleLock<Mutex1, Mutex2>>;
-    
-    DoubleLock(Mutex1& mutex1, Mutex2& mutex2) : _mutex1(mutex1), _mutex2(mutex2) { }
-    
-    DoubleLock(const DoubleLock&) = delete;
-    DoubleLock& operator=(const DoubleLock&) = delete;
-    
-    // Either locks all the mutexes or none of them
-    bool try_lock() { return (std::try_lock(_mutex1, _mutex2) == -1); }
-    
-    // Locks all the mutexes
-    void lock() { std::lock(_mutex1, _mutex2); }
-    
-     // Undefined behavior if not locked
-    void unlock() { _mutex1.unlock(); _mutex2.unlock(); }
-    
-private:
-    Mutex1& _mutex1;
-    Mutex2& _mutex2;
-};
-
 const microseconds SendQueue::MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
 const microseconds SendQueue::MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
 
+static const auto HANDSHAKE_RESEND_INTERVAL = milliseconds(100);
+static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = seconds(5);
+
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination, SequenceNumber currentSequenceNumber,
                                              MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
@@ -72,21 +49,8 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
-    // Setup queue private thread
-    QThread* thread = new QThread();
-    QString name = "Networking: SendQueue " + destination.objectName();
-    thread->setObjectName(name); // Name thread for easier debug
-
-    connect(thread, &QThread::started, [name] { setThreadName(name.toStdString()); });
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-
-    thread->start();
+    // Move queue to one of the socket's pacing threads, which starts stepping it
+    queue->_pacingThread = socket->getPacingEngine().add(queue.get());
 
     return queue;
 }
@@ -106,37 +70,39 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSe
 }
 
 SendQueue::~SendQueue() {
+    // make sure our pacing thread is done with us
+    if (_pacingThread) {
+        _pacingThread->remove(this);
+    }
+}
+
+void SendQueue::wake() {
+    _notified = true;
+    if (_pacingThread) {
+        _pacingThread->wake(this);
+    }
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    // wake the queue in case it is waiting for packets
+    wake();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    // wake the queue in case it is waiting for packets
+    wake();
 }
 
 void SendQueue::stop() {
     
     _state = State::Stopped;
     
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting somewhere
+    wake();
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
@@ -152,9 +118,7 @@ void SendQueue::ack(SequenceNumber ack) {
     {
         // remove any ACKed packets from the map of sent packets
         QWriteLocker locker(&_sentLock);
-        for (auto seq = SequenceNumber { (uint32_t) _lastACKSequenceNumber }; seq <= ack; ++seq) {
-            _sentPackets.erase(seq);
-        }
+        _sentPackets.removeUpTo(ack);
     }
     
     {   // remove any sequence numbers equal to or lower than this ACK in the loss list
@@ -167,8 +131,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting with a full congestion window
+    wake();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -177,12 +141,11 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting for losses to re-send
+    wake();
 }
 
 void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
     if (!_hasReceivedHandshakeACK) {
         // we haven't received a handshake ACK from the client, send another now
         // if the handshake hasn't been completed, then the initial sequence number
@@ -191,21 +154,14 @@ void SendQueue::sendHandshake() {
         auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
         handshakePacket->writePrimitive(initialSequenceNumber);
         _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
     }
 }
 
 void SendQueue::handshakeACK() {
-    {
-        std::lock_guard<std::mutex> locker { _handshakeMutex };
-        _hasReceivedHandshakeACK = true;
-    }
+    _hasReceivedHandshakeACK = true;
 
-    // Notify on the handshake ACK condition
-    _handshakeACKCondition.notify_one();
+    // wake the queue in case it is waiting to re-send the handshake
+    wake();
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -228,11 +184,8 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     {
         // Insert the packet we have just sent in the sent list
         QWriteLocker locker(&_sentLock);
-        auto& entry = _sentPackets[newPacket->getSequenceNumber()];
-        entry.first = 0; // No resend
-        entry.second.swap(newPacket);
+        _sentPackets.insert(sequenceNumber, std::move(newPacket));
     }
-    Q_ASSERT_X(!newPacket, "SendQueue::sendNewPacketAndAddToSentList()", "Overriden packet in sent list");
 
     if (bytesWritten < 0) {
         // this is a short-circuit loss - we failed to put this packet on the wire
@@ -249,113 +202,124 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
+SendQueue::TimePoint SendQueue::step() {
+    static const TimePoint STOPPED = TimePoint::max();
+
+    auto now = p_high_resolution_clock::now();
+    bool notified = _notified.exchange(false);
+
     if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
+        // we've been asked to stop, possibly before we even got a chance to start
+        return STOPPED;
+    } else if (_state == State::NotStarted) {
+        _state = State::Running;
+        _nextHandshakeTimestamp = now;
+        _nextPacketTimestamp = now;
     }
-    
-    _state = State::Running;
-    
+
     // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
+    if (!_hasReceivedHandshakeACK) {
+        if (now >= _nextHandshakeTimestamp) {
+            sendHandshake();
+            _nextHandshakeTimestamp = now + HANDSHAKE_RESEND_INTERVAL;
+        }
 
         // Keep processing events
         QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
-    }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
-
-    while (_state == State::Running) {
-        bool attemptedToSendPacket = maybeResendPacket();
-        
-        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
-        // (this is according to the current flow window size) then we send out a new packet
-        auto newPacketCount = 0;
-        if (!attemptedToSendPacket) {
-            newPacketCount = maybeSendNewPacket();
-            attemptedToSendPacket = (newPacketCount > 0);
+        // Either we receive the handshake ACK and get woken, or it's going to be time to re-send a handshake.
+        // No packets will be sent until the handshake ACK has been received.
+        if (_state != State::Running) {
+            return STOPPED;
         }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
+        if (!_hasReceivedHandshakeACK) {
+            return _nextHandshakeTimestamp;
         }
 
-        if (_packetSendPeriod > 0) {
-            // push the next packet timestamp forwards by the current packet send period
-            auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
+        // Keep an HRC to know when the next packet should have been
+        _nextPacketTimestamp = now;
+    }
+
+    bool attemptedToSendPacket = maybeResendPacket();
+
+    // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+    // (this is according to the current flow window size) then we send out a new packet
+    auto newPacketCount = 0;
+    if (!attemptedToSendPacket) {
+        newPacketCount = maybeSendNewPacket();
+        attemptedToSendPacket = (newPacketCount > 0);
+    }
 
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
+    // give the queue a chance to process events
+    QCoreApplication::sendPostedEvents(this);
 
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
+    // we just processed events so check now if we were just told to stop
+    if (_state != State::Running) {
+        return STOPPED;
+    }
 
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
-            // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
-                // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+    if (!attemptedToSendPacket) {
+        auto nextStep = checkInactive(now, notified);
 
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
-            }
+        // don't try to catch up on the packets we could have sent while there was nothing to send
+        _nextPacketTimestamp = now;
+        return nextStep;
+    }
+    _isWaiting = false;
 
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
-
-            const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-                qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
-
-                // alright, we're in a weird state
-                // we want to know why this is happening so we can implement a better fix than this guard
-                // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
-                static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
-
-                // setup a json object with the details we want
-                QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-                longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-                longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-                // hopefully send this event using the user activity logger
-                UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
-            }
-            
-            std::this_thread::sleep_for(timeToSleep);
-        }
+    if (_packetSendPeriod <= 0) {
+        return now;
+    }
+
+    // push the next packet timestamp forwards by the current packet send period
+    auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
+    _nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
+
+    // wait as long as we need for next packet send, if we can
+    auto timeToSleep = duration_cast<microseconds>(_nextPacketTimestamp - now);
+
+    // we use _nextPacketTimestamp so that we don't fall behind, not to force long waits
+    // we'll never allow _nextPacketTimestamp to force us to wait for more than nextPacketDelta
+    // so cap it to that value
+    if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
+        // reset the _nextPacketTimestamp so that it is correct next time we come around
+        _nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+
+        timeToSleep = std::chrono::microseconds(nextPacketDelta);
     }
+
+    // we're seeing SendQueues wait for a long period of time here,
+    // which can lock the NodeList if it's attempting to clear connections
+    // for now we guard this by capping the time this queue can wait
+
+    const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
+    if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
+        qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
+        qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
+        qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
+        << "NPT:" << _nextPacketTimestamp.time_since_epoch().count()
+        << "NOW:" << now.time_since_epoch().count();
+
+        // alright, we're in a weird state
+        // we want to know why this is happening so we can implement a better fix than this guard
+        // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
+        static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
+
+        // setup a json object with the details we want
+        QJsonObject longSleepObject;
+        longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
+        longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
+        longSleepObject["nextPacketDelta"] = nextPacketDelta;
+        longSleepObject["nextPacketTimestamp"] = qint64(_nextPacketTimestamp.time_since_epoch().count());
+        longSleepObject["then"] = qint64(now.time_since_epoch().count());
+
+        // hopefully send this event using the user activity logger
+        UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
+
+        timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
+    }
+
+    return now + timeToSleep;
 }
 
 int SendQueue::maybeSendNewPacket() {
@@ -398,20 +362,19 @@ bool SendQueue::maybeResendPacket() {
             QReadLocker sentLocker(&_sentLock);
             
             // see if we can find the packet to re-send
-            auto it = _sentPackets.find(resendNumber);
+            auto entry = _sentPackets.find(resendNumber);
 
-            if (it != _sentPackets.end()) {
+            if (entry) {
 
-                auto& entry = it->second;
                 // we found the packet - grab it
-                auto& resendPacket = *(entry.second);
-                ++entry.first; // Add 1 resend
+                auto& resendPacket = *(entry->packet);
+                ++entry->resendCount; // Add 1 resend
 
-                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry.first < 2 ? 0 : (entry.first - 2) % 4);
+                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry->resendCount < 2 ? 0 : (entry->resendCount - 2) % 4);
 
                 auto wireSize = resendPacket.getWireSize();
                 auto payloadSize = resendPacket.getPayloadSize();
-                auto sequenceNumber = it->first;
+                auto sequenceNumber = resendNumber;
 
                 if (level != Packet::NoObfuscation) {
 #ifdef UDT_CONNECTION_DEBUG
@@ -466,88 +429,86 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
-    // check for connection timeout first
+SendQueue::TimePoint SendQueue::checkInactive(TimePoint now, bool notified) {
+    // During our processing we didn't send any packets
 
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+    // If we were already waiting and nothing woke us up early, keep waiting
+    if (_isWaiting && !notified && now < _waitTimeout) {
+        return _waitTimeout;
+    }
+    bool timedOut = _isWaiting && !notified;
+    _isWaiting = false;
+
+    // To confirm that the NAKs list is still empty we'll need its lock, the queue of packets is only taken from on
+    // this thread and any packet queued from now on notifies us
+    std::unique_lock<std::mutex> locker(_naksLock, std::try_to_lock);
+
+    if (!locker.owns_lock() || !(_packets.isEmpty() || isFlowWindowFull()) || !_naks.isEmpty()) {
+        // something changed meanwhile, go around again
+        return now;
+    }
+
+    // The loss list mutex is now locked and the packets queue and the loss list are both empty
+
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        if (timedOut) {
 
 #ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
+            qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+                << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
+                << "seconds and receiver has ACKed all packets."
+                << "The queue is now inactive and will be stopped.";
 #endif
 
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
+            // Make sure to unlock before deactivating
+            locker.unlock();
 
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-
-                auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
-
-                // Clamp timeout beween 10 ms and 5 s
-                estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
-
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, estimatedTimeout);
-
-                // when we wake-up check if we're "stuck" either if we've slept for the estimated timeout
-                // or it has been that long since the last time we sent a packet
-
-                // we are stuck if all of the following are true
-                // - there are no new packets to send or the flow window is full and we can't send any new packets
-                // - there are no packets to resend
-                // - the client has yet to ACK some sent packets
-                auto now = std::chrono::high_resolution_clock::now();
-
-                if ((cvStatus == std::cv_status::timeout || (now - _lastPacketSentAt > estimatedTimeout))
-                    && (_packets.isEmpty() || isFlowWindowFull())
-                    && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
+            // Deactivate queue
+            deactivate();
+            return TimePoint::max();
         }
+
+        _isWaiting = true;
+        _waitTimeout = now + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+        return _waitTimeout;
     }
-    
-    return false;
+
+    // We think the client is still waiting for data (based on the sequence number gap)
+    // Let's wait either for a response from the client or until the estimated timeout
+    // (plus the sync interval to allow the client to respond) has elapsed
+
+    auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
+
+    // Clamp timeout beween 10 ms and 5 s
+    estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
+
+    // when we wake-up check if we're "stuck" either if we've waited for the estimated timeout
+    // or it has been that long since the last time we sent a packet
+
+    // we are stuck if all of the following are true
+    // - there are no new packets to send or the flow window is full and we can't send any new packets
+    // - there are no packets to resend
+    // - the client has yet to ACK some sent packets
+    bool sentLongAgo = std::chrono::high_resolution_clock::now() - _lastPacketSentAt > estimatedTimeout;
+    if ((timedOut || (notified && sentLongAgo)) && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+
+        // Note that we have the _naksLock right now
+        _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+
+        // time to unlock
+        locker.unlock();
+
+        emit timeout();
+        return now;
+    }
+
+    _isWaiting = true;
+    _waitTimeout = now + estimatedTimeout;
+    return _waitTimeout;
 }
 
 void SendQueue::deactivate() {
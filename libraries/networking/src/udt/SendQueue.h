@@ -13,12 +13,10 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
 #include <QtCore/QReadWriteLock>
@@ -31,6 +29,7 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "SentPacketHistory.h"
 
 namespace udt {
     
@@ -38,10 +37,15 @@ class BasePacket;
 class ControlPacket;
 class Packet;
 class PacketList;
+class PacingThread;
 class Socket;
     
+// Sends the reliable packets of a Connection, paced by its CongestionControl.
+//
+// The queue doesn't have a thread of its own, it is stepped by one of the threads of its Socket's PacingEngine.
 class SendQueue : public QObject {
     Q_OBJECT
+    friend class PacingThread;
     
 public:
     enum class State {
@@ -85,15 +89,20 @@ signals:
 
     void timeout();
     
-private slots:
-    void run();
-    
 private:
     SendQueue(Socket* socket, HifiSockAddr dest, SequenceNumber currentSequenceNumber,
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
     
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    // Runs one iteration of the send loop and returns when the next one is due, or TimePoint::max() once stopped.
+    // Only called by the PacingThread the queue lives on.
+    TimePoint step();
+    // Asks the PacingThread to step the queue as soon as possible
+    void wake();
+
     void sendHandshake();
     
     int sendPacket(const Packet& packet);
@@ -102,7 +111,8 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    // Called when there was nothing to send, returns when to step again or TimePoint::max() if the queue is now inactive
+    TimePoint checkInactive(TimePoint now, bool notified);
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -113,6 +123,7 @@ private:
     PacketQueue _packets;
     
     Socket* _socket { nullptr }; // Socket to send packet on
+    PacingThread* _pacingThread { nullptr }; // Thread stepping this queue
     HifiSockAddr _destination; // Destination addr
     
     std::atomic<uint32_t> _lastACKSequenceNumber { 0 }; // Last ACKed sequence number
@@ -131,14 +142,17 @@ private:
     LossList _naks; // Sequence numbers of packets to resend
     
     mutable QReadWriteLock _sentLock; // Protects the sent packet list
-    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
+    SentPacketHistory _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
     
-    std::condition_variable_any _emptyCondition;
+    std::atomic<bool> _notified { false }; // something changed since the last step, which ends any wait
+    
+    // Pacing state, only used by step()
+    TimePoint _nextPacketTimestamp; // when the next packet should go out according to the packet send period
+    TimePoint _nextHandshakeTimestamp; // when to re-send the handshake if it hasn't been ACKed
+    bool _isWaiting { false }; // waiting for something to send or for the client to ACK
+    TimePoint _waitTimeout;
 
     std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
 
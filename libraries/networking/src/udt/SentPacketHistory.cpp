@@ -0,0 +1,93 @@
+//
+//  SentPacketHistory.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-23.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketHistory.h"
+
+#include <algorithm>
+
+#include "Packet.h"
+
+using namespace udt;
+
+void SentPacketHistory::grow(int minCapacity) {
+    static const size_t MIN_CAPACITY = 64;
+
+    size_t capacity = std::max(_entries.size(), MIN_CAPACITY);
+    while (capacity < (size_t)minCapacity) {
+        capacity *= 2;
+    }
+    if (capacity == _entries.size()) {
+        return;
+    }
+
+    std::vector<Entry> entries(capacity);
+    for (int i = 0; i < _size; ++i) {
+        entries[i] = std::move(at(i));
+    }
+    _entries.swap(entries);
+    _head = 0;
+}
+
+void SentPacketHistory::insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet) {
+    if (_size == 0) {
+        _first = sequenceNumber;
+    }
+
+    int offset = seqoff(_first, sequenceNumber);
+    Q_ASSERT_X(offset >= _size, "SentPacketHistory::insert", "Sequence number inserted out of order");
+    if (offset < _size) {
+        return;
+    }
+
+    if ((size_t)offset >= _entries.size()) {
+        grow(offset + 1);
+    }
+
+    // entries outside of the history are always empty, so any skipped sequence numbers are already cleared
+    auto& entry = at(offset);
+    entry.resendCount = 0;
+    entry.packet = std::move(packet);
+    _size = offset + 1;
+}
+
+SentPacketHistory::Entry* SentPacketHistory::find(SequenceNumber sequenceNumber) {
+    if (_size == 0) {
+        return nullptr;
+    }
+
+    int offset = seqoff(_first, sequenceNumber);
+    if (offset < 0 || offset >= _size) {
+        return nullptr;
+    }
+
+    auto& entry = at(offset);
+    return entry.packet ? &entry : nullptr;
+}
+
+void SentPacketHistory::removeUpTo(SequenceNumber sequenceNumber) {
+    if (_size == 0) {
+        return;
+    }
+
+    int count = std::min(seqoff(_first, sequenceNumber) + 1, _size);
+    if (count <= 0) {
+        return;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        auto& entry = at(i);
+        entry.packet.reset();
+        entry.resendCount = 0;
+    }
+    _head = (_head + count) & (_entries.size() - 1);
+    _size -= count;
+    _first += count;
+}
@@ -0,0 +1,59 @@
+//
+//  SentPacketHistory.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-23.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_udt_SentPacketHistory_h
+#define hifi_udt_SentPacketHistory_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SequenceNumber.h"
+
+namespace udt {
+
+class Packet;
+
+// The packets a SendQueue has sent and not had ACKed yet, in a ring buffer indexed by sequence number.
+// Packets are inserted in sequence order and ACKed from the front, so both are O(1), as are lookups for re-sends.
+class SentPacketHistory {
+public:
+    struct Entry {
+        uint8_t resendCount { 0 };
+        std::unique_ptr<Packet> packet;
+    };
+
+    bool isEmpty() const { return _size == 0; }
+
+    // the sequence number must be after the ones already in the history
+    void insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet);
+
+    // returns nullptr if the packet isn't in the history, it was never sent or has been ACKed
+    Entry* find(SequenceNumber sequenceNumber);
+
+    // drops the packets up to and including sequenceNumber
+    void removeUpTo(SequenceNumber sequenceNumber);
+
+private:
+    Entry& at(int offset) { return _entries[(_head + offset) & (_entries.size() - 1)]; }
+    void grow(int minCapacity);
+
+    std::vector<Entry> _entries; // the capacity is a power of two
+    size_t _head { 0 };
+    int _size { 0 }; // number of sequence numbers covered, starting at _first
+    SequenceNumber _first;
+};
+
+}
+
+#endif // hifi_udt_SentPacketHistory_h
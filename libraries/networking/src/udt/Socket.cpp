@@ -15,10 +15,12 @@
 #include <sys/socket.h>
 #endif
 
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
 #include <LogHandler.h>
+#include <SharedCounters.h>
 
 #include "../NetworkLogging.h"
 #include "Connection.h"
@@ -27,6 +29,8 @@
 #include "../NLPacket.h"
 #include "../NLPacketList.h"
 #include "PacketList.h"
+#include "ReceiveBatch.h"
+#include "ReceiveShard.h"
 #include <Trace.h>
 
 using namespace udt;
@@ -38,11 +42,84 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+#include <thread>
+
+#if defined(Q_OS_LINUX)
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+static const int MAX_MESSAGES_PER_SEND_BATCH = 64;
+// kernel limits for a single UDP GSO send
+static const int MAX_GSO_SEGMENTS = 64;
+static const int MAX_GSO_BYTES = 65000;
+#endif
+
+// datagrams written by batching threads, striped by thread so that mixer slaves rarely share a lock
+static const int NUM_SEND_BATCH_STRIPES = 16;
+
+struct Socket::SendBatch {
+    struct Datagram {
+        int offset;
+        int size;
+#if defined(Q_OS_LINUX)
+        sockaddr_in destination;
+#endif
+    };
+
+    Mutex mutex;
+    std::vector<char> data;
+    std::vector<Datagram> datagrams;
+};
+
+static thread_local bool t_batchSends { false };
+
+static const QString USE_BATCHED_RECEIVE_FLAG = "HIFI_UDT_BATCHED_RECEIVE";
+static const QString USE_BATCHED_SEND_FLAG = "HIFI_UDT_BATCHED_SEND";
+
+#if defined(Q_OS_LINUX)
+// opens a non-blocking IPv4 UDP socket with SO_REUSEPORT set and binds it, returns -1 on failure
+static int createReusePortSocket(const QHostAddress& address, quint16 port) {
+    int sd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (sd == -1) {
+        return -1;
+    }
+
+    int enable = 1;
+    int receiveBufferSize = udt::UDP_RECEIVE_BUFFER_SIZE_BYTES;
+    int mtuDiscovery = IP_PMTUDISC_DONT;
+    setsockopt(sd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+    setsockopt(sd, SOL_SOCKET, SO_RCVBUF, &receiveBufferSize, sizeof(receiveBufferSize));
+    setsockopt(sd, IPPROTO_IP, IP_MTU_DISCOVER, &mtuDiscovery, sizeof(mtuDiscovery));
+
+    sockaddr_in bindAddress;
+    memset(&bindAddress, 0, sizeof(bindAddress));
+    bindAddress.sin_family = AF_INET;
+    bindAddress.sin_addr.s_addr = htonl(address.toIPv4Address());
+    bindAddress.sin_port = htons(port);
+
+    if (::bind(sd, reinterpret_cast<sockaddr*>(&bindAddress), sizeof(bindAddress)) != 0) {
+        ::close(sd);
+        return -1;
+    }
+
+    return sd;
+}
+#endif
+
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
     _udpSocket(parent),
     _readyReadBackupTimer(new QTimer(this)),
+    _sendBatches(new SendBatch[NUM_SEND_BATCH_STRIPES]),
     _shouldChangeSocketOptions(shouldChangeSocketOptions)
 {
     connect(&_udpSocket, &QUdpSocket::readyRead, this, &Socket::readPendingDatagrams);
@@ -56,11 +133,249 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+    static const bool useBatchedReceive = QProcessEnvironment::systemEnvironment().contains(USE_BATCHED_RECEIVE_FLAG);
+    if (useBatchedReceive) {
+        setUseBatchedReceive(true);
+    }
+
+    static const bool useBatchedSend = QProcessEnvironment::systemEnvironment().contains(USE_BATCHED_SEND_FLAG);
+    if (useBatchedSend) {
+        setUseBatchedSend(true);
+    }
+}
+
+Socket::~Socket() {
+    stopReceiveShards();
+}
+
+void Socket::setPacingEngine(std::shared_ptr<PacingEngine> pacingEngine) {
+    Lock connectionsLock(_connectionsHashMutex);
+    if (!_connectionsHash.empty()) {
+        qCWarning(networking) << "Could not change the pacing engine of a socket that already has connections";
+        return;
+    }
+    _pacingEngine = pacingEngine ? std::move(pacingEngine) : std::make_shared<PacingEngine>();
+}
+
+bool Socket::isBatchedReceiveSupported() {
+#if defined(Q_OS_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Socket::setUseBatchedReceive(bool useBatchedReceive) {
+    if (useBatchedReceive == isUsingBatchedReceive()) {
+        return;
+    }
+
+    if (useBatchedReceive && !isBatchedReceiveSupported()) {
+        qCWarning(networking) << "Batched datagram receive is not supported on this platform, using QUdpSocket reads.";
+        return;
+    }
+
+    if (useBatchedReceive) {
+        qCDebug(networking) << "Enabling batched datagram receive";
+        _receiveBatch.reset(new ReceiveBatch());
+    } else {
+        qCDebug(networking) << "Disabling batched datagram receive";
+        _receiveBatch.reset();
+    }
+
+    setupBatchedReadNotifier();
+}
+
+bool Socket::isBatchedSendSupported() {
+#if defined(Q_OS_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Socket::setUseBatchedSend(bool useBatchedSend) {
+    if (useBatchedSend == isUsingBatchedSend()) {
+        return;
+    }
+
+    if (useBatchedSend && !isBatchedSendSupported()) {
+        qCWarning(networking) << "Batched datagram send is not supported on this platform, using QUdpSocket writes.";
+        return;
+    }
+
+    if (useBatchedSend) {
+        qCDebug(networking) << "Enabling batched datagram send";
+        _isUsingBatchedSend = true;
+    } else {
+        qCDebug(networking) << "Disabling batched datagram send";
+        _isUsingBatchedSend = false;
+        // don't lose anything that was queued before batching was turned off, what a sending thread still queues
+        // after it goes out with the next flush
+        flushSendBatch();
+    }
+}
+
+void Socket::setBatchSendsOnCurrentThread(bool batchSends) {
+    t_batchSends = batchSends;
+}
+
+bool Socket::isReceiveShardingSupported() {
+#if defined(Q_OS_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Socket::setNumReceiveShards(int numReceiveShards) {
+    if (numReceiveShards > 1 && !isReceiveShardingSupported()) {
+        qCWarning(networking) << "Receive sharding is not supported on this platform, using a single socket.";
+        numReceiveShards = 1;
+    }
+
+    Q_ASSERT_X(_udpSocket.state() != QAbstractSocket::BoundState, "Socket::setNumReceiveShards",
+               "The number of receive shards must be set before the socket is bound");
+
+    _numReceiveShards = std::max(1, numReceiveShards);
+}
+
+bool Socket::bindWithReceiveShards(const QHostAddress& address, quint16 port) {
+#if defined(Q_OS_LINUX)
+    if (address.protocol() != QAbstractSocket::IPv4Protocol) {
+        return false;
+    }
+
+    // the socket read by this thread must be part of the SO_REUSEPORT group too, so we create it ourselves
+    int primaryDescriptor = createReusePortSocket(address, port);
+    if (primaryDescriptor == -1 ||
+        !_udpSocket.setSocketDescriptor(primaryDescriptor, QAbstractSocket::BoundState, QIODevice::ReadWrite)) {
+        qCWarning(networking) << "Could not bind SO_REUSEPORT socket on port" << port << "- error" << errno
+            << "- falling back to a single socket";
+        if (primaryDescriptor != -1) {
+            ::close(primaryDescriptor);
+        }
+        return false;
+    }
+
+    // when we were asked for any port, the shards join whatever port the kernel gave us
+    quint16 boundPort = _udpSocket.localPort();
+
+    for (int i = 1; i < _numReceiveShards; ++i) {
+        int shardDescriptor = createReusePortSocket(address, boundPort);
+        if (shardDescriptor == -1) {
+            qCWarning(networking) << "Could not bind receive shard" << i << "on port" << boundPort << "- error" << errno;
+            break;
+        }
+
+        auto shard = std::unique_ptr<ReceiveShard>(new ReceiveShard(*this, shardDescriptor, i));
+        shard->start();
+        _receiveShards.push_back(std::move(shard));
+    }
+
+    qCDebug(networking) << "Bound port" << boundPort << "with" << _receiveShards.size() + 1 << "receive shards";
+
+    return true;
+#else
+    Q_UNUSED(address);
+    Q_UNUSED(port);
+    return false;
+#endif
+}
+
+void Socket::stopReceiveShards() {
+    for (auto& shard : _receiveShards) {
+        shard->stop();
+    }
+
+    // destroying a shard waits for its thread and closes its socket
+    _receiveShards.clear();
+}
+
+void Socket::addUnfilteredHandler(const HifiSockAddr& senderSockAddr, BasePacketHandler handler) {
+    _unfilteredHandlers[senderSockAddr] = handler;
+
+    auto senders = std::make_shared<std::unordered_set<HifiSockAddr>>();
+    for (const auto& pair : _unfilteredHandlers) {
+        senders->insert(pair.first);
+    }
+    std::atomic_store(&_unfilteredSenders, std::shared_ptr<const std::unordered_set<HifiSockAddr>>(senders));
+}
+
+bool Socket::isUnfilteredSender(const HifiSockAddr& sockAddr) const {
+    auto senders = std::atomic_load(&_unfilteredSenders);
+    return senders && senders->find(sockAddr) != senders->end();
+}
+
+void Socket::notifyShardPending() {
+    // coalesce wake-ups from all shards into a single queued call
+    if (!_hasQueuedShardProcessing.exchange(true)) {
+        QMetaObject::invokeMethod(this, "processShardPending", Qt::QueuedConnection);
+    }
+}
+
+void Socket::processShardPending() {
+    _hasQueuedShardProcessing = false;
+
+    std::vector<ReceiveShard::ForwardedDatagram> datagrams;
+    ReceiveShard::UnreliableReceiveStatsMap unreliableStats;
+
+    for (auto& shard : _receiveShards) {
+        shard->takePending(datagrams, unreliableStats);
+
+        for (auto& datagram : datagrams) {
+            processDatagram(std::move(datagram.buffer), datagram.size, datagram.senderSockAddr, datagram.receiveTime);
+        }
+
+        for (const auto& pair : unreliableStats) {
+            auto connection = findOrCreateConnection(pair.first, true);
+            if (connection) {
+                connection->recordReceivedUnreliablePackets(pair.second.wireSize, pair.second.payloadSize,
+                                                            pair.second.lastSequenceNumber, pair.second.numPackets);
+            }
+        }
+
+        datagrams.clear();
+        unreliableStats.clear();
+    }
+}
+
+void Socket::recordReceiveBatch(int numPackets) {
+    Lock statsLock(_socketStatsMutex);
+    _socketStats.recordReceiveBatch(numPackets);
+}
+
+void Socket::setupBatchedReadNotifier() {
+    // QUdpSocket only re-arms its own read notification from inside readDatagram, so when we drain the descriptor
+    // ourselves we need a notifier of our own that stays armed while datagrams are pending
+    if (_batchedReadNotifier) {
+        _batchedReadNotifier->setEnabled(false);
+        _batchedReadNotifier->deleteLater();
+        _batchedReadNotifier = nullptr;
+    }
+
+    disconnect(&_udpSocket, &QUdpSocket::readyRead, this, &Socket::readPendingDatagrams);
+
+    auto sd = _udpSocket.socketDescriptor();
+    if (_receiveBatch && sd != -1) {
+        _batchedReadNotifier = new QSocketNotifier(sd, QSocketNotifier::Read, this);
+        connect(_batchedReadNotifier, &QSocketNotifier::activated, this, &Socket::readPendingDatagrams);
+    } else {
+        connect(&_udpSocket, &QUdpSocket::readyRead, this, &Socket::readPendingDatagrams);
+    }
 }
 
 void Socket::bind(const QHostAddress& address, quint16 port) {
 
-    _udpSocket.bind(address, port);
+    if (_numReceiveShards <= 1 || !bindWithReceiveShards(address, port)) {
+        _udpSocket.bind(address, port);
+    }
+
+    if (_receiveBatch) {
+        // the descriptor changes on every (re)bind
+        setupBatchedReadNotifier();
+    }
 
     if (_shouldChangeSocketOptions) {
         setSystemBufferSizes();
@@ -69,6 +384,11 @@ void Socket::bind(const QHostAddress& address, quint16 port) {
         auto sd = _udpSocket.socketDescriptor();
         int val = IP_PMTUDISC_DONT;
         setsockopt(sd, IPPROTO_IP, IP_MTU_DISCOVER, &val, sizeof(val));
+
+        // UDP GSO is available from Linux 4.18, older kernels reject the option
+        int segmentSize = 0;
+        socklen_t segmentSizeLength = sizeof(segmentSize);
+        _isGSOSupported = getsockopt(sd, SOL_UDP, UDP_SEGMENT, &segmentSize, &segmentSizeLength) == 0;
 #elif defined(Q_OS_WIN)
         auto sd = _udpSocket.socketDescriptor();
         int val = 0; // false
@@ -85,6 +405,7 @@ void Socket::rebind() {
 }
 
 void Socket::rebind(quint16 localPort) {
+    stopReceiveShards();
     _udpSocket.abort();
     bind(QHostAddress::AnyIPv4, localPort);
 }
@@ -243,9 +564,25 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
         qCDebug(networking) << "Attempt to writeDatagram when in unbound state to" << sockAddr;
         return -1;
     }
+
+    static SharedCounter datagramsSent("udt.datagramsSent");
+    static SharedCounter bytesSent("udt.bytesSent");
+    static SharedCounter writeErrors("udt.writeErrors");
+
+    if (queueBatchedDatagram(datagram.constData(), datagram.size(), sockAddr)) {
+        datagramsSent.increment();
+        bytesSent.increment(datagram.size());
+        return datagram.size();
+    }
+
     qint64 bytesWritten = _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
+    if (bytesWritten >= 0) {
+        datagramsSent.increment();
+        bytesSent.increment(bytesWritten);
+    }
     int pending = _udpSocket.bytesToWrite();
     if (bytesWritten < 0 || pending) {
+        writeErrors.increment();
         int wsaError = 0;
         static std::atomic<int> previousWsaError (0);
 #ifdef WIN32
@@ -270,6 +607,180 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+bool Socket::queueBatchedDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr) {
+#if defined(Q_OS_LINUX)
+    if (!t_batchSends || !_isUsingBatchedSend || sockAddr.getAddress().protocol() != QAbstractSocket::IPv4Protocol) {
+        return false;
+    }
+
+    static const std::hash<std::thread::id> threadHash;
+    auto& batch = _sendBatches[threadHash(std::this_thread::get_id()) % NUM_SEND_BATCH_STRIPES];
+
+    SendBatch::Datagram datagram;
+    memset(&datagram.destination, 0, sizeof(datagram.destination));
+    datagram.destination.sin_family = AF_INET;
+    datagram.destination.sin_addr.s_addr = htonl(sockAddr.getAddress().toIPv4Address());
+    datagram.destination.sin_port = htons(sockAddr.getPort());
+    datagram.size = (int)size;
+
+    Lock lock(batch.mutex);
+    datagram.offset = (int)batch.data.size();
+    batch.data.insert(batch.data.end(), data, data + size);
+    batch.datagrams.push_back(datagram);
+
+    return true;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(size);
+    Q_UNUSED(sockAddr);
+    return false;
+#endif
+}
+
+void Socket::flushSendBatch() {
+    // the stripes are drained even with batching off, for the datagrams queued while it was being turned off
+    // swap each stripe into a local batch so writers are only blocked for the swap, not the syscalls
+    SendBatch flushBatch;
+    for (int i = 0; i < NUM_SEND_BATCH_STRIPES; ++i) {
+        auto& batch = _sendBatches[i];
+        {
+            Lock lock(batch.mutex);
+            if (batch.datagrams.empty()) {
+                continue;
+            }
+            flushBatch.data.swap(batch.data);
+            flushBatch.datagrams.swap(batch.datagrams);
+        }
+
+        sendQueuedDatagrams(flushBatch);
+
+        // give the (now empty) storage back to the stripe so its capacity is reused next frame
+        flushBatch.data.clear();
+        flushBatch.datagrams.clear();
+        {
+            Lock lock(batch.mutex);
+            if (batch.datagrams.empty()) {
+                flushBatch.data.swap(batch.data);
+                flushBatch.datagrams.swap(batch.datagrams);
+            }
+        }
+    }
+}
+
+void Socket::sendQueuedDatagrams(SendBatch& batch) {
+#if defined(Q_OS_LINUX)
+    auto sd = _udpSocket.socketDescriptor();
+    if (sd == -1 || _udpSocket.state() != QAbstractSocket::BoundState) {
+        qCDebug(networking) << "Dropping" << batch.datagrams.size() << "batched datagrams, socket is unbound";
+        return;
+    }
+
+    static const size_t CONTROL_SIZE = CMSG_SPACE(sizeof(uint16_t));
+
+    mmsghdr headers[MAX_MESSAGES_PER_SEND_BATCH];
+    alignas(cmsghdr) char controls[MAX_MESSAGES_PER_SEND_BATCH][CONTROL_SIZE];
+    std::vector<iovec> iovecs(batch.datagrams.size());
+
+    const auto& datagrams = batch.datagrams;
+    size_t next = 0;
+    int numSegmentedSends = 0;
+
+    while (next < datagrams.size()) {
+        bool useGSO = _isGSOSupported;
+        int numMessages = 0;
+        memset(headers, 0, sizeof(headers));
+
+        // build up to a full set of messages, coalescing equal-sized datagrams to the same destination with GSO
+        while (next < datagrams.size() && numMessages < MAX_MESSAGES_PER_SEND_BATCH) {
+            const auto& first = datagrams[next];
+            auto& header = headers[numMessages].msg_hdr;
+
+            size_t count = 1;
+            int totalBytes = first.size;
+            if (useGSO) {
+                while (next + count < datagrams.size() && count < (size_t)MAX_GSO_SEGMENTS) {
+                    const auto& previous = datagrams[next + count - 1];
+                    const auto& candidate = datagrams[next + count];
+
+                    // every segment but the last must be exactly the segment size
+                    if (previous.size != first.size || candidate.size > first.size ||
+                        totalBytes + candidate.size > MAX_GSO_BYTES ||
+                        candidate.destination.sin_addr.s_addr != first.destination.sin_addr.s_addr ||
+                        candidate.destination.sin_port != first.destination.sin_port) {
+                        break;
+                    }
+
+                    totalBytes += candidate.size;
+                    ++count;
+                }
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                const auto& datagram = datagrams[next + i];
+                iovecs[next + i].iov_base = const_cast<char*>(batch.data.data()) + datagram.offset;
+                iovecs[next + i].iov_len = datagram.size;
+            }
+
+            header.msg_name = const_cast<sockaddr_in*>(&first.destination);
+            header.msg_namelen = sizeof(sockaddr_in);
+            header.msg_iov = &iovecs[next];
+            header.msg_iovlen = count;
+
+            if (count > 1) {
+                header.msg_control = controls[numMessages];
+                header.msg_controllen = CONTROL_SIZE;
+
+                auto control = CMSG_FIRSTHDR(&header);
+                control->cmsg_level = SOL_UDP;
+                control->cmsg_type = UDP_SEGMENT;
+                control->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                uint16_t segmentSize = (uint16_t)first.size;
+                memcpy(CMSG_DATA(control), &segmentSize, sizeof(segmentSize));
+
+                ++numSegmentedSends;
+            }
+
+            next += count;
+            ++numMessages;
+        }
+
+        int numSent = 0;
+        while (numSent < numMessages) {
+            int result = ::sendmmsg(sd, headers + numSent, numMessages - numSent, 0);
+            if (result > 0) {
+                numSent += result;
+                continue;
+            }
+
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if (useGSO && (errno == EIO || errno == EINVAL) && headers[numSent].msg_hdr.msg_controllen > 0) {
+                // the kernel or the NIC refused the segmented send - stop using GSO and re-send what's left without it
+                qCWarning(networking) << "UDP GSO send failed with error" << errno << "- disabling GSO";
+                _isGSOSupported = false;
+
+                next = headers[numSent].msg_hdr.msg_iov - iovecs.data();
+                break;
+            }
+
+            // drop this message like a failed writeDatagram would and carry on with the rest
+            HIFI_FCDEBUG(networking(), "udt::sendmmsg error -" << errno);
+            ++numSent;
+        }
+    }
+
+    {
+        Lock statsLock(_socketStatsMutex);
+        _socketStats.recordSendBatch((int)datagrams.size(), numSegmentedSends);
+    }
+#else
+    // batches are never queued on platforms without sendmmsg
+    Q_UNUSED(batch);
+#endif
+}
+
 Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreate) {
     Lock connectionsLock(_connectionsHashMutex);
     auto it = _connectionsHash.find(sockAddr);
@@ -369,6 +880,12 @@ void Socket::readPendingDatagrams() {
     using namespace std::chrono;
     static const auto MAX_PROCESS_TIME { 100ms };
     const auto abortTime = system_clock::now() + MAX_PROCESS_TIME;
+
+    if (_receiveBatch) {
+        readPendingDatagramBatches(abortTime);
+        return;
+    }
+
     int packetSizeWithHeader = -1;
 
     while (_udpSocket.hasPendingDatagrams() &&
@@ -394,7 +911,7 @@ void Socket::readPendingDatagrams() {
         HifiSockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::allocate(packetSizeWithHeader);
 
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
@@ -410,83 +927,148 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    }
+}
+
+void Socket::readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime) {
+#if defined(Q_OS_LINUX)
+    using namespace std::chrono;
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+    auto sd = _udpSocket.socketDescriptor();
+    if (sd == -1) {
+        return;
+    }
 
-            continue;
+    auto& batch = *_receiveBatch;
+
+    while (system_clock::now() <= abortTime) {
+        int numReceived = batch.receive(sd);
+        if (numReceived <= 0) {
+            if (numReceived < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                HIFI_FCDEBUG(networking(), "Socket::readPendingDatagramBatches recvmmsg error -" << errno);
+            }
+            break;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        // we're reading packets so re-start the readyRead backup timer
+        _readyReadBackupTimer->start();
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        // every datagram in the batch shares the time point of the syscall that pulled it
+        auto receiveTime = p_high_resolution_clock::now();
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+        recordReceiveBatch(numReceived);
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+        for (int i = 0; i < numReceived; ++i) {
+            int sizeRead = batch.sizeAt(i);
+            HifiSockAddr senderSockAddr(batch.addressAt(i));
+
+            // save information for this packet, in case it is the one that sticks readyRead
+            _lastPacketSizeRead = sizeRead;
+            _lastPacketSockAddr = senderSockAddr;
+
+            if (sizeRead <= 0) {
+                // leave the buffer in its slot so it is re-used for the next batch
+                continue;
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+            processDatagram(std::move(batch.buffers[i]), sizeRead, senderSockAddr, receiveTime);
+        }
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+        if (numReceived < ReceiveBatch::MAX_DATAGRAMS) {
+            // the socket has been drained
+            break;
+        }
+    }
+#else
+    Q_UNUSED(abortTime);
+#endif
+}
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+void Socket::processDatagram(PacketBuffer buffer, int packetSizeWithHeader,
+                             const HifiSockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime) {
+    static SharedCounter datagramsReceived("udt.datagramsReceived");
+    static SharedCounter bytesReceived("udt.bytesReceived");
+    datagramsReceived.increment();
+    bytesReceived.increment(packetSizeWithHeader);
+
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
+
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                    qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                        << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
+                    return;
                 }
+            } else if (connection) {
+                connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                            packet->getPayloadSize(),
+                                                            packet->getSequenceNumber());
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr, true);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
                 }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
 }
 
-void Socket::connectToSendSignal(const HifiSockAddr& destinationAddr, QObject* receiver, const char* slot) {
+void Socket::connectToSendSignal(const HifiSockAddr& destinationAddr, QObject* receiver, std::function<void()> slot) {
     Lock connectionsLock(_connectionsHashMutex);
     auto it = _connectionsHash.find(destinationAddr);
     if (it != _connectionsHash.end()) {
-        connect(it->second.get(), SIGNAL(packetSent()), receiver, slot);
+        connect(it->second.get(), &Connection::packetSent, receiver, slot);
     }
 }
 
@@ -527,6 +1109,10 @@ Socket::StatsVector Socket::sampleStatsForAllConnections() {
     return result;
 }
 
+ConnectionStats::Stats Socket::sampleSocketStats() {
+    Lock statsLock(_socketStatsMutex);
+    return _socketStats.sample();
+}
 
 std::vector<HifiSockAddr> Socket::getConnectionSockAddrs() {
     std::vector<HifiSockAddr> addr;
@@ -16,16 +16,23 @@
 
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <list>
+#include <atomic>
 
 #include <QtCore/QObject>
+#include <QtCore/QSocketNotifier>
 #include <QtCore/QTimer>
 #include <QtNetwork/QUdpSocket>
 
+#include <PortableHighResolutionClock.h>
+
 #include "../HifiSockAddr.h"
+#include "BBRCC.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "PacingEngine.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -34,6 +41,8 @@ class UDTTest;
 namespace udt {
 
 class BasePacket;
+class ReceiveShard;
+struct ReceiveBatch;
 class Packet;
 class PacketList;
 class SequenceNumber;
@@ -56,6 +65,7 @@ public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
     
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
     
     quint16 localPort() const { return _udpSocket.localPort(); }
     
@@ -78,8 +88,7 @@ public:
     void setConnectionCreationFilterOperator(ConnectionCreationFilterOperator filterOperator)
         { _connectionCreationFilterOperator = filterOperator; }
     
-    void addUnfilteredHandler(const HifiSockAddr& senderSockAddr, BasePacketHandler handler)
-        { _unfilteredHandlers[senderSockAddr] = handler; }
+    void addUnfilteredHandler(const HifiSockAddr& senderSockAddr, BasePacketHandler handler);
     
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
@@ -89,6 +98,33 @@ public:
     
     StatsVector sampleStatsForAllConnections();
 
+    // socket-wide stats that are not attributable to a single connection (e.g. receive batch sizes)
+    ConnectionStats::Stats sampleSocketStats();
+
+    // batched receive drains many datagrams per syscall (recvmmsg) where the platform supports it
+    static bool isBatchedReceiveSupported();
+    bool isUsingBatchedReceive() const { return _receiveBatch != nullptr; }
+    void setUseBatchedReceive(bool useBatchedReceive);
+
+    // batched send queues the datagrams written by opted-in threads and flushes them with sendmmsg (and UDP GSO where
+    // the kernel supports it) when flushSendBatch is called, typically once per mixer frame
+    static bool isBatchedSendSupported();
+    bool isUsingBatchedSend() const { return _isUsingBatchedSend; }
+    void setUseBatchedSend(bool useBatchedSend);
+    static void setBatchSendsOnCurrentThread(bool batchSends);
+    void flushSendBatch();
+
+    // with more than one receive shard the port is bound by that many SO_REUSEPORT sockets, each read on its own thread
+    // must be set before bind
+    static bool isReceiveShardingSupported();
+    int getNumReceiveShards() const { return _numReceiveShards; }
+    void setNumReceiveShards(int numReceiveShards);
+
+    // the threads the send queues of this socket's connections are paced on, which sockets can share so that a process
+    // with many of them doesn't have pacing threads for each - must be set before there are connections
+    PacingEngine& getPacingEngine() { return *_pacingEngine; }
+    void setPacingEngine(std::shared_ptr<PacingEngine> pacingEngine);
+
 #if (PR_BUILD || DEV_BUILD)
     void sendFakedHandshakeRequest(const HifiSockAddr& sockAddr);
 #endif
@@ -109,14 +145,30 @@ private slots:
     void handleStateChanged(QAbstractSocket::SocketState socketState);
 
 private:
+    struct SendBatch;
+
     void setSystemBufferSizes();
+    void setupBatchedReadNotifier();
+    void readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime);
+    bool queueBatchedDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr);
+    void sendQueuedDatagrams(SendBatch& batch);
+    bool bindWithReceiveShards(const QHostAddress& address, quint16 port);
+    void stopReceiveShards();
+    bool isUnfilteredSender(const HifiSockAddr& sockAddr) const;
+    void notifyShardPending();
+    Q_INVOKABLE void processShardPending();
+    void recordReceiveBatch(int numPackets);
+
+    void processDatagram(PacketBuffer buffer, int packetSizeWithHeader,
+                         const HifiSockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime);
+
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreation = false);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const HifiSockAddr& destination);
     
     std::vector<HifiSockAddr> getConnectionSockAddrs();
-    void connectToSendSignal(const HifiSockAddr& destinationAddr, QObject* receiver, const char* slot);
+    void connectToSendSignal(const HifiSockAddr& destinationAddr, QObject* receiver, std::function<void()> slot);
     
     Q_INVOKABLE void writeReliablePacket(Packet* packet, const HifiSockAddr& sockAddr);
     Q_INVOKABLE void writeReliablePacketList(PacketList* packetList, const HifiSockAddr& sockAddr);
@@ -133,10 +185,30 @@ private:
 
     std::unordered_map<HifiSockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<HifiSockAddr, SequenceNumber> _unreliableSequenceNumbers;
+    // declared before the connections, which have to be gone before the pacing threads are stopped
+    std::shared_ptr<PacingEngine> _pacingEngine { std::make_shared<PacingEngine>() };
     std::unordered_map<HifiSockAddr, std::unique_ptr<Connection>> _connectionsHash;
 
     QTimer* _readyReadBackupTimer { nullptr };
 
+    std::unique_ptr<ReceiveBatch> _receiveBatch;
+    QSocketNotifier* _batchedReadNotifier { nullptr };
+
+    int _numReceiveShards { 1 };
+    std::vector<std::unique_ptr<ReceiveShard>> _receiveShards;
+    std::atomic<bool> _hasQueuedShardProcessing { false };
+
+    // read by the receive shards, replaced (never modified) whenever an unfiltered handler is added
+    std::shared_ptr<const std::unordered_set<HifiSockAddr>> _unfilteredSenders;
+
+    // allocated with the socket, the sending threads queue into them while batching is turned on and off
+    std::unique_ptr<SendBatch[]> _sendBatches;
+    std::atomic<bool> _isUsingBatchedSend { false };
+    std::atomic<bool> _isGSOSupported { false };
+
+    Mutex _socketStatsMutex;
+    ConnectionStats _socketStats;
+
     int _maxBandwidth { -1 };
 
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<TCPVegasCC>() };
@@ -148,6 +220,7 @@ private:
     HifiSockAddr _lastPacketSockAddr;
     
     friend UDTTest;
+    friend ReceiveShard;
 };
     
 } // namespace udt
@@ -254,6 +254,13 @@ int TCPVegasCC::estimatedTimeout() const {
     return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
 }
 
+int TCPVegasCC::estimatedBandwidth() const {
+    // the rate a full congestion window gets through at the base RTT, what Vegas calls the expected rate
+    static const int64_t USECS_PER_SECOND = 1000000;
+    int rtt = minRTT() > 0 ? minRTT() : _ewmaRTT;
+    return rtt > 0 ? (int)(_congestionWindowSize * USECS_PER_SECOND / rtt) : 0;
+}
+
 bool TCPVegasCC::isCongestionWindowLimited() {
     if (_slowStart) {
         return true;
@@ -0,0 +1,178 @@
+//
+//  TimerWheel.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2021-03-22.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+// Hierarchical timer wheel, with NUM_LEVELS levels of NUM_SLOTS slots.
+//
+// Scheduling a timer is O(1): it goes in the level whose slots are as long as the time left before it expires, and is
+// moved down a level each time the level above reaches its slot. Timers can't be cancelled, owners that reschedule
+// are expected to skip the stale timers as they expire.
+// Timers further away than the range of the wheel expire at the end of its range.
+template <typename T>
+class TimerWheel {
+public:
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    static const int SLOT_BITS = 6;
+    static const int NUM_SLOTS = 1 << SLOT_BITS;
+    static const int NUM_LEVELS = 4;
+
+    TimerWheel(std::chrono::microseconds resolution, TimePoint start) : _resolution(resolution), _start(start) {}
+
+    bool isEmpty() const { return _numTimers == 0 && _due.empty(); }
+
+    // timers never expire before their time, but may expire up to one resolution after it
+    void schedule(T value, TimePoint when);
+
+    // appends the timers that have expired by now to expired
+    void advance(TimePoint now, std::vector<T>& expired);
+
+    // when advance needs to be called next, either for the next timer or to move timers down a level
+    TimePoint getNextCheck() const;
+
+private:
+    struct Timer {
+        uint64_t tick;
+        T value;
+    };
+    using Slot = std::vector<Timer>;
+
+    uint64_t toTick(TimePoint time) const;
+    TimePoint toTime(uint64_t tick) const { return _start + _resolution * tick; }
+    void insert(Timer timer);
+
+    const std::chrono::microseconds _resolution;
+    const TimePoint _start;
+    uint64_t _currentTick { 0 };
+    std::array<std::array<Slot, NUM_SLOTS>, NUM_LEVELS> _slots;
+    std::vector<T> _due;
+    size_t _numTimers { 0 };
+};
+
+template <typename T>
+uint64_t TimerWheel<T>::toTick(TimePoint time) const {
+    if (time <= _start) {
+        return 0;
+    }
+    auto elapsed = time - _start;
+    auto ticks = elapsed / _resolution;
+    // round up, so that timers don't expire early
+    if (elapsed % _resolution != decltype(elapsed)::zero()) {
+        ++ticks;
+    }
+    return (uint64_t)ticks;
+}
+
+template <typename T>
+void TimerWheel<T>::schedule(T value, TimePoint when) {
+    uint64_t tick = toTick(when);
+    if (tick <= _currentTick) {
+        _due.push_back(std::move(value));
+        return;
+    }
+    insert({ tick, std::move(value) });
+    ++_numTimers;
+}
+
+template <typename T>
+void TimerWheel<T>::insert(Timer timer) {
+    static const uint64_t MAX_DELTA = ((uint64_t)1 << (SLOT_BITS * NUM_LEVELS)) - 1;
+    uint64_t delta = timer.tick - _currentTick;
+    if (delta > MAX_DELTA) {
+        timer.tick = _currentTick + MAX_DELTA;
+        delta = MAX_DELTA;
+    }
+
+    int level = 0;
+    while (level < NUM_LEVELS - 1 && delta >= ((uint64_t)1 << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    _slots[level][(timer.tick >> (SLOT_BITS * level)) & (NUM_SLOTS - 1)].push_back(std::move(timer));
+}
+
+template <typename T>
+void TimerWheel<T>::advance(TimePoint now, std::vector<T>& expired) {
+    for (auto& value : _due) {
+        expired.push_back(std::move(value));
+    }
+    _due.clear();
+
+    uint64_t targetTick = now > _start ? (uint64_t)((now - _start) / _resolution) : 0;
+    if (_numTimers == 0) {
+        _currentTick = std::max(_currentTick, targetTick);
+        return;
+    }
+
+    while (_currentTick < targetTick && _numTimers > 0) {
+        ++_currentTick;
+
+        // move the timers of the slots starting now down a level, from the top
+        for (int level = NUM_LEVELS - 1; level > 0; --level) {
+            if ((_currentTick & (((uint64_t)1 << (SLOT_BITS * level)) - 1)) != 0) {
+                continue;
+            }
+            Slot timers;
+            timers.swap(_slots[level][(_currentTick >> (SLOT_BITS * level)) & (NUM_SLOTS - 1)]);
+            for (auto& timer : timers) {
+                if (timer.tick <= _currentTick) {
+                    expired.push_back(std::move(timer.value));
+                    --_numTimers;
+                } else {
+                    insert(std::move(timer));
+                }
+            }
+        }
+
+        auto& slot = _slots[0][_currentTick & (NUM_SLOTS - 1)];
+        for (auto& timer : slot) {
+            expired.push_back(std::move(timer.value));
+        }
+        _numTimers -= slot.size();
+        slot.clear();
+    }
+    _currentTick = std::max(_currentTick, targetTick);
+}
+
+template <typename T>
+typename TimerWheel<T>::TimePoint TimerWheel<T>::getNextCheck() const {
+    if (!_due.empty()) {
+        return toTime(_currentTick);
+    }
+    if (_numTimers == 0) {
+        return TimePoint::max();
+    }
+
+    uint64_t tick = _currentTick + 1;
+    for (; (tick & (NUM_SLOTS - 1)) != 0; ++tick) {
+        if (!_slots[0][tick & (NUM_SLOTS - 1)].empty()) {
+            break;
+        }
+    }
+    return toTime(tick);
+}
+
+}
+
+#endif // hifi_TimerWheel_h
@@ -16,6 +16,7 @@
 #include <cmath>
 #include <fstream> // to load voxels from file
 
+#include <QBuffer>
 #include <QDataStream>
 #include <QDebug>
 #include <QEventLoop>
@@ -44,15 +45,17 @@
 #include <ResourceManager.h>
 #include <SharedUtil.h>
 #include <PathUtils.h>
+#include <TBBHelpers.h>
 #include <ViewFrustum.h>
 
+#include "OctreeBinaryPersist.h"
 #include "OctreeConstants.h"
 #include "OctreeLogging.h"
 #include "OctreeQueryNode.h"
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", "bin"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -139,6 +142,49 @@ void Octree::recurseTreeWithOperator(RecurseOctreeOperator* operatorObject) {
     recurseElementWithOperator(_rootElement, operatorObject);
 }
 
+// The roots of the subtrees of recurseTreeInParallel are at this depth, there are up to 8^depth of them
+static const int PARALLEL_RECURSION_DEPTH = 2;
+
+void Octree::recurseTreeInParallel(ParallelRecurseOctreeOperator& operatorObject) {
+    std::vector<OctreeElementPointer> subtrees;
+    recurseElementInParallel(_rootElement, operatorObject, 0, subtrees);
+
+    std::vector<std::unique_ptr<ParallelRecurseOctreeOperator>> subtreeOperators(subtrees.size());
+    tbb::parallel_for((size_t)0, subtrees.size(), [&](size_t i) {
+        subtreeOperators[i] = operatorObject.clone();
+        recurseElementInParallel(subtrees[i], *subtreeOperators[i], PARALLEL_RECURSION_DEPTH, subtrees);
+    });
+
+    // in the order of the subtrees, so that the result doesn't depend on how the tasks were scheduled
+    for (const auto& subtreeOperator : subtreeOperators) {
+        operatorObject.merge(*subtreeOperator);
+    }
+}
+
+// Visits the element and its children, other than the subtrees under PARALLEL_RECURSION_DEPTH which are only gathered
+// when recursing from above it. The tasks start at that depth and so never touch the subtrees.
+void Octree::recurseElementInParallel(const OctreeElementPointer& element, ParallelRecurseOctreeOperator& operatorObject,
+                                      int recursionCount, std::vector<OctreeElementPointer>& subtrees) {
+    if (recursionCount > DANGEROUSLY_DEEP_RECURSION) {
+        HIFI_FCDEBUG(octree(), "Octree::recurseElementInParallel() reached DANGEROUSLY_DEEP_RECURSION, bailing!");
+        return;
+    }
+
+    if (operatorObject.visit(element)) {
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            OctreeElementPointer child = element->getChildAtIndex(i);
+            if (!child) {
+                continue;
+            }
+            if (recursionCount + 1 == PARALLEL_RECURSION_DEPTH) {
+                subtrees.push_back(child);
+            } else {
+                recurseElementInParallel(child, operatorObject, recursionCount + 1, subtrees);
+            }
+        }
+    }
+}
+
 bool Octree::recurseElementWithOperator(const OctreeElementPointer& element,
                                         RecurseOctreeOperator* operatorObject, int recursionCount) {
     if (recursionCount > DANGEROUSLY_DEEP_RECURSION) {
@@ -676,6 +722,30 @@ bool Octree::readFromFile(const char* fileName) {
         return readJSONFromGzippedFile(qFileName);
     }
 
+    if (qFileName.endsWith(".bin")) {
+        // a binary persist file could also hold gzipped JSON, from a failed binary write or from the domain server
+        QFile file(qFileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        // binary data is read straight from the mapped file
+        QByteArray fileData;
+        uchar* mappedData = file.map(0, file.size());
+        if (mappedData) {
+            fileData = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData), file.size());
+        } else {
+            fileData = file.readAll();
+        }
+        QByteArray uncompressedData;
+        if (!OctreeBinaryPersist::hasMagic(fileData) && gunzip(fileData, uncompressedData)) {
+            fileData = uncompressedData;
+        }
+
+        QDataStream dataStream(fileData);
+        QUrl relativeURL = QUrl::fromLocalFile(qFileName).adjusted(QUrl::RemoveFilename);
+        return readFromStream(fileData.size(), dataStream, "", false, relativeURL);
+    }
+
     QFile file(qFileName);
 
     if (!file.open(QIODevice::ReadOnly)) {
@@ -812,6 +882,9 @@ bool Octree::readFromStream(
     if (firstChar == (char) PacketType::EntityData) {
         qCWarning(octree) << "Reading from binary SVO no longer supported";
         return false;
+    } else if (OctreeBinaryPersist::hasMagic(*device)) {
+        qCDebug(octree) << "Reading from binary persist Stream length:" << streamLength;
+        return readBinaryFromStream(inputStream);
     } else {
         qCDebug(octree) << "Reading from JSON SVO Stream length:" << streamLength;
         return readJSONFromStream(streamLength, inputStream, marketplaceID, isImport, relativeURL);
@@ -819,27 +892,10 @@ bool Octree::readFromStream(
 }
 
 
-namespace {
-// hack to get the marketplace id into the entities.  We will create a way to get this from a hash of
-// the entity later, but this helps us move things along for now
-QVariantMap addMarketplaceIDToDocumentEntities(QVariantMap& doc, const QString& marketplaceID) {
-    if (!marketplaceID.isEmpty()) {
-        QVariantList newEntitiesArray;
-
-        // build a new entities array
-        auto entitiesArray = doc["Entities"].toList();
-        for (auto it = entitiesArray.begin(); it != entitiesArray.end(); it++) {
-            auto entity = (*it).toMap();
-            entity["marketplaceID"] = marketplaceID;
-            newEntitiesArray.append(entity);
-        }
-        doc["Entities"] = newEntitiesArray;
-    }
-    return doc;
-}
-
-}  // Unnamed namepsace
-const int READ_JSON_BUFFER_SIZE = 2048;
+// the entities handed to the tree at a time
+static const int READ_JSON_BATCH_SIZE = 256;
+// the progress is logged every this fraction of the document
+static const int READ_JSON_PROGRESS_STEPS = 10;
 
 bool Octree::readJSONFromStream(
     uint64_t streamLength,
@@ -848,41 +904,91 @@ bool Octree::readJSONFromStream(
     const bool isImport,
     const QUrl& relativeURL
 ) {
-    // if the data is gzipped we may not have a useful bytesAvailable() result, so just keep reading until
-    // we get an eof.  Leave streamLength parameter for consistency.
-
-    QByteArray jsonBuffer;
-    char* rawData = new char[READ_JSON_BUFFER_SIZE];
-    while (!inputStream.atEnd()) {
-        int got = inputStream.readRawData(rawData, READ_JSON_BUFFER_SIZE - 1);
-        if (got < 0) {
-            qCritical() << "error while reading from json stream";
-            delete[] rawData;
-            return false;
+    // The entities are parsed from the device and added to the tree a batch at a time, so the memory used doesn't grow
+    // with the size of the document. It takes two passes, because the top-level values the entities need come after
+    // them: the first only skips over the entities, the second adds them. The streamLength isn't reliable for gzipped
+    // data, the device's size is used for the progress instead.
+    QIODevice* device = inputStream.device();
+    QBuffer wholeData;
+    if (device->isSequential()) {
+        // a device that can't seek back is read whole first
+        wholeData.setData(device->readAll());
+        wholeData.open(QIODevice::ReadOnly);
+        device = &wholeData;
+    }
+    const qint64 start = device->pos();
+    const qint64 totalBytes = std::max(device->size() - start, (qint64)1);
+
+    OctreeEntitiesFileParser headerParser;
+    headerParser.setEntitiesDevice(device);
+    QVariantMap header;
+    if (!headerParser.parseEntities(header, nullptr)) {
+        qCritical() << "Couldn't parse Entities JSON:" << headerParser.getErrorString().c_str();
+        return false;
+    }
+    if (!device->seek(start)) {
+        qCritical() << "Couldn't go back to the start of the Entities JSON";
+        return false;
+    }
+
+    const int numEntities = headerParser.getNumEntities();
+    const bool isLarge = numEntities > READ_JSON_BATCH_SIZE;
+    if (isLarge) {
+        qCDebug(octree) << "Reading" << numEntities << "entities from" << totalBytes << "bytes of JSON";
+    }
+
+    beginReadingEntities(header, isImport);
+
+    OctreeEntitiesFileParser entitiesParser;
+    entitiesParser.setEntitiesDevice(device);
+    entitiesParser.setRelativeURL(relativeURL);
+    QVariantList batch;
+    batch.reserve(READ_JSON_BATCH_SIZE);
+    int progressStep = 0;
+    auto readBatch = [&] {
+        readEntitiesBatch(batch);
+        batch.clear();
+
+        int step = (int)(entitiesParser.getBytesRead() * READ_JSON_PROGRESS_STEPS / totalBytes);
+        if (isLarge && step > progressStep) {
+            progressStep = step;
+            qCDebug(octree) << "Read" << entitiesParser.getNumEntities() << "of" << numEntities << "entities";
         }
-        if (got == 0) {
-            break;
+    };
+
+    QVariantMap unusedHeader;
+    bool parsed = entitiesParser.parseEntities(unusedHeader, [&](QJsonObject& entityObject) {
+        QVariantMap entity = entityObject.toVariantMap();
+        // hack to get the marketplace id into the entities.  We will create a way to get this from a hash of
+        // the entity later, but this helps us move things along for now
+        if (!marketplaceID.isEmpty()) {
+            entity["marketplaceID"] = marketplaceID;
+        }
+        batch.append(entity);
+        if (batch.size() >= READ_JSON_BATCH_SIZE) {
+            readBatch();
         }
-        jsonBuffer += QByteArray(rawData, got);
+        return true;
+    });
+    if (parsed && !batch.isEmpty()) {
+        readBatch();
     }
 
-    OctreeEntitiesFileParser octreeParser;
-    octreeParser.setRelativeURL(relativeURL);
-    octreeParser.setEntitiesString(jsonBuffer);
-
-    QVariantMap asMap;
-    if (!octreeParser.parseEntities(asMap)) {
-        qCritical() << "Couldn't parse Entities JSON:" << octreeParser.getErrorString().c_str();
+    bool success = endReadingEntities();
+    if (!parsed) {
+        qCritical() << "Couldn't parse Entities JSON:" << entitiesParser.getErrorString().c_str();
         return false;
     }
+    return success;
+}
 
-    if (!marketplaceID.isEmpty()) {
-        addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
+bool Octree::readBinaryFromStream(QDataStream& inputStream) {
+    OctreeBinaryPersist::Header header;
+    if (!OctreeBinaryPersist::readHeader(inputStream, header)) {
+        qCritical() << "Couldn't read binary persist header";
+        return false;
     }
-
-    bool success = readFromMap(asMap, isImport);
-    delete[] rawData;
-    return success;
+    return readFromBinary(inputStream, header);
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
@@ -896,6 +1002,13 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "bin") {
+        success = writeToBinaryFile(cFileName);
+        if (!success) {
+            // readFromFile takes gzipped JSON from a .bin file too, that's better than not saving at all
+            qCWarning(octree) << "Failed to write binary persist file, saving as gzipped JSON instead";
+            success = writeToJSONFile(cFileName, element, true);
+        }
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -1001,6 +1114,43 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     return success;
 }
 
+bool Octree::writeToBinaryFile(const char* fileName) {
+    qCDebug(octree, "Saving binary SVO to file %s...", fileName);
+
+    QSaveFile persistFile(fileName);
+    if (!persistFile.open(QIODevice::WriteOnly)) {
+        qCritical("Failed to open binary file for writing.");
+        return false;
+    }
+
+    // the blocks are streamed to the file as they are done, so the whole tree is never held in memory
+    QDataStream out(&persistFile);
+    OctreeBinaryPersist::Header header;
+    header.id = _persistID;
+    header.dataVersion = _persistDataVersion;
+    header.version = expectedVersion();
+    OctreeBinaryPersist::writeHeader(out, header);
+
+    if (!writeToBinary(out)) {
+        qCritical("Failed to write octree to binary file.");
+        persistFile.cancelWriting();
+        return false;
+    }
+    OctreeBinaryPersist::writeEnd(out);
+
+    if (out.status() != QDataStream::Ok) {
+        qCritical("Failed to write to binary file.");
+        persistFile.cancelWriting();
+        return false;
+    }
+
+    bool success = persistFile.commit();
+    if (!success) {
+        qCritical() << "Failed to commit to binary save file:" << persistFile.errorString();
+    }
+    return success;
+}
+
 uint64_t Octree::getOctreeElementsCount() {
     uint64_t nodeCount = 0;
     recurseTreeWithOperation(countOctreeElementsOperation, &nodeCount);
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 #include <stdint.h>
 
 #include <QHash>
@@ -35,6 +36,7 @@ class Octree;
 class OctreeElement;
 class OctreePacketData;
 class Shape;
+namespace OctreeBinaryPersist { struct Header; }
 using OctreePointer = std::shared_ptr<Octree>;
 
 extern QVector<QString> PERSIST_EXTENSIONS;
@@ -47,6 +49,23 @@ public:
     virtual OctreeElementPointer possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) { return NULL; }
 };
 
+/// derive from this class to use the Octree::recurseTreeInParallel() method
+///
+/// The operator only reads the tree. Each subtree is recursed by a clone of the operator on a TBB thread, and the clones
+/// are merged back into the operator once they are all done, in the order of the subtrees.
+class ParallelRecurseOctreeOperator {
+public:
+    virtual ~ParallelRecurseOctreeOperator() = default;
+
+    /// return false to skip the children of the element
+    virtual bool visit(const OctreeElementPointer& element) = 0;
+
+    /// an operator with an empty result, for a subtree
+    virtual std::unique_ptr<ParallelRecurseOctreeOperator> clone() const = 0;
+    /// adds the result of a clone to this one's
+    virtual void merge(ParallelRecurseOctreeOperator& other) = 0;
+};
+
 // Callback function, for recuseTreeWithOperation
 using RecurseOctreeOperation = std::function<bool(const OctreeElementPointer&, void*)>;
 // Function for sorting octree children during recursion.  If return value == FLT_MAX, child is discarded
@@ -174,6 +193,10 @@ public:
 
     void recurseTreeWithOperator(RecurseOctreeOperator* operatorObject);
 
+    /// Visits the elements of the tree top down, the subtrees in parallel. The elements above the subtrees are visited
+    /// first, on the calling thread, which must hold the read lock of the tree until this returns.
+    void recurseTreeInParallel(ParallelRecurseOctreeOperator& operatorObject);
+
     bool isDirty() const { return _isDirty; }
     void clearDirtyBit() { _isDirty = false; }
     void setDirtyBit() { _isDirty = true; }
@@ -210,9 +233,12 @@ public:
     bool toJSON(QByteArray* data, const OctreeElementPointer& element = nullptr, bool doGzip = false);
     bool writeToFile(const char* filename, const OctreeElementPointer& element = nullptr, QString persistAsFileType = "json.gz");
     bool writeToJSONFile(const char* filename, const OctreeElementPointer& element = nullptr, bool doGzip = false);
+    bool writeToBinaryFile(const char* filename); // always the whole tree
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    // writes the blocks of the binary persist format, the header and end marker are taken care of by writeToBinaryFile
+    virtual bool writeToBinary(QDataStream& out) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -221,7 +247,20 @@ public:
     bool readFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="", const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="", const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromGzippedFile(QString qFileName);
+    bool readBinaryFromStream(QDataStream& inputStream);
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) = 0;
+    // The streamed JSON is read a batch of entities at a time, between beginReadingEntities, which gets the top-level
+    // values of the document, and endReadingEntities, which is false if the entities couldn't all be added.
+    virtual void beginReadingEntities(const QVariantMap& header, const bool isImport) = 0;
+    virtual void readEntitiesBatch(const QVariantList& entities) = 0;
+    virtual bool endReadingEntities() = 0;
+    virtual bool readFromBinary(QDataStream& in, const OctreeBinaryPersist::Header& header) { return false; }
+
+    // journal of the changes between two persists, see OctreePersistThread
+    virtual void setWantJournal(bool wantJournal) { }
+    // makes one compressed block of the changes since the last call, false if nothing changed
+    virtual bool takeJournalChanges(QByteArray& compressedBlock) { return false; }
+    virtual bool readJournalBlock(const QByteArray& compressedBlock, int64_t contentVersion) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -234,6 +273,9 @@ public:
 
     bool recurseElementWithOperator(const OctreeElementPointer& element, RecurseOctreeOperator* operatorObject, int recursionCount = 0);
 
+    void recurseElementInParallel(const OctreeElementPointer& element, ParallelRecurseOctreeOperator& operatorObject,
+                                  int recursionCount, std::vector<OctreeElementPointer>& subtrees);
+
     bool getIsViewing() const { return _isViewing; } /// This tree is receiving inbound viewer datagrams.
     void setIsViewing(bool isViewing) { _isViewing = isViewing; }
 
@@ -250,6 +292,8 @@ public:
         _persistID = id;
         _persistDataVersion = dataVersion;
     }
+    QUuid getPersistID() const { return _persistID; }
+    int getPersistDataVersion() const { return _persistDataVersion; }
 
     virtual void resetEditStats() { }
     virtual quint64 getAverageDecodeTime() const { return 0; }
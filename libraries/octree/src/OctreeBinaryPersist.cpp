@@ -0,0 +1,82 @@
+//
+//  OctreeBinaryPersist.cpp
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-16.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeBinaryPersist.h"
+
+#include "OctreeLogging.h"
+
+namespace {
+const quint8 END_TAG = 0;
+const quint8 BLOCK_TAG = 1;
+}
+
+bool OctreeBinaryPersist::hasMagic(const QByteArray& data) {
+    return data.startsWith(MAGIC);
+}
+
+bool OctreeBinaryPersist::hasMagic(QIODevice& device) {
+    return device.peek(MAGIC.size()) == MAGIC;
+}
+
+void OctreeBinaryPersist::writeHeader(QDataStream& out, const Header& header) {
+    out.setVersion(STREAM_VERSION);
+    out.writeRawData(MAGIC.constData(), MAGIC.size());
+    out << FORMAT_VERSION << header.id << (qint64)header.dataVersion << (qint64)header.version;
+}
+
+bool OctreeBinaryPersist::readHeader(QDataStream& in, Header& header) {
+    in.setVersion(STREAM_VERSION);
+
+    QByteArray magic(MAGIC.size(), 0);
+    if (in.readRawData(magic.data(), magic.size()) != MAGIC.size() || magic != MAGIC) {
+        return false;
+    }
+
+    quint32 formatVersion;
+    qint64 dataVersion;
+    qint64 version;
+    in >> formatVersion;
+    if (formatVersion != FORMAT_VERSION) {
+        qCWarning(octree) << "Unsupported binary octree format version" << formatVersion;
+        return false;
+    }
+    in >> header.id >> dataVersion >> version;
+    header.dataVersion = dataVersion;
+    header.version = version;
+    return in.status() == QDataStream::Ok;
+}
+
+void OctreeBinaryPersist::writeBlock(QDataStream& out, const QByteArray& compressedBlock) {
+    out << BLOCK_TAG << compressedBlock;
+}
+
+void OctreeBinaryPersist::writeEnd(QDataStream& out) {
+    out << END_TAG;
+}
+
+bool OctreeBinaryPersist::readBlock(QDataStream& in, QByteArray& compressedBlock, bool& isEnd) {
+    quint8 tag;
+    in >> tag;
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    isEnd = tag == END_TAG;
+    if (isEnd) {
+        return true;
+    }
+    if (tag != BLOCK_TAG) {
+        return false;
+    }
+
+    in >> compressedBlock;
+    return in.status() == QDataStream::Ok;
+}
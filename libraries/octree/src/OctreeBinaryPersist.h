@@ -0,0 +1,53 @@
+//
+//  OctreeBinaryPersist.h
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-16.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeBinaryPersist_h
+#define hifi_OctreeBinaryPersist_h
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QIODevice>
+#include <QUuid>
+
+#include "OctreeDataUtils.h"
+
+// Framing of the binary persist format, the "bin" persist file type.
+//
+// A binary persist file is the magic, a header with the same id and versions as the JSON format, then any number of
+// compressed blocks whose content is up to the tree, then an end marker. A file without its end marker was cut short
+// and doesn't load.
+namespace OctreeBinaryPersist {
+
+const QByteArray MAGIC { "VOCB" };
+const quint32 FORMAT_VERSION = 1;
+const QDataStream::Version STREAM_VERSION = QDataStream::Qt_5_9;
+
+struct Header {
+    QUuid id;
+    OctreeUtils::Version dataVersion { OctreeUtils::INITIAL_VERSION };
+    OctreeUtils::Version version { -1 }; // the data packet version the content was written with
+};
+
+bool hasMagic(const QByteArray& data);
+bool hasMagic(QIODevice& device);
+
+void writeHeader(QDataStream& out, const Header& header);
+bool readHeader(QDataStream& in, Header& header);
+
+void writeBlock(QDataStream& out, const QByteArray& compressedBlock);
+void writeEnd(QDataStream& out);
+
+// returns false on a damaged or truncated file, otherwise either a block or the end marker was read
+bool readBlock(QDataStream& in, QByteArray& compressedBlock, bool& isEnd);
+
+}
+
+#endif // hifi_OctreeBinaryPersist_h
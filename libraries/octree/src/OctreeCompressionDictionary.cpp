@@ -0,0 +1,117 @@
+//
+//  OctreeCompressionDictionary.cpp
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeCompressionDictionary.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+
+const int DMER_SIZE = 8;        // the byte strings counted, shorter ones are found by zlib within the section anyway
+const int SEGMENT_SIZE = 64;    // the pieces of samples the dictionary is made of
+const int SEGMENT_STEP = 16;
+
+using Frequencies = std::unordered_map<uint64_t, uint32_t>;
+
+uint64_t dmerAt(const char* data) {
+    uint64_t dmer;
+    memcpy(&dmer, data, sizeof(dmer));
+    return dmer;
+}
+
+uint32_t segmentScore(const QByteArray& sample, int start, const Frequencies& frequencies) {
+    uint32_t score = 0;
+    int end = std::min(sample.size(), start + SEGMENT_SIZE) - DMER_SIZE;
+    for (int i = start; i <= end; ++i) {
+        auto frequency = frequencies.find(dmerAt(sample.constData() + i));
+        if (frequency != frequencies.end()) {
+            score += frequency->second;
+        }
+    }
+    return score;
+}
+
+struct Segment {
+    uint32_t score;
+    int sample;
+    int start;
+
+    bool operator<(const Segment& other) const { return score < other.score; }
+};
+
+}
+
+static_assert(sizeof(uint64_t) == DMER_SIZE, "The dmers are read as 64 bit integers");
+
+QByteArray OctreeCompressionDictionary::train(const std::vector<QByteArray>& samples, int maxSize) {
+    // the strings seen once are of no use
+    Frequencies frequencies;
+    for (const auto& sample : samples) {
+        for (int i = 0; i + DMER_SIZE <= sample.size(); ++i) {
+            ++frequencies[dmerAt(sample.constData() + i)];
+        }
+    }
+    for (auto frequency = frequencies.begin(); frequency != frequencies.end();) {
+        if (frequency->second < 2) {
+            frequency = frequencies.erase(frequency);
+        } else {
+            ++frequency;
+        }
+    }
+
+    std::priority_queue<Segment> segments;
+    for (int sample = 0; sample < (int)samples.size(); ++sample) {
+        for (int start = 0; start + DMER_SIZE <= samples[sample].size(); start += SEGMENT_STEP) {
+            uint32_t score = segmentScore(samples[sample], start, frequencies);
+            if (score > 0) {
+                segments.push({ score, sample, start });
+            }
+        }
+    }
+
+    // lazy greedy: the scores only go down as the strings get covered, a segment whose updated score is still the best is
+    // the best one
+    std::vector<QByteArray> picked;
+    int size = 0;
+    while (!segments.empty() && size < maxSize) {
+        Segment segment = segments.top();
+        segments.pop();
+
+        const QByteArray& sample = samples[segment.sample];
+        uint32_t score = segmentScore(sample, segment.start, frequencies);
+        if (score == 0) {
+            continue;
+        }
+        if (!segments.empty() && score < segments.top().score) {
+            segment.score = score;
+            segments.push(segment);
+            continue;
+        }
+
+        int length = std::min({ SEGMENT_SIZE, sample.size() - segment.start, maxSize - size });
+        picked.push_back(sample.mid(segment.start, length));
+        size += length;
+        for (int i = segment.start; i + DMER_SIZE <= segment.start + length; ++i) {
+            frequencies.erase(dmerAt(sample.constData() + i));
+        }
+    }
+
+    QByteArray dictionary;
+    dictionary.reserve(size);
+    for (auto segment = picked.rbegin(); segment != picked.rend(); ++segment) {
+        dictionary.append(*segment);
+    }
+    return dictionary;
+}
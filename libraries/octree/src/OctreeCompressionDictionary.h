@@ -0,0 +1,33 @@
+//
+//  OctreeCompressionDictionary.h
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeCompressionDictionary_h
+#define hifi_OctreeCompressionDictionary_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+// A preset dictionary for the zlib compression of the octree packet sections, trained on sections of the domain.
+//
+// The sections are small and each is compressed on its own, so the compression mostly finds the repeats of the property
+// data within one section. The dictionary holds the byte strings found in many sections (the URLs, scripts, material
+// data, the encoding of common property values...), the sections compressed with it refer to them instead.
+namespace OctreeCompressionDictionary {
+    const int MAX_SIZE = 32 * 1024;             // the window of zlib, the dictionary is of no use past it
+    const int TRAINING_SIZE = 1024 * 1024;      // of samples, to train a dictionary on
+
+    // Picks the segments of the samples that have the most of the byte strings common to the samples, greedily, each
+    // string counting once. The best segments are at the end of the dictionary, where zlib refers to them most cheaply.
+    QByteArray train(const std::vector<QByteArray>& samples, int maxSize = MAX_SIZE);
+}
+
+#endif // hifi_OctreeCompressionDictionary_h
@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 
 #include "OctreeDataUtils.h"
+#include "OctreeBinaryPersist.h"
 #include "OctreeEntitiesFileParser.h"
 
 #include <Gzip.h>
@@ -30,6 +31,24 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromMap(const QVariantMap& ma
 }
 
 bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromData(QByteArray data) {
+    if (OctreeBinaryPersist::hasMagic(data)) {
+        if (!canReadBinary()) {
+            qCritical() << "Can't read entities from binary octree data";
+            return false;
+        }
+
+        QDataStream dataStream(data);
+        OctreeBinaryPersist::Header header;
+        if (!OctreeBinaryPersist::readHeader(dataStream, header)) {
+            qCritical() << "Can't read binary octree header";
+            return false;
+        }
+        id = header.id;
+        dataVersion = header.dataVersion;
+        version = header.version;
+        return true;
+    }
+
     QByteArray jsonData;
     if (gunzip(data, jsonData)) {
         data = jsonData;
@@ -38,7 +57,8 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromData(QByteArray data) {
     OctreeEntitiesFileParser jsonParser;
     jsonParser.setEntitiesString(data);
     QVariantMap entitiesMap;
-    if (!jsonParser.parseEntities(entitiesMap)) {
+    bool parsed = hasSubclassData() ? jsonParser.parseEntities(entitiesMap) : jsonParser.parseEntities(entitiesMap, nullptr);
+    if (!parsed) {
         qCritical() << "Can't parse Entities JSON: " << jsonParser.getErrorString().c_str();
         return false;
     }
@@ -33,6 +33,10 @@ public:
 
     virtual PacketType dataPacketType() const;
 
+    // the header of a binary persist file has everything but the subclass data
+    virtual bool canReadBinary() const { return true; }
+    // without subclass data, the entities of the JSON are skipped over rather than parsed
+    virtual bool hasSubclassData() const { return false; }
     virtual void readSubclassData(const QVariantMap& root) { }
     virtual void writeSubclassData(QByteArray& root) const { }
 
@@ -48,6 +52,8 @@ public:
 class RawEntityData : public RawOctreeData {
 public:
     PacketType dataPacketType() const override;
+    bool canReadBinary() const override { return false; }
+    bool hasSubclassData() const override { return true; }
     void readSubclassData(const QVariantMap& root) override;
     void writeSubclassData(QByteArray& root) const override;
 
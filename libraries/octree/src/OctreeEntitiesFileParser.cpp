@@ -22,10 +22,15 @@
 
 using std::string;
 
+// what's read from a device at a time, the contents read before are dropped once there's a chunk of them
+static const int READ_CHUNK_SIZE = 1024 * 1024;
+// enough for any integer
+static const int MAX_INTEGER_LENGTH = 32;
+
 std::string OctreeEntitiesFileParser::getErrorString() const {
     std::ostringstream err;
     if (_errorString.size() != 0) {
-        err << "Error: Line " << _line << ", byte position " << _position << ": " << _errorString;
+        err << "Error: Line " << _line << ", byte position " << getBytesRead() << ": " << _errorString;
     };
 
     return err.str();
@@ -34,11 +39,31 @@ std::string OctreeEntitiesFileParser::getErrorString() const {
 void OctreeEntitiesFileParser::setEntitiesString(const QByteArray& entitiesContents) {
     _entitiesContents = entitiesContents;
     _entitiesLength = _entitiesContents.length();
+    _device = nullptr;
+    _bufferOffset = 0;
     _position = 0;
     _line = 1;
+    _numEntities = 0;
+}
+
+void OctreeEntitiesFileParser::setEntitiesDevice(QIODevice* device) {
+    setEntitiesString(QByteArray());
+    _device = device;
 }
 
 bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
+    QVariantList entitiesValue;
+    bool success = parseEntities(parsedEntities, [&entitiesValue](QJsonObject& entity) {
+        entitiesValue.append(entity);
+        return true;
+    });
+    if (success) {
+        parsedEntities["Entities"] = std::move(entitiesValue);
+    }
+    return success;
+}
+
+bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities, const EntityFunction& entityFunction) {
     if (nextToken() != '{') {
         _errorString = "Text before start of object";
         return false;
@@ -86,12 +111,9 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
                 return false;
             }
 
-            QVariantList entitiesValue;
-            if (!readEntitiesArray(entitiesValue)) {
+            if (!readEntitiesArray(entityFunction)) {
                 return false;
             }
-
-            parsedEntities["Entities"] = std::move(entitiesValue);
             gotEntities = true;
         } else if (key == "Id") {
             if (gotId) {
@@ -173,8 +195,31 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
     return true;
 }
 
+bool OctreeEntitiesFileParser::readMore() {
+    if (!_device || _device->atEnd()) {
+        return false;
+    }
+    QByteArray chunk = _device->read(READ_CHUNK_SIZE);
+    if (chunk.isEmpty()) {
+        return false;
+    }
+    _entitiesContents += chunk;
+    _entitiesLength = _entitiesContents.length();
+    return true;
+}
+
+void OctreeEntitiesFileParser::discardRead() {
+    // nothing before the position is looked at again, it's dropped a chunk at a time so the copy stays cheap
+    if (_device && _position >= READ_CHUNK_SIZE) {
+        _entitiesContents.remove(0, _position);
+        _entitiesLength = _entitiesContents.length();
+        _bufferOffset += _position;
+        _position = 0;
+    }
+}
+
 int OctreeEntitiesFileParser::nextToken() {
-    while (_position < _entitiesLength) {
+    while (_position < _entitiesLength || readMore()) {
         char c = _entitiesContents[_position++];
         if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
             return c;
@@ -189,7 +234,7 @@ int OctreeEntitiesFileParser::nextToken() {
 
 string OctreeEntitiesFileParser::readString() {
     string returnString;
-    while (_position < _entitiesLength) {
+    while (_position < _entitiesLength || readMore()) {
         char c = _entitiesContents[_position++];
         if (c == '"') {
             break;
@@ -202,6 +247,8 @@ string OctreeEntitiesFileParser::readString() {
 }
 
 int OctreeEntitiesFileParser::readInteger() {
+    while (_entitiesLength - _position < MAX_INTEGER_LENGTH && readMore()) {
+    }
     const char* currentPosition = _entitiesContents.constData() + _position;
     int i = std::atoi(currentPosition);
 
@@ -214,13 +261,14 @@ int OctreeEntitiesFileParser::readInteger() {
     return i;
 }
 
-bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
+bool OctreeEntitiesFileParser::readEntitiesArray(const EntityFunction& entityFunction) {
     if (nextToken() != '[') {
         _errorString = "Entities entry is not an array";
         return false;
     }
 
     while (true) {
+        discardRead();
         if (nextToken() != '{') {
             _errorString = "Entity array item is not an object";
             return false;
@@ -230,119 +278,130 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             _errorString = "Unterminated entity object";
             return false;
         }
+        ++_numEntities;
 
-        QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
-        QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
-        if (entity.isNull()) {
-            _errorString = "Ill-formed entity";
+        if (entityFunction && !readEntity(matchingBrace, entityFunction)) {
             return false;
         }
+        _position = matchingBrace;
+        char c = nextToken();
+        if (c == ']') {
+            return true;
+        } else if (c != ',') {
+            _errorString = "Entity array item incorrectly terminated";
+            return false;
+        }
+    }
+    return true;
+}
 
-        QJsonObject entityObject = entity.object();
-
-        // resolve urls starting with ./ or ../ 
-        if (!_relativeURL.isEmpty()) {
-            bool isDirty = false;
-
-            const QStringList urlKeys { 
-                // model
-                "modelURL",
-                "animation.url",
-                "textures",
-                // image
-                "imageURL",
-                // web
-                "sourceUrl",
-                "scriptURL",
-                // zone
-                "ambientLight.ambientURL",
-                "skybox.url",
-                // particles
-                //"textures",  Already specified for model entity type.
-                // materials
-                "materialURL",
-                // ...shared
-                "href",
-                "script",
-                "serverScripts",
-                "collisionSoundURL",
-                "compoundShapeURL",
-                // TODO: deal with materialData and userData
-            };
-
-            for (const QString& key : urlKeys) {
-                if (key.contains('.')) {
-                    // url is inside another object
-                    const QStringList keyPair = key.split('.');
-                    const QString entityKey = keyPair[0];
-                    const QString childKey = keyPair[1];
-
-                    if (entityObject.contains(entityKey) && entityObject[entityKey].isObject()) {
-                        QJsonObject childObject = entityObject[entityKey].toObject();
-
-                        if (childObject.contains(childKey) && childObject[childKey].isString()) {
-                            const QString url = childObject[childKey].toString();
+bool OctreeEntitiesFileParser::readEntity(int matchingBrace, const EntityFunction& entityFunction) {
+    QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
+    QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
+    if (entity.isNull()) {
+        _errorString = "Ill-formed entity";
+        return false;
+    }
 
-                            if (url.startsWith("./") || url.startsWith("../")) {
-                                childObject[childKey] = _relativeURL.resolved(url).toString();
-                                entityObject[entityKey] = childObject;
-                                isDirty = true;
-                            }
+    QJsonObject entityObject = entity.object();
+
+    // resolve urls starting with ./ or ../ 
+    if (!_relativeURL.isEmpty()) {
+        bool isDirty = false;
+
+        const QStringList urlKeys { 
+            // model
+            "modelURL",
+            "animation.url",
+            "textures",
+            // image
+            "imageURL",
+            // web
+            "sourceUrl",
+            "scriptURL",
+            // zone
+            "ambientLight.ambientURL",
+            "skybox.url",
+            // particles
+            //"textures",  Already specified for model entity type.
+            // materials
+            "materialURL",
+            // ...shared
+            "href",
+            "script",
+            "serverScripts",
+            "collisionSoundURL",
+            "compoundShapeURL",
+            // TODO: deal with materialData and userData
+        };
+
+        for (const QString& key : urlKeys) {
+            if (key.contains('.')) {
+                // url is inside another object
+                const QStringList keyPair = key.split('.');
+                const QString entityKey = keyPair[0];
+                const QString childKey = keyPair[1];
+
+                if (entityObject.contains(entityKey) && entityObject[entityKey].isObject()) {
+                    QJsonObject childObject = entityObject[entityKey].toObject();
+
+                    if (childObject.contains(childKey) && childObject[childKey].isString()) {
+                        const QString url = childObject[childKey].toString();
+
+                        if (url.startsWith("./") || url.startsWith("../")) {
+                            childObject[childKey] = _relativeURL.resolved(url).toString();
+                            entityObject[entityKey] = childObject;
+                            isDirty = true;
                         }
                     }
-                } else {
-                    if (entityObject.contains(key) && entityObject[key].isString()) {
-                        const QString value = entityObject[key].toString();
-
-                        if (value.startsWith("./") || value.startsWith("../")) {
-                            // URL value.
-                            entityObject[key] = _relativeURL.resolved(value).toString();
-                            isDirty = true;
-                        } else if (value.startsWith("{")) {
-                            // Object with URL values.
-                            auto document = QJsonDocument::fromJson(value.toUtf8());
-                            if (!document.isNull()) {
-                                auto object = document.object();
-                                bool isObjectUpdated = false;
-                                for (const QString& key : object.keys()) {
-                                    auto value = object[key].toString();
-                                    if (value.startsWith("./") || value.startsWith("../")) {
-                                        object[key] = _relativeURL.resolved(value).toString();
-                                        isObjectUpdated = true;
-                                    }
-                                }
-                                if (isObjectUpdated) {
-                                    entityObject[key] = QString(QJsonDocument(object).toJson());
-                                    isDirty = true;
+                }
+            } else {
+                if (entityObject.contains(key) && entityObject[key].isString()) {
+                    const QString value = entityObject[key].toString();
+
+                    if (value.startsWith("./") || value.startsWith("../")) {
+                        // URL value.
+                        entityObject[key] = _relativeURL.resolved(value).toString();
+                        isDirty = true;
+                    } else if (value.startsWith("{")) {
+                        // Object with URL values.
+                        auto document = QJsonDocument::fromJson(value.toUtf8());
+                        if (!document.isNull()) {
+                            auto object = document.object();
+                            bool isObjectUpdated = false;
+                            for (const QString& key : object.keys()) {
+                                auto value = object[key].toString();
+                                if (value.startsWith("./") || value.startsWith("../")) {
+                                    object[key] = _relativeURL.resolved(value).toString();
+                                    isObjectUpdated = true;
                                 }
                             }
+                            if (isObjectUpdated) {
+                                entityObject[key] = QString(QJsonDocument(object).toJson());
+                                isDirty = true;
+                            }
                         }
                     }
                 }
             }
-
-            if (isDirty) {
-                entity.setObject(entityObject);
-            }
         }
 
-        entitiesArray.append(entityObject);
-        _position = matchingBrace;
-        char c = nextToken();
-        if (c == ']') {
-            return true;
-        } else if (c != ',') {
-            _errorString = "Entity array item incorrectly terminated";
-            return false;
+        if (isDirty) {
+            entity.setObject(entityObject);
         }
     }
+
+    if (!entityFunction(entityObject)) {
+        _errorString = "Entity not taken";
+        return false;
+    }
     return true;
 }
 
-int OctreeEntitiesFileParser::findMatchingBrace() const {
+int OctreeEntitiesFileParser::findMatchingBrace() {
     int index = _position;
     int nestCount = 1;
-    while (index < _entitiesLength && nestCount != 0) {
+    while ((index < _entitiesLength || readMore()) && nestCount != 0) {
         switch (_entitiesContents[index++]) {
         case '{':
             ++nestCount;
@@ -353,15 +412,14 @@ int OctreeEntitiesFileParser::findMatchingBrace() const {
             break;
 
         case '"':
-            // Skip string
-            while (index < _entitiesLength) {
-                if (_entitiesContents[index] == '"') {
-                    ++index;
+            // Skip string, and the character after each backslash
+            while (index < _entitiesLength || readMore()) {
+                char c = _entitiesContents[index++];
+                if (c == '"') {
                     break;
-                } else if (_entitiesContents[index] == '\\' && _entitiesContents[++index] == 'u') {
-                    index += 4;
+                } else if (c == '\\') {
+                    ++index;
                 }
-                ++index;
             }
             break;
 
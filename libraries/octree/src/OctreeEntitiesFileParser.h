@@ -14,29 +14,51 @@
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <functional>
+
 #include <QByteArray>
+#include <QIODevice>
+#include <QJsonObject>
 #include <QUrl>
 #include <QVariant>
 
 class OctreeEntitiesFileParser {
 public:
+    // Gets each entity as soon as it's parsed, returns false to stop the parsing.
+    using EntityFunction = std::function<bool(QJsonObject& entity)>;
+
     void setEntitiesString(const QByteArray& entitiesContents);
+    // The contents are read from the device as they're needed, from its current position. Only the entity being parsed
+    // is kept in memory.
+    void setEntitiesDevice(QIODevice* device);
     void setRelativeURL(const QUrl& relativeURL) { _relativeURL = relativeURL; }
     bool parseEntities(QVariantMap& parsedEntities);
+    // Parses the top-level values into parsedEntities but hands the entities to entityFunction rather than listing them.
+    // Without an entityFunction the entities are skipped over, and only checked for matching braces.
+    bool parseEntities(QVariantMap& parsedEntities, const EntityFunction& entityFunction);
     std::string getErrorString() const;
 
+    int64_t getBytesRead() const { return _bufferOffset + _position; }
+    int getNumEntities() const { return _numEntities; }
+
 private:
+    bool readMore();
+    void discardRead();
     int nextToken();
     std::string readString();
     int readInteger();
-    bool readEntitiesArray(QVariantList& entitiesArray);
-    int findMatchingBrace() const;
+    bool readEntitiesArray(const EntityFunction& entityFunction);
+    bool readEntity(int matchingBrace, const EntityFunction& entityFunction);
+    int findMatchingBrace();
 
     QByteArray _entitiesContents;
+    QIODevice* _device { nullptr };
     QUrl _relativeURL;
+    int64_t _bufferOffset { 0 };  // where the contents start in the device
     int _position { 0 };
     int _line { 1 };
     int _entitiesLength { 0 };
+    int _numEntities { 0 };
     std::string _errorString;
 };
 
@@ -12,7 +12,9 @@
 #include "OctreePacketData.h"
 
 #include <GLMHelpers.h>
+#include <Gzip.h>
 #include <PerfStat.h>
+#include <StringPool.h>
 
 #include "OctreeLogging.h"
 #include "NumericalConstants.h"
@@ -619,9 +621,14 @@ bool OctreePacketData::compressContent() {
     const uchar* uncompressedData = &_uncompressed[0];
     int uncompressedSize = _bytesInUse;
 
-    QByteArray compressedData = qCompress(uncompressedData, uncompressedSize, MAX_COMPRESSION);
+    QByteArray compressedData;
+    if (_compressionDictionary.isEmpty()) {
+        compressedData = qCompress(uncompressedData, uncompressedSize, MAX_COMPRESSION);
+    } else {
+        zlibCompress((const char*)uncompressedData, uncompressedSize, _compressionDictionary, compressedData, MAX_COMPRESSION);
+    }
 
-    if (compressedData.size() < _compressedByteArray.size()) {
+    if (!compressedData.isEmpty() && compressedData.size() < _compressedByteArray.size()) {
         _compressedBytes = compressedData.size();
         memcpy(_compressed, compressedData.constData(), _compressedBytes);
         _dirty = false;
@@ -647,7 +654,16 @@ void OctreePacketData::loadFinalizedContent(const unsigned char* data, int lengt
             compressedData.resize(_compressedBytes);
             memcpy(compressedData.data(), data, _compressedBytes);
 
-            QByteArray uncompressedData = qUncompress(compressedData);
+            QByteArray uncompressedData;
+            quint32 dictionaryID = zlibStreamDictionaryID(compressedData.constData(), compressedData.size());
+            if (dictionaryID == 0) {
+                uncompressedData = qUncompress(compressedData);
+            } else if (dictionaryID != zlibDictionaryID(_compressionDictionary) ||
+                       !zlibUncompress(compressedData.constData(), compressedData.size(), _compressionDictionary,
+                                       uncompressedData)) {
+                qCWarning(octree) << "OctreePacketData::loadFinalizedContent -- unable to uncompress with dictionary"
+                                  << dictionaryID;
+            }
             if (uncompressedData.size() > _bytesAvailable) {
                 int moreNeeded = uncompressedData.size() - _bytesAvailable;
                 _uncompressedByteArray.resize(_uncompressedByteArray.size() + moreNeeded);
@@ -669,6 +685,16 @@ void OctreePacketData::loadFinalizedContent(const unsigned char* data, int lengt
     }
 }
 
+void OctreePacketData::setCompressionDictionary(const QByteArray& dictionary) {
+    if (dictionary != _compressionDictionary) {
+        _compressionDictionary = dictionary;
+        // what was compressed with the previous one is compressed again
+        if (_enableCompression && _bytesInUse > 0) {
+            _dirty = true;
+        }
+    }
+}
+
 void OctreePacketData::debugContent() {
     qCDebug(octree, "OctreePacketData::debugContent()... COMPRESSED DATA.... size=%d",_compressedBytes);
     int perline=0;
@@ -721,8 +747,8 @@ int OctreePacketData::unpackDataFromBytes(const unsigned char* dataBytes, QStrin
     uint16_t length;
     memcpy(&length, dataBytes, sizeof(length));
     dataBytes += sizeof(length);
-    QString value = QString::fromUtf8((const char*)dataBytes, length);
-    result = value;
+    // the same URLs come for many entities, they share one string
+    result = StringPool::getInstance().intern(QString::fromUtf8((const char*)dataBytes, length));
     return sizeof(length) + length;
 }
 
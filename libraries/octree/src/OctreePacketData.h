@@ -241,6 +241,10 @@ public:
 
     /// load finalized content to allow access to decoded content for parsing
     void loadFinalizedContent(const unsigned char* data, int length);
+
+    /// the preset dictionary of the zlib compression, see OctreeCompressionDictionary. The content is compressed with
+    /// it, and is uncompressed with it when it was compressed with it, empty for none.
+    void setCompressionDictionary(const QByteArray& dictionary);
     
     /// returns whether or not zlib compression enabled on finalization
     bool isCompressed() const { return _enableCompression; }
@@ -317,6 +321,7 @@ private:
     QByteArray _compressedByteArray;
     unsigned char* _compressed { nullptr };
     int _compressedBytes;
+    QByteArray _compressionDictionary;
     int _bytesInUseLastCheck;
     bool _dirty;
 
@@ -27,12 +27,14 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QRegExp>
+#include <QSaveFile>
 
 #include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <PathUtils.h>
 #include <Gzip.h>
 
+#include "OctreeBinaryPersist.h"
 #include "OctreeLogging.h"
 #include "OctreeUtils.h"
 #include "OctreeDataUtils.h"
@@ -44,11 +46,14 @@ constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
-                                         bool debugTimestampNow, QString persistAsFileType) :
+                                         bool debugTimestampNow, QString persistAsFileType,
+                                         std::chrono::milliseconds journalInterval) :
     _tree(tree),
     _filename(filename),
     _persistInterval(persistInterval),
     _lastPersistCheck(std::chrono::steady_clock::now()),
+    _journalInterval(journalInterval),
+    _lastJournalCheck(std::chrono::steady_clock::now()),
     _initialLoadComplete(false),
     _loadTimeUSecs(0),
     _debugTimestampNow(debugTimestampNow),
@@ -58,6 +63,7 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+    _journalFilename = _filename + ".journal";
 }
 
 void OctreePersistThread::start() {
@@ -73,9 +79,38 @@ void OctreePersistThread::start() {
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree) << "Reading octree data from" << _filename;
-    QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
+    // after a change of persist file type the data is still in the file of the previous type
+    QString filename = findMostRecentFileExtension(_filename, PERSIST_EXTENSIONS);
+    qCDebug(octree) << "Reading octree data from" << filename;
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(octree) << "Couldn't access file" << filename << file.errorString();
+        packet->writePrimitive(false);
+    } else if (OctreeBinaryPersist::hasMagic(file)) {
+        // binary data is loaded straight from the mapped file, without a copy in memory
+        file.close();
+        _mappedFile.setFileName(filename);
+        if (_mappedFile.open(QIODevice::ReadOnly)) {
+            uchar* mappedData = _mappedFile.map(0, _mappedFile.size());
+            if (mappedData) {
+                _cachedJSONData = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData), _mappedFile.size());
+            } else {
+                _cachedJSONData = _mappedFile.readAll();
+                _mappedFile.close();
+            }
+        }
+
+        if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
+            qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
+            packet->writePrimitive(true);
+            packet->write(data.id.toRfc4122());
+            packet->writePrimitive(data.dataVersion);
+        } else {
+            clearCachedData();
+            qCWarning(octree) << "No octree data found";
+            packet->writePrimitive(false);
+        }
+    } else {
         QByteArray jsonData(file.readAll());
         file.close();
         if (!gunzip(jsonData, _cachedJSONData)) {
@@ -93,9 +128,6 @@ void OctreePersistThread::start() {
             qCWarning(octree) << "No octree data found";
             packet->writePrimitive(false);
         }
-    } else {
-        qCWarning(octree) << "Couldn't access file" << _filename << file.errorString();
-        packet->writePrimitive(false);
     }
 
     qCDebug(octree) << "Sending OctreeDataFileRequest to DS";
@@ -110,33 +142,45 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     bool includesNewData;
     message->readPrimitive(&includesNewData);
-    QByteArray replacementData;
     OctreeUtils::RawOctreeData data;
     bool hasValidOctreeData { false };
+    bool needsPersist { false };
     if (includesNewData) {
-        _cachedJSONData.clear();
-        replacementData = message->readAll();
-        replaceData(replacementData);
+        clearCachedData();
+        // streamed to the file straight from the packets of the message
+        replaceData(*message);
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
-        
-        OctreeUtils::RawEntityData data;
-        qCDebug(octree) << "Reading octree data from" << _filename;
-        if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
-            hasValidOctreeData = true;
-            if (data.id.isNull()) {
-                qCDebug(octree) << "Current octree data has a null id, updating";
-                data.resetIdAndVersion();
-
-                QFile file(_filename);
-                if (file.open(QIODevice::WriteOnly)) {
-                    auto entityData = data.toGzippedByteArray();
-                    file.write(entityData);
-                    file.close();
-                } else {
-                    qCDebug(octree) << "Failed to update octree data";
+
+        if (OctreeBinaryPersist::hasMagic(_cachedJSONData)) {
+            // the entities of a binary file aren't rewritten here, a new id is saved with them on the next persist
+            if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
+                hasValidOctreeData = true;
+                if (data.id.isNull()) {
+                    qCDebug(octree) << "Current octree data has a null id, updating on next persist";
+                    data.resetIdAndVersion();
+                    needsPersist = true;
+                }
+            }
+        } else {
+            OctreeUtils::RawEntityData data;
+            qCDebug(octree) << "Reading octree data from" << _filename;
+            if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
+                hasValidOctreeData = true;
+                if (data.id.isNull()) {
+                    qCDebug(octree) << "Current octree data has a null id, updating";
+                    data.resetIdAndVersion();
+
+                    QFile file(_filename);
+                    if (file.open(QIODevice::WriteOnly)) {
+                        auto entityData = data.toGzippedByteArray();
+                        file.write(entityData);
+                        file.close();
+                    } else {
+                        qCDebug(octree) << "Failed to update octree data";
+                    }
                 }
             }
         }
@@ -163,11 +207,23 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
         _tree->pruneTree();
     });
 
-    _cachedJSONData.clear();
+    clearCachedData();
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
 
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
+    if (needsPersist) {
+        _tree->setDirtyBit();
+    }
+
+    bool replayedJournal = false;
+    if (wantsJournal()) {
+        replayedJournal = replayJournal();
+        if (!replayedJournal) {
+            startJournal();
+        }
+        _tree->setWantJournal(true);
+    }
 
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
@@ -191,8 +247,13 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
+    _lastJournalCheck = _lastPersistCheck;
 
-    if (replacementData.isNull()) {
+    if (replayedJournal) {
+        // fold the replayed changes into a new snapshot, that lets the DS know about them too
+        _tree->setDirtyBit();
+        persist();
+    } else if (replacementData.isNull()) {
         sendLatestEntityDataToDS();
     }
 
@@ -202,21 +263,32 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 }
 
 
+void OctreePersistThread::clearCachedData() {
+    _cachedJSONData.clear();
+    _mappedFile.close(); // unmaps it too
+}
+
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || _persistAsFileType == "bin") {
+        // binary persist files are handed out as gzipped JSON, see getPersistFileContents
         return "application/zip";
     }
     return "";
 }
 
-void OctreePersistThread::replaceData(QByteArray data) {
+void OctreePersistThread::replaceData(ReceivedMessage& message) {
     backupCurrentFile();
 
+    // whatever the journal had was for the data being replaced
+    QFile::remove(_journalFilename);
+
     QFile currentFile { _filename };
     if (currentFile.open(QIODevice::WriteOnly)) {
-        currentFile.write(data);
+        message.readSegments(-1, [&currentFile](const char* data, qint64 size) {
+            currentFile.write(data, size);
+        });
         qDebug() << "Wrote replacement data";
     } else {
         qWarning() << "Failed to write replacement data";
@@ -252,6 +324,9 @@ void OctreePersistThread::process() {
     if (timeSinceLastPersist > _persistInterval) {
         _lastPersistCheck = now;
         persist();
+    } else if (wantsJournal() && now - _lastJournalCheck > _journalInterval) {
+        _lastJournalCheck = now;
+        writeJournal();
     }
 
     QTimer::singleShot(TIME_BETWEEN_PROCESSING.count(), this, &OctreePersistThread::process);
@@ -265,6 +340,11 @@ void OctreePersistThread::aboutToFinish() {
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+    if (_persistAsFileType == "bin") {
+        // JSON stays the format for export
+        _tree->toJSON(&fileContents, nullptr, true);
+        return fileContents;
+    }
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -304,6 +384,9 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
 
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
+        // the new snapshot has everything the journal has, the changes are only journaled if it can't be saved
+        QByteArray journalBlock;
+        bool hasJournalChanges = wantsJournal() && _tree->takeJournalChanges(journalBlock);
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
@@ -317,14 +400,105 @@ void OctreePersistThread::persist() {
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+            if (wantsJournal()) {
+                startJournal();
+            }
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
+            if (hasJournalChanges) {
+                appendToJournal(journalBlock);
+            }
         }
 
         sendLatestEntityDataToDS();
     }
 }
 
+void OctreePersistThread::startJournal() {
+    QSaveFile journalFile(_journalFilename);
+    if (!journalFile.open(QIODevice::WriteOnly)) {
+        qCWarning(octree) << "Failed to open journal" << _journalFilename << journalFile.errorString();
+        return;
+    }
+
+    // the header ties the journal to the persist file it follows
+    QDataStream out(&journalFile);
+    OctreeBinaryPersist::Header header;
+    header.id = _tree->getPersistID();
+    header.dataVersion = _tree->getPersistDataVersion();
+    header.version = _tree->expectedVersion();
+    OctreeBinaryPersist::writeHeader(out, header);
+
+    if (!journalFile.commit()) {
+        qCWarning(octree) << "Failed to commit journal" << _journalFilename << journalFile.errorString();
+    }
+}
+
+void OctreePersistThread::appendToJournal(const QByteArray& compressedBlock) {
+    QFile journalFile(_journalFilename);
+    if (!journalFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(octree) << "Failed to open journal" << _journalFilename << journalFile.errorString();
+        return;
+    }
+
+    QDataStream out(&journalFile);
+    out.setVersion(OctreeBinaryPersist::STREAM_VERSION);
+    OctreeBinaryPersist::writeBlock(out, compressedBlock);
+    if (out.status() != QDataStream::Ok || !journalFile.flush()) {
+        // the tree is still dirty, the next persist has these changes
+        qCWarning(octree) << "Failed to append to journal" << _journalFilename;
+    }
+}
+
+void OctreePersistThread::writeJournal() {
+    if (!_initialLoadComplete) {
+        return;
+    }
+
+    QByteArray journalBlock;
+    if (_tree->takeJournalChanges(journalBlock)) {
+        appendToJournal(journalBlock);
+    }
+}
+
+// Return true if the journal belonged to the loaded data and had changes for it.
+bool OctreePersistThread::replayJournal() {
+    QFile journalFile(_journalFilename);
+    if (!journalFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&journalFile);
+    OctreeBinaryPersist::Header header;
+    if (!OctreeBinaryPersist::readHeader(in, header)) {
+        qCWarning(octree) << "Couldn't read journal header, ignoring" << _journalFilename;
+        return false;
+    }
+    if (header.id != _tree->getPersistID() || header.dataVersion != _tree->getPersistDataVersion()) {
+        qCDebug(octree) << "Journal is for other octree data, ignoring" << header.id << header.dataVersion;
+        return false;
+    }
+
+    int numBlocks = 0;
+    _tree->withWriteLock([&] {
+        PerformanceWarning warn(true, "Replaying Octree Journal", true);
+
+        // a block cut short by a crash ends the replay, everything before it was saved whole
+        QByteArray compressedBlock;
+        bool isEnd = false;
+        while (OctreeBinaryPersist::readBlock(in, compressedBlock, isEnd) && !isEnd) {
+            if (!_tree->readJournalBlock(compressedBlock, header.version)) {
+                break;
+            }
+            ++numBlocks;
+        }
+        _tree->pruneTree();
+    });
+
+    qCDebug(octree) << "Replayed" << numBlocks << "journal blocks from" << _journalFilename;
+    return numBlocks > 0;
+}
+
 void OctreePersistThread::sendLatestEntityDataToDS() {
     qDebug() << "Sending latest entity data to DS";
     auto nodeList = DependencyManager::get<NodeList>();
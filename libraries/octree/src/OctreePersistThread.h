@@ -14,6 +14,7 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <QFile>
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
@@ -36,12 +37,14 @@ public:
                         const QString& filename,
                         std::chrono::milliseconds persistInterval = DEFAULT_PERSIST_INTERVAL,
                         bool debugTimestampNow = false,
-                        QString persistAsFileType = "json.gz");
+                        QString persistAsFileType = "json.gz",
+                        std::chrono::milliseconds journalInterval = std::chrono::milliseconds::zero());
 
     bool isInitialLoadComplete() const { return _initialLoadComplete; }
     quint64 getLoadElapsedTime() const { return _loadTimeUSecs; }
 
     QString getPersistFilename() const { return _filename; }
+    bool wantsJournal() const { return _journalInterval.count() > 0; }
     QString getPersistFileMimeType() const;
     QByteArray getPersistFileContents() const;
 
@@ -60,9 +63,16 @@ protected slots:
 protected:
     void persist();
     bool backupCurrentFile();
+
+    // the journal holds the changes since the last persist, so they can be saved much more often
+    void startJournal();
+    void appendToJournal(const QByteArray& compressedBlock);
+    void writeJournal();
+    bool replayJournal();
     void cleanupOldReplacementBackups();
 
-    void replaceData(QByteArray data);
+    void replaceData(ReceivedMessage& message);
+    void clearCachedData();
     void sendLatestEntityDataToDS();
 
 private:
@@ -70,6 +80,9 @@ private:
     QString _filename;
     std::chrono::milliseconds _persistInterval;
     std::chrono::steady_clock::time_point _lastPersistCheck;
+    QString _journalFilename;
+    std::chrono::milliseconds _journalInterval;
+    std::chrono::steady_clock::time_point _lastJournalCheck;
     bool _initialLoadComplete;
 
     quint64 _loadTimeUSecs;
@@ -78,7 +91,8 @@ private:
     quint64 _lastTimeDebug;
 
     QString _persistAsFileType;
-    QByteArray _cachedJSONData;
+    QByteArray _cachedJSONData; // or the binary data, then it's mapped from _mappedFile
+    QFile _mappedFile;
 };
 
 #endif // hifi_OctreePersistThread_h
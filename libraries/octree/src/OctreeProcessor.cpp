@@ -14,6 +14,7 @@
 
 #include <glm/glm.hpp>
 
+#include <Gzip.h>
 #include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <SharedUtil.h>
@@ -37,6 +38,24 @@ void OctreeProcessor::setTree(OctreePointer newTree) {
     _tree = newTree;
 }
 
+void OctreeProcessor::processCompressionDictionaryMessage(ReceivedMessage& message) {
+    quint32 dictionaryID;
+    message.readPrimitive(&dictionaryID);
+    QByteArray dictionary = message.readAll();
+    if (zlibDictionaryID(dictionary) != dictionaryID) {
+        qCWarning(octree) << "OctreeProcessor::processCompressionDictionaryMessage() the dictionary doesn't match its id"
+                          << dictionaryID;
+        return;
+    }
+    setCompressionDictionary(dictionary);
+}
+
+void OctreeProcessor::setCompressionDictionary(const QByteArray& dictionary) {
+    std::lock_guard<std::mutex> lock(_compressionDictionaryMutex);
+    _compressionDictionary = dictionary;
+    _compressionDictionaryID = zlibDictionaryID(dictionary);
+}
+
 void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointer sourceNode) {
     bool extraDebugging = false;
 
@@ -116,29 +135,33 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
                 // ask the VoxelTree to read the bitstream into the tree
                 ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
                                                sourceUUID, sourceNode);
-                quint64 startUncompress, startLock = usecTimestampNow();
+                quint64 startUncompress = usecTimestampNow();
+
+                // the section is uncompressed before taking the lock, only reading it into the tree needs it, so that
+                // the threads reading the tree meanwhile aren't stalled by the decompression
+                OctreePacketData packetData(packetIsCompressed);
+                if (packetIsCompressed && _compressionDictionaryID != 0) {
+                    std::lock_guard<std::mutex> lock(_compressionDictionaryMutex);
+                    packetData.setCompressionDictionary(_compressionDictionary);
+                }
+                packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
+                    sectionLength);
+                if (extraDebugging) {
+                    qCDebug(octree) << "OctreeProcessor::processDatagram() ... "
+                        "Got Packet Section color:" << packetIsColored <<
+                        "compressed:" << packetIsCompressed <<
+                        "sequence: " << sequence <<
+                        "flight: " << flightTime << " usec" <<
+                        "size:" << message.getSize() <<
+                        "data:" << message.getBytesLeftToRead() <<
+                        "subsection:" << subsection <<
+                        "sectionLength:" << sectionLength <<
+                        "uncompressed:" << packetData.getUncompressedSize();
+                }
+
+                quint64 startLock = usecTimestampNow();
                 quint64 startReadBitsteam, endReadBitsteam;
-                // FIXME STUTTER - there may be an opportunity to bump this lock outside of the
-                // loop to reduce the amount of locking/unlocking we're doing
                 _tree->withWriteLock([&] {
-                    startUncompress = usecTimestampNow();
-
-                    OctreePacketData packetData(packetIsCompressed);
-                    packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
-                        sectionLength);
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeProcessor::processDatagram() ... "
-                            "Got Packet Section color:" << packetIsColored <<
-                            "compressed:" << packetIsCompressed <<
-                            "sequence: " << sequence <<
-                            "flight: " << flightTime << " usec" <<
-                            "size:" << message.getSize() <<
-                            "data:" << message.getBytesLeftToRead() <<
-                            "subsection:" << subsection <<
-                            "sectionLength:" << sectionLength <<
-                            "uncompressed:" << packetData.getUncompressedSize();
-                    }
-
                     if (extraDebugging) {
                         qCDebug(octree) << "OctreeProcessor::processDatagram() ******* START _tree->readBitstreamToTree()...";
                     }
@@ -159,8 +182,8 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
                 _elementsInLastWindow += args.elementsPerPacket;
                 _entitiesInLastWindow += args.entitiesPerPacket;
 
-                totalWaitingForLock += (startUncompress - startLock);
-                totalUncompress += (startReadBitsteam - startUncompress);
+                totalWaitingForLock += (startReadBitsteam - startLock);
+                totalUncompress += (startLock - startUncompress);
                 totalReadBitsteam += (endReadBitsteam - startReadBitsteam);
 
             }
@@ -12,6 +12,8 @@
 #ifndef hifi_OctreeProcessor_h
 #define hifi_OctreeProcessor_h
 
+#include <atomic>
+#include <mutex>
 #include <glm/glm.hpp>
 #include <stdint.h>
 
@@ -59,6 +61,11 @@ public:
 
     OCTREE_PACKET_SEQUENCE getLastOctreeMessageSequence() const { return _lastOctreeMessageSequence; }
 
+    /// the dictionary the server compresses the sections with, once the queries tell it we have it
+    void processCompressionDictionaryMessage(ReceivedMessage& message);
+    void setCompressionDictionary(const QByteArray& dictionary);
+    quint32 getCompressionDictionaryID() const { return _compressionDictionaryID; }
+
 protected:
     virtual OctreePointer createTree() = 0;
 
@@ -82,6 +89,10 @@ protected:
     int _entitiesInLastWindow = 0;
     std::atomic<OCTREE_PACKET_SEQUENCE> _lastOctreeMessageSequence;
 
+    mutable std::mutex _compressionDictionaryMutex;
+    QByteArray _compressionDictionary;
+    std::atomic<quint32> _compressionDictionaryID { 0 };
+
 };
 
 #endif // hifi_OctreeProcessor_h
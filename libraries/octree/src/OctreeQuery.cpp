@@ -83,9 +83,13 @@ int OctreeQuery::getBroadcastData(unsigned char* destinationBuffer) {
 
     OctreeQueryFlags queryFlags { NoFlags };
     queryFlags |= (_reportInitialCompletion ? OctreeQuery::WantInitialCompletion : 0);
+    queryFlags |= (_wantCompressionDictionary ? OctreeQuery::WantCompressionDictionary : 0);
     memcpy(destinationBuffer, &queryFlags, sizeof(queryFlags));
     destinationBuffer += sizeof(queryFlags);
 
+    memcpy(destinationBuffer, &_compressionDictionaryID, sizeof(_compressionDictionaryID));
+    destinationBuffer += sizeof(_compressionDictionaryID);
+
     return destinationBuffer - bufferStart;
 }
 
@@ -165,6 +169,10 @@ int OctreeQuery::parseData(ReceivedMessage& message) {
     sourceBuffer += sizeof(queryFlags);
 
     _reportInitialCompletion = bool(queryFlags & OctreeQueryFlags::WantInitialCompletion);
+    _wantCompressionDictionary = bool(queryFlags & OctreeQueryFlags::WantCompressionDictionary);
+
+    memcpy(&_compressionDictionaryID, sourceBuffer, sizeof(_compressionDictionaryID));
+    sourceBuffer += sizeof(_compressionDictionaryID);
 
     return sourceBuffer - startPosition;
 }
@@ -56,6 +56,13 @@ public:
     bool wantReportInitialCompletion() const { return _reportInitialCompletion; }
     void setReportInitialCompletion(bool reportInitialCompletion) { _reportInitialCompletion = reportInitialCompletion; }
 
+    // Whether the sections can be compressed with a dictionary of the server, and the id of the one the client has (see
+    // zlibDictionaryID), 0 for none. The server sends its dictionary to the clients that want it and don't have it.
+    bool wantCompressionDictionary() const { return _wantCompressionDictionary; }
+    void setWantCompressionDictionary(bool wantCompressionDictionary) { _wantCompressionDictionary = wantCompressionDictionary; }
+    quint32 getCompressionDictionaryID() const { return _compressionDictionaryID; }
+    void setCompressionDictionaryID(quint32 compressionDictionaryID) { _compressionDictionaryID = compressionDictionaryID; }
+
 signals:
     void incomingConnectionIDChanged();
 
@@ -78,11 +85,13 @@ protected:
     QJsonObject _jsonParameters;
     QReadWriteLock _jsonParametersLock;
     
-    enum OctreeQueryFlags : uint16_t { NoFlags = 0x0, WantInitialCompletion = 0x1 };
+    enum OctreeQueryFlags : uint16_t { NoFlags = 0x0, WantInitialCompletion = 0x1, WantCompressionDictionary = 0x2 };
     friend OctreeQuery::OctreeQueryFlags operator|=(OctreeQuery::OctreeQueryFlags& lhs, const int rhs);
 
     bool _hasReceivedFirstQuery { false };
     bool _reportInitialCompletion { false };
+    bool _wantCompressionDictionary { false };
+    quint32 _compressionDictionaryID { 0 };
 };
 
 #endif // hifi_OctreeQuery_h
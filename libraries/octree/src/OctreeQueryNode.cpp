@@ -11,13 +11,22 @@
 
 #include "OctreeQueryNode.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 
+#include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <UUID.h>
 
+static const float MAX_SEND_BUDGET_LOSS_RATIO = 0.02f;
+static const int SEND_BUDGET_RTT_QUEUEING_FACTOR = 2;
+static const int SEND_BUDGET_RTT_SLACK_USECS = 20 * USECS_PER_MSEC;
+static const float MIN_SEND_BUDGET_SCALE = 0.1f;
+static const float SEND_BUDGET_DECREASE = 0.7f;
+static const float SEND_BUDGET_INCREASE = 0.05f;
+
 void OctreeQueryNode::nodeKilled() {
     _isShuttingDown = true;
 }
@@ -207,6 +216,7 @@ void OctreeQueryNode::setViewSent(bool viewSent) {
 void OctreeQueryNode::packetSent(const NLPacket& packet) {
     _sentPacketHistory.packetSent(_sequenceNumber, packet);
     _sequenceNumber++;
+    _numPacketsSentForBudget++;
 }
 
 bool OctreeQueryNode::hasNextNackedPacket() const {
@@ -228,7 +238,53 @@ void OctreeQueryNode::parseNackPacket(ReceivedMessage& message) {
         OCTREE_PACKET_SEQUENCE sequenceNumber;
         message.readPrimitive(&sequenceNumber);
         _nackedSequenceNumbers.enqueue(sequenceNumber);
+        _numPacketsNackedForBudget++;
+    }
+}
+
+void OctreeQueryNode::updateSendBudget(const udt::ConnectionStats::Stats& connectionStats) {
+    // the stats of the node are sampled about once per second, the budget follows each new sample
+    if (connectionStats.endTime == _lastBudgetSampleTime) {
+        return;
+    }
+    _lastBudgetSampleTime = connectionStats.endTime;
+
+    int numSent = _numPacketsSentForBudget.exchange(0);
+    int numNacked = _numPacketsNackedForBudget.exchange(0);
+    bool congested = numSent > 0 && (float)numNacked / (float)numSent > MAX_SEND_BUDGET_LOSS_RATIO;
+
+    // the round trip times and the congestion window are only measured while reliable packets are exchanged
+    if (connectionStats.rtt > 0 && connectionStats.minRTT > 0 &&
+        connectionStats.rtt > SEND_BUDGET_RTT_QUEUEING_FACTOR * connectionStats.minRTT + SEND_BUDGET_RTT_SLACK_USECS) {
+        congested = true;
+    }
+    if (connectionStats.congestionWindowSize > 0 && connectionStats.congestionWindowSize < _lastCongestionWindowSize / 2) {
+        congested = true;
+    }
+    if (connectionStats.congestionWindowSize > 0) {
+        _lastCongestionWindowSize = connectionStats.congestionWindowSize;
+    }
+    _estimatedBandwidth = connectionStats.estimatedBandwith;
+
+    // back off quickly and recover slowly, so that a lossy client doesn't keep its queues full
+    if (congested) {
+        _sendBudgetScale = std::max(MIN_SEND_BUDGET_SCALE, _sendBudgetScale * SEND_BUDGET_DECREASE);
+    } else {
+        _sendBudgetScale = std::min(1.0f, _sendBudgetScale + SEND_BUDGET_INCREASE);
+    }
+}
+
+int OctreeQueryNode::getSendBudgetPacketsPerSecond() const {
+    float packetsPerSecond = _sendBudgetScale * (float)getMaxQueryPacketsPerSecond();
+    if (_estimatedBandwidth > 0) {
+        packetsPerSecond = std::min(packetsPerSecond, (float)_estimatedBandwidth);
+    }
+    // what the client's link has room for besides its audio and avatars, in mostly full packets
+    float downstreamShareKbps = getDownstreamShareKbps();
+    if (downstreamShareKbps > 0.0f) {
+        packetsPerSecond = std::min(packetsPerSecond, downstreamShareKbps * BYTES_PER_KILOBIT / udt::MAX_PACKET_SIZE);
     }
+    return (int)packetsPerSecond;
 }
 
 bool OctreeQueryNode::haveJSONParametersChanged() {
@@ -12,10 +12,13 @@
 #ifndef hifi_OctreeQueryNode_h
 #define hifi_OctreeQueryNode_h
 
+#include <atomic>
 #include <iostream>
 
 #include <qqueue.h>
 
+#include <udt/ConnectionStats.h>
+
 #include "OctreeConstants.h"
 #include "OctreeElementBag.h"
 #include "OctreePacketData.h"
@@ -80,12 +83,25 @@ public:
     bool hasNextNackedPacket() const;
     const NLPacket* getNextNackedPacket();
 
+    // adapts the send budget to the latest sample of the stats of the connection to this client
+    void updateSendBudget(const udt::ConnectionStats::Stats& connectionStats);
+
+    // the packets per second the server should send to this client: its advertised query PPS, scaled down
+    // while the nacks or the round trip time show congestion and capped by the estimated bandwidth of the path and the
+    // share of the client's link the client reported for the entities
+    int getSendBudgetPacketsPerSecond() const;
+    float getSendBudgetScale() const { return _sendBudgetScale; }
+
     // call only from OctreeSendThread for the given node
     bool haveJSONParametersChanged();
 
     bool shouldForceFullScene() const { return _shouldForceFullScene; }
     void setShouldForceFullScene(bool shouldForceFullScene) { _shouldForceFullScene = shouldForceFullScene; }
 
+    // the compression dictionary sent to this client, it is used once the queries of the client show it has it
+    quint32 getSentCompressionDictionaryID() const { return _sentCompressionDictionaryID; }
+    void setSentCompressionDictionaryID(quint32 dictionaryID) { _sentCompressionDictionaryID = dictionaryID; }
+
 private:
     bool _viewSent { false };
     std::unique_ptr<NLPacket> _octreePacket;
@@ -106,6 +122,7 @@ private:
     bool _lodInitialized { false };
 
     OCTREE_PACKET_SEQUENCE _sequenceNumber { 0 };
+    quint32 _sentCompressionDictionaryID { 0 };
 
     PacketType _myPacketType { PacketType::Unknown };
     bool _isShuttingDown { false };
@@ -113,6 +130,14 @@ private:
     SentPacketHistory _sentPacketHistory;
     QQueue<OCTREE_PACKET_SEQUENCE> _nackedSequenceNumbers;
 
+    // packets sent and nacked since the last budget update, the nacks are parsed on the server thread
+    std::atomic<int> _numPacketsSentForBudget { 0 };
+    std::atomic<int> _numPacketsNackedForBudget { 0 };
+    std::chrono::microseconds _lastBudgetSampleTime { 0 };
+    float _sendBudgetScale { 1.0f };
+    int _estimatedBandwidth { 0 }; // packets per second, 0 when unknown
+    int _lastCongestionWindowSize { 0 };
+
     std::array<char, udt::MAX_PACKET_SIZE> _lastOctreePayload;
 
     QJsonObject _lastCheckJSONParameters;
@@ -65,6 +65,8 @@ void OctreeSceneStats::copyFromOther(const OctreeSceneStats& other) {
     _packets = other._packets;
     _bytes = other._bytes;
     _passes = other._passes;
+    _uncompressedBytes = other._uncompressedBytes;
+    _compressedBytes = other._compressedBytes;
 
     _totalElements = other._totalElements;
     _totalInternal = other._totalInternal;
@@ -164,6 +166,8 @@ void OctreeSceneStats::reset() {
     _packets = 0;
     _bytes = 0;
     _passes = 0;
+    _uncompressedBytes = 0;
+    _compressedBytes = 0;
 
     _totalElements = 0;
     _totalInternal = 0;
@@ -212,6 +216,11 @@ void OctreeSceneStats::packetSent(int bytes) {
     _bytes += bytes;
 }
 
+void OctreeSceneStats::sectionCompressed(int uncompressedBytes, int compressedBytes) {
+    _uncompressedBytes += uncompressedBytes;
+    _compressedBytes += compressedBytes;
+}
+
 void OctreeSceneStats::traversed(const OctreeElementPointer& element) {
     _traversed++;
     if (element->isLeaf()) {
@@ -312,6 +321,8 @@ int OctreeSceneStats::packIntoPacket() {
     _statsPacket->writePrimitive(_isMoving);
     _statsPacket->writePrimitive(_packets);
     _statsPacket->writePrimitive(_bytes);
+    _statsPacket->writePrimitive(_uncompressedBytes);
+    _statsPacket->writePrimitive(_compressedBytes);
 
     _statsPacket->writePrimitive(_totalInternal);
     _statsPacket->writePrimitive(_totalLeaves);
@@ -349,6 +360,8 @@ int OctreeSceneStats::unpackFromPacket(ReceivedMessage& packet) {
     packet.readPrimitive(&_isMoving);
     packet.readPrimitive(&_packets);
     packet.readPrimitive(&_bytes);
+    packet.readPrimitive(&_uncompressedBytes);
+    packet.readPrimitive(&_compressedBytes);
 
     if (_isFullScene) {
         _lastFullElapsed = _elapsed;
@@ -421,6 +434,8 @@ void OctreeSceneStats::printDebugDetails() {
     qCDebug(octree);
     qCDebug(octree) << "packets: " << _packets;
     qCDebug(octree) << "bytes: " << _bytes;
+    qCDebug(octree) << "uncompressed bytes: " << _uncompressedBytes;
+    qCDebug(octree) << "compressed bytes: " << _compressedBytes;
     qCDebug(octree);
     qCDebug(octree) << "total elements: " << _totalElements;
     qCDebug(octree) << "internal: " << _totalInternal;
@@ -460,6 +475,7 @@ OctreeSceneStats::ItemInfo OctreeSceneStats::_ITEMS[] = {
     { "Elapsed", GREENISH, 2, "Elapsed,fps" },
     { "Encode", YELLOWISH, 2, "Time,fps" },
     { "Network", GREYISH, 3, "Packets,Bytes,KBPS" },
+    { "Compression", YELLOWISH, 3, "Uncompressed,Compressed,Ratio" },
     { "Octrees on Server", GREENISH, 3, "Total,Internal,Leaves" },
     { "Octrees Sent", YELLOWISH, 5, "Total,Bits/Octree,Avg Bits/Octree,Internal,Leaves" },
     { "Colors Sent", GREYISH, 3, "Total,Internal,Leaves" },
@@ -498,6 +514,11 @@ const char* OctreeSceneStats::getItemValue(Item item) {
             sprintf(_itemValueBuffer, "%d packets %lu bytes (%d kbps)", _packets, (long unsigned int)_bytes, calculatedKBPS);
             break;
         }
+        case ITEM_COMPRESSION: {
+            sprintf(_itemValueBuffer, "%lu uncompressed %lu compressed (%.2f:1)", (long unsigned int)_uncompressedBytes,
+                    (long unsigned int)_compressedBytes, getCompressionRatio());
+            break;
+        }
         case ITEM_VOXELS_SERVER: {
             sprintf(_itemValueBuffer, "%lu total %lu internal %lu leaves",
                     (long unsigned int)_totalElements,
@@ -49,6 +49,9 @@ public:
     /// Track that a packet was sent as part of the scene.
     void packetSent(int bytes);
 
+    /// Track the size of a section of a packet before and after its compression.
+    void sectionCompressed(int uncompressedBytes, int compressedBytes);
+
     /// Tracks the beginning of an encode pass during scene calculation.
     void encodeStarted();
 
@@ -107,6 +110,7 @@ public:
         ITEM_ELAPSED,
         ITEM_ENCODE,
         ITEM_PACKETS,
+        ITEM_COMPRESSION,
         ITEM_VOXELS_SERVER,
         ITEM_VOXELS,
         ITEM_COLORS,
@@ -152,6 +156,10 @@ public:
     quint32 getLastFullTotalPackets() const { return _lastFullTotalPackets; }
     quint64 getLastFullTotalBytes() const { return _lastFullTotalBytes; }
 
+    quint64 getUncompressedBytes() const { return _uncompressedBytes; }
+    quint64 getCompressedBytes() const { return _compressedBytes; }
+    float getCompressionRatio() const { return _compressedBytes == 0 ? 1.0f : (float)_uncompressedBytes / (float)_compressedBytes; }
+
     // Used in client implementations to track individual octree packets
     void trackIncomingOctreePacket(ReceivedMessage& message, bool wasStatsPacket, qint64 nodeClockSkewUsec);
 
@@ -250,6 +258,10 @@ private:
     quint64 _bytes;
     quint32  _passes;
 
+    // of the sections of the packets
+    quint64 _uncompressedBytes;
+    quint64 _compressedBytes;
+
     // incoming packets stats
     quint32 _incomingPacket;
     quint64 _incomingBytes;
@@ -781,8 +781,39 @@ bool EntityMotionState::isLocallyOwnedOrShouldBe() const {
     }
 }
 
+void EntityMotionState::computeShapeInfo(const EntityItemPointer& entity, uint8_t region, ShapeInfo& shapeInfo) {
+    entity->computeShapeInfo(shapeInfo);
+    ShapeType type = shapeInfo.getType();
+    if (!isReducedDetailRegion(region) || !entity->getDynamic() ||
+            (type != SHAPE_TYPE_COMPOUND && type != SHAPE_TYPE_SIMPLE_COMPOUND) || shapeInfo.getNumSubShapes() < 2) {
+        return;
+    }
+
+    // the sub shapes share a frame, so one hull around all of their points bounds them all
+    ShapeInfo::PointCollection pointCollection(1);
+    for (const auto& points : shapeInfo.getPointCollection()) {
+        pointCollection[0] += points;
+    }
+    glm::vec3 halfExtents = shapeInfo.getHalfExtents();
+    glm::vec3 offset = shapeInfo.getOffset();
+    shapeInfo.clear();
+    shapeInfo.setParams(SHAPE_TYPE_SIMPLE_HULL, halfExtents);
+    shapeInfo.setPointCollection(pointCollection);
+    shapeInfo.setOffset(offset);
+}
+
 void EntityMotionState::setRegion(uint8_t region) {
+    bool wasReducedDetail = isReducedDetail();
     _region = region;
+    if (_body && _motionType == MOTION_TYPE_DYNAMIC && isReducedDetail() != wasReducedDetail) {
+        // the body is reinserted with the sleeping thresholds for its detail, and rebuilt if its shape depends on it
+        uint32_t flags = Simulation::DIRTY_MOTION_TYPE;
+        ShapeType type = _entity->getShapeType();
+        if (type == SHAPE_TYPE_COMPOUND || type == SHAPE_TYPE_SIMPLE_COMPOUND) {
+            flags |= Simulation::DIRTY_SHAPE;
+        }
+        _entity->markDirtyFlags(flags);
+    }
 }
 
 void EntityMotionState::initForBid() {
@@ -92,6 +92,13 @@ public:
 
     bool isLocallyOwned() const override;
     bool isLocallyOwnedOrShouldBe() const override; // aka shouldEmitCollisionEvents()
+    bool isReducedDetail() const override { return isReducedDetailRegion(_region); }
+
+    // Dynamic objects in R2 are simulated in less detail than those in R1: a compound shape collides as a single hull
+    // and the body goes to sleep at higher speeds.  R3 objects are not in physics but are extrapolated kinematically.
+    static bool isReducedDetailRegion(uint8_t region) { return region == workload::Region::R2; }
+    static void computeShapeInfo(const EntityItemPointer& entity, uint8_t region, ShapeInfo& shapeInfo);
+    void computeShapeInfo(ShapeInfo& shapeInfo) const { computeShapeInfo(_entity, _region, shapeInfo); }
 
     friend class PhysicalEntitySimulation;
     OwnershipState getOwnershipState() const { return _ownershipState; }
@@ -168,6 +168,7 @@ public:
 
     virtual bool isLocallyOwned() const { return false; }
     virtual bool isLocallyOwnedOrShouldBe() const { return false; } // aka shouldEmitCollisionEvents()
+    virtual bool isReducedDetail() const { return false; } // far enough away to be simulated in less detail
     virtual void saveKinematicState(btScalar timeStep);
 
     friend class PhysicsEngine;
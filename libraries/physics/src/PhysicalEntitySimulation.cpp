@@ -13,6 +13,7 @@
 #include "PhysicalEntitySimulation.h"
 
 #include <Profile.h>
+#include <TBBHelpers.h>
 
 #include "PhysicsHelpers.h"
 #include "PhysicsLogging.h"
@@ -290,7 +291,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                     // rebuild the ShapeInfo to verify hash because entity's desired shape may have changed
                     // TODO? is there a better way to do this?
                     ShapeInfo shapeInfo;
-                    entity->computeShapeInfo(shapeInfo);
+                    EntityMotionState::computeShapeInfo(entity, _space->getRegion(entity->getSpaceIndex()), shapeInfo);
 
                     if (shapeInfo.getType() == SHAPE_TYPE_NONE) {
                         requestItr = _shapeRequests.erase(requestItr);
@@ -298,7 +299,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                         // bummer, the hashes are different and we no longer want the shape we've received
                         ObjectMotionState::getShapeManager()->releaseShape(shape);
                         // try again
-                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo));
                         if (shape) {
                             buildMotionState(shape, entity);
                             requestItr = _shapeRequests.erase(requestItr);
@@ -370,9 +371,9 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
             if (requestItr == _shapeRequests.end()) {
                 // not waiting for a shape (yet)
                 ShapeInfo shapeInfo;
-                entity->computeShapeInfo(shapeInfo);
+                EntityMotionState::computeShapeInfo(entity, region, shapeInfo);
                 uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo));
                 if (shape) {
                     buildMotionState(shape, entity);
                 } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
@@ -428,14 +429,14 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
         bool needsNewShape = object->needsNewShape() && object->_entity->isReadyToComputeShape();
         if (needsNewShape) {
             ShapeType shapeType = object->getShapeType();
-            if (shapeType == SHAPE_TYPE_STATIC_MESH) {
+            if (ShapeFactory::isSlowToBuild(shapeType)) {
                 ShapeRequest shapeRequest(object->_entity);
                 ShapeRequests::iterator requestItr = _shapeRequests.find(shapeRequest);
                 if (requestItr == _shapeRequests.end()) {
                     ShapeInfo shapeInfo;
-                    object->_entity->computeShapeInfo(shapeInfo);
+                    object->computeShapeInfo(shapeInfo);
                     uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo));
                     if (shape) {
                         object->setShape(shape);
                         handledFlags |= Simulation::DIRTY_SHAPE;
@@ -453,7 +454,7 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
                 }
             } else {
                 ShapeInfo shapeInfo;
-                object->_entity->computeShapeInfo(shapeInfo);
+                object->computeShapeInfo(shapeInfo);
                 btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
                 if (shape) {
                     object->setShape(shape);
@@ -629,6 +630,12 @@ void PhysicalEntitySimulation::sendOwnedUpdates(uint32_t numSubsteps) {
         return;
     }
     PROFILE_RANGE_EX(simulation_physics, "Update", 0x00000000, (uint64_t)_owned.size());
+    const size_t MIN_PARALLEL_OWNED_UPDATES = 64;
+    if (_physicsEngine->isParallelSimulation() && _owned.size() >= MIN_PARALLEL_OWNED_UPDATES) {
+        sendOwnedUpdatesInParallel(numSubsteps);
+        return;
+    }
+
     uint32_t i = 0;
     while (i < _owned.size()) {
         if (!_owned[i]->isLocallyOwned()) {
@@ -647,6 +654,49 @@ void PhysicalEntitySimulation::sendOwnedUpdates(uint32_t numSubsteps) {
     }
 }
 
+// Deciding whether an owned entity needs an update only touches its own motion state, so that is done on the TBB
+// workers. Ownership changes and the updates themselves are handled here afterwards, in order.
+void PhysicalEntitySimulation::sendOwnedUpdatesInParallel(uint32_t numSubsteps) {
+    enum Decision : uint8_t {
+        NotOwned,
+        NoUpdate,
+        SendUpdate
+    };
+    const size_t PARALLEL_OWNED_UPDATES_GRAIN = 16;
+
+    std::vector<Decision> decisions(_owned.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _owned.size(), PARALLEL_OWNED_UPDATES_GRAIN),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                EntityMotionState* state = _owned[i];
+                if (!state->isLocallyOwned()) {
+                    decisions[i] = NotOwned;
+                } else {
+                    decisions[i] = state->shouldSendUpdate(numSubsteps) ? SendUpdate : NoUpdate;
+                }
+            }
+        });
+
+    VectorOfEntityMotionStates stillOwned;
+    stillOwned.reserve(_owned.size());
+    for (size_t i = 0; i < _owned.size(); ++i) {
+        EntityMotionState* state = _owned[i];
+        if (decisions[i] == NotOwned) {
+            if (state->shouldSendBid()) {
+                addOwnershipBid(state);
+            } else {
+                state->clearOwnershipState();
+            }
+        } else {
+            if (decisions[i] == SendUpdate) {
+                state->sendUpdate(_entityPacketSender, numSubsteps);
+            }
+            stillOwned.push_back(state);
+        }
+    }
+    _owned.swap(stillOwned);
+}
+
 void PhysicalEntitySimulation::handleCollisionEvents(const CollisionEvents& collisionEvents) {
     for (auto collision : collisionEvents) {
         // NOTE: The collision event is always aligned such that idA is never NULL.
@@ -98,6 +98,7 @@ public:
     void addOwnership(EntityMotionState* motionState);
     void sendOwnershipBids(uint32_t numSubsteps);
     void sendOwnedUpdates(uint32_t numSubsteps);
+    void sendOwnedUpdatesInParallel(uint32_t numSubsteps);
 
 private:
     void buildMotionStatesForEntitiesThatNeedThem();
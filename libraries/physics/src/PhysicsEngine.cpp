@@ -49,6 +49,7 @@ void PhysicsEngine::init() {
         _broadphaseFilter = new btDbvtBroadphase();
         _constraintSolver = new btSequentialImpulseConstraintSolver;
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        _dynamicsWorld->setParallelSync(_parallelSimulation);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -128,7 +129,12 @@ void PhysicsEngine::addObjectToDynamicsWorld(ObjectMotionState* motionState) {
 
             // NOTE: Bullet will deactivate any object whose velocity is below these thresholds for longer than 2 seconds.
             // (the 2 seconds is determined by: static btRigidBody::gDeactivationTime
-            body->setSleepingThresholds(DYNAMIC_LINEAR_SPEED_THRESHOLD, DYNAMIC_ANGULAR_SPEED_THRESHOLD);
+            // Objects simulated in less detail are allowed to settle sooner, since nobody is looking at them closely.
+            if (motionState->isReducedDetail()) {
+                body->setSleepingThresholds(REDUCED_DETAIL_LINEAR_SPEED_THRESHOLD, REDUCED_DETAIL_ANGULAR_SPEED_THRESHOLD);
+            } else {
+                body->setSleepingThresholds(DYNAMIC_LINEAR_SPEED_THRESHOLD, DYNAMIC_ANGULAR_SPEED_THRESHOLD);
+            }
             if (!motionState->isMoving()) {
                 // try to initialize this object as inactive
                 body->forceActivationState(ISLAND_SLEEPING);
@@ -302,6 +308,13 @@ void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
 }
 
 void PhysicsEngine::stepSimulation() {
+    const float MAX_TIMESTEP = (float)PHYSICS_ENGINE_MAX_NUM_SUBSTEPS * PHYSICS_ENGINE_FIXED_SUBSTEP;
+    float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
+    _clock.reset();
+    stepSimulation(btMin(dt, MAX_TIMESTEP));
+}
+
+void PhysicsEngine::stepSimulation(float timeStep) {
     CProfileManager::Reset();
     BT_PROFILE("stepSimulation");
     // NOTE: the grand order of operations is:
@@ -310,11 +323,6 @@ void PhysicsEngine::stepSimulation() {
     // (3) synchronize outgoing motion states
     // (4) send outgoing packets
 
-    const float MAX_TIMESTEP = (float)PHYSICS_ENGINE_MAX_NUM_SUBSTEPS * PHYSICS_ENGINE_FIXED_SUBSTEP;
-    float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
-    _clock.reset();
-    float timeStep = btMin(dt, MAX_TIMESTEP);
-
     auto onSubStep = [this]() {
         this->updateContactMap();
         this->doOwnershipInfectionForConstraints();
@@ -819,6 +827,13 @@ void PhysicsEngine::setShowBulletConstraintLimits(bool value) {
     }
 }
 
+void PhysicsEngine::setParallelSimulation(bool value) {
+    _parallelSimulation = value;
+    if (_dynamicsWorld) {
+        _dynamicsWorld->setParallelSync(value);
+    }
+}
+
 void PhysicsEngine::setContactAddedCallback(PhysicsEngine::ContactAddedCallback newCb) {
     // gContactAddedCallback is a special feature hook in Bullet
     // if non-null AND one of the colliding objects has btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK flag set
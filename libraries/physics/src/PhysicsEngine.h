@@ -109,6 +109,8 @@ public:
     void processTransaction(Transaction& transaction);
 
     void stepSimulation();
+    // steps by timeStep instead of by the time since the last step, for the simulations that don't run in real time
+    void stepSimulation(float timeStep);
     void harvestPerformanceStats();
     void printPerformanceStatsToFile(const QString& filename);
     void updateContactMap();
@@ -150,6 +152,10 @@ public:
     void setShowBulletConstraints(bool value);
     void setShowBulletConstraintLimits(bool value);
 
+    // opt-in: spreads the motion state synchronization and the owned entity update checks over the TBB workers
+    void setParallelSimulation(bool value);
+    bool isParallelSimulation() const { return _parallelSimulation; }
+
     // Function for getting colliding objects in the world of specified type
     // See PhysicsCollisionGroups.h for mask flags.
     std::vector<ContactTestResult> contactTest(uint16_t mask, const ShapeInfo& regionShapeInfo, const Transform& regionTransform, uint16_t group = USER_COLLISION_GROUP_DYNAMIC, float threshold = 0.0f) const;
@@ -193,6 +199,7 @@ private:
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
     bool _hasOutgoingChanges { false };
+    bool _parallelSimulation { false };
 
 };
 
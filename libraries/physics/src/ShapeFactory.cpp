@@ -11,23 +11,48 @@
 
 #include "ShapeFactory.h"
 
+#include <mutex>
+
 #include <glm/gtx/norm.hpp>
 
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <HashKey.h>
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "PhysicsLogging.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
 public:
     StaticMeshShape() = delete;
 
-    StaticMeshShape(btTriangleIndexVertexArray* dataArray)
-    :   btBvhTriangleMeshShape(dataArray, true), _dataArray(dataArray) {
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, bool buildBvh = true)
+    :   btBvhTriangleMeshShape(dataArray, true, buildBvh), _dataArray(dataArray) {
         assert(_dataArray);
     }
 
+    // the shape takes over the buffer the bvh was deserialized in
+    void setCachedBvh(btOptimizedBvh* bvh, void* bvhBuffer) {
+        setOptimizedBvh(bvh);
+        _bvhBuffer = bvhBuffer;
+    }
+
     ~StaticMeshShape() {
+        if (_bvhBuffer) {
+            // the bvh was constructed in place, the base class doesn't own it
+            m_bvh->~btOptimizedBvh();
+            btAlignedFree(_bvhBuffer);
+            m_bvh = nullptr;
+            _bvhBuffer = nullptr;
+        }
+
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
         for (int32_t i = 0; i < meshes.size(); ++i) {
@@ -47,6 +72,7 @@ public:
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    void* _bvhBuffer { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -270,6 +296,143 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
+// A cached mesh BVH is only used for a mesh with the same content, since the ShapeInfo's hash only covers the model's
+// url and scale, and the model behind a url can change.
+namespace {
+const QByteArray MESH_CACHE_MAGIC { "VBVH" };
+const quint32 MESH_CACHE_VERSION = 1;
+const QDataStream::Version MESH_CACHE_STREAM_VERSION = QDataStream::Qt_5_9;
+const int MAX_CACHED_MESHES = 256;
+
+std::mutex meshCacheMutex;
+bool meshCacheDirectorySet { false };
+QString meshCacheDirectory;
+std::once_flag meshCachePruneFlag;
+
+QString getMeshCacheDirectory() {
+    std::lock_guard<std::mutex> lock(meshCacheMutex);
+    if (!meshCacheDirectorySet) {
+        meshCacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/shapes";
+        meshCacheDirectorySet = true;
+    }
+    return meshCacheDirectory;
+}
+
+QString getMeshCachePath(uint64_t shapeHash) {
+    QString directory = getMeshCacheDirectory();
+    if (directory.isEmpty()) {
+        return QString();
+    }
+    return directory + "/" + QString::number(shapeHash, 16) + ".bvh";
+}
+
+// keeps the most recently written meshes, this runs once per session before the first write
+void pruneMeshCache(const QString& directory) {
+    QFileInfoList entries = QDir(directory).entryInfoList({ "*.bvh" }, QDir::Files, QDir::Time);
+    for (int i = MAX_CACHED_MESHES; i < entries.size(); ++i) {
+        QFile::remove(entries[i].absoluteFilePath());
+    }
+}
+
+uint64_t hashMeshContent(const ShapeInfo& info) {
+    HashKey::Hasher hasher;
+    for (const auto& pointList : info.getPointCollection()) {
+        for (const auto& point : pointList) {
+            hasher.hashVec3(point);
+        }
+    }
+    for (auto index : info.getTriangleIndices()) {
+        hasher.hashUint64((uint64_t)index);
+    }
+    return hasher.getHash64();
+}
+
+StaticMeshShape* loadCachedMeshShape(const QString& path, uint64_t contentHash, btTriangleIndexVertexArray* dataArray) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(MESH_CACHE_STREAM_VERSION);
+    QByteArray magic(MESH_CACHE_MAGIC.size(), 0);
+    in.readRawData(magic.data(), magic.size());
+    quint32 version;
+    qint32 bulletVersion;
+    quint64 cachedContentHash;
+    QByteArray bvhData;
+    in >> version >> bulletVersion >> cachedContentHash >> bvhData;
+    if (in.status() != QDataStream::Ok || magic != MESH_CACHE_MAGIC || version != MESH_CACHE_VERSION ||
+            bulletVersion != BT_BULLET_VERSION || cachedContentHash != contentHash) {
+        return nullptr;
+    }
+
+    // the bvh is constructed in the buffer, which has to stay around and be aligned for it
+    void* bvhBuffer = btAlignedAlloc(bvhData.size(), 16);
+    memcpy(bvhBuffer, bvhData.constData(), bvhData.size());
+    btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(bvhBuffer, (unsigned int)bvhData.size(), false);
+    if (!bvh) {
+        btAlignedFree(bvhBuffer);
+        return nullptr;
+    }
+
+    StaticMeshShape* shape = new StaticMeshShape(dataArray, false);
+    shape->setCachedBvh(bvh, bvhBuffer);
+    return shape;
+}
+
+void saveMeshShape(const QString& path, uint64_t contentHash, const StaticMeshShape* shape) {
+    const btOptimizedBvh* bvh = const_cast<StaticMeshShape*>(shape)->getOptimizedBvh();
+    if (!bvh) {
+        return;
+    }
+
+    QString directory = QFileInfo(path).absolutePath();
+    std::call_once(meshCachePruneFlag, pruneMeshCache, directory);
+    if (!QDir().mkpath(directory)) {
+        return;
+    }
+
+    unsigned int bvhSize = bvh->calculateSerializeBufferSize();
+    void* bvhBuffer = btAlignedAlloc(bvhSize, 16);
+    bool serialized = bvh->serializeInPlace(bvhBuffer, bvhSize, false);
+    QByteArray bvhData = serialized ? QByteArray((const char*)bvhBuffer, (int)bvhSize) : QByteArray();
+    btAlignedFree(bvhBuffer);
+    if (!serialized) {
+        return;
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(physics) << "Could not write mesh shape cache file" << path;
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(MESH_CACHE_STREAM_VERSION);
+    out.writeRawData(MESH_CACHE_MAGIC.constData(), MESH_CACHE_MAGIC.size());
+    out << MESH_CACHE_VERSION << (qint32)BT_BULLET_VERSION << (quint64)contentHash << bvhData;
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(physics) << "Could not write mesh shape cache file" << path;
+    }
+}
+}
+
+// building the bvh is the slow part of a static mesh, so it is read from the cache when possible
+StaticMeshShape* createStaticMeshShape(const ShapeInfo& info, btTriangleIndexVertexArray* dataArray) {
+    QString path = getMeshCachePath(info.getHash());
+    if (path.isEmpty()) {
+        return new StaticMeshShape(dataArray);
+    }
+
+    uint64_t contentHash = hashMeshContent(info);
+    StaticMeshShape* shape = loadCachedMeshShape(path, contentHash, dataArray);
+    if (!shape) {
+        shape = new StaticMeshShape(dataArray);
+        saveMeshShape(path, contentHash, shape);
+    }
+    return shape;
+}
+
 const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
@@ -426,7 +589,7 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         case SHAPE_TYPE_STATIC_MESH: {
             btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
             if (dataArray) {
-                shape = new StaticMeshShape(dataArray);
+                shape = createStaticMeshShape(info, dataArray);
             }
         }
         break;
@@ -483,6 +646,18 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     delete nonConstShape;
 }
 
+bool ShapeFactory::isSlowToBuild(ShapeType type) {
+    // hulls are reduced point by point, and a static mesh needs its whole bvh
+    return type == SHAPE_TYPE_COMPOUND || type == SHAPE_TYPE_SIMPLE_COMPOUND || type == SHAPE_TYPE_SIMPLE_HULL ||
+        type == SHAPE_TYPE_STATIC_MESH;
+}
+
+void ShapeFactory::setMeshCacheDirectory(const QString& path) {
+    std::lock_guard<std::mutex> lock(meshCacheMutex);
+    meshCacheDirectory = path;
+    meshCacheDirectorySet = true;
+}
+
 void ShapeFactory::Worker::run() {
     shape = ShapeFactory::createShapeFromInfo(shapeInfo);
     emit submitWork(this);
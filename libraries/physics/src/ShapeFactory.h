@@ -25,6 +25,13 @@ namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
+    // true for the shapes worth building on a Worker rather than when they are needed
+    bool isSlowToBuild(ShapeType type);
+
+    // Static mesh BVHs are kept in this directory between runs, keyed by the ShapeInfo's hash.
+    // Defaults to "shapes" in the application's cache location, an empty path turns the cache off.
+    void setMeshCacheDirectory(const QString& path);
+
     class Worker : public QObject, public QRunnable {
         Q_OBJECT
     public:
@@ -37,6 +37,14 @@ ShapeManager::~ShapeManager() {
 }
 
 const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
+    return findOrBuildShape(info, info.getType() == SHAPE_TYPE_STATIC_MESH);
+}
+
+const btCollisionShape* ShapeManager::requestShape(const ShapeInfo& info) {
+    return findOrBuildShape(info, ShapeFactory::isSlowToBuild(info.getType()));
+}
+
+const btCollisionShape* ShapeManager::findOrBuildShape(const ShapeInfo& info, bool buildOffThread) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
     }
@@ -47,17 +55,17 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         return shapeRef->shape;
     }
     const btCollisionShape* shape = nullptr;
-    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+    if (buildOffThread) {
         uint64_t hash = info.getHash();
 
         // bump the request count to the caller knows we're 
         // starting or waiting on a thread.
         ++_workRequestCount;
 
-        const auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), hash);
-        if (itr == _pendingMeshShapes.end()) {
+        const auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), hash);
+        if (itr == _pendingShapes.end()) {
             // start a worker
-            _pendingMeshShapes.push_back(hash);
+            _pendingShapes.push_back(hash);
             // try to recycle old deadWorker
             ShapeFactory::Worker* worker = _deadWorker;
             if (!worker) {
@@ -208,8 +216,8 @@ bool ShapeManager::hasShape(const btCollisionShape* shape) const {
 
 // slot: called when ShapeFactory::Worker is done building shape
 void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
-    auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), worker->shapeInfo.getHash());
-    if (itr == _pendingMeshShapes.end()) {
+    auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), worker->shapeInfo.getHash());
+    if (itr == _pendingShapes.end()) {
         // we've received a shape but don't remember asking for it
         // (should not fall in here, but if we do: delete the unwanted shape)
         if (worker->shape) {
@@ -217,8 +225,8 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
         }
     } else {
         // clear pending status
-        *itr = _pendingMeshShapes.back();
-        _pendingMeshShapes.pop_back();
+        *itr = _pendingShapes.back();
+        _pendingShapes.pop_back();
 
         // cache the new shape
         if (worker->shape) {
@@ -55,8 +55,12 @@ public:
     ShapeManager();
     ~ShapeManager();
 
-    /// \return pointer to shape
+    /// \return pointer to shape, or nullptr while a static mesh is built on a Worker
     const btCollisionShape* getShape(const ShapeInfo& info);
+
+    /// Like getShape() but every shape that is slow to build is built on a Worker, for callers that can add
+    /// their objects once the shape is ready (see getWorkRequestCount() and getWorkDeliveryCount()).
+    const btCollisionShape* requestShape(const ShapeInfo& info);
     const btCollisionShape* getShapeByKey(uint64_t key);
     bool hasShapeWithKey(uint64_t key) const;
 
@@ -78,6 +82,7 @@ protected slots:
     void acceptWork(ShapeFactory::Worker* worker);
 
 private:
+    const btCollisionShape* findOrBuildShape(const ShapeInfo& info, bool buildOffThread);
     void addToGarbage(uint64_t key);
     bool releaseShapeByKey(uint64_t key);
 
@@ -100,7 +105,7 @@ private:
     // btHashMap is required because it supports memory alignment of the btCollisionShapes
     btHashMap<HashKey, ShapeReference> _shapeMap;
     std::vector<uint64_t> _garbageRing;
-    std::vector<uint64_t> _pendingMeshShapes;
+    std::vector<uint64_t> _pendingShapes;
     std::vector<KeyExpiry> _orphans;
     ShapeFactory::Worker* _deadWorker { nullptr };
     TimePoint _nextOrphanExpiry;
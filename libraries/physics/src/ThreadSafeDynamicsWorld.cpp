@@ -19,8 +19,14 @@
 
 #include <LinearMath/btQuickprof.h>
 
+#include <TBBHelpers.h>
+
 #include "Profile.h"
 
+// fewer active bodies than this are synchronized on the calling thread even in parallel mode
+const size_t MIN_PARALLEL_SYNC_BODIES = 64;
+const size_t PARALLEL_SYNC_GRAIN = 32;
+
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
@@ -110,11 +116,41 @@ void ThreadSafeDynamicsWorld::synchronizeMotionState(btRigidBody* body) {
         return;
     }
     btTransform interpolatedTransform;
+    interpolateTransform(body, interpolatedTransform);
+    body->getMotionState()->setWorldTransform(interpolatedTransform);
+}
+
+void ThreadSafeDynamicsWorld::interpolateTransform(btRigidBody* body, btTransform& interpolatedTransform) const {
     btTransformUtil::integrateTransform(body->getInterpolationWorldTransform(),
         body->getInterpolationLinearVelocity(),body->getInterpolationAngularVelocity(),
         (m_latencyMotionStateInterpolation && m_fixedTimeStep) ? m_localTime - m_fixedTimeStep : m_localTime*body->getHitFraction(),
         interpolatedTransform);
-    body->getMotionState()->setWorldTransform(interpolatedTransform);
+}
+
+// Only the interpolation is done on the TBB workers: setting a motion state's transform updates its entity, which
+// notifies the entity's tree and children, so that still happens here one body at a time.
+void ThreadSafeDynamicsWorld::synchronizeMotionStatesInParallel() {
+    PROFILE_RANGE_EX(simulation_physics, "SyncMotionStatesParallel", 0x00000000, (uint64_t)_bodiesToSync.size());
+    size_t numBodies = _bodiesToSync.size();
+    _syncTransforms.resize((int)numBodies);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBodies, PARALLEL_SYNC_GRAIN), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            btRigidBody* body = _bodiesToSync[i];
+            if (!body->isKinematicObject()) {
+                interpolateTransform(body, _syncTransforms[(int)i]);
+            }
+        }
+    });
+
+    for (size_t i = 0; i < numBodies; ++i) {
+        btRigidBody* body = _bodiesToSync[i];
+        if (body->isKinematicObject()) {
+            synchronizeMotionState(body);
+        } else {
+            body->getMotionState()->setWorldTransform(_syncTransforms[(int)i]);
+        }
+    }
+    _bodiesToSync.clear();
 }
 
 void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
@@ -140,12 +176,17 @@ void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
         // that remembers a list of objects deactivated last step
         _activeStates.clear();
         _deactivatedStates.clear();
+        bool parallelSync = _parallelSync && (size_t)m_nonStaticRigidBodies.size() >= MIN_PARALLEL_SYNC_BODIES;
         for (int i=0;i<m_nonStaticRigidBodies.size();i++) {
             btRigidBody* body = m_nonStaticRigidBodies[i];
             ObjectMotionState* motionState = static_cast<ObjectMotionState*>(body->getMotionState());
             if (motionState) {
                 if (body->isActive()) {
-                    synchronizeMotionState(body);
+                    if (parallelSync) {
+                        _bodiesToSync.push_back(body);
+                    } else {
+                        synchronizeMotionState(body);
+                    }
                     _changedMotionStates.push_back(motionState);
                     _activeStates.insert(motionState);
                 } else if (_lastActiveStates.find(motionState) != _lastActiveStates.end()) {
@@ -154,6 +195,9 @@ void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
                 }
             }
         }
+        if (!_bodiesToSync.empty()) {
+            synchronizeMotionStatesInParallel();
+        }
     }
     _activeStates.swap(_lastActiveStates);
 }
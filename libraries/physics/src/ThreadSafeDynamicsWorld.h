@@ -24,6 +24,7 @@
 #include "ObjectMotionState.h"
 
 #include <functional>
+#include <vector>
 
 using SubStepCallback = std::function<void()>;
 
@@ -53,11 +54,18 @@ public:
     const VectorOfMotionStates& getDeactivatedMotionStates() const { return _deactivatedStates; }
 
     void addChangedMotionState(ObjectMotionState* motionState) { _changedMotionStates.push_back(motionState); }
+
+    // when set synchronizeMotionStates() interpolates the active bodies' transforms on the TBB workers
+    void setParallelSync(bool value) { _parallelSync = value; }
+    bool getParallelSync() const { return _parallelSync; }
+
     virtual void debugDrawObject(const btTransform& worldTransform, const btCollisionShape* shape, const btVector3& color) override;
 
 private:
     // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
     void synchronizeMotionState(btRigidBody* body);
+    void interpolateTransform(btRigidBody* body, btTransform& interpolatedTransform) const;
+    void synchronizeMotionStatesInParallel();
     void drawConnectedSpheres(btIDebugDraw* drawer, btScalar radius1, btScalar radius2, const btVector3& position1, 
                               const btVector3& position2, const btVector3& color);
 
@@ -65,7 +73,10 @@ private:
     VectorOfMotionStates _deactivatedStates;
     SetOfMotionStates _activeStates;
     SetOfMotionStates _lastActiveStates;
+    std::vector<btRigidBody*> _bodiesToSync;
+    btAlignedObjectArray<btTransform> _syncTransforms;
     int _numSubsteps { 0 };
+    bool _parallelSync { false };
 };
 
 #endif // hifi_ThreadSafeDynamicsWorld_h
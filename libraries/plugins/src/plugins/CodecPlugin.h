@@ -16,6 +16,12 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // Tuning for the encoders that can trade quality for bandwidth and CPU, the others ignore it.
+    // The bitrate is in bits per second, the complexity from 0 (cheapest) to 10.
+    virtual void setBitrate(int bitrate) {}
+    virtual void setComplexity(int complexity) {}
+    virtual void setExpectedPacketLossPercentage(int percentage) {}
 };
 
 class Decoder {
@@ -21,6 +21,7 @@
 #include <QtCore/QWaitCondition>
 
 #include <GLMHelpers.h>
+#include <LatencyHistogram.h>
 #include <NumericalConstants.h>
 #include <RegisteredMetaTypes.h>
 #include <shared/Bilateral.h>
@@ -189,6 +190,10 @@ public:
     virtual float newFramePresentRate() const { return -1.0f; }
     // Rate at which rendered frames are being skipped
     virtual float droppedFrameRate() const { return -1.0f; }
+    // Latencies from the start of the simulation of the new frames to their present, and intervals between the presents
+    // of new frames, in usecs, since the last reset. Returns false if the plugin doesn't track them
+    virtual bool getFramePacing(LatencyHistogram& latencies, LatencyHistogram& intervals) const { return false; }
+    virtual void resetFramePacing() {}
     virtual bool getSupportsAutoSwitch() { return false; }
 
     // Hardware specific stats
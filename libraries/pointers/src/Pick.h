@@ -11,6 +11,7 @@
 #include <memory>
 #include <stdint.h>
 #include <bitset>
+#include <vector>
 
 #include <QtCore/QUuid>
 #include <QVector>
@@ -228,6 +229,15 @@ public:
     virtual PickResultPointer getAvatarIntersection(const T& pick) = 0;
     virtual PickResultPointer getHUDIntersection(const T& pick) = 0;
 
+    // Called on one of the picks for the entity intersections of a batch of picks of its type, so that the types
+    // which can do better than one pick after the other compute them together
+    virtual void getEntityIntersections(const std::vector<Pick<T>*>& picks, const std::vector<T>& mathPicks,
+                                        std::vector<PickResultPointer>& results) {
+        for (size_t i = 0; i < picks.size(); i++) {
+            results[i] = picks[i]->getEntityIntersection(mathPicks[i]);
+        }
+    }
+
     QVariantMap toVariantMap() const override {
         QVariantMap properties = PickQuery::toVariantMap();
 
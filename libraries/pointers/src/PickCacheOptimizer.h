@@ -9,6 +9,8 @@
 #define hifi_PickCacheOptimizer_h
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "Pick.h"
 
@@ -45,6 +47,8 @@ protected:
     // Returns true if this pick exists in the cache, and if it does, update res if the cached result is closer
     bool checkAndCompareCachedResults(T& pick, PickCache& cache, PickResultPointer& res, const PickCacheKey& key);
     void cacheResult(const bool intersects, const PickResultPointer& resTemp, const PickCacheKey& key, PickResultPointer& res, T& mathPick, PickCache& cache, const std::shared_ptr<Pick<T>> pick);
+    void updatePick(const std::shared_ptr<Pick<T>>& pick, T& mathematicalPick, const PickResultPointer& batchedEntityRes,
+                    PickCache& results, bool shouldPickHUD, QVector3D& numIntersectionsComputed);
 };
 
 template<typename T>
@@ -66,6 +70,60 @@ void PickCacheOptimizer<T>::cacheResult(const bool needToCompareResults, const P
     }
 }
 
+template<typename T>
+void PickCacheOptimizer<T>::updatePick(const std::shared_ptr<Pick<T>>& pick, T& mathematicalPick, const PickResultPointer& batchedEntityRes,
+        PickCache& results, bool shouldPickHUD, QVector3D& numIntersectionsComputed) {
+    PickResultPointer res = pick->getDefaultResult(mathematicalPick.toVariantMap());
+
+    if (!pick->isEnabled() || pick->getMaxDistance() < 0.0f || !mathematicalPick) {
+        pick->setPickResult(res);
+        return;
+    }
+
+    if (pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities()) {
+        PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+        if (!checkAndCompareCachedResults(mathematicalPick, results, res, entityKey)) {
+            PickResultPointer entityRes = batchedEntityRes ? batchedEntityRes : pick->getEntityIntersection(mathematicalPick);
+            numIntersectionsComputed[0]++;
+            if (entityRes) {
+                cacheResult(entityRes->doesIntersect(), entityRes, entityKey, res, mathematicalPick, results, pick);
+            }
+        }
+    }
+
+    if (pick->getFilter().doesPickAvatars()) {
+        PickCacheKey avatarKey = { pick->getFilter().getAvatarFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+        if (!checkAndCompareCachedResults(mathematicalPick, results, res, avatarKey)) {
+            PickResultPointer avatarRes = pick->getAvatarIntersection(mathematicalPick);
+            numIntersectionsComputed[1]++;
+            if (avatarRes) {
+                cacheResult(avatarRes->doesIntersect(), avatarRes, avatarKey, res, mathematicalPick, results, pick);
+            }
+        }
+    }
+
+    // Can't intersect with HUD in desktop mode
+    if (pick->getFilter().doesPickHUD() && shouldPickHUD) {
+        PickCacheKey hudKey = { pick->getFilter().getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
+        if (!checkAndCompareCachedResults(mathematicalPick, results, res, hudKey)) {
+            PickResultPointer hudRes = pick->getHUDIntersection(mathematicalPick);
+            numIntersectionsComputed[2]++;
+            if (hudRes) {
+                cacheResult(true, hudRes, hudKey, res, mathematicalPick, results, pick);
+            }
+        }
+    }
+
+    if (pick->getMaxDistance() == 0.0f || (pick->getMaxDistance() > 0.0f && res->checkOrFilterAgainstMaxDistance(pick->getMaxDistance()))) {
+        pick->setPickResult(res);
+    } else {
+        pick->setPickResult(pick->getDefaultResult(mathematicalPick.toVariantMap()));
+    }
+}
+
+// The picks are updated in batches: the entity intersections of a batch are computed together first, for the pick types
+// which batch them, then the picks are updated one after the other until the time runs out. The picks that are the same
+// as an earlier one of the batch aren't batched, they get the cached result of that one.
 template<typename T>
 QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks,
         uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD) {
@@ -79,64 +137,71 @@ QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared
             itr = picks.begin();
         }
     }
-    uint32_t numUpdates = 0;
-    while(numUpdates < picks.size()) {
-        std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(itr->second);
-        T mathematicalPick = pick->getMathematicalPick();
-        PickResultPointer res = pick->getDefaultResult(mathematicalPick.toVariantMap());
-
-        if (!pick->isEnabled() || pick->getMaxDistance() < 0.0f || !mathematicalPick) {
-            pick->setPickResult(res);
-        } else {
-            if (pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities()) {
-                PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, entityKey)) {
-                    PickResultPointer entityRes = pick->getEntityIntersection(mathematicalPick);
-                    numIntersectionsComputed[0]++;
-                    if (entityRes) {
-                        cacheResult(entityRes->doesIntersect(), entityRes, entityKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
 
-            if (pick->getFilter().doesPickAvatars()) {
-                PickCacheKey avatarKey = { pick->getFilter().getAvatarFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, avatarKey)) {
-                    PickResultPointer avatarRes = pick->getAvatarIntersection(mathematicalPick);
-                    numIntersectionsComputed[1]++;
-                    if (avatarRes) {
-                        cacheResult(avatarRes->doesIntersect(), avatarRes, avatarKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
+    const size_t PICK_BATCH_SIZE = 32;
+    std::vector<std::shared_ptr<Pick<T>>> batch;
+    std::vector<T> batchMathPicks;
+    std::vector<int> batchEntityIndices;
+    std::vector<Pick<T>*> entityPicks;
+    std::vector<T> entityMathPicks;
+    std::vector<PickResultPointer> entityResults;
+    std::unordered_map<T, std::unordered_set<PickCacheKey>> batchedKeys;
 
-            // Can't intersect with HUD in desktop mode
-            if (pick->getFilter().doesPickHUD() && shouldPickHUD) {
-                PickCacheKey hudKey = { pick->getFilter().getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, hudKey)) {
-                    PickResultPointer hudRes = pick->getHUDIntersection(mathematicalPick);
-                    numIntersectionsComputed[2]++;
-                    if (hudRes) {
-                        cacheResult(true, hudRes, hudKey, res, mathematicalPick, results, pick);
-                    }
+    uint32_t numUpdates = 0;
+    bool outOfTime = false;
+    while (numUpdates < picks.size() && !outOfTime) {
+        batch.clear();
+        batchMathPicks.clear();
+        batchEntityIndices.clear();
+        entityPicks.clear();
+        entityMathPicks.clear();
+        batchedKeys.clear();
+
+        auto batchItr = itr;
+        for (size_t i = 0; i < PICK_BATCH_SIZE && numUpdates + i < picks.size(); i++) {
+            std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(batchItr->second);
+            T mathematicalPick = pick->getMathematicalPick();
+            int entityIndex = -1;
+            if (pick->isEnabled() && pick->getMaxDistance() >= 0.0f && mathematicalPick &&
+                (pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities())) {
+                PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+                bool isCached = results.find(mathematicalPick) != results.end() && results[mathematicalPick].find(entityKey) != results[mathematicalPick].end();
+                if (!isCached && batchedKeys[mathematicalPick].insert(entityKey).second) {
+                    entityIndex = (int)entityPicks.size();
+                    entityPicks.push_back(pick.get());
+                    entityMathPicks.push_back(mathematicalPick);
                 }
             }
+            batch.push_back(pick);
+            batchMathPicks.push_back(mathematicalPick);
+            batchEntityIndices.push_back(entityIndex);
 
-            if (pick->getMaxDistance() == 0.0f || (pick->getMaxDistance() > 0.0f && res->checkOrFilterAgainstMaxDistance(pick->getMaxDistance()))) {
-                pick->setPickResult(res);
-            } else {
-                pick->setPickResult(pick->getDefaultResult(mathematicalPick.toVariantMap()));
+            ++batchItr;
+            if (batchItr == picks.end()) {
+                batchItr = picks.begin();
             }
         }
 
-        ++itr;
-        if (itr == picks.end()) {
-            itr = picks.begin();
+        entityResults.assign(entityPicks.size(), PickResultPointer());
+        if (!entityPicks.empty()) {
+            entityPicks[0]->getEntityIntersections(entityPicks, entityMathPicks, entityResults);
         }
-        nextToUpdate = itr->first;
-        ++numUpdates;
-        if (usecTimestampNow() > expiry) {
-            break;
+
+        for (size_t i = 0; i < batch.size(); i++) {
+            int entityIndex = batchEntityIndices[i];
+            updatePick(batch[i], batchMathPicks[i], entityIndex >= 0 ? entityResults[entityIndex] : PickResultPointer(),
+                       results, shouldPickHUD, numIntersectionsComputed);
+
+            ++itr;
+            if (itr == picks.end()) {
+                itr = picks.begin();
+            }
+            nextToUpdate = itr->first;
+            ++numUpdates;
+            if (usecTimestampNow() > expiry) {
+                outOfTime = true;
+                break;
+            }
         }
     }
     return numIntersectionsComputed;
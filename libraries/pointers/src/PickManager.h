@@ -69,6 +69,7 @@ public:
 
     const std::vector<QVector3D>& getUpdatedPickCounts() { return _updatedPickCounts; }
     const std::vector<int>& getTotalPickCounts() { return _totalPickCounts; }
+    const std::vector<uint64_t>& getPickUpdateTimes() { return _pickUpdateTimes; } // usecs, of the most recent update
 
 public slots:
     void setForceCoarsePicking(bool forceCoarsePicking) { _forceCoarsePicking = forceCoarsePicking; }
@@ -76,6 +77,7 @@ public slots:
 protected:
     std::vector<QVector3D> _updatedPickCounts { PickQuery::NUM_PICK_TYPES };
     std::vector<int> _totalPickCounts { 0, 0, 0, 0 };
+    std::vector<uint64_t> _pickUpdateTimes { 0, 0, 0, 0 };
 
     bool _forceCoarsePicking { false };
     std::function<bool()> _shouldPickHUDOperator;
@@ -8,6 +8,7 @@
 
 #include "Procedural.h"
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QJsonArray>
@@ -144,13 +145,13 @@ void Procedural::setProceduralData(const ProceduralData& proceduralData) {
 
     if (proceduralData.version != _data.version) {
         _data.version = proceduralData.version;
-        _shaderDirty = true;
+        _shaderDirty = _programsDirty = true;
     }
 
     if (proceduralData.uniforms != _data.uniforms) {
         // If the uniform keys changed, we need to recreate the whole shader to handle the reflection
         if (proceduralData.uniforms.keys() != _data.uniforms.keys()) {
-            _shaderDirty = true;
+            _shaderDirty = _programsDirty = true;
         }
         _data.uniforms = proceduralData.uniforms;
         _uniformsDirty = true;
@@ -176,7 +177,7 @@ void Procedural::setProceduralData(const ProceduralData& proceduralData) {
     if (proceduralData.fragmentShaderUrl != _data.fragmentShaderUrl) {
         _data.fragmentShaderUrl = proceduralData.fragmentShaderUrl;
 
-        _shaderDirty = true;
+        _shaderDirty = _programsDirty = true;
         _networkFragmentShader.reset();
         _fragmentShaderPath.clear();
         _fragmentShaderSource.clear();
@@ -202,7 +203,7 @@ void Procedural::setProceduralData(const ProceduralData& proceduralData) {
     if (proceduralData.vertexShaderUrl != _data.vertexShaderUrl) {
         _data.vertexShaderUrl = proceduralData.vertexShaderUrl;
 
-        _shaderDirty = true;
+        _shaderDirty = _programsDirty = true;
         _networkVertexShader.reset();
         _vertexShaderPath.clear();
         _vertexShaderSource.clear();
@@ -260,6 +261,12 @@ bool Procedural::isReady() const {
         }
     }
 
+    // Is the program of the last key drawn compiled?  The other keys are compiled when first drawn
+    updateShaderSources();
+    if (getProgram(_prevKey)->getState() != ProceduralProgram::READY) {
+        return false;
+    }
+
     if (!_hasStartedFade) {
         _hasStartedFade = true;
         _isFading = true;
@@ -268,29 +275,19 @@ bool Procedural::isReady() const {
     return true;
 }
 
-void Procedural::prepare(gpu::Batch& batch,
-                         const glm::vec3& position,
-                         const glm::vec3& size,
-                         const glm::quat& orientation,
-                         const uint64_t& created,
-                         const ProceduralProgramKey key) {
-    std::lock_guard<std::mutex> lock(_mutex);
-    _entityDimensions = size;
-    _entityPosition = position;
-    _entityOrientation = glm::mat3_cast(orientation);
-    _entityCreated = created;
+void Procedural::updateShaderSources() const {
     if (!_fragmentShaderPath.isEmpty()) {
         auto lastModified = (uint64_t)QFileInfo(_fragmentShaderPath).lastModified().toMSecsSinceEpoch();
         if (lastModified > _fragmentShaderModified) {
             QFile file(_fragmentShaderPath);
             file.open(QIODevice::ReadOnly);
             _fragmentShaderSource = QTextStream(&file).readAll();
-            _shaderDirty = true;
+            _shaderDirty = _programsDirty = true;
             _fragmentShaderModified = lastModified;
         }
     } else if (_fragmentShaderSource.isEmpty() && _networkFragmentShader && _networkFragmentShader->isLoaded()) {
         _fragmentShaderSource = _networkFragmentShader->_source;
-        _shaderDirty = true;
+        _shaderDirty = _programsDirty = true;
     }
 
     if (!_vertexShaderPath.isEmpty()) {
@@ -299,94 +296,144 @@ void Procedural::prepare(gpu::Batch& batch,
             QFile file(_vertexShaderPath);
             file.open(QIODevice::ReadOnly);
             _vertexShaderSource = QTextStream(&file).readAll();
-            _shaderDirty = true;
+            _shaderDirty = _programsDirty = true;
             _vertexShaderModified = lastModified;
         }
     } else if (_vertexShaderSource.isEmpty() && _networkVertexShader && _networkVertexShader->isLoaded()) {
         _vertexShaderSource = _networkVertexShader->_source;
-        _shaderDirty = true;
+        _shaderDirty = _programsDirty = true;
     }
+}
 
-    if (_shaderDirty) {
-        _proceduralPipelines.clear();
+ProceduralProgramPointer Procedural::getProgram(const ProceduralProgramKey& key) const {
+    if (_programsDirty) {
+        // The pipelines of the previous programs are drawn with until the new ones are compiled
+        _proceduralPrograms.clear();
+        _programsDirty = false;
     }
 
-    auto pipeline = _proceduralPipelines.find(key);
-    bool recompiledShader = false;
-    if (pipeline == _proceduralPipelines.end()) {
-        gpu::Shader::Source vertexSource;
-        if (key.isSkinnedDQ()) {
-            vertexSource = _vertexSourceSkinnedDQ;
-        } else if (key.isSkinned()) {
-            vertexSource = _vertexSourceSkinned;
-        } else {
-            vertexSource = _vertexSource;
-        }
+    auto program = _proceduralPrograms.find(key);
+    if (program != _proceduralPrograms.end()) {
+        return program->second;
+    }
 
-        gpu::Shader::Source& fragmentSource = (key.isTransparent() && _transparentFragmentSource.valid()) ? _transparentFragmentSource : _opaqueFragmentSource;
+    gpu::Shader::Source vertexSource;
+    if (key.isSkinnedDQ()) {
+        vertexSource = _vertexSourceSkinnedDQ;
+    } else if (key.isSkinned()) {
+        vertexSource = _vertexSourceSkinned;
+    } else {
+        vertexSource = _vertexSource;
+    }
 
-        // Build the fragment and vertex shaders
-        auto versionDefine = "#define PROCEDURAL_V" + std::to_string(_data.version);
-        fragmentSource.replacements.clear();
-        fragmentSource.replacements[PROCEDURAL_VERSION] = versionDefine;
-        if (!_fragmentShaderSource.isEmpty()) {
-            fragmentSource.replacements[PROCEDURAL_BLOCK] = _fragmentShaderSource.toStdString();
-        }
-        vertexSource.replacements.clear();
-        vertexSource.replacements[PROCEDURAL_VERSION] = versionDefine;
-        if (!_vertexShaderSource.isEmpty()) {
-            vertexSource.replacements[PROCEDURAL_BLOCK] = _vertexShaderSource.toStdString();
-        }
+    gpu::Shader::Source fragmentSource;
+    fragmentSource = (key.isTransparent() && _transparentFragmentSource.valid()) ? _transparentFragmentSource : _opaqueFragmentSource;
+
+    // Build the fragment and vertex shaders
+    auto versionDefine = "#define PROCEDURAL_V" + std::to_string(_data.version);
+    fragmentSource.replacements.clear();
+    fragmentSource.replacements[PROCEDURAL_VERSION] = versionDefine;
+    if (!_fragmentShaderSource.isEmpty()) {
+        fragmentSource.replacements[PROCEDURAL_BLOCK] = _fragmentShaderSource.toStdString();
+    }
+    vertexSource.replacements.clear();
+    vertexSource.replacements[PROCEDURAL_VERSION] = versionDefine;
+    if (!_vertexShaderSource.isEmpty()) {
+        vertexSource.replacements[PROCEDURAL_BLOCK] = _vertexShaderSource.toStdString();
+    }
 
-        // Set any userdata specified uniforms (if any)
-        if (!_data.uniforms.empty()) {
-            // First grab all the possible dialect/variant/reflections
-            std::vector<shader::Reflection*> allFragmentReflections;
-            for (auto dialectIt = fragmentSource.dialectSources.begin(); dialectIt != fragmentSource.dialectSources.end(); ++dialectIt) {
-                for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
-                    allFragmentReflections.push_back(&(*variantIt).second.reflection);
-                }
+    // Set any userdata specified uniforms (if any)
+    if (!_data.uniforms.empty()) {
+        // First grab all the possible dialect/variant/reflections
+        std::vector<shader::Reflection*> allFragmentReflections;
+        for (auto dialectIt = fragmentSource.dialectSources.begin(); dialectIt != fragmentSource.dialectSources.end(); ++dialectIt) {
+            for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
+                allFragmentReflections.push_back(&(*variantIt).second.reflection);
             }
-            std::vector<shader::Reflection*> allVertexReflections;
-            for (auto dialectIt = vertexSource.dialectSources.begin(); dialectIt != vertexSource.dialectSources.end(); ++dialectIt) {
-                for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
-                    allVertexReflections.push_back(&(*variantIt).second.reflection);
-                }
+        }
+        std::vector<shader::Reflection*> allVertexReflections;
+        for (auto dialectIt = vertexSource.dialectSources.begin(); dialectIt != vertexSource.dialectSources.end(); ++dialectIt) {
+            for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
+                allVertexReflections.push_back(&(*variantIt).second.reflection);
+            }
+        }
+        // Then fill in every reflections the new custom bindings
+        int customSlot = procedural::slot::uniform::Custom;
+        for (const auto& key : _data.uniforms.keys()) {
+            std::string uniformName = key.toLocal8Bit().data();
+            for (auto reflection : allFragmentReflections) {
+                reflection->uniforms[uniformName] = customSlot;
             }
-            // Then fill in every reflections the new custom bindings
-            int customSlot = procedural::slot::uniform::Custom;
-            for (const auto& key : _data.uniforms.keys()) {
-                std::string uniformName = key.toLocal8Bit().data();
-                for (auto reflection : allFragmentReflections) {
-                    reflection->uniforms[uniformName] = customSlot;
-                }
-                for (auto reflection : allVertexReflections) {
-                    reflection->uniforms[uniformName] = customSlot;
-                }
-                ++customSlot;
+            for (auto reflection : allVertexReflections) {
+                reflection->uniforms[uniformName] = customSlot;
             }
+            ++customSlot;
         }
+    }
 
-        // Leave this here for debugging
-        //qCDebug(proceduralLog) << "FragmentShader:\n" << fragmentSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
-        //qCDebug(proceduralLog) << "VertexShader:\n" << vertexSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
+    // Leave this here for debugging
+    //qCDebug(proceduralLog) << "FragmentShader:\n" << fragmentSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
+    //qCDebug(proceduralLog) << "VertexShader:\n" << vertexSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
 
+    auto createProgram = [&] {
         gpu::ShaderPointer vertexShader = gpu::Shader::createVertex(vertexSource);
         gpu::ShaderPointer fragmentShader = gpu::Shader::createPixel(fragmentSource);
-        gpu::ShaderPointer program = gpu::Shader::createProgram(vertexShader, fragmentShader);
+        return gpu::Shader::createProgram(vertexShader, fragmentShader);
+    };
+    QString name = _data.fragmentShaderUrl.isEmpty() ? _data.vertexShaderUrl.toString() : _data.fragmentShaderUrl.toString();
+
+    ProceduralProgramPointer result;
+    auto materialCache = DependencyManager::get<MaterialCache>();
+    if (materialCache) {
+        // The same base shaders, with the same blocks and uniforms, build the same program
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(QByteArray::number(vertexSource.id) + ":" + QByteArray::number(fragmentSource.id) + ":");
+        hash.addData(QByteArray::fromStdString(versionDefine));
+        hash.addData(_data.uniforms.keys().join(",").toUtf8());
+        hash.addData(_vertexShaderSource.toUtf8() + "\n" + _fragmentShaderSource.toUtf8());
+        result = materialCache->getProceduralProgram(hash.result().toHex().toStdString(), createProgram, name);
+    } else {
+        result = ProceduralProgram::compile(createProgram(), name);
+    }
+    _proceduralPrograms[key] = result;
+    return result;
+}
+
+bool Procedural::prepare(gpu::Batch& batch,
+                         const glm::vec3& position,
+                         const glm::vec3& size,
+                         const glm::quat& orientation,
+                         const uint64_t& created,
+                         const ProceduralProgramKey key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entityDimensions = size;
+    _entityPosition = position;
+    _entityOrientation = glm::mat3_cast(orientation);
+    _entityCreated = created;
 
-        _proceduralPipelines[key] = gpu::Pipeline::create(program, key.isTransparent() ? _transparentState : _opaqueState);
+    updateShaderSources();
+    auto program = getProgram(key);
 
-        _lastCompile = usecTimestampNow();
-        if (_firstCompile == 0) {
-            _firstCompile = _lastCompile;
+    auto pipeline = _proceduralPipelines.find(key);
+    bool recompiledShader = false;
+    if (program->getState() == ProceduralProgram::READY) {
+        if (pipeline == _proceduralPipelines.end() || pipeline->second->getProgram() != program->getProgram()) {
+            _proceduralPipelines[key] = gpu::Pipeline::create(program->getProgram(), key.isTransparent() ? _transparentState : _opaqueState);
+
+            _lastCompile = usecTimestampNow();
+            if (_firstCompile == 0) {
+                _firstCompile = _lastCompile;
+            }
+            _frameCount = 0;
+            recompiledShader = true;
         }
-        _frameCount = 0;
-        recompiledShader = true;
+    } else if (pipeline == _proceduralPipelines.end()) {
+        // Nothing to draw this key with until its program is compiled
+        return false;
     }
 
     // FIXME: need to handle forward rendering
-    batch.setPipeline(recompiledShader ? _proceduralPipelines[key] : pipeline->second);
+    batch.setPipeline(_proceduralPipelines[key]);
 
     bool recreateUniforms = _shaderDirty || _uniformsDirty || recompiledShader || _prevKey != key;
     if (recreateUniforms) {
@@ -416,6 +463,7 @@ void Procedural::prepare(gpu::Batch& batch,
             batch.setResourceTexture((gpu::uint32)(procedural::slot::texture::Channel0 + i), gpuTexture);
         }
     }
+    return true;
 }
 
 
@@ -102,9 +102,12 @@ public:
     Procedural();
     void setProceduralData(const ProceduralData& proceduralData);
 
+    // Not ready until the shaders and textures are loaded and the program is compiled, the owner draws its fallback
+    // material meanwhile
     bool isReady() const;
     bool isEnabled() const { return _enabled; }
-    void prepare(gpu::Batch& batch, const glm::vec3& position, const glm::vec3& size, const glm::quat& orientation,
+    // Returns false, with nothing set, while the program of that key compiles and there is no previous one to draw with
+    bool prepare(gpu::Batch& batch, const glm::vec3& position, const glm::vec3& size, const glm::quat& orientation,
                  const uint64_t& created, const ProceduralProgramKey key = ProceduralProgramKey());
 
     glm::vec4 getColor(const glm::vec4& entityColor) const;
@@ -164,22 +167,25 @@ protected:
     uint64_t _firstCompile { 0 };
     int32_t _frameCount { 0 };
 
-    // Rendering object descriptions
-    QString _vertexShaderSource;
+    // Rendering object descriptions, the sources are read by isReady as well
+    mutable QString _vertexShaderSource;
     QString _vertexShaderPath;
-    uint64_t _vertexShaderModified { 0 };
+    mutable uint64_t _vertexShaderModified { 0 };
     NetworkShaderPointer _networkVertexShader;
-    QString _fragmentShaderSource;
+    mutable QString _fragmentShaderSource;
     QString _fragmentShaderPath;
-    uint64_t _fragmentShaderModified { 0 };
+    mutable uint64_t _fragmentShaderModified { 0 };
     NetworkShaderPointer _networkFragmentShader;
-    bool _shaderDirty { true };
+    mutable bool _shaderDirty { true };
+    mutable bool _programsDirty { true };
     bool _uniformsDirty { true };
 
     // Rendering objects
     UniformLambdas _uniforms;
     NetworkTexturePointer _channels[MAX_PROCEDURAL_TEXTURE_CHANNELS];
 
+    // The programs of the current sources, which may still compile, and the pipelines of the last compiled ones
+    mutable std::unordered_map<ProceduralProgramKey, ProceduralProgramPointer> _proceduralPrograms;
     std::unordered_map<ProceduralProgramKey, gpu::PipelinePointer> _proceduralPipelines;
 
     StandardInputs _standardInputs;
@@ -193,6 +199,8 @@ protected:
 
 private:
     void setupUniforms();
+    void updateShaderSources() const;
+    ProceduralProgramPointer getProgram(const ProceduralProgramKey& key) const;
 
     mutable uint64_t _fadeStartTime { 0 };
     mutable bool _hasStartedFade { false };
@@ -226,9 +234,9 @@ public:
     void setIsFading(bool isFading) { _procedural.setIsFading(isFading); }
     uint64_t getFadeStartTime() const { return _procedural.getFadeStartTime(); }
     bool hasVertexShader() const { return _procedural.hasVertexShader(); }
-    void prepare(gpu::Batch& batch, const glm::vec3& position, const glm::vec3& size, const glm::quat& orientation,
+    bool prepare(gpu::Batch& batch, const glm::vec3& position, const glm::vec3& size, const glm::quat& orientation,
                  const uint64_t& created, const ProceduralProgramKey key = ProceduralProgramKey()) {
-        _procedural.prepare(batch, position, size, orientation, created, key);
+        return _procedural.prepare(batch, position, size, orientation, created, key);
     }
 
     void initializeProcedural();
@@ -13,7 +13,11 @@
 
 #include "RegisteredMetaTypes.h"
 
+#include <gpu/Context.h>
+#include <NumericalConstants.h>
+
 #include "Procedural.h"
+#include "Logging.h"
 
 NetworkMaterialResource::NetworkMaterialResource(const QUrl& url) :
     Resource(url) {}
@@ -549,6 +553,46 @@ NetworkMaterialResourcePointer MaterialCache::getMaterial(const QUrl& url) {
     return ResourceCache::getResource(url).staticCast<NetworkMaterialResource>();
 }
 
+ProceduralProgramPointer MaterialCache::getProceduralProgram(const std::string& key, const std::function<gpu::ShaderPointer()>& createProgram,
+                                                            const QString& name) {
+    std::lock_guard<std::mutex> lock(_proceduralProgramsMutex);
+    auto program = _proceduralPrograms[key].lock();
+    if (!program) {
+        // Drop the programs no procedural uses anymore
+        for (auto it = _proceduralPrograms.begin(); it != _proceduralPrograms.end();) {
+            if (it->second.expired()) {
+                it = _proceduralPrograms.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        program = ProceduralProgram::compile(createProgram(), name);
+        _proceduralPrograms[key] = program;
+    }
+    return program;
+}
+
+ProceduralProgramPointer ProceduralProgram::compile(const gpu::ShaderPointer& program, const QString& name) {
+    auto result = std::make_shared<ProceduralProgram>(program);
+    std::weak_ptr<ProceduralProgram> weakResult = result;
+    bool queued = gpu::Context::compileProgramAsync(program, [weakResult, name](bool ready, uint64_t usecs) {
+        auto result = weakResult.lock();
+        if (!result) {
+            return;
+        }
+        if (usecs > 0) {
+            qCDebug(proceduralLog) << "Compiled procedural shader" << name << "in" << (float)usecs / USECS_PER_MSEC << "ms";
+        }
+        result->_compileTime = usecs;
+        result->_state = ready ? READY : FAILED;
+    });
+    if (!queued) {
+        // Compiled on the render thread when first drawn
+        result->_state = READY;
+    }
+    return result;
+}
+
 QSharedPointer<Resource> MaterialCache::createResource(const QUrl& url) {
     return QSharedPointer<Resource>(new NetworkMaterialResource(url), &Resource::deleter);
 }
@@ -8,9 +8,13 @@
 #ifndef hifi_MaterialCache_h
 #define hifi_MaterialCache_h
 
+#include <atomic>
+#include <mutex>
+
 #include "glm/glm.hpp"
 
 #include <ResourceCache.h>
+#include <gpu/Shader.h>
 #include <graphics/Material.h>
 #include <hfm/HFM.h>
 
@@ -110,6 +114,31 @@ using NetworkMaterialResourcePointer = QSharedPointer<NetworkMaterialResource>;
 using MaterialMapping = std::vector<std::pair<std::string, NetworkMaterialResourcePointer>>;
 Q_DECLARE_METATYPE(MaterialMapping)
 
+// A program of procedural shaders, compiled on the backend shader thread rather than on the render thread when first
+// drawn. The procedurals sharing the same sources share the program.
+class ProceduralProgram {
+public:
+    enum State : uint8_t {
+        COMPILING = 0,
+        READY,
+        FAILED
+    };
+
+    ProceduralProgram(const gpu::ShaderPointer& program) : _program(program) {}
+
+    const gpu::ShaderPointer& getProgram() const { return _program; }
+    State getState() const { return _state; }
+    uint64_t getCompileTime() const { return _compileTime; }  // usecs
+
+    static std::shared_ptr<ProceduralProgram> compile(const gpu::ShaderPointer& program, const QString& name);
+
+private:
+    gpu::ShaderPointer _program;
+    std::atomic<State> _state { COMPILING };
+    std::atomic<uint64_t> _compileTime { 0 };
+};
+using ProceduralProgramPointer = std::shared_ptr<ProceduralProgram>;
+
 class MaterialCache : public ResourceCache, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
@@ -117,9 +146,18 @@ class MaterialCache : public ResourceCache, public Dependency {
 public:
     NetworkMaterialResourcePointer getMaterial(const QUrl& url);
 
+    // The procedurals with the same sources, hashed in key, share their program, which is only created and compiled
+    // for the first of them
+    ProceduralProgramPointer getProceduralProgram(const std::string& key, const std::function<gpu::ShaderPointer()>& createProgram,
+                                                  const QString& name);
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
+
+private:
+    std::mutex _proceduralProgramsMutex;
+    std::unordered_map<std::string, std::weak_ptr<ProceduralProgram>> _proceduralPrograms;
 };
 
 #endif
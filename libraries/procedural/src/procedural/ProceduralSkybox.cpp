@@ -62,7 +62,10 @@ void ProceduralSkybox::render(gpu::Batch& batch, const ViewFrustum& viewFrustum,
     batch.setModelTransform(Transform()); // only for Mac
 
     auto& procedural = skybox._procedural;
-    procedural.prepare(batch, glm::vec3(0), glm::vec3(1), glm::quat(), skybox.getCreated());
+    if (!procedural.prepare(batch, glm::vec3(0), glm::vec3(1), glm::quat(), skybox.getCreated())) {
+        Skybox::render(batch, viewFrustum, skybox, forward);
+        return;
+    }
     skybox.prepare(batch);
     batch.draw(gpu::TRIANGLE_STRIP, 4);
 }
@@ -37,6 +37,9 @@
 // This has the effect of capping the framerate at 200
 static const int MIN_TIMER_MS = 5;
 
+// A surface that hasn't asked for a render for this long is idle, its render timer stops until the next request
+static const uint64_t MAX_IDLE_INTERVAL = 100 * USECS_PER_MSEC;
+
 using namespace hifi::qml;
 using namespace hifi::qml::impl;
 
@@ -398,6 +401,7 @@ void SharedObject::requestRender() {
         return;
     }
     _renderRequested = true;
+    wakeRenderTimer();
 }
 
 void SharedObject::requestRenderSync() {
@@ -406,6 +410,28 @@ void SharedObject::requestRenderSync() {
     }
     _renderRequested = true;
     _syncRequested = true;
+    wakeRenderTimer();
+}
+
+void SharedObject::wakeRenderTimer() {
+    _lastRequestTime = usecTimestampNow();
+#ifndef DISABLE_QML
+    if (!_renderTimer || _paused) {
+        return;
+    }
+
+    if (QThread::currentThread() == thread()) {
+        if (!_renderTimer->isActive()) {
+            _renderTimer->start();
+        }
+    } else {
+        QMetaObject::invokeMethod(this, [this] {
+            if (_renderTimer && !_renderTimer->isActive() && !_quit) {
+                _renderTimer->start();
+            }
+        }, Qt::QueuedConnection);
+    }
+#endif
 }
 
 bool SharedObject::fetchTexture(TextureAndFence& textureAndFence) {
@@ -481,6 +507,13 @@ void SharedObject::onRender() {
 
 void SharedObject::onTimer() {
     getTextureCache().report();
+
+    // the paused surfaces and the idle ones, a mostly static HUD or tablet, don't poll 200 times a second
+    if (_paused || (!_renderRequested && usecTimestampNow() - _lastRequestTime > MAX_IDLE_INTERVAL)) {
+        _renderTimer->stop();
+        return;
+    }
+
     if (!_renderRequested) {
         return;
     }
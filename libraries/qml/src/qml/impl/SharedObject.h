@@ -7,6 +7,8 @@
 //
 #pragma once
 
+#include <atomic>
+
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThread>
@@ -81,6 +83,8 @@ private:
 
     void requestRender();
     void requestRenderSync();
+    // restarts the render timer if it stopped
+    void wakeRenderTimer();
     void wait();
     void wake();
     void onInitialize();
@@ -109,6 +113,8 @@ private:
 #endif
 
     uint64_t _lastRenderTime { 0 };
+    // set by the render requests on any thread, read by the timer
+    std::atomic<uint64_t> _lastRequestTime { 0 };
     QSize _size { 100, 100 };
     uint8_t _maxFps { 60 };
 
@@ -13,6 +13,7 @@
 
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
+#include "impl/FrameChunk.h"
 
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -92,8 +93,9 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
 
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::FRAME_CHUNKED_FLAG = QStringLiteral("chunked");
 
-bool Clip::write(QIODevice& output) {
+bool Clip::write(QIODevice& output, bool chunked) {
     auto frameTypes = Frame::getFrameTypes();
     QJsonObject frameTypeObj;
     for (const auto& frameTypeName : frameTypes.keys()) {
@@ -102,8 +104,9 @@ bool Clip::write(QIODevice& output) {
 
     QJsonObject rootObject;
     rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
-    // Always mark new files as compressed
-    rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    // Always mark new files as compressed, chunks are compressed rather than each frame
+    rootObject.insert(FRAME_COMREPSSION_FLAG, !chunked);
+    rootObject.insert(FRAME_CHUNKED_FLAG, chunked);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
     // Never compress the header frame
     if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
@@ -112,6 +115,16 @@ bool Clip::write(QIODevice& output) {
 
     seek(0);
 
+    if (chunked) {
+        FrameChunk::Writer writer(output);
+        for (auto frame = nextFrame(); frame; frame = nextFrame()) {
+            if (!writer.addFrame(*frame)) {
+                return false;
+            }
+        }
+        return writer.flush();
+    }
+
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
         if (!writeFrame(output, *frame)) {
             return false;
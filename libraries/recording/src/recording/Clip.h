@@ -47,7 +47,8 @@ public:
     virtual void skipFrame() = 0;
     virtual void addFrame(FrameConstPointer) = 0;
 
-    bool write(QIODevice& output);
+    // chunked clips are smaller and faster to seek, but can't be read by versions from before they were introduced
+    bool write(QIODevice& output, bool chunked = true);
 
     static Pointer fromFile(const QString& filePath);
     static void toFile(const QString& filePath, const ConstPointer& clip);
@@ -56,6 +57,7 @@ public:
     
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
+    static const QString FRAME_CHUNKED_FLAG;
 
 protected:
     friend class WrapperClip;
@@ -0,0 +1,158 @@
+//
+//  FrameChunk.cpp
+//  libraries/recording/src/recording/impl
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameChunk.h"
+
+#include <cstring>
+#include <limits>
+
+#include <QtCore/QDebug>
+#include <QtCore/QIODevice>
+
+#include "../Logging.h"
+
+using namespace recording;
+
+using Flags = uint8_t;
+static const Flags DELTA_CODED = 1 << 0;
+
+static const int RECORD_HEADER_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(Flags) + sizeof(FrameSize);
+
+// uncompressed, so that a chunk still fits in a frame once compressed
+static const int MAX_CHUNK_DATA_SIZE = 32 * 1024;
+
+static void xorInto(char* destination, const char* source, int size) {
+    for (int i = 0; i < size; ++i) {
+        destination[i] ^= source[i];
+    }
+}
+
+bool FrameChunk::Writer::addFrame(const Frame& frame) {
+    if (frame.type == Frame::TYPE_INVALID) {
+        qWarning() << "Attempting to write invalid frame";
+        return true;
+    }
+    if (frame.data.size() > std::numeric_limits<FrameSize>::max()) {
+        qCWarning(recordingLog) << "Frame of" << frame.data.size() << "bytes is too large to be written";
+        return false;
+    }
+
+    int recordSize = RECORD_HEADER_SIZE + frame.data.size();
+    if (!_data.isEmpty() && _data.size() + recordSize > MAX_CHUNK_DATA_SIZE) {
+        if (!flush()) {
+            return false;
+        }
+    }
+    if (_data.isEmpty()) {
+        _timeOffset = frame.timeOffset;
+    }
+
+    QByteArray frameData = frame.data;
+    Flags flags = 0;
+    auto lastFrame = _lastFrames.find(frame.type);
+    if (lastFrame != _lastFrames.end() && lastFrame->size() == frameData.size() && !frameData.isEmpty()) {
+        xorInto(frameData.data(), lastFrame->constData(), frameData.size());
+        flags |= DELTA_CODED;
+    }
+    _lastFrames[frame.type] = frame.data;
+
+    FrameSize size = (FrameSize)frameData.size();
+    _data.append(reinterpret_cast<const char*>(&frame.type), sizeof(FrameType));
+    _data.append(reinterpret_cast<const char*>(&frame.timeOffset), sizeof(Frame::Time));
+    _data.append(reinterpret_cast<const char*>(&flags), sizeof(Flags));
+    _data.append(reinterpret_cast<const char*>(&size), sizeof(FrameSize));
+    _data.append(frameData);
+    return true;
+}
+
+bool FrameChunk::Writer::flush() {
+    if (_data.isEmpty()) {
+        return true;
+    }
+
+    QByteArray compressed = qCompress(_data);
+    _data.clear();
+    _lastFrames.clear();
+    if (compressed.size() > std::numeric_limits<FrameSize>::max()) {
+        qCWarning(recordingLog) << "Chunk of" << compressed.size() << "bytes is too large to be written";
+        return false;
+    }
+
+    FrameType type = TYPE;
+    FrameSize size = (FrameSize)compressed.size();
+    return _output.write(reinterpret_cast<const char*>(&type), sizeof(FrameType)) == sizeof(FrameType) &&
+        _output.write(reinterpret_cast<const char*>(&_timeOffset), sizeof(Frame::Time)) == sizeof(Frame::Time) &&
+        _output.write(reinterpret_cast<const char*>(&size), sizeof(FrameSize)) == sizeof(FrameSize) &&
+        _output.write(compressed) == compressed.size();
+}
+
+// walks the records of a chunk, returns false if it is truncated
+template <typename F>
+static bool forEachRecord(const QByteArray& chunk, F f) {
+    const char* start = chunk.constData();
+    const char* current = start;
+    const char* end = start + chunk.size();
+    while (current < end) {
+        if (end - current < RECORD_HEADER_SIZE) {
+            return false;
+        }
+        FrameChunk::Record record;
+        Flags flags;
+        memcpy(&record.type, current, sizeof(FrameType));
+        current += sizeof(FrameType);
+        memcpy(&record.timeOffset, current, sizeof(Frame::Time));
+        current += sizeof(Frame::Time);
+        memcpy(&flags, current, sizeof(Flags));
+        current += sizeof(Flags);
+        memcpy(&record.size, current, sizeof(FrameSize));
+        current += sizeof(FrameSize);
+        if (end - current < record.size) {
+            return false;
+        }
+        record.offset = (int)(current - start);
+        current += record.size;
+        f(record, flags);
+    }
+    return true;
+}
+
+QByteArray FrameChunk::decode(const uchar* data, size_t size) {
+    QByteArray decoded = qUncompress(data, (int)size);
+
+    // the frames are decoded in order, so the last frame of each type is already decoded when a delta refers to it
+    QHash<FrameType, Record> lastRecords;
+    bool areDeltasValid = true;
+    bool isValid = forEachRecord(decoded, [&](const Record& record, Flags flags) {
+        if (flags & DELTA_CODED) {
+            auto lastRecord = lastRecords.find(record.type);
+            if (lastRecord == lastRecords.end() || lastRecord->size != record.size) {
+                areDeltasValid = false;
+                return;
+            }
+            xorInto(decoded.data() + record.offset, decoded.constData() + lastRecord->offset, record.size);
+        }
+        lastRecords[record.type] = record;
+    });
+
+    if (!isValid || !areDeltasValid) {
+        qCWarning(recordingLog) << "Invalid chunk of" << size << "bytes";
+        return QByteArray();
+    }
+    return decoded;
+}
+
+std::vector<FrameChunk::Record> FrameChunk::parse(const QByteArray& decoded) {
+    std::vector<Record> records;
+    forEachRecord(decoded, [&](const Record& record, Flags) {
+        records.push_back(record);
+    });
+    return records;
+}
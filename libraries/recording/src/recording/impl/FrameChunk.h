@@ -0,0 +1,65 @@
+//
+//  FrameChunk.h
+//  libraries/recording/src/recording/impl
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_FrameChunk_h
+#define hifi_Recording_Impl_FrameChunk_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+
+#include "../Frame.h"
+
+class QIODevice;
+
+namespace recording {
+
+// In a chunked clip, the frames following the header frame are chunks: each holds a run of consecutive frames,
+// compressed together, and its time offset is the one of its first frame. A frame is delta coded against the
+// previous frame of the same type in its chunk when they are the same size, so consecutive avatar frames compress
+// well, and each chunk can be decoded on its own when seeking.
+namespace FrameChunk {
+    // never in the frame type map, so readers that don't know about chunks skip them
+    const FrameType TYPE = Frame::TYPE_INVALID;
+
+    struct Record {
+        FrameType type;
+        Frame::Time timeOffset;
+        int offset; // of the frame data in the decoded chunk
+        FrameSize size;
+    };
+
+    class Writer {
+    public:
+        Writer(QIODevice& output) : _output(output) {}
+
+        bool addFrame(const Frame& frame);
+        // writes the chunk in progress
+        bool flush();
+
+    private:
+        QIODevice& _output;
+        QByteArray _data;
+        Frame::Time _timeOffset { 0 };
+        QHash<FrameType, QByteArray> _lastFrames; // in the chunk in progress
+    };
+
+    // decompresses a chunk and undoes the delta coding, empty if the chunk is invalid
+    QByteArray decode(const uchar* data, size_t size);
+    // the frames of a decoded chunk, in order
+    std::vector<Record> parse(const QByteArray& decoded);
+}
+
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include "../Frame.h"
 #include "../Logging.h"
 #include "BufferClip.h"
+#include "FrameChunk.h"
 
 
 using namespace recording;
@@ -79,6 +80,9 @@ void PointerClip::reset() {
     _data = nullptr;
     _size = 0;
     _header = QJsonDocument();
+    _chunked = false;
+    _chunks.clear();
+    _decodedChunk.clear();
 }
 
 void PointerClip::init(uchar* data, size_t size) {
@@ -97,8 +101,8 @@ void PointerClip::init(uchar* data, size_t size) {
 
     // Grab the file header
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
+        auto fileHeaderFrameHeader = parsedFrameHeaders.front();
+        parsedFrameHeaders.erase(parsedFrameHeaders.begin());
         if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
             qWarning() << "Missing header frame, invalid file";
             reset();
@@ -112,6 +116,7 @@ void PointerClip::init(uchar* data, size_t size) {
     // Check for compression
     {
         _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+        _chunked = _header.object()[FRAME_CHUNKED_FLAG].toBool();
     }
 
     // Find the type enum translation map and fix up the frame headers
@@ -123,6 +128,32 @@ void PointerClip::init(uchar* data, size_t size) {
             return;
         }
 
+        if (_chunked) {
+            // index the frames of each chunk, the chunks are decoded again as they are played
+            for (const auto& chunkHeader : parsedFrameHeaders) {
+                if (chunkHeader.type != FrameChunk::TYPE) {
+                    continue;
+                }
+                auto decoded = FrameChunk::decode(_data + chunkHeader.fileOffset, chunkHeader.size);
+                uint32_t chunk = (uint32_t)_chunks.size();
+                _chunks.push_back(chunkHeader);
+                for (const auto& record : FrameChunk::parse(decoded)) {
+                    if (!translationMap.contains(record.type)) {
+                        continue;
+                    }
+                    PointerFrameHeader frameHeader;
+                    frameHeader.type = translationMap[record.type];
+                    frameHeader.timeOffset = record.timeOffset;
+                    frameHeader.size = record.size;
+                    frameHeader.fileOffset = record.offset;
+                    frameHeader.chunk = chunk;
+                    _frames.push_back(frameHeader);
+                }
+            }
+            _frames.shrink_to_fit();
+            return;
+        }
+
         // Update the loaded headers with the frame data
         _frames.reserve(parsedFrameHeaders.size());
         for (auto& frameHeader : parsedFrameHeaders) {
@@ -144,7 +175,12 @@ FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
         const auto& header = _frames[frameIndex];
         result->type = header.type;
         result->timeOffset = header.timeOffset;
-        if (header.size) {
+        if (_chunked) {
+            const auto& decoded = decodedChunk(header.chunk);
+            if (header.size && (int)(header.fileOffset + header.size) <= decoded.size()) {
+                result->data = decoded.mid((int)header.fileOffset, header.size);
+            }
+        } else if (header.size) {
             result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
             if (_compressed) {
                 result->data = qUncompress(result->data);
@@ -154,6 +190,15 @@ FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
     return result;
 }
 
+const QByteArray& PointerClip::decodedChunk(uint32_t chunk) const {
+    if (_decodedChunk.isEmpty() || _decodedChunkIndex != chunk) {
+        const auto& chunkHeader = _chunks[chunk];
+        _decodedChunk = FrameChunk::decode(_data + chunkHeader.fileOffset, chunkHeader.size);
+        _decodedChunkIndex = chunk;
+    }
+    return _decodedChunk;
+}
+
 void PointerClip::addFrame(FrameConstPointer) {
     throw std::runtime_error("Pointer clips are read only, use duplicate to create a read/write clip");
 }
@@ -13,6 +13,7 @@
 #include "ArrayClip.h"
 
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QJsonDocument>
 
@@ -24,10 +25,11 @@ struct PointerFrameHeader : public FrameHeader {
     FrameType type;
     Frame::Time timeOffset;
     uint16_t size;
-    quint64 fileOffset;
+    quint64 fileOffset; // in the decoded chunk for chunked clips
+    uint32_t chunk { 0 }; // for chunked clips
 };
 
-using PointerFrameHeaderList = std::list<PointerFrameHeader>;
+using PointerFrameHeaderList = std::vector<PointerFrameHeader>;
 
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
@@ -51,6 +53,13 @@ protected:
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+
+    // only the chunk being played is kept decoded
+    const QByteArray& decodedChunk(uint32_t chunk) const;
+    bool _chunked { false };
+    PointerFrameHeaderList _chunks;
+    mutable uint32_t _decodedChunkIndex { 0 };
+    mutable QByteArray _decodedChunk;
 };
 
 }
@@ -36,6 +36,13 @@ gpu::PipelinePointer AmbientOcclusionEffect::_bilateralBlurPipeline;
 gpu::PipelinePointer AmbientOcclusionEffect::_mipCreationPipeline;
 gpu::PipelinePointer AmbientOcclusionEffect::_gatherPipeline;
 gpu::PipelinePointer AmbientOcclusionEffect::_buildNormalsPipeline;
+gpu::PipelinePointer AmbientOcclusionEffect::_temporalAccumulatePipeline;
+
+// With the temporal accumulation, each frame takes a fraction of the samples and blends in with this weight
+static const int TEMPORAL_SAMPLE_DIVIDER = 4;
+static const float TEMPORAL_BLEND = 0.15f;
+// the relative difference of depth past which the history is of another surface
+static const float TEMPORAL_DEPTH_THRESHOLD = 0.05f;
 
 AmbientOcclusionFramebuffer::AmbientOcclusionFramebuffer() {
 }
@@ -75,6 +82,10 @@ void AmbientOcclusionFramebuffer::clear() {
     _occlusionBlurredTexture.reset();
     _normalFramebuffer.reset();
     _normalTexture.reset();
+    for (int i = 0; i < 2; i++) {
+        _occlusionHistoryFramebuffers[i].reset();
+        _occlusionHistoryTextures[i].reset();
+    }
 }
 
 gpu::TexturePointer AmbientOcclusionFramebuffer::getLinearDepthTexture() {
@@ -101,6 +112,12 @@ void AmbientOcclusionFramebuffer::allocate() {
         _occlusionBlurredTexture = gpu::Texture::createRenderBuffer(occlusionformat, width, height, gpu::Texture::SINGLE_MIP, sampler);
         _occlusionBlurredFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("occlusionBlurred"));
         _occlusionBlurredFramebuffer->setRenderBuffer(0, _occlusionBlurredTexture);
+
+        for (int i = 0; i < 2; i++) {
+            _occlusionHistoryTextures[i] = gpu::Texture::createRenderBuffer(occlusionformat, width, height, gpu::Texture::SINGLE_MIP, sampler);
+            _occlusionHistoryFramebuffers[i] = gpu::FramebufferPointer(gpu::Framebuffer::create("occlusionHistory"));
+            _occlusionHistoryFramebuffers[i]->setRenderBuffer(0, _occlusionHistoryTextures[i]);
+        }
     }
 
     // Lower res frame
@@ -204,6 +221,22 @@ gpu::TexturePointer AmbientOcclusionFramebuffer::getNormalTexture() {
     return _normalTexture;
 }
 
+gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionHistoryFramebuffer(int index) {
+    assert(index < 2);
+    if (!_occlusionHistoryFramebuffers[index]) {
+        allocate();
+    }
+    return _occlusionHistoryFramebuffers[index];
+}
+
+gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionHistoryTexture(int index) {
+    assert(index < 2);
+    if (!_occlusionHistoryTextures[index]) {
+        allocate();
+    }
+    return _occlusionHistoryTextures[index];
+}
+
 AmbientOcclusionEffectConfig::AmbientOcclusionEffectConfig() :
     render::GPUJobConfig::Persistent(QStringList() << "Render" << "Engine" << "Ambient Occlusion"),
     perspectiveScale{ 1.0f },
@@ -226,7 +259,8 @@ AmbientOcclusionEffectConfig::AmbientOcclusionEffectConfig() :
     ditheringEnabled{ true },
     borderingEnabled{ true },
     fetchMipsEnabled{ true },
-    jitterEnabled{ false }{
+    jitterEnabled{ false },
+    temporalEnabled{ false } {
 }
 
 void AmbientOcclusionEffectConfig::setSSAORadius(float newRadius) {
@@ -293,6 +327,7 @@ AmbientOcclusionEffect::AOParameters::AOParameters() {
     _ditheringInfo = glm::vec4{ 0.0f };
     _sampleInfo = glm::vec4{ 0.0f };
     _falloffInfo = glm::vec4{ 0.0f };
+    _temporalInfo = glm::vec4{ TEMPORAL_BLEND, TEMPORAL_DEPTH_THRESHOLD, 0.0f, 0.0f };
 }
 
 AmbientOcclusionEffect::BlurParameters::BlurParameters() {
@@ -307,6 +342,10 @@ void AmbientOcclusionEffect::configure(const Config& config) {
     bool shouldUpdateTechnique = false;
 
     _isJitterEnabled = config.jitterEnabled;
+    if (_isTemporalEnabled != config.temporalEnabled) {
+        _isTemporalEnabled = config.temporalEnabled;
+        shouldUpdateTechnique = true;
+    }
 
     if (!_framebuffer) {
         _framebuffer = std::make_shared<AmbientOcclusionFramebuffer>();
@@ -392,10 +431,11 @@ void AmbientOcclusionEffect::configure(const Config& config) {
             current.w = 1.0f / current.z;
         }
 
-        if (shouldUpdateTechnique || config.hbaoNumSamples != _aoParametersBuffer->getNumSamples()) {
+        const int numSamples = config.temporalEnabled ? std::max(1, config.hbaoNumSamples / TEMPORAL_SAMPLE_DIVIDER) : config.hbaoNumSamples;
+        if (shouldUpdateTechnique || numSamples != _aoParametersBuffer->getNumSamples()) {
             auto& current = _aoParametersBuffer.edit()._sampleInfo;
-            current.x = config.hbaoNumSamples;
-            current.y = 1.0f / config.hbaoNumSamples;
+            current.x = numSamples;
+            current.y = 1.0f / numSamples;
             updateRandomSamples();
             updateJitterSamples();
         }
@@ -425,10 +465,11 @@ void AmbientOcclusionEffect::configure(const Config& config) {
             current.z = config.ssaoNumSpiralTurns;
         }
 
-        if (shouldUpdateTechnique || config.ssaoNumSamples != _aoParametersBuffer->getNumSamples()) {
+        const int numSamples = config.temporalEnabled ? std::max(1, config.ssaoNumSamples / TEMPORAL_SAMPLE_DIVIDER) : config.ssaoNumSamples;
+        if (shouldUpdateTechnique || numSamples != _aoParametersBuffer->getNumSamples()) {
             auto& current = _aoParametersBuffer.edit()._sampleInfo;
-            current.x = config.ssaoNumSamples;
-            current.y = 1.0f / config.ssaoNumSamples;
+            current.x = numSamples;
+            current.y = 1.0f / numSamples;
             updateRandomSamples();
             updateJitterSamples();
         }
@@ -577,6 +618,19 @@ const gpu::PipelinePointer& AmbientOcclusionEffect::getBuildNormalsPipeline() {
     return _buildNormalsPipeline;
 }
 
+const gpu::PipelinePointer& AmbientOcclusionEffect::getTemporalAccumulatePipeline() {
+    if (!_temporalAccumulatePipeline) {
+        gpu::ShaderPointer program = gpu::Shader::createProgram(shader::render_utils::program::ssao_temporalAccumulate);
+        gpu::StatePointer state = gpu::StatePointer(new gpu::State());
+
+        state->setColorWriteMask(true, true, true, true);
+
+        // Good to go add the brand new pipeline
+        _temporalAccumulatePipeline = gpu::Pipeline::create(program, state);
+    }
+    return _temporalAccumulatePipeline;
+}
+
 int AmbientOcclusionEffect::getDepthResolutionLevel() const {
     return std::min(1, _aoParametersBuffer->getResolutionLevel());
 }
@@ -603,11 +657,13 @@ void AmbientOcclusionEffect::run(const render::RenderContextPointer& renderConte
 
     if (!lightingModel->isAmbientOcclusionEnabled()) {
         output.edit0().reset();
+        _hasHistory = false;
         return;
     }
 
     const auto& frameTransform = input.get1();
     const auto& linearDepthFramebuffer = input.get3();
+    const auto& velocityFramebuffer = input.get4();
     
     const int resolutionLevel = _aoParametersBuffer->getResolutionLevel();
     const auto depthResolutionLevel = getDepthResolutionLevel();
@@ -632,10 +688,19 @@ void AmbientOcclusionEffect::run(const render::RenderContextPointer& renderConte
         occlusionDepthTexture = linearDepthFramebuffer->getHalfLinearDepthTexture();
     }
 
+    bool isHistoryValid = _hasHistory;
     if (_framebuffer->update(fullResDepthTexture, resolutionLevel, depthResolutionLevel, args->isStereo())) {
         updateBlurParameters();
         updateFramebufferSizes();
+        isHistoryValid = false;
+    }
+
+    // The history is blended in from the frame after the first accumulated one
+    const bool isTemporal = _isTemporalEnabled && velocityFramebuffer != nullptr;
+    if (isHistoryValid != _aoParametersBuffer->isTemporalHistoryValid()) {
+        _aoParametersBuffer.edit()._temporalInfo.z = (float)isHistoryValid;
     }
+    _hasHistory = isTemporal;
     
     auto occlusionFBO = _framebuffer->getOcclusionFramebuffer();
     auto occlusionBlurredFBO = _framebuffer->getOcclusionBlurredFramebuffer();
@@ -656,8 +721,20 @@ void AmbientOcclusionEffect::run(const render::RenderContextPointer& renderConte
     auto splitViewport = glm::ivec4{ 0, 0, splitSize.x, splitSize.y };
 #endif
 
-    // Update sample rotation
-    if (_isJitterEnabled) {
+    gpu::PipelinePointer temporalAccumulatePipeline;
+    gpu::FramebufferPointer occlusionHistoryFBO;
+    gpu::TexturePointer previousHistoryTexture;
+    gpu::TexturePointer velocityTexture;
+    if (isTemporal) {
+        temporalAccumulatePipeline = getTemporalAccumulatePipeline();
+        occlusionHistoryFBO = _framebuffer->getOcclusionHistoryFramebuffer(_historyIndex);
+        previousHistoryTexture = _framebuffer->getOcclusionHistoryTexture(1 - _historyIndex);
+        velocityTexture = velocityFramebuffer->getVelocityTexture();
+        _historyIndex = 1 - _historyIndex;
+    }
+
+    // Update sample rotation, the accumulation needs a different one at each frame
+    if (_isJitterEnabled || isTemporal) {
         updateJitterSamples();
         _frameId = (_frameId + 1) % (SSAO_RANDOM_SAMPLE_COUNT);
     }
@@ -819,6 +896,23 @@ void AmbientOcclusionEffect::run(const render::RenderContextPointer& renderConte
             batch.popProfileRange();
         }
 
+        if (isTemporal) {
+            // Blend with the reprojected history, then hand the result to the lighting in the occlusion framebuffer
+            batch.pushProfileRange("Temporal");
+            batch.setModelTransform(Transform());
+            batch.setViewportTransform(sourceViewport);
+            batch.setPipeline(temporalAccumulatePipeline);
+            batch.setFramebuffer(occlusionHistoryFBO);
+            batch.setResourceTexture(render_utils::slot::texture::SsaoOcclusion, occlusionFBO->getRenderBuffer(0));
+            batch.setResourceTexture(render_utils::slot::texture::SsaoHistory, previousHistoryTexture);
+            batch.setResourceTexture(render_utils::slot::texture::SsaoVelocity, velocityTexture);
+            batch.draw(gpu::TRIANGLE_STRIP, 4);
+            batch.setResourceTexture(render_utils::slot::texture::SsaoHistory, nullptr);
+            batch.setResourceTexture(render_utils::slot::texture::SsaoVelocity, nullptr);
+            batch.blit(occlusionHistoryFBO, sourceViewport, occlusionFBO, sourceViewport);
+            batch.popProfileRange();
+        }
+
         batch.setResourceTexture(render_utils::slot::texture::SsaoDepth, nullptr);
         batch.setResourceTexture(render_utils::slot::texture::SsaoNormal, nullptr);
         batch.setResourceTexture(render_utils::slot::texture::SsaoOcclusion, nullptr);
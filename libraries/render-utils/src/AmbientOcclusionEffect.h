@@ -21,6 +21,7 @@
 #include "DeferredFrameTransform.h"
 #include "DeferredFramebuffer.h"
 #include "SurfaceGeometryPass.h"
+#include "VelocityBufferPass.h"
 
 #include "ssao_shared.h"
 
@@ -37,6 +38,10 @@ public:
     gpu::FramebufferPointer getNormalFramebuffer();
     gpu::TexturePointer getNormalTexture();
 
+    // The occlusion accumulated over the frames, read from one while writing the other
+    gpu::FramebufferPointer getOcclusionHistoryFramebuffer(int index);
+    gpu::TexturePointer getOcclusionHistoryTexture(int index);
+
 #if SSAO_USE_QUAD_SPLIT
     gpu::FramebufferPointer getOcclusionSplitFramebuffer(int index);
     gpu::TexturePointer getOcclusionSplitTexture();
@@ -64,6 +69,9 @@ protected:
     gpu::FramebufferPointer _normalFramebuffer;
     gpu::TexturePointer _normalTexture;
 
+    gpu::FramebufferPointer _occlusionHistoryFramebuffers[2];
+    gpu::TexturePointer _occlusionHistoryTextures[2];
+
 #if SSAO_USE_QUAD_SPLIT
     gpu::FramebufferPointer _occlusionSplitFramebuffers[SSAO_SPLIT_COUNT*SSAO_SPLIT_COUNT];
     gpu::TexturePointer _occlusionSplitTexture;
@@ -84,6 +92,7 @@ class AmbientOcclusionEffectConfig : public render::GPUJobConfig::Persistent {
     Q_PROPERTY(bool borderingEnabled MEMBER borderingEnabled NOTIFY dirty)
     Q_PROPERTY(bool fetchMipsEnabled MEMBER fetchMipsEnabled NOTIFY dirty)
     Q_PROPERTY(bool jitterEnabled MEMBER jitterEnabled NOTIFY dirty)
+    Q_PROPERTY(bool temporalEnabled MEMBER temporalEnabled NOTIFY dirty)
 
     Q_PROPERTY(int resolutionLevel MEMBER resolutionLevel WRITE setResolutionLevel)
     Q_PROPERTY(float edgeSharpness MEMBER edgeSharpness WRITE setEdgeSharpness)
@@ -144,6 +153,7 @@ public:
     bool borderingEnabled; // avoid evaluating information from non existing pixels out of the frame, should always be true
     bool fetchMipsEnabled; // fetch taps in sub mips to otpimize cache, should always be true
     bool jitterEnabled; // Add small jittering to AO samples at each frame
+    bool temporalEnabled; // Accumulate the jittered AO over the frames, with fewer samples in each
 
 signals:
     void dirty();
@@ -153,7 +163,7 @@ signals:
 
 class AmbientOcclusionEffect {
 public:
-    using Input = render::VaryingSet4<LightingModelPointer, DeferredFrameTransformPointer, DeferredFramebufferPointer, LinearDepthFramebufferPointer>;
+    using Input = render::VaryingSet5<LightingModelPointer, DeferredFrameTransformPointer, DeferredFramebufferPointer, LinearDepthFramebufferPointer, VelocityFramebufferPointer>;
     using Output = render::VaryingSet2<AmbientOcclusionFramebufferPointer, gpu::BufferView>;
     using Config = AmbientOcclusionEffectConfig;
     using JobModel = render::Job::ModelIO<AmbientOcclusionEffect, Input, Output, Config>;
@@ -182,6 +192,7 @@ public:
         bool isDitheringEnabled() const { return _ditheringInfo.x != 0.0f; }
         bool isBorderingEnabled() const { return _ditheringInfo.w != 0.0f; }
         bool isHorizonBased() const { return _resolutionInfo.y != 0.0f; }
+        bool isTemporalHistoryValid() const { return _temporalInfo.z != 0.0f; }
 
     };
     using AOParametersBuffer = gpu::StructBuffer<AOParameters>;
@@ -220,17 +231,22 @@ private:
     static const gpu::PipelinePointer& getMipCreationPipeline();
     static const gpu::PipelinePointer& getGatherPipeline();
     static const gpu::PipelinePointer& getBuildNormalsPipeline();
+    static const gpu::PipelinePointer& getTemporalAccumulatePipeline();
 
     static gpu::PipelinePointer _occlusionPipeline;
     static gpu::PipelinePointer _bilateralBlurPipeline;
     static gpu::PipelinePointer _mipCreationPipeline;
     static gpu::PipelinePointer _gatherPipeline;
     static gpu::PipelinePointer _buildNormalsPipeline;
+    static gpu::PipelinePointer _temporalAccumulatePipeline;
 
     AmbientOcclusionFramebufferPointer _framebuffer;
     std::array<float, SSAO_RANDOM_SAMPLE_COUNT * SSAO_SPLIT_COUNT*SSAO_SPLIT_COUNT> _randomSamples;
     int _frameId{ 0 };
     bool _isJitterEnabled{ true };
+    bool _isTemporalEnabled{ false };
+    bool _hasHistory{ false };
+    int _historyIndex{ 0 };
     
     gpu::RangeTimerPointer _gpuTimer;
 
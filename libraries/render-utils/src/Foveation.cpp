@@ -0,0 +1,77 @@
+//
+//  Foveation.cpp
+//  render-utils/src/
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Foveation.h"
+
+#include <gpu/Context.h>
+#include <shaders/Shaders.h>
+
+#include "render-utils/ShaderConstants.h"
+
+namespace ru {
+    using render_utils::slot::texture::Texture;
+    using render_utils::slot::buffer::Buffer;
+}
+
+bool Foveation::isEnabled(const RenderArgs* args) {
+    return args->_foveated && args->isStereo() && !args->_takingSnapshot;
+}
+
+void Foveation::updateParameters(ParametersBuffer& parametersBuffer, const RenderArgs* args) {
+    auto& parameters = parametersBuffer.edit();
+    parameters._centers = glm::vec4(args->_foveationCenters[0], args->_foveationCenters[1]);
+    parameters._viewport = glm::vec4(args->_viewport);
+    float eyeAspectRatio = 0.5f * (float)args->_viewport.z / (float)std::max(args->_viewport.w, 1);
+    parameters._radiusAspect = glm::vec4(args->_foveationRadius, eyeAspectRatio, 0.0f, 0.0f);
+}
+
+void FillFoveation::run(const render::RenderContextPointer& renderContext, const gpu::FramebufferPointer& framebuffer) {
+    RenderArgs* args = renderContext->args;
+    if (!framebuffer || !Foveation::isEnabled(args)) {
+        return;
+    }
+
+    if (!_pipeline) {
+        auto program = gpu::Shader::createProgram(shader::render_utils::program::foveation_fill);
+        auto state = std::make_shared<gpu::State>();
+        state->setDepthTest(false, false, gpu::LESS_EQUAL);
+        _pipeline = gpu::Pipeline::create(program, state);
+    }
+
+    // the holes are filled from a copy, a pass can't read the buffer it draws in
+    auto size = framebuffer->getSize();
+    if (_sourceFramebuffer && _sourceFramebuffer->getSize() != size) {
+        _sourceFramebuffer.reset();
+    }
+    if (!_sourceFramebuffer) {
+        _sourceFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("foveationSource"));
+        auto format = framebuffer->getRenderBuffer(0)->getTexelFormat();
+        auto sampler = gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT);
+        _sourceFramebuffer->setRenderBuffer(0, gpu::Texture::createRenderBuffer(format, size.x, size.y, gpu::Texture::SINGLE_MIP, sampler));
+    }
+
+    Foveation::updateParameters(_parametersBuffer, args);
+    gpu::Vec4i rect(args->_viewport.x, args->_viewport.y,
+        args->_viewport.x + args->_viewport.z, args->_viewport.y + args->_viewport.w);
+
+    gpu::doInBatch("FillFoveation::run", args->_context, [&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+        batch.blit(framebuffer, rect, _sourceFramebuffer, rect);
+
+        batch.setFramebuffer(framebuffer);
+        batch.setViewportTransform(args->_viewport);
+        batch.setPipeline(_pipeline);
+        batch.setUniformBuffer(ru::Buffer::FoveationParams, _parametersBuffer);
+        batch.setResourceTexture(ru::Texture::FoveationSource, _sourceFramebuffer->getRenderBuffer(0));
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+        batch.setResourceTexture(ru::Texture::FoveationSource, nullptr);
+    });
+}
@@ -0,0 +1,43 @@
+//
+//  Foveation.h
+//  render-utils/src/
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_Foveation_h
+#define hifi_Foveation_h
+
+#include <gpu/Buffer.h>
+#include <gpu/Pipeline.h>
+#include <render/Engine.h>
+
+#include "Foveation_shared.slh"
+
+// Foveated rendering by radial density masking: outside of the full resolution region around the center of each eye,
+// PrepareStencil masks every other 2x2 block of pixels so that the scene isn't shaded there, and FillFoveation fills
+// these blocks from their neighbors once the scene is lit.
+namespace Foveation {
+    using ParametersBuffer = gpu::StructBuffer<FoveationParameters>;
+
+    bool isEnabled(const RenderArgs* args);
+    void updateParameters(ParametersBuffer& parametersBuffer, const RenderArgs* args);
+}
+
+class FillFoveation {
+public:
+    using JobModel = render::Job::ModelI<FillFoveation, gpu::FramebufferPointer>;
+
+    void run(const render::RenderContextPointer& renderContext, const gpu::FramebufferPointer& framebuffer);
+
+private:
+    gpu::PipelinePointer _pipeline;
+    gpu::FramebufferPointer _sourceFramebuffer;
+    Foveation::ParametersBuffer _parametersBuffer;
+};
+
+#endif // hifi_Foveation_h
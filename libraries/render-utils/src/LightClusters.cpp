@@ -10,6 +10,10 @@
 
 #include "LightClusters.h"
 
+#include <atomic>
+
+#include <TBBHelpers.h>
+
 #include <gpu/Context.h>
 #include <shaders/Shaders.h>
 #include <graphics/ShaderConstants.h>
@@ -328,8 +332,16 @@ glm::ivec3 LightClusters::updateClusters() {
     // Clean up last info
     uint32_t numClusters = (uint32_t)_clusterGrid.size();
 
-    std::vector< std::vector< LightIndex > > clusterGridPoint(numClusters);
-    std::vector< std::vector< LightIndex > > clusterGridSpot(numClusters);
+    // Keep the per cluster lists around to reuse their allocations from frame to frame
+    auto& clusterGridPoint = _clusterGridPoint;
+    auto& clusterGridSpot = _clusterGridSpot;
+    clusterGridPoint.resize(numClusters);
+    clusterGridSpot.resize(numClusters);
+    for (uint32_t i = 0; i < numClusters; i++) {
+        clusterGridPoint[i].clear();
+        clusterGridSpot[i].clear();
+    }
+    _clusteredLights.clear();
 
     _clusterGrid.clear();
     _clusterGrid.resize(numClusters, EMPTY_CLUSTER);
@@ -343,7 +355,6 @@ glm::ivec3 LightClusters::updateClusters() {
 
     glm::ivec3 gridPosToOffset(1, theFrustumGrid.dims.x, theFrustumGrid.dims.x * theFrustumGrid.dims.y);
 
-    uint32_t numClusterTouched = 0;
     uint32_t numLightsIn = _visibleLightIndices[0];
     uint32_t numClusteredLights = 0;
     for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
@@ -472,17 +483,36 @@ glm::ivec3 LightClusters::updateClusters() {
             assert(yMin <= yMax);
         }
 
-        // now voxelize
-        auto& clusterGrid = (isSpot ? clusterGridSpot : clusterGridPoint);
-        if (beyondFar) {
-            numClusterTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
-        } else {
-            numClusterTouched += scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
-        }
-
+        _clusteredLights.push_back({ (LightID)lightId, glm::vec4(glm::vec3(eyeOri), radius), glm::ivec3(xMin, yMin, zMin),
+                                     glm::ivec3(xMax, yMax, zMax), isSpot, beyondFar });
         numClusteredLights++;
     }
 
+    // now voxelize, in parallel over the z layers of the grid.  A layer only touches its own clusters and walks the
+    // lights in order, so the clusters list the lights in the same order as they would have been voxelized one by one
+    std::atomic<uint32_t> numClusterTouched { 0 };
+    int numLayers = theFrustumGrid.dims.z + 1;
+    tbb::parallel_for(tbb::blocked_range<int>(0, numLayers), [&](const tbb::blocked_range<int>& range) {
+        uint32_t numTouched = 0;
+        for (const auto& light : _clusteredLights) {
+            auto& clusterGrid = (light.isSpot ? clusterGridSpot : clusterGridPoint);
+            if (light.beyondFar) {
+                if (light.minCluster.z >= range.begin() && light.minCluster.z < range.end()) {
+                    numTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, light.minCluster.z, light.minCluster.y, light.maxCluster.y,
+                                                          light.minCluster.x, light.maxCluster.x, light.id, light.eyePosRadius, clusterGrid);
+                }
+            } else {
+                int zMin = std::max(light.minCluster.z, range.begin());
+                int zMax = std::min(light.maxCluster.z, range.end() - 1);
+                if (zMin <= zMax) {
+                    numTouched += scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, light.minCluster.y, light.maxCluster.y,
+                                                        light.minCluster.x, light.maxCluster.x, light.id, light.eyePosRadius, clusterGrid);
+                }
+            }
+        }
+        numClusterTouched += numTouched;
+    });
+
     // Lights have been gathered now reexpress in terms of 2 sequential buffers
     // Start filling from near to far and stops if it overflows
     bool checkBudget = false;
@@ -524,7 +554,7 @@ glm::ivec3 LightClusters::updateClusters() {
     _clusterGridBuffer._buffer->setData(_clusterGridBuffer._size, (gpu::Byte*) _clusterGrid.data());
     _clusterContentBuffer._buffer->setSubData(0, indexOffset * sizeof(LightIndex), (gpu::Byte*) _clusterContent.data());
     
-    return glm::ivec3(numLightsIn, numClusteredLights, numClusterTouched);
+    return glm::ivec3(numLightsIn, numClusteredLights, numClusterTouched.load());
 }
 
 
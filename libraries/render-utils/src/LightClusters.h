@@ -111,6 +111,19 @@ public:
 
     bool _clusterResourcesInvalid { true };
     void updateClusterResource();
+
+    // The lights that made it into the grid, with the range of clusters they overlap
+    struct ClusteredLight {
+        LightID id;
+        glm::vec4 eyePosRadius;
+        glm::ivec3 minCluster;
+        glm::ivec3 maxCluster;
+        bool isSpot;
+        bool beyondFar;
+    };
+    std::vector<ClusteredLight> _clusteredLights;
+    std::vector<std::vector<LightIndex>> _clusterGridPoint;
+    std::vector<std::vector<LightIndex>> _clusterGridSpot;
 };
 
 using LightClustersPointer = std::shared_ptr<LightClusters>;
@@ -25,6 +25,7 @@
 using namespace render;
 
 bool ModelMeshPartPayload::enableMaterialProceduralShaders = false;
+float ModelMeshPartPayload::maxLODScreenError = 1.0f;
 
 ModelMeshPartPayload::ModelMeshPartPayload(ModelPointer model, int meshIndex, int partIndex, int shapeIndex,
                                            const Transform& transform, const uint64_t& created) :
@@ -84,6 +85,8 @@ void ModelMeshPartPayload::initCache(const ModelPointer& model, int shapeID) {
 
 void ModelMeshPartPayload::updateMeshPart(const std::shared_ptr<const graphics::Mesh>& drawMesh, int partIndex) {
     _drawMesh = drawMesh;
+    _partIndex = partIndex;
+    _lodIndex = -1;
     if (_drawMesh) {
         auto vertexFormat = _drawMesh->getVertexFormat();
         _drawPart = _drawMesh->getPartBuffer().get<graphics::Mesh::Part>(partIndex);
@@ -179,13 +182,14 @@ void ModelMeshPartPayload::updateTransformForSkinnedMesh(const Transform& modelT
     _parentTransform = modelTransform;
 }
 
-void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) {
-    batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
+void ModelMeshPartPayload::bindMesh(gpu::Batch& batch, int lodIndex) {
+    const auto& indexBuffer = lodIndex >= 0 ? _drawMesh->getLODIndexBuffer() : _drawMesh->getIndexBuffer();
+    batch.setIndexBuffer(gpu::UINT32, indexBuffer._buffer, 0);
     batch.setInputFormat((_drawMesh->getVertexFormat()));
     if (_meshBlendshapeBuffer) {
         batch.setResourceBuffer(0, _meshBlendshapeBuffer);
     }
-    batch.setInputStream(0, _drawMesh->getVertexStream());
+    batch.setInputStream(0, _preSkinnedMesh ? _preSkinnedMesh->getVertexStream() : _drawMesh->getVertexStream());
 }
 
 void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const Transform& transform, RenderArgs::RenderMode renderMode) const {
@@ -195,8 +199,8 @@ void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const Transform& tra
     batch.setModelTransform(transform);
 }
 
-void ModelMeshPartPayload::drawCall(gpu::Batch& batch) const {
-    batch.drawIndexed(gpu::TRIANGLES, _drawPart._numIndices, _drawPart._startIndex);
+void ModelMeshPartPayload::drawCall(gpu::Batch& batch, const graphics::Mesh::Part& part) const {
+    batch.drawIndexed(gpu::TRIANGLES, part._numIndices, part._startIndex);
 }
 
 void ModelMeshPartPayload::updateKey(const render::ItemKey& key) {
@@ -245,7 +249,7 @@ void ModelMeshPartPayload::setShapeKey(bool invalidateShapeKey, PrimitiveMode pr
         builder.withTranslucent();
     }
 
-    if (_isSkinned || (_isBlendShaped && _meshBlendshapeBuffer)) {
+    if (!_preSkinnedMesh && (_isSkinned || (_isBlendShaped && _meshBlendshapeBuffer))) {
         builder.withDeformed();
         if (useDualQuaternionSkinning) {
             builder.withDualQuatSkinned();
@@ -326,11 +330,23 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     Transform modelTransform = transform.worldTransform(_localTransform);
     bindTransform(batch, modelTransform, args->_renderMode);
 
+    updateTexturePriorities(args, modelTransform);
+
+    int lodIndex = selectLOD(args, modelTransform);
+    if (args->_renderMode == RenderArgs::RenderMode::DEFAULT_RENDER_MODE) {
+        _lodIndex = lodIndex;
+    }
+
+    if (canRenderInstanced(args)) {
+        renderInstanced(args, batch, lodIndex);
+        return;
+    }
+
     //Bind the index buffer and vertex buffer and Blend shapes if needed
-    bindMesh(batch);
+    bindMesh(batch, lodIndex);
 
     // IF deformed pass the mesh key
-    auto drawcallInfo = (uint16_t) (((_isBlendShaped && _meshBlendshapeBuffer && args->_enableBlendshape) << 0) | ((_isSkinned && args->_enableSkinning) << 1));
+    auto drawcallInfo = (uint16_t) (((_isBlendShaped && _meshBlendshapeBuffer && args->_enableBlendshape) << 0) | ((_isSkinned && !_preSkinnedMesh && args->_enableSkinning) << 1));
     if (drawcallInfo) {
         batch.setDrawcallUniform(drawcallInfo);
     }
@@ -343,8 +359,10 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
         auto& schema = _drawMaterials.getSchemaBuffer().get<graphics::MultiMaterial::Schema>();
         glm::vec4 outColor = glm::vec4(ColorUtils::tosRGBVec3(schema._albedo), schema._opacity);
         outColor = procedural->getColor(outColor);
-        procedural->prepare(batch, transform.getTranslation(), transform.getScale(), transform.getRotation(), _created,
-                            ProceduralProgramKey(outColor.a < 1.0f, _shapeKey.isDeformed(), _shapeKey.isDualQuatSkinned()));
+        if (!procedural->prepare(batch, transform.getTranslation(), transform.getScale(), transform.getRotation(), _created,
+                                 ProceduralProgramKey(outColor.a < 1.0f, _shapeKey.isDeformed(), _shapeKey.isDualQuatSkinned()))) {
+            return;
+        }
         batch._glColor4f(outColor.r, outColor.g, outColor.b, outColor.a);
     } else {
         // apply material properties
@@ -356,11 +374,122 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     // Draw!
     {
         PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
+        drawCall(batch, getLODPart(lodIndex));
+    }
+
+    const int INDICES_PER_TRIANGLE = 3;
+    args->_details._trianglesRendered += getLODPart(lodIndex)._numIndices / INDICES_PER_TRIANGLE;
+}
+
+int ModelMeshPartPayload::selectLOD(RenderArgs* args, const Transform& modelTransform) const {
+    if (!_drawMesh) {
+        return -1;
+    }
+    const auto& lods = _drawMesh->getLODs();
+    if (lods.empty() || (int)lods.front()._parts.size() <= _partIndex) {
+        return -1;
+    }
+    if (args->_renderMode == RenderArgs::RenderMode::SHADOW_RENDER_MODE) {
+        // the shadows are seen from the main view, at the detail of what casts them
+        return _lodIndex;
+    } else if (args->_renderMode != RenderArgs::RenderMode::DEFAULT_RENDER_MODE) {
+        return -1;
     }
 
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
+    auto worldBound = _adjustedLocalBound;
+    worldBound.transform(modelTransform);
+    float radius = 0.5f * glm::length(worldBound.getScale());
+    float distance = glm::distance(worldBound.calcCenter(), viewFrustum.getPosition()) - radius;
+    if (distance <= 0.0f) {
+        return -1;
+    }
+
+    // the errors of the LODs are in the units of the mesh, the pixels are those of the height of the viewport
+    glm::vec3 scale = glm::abs(modelTransform.getScale());
+    float maxScale = glm::max(scale.x, glm::max(scale.y, scale.z));
+    float pixelsPerUnit = maxScale * (float)args->_viewport.w /
+        (2.0f * tanf(0.5f * glm::radians(viewFrustum.getFieldOfView())) * distance);
+
+    int lodIndex = -1;
+    for (int i = 0; i < (int)lods.size() && lods[i]._error * pixelsPerUnit <= maxLODScreenError; ++i) {
+        lodIndex = i;
+    }
+    return lodIndex;
+}
+
+const graphics::Mesh::Part& ModelMeshPartPayload::getLODPart(int lodIndex) const {
+    return lodIndex >= 0 ? _drawMesh->getLODs()[lodIndex]._parts[_partIndex] : _drawPart;
+}
+
+void ModelMeshPartPayload::updateTexturePriorities(RenderArgs* args, const Transform& modelTransform) {
+    // Shadow casters are near the primary view without necessarily being on screen, so they give their textures a lower
+    // priority to have them resident before the view turns towards them
+    static const float SHADOW_PRIORITY_SCALE = 0.25f;
+
+    float scale;
+    glm::vec3 viewPosition;
+    if (args->_renderMode == RenderArgs::RenderMode::DEFAULT_RENDER_MODE) {
+        scale = 1.0f;
+        viewPosition = args->getViewFrustum().getPosition();
+    } else if (args->_renderMode == RenderArgs::RenderMode::SHADOW_RENDER_MODE) {
+        scale = SHADOW_PRIORITY_SCALE;
+        viewPosition = BillboardModeHelpers::getPrimaryViewFrustumPosition();
+    } else {
+        return;
+    }
+
+    auto worldBound = _adjustedLocalBound;
+    worldBound.transform(modelTransform);
+    float radius = 0.5f * glm::length(worldBound.getScale());
+    float distance = glm::distance(worldBound.calcCenter(), viewPosition);
+    // the ratio of the bounding sphere radius to its distance, which is proportional to its size on screen
+    float priority = scale * (distance > radius ? radius / distance : 1.0f);
+
+    for (const auto& texture : _drawMaterials.getTextureTable()->getTextures()) {
+        if (texture) {
+            texture->updatePriority(priority);
+        }
+    }
+}
+
+bool ModelMeshPartPayload::canRenderInstanced(RenderArgs* args) const {
+    // only the transform can differ between the instances of a draw, so the parts that need anything else set per item
+    // (deformation, billboarding, fading or a procedural material) are drawn on their own
+    return args->_enableInstancing && args->_shapePipeline && !_isSkinned && !_isBlendShaped &&
+        _billboardMode == BillboardMode::NONE && !_shapeKey.hasOwnPipeline() && _drawMaterials.size() == 1 &&
+        !render::ShapeKey(render::ShapeKey::Flags(args->_itemShapeKey)).isFaded();
+}
+
+void ModelMeshPartPayload::renderInstanced(RenderArgs* args, gpu::Batch& batch, int lodIndex) {
+    // the parts of all the copies of a model share their mesh and material, so they end up under the same name and are
+    // drawn by a single instanced call when the batch is flushed
+    auto pipeline = args->_shapePipeline;
+    std::string instanceName = "model_mesh_part_" + std::to_string(std::hash<const graphics::Mesh*>()(_drawMesh.get())) +
+        "_" + std::to_string(lodIndex) + "_" + std::to_string(_partIndex) +
+        "_" + std::to_string(std::hash<graphics::Material*>()(_drawMaterials.top().material.get())) +
+        "_" + std::to_string(std::hash<render::ShapePipelinePointer>()(pipeline));
+
+    // named calls run after the rest of the batch, the payloads outlive it
+    auto renderMode = args->_renderMode;
+    bool enableTexturing = args->_enableTexturing;
+    // the LOD is part of the name, the instances that aren't at the same one are drawn apart
+    const graphics::Mesh::Part part = getLODPart(lodIndex);
+    batch.setupNamedCalls(instanceName, [this, args, pipeline, renderMode, enableTexturing, lodIndex, part](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        batch.setPipeline(pipeline->pipeline);
+        pipeline->prepare(batch, args);
+
+        bindMesh(batch, lodIndex);
+        if (RenderPipelines::bindMaterials(_drawMaterials, batch, renderMode, enableTexturing)) {
+            args->_details._materialSwitches++;
+        }
+
+        PerformanceTimer perfTimer("batch.drawIndexedInstanced()");
+        batch.drawIndexedInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, part._numIndices, part._startIndex);
+    });
+
     const int INDICES_PER_TRIANGLE = 3;
-    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+    args->_details._trianglesRendered += part._numIndices / INDICES_PER_TRIANGLE;
 }
 
 bool ModelMeshPartPayload::passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const {
@@ -13,6 +13,7 @@
 #define hifi_MeshPartPayload_h
 
 #include "Model.h"
+#include "PreSkinnedMesh.h"
 
 #include <gpu/Batch.h>
 #include <render/Scene.h>
@@ -35,10 +36,13 @@ public:
 
     void updateTransformForSkinnedMesh(const Transform& modelTransform, const Model::MeshState& meshState, bool useDualQuaternionSkinning);
 
+    // when set the part draws the vertices the model skinned for this frame, and isn't skinned again in each pass
+    void setPreSkinnedMesh(const std::shared_ptr<PreSkinnedMesh>& preSkinnedMesh) { _preSkinnedMesh = preSkinnedMesh; }
+
     // ModelMeshPartPayload functions to perform render
-    void bindMesh(gpu::Batch& batch);
+    void bindMesh(gpu::Batch& batch, int lodIndex);
     virtual void bindTransform(gpu::Batch& batch, const Transform& transform, RenderArgs::RenderMode renderMode) const;
-    void drawCall(gpu::Batch& batch) const;
+    void drawCall(gpu::Batch& batch, const graphics::Mesh::Part& part) const;
 
     void updateKey(const render::ItemKey& key);
     void setShapeKey(bool invalidateShapeKey, PrimitiveMode primitiveMode, bool useDualQuaternionSkinning);
@@ -66,13 +70,25 @@ public:
     void setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers, const QVector<int>& blendedMeshSizes);
 
     static bool enableMaterialProceduralShaders;
+    // the largest error in pixels a simplified LOD of the mesh may show on screen
+    static float maxLODScreenError;
 
 private:
     void initCache(const ModelPointer& model, int shapeID);
 
+    void updateTexturePriorities(RenderArgs* args, const Transform& modelTransform);
+    // the coarsest LOD whose error stays under maxLODScreenError at the distance of the part, -1 for the full mesh
+    int selectLOD(RenderArgs* args, const Transform& modelTransform) const;
+    const graphics::Mesh::Part& getLODPart(int lodIndex) const;
+
+    bool canRenderInstanced(RenderArgs* args) const;
+    void renderInstanced(RenderArgs* args, gpu::Batch& batch, int lodIndex);
+
     int _meshIndex;
+    int _partIndex { 0 };
     std::shared_ptr<const graphics::Mesh> _drawMesh;
     graphics::Mesh::Part _drawPart;
+    int _lodIndex { -1 };    // chosen by the main view, the shadows follow it
     graphics::MultiMaterial _drawMaterials;
 
     gpu::BufferPointer _clusterBuffer;
@@ -82,6 +98,8 @@ private:
     gpu::BufferPointer _meshBlendshapeBuffer;
     int _meshNumVertices;
 
+    std::shared_ptr<PreSkinnedMesh> _preSkinnedMesh;
+
     render::ItemKey _itemKey { render::ItemKey::Builder::opaqueShape().build() };
     render::ShapeKey _shapeKey { render::ShapeKey::Builder::invalid() };
 
@@ -22,6 +22,7 @@
 #include <GeometryUtil.h>
 #include <PathUtils.h>
 #include <PerfStat.h>
+#include <PrioritySortUtil.h>
 #include <ViewFrustum.h>
 #include <GLMHelpers.h>
 #include <TBBHelpers.h>
@@ -35,6 +36,7 @@
 
 #include "AbstractViewStateInterface.h"
 #include "MeshPartPayload.h"
+#include "PreSkinnedMesh.h"
 
 #include "RenderUtilsLogging.h"
 #include <Trace.h>
@@ -48,6 +50,7 @@ int weakGeometryResourceBridgePointerTypeId = qRegisterMetaType<Geometry::WeakPo
 int vec3VectorTypeId = qRegisterMetaType<QVector<glm::vec3>>();
 int normalTypeVecTypeId = qRegisterMetaType<QVector<NormalType>>("QVector<NormalType>");
 float Model::FAKE_DIMENSION_PLACEHOLDER = -1.0f;
+bool Model::enablePreSkinning = false;
 #define HTTP_INVALID_COM "http://invalid.com"
 
 Model::Model(QObject* parent, SpatiallyNestable* spatiallyNestableOverride, uint64_t created) :
@@ -83,6 +86,33 @@ Model::~Model() {
 
 AbstractViewStateInterface* Model::_viewState = NULL;
 
+int Model::_numModelsFinalized { 0 };
+int Model::_numModelsWaitingToFinalize { 0 };
+uint64_t Model::_modelFinalizationTime { 0 };
+int Model::_prevNumModelsWaitingToFinalize { 0 };
+uint64_t Model::_prevModelFinalizationTime { 0 };
+
+void Model::startFinalizingModels() {
+    _prevNumModelsWaitingToFinalize = _numModelsWaitingToFinalize;
+    _prevModelFinalizationTime = _modelFinalizationTime;
+    _numModelsFinalized = 0;
+    _numModelsWaitingToFinalize = 0;
+    _modelFinalizationTime = 0;
+}
+
+bool Model::canFinalizeModel() {
+    if (_numModelsFinalized == 0 || _modelFinalizationTime < MAX_FINALIZE_MODELS_TIME_BUDGET) {
+        return true;
+    }
+    _numModelsWaitingToFinalize++;
+    return false;
+}
+
+void Model::modelFinalized(uint64_t usecs) {
+    _numModelsFinalized++;
+    _modelFinalizationTime += usecs;
+}
+
 bool Model::needsFixupInScene() const {
     return (_needsFixupInScene || !_addedToScene) && !_needsReload && isLoaded();
 }
@@ -223,6 +253,7 @@ void Model::updateRenderItems() {
         // lazy update of cluster matrices used for rendering.
         // We need to update them here so we can correctly update the bounding box.
         self->updateClusterMatrices();
+        self->updatePreSkinnedMeshes();
 
         Transform modelTransform = self->getTransform();
         modelTransform.setScale(glm::vec3(1.0f));
@@ -243,10 +274,14 @@ void Model::updateRenderItems() {
 
             bool invalidatePayloadShapeKey = self->shouldInvalidatePayloadShapeKey(meshIndex);
             bool useDualQuaternionSkinning = self->getUseDualQuaternionSkinning();
+            std::shared_ptr<PreSkinnedMesh> preSkinnedMesh;
+            if (meshIndex < (int)self->_preSkinnedMeshes.size()) {
+                preSkinnedMesh = self->_preSkinnedMeshes[meshIndex];
+            }
 
             transaction.updateItem<ModelMeshPartPayload>(itemID, [modelTransform, meshState, useDualQuaternionSkinning,
                                                                   invalidatePayloadShapeKey, primitiveMode, billboardMode, renderItemKeyGlobalFlags,
-                                                                  cauterized, renderWithZones](ModelMeshPartPayload& data) {
+                                                                  cauterized, renderWithZones, preSkinnedMesh](ModelMeshPartPayload& data) {
                 if (useDualQuaternionSkinning) {
                     data.updateClusterBuffer(meshState.clusterDualQuaternions);
                     data.computeAdjustedLocalBound(meshState.clusterDualQuaternions);
@@ -256,6 +291,7 @@ void Model::updateRenderItems() {
                 }
 
                 data.updateTransformForSkinnedMesh(modelTransform, meshState, useDualQuaternionSkinning);
+                data.setPreSkinnedMesh(preSkinnedMesh);
 
                 data.setCauterized(cauterized);
                 data.setRenderWithZones(renderWithZones);
@@ -269,6 +305,35 @@ void Model::updateRenderItems() {
     });
 }
 
+void Model::updatePreSkinnedMeshes() {
+    PerformanceTimer perfTimer("Model::updatePreSkinnedMeshes");
+
+    if (!enablePreSkinning || _useDualQuaternionSkinning) {
+        _preSkinnedMeshes.clear();
+        return;
+    }
+
+    const auto& meshes = _renderGeometry->getMeshes();
+    int numMeshes = std::min((int)meshes.size(), (int)_meshStates.size());
+    if (_preSkinnedMeshes.empty()) {
+        // the blendshapes are blended in the vertex shader before it skins, those meshes are left to it, and so are the
+        // ones with one or two clusters, that their parts only move with the transform of the first
+        const HFMModel& hfmModel = getHFMModel();
+        _preSkinnedMeshes.resize(numMeshes);
+        for (int i = 0; i < numMeshes; i++) {
+            if (meshes.at(i) && hfmModel.meshes.at(i).blendshapes.isEmpty() && _meshStates[i].clusterMatrices.size() > 2) {
+                _preSkinnedMeshes[i] = PreSkinnedMesh::create(*meshes.at(i));
+            }
+        }
+    }
+
+    for (int i = 0; i < numMeshes && i < (int)_preSkinnedMeshes.size(); i++) {
+        if (_preSkinnedMeshes[i]) {
+            _preSkinnedMeshes[i]->update(_meshStates[i].clusterMatrices);
+        }
+    }
+}
+
 void Model::setRenderItemsNeedUpdate() {
     _renderItemsNeedUpdate = true;
     emit requestRenderUpdate();
@@ -1292,6 +1357,13 @@ void Model::setURL(const QUrl& url) {
     onInvalidate();
 }
 
+void Model::setLoadingPriority(float priority) {
+    if (priority != _loadingPriority) {
+        _loadingPriority = priority;
+        _renderWatcher.setLoadPriority(this, priority);
+    }
+}
+
 void Model::loadURLFinished(bool success) {
     if (!success) {
         _visualGeometryRequestFailed = true;
@@ -1508,10 +1580,27 @@ void Model::updateClusterMatrices() {
     updateBlendshapes();
 }
 
+// whether the coefficients moved enough from the ones last blended to be worth blending and uploading again.
+// the faces of talking avatars change their coefficients by tiny amounts from one update to the next, those add up
+// since they are compared to the last blended coefficients rather than to the previous ones.
+static bool haveBlendshapeCoefficientsChanged(const QVector<float>& coefficients, const QVector<float>& blendedCoefficients) {
+    if (coefficients.size() != blendedCoefficients.size()) {
+        return true;
+    }
+    const float BLENDSHAPE_COEFFICIENT_EPSILON = 0.002f;
+    for (int i = 0; i < coefficients.size(); i++) {
+        if (fabsf(coefficients[i] - blendedCoefficients[i]) > BLENDSHAPE_COEFFICIENT_EPSILON) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Model::updateBlendshapes() {
     // post the blender if we're not currently waiting for one to finish
     auto modelBlender = DependencyManager::get<ModelBlender>();
-    if (modelBlender->shouldComputeBlendshapes() && getHFMModel().hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
+    if (modelBlender->shouldComputeBlendshapes() && getHFMModel().hasBlendedMeshes() &&
+        haveBlendshapeCoefficientsChanged(_blendshapeCoefficients, _blendedBlendshapeCoefficients)) {
         _blendedBlendshapeCoefficients = _blendshapeCoefficients;
         modelBlender->noteRequiresBlend(getThisPointer());
     }
@@ -1519,6 +1608,7 @@ void Model::updateBlendshapes() {
 
 void Model::deleteGeometry() {
     _meshStates.clear();
+    _preSkinnedMeshes.clear();
     _rig.destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
     _renderGeometry.reset();
@@ -1881,6 +1971,23 @@ void Blender::run() {
     QVector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
     unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
 
+    // the blendshapes of a mesh usually move a small part of its vertices (the face of a whole avatar mesh), so only the
+    // vertices they touch are accumulated and packed, the others get the packed zero offset.
+    std::vector<bool> isVertexBlended(maxBlendshapeOffsets, false);  // reuse for all meshes
+    std::vector<int> blendedVertices;
+    blendedVertices.reserve(maxBlendshapeOffsets);
+    std::vector<BlendshapeOffsetUnpacked> unpackedBlendedOffsets;
+    unpackedBlendedOffsets.reserve(maxBlendshapeOffsets);
+    std::vector<BlendshapeOffset> packedBlendedOffsets;
+    packedBlendedOffsets.reserve(maxBlendshapeOffsets);
+
+    BlendshapeOffset packedZeroOffset;
+    {
+        BlendshapeOffsetUnpacked zeroOffset;
+        memset(&zeroOffset, 0, sizeof(BlendshapeOffsetUnpacked));
+        packBlendshapeOffsets(&zeroOffset, &packedZeroOffset, 1);
+    }
+
     int offset = 0;
     for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
         if (meshIter->blendshapes.isEmpty()) {
@@ -1890,8 +1997,7 @@ void Blender::run() {
         int numVertsInMesh = meshIter->vertices.size();
         blendedMeshSizes.push_back(numVertsInMesh);
 
-        // initialize offsets to zero
-        memset(unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
+        blendedVertices.clear();
 
         // for each blendshape in this mesh, accumulate the offsets into unpackedBlendshapeOffsets.
         const float NORMAL_COEFFICIENT_SCALE = 0.01f;
@@ -1908,6 +2014,12 @@ void Blender::run() {
                 int index = blendshape.indices.at(j);
 
                 auto& currentBlendshapeOffset = unpackedBlendshapeOffsets[index];
+                if (!isVertexBlended[index]) {
+                    // initialize offsets to zero
+                    isVertexBlended[index] = true;
+                    blendedVertices.push_back(index);
+                    memset(&currentBlendshapeOffset, 0, sizeof(BlendshapeOffsetUnpacked));
+                }
                 currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
                 currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
                 if (j < blendshape.tangents.size()) {
@@ -1917,9 +2029,22 @@ void Blender::run() {
         }
 
         // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
-        auto unpacked = unpackedBlendshapeOffsets.data();
+        // the blended vertices are gathered so that they are packed together, then scattered to their place.
         auto packed = packedBlendshapeOffsets.data() + offset;
-        packBlendshapeOffsets(unpacked, packed, numVertsInMesh);
+        std::fill(packed, packed + numVertsInMesh, packedZeroOffset);
+        int numBlendedVertices = (int)blendedVertices.size();
+        if (numBlendedVertices > 0) {
+            unpackedBlendedOffsets.resize(numBlendedVertices);
+            packedBlendedOffsets.resize(numBlendedVertices);
+            for (int i = 0; i < numBlendedVertices; i++) {
+                unpackedBlendedOffsets[i] = unpackedBlendshapeOffsets[blendedVertices[i]];
+            }
+            packBlendshapeOffsets(unpackedBlendedOffsets.data(), packedBlendedOffsets.data(), numBlendedVertices);
+            for (int i = 0; i < numBlendedVertices; i++) {
+                packed[blendedVertices[i]] = packedBlendedOffsets[i];
+                isVertexBlended[blendedVertices[i]] = false;
+            }
+        }
 
         offset += numVertsInMesh;
     }
@@ -57,6 +57,7 @@ namespace render {
 class MeshPartPayload;
 class ModelMeshPartPayload;
 class ModelRenderLocations;
+class PreSkinnedMesh;
 
 inline uint qHash(const std::shared_ptr<MeshPartPayload>& a, uint seed) {
     return qHash(a.get(), seed);
@@ -89,6 +90,19 @@ public:
 
     static void setAbstractViewStateInterface(AbstractViewStateInterface* viewState) { _viewState = viewState; }
 
+    // Adding loaded models to the scene (their joint states, render payloads and materials) is given a budget of main
+    // thread time per frame, so that the frames in which many models finish loading don't stall: the models that don't fit
+    // in the budget wait for the next frame. At least one model is added per frame, however long it takes.
+    static void startFinalizingModels();
+    static bool canFinalizeModel();
+    static void modelFinalized(uint64_t usecs);
+    static int getPrevNumModelsWaitingToFinalize() { return _prevNumModelsWaitingToFinalize; }
+    static uint64_t getPrevModelFinalizationTime() { return _prevModelFinalizationTime; }
+
+    // skins the meshes on the CPU once a frame for all the passes that draw them, rather than in the vertex shader of
+    // every pass, see PreSkinnedMesh
+    static bool enablePreSkinning;
+
     Model(QObject* parent = nullptr, SpatiallyNestable* spatiallyNestableOverride = nullptr, uint64_t created = 0);
     virtual ~Model();
 
@@ -287,7 +301,8 @@ public:
     // returns 'true' if needs fullUpdate after geometry change
     virtual bool updateGeometry();
 
-    void setLoadingPriority(float priority) { _loadingPriority = priority; }
+    // also moves the model up or down the download queue while it is loading
+    void setLoadingPriority(float priority);
 
     size_t getRenderInfoVertexCount() const { return _renderInfoVertexCount; }
     size_t getRenderInfoTextureSize();
@@ -420,6 +435,7 @@ protected:
     bool _forceOffset { false };
 
     std::vector<MeshState> _meshStates;
+    std::vector<std::shared_ptr<PreSkinnedMesh>> _preSkinnedMeshes;    // by mesh, null for the ones skinned on the GPU
 
     virtual void initJointStates();
 
@@ -453,6 +469,8 @@ protected:
 
     virtual void createRenderItemSet();
 
+    void updatePreSkinnedMeshes();
+
     PrimitiveMode _primitiveMode { PrimitiveMode::SOLID };
     BillboardMode _billboardMode { BillboardMode::NONE };
     bool _useDualQuaternionSkinning { false };
@@ -462,6 +480,13 @@ protected:
 
     static AbstractViewStateInterface* _viewState;
 
+    // main thread only
+    static int _numModelsFinalized;
+    static int _numModelsWaitingToFinalize;
+    static uint64_t _modelFinalizationTime;
+    static int _prevNumModelsWaitingToFinalize;
+    static uint64_t _prevModelFinalizationTime;
+
     QVector<std::shared_ptr<ModelMeshPartPayload>> _modelMeshRenderItems;
     QMap<render::ItemID, render::PayloadPointer> _modelMeshRenderItemsMap;
     render::ItemIDs _modelMeshRenderItemIDs;
@@ -0,0 +1,195 @@
+//
+//  PreSkinnedMesh.cpp
+//  libraries/render-utils/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PreSkinnedMesh.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <glm/gtc/packing.hpp>
+
+#include <GLMHelpers.h>
+#include <TBBHelpers.h>
+
+static const size_t SKINNING_GRAIN_VERTICES = 1024;
+static const int INDICES_PER_VERTEX = 4;
+
+static bool isNormalElement(const gpu::Element& element, bool& isPacked) {
+    isPacked = element.getType() == gpu::NINT2_10_10_10;
+    return isPacked || element == gpu::Element::VEC3F_XYZ;
+}
+
+static glm::vec3 readNormal(const gpu::Byte* data, bool isPacked) {
+    if (isPacked) {
+        glm::uint32 packed;
+        memcpy(&packed, data, sizeof(packed));
+        return glm::vec3(glm::unpackSnorm3x10_1x2(packed));
+    }
+    glm::vec3 normal;
+    memcpy(&normal, data, sizeof(normal));
+    return normal;
+}
+
+static void writeNormal(gpu::Byte* data, glm::vec3 normal, bool isPacked) {
+    if (isPacked) {
+        // scaled up to the largest coordinate for the precision of the packing, as BuildGraphicsMeshTask does
+        float maxCoord = glm::max(fabsf(normal.x), glm::max(fabsf(normal.y), fabsf(normal.z)));
+        if (maxCoord > 1e-6f) {
+            normal /= maxCoord;
+        }
+        glm::uint32 packed = glm_packSnorm3x10_1x2(glm::vec4(normal, 0.0f));
+        memcpy(data, &packed, sizeof(packed));
+    } else {
+        memcpy(data, &normal, sizeof(normal));
+    }
+}
+
+std::shared_ptr<PreSkinnedMesh> PreSkinnedMesh::create(const graphics::Mesh& mesh) {
+    auto format = mesh.getVertexFormat();
+    if (!format || !format->hasAttribute(gpu::Stream::POSITION) || !format->hasAttribute(gpu::Stream::SKIN_CLUSTER_INDEX) ||
+        !format->hasAttribute(gpu::Stream::SKIN_CLUSTER_WEIGHT)) {
+        return nullptr;
+    }
+
+    // all the attributes come from the one interleaved buffer
+    auto position = format->getAttribute(gpu::Stream::POSITION);
+    for (const auto& attribute : format->getAttributes()) {
+        if (attribute.second._channel != position._channel) {
+            return nullptr;
+        }
+    }
+    const auto& stream = mesh.getVertexStream();
+    if ((size_t)position._channel >= stream.getBuffers().size() || !stream.getBuffers()[position._channel]) {
+        return nullptr;
+    }
+    const auto& buffer = stream.getBuffers()[position._channel];
+    gpu::Offset bufferOffset = stream.getOffsets()[position._channel];
+    gpu::Offset stride = stream.getStrides()[position._channel];
+    size_t numVertices = mesh.getNumVertices();
+    if (numVertices == 0 || stride == 0 || bufferOffset + numVertices * stride > buffer->getSize()) {
+        return nullptr;
+    }
+
+    auto clusterIndex = format->getAttribute(gpu::Stream::SKIN_CLUSTER_INDEX);
+    auto clusterWeight = format->getAttribute(gpu::Stream::SKIN_CLUSTER_WEIGHT);
+    bool isWideClusterIndex = clusterIndex._element.getType() == gpu::UINT16;
+    if (position._element != gpu::Element::VEC3F_XYZ || clusterIndex._element.getDimension() != gpu::VEC4 ||
+        (!isWideClusterIndex && clusterIndex._element.getType() != gpu::UINT8) ||
+        clusterWeight._element != gpu::Element(gpu::VEC4, gpu::NUINT16, gpu::XYZW)) {
+        return nullptr;
+    }
+
+    std::shared_ptr<PreSkinnedMesh> preSkinnedMesh(new PreSkinnedMesh());
+    preSkinnedMesh->_stride = stride;
+    preSkinnedMesh->_positionOffset = position._offset;
+    if (format->hasAttribute(gpu::Stream::NORMAL)) {
+        auto normal = format->getAttribute(gpu::Stream::NORMAL);
+        if (!isNormalElement(normal._element, preSkinnedMesh->_isPackedNormals)) {
+            return nullptr;
+        }
+        preSkinnedMesh->_normalOffset = (int)normal._offset;
+
+        if (format->hasAttribute(gpu::Stream::TANGENT)) {
+            auto tangent = format->getAttribute(gpu::Stream::TANGENT);
+            bool isPackedTangent;
+            if (!isNormalElement(tangent._element, isPackedTangent) || isPackedTangent != preSkinnedMesh->_isPackedNormals) {
+                return nullptr;
+            }
+            preSkinnedMesh->_tangentOffset = (int)tangent._offset;
+        }
+    }
+
+    auto& vertices = preSkinnedMesh->_vertices;
+    vertices.resize(numVertices * stride);
+    memcpy(vertices.data(), buffer->getData() + bufferOffset, vertices.size());
+
+    preSkinnedMesh->_positions.resize(numVertices);
+    if (preSkinnedMesh->_normalOffset >= 0) {
+        preSkinnedMesh->_normals.resize(numVertices);
+    }
+    if (preSkinnedMesh->_tangentOffset >= 0) {
+        preSkinnedMesh->_tangents.resize(numVertices);
+    }
+    preSkinnedMesh->_clusterIndices.resize(numVertices);
+    preSkinnedMesh->_clusterWeights.resize(numVertices);
+
+    for (size_t i = 0; i < numVertices; ++i) {
+        const gpu::Byte* vertex = vertices.data() + i * stride;
+        memcpy(&preSkinnedMesh->_positions[i], vertex + position._offset, sizeof(glm::vec3));
+        if (preSkinnedMesh->_normalOffset >= 0) {
+            preSkinnedMesh->_normals[i] = readNormal(vertex + preSkinnedMesh->_normalOffset, preSkinnedMesh->_isPackedNormals);
+        }
+        if (preSkinnedMesh->_tangentOffset >= 0) {
+            preSkinnedMesh->_tangents[i] = readNormal(vertex + preSkinnedMesh->_tangentOffset, preSkinnedMesh->_isPackedNormals);
+        }
+
+        if (isWideClusterIndex) {
+            memcpy(&preSkinnedMesh->_clusterIndices[i], vertex + clusterIndex._offset, sizeof(glm::u16vec4));
+        } else {
+            glm::u8vec4 indices;
+            memcpy(&indices, vertex + clusterIndex._offset, sizeof(indices));
+            preSkinnedMesh->_clusterIndices[i] = glm::u16vec4(indices);
+        }
+
+        glm::u16vec4 weights;
+        memcpy(&weights, vertex + clusterWeight._offset, sizeof(weights));
+        preSkinnedMesh->_clusterWeights[i] = glm::vec4(weights) / (float)UINT16_MAX;
+    }
+
+    preSkinnedMesh->_buffer = std::make_shared<gpu::Buffer>(vertices.size(), vertices.data());
+    // the same stream as the mesh's, the skinned copy instead of its vertices
+    for (size_t channel = 0; channel < stream.getBuffers().size(); ++channel) {
+        if (channel == position._channel) {
+            preSkinnedMesh->_vertexStream.addBuffer(preSkinnedMesh->_buffer, 0, stride);
+        } else {
+            preSkinnedMesh->_vertexStream.addBuffer(stream.getBuffers()[channel], stream.getOffsets()[channel],
+                                                    stream.getStrides()[channel]);
+        }
+    }
+    return preSkinnedMesh;
+}
+
+void PreSkinnedMesh::update(const std::vector<glm::mat4>& clusterMatrices) {
+    size_t numVertices = _positions.size();
+    size_t numClusters = clusterMatrices.size();
+    if (numClusters == 0) {
+        return;
+    }
+
+    // the same blend as the linear skinning of Skinning.slh
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numVertices, SKINNING_GRAIN_VERTICES), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            glm::mat4 clusterMatrix(0.0f);
+            for (int j = 0; j < INDICES_PER_VERTEX; ++j) {
+                float weight = _clusterWeights[i][j];
+                size_t index = _clusterIndices[i][j];
+                if (weight > 0.0f && index < numClusters) {
+                    clusterMatrix += clusterMatrices[index] * weight;
+                }
+            }
+
+            gpu::Byte* vertex = _vertices.data() + i * _stride;
+            glm::vec3 position = glm::vec3(clusterMatrix * glm::vec4(_positions[i], 1.0f));
+            memcpy(vertex + _positionOffset, &position, sizeof(position));
+
+            glm::mat3 normalMatrix(clusterMatrix);
+            if (_normalOffset >= 0) {
+                writeNormal(vertex + _normalOffset, normalMatrix * _normals[i], _isPackedNormals);
+            }
+            if (_tangentOffset >= 0) {
+                writeNormal(vertex + _tangentOffset, normalMatrix * _tangents[i], _isPackedNormals);
+            }
+        }
+    });
+
+    _buffer->setSubData(0, _vertices.size(), _vertices.data());
+}
@@ -0,0 +1,63 @@
+//
+//  PreSkinnedMesh.h
+//  libraries/render-utils/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PreSkinnedMesh_h
+#define hifi_PreSkinnedMesh_h
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <gpu/Stream.h>
+#include <graphics/Geometry.h>
+
+// The vertices of a skinned mesh, skinned once a frame on the CPU for all the passes that draw the mesh: the main view,
+// every shadow cascade and the secondary camera. The parts of the mesh draw from its vertex stream with the pipelines
+// of the meshes that aren't deformed, instead of skinning the same vertices again in each pass.
+//
+// Only matrix palette skinning is done, and only for the interleaved vertices BuildGraphicsMeshTask lays out.
+class PreSkinnedMesh {
+public:
+    // null when the mesh isn't skinned, or its vertices aren't in a layout this can skin
+    static std::shared_ptr<PreSkinnedMesh> create(const graphics::Mesh& mesh);
+
+    void update(const std::vector<glm::mat4>& clusterMatrices);
+
+    const gpu::BufferStream& getVertexStream() const { return _vertexStream; }
+
+private:
+    PreSkinnedMesh() {}
+
+    // where the skinned attributes are in the record of a vertex, -1 for a missing one
+    gpu::Offset _stride { 0 };
+    gpu::Offset _positionOffset { 0 };
+    int _normalOffset { -1 };
+    int _tangentOffset { -1 };
+    bool _isPackedNormals { false };
+
+    // what the mesh was skinned from
+    std::vector<glm::vec3> _positions;
+    std::vector<glm::vec3> _normals;
+    std::vector<glm::vec3> _tangents;
+    std::vector<glm::u16vec4> _clusterIndices;
+    std::vector<glm::vec4> _clusterWeights;
+
+    // a copy of the vertices of the mesh, the skinned attributes are written over at every update
+    std::vector<gpu::Byte> _vertices;
+    gpu::BufferPointer _buffer;
+    gpu::BufferStream _vertexStream;
+};
+
+#endif // hifi_PreSkinnedMesh_h
@@ -63,6 +63,7 @@ class DrawStateSortConfig : public render::Job::Config {
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
     Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
     Q_PROPERTY(bool stateSort MEMBER stateSort NOTIFY dirty)
+    Q_PROPERTY(bool instancing MEMBER instancing NOTIFY dirty)
 public:
     int getNumDrawn() { return numDrawn; }
     void setNumDrawn(int num) {
@@ -72,6 +73,7 @@ public:
 
     int maxDrawn{ -1 };
     bool stateSort{ true };
+    bool instancing{ true }; // draw the parts of copies of a model with instanced calls when state sorting
 
 signals:
     void numDrawnChanged();
@@ -95,6 +97,7 @@ public:
     void configure(const Config& config) {
         _maxDrawn = config.maxDrawn;
         _stateSort = config.stateSort;
+        _instancing = config.instancing;
     }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
@@ -102,6 +105,7 @@ protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn;  // initialized by Config
     bool _stateSort;
+    bool _instancing;
 };
 
 class SetSeparateDeferredDepthBuffer {
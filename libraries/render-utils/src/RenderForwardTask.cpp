@@ -25,6 +25,7 @@
 #include "RenderHifi.h"
 #include "render-utils/ShaderConstants.h"
 #include "StencilMaskPass.h"
+#include "Foveation.h"
 #include "ZoneRenderer.h"
 #include "FadeEffect.h"
 #include "ToneMapAndResampleTask.h"
@@ -156,6 +157,9 @@ void RenderForwardTask::build(JobModel& task, const render::Varying& input, rend
     const auto resolveInputs = ResolveFramebuffer::Inputs(scaledPrimaryFramebuffer, newResolvedFramebuffer).asVarying();
     const auto resolvedFramebuffer = task.addJob<ResolveFramebuffer>("Resolve", resolveInputs);
 
+    // Fill the pixels skipped by the foveation
+    task.addJob<FillFoveation>("FillFoveation", resolvedFramebuffer);
+
     const auto destFramebuffer = static_cast<gpu::FramebufferPointer>(nullptr);
 
     const auto toneMappingInputs = ToneMapAndResample::Input(resolvedFramebuffer, destFramebuffer).asVarying();
@@ -13,6 +13,7 @@
 
 #include <gpu/Context.h>
 
+#include <RegisteredMetaTypes.h>
 #include <ViewFrustum.h>
 
 #include <render/CullTask.h>
@@ -78,47 +79,51 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
     const auto sortedPipelines = task.addJob<PipelineSortShapes>("PipelineSortShadow", culledShadowItems);
     const auto sortedShapes = task.addJob<DepthSortShapes>("DepthSortShadow", sortedPipelines, true);
 
-    render::Varying cascadeFrustums[SHADOW_CASCADE_MAX_COUNT] = {
-        ViewFrustumPointer()
-#if SHADOW_CASCADE_MAX_COUNT>1
-        ,ViewFrustumPointer(),
-        ViewFrustumPointer(),
-        ViewFrustumPointer()
-#endif
-    };
+    const auto cascadesInputs = RenderShadowCascadesTask::Input(sortedShapes, shadowFrame, currentKeyLight).asVarying();
+    const auto cascadeSceneBBoxes = task.addJob<RenderShadowCascadesTask>("ShadowCascades", cascadesInputs, shapePlumber, shadowCasterReceiverFilter);
+    task.addJob<RenderShadowTeardown>("ShadowTeardown", setupOutput);
 
-    CascadeBoxes cascadeSceneBBoxes;
 
-    for (auto i = 0; i < SHADOW_CASCADE_MAX_COUNT; i++) {
-        char jobName[64];
-        sprintf(jobName, "ShadowCascadeSetup%d", i);
-        const auto cascadeSetupOutput = task.addJob<RenderShadowCascadeSetup>(jobName, shadowFrame, i, shadowCasterReceiverFilter);
-        const auto shadowFilter = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(0);
-        auto antiFrustum = render::Varying(ViewFrustumPointer());
-        cascadeFrustums[i] = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(1);
-        if (i > 1) {
-            antiFrustum = cascadeFrustums[i - 2];
-        }
+    output = Output(cascadeSceneBBoxes, setupOutput.getN<RenderShadowSetup::Output>(3));
 
-        const auto cullInputs = CullShadowBounds::Inputs(sortedShapes, shadowFilter, antiFrustum, currentKeyLight, cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(2)).asVarying();
-        sprintf(jobName, "CullShadowCascade%d", i);
-        const auto culledShadowItemsAndBounds = task.addJob<CullShadowBounds>(jobName, cullInputs);
+}
 
-        // GPU jobs: Render to shadow map
-        sprintf(jobName, "RenderShadowMap%d", i);
-        const auto shadowInputs = RenderShadowMap::Inputs(culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(0),
-            culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1), shadowFrame).asVarying();
-        task.addJob<RenderShadowMap>(jobName, shadowInputs, shapePlumber, i);
-        sprintf(jobName, "ShadowCascadeTeardown%d", i);
-        task.addJob<RenderShadowCascadeTeardown>(jobName, shadowFilter);
+void RenderShadowCascadeTask::build(JobModel& task, const render::Varying& input, render::Varying& output, render::ShapePlumberPointer shapePlumber,
+        unsigned int cascadeIndex, render::ItemFilter filter) {
+    const auto& sortedShapes = input.getN<Input>(0);
+    const auto& shadowFrame = input.getN<Input>(1);
+    const auto& currentKeyLight = input.getN<Input>(2);
+
+    char jobName[64];
+    sprintf(jobName, "ShadowCascadeSetup%d", cascadeIndex);
+    const auto cascadeSetupOutput = task.addJob<RenderShadowCascadeSetup>(jobName, shadowFrame, cascadeIndex, filter);
+    const auto shadowFilter = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(0);
+    const auto antiFrustum = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(3);
+
+    const auto cullInputs = CullShadowBounds::Inputs(sortedShapes, shadowFilter, antiFrustum, currentKeyLight, cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(2)).asVarying();
+    sprintf(jobName, "CullShadowCascade%d", cascadeIndex);
+    const auto culledShadowItemsAndBounds = task.addJob<CullShadowBounds>(jobName, cullInputs);
+
+    // GPU jobs: Render to shadow map
+    sprintf(jobName, "RenderShadowMap%d", cascadeIndex);
+    const auto shadowInputs = RenderShadowMap::Inputs(culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(0),
+        culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1), shadowFrame).asVarying();
+    task.addJob<RenderShadowMap>(jobName, shadowInputs, shapePlumber, cascadeIndex);
+    sprintf(jobName, "ShadowCascadeTeardown%d", cascadeIndex);
+    task.addJob<RenderShadowCascadeTeardown>(jobName, shadowFilter);
+
+    output = culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1);
+}
 
-        cascadeSceneBBoxes[i] = culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1);
+void RenderShadowCascadesTask::build(JobModel& task, const render::Varying& input, render::Varying& output, render::ShapePlumberPointer shapePlumber,
+        render::ItemFilter filter) {
+    RenderShadowTask::CascadeBoxes cascadeSceneBBoxes;
+    for (auto i = 0; i < SHADOW_CASCADE_MAX_COUNT; i++) {
+        char jobName[64];
+        sprintf(jobName, "ShadowCascade%d", i);
+        cascadeSceneBBoxes[i] = task.addJob<RenderShadowCascadeTask>(jobName, input, shapePlumber, i, filter);
     }
-    task.addJob<RenderShadowTeardown>("ShadowTeardown", setupOutput);
-
-
-    output = Output(cascadeSceneBBoxes, setupOutput.getN<RenderShadowSetup::Output>(3));
-
+    output = cascadeSceneBBoxes;
 }
 
 static void computeNearFar(const Triangle& triangle, const Plane shadowClipPlanes[4], float& near, float& far) {
@@ -203,6 +208,112 @@ static void adjustNearFar(const AABox& inShapeBounds, ViewFrustum& shadowFrustum
     }
 }
 
+void RenderShadowMap::configure(const Config& config) {
+    _cached = config.cached;
+    if (!_cached) {
+        _isCacheValid = false;
+        _staticCache.reset();
+        _previousBounds.clear();
+    }
+}
+
+bool RenderShadowMap::splitStaticCasters(const ShapeBounds& inShapes, const ViewFrustum& frustum, ShapeBounds& staticShapes,
+        ShapeBounds& dynamicShapes) {
+    std::unordered_map<ItemID, AABox> bounds;
+    size_t staticItemsHash = 0;
+    size_t numStaticItems = 0;
+    for (const auto& items : inShapes) {
+        const auto& key = items.first;
+        // Deformed and procedural casters can change without their bounds changing, and fading ones change every frame
+        bool canBeStatic = !key.isDeformed() && !key.hasOwnPipeline() && !key.isFaded();
+        for (const auto& item : items.second) {
+            bounds[item.id] = item.bound;
+            bool isStatic = false;
+            if (canBeStatic) {
+                auto previous = _previousBounds.find(item.id);
+                isStatic = previous != _previousBounds.end() && previous->second == item.bound;
+            }
+            if (isStatic) {
+                staticShapes[key].push_back(item);
+                // the casters aren't always in the same order, so the hash mustn't depend on it
+                staticItemsHash ^= std::hash<ItemID>()(item.id);
+                numStaticItems++;
+            } else {
+                dynamicShapes[key].push_back(item);
+            }
+        }
+    }
+    _previousBounds.swap(bounds);
+    std::hash_combine(staticItemsHash, numStaticItems);
+
+    glm::mat4 view = frustum.getView();
+    glm::mat4 projection = frustum.getProjection();
+    bool isCacheValid = _isCacheValid && staticItemsHash == _cachedStaticItemsHash && view == _cachedView &&
+        projection == _cachedProjection;
+    _cachedStaticItemsHash = staticItemsHash;
+    _cachedView = view;
+    _cachedProjection = projection;
+    _isCacheValid = true;
+    return !isCacheValid;
+}
+
+void RenderShadowMap::renderCasters(const render::RenderContextPointer& renderContext, const ShapeBounds& inShapes) {
+    RenderArgs* args = renderContext->args;
+
+    const std::vector<ShapeKey::Builder> keys = {
+        ShapeKey::Builder(), ShapeKey::Builder().withFade(),
+        ShapeKey::Builder().withDeformed(), ShapeKey::Builder().withDeformed().withFade(),
+        ShapeKey::Builder().withDeformed().withDualQuatSkinned(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withFade(),
+        ShapeKey::Builder().withOwnPipeline(), ShapeKey::Builder().withOwnPipeline().withFade(),
+        ShapeKey::Builder().withDeformed().withOwnPipeline(), ShapeKey::Builder().withDeformed().withOwnPipeline().withFade(),
+        ShapeKey::Builder().withDeformed().withDualQuatSkinned().withOwnPipeline(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withOwnPipeline().withFade(),
+    };
+    std::vector<std::vector<ShapeKey>> sortedShapeKeys(keys.size());
+
+    const int OWN_PIPELINE_INDEX = 6;
+    for (const auto& items : inShapes) {
+        int index = items.first.hasOwnPipeline() ? OWN_PIPELINE_INDEX : 0;
+        if (items.first.isDeformed()) {
+            index += 2;
+            if (items.first.isDualQuatSkinned()) {
+                index += 2;
+            }
+        }
+
+        if (items.first.isFaded()) {
+            index += 1;
+        }
+
+        sortedShapeKeys[index].push_back(items.first);
+    }
+
+    // Render non-withOwnPipeline things
+    for (size_t i = 0; i < OWN_PIPELINE_INDEX; i++) {
+        auto& shapeKeys = sortedShapeKeys[i];
+        if (shapeKeys.size() > 0) {
+            const auto& shapePipeline = _shapePlumber->pickPipeline(args, keys[i]);
+            args->_shapePipeline = shapePipeline;
+            for (const auto& key : shapeKeys) {
+                renderShapes(renderContext, _shapePlumber, inShapes.at(key));
+            }
+        }
+    }
+
+    // Render withOwnPipeline things
+    for (size_t i = OWN_PIPELINE_INDEX; i < keys.size(); i++) {
+        auto& shapeKeys = sortedShapeKeys[i];
+        if (shapeKeys.size() > 0) {
+            args->_shapePipeline = nullptr;
+            for (const auto& key : shapeKeys) {
+                args->_itemShapeKey = key._flags.to_ulong();
+                renderShapes(renderContext, _shapePlumber, inShapes.at(key));
+            }
+        }
+    }
+
+    args->_shapePipeline = nullptr;
+}
+
 void RenderShadowMap::run(const render::RenderContextPointer& renderContext, const Inputs& inputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -233,6 +344,23 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
     args->popViewFrustum();
     args->pushViewFrustum(adjustedShadowFrustum);
 
+    bool useCache = _cached && !inShapeBounds.isNull();
+    ShapeBounds staticShapes;
+    ShapeBounds dynamicShapes;
+    bool drawStatic = true;
+    if (useCache) {
+        if (!_staticCache || _staticCache->getSize() != fbo->getSize()) {
+            auto depthFormat = shadow->map->getTexelFormat();
+            auto depthTexture = gpu::Texture::createRenderBuffer(depthFormat, fbo->getWidth(), fbo->getHeight());
+            _staticCache = gpu::FramebufferPointer(gpu::Framebuffer::create("shadowStaticCache"));
+            _staticCache->setDepthBuffer(depthTexture, depthFormat);
+            _isCacheValid = false;
+        }
+        drawStatic = splitStaticCasters(inShapes, adjustedShadowFrustum, staticShapes, dynamicShapes);
+    } else {
+        _isCacheValid = false;
+    }
+
     gpu::doInBatch("RenderShadowMap::run", args->_context, [&](gpu::Batch& batch) {
         args->_batch = &batch;
         batch.enableStereo(false);
@@ -242,7 +370,11 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
         batch.setStateScissorRect(viewport);
 
         batch.setFramebuffer(fbo);
-        batch.clearDepthFramebuffer(1.0, false);
+        if (drawStatic) {
+            batch.clearDepthFramebuffer(1.0, false);
+        } else {
+            batch.blit(_staticCache, viewport, fbo, viewport);
+        }
 
         if (!inShapeBounds.isNull()) {
             glm::mat4 projMat;
@@ -253,58 +385,15 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
             batch.setProjectionTransform(projMat);
             batch.setViewTransform(viewMat, false);
 
-            const std::vector<ShapeKey::Builder> keys = {
-                ShapeKey::Builder(), ShapeKey::Builder().withFade(),
-                ShapeKey::Builder().withDeformed(), ShapeKey::Builder().withDeformed().withFade(),
-                ShapeKey::Builder().withDeformed().withDualQuatSkinned(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withFade(),
-                ShapeKey::Builder().withOwnPipeline(), ShapeKey::Builder().withOwnPipeline().withFade(),
-                ShapeKey::Builder().withDeformed().withOwnPipeline(), ShapeKey::Builder().withDeformed().withOwnPipeline().withFade(),
-                ShapeKey::Builder().withDeformed().withDualQuatSkinned().withOwnPipeline(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withOwnPipeline().withFade(),
-            };
-            std::vector<std::vector<ShapeKey>> sortedShapeKeys(keys.size());
-
-            const int OWN_PIPELINE_INDEX = 6;
-            for (const auto& items : inShapes) {
-                int index = items.first.hasOwnPipeline() ? OWN_PIPELINE_INDEX : 0;
-                if (items.first.isDeformed()) {
-                    index += 2;
-                    if (items.first.isDualQuatSkinned()) {
-                        index += 2;
-                    }
-                }
-
-                if (items.first.isFaded()) {
-                    index += 1;
-                }
-
-                sortedShapeKeys[index].push_back(items.first);
-            }
-
-            // Render non-withOwnPipeline things
-            for (size_t i = 0; i < OWN_PIPELINE_INDEX; i++) {
-                auto& shapeKeys = sortedShapeKeys[i];
-                if (shapeKeys.size() > 0) {
-                    const auto& shapePipeline = _shapePlumber->pickPipeline(args, keys[i]);
-                    args->_shapePipeline = shapePipeline;
-                    for (const auto& key : shapeKeys) {
-                        renderShapes(renderContext, _shapePlumber, inShapes.at(key));
-                    }
-                }
-            }
-
-            // Render withOwnPipeline things
-            for (size_t i = OWN_PIPELINE_INDEX; i < keys.size(); i++) {
-                auto& shapeKeys = sortedShapeKeys[i];
-                if (shapeKeys.size() > 0) {
-                    args->_shapePipeline = nullptr;
-                    for (const auto& key : shapeKeys) {
-                        args->_itemShapeKey = key._flags.to_ulong();
-                        renderShapes(renderContext, _shapePlumber, inShapes.at(key));
-                    }
+            if (!useCache) {
+                renderCasters(renderContext, inShapes);
+            } else {
+                if (drawStatic) {
+                    renderCasters(renderContext, staticShapes);
+                    batch.blit(fbo, viewport, _staticCache, viewport);
                 }
+                renderCasters(renderContext, dynamicShapes);
             }
-
-            args->_shapePipeline = nullptr;
         }
 
         args->_batch = nullptr;
@@ -497,14 +586,22 @@ void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderCon
 
             output.edit1() = cascadeFrustum;
 
+            // the items of the cascade two below are already rendered at a higher resolution
+            if (_cascadeIndex > 1) {
+                output.edit3() = globalShadow->getCascade(_cascadeIndex - 2).getFrustum();
+            } else {
+                output.edit3() = ViewFrustumPointer();
+            }
         } else {
             output.edit0() = ItemFilter::Builder::nothing();
             output.edit1() = ViewFrustumPointer();
+            output.edit3() = ViewFrustumPointer();
         }
     }
     else {
         output.edit0() = ItemFilter::Builder::nothing();
         output.edit1() = ViewFrustumPointer();
+        output.edit3() = ViewFrustumPointer();
     }
 
     output.edit2() = cullFunctor;
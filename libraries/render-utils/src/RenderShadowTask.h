@@ -12,6 +12,8 @@
 #ifndef hifi_RenderShadowTask_h
 #define hifi_RenderShadowTask_h
 
+#include <unordered_map>
+
 #include <gpu/Framebuffer.h>
 #include <gpu/Pipeline.h>
 
@@ -24,17 +26,45 @@
 
 class ViewFrustum;
 
+class RenderShadowMapConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool cached MEMBER cached NOTIFY dirty)
+public:
+    // Keep the static casters of the cascade in a separate depth map, which is only redrawn when the cascade frustum or
+    // the static casters change, and draw only the dynamic casters every frame
+    bool cached { false };
+
+signals:
+    void dirty();
+};
+
 class RenderShadowMap {
 public:
     using Inputs = render::VaryingSet3<render::ShapeBounds, AABox, LightStage::ShadowFramePointer>;
-    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs>;
+    using Config = RenderShadowMapConfig;
+    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs, Config>;
 
     RenderShadowMap(render::ShapePlumberPointer shapePlumber, unsigned int cascadeIndex) : _shapePlumber{ shapePlumber }, _cascadeIndex{ cascadeIndex } {}
+    void configure(const Config& config);
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
     unsigned int _cascadeIndex;
+
+    bool _cached { false };
+    bool _isCacheValid { false };
+    gpu::FramebufferPointer _staticCache;
+    glm::mat4 _cachedView;
+    glm::mat4 _cachedProjection;
+    size_t _cachedStaticItemsHash { 0 };
+    // The casters bounds of the previous frame, the ones that haven't changed since are static
+    std::unordered_map<render::ItemID, AABox> _previousBounds;
+
+    // Splits the casters in static and dynamic ones, and returns true if the static ones have to be drawn again
+    bool splitStaticCasters(const render::ShapeBounds& inShapes, const ViewFrustum& frustum, render::ShapeBounds& staticShapes,
+        render::ShapeBounds& dynamicShapes);
+    void renderCasters(const render::RenderContextPointer& renderContext, const render::ShapeBounds& inShapes);
 };
 
 //class RenderShadowTaskConfig : public render::Task::Config::Persistent {
@@ -144,10 +174,33 @@ private:
     void calculateBiases(float biasInput);
 };
 
+// Culls and renders the shadow map of one cascade
+class RenderShadowCascadeTask {
+public:
+    using Input = render::VaryingSet3<render::ShapeBounds, LightStage::ShadowFramePointer, graphics::LightPointer>;
+    using Output = AABox;
+    using JobModel = render::Task::ModelIO<RenderShadowCascadeTask, Input, Output>;
+
+    void build(JobModel& task, const render::Varying& input, render::Varying& output, render::ShapePlumberPointer shapePlumber,
+        unsigned int cascadeIndex, render::ItemFilter filter);
+};
+
+// Runs the cascade tasks, which can record their batches concurrently as they only share the sorted shadow casters
+class RenderShadowCascadesTask {
+public:
+    using Input = RenderShadowCascadeTask::Input;
+    using Output = RenderShadowTask::CascadeBoxes;
+    using JobModel = render::Task::ParallelModelIO<RenderShadowCascadesTask, Input, Output>;
+
+    void build(JobModel& task, const render::Varying& input, render::Varying& output, render::ShapePlumberPointer shapePlumber,
+        render::ItemFilter filter);
+};
+
 class RenderShadowCascadeSetup {
 public:
     using Inputs = LightStage::ShadowFramePointer;
-    using Outputs = render::VaryingSet3<render::ItemFilter, ViewFrustumPointer, RenderShadowTask::CullFunctor>;
+    // the filter, the frustum and cull functor of the cascade, then the frustum of the cascade whose items it can skip
+    using Outputs = render::VaryingSet4<render::ItemFilter, ViewFrustumPointer, RenderShadowTask::CullFunctor, ViewFrustumPointer>;
     using JobModel = render::Job::ModelIO<RenderShadowCascadeSetup, Inputs, Outputs>;
 
     RenderShadowCascadeSetup(unsigned int cascadeIndex, render::ItemFilter filter) : _cascadeIndex(cascadeIndex), _filter(filter) {}
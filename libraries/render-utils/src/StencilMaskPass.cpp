@@ -15,6 +15,8 @@
 #include <gpu/Context.h>
 #include <shaders/Shaders.h>
 
+#include "render-utils/ShaderConstants.h"
+
 using namespace render;
 
 void PrepareStencil::configure(const Config& config) {
@@ -61,6 +63,18 @@ gpu::PipelinePointer PrepareStencil::getPaintStencilPipeline() {
     return _paintStencilPipeline;
 }
 
+gpu::PipelinePointer PrepareStencil::getFoveationStencilPipeline() {
+    if (!_foveationStencilPipeline) {
+        auto program = gpu::Shader::createProgram(shader::render_utils::program::stencil_drawFoveationMask);
+        auto state = std::make_shared<gpu::State>();
+        drawMask(*state);
+        state->setColorWriteMask(gpu::State::WRITE_NONE);
+
+        _foveationStencilPipeline = gpu::Pipeline::create(program, state);
+    }
+    return _foveationStencilPipeline;
+}
+
 void PrepareStencil::run(const RenderContextPointer& renderContext, const gpu::FramebufferPointer& srcFramebuffer) {
     RenderArgs* args = renderContext->args;
 
@@ -85,10 +99,18 @@ void PrepareStencil::run(const RenderContextPointer& renderContext, const gpu::F
         maskOperator = args->_stencilMaskOperator;
     }
 
-    if (maskMode == StencilMaskMode::NONE || (maskMode == StencilMaskMode::MESH && !maskOperator)) {
+    bool foveated = Foveation::isEnabled(args);
+    if (maskMode == StencilMaskMode::MESH && !maskOperator) {
+        maskMode = StencilMaskMode::NONE;
+    }
+    if (maskMode == StencilMaskMode::NONE && !foveated) {
         return;
     }
 
+    if (foveated) {
+        Foveation::updateParameters(_foveationParametersBuffer, args);
+    }
+
     doInBatch("PrepareStencil::run", args->_context, [&](gpu::Batch& batch) {
         batch.enableStereo(false);
 
@@ -101,6 +123,13 @@ void PrepareStencil::run(const RenderContextPointer& renderContext, const gpu::F
             batch.setPipeline(getMeshStencilPipeline());
             maskOperator(batch);
         }
+
+        // the foveation holes are masked like the areas that aren't visible, filled by FillFoveation after the lighting
+        if (foveated) {
+            batch.setPipeline(getFoveationStencilPipeline());
+            batch.setUniformBuffer(render_utils::slot::buffer::Buffer::FoveationParams, _foveationParametersBuffer);
+            batch.draw(gpu::TRIANGLE_STRIP, 4);
+        }
     });
 }
 
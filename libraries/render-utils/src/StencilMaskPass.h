@@ -17,6 +17,8 @@
 #include <graphics/Geometry.h>
 #include <StencilMaskMode.h>
 
+#include "Foveation.h"
+
 class PrepareStencilConfig : public render::Job::Config {
     Q_OBJECT
     Q_PROPERTY(StencilMaskMode maskMode MEMBER maskMode NOTIFY dirty)
@@ -65,6 +67,10 @@ private:
     gpu::PipelinePointer _paintStencilPipeline;
     gpu::PipelinePointer getPaintStencilPipeline();
 
+    gpu::PipelinePointer _foveationStencilPipeline;
+    gpu::PipelinePointer getFoveationStencilPipeline();
+    Foveation::ParametersBuffer _foveationParametersBuffer;
+
     graphics::MeshPointer _mesh;
     graphics::MeshPointer getMesh();
 
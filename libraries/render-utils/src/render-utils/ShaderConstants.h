@@ -95,6 +95,8 @@
 #define RENDER_UTILS_TEXTURE_SSAO_DEPTH 1
 #define RENDER_UTILS_TEXTURE_SSAO_NORMAL 2
 #define RENDER_UTILS_TEXTURE_SSAO_OCCLUSION 0
+#define RENDER_UTILS_TEXTURE_SSAO_HISTORY 3
+#define RENDER_UTILS_TEXTURE_SSAO_VELOCITY 4
 
 // Temporal anti-aliasing
 #define RENDER_UTILS_BUFFER_TAA_PARAMS 2
@@ -122,6 +124,10 @@
 #define RENDER_UTILS_BUFFER_BLOOM_PARAMS 1
 #define RENDER_UTILS_TEXTURE_BLOOM_COLOR 0
 
+// Foveation
+#define RENDER_UTILS_BUFFER_FOVEATION_PARAMS 0
+#define RENDER_UTILS_TEXTURE_FOVEATION_SOURCE 0
+
 // SDF Text rendering
 #define RENDER_UTILS_TEXTURE_TEXT_FONT 0
 #define RENDER_UTILS_UNIFORM_TEXT_COLOR 0
@@ -162,6 +168,7 @@ enum Buffer {
     ToneMappingParams = RENDER_UTILS_BUFFER_TM_PARAMS,
     ShadowParams = RENDER_UTILS_BUFFER_SHADOW_PARAMS,
     DebugDeferredParams = RENDER_UTILS_BUFFER_DEBUG_DEFERRED_PARAMS,
+    FoveationParams = RENDER_UTILS_BUFFER_FOVEATION_PARAMS,
 };
 } // namespace buffer
 
@@ -192,6 +199,8 @@ enum Texture {
     SsaoOcclusion = RENDER_UTILS_TEXTURE_SSAO_OCCLUSION,
     SsaoDepth = RENDER_UTILS_TEXTURE_SSAO_DEPTH,
     SsaoNormal = RENDER_UTILS_TEXTURE_SSAO_NORMAL,
+    SsaoHistory = RENDER_UTILS_TEXTURE_SSAO_HISTORY,
+    SsaoVelocity = RENDER_UTILS_TEXTURE_SSAO_VELOCITY,
     HighlightSceneDepth = RENDER_UTILS_TEXTURE_HIGHLIGHT_SCENE_DEPTH,
     HighlightDepth = RENDER_UTILS_TEXTURE_HIGHLIGHT_DEPTH,
     SurfaceGeometryDepth = RENDER_UTILS_TEXTURE_SG_DEPTH,
@@ -203,6 +212,7 @@ enum Texture {
     TextFont = RENDER_UTILS_TEXTURE_TEXT_FONT,
     AmbientFresnel = RENDER_UTILS_TEXTURE_AMBIENT_FRESNEL,
     DebugTexture0 = RENDER_UTILS_DEBUG_TEXTURE0,
+    FoveationSource = RENDER_UTILS_TEXTURE_FOVEATION_SOURCE,
 };
 } // namespace texture
 
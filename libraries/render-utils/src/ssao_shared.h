@@ -42,6 +42,7 @@ struct AmbientOcclusionParams {
     SSAO_VEC4 _sampleInfo;
     SSAO_VEC4 _falloffInfo;
     SSAO_VEC4 _sideSizes[2];
+    SSAO_VEC4 _temporalInfo;
 };
 
 struct AmbientOcclusionFrameParams {
@@ -75,6 +75,30 @@ Font::Pointer Font::load(QIODevice& fontFile) {
 
 static QHash<QString, Font::Pointer> LOADED_FONTS;
 
+Font::Pointer Font::loadResource(const QString& filename) {
+    QFile fontFile(filename);
+    fontFile.open(QIODevice::ReadOnly);
+
+    qCDebug(renderutils) << "Loaded font" << filename << "from Qt Resource System.";
+
+    return load(fontFile);
+}
+
+template <typename Map>
+static void pruneExpired(Map& map, size_t& pruneSize, size_t minPruneSize) {
+    if (map.size() < pruneSize) {
+        return;
+    }
+    for (auto it = map.begin(); it != map.end();) {
+        if (it->second.expired()) {
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    pruneSize = std::max(minPruneSize, 2 * map.size());
+}
+
 Font::Pointer Font::load(const QString& family) {
     std::lock_guard<std::mutex> lock(fontMutex);
     if (!LOADED_FONTS.contains(family)) {
@@ -102,21 +126,16 @@ Font::Pointer Font::load(const QString& family) {
 
             auto networkReply = networkAccessManager.get(networkRequest);
             connect(networkReply, &QNetworkReply::finished, loadingFont.get(), &Font::handleFontNetworkReply);
-        } else if (!LOADED_FONTS.contains(ROBOTO_FONT_FAMILY)) {
-            // Unrecognized font and we haven't loaded Roboto yet
-            loadFilename = ":/Roboto.sdff";
         } else {
-            // Unrecognized font but we've already loaded Roboto
+            // Unrecognized font, it shares the atlas of Roboto rather than loading its own copy
+            if (!LOADED_FONTS.contains(ROBOTO_FONT_FAMILY)) {
+                LOADED_FONTS[ROBOTO_FONT_FAMILY] = loadResource(":/Roboto.sdff");
+            }
             LOADED_FONTS[family] = LOADED_FONTS[ROBOTO_FONT_FAMILY];
         }
 
         if (!loadFilename.isEmpty()) {
-            QFile fontFile(loadFilename);
-            fontFile.open(QIODevice::ReadOnly);
-
-            qCDebug(renderutils) << "Loaded font" << loadFilename << "from Qt Resource System.";
-
-            LOADED_FONTS[family] = load(fontFile);
+            LOADED_FONTS[family] = loadResource(loadFilename);
         }
     }
     return LOADED_FONTS[family];
@@ -260,6 +279,9 @@ void Font::read(QIODevice& in) {
     _texture->setStoredMipFormat(formatMip);
     _texture->assignStoredMip(0, image.sizeInBytes(), image.constBits());
     _texture->setImportant(true);
+
+    std::lock_guard<std::mutex> lock(_sharedMutex);
+    _layouts.clear();
 }
 
 void Font::setupGPU() {
@@ -312,17 +334,13 @@ inline QuadBuilder adjustedQuadBuilderForAlignmentMode(const Glyph& glyph, glm::
     return QuadBuilder(glyph, advance, scale, enlargeForShadows);
 }
 
-void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
+void Font::buildVertices(Font::Layout& layout, const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
                          TextAlignment alignment) {
-    drawInfo.verticesBuffer = std::make_shared<gpu::Buffer>();
-    drawInfo.indicesBuffer = std::make_shared<gpu::Buffer>();
-    drawInfo.indexCount = 0;
+    layout.verticesBuffer = std::make_shared<gpu::Buffer>();
+    layout.indicesBuffer = std::make_shared<gpu::Buffer>();
+    layout.indexCount = 0;
     int numVertices = 0;
 
-    drawInfo.string = str;
-    drawInfo.bounds = bounds;
-    drawInfo.origin = origin;
-
     float enlargedBoundsX = bounds.x - 0.5f * DOUBLE_MAX_OFFSET_PIXELS * float(enlargeForShadows);
     float rightEdge = origin.x + enlargedBoundsX;
 
@@ -401,7 +419,7 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
     // The quadBuilders is backwards now because we looped over the glyphs backwards to adjust their alignment
     for (int i = quadBuilders.size() - 1; i >= 0; i--) {
         quint16 verticesOffset = numVertices;
-        drawInfo.verticesBuffer->append(quadBuilders[i]);
+        layout.verticesBuffer->append(quadBuilders[i]);
         numVertices += VERTICES_PER_QUAD;
 
         // Sam's recommended triangle slices
@@ -428,11 +446,59 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
         indices[3] = verticesOffset + 2;
         indices[4] = verticesOffset + 1;
         indices[5] = verticesOffset + 3;
-        drawInfo.indicesBuffer->append(sizeof(indices), (const gpu::Byte*)indices);
-        drawInfo.indexCount += NUMBER_OF_INDICES_PER_QUAD;
+        layout.indicesBuffer->append(sizeof(indices), (const gpu::Byte*)indices);
+        layout.indexCount += NUMBER_OF_INDICES_PER_QUAD;
     }
 }
 
+Font::LayoutPointer Font::getLayout(const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale,
+                                    bool enlargeForShadows, TextAlignment alignment) {
+    LayoutKey key(str, origin.x, origin.y, bounds.x, bounds.y, scale, (int)alignment, enlargeForShadows);
+
+    std::lock_guard<std::mutex> lock(_sharedMutex);
+    auto& sharedLayout = _layouts[key];
+    LayoutPointer layout = sharedLayout.lock();
+    if (!layout) {
+        auto newLayout = std::make_shared<Layout>();
+        buildVertices(*newLayout, str, origin, bounds, scale, enlargeForShadows, alignment);
+        layout = newLayout;
+        sharedLayout = layout;
+        pruneExpired(_layouts, _layoutsPruneSize, MIN_PRUNE_SIZE);
+    }
+    return layout;
+}
+
+gpu::BufferPointer Font::getParamsBuffer(const DrawParams& params) {
+    ParamsKey key(params.color.r, params.color.g, params.color.b, params.color.a, params.effectColor.r, params.effectColor.g,
+                  params.effectColor.b, params.effectThickness, params.effect);
+
+    std::lock_guard<std::mutex> lock(_sharedMutex);
+    auto& sharedBuffer = _paramsBuffers[key];
+    gpu::BufferPointer paramsBuffer = sharedBuffer.lock();
+    if (!paramsBuffer) {
+        // need the gamma corrected color here
+        DrawParams gpuDrawParams;
+        gpuDrawParams.color = ColorUtils::sRGBToLinearVec4(params.color);
+        gpuDrawParams.effectColor = ColorUtils::sRGBToLinearVec3(params.effectColor);
+        gpuDrawParams.effectThickness = params.effectThickness;
+        gpuDrawParams.effect = params.effect;
+        paramsBuffer = std::make_shared<gpu::Buffer>(sizeof(DrawParams), (const gpu::Byte*)&gpuDrawParams);
+        sharedBuffer = paramsBuffer;
+        pruneExpired(_paramsBuffers, _paramsBuffersPruneSize, MIN_PRUNE_SIZE);
+    }
+    return paramsBuffer;
+}
+
+void Font::setupDraw(gpu::Batch& batch, const gpu::PipelinePointer& pipeline, const Layout& layout,
+                     const gpu::BufferPointer& paramsBuffer) const {
+    batch.setPipeline(pipeline);
+    batch.setInputFormat(_format);
+    batch.setInputBuffer(0, layout.verticesBuffer, 0, _format->getChannels().at(0)._stride);
+    batch.setResourceTexture(render_utils::slot::texture::TextFont, _texture);
+    batch.setUniformBuffer(0, paramsBuffer, 0, sizeof(DrawParams));
+    batch.setIndexBuffer(gpu::UINT16, layout.indicesBuffer, 0);
+}
+
 void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString& str, const glm::vec4& color,
                       const glm::vec3& effectColor, float effectThickness, TextEffect effect, TextAlignment alignment,
                       const glm::vec2& origin, const glm::vec2& bounds, float scale, bool unlit, bool forward) {
@@ -443,13 +509,18 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
     int textEffect = (int)effect;
     const int SHADOW_EFFECT = (int)TextEffect::SHADOW_EFFECT;
 
-    // If we're switching to or from shadow effect mode, we need to rebuild the vertices
-    if (str != drawInfo.string || bounds != drawInfo.bounds || origin != drawInfo.origin || alignment != _alignment ||
-            (drawInfo.params.effect != textEffect && (textEffect == SHADOW_EFFECT || drawInfo.params.effect == SHADOW_EFFECT)) ||
-            (textEffect == SHADOW_EFFECT && scale != _scale)) {
-        _scale = scale;
-        _alignment = alignment;
-        buildVertices(drawInfo, str, origin, bounds, scale, textEffect == SHADOW_EFFECT, alignment);
+    // The quads are only enlarged for the shadow effect, which is also the only one the scale matters to
+    bool enlargeForShadows = textEffect == SHADOW_EFFECT;
+    float layoutScale = enlargeForShadows ? scale : 0.0f;
+    if (!drawInfo.layout || str != drawInfo.string || bounds != drawInfo.bounds || origin != drawInfo.origin ||
+            alignment != drawInfo.alignment || enlargeForShadows != drawInfo.enlargedForShadows || layoutScale != drawInfo.scale) {
+        drawInfo.string = str;
+        drawInfo.bounds = bounds;
+        drawInfo.origin = origin;
+        drawInfo.alignment = alignment;
+        drawInfo.enlargedForShadows = enlargeForShadows;
+        drawInfo.scale = layoutScale;
+        drawInfo.layout = getLayout(str, origin, bounds, layoutScale, enlargeForShadows, alignment);
     }
 
     setupGPU();
@@ -460,24 +531,34 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
         drawInfo.params.effectColor = effectColor;
         drawInfo.params.effectThickness = effectThickness;
         drawInfo.params.effect = textEffect;
+        drawInfo.paramsBuffer = getParamsBuffer(drawInfo.params);
+    }
 
-        // need the gamma corrected color here
-        DrawParams gpuDrawParams;
-        gpuDrawParams.color = ColorUtils::sRGBToLinearVec4(drawInfo.params.color);
-        gpuDrawParams.effectColor = ColorUtils::sRGBToLinearVec3(drawInfo.params.effectColor);
-        gpuDrawParams.effectThickness = drawInfo.params.effectThickness;
-        gpuDrawParams.effect = drawInfo.params.effect;
-        if (!drawInfo.paramsBuffer) {
-            drawInfo.paramsBuffer = std::make_shared<gpu::Buffer>(sizeof(DrawParams), nullptr);
-        }
-        drawInfo.paramsBuffer->setSubData(0, sizeof(DrawParams), (const gpu::Byte*)&gpuDrawParams);
+    if (drawInfo.layout->indexCount == 0) {
+        return;
     }
 
-    batch.setPipeline(_pipelines[std::make_tuple(color.a < 1.0f, unlit, forward)]);
-    batch.setInputFormat(_format);
-    batch.setInputBuffer(0, drawInfo.verticesBuffer, 0, _format->getChannels().at(0)._stride);
-    batch.setResourceTexture(render_utils::slot::texture::TextFont, _texture);
-    batch.setUniformBuffer(0, drawInfo.paramsBuffer, 0, sizeof(DrawParams));
-    batch.setIndexBuffer(gpu::UINT16, drawInfo.indicesBuffer, 0);
-    batch.drawIndexed(gpu::TRIANGLES, drawInfo.indexCount, 0);
+    bool isTranslucent = color.a < 1.0f;
+    auto& pipeline = _pipelines[std::make_tuple(isTranslucent, unlit, forward)];
+    if (isTranslucent || forward) {
+        // translucent text is drawn in the order it was sorted in, and the forward pipelines need the lighting state the
+        // item was drawn with
+        setupDraw(batch, pipeline, *drawInfo.layout, drawInfo.paramsBuffer);
+        batch.drawIndexed(gpu::TRIANGLES, drawInfo.layout->indexCount, 0);
+        return;
+    }
+
+    // the draws of the same text with the same parameters share their layout and params buffer, so they end up under the
+    // same name and are drawn by a single instanced call when the batch is flushed, as copies of a sign or labels are
+    std::string instanceName = "sdf_text_" + std::to_string(std::hash<const Layout*>()(drawInfo.layout.get())) +
+        "_" + std::to_string(std::hash<gpu::Buffer*>()(drawInfo.paramsBuffer.get())) +
+        "_" + std::to_string(std::hash<gpu::Pipeline*>()(pipeline.get()));
+
+    // named calls run after the rest of the batch, the lambda keeps what it draws alive until then
+    auto layout = drawInfo.layout;
+    auto paramsBuffer = drawInfo.paramsBuffer;
+    batch.setupNamedCalls(instanceName, [this, pipeline, layout, paramsBuffer](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        setupDraw(batch, pipeline, *layout, paramsBuffer);
+        batch.drawIndexedInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, layout->indexCount, 0);
+    });
 }
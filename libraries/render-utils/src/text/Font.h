@@ -10,6 +10,10 @@
 #ifndef hifi_Font_h
 #define hifi_Font_h
 
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include <QObject>
 
 #include "Glyph.h"
@@ -42,15 +46,26 @@ public:
         vec3 _spare;
     };
 
+    // The glyph quads of a text, laid out in its bounds
+    struct Layout {
+        gpu::BufferPointer verticesBuffer;
+        gpu::BufferPointer indicesBuffer;
+        uint32_t indexCount { 0 };
+    };
+    using LayoutPointer = std::shared_ptr<const Layout>;
+
+    // What a drawer of text keeps between its draws. The layout and the params buffer are shared by all the draws of the
+    // font with the same text and bounds, and the same parameters, and are only looked up again when those change.
     struct DrawInfo {
-        gpu::BufferPointer verticesBuffer { nullptr };
-        gpu::BufferPointer indicesBuffer { nullptr };
-        gpu::BufferPointer paramsBuffer { nullptr };
-        uint32_t indexCount;
+        LayoutPointer layout;
+        gpu::BufferPointer paramsBuffer;
 
         QString string;
         glm::vec2 origin;
         glm::vec2 bounds;
+        float scale { 0.0f };
+        TextAlignment alignment { TextAlignment::LEFT };
+        bool enlargedForShadows { false };
         DrawParams params;
     };
 
@@ -72,14 +87,20 @@ public slots:
 
 private:
     static Pointer load(QIODevice& fontFile);
+    static Pointer loadResource(const QString& filename);
     QStringList tokenizeForWrapping(const QString& str) const;
     QStringList splitLines(const QString& str) const;
     glm::vec2 computeTokenExtent(const QString& str) const;
 
     const Glyph& getGlyph(const QChar& c) const;
-    void buildVertices(DrawInfo& drawInfo, const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
+    void buildVertices(Layout& layout, const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
                        TextAlignment alignment);
 
+    LayoutPointer getLayout(const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
+                            TextAlignment alignment);
+    gpu::BufferPointer getParamsBuffer(const DrawParams& params);
+    void setupDraw(gpu::Batch& batch, const gpu::PipelinePointer& pipeline, const Layout& layout, const gpu::BufferPointer& paramsBuffer) const;
+
     void setupGPU();
 
     // maps characters to cached glyph info
@@ -97,11 +118,18 @@ private:
     float _descent { 0.0f };
     float _spaceWidth { 0.0f };
 
-    float _scale { 0.0f };
-    TextAlignment _alignment;
-
     bool _loaded { true };
 
+    // the layouts and params buffers in use, they go once no draw holds them
+    static const size_t MIN_PRUNE_SIZE = 256;
+    using LayoutKey = std::tuple<QString, float, float, float, float, float, int, bool>;
+    using ParamsKey = std::tuple<float, float, float, float, float, float, float, float, int>;
+    std::mutex _sharedMutex;
+    std::map<LayoutKey, std::weak_ptr<const Layout>> _layouts;
+    std::map<ParamsKey, std::weak_ptr<gpu::Buffer>> _paramsBuffers;
+    size_t _layoutsPruneSize { MIN_PRUNE_SIZE };
+    size_t _paramsBuffersPruneSize { MIN_PRUNE_SIZE };
+
     gpu::TexturePointer _texture;
     gpu::BufferStreamPointer _stream;
 
@@ -39,6 +39,14 @@ namespace render {
             int _outOfView = 0;
             int _tooSmall = 0;
             int _rendered = 0;
+
+            Item& operator+=(const Item& other) {
+                _considered += other._considered;
+                _outOfView += other._outOfView;
+                _tooSmall += other._tooSmall;
+                _rendered += other._rendered;
+                return *this;
+            }
         };
 
         int _materialSwitches = 0;
@@ -58,6 +66,15 @@ namespace render {
                     return _other;
             }
         }
+
+        RenderDetails& operator+=(const RenderDetails& other) {
+            _materialSwitches += other._materialSwitches;
+            _trianglesRendered += other._trianglesRendered;
+            _item += other._item;
+            _shadow += other._shadow;
+            _other += other._other;
+            return *this;
+        }
     };
 
 
@@ -130,6 +147,7 @@ namespace render {
         bool _enableTexturing { true };
         bool _enableBlendshape { true };
         bool _enableSkinning { true };
+        bool _enableInstancing { false };
 
         bool _enableFade { false };
 
@@ -143,6 +161,12 @@ namespace render {
         bool _takingSnapshot { false };
         StencilMaskMode _stencilMaskMode { StencilMaskMode::NONE };
         std::function<void(gpu::Batch&)> _stencilMaskOperator;
+
+        // Foveated stereo rendering: outside of the given radius around the center of each eye, over the height of the
+        // eye, only half of the pixels are shaded. The centers are in the texcoords of each eye
+        bool _foveated { false };
+        float _foveationRadius { 0.5f };
+        glm::vec2 _foveationCenters[2] { glm::vec2(0.5f), glm::vec2(0.5f) };
     };
 
 }
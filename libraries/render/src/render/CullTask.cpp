@@ -16,6 +16,7 @@
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
@@ -141,6 +142,56 @@ void FetchSpatialTree::run(const RenderContextPointer& renderContext, const Inpu
     }
 }
 
+// Long lists are culled in chunks spread over the worker threads. Each chunk has its own output and details, which are
+// appended in order so that the result is the same as culling on one thread.
+const size_t CULL_CHUNK_SIZE = 256;
+const size_t MIN_PARALLEL_CULL_ITEMS = 4 * CULL_CHUNK_SIZE;
+
+void render::cullSelectedItems(const ItemIDs& ids, const ItemFilter& filter, bool testFrustum, bool testSolidAngle,
+                               CullFunctor& cullFunctor, Scene& scene, RenderArgs* args,
+                               RenderDetails::Item& details, ItemBounds& outItems) {
+    auto cullRange = [&](size_t begin, size_t end, RenderDetails::Item& rangeDetails, ItemBounds& rangeItems) {
+        CullTest test(cullFunctor, args, rangeDetails);
+        for (size_t i = begin; i < end; ++i) {
+            auto id = ids[i];
+            auto& item = scene.getItem(id);
+            if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
+                ItemBound itemBound(id, item.getBound(args));
+                if ((!testFrustum || test.frustumTest(itemBound.bound)) &&
+                        (!testSolidAngle || test.solidAngleTest(itemBound.bound))) {
+                    rangeItems.emplace_back(itemBound);
+                    if (item.getKey().isMetaCullGroup()) {
+                        item.fetchMetaSubItemBounds(rangeItems, scene, args);
+                    }
+                }
+            }
+        }
+    };
+
+    if (ids.size() < MIN_PARALLEL_CULL_ITEMS) {
+        cullRange(0, ids.size(), details, outItems);
+        return;
+    }
+
+    size_t numChunks = (ids.size() + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE;
+    std::vector<ItemBounds> chunkItems(numChunks);
+    std::vector<RenderDetails::Item> chunkDetails(numChunks);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t chunk = range.begin(); chunk != range.end(); ++chunk) {
+            size_t begin = chunk * CULL_CHUNK_SIZE;
+            size_t end = std::min(begin + CULL_CHUNK_SIZE, ids.size());
+            chunkItems[chunk].reserve(end - begin);
+            cullRange(begin, end, chunkDetails[chunk], chunkItems[chunk]);
+        }
+    });
+
+    for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        outItems.insert(outItems.end(), chunkItems[chunk].begin(), chunkItems[chunk].end());
+        details._outOfView += chunkDetails[chunk]._outOfView;
+        details._tooSmall += chunkDetails[chunk]._tooSmall;
+    }
+}
+
 void CullSpatialSelection::configure(const Config& config) {
     _justFrozeFrustum = _justFrozeFrustum || (config.freezeFrustum && !_freezeFrustum);
     _freezeFrustum = config.freezeFrustum;
@@ -167,8 +218,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -181,134 +230,31 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-        } else {
+        // When culling is disabled the items are only filtered.
+        bool cull = !(_skipCulling || _overrideSkipCulling);
 
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
+        // inside & fit items: easy, just filter
+        {
+            PerformanceTimer perfTimer("insideFitItems");
+            cullSelectedItems(inSelection.insideItems, filter, false, false, _cullFunctor, *scene, args, details, outItems);
+        }
 
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            cullSelectedItems(inSelection.insideSubcellItems, filter, false, cull, _cullFunctor, *scene, args, details, outItems);
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & fit items: filter & frustum cull
+        {
+            PerformanceTimer perfTimer("partialFitItems");
+            cullSelectedItems(inSelection.partialItems, filter, cull, false, _cullFunctor, *scene, args, details, outItems);
+        }
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound) && test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        {
+            PerformanceTimer perfTimer("partialSmallItems");
+            cullSelectedItems(inSelection.partialSubcellItems, filter, cull, cull, _cullFunctor, *scene, args, details, outItems);
         }
     }
 
@@ -39,6 +39,11 @@ namespace render {
         static std::unordered_set<QUuid> _prevContainingZones;
     };
 
+    // Filters the items of one list of a spatial selection, and culls them against the view frustum and/or by solid angle
+    void cullSelectedItems(const ItemIDs& ids, const ItemFilter& filter, bool testFrustum, bool testSolidAngle,
+                           CullFunctor& cullFunctor, Scene& scene, RenderArgs* args,
+                           RenderDetails::Item& details, ItemBounds& outItems);
+
     class FetchNonspatialItems {
     public:
         using JobModel = Job::ModelIO<FetchNonspatialItems, ItemFilter, ItemBounds>;
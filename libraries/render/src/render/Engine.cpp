@@ -36,6 +36,37 @@ public:
     }
 };
 
+task::JobContextPointer RenderContext::fork() {
+    if (!args) {
+        return nullptr;
+    }
+
+    auto fork = std::make_shared<RenderContext>();
+    fork->_forkedArgs = std::make_shared<RenderArgs>(*args);
+    fork->_forkedArgs->_batch = nullptr;
+    fork->_forkedArgs->_details = RenderDetails();
+    fork->args = fork->_forkedArgs.get();
+    fork->_scene = _scene;
+    return fork;
+}
+
+void RenderContext::beginForkedRun() {
+    gpu::Context::beginBatchCapture(_forkedBatches);
+}
+
+void RenderContext::endForkedRun() {
+    gpu::Context::endBatchCapture();
+}
+
+void RenderContext::join(task::JobContext& fork) {
+    auto& renderFork = static_cast<RenderContext&>(fork);
+    for (const auto& batch : renderFork._forkedBatches) {
+        args->_context->appendFrameBatch(batch);
+    }
+    renderFork._forkedBatches.clear();
+    args->_details += renderFork.args->_details;
+}
+
 RenderEngine::RenderEngine() : Engine(EngineTask::JobModel::create("Engine"), std::make_shared<RenderContext>())
 {
 }
@@ -28,8 +28,18 @@ namespace render {
         RenderContext() : task::JobContext() {}
         virtual ~RenderContext() {}
 
+        // A fork renders with its own copy of the args, and its batches are appended to the frame when it is joined
+        task::JobContextPointer fork() override;
+        void beginForkedRun() override;
+        void endForkedRun() override;
+        void join(task::JobContext& fork) override;
+
         RenderArgs* args;
         ScenePointer _scene;
+
+    private:
+        std::shared_ptr<RenderArgs> _forkedArgs;
+        std::vector<gpu::BatchPointer> _forkedBatches;
     };
     using RenderContextPointer = std::shared_ptr<RenderContext>;
 
@@ -64,5 +64,19 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
 
+    config->frameFilteredSetPipelineCount = _gpuStats._PSNumSetPipelinesFiltered;
+    config->frameFilteredInputFormatCount = _gpuStats._ISNumFormatChangesFiltered;
+    config->frameFilteredUniformBufferCount = _gpuStats._RSNumUniformBuffersFiltered;
+    config->frameFilteredTextureCount = _gpuStats._RSNumTexturesFiltered;
+    config->frameFilteredTextureTableCount = _gpuStats._RSNumTextureTablesFiltered;
+
+    if (renderContext->_scene) {
+        const auto& scene = renderContext->_scene;
+        config->sceneTransactionCount = scene->getNumTransactionsProcessed();
+        config->sceneItemUpdateCount = scene->getNumItemUpdatesProcessed();
+        config->scenePendingItemUpdateCount = scene->getNumItemUpdatesPending();
+        config->sceneTransactionTime = scene->getTransactionProcessingTime();
+    }
+
     // These new stat values are notified with the "newStats" signal triggered by the timer
 }
@@ -61,6 +61,17 @@ namespace render {
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameSetInputFormatCount MEMBER frameSetInputFormatCount NOTIFY newStats)
 
+        Q_PROPERTY(quint32 frameFilteredSetPipelineCount MEMBER frameFilteredSetPipelineCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameFilteredInputFormatCount MEMBER frameFilteredInputFormatCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameFilteredUniformBufferCount MEMBER frameFilteredUniformBufferCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameFilteredTextureCount MEMBER frameFilteredTextureCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameFilteredTextureTableCount MEMBER frameFilteredTextureTableCount NOTIFY newStats)
+
+        Q_PROPERTY(quint32 sceneTransactionCount MEMBER sceneTransactionCount NOTIFY newStats)
+        Q_PROPERTY(quint32 sceneItemUpdateCount MEMBER sceneItemUpdateCount NOTIFY newStats)
+        Q_PROPERTY(quint32 scenePendingItemUpdateCount MEMBER scenePendingItemUpdateCount NOTIFY newStats)
+        Q_PROPERTY(quint64 sceneTransactionTime MEMBER sceneTransactionTime NOTIFY newStats)
+
 
     public:
         EngineStatsConfig() : Job::Config(true) {}
@@ -101,6 +112,18 @@ namespace render {
         quint32 frameSetPipelineCount{ 0 };
 
         quint32 frameSetInputFormatCount{ 0 };
+
+        // the redundant binds skipped by the backend
+        quint32 frameFilteredSetPipelineCount{ 0 };
+        quint32 frameFilteredInputFormatCount{ 0 };
+        quint32 frameFilteredUniformBufferCount{ 0 };
+        quint32 frameFilteredTextureCount{ 0 };
+        quint32 frameFilteredTextureTableCount{ 0 };
+
+        quint32 sceneTransactionCount { 0 };
+        quint32 sceneItemUpdateCount { 0 };
+        quint32 scenePendingItemUpdateCount { 0 };
+        quint64 sceneTransactionTime { 0 }; // usecs
     };
 
     class EngineStats {
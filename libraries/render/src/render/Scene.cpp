@@ -12,6 +12,7 @@
 
 #include <numeric>
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -218,6 +219,7 @@ uint32_t Scene::enqueueFrame() {
         std::unique_lock<std::mutex> lock(_transactionQueueMutex);
         localTransactionQueue.swap(_transactionQueue);
     }
+    _numTransactionsEnqueued += (uint32_t)localTransactionQueue.size();
 
     Transaction consolidatedTransaction;
     consolidatedTransaction.merge(std::move(localTransactionQueue));
@@ -230,8 +232,16 @@ uint32_t Scene::enqueueFrame() {
 }
 
  
+// a burst of updates (a domain loading, many entities edited at once) is spread over several frames
+static const uint64_t MAX_ITEM_UPDATES_TIME_BUDGET = 4000; // usecs
+// applied whatever the budget, so that the pending updates always get through
+static const uint32_t MIN_ITEM_UPDATES_PER_FRAME = 256;
+
 void Scene::processTransactionQueue() {
     PROFILE_RANGE(render, __FUNCTION__);
+    uint64_t start = usecTimestampNow();
+    _updatesExpiry = start + MAX_ITEM_UPDATES_TIME_BUDGET;
+    _numUpdatesThisFrame = 0;
 
     static TransactionFrames queuedFrames;
     {
@@ -246,6 +256,67 @@ void Scene::processTransactionQueue() {
     }
 
     queuedFrames.clear();
+
+    // then the updates left over from the previous frames, if there is time left
+    if (_pendingUpdatesBegin < _pendingUpdates.size()) {
+        std::unique_lock<std::mutex> lock(_itemsMutex);
+        applyPendingUpdates();
+    }
+
+    _numTransactionsProcessed = _numTransactionsEnqueued.exchange(0);
+    _numItemUpdatesProcessed = _numUpdatesThisFrame;
+    _numItemUpdatesPending = (uint32_t)(_pendingUpdates.size() - _pendingUpdatesBegin);
+    _transactionProcessingTime = usecTimestampNow() - start;
+}
+
+bool Scene::isUpdateBudgetExpired() const {
+    return _numUpdatesThisFrame >= MIN_ITEM_UPDATES_PER_FRAME && usecTimestampNow() > _updatesExpiry;
+}
+
+void Scene::applyUpdate(const Transaction::Update& update) {
+    updateItem(update);
+    _numUpdatesThisFrame++;
+}
+
+void Scene::applyPendingUpdates() {
+    PROFILE_RANGE(render, __FUNCTION__);
+    while (_pendingUpdatesBegin < _pendingUpdates.size() && !isUpdateBudgetExpired()) {
+        auto& update = _pendingUpdates[_pendingUpdatesBegin++];
+        auto updateID = std::get<0>(update);
+        if (updateID != Item::INVALID_ITEM_ID) {
+            auto numPendingIt = _numPendingUpdatesByItem.find(updateID);
+            if (numPendingIt != _numPendingUpdatesByItem.end() && --numPendingIt->second == 0) {
+                _numPendingUpdatesByItem.erase(numPendingIt);
+            }
+            applyUpdate(update);
+        }
+        // release the functor now rather than when the queue is empty
+        update = Transaction::Update(Item::INVALID_ITEM_ID, UpdateFunctorPointer());
+    }
+
+    if (_pendingUpdatesBegin == _pendingUpdates.size()) {
+        _pendingUpdates.clear();
+        _pendingUpdatesBegin = 0;
+        _numPendingUpdatesByItem.clear();
+    } else if (_pendingUpdatesBegin > _pendingUpdates.size() / 2) {
+        _pendingUpdates.erase(_pendingUpdates.begin(), _pendingUpdates.begin() + _pendingUpdatesBegin);
+        _pendingUpdatesBegin = 0;
+    }
+}
+
+void Scene::flushPendingUpdates(ItemID itemID) {
+    auto numPendingIt = _numPendingUpdatesByItem.find(itemID);
+    if (numPendingIt == _numPendingUpdatesByItem.end()) {
+        return;
+    }
+    _numPendingUpdatesByItem.erase(numPendingIt);
+    for (size_t i = _pendingUpdatesBegin; i < _pendingUpdates.size(); i++) {
+        auto& update = _pendingUpdates[i];
+        if (std::get<0>(update) == itemID) {
+            applyUpdate(update);
+            update = Transaction::Update(Item::INVALID_ITEM_ID, UpdateFunctorPointer());
+        }
+    }
 }
 
 void Scene::processTransactionFrame(const Transaction& transaction) {
@@ -262,6 +333,11 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         // capture anything coming from the transaction
 
         // resets and potential NEW items
+        if (!_numPendingUpdatesByItem.empty()) {
+            for (auto& reset : transaction._resetItems) {
+                flushPendingUpdates(std::get<0>(reset));
+            }
+        }
         resetItems(transaction._resetItems);
 
         // Update the numItemsAtomic counter AFTER the reset changes went through
@@ -271,6 +347,11 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         updateItems(transaction._updatedItems);
 
         // removes
+        if (!_numPendingUpdatesByItem.empty()) {
+            for (auto removedID : transaction._removedItems) {
+                flushPendingUpdates(removedID);
+            }
+        }
         removeItems(transaction._removedItems);
 
         // add transitions
@@ -336,46 +417,65 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
 }
 
 void Scene::updateItems(const Transaction::Updates& transactions) {
-    for (auto& update : transactions) {
+    // the updates of an item are applied in order, so these wait for the ones still pending
+    applyPendingUpdates();
+
+    size_t numApplied = 0;
+    if (_pendingUpdatesBegin == _pendingUpdates.size()) {
+        while (numApplied < transactions.size() && !isUpdateBudgetExpired()) {
+            applyUpdate(transactions[numApplied++]);
+        }
+    }
+
+    for (size_t i = numApplied; i < transactions.size(); i++) {
+        auto& update = transactions[i];
         auto updateID = std::get<0>(update);
-        if (updateID == Item::INVALID_ITEM_ID) {
-            continue;
+        if (updateID != Item::INVALID_ITEM_ID) {
+            _pendingUpdates.push_back(update);
+            _numPendingUpdatesByItem[updateID]++;
         }
+    }
+}
 
-        // Access the true item
-        auto& item = _items[updateID];
+void Scene::updateItem(const Transaction::Update& update) {
+    auto updateID = std::get<0>(update);
+    if (updateID == Item::INVALID_ITEM_ID) {
+        return;
+    }
 
-        // If item doesn't exist it cannot be updated
-        if (!item.exist()) {
-            continue;
-        }
+    // Access the true item
+    auto& item = _items[updateID];
 
-        // Good to go, deal with the update
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
+    // If item doesn't exist it cannot be updated
+    if (!item.exist()) {
+        return;
+    }
 
-        // Update the item
-        item.update(std::get<1>(update));
-        auto newKey = item.getKey();
+    // Good to go, deal with the update
+    auto oldCell = item.getCell();
+    auto oldKey = item.getKey();
 
-        // Update the item's container
-        if (oldKey.isSpatial() == newKey.isSpatial()) {
-            if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
-            }
-        } else {
-            if (newKey.isSpatial()) {
-                _masterNonspatialSet.erase(updateID);
+    // Update the item
+    item.update(std::get<1>(update));
+    auto newKey = item.getKey();
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
-            } else {
-                _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
-                item.resetCell();
+    // Update the item's container
+    if (oldKey.isSpatial() == newKey.isSpatial()) {
+        if (newKey.isSpatial()) {
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), updateID, newKey);
+            item.resetCell(newCell, newKey.isSmall());
+        }
+    } else {
+        if (newKey.isSpatial()) {
+            _masterNonspatialSet.erase(updateID);
 
-                _masterNonspatialSet.insert(updateID);
-            }
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), updateID, newKey);
+            item.resetCell(newCell, newKey.isSmall());
+        } else {
+            _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
+            item.resetCell();
+
+            _masterNonspatialSet.insert(updateID);
         }
     }
 }
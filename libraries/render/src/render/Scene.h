@@ -12,6 +12,9 @@
 #ifndef hifi_render_Scene_h
 #define hifi_render_Scene_h
 
+#include <deque>
+#include <unordered_map>
+
 #include "Item.h"
 #include "SpatialTree.h"
 #include "Stage.h"
@@ -156,8 +159,16 @@ public:
     uint32_t enqueueFrame();
 
     // Process the pending transactions queued
+    // The resets, removes, transitions, selections and highlights are all applied, the item updates are applied within
+    // a time budget and the ones left over are applied first on the next calls.
     void processTransactionQueue();
 
+    // Stats of the last processTransactionQueue, this a threadsafe call
+    uint32_t getNumTransactionsProcessed() const { return _numTransactionsProcessed.load(); }
+    uint32_t getNumItemUpdatesProcessed() const { return _numItemUpdatesProcessed.load(); }
+    uint32_t getNumItemUpdatesPending() const { return _numItemUpdatesPending.load(); }
+    uint64_t getTransactionProcessingTime() const { return _transactionProcessingTime.load(); } // usecs
+
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
     Selection getSelection(const Selection::Name& name) const;
@@ -207,10 +218,29 @@ protected:
     using TransactionFrames = std::vector<Transaction>;
     TransactionFrames _transactionFrames;
     uint32_t _transactionFrameNumber{ 0 };
+    std::atomic<uint32_t> _numTransactionsEnqueued { 0 };
 
     // Process one transaction frame 
     void processTransactionFrame(const Transaction& transaction);
 
+    // The item updates that didn't fit in the budget, in the order they were enqueued
+    Transaction::Updates _pendingUpdates;
+    size_t _pendingUpdatesBegin { 0 };
+    std::unordered_map<ItemID, uint32_t> _numPendingUpdatesByItem;
+    uint64_t _updatesExpiry { 0 };
+    uint32_t _numUpdatesThisFrame { 0 };
+
+    std::atomic<uint32_t> _numTransactionsProcessed { 0 };
+    std::atomic<uint32_t> _numItemUpdatesProcessed { 0 };
+    std::atomic<uint32_t> _numItemUpdatesPending { 0 };
+    std::atomic<uint64_t> _transactionProcessingTime { 0 };
+
+    bool isUpdateBudgetExpired() const;
+    void applyUpdate(const Transaction::Update& update);
+    void applyPendingUpdates();
+    // an item that is reset or removed gets its pending updates first, they were meant for its previous payload
+    void flushPendingUpdates(ItemID itemID);
+
     // The actual database
     // database of items is protected for editing by a mutex
     std::mutex _itemsMutex;
@@ -222,6 +252,7 @@ protected:
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
     void removeItems(const Transaction::Removes& transactions);
     void updateItems(const Transaction::Updates& transactions);
+    void updateItem(const Transaction::Update& update);
 
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
     void removeTransitionItems(const Transaction::TransitionRemoves& transactions);
@@ -10,6 +10,7 @@
 //
 #include "SpatialTree.h"
 
+#include <CullingBatch.h>
 #include <ViewFrustum.h>
 
 using namespace render;
@@ -445,12 +446,7 @@ int Octree::select(CellSelection& selection, const FrustumSelector& selector) co
     selectCellBrick(cellID, selection, false);
 
     // then traverse deeper
-    for (int i = 0; i < NUM_OCTANTS; i++) {
-        Index subCellID = cell.child((Link)i);
-        if (subCellID != INVALID_CELL) {
-            selectTraverse(subCellID, selection, selector);
-        }
-    }
+    selectChildren(cell, selection, selector);
 
     return (int)selection.size() - numSelectedsIn;
 }
@@ -515,7 +511,6 @@ Octree::Location::Intersection Octree::Location::intersectCell(const Location& c
 }
 
 int Octree::selectTraverse(Index cellID, CellSelection& selection, const FrustumSelector& selector) const {
-    int numSelectedsIn = (int) selection.size();
     auto cell = getConcreteCell(cellID);
 
     auto cellLocation = cell.getlocation();
@@ -525,39 +520,77 @@ int Octree::selectTraverse(Index cellID, CellSelection& selection, const Frustum
         case Octree::Location::Outside:
             // cell is outside, stop traversing this branch
             return 0;
-            break;
-        case Octree::Location::Inside: {
+        case Octree::Location::Inside:
             // traverse all the Cell Branch and collect items in the selection
-            selectBranch(cellID, selection, selector);
-            break;
-        }
+            return selectBranch(cellID, selection, selector);
         case Octree::Location::Intersect:
-        default: {
-            // Cell is partially in
-
-            // Test for lod
-            auto cellLocation = cell.getlocation();
-            float test = selector.testThreshold(cellLocation.getCenter(), Octree::getCoordSubcellWidth(cellLocation.depth));
-            if (test < 0.0f) {
-                return 0;
-            }
-
-            // Select this cell partially in frustum
-            selectCellBrick(cellID, selection, false);
-
-            // then traverse deeper
-            for (int i = 0; i < NUM_OCTANTS; i++) {
-                Index subCellID = cell.child((Link)i);
-                if (subCellID != INVALID_CELL) {
-                    selectTraverse(subCellID, selection, selector);
-                }
-            }
+        default:
+            return selectPartialCell(cellID, selection, selector);
+    }
+}
+
+int Octree::selectChildren(const Cell& cell, CellSelection& selection, const FrustumSelector& selector) const {
+    int numSelectedsIn = (int) selection.size();
+
+    // Same test as Location::intersectCell, on the 8 subcells at once
+    Index subCellIDs[NUM_OCTANTS];
+    CullingBoxBatch boxes;
+    for (int i = 0; i < NUM_OCTANTS; i++) {
+        Index subCellID = cell.child((Link)i);
+        if (subCellID != INVALID_CELL) {
+            auto subCellLocation = getConcreteCell(subCellID).getlocation();
+            float cellSize = Octree::getInvDepthDimension(subCellLocation.depth);
+            subCellIDs[boxes.count] = subCellID;
+            boxes.add(Coord3f(subCellLocation.pos) * cellSize, cellSize);
+        }
+    }
+    if (boxes.count == 0) {
+        return 0;
+    }
+
+    uint8_t outsideMask;
+    uint8_t intersectMask;
+    cullingClassifyBoxes(boxes, selector.frustum, ViewFrustum::NUM_PLANES, outsideMask, intersectMask);
+
+    for (int i = 0; i < boxes.count; i++) {
+        uint8_t bit = 1 << i;
+        if (outsideMask & bit) {
+            // cell is outside, stop traversing this branch
+            continue;
+        }
+        if (intersectMask & bit) {
+            selectPartialCell(subCellIDs[i], selection, selector);
+        } else {
+            // traverse all the Cell Branch and collect items in the selection
+            selectBranch(subCellIDs[i], selection, selector);
         }
     }
 
     return (int) selection.size() - numSelectedsIn;
 }
 
+int Octree::selectPartialCell(Index cellID, CellSelection& selection, const FrustumSelector& selector) const {
+    int numSelectedsIn = (int) selection.size();
+    auto cell = getConcreteCell(cellID);
+
+    // Cell is partially in
+
+    // Test for lod
+    auto cellLocation = cell.getlocation();
+    float test = selector.testThreshold(cellLocation.getCenter(), Octree::getCoordSubcellWidth(cellLocation.depth));
+    if (test < 0.0f) {
+        return 0;
+    }
+
+    // Select this cell partially in frustum
+    selectCellBrick(cellID, selection, false);
+
+    // then traverse deeper
+    selectChildren(cell, selection, selector);
+
+    return (int) selection.size() - numSelectedsIn;
+}
+
 
 int Octree::selectBranch(Index cellID, CellSelection& selection, const FrustumSelector& selector) const {
     int numSelectedsIn = (int) selection.size();
@@ -337,6 +337,9 @@ namespace render {
 
         int select(CellSelection& selection, const FrustumSelector& selector) const;
         int selectTraverse(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
+        // the subcells of the cell, tested against the frustum all at once
+        int selectChildren(const Cell& cell, CellSelection& selection, const FrustumSelector& selector) const;
+        int selectPartialCell(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
         int selectBranch(Index cellID, CellSelection& selection, const FrustumSelector& selector) const;
         int selectCellBrick(Index cellID, CellSelection& selection, bool inside) const;
 
@@ -15,6 +15,7 @@
 
 #include <shared/QtHelpers.h>
 
+#include "ScriptAudioEmitter.h"
 #include "ScriptAudioInjector.h"
 #include "ScriptEngineLogging.h"
 
@@ -65,6 +66,14 @@ ScriptAudioInjector* AudioScriptingInterface::playSound(SharedSoundPointer sound
     }
 }
 
+ScriptAudioEmitter* AudioScriptingInterface::addSoundEmitter(const QUrl& soundURL, const AudioInjectorOptions& options) {
+    if (!soundURL.isValid()) {
+        qCDebug(scriptengine) << "AudioScriptingInterface::addSoundEmitter called with an invalid URL.";
+        return nullptr;
+    }
+    return new ScriptAudioEmitter(soundURL, options);
+}
+
 void AudioScriptingInterface::setStereoInput(bool stereo) {
     if (_localAudioInterface) {
         QMetaObject::invokeMethod(_localAudioInterface, "setIsStereoInput", Q_ARG(bool, stereo));
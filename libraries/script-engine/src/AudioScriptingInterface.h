@@ -17,6 +17,7 @@
 #include <DependencyManager.h>
 #include <Sound.h>
 
+class ScriptAudioEmitter;
 class ScriptAudioInjector;
 
 class AudioScriptingInterface : public QObject, public Dependency {
@@ -202,6 +203,18 @@ protected:
      */
     Q_INVOKABLE ScriptAudioInjector* playSystemSound(SharedSoundPointer sound);
 
+    /*@jsdoc
+     * Adds a sound emitter hosted by the audio mixer: the mixer loads the audio file and mixes it itself, the script only 
+     * sends it the emitter's options when they change. Use it for the long or looping sounds played from assignment client 
+     * and server entity scripts, that otherwise stream the whole sound to the mixer.
+     * <p>Ambisonic sounds can't be played by an emitter.</p>
+     * @function Audio.addSoundEmitter
+     * @param {string} soundURL - The URL of the audio file, which must be reachable by the audio mixer.
+     * @param {AudioInjector.AudioInjectorOptions} [options={}] - Configures where and how the emitter plays the audio file.
+     * @returns {AudioEmitter} The emitter that plays the audio file.
+     */
+    Q_INVOKABLE ScriptAudioEmitter* addSoundEmitter(const QUrl& soundURL, const AudioInjectorOptions& options = AudioInjectorOptions());
+
     /*@jsdoc
      * Sets whether the audio input should be used in stereo. If the audio input doesn't support stereo then setting a value 
      * of <code>true</code> has no effect.
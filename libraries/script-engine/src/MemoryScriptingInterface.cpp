@@ -0,0 +1,22 @@
+//
+//  MemoryScriptingInterface.cpp
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MemoryScriptingInterface.h"
+
+#include <MemoryAccounting.h>
+
+QVariantMap MemoryScriptingInterface::getUsage() const {
+    return MemoryAccounting::getInstance().toJson().toVariantMap();
+}
+
+void MemoryScriptingInterface::logSnapshot() const {
+    MemoryAccounting::getInstance().logSnapshot();
+}
@@ -0,0 +1,58 @@
+//
+//  MemoryScriptingInterface.h
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_MemoryScriptingInterface_h
+#define hifi_MemoryScriptingInterface_h
+
+#include <QtCore/QObject>
+#include <QtCore/QVariantMap>
+
+/*@jsdoc
+ * The <code>Memory</code> API reports how much memory the subsystems of the process account for: the resource caches,
+ * the sound data, the entities, the script engines and the packet buffers.
+ *
+ * @namespace Memory
+ *
+ * @hifi-interface
+ * @hifi-client-entity
+ * @hifi-avatar
+ * @hifi-server-entity
+ * @hifi-assignment-client
+ */
+class MemoryScriptingInterface : public QObject {
+    Q_OBJECT
+
+public:
+    MemoryScriptingInterface(QObject* parent = nullptr) : QObject(parent) {}
+
+    /*@jsdoc
+     * Gets the memory each subsystem accounts for.
+     * @function Memory.getUsage
+     * @returns {object} <code>accounted_bytes</code>, the sum of the subsystems; <code>process_used_bytes</code> and
+     *     <code>process_peak_used_bytes</code>, where the platform reports them; and <code>usage</code>, an object with
+     *     the <code>bytes</code>, <code>peak_bytes</code> and <code>count</code> of each subsystem by name. Subsystems that
+     *     only count their objects report <code>0</code> bytes.
+     * @example <caption>Report the size of the texture cache.</caption>
+     * var usage = Memory.getUsage().usage["resources.TextureCache"];
+     * print("Textures: " + usage.count + ", " + (usage.bytes / 1048576).toFixed(1) + " MB");
+     */
+    Q_INVOKABLE QVariantMap getUsage() const;
+
+    /*@jsdoc
+     * Writes the memory each subsystem accounts for to the log.
+     * @function Memory.logSnapshot
+     */
+    Q_INVOKABLE void logSnapshot() const;
+};
+
+#endif // hifi_MemoryScriptingInterface_h
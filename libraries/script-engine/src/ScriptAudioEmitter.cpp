@@ -0,0 +1,81 @@
+//
+//  ScriptAudioEmitter.cpp
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptAudioEmitter.h"
+
+#include <NodeList.h>
+
+QScriptValue emitterToScriptValue(QScriptEngine* engine, ScriptAudioEmitter* const& in) {
+    if (!in) {
+        return QScriptValue(QScriptValue::NullValue);
+    }
+
+    return engine->newQObject(in, QScriptEngine::ScriptOwnership);
+}
+
+void emitterFromScriptValue(const QScriptValue& object, ScriptAudioEmitter*& out) {
+    out = qobject_cast<ScriptAudioEmitter*>(object.toQObject());
+}
+
+ScriptAudioEmitter::ScriptAudioEmitter(const QUrl& soundURL, const AudioInjectorOptions& options) :
+    _properties(QUuid::createUuid(), soundURL, options),
+    _options(options)
+{
+    // a new mixer doesn't know about the emitter
+    auto nodeList = DependencyManager::get<NodeList>();
+    connect(nodeList.data(), &LimitedNodeList::nodeActivated, this, &ScriptAudioEmitter::handleNodeActivated);
+
+    sendProperties();
+}
+
+ScriptAudioEmitter::~ScriptAudioEmitter() {
+    stop();
+}
+
+void ScriptAudioEmitter::setOptions(const AudioInjectorOptions& options) {
+    if (_properties.isRemoved) {
+        return;
+    }
+
+    // the offset only applies when the sound starts
+    auto secondOffset = _properties.secondOffset;
+    _properties = AudioEmitterProperties(_properties.emitterID, _properties.soundURL, options);
+    _properties.secondOffset = secondOffset;
+    _options = options;
+
+    sendProperties();
+}
+
+void ScriptAudioEmitter::stop() {
+    if (_properties.isRemoved) {
+        return;
+    }
+    _properties.isRemoved = true;
+    sendProperties();
+}
+
+void ScriptAudioEmitter::handleNodeActivated(SharedNodePointer node) {
+    if (node->getType() == NodeType::AudioMixer && !_properties.isRemoved) {
+        sendProperties();
+    }
+}
+
+void ScriptAudioEmitter::sendProperties() {
+    // the NodeList may have been destroyed on shutdown, the mixer drops the emitters of a node that leaves
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (!nodeList) {
+        return;
+    }
+    auto audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (audioMixer && audioMixer->getActiveSocket()) {
+        nodeList->sendPacket(_properties.createPacket(), *audioMixer);
+    }
+}
@@ -0,0 +1,81 @@
+//
+//  ScriptAudioEmitter.h
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptAudioEmitter_h
+#define hifi_ScriptAudioEmitter_h
+
+#include <QtCore/QObject>
+#include <QtScript/QScriptEngine>
+
+#include <AudioEmitterProperties.h>
+#include <AudioInjectorOptions.h>
+#include <Node.h>
+
+/*@jsdoc
+ * Plays the content of an audio file from the audio mixer, which loads and mixes the sound itself instead of receiving it 
+ * from the script.
+ *
+ * <p>Create using {@link Audio.addSoundEmitter}.</p>
+ *
+ * @class AudioEmitter
+ *
+ * @hifi-server-entity
+ * @hifi-assignment-client
+ *
+ * @property {AudioInjector.AudioInjectorOptions} options - Configures how the emitter plays the audio. The 
+ *     <code>stereo</code>, <code>localOnly</code> and <code>secondOffset</code> options (after it has started) are ignored.
+ */
+class ScriptAudioEmitter : public QObject {
+    Q_OBJECT
+
+    Q_PROPERTY(AudioInjectorOptions options WRITE setOptions READ getOptions)
+public:
+    ScriptAudioEmitter(const QUrl& soundURL, const AudioInjectorOptions& options);
+    ~ScriptAudioEmitter();
+
+public slots:
+
+    /*@jsdoc
+     * Gets the current configuration of the audio emitter.
+     * @function AudioEmitter.getOptions
+     * @returns {AudioInjector.AudioInjectorOptions} Configuration of how the emitter plays the audio.
+     */
+    AudioInjectorOptions getOptions() const { return _options; }
+
+    /*@jsdoc
+     * Configures how the emitter plays the audio.
+     * @function AudioEmitter.setOptions
+     * @param {AudioInjector.AudioInjectorOptions} options - Configuration of how the emitter plays the audio.
+     */
+    void setOptions(const AudioInjectorOptions& options);
+
+    /*@jsdoc
+     * Stops the audio and removes the emitter from the audio mixer.
+     * @function AudioEmitter.stop
+     */
+    void stop();
+
+private slots:
+    void handleNodeActivated(SharedNodePointer node);
+
+private:
+    void sendProperties();
+
+    AudioEmitterProperties _properties;
+    AudioInjectorOptions _options;
+};
+
+Q_DECLARE_METATYPE(ScriptAudioEmitter*)
+
+QScriptValue emitterToScriptValue(QScriptEngine* engine, ScriptAudioEmitter* const& in);
+void emitterFromScriptValue(const QScriptValue& object, ScriptAudioEmitter*& out);
+
+#endif // hifi_ScriptAudioEmitter_h
@@ -12,8 +12,10 @@
 #include "ScriptEngine.h"
 
 #include <chrono>
+#include <memory>
 #include <thread>
 
+#include <QtCore/QAbstractEventDispatcher>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFileInfo>
@@ -46,6 +48,7 @@
 #include <AvatarData.h>
 #include <DebugDraw.h>
 #include <EntityScriptingInterface.h>
+#include <MemoryAccounting.h>
 #include <MessagesClient.h>
 #include <NetworkAccessManager.h>
 #include <PathUtils.h>
@@ -66,11 +69,14 @@
 #include "DataViewClass.h"
 #include "EventTypes.h"
 #include "FileScriptingInterface.h" // unzip project
+#include "MemoryScriptingInterface.h"
 #include "MenuItemProperties.h"
+#include "ScriptAudioEmitter.h"
 #include "ScriptAudioInjector.h"
 #include "ScriptAvatarData.h"
 #include "ScriptCache.h"
 #include "ScriptEngineLogging.h"
+#include "ScriptProgramCache.h"
 #include "TypedArrays.h"
 #include "XMLHttpRequestClass.h"
 #include "WebSocketClass.h"
@@ -103,6 +109,12 @@ static const QScriptValue::PropertyFlags READONLY_HIDDEN_PROP_FLAGS { READONLY_P
 
 static const bool HIFI_AUTOREFRESH_FILE_SCRIPTS { true };
 
+// only counted, QScriptEngine doesn't tell how large its heap is
+static MemoryTag& scriptEnginesTag() {
+    static MemoryTag tag("scripts.engines");
+    return tag;
+}
+
 Q_DECLARE_METATYPE(QScriptEngine::FunctionSignature)
 int functionSignatureMetaID = qRegisterMetaType<QScriptEngine::FunctionSignature>();
 
@@ -284,6 +296,8 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
             }
         });
     }
+
+    scriptEnginesTag().allocated(0);
 }
 
 QString ScriptEngine::getTypeAsString() const {
@@ -315,7 +329,9 @@ bool ScriptEngine::isDebugMode() const {
 #endif
 }
 
-ScriptEngine::~ScriptEngine() {}
+ScriptEngine::~ScriptEngine() {
+    scriptEnginesTag().freed(0);
+}
 
 void ScriptEngine::disconnectNonEssentialSignals() {
     disconnect();
@@ -810,6 +826,7 @@ void ScriptEngine::init() {
     globalObject().setProperty("AudioEffectOptions", audioEffectOptionsConstructorValue);
 
     qScriptRegisterMetaType(this, injectorToScriptValue, injectorFromScriptValue);
+    qScriptRegisterMetaType(this, emitterToScriptValue, emitterFromScriptValue);
     qScriptRegisterMetaType(this, inputControllerToScriptValue, inputControllerFromScriptValue);
     qScriptRegisterMetaType(this, avatarDataToScriptValue, avatarDataFromScriptValue);
     qScriptRegisterMetaType(this, animationDetailsToScriptValue, animationDetailsFromScriptValue);
@@ -840,12 +857,14 @@ void ScriptEngine::init() {
 
     registerGlobalObject("Entities", entityScriptingInterface.data());
     registerFunction("Entities", "getMultipleEntityProperties", EntityScriptingInterface::getMultipleEntityProperties);
+    registerFunction("Entities", "editEntities", EntityScriptingInterface::editEntities);
     registerGlobalObject("Quat", &_quatLibrary);
     registerGlobalObject("Vec3", &_vec3Library);
     registerGlobalObject("Mat4", &_mat4Library);
     registerGlobalObject("Uuid", &_uuidLibrary);
     registerGlobalObject("Messages", DependencyManager::get<MessagesClient>().data());
     registerGlobalObject("File", new FileScriptingInterface(this));
+    registerGlobalObject("Memory", new MemoryScriptingInterface(this));
     registerGlobalObject("console", &_consoleScriptingInterface);
     registerFunction("console", "info", ConsoleScriptingInterface::info, currentContext()->argumentCount());
     registerFunction("console", "log", ConsoleScriptingInterface::log, currentContext()->argumentCount());
@@ -1225,17 +1244,22 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
         return result;
     }
 
-    // Check syntax
-    auto syntaxError = lintScript(sourceCode, fileName);
-    if (syntaxError.isError()) {
-        if (!isEvaluating()) {
-            syntaxError.setProperty("detail", "evaluate");
+    // Check syntax, unless this script engine or another already did
+    const auto contentsHash = ScriptProgramCache::hashContents(sourceCode);
+    auto& programCache = ScriptProgramCache::getInstance();
+    if (!programCache.hasPassed(contentsHash, ScriptProgramCache::SYNTAX)) {
+        auto syntaxError = lintScript(sourceCode, fileName);
+        if (syntaxError.isError()) {
+            if (!isEvaluating()) {
+                syntaxError.setProperty("detail", "evaluate");
+            }
+            raiseException(syntaxError);
+            maybeEmitUncaughtException("lint");
+            return syntaxError;
         }
-        raiseException(syntaxError);
-        maybeEmitUncaughtException("lint");
-        return syntaxError;
+        programCache.setPassed(contentsHash, ScriptProgramCache::SYNTAX);
     }
-    QScriptProgram program { sourceCode, fileName, lineNumber };
+    QScriptProgram program = getProgram(sourceCode, fileName, lineNumber, contentsHash);
     if (program.isNull()) {
         // can this happen?
         auto err = makeError("could not create QScriptProgram for " + fileName);
@@ -1252,6 +1276,24 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
     return result;
 }
 
+QScriptProgram ScriptEngine::getProgram(const QString& sourceCode, const QString& fileName, int lineNumber,
+                                        const QByteArray& contentsHash) {
+    // the same contents evaluated again, e.g. for each entity running the same script, aren't compiled again
+    static const int MAX_CACHED_PROGRAMS = 256;
+    const QString key = QString("%1:%2:%3").arg(fileName).arg(lineNumber).arg(QString(contentsHash.toHex()));
+    auto it = _programs.constFind(key);
+    if (it != _programs.constEnd()) {
+        return it.value();
+    }
+
+    if (_programs.size() >= MAX_CACHED_PROGRAMS) {
+        _programs.clear();
+    }
+    QScriptProgram program { sourceCode, fileName, lineNumber };
+    _programs.insert(key, program);
+    return program;
+}
+
 void ScriptEngine::run() {
     if (QThread::currentThread() != qApp->thread() && _context == Context::CLIENT_SCRIPT) {
         // Flag that we're allowed to access local HTML files on UI created from C++ calls on this thread
@@ -1277,6 +1319,20 @@ void ScriptEngine::run() {
     _isRunning = true;
     emit runningStateChanged();
 
+    // the thread is busy whenever its event loop isn't blocked waiting for events
+    _threadLoadMeasuredSince = usecTimestampNow();
+    if (auto dispatcher = QAbstractEventDispatcher::instance()) {
+        connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, [this] {
+            _threadBlockedSince = usecTimestampNow();
+        }, Qt::DirectConnection);
+        connect(dispatcher, &QAbstractEventDispatcher::awake, this, [this] {
+            quint64 blockedSince = _threadBlockedSince.exchange(0);
+            if (blockedSince != 0) {
+                _threadBlockedUsecs += usecTimestampNow() - blockedSince;
+            }
+        }, Qt::DirectConnection);
+    }
+
     {
         PROFILE_RANGE(script, _fileNameString);
         evaluate(_scriptContents, _fileNameString);
@@ -1547,7 +1603,7 @@ void ScriptEngine::timerFired() {
     if (timerData.function.isValid()) {
         PROFILE_RANGE(script, __FUNCTION__);
         auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList(), "timer");
         auto postTimer = p_high_resolution_clock::now();
         auto elapsed = (postTimer - preTimer);
         _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
@@ -2100,7 +2156,7 @@ void ScriptEngine::include(const QStringList& includeFiles, QScriptValue callbac
         _parentURL = parentURL;
 
         if (callback.isFunction()) {
-            callWithEnvironment(capturedEntityIdentifier, capturedSandboxURL, QScriptValue(callback), QScriptValue(), QScriptValueList());
+            callWithEnvironment(capturedEntityIdentifier, capturedSandboxURL, QScriptValue(callback), QScriptValue(), QScriptValueList(), "include");
         }
 
         loader->deleteLater();
@@ -2183,7 +2239,7 @@ void ScriptEngine::forwardHandlerCall(const EntityItemID& entityID, const QStrin
             // and the entity scripts may be for entities other than the one this is a handler for.
             // Fortunately, the definingEntityIdentifier captured the entity script id (if any) when the handler was added.
             CallbackData& handler = handlersForEvent[i];
-            callWithEnvironment(handler.definingEntityIdentifier, handler.definingSandboxURL, handler.function, QScriptValue(), eventHandlerArgs);
+            callWithEnvironment(handler.definingEntityIdentifier, handler.definingSandboxURL, handler.function, QScriptValue(), eventHandlerArgs, eventName);
         }
     }
 }
@@ -2263,6 +2319,25 @@ QFuture<QVariant> ScriptEngine::getLocalEntityScriptDetails(const EntityItemID&
     return QtConcurrent::run(this, &ScriptEngine::cloneEntityScriptDetails, entityID);
 }
 
+float ScriptEngine::getAndResetThreadLoad() {
+    quint64 now = usecTimestampNow();
+    quint64 measuredSince = _threadLoadMeasuredSince.exchange(now);
+    if (measuredSince == 0 || now <= measuredSince) {
+        return 0.0f;
+    }
+
+    // count the part of a wait still in progress now, the rest of it goes to the next measure
+    quint64 blockedUsecs = 0;
+    quint64 blockedSince = _threadBlockedSince;
+    if (blockedSince != 0 && _threadBlockedSince.compare_exchange_strong(blockedSince, now)) {
+        blockedUsecs += now - std::max(blockedSince, measuredSince);
+    }
+    blockedUsecs += _threadBlockedUsecs.exchange(0);
+
+    float blockedRatio = (float)blockedUsecs / (float)(now - measuredSince);
+    return std::max(0.0f, std::min(1.0f - blockedRatio, 1.0f));
+}
+
 bool ScriptEngine::getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const {
     QReadLocker locker { &_entityScriptsLock };
     auto it = _entityScripts.constFind(entityID);
@@ -2429,16 +2504,21 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     }
 
     // SYNTAX ERRORS
-    auto syntaxError = lintScript(contents, fileName);
-    if (syntaxError.isError()) {
-        auto message = syntaxError.property("formatted").toString();
-        if (message.isEmpty()) {
-            message = syntaxError.toString();
-        }
-        setError(QString("Bad syntax (%1)").arg(message), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        syntaxError.setProperty("detail", entityID.toString());
-        emit unhandledException(syntaxError);
-        return;
+    const auto contentsHash = ScriptProgramCache::hashContents(contents);
+    auto& programCache = ScriptProgramCache::getInstance();
+    if (!programCache.hasPassed(contentsHash, ScriptProgramCache::SYNTAX)) {
+        auto syntaxError = lintScript(contents, fileName);
+        if (syntaxError.isError()) {
+            auto message = syntaxError.property("formatted").toString();
+            if (message.isEmpty()) {
+                message = syntaxError.toString();
+            }
+            setError(QString("Bad syntax (%1)").arg(message), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            syntaxError.setProperty("detail", entityID.toString());
+            emit unhandledException(syntaxError);
+            return;
+        }
+        programCache.setPassed(contentsHash, ScriptProgramCache::SYNTAX);
     }
     QScriptProgram program { contents, fileName };
     if (program.isNull()) {
@@ -2452,32 +2532,42 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     }
 
     // SANITY/PERFORMANCE CHECK USING SANDBOX
+    // contents that already passed it for another entity, in this script engine or another, don't need to again
+    const bool isPreflighted = programCache.hasPassed(contentsHash, ScriptProgramCache::ENTITY_PREFLIGHT);
     const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
-    BaseScriptEngine sandbox;
-    sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
+    std::unique_ptr<BaseScriptEngine> sandbox;
     QScriptValue testConstructor, exception;
-    if (atoi(getenv("UNSAFE_ENTITY_SCRIPTS") ? getenv("UNSAFE_ENTITY_SCRIPTS") : "0"))
-    {
+    auto preflight = [&] {
+        sandbox.reset(new BaseScriptEngine());
+        sandbox->setProcessEventsInterval(SANDBOX_TIMEOUT);
+        BaseScriptEngine* sandboxEngine = sandbox.get();
+
         QTimer timeout;
         timeout.setSingleShot(true);
         timeout.start(SANDBOX_TIMEOUT);
-        connect(&timeout, &QTimer::timeout, [=, &sandbox]{
-                qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout";
+        connect(&timeout, &QTimer::timeout, [=] {
+            qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout";
 
-                // Guard against infinite loops and non-performant code
-                sandbox.raiseException(
-                    sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
-                );
+            // Guard against infinite loops and non-performant code
+            sandboxEngine->raiseException(
+                sandboxEngine->makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT)));
         });
 
-        testConstructor = sandbox.evaluate(program);
+        testConstructor = sandbox->evaluate(program);
 
-        if (sandbox.hasUncaughtException()) {
-            exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
-            sandbox.clearExceptions();
+        if (sandbox->hasUncaughtException()) {
+            exception = sandbox->cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
+            sandbox->clearExceptions();
         } else if (testConstructor.isError()) {
             exception = testConstructor;
         }
+    };
+
+    if (atoi(getenv("UNSAFE_ENTITY_SCRIPTS") ? getenv("UNSAFE_ENTITY_SCRIPTS") : "0"))
+    {
+        if (!isPreflighted) {
+            preflight();
+        }
     } else {
         // ENTITY SCRIPT WHITELIST STARTS HERE
         auto nodeList = DependencyManager::get<NodeList>();
@@ -2533,26 +2623,8 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         if (!passList) { // If the entity failed to pass for any reason, it's blocked and an error is thrown.
             qCDebug(scriptengine) << whitelistPrefix << "(disabled entity script)" << entityID.toString() << scriptOrURL;
             exception = makeError("UNSAFE_ENTITY_SCRIPTS == 0");
-        } else {
-            QTimer timeout;
-            timeout.setSingleShot(true);
-            timeout.start(SANDBOX_TIMEOUT);
-            connect(&timeout, &QTimer::timeout, [=, &sandbox] {
-                qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout";
-
-                // Guard against infinite loops and non-performant code
-                sandbox.raiseException(
-                    sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT)));
-            });
-
-            testConstructor = sandbox.evaluate(program);
-
-            if (sandbox.hasUncaughtException()) {
-                exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
-                sandbox.clearExceptions();
-            } else if (testConstructor.isError()) {
-                exception = testConstructor;
-            }
+        } else if (!isPreflighted) {
+            preflight();
         }
       // ENTITY SCRIPT WHITELIST ENDS HERE, uncomment below for original full disabling.
 
@@ -2569,7 +2641,7 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     }
 
     // CONSTRUCTOR VIABILITY
-    if (!testConstructor.isFunction()) {
+    if (!isPreflighted && !testConstructor.isFunction()) {
         QString testConstructorType = QString(testConstructor.toVariant().typeName());
         if (testConstructorType == "") {
             testConstructorType = "empty";
@@ -2589,6 +2661,7 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         emit unhandledException(err);
         return; // done processing script
     }
+    programCache.setPassed(contentsHash, ScriptProgramCache::ENTITY_PREFLIGHT);
 
     // (this feeds into refreshFileScript)
     int64_t lastModified = 0;
@@ -2680,6 +2753,7 @@ void ScriptEngine::unloadEntityScript(const EntityItemID& entityID, bool shouldR
                 QWriteLocker locker { &_entityScriptsLock };
                 _entityScripts.remove(entityID);
             }
+            _profiler.forgetScript(entityID.toString());
             emit entityScriptDetailsUpdated();
         } else if (oldDetails.status != EntityScriptStatus::UNLOADED) {
             EntityScriptDetails newDetails;
@@ -2787,11 +2861,41 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     currentSandboxURL = oldSandboxURL;
 }
 
-void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args) {
+void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args,
+                                       const QString& handlerName) {
+    // the engine's own script when there is no entity
+    QString script = entityID.isNull() ? _fileNameString : entityID.toString();
+
+    // the lifecycle methods are never throttled, an entity script that misses them would be left in a bad state
+    bool canThrottle = handlerName != "preload" && handlerName != "unload";
+    quint64 start = usecTimestampNow();
+    auto callStart = canThrottle ? _profiler.startCall(script, start) : ScriptProfiler::Start::Allowed;
+    if (callStart != ScriptProfiler::Start::Allowed) {
+        if (callStart == ScriptProfiler::Start::FirstThrottled) {
+            qCWarning(scriptengine) << "Script" << script << "is over its budget of" << _profiler.getBudget() / USECS_PER_MSEC
+                                    << "ms per second, its calls are skipped until it is back within it";
+        }
+        return;
+    }
+
     auto operation = [&]() {
         function.call(thisObject, args);
     };
     doWithEnvironment(entityID, sandboxURL, operation);
+
+    _profiler.endCall(script, handlerName, usecTimestampNow() - start);
+}
+
+void ScriptEngine::setScriptBudget(int msecsPerSecond) {
+    _profiler.setBudget(msecsPerSecond > 0 ? (quint64)msecsPerSecond * USECS_PER_MSEC : 0);
+}
+
+QVariantMap ScriptEngine::getProfile() const {
+    return _profiler.getProfile();
+}
+
+QVariantList ScriptEngine::getSlowestScripts(int maxScripts) const {
+    return _profiler.getSlowestScripts(maxScripts);
 }
 
 void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName, const QStringList& params, const QUuid& remoteCallerID) {
@@ -2855,7 +2959,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
 
             QScriptValue oldData = this->globalObject().property("Script").property("remoteCallerID");
             this->globalObject().property("Script").setProperty("remoteCallerID", remoteCallerID.toString()); // Make the remoteCallerID available to javascript as a global.
-            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
+            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args, methodName);
             this->globalObject().property("Script").setProperty("remoteCallerID", oldData);
         }
     }
@@ -2893,7 +2997,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             QScriptValueList args;
             args << entityID.toScriptValue(this);
             args << event.toScriptValue(this);
-            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
+            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args, methodName);
         }
     }
 }
@@ -2932,7 +3036,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             args << entityID.toScriptValue(this);
             args << otherID.toScriptValue(this);
             args << collisionToScriptValue(this, collision);
-            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
+            callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args, methodName);
         }
     }
 }
@@ -13,6 +13,7 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include <QMetaEnum>
 
 #include <QtScript/QScriptEngine>
+#include <QtScript/QScriptProgram>
 
 #include <AnimationCache.h>
 #include <AnimVariant.h>
@@ -44,6 +46,7 @@
 #include "Quat.h"
 #include "Mat4.h"
 #include "ScriptCache.h"
+#include "ScriptProfiler.h"
 #include "ScriptUUID.h"
 #include "Vec3.h"
 #include "ConsoleScriptingInterface.h"
@@ -553,6 +556,32 @@ public:
      */
     Q_INVOKABLE QUrl resourcesPath() const;
 
+    /*@jsdoc
+     * Gets the time spent running each script in this script engine: the engine's own script, identified by its filename, 
+     * and each entity script, identified by its entity ID. The time is broken down by handler: <code>"timer"</code> for 
+     * timers, <code>"include"</code> for include callbacks, the event name for entity event handlers and the method name for
+     * entity methods. Time spent in callbacks connected to signals with <code>connect()</code> isn't included.
+     * @function Script.getProfile
+     * @returns {Object<string, Script.ScriptProfile>} The profile of each script, keyed by script.
+     * @example <caption>Report the handlers that took the most time.</caption>
+     * var profile = Script.getProfile();
+     * for (var script in profile) {
+     *     for (var handler in profile[script].handlers) {
+     *         print(script, handler, JSON.stringify(profile[script].handlers[handler]));
+     *     }
+     * }
+     */
+    /*@jsdoc
+     * @typedef {object} Script.ScriptProfile
+     * @property {number} calls - The number of calls made.
+     * @property {number} totalTime - The total time spent in the calls, in ms.
+     * @property {number} maxTime - The longest call, in ms.
+     * @property {number} throttledCalls - The number of calls skipped because the script was over its budget.
+     * @property {Object<string, object>} handlers - The <code>calls</code>, <code>totalTime</code> and
+     *     <code>maxTime</code> of each handler.
+     */
+    Q_INVOKABLE QVariantMap getProfile() const;
+
     /*@jsdoc
      * Starts timing a section of code in order to send usage data about it to Vircadia. Shouldn't be used outside of the 
      * standard scripts.
@@ -691,6 +720,12 @@ public:
     void scriptPrintedMessage(const QString& message);
     void clearDebugLogWindow();
     int getNumRunningEntityScripts() const;
+    // the share of the time the engine's thread was busy since the last call, from 0 to 1
+    float getAndResetThreadLoad();
+    // the time each script may spend running per second before its calls are skipped, 0 for no budget
+    void setScriptBudget(int msecsPerSecond);
+    // the scripts that took the most time so far, as in getProfile
+    QVariantList getSlowestScripts(int maxScripts) const;
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
@@ -965,7 +1000,9 @@ protected:
     EntityItemID currentEntityIdentifier; // Contains the defining entity script entity id during execution, if any. Empty for interface script execution.
     QUrl currentSandboxURL; // The toplevel url string for the entity script that loaded the code being executed, else empty.
     void doWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, std::function<void()> operation);
-    void callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args);
+    void callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args,
+                             const QString& handlerName);
+    QScriptProgram getProgram(const QString& sourceCode, const QString& fileName, int lineNumber, const QByteArray& contentsHash);
 
     Context _context;
     Type _type;
@@ -1007,6 +1044,15 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    // for getAndResetThreadLoad, the time the engine's event loop spent blocked waiting for events
+    std::atomic<quint64> _threadBlockedUsecs { 0 };
+    std::atomic<quint64> _threadBlockedSince { 0 }; // 0 while the thread is awake
+    std::atomic<quint64> _threadLoadMeasuredSince { 0 };
+
+    ScriptProfiler _profiler;
+
+    QHash<QString, QScriptProgram> _programs; // compiled, by file name, line number and contents hash
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
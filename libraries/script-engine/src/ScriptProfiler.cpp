@@ -0,0 +1,127 @@
+//
+//  ScriptProfiler.cpp
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <NumericalConstants.h>
+
+static const quint64 BUDGET_WINDOW_USECS = USECS_PER_SECOND;
+
+void ScriptProfiler::CallStats::add(quint64 usecs) {
+    ++calls;
+    totalUsecs += usecs;
+    maxUsecs = std::max(maxUsecs, usecs);
+}
+
+static QVariantMap toVariantMap(const ScriptProfiler::CallStats& stats) {
+    QVariantMap map;
+    map["calls"] = stats.calls;
+    map["totalTime"] = (double)stats.totalUsecs / USECS_PER_MSEC;
+    map["maxTime"] = (double)stats.maxUsecs / USECS_PER_MSEC;
+    return map;
+}
+
+void ScriptProfiler::setBudget(quint64 usecsPerSecond) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _budgetUsecs = usecsPerSecond;
+}
+
+quint64 ScriptProfiler::getBudget() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _budgetUsecs;
+}
+
+ScriptProfiler::Start ScriptProfiler::startCall(const QString& script, quint64 now) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_budgetUsecs == 0) {
+        return Start::Allowed;
+    }
+
+    auto& stats = _scripts[script];
+    if (now - stats.windowStart >= BUDGET_WINDOW_USECS) {
+        // start a new window, going over the budget by a long call is paid for in the following ones
+        stats.windowUsecs = stats.windowUsecs > _budgetUsecs ? stats.windowUsecs - _budgetUsecs : 0;
+        stats.windowStart = now;
+    }
+    if (stats.windowUsecs < _budgetUsecs) {
+        stats.isThrottled = false;
+        return Start::Allowed;
+    }
+
+    ++stats.throttledCalls;
+    if (!stats.isThrottled) {
+        stats.isThrottled = true;
+        return Start::FirstThrottled;
+    }
+    return Start::Throttled;
+}
+
+void ScriptProfiler::endCall(const QString& script, const QString& handler, quint64 usecs) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& stats = _scripts[script];
+    stats.total.add(usecs);
+    stats.handlers[handler].add(usecs);
+    stats.windowUsecs += usecs;
+}
+
+QVariantMap ScriptProfiler::getProfile() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    QVariantMap profile;
+    for (auto it = _scripts.constBegin(); it != _scripts.constEnd(); ++it) {
+        const ScriptStats& stats = it.value();
+        QVariantMap scriptProfile = toVariantMap(stats.total);
+        scriptProfile["throttledCalls"] = stats.throttledCalls;
+
+        QVariantMap handlers;
+        for (auto handler = stats.handlers.constBegin(); handler != stats.handlers.constEnd(); ++handler) {
+            handlers[handler.key()] = toVariantMap(handler.value());
+        }
+        scriptProfile["handlers"] = handlers;
+        profile[it.key()] = scriptProfile;
+    }
+    return profile;
+}
+
+QVariantList ScriptProfiler::getSlowestScripts(int maxScripts) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<QHash<QString, ScriptStats>::const_iterator> scripts;
+    scripts.reserve(_scripts.size());
+    for (auto it = _scripts.constBegin(); it != _scripts.constEnd(); ++it) {
+        scripts.push_back(it);
+    }
+
+    int count = std::min(maxScripts, (int)scripts.size());
+    std::partial_sort(scripts.begin(), scripts.begin() + count, scripts.end(), [](const auto& a, const auto& b) {
+        return a.value().total.totalUsecs > b.value().total.totalUsecs;
+    });
+
+    QVariantList slowest;
+    for (int i = 0; i < count; ++i) {
+        QVariantMap scriptProfile = toVariantMap(scripts[i].value().total);
+        scriptProfile["script"] = scripts[i].key();
+        scriptProfile["throttledCalls"] = scripts[i].value().throttledCalls;
+        slowest.append(scriptProfile);
+    }
+    return slowest;
+}
+
+void ScriptProfiler::forgetScript(const QString& script) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _scripts.remove(script);
+}
+
+void ScriptProfiler::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _scripts.clear();
+}
@@ -0,0 +1,74 @@
+//
+//  ScriptProfiler.h
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptProfiler_h
+#define hifi_ScriptProfiler_h
+
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QVariantMap>
+
+// Accumulates the wall time a script engine spends in each script (the engine's own or an entity's), broken down by
+// handler: timers, event handlers and entity methods. It can also hold each script to a budget of time per second,
+// the calls made once a script is over its budget are skipped until the next second.
+//
+// Calls are recorded on the engine's thread, the results can be read from any thread.
+class ScriptProfiler {
+public:
+    struct CallStats {
+        quint64 calls { 0 };
+        quint64 totalUsecs { 0 };
+        quint64 maxUsecs { 0 };
+
+        void add(quint64 usecs);
+    };
+
+    // 0 for no budget
+    void setBudget(quint64 usecsPerSecond);
+    quint64 getBudget() const;
+
+    enum class Start {
+        Allowed,
+        Throttled,
+        FirstThrottled // the first call throttled since the script went over its budget
+    };
+
+    // the call shouldn't be made unless it is allowed, throttled calls are counted as such
+    Start startCall(const QString& script, quint64 now);
+    void endCall(const QString& script, const QString& handler, quint64 usecs);
+
+    // per script: totalTime, calls, maxTime (in ms), throttledCalls and the same for each of its handlers
+    QVariantMap getProfile() const;
+    // the scripts that took the most time, with their totalTime, calls, maxTime and throttledCalls
+    QVariantList getSlowestScripts(int maxScripts) const;
+
+    void forgetScript(const QString& script);
+    void clear();
+
+private:
+    struct ScriptStats {
+        CallStats total;
+        quint64 throttledCalls { 0 };
+        QHash<QString, CallStats> handlers;
+
+        quint64 windowStart { 0 };
+        quint64 windowUsecs { 0 };
+        bool isThrottled { false };
+    };
+
+    mutable std::mutex _mutex;
+    QHash<QString, ScriptStats> _scripts;
+    quint64 _budgetUsecs { 0 };
+};
+
+#endif // hifi_ScriptProfiler_h
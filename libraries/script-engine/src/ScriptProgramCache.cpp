@@ -0,0 +1,39 @@
+//
+//  ScriptProgramCache.cpp
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProgramCache.h"
+
+#include <QtCore/QCryptographicHash>
+
+// each entry is only a hash and some flags, this is only there to keep a domain that keeps generating scripts in check
+static const int MAX_CACHED_CONTENTS = 16384;
+
+ScriptProgramCache& ScriptProgramCache::getInstance() {
+    static ScriptProgramCache instance;
+    return instance;
+}
+
+QByteArray ScriptProgramCache::hashContents(const QString& contents) {
+    return QCryptographicHash::hash(contents.toUtf8(), QCryptographicHash::Md5);
+}
+
+bool ScriptProgramCache::hasPassed(const QByteArray& hash, Check check) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (_passedChecks.value(hash, 0) & check) != 0;
+}
+
+void ScriptProgramCache::setPassed(const QByteArray& hash, Check check) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_passedChecks.size() >= MAX_CACHED_CONTENTS && !_passedChecks.contains(hash)) {
+        _passedChecks.clear();
+    }
+    _passedChecks[hash] |= check;
+}
@@ -0,0 +1,45 @@
+//
+//  ScriptProgramCache.h
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptProgramCache_h
+#define hifi_ScriptProgramCache_h
+
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+// Remembers, across all the script engines, which script contents have already passed the checks made before they
+// are evaluated, so that the same library or entity script isn't parsed again and again just to be checked.
+//
+// Compiled programs and evaluated values belong to a single QScriptEngine and can't be shared, each ScriptEngine keeps
+// its own compiled programs.
+class ScriptProgramCache {
+public:
+    enum Check {
+        SYNTAX = 1 << 0, // the contents are free of syntax errors
+        ENTITY_PREFLIGHT = 1 << 1 // the contents evaluate to an entity script constructor in a sandbox
+    };
+
+    static ScriptProgramCache& getInstance();
+
+    static QByteArray hashContents(const QString& contents);
+
+    bool hasPassed(const QByteArray& hash, Check check) const;
+    void setPassed(const QByteArray& hash, Check check);
+
+private:
+    mutable std::mutex _mutex;
+    QHash<QByteArray, int> _passedChecks;
+};
+
+#endif // hifi_ScriptProgramCache_h
@@ -0,0 +1,129 @@
+//
+//  CullingBatch.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullingBatch.h"
+
+#include <algorithm>
+#include <math.h>
+
+// the same as ConicalViewFrustum::getAngularSize
+static const float AVOID_DIVIDE_BY_ZERO = 0.001f;
+
+static void cullingClassifyBoxes_ref(const CullingBoxBatch& boxes, const glm::vec4* planes, int numPlanes,
+                                     uint8_t& outsideMask, uint8_t& intersectMask) {
+    outsideMask = 0;
+    intersectMask = 0;
+    for (int i = 0; i < boxes.count; ++i) {
+        uint8_t bit = 1 << i;
+        for (int p = 0; p < numPlanes; ++p) {
+            const glm::vec4& plane = planes[p];
+            float base = plane.x * boxes.x[i] + plane.y * boxes.y[i] + plane.z * boxes.z[i] + plane.w;
+            // the farthest and nearest corners along the normal
+            float farthest = base + boxes.scaleX[i] * std::max(plane.x, 0.0f) + boxes.scaleY[i] * std::max(plane.y, 0.0f) +
+                             boxes.scaleZ[i] * std::max(plane.z, 0.0f);
+            if (farthest < 0.0f) {
+                outsideMask |= bit;
+                break;
+            }
+            float nearest = base + boxes.scaleX[i] * std::min(plane.x, 0.0f) + boxes.scaleY[i] * std::min(plane.y, 0.0f) +
+                            boxes.scaleZ[i] * std::min(plane.z, 0.0f);
+            if (nearest < 0.0f) {
+                intersectMask |= bit;
+            }
+        }
+    }
+    intersectMask &= ~outsideMask;
+}
+
+static uint8_t cullingSpheresInsidePlanes_ref(const CullingSphereBatch& spheres, const glm::vec4* planes, int numPlanes) {
+    uint8_t mask = 0;
+    for (int i = 0; i < spheres.count; ++i) {
+        bool isInside = true;
+        for (int p = 0; p < numPlanes && isInside; ++p) {
+            const glm::vec4& plane = planes[p];
+            float distance = plane.x * spheres.x[i] + plane.y * spheres.y[i] + plane.z * spheres.z[i] + plane.w;
+            isInside = distance >= -spheres.radius[i];
+        }
+        if (isInside) {
+            mask |= 1 << i;
+        }
+    }
+    return mask;
+}
+
+static uint8_t cullingSpheresIntersectCone_ref(const CullingSphereBatch& spheres, const CullingCone& cone, float minAngularSize) {
+    uint8_t mask = 0;
+    for (int i = 0; i < spheres.count; ++i) {
+        glm::vec3 position = glm::vec3(spheres.x[i], spheres.y[i], spheres.z[i]) - cone.position;
+        float radius = spheres.radius[i];
+        float distance = glm::length(position);
+
+        if (radius / (distance + AVOID_DIVIDE_BY_ZERO) <= minAngularSize) {
+            continue;
+        }
+        bool intersects = distance < cone.radius + radius;
+        if (!intersects && distance <= cone.farClip + radius) {
+            // see ConicalViewFrustum::intersects
+            intersects = glm::dot(position, cone.direction) >
+                         sqrtf(distance * distance - radius * radius) * cone.cosAngle - radius * cone.sinAngle;
+        }
+        if (intersects) {
+            mask |= 1 << i;
+        }
+    }
+    return mask;
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void cullingClassifyBoxes_AVX2(const CullingBoxBatch& boxes, const glm::vec4* planes, int numPlanes,
+                               uint8_t& outsideMask, uint8_t& intersectMask);
+uint8_t cullingSpheresInsidePlanes_AVX2(const CullingSphereBatch& spheres, const glm::vec4* planes, int numPlanes);
+uint8_t cullingSpheresIntersectCone_AVX2(const CullingSphereBatch& spheres, const CullingCone& cone, float minAngularSize);
+
+void cullingClassifyBoxes(const CullingBoxBatch& boxes, const glm::vec4* planes, int numPlanes,
+                          uint8_t& outsideMask, uint8_t& intersectMask) {
+    static auto f = cpuSupportsAVX2() ? cullingClassifyBoxes_AVX2 : cullingClassifyBoxes_ref;
+    (*f)(boxes, planes, numPlanes, outsideMask, intersectMask);  // dispatch
+}
+
+uint8_t cullingSpheresInsidePlanes(const CullingSphereBatch& spheres, const glm::vec4* planes, int numPlanes) {
+    static auto f = cpuSupportsAVX2() ? cullingSpheresInsidePlanes_AVX2 : cullingSpheresInsidePlanes_ref;
+    return (*f)(spheres, planes, numPlanes);  // dispatch
+}
+
+uint8_t cullingSpheresIntersectCone(const CullingSphereBatch& spheres, const CullingCone& cone, float minAngularSize) {
+    static auto f = cpuSupportsAVX2() ? cullingSpheresIntersectCone_AVX2 : cullingSpheresIntersectCone_ref;
+    return (*f)(spheres, cone, minAngularSize);  // dispatch
+}
+
+#else   // portable reference code
+
+void cullingClassifyBoxes(const CullingBoxBatch& boxes, const glm::vec4* planes, int numPlanes,
+                          uint8_t& outsideMask, uint8_t& intersectMask) {
+    cullingClassifyBoxes_ref(boxes, planes, numPlanes, outsideMask, intersectMask);
+}
+
+uint8_t cullingSpheresInsidePlanes(const CullingSphereBatch& spheres, const glm::vec4* planes, int numPlanes) {
+    return cullingSpheresInsidePlanes_ref(spheres, planes, numPlanes);
+}
+
+uint8_t cullingSpheresIntersectCone(const CullingSphereBatch& spheres, const CullingCone& cone, float minAngularSize) {
+    return cullingSpheresIntersectCone_ref(spheres, cone, minAngularSize);
+}
+
+#endif
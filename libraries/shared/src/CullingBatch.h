@@ -0,0 +1,91 @@
+//
+//  CullingBatch.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_CullingBatch_h
+#define hifi_CullingBatch_h
+
+#include <stdint.h>
+
+#include <glm/glm.hpp>
+
+// The bounds of up to 8 shapes laid out as structures of arrays, so that the culling tests run on all of them at once
+// (with AVX2 when the CPU has it). The results are masks with a bit per shape, in the order they were added; the bits
+// past the count are always 0. The octree traversals test the 8 children of a cell in one batch.
+const int CULLING_BATCH_SIZE = 8;
+
+class CullingBoxBatch {
+public:
+    void clear() { count = 0; }
+    bool isFull() const { return count == CULLING_BATCH_SIZE; }
+    void add(const glm::vec3& corner, const glm::vec3& scale) {
+        x[count] = corner.x;
+        y[count] = corner.y;
+        z[count] = corner.z;
+        scaleX[count] = scale.x;
+        scaleY[count] = scale.y;
+        scaleZ[count] = scale.z;
+        ++count;
+    }
+    void add(const glm::vec3& corner, float scale) { add(corner, glm::vec3(scale)); }
+
+    // the minimum corners and the dimensions
+    alignas(32) float x[CULLING_BATCH_SIZE] {};
+    alignas(32) float y[CULLING_BATCH_SIZE] {};
+    alignas(32) float z[CULLING_BATCH_SIZE] {};
+    alignas(32) float scaleX[CULLING_BATCH_SIZE] {};
+    alignas(32) float scaleY[CULLING_BATCH_SIZE] {};
+    alignas(32) float scaleZ[CULLING_BATCH_SIZE] {};
+    int count { 0 };
+};
+
+class CullingSphereBatch {
+public:
+    void clear() { count = 0; }
+    bool isFull() const { return count == CULLING_BATCH_SIZE; }
+    void add(const glm::vec3& center, float sphereRadius) {
+        x[count] = center.x;
+        y[count] = center.y;
+        z[count] = center.z;
+        radius[count] = sphereRadius;
+        ++count;
+    }
+
+    alignas(32) float x[CULLING_BATCH_SIZE] {};
+    alignas(32) float y[CULLING_BATCH_SIZE] {};
+    alignas(32) float z[CULLING_BATCH_SIZE] {};
+    alignas(32) float radius[CULLING_BATCH_SIZE] {};
+    int count { 0 };
+};
+
+// A cone with a sphere at its apex, as the ConicalViewFrustum
+struct CullingCone {
+    glm::vec3 position;
+    glm::vec3 direction;
+    float radius;
+    float farClip;
+    float cosAngle;
+    float sinAngle;
+};
+
+// The planes are (normal, d) and their normals point inside. outsideMask gets the boxes entirely behind one of the planes,
+// intersectMask the others that straddle one of them.
+void cullingClassifyBoxes(const CullingBoxBatch& boxes, const glm::vec4* planes, int numPlanes,
+                          uint8_t& outsideMask, uint8_t& intersectMask);
+
+// The spheres that aren't entirely behind one of the planes
+uint8_t cullingSpheresInsidePlanes(const CullingSphereBatch& spheres, const glm::vec4* planes, int numPlanes);
+
+// The spheres that intersect the cone, and whose angular size from its apex is larger than minAngularSize
+uint8_t cullingSpheresIntersectCone(const CullingSphereBatch& spheres, const CullingCone& cone, float minAngularSize);
+
+#endif // hifi_CullingBatch_h
@@ -19,6 +19,7 @@
 #include <QWeakPointer>
 #include <QMutex>
 
+#include <atomic>
 #include <functional>
 #include <typeinfo>
 
@@ -43,6 +44,7 @@ protected:
 
 // usage:
 //     auto instance = DependencyManager::get<T>();
+//     auto& instance = DependencyManager::getRef<T>();
 //     auto instance = DependencyManager::set<T>(Args... args);
 //     DependencyManager::destroy<T>();
 //     DependencyManager::registerInheritance<Base, Derived>();
@@ -51,6 +53,12 @@ public:
     template<typename T>
     static QSharedPointer<T> get();
 
+    // A raw reference to the instance, for the hot paths (per packet, per node loops) where the atomic reference counting
+    // of get() bounces a cache line between the cores. It doesn't keep the instance alive: only use it for a dependency
+    // that outlives the caller, and don't hold on to it across a set<T>() or a destroy<T>(). There must be an instance.
+    template<typename T>
+    static T& getRef();
+
     template<typename T>
     static bool isSet();
 
@@ -92,6 +100,9 @@ private:
     mutable QMutex _instanceHashMutex { QMutex::Recursive };
     mutable QMutex _inheritanceHashMutex;
 
+    // bumped by set() and destroy(), the references cached by getRef() are taken again after it
+    std::atomic<uint32_t> _instancesVersion { 0 };
+
     bool _exiting { false };
 };
 
@@ -121,6 +132,38 @@ QSharedPointer<T> DependencyManager::get() {
     return instance.toStrongRef();
 }
 
+template <typename T>
+T& DependencyManager::getRef() {
+    static std::atomic<T*> instance { nullptr };
+    static std::atomic<uint32_t> instanceVersion { (uint32_t)-1 };
+
+    // the version is read before the pointer it was stored after
+    uint32_t version = manager()._instancesVersion.load(std::memory_order_acquire);
+    bool isCurrent = instanceVersion.load(std::memory_order_acquire) == version;
+    T* pointer = instance.load(std::memory_order_acquire);
+    if (!pointer || !isCurrent) {
+        static size_t hashCode = manager().getHashCode<T>();
+        static QMutex mutex;
+        QMutexLocker lock(&mutex);
+        version = manager()._instancesVersion.load(std::memory_order_acquire);
+        pointer = qSharedPointerCast<T>(manager().safeGet(hashCode)).data();
+        instance.store(pointer, std::memory_order_release);
+        instanceVersion.store(version, std::memory_order_release);
+    }
+
+#ifndef QT_NO_DEBUG
+    // debug builds check that the reference is still the one of the instance that is set
+    {
+        static size_t hashCode = manager().getHashCode<T>();
+        QSharedPointer<Dependency> current = manager().safeGet(hashCode);
+        Q_ASSERT_X(pointer && current.data() == static_cast<Dependency*>(pointer), "DependencyManager::getRef()",
+                   "No instance available, or the reference was kept from a previous instance");
+    }
+#endif
+
+    return *pointer;
+}
+
 template <typename T>
 bool DependencyManager::isSet() {
     static size_t hashCode = manager().getHashCode<T>();
@@ -142,6 +185,7 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
 
     QSharedPointer<T> newInstance(new T(args...), &T::customDeleter);
     manager()._instanceHash.insert(hashCode, newInstance);
+    manager()._instancesVersion.fetch_add(1, std::memory_order_release);
 
     return newInstance;
 }
@@ -159,6 +203,7 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
 
     QSharedPointer<T> newInstance(new I(args...), &I::customDeleter);
     manager()._instanceHash.insert(hashCode, newInstance);
+    manager()._instancesVersion.fetch_add(1, std::memory_order_release);
 
     return newInstance;
 }
@@ -169,6 +214,7 @@ void DependencyManager::destroy() {
 
     QMutexLocker lock(&manager()._instanceHashMutex);
     QSharedPointer<Dependency> shared = manager()._instanceHash.take(hashCode);
+    manager()._instancesVersion.fetch_add(1, std::memory_order_release);
     QWeakPointer<Dependency> weak = shared;
     shared.clear();
 
@@ -110,6 +110,25 @@ int unpackFloatVec3FromSignedTwoByteFixed(const unsigned char* sourceBuffer, glm
     return sourceBuffer - startPosition;
 }
 
+int packFloatVec3ToSignedOneByteFixed(unsigned char* destBuffer, const glm::vec3& srcVector, int radix) {
+    using FixedType = int8_t;
+    for (int i = 0; i < 3; i++) {
+        FixedType oneByteFixed = (FixedType) glm::clamp(roundf(srcVector[i] * (1 << radix)),
+            (float)std::numeric_limits<FixedType>::min(), (float)std::numeric_limits<FixedType>::max());
+        memcpy(destBuffer + i, &oneByteFixed, sizeof(FixedType));
+    }
+    return 3 * sizeof(FixedType);
+}
+
+int unpackFloatVec3FromSignedOneByteFixed(const unsigned char* sourceBuffer, glm::vec3& destination, int radix) {
+    for (int i = 0; i < 3; i++) {
+        int8_t oneByteFixed;
+        memcpy(&oneByteFixed, sourceBuffer + i, sizeof(int8_t));
+        destination[i] = oneByteFixed / (float)(1 << radix);
+    }
+    return 3 * sizeof(int8_t);
+}
+
 int packFloatAngleToTwoByte(unsigned char* buffer, float degrees) {
     const float ANGLE_CONVERSION_RATIO = (std::numeric_limits<uint16_t>::max() / 360.0f);
 
@@ -231,6 +250,71 @@ int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& qu
     return 6;
 }
 
+int packOrientationQuatToFourBytes(unsigned char* buffer, const glm::quat& quatInput) {
+
+    // find largest component
+    uint8_t largestComponent = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabs(quatInput[i]) > fabs(quatInput[largestComponent])) {
+            largestComponent = i;
+        }
+    }
+
+    // ensure that the sign of the dropped component is always negative.
+    glm::quat q = quatInput[largestComponent] > 0 ? -quatInput : quatInput;
+
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const uint32_t NUM_BITS_PER_COMPONENT = 10;
+    const uint32_t RANGE = (1 << NUM_BITS_PER_COMPONENT) - 1;
+
+    // the largest component goes in the top two bits, followed by the smallest three
+    uint32_t packed = largestComponent;
+    for (int i = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            float value = glm::clamp((q[i] + MAGNITUDE) / (2.0f * MAGNITUDE), 0.0f, 1.0f);
+            packed = (packed << NUM_BITS_PER_COMPONENT) | (uint32_t)(value * RANGE + 0.5f);
+        }
+    }
+
+    buffer[0] = (uint8_t)(packed >> 24);
+    buffer[1] = (uint8_t)(packed >> 16);
+    buffer[2] = (uint8_t)(packed >> 8);
+    buffer[3] = (uint8_t)packed;
+
+    return 4;
+}
+
+int unpackOrientationQuatFromFourBytes(const unsigned char* buffer, glm::quat& quatOutput) {
+    uint32_t packed = ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | buffer[3];
+
+    const uint32_t NUM_BITS_PER_COMPONENT = 10;
+    const uint32_t MASK = (1 << NUM_BITS_PER_COMPONENT) - 1;
+    const float RANGE = (float)MASK;
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+
+    uint8_t largestComponent = (uint8_t)(packed >> (3 * NUM_BITS_PER_COMPONENT));
+    float floatComponents[3];
+    for (int i = 0; i < 3; i++) {
+        uint32_t component = (packed >> ((2 - i) * NUM_BITS_PER_COMPONENT)) & MASK;
+        floatComponents[i] = ((float)component / RANGE) * (2.0f * MAGNITUDE) - MAGNITUDE;
+    }
+
+    // missingComponent is always negative, the coarser steps can leave the sum slightly over one
+    float missingComponent = -sqrtf(glm::max(0.0f, 1.0f - floatComponents[0] * floatComponents[0] -
+        floatComponents[1] * floatComponents[1] - floatComponents[2] * floatComponents[2]));
+
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            quatOutput[i] = floatComponents[j];
+            j++;
+        } else {
+            quatOutput[i] = missingComponent;
+        }
+    }
+
+    return 4;
+}
+
 bool closeEnough(float a, float b, float relativeError) {
     assert(relativeError >= 0.0f);
     // NOTE: we add EPSILON to the denominator so we can avoid checking for division by zero.
@@ -118,6 +118,11 @@ int unpackOrientationQuatFromBytes(const unsigned char* buffer, glm::quat& quatO
 int packOrientationQuatToSixBytes(unsigned char* buffer, const glm::quat& quatInput);
 int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& quatOutput);
 
+// coarser version of the above, for things that are far away: the smallest three components get 10 bits each and the
+// omitted one 2 bits, for a maximum error of about +- 1.8e-3 per component.
+int packOrientationQuatToFourBytes(unsigned char* buffer, const glm::quat& quatInput);
+int unpackOrientationQuatFromFourBytes(const unsigned char* buffer, glm::quat& quatOutput);
+
 // Ratios need the be highly accurate when less than 10, but not very accurate above 10, and they
 // are never greater than 1000 to 1, this allows us to encode each component in 16bits
 int packFloatRatioToTwoByte(unsigned char* buffer, float ratio);
@@ -140,6 +145,10 @@ int unpackFloatScalarFromSignedTwoByteFixed(const int16_t* byteFixedPointer, flo
 int packFloatVec3ToSignedTwoByteFixed(unsigned char* destBuffer, const glm::vec3& srcVector, int radix);
 int unpackFloatVec3FromSignedTwoByteFixed(const unsigned char* sourceBuffer, glm::vec3& destination, int radix);
 
+// The same with one byte per component: radix 6 makes a 2.6 number
+int packFloatVec3ToSignedOneByteFixed(unsigned char* destBuffer, const glm::vec3& srcVector, int radix);
+int unpackFloatVec3FromSignedOneByteFixed(const unsigned char* sourceBuffer, glm::vec3& destination, int radix);
+
 bool closeEnough(float a, float b, float relativeError);
 
 /// \return vec3 with euler angles in radians
@@ -17,6 +17,12 @@ const int GZIP_WINDOWS_BIT = 31;
 const int GZIP_CHUNK_SIZE = 4096;
 const int DEFAULT_MEM_LEVEL = 8;
 
+const int QCOMPRESS_HEADER_SIZE = 4;
+const int ZLIB_HEADER_SIZE = 2;
+const int ZLIB_DICTIONARY_ID_SIZE = 4;
+const unsigned char ZLIB_FDICT_BIT = 0x20;
+const int MAX_ZLIB_UNCOMPRESSED_SIZE = 64 * 1024 * 1024;
+
 bool gunzip(QByteArray source, QByteArray &destination) {
     destination.clear();
     if (source.length() == 0) {
@@ -153,3 +159,112 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     deflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+static quint32 readBigEndian(const unsigned char* bytes) {
+    return ((quint32)bytes[0] << 24) | ((quint32)bytes[1] << 16) | ((quint32)bytes[2] << 8) | (quint32)bytes[3];
+}
+
+bool zlibCompress(const char* source, int size, const QByteArray& dictionary, QByteArray& destination, int compressionLevel) {
+    destination.clear();
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    if (deflateInit(&strm, qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel))) != Z_OK) {
+        return false;
+    }
+    if (!dictionary.isEmpty() &&
+        deflateSetDictionary(&strm, (const Bytef*)dictionary.constData(), (uInt)dictionary.size()) != Z_OK) {
+        deflateEnd(&strm);
+        return false;
+    }
+
+    // the sections of the octree packets are small, they are compressed in one go
+    uLong bound = deflateBound(&strm, (uLong)size);
+    destination.resize(QCOMPRESS_HEADER_SIZE + (int)bound);
+    unsigned char* header = (unsigned char*)destination.data();
+    header[0] = (unsigned char)((size >> 24) & 0xff);
+    header[1] = (unsigned char)((size >> 16) & 0xff);
+    header[2] = (unsigned char)((size >> 8) & 0xff);
+    header[3] = (unsigned char)(size & 0xff);
+
+    strm.next_in = (Bytef*)source;
+    strm.avail_in = (uInt)size;
+    strm.next_out = header + QCOMPRESS_HEADER_SIZE;
+    strm.avail_out = (uInt)bound;
+    int status = deflate(&strm, Z_FINISH);
+    int compressedSize = (int)strm.total_out;
+    deflateEnd(&strm);
+
+    if (status != Z_STREAM_END) {
+        destination.clear();
+        return false;
+    }
+    destination.resize(QCOMPRESS_HEADER_SIZE + compressedSize);
+    return true;
+}
+
+bool zlibUncompress(const char* source, int size, const QByteArray& dictionary, QByteArray& destination) {
+    destination.clear();
+    if (size < QCOMPRESS_HEADER_SIZE + ZLIB_HEADER_SIZE) {
+        return false;
+    }
+
+    quint32 uncompressedSize = readBigEndian((const unsigned char*)source);
+    if (uncompressedSize > (quint32)MAX_ZLIB_UNCOMPRESSED_SIZE) {
+        return false;
+    }
+    destination.resize((int)uncompressedSize);
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = (Bytef*)source + QCOMPRESS_HEADER_SIZE;
+    strm.avail_in = (uInt)(size - QCOMPRESS_HEADER_SIZE);
+
+    if (inflateInit(&strm) != Z_OK) {
+        destination.clear();
+        return false;
+    }
+
+    strm.next_out = (Bytef*)destination.data();
+    strm.avail_out = (uInt)uncompressedSize;
+    int status = inflate(&strm, Z_FINISH);
+    if (status == Z_NEED_DICT) {
+        if (dictionary.isEmpty() ||
+            inflateSetDictionary(&strm, (const Bytef*)dictionary.constData(), (uInt)dictionary.size()) != Z_OK) {
+            status = Z_DATA_ERROR;
+        } else {
+            status = inflate(&strm, Z_FINISH);
+        }
+    }
+    bool success = status == Z_STREAM_END && strm.total_out == uncompressedSize;
+    inflateEnd(&strm);
+
+    if (!success) {
+        destination.clear();
+    }
+    return success;
+}
+
+quint32 zlibDictionaryID(const QByteArray& dictionary) {
+    if (dictionary.isEmpty()) {
+        return 0;
+    }
+    return (quint32)adler32(adler32(0L, Z_NULL, 0), (const Bytef*)dictionary.constData(), (uInt)dictionary.size());
+}
+
+quint32 zlibStreamDictionaryID(const char* source, int size) {
+    if (size < QCOMPRESS_HEADER_SIZE + ZLIB_HEADER_SIZE + ZLIB_DICTIONARY_ID_SIZE) {
+        return 0;
+    }
+    const unsigned char* header = (const unsigned char*)source + QCOMPRESS_HEADER_SIZE;
+    const int ZLIB_HEADER_CHECK = 31;
+    if ((header[0] * 256 + header[1]) % ZLIB_HEADER_CHECK != 0 || !(header[1] & ZLIB_FDICT_BIT)) {
+        return 0;
+    }
+    return readBigEndian(header + ZLIB_HEADER_SIZE);
+}
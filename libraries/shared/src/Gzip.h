@@ -24,4 +24,15 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// zlib streams with a preset dictionary, framed as qCompress frames them: the size of the uncompressed data comes first,
+// as 4 bytes big endian. The streams without a dictionary are those of qCompress, zlibUncompress reads both.
+bool zlibCompress(const char* source, int size, const QByteArray& dictionary, QByteArray& destination,
+                  int compressionLevel = -1);
+bool zlibUncompress(const char* source, int size, const QByteArray& dictionary, QByteArray& destination);
+
+// the id of a dictionary as zlib writes it in the streams, 0 for no dictionary
+quint32 zlibDictionaryID(const QByteArray& dictionary);
+// the id of the dictionary a stream needs, 0 when it doesn't need one
+quint32 zlibStreamDictionaryID(const char* source, int size);
+
 #endif
@@ -0,0 +1,113 @@
+//
+//  LatencyHistogram.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-11.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+const int LatencyHistogram::NUM_BUCKETS;
+const uint64_t LatencyHistogram::MAX_VALUE;
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < (uint64_t)SUB_BUCKETS) {
+        return (int)value;
+    }
+
+    value = std::min(value, MAX_VALUE);
+
+    int mostSignificantBit = 0;
+    while ((value >> (mostSignificantBit + 1)) != 0) {
+        ++mostSignificantBit;
+    }
+
+    // the top SUB_BUCKET_BITS + 1 bits pick the bucket, anything below them is the precision we give up
+    int shift = mostSignificantBit - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + (int)((value >> shift) - SUB_BUCKETS);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return (uint64_t)index;
+    }
+
+    int shift = index / SUB_BUCKETS - 1;
+    uint64_t lowerBound = (uint64_t)(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lowerBound + ((uint64_t)1 << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    ++_counts[bucketIndex(value)];
+    ++_count;
+    _sum += value;
+    _max = std::max(_max, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _max = std::max(_max, other._max);
+}
+
+void LatencyHistogram::reset() {
+    _counts.fill(0);
+    _count = 0;
+    _sum = 0;
+    _max = 0;
+}
+
+uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    uint64_t target = (uint64_t)std::ceil(_count * std::min(std::max(percentile, 0.0), 100.0) / 100.0);
+    target = std::max(target, (uint64_t)1);
+
+    uint64_t seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        seen += _counts[i];
+        if (seen >= target) {
+            // a bucket bound can overshoot what was actually recorded
+            return std::min(bucketUpperBound(i), _max);
+        }
+    }
+
+    return _max;
+}
+
+uint64_t LatencyHistogram::getCountAtOrBelow(uint64_t value) const {
+    if (value >= _max) {
+        return _count;
+    }
+
+    uint64_t count = 0;
+    int lastIndex = bucketIndex(value);
+    for (int i = 0; i <= lastIndex; ++i) {
+        count += _counts[i];
+    }
+    return count;
+}
+
+QJsonObject LatencyHistogram::toJson(const QString& unit) const {
+    QJsonObject json;
+    json["count"] = (qint64)_count;
+    json["mean_" + unit] = getMean();
+    json["p50_" + unit] = (qint64)getPercentile(50.0);
+    json["p90_" + unit] = (qint64)getPercentile(90.0);
+    json["p99_" + unit] = (qint64)getPercentile(99.0);
+    json["p99.9_" + unit] = (qint64)getPercentile(99.9);
+    json["max_" + unit] = (qint64)_max;
+    return json;
+}
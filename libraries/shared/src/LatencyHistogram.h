@@ -0,0 +1,65 @@
+//
+//  LatencyHistogram.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-11.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_LatencyHistogram_h
+#define hifi_LatencyHistogram_h
+
+#include <array>
+#include <stdint.h>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+// Fixed-size histogram of durations, in the style of HdrHistogram.
+//
+// Values are bucketed with SUB_BUCKETS linear steps per power of two, so every bucket is within 1/SUB_BUCKETS of the
+// values it holds, from one unit (usually a micro- or nanosecond) up to MAX_VALUE. Recording is a couple of shifts and an increment, so it is
+// cheap enough to run on every mix. A histogram is not thread-safe, keep one per thread and merge them.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAGNITUDES = 24;
+    static const int NUM_BUCKETS = (MAGNITUDES + 1) * SUB_BUCKETS;
+
+    // values above this (about 268 million: 268 seconds of usecs, 268 milliseconds of nsecs) land in the last bucket
+    static const uint64_t MAX_VALUE = ((uint64_t)SUB_BUCKETS << MAGNITUDES) - 1;
+
+    void record(uint64_t value);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t getCount() const { return _count; }
+    uint64_t getSum() const { return _sum; }
+    uint64_t getMax() const { return _max; }
+    double getMean() const { return _count > 0 ? (double)_sum / _count : 0.0; }
+
+    // the highest value, within bucket precision, that percentile percent of the recorded values stay under
+    uint64_t getPercentile(double percentile) const;
+    // the number of recorded values, within bucket precision, at or below the value
+    uint64_t getCountAtOrBelow(uint64_t value) const;
+
+    // count, mean, max and the usual percentiles, keyed with the given unit suffix (e.g. "usecs")
+    QJsonObject toJson(const QString& unit) const;
+
+private:
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int index);
+
+    std::array<uint32_t, NUM_BUCKETS> _counts {};
+    uint64_t _count { 0 };
+    uint64_t _sum { 0 };
+    uint64_t _max { 0 };
+};
+
+#endif // hifi_LatencyHistogram_h
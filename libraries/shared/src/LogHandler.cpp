@@ -12,7 +12,8 @@
 
 #include "LogHandler.h"
 
-#include <mutex>
+#include <algorithm>
+#include <chrono>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -23,13 +24,57 @@
 #endif
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
 #include <QtCore/QDebug>
-#include <QtCore/QMutexLocker>
+#include <QtCore/QFile>
 #include <QtCore/QThread>
-#include <QtCore/QTimer>
 
-QMutex LogHandler::_mutex(QMutex::Recursive);
+static const int WRITER_INTERVAL_MSECS = 10;
+static const qint64 USECS_PER_MSEC = 1000;
+
+// set on the thread that drains the queues, while it does
+static thread_local bool isWritingLog { false };
+
+// The queue of the messages of one thread: only the thread pushes to it, and only the thread writing the log, with the
+// writer mutex, pops from it.
+class LogHandler::EntryQueue {
+public:
+    static const size_t CAPACITY = 1024;
+
+    EntryQueue() : _entries(CAPACITY) {}
+
+    bool push(Entry&& entry) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= CAPACITY) {
+            return false;
+        }
+        _entries[head % CAPACITY] = std::move(entry);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void popAll(std::vector<Entry>& entries) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t head = _head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            entries.push_back(std::move(_entries[tail % CAPACITY]));
+        }
+        _tail.store(tail, std::memory_order_release);
+    }
+
+    bool isEmpty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+
+    // once its thread is gone, the queue is dropped when empty
+    void close() { _isClosed.store(true, std::memory_order_release); }
+    bool isClosed() const { return _isClosed.load(std::memory_order_acquire); }
+
+private:
+    std::vector<Entry> _entries;
+    std::atomic<size_t> _head { 0 };
+    std::atomic<size_t> _tail { 0 };
+    std::atomic<bool> _isClosed { false };
+};
 
 LogHandler& LogHandler::getInstance() {
     static LogHandler staticInstance;
@@ -66,10 +111,38 @@ LogHandler::LogHandler() {
             _shouldDisplayMilliseconds = true;
         } else if (option == "keep_repeats") {
             _keepRepeats = true;
+        } else if (option == "binary") {
+            _isBinary = true;
         } else if (option != "") {
             fprintf(stdout, "Unrecognized option in VIRCADIA_LOG_OPTIONS: '%s'\n", option.toUtf8().constData());
         }
     }
+
+    if (_isBinary) {
+        QString binaryFileName = qgetenv("VIRCADIA_LOG_BINARY_FILE");
+        if (!binaryFileName.isEmpty()) {
+            _binaryFile.reset(new QFile(binaryFileName));
+        }
+        if (!_binaryFile || !_binaryFile->open(QIODevice::WriteOnly | QIODevice::Append)) {
+            fprintf(stdout, "Unable to open the file of VIRCADIA_LOG_BINARY_FILE: '%s', logging as text\n",
+                    binaryFileName.toUtf8().constData());
+            _binaryFile.reset();
+            _isBinary = false;
+        }
+    }
+
+    _lastRepeatedMessagesFlush = QDateTime::currentMSecsSinceEpoch();
+    _writer = std::thread([this] { runWriter(); });
+}
+
+LogHandler::~LogHandler() {
+    _isStopping = true;
+    _wakeCondition.notify_one();
+    if (_writer.joinable()) {
+        _writer.join();
+    }
+    _isStopped = true;
+    flush();
 }
 
 const char* stringForLogType(LogMsgType msgType) {
@@ -121,48 +194,54 @@ const QString DATE_STRING_FORMAT = "MM/dd hh:mm:ss";
 const QString DATE_STRING_FORMAT_WITH_MILLISECONDS = "MM/dd hh:mm:ss.zzz";
 
 void LogHandler::setTargetName(const QString& targetName) {
-    QMutexLocker lock(&_mutex);
+    std::lock_guard<std::mutex> lock(_targetNameMutex);
     _targetName = targetName;
 }
 
 void LogHandler::setShouldOutputProcessID(bool shouldOutputProcessID) {
-    QMutexLocker lock(&_mutex);
     _shouldOutputProcessID = shouldOutputProcessID;
 }
 
 void LogHandler::setShouldOutputThreadID(bool shouldOutputThreadID) {
-    QMutexLocker lock(&_mutex);
     _shouldOutputThreadID = shouldOutputThreadID;
 }
 
 void LogHandler::setShouldDisplayMilliseconds(bool shouldDisplayMilliseconds) {
-    QMutexLocker lock(&_mutex);
     _shouldDisplayMilliseconds = shouldDisplayMilliseconds;
 }
 
+void LogHandler::addSink(LogSink* sink) {
+    std::lock_guard<std::mutex> lock(_writerMutex);
+    if (std::find(_sinks.begin(), _sinks.end(), sink) == _sinks.end()) {
+        _sinks.push_back(sink);
+    }
+}
 
-void LogHandler::flushRepeatedMessages() {
-    QMutexLocker lock(&_mutex);
+void LogHandler::removeSink(LogSink* sink) {
+    // waits for a batch being written to the sink
+    std::lock_guard<std::mutex> lock(_writerMutex);
+    _sinks.erase(std::remove(_sinks.begin(), _sinks.end(), sink), _sinks.end());
+}
 
-    // New repeat-suppress scheme:
-    for (int m = 0; m < (int)_repeatedMessageRecords.size(); ++m) {
-        int repeatCount = _repeatedMessageRecords[m].repeatCount;
-        if (repeatCount > 1) {
-            QString repeatLogMessage = QString().setNum(repeatCount) + " repeated log entries - Last entry: \"" 
-                    + _repeatedMessageRecords[m].repeatString + "\"";
-            printMessage(LogSuppressed, QMessageLogContext(), repeatLogMessage);
-            _repeatedMessageRecords[m].repeatCount = 0;
-            _repeatedMessageRecords[m].repeatString = QString();
+LogHandler::Entry LogHandler::makeEntry(LogMsgType type, const QMessageLogContext& context, const QString& message) const {
+    Entry entry;
+    entry.type = type;
+    entry.usecsSinceEpoch = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    entry.threadID = (size_t)QThread::currentThreadId();
+    entry.category = context.category;
+
+    // for [qml] console.* messages include an abbreviated source filename
+    if (context.category && context.file && !strcmp("qml", context.category)) {
+        if (const char* basename = strrchr(context.file, '/')) {
+            entry.file = basename + 1;
         }
     }
+    entry.message = message;
+    return entry;
 }
 
-QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
-    if (message.isEmpty()) {
-        return QString();
-    }
-    QMutexLocker lock(&_mutex);
-
+QString LogHandler::formatMessage(const Entry& entry) const {
     // log prefix is in the following format
     // [TIMESTAMP] [DEBUG] [PID] [TID] [TARGET] logged string
 
@@ -171,93 +250,259 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
         dateFormatPtr = &DATE_STRING_FORMAT_WITH_MILLISECONDS;
     }
 
-    QString prefixString = QString("[%1] [%2] [%3]").arg(QDateTime::currentDateTime().toString(*dateFormatPtr),
-        stringForLogType(type), context.category);
+    QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(entry.usecsSinceEpoch / USECS_PER_MSEC);
+    QString prefixString = QString("[%1] [%2] [%3]").arg(timestamp.toString(*dateFormatPtr),
+        stringForLogType(entry.type), QString::fromLatin1(entry.category));
 
     if (_shouldOutputProcessID) {
         prefixString.append(QString(" [%1]").arg(QCoreApplication::applicationPid()));
     }
 
     if (_shouldOutputThreadID) {
-        size_t threadID = (size_t)QThread::currentThreadId();
-        prefixString.append(QString(" [%1]").arg(threadID));
+        prefixString.append(QString(" [%1]").arg(entry.threadID));
     }
 
-    if (!_targetName.isEmpty()) {
-        prefixString.append(QString(" [%1]").arg(_targetName));
+    QString targetName;
+    {
+        std::lock_guard<std::mutex> lock(_targetNameMutex);
+        targetName = _targetName;
+    }
+    if (!targetName.isEmpty()) {
+        prefixString.append(QString(" [%1]").arg(targetName));
     }
 
-    // for [qml] console.* messages include an abbreviated source filename
-    if (context.category && context.file && !strcmp("qml", context.category)) {
-        if (const char* basename = strrchr(context.file, '/')) {
-            prefixString.append(QString(" [%1]").arg(basename+1));
+    if (!entry.file.isEmpty()) {
+        prefixString.append(QString(" [%1]").arg(QString::fromLatin1(entry.file)));
+    }
+
+    return QString("%1 %2\n").arg(prefixString, entry.message.split('\n').join('\n' + prefixString + " "));
+}
+
+LogHandler::EntryQueue& LogHandler::getThreadQueue() {
+    struct ThreadQueue {
+        std::shared_ptr<EntryQueue> queue;
+        ~ThreadQueue() {
+            if (queue) {
+                queue->close();
+            }
+        }
+    };
+    static thread_local ThreadQueue threadQueue;
+
+    if (!threadQueue.queue) {
+        threadQueue.queue = std::make_shared<EntryQueue>();
+        std::lock_guard<std::mutex> lock(_queuesMutex);
+        _queues.push_back(threadQueue.queue);
+    }
+    return *threadQueue.queue;
+}
+
+void LogHandler::enqueue(Entry&& entry) {
+    LogMsgType type = entry.type;
+    EntryQueue& queue = getThreadQueue();
+    if (!queue.push(std::move(entry))) {
+        if (isWritingLog) {
+            // logged by a sink while its batch is written, and there's no room left: dropped
+            return;
+        }
+        // the writer is behind, this thread writes out its own messages
+        flush();
+        queue.push(std::move(entry));
+    }
+
+    if (type == LogFatal || _isStopped) {
+        // about to abort, or the writer is gone already
+        flush();
+    } else if (type == LogWarning || type == LogCritical) {
+        _wakeCondition.notify_one();
+    }
+}
+
+QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
+    if (message.isEmpty()) {
+        return QString();
+    }
+
+    Entry entry = makeEntry(type, context, message);
+    entry.logMessage = formatMessage(entry);
+    QString logMessage = entry.logMessage;
+    enqueue(std::move(entry));
+    return logMessage;
+}
+
+void LogHandler::queueMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
+    if (message.isEmpty()) {
+        return;
+    }
+    enqueue(makeEntry(type, context, message));
+}
+
+void LogHandler::verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+    getInstance().queueMessage((LogMsgType) type, context, message);
+}
+
+void LogHandler::flush() {
+    if (isWritingLog) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_writerMutex);
+    drainQueues();
+}
+
+void LogHandler::runWriter() {
+    while (!_isStopping) {
+        {
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wakeCondition.wait_for(lock, std::chrono::milliseconds(WRITER_INTERVAL_MSECS));
         }
+        std::lock_guard<std::mutex> lock(_writerMutex);
+        drainQueues();
+    }
+}
+
+void LogHandler::drainQueues() {
+    isWritingLog = true;
+
+    {
+        std::lock_guard<std::mutex> lock(_queuesMutex);
+        for (auto& queue : _queues) {
+            queue->popAll(_batch);
+        }
+        _queues.erase(std::remove_if(_queues.begin(), _queues.end(), [](const std::shared_ptr<EntryQueue>& queue) {
+            return queue->isClosed() && queue->isEmpty();
+        }), _queues.end());
+    }
+
+    // the queues are drained one after the other, the messages of the threads are put back in order
+    std::stable_sort(_batch.begin(), _batch.end(), [](const Entry& a, const Entry& b) {
+        return a.usecsSinceEpoch < b.usecsSinceEpoch;
+    });
+    for (auto& entry : _batch) {
+        writeEntry(entry);
     }
+    _batch.clear();
 
-    QString logMessage = QString("%1 %2\n").arg(prefixString, message.split('\n').join('\n' + prefixString + " "));
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (now - _lastRepeatedMessagesFlush >= VERBOSE_LOG_INTERVAL_SECONDS * 1000) {
+        _lastRepeatedMessagesFlush = now;
+        flushRepeatedMessages();
+    }
 
-    const char* color = "";
-    const char* resetColor = "";
+    if (!_sinkLines.empty()) {
+        for (auto sink : _sinks) {
+            sink->writeLog(_sinkLines);
+        }
+        _sinkLines.clear();
+    }
+    if (!_isBinary) {
+        fflush(stdout);
+    }
 
-    if (_useColor) {
-        color = colorForLogType(type);
-        resetColor = colorReset();
+    isWritingLog = false;
+}
+
+void LogHandler::writeEntry(Entry& entry) {
+    if (entry.repeatedMessageID >= 0) {
+        if (entry.repeatedMessageID >= (int)_repeatedMessageRecords.size()) {
+            _repeatedMessageRecords.resize(entry.repeatedMessageID + 1, RepeatedMessageRecord { 0, QString() });
+        }
+        auto& record = _repeatedMessageRecords[entry.repeatedMessageID];
+        ++record.repeatCount;
+        if (record.repeatCount > 1) {
+            record.repeatString = entry.message;
+            return;
+        }
     }
 
-    if (_keepRepeats || _previousMessage != message) {
-        if (_repeatCount > 0) {
-            fprintf(stdout, "[Previous message was repeated %i times]\n", _repeatCount);
+    if (_isBinary) {
+        writeBinaryEntry(entry);
+        if (_sinks.empty()) {
+            return;
         }
+    }
 
-        fprintf(stdout, "%s%s%s", color, qPrintable(logMessage), resetColor);
-        _repeatCount = 0;
-    } else {
-        _repeatCount++;
+    if (entry.logMessage.isEmpty()) {
+        entry.logMessage = formatMessage(entry);
     }
 
-    _previousMessage = message;
+    if (!_isBinary) {
+        const char* color = "";
+        const char* resetColor = "";
+
+        if (_useColor) {
+            color = colorForLogType(entry.type);
+            resetColor = colorReset();
+        }
+
+        if (_keepRepeats || _previousMessage != entry.message) {
+            if (_repeatCount > 0) {
+                fprintf(stdout, "[Previous message was repeated %i times]\n", _repeatCount);
+            }
+
+            fprintf(stdout, "%s%s%s", color, qPrintable(entry.logMessage), resetColor);
+            _repeatCount = 0;
+        } else {
+            _repeatCount++;
+        }
+
+        _previousMessage = entry.message;
+    }
 #ifdef Q_OS_WIN
     // On windows, this will output log lines into the Visual Studio "output" tab
-    OutputDebugStringA(qPrintable(logMessage));
+    OutputDebugStringA(qPrintable(entry.logMessage));
 #endif
-    return logMessage;
+
+    if (!_sinks.empty()) {
+        _sinkLines.push_back(std::move(entry.logMessage));
+    }
 }
 
-void LogHandler::verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
-    getInstance().printMessage((LogMsgType) type, context, message);
+void LogHandler::writeBinaryEntry(const Entry& entry) {
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    QByteArray message = entry.message.toUtf8();
+    stream << (quint32)0 << (quint64)entry.usecsSinceEpoch << (quint8)entry.type << (quint64)entry.threadID;
+    stream << (quint16)entry.category.size();
+    stream.writeRawData(entry.category.constData(), entry.category.size());
+    stream << (quint32)message.size();
+    stream.writeRawData(message.constData(), message.size());
+
+    // the size of the rest of the record goes first
+    stream.device()->seek(0);
+    stream << (quint32)(record.size() - sizeof(quint32));
+    _binaryFile->write(record);
 }
 
-void LogHandler::setupRepeatedMessageFlusher() {
-    static std::once_flag once;
-    std::call_once(once, [&] {
-        // setup our timer to flush the verbose logs every 5 seconds
-        QTimer* logFlushTimer = new QTimer(this);
-        connect(logFlushTimer, &QTimer::timeout, this, &LogHandler::flushRepeatedMessages);
-        logFlushTimer->start(VERBOSE_LOG_INTERVAL_SECONDS * 1000);
-    });
+void LogHandler::flushRepeatedMessages() {
+    // New repeat-suppress scheme:
+    for (auto& record : _repeatedMessageRecords) {
+        if (record.repeatCount > 1) {
+            Entry entry = makeEntry(LogSuppressed, QMessageLogContext(), QString().setNum(record.repeatCount)
+                + " repeated log entries - Last entry: \"" + record.repeatString + "\"");
+            writeEntry(entry);
+            record.repeatCount = 0;
+            record.repeatString = QString();
+        }
+    }
+    if (_isBinary) {
+        _binaryFile->flush();
+    }
 }
 
 int LogHandler::newRepeatedMessageID() {
-    QMutexLocker lock(&_mutex);
-    int newMessageId = _currentMessageID;
-    ++_currentMessageID;
-    RepeatedMessageRecord newRecord { 0, QString() };
-    _repeatedMessageRecords.push_back(newRecord);
-    return newMessageId;
+    // the record is made by the writer, when it gets the first message
+    return _currentMessageID++;
 }
 
 void LogHandler::printRepeatedMessage(int messageID, LogMsgType type, const QMessageLogContext& context,
                                       const QString& message) {
-    QMutexLocker lock(&_mutex);
-    if (messageID >= _currentMessageID) {
+    if (messageID < 0 || messageID >= _currentMessageID || message.isEmpty()) {
         return;
     }
 
-    if (_repeatedMessageRecords[messageID].repeatCount == 0) {
-        printMessage(type, context, message);
-    } else {
-        _repeatedMessageRecords[messageID].repeatString = message;
-    }
- 
-    ++_repeatedMessageRecords[messageID].repeatCount;
+    Entry entry = makeEntry(type, context, message);
+    entry.repeatedMessageID = messageID;
+    enqueue(std::move(entry));
 }
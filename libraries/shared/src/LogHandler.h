@@ -17,9 +17,15 @@
 #include <QString>
 #include <QRegExp>
 #include <QMutex>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <memory>
 
+class QFile;
+
 const int VERBOSE_LOG_INTERVAL_SECONDS = 5;
 
 enum LogMsgType {
@@ -31,13 +37,27 @@ enum LogMsgType {
     LogSuppressed = 100
 };
 
+/// Receives the formatted log lines, a batch at a time, on the writer thread of the LogHandler
+class LogSink {
+public:
+    virtual ~LogSink() {}
+    virtual void writeLog(const std::vector<QString>& lines) = 0;
+};
+
 /// Handles custom message handling and sending of stats/logs to Logstash instance
+///
+/// The threads that log only push their messages to a queue of their own, without locks, and a writer thread drains
+/// the queues: it formats the messages, suppresses the repeats, and writes them out to stdout and to the sinks (e.g. the
+/// FileLogger). With the "binary" option of VIRCADIA_LOG_OPTIONS, the messages are written as records to the file named
+/// by VIRCADIA_LOG_BINARY_FILE instead of stdout, which saves formatting them:
+///     uint32 size of the rest of the record, uint64 usecs since epoch, uint8 LogMsgType, uint64 thread ID,
+///     uint16 size + category, uint32 size + UTF-8 message, little endian
 class LogHandler : public QObject {
     Q_OBJECT
 public:
     static LogHandler& getInstance();
 
-    /// sets the target name to output via the verboseMessageHandler, called once before logging begins
+    /// sets the target name to output via the verboseMessageHandler, the assignments change it while the others log
     /// \param targetName the desired target name to output in logs
     void setTargetName(const QString& targetName);
 
@@ -45,7 +65,16 @@ public:
     void setShouldOutputThreadID(bool shouldOutputThreadID);
     void setShouldDisplayMilliseconds(bool shouldDisplayMilliseconds);
 
+    /// formats the message on the calling thread, for the message handlers that need the line, and queues it
     QString printMessage(LogMsgType type, const QMessageLogContext& context, const QString &message);
+    /// queues the message, it is formatted on the writer thread
+    void queueMessage(LogMsgType type, const QMessageLogContext& context, const QString &message);
+
+    /// writes out what was queued by now, on the calling thread
+    void flush();
+
+    void addSink(LogSink* sink);
+    void removeSink(LogSink* sink);
 
     /// a qtMessageHandler that can be hooked up to a target that links to Qt
     /// prints various process, message type, and time information
@@ -54,32 +83,70 @@ public:
     int newRepeatedMessageID();
     void printRepeatedMessage(int messageID, LogMsgType type, const QMessageLogContext& context, const QString &message);
 
-    void setupRepeatedMessageFlusher();
-
 private:
-    LogHandler();
-    ~LogHandler() = default;
+    struct Entry {
+        LogMsgType type { LogDebug };
+        qint64 usecsSinceEpoch { 0 };
+        size_t threadID { 0 };
+        int repeatedMessageID { -1 };
+        QByteArray category;
+        QByteArray file;
+        QString message;
+        QString logMessage;     // when it was formatted by printMessage
+    };
+
+    class EntryQueue;
 
+    LogHandler();
+    ~LogHandler();
+
+    Entry makeEntry(LogMsgType type, const QMessageLogContext& context, const QString& message) const;
+    QString formatMessage(const Entry& entry) const;
+    void enqueue(Entry&& entry);
+    EntryQueue& getThreadQueue();
+
+    // on the writer thread, or the thread that flushes, with _writerMutex
+    void runWriter();
+    void drainQueues();
+    void writeEntry(Entry& entry);
+    void writeBinaryEntry(const Entry& entry);
     void flushRepeatedMessages();
 
+    // read by whichever thread formats a message
+    mutable std::mutex _targetNameMutex;
     QString _targetName;
-    bool _shouldOutputProcessID { false };
-    bool _shouldOutputThreadID { false };
-    bool _shouldDisplayMilliseconds { false };
+    std::atomic<bool> _shouldOutputProcessID { false };
+    std::atomic<bool> _shouldOutputThreadID { false };
+    std::atomic<bool> _shouldDisplayMilliseconds { false };
     bool _useColor { false };
     bool _keepRepeats { false };
+    bool _isBinary { false };
+
+    std::mutex _queuesMutex;
+    std::vector<std::shared_ptr<EntryQueue>> _queues;
+
+    std::thread _writer;
+    std::mutex _writerMutex;
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+    std::atomic<bool> _isStopping { false };
+    std::atomic<bool> _isStopped { false };
+
+    std::vector<Entry> _batch;
+    std::vector<QString> _sinkLines;
+    std::vector<LogSink*> _sinks;
+    std::unique_ptr<QFile> _binaryFile;
 
     QString _previousMessage;
     int _repeatCount { 0 };
 
-
-    int _currentMessageID { 0 };
+    std::atomic<int> _currentMessageID { 0 };
     struct RepeatedMessageRecord {
         int repeatCount;
         QString repeatString;
     };
     std::vector<RepeatedMessageRecord> _repeatedMessageRecords;
-    static QMutex _mutex;
+    qint64 _lastRepeatedMessagesFlush { 0 };
 };
 
 #define HIFI_FCDEBUG(category, message) \
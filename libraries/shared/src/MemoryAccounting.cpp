@@ -0,0 +1,143 @@
+//
+//  MemoryAccounting.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MemoryAccounting.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonDocument>
+
+#include "NumericalConstants.h"
+#include "SharedLogging.h"
+#include "SharedUtil.h"
+
+static const char* MEMORY_SNAPSHOT_INTERVAL_ENV = "VIRCADIA_MEMORY_SNAPSHOT_INTERVAL";
+
+MemoryAccounting& MemoryAccounting::getInstance() {
+    // never destroyed, the tags of static objects are still counted on while the statics are destroyed
+    static MemoryAccounting* instance = new MemoryAccounting();
+    return *instance;
+}
+
+MemoryAccounting::MemoryAccounting() {
+    _tagNames.reserve(MAX_TAGS);
+
+    bool ok = false;
+    int intervalSeconds = qEnvironmentVariableIntValue(MEMORY_SNAPSHOT_INTERVAL_ENV, &ok);
+    if (ok && intervalSeconds > 0) {
+        _snapshotIntervalUsecs = (uint64_t)intervalSeconds * USECS_PER_SECOND;
+        _nextSnapshotUsecs = usecTimestampNow() + _snapshotIntervalUsecs;
+    }
+}
+
+int MemoryAccounting::registerTag(const QString& name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = std::find(_tagNames.begin(), _tagNames.end(), name);
+    if (it != _tagNames.end()) {
+        return (int)(it - _tagNames.begin());
+    }
+
+    if ((int)_tagNames.size() >= MAX_TAGS) {
+        qCWarning(shared) << "MemoryAccounting: no room left for the tag" << name;
+        return -1;
+    }
+
+    _tagNames.push_back(name);
+    return (int)_tagNames.size() - 1;
+}
+
+int MemoryAccounting::addSource(const QString& name, SourceFunction function) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    int id = _nextSourceId++;
+    Source source;
+    source.id = id;
+    source.name = name;
+    source.function = std::move(function);
+    _sources.push_back(std::move(source));
+    return id;
+}
+
+void MemoryAccounting::removeSource(int id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _sources.erase(std::remove_if(_sources.begin(), _sources.end(), [id](const Source& source) {
+        return source.id == id;
+    }), _sources.end());
+}
+
+std::vector<MemoryAccounting::Usage> MemoryAccounting::sample() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<Usage> usages;
+    usages.reserve(_tagNames.size() + _sources.size());
+
+    for (size_t i = 0; i < _tagNames.size(); ++i) {
+        const Tag& tag = _tags[i];
+        Usage usage;
+        usage.name = _tagNames[i];
+        usage.bytes = tag.bytes.load(std::memory_order_relaxed);
+        usage.peakBytes = tag.peakBytes.load(std::memory_order_relaxed);
+        usage.count = tag.count.load(std::memory_order_relaxed);
+        usages.push_back(usage);
+    }
+
+    for (auto& source : _sources) {
+        Usage usage;
+        usage.name = source.name;
+        source.function(usage.bytes, usage.count);
+        // the peak of a source is only as good as how often it is sampled
+        source.peakBytes = std::max(source.peakBytes, usage.bytes);
+        usage.peakBytes = source.peakBytes;
+        usages.push_back(usage);
+    }
+
+    return usages;
+}
+
+QJsonObject MemoryAccounting::toJson(const std::vector<Usage>& usages) {
+    QJsonObject usageObject;
+    qint64 accountedBytes = 0;
+    for (const auto& usage : usages) {
+        QJsonObject entry;
+        entry["bytes"] = (qint64)usage.bytes;
+        entry["peak_bytes"] = (qint64)usage.peakBytes;
+        entry["count"] = (qint64)usage.count;
+        usageObject[usage.name] = entry;
+        accountedBytes += usage.bytes;
+    }
+
+    QJsonObject memoryObject;
+    memoryObject["accounted_bytes"] = accountedBytes;
+    MemoryInfo memoryInfo;
+    if (getMemoryInfo(memoryInfo)) {
+        memoryObject["process_used_bytes"] = (qint64)memoryInfo.processUsedMemoryBytes;
+        memoryObject["process_peak_used_bytes"] = (qint64)memoryInfo.processPeakUsedMemoryBytes;
+    }
+    memoryObject["usage"] = usageObject;
+    return memoryObject;
+}
+
+void MemoryAccounting::logSnapshot() {
+    qCInfo(shared).noquote() << "Memory snapshot:" << QJsonDocument(toJson()).toJson(QJsonDocument::Compact);
+}
+
+void MemoryAccounting::logSnapshotIfDue() {
+    if (_snapshotIntervalUsecs == 0) {
+        return;
+    }
+
+    uint64_t now = usecTimestampNow();
+    uint64_t next = _nextSnapshotUsecs.load(std::memory_order_relaxed);
+    // only the one thread that moves the time of the next snapshot logs this one
+    if (now >= next && _nextSnapshotUsecs.compare_exchange_strong(next, now + _snapshotIntervalUsecs)) {
+        logSnapshot();
+    }
+}
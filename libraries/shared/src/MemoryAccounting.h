@@ -0,0 +1,126 @@
+//
+//  MemoryAccounting.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_MemoryAccounting_h
+#define hifi_MemoryAccounting_h
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+// How much memory each subsystem of the process holds, by name ("resources.TextureCache", "network.packetBuffers"...),
+// for the stats overlay, the Memory script API and the stats of the assignment clients.
+//
+// A subsystem either counts what it allocates and frees on a tag, usually a static local where it allocates:
+//     static MemoryTag soundBuffers("audio.soundBuffers");
+//     soundBuffers.allocated(size);
+// or, when it already keeps its own sizes, adds a source that the registry reads from whenever it is sampled.
+//
+// The sizes are what the subsystems account for, not what the allocator gives them, so they don't sum up to the memory
+// of the process, which the snapshots log next to them.
+class MemoryAccounting {
+public:
+    static const int MAX_TAGS = 128;
+
+    struct Usage {
+        QString name;
+        int64_t bytes { 0 };
+        int64_t peakBytes { 0 };
+        int64_t count { 0 };
+    };
+
+    // Reads the bytes and the number of objects of a source. It is called with the registry locked, from any thread,
+    // so it should only read values the source keeps atomically and must not lock anything.
+    using SourceFunction = std::function<void(int64_t& bytes, int64_t& count)>;
+
+    static MemoryAccounting& getInstance();
+
+    // the index of the tag, the same one if it was registered already, -1 when there is no more room
+    int registerTag(const QString& name);
+
+    void add(int tag, int64_t bytes, int64_t count) {
+        if (tag < 0) {
+            return;
+        }
+        Tag& entry = _tags[tag];
+        int64_t total = entry.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        entry.count.fetch_add(count, std::memory_order_relaxed);
+
+        int64_t peak = entry.peakBytes.load(std::memory_order_relaxed);
+        while (total > peak && !entry.peakBytes.compare_exchange_weak(peak, total, std::memory_order_relaxed)) {
+        }
+    }
+
+    // the id to remove the source with, before whatever it reads from goes away
+    int addSource(const QString& name, SourceFunction function);
+    void removeSource(int id);
+
+    // the tags in the order they were registered, then the sources
+    std::vector<Usage> sample();
+
+    // { "accounted_bytes", "process_used_bytes" where it is known, "usage": { name: { "bytes", "peak_bytes", "count" } } }
+    QJsonObject toJson() { return toJson(sample()); }
+    static QJsonObject toJson(const std::vector<Usage>& usages);
+
+    void logSnapshot();
+
+    // Logs a snapshot when one is due, every VIRCADIA_MEMORY_SNAPSHOT_INTERVAL seconds if the variable is set. Cheap
+    // enough to be called from the stats updates of the process.
+    void logSnapshotIfDue();
+
+private:
+    MemoryAccounting();
+
+    struct Tag {
+        std::atomic<int64_t> bytes { 0 };
+        std::atomic<int64_t> peakBytes { 0 };
+        std::atomic<int64_t> count { 0 };
+    };
+
+    struct Source {
+        int id;
+        QString name;
+        SourceFunction function;
+        int64_t peakBytes { 0 };
+    };
+
+    Tag _tags[MAX_TAGS];
+
+    std::mutex _mutex;
+    std::vector<QString> _tagNames;
+    std::vector<Source> _sources;
+    int _nextSourceId { 0 };
+
+    uint64_t _snapshotIntervalUsecs { 0 };
+    std::atomic<uint64_t> _nextSnapshotUsecs { 0 };
+};
+
+// A handle on a tag of the MemoryAccounting, cheap to count on.
+class MemoryTag {
+public:
+    MemoryTag(const char* name) : _index(MemoryAccounting::getInstance().registerTag(name)) {}
+
+    void allocated(int64_t bytes, int64_t count = 1) { MemoryAccounting::getInstance().add(_index, bytes, count); }
+    void freed(int64_t bytes, int64_t count = 1) { MemoryAccounting::getInstance().add(_index, -bytes, -count); }
+    void resized(int64_t oldBytes, int64_t newBytes) { MemoryAccounting::getInstance().add(_index, newBytes - oldBytes, 0); }
+
+private:
+    const int _index;
+};
+
+#endif // hifi_MemoryAccounting_h
@@ -27,6 +27,8 @@ const float DYNAMIC_LINEAR_SPEED_THRESHOLD = 0.05f;  // 5 cm/sec
 const float DYNAMIC_ANGULAR_SPEED_THRESHOLD = 0.087266f;  // ~5 deg/sec
 const float KINEMATIC_LINEAR_SPEED_THRESHOLD = 0.001f;  // 1 mm/sec
 const float KINEMATIC_ANGULAR_SPEED_THRESHOLD = 0.008f;  // ~0.5 deg/sec
+const float REDUCED_DETAIL_LINEAR_SPEED_THRESHOLD = 0.2f;  // 20 cm/sec
+const float REDUCED_DETAIL_ANGULAR_SPEED_THRESHOLD = 0.349066f;  // ~20 deg/sec
 
 // return incremental rotation (Bullet-style) caused by angularVelocity over timeStep
 glm::quat computeBulletRotationStep(const glm::vec3& angularVelocity, float timeStep);
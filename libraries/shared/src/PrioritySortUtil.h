@@ -11,12 +11,19 @@
 #ifndef hifi_PrioritySortUtil_h
 #define hifi_PrioritySortUtil_h
 
+#include <algorithm>
+#include <vector>
+
 #include <glm/glm.hpp>
 
+#include "CullingBatch.h"
 #include "NumericalConstants.h"
 #include "shared/ConicalViewFrustum.h"
 
 //   PrioritySortUtil is a helper for sorting 3D things relative to a ViewFrustum.
+//
+//   The priorities are computed when the things are sorted, a batch of things at a time against each view. A queue can be
+//   kept from one frame to the next and cleared, so that its storage is reused.
 
 const float OUT_OF_VIEW_PENALTY = -10.0f;
 const float OUT_OF_VIEW_THRESHOLD = 0.5f * OUT_OF_VIEW_PENALTY;
@@ -62,69 +69,92 @@ namespace PrioritySortUtil {
 
         size_t size() const { return _vector.size(); }
         void push(T thing) {
-            thing.setPriority(computePriority(thing));
             _vector.push_back(thing);
         }
         void reserve(size_t num) {
             _vector.reserve(num);
         }
+        // empties the queue for another frame, keeping its storage
+        void clear() {
+            _vector.clear();
+            _numPrioritized = 0;
+            _usecCurrentTime = usecTimestampNow();
+        }
+
+        // the first numToSort things are the ones of highest priority, in order, the others follow in no order
         const std::vector<T>& getSortedVector(int numToSort = 0) {
+            computePriorities();
+            auto higherPriority = [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); };
             if (numToSort == 0 || numToSort >= (int)_vector.size()) {
-                std::sort(_vector.begin(), _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
+                std::sort(_vector.begin(), _vector.end(), higherPriority);
             } else {
-                std::partial_sort(_vector.begin(), _vector.begin() + numToSort, _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
+                // only the top of the queue is used, selecting it first is linear in the size of the queue
+                auto top = _vector.begin() + numToSort;
+                std::nth_element(_vector.begin(), top, _vector.end(), higherPriority);
+                std::sort(_vector.begin(), top, higherPriority);
             }
             return _vector;
         }
 
     private:
-
-        float computePriority(const T& thing) const {
-            float priority = std::numeric_limits<float>::min();
-
-            for (const auto& view : _views) {
-                priority = std::max(priority, computePriority(view, thing));
-            }
-
-            return priority;
-        }
-
-        float computePriority(const ConicalViewFrustum& view, const T& thing) const {
+        // the things pushed since the last sort
+        void computePriorities() {
             // priority = weighted linear combination of multiple values:
             //   (a) angular size
             //   (b) proximity to center of view
             //   (c) time since last update
             // where the relative "weights" are tuned to scale the contributing values into units of "priority".
-
-            glm::vec3 position = thing.getPosition();
-            glm::vec3 offset = position - view.getPosition();
-            float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
             const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
-            float radius = glm::max(thing.getRadius(), MIN_RADIUS);
-            // Other item's angle from view centre:
-            float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
-            if (cosineAngle > 0.0f) {
-                cosineAngle = std::sqrt(cosineAngle);
-            }
-            float age = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
-
-            // the "age" term accumulates at the sum of all weights
-            float angularSize = radius / distance;
-            float priority = (_angularWeight * angularSize + _centerWeight * cosineAngle) * (age + 1.0f) + _ageWeight * age;
+            const float ANY_ANGULAR_SIZE = -1.0f;
+
+            for (size_t first = _numPrioritized; first < _vector.size(); first += CULLING_BATCH_SIZE) {
+                int count = (int)std::min(_vector.size() - first, (size_t)CULLING_BATCH_SIZE);
+                CullingSphereBatch spheres;
+                float ages[CULLING_BATCH_SIZE] {};
+                float priorities[CULLING_BATCH_SIZE];
+                for (int i = 0; i < count; ++i) {
+                    const T& thing = _vector[first + i];
+                    spheres.add(thing.getPosition(), glm::max(thing.getRadius(), MIN_RADIUS));
+                    ages[i] = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
+                }
+                std::fill(priorities, priorities + CULLING_BATCH_SIZE, std::numeric_limits<float>::min());
+
+                for (const auto& view : _views) {
+                    uint8_t inViewMask = view.intersects(spheres, ANY_ANGULAR_SIZE);
+                    const glm::vec3& viewPosition = view.getPosition();
+                    const glm::vec3& viewDirection = view.getDirection();
+
+                    // branchless over the whole batch, for the compiler to vectorize
+                    for (int i = 0; i < CULLING_BATCH_SIZE; ++i) {
+                        glm::vec3 offset = glm::vec3(spheres.x[i], spheres.y[i], spheres.z[i]) - viewPosition;
+                        float radius = spheres.radius[i];
+                        float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
+                        // Other item's angle from view centre:
+                        float cosineAngle = glm::dot(offset, viewDirection) / distance;
+                        cosineAngle = cosineAngle > 0.0f ? std::sqrt(cosineAngle) : cosineAngle;
+                        float age = ages[i];
+
+                        // the "age" term accumulates at the sum of all weights
+                        float angularSize = radius / distance;
+                        float priority = (_angularWeight * angularSize + _centerWeight * cosineAngle) * (age + 1.0f) + _ageWeight * age;
+
+                        // decrement priority of things outside keyhole
+                        bool isOutOfView = distance - radius > view.getRadius() && !(inViewMask & (1 << i));
+                        priority += isOutOfView ? OUT_OF_VIEW_PENALTY : 0.0f;
+                        priorities[i] = std::max(priorities[i], priority);
+                    }
+                }
 
-            // decrement priority of things outside keyhole
-            if (distance - radius > view.getRadius()) {
-                if (!view.intersects(offset, distance, radius)) {
-                    priority += OUT_OF_VIEW_PENALTY;
+                for (int i = 0; i < count; ++i) {
+                    _vector[first + i].setPriority(priorities[i]);
                 }
             }
-            return priority;
+            _numPrioritized = _vector.size();
         }
 
         ConicalViewFrustums _views;
         std::vector<T> _vector;
+        size_t _numPrioritized { 0 };
         float _angularWeight { DEFAULT_ANGULAR_COEF };
         float _centerWeight { DEFAULT_CENTER_COEF };
         float _ageWeight { DEFAULT_AGE_COEF };
@@ -136,5 +166,6 @@ namespace PrioritySortUtil {
 const uint64_t MAX_UPDATE_RENDERABLES_TIME_BUDGET = 2000; // usec
 const uint64_t MIN_SORTED_UPDATE_RENDERABLES_TIME_BUDGET = 1000; // usec
 const uint64_t MAX_UPDATE_AVATARS_TIME_BUDGET = 2000; // usec
+const uint64_t MAX_FINALIZE_MODELS_TIME_BUDGET = 4000; // usec
 
 #endif // hifi_PrioritySortUtil_h
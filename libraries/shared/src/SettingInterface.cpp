@@ -64,13 +64,16 @@ namespace Setting {
         // This makes the timer fire on the settings thread so we don't block the main
         // thread with a lot of file I/O.
         // We bring back the manager to the main thread when the QApplication goes down
+        // The QSettings goes along, so that the manager can filter its events
         globalManager->moveToThread(thread);
+        globalManager->_qSettings.moveToThread(thread);
         QObject::connect(thread, &QThread::finished, globalManager.data(), [] {
             auto globalManager = DependencyManager::get<Manager>();
             Q_ASSERT(qApp && globalManager);
 
             // Move manager back to the main thread (has to be done on owning thread)
             globalManager->moveToThread(qApp->thread());
+            globalManager->_qSettings.moveToThread(qApp->thread());
         });
 
         // Start the settings save thread
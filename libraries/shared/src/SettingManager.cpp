@@ -13,12 +13,23 @@
 
 #include <QtCore/QThread>
 #include <QtCore/QDebug>
+#include <QtCore/QEvent>
 #include <QtCore/QUuid>
 
 #include "SettingInterface.h"
 
 namespace Setting {
 
+    Manager::Manager() {
+        // The snapshot the handles are loaded from
+        for (const auto& key : _qSettings.allKeys()) {
+            _values.insert(key, _qSettings.value(key));
+        }
+
+        // The QSettings would otherwise sync on its own, on whatever thread it lives in, after each change
+        _qSettings.installEventFilter(this);
+    }
+
     Manager::~Manager() {
         // Cleanup timer
         stopTimer();
@@ -47,17 +58,14 @@ namespace Setting {
 
     void Manager::loadSetting(Interface* handle) {
         const auto& key = handle->getKey();
-        withWriteLock([&] {
-            QVariant loadedValue;
-            if (_pendingChanges.contains(key) && _pendingChanges[key] != UNSET_VALUE) {
-                loadedValue = _pendingChanges[key];
-            } else {
-                loadedValue = _qSettings.value(key);
-            }
-            if (loadedValue.isValid()) {
-                handle->setVariant(loadedValue);
-            }
-        });
+        QVariant loadedValue;
+        {
+            QMutexLocker lock(&_valuesMutex);
+            loadedValue = _values.value(key);
+        }
+        if (loadedValue.isValid()) {
+            handle->setVariant(loadedValue);
+        }
     }
 
 
@@ -68,9 +76,45 @@ namespace Setting {
             handleValue = handle->getVariant();
         }
 
-        withWriteLock([&] {
-            _pendingChanges[key] = handleValue;
-        });
+        QMutexLocker lock(&_valuesMutex);
+        _pendingChanges[key] = handleValue;
+        if (handleValue == UNSET_VALUE) {
+            _values.remove(key);
+        } else {
+            _values[key] = handleValue;
+        }
+    }
+
+    QString Manager::fullKey(const QString& key) const {
+        // the group of the QSettings includes the index of the current array
+        QString group = _qSettings.group();
+        return group.isEmpty() ? key : group + "/" + key;
+    }
+
+    void Manager::updateValue(const QString& key, const QVariant& value) {
+        QMutexLocker lock(&_valuesMutex);
+        if (value.isValid()) {
+            _values[key] = value;
+        } else {
+            // the children of a group go with it
+            _values.remove(key);
+            const QString groupPrefix = key + "/";
+            for (auto it = _values.begin(); it != _values.end();) {
+                if (it.key().startsWith(groupPrefix)) {
+                    it = _values.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    bool Manager::eventFilter(QObject* object, QEvent* event) {
+        if (object == &_qSettings && event->type() == QEvent::UpdateRequest) {
+            // saveAll syncs it, on the settings thread
+            return true;
+        }
+        return QObject::eventFilter(object, event);
     }
 
     static const int SAVE_INTERVAL_MSEC = 5 * 1000; // 5 sec
@@ -92,10 +136,18 @@ namespace Setting {
     }
 
     void Manager::saveAll() {
+        QHash<QString, QVariant> changes;
+        {
+            QMutexLocker lock(&_valuesMutex);
+            changes.swap(_pendingChanges);
+        }
+
         withWriteLock([&] {
-            bool forceSync = false;
-            for (auto key : _pendingChanges.keys()) {
-                auto newValue = _pendingChanges[key];
+            bool forceSync = _hasUnsavedChanges;
+            _hasUnsavedChanges = false;
+            for (auto it = changes.cbegin(); it != changes.cend(); ++it) {
+                const auto& key = it.key();
+                const auto& newValue = it.value();
                 auto savedValue = _qSettings.value(key, UNSET_VALUE);
                 if (newValue == savedValue) {
                     continue;
@@ -107,7 +159,6 @@ namespace Setting {
                     _qSettings.setValue(key, newValue);
                 }
             }
-            _pendingChanges.clear();
 
             if (forceSync) {
                 _qSettings.sync();
@@ -128,7 +179,9 @@ namespace Setting {
 
     void Manager::remove(const QString &key) {
         withWriteLock([&] {
+            updateValue(fullKey(key), QVariant());
             _qSettings.remove(key);
+            _hasUnsavedChanges = true;
         });
     }
 
@@ -177,6 +230,7 @@ namespace Setting {
     void Manager::endArray() {
         withWriteLock([&] {
             _qSettings.endArray();
+            _hasUnsavedChanges = true;
         });
     }
 
@@ -194,7 +248,9 @@ namespace Setting {
 
     void Manager::setValue(const QString &key, const QVariant &value) {
         withWriteLock([&] {
+            updateValue(fullKey(key), value);
             _qSettings.setValue(key, value);
+            _hasUnsavedChanges = true;
         });
     }
 
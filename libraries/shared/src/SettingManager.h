@@ -12,6 +12,7 @@
 #ifndef hifi_SettingManager_h
 #define hifi_SettingManager_h
 
+#include <QtCore/QMutex>
 #include <QtCore/QPointer>
 #include <QtCore/QSettings>
 #include <QtCore/QTimer>
@@ -23,10 +24,14 @@
 namespace Setting {
     class Interface;
 
+    // The values of the Setting::Handles are kept in memory, loaded once at startup, and their changes are written to
+    // the QSettings and to disk by the settings thread, every few seconds and when the application goes down. The main
+    // thread never waits on the disk for them.
     class Manager : public QObject, public ReadWriteLockable, public Dependency {
         Q_OBJECT
 
     public:
+        Manager();
         void customDeleter() override;
 
         // thread-safe proxies into QSettings
@@ -59,11 +64,22 @@ namespace Setting {
 
         void saveAll();
 
+    protected:
+        bool eventFilter(QObject* object, QEvent* event) override;
+
     private:
+        QString fullKey(const QString& key) const;
+        void updateValue(const QString& key, const QVariant& value);
+
         QHash<QString, Interface*> _handles;
         QPointer<QTimer> _saveTimer = nullptr;
         const QVariant UNSET_VALUE { QUuid::createUuid() };
-        QHash<QString, QVariant> _pendingChanges;
+
+        // with _valuesMutex, rather than the lock of the QSettings that saveAll holds while it writes to disk
+        QMutex _valuesMutex;
+        QHash<QString, QVariant> _values;            // as on disk, with the changes not saved yet
+        QHash<QString, QVariant> _pendingChanges;    // the keys to save, UNSET_VALUE for the ones to remove
+        bool _hasUnsavedChanges { false };           // written through the proxies, with the write lock
 
         friend class Interface;
         friend void cleanupSettingsSaveThread();
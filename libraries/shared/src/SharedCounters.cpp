@@ -0,0 +1,143 @@
+//
+//  SharedCounters.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SharedCounters.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+
+static const QString SHARED_COUNTERS_KEY_PREFIX = "hifi-counters-";
+
+thread_local SharedCounters::ThreadBlock* SharedCounters::_threadBlock { nullptr };
+thread_local bool SharedCounters::_isThreadBlockShared { false };
+
+SharedCounters& SharedCounters::getInstance() {
+    static SharedCounters instance;
+    return instance;
+}
+
+QString SharedCounters::keyFor(qint64 pid) {
+    return SHARED_COUNTERS_KEY_PREFIX + QString::number(pid);
+}
+
+SharedCounters::SharedCounters() : _sharedMemory(keyFor(QCoreApplication::applicationPid())) {
+    void* memory = nullptr;
+    if (_sharedMemory.create(sizeof(Segment))) {
+        memory = _sharedMemory.data();
+    } else if (_sharedMemory.error() == QSharedMemory::AlreadyExists && _sharedMemory.attach()) {
+        // left behind by a process that had the same pid and didn't exit cleanly
+        if (_sharedMemory.size() >= (int)sizeof(Segment)) {
+            memory = _sharedMemory.data();
+        } else {
+            _sharedMemory.detach();
+        }
+    }
+
+    if (memory) {
+        _segment = new (memory) Segment();
+    } else {
+        qWarning() << "SharedCounters: unable to make the shared memory segment," << _sharedMemory.errorString()
+                   << "- the counters are kept in the process";
+        _localSegment.reset(new Segment());
+        _segment = _localSegment.get();
+    }
+
+    _segment->header.magic = MAGIC;
+    _segment->header.version = VERSION;
+    _segment->header.numCounters.store(0, std::memory_order_release);
+    _segment->header.numThreads.store(0, std::memory_order_release);
+}
+
+SharedCounters::~SharedCounters() {
+    // destroyed with the other statics once main returns, the threads that count are joined by then
+    _sharedMemory.detach();
+}
+
+int SharedCounters::registerCounter(const char* name) {
+    std::lock_guard<std::mutex> lock(_registerMutex);
+
+    Header& header = _segment->header;
+    uint32_t numCounters = header.numCounters.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < numCounters; ++i) {
+        if (strncmp(header.names[i], name, MAX_NAME_LENGTH - 1) == 0) {
+            return (int)i;
+        }
+    }
+
+    if (numCounters >= (uint32_t)MAX_COUNTERS) {
+        qWarning() << "SharedCounters: no more room for" << name;
+        return -1;
+    }
+
+    strncpy(header.names[numCounters], name, MAX_NAME_LENGTH - 1);
+    header.names[numCounters][MAX_NAME_LENGTH - 1] = '\0';
+    header.numCounters.store(numCounters + 1, std::memory_order_release);
+    return (int)numCounters;
+}
+
+SharedCounters::ThreadBlock* SharedCounters::assignThreadBlock() {
+    uint32_t index = _segment->header.numThreads.fetch_add(1, std::memory_order_relaxed);
+    if (index >= (uint32_t)MAX_THREADS - 1) {
+        index = MAX_THREADS - 1;
+        _isThreadBlockShared = true;
+    }
+    _threadBlock = &_segment->threads[index];
+    return _threadBlock;
+}
+
+bool SharedCountersReader::attach(qint64 pid) {
+    _segment = nullptr;
+    if (_sharedMemory.isAttached()) {
+        _sharedMemory.detach();
+    }
+
+    _sharedMemory.setKey(SharedCounters::keyFor(pid));
+    if (!_sharedMemory.attach(QSharedMemory::ReadOnly)) {
+        return false;
+    }
+
+    auto segment = static_cast<const SharedCounters::Segment*>(_sharedMemory.constData());
+    if (_sharedMemory.size() < (int)sizeof(SharedCounters::Segment) || segment->header.magic != SharedCounters::MAGIC ||
+        segment->header.version != SharedCounters::VERSION) {
+        qWarning() << "SharedCountersReader: the segment of" << pid << "isn't one of this version";
+        _sharedMemory.detach();
+        return false;
+    }
+
+    _segment = segment;
+    return true;
+}
+
+std::vector<std::pair<QString, uint64_t>> SharedCountersReader::read() const {
+    std::vector<std::pair<QString, uint64_t>> counters;
+    if (!_segment) {
+        return counters;
+    }
+
+    const auto& header = _segment->header;
+    uint32_t numCounters = std::min(header.numCounters.load(std::memory_order_acquire), (uint32_t)SharedCounters::MAX_COUNTERS);
+    uint32_t numThreads = std::min(header.numThreads.load(std::memory_order_relaxed), (uint32_t)SharedCounters::MAX_THREADS);
+
+    counters.reserve(numCounters);
+    for (uint32_t i = 0; i < numCounters; ++i) {
+        uint64_t value = 0;
+        for (uint32_t thread = 0; thread < numThreads; ++thread) {
+            value += _segment->threads[thread].values[i].load(std::memory_order_relaxed);
+        }
+        counters.emplace_back(QString::fromLatin1(header.names[i], (int)strnlen(header.names[i], SharedCounters::MAX_NAME_LENGTH)),
+                              value);
+    }
+    return counters;
+}
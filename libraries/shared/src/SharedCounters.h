@@ -0,0 +1,132 @@
+//
+//  SharedCounters.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SharedCounters_h
+#define hifi_SharedCounters_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+#include <QtCore/QSharedMemory>
+#include <QtCore/QString>
+
+// Named counters of the hot paths (packets, bytes, frames...), in a shared memory segment of the process.
+//
+// Each thread gets its own block of values, aligned on cache lines, so that counting is a plain load and store that
+// never bounces a cache line between cores. The segment is keyed on the pid of the process (see keyFor), and an external
+// tool can attach to it read-only and sample the sums over the threads as often as it likes, without the process doing
+// anything. The counters only ever grow, the rates are up to the reader.
+//
+// Counters are registered once, usually as static locals where they are counted:
+//     static SharedCounter packetsSent("udt.packetsSent");
+//     packetsSent.increment();
+class SharedCounters {
+public:
+    static const uint32_t MAGIC = 0x48434e54;    // "HCNT"
+    static const uint32_t VERSION = 1;
+    static const int MAX_COUNTERS = 256;
+    static const int MAX_THREADS = 64;           // the threads past this share the last block
+    static const int MAX_NAME_LENGTH = 48;
+    static const int CACHE_LINE_SIZE = 64;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        std::atomic<uint32_t> numCounters;      // published once the name is written
+        std::atomic<uint32_t> numThreads;
+        char names[MAX_COUNTERS][MAX_NAME_LENGTH];
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ThreadBlock {
+        std::atomic<uint64_t> values[MAX_COUNTERS];
+    };
+
+    struct Segment {
+        Header header;
+        ThreadBlock threads[MAX_THREADS];
+    };
+
+    static_assert(sizeof(ThreadBlock) % CACHE_LINE_SIZE == 0, "The thread blocks must not share cache lines");
+
+    static SharedCounters& getInstance();
+    static QString keyFor(qint64 pid);
+
+    ~SharedCounters();
+
+    // the index of the counter, the same one if it was registered already, -1 when there is no more room
+    int registerCounter(const char* name);
+
+    void increment(int index, uint64_t amount) {
+        if (index < 0) {
+            return;
+        }
+        ThreadBlock* block = _threadBlock;
+        if (!block) {
+            block = assignThreadBlock();
+        }
+        std::atomic<uint64_t>& value = block->values[index];
+        if (_isThreadBlockShared) {
+            value.fetch_add(amount, std::memory_order_relaxed);
+        } else {
+            // only this thread writes to its block
+            value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+    }
+
+    // whether the counters are in shared memory, rather than in the memory of the process when the segment couldn't be made
+    bool isShared() const { return _sharedMemory.isAttached(); }
+
+private:
+    SharedCounters();
+
+    ThreadBlock* assignThreadBlock();
+
+    QSharedMemory _sharedMemory;
+    std::unique_ptr<Segment> _localSegment;
+    Segment* _segment { nullptr };
+    std::mutex _registerMutex;
+
+    static thread_local ThreadBlock* _threadBlock;
+    static thread_local bool _isThreadBlockShared;
+};
+
+// A handle on a counter of the SharedCounters, cheap to increment.
+class SharedCounter {
+public:
+    SharedCounter(const char* name) : _index(SharedCounters::getInstance().registerCounter(name)) {}
+
+    void increment(uint64_t amount = 1) { SharedCounters::getInstance().increment(_index, amount); }
+
+private:
+    const int _index;
+};
+
+// Reads the counters of another process, for the tools.
+class SharedCountersReader {
+public:
+    bool attach(qint64 pid);
+    QString getErrorString() const { return _sharedMemory.errorString(); }
+
+    // the names of the counters and their value summed over the threads, in the order they were registered
+    std::vector<std::pair<QString, uint64_t>> read() const;
+
+private:
+    QSharedMemory _sharedMemory;
+    const SharedCounters::Segment* _segment { nullptr };
+};
+
+#endif // hifi_SharedCounters_h
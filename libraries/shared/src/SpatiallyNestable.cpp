@@ -21,6 +21,8 @@
 const float defaultAACubeSize = 1.0f;
 const int MAX_PARENTING_CHAIN_SIZE = 30;
 
+std::atomic<uint32_t> SpatiallyNestable::_worldTransformGeneration { 0 };
+
 SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
     _id(id),
     _nestableType(nestableType),
@@ -35,6 +37,9 @@ SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
 }
 
 SpatiallyNestable::~SpatiallyNestable() {
+    if (hasChildren()) {
+        invalidateWorldTransforms();
+    }
     forEachChild([&](SpatiallyNestablePointer object) {
         object->parentDeleted();
     });
@@ -79,6 +84,10 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
         }
     });
 
+    if (parentChanged) {
+        transformChanged(true);
+    }
+
     if (parentChanged && success && parent) {
         parent->recalculateChildCauterization();
     }
@@ -102,9 +111,15 @@ Transform SpatiallyNestable::getParentTransform(bool& success, int depth) const
     }
     if (parent) {
         result = parent->getJointTransform(_parentJointIndex, success, depth + 1);
-        if (getScalesWithParent()) {
+        bool scalesWithParent = getScalesWithParent();
+        if (scalesWithParent) {
             result.setScale(parent->scaleForChildren());
         }
+        // the joints and the scale of the parent change without this knowing, only the rest of the chain is cached
+        _isWorldTransformCacheable = success && _parentJointIndex == INVALID_JOINT_INDEX && !scalesWithParent &&
+            parent->_isWorldTransformCacheable;
+    } else {
+        _isWorldTransformCacheable = true;
     }
     return result;
 }
@@ -183,7 +198,10 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 }
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
-    _parentJointIndex = parentJointIndex;
+    if (_parentJointIndex != parentJointIndex) {
+        _parentJointIndex = parentJointIndex;
+        transformChanged(true);
+    }
     bool success = false;
     auto parent = getParentPointer(success);
     if (success && parent) {
@@ -515,6 +533,7 @@ void SpatiallyNestable::setWorldTransform(const glm::vec3& position, const glm::
             }
         });
         if (changed) {
+            transformChanged();
             locationChanged(false);
         }
     }
@@ -558,6 +577,9 @@ void SpatiallyNestable::setWorldPosition(const glm::vec3& position, bool& succes
             _translationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        transformChanged();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -611,6 +633,9 @@ void SpatiallyNestable::setWorldOrientation(const glm::quat& orientation, bool&
             _rotationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        transformChanged();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -746,14 +771,78 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
+    if (getCachedWorldTransform(result)) {
+        success = true;
+        return result;
+    }
+
+    // taken before the transforms are read, so that a change made meanwhile leaves the cache stale
+    uint32_t generation = _worldTransformGeneration.load(std::memory_order_acquire);
+    uint32_t version = _transformVersion.load(std::memory_order_acquire);
+
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    if (success && _isWorldTransformCacheable) {
+        cacheWorldTransform(result, generation, version);
+    }
     return result;
 }
 
+void SpatiallyNestable::transformChanged(bool parentingChanged) {
+    _transformVersion.fetch_add(1, std::memory_order_release);
+    // the world transforms of the descendants are cached against the generation, one bump invalidates them all
+    if (parentingChanged || hasChildren()) {
+        invalidateWorldTransforms();
+    }
+}
+
+bool SpatiallyNestable::getCachedWorldTransform(Transform& result) const {
+    // a seqlock: the cache is only read when no thread was writing it meanwhile
+    uint32_t sequence = _worldTransformSequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+
+    bool isValid = _hasCachedWorldTransform && _isWorldTransformCacheable &&
+        _cachedWorldTransformGeneration == _worldTransformGeneration.load(std::memory_order_acquire) &&
+        _cachedTransformVersion == _transformVersion.load(std::memory_order_acquire);
+    glm::quat rotation = _cachedWorldRotation;
+    glm::vec3 scale = _cachedWorldScale;
+    glm::vec3 translation = _cachedWorldTranslation;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!isValid || _worldTransformSequence.load(std::memory_order_relaxed) != sequence) {
+        return false;
+    }
+    result = Transform();
+    result.setTranslation(translation);
+    result.setRotation(rotation);
+    result.setScale(scale);
+    return true;
+}
+
+void SpatiallyNestable::cacheWorldTransform(const Transform& transform, uint32_t generation, uint32_t version) const {
+    // when another thread is storing its own, that one is kept
+    uint32_t sequence = _worldTransformSequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) || !_worldTransformSequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _cachedWorldRotation = transform.getRotation();
+    _cachedWorldScale = transform.getScale();
+    _cachedWorldTranslation = transform.getTranslation();
+    _cachedWorldTransformGeneration = generation;
+    _cachedTransformVersion = version;
+    _hasCachedWorldTransform = true;
+
+    _worldTransformSequence.store(sequence + 2, std::memory_order_release);
+}
+
 const Transform SpatiallyNestable::getTransformWithOnlyLocalRotation(bool& success, int depth) const {
     Transform result;
     // return a world-space transform for this object's location
@@ -831,6 +920,7 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             }
         });
         if (changed) {
+            transformChanged();
             locationChanged();
         }
     }
@@ -885,6 +975,9 @@ void SpatiallyNestable::setSNScale(const glm::vec3& scale, bool& success) {
             _scaleChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        transformChanged();
+    }
     if (success && changed) {
         dimensionsChanged();
     }
@@ -917,6 +1010,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     });
 
     if (changed) {
+        transformChanged();
         locationChanged();
     }
 }
@@ -944,6 +1038,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
         }
     });
     if (changed) {
+        transformChanged();
         locationChanged(tellPhysics);
     }
 }
@@ -971,6 +1066,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
         }
     });
     if (changed) {
+        transformChanged();
         locationChanged();
     }
 }
@@ -1027,6 +1123,7 @@ void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        transformChanged();
         dimensionsChanged();
     }
 }
@@ -1126,6 +1223,8 @@ void SpatiallyNestable::forEachDescendantTest(const ChildLambdaTest& actor) cons
 }
 
 void SpatiallyNestable::locationChanged(bool tellPhysics, bool tellChildren) {
+    // something this is relative to may have moved
+    _transformVersion.fetch_add(1, std::memory_order_release);
     if (tellChildren) {
         forEachChild([&](SpatiallyNestablePointer object) {
             object->locationChanged(tellPhysics, tellChildren);
@@ -1391,6 +1490,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     });
 
     if (changed) {
+        transformChanged();
         locationChanged(false);
     }
 }
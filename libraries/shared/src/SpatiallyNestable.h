@@ -12,6 +12,8 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -215,7 +217,7 @@ public:
     void dump(const QString& prefix = "") const;
 
     virtual void locationChanged(bool tellPhysics = true, bool tellChildren = true); // called when a this object's location has changed
-    virtual void dimensionsChanged() { _queryAACubeSet = false; } // called when a this object's dimensions have changed
+    virtual void dimensionsChanged() { _queryAACubeSet = false; invalidateWorldTransforms(); } // called when a this object's dimensions have changed
     virtual void parentDeleted() { } // called on children of a deleted parent
 
     virtual void addGrab(GrabPointer grab);
@@ -226,6 +228,11 @@ public:
 
     void bumpAncestorChainRenderableVersion(int depth = 0) const;
 
+    // The world transforms are cached, for as long as the local transform of the object and the generation stay the
+    // same. A change that moves descendants without their knowing (a parent that is rescaled, reparented or deleted)
+    // bumps the generation, and with it every cached world transform is recomputed the next time it is asked for.
+    static void invalidateWorldTransforms() { _worldTransformGeneration.fetch_add(1, std::memory_order_release); }
+
 protected:
     QUuid _id;
     mutable SpatiallyNestableWeakPointer _parent;
@@ -267,6 +274,22 @@ private:
     bool _isDead { false };
     bool _queryAACubeIsPuffed { false };
 
+    // the cache of the world transform, see invalidateWorldTransforms
+    static std::atomic<uint32_t> _worldTransformGeneration;
+    std::atomic<uint32_t> _transformVersion { 0 };    // bumped with each change of _transform or of what it is relative to
+    mutable std::atomic<bool> _isWorldTransformCacheable { false };
+    mutable std::atomic<uint32_t> _worldTransformSequence { 0 };    // odd while the cache is written
+    mutable bool _hasCachedWorldTransform { false };
+    mutable uint32_t _cachedWorldTransformGeneration { 0 };
+    mutable uint32_t _cachedTransformVersion { 0 };
+    mutable glm::quat _cachedWorldRotation;
+    mutable glm::vec3 _cachedWorldScale;
+    mutable glm::vec3 _cachedWorldTranslation;
+
+    void transformChanged(bool parentingChanged = false);
+    bool getCachedWorldTransform(Transform& result) const;
+    void cacheWorldTransform(const Transform& transform, uint32_t generation, uint32_t version) const;
+
     void breakParentingLoop() const;
 };
 
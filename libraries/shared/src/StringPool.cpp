@@ -0,0 +1,53 @@
+//
+//  StringPool.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StringPool.h"
+
+StringPool& StringPool::getInstance() {
+    static StringPool instance;
+    return instance;
+}
+
+QString StringPool::intern(const QString& string) {
+    if (string.isEmpty() || string.size() > MAX_INTERNED_LENGTH) {
+        return string;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto pooled = _strings.constFind(string);
+    if (pooled != _strings.constEnd()) {
+        return *pooled;
+    }
+
+    if (_strings.size() >= _pruneSize) {
+        prune();
+    }
+    _strings.insert(string);
+    return string;
+}
+
+int StringPool::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _strings.size();
+}
+
+void StringPool::prune() {
+    for (auto it = _strings.begin(); it != _strings.end();) {
+        // only the pool holds on it
+        if (it->isDetached()) {
+            it = _strings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    int pruneSize = 2 * _strings.size();
+    _pruneSize = pruneSize > MIN_PRUNE_SIZE ? pruneSize : MIN_PRUNE_SIZE;
+}
@@ -0,0 +1,51 @@
+//
+//  StringPool.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_StringPool_h
+#define hifi_StringPool_h
+
+#include <mutex>
+
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+// Interns the strings that many objects have the same value of, so that they share one buffer (QString is implicitly
+// shared) rather than each holding a copy: the URLs of the models, scripts and textures of the entities of a domain are
+// the same for thousands of them.
+//
+// The pool holds a reference on each string, the strings that nothing else holds on any more are dropped from it each
+// time it has doubled in size since the last time, so that it doesn't keep the values that were edited away.
+class StringPool {
+public:
+    static const int MAX_INTERNED_LENGTH = 4096;    // longer strings are rarely the same, hashing them isn't worth it
+
+    static StringPool& getInstance();
+
+    // the pooled string of the same value, pooling it if it wasn't, or the string itself when it is empty or too long
+    QString intern(const QString& string);
+
+    int size() const;
+
+private:
+    static const int MIN_PRUNE_SIZE = 1024;
+
+    StringPool() {}
+
+    void prune();
+
+    mutable std::mutex _mutex;
+    QSet<QString> _strings;
+    int _pruneSize { MIN_PRUNE_SIZE };
+};
+
+#endif // hifi_StringPool_h
@@ -9,6 +9,7 @@
 #include "Trace.h"
 
 #include <chrono>
+#include <random>
 
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
@@ -33,6 +34,7 @@
 #include "SharedLogging.h"
 #include "shared/FileUtils.h"
 #include "shared/GlobalAppProperties.h"
+#include "SharedUtil.h"
 
 using namespace tracing;
 
@@ -176,6 +178,43 @@ void Tracer::serialize(const QString& filename) {
 #endif
 }
 
+TraceID Tracer::sampleTraceID() {
+    float sampleRate = _sampleRate;
+    if (!_enabled || sampleRate <= 0.0f) {
+        return NULL_TRACE_ID;
+    }
+
+    // random rather than counted IDs, so that the samples of the processes don't collide once merged
+    static thread_local std::mt19937 generator { std::random_device()() };
+    std::uniform_real_distribution<float> sample(0.0f, 1.0f);
+    if (sample(generator) >= sampleRate) {
+        return NULL_TRACE_ID;
+    }
+    std::uniform_int_distribution<TraceID> traceID(NULL_TRACE_ID + 1);
+    return traceID(generator);
+}
+
+void tracing::traceFlow(const QLoggingCategory& category, const QString& name, EventType type, TraceID traceID,
+                        const QVariantMap& args) {
+    if (traceID == NULL_TRACE_ID || !DependencyManager::isSet<Tracer>()) {
+        return;
+    }
+    const auto& tracer = DependencyManager::get<Tracer>();
+    if (!tracer || !tracer->isEnabled()) {
+        return;
+    }
+
+    QString id = QString::number(traceID, 16);
+    QVariantMap stageArgs = args;
+    stageArgs["traceID"] = id;
+    stageArgs["usecTimestamp"] = (qulonglong)usecTimestampNow();
+
+    // the stage is a slice the flow event binds to, so that the trace viewer draws the arrows between the stages
+    auto timestamp = Tracer::now();
+    tracer->traceEvent(category, name, Complete, timestamp, id, stageArgs, { { "dur", 1 } });
+    tracer->traceEvent(category, name, type, timestamp, id, QVariantMap(), { { "bp", "e" } });
+}
+
 int64_t Tracer::now() {
     return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
 }
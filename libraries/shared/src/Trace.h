@@ -10,6 +10,7 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 
@@ -27,6 +28,10 @@ bool enabled();
 
 using TraceTimestamp = uint64_t;
 
+// Identifies a sample of the data that is followed across the processes, 0 for the data that isn't followed
+using TraceID = uint32_t;
+const TraceID NULL_TRACE_ID = 0;
+
 enum EventType : char {
     DurationBegin = 'B',
     DurationEnd = 'E',
@@ -95,6 +100,12 @@ public:
     void serialize(const QString& file);
     bool isEnabled() const { return _enabled; }
 
+    // the fraction of the data that sampleTraceID picks out to be followed, none by default
+    void setSampleRate(float sampleRate) { _sampleRate = sampleRate; }
+    float getSampleRate() const { return _sampleRate; }
+    // a new trace ID for a sample of the calls while tracing, NULL_TRACE_ID for the others
+    TraceID sampleTraceID();
+
 private:
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
@@ -103,6 +114,7 @@ private:
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
     bool _enabled { false };
+    std::atomic<float> _sampleRate { 0.0f };
     std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
@@ -132,6 +144,20 @@ inline void traceEvent(const QLoggingCategory& category, const QString& name, Ev
     traceEvent(category, name, type, QString::number(id), args, extra);
 }
 
+inline TraceID sampleTraceID() {
+    if (!DependencyManager::isSet<Tracer>()) {
+        return NULL_TRACE_ID;
+    }
+    const auto& tracer = DependencyManager::get<Tracer>();
+    return tracer ? tracer->sampleTraceID() : NULL_TRACE_ID;
+}
+
+// Records a stage of the trace traceID in this process: type is FlowStart where the sample was taken, FlowEnd at the last
+// stage and FlowStep in between. The stages of the processes link up once their trace files are merged, the
+// usecTimestamp arg of each stage (the wall clock of usecTimestampNow) lines the files up.
+void traceFlow(const QLoggingCategory& category, const QString& name, EventType type, TraceID traceID,
+               const QVariantMap& args = {});
+
 }
 
 #endif // hifi_Trace_h
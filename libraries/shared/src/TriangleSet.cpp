@@ -11,9 +11,60 @@
 
 #include "TriangleSet.h"
 
+#include <float.h>
+
 #include "GLMHelpers.h"
 
-#include <list>
+static const uint32_t MAX_LEAF_TRIANGLES = 4;
+// past this many triangles a leaf is split even when the surface area heuristic would keep it
+static const uint32_t MAX_SAH_LEAF_TRIANGLES = 16;
+static const int NUM_SAH_BINS = 12;
+// the cost of visiting a node, relative to the cost of intersecting a triangle
+static const float NODE_TRAVERSAL_COST = 1.0f;
+// the traversal stacks are at most one deeper than the tree
+static const int MAX_DEPTH = 48;
+static const int MAX_STACK_SIZE = MAX_DEPTH + 2;
+
+// half the surface area of a box, which is all the heuristic needs
+static float getHalfArea(const glm::vec3& minCorner, const glm::vec3& maxCorner) {
+    glm::vec3 extent = glm::max(maxCorner - minCorner, glm::vec3(0.0f));
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
+static bool rayHitsBounds(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
+                          const glm::vec3& minCorner, const glm::vec3& maxCorner, float& entryDistance) {
+    float nearDistance = 0.0f;
+    float farDistance = FLT_MAX;
+    for (int i = 0; i < 3; i++) {
+        if (direction[i] == 0.0f) {
+            if (origin[i] < minCorner[i] || origin[i] > maxCorner[i]) {
+                return false;
+            }
+            continue;
+        }
+        float distance0 = (minCorner[i] - origin[i]) * invDirection[i];
+        float distance1 = (maxCorner[i] - origin[i]) * invDirection[i];
+        nearDistance = glm::max(nearDistance, glm::min(distance0, distance1));
+        farDistance = glm::min(farDistance, glm::max(distance0, distance1));
+        if (nearDistance > farDistance) {
+            return false;
+        }
+    }
+    entryDistance = nearDistance;
+    return true;
+}
+
+static bool parabolaHitsBounds(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+                               const glm::vec3& minCorner, const glm::vec3& maxCorner, float& entryDistance) {
+    AABox bounds(minCorner, maxCorner - minCorner);
+    if (bounds.contains(origin)) {
+        entryDistance = 0.0f;
+        return true;
+    }
+    BoxFace face;
+    glm::vec3 surfaceNormal;
+    return bounds.findParabolaIntersection(origin, velocity, acceleration, entryDistance, face, surfaceNormal);
+}
 
 void TriangleSet::insert(const Triangle& t) {
     _isBalanced = false;
@@ -26,10 +77,9 @@ void TriangleSet::insert(const Triangle& t) {
 
 void TriangleSet::clear() {
     _triangles.clear();
+    _nodes.clear();
     _bounds.clear();
     _isBalanced = false;
-
-    _triangleTree.clear();
 }
 
 bool TriangleSet::convexHullContains(const glm::vec3& point) const {
@@ -52,277 +102,225 @@ bool TriangleSet::convexHullContains(const glm::vec3& point) const {
 void TriangleSet::debugDump() {
     qDebug() << __FUNCTION__;
     qDebug() << "bounds:" << getBounds();
-    qDebug() << "triangles:" << size() << "at top level....";
-    qDebug() << "----- _triangleTree -----";
-    _triangleTree.debugDump();
+    qDebug() << "triangles:" << size() << "nodes:" << _nodes.size();
+    int numLeaves = 0;
+    for (const auto& node : _nodes) {
+        if (node.numTriangles > 0) {
+            numLeaves++;
+        }
+    }
+    qDebug() << "leaves:" << numLeaves;
 }
 
 void TriangleSet::balanceTree() {
-    _triangleTree.reset(_bounds);
+    _nodes.clear();
+    _isBalanced = true;
+    if (_triangles.empty()) {
+        return;
+    }
 
-    // insert all the triangles
-    for (size_t i = 0; i < _triangles.size(); i++) {
-        _triangleTree.insert(i);
+    uint32_t numTriangles = (uint32_t)_triangles.size();
+    std::vector<glm::vec3> centroids;
+    centroids.reserve(numTriangles);
+    for (const auto& triangle : _triangles) {
+        centroids.push_back((triangle.v0 + triangle.v1 + triangle.v2) / 3.0f);
     }
 
-    _isBalanced = true;
+    // a binary tree has fewer than twice as many nodes as leaves
+    _nodes.reserve(2 * (numTriangles / MAX_LEAF_TRIANGLES + 1));
+    _nodes.emplace_back();
+    buildNode(0, 0, numTriangles, 0, centroids);
 
 #if WANT_DEBUGGING
     debugDump();
 #endif
 }
 
-// With an octree: 8 ^ MAX_DEPTH = 4096 leaves
-//static const int MAX_DEPTH = 4;
-// With a k-d tree: 2 ^ MAX_DEPTH = 4096 leaves
-static const int MAX_DEPTH = 12;
-
-TriangleSet::TriangleTreeCell::TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth) :
-    _allTriangles(allTriangles)
-{
-    reset(bounds, depth);
-}
-
-void TriangleSet::TriangleTreeCell::clear() {
-    _population = 0;
-    _triangleIndices.clear();
-    _bounds.clear();
-    _children.first.reset();
-    _children.second.reset();
-}
+void TriangleSet::buildNode(uint32_t nodeIndex, uint32_t firstIndex, uint32_t numTriangles, int depth,
+                            std::vector<glm::vec3>& centroids) {
+    uint32_t endIndex = firstIndex + numTriangles;
+    glm::vec3 minCorner(FLT_MAX);
+    glm::vec3 maxCorner(-FLT_MAX);
+    glm::vec3 minCentroid(FLT_MAX);
+    glm::vec3 maxCentroid(-FLT_MAX);
+    for (uint32_t i = firstIndex; i < endIndex; i++) {
+        const auto& triangle = _triangles[i];
+        minCorner = glm::min(minCorner, glm::min(triangle.v0, glm::min(triangle.v1, triangle.v2)));
+        maxCorner = glm::max(maxCorner, glm::max(triangle.v0, glm::max(triangle.v1, triangle.v2)));
+        minCentroid = glm::min(minCentroid, centroids[i]);
+        maxCentroid = glm::max(maxCentroid, centroids[i]);
+    }
+    _nodes[nodeIndex].minCorner = minCorner;
+    _nodes[nodeIndex].maxCorner = maxCorner;
+    _nodes[nodeIndex].firstIndex = firstIndex;
+    _nodes[nodeIndex].numTriangles = numTriangles;
 
-void TriangleSet::TriangleTreeCell::reset(const AABox& bounds, int depth) {
-    clear();
-    _bounds = bounds;
-    _depth = depth;
-}
+    // the centroids are binned along their longest extent
+    glm::vec3 centroidExtent = maxCentroid - minCentroid;
+    int axis = 0;
+    if (centroidExtent.y > centroidExtent[axis]) {
+        axis = 1;
+    }
+    if (centroidExtent.z > centroidExtent[axis]) {
+        axis = 2;
+    }
+    if (numTriangles <= MAX_LEAF_TRIANGLES || depth >= MAX_DEPTH || centroidExtent[axis] <= 0.0f) {
+        return;
+    }
 
-void TriangleSet::TriangleTreeCell::debugDump() {
-    qDebug() << __FUNCTION__;
-    qDebug() << "               bounds:" << getBounds();
-    qDebug() << "                depth:" << _depth;
-    qDebug() << "           population:" << _population << "this level or below"
-             << " ---- triangleIndices:" << _triangleIndices.size() << "in this cell";
-
-    int numChildren = 0;
-    if (_children.first) {
-        numChildren++;
-    } else if (_children.second) {
-        numChildren++;
+    struct Bin {
+        glm::vec3 minCorner { FLT_MAX };
+        glm::vec3 maxCorner { -FLT_MAX };
+        uint32_t numTriangles { 0 };
+    };
+    Bin bins[NUM_SAH_BINS];
+    float binScale = (float)NUM_SAH_BINS / centroidExtent[axis];
+    auto getBinIndex = [&](const glm::vec3& centroid) {
+        return glm::min((int)((centroid[axis] - minCentroid[axis]) * binScale), NUM_SAH_BINS - 1);
+    };
+    for (uint32_t i = firstIndex; i < endIndex; i++) {
+        const auto& triangle = _triangles[i];
+        Bin& bin = bins[getBinIndex(centroids[i])];
+        bin.minCorner = glm::min(bin.minCorner, glm::min(triangle.v0, glm::min(triangle.v1, triangle.v2)));
+        bin.maxCorner = glm::max(bin.maxCorner, glm::max(triangle.v0, glm::max(triangle.v1, triangle.v2)));
+        bin.numTriangles++;
     }
-    qDebug() << "child cells:" << numChildren;
-    if (_depth < MAX_DEPTH) {
-        if (_children.first) {
-            qDebug() << "child: 0";
-            _children.first->debugDump();
-        }
-        if (_children.second) {
-            qDebug() << "child: 1";
-            _children.second->debugDump();
+
+    // the costs of the splits after each bin, swept from both ends
+    float belowCosts[NUM_SAH_BINS - 1];
+    {
+        Bin below;
+        for (int i = 0; i < NUM_SAH_BINS - 1; i++) {
+            below.minCorner = glm::min(below.minCorner, bins[i].minCorner);
+            below.maxCorner = glm::max(below.maxCorner, bins[i].maxCorner);
+            below.numTriangles += bins[i].numTriangles;
+            belowCosts[i] = below.numTriangles > 0 ?
+                (float)below.numTriangles * getHalfArea(below.minCorner, below.maxCorner) : FLT_MAX;
         }
     }
-}
-
-std::pair<AABox, AABox> TriangleSet::TriangleTreeCell::getTriangleTreeCellChildBounds() {
-    std::pair<AABox, AABox> toReturn;
-    int axis = 0;
-    // find biggest axis
-    glm::vec3 dimensions = _bounds.getDimensions();
-    for (int i = 0; i < 3; i++) {
-        if (dimensions[i] >= dimensions[(i + 1) % 3] && dimensions[i] >= dimensions[(i + 2) % 3]) {
-            axis = i;
-            break;
+    int bestSplit = -1;
+    float bestCost = FLT_MAX;
+    {
+        Bin above;
+        for (int i = NUM_SAH_BINS - 1; i > 0; i--) {
+            above.minCorner = glm::min(above.minCorner, bins[i].minCorner);
+            above.maxCorner = glm::max(above.maxCorner, bins[i].maxCorner);
+            above.numTriangles += bins[i].numTriangles;
+            if (above.numTriangles == 0 || belowCosts[i - 1] == FLT_MAX) {
+                continue;
+            }
+            float cost = belowCosts[i - 1] + (float)above.numTriangles * getHalfArea(above.minCorner, above.maxCorner);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = i - 1;
+            }
         }
     }
+    if (bestSplit < 0) {
+        return;
+    }
+    float halfArea = getHalfArea(minCorner, maxCorner);
+    float leafCost = (float)numTriangles * halfArea;
+    float splitCost = NODE_TRAVERSAL_COST * halfArea + bestCost;
+    if (splitCost >= leafCost && numTriangles <= MAX_SAH_LEAF_TRIANGLES) {
+        return;
+    }
 
-    // The new boxes are half the size in the largest dimension
-    glm::vec3 newDimensions = dimensions;
-    newDimensions[axis] *= 0.5f;
-    toReturn.first.setBox(_bounds.getCorner(), newDimensions);
-    glm::vec3 offset = glm::vec3(0.0f);
-    offset[axis] = newDimensions[axis];
-    toReturn.second.setBox(_bounds.getCorner() + offset, newDimensions);
-    return toReturn;
-}
-
-void TriangleSet::TriangleTreeCell::insert(size_t triangleIndex) {
-    _population++;
-
-    // if we're not yet at the max depth, then check which child the triangle fits in
-    if (_depth < MAX_DEPTH) {
-        const Triangle& triangle = _allTriangles[triangleIndex];
-        auto childBounds = getTriangleTreeCellChildBounds();
-
-        auto insertOperator = [&](const AABox& childBound, std::shared_ptr<TriangleTreeCell>& child) {
-            // if the child AABox would contain the triangle...
-            if (childBound.contains(triangle)) {
-                // if the child cell doesn't yet exist, create it...
-                if (!child) {
-                    child = std::make_shared<TriangleTreeCell>(_allTriangles, childBound, _depth + 1);
-                }
-
-                // insert the triangleIndex in the child cell
-                child->insert(triangleIndex);
-                return true;
-            }
-            return false;
-        };
-        if (insertOperator(childBounds.first, _children.first) || insertOperator(childBounds.second, _children.second)) {
-            return;
+    // the triangles of the bins up to the split go first
+    uint32_t splitIndex = firstIndex;
+    for (uint32_t i = firstIndex; i < endIndex; i++) {
+        if (getBinIndex(centroids[i]) <= bestSplit) {
+            std::swap(_triangles[i], _triangles[splitIndex]);
+            std::swap(centroids[i], centroids[splitIndex]);
+            splitIndex++;
         }
     }
-    // either we're at max depth, or the triangle doesn't fit in one of our
-    // children and so we want to just record it here
-    _triangleIndices.push_back(triangleIndex);
+
+    uint32_t childIndex = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
+    _nodes.emplace_back();
+    _nodes[nodeIndex].firstIndex = childIndex;
+    _nodes[nodeIndex].numTriangles = 0;
+    buildNode(childIndex, firstIndex, splitIndex - firstIndex, depth + 1, centroids);
+    buildNode(childIndex + 1, splitIndex, endIndex - splitIndex, depth + 1, centroids);
 }
 
+// Determine of the given ray (origin/direction) in model space intersects with any triangles in the set. The distance
+// passed in is the distance to the bounds of the set, if !precision it is kept as the distance to the triangles.
 bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection, float& distance,
                                       BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
     if (!_isBalanced) {
         balanceTree();
     }
-
-    float localDistance = distance;
-    int trianglesTouched = 0;
-    bool hit = _triangleTree.findRayIntersection(origin, direction, invDirection, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        distance = localDistance;
+    if (_nodes.empty()) {
+        return false;
     }
-
-#if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
+    if (!precision) {
+        face = UNKNOWN_FACE;
+        return true;
     }
-#endif
-    return hit;
-}
 
-// Determine of the given ray (origin/direction) in model space intersects with any triangles
-// in the set. If an intersection occurs, the distance and surface normal will be provided.
-bool TriangleSet::TriangleTreeCell::findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-                                                                  float& distance, BoxFace& face, Triangle& triangle, bool precision,
-                                                                  int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
     float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findRayTriangleIntersection(origin, direction, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
+    const Triangle* bestTriangle = nullptr;
+
+    // the nearer child is visited first, the farther one is skipped once a hit is nearer than its bounds
+    uint32_t stack[MAX_STACK_SIZE];
+    float stackDistances[MAX_STACK_SIZE];
+    int stackSize = 0;
+    float entryDistance;
+    if (rayHitsBounds(origin, direction, invDirection, _nodes[0].minCorner, _nodes[0].maxCorner, entryDistance)) {
+        stack[stackSize] = 0;
+        stackDistances[stackSize++] = entryDistance;
+    }
+    while (stackSize > 0) {
+        stackSize--;
+        if (stackDistances[stackSize] > bestDistance) {
+            continue;
+        }
+        const Node& node = _nodes[stack[stackSize]];
+        if (node.numTriangles > 0) {
+            for (uint32_t i = node.firstIndex; i < node.firstIndex + node.numTriangles; i++) {
+                float thisTriangleDistance;
+                if (findRayTriangleIntersection(origin, direction, _triangles[i], thisTriangleDistance, allowBackface) &&
+                        thisTriangleDistance < bestDistance) {
                     bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
+                    bestTriangle = &_triangles[i];
                 }
             }
+            continue;
         }
-    } else {
-        intersectedSomething = true;
-        bestDistance = distance;
-    }
-
-    if (intersectedSomething) {
-        distance = bestDistance;
-        triangle = bestTriangle;
-    }
-
-    return intersectedSomething;
-}
-
-bool TriangleSet::TriangleTreeCell::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-                                                        float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-                                                        bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
-    }
-
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
-    bool intersects = false;
 
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = distance;
-        BoxFace internalFace { UNKNOWN_FACE };
-        Triangle internalTriangle;
-        if (findRayIntersectionInternal(origin, direction, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
+        uint32_t nearIndex = node.firstIndex;
+        uint32_t farIndex = node.firstIndex + 1;
+        float nearDistance;
+        float farDistance;
+        bool hitsNear = rayHitsBounds(origin, direction, invDirection, _nodes[nearIndex].minCorner, _nodes[nearIndex].maxCorner, nearDistance);
+        bool hitsFar = rayHitsBounds(origin, direction, invDirection, _nodes[farIndex].minCorner, _nodes[farIndex].maxCorner, farDistance);
+        if (hitsNear && hitsFar && farDistance < nearDistance) {
+            std::swap(nearIndex, farIndex);
+            std::swap(nearDistance, farDistance);
+        } else if (!hitsNear) {
+            std::swap(nearIndex, farIndex);
+            std::swap(nearDistance, farDistance);
+            std::swap(hitsNear, hitsFar);
         }
-    }
-
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findRayIntersection(origin, direction, invDirection, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
-                        }
-                    }
-                }
-
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
-                }
-            }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
-                break;
-            }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
-                BoxFace childBoundFace;
-                glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findRayIntersection(origin, direction, invDirection, childDistance, childBoundFace, childBoundNormal);
-            }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findRayIntersection(origin, direction, invDirection, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
-                    intersects = true;
-                    break;
-                }
-            }
+        if (hitsFar && farDistance <= bestDistance) {
+            stack[stackSize] = farIndex;
+            stackDistances[stackSize++] = farDistance;
+        }
+        if (hitsNear && nearDistance <= bestDistance) {
+            stack[stackSize] = nearIndex;
+            stackDistances[stackSize++] = nearDistance;
         }
     }
 
-    if (intersects) {
-        distance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+    if (!bestTriangle) {
+        return false;
     }
-    return intersects;
+    distance = bestDistance;
+    face = UNKNOWN_FACE;
+    triangle = *bestTriangle;
+    return true;
 }
 
 bool TriangleSet::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
@@ -330,146 +328,72 @@ bool TriangleSet::findParabolaIntersection(const glm::vec3& origin, const glm::v
     if (!_isBalanced) {
         balanceTree();
     }
-
-    float localDistance = parabolicDistance;
-    int trianglesTouched = 0;
-    bool hit = _triangleTree.findParabolaIntersection(origin, velocity, acceleration, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        parabolicDistance = localDistance;
+    if (_nodes.empty()) {
+        return false;
     }
-
-#if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
+    if (!precision) {
+        face = UNKNOWN_FACE;
+        return true;
     }
-#endif
-    return hit;
-}
 
-bool TriangleSet::TriangleTreeCell::findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity,
-                                                                       const glm::vec3& acceleration, float& parabolicDistance,
-                                                                       BoxFace& face, Triangle& triangle, bool precision,
-                                                                       int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
     float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findParabolaTriangleIntersection(origin, velocity, acceleration, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
+    const Triangle* bestTriangle = nullptr;
+
+    uint32_t stack[MAX_STACK_SIZE];
+    float stackDistances[MAX_STACK_SIZE];
+    int stackSize = 0;
+    float entryDistance;
+    if (parabolaHitsBounds(origin, velocity, acceleration, _nodes[0].minCorner, _nodes[0].maxCorner, entryDistance)) {
+        stack[stackSize] = 0;
+        stackDistances[stackSize++] = entryDistance;
+    }
+    while (stackSize > 0) {
+        stackSize--;
+        if (stackDistances[stackSize] > bestDistance) {
+            continue;
+        }
+        const Node& node = _nodes[stack[stackSize]];
+        if (node.numTriangles > 0) {
+            for (uint32_t i = node.firstIndex; i < node.firstIndex + node.numTriangles; i++) {
+                float thisTriangleDistance;
+                if (findParabolaTriangleIntersection(origin, velocity, acceleration, _triangles[i], thisTriangleDistance, allowBackface) &&
+                        thisTriangleDistance < bestDistance) {
                     bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
+                    bestTriangle = &_triangles[i];
                 }
             }
+            continue;
         }
-    } else {
-        intersectedSomething = true;
-        bestDistance = parabolicDistance;
-    }
-
-    if (intersectedSomething) {
-        parabolicDistance = bestDistance;
-        triangle = bestTriangle;
-    }
-
-    return intersectedSomething;
-}
-
-bool TriangleSet::TriangleTreeCell::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity,
-                                                               const glm::vec3& acceleration, float& parabolicDistance,
-                                                               BoxFace& face, Triangle& triangle, bool precision,
-                                                               int& trianglesTouched, bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
-    }
 
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
-    bool intersects = false;
-
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = parabolicDistance;
-        BoxFace internalFace;
-        Triangle internalTriangle;
-        if (findParabolaIntersectionInternal(origin, velocity, acceleration, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
+        uint32_t nearIndex = node.firstIndex;
+        uint32_t farIndex = node.firstIndex + 1;
+        float nearDistance;
+        float farDistance;
+        bool hitsNear = parabolaHitsBounds(origin, velocity, acceleration, _nodes[nearIndex].minCorner, _nodes[nearIndex].maxCorner, nearDistance);
+        bool hitsFar = parabolaHitsBounds(origin, velocity, acceleration, _nodes[farIndex].minCorner, _nodes[farIndex].maxCorner, farDistance);
+        if (hitsNear && hitsFar && farDistance < nearDistance) {
+            std::swap(nearIndex, farIndex);
+            std::swap(nearDistance, farDistance);
+        } else if (!hitsNear) {
+            std::swap(nearIndex, farIndex);
+            std::swap(nearDistance, farDistance);
+            std::swap(hitsNear, hitsFar);
         }
-    }
-
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findParabolaIntersection(origin, velocity, acceleration, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
-                        }
-                    }
-                }
-
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
-                }
-            }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
-                break;
-            }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
-                BoxFace childBoundFace;
-                glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findParabolaIntersection(origin, velocity, acceleration, childDistance, childBoundFace, childBoundNormal);
-            }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findParabolaIntersection(origin, velocity, acceleration, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
-                    intersects = true;
-                    break;
-                }
-            }
+        if (hitsFar && farDistance <= bestDistance) {
+            stack[stackSize] = farIndex;
+            stackDistances[stackSize++] = farDistance;
+        }
+        if (hitsNear && nearDistance <= bestDistance) {
+            stack[stackSize] = nearIndex;
+            stackDistances[stackSize++] = nearDistance;
         }
     }
 
-    if (intersects) {
-        parabolicDistance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+    if (!bestTriangle) {
+        return false;
     }
-    return intersects;
+    parabolicDistance = bestDistance;
+    face = UNKNOWN_FACE;
+    triangle = *bestTriangle;
+    return true;
 }
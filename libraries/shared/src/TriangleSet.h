@@ -11,59 +11,25 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
-#include <memory>
 
 #include "AABox.h"
 #include "GeometryUtil.h"
 
+// The triangles of a mesh part, in a bounding volume hierarchy built with the surface area heuristic. The nodes are kept
+// in a flat array and the triangles are reordered so that each leaf covers a contiguous range of them.
 class TriangleSet {
 
-    class TriangleTreeCell {
-    public:
-        TriangleTreeCell(std::vector<Triangle>& allTriangles) : _allTriangles(allTriangles) {}
-        TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth);
-
-        void insert(size_t triangleIndex);
-        void reset(const AABox& bounds, int depth = 0);
-        void clear();
-
-        bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        const AABox& getBounds() const { return _bounds; }
-
-        void debugDump();
-
-    protected:
-        // checks our internal list of triangles
-        bool findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        std::pair<AABox, AABox> getTriangleTreeCellChildBounds();
-
-        std::vector<Triangle>& _allTriangles;
-        std::pair<std::shared_ptr<TriangleTreeCell>, std::shared_ptr<TriangleTreeCell>> _children;
-        int _depth { 0 };
-        int _population { 0 };
-        AABox _bounds;
-        std::vector<size_t> _triangleIndices;
-
-        friend class TriangleSet;
+    struct Node {
+        glm::vec3 minCorner;
+        uint32_t firstIndex { 0 }; // of the first triangle of a leaf, or of the first of the two children of a branch
+        glm::vec3 maxCorner;
+        uint32_t numTriangles { 0 }; // 0 for a branch
     };
 
-    using SortedTriangleCell = std::pair<float, std::shared_ptr<TriangleTreeCell>>;
-
 public:
-    TriangleSet() : _triangleTree(_triangles) {}
+    TriangleSet() {}
 
     void debugDump();
 
@@ -87,8 +53,10 @@ public:
     const AABox& getBounds() const { return _bounds; }
 
 protected:
+    void buildNode(uint32_t nodeIndex, uint32_t firstIndex, uint32_t numTriangles, int depth, std::vector<glm::vec3>& centroids);
+
     bool _isBalanced { false };
     std::vector<Triangle> _triangles;
-    TriangleTreeCell _triangleTree;
+    std::vector<Node> _nodes;
     AABox _bounds;
 };
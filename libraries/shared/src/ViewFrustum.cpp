@@ -21,6 +21,7 @@
 
 #include <QtCore/QDebug>
 
+#include "CullingBatch.h"
 #include "GeometryUtil.h"
 #include "GLMHelpers.h"
 #include "NumericalConstants.h"
@@ -157,6 +158,32 @@ ViewFrustum::intersection ViewFrustum::calculateCubeFrustumIntersection(const AA
     return result;
 }
 
+void ViewFrustum::getPlaneCoefficients(glm::vec4 planes[NUM_FRUSTUM_PLANES]) const {
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+        planes[i] = glm::vec4(_planes[i].getNormal(), _planes[i].getDCoefficient());
+    }
+}
+
+void ViewFrustum::calculateBoxesFrustumIntersection(const CullingBoxBatch& boxes, uint8_t& outsideMask,
+                                                    uint8_t& intersectMask) const {
+    glm::vec4 planes[NUM_FRUSTUM_PLANES];
+    getPlaneCoefficients(planes);
+    cullingClassifyBoxes(boxes, planes, NUM_FRUSTUM_PLANES, outsideMask, intersectMask);
+}
+
+uint8_t ViewFrustum::boxesIntersectFrustum(const CullingBoxBatch& boxes) const {
+    uint8_t outsideMask;
+    uint8_t intersectMask;
+    calculateBoxesFrustumIntersection(boxes, outsideMask, intersectMask);
+    return (uint8_t)(~outsideMask & ((1 << boxes.count) - 1));
+}
+
+uint8_t ViewFrustum::spheresIntersectFrustum(const CullingSphereBatch& spheres) const {
+    glm::vec4 planes[NUM_FRUSTUM_PLANES];
+    getPlaneCoefficients(planes);
+    return cullingSpheresInsidePlanes(spheres, planes, NUM_FRUSTUM_PLANES);
+}
+
 const float HALF_SQRT_THREE = 0.8660254f;
 
 ViewFrustum::intersection ViewFrustum::calculateCubeKeyholeIntersection(const AACube& cube) const {
@@ -33,6 +33,9 @@ const float DEFAULT_ASPECT_RATIO = 16.0f/9.0f;
 const float DEFAULT_NEAR_CLIP = 0.08f;
 const float DEFAULT_FAR_CLIP = 16384.0f;
 
+class CullingBoxBatch;
+class CullingSphereBatch;
+
 class ViewFrustum {
 public:
     // setters for camera attributes
@@ -107,6 +110,11 @@ public:
     bool boxIntersectsFrustum(const AABox& box) const;
     bool boxInsideFrustum(const AABox& box) const;
 
+    // the same tests on batches of shapes, with a bit per shape in the results
+    void calculateBoxesFrustumIntersection(const CullingBoxBatch& boxes, uint8_t& outsideMask, uint8_t& intersectMask) const;
+    uint8_t boxesIntersectFrustum(const CullingBoxBatch& boxes) const;
+    uint8_t spheresIntersectFrustum(const CullingSphereBatch& spheres) const;
+
     bool sphereIntersectsKeyhole(const glm::vec3& center, float radius) const;
     bool cubeIntersectsKeyhole(const AACube& cube) const;
     bool boxIntersectsKeyhole(const AABox& box) const;
@@ -176,6 +184,7 @@ private:
     float _farClip { DEFAULT_FAR_CLIP };
 
     const char* debugPlaneName (int plane) const;
+    void getPlaneCoefficients(glm::vec4 planes[NUM_FRUSTUM_PLANES]) const;
 
     // Used to project points
     glm::mat4 _ourModelViewProjectionMatrix;
@@ -0,0 +1,291 @@
+//
+//  WorkStealingScheduler.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-10.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingScheduler.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <chrono>
+
+#include <QtCore/QProcessEnvironment>
+
+#if defined(Q_OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "ThreadHelpers.h"
+
+using Clock = std::chrono::steady_clock;
+
+// how long a worker keeps checking for the next run before it parks
+static const std::chrono::microseconds WORKER_SPIN_TIME { 50 };
+
+static const QString ENABLE_WORKER_PINNING_FLAG = "HIFI_ENABLE_WORKER_PINNING";
+
+// a worker's range is packed into one word so the owner and the thieves can both update it with a single CAS
+static uint64_t packRange(uint32_t begin, uint32_t end) {
+    return ((uint64_t)begin << 32) | end;
+}
+
+static uint32_t rangeBegin(uint64_t range) {
+    return (uint32_t)(range >> 32);
+}
+
+static uint32_t rangeEnd(uint64_t range) {
+    return (uint32_t)range;
+}
+
+static void pinCurrentThread(int worker) {
+#if defined(Q_OS_LINUX)
+    static const bool isPinningEnabled = QProcessEnvironment::systemEnvironment().contains(ENABLE_WORKER_PINNING_FLAG);
+    if (!isPinningEnabled) {
+        return;
+    }
+
+    // pin to the CPUs the process is allowed on, which a container or taskset may have narrowed down
+    cpu_set_t allowedSet;
+    CPU_ZERO(&allowedSet);
+    if (sched_getaffinity(0, sizeof(allowedSet), &allowedSet) != 0) {
+        qWarning("%s: could not read the affinity of the process", __FUNCTION__);
+        return;
+    }
+    int numAllowed = CPU_COUNT(&allowedSet);
+    if (numAllowed <= 0) {
+        return;
+    }
+
+    int target = worker % numAllowed;
+    int cpu = 0;
+    for (; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowedSet) && target-- == 0) {
+            break;
+        }
+    }
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0) {
+        qWarning("%s: could not pin worker %d", __FUNCTION__, worker);
+    }
+#else
+    Q_UNUSED(worker);
+#endif
+}
+
+class WorkStealingScheduler::Worker : public QThread {
+public:
+    Worker(WorkStealingScheduler& scheduler, const QString& name, int index) :
+        scheduler(scheduler), name(name), index(index) {}
+
+    void run() override { scheduler.workerLoop(*this); }
+
+    WorkStealingScheduler& scheduler;
+    QString name;
+    int index;
+
+    std::atomic<uint64_t> range { 0 };
+
+    // written by the worker during a run, read by run() once every worker is done
+    Clock::duration busyTime { 0 };
+    int numSteals { 0 };
+};
+
+WorkStealingScheduler::WorkStealingScheduler(const QString& name, int numWorkers) {
+    assert(numWorkers > 0);
+
+    for (int i = 0; i < numWorkers; ++i) {
+        auto worker = new Worker(*this, name, i);
+        worker->setObjectName(QString("%1 %2").arg(name).arg(i));
+        worker->start();
+        _workers.emplace_back(worker);
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _workerCondition.notify_all();
+
+    for (auto& worker : _workers) {
+        worker->wait();
+    }
+}
+
+QThread* WorkStealingScheduler::getWorkerThread(int worker) const {
+    return _workers[worker].get();
+}
+
+void WorkStealingScheduler::run(int numItems, const Configure& configure, const Job& job) {
+    _configure = configure;
+    _job = job;
+
+    // deal out one contiguous range per worker
+    int numWorkers = (int)_workers.size();
+    int chunkSize = numItems / numWorkers;
+    int numLargerChunks = numItems % numWorkers;
+    uint32_t begin = 0;
+    for (int i = 0; i < numWorkers; ++i) {
+        uint32_t end = begin + chunkSize + (i < numLargerChunks ? 1 : 0);
+        _workers[i]->range.store(packRange(begin, end), std::memory_order_relaxed);
+        _workers[i]->busyTime = Clock::duration { 0 };
+        _workers[i]->numSteals = 0;
+        begin = end;
+    }
+
+    _numRunning = numWorkers;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // run
+        _generation.fetch_add(1, std::memory_order_release);
+        _workerCondition.notify_all();
+
+        // wait
+        _doneCondition.wait(lock, [&] {
+            return _numRunning.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    // the run is only as fast as its busiest worker
+    Clock::duration totalTime { 0 };
+    Clock::duration maxTime { 0 };
+    for (auto& worker : _workers) {
+        totalTime += worker->busyTime;
+        maxTime = std::max(maxTime, worker->busyTime);
+        _stats.numSteals += worker->numSteals;
+    }
+
+    float imbalance = 1.0f;
+    if (totalTime.count() > 0) {
+        imbalance = (float)maxTime.count() * numWorkers / (float)totalTime.count();
+    }
+    ++_stats.numRuns;
+    _sumImbalance += imbalance;
+    _stats.maxImbalance = std::max(_stats.maxImbalance, imbalance);
+
+    _configure = nullptr;
+    _job = nullptr;
+}
+
+WorkStealingScheduler::Stats WorkStealingScheduler::takeStats() {
+    Stats stats = _stats;
+    if (stats.numRuns > 0) {
+        stats.averageImbalance = _sumImbalance / stats.numRuns;
+    }
+
+    _stats = Stats();
+    _sumImbalance = 0.0f;
+    return stats;
+}
+
+void WorkStealingScheduler::workerLoop(Worker& worker) {
+    setThreadName(worker.name.toStdString());
+    pinCurrentThread(worker.index);
+
+    // runs start at generation 1, this worker may only get going after the first one was started
+    uint32_t lastGeneration = 0;
+
+    while (true) {
+        auto hasWork = [&] {
+            return _stop.load(std::memory_order_acquire) ||
+                _generation.load(std::memory_order_acquire) != lastGeneration;
+        };
+
+        // spin briefly, back-to-back runs are common
+        auto spinEnd = Clock::now() + WORKER_SPIN_TIME;
+        while (!hasWork() && Clock::now() < spinEnd) {
+            std::this_thread::yield();
+        }
+
+        if (!hasWork()) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workerCondition.wait(lock, hasWork);
+        }
+
+        if (_stop) {
+            return;
+        }
+        lastGeneration = _generation.load(std::memory_order_acquire);
+
+        auto start = Clock::now();
+
+        if (_configure) {
+            _configure(worker.index);
+        }
+
+        int item;
+        while (takeItem(worker, item) || stealItems(worker, item)) {
+            _job(worker.index, item);
+        }
+
+        worker.busyTime = Clock::now() - start;
+
+        finishRun();
+    }
+}
+
+bool WorkStealingScheduler::takeItem(Worker& worker, int& item) {
+    uint64_t range = worker.range.load(std::memory_order_acquire);
+    while (rangeBegin(range) < rangeEnd(range)) {
+        uint32_t begin = rangeBegin(range);
+        if (worker.range.compare_exchange_weak(range, packRange(begin + 1, rangeEnd(range)))) {
+            item = (int)begin;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingScheduler::stealItems(Worker& thief, int& item) {
+    while (true) {
+        // pick the victim with the most left to do
+        Worker* victim = nullptr;
+        uint64_t victimRange = 0;
+        uint32_t mostRemaining = 0;
+        for (auto& worker : _workers) {
+            uint64_t range = worker->range.load(std::memory_order_acquire);
+            uint32_t remaining = rangeEnd(range) > rangeBegin(range) ? rangeEnd(range) - rangeBegin(range) : 0;
+            if (remaining > mostRemaining) {
+                victim = worker.get();
+                victimRange = range;
+                mostRemaining = remaining;
+            }
+        }
+
+        if (!victim) {
+            return false;
+        }
+
+        // take the back half, rounded up so the last item can be stolen too
+        uint32_t begin = rangeBegin(victimRange);
+        uint32_t end = rangeEnd(victimRange);
+        uint32_t middle = begin + (end - begin) / 2;
+        if (victim->range.compare_exchange_strong(victimRange, packRange(begin, middle))) {
+            // our own range is empty, so nobody else is touching it
+            thief.range.store(packRange(middle + 1, end), std::memory_order_release);
+            ++thief.numSteals;
+            item = (int)middle;
+            return true;
+        }
+    }
+}
+
+void WorkStealingScheduler::finishRun() {
+    if (_numRunning.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _doneCondition.notify_one();
+    }
+}
@@ -0,0 +1,88 @@
+//
+//  WorkStealingScheduler.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-10.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_WorkStealingScheduler_h
+#define hifi_WorkStealingScheduler_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QString>
+#include <QtCore/QThread>
+
+// Runs a batch of indexed jobs across a fixed set of worker threads and returns once all of them are done.
+//
+// Every run splits the items into one contiguous range per worker. A worker takes items from the front of its own range
+// and, once that is empty, steals the back half of the largest range left, so one expensive item cannot leave the other
+// workers idle at the end of the run. Between runs the workers spin for a short while before parking, which keeps the
+// wakeup cheap for callers that run once per frame.
+//
+// On Linux, setting HIFI_ENABLE_WORKER_PINNING pins each worker to one of the CPUs the process is allowed on.
+//
+//   WorkStealingScheduler is not thread-safe! run() should only be called from a single thread.
+class WorkStealingScheduler {
+public:
+    // called on a worker before it takes its first item of a run
+    using Configure = std::function<void(int worker)>;
+    // called on a worker for every item it takes
+    using Job = std::function<void(int worker, int item)>;
+
+    struct Stats {
+        int numRuns { 0 };
+        int numSteals { 0 };
+        float averageImbalance { 0.0f }; // busiest worker time over average worker time, 1.0 is perfectly balanced
+        float maxImbalance { 0.0f };
+    };
+
+    WorkStealingScheduler(const QString& name, int numWorkers);
+    ~WorkStealingScheduler();
+
+    void run(int numItems, const Configure& configure, const Job& job);
+
+    int numWorkers() const { return (int)_workers.size(); }
+    QThread* getWorkerThread(int worker) const;
+
+    // stats accumulated since the last call
+    Stats takeStats();
+
+private:
+    class Worker;
+
+    void workerLoop(Worker& worker);
+    bool takeItem(Worker& worker, int& item);
+    bool stealItems(Worker& thief, int& item);
+    void finishRun();
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    // run state, written by run() before _generation is bumped
+    Configure _configure;
+    Job _job;
+
+    std::atomic<uint32_t> _generation { 0 };
+    std::atomic<int> _numRunning { 0 };
+    std::atomic<bool> _stop { false };
+
+    std::mutex _mutex;
+    std::condition_variable _workerCondition;
+    std::condition_variable _doneCondition;
+
+    Stats _stats;
+    float _sumImbalance { 0.0f };
+};
+
+#endif // hifi_WorkStealingScheduler_h
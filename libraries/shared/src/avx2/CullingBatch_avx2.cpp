@@ -0,0 +1,109 @@
+//
+//  CullingBatch_avx2.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <algorithm>
+#include <immintrin.h>
+
+#include "../CullingBatch.h"
+
+static const float AVOID_DIVIDE_BY_ZERO = 0.001f;
+
+static inline uint8_t laneMask(__m256 condition, int count) {
+    return (uint8_t)(_mm256_movemask_ps(condition) & ((1 << count) - 1));
+}
+
+void cullingClassifyBoxes_AVX2(const CullingBoxBatch& boxes, const glm::vec4* planes, int numPlanes,
+                               uint8_t& outsideMask, uint8_t& intersectMask) {
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 x = _mm256_load_ps(boxes.x);
+    __m256 y = _mm256_load_ps(boxes.y);
+    __m256 z = _mm256_load_ps(boxes.z);
+    __m256 scaleX = _mm256_load_ps(boxes.scaleX);
+    __m256 scaleY = _mm256_load_ps(boxes.scaleY);
+    __m256 scaleZ = _mm256_load_ps(boxes.scaleZ);
+
+    __m256 outside = zero;
+    __m256 straddles = zero;
+    for (int p = 0; p < numPlanes; ++p) {
+        const glm::vec4& plane = planes[p];
+        __m256 base = _mm256_set1_ps(plane.w);
+        base = _mm256_fmadd_ps(_mm256_set1_ps(plane.x), x, base);
+        base = _mm256_fmadd_ps(_mm256_set1_ps(plane.y), y, base);
+        base = _mm256_fmadd_ps(_mm256_set1_ps(plane.z), z, base);
+
+        // the farthest and nearest corners along the normal
+        __m256 farthest = _mm256_fmadd_ps(_mm256_set1_ps(std::max(plane.x, 0.0f)), scaleX, base);
+        farthest = _mm256_fmadd_ps(_mm256_set1_ps(std::max(plane.y, 0.0f)), scaleY, farthest);
+        farthest = _mm256_fmadd_ps(_mm256_set1_ps(std::max(plane.z, 0.0f)), scaleZ, farthest);
+        __m256 nearest = _mm256_fmadd_ps(_mm256_set1_ps(std::min(plane.x, 0.0f)), scaleX, base);
+        nearest = _mm256_fmadd_ps(_mm256_set1_ps(std::min(plane.y, 0.0f)), scaleY, nearest);
+        nearest = _mm256_fmadd_ps(_mm256_set1_ps(std::min(plane.z, 0.0f)), scaleZ, nearest);
+
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(farthest, zero, _CMP_LT_OQ));
+        straddles = _mm256_or_ps(straddles, _mm256_cmp_ps(nearest, zero, _CMP_LT_OQ));
+    }
+
+    outsideMask = laneMask(outside, boxes.count);
+    intersectMask = laneMask(straddles, boxes.count) & ~outsideMask;
+}
+
+uint8_t cullingSpheresInsidePlanes_AVX2(const CullingSphereBatch& spheres, const glm::vec4* planes, int numPlanes) {
+    __m256 x = _mm256_load_ps(spheres.x);
+    __m256 y = _mm256_load_ps(spheres.y);
+    __m256 z = _mm256_load_ps(spheres.z);
+    __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_load_ps(spheres.radius));
+
+    __m256 outside = _mm256_setzero_ps();
+    for (int p = 0; p < numPlanes; ++p) {
+        const glm::vec4& plane = planes[p];
+        __m256 distance = _mm256_set1_ps(plane.w);
+        distance = _mm256_fmadd_ps(_mm256_set1_ps(plane.x), x, distance);
+        distance = _mm256_fmadd_ps(_mm256_set1_ps(plane.y), y, distance);
+        distance = _mm256_fmadd_ps(_mm256_set1_ps(plane.z), z, distance);
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, negativeRadius, _CMP_LT_OQ));
+    }
+
+    return (uint8_t)(~laneMask(outside, CULLING_BATCH_SIZE) & ((1 << spheres.count) - 1));
+}
+
+uint8_t cullingSpheresIntersectCone_AVX2(const CullingSphereBatch& spheres, const CullingCone& cone, float minAngularSize) {
+    __m256 x = _mm256_sub_ps(_mm256_load_ps(spheres.x), _mm256_set1_ps(cone.position.x));
+    __m256 y = _mm256_sub_ps(_mm256_load_ps(spheres.y), _mm256_set1_ps(cone.position.y));
+    __m256 z = _mm256_sub_ps(_mm256_load_ps(spheres.z), _mm256_set1_ps(cone.position.z));
+    __m256 radius = _mm256_load_ps(spheres.radius);
+
+    __m256 distanceSquared = _mm256_mul_ps(x, x);
+    distanceSquared = _mm256_fmadd_ps(y, y, distanceSquared);
+    distanceSquared = _mm256_fmadd_ps(z, z, distanceSquared);
+    __m256 distance = _mm256_sqrt_ps(distanceSquared);
+
+    // radius / (distance + AVOID_DIVIDE_BY_ZERO) > minAngularSize, without the division
+    __m256 isBigEnough = _mm256_cmp_ps(radius,
+        _mm256_mul_ps(_mm256_add_ps(distance, _mm256_set1_ps(AVOID_DIVIDE_BY_ZERO)), _mm256_set1_ps(minAngularSize)),
+        _CMP_GT_OQ);
+
+    __m256 isInKeyhole = _mm256_cmp_ps(distance, _mm256_add_ps(_mm256_set1_ps(cone.radius), radius), _CMP_LT_OQ);
+    __m256 isBeforeFarClip = _mm256_cmp_ps(distance, _mm256_add_ps(_mm256_set1_ps(cone.farClip), radius), _CMP_LE_OQ);
+
+    // see ConicalViewFrustum::intersects, the spheres around the apex are in the keyhole already
+    __m256 dot = _mm256_mul_ps(x, _mm256_set1_ps(cone.direction.x));
+    dot = _mm256_fmadd_ps(y, _mm256_set1_ps(cone.direction.y), dot);
+    dot = _mm256_fmadd_ps(z, _mm256_set1_ps(cone.direction.z), dot);
+    __m256 tangent = _mm256_sqrt_ps(_mm256_max_ps(_mm256_fnmadd_ps(radius, radius, distanceSquared), _mm256_setzero_ps()));
+    __m256 threshold = _mm256_fnmadd_ps(radius, _mm256_set1_ps(cone.sinAngle), _mm256_mul_ps(tangent, _mm256_set1_ps(cone.cosAngle)));
+    __m256 isInCone = _mm256_and_ps(isBeforeFarClip, _mm256_cmp_ps(dot, threshold, _CMP_GT_OQ));
+
+    return laneMask(_mm256_and_ps(isBigEnough, _mm256_or_ps(isInKeyhole, isInCone)), spheres.count);
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include "ConicalViewFrustum.h"
 
 
+#include "../CullingBatch.h"
 #include "../NumericalConstants.h"
 #include "../ViewFrustum.h"
 #include <glm/gtc/type_ptr.hpp>
@@ -108,6 +109,11 @@ bool ConicalViewFrustum::intersects(const glm::vec3& relativePosition, float dis
            sqrtf(distance * distance - radius * radius) * _cosAngle - radius * _sinAngle;
 }
 
+uint8_t ConicalViewFrustum::intersects(const CullingSphereBatch& spheres, float minAngularSize) const {
+    CullingCone cone { _position, _direction, _radius, _farClip, _cosAngle, _sinAngle };
+    return cullingSpheresIntersectCone(spheres, cone, minAngularSize);
+}
+
 float ConicalViewFrustum::getAngularSize(float distance, float radius) const {
     const float AVOID_DIVIDE_BY_ZERO = 0.001f;
     float angularSize = radius / (distance + AVOID_DIVIDE_BY_ZERO);
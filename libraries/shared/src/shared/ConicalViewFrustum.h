@@ -12,12 +12,14 @@
 #ifndef hifi_ConicalViewFrustum_h
 #define hifi_ConicalViewFrustum_h
 
+#include <stdint.h>
 #include <vector>
 
 #include <glm/glm.hpp>
 
 class AACube;
 class AABox;
+class CullingSphereBatch;
 class ViewFrustum;
 using ViewFrustums = std::vector<ViewFrustum>;
 
@@ -49,6 +51,8 @@ public:
     float getAngularSize(const AABox& box) const;
 
     bool intersects(const glm::vec3& relativePosition, float distance, float radius) const;
+    // the bounding spheres in view and larger than minAngularSize, a bit per sphere
+    uint8_t intersects(const CullingSphereBatch& spheres, float minAngularSize = 0.0f) const;
     float getAngularSize(float distance, float radius) const;
 
     int serialize(unsigned char* destinationBuffer) const;
@@ -16,10 +16,12 @@
 #include <queue>
 #include <cassert>
 
+#include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QSaveFile>
 #include <QtCore/QStorageInfo>
+#include <QtCore/QThreadPool>
 
 #include "../PathUtils.h"
 #include "../NumericalConstants.h"
@@ -40,6 +42,11 @@ using namespace cache;
 static const char DIR_SEP = '/';
 static const char EXT_SEP = '.';
 
+// the index has no extension, so that it is never taken for a cached file
+static const char* INDEX_FILENAME = "index";
+static const quint32 INDEX_MAGIC = 0x78646e69; // "indx"
+static const quint32 INDEX_VERSION = 1;
+
 const size_t FileCache::DEFAULT_MAX_SIZE { GB_TO_BYTES(5) };
 const size_t FileCache::MAX_MAX_SIZE { GB_TO_BYTES(100) };
 const size_t FileCache::DEFAULT_MIN_FREE_STORAGE_SPACE { GB_TO_BYTES(1) };
@@ -96,20 +103,20 @@ void FileCache::initialize() {
     QDir dir(_dirpath.c_str());
 
     if (dir.exists()) {
-        auto nameFilters = QStringList(("*." + _ext).c_str());
-        auto filters = QDir::Filters(QDir::NoDotAndDotDot | QDir::Files);
-        auto sort = QDir::SortFlags(QDir::Time);
-        auto files = dir.entryList(nameFilters, filters, sort);
-
-        // load persisted files
-        foreach(QString filename, files) {
-            const Key key = filename.section('.', 0, 0).toStdString();
-            const std::string filepath = dir.filePath(filename).toStdString();
-            const size_t length = QFileInfo(filepath.c_str()).size();
-            addFile(Metadata(key, length), filepath);
+        // load the persisted files from the index, without touching the files themselves, and look for the files that
+        // it doesn't know of in the background, a large cache would otherwise hold up the startup
+        if (loadIndex()) {
+            qCDebug(file_cache, "[%s] Initialized %s with the %d files of its index", _dirname.c_str(), _dirpath.c_str(),
+                (int)_files.size());
+        } else {
+            qCDebug(file_cache, "[%s] Initialized %s without an index", _dirname.c_str(), _dirpath.c_str());
         }
 
-        qCDebug(file_cache, "[%s] Initialized %s", _dirname.c_str(), _dirpath.c_str());
+        _isScanning = true;
+        FileCacheWeakPointer weakCache = shared_from_this();
+        QThreadPool::globalInstance()->start([weakCache] {
+            scan(weakCache);
+        });
     } else {
         dir.mkpath(_dirpath.c_str());
         qCDebug(file_cache, "[%s] Created %s", _dirname.c_str(), _dirpath.c_str());
@@ -118,11 +125,161 @@ void FileCache::initialize() {
     _initialized = true;
 }
 
+std::string FileCache::getIndexFilepath() const {
+    return _dirpath + DIR_SEP + INDEX_FILENAME;
+}
+
+bool FileCache::loadIndex() {
+    QFile indexFile(getIndexFilepath().c_str());
+    if (!indexFile.open(QIODevice::ReadOnly) || indexFile.size() == 0) {
+        return false;
+    }
+
+    uchar* mapped = indexFile.map(0, indexFile.size());
+    if (!mapped) {
+        return false;
+    }
+
+    QDataStream stream(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), (int)indexFile.size()));
+    quint32 magic { 0 };
+    quint32 version { 0 };
+    quint32 count { 0 };
+    stream >> magic >> version >> count;
+
+    bool isValid = stream.status() == QDataStream::Ok && magic == INDEX_MAGIC && version == INDEX_VERSION;
+    for (quint32 i = 0; isValid && i < count; ++i) {
+        QByteArray key;
+        quint64 length { 0 };
+        qint64 modified { 0 };
+        quint32 uses { 0 };
+        stream >> key >> length >> modified >> uses;
+        if (stream.status() != QDataStream::Ok) {
+            break;
+        }
+
+        // a file that is no longer there is ejected by the scan, or when it is looked up
+        if (!key.isEmpty() && length > 0 && _files.find(key.toStdString()) == _files.end()) {
+            const Key fileKey = key.toStdString();
+            auto file = addFile(Metadata(fileKey, length), getFilepath(fileKey), modified, uses);
+
+            // added as unused directly, rather than by releasing it, to only clean once it is all loaded
+            file->_locked = false;
+            _unusedFiles.insert(file);
+            _numUnusedFiles += 1;
+            _unusedFilesSize += file->getLength();
+        }
+    }
+
+    indexFile.unmap(mapped);
+    clean();
+    return isValid;
+}
+
+void FileCache::saveIndex() {
+    QByteArray index;
+    {
+        QDataStream stream(&index, QIODevice::WriteOnly);
+        std::vector<FilePointer> files;
+        files.reserve(_files.size());
+        for (const auto& entry : _files) {
+            auto file = entry.second.lock();
+            if (file) {
+                files.push_back(file);
+            }
+        }
+
+        stream << INDEX_MAGIC << INDEX_VERSION << (quint32)files.size();
+        for (const auto& file : files) {
+            stream << QByteArray::fromStdString(file->getKey()) << (quint64)file->getLength() << (qint64)file->_modified
+                << (quint32)file->_uses;
+        }
+    }
+
+    QSaveFile saveFile(getIndexFilepath().c_str());
+    if (!(saveFile.open(QIODevice::WriteOnly) && saveFile.write(index) == index.size() && saveFile.commit())) {
+        qCWarning(file_cache, "[%s] Failed to write the index", _dirname.c_str());
+    }
+}
+
+void FileCache::scan(FileCacheWeakPointer weakCache) {
+    QString dirpath;
+    QString nameFilter;
+    KeySet indexedKeys;
+    {
+        auto cache = weakCache.lock();
+        if (!cache) {
+            return;
+        }
+
+        Lock lock(cache->_mutex);
+        dirpath = cache->_dirpath.c_str();
+        nameFilter = ("*." + cache->_ext).c_str();
+        for (const auto& entry : cache->_files) {
+            indexedKeys.insert(entry.first);
+        }
+    }
+
+    // the files written from here on are in the cache already
+    auto filenames = QDir(dirpath).entryList(QStringList(nameFilter), QDir::NoDotAndDotDot | QDir::Files);
+
+    int numFound = 0;
+    for (const auto& filename : filenames) {
+        auto cache = weakCache.lock();
+        if (!cache) {
+            return;
+        }
+
+        Lock lock(cache->_mutex);
+        const Key key = filename.section('.', 0, 0).toStdString();
+        indexedKeys.erase(key);
+        if (cache->_files.find(key) != cache->_files.end()) {
+            continue;
+        }
+
+        QFileInfo info(QDir(dirpath).filePath(filename));
+        if (!info.exists()) {
+            continue;
+        }
+
+        if (cache->_isWiped) {
+            QFile::remove(info.filePath());
+        } else if (info.size() > 0) {
+            cache->addFile(Metadata(key, info.size()), info.filePath().toStdString(), info.lastRead().toMSecsSinceEpoch(), 1);
+            ++numFound;
+        }
+    }
+
+    auto cache = weakCache.lock();
+    if (!cache) {
+        return;
+    }
+
+    Lock lock(cache->_mutex);
+
+    // what is left of the index is gone from the folder
+    for (const auto& key : indexedKeys) {
+        auto it = cache->_files.find(key);
+        if (it != cache->_files.end()) {
+            auto file = it->second.lock();
+            if (file && !file->_locked) {
+                cache->eject(file);
+            }
+        }
+    }
+
+    cache->_isScanning = false;
+    cache->_isWiped = false;
+    cache->saveIndex();
+    qCDebug(file_cache, "[%s] Found %d files that weren't in the index, %d files missing from it",
+        cache->_dirname.c_str(), numFound, (int)indexedKeys.size());
+    emit cache->dirty();
+}
+
 std::unique_ptr<File> FileCache::createFile(Metadata&& metadata, const std::string& filepath) {
     return std::unique_ptr<File>(new cache::File(std::move(metadata), filepath));
 }
 
-FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath) {
+FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath, int64_t modified, uint32_t uses) {
     File* rawFile = createFile(std::move(metadata), filepath).release();
     FilePointer file(rawFile, std::bind(&File::deleter, rawFile));
     if (file) {
@@ -130,6 +287,8 @@ FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath)
         _totalFilesSize += file->getLength();
         file->_parent = shared_from_this();
         file->_locked = true;
+        file->_modified = modified;
+        file->_uses = uses;
         emit dirty();
 
         _files[file->getKey()] = file;
@@ -138,6 +297,13 @@ FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath)
 }
 
 FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bool overwrite) {
+    auto length = static_cast<qint64>(metadata.length);
+    return writeFile([data, length](QIODevice& device) {
+        return device.write(data, length) == length;
+    }, std::move(metadata), overwrite);
+}
+
+FilePointer FileCache::writeFile(const Writer& writer, File::Metadata&& metadata, bool overwrite) {
     FilePointer file;
 
     if (0 == metadata.length) {
@@ -169,10 +335,11 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
 
     QSaveFile saveFile(QString::fromStdString(filepath));
     if (saveFile.open(QIODevice::WriteOnly)
-        && saveFile.write(data, metadata.length) == static_cast<qint64>(metadata.length)
+        && writer(saveFile)
+        && saveFile.size() == static_cast<qint64>(metadata.length)
         && saveFile.commit()) {
 
-        file = addFile(std::move(metadata), filepath);
+        file = addFile(std::move(metadata), filepath, QDateTime::currentMSecsSinceEpoch(), 1);
     } else {
         qCWarning(file_cache, "[%s] Failed to write %s", _dirname.c_str(), metadata.key.c_str());
     }
@@ -194,8 +361,12 @@ FilePointer FileCache::getFile(const Key& key) {
     const auto it = _files.find(key);
     if (it != _files.cend()) {
         file = it->second.lock();
-        if (file) {
-            file->touch();
+        if (file && !file->touch()) {
+            // the file was removed from the folder since the index was written
+            qCDebug(file_cache, "[%s] Lost %s", _dirname.c_str(), key.c_str());
+            eject(file);
+            file.reset();
+        } else if (file) {
             // if it exists, it is active - remove it from the cache
             if (_unusedFiles.erase(file)) {
                 assert(!file->_locked);
@@ -211,12 +382,37 @@ FilePointer FileCache::getFile(const Key& key) {
             // if not, remove the weak_ptr
             _files.erase(it);
         }
+    } else if (_isScanning && !_isWiped) {
+        // the scan may not have got to the file yet
+        std::string filepath = getFilepath(key);
+        QFileInfo info(filepath.c_str());
+        if (info.exists() && info.size() > 0) {
+            file = addFile(Metadata(key, info.size()), filepath, info.lastRead().toMSecsSinceEpoch(), 1);
+            file->touch();
+            qCDebug(file_cache, "[%s] Found %s ahead of the scan", _dirname.c_str(), key.c_str());
+        }
     }
 
     assert(!file || (file->_locked && file->_parent.lock()));
     return file;
 }
 
+bool FileCache::removeFile(const Key& key) {
+    Lock lock(_mutex);
+    const auto it = _files.find(key);
+    if (it == _files.cend()) {
+        return false;
+    }
+
+    auto file = it->second.lock();
+    if (file) {
+        eject(file);
+    } else {
+        _files.erase(it);
+    }
+    return (bool)file;
+}
+
 std::string FileCache::getFilepath(const Key& key) {
     return _dirpath + DIR_SEP + key + EXT_SEP + _ext;
 }
@@ -251,8 +447,15 @@ size_t FileCache::getOverbudgetAmount() const {
 }
 
 namespace cache {
+    // the files that were only used once go first, so that a burst of new files doesn't push out those used again and
+    // again, then the least recently used
     struct FilePointerComparator {
         bool operator()(const FilePointer& a, const FilePointer& b) {
+            bool isAReused = a->_uses > 1;
+            bool isBReused = b->_uses > 1;
+            if (isAReused != isBReused) {
+                return isAReused;
+            }
             return a->_modified > b->_modified;
         }
     };
@@ -302,6 +505,11 @@ void FileCache::wipe() {
     while (!_unusedFiles.empty()) {
         eject(*_unusedFiles.begin());
     }
+
+    if (_initialized) {
+        _isWiped = _isScanning;
+        saveIndex();
+    }
 }
 
 void FileCache::clear() {
@@ -310,6 +518,10 @@ void FileCache::clear() {
     // Eliminate any overbudget files
     clean();
 
+    if (_initialized) {
+        saveIndex();
+    }
+
     // Mark everything remaining as persisted while effectively ejecting from the cache
     for (auto& file : _unusedFiles) {
         file->_shouldPersist = true;
@@ -344,8 +556,7 @@ void File::deleter(File* file) {
 File::File(Metadata&& metadata, const std::string& filepath) :
     _key(std::move(metadata.key)),
     _length(metadata.length),
-    _filepath(filepath),
-    _modified(QFileInfo(_filepath.c_str()).lastRead().toMSecsSinceEpoch()) {
+    _filepath(filepath) {
 }
 
 File::~File() {
@@ -356,8 +567,10 @@ File::~File() {
     }
 }
 
-void File::touch() {
-    utime(_filepath.c_str(), nullptr);
-    _modified = std::max<int64_t>(QFileInfo(_filepath.c_str()).lastRead().toMSecsSinceEpoch(), _modified);
+bool File::touch() {
+    // the time of use is kept in the index, the access time of the file is only used by scans
+    _modified = std::max<int64_t>(QDateTime::currentMSecsSinceEpoch(), _modified);
+    _uses++;
+    return utime(_filepath.c_str(), nullptr) == 0;
 }
 
@@ -13,6 +13,7 @@
 #include <atomic>
 #include <memory>
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <unordered_set>
 #include <mutex>
@@ -22,6 +23,8 @@
 #include <QObject>
 #include <QLoggingCategory>
 
+class QIODevice;
+
 Q_DECLARE_LOGGING_CATEGORY(file_cache)
 
 class FileCacheTests;
@@ -56,6 +59,15 @@ public:
     // Remove all unlocked items from the cache
     void wipe();
 
+    // Remove a file from the cache, it is deleted once it is no longer in use
+    bool removeFile(const Key& key);
+
+    // True while the files that aren't in the index are being looked for, the cache can be used meanwhile
+    bool isScanning() const { return _isScanning; }
+
+    const std::string& getDirpath() const { return _dirpath; }
+    size_t getMaxSize() const { return _maxSize; }
+
     size_t getNumTotalFiles() const { return _numTotalFiles; }
     size_t getNumCachedFiles() const { return _numUnusedFiles; }
     size_t getSizeTotalFiles() const { return _totalFilesSize; }
@@ -93,10 +105,16 @@ signals:
 
 public:
     /// must be called after construction to create the cache on the fs and restore persisted files
+    /// the files are restored from the index of the cache, and the folder is scanned in the background for the others
     virtual void initialize();
 
+    // writes the contents of a file to the device, false if it failed
+    using Writer = std::function<bool(QIODevice& device)>;
+
     // Add file to the cache and return the cache entry.  
     FilePointer writeFile(const char* data, Metadata&& metadata, bool overwrite = false);
+    // Same, with contents of metadata.length written by writer, so that they need not be all in memory
+    FilePointer writeFile(const Writer& writer, Metadata&& metadata, bool overwrite = false);
     FilePointer getFile(const Key& key);
 
     /// create a file
@@ -112,12 +130,17 @@ private:
     friend class File;
 
     std::string getFilepath(const Key& key);
+    std::string getIndexFilepath() const;
 
-    FilePointer addFile(Metadata&& metadata, const std::string& filepath);
+    FilePointer addFile(Metadata&& metadata, const std::string& filepath, int64_t modified, uint32_t uses);
     void addUnusedFile(const FilePointer& file);
     void releaseFile(File* file);
     void clean();
     void clear();
+
+    bool loadIndex();
+    void saveIndex();
+    static void scan(FileCacheWeakPointer weakCache);
     // Remove a file from the cache
     void eject(FilePointer file);
 
@@ -136,6 +159,9 @@ private:
     const std::string _dirname;
     const std::string _dirpath;
     bool _initialized { false };
+    std::atomic<bool> _isScanning { false };
+    // files found by a scan that is still running when the cache is wiped are deleted
+    bool _isWiped { false };
 
     Mutex _mutex;
     Map _files;
@@ -168,9 +194,11 @@ private:
     const size_t _length;
     const std::string _filepath;
 
-    void touch();
+    bool touch();
     FileCacheWeakPointer _parent;
     int64_t _modified { 0 };
+    // files used more than once are ejected after the ones that were only used once
+    uint32_t _uses { 0 };
     bool _locked { false };
 
     bool _shouldPersist { false };
@@ -22,22 +22,6 @@
 #include "../SharedUtil.h"
 #include "../SharedLogging.h"
 
-class FilePersistThread : public GenericQueueThread < QString > {
-    Q_OBJECT
-public:
-    FilePersistThread(const FileLogger& logger);
-signals:
-    void rollingLogFile(QString newFilename);
-
-protected:
-    void rollFileIfNecessary(QFile& file, bool force = false, bool notifyListenersIfRolled = true);
-    virtual bool processQueueItems(const Queue& messages) override;
-
-private:
-    const FileLogger& _logger;
-    QMutex _fileMutex;
-};
-
 static const QString FILENAME_FORMAT = "vircadia-log_%1%2.txt";
 static const QString DATETIME_FORMAT = "yyyy-MM-dd_hh.mm.ss";
 static const QString LOGS_DIRECTORY = "Logs";
@@ -52,8 +36,6 @@ static const qint64 MAX_LOG_SIZE = 512 * 1024;
 // Max log files found in the log directory is 100.
 static const qint64 MAX_LOG_DIR_SIZE = 512 * 1024 * 100;
 
-static FilePersistThread* _persistThreadInstance;
-
 QString getLogRollerFilename() {
     QString result = FileUtils::standardPath(LOGS_DIRECTORY);
     QDateTime now = QDateTime::currentDateTime();
@@ -72,17 +54,7 @@ const QString& getLogFilename() {
     return fileName;
 }
 
-FilePersistThread::FilePersistThread(const FileLogger& logger) : _logger(logger) {
-    setObjectName("LogFileWriter");
-
-    // A file may exist from a previous run - if it does, roll the file and suppress notifying listeners.
-    QFile file(_logger._fileName);
-    if (file.exists()) {
-        rollFileIfNecessary(file, true, false);
-    }
-}
-
-void FilePersistThread::rollFileIfNecessary(QFile& file, bool force, bool notifyListenersIfRolled) {
+void FileLogger::rollFileIfNecessary(QFile& file, bool force, bool notifyListenersIfRolled) {
     if (force || (file.size() > MAX_LOG_SIZE)) {
         QString newFileName = getLogRollerFilename();
         if (file.copy(newFileName)) {
@@ -113,30 +85,38 @@ void FilePersistThread::rollFileIfNecessary(QFile& file, bool force, bool notify
     }
 }
 
-bool FilePersistThread::processQueueItems(const Queue& messages) {
-    QMutexLocker lock(&_fileMutex);
-    QFile file(_logger._fileName);
-    rollFileIfNecessary(file);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-        QTextStream out(&file);
-        for (const QString& message : messages) {
-            out << message;
+void FileLogger::writeLog(const std::vector<QString>& lines) {
+    {
+        std::lock_guard<std::mutex> lock(_fileMutex);
+        QFile file(_fileName);
+        rollFileIfNecessary(file);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+            QTextStream out(&file);
+            for (const QString& line : lines) {
+                out << line;
+            }
         }
     }
-    return true;
+
+    for (const QString& line : lines) {
+        emit logReceived(line);
+    }
 }
 
 FileLogger::FileLogger(QObject* parent) :
     AbstractLoggerInterface(parent),
     _fileName(getLogFilename())
 {
-    _persistThreadInstance = new FilePersistThread(*this);
-    _persistThreadInstance->initialize(true, QThread::LowestPriority);
-    connect(_persistThreadInstance, &FilePersistThread::rollingLogFile, this, &FileLogger::rollingLogFile);
+    // A file may exist from a previous run - if it does, roll the file and suppress notifying listeners.
+    QFile file(_fileName);
+    if (file.exists()) {
+        rollFileIfNecessary(file, true, false);
+    }
 }
 
 FileLogger::~FileLogger() {
-    _persistThreadInstance->terminate();
+    LogHandler::getInstance().flush();
+    LogHandler::getInstance().removeSink(this);
 }
 
 void FileLogger::setSessionID(const QUuid& message) {
@@ -146,8 +126,7 @@ void FileLogger::setSessionID(const QUuid& message) {
     }
 
 void FileLogger::addMessage(const QString& message) {
-    _persistThreadInstance->queueItem(message);
-    emit logReceived(message);
+    writeLog({ message });
 }
 
 void FileLogger::locateLog() {
@@ -164,7 +143,5 @@ QString FileLogger::getLogData() {
 }
 
 void FileLogger::sync() {
-    _persistThreadInstance->process();
+    LogHandler::getInstance().flush();
 }
-
-#include "FileLogger.moc"
\ No newline at end of file
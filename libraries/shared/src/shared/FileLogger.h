@@ -13,11 +13,15 @@
 #define hifi_FileLogger_h
 
 #include "AbstractLoggerInterface.h"
-#include "../GenericQueueThread.h"
+#include "../LogHandler.h"
+
+#include <mutex>
 
 #include <QtCore/QFile>
 
-class FileLogger : public AbstractLoggerInterface {
+/// Writes the log to a file, rolled once it gets too large. Added as a sink of the LogHandler, it is written to by the
+/// writer thread of the LogHandler.
+class FileLogger : public AbstractLoggerInterface, public LogSink {
     Q_OBJECT
 
 public:
@@ -31,12 +35,16 @@ public:
     virtual void locateLog() override;
     virtual void sync() override;
 
+    virtual void writeLog(const std::vector<QString>& lines) override;
+
 signals:
     void rollingLogFile(QString newFilename);
 
 private:
+    void rollFileIfNecessary(QFile& file, bool force = false, bool notifyListenersIfRolled = true);
+
     const QString _fileName;
-    friend class FilePersistThread;
+    std::mutex _fileMutex;
 };
 
 
@@ -256,6 +256,17 @@ signals:
     void dirtyEnabled();
 };
 
+// The config of a task running its jobs in parallel, which it only does once parallel is set
+class ParallelConfig : public JobConfig {
+    Q_OBJECT
+    Q_PROPERTY(bool parallel MEMBER parallel NOTIFY dirtyParallel)
+public:
+    bool parallel { false };
+
+signals:
+    void dirtyParallel();
+};
+
 using QConfigPointer = std::shared_ptr<JobConfig>;
 
 }
@@ -10,6 +10,8 @@
 //
 #include "Task.h"
 
+#include <TBBHelpers.h>
+
 using namespace task;
 
 JobContext::JobContext() {
@@ -18,6 +20,12 @@ JobContext::JobContext() {
 JobContext::~JobContext() {
 }
 
+void task::runConcurrently(size_t count, const std::function<void(size_t)>& run) {
+    tbb::parallel_for((size_t)0, count, [&](size_t index) {
+        run(index);
+    });
+}
+
 void TaskFlow::reset() {
     _doAbortTask = false;
 }
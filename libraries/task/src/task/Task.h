@@ -15,6 +15,7 @@
 #include "Config.h"
 #include "Varying.h"
 
+#include <functional>
 #include <unordered_map>
 
 namespace task {
@@ -60,10 +61,21 @@ public:
     // Task flow control
     TaskFlow taskFlow{};
 
+    // Parallel tasks run each of their jobs on a fork of the context, then join the forks back in the order of the jobs.
+    // beginForkedRun and endForkedRun are called on the thread running the job of a fork.
+    // A context that returns no fork makes the parallel tasks run their jobs serially on it instead.
+    virtual std::shared_ptr<JobContext> fork() { return nullptr; }
+    virtual void beginForkedRun() {}
+    virtual void endForkedRun() {}
+    virtual void join(JobContext& fork) {}
+
 protected:
 };
 using JobContextPointer = std::shared_ptr<JobContext>;
 
+// Calls run(index) for every index below count, concurrently
+void runConcurrently(size_t count, const std::function<void(size_t)>& run);
+
 // The guts of a job
 class JobConcept {
 public:
@@ -345,6 +357,70 @@ public:
     template <class T, class O, class C = Config> using ModelO = TaskModel<T, C, None, O>;
     template <class T, class I, class O, class C = Config> using ModelIO = TaskModel<T, C, I, O>;
 
+    // A parallel task runs each of its jobs on a fork of the context, concurrently when its config is set to, and joins
+    // the forks back in the order the jobs were added.
+    // The jobs of a parallel task must not consume each other's outputs, and aborting from one of them only ends that job.
+    template <class T, class C = ParallelConfig, class I = None, class O = None> class ParallelTaskModel : public TaskModel<T, C, I, O> {
+    public:
+        using Base = TaskModel<T, C, I, O>;
+
+        ParallelTaskModel(const std::string& name, const Varying& input, QConfigPointer config) : Base(name, input, config) {}
+
+        template <class... A>
+        static std::shared_ptr<ParallelTaskModel> create(const std::string& name, const Varying& input, A&&... args) {
+            auto model = std::make_shared<ParallelTaskModel>(name, input, std::make_shared<C>());
+
+            {
+                TimeProfiler probe("build::" + model->getName());
+                model->_data.build(*(model), model->_input, model->_output, std::forward<A>(args)...);
+            }
+
+            return model;
+        }
+
+        template <class... A>
+        static std::shared_ptr<ParallelTaskModel> create(const std::string& name, A&&... args) {
+            const auto input = Varying(I());
+            return create(name, input, std::forward<A>(args)...);
+        }
+
+        void run(const ContextPointer& jobContext) override {
+            auto config = std::static_pointer_cast<C>(Concept::_config);
+            auto& jobs = TaskConcept::_jobs;
+
+            std::vector<ContextPointer> forks;
+            if (config->isEnabled() && config->parallel && jobs.size() > 1) {
+                forks.reserve(jobs.size());
+                for (size_t i = 0; i < jobs.size(); i++) {
+                    auto fork = std::static_pointer_cast<Context>(jobContext->fork());
+                    if (!fork) {
+                        forks.clear();
+                        break;
+                    }
+                    forks.push_back(fork);
+                }
+            }
+            if (forks.empty()) {
+                Base::run(jobContext);
+                return;
+            }
+
+            runConcurrently(jobs.size(), [&](size_t i) {
+                forks[i]->beginForkedRun();
+                jobs[i].run(forks[i]);
+                forks[i]->endForkedRun();
+            });
+
+            for (auto& fork : forks) {
+                jobContext->join(*fork);
+            }
+        }
+    };
+    template <class T, class C = ParallelConfig> using ParallelModel = ParallelTaskModel<T, C, None, None>;
+    template <class T, class I, class C = ParallelConfig> using ParallelModelI = ParallelTaskModel<T, C, I, None>;
+    template <class T, class O, class C = ParallelConfig> using ParallelModelO = ParallelTaskModel<T, C, None, O>;
+    template <class T, class I, class O, class C = ParallelConfig> using ParallelModelIO = ParallelTaskModel<T, C, I, O>;
+
     // Create a new job in the Task's queue; returns the job's output
     template <class T, class... A> const Varying addJob(std::string name, const Varying& input, A&&... args) {
         return std::static_pointer_cast<TaskConcept>(JobType::_concept)->template addJob<T>(name, input, std::forward<A>(args)...);
@@ -533,6 +609,7 @@ protected:
     using JobConfig = task::JobConfig; \
     using TaskConfig = task::JobConfig; \
     using SwitchConfig = task::JobConfig; \
+    using ParallelConfig = task::ParallelConfig; \
     template <class T> using PersistentConfig = task::PersistentConfig<T>; \
     using Job = task::Job<ContextType, TimeProfiler>; \
     using Switch = task::Switch<ContextType, TimeProfiler>; \
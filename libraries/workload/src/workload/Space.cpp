@@ -18,8 +18,46 @@
 
 #include <glm/gtx/quaternion.hpp>
 
+#include <TBBHelpers.h>
+
 using namespace workload;
 
+// proxies are categorized in chunks, in parallel once there are enough of them
+const uint32_t CATEGORIZE_CHUNK_SIZE = 1024;
+const uint32_t MIN_PARALLEL_CATEGORIZE_PROXIES = 8 * CATEGORIZE_CHUNK_SIZE;
+
+void Space::ProxyArrays::resize(size_t size) {
+    xs.resize(size, 0.0f);
+    ys.resize(size, 0.0f);
+    zs.resize(size, 0.0f);
+    radii.resize(size, 0.0f);
+    regions.resize(size, Region::INVALID);
+    prevRegions.resize(size, Region::INVALID);
+}
+
+void Space::ProxyArrays::clear() {
+    xs.clear();
+    ys.clear();
+    zs.clear();
+    radii.clear();
+    regions.clear();
+    prevRegions.clear();
+}
+
+void Space::ProxyArrays::setSphere(size_t i, const Sphere& sphere) {
+    xs[i] = sphere.x;
+    ys[i] = sphere.y;
+    zs[i] = sphere.z;
+    radii[i] = sphere.w;
+}
+
+Proxy Space::ProxyArrays::getProxy(size_t i) const {
+    Proxy proxy(getSphere(i));
+    proxy.region = regions[i];
+    proxy.prevRegion = prevRegions[i];
+    return proxy;
+}
+
 Space::Space() : Collection() {
 }
 
@@ -49,11 +87,9 @@ void Space::processResets(const Transaction::Resets& transactions) {
         if (!_IDAllocator.checkIndex(proxyID)) {
             continue;
         }
-        auto& item = _proxies[proxyID];
-
         // Reset the item with a new payload
-        item.sphere = (std::get<1>(reset));
-        item.prevRegion = item.region = Region::UNKNOWN;
+        _proxies.setSphere(proxyID, std::get<1>(reset));
+        _proxies.prevRegions[proxyID] = _proxies.regions[proxyID] = Region::UNKNOWN;
 
         _owners[proxyID] = (std::get<2>(reset));
     }
@@ -66,11 +102,8 @@ void Space::processRemoves(const Transaction::Removes& transactions) {
         }
         _IDAllocator.freeIndex(removedID);
 
-        // Access the true item
-        auto& item = _proxies[removedID];
-
         // Kill it
-        item.prevRegion = item.region = Region::INVALID;
+        _proxies.prevRegions[removedID] = _proxies.regions[removedID] = Region::INVALID;
         _owners[removedID] = Owner();
     }
 }
@@ -82,48 +115,88 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
             continue;
         }
 
-        // Access the true item
-        auto& item = _proxies[updateID];
-
         // Update the item
-        item.sphere = (std::get<1>(update));
+        _proxies.setSphere(updateID, std::get<1>(update));
     }
 }
 
 void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     uint32_t numProxies = (uint32_t)_proxies.size();
-    uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        Proxy& proxy = _proxies[i];
-        if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::R4;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
+    if (numProxies < MIN_PARALLEL_CATEGORIZE_PROXIES) {
+        categorizeRange(0, numProxies, changes);
+        return;
+    }
+
+    // each chunk collects its own changes, which are appended in order to keep the result the same as the serial one
+    uint32_t numChunks = (numProxies + CATEGORIZE_CHUNK_SIZE - 1) / CATEGORIZE_CHUNK_SIZE;
+    std::vector<std::vector<Space::Change>> chunkChanges(numChunks);
+    tbb::parallel_for(tbb::blocked_range<uint32_t>(0, numChunks), [&](const tbb::blocked_range<uint32_t>& range) {
+        for (uint32_t chunk = range.begin(); chunk != range.end(); ++chunk) {
+            uint32_t begin = chunk * CATEGORIZE_CHUNK_SIZE;
+            uint32_t end = std::min(begin + CATEGORIZE_CHUNK_SIZE, numProxies);
+            categorizeRange(begin, end, chunkChanges[chunk]);
+        }
+    });
+
+    size_t numChanges = changes.size();
+    for (const auto& chunk : chunkChanges) {
+        numChanges += chunk.size();
+    }
+    changes.reserve(numChanges);
+    for (const auto& chunk : chunkChanges) {
+        changes.insert(changes.end(), chunk.begin(), chunk.end());
+    }
+}
+
+void Space::categorizeRange(uint32_t begin, uint32_t end, std::vector<Space::Change>& changes) {
+    const float* xs = _proxies.xs.data();
+    const float* ys = _proxies.ys.data();
+    const float* zs = _proxies.zs.data();
+    const float* radii = _proxies.radii.data();
+
+    while (begin < end) {
+        uint32_t numProxies = std::min(end - begin, CATEGORIZE_CHUNK_SIZE);
+
+        // A proxy is in the nearest region that it touches for any view.  The tests are done for every proxy
+        // of the chunk without branching, so that they vectorize.
+        uint8_t newRegions[CATEGORIZE_CHUNK_SIZE];
+        std::fill(newRegions, newRegions + numProxies, (uint8_t)Region::R4);
+        for (const auto& view : _views) {
+            for (uint8_t k = 0; k < Region::NUM_TRACKED_REGIONS; ++k) {
+                const Sphere& regionSphere = view.regions[k];
+                for (uint32_t i = 0; i < numProxies; ++i) {
+                    uint32_t j = begin + i;
+                    float dx = xs[j] - regionSphere.x;
+                    float dy = ys[j] - regionSphere.y;
+                    float dz = zs[j] - regionSphere.z;
+                    float touchDistance = radii[j] + regionSphere.w;
+                    bool touches = dx * dx + dy * dy + dz * dz < touchDistance * touchDistance;
+                    newRegions[i] = (touches && k < newRegions[i]) ? k : newRegions[i];
                 }
             }
-            proxy.prevRegion = proxy.region;
-            proxy.region = region;
-            if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+        }
+
+        for (uint32_t i = 0; i < numProxies; ++i) {
+            uint32_t j = begin + i;
+            if (_proxies.regions[j] < Region::INVALID) {
+                _proxies.prevRegions[j] = _proxies.regions[j];
+                _proxies.regions[j] = newRegions[i];
+                if (_proxies.regions[j] != _proxies.prevRegions[j]) {
+                    changes.emplace_back(Space::Change((int32_t)j, _proxies.regions[j], _proxies.prevRegions[j]));
+                }
             }
         }
+        begin += numProxies;
     }
 }
 
 uint32_t Space::copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     auto numCopied = std::min(numDestProxies, (uint32_t)_proxies.size());
-    memcpy(proxies, _proxies.data(), numCopied * sizeof(Proxy));
+    for (uint32_t i = 0; i < numCopied; ++i) {
+        proxies[i] = _proxies.getProxy(i);
+    }
     return numCopied;
 }
 
@@ -132,7 +205,7 @@ uint32_t Space::copySelectedProxyValues(Proxy::Vector& proxies, const workload::
     uint32_t numCopied = 0;
     for (auto index : indices) {
         if (isAllocatedID(index) && (index < (Index)_proxies.size())) {
-            proxies.push_back(_proxies[index]);
+            proxies.push_back(_proxies.getProxy(index));
             ++numCopied;
         }
     }
@@ -150,7 +223,7 @@ const Owner Space::getOwner(int32_t proxyID) const {
 uint8_t Space::getRegion(int32_t proxyID) const {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     if (isAllocatedID(proxyID) && (proxyID < (Index)_proxies.size())) {
-        return _proxies[proxyID].region;
+        return _proxies.regions[proxyID];
     }
     return (uint8_t)Region::INVALID;
 }
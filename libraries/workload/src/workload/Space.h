@@ -54,15 +54,35 @@ public:
 
     void clear() override;
 private:
+    // The proxies are stored as a structure of arrays, so that categorizing streams through each component
+    // in loops the compiler can vectorize.
+    struct ProxyArrays {
+        size_t size() const { return radii.size(); }
+        void resize(size_t size);
+        void clear();
+
+        Sphere getSphere(size_t i) const { return Sphere(xs[i], ys[i], zs[i], radii[i]); }
+        void setSphere(size_t i, const Sphere& sphere);
+        Proxy getProxy(size_t i) const;
+
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<float> zs;
+        std::vector<float> radii;
+        std::vector<uint8_t> regions;
+        std::vector<uint8_t> prevRegions;
+    };
 
     void processTransactionFrame(const Transaction& transaction) override;
     void processResets(const Transaction::Resets& transactions);
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
 
+    void categorizeRange(uint32_t begin, uint32_t end, std::vector<Change>& changes);
+
     // The database of proxies is protected for editing by a mutex
     mutable std::mutex _proxiesMutex;
-    Proxy::Vector _proxies;
+    ProxyArrays _proxies;
     std::vector<Owner> _owners;
 
     Views _views;
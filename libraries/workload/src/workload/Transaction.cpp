@@ -148,7 +148,7 @@ uint32_t Collection::enqueueFrame() {
     consolidatedTransaction.merge(std::move(localTransactionQueue));
     {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        _transactionFrames.push_back(consolidatedTransaction);
+        _transactionFrames.push_back(std::move(consolidatedTransaction));
     }
 
     return ++_transactionFrameNumber;
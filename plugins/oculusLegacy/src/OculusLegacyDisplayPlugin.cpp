@@ -59,6 +59,13 @@ bool OculusLegacyDisplayPlugin::beginFrameRender(uint32_t frameIndex) {
     return Parent::beginFrameRender(frameIndex);
 }
 
+void OculusLegacyDisplayPlugin::updatePresentPose() {
+    // this SDK doesn't reproject, the latest pose is the one the frame is corrected or reprojected to
+    _currentPresentFrameInfo.sensorSampleTime = ovr_GetTimeInSeconds();
+    auto trackingState = ovrHmd_GetTrackingState(_hmd, _currentPresentFrameInfo.sensorSampleTime);
+    _currentPresentFrameInfo.presentPose = toGlm(trackingState.HeadPose.ThePose);
+}
+
 bool OculusLegacyDisplayPlugin::isSupported() const {
     if (!ovr_Initialize(nullptr)) {
         return false;
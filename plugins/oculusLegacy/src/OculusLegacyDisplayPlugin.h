@@ -41,6 +41,7 @@ protected:
     void uncustomizeContext() override;
     void hmdPresent() override;
     bool isHmdMounted() const override { return true; }
+    void updatePresentPose() override;
 
 private:
     static const char* NAME;
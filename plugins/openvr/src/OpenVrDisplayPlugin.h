@@ -82,6 +82,8 @@ protected:
     bool internalActivate() override;
     void internalDeactivate() override;
     void updatePresentPose() override;
+    // the compositor warps the submitted frames to the latest pose itself
+    bool reprojectsRepeatedFrames() const override { return false; }
 
     void compositeLayers() override;
     void hmdPresent() override;
@@ -24,10 +24,10 @@ public:
 
 
     int getComplexity() const;
-    void setComplexity(int complexity);
+    virtual void setComplexity(int complexity) override;
 
     int getBitrate() const;
-    void setBitrate(int bitrate);
+    virtual void setBitrate(int bitrate) override;
 
     int getVBR() const;
     void setVBR(int vbr);
@@ -53,7 +53,7 @@ public:
     void setInbandFEC(int inBandFEC);
 
     int getExpectedPacketLossPercentage() const;
-    void setExpectedPacketLossPercentage(int percentage);
+    virtual void setExpectedPacketLossPercentage(int percentage) override;
 
     int getDTX() const;
     void setDTX(int dtx);
@@ -10,6 +10,7 @@
 #include "AnimTests.h"
 #include <AnimNodeLoader.h>
 #include <AnimClip.h>
+#include <AnimClipData.h>
 #include <AnimBlendLinear.h>
 #include <AnimationLogging.h>
 #include <AnimVariant.h>
@@ -260,6 +261,52 @@ void AnimTests::testVariant() {
     QVERIFY(q.z == 4.0f);
 }
 
+void AnimTests::testVariantMapKeys() {
+    AnimVariantKey alphaKey("keyTestAlpha");
+    AnimVariantKey enabledKey("keyTestEnabled");
+    AnimVariantKey emptyKey;
+
+    QVERIFY(alphaKey.getSlot() >= 0);
+    QVERIFY(alphaKey.getSlot() == AnimVariantKey("keyTestAlpha").getSlot());
+    QVERIFY(alphaKey.getSlot() != enabledKey.getSlot());
+    QVERIFY(AnimVariantKey::nameOf(alphaKey.getSlot()) == "keyTestAlpha");
+    QVERIFY(emptyKey.isEmpty());
+    QVERIFY(AnimVariantKey::find("keyTestNeverSet") == -1);
+
+    // set by name, looked up by key or name
+    AnimVariantMap vars;
+    vars.set("keyTestAlpha", 0.25f);
+    QVERIFY(vars.lookup(alphaKey, 1.0f) == 0.25f);
+    QVERIFY(vars.lookup(QString("keyTestAlpha"), 1.0f) == 0.25f);
+    QVERIFY(vars.lookup(enabledKey, true) == true);
+    QVERIFY(vars.lookup(emptyKey, 1.0f) == 1.0f);
+    QVERIFY(vars.hasKey(alphaKey));
+    QVERIFY(!vars.hasKey(enabledKey));
+
+    // a key interned after the map grew
+    AnimVariantKey laterKey("keyTestLater");
+    QVERIFY(vars.lookup(laterKey, 3) == 3);
+    vars.set("keyTestLater", 4);
+    QVERIFY(vars.lookup(laterKey, 3) == 4);
+
+    vars.unset("keyTestAlpha");
+    QVERIFY(!vars.hasKey(alphaKey));
+    QVERIFY(vars.lookup(alphaKey, 1.0f) == 1.0f);
+
+    AnimVariantMap triggers;
+    triggers.setTrigger(enabledKey);
+    vars.copyVariantsFrom(triggers);
+    QVERIFY(vars.lookup(enabledKey, false) == true);
+    QVERIFY(vars.lookup(laterKey, 3) == 4);
+
+    auto debugMap = vars.toDebugMap();
+    QVERIFY(debugMap.size() == 2);
+    QVERIFY(debugMap.count("keyTestEnabled") == 1);
+
+    triggers.clearMap();
+    QVERIFY(!triggers.hasKey(enabledKey));
+}
+
 void AnimTests::testAccumulateTime() {
 
     float startFrame = 0.0f;
@@ -468,6 +515,94 @@ void AnimTests::testAnimPose() {
     QCOMPARE_WITH_ABS_ERROR(p.scale(), resultScale, TEST_EPSILON2);
 }
 
+void AnimTests::testBlend() {
+    const float PI = (float)M_PI;
+
+    // enough poses for the vectorized blend and the remaining ones, with rotations on both sides of each other
+    const int NUM_POSES = 11;
+    AnimPoseVec a, b;
+    std::vector<float> weights;
+    for (int i = 0; i < NUM_POSES; i++) {
+        float t = (float)i / (float)NUM_POSES;
+        a.push_back(AnimPose(glm::vec3(1.0f + t), glm::angleAxis(PI * t, glm::normalize(glm::vec3(1.0f, t, 0.5f))),
+                             glm::vec3(t, 2.0f * t, -t)));
+        glm::quat bRot = glm::angleAxis(PI * (1.0f - t), glm::normalize(glm::vec3(t, 1.0f, -0.5f)));
+        b.push_back(AnimPose(glm::vec3(2.0f - t), (i % 2) ? -bRot : bRot, glm::vec3(-t, 1.0f, 3.0f * t)));
+        weights.push_back(t);
+    }
+
+    const float ALPHA = 0.3f;
+    AnimPoseVec result(NUM_POSES);
+    ::blend(NUM_POSES, &a[0], &b[0], ALPHA, &result[0]);
+    AnimPoseVec weightedResult(NUM_POSES);
+    ::blendWeighted(NUM_POSES, &a[0], &b[0], &weights[0], ALPHA, &weightedResult[0]);
+
+    for (int i = 0; i < NUM_POSES; i++) {
+        QCOMPARE_WITH_ABS_ERROR(result[i].scale(), lerp(a[i].scale(), b[i].scale(), ALPHA), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].rot(), safeLerp(a[i].rot(), b[i].rot(), ALPHA), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].trans(), lerp(a[i].trans(), b[i].trans(), ALPHA), TEST_EPSILON);
+
+        float alpha = weights[i] * ALPHA;
+        QCOMPARE_WITH_ABS_ERROR(weightedResult[i].scale(), lerp(a[i].scale(), b[i].scale(), alpha), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(weightedResult[i].rot(), safeLerp(a[i].rot(), b[i].rot(), alpha), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(weightedResult[i].trans(), lerp(a[i].trans(), b[i].trans(), alpha), TEST_EPSILON);
+    }
+
+    // the result can be one of the inputs
+    ::blend(NUM_POSES, &a[0], &b[0], ALPHA, &a[0]);
+    for (int i = 0; i < NUM_POSES; i++) {
+        QCOMPARE_WITH_ABS_ERROR(a[i].rot(), result[i].rot(), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(a[i].trans(), result[i].trans(), TEST_EPSILON);
+    }
+}
+
+void AnimTests::testClipData() {
+    const float PI = (float)M_PI;
+    const int NUM_FRAMES = 5;
+    const int NUM_JOINTS = 4;
+
+    // the last joint isn't animated
+    AnimClipData::Frames frames(NUM_FRAMES);
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        for (int i = 0; i < NUM_JOINTS; i++) {
+            float t = (i == NUM_JOINTS - 1) ? 0.5f : (float)(frame * NUM_JOINTS + i) / (float)(NUM_FRAMES * NUM_JOINTS);
+            frames[frame].push_back(AnimPose(glm::vec3(1.0f + i), glm::angleAxis(2.0f * PI * t, glm::normalize(glm::vec3(1.0f, t, -0.5f))),
+                                             glm::vec3(10.0f * t, -t, 0.25f)));
+        }
+    }
+
+    AnimClipData data(frames);
+    QCOMPARE(data.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(data.getNumJoints(), NUM_JOINTS);
+
+    const float ROTATION_DOT_EPSILON = 0.00001f;
+    auto decodedFrames = data.decodeFrames();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        for (int i = 0; i < NUM_JOINTS; i++) {
+            const AnimPose& pose = frames[frame][i];
+            const AnimPose& decodedPose = decodedFrames[frame][i];
+            QCOMPARE_WITH_ABS_ERROR(decodedPose.scale(), pose.scale(), TEST_EPSILON);
+            QVERIFY(1.0f - fabsf(glm::dot(decodedPose.rot(), pose.rot())) < ROTATION_DOT_EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(decodedPose.trans(), pose.trans(), TEST_EPSILON);
+        }
+    }
+
+    // the frames are built once while they are in use
+    int numBuilds = 0;
+    auto buildFrames = [&] {
+        numBuilds++;
+        return frames;
+    };
+    auto shared = AnimClipData::getOrBuild("testClipData", buildFrames);
+    auto sharedAgain = AnimClipData::getOrBuild("testClipData", buildFrames);
+    QCOMPARE(shared.get(), sharedAgain.get());
+    QCOMPARE(numBuilds, 1);
+    shared.reset();
+    sharedAgain.reset();
+    AnimClipData::getOrBuild("testClipData", buildFrames);
+    QCOMPARE(numBuilds, 2);
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -556,7 +691,7 @@ void AnimTests::testExpressionParser() {
     QVERIFY(e._opCodes.size() == 1);
     if (e._opCodes.size() == 1) {
         QVERIFY(e._opCodes[0].type == AnimExpression::OpCode::Identifier);
-        QVERIFY(e._opCodes[0].strVal == "twenty");
+        QVERIFY(e._opCodes[0].strVal.getName() == "twenty");
     }
 
     e = AnimExpression("true || false");
@@ -25,8 +25,11 @@ private slots:
     void testClipEvaulateWithVars();
     void testLoader();
     void testVariant();
+    void testVariantMapKeys();
     void testAccumulateTime();
     void testAnimPose();
+    void testBlend();
+    void testClipData();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
@@ -0,0 +1,78 @@
+//
+//  AudioAmbisonicBedTests.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioAmbisonicBedTests.h"
+
+#include <cmath>
+
+#include <AudioAmbisonicBed.h>
+
+QTEST_MAIN(AudioAmbisonicBedTests)
+
+using namespace AudioAmbisonicBed;
+
+// a low tone, well below the half rate of the bed
+static void createTone(int16_t* samples) {
+    const float FREQUENCY = 440.0f;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        samples[i] = (int16_t)(8000.0f * sinf(2.0f * (float)M_PI * FREQUENCY * i / AudioConstants::SAMPLE_RATE));
+    }
+}
+
+void AudioAmbisonicBedTests::roundTripTest() {
+    int16_t tone[NUM_FRAMES];
+    createTone(tone);
+
+    float bed[NUM_SAMPLES] = {};
+    encodeSource(tone, glm::vec3(0.0f, 0.0f, -1.0f), 1.0f, bed);
+
+    QByteArray encoded;
+    encode(bed, encoded);
+    QCOMPARE(encoded.size(), ENCODED_BYTES);
+
+    int16_t decoded[NUM_SAMPLES];
+    QVERIFY(decode(encoded, decoded));
+
+    // W and X follow the tone, away from the edges of the frame which are held
+    const int MAX_ERROR = 800;
+    for (int i = 4; i < NUM_FRAMES - 4; i++) {
+        QVERIFY(std::abs(decoded[NUM_CHANNELS * i + 0] - tone[i]) < MAX_ERROR);
+        QVERIFY(std::abs(decoded[NUM_CHANNELS * i + 3] - tone[i]) < MAX_ERROR);
+        QVERIFY(std::abs(decoded[NUM_CHANNELS * i + 1]) < MAX_ERROR);
+        QVERIFY(std::abs(decoded[NUM_CHANNELS * i + 2]) < MAX_ERROR);
+    }
+}
+
+void AudioAmbisonicBedTests::directionTest() {
+    int16_t tone[NUM_FRAMES];
+    createTone(tone);
+
+    // a source on the left and above, far away
+    float bed[NUM_SAMPLES] = {};
+    encodeSource(tone, glm::vec3(-100.0f, 100.0f, 0.0f), 1.0f, bed);
+
+    const float SQRT1_2 = 0.7071067811865476f;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        float w = bed[NUM_CHANNELS * i + 0];
+        QCOMPARE(bed[NUM_CHANNELS * i + 1], SQRT1_2 * w);   // Y: left
+        QCOMPARE(bed[NUM_CHANNELS * i + 2], SQRT1_2 * w);   // Z: up
+        QCOMPARE(bed[NUM_CHANNELS * i + 3], 0.0f);          // X: front
+    }
+}
+
+void AudioAmbisonicBedTests::malformedTest() {
+    int16_t decoded[NUM_SAMPLES];
+    QVERIFY(!decode(QByteArray(ENCODED_BYTES - 1, 0), decoded));
+
+    QByteArray badIndex(ENCODED_BYTES, 0);
+    badIndex[sizeof(int16_t)] = (char)100;
+    QVERIFY(!decode(badIndex, decoded));
+}
@@ -0,0 +1,25 @@
+//
+//  AudioAmbisonicBedTests.h
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioAmbisonicBedTests_h
+#define hifi_AudioAmbisonicBedTests_h
+
+#include <QtTest/QtTest>
+
+class AudioAmbisonicBedTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTripTest();
+    void directionTest();
+    void malformedTest();
+};
+
+#endif // hifi_AudioAmbisonicBedTests_h
@@ -0,0 +1,100 @@
+//
+//  AudioFECTests.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-25.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioFECTests.h"
+
+#include <AudioFEC.h>
+
+QTEST_MAIN(AudioFECTests)
+
+static const int GROUP_SIZE = 4;
+
+static std::unique_ptr<NLPacket> createAudioPacket(PacketType type, quint16 sequence) {
+    auto packet = NLPacket::create(type);
+    packet->writePrimitive(sequence);
+    // payloads of different lengths, as encoded audio would be
+    QByteArray data(20 + 7 * (sequence % 5), (char)('a' + sequence % 26));
+    packet->write(data);
+    return packet;
+}
+
+static quint16 readSequence(ReceivedMessage& message) {
+    message.seek(0);
+    quint16 sequence;
+    message.readPrimitive(&sequence);
+    return sequence;
+}
+
+// sends the packets of [0, numPackets) but the lost ones through an encoder and decoder, returns the output sequence
+static std::vector<quint16> transmit(int numPackets, const std::vector<int>& lost,
+                                     std::vector<QSharedPointer<ReceivedMessage>>* outputMessages = nullptr) {
+    AudioFECEncoder encoder;
+    encoder.setGroupSize(GROUP_SIZE);
+    AudioFECDecoder decoder;
+
+    std::vector<quint16> output;
+    auto outputMessage = [&](const QSharedPointer<ReceivedMessage>& message) {
+        output.push_back(readSequence(*message));
+        if (outputMessages) {
+            outputMessages->push_back(message);
+        }
+    };
+
+    for (int i = 0; i < numPackets; ++i) {
+        auto type = i % 3 == 0 ? PacketType::SilentAudioFrame : PacketType::MicrophoneAudioNoEcho;
+        auto packet = createAudioPacket(type, (quint16)i);
+        auto parityPacket = encoder.addPacket(*packet);
+
+        if (std::find(lost.begin(), lost.end(), i) == lost.end()) {
+            decoder.handleAudioPacket(QSharedPointer<ReceivedMessage>::create(*packet), outputMessage);
+        }
+        if (parityPacket) {
+            ReceivedMessage parityMessage(*parityPacket);
+            decoder.handleParityPacket(parityMessage, outputMessage);
+        }
+    }
+    return output;
+}
+
+void AudioFECTests::noLossTest() {
+    auto output = transmit(3 * GROUP_SIZE, {});
+    QCOMPARE((int)output.size(), 3 * GROUP_SIZE);
+    for (int i = 0; i < (int)output.size(); ++i) {
+        QCOMPARE((int)output[i], i);
+    }
+}
+
+void AudioFECTests::recoverTest() {
+    std::vector<QSharedPointer<ReceivedMessage>> messages;
+    auto output = transmit(3 * GROUP_SIZE, { 1, GROUP_SIZE + 3, 2 * GROUP_SIZE }, &messages);
+
+    // one loss per group, they all come back in order
+    QCOMPARE((int)output.size(), 3 * GROUP_SIZE);
+    for (int i = 0; i < (int)output.size(); ++i) {
+        QCOMPARE((int)output[i], i);
+
+        auto original = createAudioPacket(i % 3 == 0 ? PacketType::SilentAudioFrame : PacketType::MicrophoneAudioNoEcho,
+                                          (quint16)i);
+        QCOMPARE(messages[i]->getType(), original->getType());
+        QCOMPARE(messages[i]->getMessage(), QByteArray(original->getPayload(), (int)original->getPayloadSize()));
+    }
+}
+
+void AudioFECTests::unrecoverableTest() {
+    auto output = transmit(2 * GROUP_SIZE, { 1, 2 });
+
+    // the second group goes through once the first one is given up on, the losses are left to the stream
+    std::vector<quint16> expected { 0, 3 };
+    for (int i = GROUP_SIZE; i < 2 * GROUP_SIZE; ++i) {
+        expected.push_back((quint16)i);
+    }
+    QCOMPARE(output, expected);
+}
@@ -0,0 +1,25 @@
+//
+//  AudioFECTests.h
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-25.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioFECTests_h
+#define hifi_AudioFECTests_h
+
+#include <QtTest/QtTest>
+
+class AudioFECTests : public QObject {
+    Q_OBJECT
+private slots:
+    void noLossTest();
+    void recoverTest();
+    void unrecoverableTest();
+};
+
+#endif // hifi_AudioFECTests_h
@@ -0,0 +1,66 @@
+//
+//  AudioHRTFTests.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-08.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFTests.h"
+
+#include <cmath>
+
+#include <AudioHRTF.h>
+
+QTEST_MAIN(AudioHRTFTests)
+
+static const int NUM_SOURCES = 3;   // odd, so the unpaired path is covered too
+static const int NUM_BLOCKS = 8;
+
+void AudioHRTFTests::renderMultipleTest() {
+    AudioHRTF single[NUM_SOURCES];
+    AudioHRTF multiple[NUM_SOURCES];
+
+    static int16_t input[NUM_SOURCES][HRTF_BLOCK];
+    static float singleOutput[2 * HRTF_BLOCK];
+    static float multipleOutput[2 * HRTF_BLOCK];
+
+    for (int block = 0; block < NUM_BLOCKS; ++block) {
+        float azimuths[NUM_SOURCES];
+        float distances[NUM_SOURCES];
+        float gains[NUM_SOURCES];
+
+        for (int s = 0; s < NUM_SOURCES; ++s) {
+            for (int i = 0; i < HRTF_BLOCK; ++i) {
+                input[s][i] = (int16_t)(8192.0f * sinf(0.01f * (s + 1) * (block * HRTF_BLOCK + i)));
+            }
+
+            // move the sources around so the filters interpolate between blocks
+            azimuths[s] = 0.3f * s + 0.1f * block;
+            distances[s] = 0.5f + s + 0.25f * block;
+            gains[s] = 1.0f / (s + 1);
+        }
+
+        memset(singleOutput, 0, sizeof(singleOutput));
+        memset(multipleOutput, 0, sizeof(multipleOutput));
+
+        for (int s = 0; s < NUM_SOURCES; ++s) {
+            single[s].render(input[s], singleOutput, 1, azimuths[s], distances[s], gains[s], HRTF_BLOCK);
+        }
+
+        AudioHRTF* hrtfs[NUM_SOURCES];
+        int16_t* inputs[NUM_SOURCES];
+        for (int s = 0; s < NUM_SOURCES; ++s) {
+            hrtfs[s] = &multiple[s];
+            inputs[s] = input[s];
+        }
+        AudioHRTF::renderMultiple(hrtfs, inputs, azimuths, distances, gains, NUM_SOURCES, multipleOutput, 1, HRTF_BLOCK);
+
+        for (int i = 0; i < 2 * HRTF_BLOCK; ++i) {
+            QVERIFY(fabsf(singleOutput[i] - multipleOutput[i]) < 1e-6f);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+//
+//  AudioMixBenchmarks.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixBenchmarks.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <AudioAmbisonicBed.h>
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <AudioLimiter.h>
+
+QTEST_MAIN(AudioMixBenchmarks)
+
+// A frame of the audio-mixer for synthetic listeners, each of them hearing all the sources: the per listener work of
+// AudioMixerSlave (spatialization of the near sources, ambisonic bed of the distant ones, limiter) without the
+// network and the codecs. Run with -tickcounter or -median to compare kernels; the time is per frame of 10 ms.
+
+static const float SPREAD = 64.0f;          // meters, the side of the square the avatars stand in
+static const float ATTENUATION = 0.5f;      // the default attenuation per doubling of distance
+static const float DISTANCE_REF = 2.0f;
+
+void AudioMixBenchmarks::mixFrameBenchmark_data() {
+    QTest::addColumn<int>("numListeners");
+    QTest::addColumn<int>("numSources");
+    QTest::addColumn<float>("bedDistance");     // 0 spatializes all the sources
+
+    QTest::newRow("10 listeners, 10 sources") << 10 << 10 << 0.0f;
+    QTest::newRow("50 listeners, 50 sources") << 50 << 50 << 0.0f;
+    QTest::newRow("100 listeners, 100 sources") << 100 << 100 << 0.0f;
+    QTest::newRow("100 listeners, 100 sources, bed") << 100 << 100 << 16.0f;
+}
+
+void AudioMixBenchmarks::mixFrameBenchmark() {
+    QFETCH(int, numListeners);
+    QFETCH(int, numSources);
+    QFETCH(float, bedDistance);
+
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    std::mt19937 generator(numListeners * numSources);
+    std::uniform_real_distribution<float> position(0.0f, SPREAD);
+
+    // the avatars are the sources and the listeners, each of them with a tone of its own
+    int numAvatars = std::max(numListeners, numSources);
+    std::vector<float> x(numAvatars);
+    std::vector<float> z(numAvatars);
+    for (int i = 0; i < numAvatars; ++i) {
+        x[i] = position(generator);
+        z[i] = position(generator);
+    }
+    std::vector<int16_t> input(numSources * NUM_FRAMES);
+    for (int s = 0; s < numSources; ++s) {
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            input[s * NUM_FRAMES + i] = (int16_t)(4096.0f * sinf(0.02f * (s + 1) * i));
+        }
+    }
+
+    // the filter state of each listener-source pair, as kept by AudioMixerClientData
+    std::vector<AudioHRTF> hrtfs(numListeners * numSources);
+    std::vector<std::unique_ptr<AudioLimiter>> limiters;
+    for (int l = 0; l < numListeners; ++l) {
+        limiters.emplace_back(new AudioLimiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO));
+    }
+
+    std::vector<AudioHRTF*> pairs(numSources);
+    std::vector<int16_t*> inputs(numSources);
+    std::vector<float> azimuths(numSources);
+    std::vector<float> distances(numSources);
+    std::vector<float> gains(numSources);
+    std::vector<float> mix(AudioConstants::STEREO * NUM_FRAMES);
+    std::vector<float> bed(AudioAmbisonicBed::NUM_SAMPLES);
+    std::vector<int16_t> output(AudioConstants::STEREO * NUM_FRAMES);
+    QByteArray encodedBed;
+
+    QBENCHMARK {
+        for (int l = 0; l < numListeners; ++l) {
+            std::fill(mix.begin(), mix.end(), 0.0f);
+            std::fill(bed.begin(), bed.end(), 0.0f);
+            bool hasBed = false;
+
+            int numNear = 0;
+            for (int s = 0; s < numSources; ++s) {
+                if (s == l) {
+                    continue;
+                }
+                float dx = x[s] - x[l];
+                float dz = z[s] - z[l];
+                float distance = std::max(sqrtf(dx * dx + dz * dz), 0.1f);
+                float gain = distance > DISTANCE_REF ?
+                    powf(1.0f - ATTENUATION, log2f(distance / DISTANCE_REF)) : 1.0f;
+
+                if (bedDistance > 0.0f && distance > bedDistance) {
+                    AudioAmbisonicBed::encodeSource(&input[s * NUM_FRAMES], glm::vec3(dx, 0.0f, dz), gain, bed.data());
+                    hasBed = true;
+                    continue;
+                }
+
+                pairs[numNear] = &hrtfs[l * numSources + s];
+                inputs[numNear] = &input[s * NUM_FRAMES];
+                azimuths[numNear] = atan2f(dx, -dz);
+                distances[numNear] = distance;
+                gains[numNear] = gain;
+                ++numNear;
+            }
+
+            AudioHRTF::renderMultiple(pairs.data(), inputs.data(), azimuths.data(), distances.data(), gains.data(),
+                                      numNear, mix.data(), 1, NUM_FRAMES);
+            limiters[l]->render(mix.data(), output.data(), NUM_FRAMES);
+
+            if (hasBed) {
+                AudioAmbisonicBed::encode(bed.data(), encodedBed);
+            }
+        }
+    }
+}
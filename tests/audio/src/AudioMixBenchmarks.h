@@ -0,0 +1,24 @@
+//
+//  AudioMixBenchmarks.h
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixBenchmarks_h
+#define hifi_AudioMixBenchmarks_h
+
+#include <QtTest/QtTest>
+
+class AudioMixBenchmarks : public QObject {
+    Q_OBJECT
+private slots:
+    void mixFrameBenchmark_data();
+    void mixFrameBenchmark();
+};
+
+#endif // hifi_AudioMixBenchmarks_h
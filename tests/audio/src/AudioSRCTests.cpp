@@ -0,0 +1,51 @@
+//
+//  AudioSRCTests.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSRCTests.h"
+
+#include <cmath>
+#include <vector>
+
+#include <AudioSRC.h>
+
+QTEST_MAIN(AudioSRCTests)
+
+// blocks of odd sizes, so that the outputs computed four at a time straddle the blocks
+static const int BLOCK_FRAMES[] = { 480, 37, 256, 101, 480, 3 };
+
+void AudioSRCTests::decimationTest() {
+    // the mono integer decimation has its own path, it must match the stereo one
+    AudioSRC mono(48000, 24000, 1);
+    AudioSRC stereo(48000, 24000, 2);
+
+    int t = 0;
+    for (int numFrames : BLOCK_FRAMES) {
+        std::vector<float> monoInput(numFrames);
+        std::vector<float> stereoInput(2 * numFrames);
+        for (int i = 0; i < numFrames; i++, t++) {
+            float sample = 0.5f * sinf(2.0f * (float)M_PI * 1000.0f * t / 48000.0f);
+            monoInput[i] = sample;
+            stereoInput[2 * i + 0] = sample;
+            stereoInput[2 * i + 1] = -sample;
+        }
+
+        std::vector<float> monoOutput(mono.getMaxOutput(numFrames));
+        std::vector<float> stereoOutput(2 * stereo.getMaxOutput(numFrames));
+        int monoFrames = mono.render(monoInput.data(), monoOutput.data(), numFrames);
+        int stereoFrames = stereo.render(stereoInput.data(), stereoOutput.data(), numFrames);
+
+        QCOMPARE(monoFrames, stereoFrames);
+        for (int i = 0; i < monoFrames; i++) {
+            QVERIFY(fabsf(monoOutput[i] - stereoOutput[2 * i + 0]) < 1e-5f);
+            QVERIFY(fabsf(monoOutput[i] + stereoOutput[2 * i + 1]) < 1e-5f);
+        }
+    }
+}
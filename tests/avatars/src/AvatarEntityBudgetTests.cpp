@@ -0,0 +1,105 @@
+//
+//  AvatarEntityBudgetTests.cpp
+//  tests/avatars/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarEntityBudgetTests.h"
+
+#include <AvatarEntityBudget.h>
+
+QTEST_MAIN(AvatarEntityBudgetTests)
+
+// sends the avatar entities of an avatar as the mixer does, returns how many went out
+static int sendAvatarEntities(AvatarEntityBudget& budget, bool isInView, NetworkLocalID sender, int numAvatarEntities,
+                              qint64 entityBytes) {
+    budget.beginAvatar(isInView, sender);
+    qint64 bytesWritten = 0;
+    int numSent = 0;
+    for (int i = 0; i < numAvatarEntities; ++i) {
+        if (budget.canSendAvatarEntity(bytesWritten)) {
+            bytesWritten += entityBytes;
+            ++numSent;
+        }
+    }
+    budget.endAvatar(bytesWritten);
+    return numSent;
+}
+
+void AvatarEntityBudgetTests::testBudget() {
+    AvatarEntityBudget budget(1000, AvatarEntityBudget::NULL_SENDER);
+
+    // sent while fewer bytes than the budget have been written
+    QCOMPARE(sendAvatarEntities(budget, true, 1, 5, 300), 4);
+    QCOMPARE(budget.getRemainingBytes(), (qint64)0);
+    QCOMPARE(budget.getNextOverBudgetSender(), (NetworkLocalID)1);
+
+    // an entity larger than the whole budget still goes out, with the pass of the frame
+    AvatarEntityBudget smallBudget(0, 1);
+    QCOMPARE(sendAvatarEntities(smallBudget, true, 1, 2, 5000), 1);
+}
+
+void AvatarEntityBudgetTests::testOutOfView() {
+    AvatarEntityBudget budget(1000, AvatarEntityBudget::NULL_SENDER);
+
+    // out of view, nothing goes out and the budget is left to the others
+    QCOMPARE(sendAvatarEntities(budget, false, 1, 3, 100), 0);
+    QCOMPARE(budget.getRemainingBytes(), (qint64)1000);
+    QCOMPARE(sendAvatarEntities(budget, true, 2, 3, 100), 3);
+    QCOMPARE(budget.getRemainingBytes(), (qint64)700);
+
+    // the avatars out of view don't get the pass either
+    QCOMPARE(budget.getNextOverBudgetSender(), AvatarEntityBudget::NULL_SENDER);
+}
+
+void AvatarEntityBudgetTests::testSaturatedBudget() {
+    // the first avatar in the order always has more avatar entities than the frame has room for
+    const int NUM_FRAMES = 20;
+    const int LAST_AVATAR_ENTITIES = 8;
+    int lastAvatarRemaining = LAST_AVATAR_ENTITIES;
+    NetworkLocalID overBudgetSender = AvatarEntityBudget::NULL_SENDER;
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        AvatarEntityBudget budget(1000, overBudgetSender);
+        QVERIFY(sendAvatarEntities(budget, true, 1, 100, 400) > 0);
+        QCOMPARE(budget.getRemainingBytes(), (qint64)0);
+
+        // the avatar after it isn't starved, it shares the pass with the first one
+        lastAvatarRemaining -= sendAvatarEntities(budget, true, 2, lastAvatarRemaining, 400);
+        overBudgetSender = budget.getNextOverBudgetSender();
+    }
+    QCOMPARE(lastAvatarRemaining, 0);
+}
+
+void AvatarEntityBudgetTests::testCrowdWithoutBudget() {
+    // a crowd comes into view of a receiver whose frames have no room for avatar entities
+    const int NUM_AVATARS = 50;
+    const int AVATAR_ENTITIES = 3;
+    const int NUM_FRAMES = NUM_AVATARS * AVATAR_ENTITIES + NUM_AVATARS;
+    std::vector<int> remaining(NUM_AVATARS, AVATAR_ENTITIES);
+    NetworkLocalID overBudgetSender = AvatarEntityBudget::NULL_SENDER;
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        AvatarEntityBudget budget(0, overBudgetSender);
+        int numSent = 0;
+        for (int i = 0; i < NUM_AVATARS; ++i) {
+            // the priority order moves around from one frame to the next
+            int avatar = (i + frame * 7) % NUM_AVATARS;
+            int numAvatarSent = sendAvatarEntities(budget, true, (NetworkLocalID)(avatar + 1), remaining[avatar], 5000);
+            remaining[avatar] -= numAvatarSent;
+            numSent += numAvatarSent;
+        }
+
+        // never more than one avatar entity a frame, whatever its size
+        QVERIFY(numSent <= 1);
+        overBudgetSender = budget.getNextOverBudgetSender();
+    }
+
+    // and every avatar got its avatar entities out in the end
+    for (int avatar = 0; avatar < NUM_AVATARS; ++avatar) {
+        QCOMPARE(remaining[avatar], 0);
+    }
+}
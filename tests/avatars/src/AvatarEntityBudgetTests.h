@@ -0,0 +1,27 @@
+//
+//  AvatarEntityBudgetTests.h
+//  tests/avatars/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarEntityBudgetTests_h
+#define hifi_AvatarEntityBudgetTests_h
+
+#include <QtTest/QtTest>
+
+class AvatarEntityBudgetTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testBudget();
+    void testOutOfView();
+    void testSaturatedBudget();
+    void testCrowdWithoutBudget();
+};
+
+#endif // hifi_AvatarEntityBudgetTests_h
@@ -10,9 +10,11 @@
 
 #include <mutex>
 
+#include <QtCore/QBuffer>
 #include <QtTest/QtTest>
 
 #include <ktx/KTX.h>
+#include <ktx/KTX2.h>
 #include <gpu/Texture.h>
 #include <image/Image.h>
 
@@ -142,6 +144,96 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+// Stands in for a Basis Universal transcoder: the levels are taken as RGBA8 as they are
+class PassThroughTranscoder : public ktx::KTX2Transcoder {
+public:
+    std::unique_ptr<ktx::KTX> transcode(const ktx::KTX2& source) const override {
+        auto header = source.evalKTXHeader();
+        header.setUncompressed(ktx::GLType::UNSIGNED_BYTE, 1, ktx::GLFormat::RGBA, ktx::GLInternalFormat::RGBA8, ktx::GLBaseInternalFormat::RGBA);
+        auto level = source.getLevelData(0);
+        ktx::Images images { ktx::Image(0, (uint32_t)level->size(), 0, level->data()) };
+        return ktx::KTX::create(header, images, source.getKeyValues());
+    }
+};
+
+void KtxTests::testKtx2Conversion() {
+    const uint32_t WIDTH = 4;
+    const uint32_t HEIGHT = 4;
+    const size_t LEVEL_SIZE = WIDTH * HEIGHT * 4;
+    const uint32_t VK_FORMAT_R8G8B8A8_SRGB = 43;
+
+    ktx::KeyValue keyValue("hifi.test", "value");
+
+    ktx::KTX2::Header header;
+    memcpy(header.identifier, ktx::KTX2::IDENTIFIER.data(), ktx::KTX2::IDENTIFIER_LENGTH);
+    header.vkFormat = VK_FORMAT_R8G8B8A8_SRGB;
+    header.pixelWidth = WIDTH;
+    header.pixelHeight = HEIGHT;
+    header.levelCount = 1;
+    header.kvdByteOffset = ktx::KTX2_HEADER_SIZE + ktx::KTX2_LEVEL_INDEX_SIZE;
+    header.kvdByteLength = keyValue.serializedByteSize();
+
+    ktx::KTX2::LevelIndex level;
+    level.byteOffset = ktx::evalPaddedSize(header.kvdByteOffset + header.kvdByteLength);
+    level.byteLength = LEVEL_SIZE;
+    level.uncompressedByteLength = LEVEL_SIZE;
+
+    std::vector<ktx::Byte> texels(LEVEL_SIZE);
+    for (size_t i = 0; i < LEVEL_SIZE; ++i) {
+        texels[i] = (ktx::Byte)i;
+    }
+
+    auto storage = std::make_shared<storage::MemoryStorage>(level.byteOffset + LEVEL_SIZE);
+    auto bytes = storage->data();
+    memcpy(bytes, &header, ktx::KTX2_HEADER_SIZE);
+    memcpy(bytes + ktx::KTX2_HEADER_SIZE, &level, ktx::KTX2_LEVEL_INDEX_SIZE);
+    ktx::KeyValue::writeSerializedKeyAndValue(bytes + header.kvdByteOffset, header.kvdByteLength, keyValue);
+    memcpy(bytes + level.byteOffset, texels.data(), LEVEL_SIZE);
+
+    QVERIFY(ktx::KTX2::checkIdentifier(bytes));
+    {
+        auto ktx2File = ktx::KTX2::create(storage);
+        QVERIFY(ktx2File.get());
+        QVERIFY(!ktx2File->needsTranscoding());
+        QCOMPARE(ktx2File->getKeyValues().size(), (size_t)1);
+
+        auto ktxFile = ktx2File->toKTX();
+        QVERIFY(ktxFile.get());
+        QVERIFY(ktxFile->isValid());
+        const auto& ktxHeader = ktxFile->getHeader();
+        QVERIFY(ktxHeader.getGLInternaFormat() == ktx::GLInternalFormat::SRGB8_ALPHA8);
+        QCOMPARE(ktxHeader.getPixelWidth(), WIDTH);
+        QCOMPARE(ktxHeader.getPixelHeight(), HEIGHT);
+        QCOMPARE(ktxFile->_keyValues.size(), (size_t)1);
+        QCOMPARE(ktxFile->_images.size(), (size_t)1);
+        QCOMPARE(ktxFile->_images[0]._faceSize, (uint32_t)LEVEL_SIZE);
+        QVERIFY(0 == memcmp(ktxFile->_images[0]._faceBytes[0], texels.data(), LEVEL_SIZE));
+    }
+
+    // Basis Universal ETC1S levels can only go through the transcoder
+    header.vkFormat = ktx::KTX2::VK_FORMAT_UNDEFINED;
+    header.supercompressionScheme = ktx::KTX2::BASIS_LZ;
+    memcpy(bytes, &header, ktx::KTX2_HEADER_SIZE);
+    {
+        auto ktx2File = ktx::KTX2::create(storage);
+        QVERIFY(ktx2File.get());
+        QVERIFY(ktx2File->needsTranscoding());
+        QVERIFY(!ktx2File->toKTX());
+
+        ktx::KTX2::setTranscoder(std::make_shared<PassThroughTranscoder>());
+        auto ktxFile = ktx2File->toKTX();
+        ktx::KTX2::setTranscoder(nullptr);
+        QVERIFY(ktxFile.get());
+        QVERIFY(ktxFile->getHeader().getGLInternaFormat() == ktx::GLInternalFormat::RGBA8);
+        QVERIFY(0 == memcmp(ktxFile->_images[0]._faceBytes[0], texels.data(), LEVEL_SIZE));
+    }
+
+    // a level past the end of the data
+    level.byteLength = LEVEL_SIZE + 1;
+    memcpy(bytes + ktx::KTX2_HEADER_SIZE, &level, ktx::KTX2_LEVEL_INDEX_SIZE);
+    QVERIFY(!ktx::KTX2::create(storage));
+}
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
@@ -196,3 +288,47 @@ int mainTemp(int, char**) {
     return 0;
 }
 #endif
+
+void KtxTests::testKtxStreamWriter() {
+    ktx::Header header;
+    header.set2D(8, 8);
+    header.numberOfMipmapLevels = 2;
+
+    std::vector<ktx::Byte> mip0(header.evalFaceSize(0), 0x11);
+    std::vector<ktx::Byte> mip1(header.evalFaceSize(1), 0x22);
+    ktx::Images images;
+    images.emplace_back(ktx::Image(0, (uint32_t)mip0.size(), 0, mip0.data()));
+    images.emplace_back(ktx::Image(0, (uint32_t)mip1.size(), 0, mip1.data()));
+    ktx::KeyValues keyValues;
+    keyValues.emplace_back("test", "value");
+
+    auto ktxMemory = ktx::KTX::create(header, images, keyValues);
+    QVERIFY(ktxMemory.get());
+    const auto& memStorage = ktxMemory->getStorage();
+
+    // Written as it goes, the same bytes as in memory
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(ktx::KTX::write(buffer, header, images, keyValues));
+        QCOMPARE((size_t)buffer.size(), memStorage->size());
+        QCOMPARE((size_t)buffer.size(), ktx::KTX::evalStorageSize(header, images, keyValues));
+        QVERIFY(0 == memcmp(buffer.data().constData(), memStorage->data(), memStorage->size()));
+    }
+
+    // The mips in any order, each checked as it comes
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        ktx::StreamWriter writer(buffer, header, keyValues);
+        QCOMPARE(writer.getStorageSize(), memStorage->size());
+        QVERIFY(!writer.writeMip(1, { mip1.data() }, (uint32_t)mip0.size()));
+        QVERIFY(writer.writeImage(1, images[1]));
+        QVERIFY(!writer.writeImage(1, images[1]));
+        QVERIFY(!writer.writeImage(2, images[1]));
+        QVERIFY(!writer.finish());
+        QVERIFY(writer.writeImage(0, images[0]));
+        QVERIFY(writer.finish());
+        QVERIFY(0 == memcmp(buffer.data().constData(), memStorage->data(), memStorage->size()));
+    }
+}
@@ -0,0 +1,110 @@
+//
+//  DownstreamBandwidthTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DownstreamBandwidthTests.h"
+
+#include <DownstreamBandwidth.h>
+
+QTEST_MAIN(DownstreamBandwidthTests)
+
+static DownstreamBandwidth roundTrip(const DownstreamBandwidth& bandwidth) {
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << bandwidth;
+
+    DownstreamBandwidth result;
+    QDataStream in(data);
+    in >> result;
+    return result;
+}
+
+void DownstreamBandwidthTests::noLimitTest() {
+    DownstreamBandwidth bandwidth;
+    bandwidth.usageKbps = {{ 100.0f, 300.0f, 400.0f, 0.0f }};
+
+    for (int i = 0; i < DownstreamBandwidth::NumStreams; ++i) {
+        QCOMPARE(bandwidth.getShareKbps((DownstreamBandwidth::Stream)i), 0.0f);
+    }
+}
+
+void DownstreamBandwidthTests::priorityTest() {
+    DownstreamBandwidth bandwidth;
+    bandwidth.capacityKbps = 1000.0f;
+    bandwidth.usageKbps = {{ 100.0f, 300.0f, 400.0f, 0.0f }};
+
+    // the audio and the avatars get what they use and room to grow, the entities what is left but the assets' part
+    QCOMPARE(bandwidth.getShareKbps(DownstreamBandwidth::Audio), 157.0f);
+    QCOMPARE(bandwidth.getShareKbps(DownstreamBandwidth::Avatars), 407.0f);
+    QCOMPARE(bandwidth.getShareKbps(DownstreamBandwidth::Entities), 404.0f);
+    QCOMPARE(bandwidth.getShareKbps(DownstreamBandwidth::Assets), 32.0f);
+}
+
+void DownstreamBandwidthTests::minimumShareTest() {
+    DownstreamBandwidth bandwidth;
+    bandwidth.capacityKbps = 200.0f;
+    bandwidth.usageKbps = {{ 300.0f, 0.0f, 0.0f, 0.0f }};
+
+    // the audio wants more than the link has, the other streams still keep their minimum parts of it
+    QCOMPARE(bandwidth.getShareKbps(DownstreamBandwidth::Audio), 140.0f);
+    QCOMPARE(bandwidth.getShareKbps(DownstreamBandwidth::Avatars), 30.0f);
+    QCOMPARE(bandwidth.getShareKbps(DownstreamBandwidth::Entities), 20.0f);
+    QCOMPARE(bandwidth.getShareKbps(DownstreamBandwidth::Assets), 10.0f);
+}
+
+void DownstreamBandwidthTests::estimatorTest() {
+    DownstreamBandwidthEstimator estimator;
+
+    // a clean link isn't limited
+    QCOMPARE(estimator.update(1000.0f, 1000, 0), 0.0f);
+
+    // the loss sets the capacity under what got through
+    QCOMPARE(estimator.update(1000.0f, 900, 100), 900.0f);
+
+    // it grows back while the streams are held back by it and nothing is lost
+    QCOMPARE(estimator.update(850.0f, 1000, 0), 945.0f);
+
+    // but not while they use little of it, or when there are too few packets to tell
+    QCOMPARE(estimator.update(100.0f, 100, 0), 945.0f);
+    QCOMPARE(estimator.update(500.0f, 10, 5), 945.0f);
+    QCOMPARE(estimator.getCapacityKbps(), 945.0f);
+}
+
+void DownstreamBandwidthTests::roundTripTest() {
+    DownstreamBandwidth bandwidth;
+    bandwidth.capacityKbps = 1500.0f;
+    bandwidth.usageKbps = {{ 64.0f, 500.0f, 250.0f, 12.5f }};
+
+    DownstreamBandwidth result = roundTrip(bandwidth);
+    QCOMPARE(result.capacityKbps, 1500.0f);
+    for (int i = 0; i < DownstreamBandwidth::NumStreams; ++i) {
+        QCOMPARE(result.usageKbps[i], bandwidth.usageKbps[i]);
+    }
+}
+
+void DownstreamBandwidthTests::corruptDataTest() {
+    DownstreamBandwidth bandwidth;
+    bandwidth.capacityKbps = -5.0f;
+    bandwidth.usageKbps = {{ 64.0f, -1.0f, 0.0f, 0.0f }};
+
+    // negative rates count as none
+    DownstreamBandwidth result = roundTrip(bandwidth);
+    QCOMPARE(result.capacityKbps, 0.0f);
+    QCOMPARE(result.usageKbps[0], 64.0f);
+    QCOMPARE(result.usageKbps[1], 0.0f);
+
+    // a truncated report is no report
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << 1500.0f;
+    QDataStream in(data);
+    in >> result;
+    QCOMPARE(result.capacityKbps, 0.0f);
+}
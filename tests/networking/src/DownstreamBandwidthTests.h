@@ -0,0 +1,28 @@
+//
+//  DownstreamBandwidthTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DownstreamBandwidthTests_h
+#define hifi_DownstreamBandwidthTests_h
+
+#include <QtTest/QtTest>
+
+class DownstreamBandwidthTests : public QObject {
+    Q_OBJECT
+private slots:
+    void noLimitTest();
+    void priorityTest();
+    void minimumShareTest();
+    void estimatorTest();
+    void roundTripTest();
+    void corruptDataTest();
+};
+
+#endif // hifi_DownstreamBandwidthTests_h
@@ -0,0 +1,190 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-23.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <algorithm>
+#include <random>
+
+#include <udt/LossList.h>
+#include <udt/Packet.h>
+#include <udt/SentPacketHistory.h>
+
+QTEST_MAIN(LossListTests)
+
+using namespace udt;
+
+static SequenceNumber seq(int value) {
+    return SequenceNumber(value);
+}
+
+void LossListTests::appendTest() {
+    LossList list;
+    QVERIFY(list.isEmpty());
+
+    list.append(seq(1));
+    list.append(seq(2));
+    list.append(seq(5), seq(9));
+    list.append(seq(10), seq(11));
+    QCOMPARE(list.getLength(), 9);
+    QCOMPARE(list.getFirstSequenceNumber(), seq(1));
+
+    QCOMPARE(list.popFirstSequenceNumber(), seq(1));
+    QCOMPARE(list.popFirstSequenceNumber(), seq(2));
+    QCOMPARE(list.popFirstSequenceNumber(), seq(5));
+    QCOMPARE(list.getLength(), 6);
+
+    list.clear();
+    QVERIFY(list.isEmpty());
+}
+
+void LossListTests::insertTest() {
+    LossList list;
+    list.append(seq(10), seq(12));
+    list.append(seq(20), seq(22));
+
+    // before, between and merging ranges
+    list.insert(seq(1), seq(2));
+    QCOMPARE(list.getFirstSequenceNumber(), seq(1));
+    list.insert(seq(15), seq(15));
+    QCOMPARE(list.getLength(), 9);
+    list.insert(seq(11), seq(21));
+    QCOMPARE(list.getLength(), 15);
+
+    // the ranges are 1-2 and 10-22
+    QVERIFY(list.remove(seq(2)));
+    QVERIFY(!list.remove(seq(3)));
+    QCOMPARE(list.popFirstSequenceNumber(), seq(1));
+    QCOMPARE(list.getFirstSequenceNumber(), seq(10));
+    QCOMPARE(list.getLength(), 13);
+}
+
+void LossListTests::removeTest() {
+    LossList list;
+    list.append(seq(1), seq(10));
+
+    // splits the range
+    QVERIFY(list.remove(seq(5)));
+    QVERIFY(!list.remove(seq(5)));
+    QVERIFY(list.remove(seq(1)));
+    QVERIFY(list.remove(seq(10)));
+    QCOMPARE(list.getLength(), 7);
+
+    for (int i : { 2, 3, 4, 6, 7, 8, 9 }) {
+        QCOMPARE(list.popFirstSequenceNumber(), seq(i));
+    }
+    QVERIFY(list.isEmpty());
+}
+
+void LossListTests::removeRangeTest() {
+    LossList list;
+    list.append(seq(1), seq(5));
+    list.append(seq(10), seq(15));
+    list.append(seq(20), seq(25));
+
+    // inside a single range
+    list.remove(seq(2), seq(3));
+    QCOMPARE(list.getLength(), 15);
+
+    // across ranges, truncating the first and last ones
+    list.remove(seq(5), seq(21));
+    QCOMPARE(list.getLength(), 6);
+    QCOMPARE(list.popFirstSequenceNumber(), seq(1));
+    QCOMPARE(list.popFirstSequenceNumber(), seq(4));
+    QCOMPARE(list.popFirstSequenceNumber(), seq(22));
+
+    // everything left
+    list.remove(seq(0), seq(30));
+    QVERIFY(list.isEmpty());
+}
+
+void LossListTests::sentPacketHistoryTest() {
+    SentPacketHistory history;
+    QVERIFY(history.isEmpty());
+
+    // enough packets to grow the ring a few times, with a gap
+    for (int i = 0; i < 1000; ++i) {
+        if (i != 500) {
+            history.insert(seq(i), Packet::create());
+        }
+    }
+    QVERIFY(history.find(seq(0)));
+    QVERIFY(history.find(seq(999)));
+    QVERIFY(!history.find(seq(500)));
+    QVERIFY(!history.find(seq(1000)));
+
+    history.removeUpTo(seq(499));
+    QVERIFY(!history.find(seq(499)));
+    QVERIFY(history.find(seq(501)));
+
+    // keeps wrapping around the ring
+    for (int i = 1000; i < 5000; ++i) {
+        history.insert(seq(i), Packet::create());
+        history.removeUpTo(seq(i - 100));
+    }
+    QVERIFY(!history.find(seq(4899)));
+    QVERIFY(history.find(seq(4900)));
+    QVERIFY(history.find(seq(4999)));
+
+    history.removeUpTo(seq(4999));
+    QVERIFY(history.isEmpty());
+}
+
+void LossListTests::burstLossBenchmark() {
+    static const int NUM_PACKETS = 100000;
+    static const int LOSS_PERCENT = 5;
+
+    // the same losses on every run
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 99);
+    std::vector<int> lost;
+    for (int i = 0; i < NUM_PACKETS; ++i) {
+        if (distribution(generator) < LOSS_PERCENT) {
+            lost.push_back(i);
+        }
+    }
+
+    // the re-sends are lost again and reordered, so they arrive in any order
+    auto resent = lost;
+    std::shuffle(resent.begin(), resent.end(), generator);
+
+    QBENCHMARK {
+        // receiving end: the gaps are appended as later packets arrive, then removed as the re-sends arrive
+        LossList receiverLosses;
+        int lastReceived = -1;
+        auto nextLost = lost.cbegin();
+        for (int i = 0; i < NUM_PACKETS; ++i) {
+            if (nextLost != lost.cend() && *nextLost == i) {
+                ++nextLost;
+                continue;
+            }
+            if (i > lastReceived + 1) {
+                receiverLosses.append(seq(lastReceived + 1), seq(i - 1));
+            }
+            lastReceived = i;
+        }
+        QCOMPARE(receiverLosses.getLength(), (int)lost.size());
+
+        // sending end: the NAKs are inserted as they come, and popped to be re-sent between them
+        LossList senderNAKs;
+        for (size_t i = 0; i < resent.size(); ++i) {
+            QVERIFY(receiverLosses.remove(seq(resent[i])));
+            senderNAKs.insert(seq(resent[i]), seq(resent[i]));
+            if (i % 2 == 0) {
+                senderNAKs.popFirstSequenceNumber();
+            }
+        }
+        QVERIFY(receiverLosses.isEmpty());
+
+        senderNAKs.remove(seq(0), seq(NUM_PACKETS));
+        QVERIFY(senderNAKs.isEmpty());
+    }
+}
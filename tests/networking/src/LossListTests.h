@@ -0,0 +1,30 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-23.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    void appendTest();
+    void insertTest();
+    void removeTest();
+    void removeRangeTest();
+    void sentPacketHistoryTest();
+
+    // 5% random loss over a 100k packet message, on both ends of the connection
+    void burstLossBenchmark();
+};
+
+#endif // hifi_LossListTests_h
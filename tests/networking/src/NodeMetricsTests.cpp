@@ -0,0 +1,96 @@
+//
+//  NodeMetricsTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeMetricsTests.h"
+
+#include <NodeMetrics.h>
+
+QTEST_MAIN(NodeMetricsTests)
+
+static const std::vector<quint64> BUCKETS { 10, 100, 1000 };
+
+static NodeMetrics roundTrip(const NodeMetrics& metrics) {
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << metrics;
+
+    NodeMetrics result;
+    QDataStream in(data);
+    in >> result;
+    return result;
+}
+
+void NodeMetricsTests::roundTripTest() {
+    NodeMetrics metrics;
+    metrics.setCounter("packets_total", 42.0);
+    metrics.setGauge("listeners", 3.5);
+
+    LatencyHistogram histogram;
+    histogram.record(5);
+    histogram.record(50);
+    metrics.addHistogram("frame_seconds", histogram, BUCKETS, 1.0e-6);
+
+    NodeMetrics result = roundTrip(metrics);
+    QCOMPARE(result.getMetrics().size(), 3);
+
+    auto counter = result.getMetrics().value("packets_total");
+    QCOMPARE(counter.type, NodeMetrics::Type::Counter);
+    QCOMPARE(counter.value, 42.0);
+
+    auto gauge = result.getMetrics().value("listeners");
+    QCOMPARE(gauge.type, NodeMetrics::Type::Gauge);
+    QCOMPARE(gauge.value, 3.5);
+
+    auto frames = result.getMetrics().value("frame_seconds");
+    QCOMPARE(frames.type, NodeMetrics::Type::Histogram);
+    QCOMPARE(frames.bucketBounds.size(), BUCKETS.size());
+    QCOMPARE(frames.bucketBounds[1], 100 * 1.0e-6);
+    QCOMPARE(frames.count, (quint64)2);
+}
+
+void NodeMetricsTests::histogramTest() {
+    NodeMetrics metrics;
+
+    LatencyHistogram histogram;
+    histogram.record(5);
+    histogram.record(50);
+    histogram.record(5000);
+    metrics.addHistogram("frame", histogram, BUCKETS, 1.0);
+
+    // the totals keep growing across stats windows, as Prometheus expects
+    histogram.reset();
+    histogram.record(500);
+    metrics.addHistogram("frame", histogram, BUCKETS, 1.0);
+
+    auto frames = metrics.getMetrics().value("frame");
+    QCOMPARE(frames.bucketCounts[0], (quint64)1);
+    QCOMPARE(frames.bucketCounts[1], (quint64)2);
+    QCOMPARE(frames.bucketCounts[2], (quint64)3);
+    QCOMPARE(frames.count, (quint64)4);
+    QCOMPARE(frames.value, 5555.0);
+}
+
+void NodeMetricsTests::corruptDataTest() {
+    NodeMetrics metrics;
+    metrics.setGauge("listeners", 1.0);
+
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << metrics;
+
+    // a truncated packet doesn't produce half a metric
+    data.chop(4);
+    NodeMetrics result;
+    QDataStream in(data);
+    in >> result;
+    QVERIFY(in.status() != QDataStream::Ok);
+    QVERIFY(result.isEmpty());
+}
@@ -0,0 +1,25 @@
+//
+//  NodeMetricsTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeMetricsTests_h
+#define hifi_NodeMetricsTests_h
+
+#include <QtTest/QtTest>
+
+class NodeMetricsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTripTest();
+    void histogramTest();
+    void corruptDataTest();
+};
+
+#endif // hifi_NodeMetricsTests_h
@@ -0,0 +1,91 @@
+//
+//  PacketAuthTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketAuthTests.h"
+
+#include <QtCore/QUuid>
+
+#include <PacketAuth.h>
+#include <udt/Constants.h>
+
+QTEST_MAIN(PacketAuthTests)
+
+// the key 00 01 .. 0f of the reference implementation
+static const uint64_t REFERENCE_KEY0 = 0x0706050403020100ULL;
+static const uint64_t REFERENCE_KEY1 = 0x0f0e0d0c0b0a0908ULL;
+
+static QByteArray toHex(const PacketAuth::Hash& hash) {
+    return QByteArray((const char*)hash.data(), (int)hash.size()).toHex();
+}
+
+void PacketAuthTests::referenceVectorsTest() {
+    PacketAuth packetAuth;
+    packetAuth.setKey(REFERENCE_KEY0, REFERENCE_KEY1);
+
+    // the messages are 00 01 .. of each length
+    QByteArray message;
+    for (int i = 0; i < 64; ++i) {
+        message.append((char)i);
+    }
+
+    QCOMPARE(toHex(packetAuth.calculateHash(message.constData(), 0)), QByteArray("a3817f04ba25a8e66df67214c7550293"));
+    QCOMPARE(toHex(packetAuth.calculateHash(message.constData(), 1)), QByteArray("da87c1d86b99af44347659119b22fc45"));
+    QCOMPARE(toHex(packetAuth.calculateHash(message.constData(), 7)), QByteArray("a1f1ebbed8dbc153c0b84aa61ff08239"));
+    QCOMPARE(toHex(packetAuth.calculateHash(message.constData(), 8)), QByteArray("3b62a9ba6258f5610f83e264f31497b4"));
+    QCOMPARE(toHex(packetAuth.calculateHash(message.constData(), 15)), QByteArray("5493e99933b0a8117e08ec0f97cfc3d9"));
+    QCOMPARE(toHex(packetAuth.calculateHash(message.constData(), 63)), QByteArray("5150d1772f50834a503e069a973fbd7c"));
+}
+
+void PacketAuthTests::keyTest() {
+    QByteArray payload(512, 'x');
+
+    PacketAuth packetAuth;
+    QUuid secret = QUuid::createUuid();
+    packetAuth.setKey(secret);
+    PacketAuth::Hash hash = packetAuth.calculateHash(payload.constData(), payload.size());
+    QCOMPARE(packetAuth.calculateHash(payload.constData(), payload.size()), hash);
+
+    PacketAuth otherAuth;
+    otherAuth.setKey(secret);
+    QCOMPARE(otherAuth.calculateHash(payload.constData(), payload.size()), hash);
+
+    otherAuth.setKey(QUuid::createUuid());
+    QVERIFY(otherAuth.calculateHash(payload.constData(), payload.size()) != hash);
+
+    payload[100] = 'y';
+    QVERIFY(packetAuth.calculateHash(payload.constData(), payload.size()) != hash);
+}
+
+void PacketAuthTests::hashBenchmark_data() {
+    QTest::addColumn<int>("payloadSize");
+
+    QTest::newRow("64 bytes") << 64;
+    QTest::newRow("512 bytes") << 512;
+    QTest::newRow("MTU") << (int)udt::MAX_PACKET_SIZE;
+}
+
+void PacketAuthTests::hashBenchmark() {
+    QFETCH(int, payloadSize);
+
+    QByteArray payload(payloadSize, '\0');
+    for (int i = 0; i < payloadSize; ++i) {
+        payload[i] = (char)(i * 31);
+    }
+
+    PacketAuth packetAuth;
+    packetAuth.setKey(QUuid::createUuid());
+
+    PacketAuth::Hash hash {};
+    QBENCHMARK {
+        hash = packetAuth.calculateHash(payload.constData(), payload.size());
+    }
+    QVERIFY(hash != PacketAuth::Hash {});
+}
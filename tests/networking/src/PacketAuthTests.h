@@ -0,0 +1,31 @@
+//
+//  PacketAuthTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketAuthTests_h
+#define hifi_PacketAuthTests_h
+
+#include <QtTest/QtTest>
+
+class PacketAuthTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test the hashes against the reference vectors of SipHash-2-4-128
+    void referenceVectorsTest();
+
+    // Test that the hash follows the key
+    void keyTest();
+
+    // Time the hash of a packet payload
+    void hashBenchmark_data();
+    void hashBenchmark();
+};
+
+#endif // hifi_PacketAuthTests_h
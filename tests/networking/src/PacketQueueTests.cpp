@@ -0,0 +1,103 @@
+//
+//  PacketQueueTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketQueueTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <udt/PacketList.h>
+#include <udt/PacketQueue.h>
+
+QTEST_MAIN(PacketQueueTests)
+
+using namespace udt;
+
+static std::unique_ptr<Packet> createPacket(uint32_t id) {
+    auto packet = Packet::create();
+    packet->writePrimitive(id);
+    return packet;
+}
+
+static std::unique_ptr<PacketList> createPacketList(uint32_t firstID, int numPackets) {
+    auto packetList = PacketList::create(PacketType::Unknown);
+    for (int i = 0; i < numPackets; ++i) {
+        packetList->writePrimitive(firstID + i);
+        packetList->closeCurrentPacket();
+    }
+    return packetList;
+}
+
+static uint32_t getID(const Packet& packet) {
+    uint32_t id;
+    memcpy(&id, packet.getPayload(), sizeof(id));
+    return id;
+}
+
+void PacketQueueTests::concurrentQueueTest() {
+    const int NUM_THREADS = 4;
+    const int NUM_PACKETS_PER_THREAD = 1000;
+
+    PacketQueue queue;
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < NUM_THREADS; ++thread) {
+        threads.emplace_back([&queue, thread] {
+            for (int i = 0; i < NUM_PACKETS_PER_THREAD; ++i) {
+                queue.queuePacket(createPacket((thread << 16) | i));
+            }
+        });
+    }
+
+    // take them meanwhile
+    std::vector<int> nextIndex(NUM_THREADS, 0);
+    int numTaken = 0;
+    bool isInOrder = true;
+    auto takeAvailable = [&] {
+        while (auto packet = queue.takePacket()) {
+            uint32_t id = getID(*packet);
+            int thread = id >> 16;
+            isInOrder &= (int)(id & 0xffff) == nextIndex[thread];
+            ++nextIndex[thread];
+            ++numTaken;
+        }
+    };
+    while (numTaken < NUM_THREADS * NUM_PACKETS_PER_THREAD / 2) {
+        takeAvailable();
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    takeAvailable();
+
+    QVERIFY(isInOrder);
+    QCOMPARE(numTaken, NUM_THREADS * NUM_PACKETS_PER_THREAD);
+    QVERIFY(queue.isEmpty());
+}
+
+void PacketQueueTests::channelRoundRobinTest() {
+    PacketQueue queue;
+    queue.queuePacket(createPacket(0));
+    queue.queuePacketList(createPacketList(10, 3));
+    queue.queuePacketList(createPacketList(20, 2));
+    QVERIFY(!queue.isEmpty());
+
+    // the main channel, then each packet list in turn until they run out
+    std::vector<uint32_t> expectedIDs { 0, 10, 20, 11, 21, 12 };
+    for (auto expectedID : expectedIDs) {
+        auto packet = queue.takePacket();
+        QVERIFY(packet);
+        QCOMPARE(getID(*packet), expectedID);
+    }
+
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.takePacket());
+}
@@ -0,0 +1,27 @@
+//
+//  PacketQueueTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketQueueTests_h
+#define hifi_PacketQueueTests_h
+
+#include <QtTest/QtTest>
+
+class PacketQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the packets queued from several threads are all taken, each thread's in order
+    void concurrentQueueTest();
+
+    // Test that the channels are sent from in turn
+    void channelRoundRobinTest();
+};
+
+#endif // hifi_PacketQueueTests_h
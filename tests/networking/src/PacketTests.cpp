@@ -18,7 +18,7 @@ QTEST_MAIN(PacketTests)
 
 std::unique_ptr<NLPacket> copyToReadPacket(std::unique_ptr<NLPacket>& packet) {
     auto size = packet->getDataSize();
-    auto data = std::unique_ptr<char[]>(new char[size]);
+    auto data = udt::PacketBufferPool::allocate(size);
     memcpy(data.get(), packet->getData(), size);
     return NLPacket::fromReceivedPacket(std::move(data), size, HifiSockAddr());
 }
@@ -180,3 +180,24 @@ void PacketTests::primitiveTest() {
     QCOMPARE(recvPacket->peekPrimitive(&noValue), 0);
     QCOMPARE(recvPacket->readPrimitive(&noValue), 0);
 }
+
+void PacketTests::bufferPoolRecycleTest() {
+    // make sure this thread has a free buffer cached
+    NLPacket::create(PacketType::Unknown);
+
+    auto statsBefore = udt::PacketBufferPool::getStats();
+    {
+        auto packet = NLPacket::create(PacketType::Unknown);
+        auto readPacket = copyToReadPacket(packet);
+        QCOMPARE(readPacket->getType(), PacketType::Unknown);
+    }
+    auto statsAfter = udt::PacketBufferPool::getStats();
+
+    // the new packet picks up the buffer freed by the first one
+    QVERIFY(statsAfter.hits > statsBefore.hits);
+
+    // requests larger than a datagram bypass the pool
+    auto oversizedBuffer = udt::PacketBufferPool::allocate(udt::PacketBufferPool::BUFFER_SIZE + 1);
+    QVERIFY(oversizedBuffer);
+    QCOMPARE(udt::PacketBufferPool::getStats().oversized, statsAfter.oversized + 1);
+}
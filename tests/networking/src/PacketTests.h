@@ -36,6 +36,9 @@ private slots:
 
     // Test set/get packet type
     void packetTypeTest();
+
+    // Test that packet buffers are recycled through the PacketBufferPool
+    void bufferPoolRecycleTest();
 };
 
 #endif // hifi_PacketTests_h
@@ -0,0 +1,95 @@
+//
+//  TimerWheelTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-22.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <udt/TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using namespace udt;
+using Wheel = TimerWheel<int>;
+using std::chrono::microseconds;
+
+static const microseconds RESOLUTION { 100 };
+
+void TimerWheelTests::dueTest() {
+    auto start = p_high_resolution_clock::now();
+    Wheel wheel(RESOLUTION, start);
+    QVERIFY(wheel.isEmpty());
+
+    // timers already due expire on the next advance
+    wheel.schedule(1, start);
+    wheel.schedule(2, start - microseconds(1000));
+    QVERIFY(!wheel.isEmpty());
+
+    std::vector<int> expired;
+    wheel.advance(start, expired);
+    QCOMPARE(expired.size(), (size_t)2);
+    QVERIFY(wheel.isEmpty());
+}
+
+void TimerWheelTests::orderTest() {
+    auto start = p_high_resolution_clock::now();
+    Wheel wheel(RESOLUTION, start);
+
+    for (int i = 1; i <= 10; ++i) {
+        wheel.schedule(i, start + i * RESOLUTION);
+    }
+
+    // timers never expire early
+    std::vector<int> expired;
+    for (int i = 1; i <= 10; ++i) {
+        wheel.advance(start + i * RESOLUTION - microseconds(1), expired);
+        QCOMPARE(expired.size(), (size_t)(i - 1));
+        wheel.advance(start + i * RESOLUTION, expired);
+        QCOMPARE(expired.size(), (size_t)i);
+        QCOMPARE(expired.back(), i);
+    }
+    QVERIFY(wheel.isEmpty());
+}
+
+void TimerWheelTests::cascadeTest() {
+    auto start = p_high_resolution_clock::now();
+    Wheel wheel(RESOLUTION, start);
+
+    // one timer per level, plus one past the range of the wheel
+    const int64_t ticks[] = { 3, Wheel::NUM_SLOTS + 5, Wheel::NUM_SLOTS * Wheel::NUM_SLOTS + 7,
+                              Wheel::NUM_SLOTS * Wheel::NUM_SLOTS * Wheel::NUM_SLOTS + 11 };
+    for (int i = 0; i < 4; ++i) {
+        wheel.schedule(i, start + ticks[i] * RESOLUTION);
+    }
+
+    std::vector<int> expired;
+    for (int i = 0; i < 4; ++i) {
+        wheel.advance(start + (ticks[i] - 1) * RESOLUTION, expired);
+        QCOMPARE(expired.size(), (size_t)i);
+        wheel.advance(start + ticks[i] * RESOLUTION, expired);
+        QCOMPARE(expired.size(), (size_t)(i + 1));
+        QCOMPARE(expired.back(), i);
+    }
+    QVERIFY(wheel.isEmpty());
+}
+
+void TimerWheelTests::nextCheckTest() {
+    auto start = p_high_resolution_clock::now();
+    Wheel wheel(RESOLUTION, start);
+    QVERIFY(wheel.getNextCheck() == Wheel::TimePoint::max());
+
+    auto when = start + 10 * RESOLUTION;
+    wheel.schedule(1, when);
+    QVERIFY(wheel.getNextCheck() == when);
+
+    // a timer further away than the first level only needs a check when the level wraps around
+    Wheel farWheel(RESOLUTION, start);
+    farWheel.schedule(1, start + 1000 * RESOLUTION);
+    QVERIFY(farWheel.getNextCheck() == start + Wheel::NUM_SLOTS * RESOLUTION);
+}
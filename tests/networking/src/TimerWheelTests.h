@@ -0,0 +1,26 @@
+//
+//  TimerWheelTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2021-03-22.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheelTests_h
+#define hifi_TimerWheelTests_h
+
+#include <QtTest/QtTest>
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+private slots:
+    void dueTest();
+    void orderTest();
+    void cascadeTest();
+    void nextCheckTest();
+};
+
+#endif // hifi_TimerWheelTests_h
@@ -0,0 +1,104 @@
+//
+//  EntityInterpolationBufferTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityInterpolationBufferTests.h"
+
+#include <EntityInterpolationBuffer.h>
+#include <SharedUtil.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(EntityInterpolationBufferTests)
+
+static const quint64 START = 10 * USECS_PER_SECOND;
+static const quint64 INTERVAL = USECS_PER_SECOND / 10;
+static const float EPSILON = 0.0001f;
+
+static EntityInterpolationBuffer::Snapshot makeSnapshot(quint64 timestamp, const glm::vec3& velocity) {
+    EntityInterpolationBuffer::Snapshot snapshot;
+    snapshot.timestamp = timestamp;
+    snapshot.position = velocity * ((float)(timestamp - START) / (float)USECS_PER_SECOND);
+    snapshot.rotation = glm::quat();
+    snapshot.velocity = velocity;
+    return snapshot;
+}
+
+void EntityInterpolationBufferTests::interpolatesBetweenSnapshots() {
+    EntityInterpolationBuffer buffer;
+    glm::vec3 velocity(1.0f, 0.0f, 2.0f);
+    for (int i = 0; i < 4; i++) {
+        quint64 timestamp = START + i * INTERVAL;
+        buffer.addSnapshot(makeSnapshot(timestamp, velocity), timestamp, QUuid());
+    }
+
+    // the curve of a constant velocity is the straight line
+    quint64 now = START + 2 * INTERVAL + INTERVAL / 2 + buffer.getDelay();
+    EntityInterpolationBuffer::Snapshot result;
+    float extrapolationTime;
+    QCOMPARE(buffer.sample(now, result, extrapolationTime), true);
+    QCOMPARE(extrapolationTime, 0.0f);
+    QCOMPARE_WITH_ABS_ERROR(result.position, velocity * 0.25f, EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(result.velocity, velocity, EPSILON);
+}
+
+void EntityInterpolationBufferTests::extrapolatesPastNewestSnapshot() {
+    EntityInterpolationBuffer buffer;
+    glm::vec3 velocity(0.0f, -1.0f, 0.0f);
+    buffer.addSnapshot(makeSnapshot(START, velocity), START, QUuid());
+    buffer.addSnapshot(makeSnapshot(START + INTERVAL, velocity), START + INTERVAL, QUuid());
+
+    quint64 now = START + 3 * INTERVAL + buffer.getDelay();
+    EntityInterpolationBuffer::Snapshot result;
+    float extrapolationTime;
+    QCOMPARE(buffer.sample(now, result, extrapolationTime), true);
+    QCOMPARE(result.timestamp, START + INTERVAL);
+    QCOMPARE_WITH_ABS_ERROR(extrapolationTime, 0.2f, EPSILON);
+}
+
+void EntityInterpolationBufferTests::delayFollowsUpdateInterval() {
+    EntityInterpolationBuffer buffer;
+    QCOMPARE(buffer.getDelay(), EntityInterpolationBuffer::MIN_DELAY);
+
+    // updates that arrive regularly are played back an interval late
+    for (int i = 0; i < 20; i++) {
+        quint64 timestamp = START + i * INTERVAL;
+        buffer.addSnapshot(makeSnapshot(timestamp, glm::vec3(1.0f)), timestamp, QUuid());
+    }
+    QCOMPARE(buffer.getDelay(), INTERVAL);
+
+    // and rare ones no more than the maximum
+    EntityInterpolationBuffer rareBuffer;
+    for (int i = 0; i < 20; i++) {
+        quint64 timestamp = START + i * USECS_PER_SECOND;
+        rareBuffer.addSnapshot(makeSnapshot(timestamp, glm::vec3(1.0f)), timestamp, QUuid());
+    }
+    QCOMPARE(rareBuffer.getDelay(), EntityInterpolationBuffer::MAX_DELAY);
+}
+
+void EntityInterpolationBufferTests::parentChangeClearsSnapshots() {
+    EntityInterpolationBuffer buffer;
+    buffer.addSnapshot(makeSnapshot(START, glm::vec3(1.0f)), START, QUuid());
+    buffer.addSnapshot(makeSnapshot(START + INTERVAL, glm::vec3(1.0f)), START + INTERVAL, QUuid());
+
+    QUuid parentID = QUuid::createUuid();
+    EntityInterpolationBuffer::Snapshot snapshot = makeSnapshot(START + 2 * INTERVAL, glm::vec3(0.0f));
+    buffer.addSnapshot(snapshot, START + 2 * INTERVAL, parentID);
+
+    EntityInterpolationBuffer::Snapshot result;
+    float extrapolationTime;
+    QCOMPARE(buffer.sample(START, result, extrapolationTime), true);
+    QCOMPARE(result.timestamp, snapshot.timestamp);
+
+    buffer.clear();
+    QCOMPARE(buffer.isEmpty(), true);
+    QCOMPARE(buffer.sample(START, result, extrapolationTime), false);
+}
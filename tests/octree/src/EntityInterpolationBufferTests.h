@@ -0,0 +1,27 @@
+//
+//  EntityInterpolationBufferTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityInterpolationBufferTests_h
+#define hifi_EntityInterpolationBufferTests_h
+
+#include <QtTest/QtTest>
+
+class EntityInterpolationBufferTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void interpolatesBetweenSnapshots();
+    void extrapolatesPastNewestSnapshot();
+    void delayFollowsUpdateInterval();
+    void parentChangeClearsSnapshots();
+};
+
+#endif // hifi_EntityInterpolationBufferTests_h
@@ -0,0 +1,115 @@
+//
+//  EntityTreeAccountingTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeAccountingTests.h"
+
+#include <vector>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <MemoryAccounting.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntityTreeAccountingTests)
+
+// The entities counted on "entities.items" have to follow every way the map of a tree is emptied.
+
+static const int NUM_ENTITIES = 100;
+
+static int64_t countedEntities() {
+    for (const auto& usage : MemoryAccounting::getInstance().sample()) {
+        if (usage.name == "entities.items") {
+            return usage.count;
+        }
+    }
+    return 0;
+}
+
+static EntityTreePointer buildTree(bool isServer, std::vector<EntityItemID>& ids) {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(isServer);
+    ids.resize(NUM_ENTITIES);
+    tree->withWriteLock([&] {
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(glm::vec3((float)i, 0.0f, 0.0f));
+            properties.setDimensions(glm::vec3(0.5f));
+            ids[i] = EntityItemID(QUuid::createUuid());
+            tree->addEntity(ids[i], properties);
+        }
+    });
+    return tree;
+}
+
+void EntityTreeAccountingTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer);
+}
+
+void EntityTreeAccountingTests::cleanupTestCase() {
+    DependencyManager::destroy<NodeList>();
+    DependencyManager::destroy<AddressManager>();
+    DependencyManager::destroy<AccountManager>();
+}
+
+void EntityTreeAccountingTests::testDelete() {
+    int64_t baseline = countedEntities();
+    std::vector<EntityItemID> ids;
+    auto tree = buildTree(true, ids);
+    QCOMPARE(countedEntities(), baseline + NUM_ENTITIES);
+
+    tree->withWriteLock([&] {
+        tree->deleteEntitiesByID(ids, true);
+    });
+    QCOMPARE(countedEntities(), baseline);
+}
+
+void EntityTreeAccountingTests::testEraseAll() {
+    int64_t baseline = countedEntities();
+    std::vector<EntityItemID> ids;
+    auto tree = buildTree(true, ids);
+    QCOMPARE(countedEntities(), baseline + NUM_ENTITIES);
+
+    // as the content is replaced or reloaded
+    tree->eraseAllOctreeElements();
+    QCOMPARE(countedEntities(), baseline);
+
+    // and again on the same tree, as each domain switch or reload does
+    tree->withWriteLock([&] {
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setDimensions(glm::vec3(0.5f));
+            tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+        }
+    });
+    QCOMPARE(countedEntities(), baseline + NUM_ENTITIES);
+    tree->eraseAllOctreeElements();
+    QCOMPARE(countedEntities(), baseline);
+}
+
+void EntityTreeAccountingTests::testEraseDomain() {
+    int64_t baseline = countedEntities();
+    std::vector<EntityItemID> ids;
+    // as an interface switching domains, none of the entities are its own
+    auto tree = buildTree(false, ids);
+    QCOMPARE(countedEntities(), baseline + NUM_ENTITIES);
+
+    tree->eraseDomainAndNonOwnedEntities();
+    QCOMPARE(countedEntities(), baseline);
+}
@@ -0,0 +1,29 @@
+//
+//  EntityTreeAccountingTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeAccountingTests_h
+#define hifi_EntityTreeAccountingTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeAccountingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testDelete();
+    void testEraseAll();
+    void testEraseDomain();
+};
+
+#endif // hifi_EntityTreeAccountingTests_h
@@ -0,0 +1,315 @@
+//
+//  EntityTreeBenchmarks.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBenchmarks.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <DiffTraversal.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <NodeList.h>
+#include <OctreeBinaryPersist.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+
+QTEST_MAIN(EntityTreeBenchmarks)
+
+// The work of an entity server on the trees of large domains: the edits, the traversals of the entities to send to a
+// view, and the persistence of the tree. Run with -o <file>,xml (or csv) to keep the results.
+
+static const float WORLD_SIZE = 1000.0f;    // meters, the side of the cube the entities are spread in
+static const float MIN_DIMENSION = 0.1f;
+static const float MAX_DIMENSION = 10.0f;
+static const int EDITED_ENTITY_STEP = 10;    // one entity in ten is edited each frame
+static const int NUM_QUERIES = 100;          // sphere queries each frame, as scripts looking around
+static const float QUERY_RADIUS = 10.0f;
+
+static EntityTreePointer newTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+static EntityTreePointer buildTree(int numEntities, std::vector<EntityItemID>& ids) {
+    std::mt19937 generator(numEntities);
+    std::uniform_real_distribution<float> position(-0.5f * WORLD_SIZE, 0.5f * WORLD_SIZE);
+    std::uniform_real_distribution<float> dimension(MIN_DIMENSION, MAX_DIMENSION);
+
+    auto tree = newTree();
+    ids.resize(numEntities);
+    tree->withWriteLock([&] {
+        for (int i = 0; i < numEntities; ++i) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(glm::vec3(position(generator), position(generator), position(generator)));
+            properties.setDimensions(glm::vec3(dimension(generator), dimension(generator), dimension(generator)));
+            ids[i] = EntityItemID(QUuid::createUuid());
+            tree->addEntity(ids[i], properties);
+        }
+    });
+    return tree;
+}
+
+static void addRows() {
+    QTest::addColumn<int>("numEntities");
+
+    QTest::newRow("10k entities") << 10000;
+    QTest::newRow("100k entities") << 100000;
+    QTest::newRow("500k entities") << 500000;
+}
+
+static void addPersistRows() {
+    QTest::addColumn<int>("numEntities");
+    QTest::addColumn<bool>("isBinary");
+
+    for (int numEntities : { 10000, 100000, 500000 }) {
+        QString name = QString("%1k entities").arg(numEntities / 1000);
+        QTest::newRow(qPrintable(name + " json.gz")) << numEntities << false;
+        QTest::newRow(qPrintable(name + " bin")) << numEntities << true;
+    }
+}
+
+static QByteArray writeTree(const EntityTreePointer& tree, bool isBinary) {
+    QByteArray data;
+    if (isBinary) {
+        // as Octree::writeToBinaryFile, to memory
+        QDataStream out(&data, QIODevice::WriteOnly);
+        OctreeBinaryPersist::Header header;
+        header.version = tree->expectedVersion();
+        OctreeBinaryPersist::writeHeader(out, header);
+        tree->writeToBinary(out);
+        OctreeBinaryPersist::writeEnd(out);
+    } else {
+        tree->toJSON(&data, nullptr, true);
+    }
+    return data;
+}
+
+void EntityTreeBenchmarks::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer);
+}
+
+void EntityTreeBenchmarks::cleanupTestCase() {
+    DependencyManager::destroy<NodeList>();
+    DependencyManager::destroy<AddressManager>();
+    DependencyManager::destroy<AccountManager>();
+}
+
+void EntityTreeBenchmarks::addBenchmark_data() {
+    addRows();
+}
+
+void EntityTreeBenchmarks::addBenchmark() {
+    QFETCH(int, numEntities);
+
+    std::vector<EntityItemID> ids;
+    EntityTreePointer tree;
+    QBENCHMARK {
+        tree = buildTree(numEntities, ids);
+    }
+    QVERIFY(tree->findEntityByEntityItemID(ids[0]));
+}
+
+void EntityTreeBenchmarks::editBenchmark_data() {
+    addRows();
+}
+
+void EntityTreeBenchmarks::editBenchmark() {
+    QFETCH(int, numEntities);
+
+    std::vector<EntityItemID> ids;
+    auto tree = buildTree(numEntities, ids);
+
+    // the edited entities move by a meter back and forth, some of them across the elements of the tree
+    int frame = 0;
+    QBENCHMARK {
+        float offset = (frame++ % 2) ? -1.0f : 1.0f;
+        tree->withWriteLock([&] {
+            for (int i = 0; i < numEntities; i += EDITED_ENTITY_STEP) {
+                auto entity = tree->findEntityByEntityItemID(ids[i]);
+                EntityItemProperties properties;
+                properties.setPosition(entity->getWorldPosition() + glm::vec3(offset, 0.0f, 0.0f));
+                tree->updateEntity(ids[i], properties);
+            }
+        });
+    }
+}
+
+void EntityTreeBenchmarks::deleteBenchmark_data() {
+    addRows();
+}
+
+void EntityTreeBenchmarks::deleteBenchmark() {
+    QFETCH(int, numEntities);
+
+    std::vector<EntityItemID> ids;
+    auto tree = buildTree(numEntities, ids);
+
+    // a delete can't be repeated on the same tree
+    QBENCHMARK_ONCE {
+        tree->withWriteLock([&] {
+            tree->deleteEntitiesByID(ids, true);
+        });
+    }
+    QVERIFY(!tree->findEntityByEntityItemID(ids[0]));
+}
+
+void EntityTreeBenchmarks::traversalBenchmark_data() {
+    addRows();
+}
+
+void EntityTreeBenchmarks::traversalBenchmark() {
+    QFETCH(int, numEntities);
+
+    std::vector<EntityItemID> ids;
+    auto tree = buildTree(numEntities, ids);
+
+    // the first, full, traversal for an agent that just connected, as EntityTreeSendThread runs it
+    ViewFrustum viewFrustum;
+    viewFrustum.setPosition(glm::vec3(0.0f));
+    viewFrustum.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+    viewFrustum.calculate();
+
+    DiffTraversal::View view;
+    view.viewFrustums.push_back(ConicalViewFrustum(viewFrustum));
+
+    int numScanned = 0;
+    QBENCHMARK {
+        DiffTraversal traversal;
+        traversal.setScanCallback([&](DiffTraversal::VisibleElement& next) {
+            next.element->forEachEntity([&](EntityItemPointer entity) {
+                if (view.viewFrustums[0].intersects(entity->getQueryAACube())) {
+                    ++numScanned;
+                }
+            });
+        });
+        view.startTime = usecTimestampNow();
+        traversal.prepareNewTraversal(view, tree->getRoot(), true);
+        while (!traversal.finished()) {
+            traversal.traverse(std::numeric_limits<uint64_t>::max());
+        }
+    }
+    QVERIFY(numScanned > 0);
+}
+
+void EntityTreeBenchmarks::queryBenchmark_data() {
+    QTest::addColumn<int>("numEntities");
+    QTest::addColumn<bool>("isGrid");
+
+    for (int numEntities : { 10000, 100000, 500000 }) {
+        QString name = QString("%1k entities").arg(numEntities / 1000);
+        QTest::newRow(qPrintable(name + " octree")) << numEntities << false;
+        QTest::newRow(qPrintable(name + " grid")) << numEntities << true;
+    }
+}
+
+void EntityTreeBenchmarks::queryBenchmark() {
+    QFETCH(int, numEntities);
+    QFETCH(bool, isGrid);
+
+    std::vector<EntityItemID> ids;
+    auto tree = buildTree(numEntities, ids);
+
+    std::mt19937 generator(numEntities);
+    std::uniform_real_distribution<float> position(-0.5f * WORLD_SIZE, 0.5f * WORLD_SIZE);
+    std::vector<glm::vec3> centers;
+    for (int i = 0; i < NUM_QUERIES; ++i) {
+        centers.emplace_back(position(generator), position(generator), position(generator));
+    }
+
+    auto runQueries = [&] {
+        std::vector<QVector<QUuid>> results(centers.size());
+        tree->withReadLock([&] {
+            for (size_t i = 0; i < centers.size(); ++i) {
+                tree->evalEntitiesInSphere(centers[i], QUERY_RADIUS, PickFilter(), results[i]);
+            }
+        });
+        return results;
+    };
+
+    // both indexes find the same entities
+    auto octreeResults = runQueries();
+    tree->setSpatialIndex(EntityTree::SpatialIndex::Grid);
+    auto gridResults = runQueries();
+    for (size_t i = 0; i < centers.size(); ++i) {
+        std::sort(octreeResults[i].begin(), octreeResults[i].end());
+        std::sort(gridResults[i].begin(), gridResults[i].end());
+        QCOMPARE(gridResults[i], octreeResults[i]);
+    }
+    tree->setSpatialIndex(isGrid ? EntityTree::SpatialIndex::Grid : EntityTree::SpatialIndex::Octree);
+
+    // the edited entities move as in editBenchmark, then the queries run on the moved entities
+    int frame = 0;
+    QBENCHMARK {
+        float offset = (frame++ % 2) ? -1.0f : 1.0f;
+        tree->withWriteLock([&] {
+            for (int i = 0; i < numEntities; i += EDITED_ENTITY_STEP) {
+                auto entity = tree->findEntityByEntityItemID(ids[i]);
+                EntityItemProperties properties;
+                properties.setPosition(entity->getWorldPosition() + glm::vec3(offset, 0.0f, 0.0f));
+                tree->updateEntity(ids[i], properties);
+            }
+        });
+        runQueries();
+    }
+}
+
+void EntityTreeBenchmarks::writeBenchmark_data() {
+    addPersistRows();
+}
+
+void EntityTreeBenchmarks::writeBenchmark() {
+    QFETCH(int, numEntities);
+    QFETCH(bool, isBinary);
+
+    std::vector<EntityItemID> ids;
+    auto tree = buildTree(numEntities, ids);
+
+    QByteArray data;
+    QBENCHMARK {
+        data = writeTree(tree, isBinary);
+    }
+    QVERIFY(!data.isEmpty());
+}
+
+void EntityTreeBenchmarks::readBenchmark_data() {
+    addPersistRows();
+}
+
+void EntityTreeBenchmarks::readBenchmark() {
+    QFETCH(int, numEntities);
+    QFETCH(bool, isBinary);
+
+    QByteArray data;
+    {
+        std::vector<EntityItemID> ids;
+        data = writeTree(buildTree(numEntities, ids), isBinary);
+    }
+
+    // the entities are loaded in a new tree each time, as the persist thread does it on startup (the teardown of the
+    // trees is timed too)
+    QBENCHMARK {
+        auto tree = newTree();
+        QVERIFY(tree->readFromByteArray(QString(), data));
+    }
+}
@@ -0,0 +1,40 @@
+//
+//  EntityTreeBenchmarks.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBenchmarks_h
+#define hifi_EntityTreeBenchmarks_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void addBenchmark_data();
+    void addBenchmark();
+    void editBenchmark_data();
+    void editBenchmark();
+    void deleteBenchmark_data();
+    void deleteBenchmark();
+    void traversalBenchmark_data();
+    void traversalBenchmark();
+    void queryBenchmark_data();
+    void queryBenchmark();
+    void writeBenchmark_data();
+    void writeBenchmark();
+    void readBenchmark_data();
+    void readBenchmark();
+};
+
+#endif // hifi_EntityTreeBenchmarks_h
@@ -0,0 +1,113 @@
+//
+//  OctreeEntitiesFileParserTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEntitiesFileParserTests.h"
+
+#include <QBuffer>
+#include <QUuid>
+
+#include <OctreeEntitiesFileParser.h>
+
+QTEST_MAIN(OctreeEntitiesFileParserTests)
+
+// enough entities for the document to be read in several chunks
+static const int NUM_ENTITIES = 5000;
+
+static QByteArray makeDocument(int numEntities, const QByteArray& userData) {
+    QByteArray document = "{\n  \"DataVersion\": 7,\n  \"Entities\": [";
+    for (int i = 0; i < numEntities; ++i) {
+        if (i > 0) {
+            document += ",";
+        }
+        document += "\n    {\"id\": \"" + QUuid::createUuid().toByteArray() + "\", \"name\": \"entity " +
+            QByteArray::number(i) + "\", \"userData\": \"" + userData + "\"}";
+    }
+    document += "],\n  \"Id\": \"{5c4a9d25-4cbf-4a34-9a3e-8c3fb5e59e0d}\",\n  \"Version\": 133\n}\n";
+    return document;
+}
+
+void OctreeEntitiesFileParserTests::testStreamedMatchesString() {
+    QByteArray document = makeDocument(NUM_ENTITIES, QByteArray(400, 'x'));
+
+    OctreeEntitiesFileParser stringParser;
+    stringParser.setEntitiesString(document);
+    QVariantMap parsed;
+    QVERIFY(stringParser.parseEntities(parsed));
+    QVariantList entities = parsed["Entities"].toList();
+    QCOMPARE(entities.size(), NUM_ENTITIES);
+
+    QBuffer buffer(&document);
+    buffer.open(QIODevice::ReadOnly);
+    OctreeEntitiesFileParser streamParser;
+    streamParser.setEntitiesDevice(&buffer);
+    QVariantMap header;
+    int index = 0;
+    QVERIFY(streamParser.parseEntities(header, [&](QJsonObject& entity) {
+        bool isSame = entity == entities[index].toJsonObject();
+        ++index;
+        return isSame;
+    }));
+    QCOMPARE(index, NUM_ENTITIES);
+    QCOMPARE(streamParser.getNumEntities(), NUM_ENTITIES);
+    QCOMPARE(streamParser.getBytesRead(), (int64_t)document.size());
+
+    QVERIFY(!header.contains("Entities"));
+    QCOMPARE(header["DataVersion"].toInt(), 7);
+    QCOMPARE(header["Version"].toInt(), 133);
+    QCOMPARE(header["Id"].toUuid(), parsed["Id"].toUuid());
+}
+
+void OctreeEntitiesFileParserTests::testSkippedEntities() {
+    QByteArray document = makeDocument(NUM_ENTITIES, QByteArray(400, 'x'));
+    QBuffer buffer(&document);
+    buffer.open(QIODevice::ReadOnly);
+
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesDevice(&buffer);
+    QVariantMap header;
+    QVERIFY(parser.parseEntities(header, nullptr));
+    QCOMPARE(parser.getNumEntities(), NUM_ENTITIES);
+    QCOMPARE(header["Version"].toInt(), 133);
+}
+
+void OctreeEntitiesFileParserTests::testStringsAcrossChunks() {
+    // braces and escaped quotes in the strings don't end the entities, wherever the chunks are cut
+    QByteArray userData = "{\\\"a\\\": \\\"}}\\\\\\\"{\\\"}";
+    QByteArray document = makeDocument(NUM_ENTITIES * 4, userData);
+    QBuffer buffer(&document);
+    buffer.open(QIODevice::ReadOnly);
+
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesDevice(&buffer);
+    QVariantMap header;
+    int numEntities = 0;
+    bool isUserDataKept = true;
+    QVERIFY(parser.parseEntities(header, [&](QJsonObject& entity) {
+        isUserDataKept = isUserDataKept && entity["userData"].toString() == "{\"a\": \"}}\\\"{\"}";
+        ++numEntities;
+        return true;
+    }));
+    QCOMPARE(numEntities, NUM_ENTITIES * 4);
+    QVERIFY(isUserDataKept);
+}
+
+void OctreeEntitiesFileParserTests::testUnterminatedEntity() {
+    QByteArray document = makeDocument(NUM_ENTITIES, QByteArray(400, 'x'));
+    document.chop(200);
+    QBuffer buffer(&document);
+    buffer.open(QIODevice::ReadOnly);
+
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesDevice(&buffer);
+    QVariantMap header;
+    QVERIFY(!parser.parseEntities(header, nullptr));
+    QVERIFY(!parser.getErrorString().empty());
+}
@@ -0,0 +1,27 @@
+//
+//  OctreeEntitiesFileParserTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeEntitiesFileParserTests_h
+#define hifi_OctreeEntitiesFileParserTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeEntitiesFileParserTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testStreamedMatchesString();
+    void testSkippedEntities();
+    void testStringsAcrossChunks();
+    void testUnterminatedEntity();
+};
+
+#endif // hifi_OctreeEntitiesFileParserTests_h
@@ -11,11 +11,15 @@
 
 #include "ViewFrustumTests.h"
 
+#include <random>
+
 #include <glm/glm.hpp>
 
+#include <CullingBatch.h>
 #include <GLMHelpers.h>
 #include <NumericalConstants.h>
 #include <ViewFrustum.h>
+#include <shared/ConicalViewFrustum.h>
 
 //#include <StreamUtils.h>
 #include <test-utils/GLMTestUtils.h>
@@ -1345,3 +1349,69 @@ void ViewFrustumTests::testBoxIntersectsKeyhole() {
     box.setBox(boxCenter - halfScaleOffset, boxScale);
     QCOMPARE(view.boxIntersectsKeyhole(box), false); // outside back
 }
+
+void ViewFrustumTests::testCullingBatches() {
+    float aspect = 1.0f;
+    float fovX = PI / 2.0f;
+    float nearClip = 1.0f;
+    float farClip = 100.0f;
+    float holeRadius = 10.0f;
+
+    ViewFrustum view;
+    view.setProjection(glm::perspective(fovX, aspect, nearClip, farClip));
+    view.setPosition(glm::vec3(12.3f, 4.56f, 89.7f));
+    view.setOrientation(glm::angleAxis(PI / 7.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))));
+    view.setCenterRadius(holeRadius);
+    view.calculate();
+    ConicalViewFrustum cone(view);
+    cone.calculate();
+
+    // shapes all around the view, inside, outside and on the planes, the batches give the same answers as the shapes alone
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> offset(-1.5f * farClip, 1.5f * farClip);
+    std::uniform_real_distribution<float> size(0.1f, 20.0f);
+    const float MIN_ANGULAR_SIZE = 0.01f;
+    const int NUM_BATCHES = 100;
+
+    for (int batch = 0; batch < NUM_BATCHES; ++batch) {
+        CullingBoxBatch boxes;
+        CullingSphereBatch spheres;
+        AACube cubes[CULLING_BATCH_SIZE];
+        // the last batches aren't full
+        int count = CULLING_BATCH_SIZE - batch % 3;
+        for (int i = 0; i < count; ++i) {
+            glm::vec3 position = view.getPosition() + glm::vec3(offset(generator), offset(generator), offset(generator));
+            cubes[i] = AACube(position, size(generator));
+            boxes.add(cubes[i].getCorner(), cubes[i].getScale());
+            spheres.add(cubes[i].calcCenter(), 0.5f * SQRT_THREE * cubes[i].getScale());
+        }
+
+        uint8_t outsideMask;
+        uint8_t intersectMask;
+        view.calculateBoxesFrustumIntersection(boxes, outsideMask, intersectMask);
+        uint8_t inFrustumMask = view.spheresIntersectFrustum(spheres);
+        uint8_t inConeMask = cone.intersects(spheres, MIN_ANGULAR_SIZE);
+
+        for (int i = 0; i < CULLING_BATCH_SIZE; ++i) {
+            uint8_t bit = 1 << i;
+            if (i >= count) {
+                QVERIFY(!(outsideMask & bit) && !(intersectMask & bit) && !(inFrustumMask & bit) && !(inConeMask & bit));
+                continue;
+            }
+
+            auto intersection = view.calculateCubeFrustumIntersection(cubes[i]);
+            QCOMPARE((bool)(outsideMask & bit), intersection == ViewFrustum::OUTSIDE);
+            QCOMPARE((bool)(intersectMask & bit), intersection == ViewFrustum::INTERSECT);
+
+            glm::vec3 center(spheres.x[i], spheres.y[i], spheres.z[i]);
+            float radius = spheres.radius[i];
+            QCOMPARE((bool)(inFrustumMask & bit), view.sphereIntersectsFrustum(center, radius));
+
+            glm::vec3 relativePosition = center - cone.getPosition();
+            float distance = glm::length(relativePosition);
+            bool inCone = cone.getAngularSize(distance, radius) > MIN_ANGULAR_SIZE &&
+                          cone.intersects(relativePosition, distance, radius);
+            QCOMPARE((bool)(inConeMask & bit), inCone);
+        }
+    }
+}
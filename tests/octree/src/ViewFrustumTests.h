@@ -27,6 +27,7 @@ private slots:
     void testSphereIntersectsKeyhole();
     void testCubeIntersectsKeyhole();
     void testBoxIntersectsKeyhole();
+    void testCullingBatches();
 };
 
 #endif // hifi_ViewFruxtumTests_h
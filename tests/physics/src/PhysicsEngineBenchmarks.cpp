@@ -0,0 +1,148 @@
+//
+//  PhysicsEngineBenchmarks.cpp
+//  tests/physics/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsEngineBenchmarks.h"
+
+#include <cmath>
+
+#include <BulletUtil.h>
+#include <ObjectMotionState.h>
+#include <PhysicsCollisionGroups.h>
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <ShapeInfo.h>
+#include <ShapeManager.h>
+
+QTEST_MAIN(PhysicsEngineBenchmarks)
+
+// The steps of the simulation of an entity server with a lot of dynamic bodies, piled up on a floor so that they collide.
+// Run with -o <file>,xml (or csv) to keep the results.
+
+static const float BODY_SIZE = 0.5f;        // meters
+static const float BODY_SPACING = 0.6f;     // meters, between the centers of the bodies, they touch once they fall
+static const float FLOOR_SIZE = 1000.0f;    // meters
+static const int NUM_WARMUP_STEPS = 60;     // for the bodies to start colliding
+
+// The state of a body that isn't an entity or an avatar.
+class BenchmarkMotionState : public ObjectMotionState {
+public:
+    BenchmarkMotionState(const btCollisionShape* shape, const glm::vec3& position, bool isStatic) :
+        ObjectMotionState(shape),
+        _position(position),
+        _isStatic(isStatic)
+    {
+        _type = MOTIONSTATE_TYPE_DETAILED;
+    }
+
+    void getWorldTransform(btTransform& worldTrans) const override {
+        worldTrans.setOrigin(glmToBullet(_position - ObjectMotionState::getWorldOffset()));
+        worldTrans.setRotation(glmToBullet(_rotation));
+    }
+
+    void setWorldTransform(const btTransform& worldTrans) override {
+        _position = bulletToGLM(worldTrans.getOrigin()) + ObjectMotionState::getWorldOffset();
+        _rotation = bulletToGLM(worldTrans.getRotation());
+    }
+
+    uint32_t getIncomingDirtyFlags() const override { return 0; }
+    void clearIncomingDirtyFlags(uint32_t mask = DIRTY_PHYSICS_FLAGS) override {}
+
+    PhysicsMotionType computePhysicsMotionType() const override {
+        return _isStatic ? MOTION_TYPE_STATIC : MOTION_TYPE_DYNAMIC;
+    }
+
+    bool isMoving() const override { return !_isStatic; }
+
+    float getObjectRestitution() const override { return 0.5f; }
+    float getObjectFriction() const override { return 0.5f; }
+    float getObjectLinearDamping() const override { return 0.0f; }
+    float getObjectAngularDamping() const override { return 0.0f; }
+
+    glm::vec3 getObjectPosition() const override { return _position; }
+    glm::quat getObjectRotation() const override { return _rotation; }
+    glm::vec3 getObjectLinearVelocity() const override { return glm::vec3(0.0f); }
+    glm::vec3 getObjectAngularVelocity() const override { return glm::vec3(0.0f); }
+    glm::vec3 getObjectGravity() const override { return _isStatic ? glm::vec3(0.0f) : glm::vec3(0.0f, -9.8f, 0.0f); }
+
+    const QUuid getObjectID() const override { return _id; }
+    QUuid getSimulatorID() const override { return QUuid(); }
+    ShapeType getShapeType() const override { return SHAPE_TYPE_BOX; }
+
+    void computeCollisionGroupAndMask(int32_t& group, int32_t& mask) const override {
+        if (_isStatic) {
+            group = BULLET_COLLISION_GROUP_STATIC;
+            mask = BULLET_COLLISION_MASK_STATIC;
+        } else {
+            group = BULLET_COLLISION_GROUP_DYNAMIC;
+            mask = BULLET_COLLISION_MASK_DYNAMIC;
+        }
+    }
+
+private:
+    QUuid _id { QUuid::createUuid() };
+    glm::vec3 _position;
+    glm::quat _rotation;
+    bool _isStatic;
+};
+
+void PhysicsEngineBenchmarks::stepSimulationBenchmark_data() {
+    QTest::addColumn<int>("numBodies");
+
+    QTest::newRow("1k bodies") << 1000;
+    QTest::newRow("10k bodies") << 10000;
+    QTest::newRow("50k bodies") << 50000;
+}
+
+void PhysicsEngineBenchmarks::stepSimulationBenchmark() {
+    QFETCH(int, numBodies);
+
+    ShapeManager shapeManager;
+    ObjectMotionState::setShapeManager(&shapeManager);
+
+    PhysicsEngine engine(glm::vec3(0.0f));
+    engine.init();
+
+    ShapeInfo floorInfo;
+    floorInfo.setBox(glm::vec3(0.5f * FLOOR_SIZE, 0.5f, 0.5f * FLOOR_SIZE));
+    ShapeInfo bodyInfo;
+    bodyInfo.setBox(glm::vec3(0.5f * BODY_SIZE));
+
+    // a square of columns of bodies, ten high, over the floor
+    const int COLUMN_HEIGHT = 10;
+    int side = (int)std::ceil(std::sqrt((float)numBodies / COLUMN_HEIGHT));
+    VectorOfMotionStates motionStates;
+    motionStates.push_back(new BenchmarkMotionState(shapeManager.getShape(floorInfo), glm::vec3(0.0f, -0.5f, 0.0f), true));
+    for (int i = 0; i < numBodies; ++i) {
+        int column = i / COLUMN_HEIGHT;
+        glm::vec3 position((column % side - 0.5f * side) * BODY_SPACING, (i % COLUMN_HEIGHT + 1) * BODY_SPACING,
+                           (column / side - 0.5f * side) * BODY_SPACING);
+        motionStates.push_back(new BenchmarkMotionState(shapeManager.getShape(bodyInfo), position, false));
+    }
+    engine.addObjects(motionStates);
+
+    for (int i = 0; i < NUM_WARMUP_STEPS; ++i) {
+        engine.stepSimulation(PHYSICS_ENGINE_FIXED_SUBSTEP);
+    }
+
+    QBENCHMARK {
+        engine.stepSimulation(PHYSICS_ENGINE_FIXED_SUBSTEP);
+    }
+
+    SetOfMotionStates objects;
+    for (auto motionState : motionStates) {
+        objects.insert(motionState);
+    }
+    engine.removeSetOfObjects(objects);
+    for (auto motionState : motionStates) {
+        delete motionState;
+    }
+    ObjectMotionState::setShapeManager(nullptr);
+}
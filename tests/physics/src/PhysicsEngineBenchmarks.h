@@ -0,0 +1,25 @@
+//
+//  PhysicsEngineBenchmarks.h
+//  tests/physics/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsEngineBenchmarks_h
+#define hifi_PhysicsEngineBenchmarks_h
+
+#include <QtTest/QtTest>
+
+class PhysicsEngineBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void stepSimulationBenchmark_data();
+    void stepSimulationBenchmark();
+};
+
+#endif // hifi_PhysicsEngineBenchmarks_h
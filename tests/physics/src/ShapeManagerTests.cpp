@@ -244,3 +244,48 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::requestCompoundShape() {
+    // a compound of two tetrahedral hulls
+    QVector<glm::vec3> tetrahedron;
+    tetrahedron.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
+    tetrahedron.push_back(glm::vec3(1.0f, -1.0f, -1.0f));
+    tetrahedron.push_back(glm::vec3(-1.0f, 1.0f, -1.0f));
+    tetrahedron.push_back(glm::vec3(-1.0f, -1.0f, 1.0f));
+
+    ShapeInfo::PointCollection pointCollection;
+    int numHulls = 2;
+    for (int i = 0; i < numHulls; ++i) {
+        ShapeInfo::PointList pointList;
+        glm::vec3 offset((float)(2 * i), 0.0f, 0.0f);
+        for (const auto& point : tetrahedron) {
+            pointList.push_back(point + offset);
+        }
+        pointCollection.push_back(pointList);
+    }
+
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(2.0f, 1.0f, 1.0f));
+    info.setPointCollection(pointCollection);
+
+    // the compound is built on a worker
+    ShapeManager shapeManager;
+    QVERIFY(shapeManager.requestShape(info) == nullptr);
+    QCOMPARE(shapeManager.getWorkRequestCount(), (uint32_t)1);
+
+    // asking again while it is being built doesn't start another worker
+    QVERIFY(shapeManager.requestShape(info) == nullptr);
+    QTRY_COMPARE(shapeManager.getWorkDeliveryCount(), (uint32_t)1);
+
+    // the delivered shape waits unreferenced for the object that asked for it
+    QCOMPARE(shapeManager.getNumShapes(), 1);
+    QCOMPARE(shapeManager.getNumReferences(info), 0);
+    const btCollisionShape* shape = shapeManager.requestShape(info);
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    QCOMPARE(shapeManager.getNumReferences(info), 1);
+
+    shapeManager.releaseShape(shape);
+    shapeManager.collectGarbage();
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+}
@@ -119,10 +119,60 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void testChunkedPersist() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    // enough similar frames of changing sizes to fill several chunks, and to be delta coded
+    auto writeClip = Clip::newClip();
+    const int FRAME_COUNT = 2000;
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        QByteArray data(100 + (i / 100) % 3, (char)(i / 10));
+        data[0] = (char)i;
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(i * 10), data));
+    }
+
+    for (bool chunked : { true, false }) {
+        QFile outputFile(fileName);
+        QVERIFY(outputFile.open(QFile::Truncate | QFile::WriteOnly));
+        QVERIFY(writeClip->write(outputFile, chunked));
+        outputFile.close();
+
+        auto readClip = Clip::fromFile(fileName);
+        QVERIFY(readClip != Clip::Pointer());
+        QVERIFY(readClip->frameCount() == (size_t)FRAME_COUNT);
+        QVERIFY(readClip->duration() == writeClip->duration());
+
+        readClip->seek(0);
+        writeClip->seek(0);
+        for (auto readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame(); readFrame && writeFrame;
+            readFrame = readClip->nextFrame(), writeFrame = writeClip->nextFrame()) {
+            QVERIFY(readFrame->type == writeFrame->type);
+            QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+            QVERIFY(readFrame->data == writeFrame->data);
+        }
+
+        // seeking back into an earlier chunk
+        const Frame::Time SEEK_TIME = 5000;
+        readClip->seekFrameTime(SEEK_TIME);
+        writeClip->seekFrameTime(SEEK_TIME);
+        auto readFrame = readClip->nextFrame();
+        auto writeFrame = writeClip->nextFrame();
+        QVERIFY(readFrame && writeFrame);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
+    testChunkedPersist();
     testClipOrdering();
 }
@@ -163,6 +163,21 @@ void DependencyManagerTests::testDependencyManager() {
     QCOMPARE(DependencyManager::isSet<A>(), false);
 }
 
+void DependencyManagerTests::testGetRef() {
+    auto first = DependencyManager::set<B>();
+    B& firstRef = DependencyManager::getRef<B>();
+    QCOMPARE(&firstRef, first.data());
+    QCOMPARE(&DependencyManager::getRef<B>(), first.data());
+    first.clear();
+
+    // the reference is taken again once the instance is replaced
+    auto second = DependencyManager::set<B>();
+    QCOMPARE(&DependencyManager::getRef<B>(), second.data());
+    second.clear();
+    DependencyManager::destroy<B>();
+    QCOMPARE(DependencyManager::isSet<B>(), false);
+}
+
 static void addDeps() {
 
 #define CLASS(NAME) DependencyManager::set<NAME>();
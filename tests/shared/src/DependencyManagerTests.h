@@ -15,6 +15,7 @@ class DependencyManagerTests : public QObject {
     Q_OBJECT
 private slots:
     void testDependencyManager();
+    void testGetRef();
     void testDependencyManagerMultiThreaded();
 };
 
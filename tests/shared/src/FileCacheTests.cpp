@@ -156,6 +156,43 @@ void FileCacheTests::testWipe() {
     QCOMPARE(getCacheDirectorySize(), (size_t)0);
 }
 
+void FileCacheTests::testReusedFiles() {
+    auto cache = makeFileCache(_testDir.path());
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)0);
+
+    // files 0 to 4 are used again after being written, files 5 to 9 are written after them but not used again
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(cache->writeFile(TEST_DATA.data(), FileCache::Metadata(getFileKey(i), TEST_DATA.size())).get());
+        QThread::msleep(10);
+    }
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(cache->getFile(getFileKey(i)).get());
+        QThread::msleep(10);
+    }
+    for (int i = 5; i < 10; ++i) {
+        QVERIFY(cache->writeFile(TEST_DATA.data(), FileCache::Metadata(getFileKey(i), TEST_DATA.size())).get());
+        QThread::msleep(10);
+    }
+    QCOMPARE(cache->getNumCachedFiles(), (size_t)10);
+
+    // the new files push out the ones that were only used once, even though they are more recent
+    for (int i = 10; i < 15; ++i) {
+        QVERIFY(cache->writeFile(TEST_DATA.data(), FileCache::Metadata(getFileKey(i), TEST_DATA.size())).get());
+        QThread::msleep(10);
+    }
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(cache->getFile(getFileKey(i)).get());
+    }
+    for (int i = 5; i < 10; ++i) {
+        QVERIFY(!cache->getFile(getFileKey(i)).get());
+    }
+
+    // the files are restored from the index as the cache is created, without waiting for the scan of the folder
+    cache.reset();
+    cache = makeFileCache(_testDir.path());
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
+}
 
 void FileCacheTests::cleanupTestCase() {
 }
@@ -21,6 +21,7 @@ private slots:
     void testFreeSpacePreservation();
     void cleanupTestCase();
     void testWipe();
+    void testReusedFiles();
 
 private:
     size_t getFreeSpace() const;
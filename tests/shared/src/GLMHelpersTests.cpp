@@ -73,6 +73,23 @@ static void testQuatCompression(glm::quat testQuat) {
     QCOMPARE_WITH_ABS_ERROR(q.w, testQuat.w, MAX_COMPONENT_ERROR);
 }
 
+static void testFourByteQuatCompression(glm::quat testQuat) {
+
+    float MAX_COMPONENT_ERROR = 1.8e-3f;
+
+    glm::quat q;
+    uint8_t bytes[4];
+    packOrientationQuatToFourBytes(bytes, testQuat);
+    unpackOrientationQuatFromFourBytes(bytes, q);
+    if (glm::dot(q, testQuat) < 0.0f) {
+        q = -q;
+    }
+    QCOMPARE_WITH_ABS_ERROR(q.x, testQuat.x, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.y, testQuat.y, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.z, testQuat.z, MAX_COMPONENT_ERROR);
+    QCOMPARE_WITH_ABS_ERROR(q.w, testQuat.w, MAX_COMPONENT_ERROR);
+}
+
 void GLMHelpersTests::testSixByteOrientationCompression() {
     const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
     const glm::quat ROT_Y_180 = glm::angleAxis(PI, glm::vec3(0.0f, 1.0, 0.0f));
@@ -105,6 +122,24 @@ void GLMHelpersTests::testSixByteOrientationCompression() {
     testQuatCompression(-(ROT_Z_30 * ROT_X_90 * ROT_Y_180));
 }
 
+void GLMHelpersTests::testFourByteOrientationCompression() {
+    const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::quat ROT_Y_180 = glm::angleAxis(PI, glm::vec3(0.0f, 1.0, 0.0f));
+    const glm::quat ROT_Z_30 = glm::angleAxis(PI / 6.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+
+    testFourByteQuatCompression(glm::quat());
+    testFourByteQuatCompression(ROT_X_90);
+    testFourByteQuatCompression(ROT_Y_180);
+    testFourByteQuatCompression(ROT_Z_30);
+    testFourByteQuatCompression(ROT_X_90 * ROT_Y_180 * ROT_Z_30);
+    testFourByteQuatCompression(ROT_Y_180 * ROT_Z_30 * ROT_X_90);
+    testFourByteQuatCompression(-ROT_X_90);
+    testFourByteQuatCompression(-(ROT_Z_30 * ROT_X_90 * ROT_Y_180));
+
+    // every component the same size, the worst case for the omitted one
+    testFourByteQuatCompression(glm::quat(0.5f, 0.5f, -0.5f, 0.5f));
+}
+
 #define LOOPS 500000
 
 void GLMHelpersTests::testSimd() {
@@ -0,0 +1,69 @@
+//
+//  LatencyHistogramTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-11.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LatencyHistogramTests.h"
+
+#include <LatencyHistogram.h>
+
+QTEST_MAIN(LatencyHistogramTests)
+
+void LatencyHistogramTests::testPercentiles() {
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.getPercentile(50.0), (uint64_t)0);
+
+    // small values are exact
+    for (uint64_t i = 1; i <= 10; ++i) {
+        histogram.record(i);
+    }
+    QCOMPARE(histogram.getCount(), (uint64_t)10);
+    QCOMPARE(histogram.getMax(), (uint64_t)10);
+    QCOMPARE(histogram.getMean(), 5.5);
+    QCOMPARE(histogram.getPercentile(50.0), (uint64_t)5);
+    QCOMPARE(histogram.getPercentile(90.0), (uint64_t)9);
+    QCOMPARE(histogram.getPercentile(100.0), (uint64_t)10);
+
+    histogram.reset();
+    QCOMPARE(histogram.getCount(), (uint64_t)0);
+    QCOMPARE(histogram.getMax(), (uint64_t)0);
+}
+
+void LatencyHistogramTests::testPrecision() {
+    // every value is reported within one sub-bucket of itself
+    for (uint64_t value = 1; value < 10000000; value = value * 3 + 7) {
+        LatencyHistogram histogram;
+        histogram.record(value);
+        histogram.record(LatencyHistogram::MAX_VALUE + 1);
+
+        uint64_t reported = histogram.getPercentile(50.0);
+        QVERIFY(reported >= value);
+        QVERIFY(reported - value <= value / LatencyHistogram::SUB_BUCKETS);
+    }
+
+    // and out of range values are clamped into the last bucket
+    LatencyHistogram histogram;
+    histogram.record(LatencyHistogram::MAX_VALUE * 2);
+    QCOMPARE(histogram.getPercentile(50.0), LatencyHistogram::MAX_VALUE);
+}
+
+void LatencyHistogramTests::testMerge() {
+    LatencyHistogram fast;
+    LatencyHistogram slow;
+    for (int i = 0; i < 99; ++i) {
+        fast.record(100);
+    }
+    slow.record(10000);
+
+    fast.merge(slow);
+    QCOMPARE(fast.getCount(), (uint64_t)100);
+    QCOMPARE(fast.getMax(), (uint64_t)10000);
+    QVERIFY(fast.getPercentile(99.0) <= 100 + 100 / LatencyHistogram::SUB_BUCKETS);
+    QCOMPARE(fast.getPercentile(99.9), (uint64_t)10000);
+}
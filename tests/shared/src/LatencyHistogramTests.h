@@ -0,0 +1,26 @@
+//
+//  LatencyHistogramTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-11.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LatencyHistogramTests_h
+#define hifi_LatencyHistogramTests_h
+
+#include <QtTest/QtTest>
+
+class LatencyHistogramTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testPercentiles();
+    void testPrecision();
+    void testMerge();
+};
+
+#endif // hifi_LatencyHistogramTests_h
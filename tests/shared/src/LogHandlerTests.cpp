@@ -0,0 +1,95 @@
+//
+//  LogHandlerTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LogHandlerTests.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <LogHandler.h>
+
+QTEST_MAIN(LogHandlerTests)
+
+static const int NUM_THREADS = 4;
+static const int NUM_LINES = 3000;    // more than a queue holds, the threads have to write some out themselves
+
+class TestSink : public LogSink {
+public:
+    TestSink(const QString& marker) : _marker(marker) { LogHandler::getInstance().addSink(this); }
+    ~TestSink() { LogHandler::getInstance().removeSink(this); }
+
+    void writeLog(const std::vector<QString>& lines) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto& line : lines) {
+            if (line.contains(_marker)) {
+                _lines.push_back(line);
+            }
+        }
+    }
+
+    std::vector<QString> getLines() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _lines;
+    }
+
+private:
+    const QString _marker;
+    std::mutex _mutex;
+    std::vector<QString> _lines;
+};
+
+void LogHandlerTests::testThreadsInOrder() {
+    TestSink sink("ordered");
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([i] {
+            for (int line = 0; line < NUM_LINES; ++line) {
+                LogHandler::getInstance().queueMessage(LogDebug, QMessageLogContext(),
+                                                       QString("ordered %1 %2").arg(i).arg(line));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    LogHandler::getInstance().flush();
+
+    auto lines = sink.getLines();
+    QCOMPARE((int)lines.size(), NUM_THREADS * NUM_LINES);
+
+    // the lines of each thread come out in the order they were logged
+    std::vector<int> nextLines(NUM_THREADS, 0);
+    for (const auto& line : lines) {
+        auto words = line.trimmed().split(' ');
+        int thread = words[words.size() - 2].toInt();
+        int number = words[words.size() - 1].toInt();
+        QCOMPARE(number, nextLines[thread]);
+        ++nextLines[thread];
+    }
+}
+
+void LogHandlerTests::testRepeatedMessage() {
+    TestSink sink("repeated");
+    int messageID = LogHandler::getInstance().newRepeatedMessageID();
+    for (int i = 0; i < 3; ++i) {
+        LogHandler::getInstance().printRepeatedMessage(messageID, LogWarning, QMessageLogContext(), "repeated message");
+    }
+    LogHandler::getInstance().flush();
+
+    // the repeats are held until the records are flushed
+    auto lines = sink.getLines();
+    int numPrinted = (int)std::count_if(lines.begin(), lines.end(), [](const QString& line) {
+        return !line.contains("repeated log entries");
+    });
+    QCOMPARE(numPrinted, 1);
+}
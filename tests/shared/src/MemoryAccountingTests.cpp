@@ -0,0 +1,81 @@
+//
+//  MemoryAccountingTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MemoryAccountingTests.h"
+
+#include <MemoryAccounting.h>
+
+QTEST_MAIN(MemoryAccountingTests)
+
+static bool findUsage(const QString& name, MemoryAccounting::Usage& found) {
+    for (const auto& usage : MemoryAccounting::getInstance().sample()) {
+        if (usage.name == name) {
+            found = usage;
+            return true;
+        }
+    }
+    return false;
+}
+
+void MemoryAccountingTests::testTags() {
+    auto& accounting = MemoryAccounting::getInstance();
+    int index = accounting.registerTag("test.tags");
+    QVERIFY(index >= 0);
+    QCOMPARE(accounting.registerTag("test.tags"), index);
+
+    MemoryTag tag("test.tags");
+    tag.allocated(1000);
+    tag.allocated(500);
+    tag.freed(1000);
+    tag.resized(500, 700);
+
+    MemoryAccounting::Usage usage;
+    QVERIFY(findUsage("test.tags", usage));
+    QCOMPARE(usage.bytes, (int64_t)700);
+    QCOMPARE(usage.peakBytes, (int64_t)1500);
+    QCOMPARE(usage.count, (int64_t)1);
+}
+
+void MemoryAccountingTests::testSources() {
+    auto& accounting = MemoryAccounting::getInstance();
+    std::atomic<int64_t> size { 4096 };
+    int id = accounting.addSource("test.source", [&size](int64_t& bytes, int64_t& count) {
+        bytes = size;
+        count = 2;
+    });
+
+    MemoryAccounting::Usage usage;
+    QVERIFY(findUsage("test.source", usage));
+    QCOMPARE(usage.bytes, (int64_t)4096);
+    QCOMPARE(usage.count, (int64_t)2);
+
+    // the peak is kept across the samples
+    size = 1024;
+    QVERIFY(findUsage("test.source", usage));
+    QCOMPARE(usage.bytes, (int64_t)1024);
+    QCOMPARE(usage.peakBytes, (int64_t)4096);
+
+    accounting.removeSource(id);
+    QVERIFY(!findUsage("test.source", usage));
+}
+
+void MemoryAccountingTests::testJson() {
+    MemoryTag tag("test.json");
+    tag.allocated(256, 4);
+
+    QJsonObject json = MemoryAccounting::getInstance().toJson();
+    QJsonObject entry = json["usage"].toObject()["test.json"].toObject();
+    QCOMPARE(entry["bytes"].toInt(), 256);
+    QCOMPARE(entry["count"].toInt(), 4);
+    QVERIFY(json["accounted_bytes"].toDouble() >= 256.0);
+
+    tag.freed(256, 4);
+}
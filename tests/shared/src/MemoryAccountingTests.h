@@ -0,0 +1,26 @@
+//
+//  MemoryAccountingTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MemoryAccountingTests_h
+#define hifi_MemoryAccountingTests_h
+
+#include <QtTest/QtTest>
+
+class MemoryAccountingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testTags();
+    void testSources();
+    void testJson();
+};
+
+#endif // hifi_MemoryAccountingTests_h
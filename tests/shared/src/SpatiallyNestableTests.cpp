@@ -0,0 +1,126 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <QtCore/QHash>
+
+#include <GLMHelpers.h>
+#include <SpatiallyNestable.h>
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+// The world transforms of the children are cached, these check that they follow what they are relative to.
+
+const float EPSILON = 0.0001f;
+
+class TestNestable : public SpatiallyNestable {
+public:
+    TestNestable() : SpatiallyNestable(NestableType::Entity, QUuid::createUuid()) {}
+    virtual ~TestNestable() {}
+};
+
+using TestNestablePointer = std::shared_ptr<TestNestable>;
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    void add(const SpatiallyNestablePointer& nestable) { _nestables[nestable->getID()] = nestable; }
+
+    virtual SpatiallyNestableWeakPointer find(QUuid parentID, bool& success, SpatialParentTree* entityTree) const override {
+        auto it = _nestables.find(parentID);
+        success = it != _nestables.end() && !it.value().expired();
+        return success ? it.value() : SpatiallyNestableWeakPointer();
+    }
+
+private:
+    QHash<QUuid, SpatiallyNestableWeakPointer> _nestables;
+};
+
+static TestNestablePointer makeNestable(const glm::vec3& position) {
+    auto nestable = std::make_shared<TestNestable>();
+    nestable->setLocalPosition(position);
+    DependencyManager::get<TestParentFinder>()->add(nestable);
+    return nestable;
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    DependencyManager::set<TestParentFinder>();
+    DependencyManager::registerInheritance<SpatialParentFinder, TestParentFinder>();
+}
+
+void SpatiallyNestableTests::testParentMoves() {
+    auto parent = makeNestable(glm::vec3(1.0f, 0.0f, 0.0f));
+    auto child = makeNestable(glm::vec3(0.0f, 1.0f, 0.0f));
+    child->setParentID(parent->getID());
+
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 0.0f), EPSILON);
+    // from the cache
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 0.0f), EPSILON);
+
+    parent->setWorldPosition(glm::vec3(2.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(2.0f, 1.0f, 0.0f), EPSILON);
+
+    parent->setWorldOrientation(glm::angleAxis(PI_OVER_TWO, Vectors::UNIT_Z));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 0.0f, 0.0f), EPSILON);
+
+    parent->setSNScale(glm::vec3(2.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 0.0f, 0.0f), EPSILON);
+
+    child->setLocalPosition(glm::vec3(0.0f, 0.0f, 1.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(2.0f, 0.0f, 2.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::testGrandparentMoves() {
+    auto grandparent = makeNestable(glm::vec3(0.0f));
+    auto parent = makeNestable(glm::vec3(1.0f, 0.0f, 0.0f));
+    auto child = makeNestable(glm::vec3(1.0f, 0.0f, 0.0f));
+    parent->setParentID(grandparent->getID());
+    child->setParentID(parent->getID());
+
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(2.0f, 0.0f, 0.0f), EPSILON);
+
+    grandparent->setLocalPosition(glm::vec3(0.0f, 0.0f, 3.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(2.0f, 0.0f, 3.0f), EPSILON);
+
+    // a change that doesn't tell physics still reaches the descendants
+    grandparent->setLocalTransformAndVelocities(Transform(), glm::vec3(0.0f), glm::vec3(0.0f));
+    QCOMPARE_WITH_ABS_ERROR(parent->getWorldPosition(), glm::vec3(1.0f, 0.0f, 0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(2.0f, 0.0f, 0.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::testReparenting() {
+    auto first = makeNestable(glm::vec3(1.0f, 0.0f, 0.0f));
+    auto second = makeNestable(glm::vec3(0.0f, 5.0f, 0.0f));
+    auto child = makeNestable(glm::vec3(0.0f, 0.0f, 1.0f));
+
+    child->setParentID(first->getID());
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 0.0f, 1.0f), EPSILON);
+
+    child->setParentID(second->getID());
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 5.0f, 1.0f), EPSILON);
+
+    child->setParentID(QUuid());
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 0.0f, 1.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::testParentDeleted() {
+    auto parent = makeNestable(glm::vec3(1.0f, 0.0f, 0.0f));
+    auto child = makeNestable(glm::vec3(0.0f, 1.0f, 0.0f));
+    child->setParentID(parent->getID());
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 0.0f), EPSILON);
+
+    parent.reset();
+    bool success = true;
+    child->getWorldPosition(success);
+    QVERIFY(!success);
+}
@@ -0,0 +1,28 @@
+//
+//  SpatiallyNestableTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SpatiallyNestableTests_h
+#define hifi_SpatiallyNestableTests_h
+
+#include <QtTest/QtTest>
+
+class SpatiallyNestableTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testParentMoves();
+    void testGrandparentMoves();
+    void testReparenting();
+    void testParentDeleted();
+};
+
+#endif // hifi_SpatiallyNestableTests_h
@@ -0,0 +1,54 @@
+//
+//  StringPoolTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StringPoolTests.h"
+
+#include <StringPool.h>
+
+QTEST_MAIN(StringPoolTests)
+
+void StringPoolTests::testIntern() {
+    auto& pool = StringPool::getInstance();
+
+    // two strings of the same value, each decoded in its own buffer, share the first one once interned
+    QString url = QStringLiteral("https://example.com/models/chair.fbx");
+    QString first = pool.intern(QString(url.constData(), url.size()));
+    QString second = pool.intern(QString(url.constData(), url.size()));
+    QCOMPARE(first, url);
+    QCOMPARE(second, url);
+    QVERIFY(first.constData() == second.constData());
+
+    QString other = pool.intern(QStringLiteral("https://example.com/models/table.fbx"));
+    QVERIFY(other.constData() != first.constData());
+
+    // the empty and the long strings are left as they are
+    QVERIFY(pool.intern(QString()).isEmpty());
+    QString longString(StringPool::MAX_INTERNED_LENGTH + 1, QChar('a'));
+    QString longFirst = pool.intern(QString(longString.constData(), longString.size()));
+    QString longSecond = pool.intern(QString(longString.constData(), longString.size()));
+    QCOMPARE(longFirst, longSecond);
+    QVERIFY(longFirst.constData() != longSecond.constData());
+}
+
+void StringPoolTests::testPrune() {
+    auto& pool = StringPool::getInstance();
+
+    // the values nothing holds on any more are dropped as the pool grows, the others are kept
+    QString kept = pool.intern(QStringLiteral("https://example.com/scripts/kept.js"));
+    const int NUM_STRINGS = 10000;
+    for (int i = 0; i < NUM_STRINGS; ++i) {
+        pool.intern(QString("https://example.com/textures/%1.png").arg(i));
+    }
+    QVERIFY(pool.size() < NUM_STRINGS);
+
+    QString keptAgain = pool.intern(QString("https://example.com/scripts/kept.js"));
+    QVERIFY(keptAgain.constData() == kept.constData());
+}
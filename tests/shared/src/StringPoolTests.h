@@ -0,0 +1,25 @@
+//
+//  StringPoolTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_StringPoolTests_h
+#define hifi_StringPoolTests_h
+
+#include <QtTest/QtTest>
+
+class StringPoolTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIntern();
+    void testPrune();
+};
+
+#endif // hifi_StringPoolTests_h
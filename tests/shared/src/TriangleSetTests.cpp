@@ -0,0 +1,149 @@
+//
+//  TriangleSetTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleSetTests.h"
+
+#include <float.h>
+#include <random>
+
+#include <GLMHelpers.h>
+#include <TriangleSet.h>
+
+QTEST_MAIN(TriangleSetTests)
+
+static const int NUM_TRIANGLES = 2000;
+static const int NUM_PICKS = 500;
+static const float DISTANCE_EPSILON = 1.0e-4f;
+
+static std::vector<Triangle> makeTriangles(std::mt19937& generator) {
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+    std::vector<Triangle> triangles;
+    for (int i = 0; i < NUM_TRIANGLES; i++) {
+        glm::vec3 v0(position(generator), position(generator), position(generator));
+        glm::vec3 v1 = v0 + glm::vec3(offset(generator), offset(generator), offset(generator));
+        glm::vec3 v2 = v0 + glm::vec3(offset(generator), offset(generator), offset(generator));
+        triangles.push_back({ v0, v1, v2 });
+    }
+    return triangles;
+}
+
+static glm::vec3 makeDirection(std::mt19937& generator) {
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    glm::vec3 direction;
+    do {
+        direction = glm::vec3(component(generator), component(generator), component(generator));
+    } while (glm::length(direction) < 0.1f);
+    return glm::normalize(direction);
+}
+
+void TriangleSetTests::testEmptySet() {
+    TriangleSet triangleSet;
+    float distance = 1.0f;
+    BoxFace face;
+    Triangle triangle;
+    glm::vec3 direction(0.0f, 0.0f, -1.0f);
+    QVERIFY(!triangleSet.findRayIntersection(glm::vec3(0.0f), direction, 1.0f / direction, distance, face, triangle, true));
+    QVERIFY(!triangleSet.findRayIntersection(glm::vec3(0.0f), direction, 1.0f / direction, distance, face, triangle, false));
+    QVERIFY(!triangleSet.findParabolaIntersection(glm::vec3(0.0f), direction, glm::vec3(0.0f, -1.0f, 0.0f), distance, face,
+        triangle, true));
+}
+
+void TriangleSetTests::testCoarseIntersection() {
+    TriangleSet triangleSet;
+    triangleSet.insert({ glm::vec3(-1.0f, -1.0f, -5.0f), glm::vec3(1.0f, -1.0f, -5.0f), glm::vec3(0.0f, 1.0f, -5.0f) });
+
+    // without precision the distance to the bounds given by the caller stands for the triangles
+    float distance = 3.0f;
+    BoxFace face;
+    Triangle triangle;
+    glm::vec3 direction(0.0f, 0.0f, -1.0f);
+    QVERIFY(triangleSet.findRayIntersection(glm::vec3(0.0f), direction, 1.0f / direction, distance, face, triangle, false));
+    QCOMPARE(distance, 3.0f);
+
+    QVERIFY(triangleSet.findRayIntersection(glm::vec3(0.0f), direction, 1.0f / direction, distance, face, triangle, true));
+    QCOMPARE(distance, 5.0f);
+}
+
+void TriangleSetTests::testRayIntersectionMatchesTriangles() {
+    std::mt19937 generator(1);
+    auto triangles = makeTriangles(generator);
+    TriangleSet triangleSet;
+    for (const auto& triangle : triangles) {
+        triangleSet.insert(triangle);
+    }
+
+    std::uniform_real_distribution<float> position(-12.0f, 12.0f);
+    int numHits = 0;
+    for (int i = 0; i < NUM_PICKS; i++) {
+        glm::vec3 origin(position(generator), position(generator), position(generator));
+        glm::vec3 direction = makeDirection(generator);
+        bool allowBackface = (i % 2) == 0;
+
+        float expectedDistance = FLT_MAX;
+        for (const auto& triangle : triangles) {
+            float distance;
+            if (findRayTriangleIntersection(origin, direction, triangle, distance, allowBackface)) {
+                expectedDistance = glm::min(expectedDistance, distance);
+            }
+        }
+
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        bool hit = triangleSet.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, true,
+            allowBackface);
+        QCOMPARE(hit, expectedDistance < FLT_MAX);
+        if (hit) {
+            numHits++;
+            QVERIFY(fabsf(distance - expectedDistance) < DISTANCE_EPSILON);
+        }
+    }
+    QVERIFY(numHits > 0);
+}
+
+void TriangleSetTests::testParabolaIntersectionMatchesTriangles() {
+    std::mt19937 generator(2);
+    auto triangles = makeTriangles(generator);
+    TriangleSet triangleSet;
+    for (const auto& triangle : triangles) {
+        triangleSet.insert(triangle);
+    }
+
+    std::uniform_real_distribution<float> position(-12.0f, 12.0f);
+    const glm::vec3 acceleration(0.0f, -2.0f, 0.0f);
+    int numHits = 0;
+    for (int i = 0; i < NUM_PICKS; i++) {
+        glm::vec3 origin(position(generator), position(generator), position(generator));
+        glm::vec3 velocity = 4.0f * makeDirection(generator);
+        bool allowBackface = (i % 2) == 0;
+
+        float expectedDistance = FLT_MAX;
+        for (const auto& triangle : triangles) {
+            float distance;
+            if (findParabolaTriangleIntersection(origin, velocity, acceleration, triangle, distance, allowBackface)) {
+                expectedDistance = glm::min(expectedDistance, distance);
+            }
+        }
+
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        bool hit = triangleSet.findParabolaIntersection(origin, velocity, acceleration, distance, face, triangle, true,
+            allowBackface);
+        QCOMPARE(hit, expectedDistance < FLT_MAX);
+        if (hit) {
+            numHits++;
+            QVERIFY(fabsf(distance - expectedDistance) < DISTANCE_EPSILON);
+        }
+    }
+    QVERIFY(numHits > 0);
+}
@@ -0,0 +1,26 @@
+//
+//  TriangleSetTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TriangleSetTests_h
+#define hifi_TriangleSetTests_h
+
+#include <QtTest/QtTest>
+
+class TriangleSetTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testEmptySet();
+    void testCoarseIntersection();
+    void testRayIntersectionMatchesTriangles();
+    void testParabolaIntersectionMatchesTriangles();
+};
+
+#endif // hifi_TriangleSetTests_h
@@ -0,0 +1,128 @@
+//
+//  SpaceBenchmarks.cpp
+//  tests/workload/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpaceBenchmarks.h"
+
+#include <random>
+#include <vector>
+
+#include <workload/Space.h>
+
+QTEST_MAIN(SpaceBenchmarks)
+
+// The classification of the proxies of a workload::Space in the regions of the views, as the RegionTracker runs it each
+// frame, at the scale of large domains. Run with -o <file>,xml (or csv) to keep the results.
+
+static const float WORLD_SIZE = 1000.0f;    // meters, the side of the cube the proxies are spread in
+static const float MIN_RADIUS = 0.5f;
+static const float MAX_RADIUS = 5.0f;
+static const float VIEW_STEP = 1.0f;        // meters the views move by each frame
+static const int NUM_VIEWS = 2;
+
+static void buildSpace(workload::Space& space, int numProxies, std::vector<workload::Space::Sphere>& spheres,
+                       std::vector<workload::ProxyID>& ids) {
+    std::mt19937 generator(numProxies);
+    std::uniform_real_distribution<float> position(-0.5f * WORLD_SIZE, 0.5f * WORLD_SIZE);
+    std::uniform_real_distribution<float> radius(MIN_RADIUS, MAX_RADIUS);
+
+    workload::Transaction transaction;
+    spheres.resize(numProxies);
+    ids.resize(numProxies);
+    for (int i = 0; i < numProxies; ++i) {
+        spheres[i] = workload::Space::Sphere(position(generator), position(generator), position(generator), radius(generator));
+        ids[i] = space.allocateID();
+        transaction.reset(ids[i], spheres[i], workload::Owner());
+    }
+    space.enqueueTransaction(std::move(transaction));
+    space.enqueueFrame();
+    space.processTransactionQueue();
+}
+
+static workload::Views buildViews(float offset) {
+    workload::Views views;
+    for (int i = 0; i < NUM_VIEWS; ++i) {
+        workload::View view;
+        view.origin = glm::vec3(offset, 0.0f, 0.1f * WORLD_SIZE * i);
+        workload::View::updateRegionsDefault(view);
+        views.push_back(view);
+    }
+    return views;
+}
+
+static void addRows() {
+    QTest::addColumn<int>("numProxies");
+
+    QTest::newRow("10k proxies") << 10000;
+    QTest::newRow("100k proxies") << 100000;
+    QTest::newRow("500k proxies") << 500000;
+}
+
+void SpaceBenchmarks::categorizeBenchmark_data() {
+    addRows();
+}
+
+void SpaceBenchmarks::categorizeBenchmark() {
+    QFETCH(int, numProxies);
+
+    workload::Space space;
+    std::vector<workload::Space::Sphere> spheres;
+    std::vector<workload::ProxyID> ids;
+    buildSpace(space, numProxies, spheres, ids);
+
+    workload::Changes changes;
+    space.setViews(buildViews(0.0f));
+    space.categorizeAndGetChanges(changes);
+    QVERIFY(space.getNumObjects() == (uint32_t)numProxies);
+
+    // the views walk back and forth, so that some proxies change of region each frame
+    int frame = 0;
+    QBENCHMARK {
+        changes.clear();
+        space.setViews(buildViews((frame++ % 2) * VIEW_STEP));
+        space.categorizeAndGetChanges(changes);
+    }
+}
+
+void SpaceBenchmarks::updateBenchmark_data() {
+    addRows();
+}
+
+void SpaceBenchmarks::updateBenchmark() {
+    QFETCH(int, numProxies);
+
+    workload::Space space;
+    std::vector<workload::Space::Sphere> spheres;
+    std::vector<workload::ProxyID> ids;
+    buildSpace(space, numProxies, spheres, ids);
+
+    workload::Changes changes;
+    space.setViews(buildViews(0.0f));
+    space.categorizeAndGetChanges(changes);
+
+    // a frame where one proxy in ten moves, as the entities simulated in a busy domain
+    const int MOVING_PROXY_STEP = 10;
+    int frame = 0;
+    QBENCHMARK {
+        float offset = (frame++ % 2) * VIEW_STEP;
+        workload::Transaction transaction;
+        for (int i = 0; i < numProxies; i += MOVING_PROXY_STEP) {
+            workload::Space::Sphere sphere = spheres[i];
+            sphere.x += offset;
+            transaction.update(ids[i], sphere);
+        }
+        space.enqueueTransaction(std::move(transaction));
+        space.enqueueFrame();
+        space.processTransactionQueue();
+
+        changes.clear();
+        space.categorizeAndGetChanges(changes);
+    }
+}
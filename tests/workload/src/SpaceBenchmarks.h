@@ -0,0 +1,26 @@
+//
+//  SpaceBenchmarks.h
+//  tests/workload/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_workload_SpaceBenchmarks_h
+#define hifi_workload_SpaceBenchmarks_h
+
+#include <QtTest/QtTest>
+
+class SpaceBenchmarks : public QObject {
+    Q_OBJECT
+private slots:
+    void categorizeBenchmark_data();
+    void categorizeBenchmark();
+    void updateBenchmark_data();
+    void updateBenchmark();
+};
+
+#endif // hifi_workload_SpaceBenchmarks_h
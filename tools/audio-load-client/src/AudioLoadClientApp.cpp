@@ -0,0 +1,452 @@
+//
+//  AudioLoadClientApp.cpp
+//  tools/audio-load-client/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioLoadClientApp.h"
+
+#include <cmath>
+
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+
+#include <AbstractAudioInterface.h>
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <AudioConstants.h>
+#include <AvatarHashMap.h>
+#include <DependencyManager.h>
+#include <GLMHelpers.h>
+#include <MetaverseAPI.h>
+#include <NetworkLogging.h>
+#include <SharedLogging.h>
+#include <SharedUtil.h>
+#include <Transform.h>
+#include <plugins/PluginManager.h>
+
+static const int STATS_INTERVAL_MSECS = 10 * (int)MSECS_PER_SECOND;
+static const float TALK_PERIOD_SECS = 10.0f;
+static const int MAX_CATCH_UP_FRAMES = 10;     // after a stall, the frames that are sent at once to catch up
+static const QString PCM_CODEC_NAME = "pcm";
+
+AudioLoadClientApp::AudioLoadClientApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Vircadia audio load client");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address", "127.0.0.1:40103");
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption listenPortOption("listenPort", "listen port of the first agent", QString::number(INVALID_PORT));
+    parser.addOption(listenPortOption);
+
+    const QCommandLineOption agentsOption("agents", "number of agents", "1");
+    parser.addOption(agentsOption);
+
+    const QCommandLineOption agentIndexOption("agent-index", "run agent <index> alone (used by the parent process)", "index");
+    parser.addOption(agentIndexOption);
+
+    const QCommandLineOption layoutOption("layout", "avatar layout: grid or circle", "grid");
+    parser.addOption(layoutOption);
+
+    const QCommandLineOption spacingOption("spacing", "meters between neighbouring avatars", "2");
+    parser.addOption(spacingOption);
+
+    const QCommandLineOption signalOption("signal", "microphone signal: tone, noise or silence", "tone");
+    parser.addOption(signalOption);
+
+    const QCommandLineOption gainOption("gain", "microphone signal gain, 1 is full scale", "0.1");
+    parser.addOption(gainOption);
+
+    const QCommandLineOption talkOption("talk", "fraction of the time each agent talks, silent frames otherwise", "1");
+    parser.addOption(talkOption);
+
+    const QCommandLineOption codecOption("codec", "only offer this codec to the audio-mixer, pcm for none", "name");
+    parser.addOption(codecOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run, 0 to run until killed", "0");
+    parser.addOption(durationOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _verbose = parser.isSet(verboseOutput);
+    if (!_verbose) {
+        QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtWarningMsg, false);
+
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtWarningMsg, false);
+    }
+
+    _numAgents = std::max(parser.value(agentsOption).toInt(), 1);
+
+    if (_numAgents > 1 && !parser.isSet(agentIndexOption)) {
+        spawnAgents(QCoreApplication::arguments().mid(1));
+        return;
+    }
+
+    _agentIndex = parser.isSet(agentIndexOption) ? parser.value(agentIndexOption).toInt() : 0;
+    if (_agentIndex < 0 || _agentIndex >= _numAgents) {
+        qCritical() << "--agent-index should be between 0 and" << _numAgents - 1;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    QString signal = parser.value(signalOption);
+    if (signal == "tone") {
+        _signal = Tone;
+    } else if (signal == "noise") {
+        _signal = Noise;
+    } else if (signal == "silence") {
+        _signal = Silence;
+    } else {
+        qCritical() << "--signal should be tone, noise or silence";
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _gain = glm::clamp(parser.value(gainOption).toFloat(), 0.0f, 1.0f);
+    _talkRatio = glm::clamp(parser.value(talkOption).toFloat(), 0.0f, 1.0f);
+    _codecName = parser.value(codecOption);
+    _duration = std::max(parser.value(durationOption).toInt(), 0);
+    _generator.seed(_agentIndex);
+
+    // the avatars stand on a grid or on a circle around the origin, looking at its center
+    float spacing = parser.value(spacingOption).toFloat();
+    QString layout = parser.value(layoutOption);
+    if (layout == "circle") {
+        float angle = TWO_PI * _agentIndex / _numAgents;
+        float radius = _numAgents * spacing / TWO_PI;
+        _position = glm::vec3(radius * sinf(angle), 0.0f, radius * cosf(angle));
+        _orientation = glm::angleAxis(angle, Vectors::UP);
+    } else if (layout == "grid") {
+        int side = (int)ceilf(sqrtf((float)_numAgents));
+        float offset = 0.5f * (side - 1);
+        _position = glm::vec3(((_agentIndex % side) - offset) * spacing, 0.0f, ((_agentIndex / side) - offset) * spacing);
+    } else {
+        qCritical() << "--layout should be grid or circle";
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    QString domainServerAddress = parser.value(domainAddressOption);
+    int listenPort = INVALID_PORT;
+    if (parser.isSet(listenPortOption)) {
+        listenPort = parser.value(listenPortOption).toInt() + _agentIndex;
+    }
+
+    startAgent(domainServerAddress, listenPort);
+}
+
+AudioLoadClientApp::~AudioLoadClientApp() {
+    if (_agents.empty()) {
+        if (_codec && _encoder) {
+            _codec->releaseEncoder(_encoder);
+            _encoder = nullptr;
+        }
+    }
+}
+
+void AudioLoadClientApp::spawnAgents(const QStringList& arguments) {
+    qInfo() << "Starting" << _numAgents << "agents";
+
+    for (int i = 0; i < _numAgents; ++i) {
+        auto agent = new QProcess(this);
+        agent->setProcessChannelMode(QProcess::ForwardedChannels);
+        connect(agent, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+            [this, i](int exitCode, QProcess::ExitStatus exitStatus) {
+                if (exitStatus != QProcess::NormalExit || exitCode != 0) {
+                    qWarning() << "Agent" << i << "exited with code" << exitCode;
+                }
+                if (--_numRunningAgents == 0) {
+                    finish(0);
+                }
+            });
+        agent->start(QCoreApplication::applicationFilePath(), QStringList(arguments) << "--agent-index" << QString::number(i));
+        _agents.push_back(agent);
+        ++_numRunningAgents;
+    }
+
+    // the agents go with the parent
+    connect(this, &QCoreApplication::aboutToQuit, this, [this] {
+        for (auto agent : _agents) {
+            agent->kill();
+            agent->waitForFinished();
+        }
+    });
+}
+
+void AudioLoadClientApp::startAgent(const QString& domainServerAddress, int listenPort) {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+
+    DependencyManager::set<AccountManager>(false, [&]{ return QString("Mozilla/5.0 (VircadiaAudioLoadClient)"); });
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent, listenPort);
+    DependencyManager::set<PluginManager>()->instantiate();
+    DependencyManager::set<AvatarHashMap>();
+
+    auto accountManager = DependencyManager::get<AccountManager>();
+    accountManager->setIsAgent(true);
+    accountManager->setAuthURL(MetaverseAPI::getCurrentMetaverseServerURL());
+
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // setup a timer for domain-server check ins
+    QTimer* domainCheckInTimer = new QTimer(nodeList.data());
+    connect(domainCheckInTimer, &QTimer::timeout, nodeList.data(), &NodeList::sendDomainServerCheckIn);
+    domainCheckInTimer->start(DOMAIN_SERVER_CHECK_IN_MSECS);
+
+    // start the nodeThread so its event loop is running
+    // (must happen after the checkin timer is created with the nodelist as it's parent)
+    nodeList->startThread();
+
+    const DomainHandler& domainHandler = nodeList->getDomainHandler();
+    connect(&domainHandler, &DomainHandler::domainConnectionRefused, this, &AudioLoadClientApp::domainConnectionRefused);
+
+    connect(nodeList.data(), &NodeList::nodeActivated, this, &AudioLoadClientApp::nodeActivated);
+    connect(nodeList.data(), &NodeList::uuidChanged, this, &AudioLoadClientApp::uuidChanged);
+    nodeList->addSetOfNodeTypesToNodeInterestSet(NodeSet() << NodeType::AudioMixer << NodeType::AvatarMixer);
+
+    auto& packetReceiver = nodeList->getPacketReceiver();
+    packetReceiver.registerListener(PacketType::SelectedAudioFormat,
+        PacketReceiver::makeUnsourcedListenerReference<AudioLoadClientApp>(this, &AudioLoadClientApp::handleSelectedAudioFormat));
+    packetReceiver.registerListenerForTypes({ PacketType::MixedAudio, PacketType::SilentAudioFrame,
+                                              PacketType::MixedAudioWithAmbisonicBed },
+        PacketReceiver::makeUnsourcedListenerReference<AudioLoadClientApp>(this, &AudioLoadClientApp::handleMixedAudio));
+
+    _avatar = std::make_shared<AvatarData>();
+    _avatar->setDisplayName(QString("Audio Load Agent %1").arg(_agentIndex));
+    _avatar->setWorldPosition(_position);
+    _avatar->setWorldOrientation(_orientation);
+    _avatar->setHeadOrientation(_orientation);
+
+    DependencyManager::get<AddressManager>()->handleLookupString(domainServerAddress, false);
+
+    _audioTimer.setTimerType(Qt::PreciseTimer);
+    connect(&_audioTimer, &QTimer::timeout, this, &AudioLoadClientApp::sendAudio);
+    _audioTimer.start((int)(AudioConstants::NETWORK_FRAME_MSECS / 2));
+
+    connect(&_avatarTimer, &QTimer::timeout, this, &AudioLoadClientApp::sendAvatar);
+    _avatarTimer.start((int)(MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS / USECS_PER_MSEC));
+
+    connect(&_statsTimer, &QTimer::timeout, this, &AudioLoadClientApp::printStats);
+    _statsTimer.start(STATS_INTERVAL_MSECS);
+
+    if (_duration > 0) {
+        QTimer::singleShot(_duration * (int)MSECS_PER_SECOND, this, [this] {
+            printStats();
+            finish(0);
+        });
+    }
+}
+
+void AudioLoadClientApp::domainConnectionRefused(const QString& reasonMessage, int reasonCodeInt, const QString& extraInfo) {
+    qWarning() << "Agent" << _agentIndex << "was refused by the domain:" << reasonMessage << extraInfo;
+    finish(1);
+}
+
+void AudioLoadClientApp::nodeActivated(SharedNodePointer node) {
+    if (node->getType() == NodeType::AudioMixer) {
+        negotiateAudioFormat();
+    } else if (node->getType() == NodeType::AvatarMixer) {
+        _avatar->sendIdentityPacket();
+    }
+}
+
+void AudioLoadClientApp::uuidChanged(const QUuid& ownerUUID, const QUuid& oldUUID) {
+    _avatar->setSessionUUID(ownerUUID);
+}
+
+void AudioLoadClientApp::negotiateAudioFormat() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto negotiateFormatPacket = NLPacket::create(PacketType::NegotiateAudioFormat);
+
+    // no codec falls back to pcm
+    std::vector<QString> codecNames;
+    for (auto& plugin : PluginManager::getInstance()->getCodecPlugins()) {
+        if (_codecName.isEmpty() || _codecName == plugin->getName()) {
+            codecNames.push_back(plugin->getName());
+        }
+    }
+    if (codecNames.empty() && !_codecName.isEmpty() && _codecName != PCM_CODEC_NAME) {
+        qWarning() << "Agent" << _agentIndex << "has no codec" << _codecName << ", sending pcm";
+    }
+
+    negotiateFormatPacket->writePrimitive((quint8)codecNames.size());
+    for (auto& codecName : codecNames) {
+        negotiateFormatPacket->writeString(codecName);
+    }
+
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (audioMixer) {
+        nodeList->sendPacket(std::move(negotiateFormatPacket), *audioMixer);
+    }
+}
+
+void AudioLoadClientApp::handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message) {
+    selectAudioFormat(message->readString());
+}
+
+void AudioLoadClientApp::selectAudioFormat(const QString& selectedCodecName) {
+    if (_selectedCodecName == selectedCodecName) {
+        return;
+    }
+    _selectedCodecName = selectedCodecName;
+
+    if (_verbose) {
+        qDebug() << "Agent" << _agentIndex << "selected codec:" << _selectedCodecName;
+    }
+
+    // release any old codec encoder first...
+    if (_codec && _encoder) {
+        _codec->releaseEncoder(_encoder);
+        _encoder = nullptr;
+        _codec = nullptr;
+    }
+
+    for (auto& plugin : PluginManager::getInstance()->getCodecPlugins()) {
+        if (_selectedCodecName == plugin->getName()) {
+            _codec = plugin;
+            _encoder = plugin->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
+            break;
+        }
+    }
+}
+
+void AudioLoadClientApp::handleMixedAudio(QSharedPointer<ReceivedMessage> message) {
+    ++_mixesReceived;
+    _mixBytesReceived += message->getSize();
+}
+
+void AudioLoadClientApp::renderFrame(int16_t* samples) {
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    if (_signal == Tone) {
+        // a tone of its own for each agent, so that they can be told apart in a mix
+        float frequency = 200.0f + 20.0f * (_agentIndex % 40);
+        float step = TWO_PI * frequency / AudioConstants::SAMPLE_RATE;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            samples[i] = (int16_t)(_gain * AudioConstants::MAX_SAMPLE_VALUE * sinf(_phase));
+            _phase = fmodf(_phase + step, TWO_PI);
+        }
+    } else if (_signal == Noise) {
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            samples[i] = (int16_t)(_gain * AudioConstants::MAX_SAMPLE_VALUE * noise(_generator));
+        }
+    } else {
+        memset(samples, 0, NUM_FRAMES * sizeof(int16_t));
+    }
+}
+
+void AudioLoadClientApp::sendAudio() {
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    if (!_clock.isValid()) {
+        _clock.start();
+    }
+
+    // the frames are due every 10 ms from the start, whatever the timer does
+    qint64 framesDue = _clock.nsecsElapsed() / ((qint64)AudioConstants::NETWORK_FRAME_USECS * (qint64)NSECS_PER_USEC);
+    if (framesDue - _framesSent > MAX_CATCH_UP_FRAMES) {
+        _framesSent = framesDue - MAX_CATCH_UP_FRAMES;
+    }
+
+    Transform audioTransform;
+    audioTransform.setTranslation(_position);
+    audioTransform.setRotation(_orientation);
+
+    QByteArray audio(NUM_FRAMES * sizeof(int16_t), 0);
+    QByteArray encoded;
+
+    for (; _framesSent < framesDue; ++_framesSent) {
+        // the agents talk in turn, each at its own phase of the talk period
+        float time = _framesSent * AudioConstants::NETWORK_FRAME_SECS;
+        float talkPhase = fmodf(time / TALK_PERIOD_SECS + (float)_agentIndex / _numAgents, 1.0f);
+        bool isTalking = _signal != Silence && talkPhase < _talkRatio;
+
+        // the codec must be flushed to silence before sending silent packets,
+        // so the transition to silent packets is delayed by one packet
+        auto packetType = PacketType::MicrophoneAudioNoEcho;
+        if (isTalking) {
+            renderFrame(reinterpret_cast<int16_t*>(audio.data()));
+        } else if (_wasTalking) {
+            audio.fill(0);
+        } else {
+            packetType = PacketType::SilentAudioFrame;
+            ++_silentFramesSent;
+        }
+        _wasTalking = isTalking;
+
+        if (packetType != PacketType::SilentAudioFrame && _encoder) {
+            _encoder->encode(audio, encoded);
+        } else {
+            encoded = audio;
+        }
+
+        AbstractAudioInterface::emitAudioPacket(encoded.data(), encoded.size(), _sequenceNumber, false, audioTransform,
+                                                _position, glm::vec3(0.0f), packetType, _selectedCodecName);
+    }
+}
+
+void AudioLoadClientApp::sendAvatar() {
+    if (!_avatar->getSessionUUID().isNull()) {
+        _avatar->sendAvatarDataPacket();
+    }
+}
+
+void AudioLoadClientApp::printStats() {
+    float seconds = STATS_INTERVAL_MSECS / (float)MSECS_PER_SECOND;
+    qInfo() << "Agent" << _agentIndex << "sent" << _framesSent << "frames (" << _silentFramesSent << "silent ),"
+            << "received" << _mixesReceived << "mixes (" << _mixBytesReceived << "bytes ),"
+            << (_framesSent - _lastFramesSent) / seconds << "frames/s up,"
+            << (_mixesReceived - _lastMixesReceived) / seconds << "mixes/s down";
+    _lastFramesSent = _framesSent;
+    _lastMixesReceived = _mixesReceived;
+}
+
+void AudioLoadClientApp::finish(int exitCode) {
+    if (_agents.empty()) {
+        auto nodeList = DependencyManager::get<NodeList>();
+
+        // send the domain a disconnect packet, force stoppage of domain-server check-ins
+        nodeList->getDomainHandler().disconnect("Finishing");
+        nodeList->setIsShuttingDown(true);
+
+        // tell the packet receiver we're shutting down, so it can drop packets
+        nodeList->getPacketReceiver().setShouldDropPackets(true);
+
+        // remove the NodeThread from the list of threads
+        QThread* nodeThread = DependencyManager::get<NodeList>()->getThread();
+        nodeThread->quit();
+        nodeThread->wait();
+    }
+
+    QCoreApplication::exit(exitCode);
+}
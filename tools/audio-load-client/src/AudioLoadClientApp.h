@@ -0,0 +1,105 @@
+//
+//  AudioLoadClientApp.h
+//  tools/audio-load-client/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioLoadClientApp_h
+#define hifi_AudioLoadClientApp_h
+
+#include <random>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QTimer>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AvatarData.h>
+#include <NodeList.h>
+#include <ReceivedMessage.h>
+#include <plugins/CodecPlugin.h>
+
+// Puts load on an audio-mixer: each agent connects to the domain, streams a synthetic microphone (a tone or noise, with
+// an optional talk duty cycle) to the audio-mixer and its avatar position to the avatar-mixer, and counts the mixes it
+// gets back. A node list serves a single agent, so with more than one agent the application runs as a parent that
+// spawns one process per agent.
+class AudioLoadClientApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    AudioLoadClientApp(int argc, char* argv[]);
+    ~AudioLoadClientApp();
+
+private slots:
+    void domainConnectionRefused(const QString& reasonMessage, int reasonCodeInt, const QString& extraInfo);
+    void nodeActivated(SharedNodePointer node);
+    void uuidChanged(const QUuid& ownerUUID, const QUuid& oldUUID);
+    void handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message);
+    void handleMixedAudio(QSharedPointer<ReceivedMessage> message);
+    void sendAudio();
+    void sendAvatar();
+    void printStats();
+
+private:
+    enum Signal {
+        Tone,
+        Noise,
+        Silence
+    };
+
+    void spawnAgents(const QStringList& arguments);
+    void startAgent(const QString& domainServerAddress, int listenPort);
+    void negotiateAudioFormat();
+    void selectAudioFormat(const QString& selectedCodecName);
+    void renderFrame(int16_t* samples);
+    void finish(int exitCode);
+
+    bool _verbose { false };
+
+    // parent
+    std::vector<QProcess*> _agents;
+    int _numRunningAgents { 0 };
+
+    // agent
+    int _numAgents { 1 };
+    int _agentIndex { 0 };
+    Signal _signal { Tone };
+    float _gain { 0.1f };
+    float _talkRatio { 1.0f };      // fraction of the talk period spent talking
+    QString _codecName;             // restricts the negotiation, "pcm" for none
+    int _duration { 0 };            // seconds, 0 runs until killed
+
+    glm::vec3 _position;
+    glm::quat _orientation;
+    AvatarSharedPointer _avatar;
+
+    QString _selectedCodecName;
+    CodecPluginPointer _codec;
+    Encoder* _encoder { nullptr };
+
+    QTimer _audioTimer;
+    QTimer _avatarTimer;
+    QTimer _statsTimer;
+    QElapsedTimer _clock;
+    qint64 _framesSent { 0 };
+    quint16 _sequenceNumber { 0 };
+    bool _wasTalking { false };
+    float _phase { 0.0f };
+    std::mt19937 _generator;
+
+    qint64 _silentFramesSent { 0 };
+    qint64 _mixesReceived { 0 };
+    qint64 _mixBytesReceived { 0 };
+    qint64 _lastFramesSent { 0 };
+    qint64 _lastMixesReceived { 0 };
+};
+
+#endif // hifi_AudioLoadClientApp_h
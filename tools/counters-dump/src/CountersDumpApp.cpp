@@ -0,0 +1,96 @@
+//
+//  CountersDumpApp.cpp
+//  tools/counters-dump/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CountersDumpApp.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDebug>
+
+static const int DEFAULT_INTERVAL_MSECS = 10;    // 100 Hz
+
+CountersDumpApp::CountersDumpApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Dumps the hot path counters of a running Vircadia process as CSV");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption pidOption("p", "pid of the process to read the counters of", "pid");
+    parser.addOption(pidOption);
+
+    const QCommandLineOption intervalOption("i", "msecs between the samples", "msecs", QString::number(DEFAULT_INTERVAL_MSECS));
+    parser.addOption(intervalOption);
+
+    const QCommandLineOption countOption("n", "number of samples, until stopped if not set", "count");
+    parser.addOption(countOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (!parser.isSet(pidOption)) {
+        qCritical() << "The pid of the process is required";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    qint64 pid = parser.value(pidOption).toLongLong();
+    if (!_reader.attach(pid)) {
+        qCritical() << "Unable to read the counters of" << pid << "-" << _reader.getErrorString();
+        _returnCode = 2;
+        return;
+    }
+
+    int interval = parser.value(intervalOption).toInt();
+    _numSamples = parser.value(countOption).toInt();
+
+    connect(&_timer, &QTimer::timeout, this, &CountersDumpApp::sample);
+    _timer.setTimerType(Qt::PreciseTimer);
+    _timer.start(std::max(interval, 1));
+    _elapsed.start();
+}
+
+void CountersDumpApp::sample() {
+    auto counters = _reader.read();
+
+    // counters are registered as the process comes across them, the header is written again when there are new ones
+    if ((int)counters.size() != _numColumns) {
+        _numColumns = (int)counters.size();
+        std::cout << "msecs";
+        for (const auto& counter : counters) {
+            std::cout << "," << counter.first.toStdString();
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << _elapsed.elapsed();
+    for (const auto& counter : counters) {
+        std::cout << "," << counter.second;
+    }
+    std::cout << "\n";
+
+    ++_sampleCount;
+    if (_numSamples > 0 && _sampleCount >= _numSamples) {
+        std::cout.flush();
+        _timer.stop();
+        quit();
+    }
+}
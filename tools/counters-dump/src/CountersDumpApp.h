@@ -0,0 +1,42 @@
+//
+//  CountersDumpApp.h
+//  tools/counters-dump/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CountersDumpApp_h
+#define hifi_CountersDumpApp_h
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+
+#include <SharedCounters.h>
+
+// Samples the SharedCounters of a running process and writes them as CSV, a line per sample.
+class CountersDumpApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    CountersDumpApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private slots:
+    void sample();
+
+private:
+    SharedCountersReader _reader;
+    QTimer _timer;
+    QElapsedTimer _elapsed;
+    int _numSamples { 0 };      // 0 to sample until stopped
+    int _sampleCount { 0 };
+    int _numColumns { -1 };
+    int _returnCode { 0 };
+};
+
+#endif // hifi_CountersDumpApp_h
@@ -0,0 +1,25 @@
+//
+//  main.cpp
+//  tools/counters-dump/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "CountersDumpApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Counters Dump");
+
+    CountersDumpApp app(argc, argv);
+    if (app.getReturnCode() != 0) {
+        return app.getReturnCode();
+    }
+    app.exec();
+    return app.getReturnCode();
+}
@@ -0,0 +1,418 @@
+//
+//  CrowdClientApp.cpp
+//  tools/crowd-client/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CrowdClientApp.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <AudioConstants.h>
+#include <DependencyManager.h>
+#include <GLMHelpers.h>
+#include <MetaverseAPI.h>
+#include <NetworkingConstants.h>
+#include <NetworkLogging.h>
+#include <SharedLogging.h>
+#include <SharedUtil.h>
+#include <Sound.h>
+#include <plugins/PluginManager.h>
+#include <recording/Clip.h>
+#include <udt/PacingEngine.h>
+
+static const int STATS_INTERVAL_MSECS = 10 * (int)MSECS_PER_SECOND;
+static const QString PCM_CODEC_NAME = "pcm";
+
+// the keys of the recorded avatar frames that each client has its own of
+static const QStringList CLIENT_FRAME_KEYS = { "displayName", "attachedEntities" };
+
+// "min / p10 / p50 / p90 / max" of the values of the clients, which sorts them
+static QString distribution(std::vector<float>& values) {
+    if (values.empty()) {
+        return "-";
+    }
+    std::sort(values.begin(), values.end());
+    auto at = [&](float fraction) {
+        return values[std::min((size_t)(fraction * values.size()), values.size() - 1)];
+    };
+    return QString("%1 / %2 / %3 / %4 / %5").arg(values.front(), 0, 'f', 1).arg(at(0.1f), 0, 'f', 1)
+        .arg(at(0.5f), 0, 'f', 1).arg(at(0.9f), 0, 'f', 1).arg(values.back(), 0, 'f', 1);
+}
+
+CrowdClientApp::CrowdClientApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Vircadia crowd client");
+
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address, host[:port]", "address", "127.0.0.1");
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption listenPortOption("listenPort", "listen port of the first client, the others follow it", "port");
+    parser.addOption(listenPortOption);
+
+    const QCommandLineOption clientsOption("clients", "number of virtual clients", "count", "1");
+    parser.addOption(clientsOption);
+
+    const QCommandLineOption threadsOption("threads", "threads the clients share, 0 for one per core", "count", "0");
+    parser.addOption(threadsOption);
+
+    const QCommandLineOption rampUpOption("ramp-up", "seconds over which the clients are started", "seconds", "10");
+    parser.addOption(rampUpOption);
+
+    const QCommandLineOption layoutOption("layout", "avatar layout: grid or circle", "layout", "grid");
+    parser.addOption(layoutOption);
+
+    const QCommandLineOption spacingOption("spacing", "meters between neighbouring avatars", "meters", "2");
+    parser.addOption(spacingOption);
+
+    const QCommandLineOption recordingOption("recording", "avatar recording (.hfr) the clients play, each at its own time",
+                                             "path");
+    parser.addOption(recordingOption);
+
+    const QCommandLineOption audioOption("audio", "WAV file the clients say, each at its own time, silence without one",
+                                         "path");
+    parser.addOption(audioOption);
+
+    const QCommandLineOption codecOption("codec", "only offer this codec to the audio-mixer, pcm for none", "name");
+    parser.addOption(codecOption);
+
+    const QCommandLineOption queryRateOption("query-rate", "entity queries per second of each client, 0 for none",
+                                             "rate", "10");
+    parser.addOption(queryRateOption);
+
+    const QCommandLineOption editRateOption("edit-rate", "edits per second of the entity of each client, 0 for none",
+                                            "rate", "1");
+    parser.addOption(editRateOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run, 0 to run until killed", "seconds", "0");
+    parser.addOption(durationOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _verbose = parser.isSet(verboseOutput);
+    if (!_verbose) {
+        QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtWarningMsg, false);
+
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&shared())->setEnabled(QtWarningMsg, false);
+    }
+
+    _numClients = std::max(parser.value(clientsOption).toInt(), 1);
+    _layout = parser.value(layoutOption);
+    if (_layout != "grid" && _layout != "circle") {
+        qCritical() << "--layout should be grid or circle";
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+    _spacing = parser.value(spacingOption).toFloat();
+    _duration = std::max(parser.value(durationOption).toInt(), 0);
+
+    if (parser.isSet(recordingOption) && !loadRecording(parser.value(recordingOption))) {
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        return;
+    }
+    if (parser.isSet(audioOption) && !loadAudio(parser.value(audioOption))) {
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        return;
+    }
+
+    // the clients go to an address of their own, not through the address manager
+    _settings.domainURL = QUrl(URL_SCHEME_HIFI + "://" + parser.value(domainAddressOption));
+    if (!_settings.domainURL.isValid() || _settings.domainURL.host().isEmpty()) {
+        qCritical() << "-d should be a host, with an optional port";
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+    if (parser.isSet(listenPortOption)) {
+        _settings.listenPort = parser.value(listenPortOption).toInt();
+    }
+    _settings.codecName = parser.value(codecOption);
+    _settings.queryRate = std::max(parser.value(queryRateOption).toFloat(), 0.0f);
+    _settings.editRate = std::max(parser.value(editRateOption).toFloat(), 0.0f);
+    // the entities outlive the run a little, in case the clients don't get to erase them
+    const float ENTITY_LIFETIME_MARGIN_SECS = 60.0f;
+    _settings.entityLifetime = (_duration > 0 ? _duration : (float)SECS_PER_HOUR) + ENTITY_LIFETIME_MARGIN_SECS;
+
+    DependencyManager::set<AccountManager>(false, [&]{ return QString("Mozilla/5.0 (VircadiaCrowdClient)"); });
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<PluginManager>()->instantiate();
+
+    auto accountManager = DependencyManager::get<AccountManager>();
+    accountManager->setIsAgent(true);
+    accountManager->setAuthURL(MetaverseAPI::getCurrentMetaverseServerURL());
+
+    // the clients look the codecs up from their threads
+    auto codecPlugins = PluginManager::getInstance()->getCodecPlugins();
+    if (!_settings.codecName.isEmpty() && _settings.codecName != PCM_CODEC_NAME &&
+        std::none_of(codecPlugins.begin(), codecPlugins.end(), [&](const CodecPluginPointer& plugin) {
+            return plugin->getName() == _settings.codecName;
+        })) {
+        qWarning() << "There is no codec" << _settings.codecName << ", the clients send pcm";
+    }
+
+    // the send queues of all the clients are paced on the same few threads
+    _settings.pacingEngine = std::make_shared<udt::PacingEngine>();
+
+    int numThreads = parser.value(threadsOption).toInt();
+    if (numThreads <= 0) {
+        numThreads = std::max(QThread::idealThreadCount(), 1);
+    }
+    numThreads = std::min(numThreads, _numClients);
+    for (int i = 0; i < numThreads; ++i) {
+        auto thread = new QThread(this);
+        thread->setObjectName(QString("Crowd Thread %1").arg(i));
+        thread->start();
+        _threads.push_back(thread);
+    }
+
+    qInfo() << "Starting" << _numClients << "clients on" << numThreads << "threads";
+
+    float rampUp = std::max(parser.value(rampUpOption).toFloat(), 0.0f);
+    connect(&_rampUpTimer, &QTimer::timeout, this, &CrowdClientApp::startNextClient);
+    _rampUpTimer.start((int)(rampUp * MSECS_PER_SECOND / _numClients));
+    startNextClient();
+
+    connect(&_statsTimer, &QTimer::timeout, this, &CrowdClientApp::printStats);
+    _statsTimer.start(STATS_INTERVAL_MSECS);
+    _statsClock.start();
+
+    if (_duration > 0) {
+        QTimer::singleShot(_duration * (int)MSECS_PER_SECOND, this, [this] {
+            printStats();
+            finish(0);
+        });
+    }
+
+    connect(this, &QCoreApplication::aboutToQuit, this, &CrowdClientApp::stopClients);
+}
+
+CrowdClientApp::~CrowdClientApp() {
+    stopClients();
+}
+
+bool CrowdClientApp::loadRecording(const QString& path) {
+    auto clip = recording::Clip::fromFile(path);
+    if (!clip) {
+        qCritical() << "Could not load the recording" << path;
+        return false;
+    }
+
+    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    auto decoded = std::make_shared<CrowdRecording>();
+    clip->seekFrameTime(0);
+    for (auto frame = clip->nextFrame(); frame; frame = clip->nextFrame()) {
+        if (frame->type == AVATAR_FRAME_TYPE) {
+            QJsonObject json = QJsonDocument::fromBinaryData(frame->data).object();
+            for (auto& key : CLIENT_FRAME_KEYS) {
+                json.remove(key);
+            }
+            decoded->times.push_back(frame->timeOffset);
+            decoded->frames.push_back(json);
+        }
+    }
+    decoded->duration = clip->duration();
+
+    if (decoded->frames.empty()) {
+        qCritical() << "The recording" << path << "has no avatar frames";
+        return false;
+    }
+    qInfo() << "Playing" << decoded->frames.size() << "avatar frames over" << decoded->duration << "s from" << path;
+    _settings.recording = decoded;
+    return true;
+}
+
+bool CrowdClientApp::loadAudio(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Could not open the audio file" << path;
+        return false;
+    }
+
+    SoundProcessor processor(QWeakPointer<Resource>(), QByteArray());
+    QByteArray samples;
+    auto properties = processor.interpretAsWav(file.readAll(), samples);
+    if (properties.numChannels != 1 && properties.numChannels != 2) {
+        qCritical() << "The audio file" << path << "should be a mono or stereo WAV file";
+        return false;
+    }
+
+    // the microphones are mono
+    if (properties.numChannels == 2) {
+        auto stereo = reinterpret_cast<const int16_t*>(samples.constData());
+        int numFrames = samples.size() / (2 * sizeof(int16_t));
+        QByteArray mono(numFrames * sizeof(int16_t), Qt::Uninitialized);
+        auto destination = reinterpret_cast<int16_t*>(mono.data());
+        for (int i = 0; i < numFrames; ++i) {
+            destination[i] = (int16_t)(((int)stereo[2 * i] + (int)stereo[2 * i + 1]) / 2);
+        }
+        samples = mono;
+        properties.numChannels = 1;
+    }
+
+    _settings.audio = processor.downSample(samples, properties);
+    if (_settings.audio.size() < AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL) {
+        qCritical() << "The audio file" << path << "is shorter than a network frame";
+        return false;
+    }
+    qInfo() << "Saying" << _settings.audio.size() / (float)(AudioConstants::SAMPLE_RATE * sizeof(int16_t)) << "s from" << path;
+    return true;
+}
+
+void CrowdClientApp::startNextClient() {
+    int index = (int)_clients.size();
+    if (index >= _numClients || _isFinished) {
+        _rampUpTimer.stop();
+        return;
+    }
+
+    // the avatars stand on a grid or on a circle around the origin, looking at its center
+    glm::vec3 position;
+    glm::quat orientation;
+    if (_layout == "circle") {
+        float angle = TWO_PI * index / _numClients;
+        float radius = _numClients * _spacing / TWO_PI;
+        position = glm::vec3(radius * sinf(angle), 0.0f, radius * cosf(angle));
+        orientation = glm::angleAxis(angle, Vectors::UP);
+    } else {
+        int side = (int)ceilf(sqrtf((float)_numClients));
+        float offset = 0.5f * (side - 1);
+        position = glm::vec3(((index % side) - offset) * _spacing, 0.0f, ((index / side) - offset) * _spacing);
+    }
+
+    VirtualClientSettings settings = _settings;
+    if (settings.listenPort != INVALID_PORT) {
+        settings.listenPort += index;
+    }
+
+    auto client = new VirtualClient(index, position, orientation, settings);
+    client->moveToThread(_threads[index % _threads.size()]);
+    QMetaObject::invokeMethod(client, "start", Qt::QueuedConnection);
+    _clients.push_back(client);
+}
+
+void CrowdClientApp::printStats() {
+    float seconds = _statsClock.restart() / (float)MSECS_PER_SECOND;
+    if (_clients.empty() || seconds <= 0.0f) {
+        return;
+    }
+
+    int numConnected = 0;
+    VirtualClient::Stats total;
+    std::vector<float> mixRates, avatarRates, entityRates, mixGaps, connectTimes;
+    std::vector<float> audioMixerPings, avatarMixerPings, entityServerPings;
+    for (auto client : _clients) {
+        auto stats = client->sampleStats();
+
+        total.audioFramesSent += stats.audioFramesSent;
+        total.avatarPacketsSent += stats.avatarPacketsSent;
+        total.queriesSent += stats.queriesSent;
+        total.editsSent += stats.editsSent;
+        total.mixBytesReceived += stats.mixBytesReceived;
+        total.avatarBytesReceived += stats.avatarBytesReceived;
+        total.entityBytesReceived += stats.entityBytesReceived;
+
+        if (stats.connectMsecs >= 0) {
+            connectTimes.push_back((float)stats.connectMsecs);
+        }
+        if (!stats.isConnected) {
+            continue;
+        }
+
+        // the clients that get the least are the ones to look at, the rates are of the connected ones only
+        ++numConnected;
+        mixRates.push_back(stats.mixesReceived / seconds);
+        avatarRates.push_back(stats.avatarBytesReceived / seconds / BYTES_PER_KILOBYTE);
+        entityRates.push_back(stats.entityBytesReceived / seconds / BYTES_PER_KILOBYTE);
+        mixGaps.push_back((float)stats.maxMixGapMsecs);
+        if (stats.audioMixerPingMsecs >= 0) {
+            audioMixerPings.push_back((float)stats.audioMixerPingMsecs);
+        }
+        if (stats.avatarMixerPingMsecs >= 0) {
+            avatarMixerPings.push_back((float)stats.avatarMixerPingMsecs);
+        }
+        if (stats.entityServerPingMsecs >= 0) {
+            entityServerPings.push_back((float)stats.entityServerPingMsecs);
+        }
+    }
+
+    qInfo().noquote() << QString("%1 of %2 clients connected, sending %3 audio frames/s, %4 avatar packets/s, "
+                                 "%5 queries/s, %6 edits/s, receiving %7 kB/s of mixes, %8 kB/s of avatars, "
+                                 "%9 kB/s of entities")
+        .arg(numConnected).arg(_numClients)
+        .arg(total.audioFramesSent / seconds, 0, 'f', 0).arg(total.avatarPacketsSent / seconds, 0, 'f', 0)
+        .arg(total.queriesSent / seconds, 0, 'f', 0).arg(total.editsSent / seconds, 0, 'f', 1)
+        .arg(total.mixBytesReceived / seconds / BYTES_PER_KILOBYTE, 0, 'f', 1)
+        .arg(total.avatarBytesReceived / seconds / BYTES_PER_KILOBYTE, 0, 'f', 1)
+        .arg(total.entityBytesReceived / seconds / BYTES_PER_KILOBYTE, 0, 'f', 1);
+    qInfo().noquote() << "  per client, min / p10 / p50 / p90 / max:";
+    qInfo().noquote() << "    mixes/s           " << distribution(mixRates);
+    qInfo().noquote() << "    longest mix gap ms" << distribution(mixGaps);
+    qInfo().noquote() << "    avatars kB/s      " << distribution(avatarRates);
+    qInfo().noquote() << "    entities kB/s     " << distribution(entityRates);
+    qInfo().noquote() << "    audio-mixer ping  " << distribution(audioMixerPings);
+    qInfo().noquote() << "    avatar-mixer ping " << distribution(avatarMixerPings);
+    qInfo().noquote() << "    entity-server ping" << distribution(entityServerPings);
+    qInfo().noquote() << "    connect time ms   " << distribution(connectTimes);
+}
+
+void CrowdClientApp::stopClients() {
+    if (_isFinished) {
+        return;
+    }
+    _isFinished = true;
+    _rampUpTimer.stop();
+    _statsTimer.stop();
+
+    // the clients erase their entities and leave the domain before their threads stop
+    for (auto client : _clients) {
+        QMetaObject::invokeMethod(client, "stop", Qt::BlockingQueuedConnection);
+        client->deleteLater();
+    }
+    _clients.clear();
+
+    for (auto thread : _threads) {
+        thread->quit();
+        thread->wait();
+    }
+    _threads.clear();
+}
+
+void CrowdClientApp::finish(int exitCode) {
+    stopClients();
+    QCoreApplication::exit(exitCode);
+}
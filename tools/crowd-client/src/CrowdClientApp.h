@@ -0,0 +1,60 @@
+//
+//  CrowdClientApp.h
+//  tools/crowd-client/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CrowdClientApp_h
+#define hifi_CrowdClientApp_h
+
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QTimer>
+
+#include "VirtualClient.h"
+
+// Puts the load of a crowd on a whole domain: every virtual client connects on its own, plays an avatar recording to the
+// avatar-mixer, a sound to the audio-mixer and queries the entity-server from its moving view, editing an entity of its
+// own now and then. The clients share the threads and the pacing threads of the process, so that a machine connects many
+// more of them than it would run interfaces, and their receive rates and pings are summed up across the crowd.
+class CrowdClientApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    CrowdClientApp(int argc, char* argv[]);
+    ~CrowdClientApp();
+
+private slots:
+    void startNextClient();
+    void printStats();
+    void stopClients();
+
+private:
+    bool loadRecording(const QString& path);
+    bool loadAudio(const QString& path);
+    void finish(int exitCode);
+
+    bool _verbose { false };
+    int _numClients { 1 };
+    QString _layout;
+    float _spacing { 2.0f };
+    int _duration { 0 }; // seconds, 0 runs until killed
+    VirtualClientSettings _settings;
+
+    std::vector<QThread*> _threads;
+    std::vector<VirtualClient*> _clients;
+    bool _isFinished { false };
+
+    QTimer _rampUpTimer;
+    QTimer _statsTimer;
+    QElapsedTimer _statsClock;
+};
+
+#endif // hifi_CrowdClientApp_h
@@ -0,0 +1,504 @@
+//
+//  VirtualClient.cpp
+//  tools/crowd-client/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "VirtualClient.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <AbstractAudioInterface.h>
+#include <AudioConstants.h>
+#include <AvatarHashMap.h>
+#include <AvatarTraits.h>
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <GLMHelpers.h>
+#include <OctreeConstants.h>
+#include <SharedUtil.h>
+#include <Transform.h>
+#include <ViewFrustum.h>
+#include <plugins/PluginManager.h>
+#include <shared/ConicalViewFrustum.h>
+
+static const int NODE_STATS_INTERVAL_MSECS = 1000;
+static const int MAX_CATCH_UP_FRAMES = 10; // after a stall, the audio frames that are sent at once to catch up
+static const int CLIENT_AUDIO_OFFSET_FRAMES = 37; // so that the clients don't all say the same thing at once
+static const float CLIENT_RECORDING_OFFSET_SECS = 0.7f; // so that the clients don't all move in step
+static const float TURN_RATE = 0.2f; // radians per second, without a recording
+static const float ENTITY_SIZE = 0.2f;
+static const float ENTITY_HEIGHT = 2.2f; // above the avatar's position, which the entity circles
+static const float ENTITY_ORBIT_RADIUS = 0.5f;
+
+VirtualClient::VirtualClient(int index, const glm::vec3& position, const glm::quat& orientation,
+                             const VirtualClientSettings& settings) :
+    _index(index),
+    _position(position),
+    _orientation(orientation),
+    _settings(settings),
+    _domainCheckInTimer(this),
+    _audioTimer(this),
+    _avatarTimer(this),
+    _queryTimer(this),
+    _editTimer(this),
+    _nodeStatsTimer(this)
+{
+}
+
+VirtualClient::~VirtualClient() {
+    releaseEncoder();
+}
+
+VirtualClient::Stats VirtualClient::sampleStats() {
+    Stats stats;
+    stats.isConnected = _isConnected;
+    stats.connectMsecs = _connectMsecs;
+    stats.audioFramesSent = _audioFramesSent.exchange(0);
+    stats.avatarPacketsSent = _avatarPacketsSent.exchange(0);
+    stats.queriesSent = _queriesSent.exchange(0);
+    stats.editsSent = _editsSent.exchange(0);
+    stats.mixesReceived = _mixesReceived.exchange(0);
+    stats.mixBytesReceived = _mixBytesReceived.exchange(0);
+    stats.avatarPacketsReceived = _avatarPacketsReceived.exchange(0);
+    stats.avatarBytesReceived = _avatarBytesReceived.exchange(0);
+    stats.entityPacketsReceived = _entityPacketsReceived.exchange(0);
+    stats.entityBytesReceived = _entityBytesReceived.exchange(0);
+    stats.maxMixGapMsecs = _maxMixGapMsecs.exchange(0);
+    stats.audioMixerPingMsecs = _audioMixerPingMsecs;
+    stats.avatarMixerPingMsecs = _avatarMixerPingMsecs;
+    stats.entityServerPingMsecs = _entityServerPingMsecs;
+    return stats;
+}
+
+void VirtualClient::start() {
+    _clock.start();
+
+    _nodeList = NodeList::create(NodeType::Agent, _settings.listenPort);
+    if (_settings.pacingEngine) {
+        _nodeList->setPacingEngine(_settings.pacingEngine);
+    }
+
+    connect(&_domainCheckInTimer, &QTimer::timeout, _nodeList.data(), &NodeList::sendDomainServerCheckIn);
+    _domainCheckInTimer.start(DOMAIN_SERVER_CHECK_IN_MSECS);
+
+    const DomainHandler& domainHandler = _nodeList->getDomainHandler();
+    connect(&domainHandler, &DomainHandler::domainConnectionRefused, this, &VirtualClient::domainConnectionRefused);
+    connect(&domainHandler, &DomainHandler::connectedToDomain, this, &VirtualClient::connectedToDomain);
+    connect(&domainHandler, &DomainHandler::disconnectedFromDomain, this, [this] {
+        _isConnected = false;
+    });
+
+    connect(_nodeList.data(), &NodeList::nodeActivated, this, &VirtualClient::nodeActivated);
+    connect(_nodeList.data(), &NodeList::uuidChanged, this, &VirtualClient::uuidChanged);
+    _nodeList->addSetOfNodeTypesToNodeInterestSet(NodeSet() << NodeType::AudioMixer << NodeType::AvatarMixer
+                                                  << NodeType::EntityServer);
+
+    auto& packetReceiver = _nodeList->getPacketReceiver();
+    packetReceiver.registerListener(PacketType::SelectedAudioFormat,
+        PacketReceiver::makeUnsourcedListenerReference<VirtualClient>(this, &VirtualClient::handleSelectedAudioFormat));
+    packetReceiver.registerListenerForTypes({ PacketType::MixedAudio, PacketType::SilentAudioFrame,
+                                              PacketType::MixedAudioWithAmbisonicBed },
+        PacketReceiver::makeUnsourcedListenerReference<VirtualClient>(this, &VirtualClient::handleMixedAudio));
+    packetReceiver.registerListenerForTypes({ PacketType::BulkAvatarData, PacketType::AvatarIdentity,
+                                              PacketType::KillAvatar },
+        PacketReceiver::makeUnsourcedListenerReference<VirtualClient>(this, &VirtualClient::handleAvatarPacket));
+    packetReceiver.registerListener(PacketType::BulkAvatarTraits,
+        PacketReceiver::makeUnsourcedListenerReference<VirtualClient>(this, &VirtualClient::handleBulkAvatarTraits));
+    packetReceiver.registerListenerForTypes({ PacketType::EntityData, PacketType::EntityErase,
+                                              PacketType::EntityQueryInitialResultsComplete },
+        PacketReceiver::makeUnsourcedListenerReference<VirtualClient>(this, &VirtualClient::handleEntityPacket));
+
+    _avatar = std::make_shared<AvatarData>();
+    _avatar->setDisplayName(QString("Crowd Client %1").arg(_index));
+    _avatar->setWorldPosition(_position);
+    _avatar->setWorldOrientation(_orientation);
+    _avatar->setHeadOrientation(_orientation);
+    if (_settings.recording && !_settings.recording->frames.empty()) {
+        // the recording is played from where the client stands
+        _avatar->setRecordingBasis();
+        if (_settings.recording->duration > 0.0f) {
+            _recordingOffset = fmodf(_index * CLIENT_RECORDING_OFFSET_SECS, _settings.recording->duration);
+        }
+    }
+
+    _entityID = QUuid::createUuid();
+
+    _nodeList->getDomainHandler().setURLAndID(_settings.domainURL, QUuid());
+
+    _audioTimer.setTimerType(Qt::PreciseTimer);
+    connect(&_audioTimer, &QTimer::timeout, this, &VirtualClient::sendAudio);
+    _audioTimer.start((int)AudioConstants::NETWORK_FRAME_MSECS);
+
+    connect(&_avatarTimer, &QTimer::timeout, this, &VirtualClient::sendAvatar);
+    _avatarTimer.start((int)(MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS / USECS_PER_MSEC));
+
+    if (_settings.queryRate > 0.0f) {
+        connect(&_queryTimer, &QTimer::timeout, this, &VirtualClient::sendQuery);
+        _queryTimer.start((int)(MSECS_PER_SECOND / _settings.queryRate));
+    }
+
+    // started with the entity server
+    connect(&_editTimer, &QTimer::timeout, this, &VirtualClient::sendEdit);
+
+    connect(&_nodeStatsTimer, &QTimer::timeout, this, &VirtualClient::updateNodeStats);
+    _nodeStatsTimer.start(NODE_STATS_INTERVAL_MSECS);
+}
+
+void VirtualClient::stop() {
+    if (!_nodeList) {
+        return;
+    }
+
+    _domainCheckInTimer.stop();
+    _audioTimer.stop();
+    _avatarTimer.stop();
+    _queryTimer.stop();
+    _editTimer.stop();
+    _nodeStatsTimer.stop();
+
+    if (_hasEntity) {
+        QByteArray message(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
+        if (EntityItemProperties::encodeEraseEntityMessage(_entityID, message)) {
+            sendEntityMessage(PacketType::EntityErase, message);
+        }
+        _hasEntity = false;
+    }
+
+    // send the domain a disconnect packet, force stoppage of domain-server check-ins
+    _nodeList->getDomainHandler().disconnect("Finishing");
+    _nodeList->setIsShuttingDown(true);
+
+    // tell the packet receiver we're shutting down, so it can drop packets
+    _nodeList->getPacketReceiver().setShouldDropPackets(true);
+
+    releaseEncoder();
+    _nodeList.reset();
+    _isConnected = false;
+}
+
+void VirtualClient::domainConnectionRefused(const QString& reasonMessage, int reasonCodeInt, const QString& extraInfo) {
+    qWarning() << "Client" << _index << "was refused by the domain:" << reasonMessage << extraInfo;
+}
+
+void VirtualClient::connectedToDomain() {
+    if (_connectMsecs < 0) {
+        _connectMsecs = _clock.elapsed();
+    }
+    _isConnected = true;
+}
+
+void VirtualClient::nodeActivated(SharedNodePointer node) {
+    if (node->getType() == NodeType::AudioMixer) {
+        negotiateAudioFormat();
+    } else if (node->getType() == NodeType::AvatarMixer) {
+        _avatar->sendIdentityPacketTo(*_nodeList);
+    } else if (node->getType() == NodeType::EntityServer && _settings.editRate > 0.0f && !_editTimer.isActive()) {
+        _editTimer.start((int)(MSECS_PER_SECOND / _settings.editRate));
+    }
+}
+
+void VirtualClient::uuidChanged(const QUuid& ownerUUID, const QUuid& oldUUID) {
+    _avatar->setSessionUUID(ownerUUID);
+}
+
+void VirtualClient::negotiateAudioFormat() {
+    auto negotiateFormatPacket = NLPacket::create(PacketType::NegotiateAudioFormat);
+
+    // no codec falls back to pcm
+    std::vector<QString> codecNames;
+    for (auto& plugin : PluginManager::getInstance()->getCodecPlugins()) {
+        if (_settings.codecName.isEmpty() || _settings.codecName == plugin->getName()) {
+            codecNames.push_back(plugin->getName());
+        }
+    }
+
+    negotiateFormatPacket->writePrimitive((quint8)codecNames.size());
+    for (auto& codecName : codecNames) {
+        negotiateFormatPacket->writeString(codecName);
+    }
+
+    SharedNodePointer audioMixer = _nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (audioMixer) {
+        _nodeList->sendPacket(std::move(negotiateFormatPacket), *audioMixer);
+    }
+}
+
+void VirtualClient::handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message) {
+    selectAudioFormat(message->readString());
+}
+
+void VirtualClient::selectAudioFormat(const QString& selectedCodecName) {
+    if (_selectedCodecName == selectedCodecName) {
+        return;
+    }
+    _selectedCodecName = selectedCodecName;
+
+    releaseEncoder();
+    for (auto& plugin : PluginManager::getInstance()->getCodecPlugins()) {
+        if (_selectedCodecName == plugin->getName()) {
+            _codec = plugin;
+            _encoder = plugin->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
+            break;
+        }
+    }
+}
+
+void VirtualClient::releaseEncoder() {
+    if (_codec && _encoder) {
+        _codec->releaseEncoder(_encoder);
+    }
+    _encoder = nullptr;
+    _codec = nullptr;
+}
+
+void VirtualClient::handleMixedAudio(QSharedPointer<ReceivedMessage> message) {
+    ++_mixesReceived;
+    _mixBytesReceived += message->getSize();
+
+    qint64 now = _clock.elapsed();
+    if (_lastMixTime >= 0) {
+        int gap = (int)(now - _lastMixTime);
+        if (gap > _maxMixGapMsecs) {
+            _maxMixGapMsecs = gap;
+        }
+    }
+    _lastMixTime = now;
+}
+
+void VirtualClient::handleAvatarPacket(QSharedPointer<ReceivedMessage> message) {
+    ++_avatarPacketsReceived;
+    _avatarBytesReceived += message->getSize();
+}
+
+void VirtualClient::handleBulkAvatarTraits(QSharedPointer<ReceivedMessage> message) {
+    ++_avatarPacketsReceived;
+    _avatarBytesReceived += message->getSize();
+    if (!_nodeList) {
+        return;
+    }
+
+    // the mixer sends the traits again until they are acknowledged
+    AvatarTraits::TraitMessageSequence seq;
+    if (message->getBytesLeftToRead() < (qint64)sizeof(seq)) {
+        return;
+    }
+    message->readPrimitive(&seq);
+
+    SharedNodePointer avatarMixer = _nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (avatarMixer) {
+        auto traitsAckPacket = NLPacket::create(PacketType::BulkAvatarTraitsAck, sizeof(seq), true);
+        traitsAckPacket->writePrimitive(seq);
+        _nodeList->sendPacket(std::move(traitsAckPacket), *avatarMixer);
+    }
+}
+
+void VirtualClient::handleEntityPacket(QSharedPointer<ReceivedMessage> message) {
+    ++_entityPacketsReceived;
+    _entityBytesReceived += message->getSize();
+}
+
+void VirtualClient::sendAudio() {
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    // the frames are due every 10 ms from the start, whatever the timer does
+    qint64 framesDue = _clock.nsecsElapsed() / ((qint64)AudioConstants::NETWORK_FRAME_USECS * (qint64)NSECS_PER_USEC);
+
+    SharedNodePointer audioMixer = _nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (!audioMixer || !audioMixer->getActiveSocket()) {
+        _framesSent = framesDue;
+        return;
+    }
+    if (framesDue - _framesSent > MAX_CATCH_UP_FRAMES) {
+        _framesSent = framesDue - MAX_CATCH_UP_FRAMES;
+    }
+
+    Transform audioTransform;
+    audioTransform.setTranslation(_avatar->getWorldPosition());
+    audioTransform.setRotation(_avatar->getWorldOrientation());
+
+    const auto samples = reinterpret_cast<const int16_t*>(_settings.audio.constData());
+    const qint64 numSamples = _settings.audio.size() / sizeof(int16_t);
+    bool isTalking = numSamples >= NUM_FRAMES;
+    auto packetType = isTalking ? PacketType::MicrophoneAudioNoEcho : PacketType::SilentAudioFrame;
+
+    QByteArray frame(NUM_FRAMES * sizeof(int16_t), 0);
+    QByteArray encoded;
+
+    for (; _framesSent < framesDue; ++_framesSent) {
+        if (isTalking) {
+            auto destination = reinterpret_cast<int16_t*>(frame.data());
+            qint64 offset = ((_framesSent + _index * CLIENT_AUDIO_OFFSET_FRAMES) * NUM_FRAMES) % numSamples;
+            for (int i = 0; i < NUM_FRAMES; ++i) {
+                destination[i] = samples[(offset + i) % numSamples];
+            }
+        }
+
+        if (isTalking && _encoder) {
+            _encoder->encode(frame, encoded);
+        } else {
+            encoded = frame;
+        }
+
+        AbstractAudioInterface::emitAudioPacket(*_nodeList, encoded.data(), encoded.size(), _audioSequenceNumber, false,
+                                                audioTransform, _avatar->getWorldPosition(), glm::vec3(0.0f), packetType,
+                                                _selectedCodecName);
+        ++_audioFramesSent;
+    }
+}
+
+void VirtualClient::advanceMotion() {
+    float seconds = _clock.elapsed() / (float)MSECS_PER_SECOND;
+
+    const auto& recording = _settings.recording;
+    if (!recording || recording->frames.empty()) {
+        glm::quat orientation = _orientation * glm::angleAxis(TURN_RATE * seconds, Vectors::UP);
+        _avatar->setWorldOrientation(orientation);
+        _avatar->setHeadOrientation(orientation);
+        return;
+    }
+
+    float time = recording->duration > 0.0f ? fmodf(seconds + _recordingOffset, recording->duration) : 0.0f;
+    auto next = std::upper_bound(recording->times.begin(), recording->times.end(),
+                                 recording::Frame::secondsToFrameTime(time));
+    int frameIndex = std::max((int)std::distance(recording->times.begin(), next) - 1, 0);
+    if (frameIndex != _frameIndex) {
+        _frameIndex = frameIndex;
+        _avatar->fromJson(recording->frames[frameIndex], false);
+    }
+}
+
+void VirtualClient::sendAvatar() {
+    SharedNodePointer avatarMixer = _nodeList->soloNodeOfType(NodeType::AvatarMixer);
+    if (_avatar->getSessionUUID().isNull() || !avatarMixer || !avatarMixer->getActiveSocket()) {
+        return;
+    }
+
+    advanceMotion();
+    if (_avatar->sendAvatarDataPacketTo(*_nodeList) > 0) {
+        ++_avatarPacketsSent;
+    }
+}
+
+void VirtualClient::sendQuery() {
+    SharedNodePointer entityServer = _nodeList->soloNodeOfType(NodeType::EntityServer);
+    if (!entityServer || !entityServer->getActiveSocket()) {
+        return;
+    }
+
+    // the view of the avatar's eyes, which moves with its recording
+    ViewFrustum viewFrustum;
+    viewFrustum.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+    viewFrustum.setPosition(_avatar->getWorldPosition());
+    viewFrustum.setOrientation(_avatar->getWorldOrientation());
+    viewFrustum.calculate();
+
+    _octreeQuery.setConicalViews({ ConicalViewFrustum(viewFrustum) });
+    _octreeQuery.setOctreeSizeScale(DEFAULT_OCTREE_SIZE_SCALE);
+    _octreeQuery.setBoundaryLevelAdjust(0);
+    _octreeQuery.setMaxQueryPacketsPerSecond(DEFAULT_MAX_OCTREE_PPS);
+
+    auto queryPacket = NLPacket::create(PacketType::EntityQuery);
+    int packetSize = _octreeQuery.getBroadcastData(reinterpret_cast<unsigned char*>(queryPacket->getPayload()));
+    queryPacket->setPayloadSize(packetSize);
+    _nodeList->sendUnreliablePacket(*queryPacket, *entityServer);
+    ++_queriesSent;
+}
+
+QByteArray VirtualClient::encodeEntityEdit(PacketType type, const glm::vec3& position) {
+    EntityItemProperties properties;
+    if (type == PacketType::EntityAdd) {
+        properties.setType(EntityTypes::Box);
+        properties.setName(QString("Crowd Client %1").arg(_index));
+        properties.setDimensions(glm::vec3(ENTITY_SIZE));
+        properties.setLifetime(_settings.entityLifetime);
+    }
+    properties.setPosition(position);
+    properties.setLastEdited(usecTimestampNow());
+
+    QByteArray message(NLPacket::maxPayloadSize(type), 0);
+    EntityPropertyFlags didntFitProperties;
+    auto result = EntityItemProperties::encodeEntityEditPacket(type, _entityID, properties, message,
+                                                               properties.getChangedProperties(), didntFitProperties);
+    if (result != OctreeElement::COMPLETED) {
+        qWarning() << "Client" << _index << "could not encode the edit of its entity";
+        return QByteArray();
+    }
+    return message;
+}
+
+void VirtualClient::sendEntityMessage(PacketType type, QByteArray& message) {
+    SharedNodePointer entityServer = _nodeList->soloNodeOfType(NodeType::EntityServer);
+    if (!entityServer || !entityServer->getActiveSocket()) {
+        return;
+    }
+
+    auto clockSkew = entityServer->getClockSkewUsec();
+    if (clockSkew != 0 && (type == PacketType::EntityAdd || type == PacketType::EntityEdit)) {
+        EntityItem::adjustEditPacketForClockSkew(message, clockSkew);
+    }
+
+    quint16 sequence = _editSequenceNumber++;
+    quint64 now = usecTimestampNow() + clockSkew;
+
+    // adds are sent reliably, the edits are sent again soon enough
+    if (type == PacketType::EntityAdd) {
+        auto packetList = NLPacketList::create(type, QByteArray(), true, true);
+        packetList->writePrimitive(sequence);
+        packetList->writePrimitive(now);
+        packetList->write(message);
+        _nodeList->sendPacketList(std::move(packetList), *entityServer);
+    } else {
+        auto packet = NLPacket::create(type, sizeof(sequence) + sizeof(now) + message.size());
+        packet->writePrimitive(sequence);
+        packet->writePrimitive(now);
+        packet->write(message);
+        _nodeList->sendPacket(std::move(packet), *entityServer);
+    }
+}
+
+void VirtualClient::sendEdit() {
+    SharedNodePointer entityServer = _nodeList->soloNodeOfType(NodeType::EntityServer);
+    if (!entityServer || !entityServer->getActiveSocket()) {
+        return;
+    }
+
+    bool canRez = _nodeList->getThisNodeCanRez() || _nodeList->getThisNodeCanRezTmp();
+    if (!canRez) {
+        if (_canRez) {
+            qWarning() << "Client" << _index << "can't rez entities in this domain, it doesn't edit one";
+        }
+        _canRez = false;
+        return;
+    }
+    _canRez = true;
+
+    float seconds = _clock.elapsed() / (float)MSECS_PER_SECOND;
+    glm::vec3 position = _position + glm::vec3(ENTITY_ORBIT_RADIUS * cosf(seconds), ENTITY_HEIGHT,
+                                               ENTITY_ORBIT_RADIUS * sinf(seconds));
+
+    auto type = _hasEntity ? PacketType::EntityEdit : PacketType::EntityAdd;
+    QByteArray message = encodeEntityEdit(type, position);
+    if (message.isEmpty()) {
+        return;
+    }
+    sendEntityMessage(type, message);
+    _hasEntity = true;
+    ++_editsSent;
+}
+
+void VirtualClient::updateNodeStats() {
+    auto pingOf = [this](NodeType_t type) {
+        SharedNodePointer node = _nodeList->soloNodeOfType(type);
+        return node && node->getActiveSocket() ? node->getPingMs() : -1;
+    };
+    _audioMixerPingMsecs = pingOf(NodeType::AudioMixer);
+    _avatarMixerPingMsecs = pingOf(NodeType::AvatarMixer);
+    _entityServerPingMsecs = pingOf(NodeType::EntityServer);
+}
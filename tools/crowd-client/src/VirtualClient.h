@@ -0,0 +1,179 @@
+//
+//  VirtualClient.h
+//  tools/crowd-client/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_VirtualClient_h
+#define hifi_VirtualClient_h
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtCore/QUrl>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AvatarData.h>
+#include <EntityItemID.h>
+#include <NodeList.h>
+#include <OctreeQuery.h>
+#include <ReceivedMessage.h>
+#include <plugins/CodecPlugin.h>
+#include <recording/Frame.h>
+
+namespace udt {
+    class PacingEngine;
+}
+
+// the avatar frames of a recording, decoded once for all the clients that play it
+struct CrowdRecording {
+    std::vector<recording::Frame::Time> times;
+    std::vector<QJsonObject> frames;
+    float duration { 0.0f };
+};
+using CrowdRecordingPointer = std::shared_ptr<const CrowdRecording>;
+
+struct VirtualClientSettings {
+    QUrl domainURL;
+    int listenPort { INVALID_PORT };
+    std::shared_ptr<udt::PacingEngine> pacingEngine;
+    CrowdRecordingPointer recording; // none turns the avatar on the spot
+    QByteArray audio; // 24 kHz mono, looped, none sends silent frames
+    QString codecName; // restricts the negotiation, "pcm" for none
+    float queryRate { 0.0f }; // entity queries per second
+    float editRate { 0.0f }; // edits per second of an entity of the client's own, 0 for none
+    float entityLifetime { 0.0f }; // seconds, in case the client doesn't get to erase it
+};
+
+// One client of a crowd: a node list of its own connected to the domain, an avatar played from a recording, a microphone
+// played from a sound, entity queries following the avatar's view and an entity it edits, as an interface would send.
+//
+// A client lives on one of the threads of the crowd, with its node list. It only makes the traffic of a client: it counts
+// the mixes, avatars and entities it gets back but doesn't decode them.
+class VirtualClient : public QObject {
+    Q_OBJECT
+public:
+    struct Stats {
+        bool isConnected { false };
+        qint64 connectMsecs { -1 }; // from the start to the connection to the domain, -1 until then
+
+        // since the previous sample
+        uint64_t audioFramesSent { 0 };
+        uint64_t avatarPacketsSent { 0 };
+        uint64_t queriesSent { 0 };
+        uint64_t editsSent { 0 };
+        uint64_t mixesReceived { 0 };
+        uint64_t mixBytesReceived { 0 };
+        uint64_t avatarPacketsReceived { 0 };
+        uint64_t avatarBytesReceived { 0 };
+        uint64_t entityPacketsReceived { 0 };
+        uint64_t entityBytesReceived { 0 };
+        int maxMixGapMsecs { 0 }; // the longest wait for a mix
+
+        // -1 without the node
+        int audioMixerPingMsecs { -1 };
+        int avatarMixerPingMsecs { -1 };
+        int entityServerPingMsecs { -1 };
+    };
+
+    VirtualClient(int index, const glm::vec3& position, const glm::quat& orientation, const VirtualClientSettings& settings);
+    ~VirtualClient();
+
+    // thread-safe
+    Stats sampleStats();
+
+public slots:
+    // on the client's thread
+    void start();
+    // erases the entity of the client and disconnects it from the domain
+    void stop();
+
+private slots:
+    void domainConnectionRefused(const QString& reasonMessage, int reasonCodeInt, const QString& extraInfo);
+    void connectedToDomain();
+    void nodeActivated(SharedNodePointer node);
+    void uuidChanged(const QUuid& ownerUUID, const QUuid& oldUUID);
+    void handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message);
+    void handleMixedAudio(QSharedPointer<ReceivedMessage> message);
+    void handleAvatarPacket(QSharedPointer<ReceivedMessage> message);
+    void handleBulkAvatarTraits(QSharedPointer<ReceivedMessage> message);
+    void handleEntityPacket(QSharedPointer<ReceivedMessage> message);
+    void sendAudio();
+    void sendAvatar();
+    void sendQuery();
+    void sendEdit();
+    void updateNodeStats();
+
+private:
+    void negotiateAudioFormat();
+    void selectAudioFormat(const QString& selectedCodecName);
+    void releaseEncoder();
+    // plays the recording, or turns on the spot without one
+    void advanceMotion();
+    // wraps the edit message as an entity edit packet sender would
+    void sendEntityMessage(PacketType type, QByteArray& message);
+    QByteArray encodeEntityEdit(PacketType type, const glm::vec3& position);
+
+    const int _index;
+    const glm::vec3 _position;
+    const glm::quat _orientation;
+    const VirtualClientSettings _settings;
+
+    QSharedPointer<NodeList> _nodeList;
+    AvatarSharedPointer _avatar;
+    OctreeQuery _octreeQuery { true };
+
+    QElapsedTimer _clock;
+    QTimer _domainCheckInTimer;
+    QTimer _audioTimer;
+    QTimer _avatarTimer;
+    QTimer _queryTimer;
+    QTimer _editTimer;
+    QTimer _nodeStatsTimer;
+
+    float _recordingOffset { 0.0f };
+    int _frameIndex { -1 };
+
+    QString _selectedCodecName;
+    CodecPluginPointer _codec;
+    Encoder* _encoder { nullptr };
+    qint64 _framesSent { 0 };
+    quint16 _audioSequenceNumber { 0 };
+    qint64 _lastMixTime { -1 };
+
+    EntityItemID _entityID;
+    bool _hasEntity { false };
+    bool _canRez { true };
+    quint16 _editSequenceNumber { 0 };
+
+    std::atomic<bool> _isConnected { false };
+    std::atomic<qint64> _connectMsecs { -1 };
+    std::atomic<uint64_t> _audioFramesSent { 0 };
+    std::atomic<uint64_t> _avatarPacketsSent { 0 };
+    std::atomic<uint64_t> _queriesSent { 0 };
+    std::atomic<uint64_t> _editsSent { 0 };
+    std::atomic<uint64_t> _mixesReceived { 0 };
+    std::atomic<uint64_t> _mixBytesReceived { 0 };
+    std::atomic<uint64_t> _avatarPacketsReceived { 0 };
+    std::atomic<uint64_t> _avatarBytesReceived { 0 };
+    std::atomic<uint64_t> _entityPacketsReceived { 0 };
+    std::atomic<uint64_t> _entityBytesReceived { 0 };
+    std::atomic<int> _maxMixGapMsecs { 0 };
+    std::atomic<int> _audioMixerPingMsecs { -1 };
+    std::atomic<int> _avatarMixerPingMsecs { -1 };
+    std::atomic<int> _entityServerPingMsecs { -1 };
+};
+
+#endif // hifi_VirtualClient_h
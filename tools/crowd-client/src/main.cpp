@@ -0,0 +1,24 @@
+//
+//  main.cpp
+//  tools/crowd-client/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+#include <SettingHandle.h>
+
+#include "CrowdClientApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Crowd Client");
+
+    Setting::init();
+
+    CrowdClientApp app(argc, argv);
+    return app.exec();
+}
@@ -0,0 +1,269 @@
+//
+//  Created by Vircadia contributors on 2021-03-27
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameBenchmark.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QLoggingCategory>
+
+#include <gpu/Batch.h>
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <gpu/Query.h>
+
+Q_DECLARE_LOGGING_CATEGORY(gpu_player_logging)
+
+const int FrameBenchmark::DEFAULT_WARMUP_COUNT = 10;
+const int FrameBenchmark::DEFAULT_REPEAT_COUNT = 100;
+const float FrameBenchmark::DEFAULT_THRESHOLD = 0.1f;
+const double FrameBenchmark::MIN_REGRESSION_MSECS = 0.05;
+
+static const QString FRAME_TASK_NAME = "frame";
+
+void FrameBenchmark::addCapture(const QString& name, const gpu::FramePointer& frame) {
+    Capture capture;
+    capture.name = name;
+    capture.frame = frame;
+    _captures.push_back(capture);
+}
+
+gpu::FramePointer FrameBenchmark::getFrame() {
+    while (_currentCapture < _captures.size()) {
+        auto& capture = _captures[_currentCapture];
+        if (capture.replayCount < _settings.warmupCount + _settings.repeatCount) {
+            if (capture.replayCount == 0) {
+                qCInfo(gpu_player_logging) << "Replaying" << capture.name;
+                setupQueries(capture);
+            }
+            return capture.frame;
+        }
+
+        // done with it, the next capture may need the memory
+        capture.frame.reset();
+        _batchQueries.clear();
+        ++_currentCapture;
+    }
+    return nullptr;
+}
+
+void FrameBenchmark::setupQueries(const Capture& capture) {
+    _frameQuery = std::make_shared<gpu::Query>([this](const gpu::Query& query) {
+        _replayFrame.gpu += query.getGPUElapsedTime();
+        _replayFrame.cpu += query.getBatchElapsedTime();
+    }, FRAME_TASK_NAME.toStdString());
+
+    _batchQueries.clear();
+    for (const auto& batch : capture.frame->batches) {
+        const std::string& name = batch->getName();
+        _batchQueries.push_back(std::make_shared<gpu::Query>([this, name](const gpu::Query& query) {
+            auto& timing = _replayTasks[name];
+            timing.gpu += query.getGPUElapsedTime();
+            timing.cpu += query.getBatchElapsedTime();
+        }, name));
+    }
+}
+
+void FrameBenchmark::executeFrame(const gpu::ContextPointer& context, const gpu::FramePointer& frame) {
+    if (frame->batches.size() != _batchQueries.size()) {
+        return;
+    }
+
+    context->consumeFrameUpdates(frame);
+    const auto& backend = context->getBackend();
+    backend->setStereoState(frame->stereoState);
+
+    context->executeBatch("FrameBenchmark::begin", [&](gpu::Batch& batch) {
+        batch.beginQuery(_frameQuery);
+    });
+    for (size_t i = 0; i < frame->batches.size(); ++i) {
+        const auto& query = _batchQueries[i];
+        context->executeBatch("FrameBenchmark::beginTask", [&](gpu::Batch& batch) {
+            batch.beginQuery(query);
+        });
+        backend->render(*frame->batches[i]);
+        context->executeBatch("FrameBenchmark::endTask", [&](gpu::Batch& batch) {
+            batch.endQuery(query);
+        });
+    }
+    context->executeBatch("FrameBenchmark::end", [&](gpu::Batch& batch) {
+        batch.endQuery(_frameQuery);
+    });
+}
+
+void FrameBenchmark::endFrame(const gpu::ContextPointer& context) {
+    if (_currentCapture >= _captures.size()) {
+        return;
+    }
+
+    // The handlers of the queries sum up the timings of the replay
+    _replayFrame = Timing();
+    _replayTasks.clear();
+    context->executeBatch("FrameBenchmark::getQueries", [&](gpu::Batch& batch) {
+        batch.getQuery(_frameQuery);
+        for (const auto& query : _batchQueries) {
+            batch.getQuery(query);
+        }
+    });
+
+    auto& capture = _captures[_currentCapture];
+    if (capture.replayCount >= _settings.warmupCount) {
+        addSample(capture.frameSamples, _replayFrame);
+        for (const auto& task : _replayTasks) {
+            addSample(capture.taskSamples[task.first], task.second);
+        }
+    }
+    ++capture.replayCount;
+}
+
+void FrameBenchmark::addSample(Samples& samples, const Timing& timing) {
+    samples.gpu.push_back(timing.gpu);
+    samples.cpu.push_back(timing.cpu);
+}
+
+double FrameBenchmark::median(std::vector<double> samples) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    auto middle = samples.begin() + samples.size() / 2;
+    std::nth_element(samples.begin(), middle, samples.end());
+    return *middle;
+}
+
+QJsonObject FrameBenchmark::toJson(const Samples& samples) {
+    auto statistics = [](const std::vector<double>& values) {
+        QJsonObject result;
+        if (values.empty()) {
+            return result;
+        }
+        result["median"] = median(values);
+        result["mean"] = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+        result["min"] = *std::min_element(values.begin(), values.end());
+        result["max"] = *std::max_element(values.begin(), values.end());
+        return result;
+    };
+
+    QJsonObject result;
+    result["gpuMsecs"] = statistics(samples.gpu);
+    result["cpuMsecs"] = statistics(samples.cpu);
+    return result;
+}
+
+QJsonObject FrameBenchmark::toJson(const Capture& capture) {
+    QJsonObject tasks;
+    for (const auto& task : capture.taskSamples) {
+        tasks[QString::fromStdString(task.first)] = toJson(task.second);
+    }
+
+    QJsonObject result;
+    result["name"] = capture.name;
+    result["replays"] = (int)capture.frameSamples.gpu.size();
+    result[FRAME_TASK_NAME] = toJson(capture.frameSamples);
+    result["tasks"] = tasks;
+    return result;
+}
+
+QJsonArray FrameBenchmark::compare(const QJsonArray& captures, const QJsonArray& baselineCaptures) const {
+    QJsonArray regressions;
+
+    auto compareMedians = [&](const QString& capture, const QString& task, const QJsonObject& current,
+                              const QJsonObject& baseline) {
+        for (const QString& measure : { "gpuMsecs", "cpuMsecs" }) {
+            auto baselineMedian = baseline[measure].toObject()["median"];
+            auto currentMedian = current[measure].toObject()["median"];
+            if (!baselineMedian.isDouble() || !currentMedian.isDouble()) {
+                continue;
+            }
+            double before = baselineMedian.toDouble();
+            double after = currentMedian.toDouble();
+            if (after > before * (1.0 + _settings.threshold) && after - before > MIN_REGRESSION_MSECS) {
+                qCWarning(gpu_player_logging) << "Regression in" << capture << task << measure << "median:" << before
+                                              << "ms in the baseline," << after << "ms now";
+                QJsonObject regression;
+                regression["capture"] = capture;
+                regression["task"] = task;
+                regression["measure"] = measure;
+                regression["baseline"] = before;
+                regression["current"] = after;
+                regressions.append(regression);
+            }
+        }
+    };
+
+    for (const auto& captureValue : captures) {
+        auto capture = captureValue.toObject();
+        auto name = capture["name"].toString();
+        auto baselineCapture = std::find_if(baselineCaptures.begin(), baselineCaptures.end(), [&](const QJsonValue& value) {
+            return value.toObject()["name"].toString() == name;
+        });
+        if (baselineCapture == baselineCaptures.end()) {
+            qCInfo(gpu_player_logging) << "No baseline for" << name;
+            continue;
+        }
+
+        auto baseline = (*baselineCapture).toObject();
+        compareMedians(name, FRAME_TASK_NAME, capture[FRAME_TASK_NAME].toObject(), baseline[FRAME_TASK_NAME].toObject());
+
+        // the tasks that are new or gone are not regressions in themselves, the frame time tells
+        auto tasks = capture["tasks"].toObject();
+        auto baselineTasks = baseline["tasks"].toObject();
+        for (auto task = tasks.begin(); task != tasks.end(); ++task) {
+            if (baselineTasks.contains(task.key())) {
+                compareMedians(name, task.key(), task.value().toObject(), baselineTasks[task.key()].toObject());
+            }
+        }
+    }
+    return regressions;
+}
+
+bool FrameBenchmark::report(const std::string& backendVersion) {
+    QJsonArray captures;
+    for (const auto& capture : _captures) {
+        captures.append(toJson(capture));
+    }
+
+    QJsonArray regressions;
+    if (!_settings.baselinePath.isEmpty()) {
+        QFile baselineFile(_settings.baselinePath);
+        if (baselineFile.open(QIODevice::ReadOnly)) {
+            auto baseline = QJsonDocument::fromJson(baselineFile.readAll()).object();
+            regressions = compare(captures, baseline["captures"].toArray());
+        } else {
+            qCWarning(gpu_player_logging) << "Unable to read the baseline" << _settings.baselinePath;
+        }
+    }
+
+    QJsonObject results;
+    results["backend"] = QString::fromStdString(backendVersion);
+    results["warmup"] = _settings.warmupCount;
+    results["repeat"] = _settings.repeatCount;
+    results["captures"] = captures;
+    if (!_settings.baselinePath.isEmpty()) {
+        results["baseline"] = _settings.baselinePath;
+        results["threshold"] = _settings.threshold;
+        results["regressions"] = regressions;
+    }
+
+    auto json = QJsonDocument(results).toJson();
+    if (_settings.outputPath.isEmpty()) {
+        qCInfo(gpu_player_logging).noquote() << json;
+    } else {
+        QFile outputFile(_settings.outputPath);
+        if (outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            outputFile.write(json);
+            qCInfo(gpu_player_logging) << "Benchmark results written to" << _settings.outputPath;
+        } else {
+            qCWarning(gpu_player_logging) << "Unable to write the results to" << _settings.outputPath;
+        }
+    }
+
+    return regressions.isEmpty();
+}
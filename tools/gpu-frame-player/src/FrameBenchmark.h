@@ -0,0 +1,95 @@
+//
+//  Created by Vircadia contributors on 2021-03-27
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include <gpu/Forward.h>
+
+// Replays a set of captured frames a fixed number of times each, and reports the time spent on them.
+//
+// Each batch of a frame is timed on its own with a gpu::Query, the batches being named after the render tasks that
+// recorded them. The GPU time and the CPU time of the backend are collected per task and for the whole frame, written to
+// a JSON file, and compared with the medians of a baseline written by a previous run.
+class FrameBenchmark {
+public:
+    static const int DEFAULT_WARMUP_COUNT;
+    static const int DEFAULT_REPEAT_COUNT;
+    static const float DEFAULT_THRESHOLD;        // above the baseline median, relative
+    static const double MIN_REGRESSION_MSECS;    // below this, a difference with the baseline is noise
+
+    struct Settings {
+        int warmupCount { DEFAULT_WARMUP_COUNT };
+        int repeatCount { DEFAULT_REPEAT_COUNT };
+        QString outputPath;
+        QString baselinePath;
+        float threshold { DEFAULT_THRESHOLD };
+    };
+
+    FrameBenchmark(const Settings& settings) : _settings(settings) {}
+
+    void addCapture(const QString& name, const gpu::FramePointer& frame);
+
+    // On the render thread:
+    // the capture to replay, null once all have been replayed
+    gpu::FramePointer getFrame();
+    // replays the frame, in place of gpu::Context::executeFrame
+    void executeFrame(const gpu::ContextPointer& context, const gpu::FramePointer& frame);
+    // once the GPU is done with the frame, gets the timers back
+    void endFrame(const gpu::ContextPointer& context);
+
+    // writes the results and compares them with the baseline, false if there is a regression
+    bool report(const std::string& backendVersion);
+
+private:
+    struct Samples {
+        std::vector<double> gpu;    // msecs
+        std::vector<double> cpu;    // msecs
+    };
+
+    struct Timing {
+        double gpu { 0.0 };
+        double cpu { 0.0 };
+    };
+
+    struct Capture {
+        QString name;
+        gpu::FramePointer frame;
+        int replayCount { 0 };
+        Samples frameSamples;
+        std::map<std::string, Samples> taskSamples;
+    };
+
+    void setupQueries(const Capture& capture);
+    static void addSample(Samples& samples, const Timing& timing);
+    static QJsonObject toJson(const Capture& capture);
+    static QJsonObject toJson(const Samples& samples);
+    static double median(std::vector<double> samples);
+    QJsonArray compare(const QJsonArray& captures, const QJsonArray& baselineCaptures) const;
+
+    Settings _settings;
+    std::vector<Capture> _captures;
+    size_t _currentCapture { 0 };
+
+    // the timers of the current capture, one per batch, reused by each replay
+    gpu::QueryPointer _frameQuery;
+    std::vector<gpu::QueryPointer> _batchQueries;
+
+    // of the current replay, the batches of the same task are summed
+    Timing _replayFrame;
+    std::map<std::string, Timing> _replayTasks;
+};
+
+using FrameBenchmarkPointer = std::shared_ptr<FrameBenchmark>;
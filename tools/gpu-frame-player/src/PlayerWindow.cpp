@@ -10,6 +10,7 @@
 
 #include <QtCore/QByteArray>
 #include <QtCore/QBuffer>
+#include <QtCore/QDir>
 #include <QtGui/QResizeEvent>
 #include <QtGui/QImageReader>
 #include <QtGui/QScreen>
@@ -106,6 +107,37 @@ void PlayerWindow::resizeEvent(QResizeEvent* ev) {
     _renderThread.resize(ev->size());
 }
 
+bool PlayerWindow::startBenchmark(const QStringList& paths, const FrameBenchmark::Settings& settings) {
+    QStringList captures;
+    for (const auto& path : paths) {
+        QFileInfo info(path);
+        if (info.isDir()) {
+            for (const auto& entry : QDir(path).entryInfoList({ QString("*") + gpu::hfb::EXTENSION }, QDir::Files, QDir::Name)) {
+                captures << entry.absoluteFilePath();
+            }
+        } else {
+            captures << info.absoluteFilePath();
+        }
+    }
+
+    auto benchmark = std::make_shared<FrameBenchmark>(settings);
+    for (const auto& capture : captures) {
+        auto frame = gpu::readFrame(capture.toStdString(), _renderThread._externalTexture);
+        if (!frame || !frame->framebuffer) {
+            qWarning() << "Unable to load the capture" << capture;
+            return false;
+        }
+        benchmark->addCapture(QFileInfo(capture).completeBaseName(), frame);
+    }
+    if (captures.empty()) {
+        qWarning() << "No capture to replay";
+        return false;
+    }
+
+    _renderThread.startBenchmark(benchmark);
+    return true;
+}
+
 void PlayerWindow::loadFrame(const QString& path) {
     auto frame = gpu::readFrame(path.toStdString(), _renderThread._externalTexture);
     if (frame) {
@@ -20,6 +20,9 @@ public:
     PlayerWindow();
     virtual ~PlayerWindow();
 
+    // replays the captures, the paths of .hfb files or of directories of these, then quits
+    bool startBenchmark(const QStringList& paths, const FrameBenchmark::Settings& settings);
+
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
     void keyPressEvent(QKeyEvent* event) override;
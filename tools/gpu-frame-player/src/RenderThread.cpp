@@ -7,6 +7,7 @@
 //
 
 #include "RenderThread.h"
+#include <QtCore/QCoreApplication>
 #include <QtGui/QWindow>
 #include <gl/QOpenGLContextWrapper.h>
 
@@ -15,6 +16,11 @@ void RenderThread::submitFrame(const gpu::FramePointer& frame) {
     _pendingFrames.push(frame);
 }
 
+void RenderThread::startBenchmark(const FrameBenchmarkPointer& benchmark) {
+    std::unique_lock<std::mutex> lock(_frameLock);
+    _benchmark = benchmark;
+}
+
 void RenderThread::resize(const QSize& newSize) {
     std::unique_lock<std::mutex> lock(_frameLock);
     _pendingSize.push(newSize);
@@ -171,12 +177,19 @@ void RenderThread::renderFrame(gpu::FramePointer& frame) {
 
     //_gpuContext->enableStereo(true);
     if (frame && !frame->batches.empty()) {
-        _gpuContext->executeFrame(frame);
+        if (_activeBenchmark) {
+            _activeBenchmark->executeFrame(_gpuContext, frame);
+        } else {
+            _gpuContext->executeFrame(frame);
+        }
     }
 
 #ifdef USE_GL
     static gpu::BatchPointer batch = nullptr;
-    if (!batch) {
+    static gpu::FramebufferPointer presentedFramebuffer = nullptr;
+    // a benchmark replays several captures
+    if (!batch || presentedFramebuffer != frame->framebuffer) {
+        presentedFramebuffer = frame->framebuffer;
         batch = std::make_shared<gpu::Batch>();
         batch->setPipeline(_presentPipeline);
         batch->setFramebuffer(nullptr);
@@ -199,6 +212,11 @@ void RenderThread::renderFrame(gpu::FramePointer& frame) {
 */
     (void)CHECK_GL_ERROR();
     _context.swapBuffers();
+    if (_activeBenchmark) {
+        // wait for the GPU to be done with the frame, so that its timers can all be read back
+        glFinish();
+        _activeBenchmark->endFrame(_gpuContext);
+    }
     _context.doneCurrent();
 #else
     endRegion(commandBuffer);
@@ -227,6 +245,7 @@ bool RenderThread::process() {
         std::unique_lock<std::mutex> lock(_frameLock);
         pendingFrames.swap(_pendingFrames);
         pendingSize.swap(_pendingSize);
+        _activeBenchmark = _benchmark;
     }
     
     while (!pendingFrames.empty()) {
@@ -235,6 +254,18 @@ bool RenderThread::process() {
         _gpuContext->consumeFrameUpdates(_activeFrame);
     }
 
+    if (_activeBenchmark) {
+        _activeFrame = _activeBenchmark->getFrame();
+        if (!_activeFrame) {
+            bool passed = _activeBenchmark->report(_backend->getVersion());
+            _activeBenchmark.reset();
+            QMetaObject::invokeMethod(qApp, [passed] {
+                QCoreApplication::exit(passed ? 0 : 1);
+            }, Qt::QueuedConnection);
+            return false;
+        }
+    }
+
     while (!pendingSize.empty()) {
 #ifndef USE_GL
         const auto& size = pendingSize.front();
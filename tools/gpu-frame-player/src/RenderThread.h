@@ -13,6 +13,8 @@
 #include <GenericThread.h>
 #include <shared/RateCounter.h>
 
+#include "FrameBenchmark.h"
+
 #ifdef USE_GL
 #include <gl/Config.h>
 #include <gl/Context.h>
@@ -58,6 +60,9 @@ public:
     void move(const glm::vec3& v);
     glm::mat4 _correction;
     gpu::PipelinePointer _presentPipeline;
+    // replays its captures in place of the submitted frames, then quits
+    FrameBenchmarkPointer _benchmark;
+    FrameBenchmarkPointer _activeBenchmark;     // on the render thread
 
     void resize(const QSize& newSize);
     void setup() override;
@@ -65,6 +70,7 @@ public:
     void shutdown() override;
 
     void submitFrame(const gpu::FramePointer& frame);
+    void startBenchmark(const FrameBenchmarkPointer& benchmark);
     void initialize(QWindow* window);
     void renderFrame(gpu::FramePointer& frame);
 };
@@ -6,6 +6,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
+#include <QtCore/QCommandLineParser>
 #include <QtWidgets/QApplication>
 
 #include <shared/FileLogger.h>
@@ -26,9 +29,44 @@ int main(int argc, char** argv) {
     setupHifiApplication("gpuFramePlayer");
 
     QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays the frames captured by gpu::FrameWriter");
+    parser.addHelpOption();
+    const QCommandLineOption benchmarkOption("benchmark", "replay the captures given as arguments, and report their timings");
+    parser.addOption(benchmarkOption);
+    const QCommandLineOption warmupOption("warmup", "replays of each capture before the timed ones",
+                                          "count", QString::number(FrameBenchmark::DEFAULT_WARMUP_COUNT));
+    parser.addOption(warmupOption);
+    const QCommandLineOption repeatOption("repeat", "timed replays of each capture",
+                                          "count", QString::number(FrameBenchmark::DEFAULT_REPEAT_COUNT));
+    parser.addOption(repeatOption);
+    const QCommandLineOption outputOption("output", "JSON file the timings are written to, the log otherwise", "file");
+    parser.addOption(outputOption);
+    const QCommandLineOption baselineOption("baseline", "JSON file of a previous run the timings are compared with", "file");
+    parser.addOption(baselineOption);
+    const QCommandLineOption thresholdOption("threshold", "relative increase of a median over the baseline that fails the run",
+                                             "ratio", QString::number(FrameBenchmark::DEFAULT_THRESHOLD));
+    parser.addOption(thresholdOption);
+    parser.addPositionalArgument("captures", "the .hfb files, or directories of these, to benchmark");
+    parser.process(app);
+
     logger.reset(new FileLogger());
     setup();
     PlayerWindow window;
-    app.exec();
-    return 0;
+
+    if (parser.isSet(benchmarkOption)) {
+        FrameBenchmark::Settings settings;
+        settings.warmupCount = std::max(parser.value(warmupOption).toInt(), 0);
+        settings.repeatCount = std::max(parser.value(repeatOption).toInt(), 1);
+        settings.outputPath = parser.value(outputOption);
+        settings.baselinePath = parser.value(baselineOption);
+        settings.threshold = std::max(parser.value(thresholdOption).toFloat(), 0.0f);
+        if (!window.startBenchmark(parser.positionalArguments(), settings)) {
+            window.close();
+            return 1;
+        }
+    }
+
+    return app.exec();
 }
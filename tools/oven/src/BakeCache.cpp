@@ -0,0 +1,173 @@
+//
+//  BakeCache.cpp
+//  tools/oven/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeCache.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSysInfo>
+
+// bumped when the output of the bakers changes, so that bakes from older ovens aren't used
+static const QByteArray BAKE_CACHE_VERSION = "1";
+
+// a claim that hasn't been refreshed for this long belongs to an instance that is gone
+static const qint64 STALE_CLAIM_SECS = 10 * 60;
+
+static const QString MANIFEST_MAIN_FILE_KEY = "mainFile";
+static const QString MANIFEST_HOST_KEY = "host";
+static const QString MANIFEST_TIME_KEY = "time";
+
+static bool copyDirectory(const QString& sourcePath, const QString& destinationPath) {
+    QDir source(sourcePath);
+    if (!source.exists() || !QDir().mkpath(destinationPath)) {
+        return false;
+    }
+
+    QDirIterator it(sourcePath, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        auto filePath = it.next();
+        auto destinationFilePath = QDir(destinationPath).absoluteFilePath(source.relativeFilePath(filePath));
+        if (!QDir().mkpath(QFileInfo(destinationFilePath).absolutePath())) {
+            return false;
+        }
+        QFile::remove(destinationFilePath);
+        if (!QFile::copy(filePath, destinationFilePath)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BakeCache::BakeCache(const QString& path) : _dir(path) {
+    _isValid = QDir().mkpath(path) && _dir.exists();
+    if (!_isValid) {
+        qWarning() << "Could not use bake cache folder" << path;
+    }
+}
+
+QByteArray BakeCache::getModelKey(const QUrl& modelURL) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData("model");
+    hash.addData(BAKE_CACHE_VERSION);
+
+    // the baked files are named after the model
+    hash.addData(modelURL.fileName().toUtf8());
+
+    QFile file(modelURL.toLocalFile());
+    if (modelURL.isLocalFile() && file.open(QIODevice::ReadOnly)) {
+        hash.addData(&file);
+    } else {
+        // a remote model isn't downloaded just to be hashed, its URL stands for it
+        hash.addData(modelURL.adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment).toEncoded());
+    }
+    return hash.result().toHex();
+}
+
+bool BakeCache::contains(const QByteArray& key) const {
+    return _isValid && QFile::exists(getManifestPath(key));
+}
+
+bool BakeCache::isClaimed(const QByteArray& key) const {
+    QFileInfo claim(getClaimPath(key));
+    return claim.exists() && claim.lastModified().secsTo(QDateTime::currentDateTime()) < STALE_CLAIM_SECS;
+}
+
+bool BakeCache::claim(const QByteArray& key) {
+    if (!_isValid || contains(key)) {
+        return false;
+    }
+
+    auto claimPath = getClaimPath(key);
+    if (QFile::exists(claimPath)) {
+        if (isClaimed(key)) {
+            return false;
+        }
+        // two instances can both take over a stale claim, which only means the bake is done twice
+        qDebug() << "Taking over the stale bake cache claim" << claimPath;
+        QFile::remove(claimPath);
+    }
+
+    // the claim is only ours if we are the ones creating it
+    QFile claimFile(claimPath);
+    if (!claimFile.open(QIODevice::WriteOnly | QIODevice::NewOnly)) {
+        return false;
+    }
+    claimFile.write(QSysInfo::machineHostName().toUtf8() + " " + QByteArray::number(QCoreApplication::applicationPid()));
+    return true;
+}
+
+void BakeCache::refreshClaim(const QByteArray& key) {
+    QFile claimFile(getClaimPath(key));
+    if (claimFile.open(QIODevice::ReadWrite)) {
+        claimFile.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+}
+
+void BakeCache::release(const QByteArray& key) {
+    QFile::remove(getClaimPath(key));
+}
+
+bool BakeCache::store(const QByteArray& key, const QString& outputPath, const QString& mainFilePath) {
+    if (!_isValid) {
+        return false;
+    }
+
+    // copy aside first, so that an entry is either complete or missing
+    auto entryPath = getEntryPath(key);
+    auto temporaryPath = entryPath + ".tmp-" + QString::number(QCoreApplication::applicationPid());
+    QDir(temporaryPath).removeRecursively();
+    if (!copyDirectory(outputPath, temporaryPath)) {
+        qWarning() << "Could not copy" << outputPath << "to the bake cache";
+        QDir(temporaryPath).removeRecursively();
+        release(key);
+        return false;
+    }
+
+    QDir(entryPath).removeRecursively();
+    if (!QDir().rename(temporaryPath, entryPath)) {
+        QDir(temporaryPath).removeRecursively();
+        release(key);
+        return false;
+    }
+
+    QJsonObject manifest;
+    manifest[MANIFEST_MAIN_FILE_KEY] = mainFilePath;
+    manifest[MANIFEST_HOST_KEY] = QSysInfo::machineHostName();
+    manifest[MANIFEST_TIME_KEY] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+
+    QFile manifestFile(getManifestPath(key));
+    bool stored = manifestFile.open(QIODevice::WriteOnly) && manifestFile.write(QJsonDocument(manifest).toJson()) != -1;
+    manifestFile.close();
+    if (!stored) {
+        manifestFile.remove();
+    }
+    release(key);
+    return stored;
+}
+
+QString BakeCache::fetch(const QByteArray& key, const QString& outputPath) const {
+    QFile manifestFile(getManifestPath(key));
+    if (!manifestFile.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    auto mainFilePath = QJsonDocument::fromJson(manifestFile.readAll()).object()[MANIFEST_MAIN_FILE_KEY].toString();
+    if (mainFilePath.isEmpty() || !copyDirectory(getEntryPath(key), outputPath)) {
+        return QString();
+    }
+    return mainFilePath;
+}
@@ -0,0 +1,58 @@
+//
+//  BakeCache.h
+//  tools/oven/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeCache_h
+#define hifi_BakeCache_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+
+// A folder of finished bakes, keyed by a hash of what was baked. The folder can be on a share used by oven instances on
+// several machines baking the same domain: a bake that is in the cache isn't baked again, and an instance claims a bake
+// before starting it so that the other instances wait for its results rather than baking it too.
+//
+// <key>/      the baked output, as laid out in the content folder of a bake
+// <key>.json  the manifest, written once the output is complete
+// <key>.claim held by the instance baking it, refreshed while it bakes
+class BakeCache {
+public:
+    BakeCache(const QString& path);
+
+    bool isValid() const { return _isValid; }
+
+    // the key of a model bake, from the content of the model when it is a local file and from its URL otherwise
+    static QByteArray getModelKey(const QUrl& modelURL);
+
+    bool contains(const QByteArray& key) const;
+    bool isClaimed(const QByteArray& key) const;
+
+    // true if this instance now holds the claim on the bake, which has to be stored or released
+    bool claim(const QByteArray& key);
+    void refreshClaim(const QByteArray& key);
+    void release(const QByteArray& key);
+
+    // mainFilePath is the path of the file the baked references point to, relative to outputPath
+    bool store(const QByteArray& key, const QString& outputPath, const QString& mainFilePath);
+    // copies the output of a cached bake to outputPath, returns the path of its main file relative to outputPath
+    QString fetch(const QByteArray& key, const QString& outputPath) const;
+
+private:
+    QString getEntryPath(const QByteArray& key) const { return _dir.absoluteFilePath(key); }
+    QString getManifestPath(const QByteArray& key) const { return _dir.absoluteFilePath(key + ".json"); }
+    QString getClaimPath(const QByteArray& key) const { return _dir.absoluteFilePath(key + ".claim"); }
+
+    QDir _dir;
+    bool _isValid { false };
+};
+
+#endif // hifi_BakeCache_h
@@ -24,12 +24,14 @@
 #include "JSBaker.h"
 #include "TextureBaker.h"
 #include "MaterialBaker.h"
+#include "DomainBaker.h"
 
 BakerCLI::BakerCLI(OvenCLIApplication* parent) : QObject(parent) {
     
 }
 
-void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type) {
+void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type,
+                        const QUrl& destinationPath, const QString& bakeCachePath) {
 
     // if the URL doesn't have a scheme, assume it is a local file
     if (inputUrl.scheme() != "http" && inputUrl.scheme() != "https" && inputUrl.scheme() != "ftp" && inputUrl.scheme() != "file") {
@@ -42,6 +44,7 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
     static const QString FBX_EXTENSION { "fbx" };     // legacy
     static const QString MATERIAL_EXTENSION { "material" };
     static const QString SCRIPT_EXTENSION { "js" };
+    static const QString DOMAIN_TYPE { "domain" };
 
     _outputPath = outputPath;
 
@@ -58,6 +61,15 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
         // FIXME: disabled for now because it breaks some scripts
         //_baker = std::unique_ptr<Baker> { new JSBaker(inputUrl, outputPath) };
         //_baker->moveToThread(Oven::instance().getNextWorkerThread());
+    } else if (type == DOMAIN_TYPE) {
+        // the input is the entities file of the domain
+        if (destinationPath.isEmpty()) {
+            qCDebug(model_baking) << "A destination is needed to bake a domain";
+            QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+            return;
+        }
+        _baker = std::unique_ptr<Baker> { new DomainBaker(inputUrl, QString(), outputPath, destinationPath, false, bakeCachePath) };
+        _baker->moveToThread(Oven::instance().getNextWorkerThread());
     } else if (type == MATERIAL_EXTENSION) {
         _baker = std::unique_ptr<Baker> { new MaterialBaker(inputUrl.toDisplayString(), true, outputPath) };
         _baker->moveToThread(Oven::instance().getNextWorkerThread());
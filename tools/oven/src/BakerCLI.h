@@ -34,7 +34,8 @@ public:
     BakerCLI(OvenCLIApplication* parent);
 
 public slots:
-    void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString());
+    void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString(),
+                  const QUrl& destinationPath = QUrl(), const QString& bakeCachePath = QString());
 
 private slots:
     void handleFinishedBaker();  
@@ -23,7 +23,7 @@
 
 DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainName,
                          const QString& baseOutputPath, const QUrl& destinationPath,
-                         bool shouldRebakeOriginals) :
+                         bool shouldRebakeOriginals, const QString& bakeCachePath) :
     _localEntitiesFileURL(localModelFileURL),
     _domainName(domainName),
     _baseOutputPath(baseOutputPath),
@@ -35,6 +35,13 @@ DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainNam
     } else {
         _destinationPath = destinationPath;
     }
+
+    if (!bakeCachePath.isEmpty()) {
+        _bakeCache = std::make_unique<BakeCache>(bakeCachePath);
+        if (!_bakeCache->isValid()) {
+            _bakeCache.reset();
+        }
+    }
 }
 
 void DomainBaker::bake() {
@@ -56,6 +63,18 @@ void DomainBaker::bake() {
         return;
     }
 
+    if (!_cachedModels.isEmpty() || !_claimedModels.isEmpty()) {
+        // watch for the models other instances are baking, and keep our own claims alive
+        static const int BAKE_CACHE_CHECK_INTERVAL_MSECS = 5 * 1000;
+        _bakeCacheTimer = new QTimer(this);
+        connect(_bakeCacheTimer, &QTimer::timeout, this, &DomainBaker::checkCachedModels);
+        _bakeCacheTimer->start(BAKE_CACHE_CHECK_INTERVAL_MSECS);
+
+        // pick up the models that are already in the cache right away
+        checkCachedModels();
+        return;
+    }
+
     // in case we've baked and re-written all of our entities already, check if we're done
     checkIfRewritingComplete();
 }
@@ -149,31 +168,25 @@ void DomainBaker::addModelBaker(const QString& property, const QString& url, con
     QUrl bakeableModelURL = getBakeableModelURL(url);
     if (!bakeableModelURL.isEmpty() && (_shouldRebakeOriginals || !isModelBaked(bakeableModelURL))) {
         // setup a ModelBaker for this URL, as long as we don't already have one
-        bool haveBaker = _modelBakers.contains(bakeableModelURL);
-        if (!haveBaker) {
-            QSharedPointer<ModelBaker> baker = QSharedPointer<ModelBaker>(getModelBaker(bakeableModelURL, _contentOutputPath).release(), &Baker::deleteLater);
-            if (baker) {
-                // Hold on to the old url userinfo/query/fragment data so ModelBaker::getFullOutputMappingURL retains that data from the original model URL
-                // Note: The ModelBaker currently doesn't store this in the FST because the equal signs mess up FST parsing.
-                //       There is a small chance this could break a server workflow relying on the old behavior.
-                //       Url suffix is still propagated to the baked URL if the input URL is an FST.
-                //       Url suffix has always been stripped from the URL when loading the original model file to be baked.
-                baker->setOutputURLSuffix(url);
-
-                // make sure our handler is called when the baker is done
-                connect(baker.data(), &Baker::finished, this, &DomainBaker::handleFinishedModelBaker);
-
-                // insert it into our bakers hash so we hold a strong pointer to it
-                _modelBakers.insert(bakeableModelURL, baker);
+        bool haveBaker = _modelBakers.contains(bakeableModelURL) || _cachedModels.contains(bakeableModelURL);
+        if (!haveBaker && _bakeCache) {
+            auto key = BakeCache::getModelKey(bakeableModelURL);
+            if (_bakeCache->claim(key)) {
+                _claimedModels.insert(bakeableModelURL, key);
+            } else {
+                // this model is in the cache already, or another instance is baking it
+                _cachedModels.insert(bakeableModelURL, { key, url });
                 haveBaker = true;
-
-                // move the baker to the baker thread
-                // and kickoff the bake
-                baker->moveToThread(Oven::instance().getNextWorkerThread());
-                QMetaObject::invokeMethod(baker.data(), "bake", Qt::QueuedConnection);
-
+                ++_totalNumberOfSubBakes;
+            }
+        }
+        if (!haveBaker) {
+            haveBaker = startModelBaker(bakeableModelURL, url);
+            if (haveBaker) {
                 // keep track of the total number of baking entities
                 ++_totalNumberOfSubBakes;
+            } else if (_claimedModels.contains(bakeableModelURL)) {
+                _bakeCache->release(_claimedModels.take(bakeableModelURL));
             }
         }
 
@@ -185,6 +198,94 @@ void DomainBaker::addModelBaker(const QString& property, const QString& url, con
     }
 }
 
+bool DomainBaker::startModelBaker(const QUrl& bakeableModelURL, const QUrl& outputURLSuffix) {
+    QSharedPointer<ModelBaker> baker = QSharedPointer<ModelBaker>(getModelBaker(bakeableModelURL, _contentOutputPath).release(), &Baker::deleteLater);
+    if (!baker) {
+        return false;
+    }
+
+    // Hold on to the old url userinfo/query/fragment data so ModelBaker::getFullOutputMappingURL retains that data from the original model URL
+    // Note: The ModelBaker currently doesn't store this in the FST because the equal signs mess up FST parsing.
+    //       There is a small chance this could break a server workflow relying on the old behavior.
+    //       Url suffix is still propagated to the baked URL if the input URL is an FST.
+    //       Url suffix has always been stripped from the URL when loading the original model file to be baked.
+    baker->setOutputURLSuffix(outputURLSuffix);
+
+    // make sure our handler is called when the baker is done
+    connect(baker.data(), &Baker::finished, this, &DomainBaker::handleFinishedModelBaker);
+
+    // insert it into our bakers hash so we hold a strong pointer to it
+    _modelBakers.insert(bakeableModelURL, baker);
+
+    // move the baker to the baker thread
+    // and kickoff the bake
+    baker->moveToThread(Oven::instance().getNextWorkerThread());
+    QMetaObject::invokeMethod(baker.data(), "bake", Qt::QueuedConnection);
+    return true;
+}
+
+QString DomainBaker::getUniqueModelFolderName(const QUrl& bakeableModelURL) const {
+    // the same folder names getModelBaker would use
+    auto filename = bakeableModelURL.fileName();
+    auto baseName = filename.left(filename.lastIndexOf('.')).left(filename.lastIndexOf(".baked"));
+    auto folderName = baseName;
+    int i = 1;
+    while (QDir(_contentOutputPath + "/" + folderName).exists()) {
+        folderName = baseName + "-" + QString::number(i++);
+    }
+    return folderName;
+}
+
+void DomainBaker::checkCachedModels() {
+    if (!_bakeCache) {
+        return;
+    }
+
+    for (auto& key : _claimedModels) {
+        _bakeCache->refreshClaim(key);
+    }
+
+    for (const auto& bakeableModelURL : _cachedModels.keys()) {
+        const auto cachedModel = _cachedModels[bakeableModelURL];
+        if (_bakeCache->contains(cachedModel.key)) {
+            finishCachedModel(bakeableModelURL);
+        } else if (!_bakeCache->isClaimed(cachedModel.key) && _bakeCache->claim(cachedModel.key)) {
+            // the instance that was baking this model is gone without baking it, so bake it here
+            _cachedModels.remove(bakeableModelURL);
+            _claimedModels.insert(bakeableModelURL, cachedModel.key);
+            if (!startModelBaker(bakeableModelURL, cachedModel.outputURLSuffix)) {
+                _bakeCache->release(_claimedModels.take(bakeableModelURL));
+                _entitiesNeedingRewrite.remove(bakeableModelURL);
+                emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+            }
+        }
+    }
+
+    checkIfRewritingComplete();
+}
+
+void DomainBaker::finishCachedModel(const QUrl& bakeableModelURL) {
+    auto cachedModel = _cachedModels.take(bakeableModelURL);
+
+    auto folderName = getUniqueModelFolderName(bakeableModelURL);
+    auto mainFilePath = _bakeCache->fetch(cachedModel.key, _contentOutputPath + "/" + folderName);
+    if (!mainFilePath.isEmpty()) {
+        qDebug() << "Re-writing entity references to" << bakeableModelURL << "from the bake cache";
+
+        // as ModelBaker::getFullOutputMappingURL would
+        QUrl newURL = _destinationPath.resolved(folderName + "/" + mainFilePath);
+        newURL.setFragment(cachedModel.outputURLSuffix.fragment());
+        newURL.setQuery(cachedModel.outputURLSuffix.query());
+        newURL.setUserInfo(cachedModel.outputURLSuffix.userInfo());
+        rewriteModelReferences(bakeableModelURL, newURL);
+    } else {
+        _warningList << "Could not copy the cached bake of " + bakeableModelURL.toString();
+    }
+
+    _entitiesNeedingRewrite.remove(bakeableModelURL);
+    emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+}
+
 void DomainBaker::addTextureBaker(const QString& property, const QString& url, image::TextureUsage::Type type, const QJsonValueRef& jsonRef) {
     QString cleanURL = QUrl(url).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment).toDisplayString();
     auto idx = cleanURL.lastIndexOf('.');
@@ -443,45 +544,28 @@ void DomainBaker::handleFinishedModelBaker() {
 
             QUrl newURL = _destinationPath.resolved(relativeMappingFilePath);
 
-            // enumerate the QJsonRef values for the URL of this model from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getOriginalInputModelURL())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // set the new URL as the value in our temp QJsonObject
-                    // The fragment, query, and user info from the original model URL should now be present on the filename in the FST file
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old model URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
-
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
+            rewriteModelReferences(baker->getOriginalInputModelURL(), newURL);
+
+            if (_claimedModels.contains(baker->getOriginalInputModelURL())) {
+                // the model's folder, with its baked and original sub-folders, goes in the cache
+                QUrl mappingURL = baker->getFullOutputMappingURL();
+                mappingURL.setFragment(QString());
+                mappingURL.setQuery(QString());
+                mappingURL.setUserInfo(QString());
+                auto relativeMappingPath = QDir(_contentOutputPath).relativeFilePath(mappingURL.toString());
+                auto folderName = relativeMappingPath.section('/', 0, 0, QString::SectionSkipEmpty);
+                auto mainFilePath = relativeMappingPath.section('/', 1, -1, QString::SectionSkipEmpty);
+                _bakeCache->store(_claimedModels.take(baker->getOriginalInputModelURL()),
+                                  QDir(_contentOutputPath).absoluteFilePath(folderName), mainFilePath);
             }
         } else {
             // this model failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the model to our warnings
             _warningList << baker->getErrors();
+
+            if (_claimedModels.contains(baker->getOriginalInputModelURL())) {
+                _bakeCache->release(_claimedModels.take(baker->getOriginalInputModelURL()));
+            }
         }
 
         // remove the baked URL from the multi hash of entities needing a re-write
@@ -498,6 +582,44 @@ void DomainBaker::handleFinishedModelBaker() {
     }
 }
 
+void DomainBaker::rewriteModelReferences(const QUrl& bakeableModelURL, QUrl newURL) {
+    // enumerate the QJsonRef values for the URL of this model from our multi hash of
+    // entity objects needing a URL re-write
+    for (auto propertyEntityPair : _entitiesNeedingRewrite.values(bakeableModelURL)) {
+        QString property = propertyEntityPair.first;
+        // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
+        auto entity = propertyEntityPair.second.toObject();
+
+        if (!property.contains(".")) {
+            // grab the old URL
+            QUrl oldURL = entity[property].toString();
+
+            // set the new URL as the value in our temp QJsonObject
+            // The fragment, query, and user info from the original model URL should now be present on the filename in the FST file
+            entity[property] = newURL.toString();
+        } else {
+            // Group property
+            QStringList propertySplit = property.split(".");
+            assert(propertySplit.length() == 2);
+            // grab the old URL
+            auto oldObject = entity[propertySplit[0]].toObject();
+            QUrl oldURL = oldObject[propertySplit[1]].toString();
+
+            // copy the fragment and query, and user info from the old model URL
+            newURL.setQuery(oldURL.query());
+            newURL.setFragment(oldURL.fragment());
+            newURL.setUserInfo(oldURL.userInfo());
+
+            // set the new URL as the value in our temp QJsonObject
+            oldObject[propertySplit[1]] = newURL.toString();
+            entity[propertySplit[0]] = oldObject;
+        }
+
+        // replace our temp object with the value referenced by our QJsonValueRef
+        propertyEntityPair.second = entity;
+    }
+}
+
 void DomainBaker::handleFinishedTextureBaker() {
     auto baker = qobject_cast<TextureBaker*>(sender());
 
@@ -740,6 +862,10 @@ void DomainBaker::handleFinishedMaterialBaker() {
 
 void DomainBaker::checkIfRewritingComplete() {
     if (_entitiesNeedingRewrite.isEmpty()) {
+        if (_bakeCacheTimer) {
+            _bakeCacheTimer->stop();
+        }
+
         writeNewEntitiesFile();
 
         if (hasErrors()) {
@@ -12,12 +12,16 @@
 #ifndef hifi_DomainBaker_h
 #define hifi_DomainBaker_h
 
+#include <memory>
+
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonArray>
 #include <QtCore/QObject>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 #include <QtCore/QThread>
 
+#include "BakeCache.h"
 #include "ModelBaker.h"
 #include "TextureBaker.h"
 #include "JSBaker.h"
@@ -29,9 +33,11 @@ public:
     // This is a real bummer, but the FBX SDK is not thread safe - even with separate FBXManager objects.
     // This means that we need to put all of the FBX importing/exporting from the same process on the same thread.
     // That means you must pass a usable running QThread when constructing a domain baker.
+    // With a bake cache folder, the models already baked in it are copied from it rather than baked, and several
+    // instances sharing the folder split the models of the domain between them.
     DomainBaker(const QUrl& localEntitiesFileURL, const QString& domainName,
                 const QString& baseOutputPath, const QUrl& destinationPath,
-                bool shouldRebakeOriginals);
+                bool shouldRebakeOriginals, const QString& bakeCachePath = QString());
 
 signals:
     void allModelsFinished();
@@ -43,6 +49,7 @@ private slots:
     void handleFinishedTextureBaker();
     void handleFinishedScriptBaker();
     void handleFinishedMaterialBaker();
+    void checkCachedModels();
 
 private:
     void setupOutputFolder();
@@ -51,6 +58,11 @@ private:
     void checkIfRewritingComplete();
     void writeNewEntitiesFile();
 
+    bool startModelBaker(const QUrl& bakeableModelURL, const QUrl& outputURLSuffix);
+    void finishCachedModel(const QUrl& bakeableModelURL);
+    void rewriteModelReferences(const QUrl& bakeableModelURL, QUrl newURL);
+    QString getUniqueModelFolderName(const QUrl& bakeableModelURL) const;
+
     QUrl _localEntitiesFileURL;
     QString _domainName;
     QString _baseOutputPath;
@@ -76,6 +88,17 @@ private:
 
     bool _shouldRebakeOriginals { false };
 
+    // the models waiting on the bake cache, found in it or being baked by another instance
+    struct CachedModel {
+        QByteArray key;
+        QUrl outputURLSuffix;
+    };
+    std::unique_ptr<BakeCache> _bakeCache;
+    QHash<QUrl, CachedModel> _cachedModels;
+    // the models this instance claimed in the bake cache
+    QHash<QUrl, QByteArray> _claimedModels;
+    QTimer* _bakeCacheTimer { nullptr };
+
     void addModelBaker(const QString& property, const QString& url, const QJsonValueRef& jsonRef);
     void addTextureBaker(const QString& property, const QString& url, image::TextureUsage::Type type, const QJsonValueRef& jsonRef);
     void addScriptBaker(const QString& property, const QString& url, const QJsonValueRef& jsonRef);
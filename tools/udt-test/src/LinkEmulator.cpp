@@ -0,0 +1,233 @@
+//
+//  LinkEmulator.cpp
+//  tools/udt-test/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LinkEmulator.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+// how long a datagram can wait for the bandwidth of its link before it is dropped, like a full router buffer
+static const std::chrono::milliseconds MAX_QUEUE_DELAY { 250 };
+static const int LINK_SOCKET_BUFFER_SIZE = 1 << 20;
+
+LinkEmulator::LinkEmulator(const HifiSockAddr& target, quint16 firstPort, int numLinks, const LinkProfile& profile,
+                           QObject* parent) :
+    QObject(parent),
+    _target(target),
+    _profile(profile)
+{
+    _links.resize(numLinks);
+    for (int i = 0; i < numLinks; ++i) {
+        auto socket = new QUdpSocket(this);
+        if (!socket->bind(QHostAddress::AnyIPv4, firstPort + i)) {
+            qCritical() << "Link emulator could not bind port" << firstPort + i << "-" << socket->errorString();
+        }
+        socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, LINK_SOCKET_BUFFER_SIZE);
+        socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, LINK_SOCKET_BUFFER_SIZE);
+        connect(socket, &QUdpSocket::readyRead, this, &LinkEmulator::readPendingDatagrams);
+        _links[i].socket = socket;
+    }
+
+    _sendTimer.setSingleShot(true);
+    _sendTimer.setTimerType(Qt::PreciseTimer);
+    connect(&_sendTimer, &QTimer::timeout, this, &LinkEmulator::sendDueDatagrams);
+
+    qDebug() << "Link emulator is relaying ports" << firstPort << "to" << firstPort + numLinks - 1 << "to" << _target;
+}
+
+bool LinkEmulator::loadTrace(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCritical() << "Could not open the link trace" << path;
+        return false;
+    }
+
+    _trace.clear();
+    QTextStream stream(&file);
+    int lineNumber = 0;
+    while (!stream.atEnd()) {
+        QString line = stream.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        QStringList values = line.split(',');
+        bool isValid = values.size() >= 4;
+        std::vector<float> numbers;
+        for (const auto& value : values) {
+            bool isNumber = false;
+            numbers.push_back(value.trimmed().toFloat(&isNumber));
+            isValid &= isNumber;
+        }
+        if (!isValid || (!_trace.empty() && numbers[0] < std::chrono::duration<float>(_trace.back().time).count())) {
+            qCritical() << "The link trace" << path << "has an invalid sample on line" << lineNumber;
+            _trace.clear();
+            return false;
+        }
+
+        TraceSample sample;
+        sample.time = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(numbers[0]));
+        sample.profile = _profile;
+        sample.profile.rtt = numbers[1];
+        sample.profile.jitter = numbers[2];
+        sample.profile.loss = numbers[3];
+        if (numbers.size() > 4) {
+            sample.profile.bandwidth = numbers[4];
+        }
+        _trace.push_back(sample);
+    }
+
+    qDebug() << "Replaying" << _trace.size() << "samples of the link trace" << path;
+    _startTime = Clock::now();
+    _traceIndex = 0;
+    return !_trace.empty();
+}
+
+LinkEmulator::Stats LinkEmulator::sampleStats() {
+    Stats stats = _stats;
+    stats.queued = (int)_inFlight.size();
+    _stats = Stats();
+    return stats;
+}
+
+const LinkProfile& LinkEmulator::getProfile(Clock::time_point now) {
+    if (_trace.empty()) {
+        return _profile;
+    }
+
+    // the trace loops after its last sample has held for as long as the one before it
+    auto elapsed = now - _startTime;
+    if (_trace.size() > 1) {
+        auto lastInterval = _trace.back().time - _trace[_trace.size() - 2].time;
+        auto loopDuration = _trace.back().time + lastInterval;
+        if (loopDuration.count() > 0) {
+            elapsed %= loopDuration;
+        }
+    }
+
+    if (elapsed < _trace[_traceIndex].time) {
+        _traceIndex = 0;
+    }
+    while (_traceIndex + 1 < _trace.size() && _trace[_traceIndex + 1].time <= elapsed) {
+        ++_traceIndex;
+    }
+    return _trace[_traceIndex].profile;
+}
+
+bool LinkEmulator::shouldDrop(Link& link, Direction direction, const LinkProfile& profile) {
+    // a Gilbert model, losing the datagrams in bursts of lossBurst on average that add up to the loss percentage
+    float loss = profile.loss / 100.0f;
+    bool& isLosing = link.isLosing[direction];
+    if (loss <= 0.0f) {
+        isLosing = false;
+    } else if (loss >= 1.0f) {
+        isLosing = true;
+    } else {
+        float burst = std::max(profile.lossBurst, 1.0f);
+        if (isLosing) {
+            isLosing = _uniform(_generator) >= 1.0f / burst;
+        } else {
+            isLosing = _uniform(_generator) < loss / ((1.0f - loss) * burst);
+        }
+    }
+    return isLosing;
+}
+
+void LinkEmulator::readPendingDatagrams() {
+    auto socket = qobject_cast<QUdpSocket*>(sender());
+    int linkIndex = 0;
+    while (linkIndex < (int)_links.size() && _links[linkIndex].socket != socket) {
+        ++linkIndex;
+    }
+    if (linkIndex == (int)_links.size()) {
+        return;
+    }
+    Link& link = _links[linkIndex];
+
+    auto now = Clock::now();
+    const LinkProfile& profile = getProfile(now);
+
+    while (socket->hasPendingDatagrams()) {
+        QByteArray data;
+        data.resize((int)socket->pendingDatagramSize());
+        QHostAddress address;
+        quint16 port;
+        if (socket->readDatagram(data.data(), data.size(), &address, &port) < 0) {
+            continue;
+        }
+
+        HifiSockAddr senderSockAddr(address, port);
+        Direction direction = senderSockAddr == _target ? ToClient : ToTarget;
+        if (direction == ToTarget) {
+            link.client = senderSockAddr;
+        } else if (link.client.isNull()) {
+            continue;
+        }
+
+        if (shouldDrop(link, direction, profile)) {
+            ++_stats.lost;
+            continue;
+        }
+
+        auto departure = now;
+        if (profile.bandwidth > 0.0f) {
+            departure = std::max(now, link.nextDeparture[direction]);
+            if (departure - now > MAX_QUEUE_DELAY) {
+                ++_stats.queueDrops;
+                continue;
+            }
+            // Mb/s are bits per microsecond
+            std::chrono::duration<float, std::micro> transmission { data.size() * 8.0f / profile.bandwidth };
+            departure += std::chrono::duration_cast<Clock::duration>(transmission);
+            link.nextDeparture[direction] = departure;
+        }
+
+        // jitter can reorder the datagrams, as it does on a real link
+        float delay = std::max(profile.rtt / 2.0f + profile.jitter * _normal(_generator), 0.0f);
+        auto due = departure + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(delay));
+
+        _inFlight.emplace(due, Datagram { linkIndex, direction, std::move(data) });
+    }
+
+    scheduleNextSend();
+}
+
+void LinkEmulator::sendDueDatagrams() {
+    auto now = Clock::now();
+    while (!_inFlight.empty() && _inFlight.begin()->first <= now) {
+        const Datagram& datagram = _inFlight.begin()->second;
+        const Link& link = _links[datagram.link];
+        const HifiSockAddr& destination = datagram.direction == ToTarget ? _target : link.client;
+        link.socket->writeDatagram(datagram.data, destination.getAddress(), destination.getPort());
+        ++_stats.forwarded;
+        _inFlight.erase(_inFlight.begin());
+    }
+
+    scheduleNextSend();
+}
+
+void LinkEmulator::scheduleNextSend() {
+    if (_inFlight.empty()) {
+        _sendTimer.stop();
+        return;
+    }
+
+    // Qt timers have millisecond resolution, so the datagrams are sent up to a millisecond late
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(_inFlight.begin()->first - Clock::now());
+    int interval = std::max((int)wait.count(), 0);
+    if (!_sendTimer.isActive() || _sendTimer.remainingTime() > interval) {
+        _sendTimer.start(interval);
+    }
+}
@@ -0,0 +1,110 @@
+//
+//  LinkEmulator.h
+//  tools/udt-test/src
+//
+//  Created by Vircadia contributors on 2021-03-27.
+//  Copyright 2021 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_LinkEmulator_h
+#define hifi_LinkEmulator_h
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QUdpSocket>
+
+#include <HifiSockAddr.h>
+
+struct LinkProfile {
+    float rtt { 0.0f }; // ms, split evenly between both directions
+    float jitter { 0.0f }; // ms, standard deviation of the one-way delay
+    float loss { 0.0f }; // percent of the datagrams dropped in each direction
+    float lossBurst { 1.0f }; // average number of datagrams dropped in a row
+    float bandwidth { 0.0f }; // Mb/s in each direction, 0 is unlimited
+};
+
+// Relays the datagrams between the clients and a target through a number of links, each listening on its own port and
+// connected to the target from that port, so that one udt::Socket sending to all the ports has that many connections.
+//
+// Every datagram is delayed, dropped or queued behind the others according to the link profile, which can be replayed
+// from a link trace that gives it over time.
+class LinkEmulator : public QObject {
+    Q_OBJECT
+public:
+    struct Stats {
+        uint64_t forwarded { 0 };
+        uint64_t lost { 0 }; // dropped by the loss profile
+        uint64_t queueDrops { 0 }; // dropped because the bandwidth profile kept them queued too long
+        int queued { 0 }; // in flight at the time of the sample
+    };
+
+    LinkEmulator(const HifiSockAddr& target, quint16 firstPort, int numLinks, const LinkProfile& profile,
+                 QObject* parent = nullptr);
+
+    // a link trace has a "seconds,rtt,jitter,loss[,bandwidth]" line for each change of the profile, which is replayed in
+    // a loop from the time the emulator starts - the loss burst stays the one of the profile
+    bool loadTrace(const QString& path);
+
+    // counts since the previous sample
+    Stats sampleStats();
+
+private slots:
+    void readPendingDatagrams();
+    void sendDueDatagrams();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum Direction { ToTarget = 0, ToClient, NumDirections };
+
+    struct Link {
+        QUdpSocket* socket { nullptr };
+        HifiSockAddr client; // the first one heard from
+        Clock::time_point nextDeparture[NumDirections];
+        bool isLosing[NumDirections] { false, false };
+    };
+
+    struct Datagram {
+        int link;
+        Direction direction;
+        QByteArray data;
+    };
+
+    struct TraceSample {
+        Clock::duration time;
+        LinkProfile profile;
+    };
+
+    const LinkProfile& getProfile(Clock::time_point now);
+    bool shouldDrop(Link& link, Direction direction, const LinkProfile& profile);
+    void scheduleNextSend();
+
+    HifiSockAddr _target;
+    std::vector<Link> _links;
+    std::multimap<Clock::time_point, Datagram> _inFlight;
+
+    LinkProfile _profile;
+    std::vector<TraceSample> _trace;
+    Clock::time_point _startTime { Clock::now() };
+    size_t _traceIndex { 0 };
+
+    QTimer _sendTimer;
+
+    std::mt19937 _generator { std::random_device()() };
+    std::uniform_real_distribution<float> _uniform { 0.0f, 1.0f };
+    std::normal_distribution<float> _normal { 0.0f, 1.0f };
+
+    Stats _stats;
+};
+
+#endif // hifi_LinkEmulator_h
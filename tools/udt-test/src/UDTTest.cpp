@@ -11,13 +11,24 @@
 
 #include "UDTTest.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <QtCore/QDebug>
 
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
 #include <udt/Constants.h>
 #include <udt/Packet.h>
+#include <udt/PacketBufferPool.h>
 #include <udt/PacketList.h>
 
 #include <LogHandler.h>
+#include <SharedUtil.h>
 
 const QCommandLineOption PORT_OPTION { "p", "listening port for socket (defaults to random)", "port", 0 };
 const QCommandLineOption TARGET_OPTION {
@@ -55,6 +66,55 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption CONNECTIONS {
+    "connections", "number of connections, to the target port and the ones after it (default is 1)", "count"
+};
+const QCommandLineOption QUEUE_DEPTH {
+    "queue-depth", "number of packets kept queued for each reliable connection (default is 500)", "packets"
+};
+const QCommandLineOption UNRELIABLE_RATE {
+    "unreliable-rate", "unreliable packets per second to each target (default is a single burst)", "packets"
+};
+const QCommandLineOption DURATION {
+    "duration", "seconds to run before printing a summary and quitting (default is infinite)", "seconds"
+};
+const QCommandLineOption CONGESTION_CONTROL {
+    "congestion-control", "congestion control of the reliable connections, vegas or bbr (default is vegas)", "name"
+};
+const QCommandLineOption BATCHED_RECEIVE {
+    "batched-receive", "drain the socket with recvmmsg where it is supported"
+};
+const QCommandLineOption BATCHED_SEND {
+    "batched-send", "batch the unreliable packets with sendmmsg where it is supported"
+};
+const QCommandLineOption RECEIVE_SHARDS {
+    "receive-shards", "number of SO_REUSEPORT sockets read on their own threads (default is 1)", "count"
+};
+const QCommandLineOption NO_PACKET_POOL {
+    "no-packet-pool", "allocate the packet buffers on the heap instead of from the packet buffer pool"
+};
+const QCommandLineOption LINK_EMULATOR {
+    "link-emulator", "relay the listening port and the ones after it to the target through an emulated link, "
+    "instead of testing"
+};
+const QCommandLineOption LINK_RTT {
+    "link-rtt", "round trip time the emulated link adds (default is 0)", "milliseconds"
+};
+const QCommandLineOption LINK_JITTER {
+    "link-jitter", "standard deviation of the one-way delays of the emulated link (default is 0)", "milliseconds"
+};
+const QCommandLineOption LINK_LOSS {
+    "link-loss", "percent of the datagrams the emulated link loses in each direction (default is 0)", "percent"
+};
+const QCommandLineOption LINK_LOSS_BURST {
+    "link-loss-burst", "average number of datagrams the emulated link loses in a row (default is 1)", "datagrams"
+};
+const QCommandLineOption LINK_BANDWIDTH {
+    "link-bandwidth", "bandwidth of the emulated link in each direction (default is unlimited)", "Mb/s"
+};
+const QCommandLineOption LINK_TRACE {
+    "link-trace", "replay the emulated link from a trace of \"seconds,rtt,jitter,loss[,bandwidth]\" lines", "file"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -66,16 +126,77 @@ const QStringList SERVER_STATS_TABLE_HEADERS {
     "Sent ACK", "Duplicates (P)"
 };
 
+const QStringList LINK_STATS_TABLE_HEADERS {
+    "Forwarded (P)", "Lost (P)", "Queue Drops (P)", "In Flight (P)"
+};
+
+static const int UNRELIABLE_SEND_INTERVAL_MS = 10;
+
+static const double BYTES_PER_MEGABYTE = 1000000.0;
+static const double MEGABITS_PER_BYTE = 8.0 / 1000000.0;
+static const double USECS_PER_MSEC = 1000.0;
+static const double MSECS_PER_SECOND = 1000.0;
+
+// user and system time of the whole process, in seconds
+static double getProcessCPUTime() {
+#ifdef Q_OS_WIN
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0.0;
+    }
+    // in units of 100 nanoseconds
+    auto toSeconds = [](const FILETIME& time) {
+        return (double)(((quint64)time.dwHighDateTime << 32) | time.dwLowDateTime) / 1.0e7;
+    };
+    return toSeconds(kernelTime) + toSeconds(userTime);
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    return (double)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+        (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1.0e6;
+#endif
+}
+
+static quint32 getPercentile(const std::vector<quint32>& sortedValues, double percentile) {
+    size_t index = (size_t)(percentile / 100.0 * sortedValues.size());
+    return sortedValues[std::min(index, sortedValues.size() - 1)];
+}
+
+// the totals are added up and the trailing averages are averaged by the caller
+static void addStats(udt::ConnectionStats::Stats& total, const udt::ConnectionStats::Stats& sample) {
+    for (size_t i = 0; i < total.events.size(); ++i) {
+        total.events[i] += sample.events[i];
+    }
+    total.sentPackets += sample.sentPackets + sample.sentUnreliablePackets;
+    total.receivedPackets += sample.receivedPackets + sample.receivedUnreliablePackets;
+    total.retransmittedPackets += sample.retransmittedPackets;
+    total.duplicatePackets += sample.duplicatePackets;
+    total.sentUtilBytes += sample.sentUtilBytes + sample.sentUnreliableUtilBytes;
+    total.receivedBytes += sample.receivedBytes + sample.receivedUnreliableBytes;
+
+    total.sendRate += sample.sendRate;
+    total.receiveRate += sample.receiveRate;
+    total.estimatedBandwith += sample.estimatedBandwith;
+    total.rtt += sample.rtt;
+    total.congestionWindowSize += sample.congestionWindowSize;
+    total.packetSendPeriod += sample.packetSendPeriod;
+}
+
 UDTTest::UDTTest(int& argc, char** argv) :
     QCoreApplication(argc, argv)
 {
     parseArguments();
+    _startCPUTime = getProcessCPUTime();
     
     // randomize the seed for packet size randomization
     srand(time(NULL));
 
-    _socket.bind(QHostAddress::AnyIPv4, _argumentParser.value(PORT_OPTION).toUInt());
-    qDebug() << "Test socket is listening on" << _socket.localPort();
+    int numConnections = 1;
+    if (_argumentParser.isSet(CONNECTIONS)) {
+        numConnections = std::max(_argumentParser.value(CONNECTIONS).toInt(), 1);
+    }
     
     if (_argumentParser.isSet(TARGET_OPTION)) {
         // parse the IP and port combination for this target
@@ -90,10 +211,30 @@ UDTTest::UDTTest(int& argc, char** argv) :
             
             QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
         } else {
-            _target = HifiSockAddr(address, port);
-            qDebug() << "Packets will be sent to" << _target;
+            for (int i = 0; i < numConnections; ++i) {
+                _targets.emplace_back(address, port + i);
+            }
+            qDebug() << "Packets will be sent to" << _targets.front() << "over" << numConnections << "connection(s)";
         }
     }
+
+    if (_argumentParser.isSet(DURATION)) {
+        QTimer::singleShot(_argumentParser.value(DURATION).toInt() * (int)MSECS_PER_SECOND, this, &QCoreApplication::quit);
+    }
+    connect(this, &QCoreApplication::aboutToQuit, this, &UDTTest::printSummary);
+
+    if (_argumentParser.isSet(STATS_INTERVAL)) {
+        _statsInterval = _argumentParser.value(STATS_INTERVAL).toInt();
+    }
+
+    if (_argumentParser.isSet(LINK_EMULATOR)) {
+        setupLinkEmulator();
+
+        QTimer* statsTimer = new QTimer(this);
+        connect(statsTimer, &QTimer::timeout, this, &UDTTest::sampleStats);
+        statsTimer->start(_statsInterval);
+        return;
+    }
     
     if (_argumentParser.isSet(PACKET_SIZE)) {
         // parse the desired packet size
@@ -141,11 +282,28 @@ UDTTest::UDTTest(int& argc, char** argv) :
 
     if (_argumentParser.isSet(ORDERED_PACKETS)) {
         _sendOrdered = true;
+
+        if (_targets.size() > 1) {
+            // the receiver verifies the messages in the order they were generated, which only one connection keeps
+            qCritical() << "Cannot send ordered packets over more than one connection.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+    }
+
+    if (_argumentParser.isSet(QUEUE_DEPTH)) {
+        _queueDepth = std::max(_argumentParser.value(QUEUE_DEPTH).toInt(), 1);
+    }
+
+    if (_argumentParser.isSet(UNRELIABLE_RATE)) {
+        if (_sendReliable) {
+            qWarning() << "unreliable-rate has no effect if not sending unreliable - it will be ignored";
+        } else {
+            _unreliableRate = _argumentParser.value(UNRELIABLE_RATE).toInt();
+        }
     }
     
     if (_argumentParser.isSet(MESSAGE_SIZE)) {
         if (_argumentParser.isSet(ORDERED_PACKETS)) {
-            static const double BYTES_PER_MEGABYTE = 1000000;
             _messageSize = (int) _argumentParser.value(MESSAGE_SIZE).toInt() * BYTES_PER_MEGABYTE;
             
             qDebug() << "Message size for ordered packet sending is" << QString("%1MB").arg(_messageSize / BYTES_PER_MEGABYTE);
@@ -167,13 +325,24 @@ UDTTest::UDTTest(int& argc, char** argv) :
     // seed the generator with a value that the receiver will also use when verifying the ordered message
     _generator.seed(messageSeed);
     
-    if (!_target.isNull()) {
+    setupSocket();
+
+    if (!_targets.empty()) {
         sendInitialPackets();
+
+        if (!_sendReliable && _unreliableRate > 0) {
+            QTimer* sendTimer = new QTimer(this);
+            sendTimer->setTimerType(Qt::PreciseTimer);
+            connect(sendTimer, &QTimer::timeout, this, &UDTTest::sendUnreliablePackets);
+            sendTimer->start(UNRELIABLE_SEND_INTERVAL_MS);
+        }
     } else {
         // this is a receiver - in case there are ordered packets (messages) being sent to us make sure that we handle them
         // so that they can be verified
         _socket.setMessageHandler(
             [this](std::unique_ptr<udt::Packet> packet) {
+                recordReceivedPacket(*packet);
+
                 auto messageNumber = packet->getMessageNumber();
                 auto it = _pendingMessages.find(messageNumber);
 
@@ -196,6 +365,20 @@ UDTTest::UDTTest(int& argc, char** argv) :
                 }
 
         });
+
+        // the packets that are not part of a message carry the time they were sent for the latency
+        _socket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+            recordReceivedPacket(*packet);
+
+            quint64 sentTime;
+            if (packet->getPayloadSize() >= (qint64)sizeof(sentTime)) {
+                memcpy(&sentTime, packet->getPayload(), sizeof(sentTime));
+                quint64 now = usecTimestampNow();
+                if (now >= sentTime) {
+                    _latencies.push_back((quint32)std::min(now - sentTime, (quint64)UINT32_MAX));
+                }
+            }
+        });
     }
     _socket.setMessageFailureHandler(
         [this](HifiSockAddr from, udt::Packet::MessageNumber messageNumber) {
@@ -204,11 +387,6 @@ UDTTest::UDTTest(int& argc, char** argv) :
     );
     
     // the sender reports stats every 100 milliseconds, unless passed a custom value
-    
-    if (_argumentParser.isSet(STATS_INTERVAL)) {
-        _statsInterval = _argumentParser.value(STATS_INTERVAL).toInt();
-    }
-    
     QTimer* statsTimer = new QTimer(this);
     connect(statsTimer, &QTimer::timeout, this, &UDTTest::sampleStats);
     statsTimer->start(_statsInterval);
@@ -224,7 +402,9 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, CONNECTIONS, QUEUE_DEPTH, UNRELIABLE_RATE, DURATION,
+        CONGESTION_CONTROL, BATCHED_RECEIVE, BATCHED_SEND, RECEIVE_SHARDS, NO_PACKET_POOL,
+        LINK_EMULATOR, LINK_RTT, LINK_JITTER, LINK_LOSS, LINK_LOSS_BURST, LINK_BANDWIDTH, LINK_TRACE
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -239,22 +419,109 @@ void UDTTest::parseArguments() {
     }
 }
 
+void UDTTest::setupSocket() {
+    // the shards have to be set before the socket is bound
+    if (_argumentParser.isSet(RECEIVE_SHARDS)) {
+        _socket.setNumReceiveShards(_argumentParser.value(RECEIVE_SHARDS).toInt());
+    }
+
+    _socket.bind(QHostAddress::AnyIPv4, _argumentParser.value(PORT_OPTION).toUInt());
+    qDebug() << "Test socket is listening on" << _socket.localPort();
+
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        QString congestionControl = _argumentParser.value(CONGESTION_CONTROL).toLower();
+        if (congestionControl == "bbr") {
+            _socket.setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+                new udt::CongestionControlFactory<udt::BBRCC>()));
+        } else if (congestionControl != "vegas") {
+            qCritical() << "Unknown congestion control" << congestionControl << "- it has to be vegas or bbr.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+        qDebug() << "Reliable connections use the" << congestionControl << "congestion control";
+    }
+
+    if (_argumentParser.isSet(BATCHED_RECEIVE)) {
+        _socket.setUseBatchedReceive(true);
+    }
+
+    if (_argumentParser.isSet(BATCHED_SEND)) {
+        if (_sendReliable || _targets.empty()) {
+            // the reliable packets are sent from the pacing threads, which never batch
+            qWarning() << "batched-send has no effect if not sending unreliable - it will be ignored";
+        } else {
+            _socket.setUseBatchedSend(true);
+            udt::Socket::setBatchSendsOnCurrentThread(true);
+        }
+    }
+
+    if (_argumentParser.isSet(NO_PACKET_POOL)) {
+        udt::PacketBufferPool::setEnabled(false);
+        qDebug() << "Packet buffers are allocated on the heap";
+    }
+}
+
+void UDTTest::setupLinkEmulator() {
+    if (_targets.empty() || !_argumentParser.isSet(PORT_OPTION)) {
+        qCritical() << "The link emulator needs a listening port and a target to relay to.";
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        return;
+    }
+
+    LinkProfile profile;
+    if (_argumentParser.isSet(LINK_RTT)) {
+        profile.rtt = _argumentParser.value(LINK_RTT).toFloat();
+    }
+    if (_argumentParser.isSet(LINK_JITTER)) {
+        profile.jitter = _argumentParser.value(LINK_JITTER).toFloat();
+    }
+    if (_argumentParser.isSet(LINK_LOSS)) {
+        profile.loss = _argumentParser.value(LINK_LOSS).toFloat();
+    }
+    if (_argumentParser.isSet(LINK_LOSS_BURST)) {
+        profile.lossBurst = _argumentParser.value(LINK_LOSS_BURST).toFloat();
+    }
+    if (_argumentParser.isSet(LINK_BANDWIDTH)) {
+        profile.bandwidth = _argumentParser.value(LINK_BANDWIDTH).toFloat();
+    }
+
+    _linkEmulator = new LinkEmulator(_targets.front(), (quint16)_argumentParser.value(PORT_OPTION).toUInt(),
+                                     (int)_targets.size(), profile, this);
+
+    if (_argumentParser.isSet(LINK_TRACE) && !_linkEmulator->loadTrace(_argumentParser.value(LINK_TRACE))) {
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+    }
+}
+
 void UDTTest::sendInitialPackets() {
-    static const int NUM_INITIAL_PACKETS = 500;
-    
-    int numPackets = std::max(NUM_INITIAL_PACKETS, _maxSendPackets);
+    int numPackets = std::max(_queueDepth, _maxSendPackets);
     
-    for (int i = 0; i < numPackets; ++i) {
-        sendPacket();
+    for (const auto& target : _targets) {
+        for (int i = 0; i < numPackets; ++i) {
+            sendPacket(target);
+        }
+
+        if (_sendReliable && numPackets == _queueDepth) {
+            // we've put the initial packets in the queue, everytime we hear one has gone out we should add a new one
+            _socket.connectToSendSignal(target, this, [this, target] { sendPacket(target); });
+        }
     }
-    
-    if (numPackets == NUM_INITIAL_PACKETS) {
-        // we've put 500 initial packets in the queue, everytime we hear one has gone out we should add a new one
-        _socket.connectToSendSignal(_target, this, SLOT(refillPacket()));
+
+    _socket.flushSendBatch();
+}
+
+void UDTTest::sendUnreliablePackets() {
+    int numPackets = std::max(_unreliableRate * UNRELIABLE_SEND_INTERVAL_MS / (int)MSECS_PER_SECOND, 1);
+
+    for (const auto& target : _targets) {
+        for (int i = 0; i < numPackets; ++i) {
+            sendPacket(target);
+        }
     }
+
+    _socket.flushSendBatch();
 }
 
-void UDTTest::sendPacket() {
+void UDTTest::sendPacket(const HifiSockAddr& target) {
     
     if (_maxSendPackets != -1 && _totalQueuedPackets > _maxSendPackets) {
         // don't send more packets, we've hit max
@@ -310,20 +577,26 @@ void UDTTest::sendPacket() {
             _totalQueuedBytes += (int)packetList->getDataSize();
             _totalQueuedPackets += (int)packetList->getNumPackets();
             
-            _socket.writePacketList(std::move(packetList), _target);
+            _socket.writePacketList(std::move(packetList), target);
         }
         
     } else {
         auto newPacket = udt::Packet::create(packetPayloadSize, _sendReliable);
         newPacket->setPayloadSize(packetPayloadSize);
+
+        // the receiver measures the latency from the time the packet is queued
+        quint64 now = usecTimestampNow();
+        if (packetPayloadSize >= (int)sizeof(now)) {
+            memcpy(newPacket->getPayload(), &now, sizeof(now));
+        }
         
         _totalQueuedBytes += newPacket->getDataSize();
         
         // queue or send this packet by calling write packet on the socket for our target
         if (_sendReliable) {
-            _socket.writePacket(std::move(newPacket), _target);
+            _socket.writePacket(std::move(newPacket), target);
         } else {
-            _socket.writePacket(*newPacket, _target);
+            _socket.writePacket(*newPacket, target);
         }
         
         ++_totalQueuedPackets;
@@ -357,23 +630,82 @@ void UDTTest::handleMessage(std::unique_ptr<Message> message) {
     }
 }
 
-void UDTTest::sampleStats() {
+void UDTTest::recordReceivedPacket(const udt::Packet& packet) {
+    if (_totals.goodputBytes == 0) {
+        // the rates are measured from the first packet, not from the time the receiver started waiting
+        _startTime = std::chrono::steady_clock::now();
+        _startCPUTime = getProcessCPUTime();
+    }
+    _totals.goodputBytes += packet.getPayloadSize();
+}
+
+void UDTTest::sampleConnectionStats(bool shouldPrint) {
     static bool first = true;
-    static const double USECS_PER_MSEC = 1000.0;
-    static const double MEGABITS_PER_BYTE = 8.0 / 1000000.0;
-    static const double MS_PER_SECOND = 1000.0;
     static const double PPS_TO_MBPS = udt::MAX_PACKET_SIZE * MEGABITS_PER_BYTE;
 
+    if (_linkEmulator) {
+        auto stats = _linkEmulator->sampleStats();
+        _linkTotals.forwarded += stats.forwarded;
+        _linkTotals.lost += stats.lost;
+        _linkTotals.queueDrops += stats.queueDrops;
+
+        if (!shouldPrint) {
+            return;
+        }
+
+        if (first) {
+            // output the headers for stats for our table
+            qDebug() << qPrintable(LINK_STATS_TABLE_HEADERS.join(" | "));
+            first = false;
+        }
+
+        int headerIndex = -1;
+
+        QStringList values {
+            QString::number(stats.forwarded).rightJustified(LINK_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.lost).rightJustified(LINK_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.queueDrops).rightJustified(LINK_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.queued).rightJustified(LINK_STATS_TABLE_HEADERS[++headerIndex].size())
+        };
+
+        qDebug() << qPrintable(values.join(" | "));
+        return;
+    }
+
+    // the sender samples its targets, the receiver whoever is connected to it
+    std::vector<HifiSockAddr> sockAddrs = _targets.empty() ? _socket.getConnectionSockAddrs() : _targets;
+    if (sockAddrs.empty()) {
+        return;
+    }
+
+    udt::ConnectionStats::Stats stats;
+    for (const auto& sockAddr : sockAddrs) {
+        addStats(stats, _socket.sampleStatsForConnection(sockAddr));
+    }
+    int numConnections = (int)sockAddrs.size();
+    stats.rtt /= numConnections;
+    stats.packetSendPeriod /= numConnections;
+
+    _totals.sentPackets += stats.sentPackets;
+    _totals.retransmittedPackets += stats.retransmittedPackets;
+    _totals.sentUtilBytes += stats.sentUtilBytes;
+    _totals.receivedPackets += stats.receivedPackets;
+    _totals.duplicatePackets += stats.duplicatePackets;
+
+    if (!shouldPrint) {
+        return;
+    }
+
+    if (!_targets.empty()) {
+        // anything an unreliable burst left behind goes out with the stats
+        _socket.flushSendBatch();
 
-    if (!_target.isNull()) {
         if (first) {
             // output the headers for stats for our table
             qDebug() << qPrintable(CLIENT_STATS_TABLE_HEADERS.join(" | "));
             first = false;
         }
         
-        udt::ConnectionStats::Stats stats = _socket.sampleStatsForConnection(_target);
-        
         int headerIndex = -1;
         
         // setup a list of left justified values
@@ -398,27 +730,87 @@ void UDTTest::sampleStats() {
             first = false;
         }
         
-        auto sockets = _socket.getConnectionSockAddrs();
-        if (sockets.size() > 0) {
-            udt::ConnectionStats::Stats stats = _socket.sampleStatsForConnection(sockets.front());
-            
-            int headerIndex = -1;
-            
-            double megabitsPerSecond = (stats.receivedBytes * MEGABITS_PER_BYTE * MS_PER_SECOND) / _statsInterval;
-            
-            // setup a list of left justified values
-            QStringList values {
-                QString::number(megabitsPerSecond, 'f', 2).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.receiveRate * PPS_TO_MBPS).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.estimatedBandwith * PPS_TO_MBPS).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.rtt / USECS_PER_MSEC, 'f', 2).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.congestionWindowSize).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.events[udt::ConnectionStats::Stats::SentACK]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.events[udt::ConnectionStats::Stats::Duplicate]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
-            };
-            
-            // output this line of values
-            qDebug() << qPrintable(values.join(" | "));
+        int headerIndex = -1;
+        
+        double megabitsPerSecond = (stats.receivedBytes * MEGABITS_PER_BYTE * MSECS_PER_SECOND) / _statsInterval;
+        
+        // setup a list of left justified values
+        QStringList values {
+            QString::number(megabitsPerSecond, 'f', 2).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.receiveRate * PPS_TO_MBPS).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.estimatedBandwith * PPS_TO_MBPS).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.rtt / USECS_PER_MSEC, 'f', 2).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.congestionWindowSize).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.events[udt::ConnectionStats::Stats::SentACK]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(stats.duplicatePackets).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
+        };
+        
+        // output this line of values
+        qDebug() << qPrintable(values.join(" | "));
+    }
+}
+
+void UDTTest::printSummary() {
+    // pick up what happened since the last sample
+    sampleConnectionStats(false);
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTime).count();
+    double cpuTime = getProcessCPUTime() - _startCPUTime;
+
+    qDebug().noquote() << "Summary over" << QString::number(elapsed, 'f', 2) << "seconds:";
+
+    if (_linkEmulator) {
+        qDebug().noquote() << "  Forwarded" << _linkTotals.forwarded << "datagrams, lost" << _linkTotals.lost
+            << "and dropped" << _linkTotals.queueDrops << "from full queues";
+        return;
+    }
+
+    auto toText = [](double value) { return QString::number(value, 'f', 2); };
+
+    if (!_targets.empty()) {
+        double sentMegabytes = _totals.sentUtilBytes / BYTES_PER_MEGABYTE;
+        double retransmissionRatio = _totals.sentPackets > 0 ?
+            (double)_totals.retransmittedPackets / _totals.sentPackets : 0.0;
+
+        qDebug().noquote() << "  Sent" << toText(sentMegabytes) << "MB over" << _targets.size() << "connection(s) at"
+            << toText(elapsed > 0.0 ? _totals.sentUtilBytes * MEGABITS_PER_BYTE / elapsed : 0.0) << "Mb/s";
+        qDebug().noquote() << "  Re-sent" << _totals.retransmittedPackets << "of" << _totals.sentPackets << "packets,"
+            << toText(100.0 * retransmissionRatio) << "%";
+        if (sentMegabytes > 0.0) {
+            qDebug().noquote() << "  CPU" << toText(cpuTime * MSECS_PER_SECOND / sentMegabytes) << "ms per MB sent";
+        }
+    } else {
+        double goodputMegabytes = _totals.goodputBytes / BYTES_PER_MEGABYTE;
+
+        qDebug().noquote() << "  Received" << toText(goodputMegabytes) << "MB of goodput at"
+            << toText(elapsed > 0.0 ? _totals.goodputBytes * MEGABITS_PER_BYTE / elapsed : 0.0) << "Mb/s with"
+            << _totals.duplicatePackets << "duplicate packets";
+        if (goodputMegabytes > 0.0) {
+            qDebug().noquote() << "  CPU" << toText(cpuTime * MSECS_PER_SECOND / goodputMegabytes) << "ms per MB received";
         }
+
+        if (!_latencies.empty()) {
+            // the sender and the receiver have to share a clock, on the same host or synchronized
+            std::sort(_latencies.begin(), _latencies.end());
+            qDebug().noquote() << "  Latency (ms) p50" << toText(getPercentile(_latencies, 50.0) / USECS_PER_MSEC)
+                << "p90" << toText(getPercentile(_latencies, 90.0) / USECS_PER_MSEC)
+                << "p99" << toText(getPercentile(_latencies, 99.0) / USECS_PER_MSEC)
+                << "p99.9" << toText(getPercentile(_latencies, 99.9) / USECS_PER_MSEC)
+                << "max" << toText(_latencies.back() / USECS_PER_MSEC)
+                << "of" << _latencies.size() << "packets";
+        }
+    }
+
+    auto socketStats = _socket.sampleSocketStats();
+    if (socketStats.receiveBatches > 0) {
+        qDebug().noquote() << "  Received" << socketStats.receiveBatchedPackets << "packets in" << socketStats.receiveBatches
+            << "batches, at most" << socketStats.maxReceiveBatchSize;
     }
+    if (socketStats.sendBatches > 0) {
+        qDebug().noquote() << "  Sent" << socketStats.sendBatchedPackets << "packets in" << socketStats.sendBatches
+            << "batches, at most" << socketStats.maxSendBatchSize;
+    }
+
+    auto poolStats = udt::PacketBufferPool::getStats();
+    qDebug().noquote() << "  Packet buffers: " << poolStats.hits << "from the pool," << poolStats.misses << "allocated";
 }
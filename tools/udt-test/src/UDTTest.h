@@ -15,7 +15,9 @@
 #define hifi_UDTTest_h
 
 
+#include <chrono>
 #include <random>
+#include <vector>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QCommandLineParser>
@@ -25,6 +27,8 @@
 
 #include <ReceivedMessage.h>
 
+#include "LinkEmulator.h"
+
 struct Message {
     udt::MessageNumber messageNumber;
     QByteArray data;
@@ -36,20 +40,35 @@ public:
     UDTTest(int& argc, char** argv);
 
 public slots:
-    void refillPacket() { sendPacket(); } // adds a new packet to the queue when we are told one is sent
-    void sampleStats();
+    void sampleStats() { sampleConnectionStats(true); }
+    void sendUnreliablePackets(); // sends the unreliable packets of one interval to each target
+    void printSummary();
     
 private:
+    struct Totals {
+        uint64_t sentPackets { 0 };
+        uint64_t retransmittedPackets { 0 };
+        uint64_t sentUtilBytes { 0 };
+        uint64_t receivedPackets { 0 };
+        uint64_t duplicatePackets { 0 };
+        uint64_t goodputBytes { 0 }; // payload handed to the test, without the duplicates
+    };
+
     void parseArguments();
+    void setupSocket();
+    void setupLinkEmulator();
     void handleMessage(std::unique_ptr<Message> message);
+    void recordReceivedPacket(const udt::Packet& packet);
     
     void sendInitialPackets(); // fills the queue with packets to start
-    void sendPacket(); // constructs and sends a packet according to the test parameters
+    void sendPacket(const HifiSockAddr& target); // constructs and sends a packet according to the test parameters
+    void sampleConnectionStats(bool shouldPrint); // adds up the stats of all the connections since the last sample
     
     QCommandLineParser _argumentParser;
     udt::Socket _socket;
     
-    HifiSockAddr _target; // the target for sent packets
+    std::vector<HifiSockAddr> _targets; // the targets for sent packets, on consecutive ports, one connection each
+    LinkEmulator* _linkEmulator { nullptr }; // when relaying between other instances instead of testing
     
     int _minPacketSize { udt::MAX_PACKET_SIZE };
     int _maxPacketSize { udt::MAX_PACKET_SIZE };
@@ -61,6 +80,9 @@ private:
     
     int _messageSize { 10000000 }; // number of bytes per message while sending ordered
 
+    int _queueDepth { 500 }; // number of packets kept queued for each reliable connection
+    int _unreliableRate { 0 }; // unreliable packets per second to each target, 0 sends a single burst
+
     std::unordered_map<udt::Packet::MessageNumber, std::unique_ptr<Message>> _pendingMessages;
     
     std::random_device _randomDevice;
@@ -71,6 +93,12 @@ private:
     int _totalQueuedBytes { 0 }; // keeps track of the number of bytes we have already queued
     
     int _statsInterval { 100 }; // recording interval for stats in milliseconds
+
+    Totals _totals;
+    LinkEmulator::Stats _linkTotals;
+    std::vector<quint32> _latencies; // usecs from the send to the handling of each timestamped packet
+    std::chrono::steady_clock::time_point _startTime { std::chrono::steady_clock::now() };
+    double _startCPUTime { 0.0 };
 };
 
 #endif // hifi_UDTTest_h